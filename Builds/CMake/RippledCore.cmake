@@ -32,6 +32,7 @@ target_sources (xrpl_core PRIVATE
   src/ripple/beast/insight/impl/Hook.cpp
   src/ripple/beast/insight/impl/Metric.cpp
   src/ripple/beast/insight/impl/NullCollector.cpp
+  src/ripple/beast/insight/impl/PrometheusCollector.cpp
   src/ripple/beast/insight/impl/StatsDCollector.cpp
   src/ripple/beast/net/impl/IPAddressConversion.cpp
   src/ripple/beast/net/impl/IPAddressV4.cpp
@@ -55,6 +56,8 @@ target_sources (xrpl_core PRIVATE
   src/ripple/basics/impl/IOUAmount.cpp
   src/ripple/basics/impl/Log.cpp
   src/ripple/basics/impl/Number.cpp
+  src/ripple/basics/impl/ProfiledMutex.cpp
+  src/ripple/basics/impl/strHex.cpp
   src/ripple/basics/impl/StringUtilities.cpp
   #[===============================[
     main sources:
@@ -118,6 +121,7 @@ target_sources (xrpl_core PRIVATE
   src/ripple/protocol/impl/TxMeta.cpp
   src/ripple/protocol/impl/UintTypes.cpp
   src/ripple/protocol/impl/digest.cpp
+  src/ripple/protocol/impl/sha512_batch.cpp
   src/ripple/protocol/impl/tokens.cpp
   src/ripple/protocol/impl/NFTSyntheticSerializer.cpp
   src/ripple/protocol/impl/NFTokenID.cpp
@@ -176,6 +180,7 @@ install (
     src/ripple/basics/FeeUnits.h
     src/ripple/basics/FileUtilities.h
     src/ripple/basics/hardened_hash.h
+    src/ripple/basics/Histogram.h
     src/ripple/basics/IOUAmount.h
     src/ripple/basics/join.h
     src/ripple/basics/KeyCache.h
@@ -186,7 +191,10 @@ install (
     src/ripple/basics/mulDiv.h
     src/ripple/basics/Number.h
     src/ripple/basics/partitioned_unordered_map.h
+    src/ripple/basics/PerfCost.h
     src/ripple/basics/PerfLog.h
+    src/ripple/basics/PerfTrace.h
+    src/ripple/basics/ProfiledMutex.h
     src/ripple/basics/random.h
     src/ripple/basics/RangeSet.h
     src/ripple/basics/README.md
@@ -201,6 +209,7 @@ install (
     src/ripple/basics/StringUtilities.h
     src/ripple/basics/TaggedCache.h
     src/ripple/basics/tagged_integer.h
+    src/ripple/basics/ThreadAffinity.h
     src/ripple/basics/ThreadSafetyAnalysis.h
     src/ripple/basics/ToString.h
     src/ripple/basics/UnorderedContainers.h
@@ -451,6 +460,7 @@ target_sources (rippled PRIVATE
   #]===============================]
   src/ripple/app/consensus/RCLConsensus.cpp
   src/ripple/app/consensus/RCLCxPeerPos.cpp
+  src/ripple/app/consensus/RCLTimelines.cpp
   src/ripple/app/consensus/RCLValidations.cpp
   src/ripple/app/ledger/AcceptedLedger.cpp
   src/ripple/app/ledger/AcceptedLedgerTx.cpp
@@ -458,6 +468,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/ledger/BookListeners.cpp
   src/ripple/app/ledger/ConsensusTransSetSF.cpp
   src/ripple/app/ledger/Ledger.cpp
+  src/ripple/app/ledger/LedgerHeaderCache.cpp
   src/ripple/app/ledger/LedgerHistory.cpp
   src/ripple/app/ledger/OrderBookDB.cpp
   src/ripple/app/ledger/TransactionStateSF.cpp
@@ -467,6 +478,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/ledger/impl/InboundTransactions.cpp
   src/ripple/app/ledger/impl/LedgerCleaner.cpp
   src/ripple/app/ledger/impl/LedgerDeltaAcquire.cpp
+  src/ripple/app/ledger/impl/LedgerHashIndex.cpp
   src/ripple/app/ledger/impl/LedgerMaster.cpp
   src/ripple/app/ledger/impl/LedgerReplay.cpp
   src/ripple/app/ledger/impl/LedgerReplayer.cpp
@@ -475,15 +487,19 @@ target_sources (rippled PRIVATE
   src/ripple/app/ledger/impl/LedgerToJson.cpp
   src/ripple/app/ledger/impl/LocalTxs.cpp
   src/ripple/app/ledger/impl/OpenLedger.cpp
+  src/ripple/app/ledger/impl/PeerLatency.cpp
+  src/ripple/app/ledger/impl/PeerThroughput.cpp
   src/ripple/app/ledger/impl/SkipListAcquire.cpp
   src/ripple/app/ledger/impl/TimeoutCounter.cpp
   src/ripple/app/ledger/impl/TransactionAcquire.cpp
   src/ripple/app/ledger/impl/TransactionMaster.cpp
   src/ripple/app/main/Application.cpp
   src/ripple/app/main/BasicApp.cpp
+  src/ripple/app/main/CacheGovernor.cpp
   src/ripple/app/main/CollectorManager.cpp
   src/ripple/app/main/GRPCServer.cpp
   src/ripple/app/main/LoadManager.cpp
+  src/ripple/app/main/MemoryUsage.cpp
   src/ripple/app/main/Main.cpp
   src/ripple/app/main/NodeIdentity.cpp
   src/ripple/app/main/NodeStoreScheduler.cpp
@@ -502,6 +518,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/misc/impl/AccountTxPaging.cpp
   src/ripple/app/misc/impl/AmendmentTable.cpp
   src/ripple/app/misc/impl/DeliverMax.cpp
+  src/ripple/app/misc/impl/GatewayBalancesIndex.cpp
   src/ripple/app/misc/impl/LoadFeeTrack.cpp
   src/ripple/app/misc/impl/Manifest.cpp
   src/ripple/app/misc/impl/Transaction.cpp
@@ -512,6 +529,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/paths/AccountCurrencies.cpp
   src/ripple/app/paths/Credit.cpp
   src/ripple/app/paths/Flow.cpp
+  src/ripple/app/paths/PathDependencies.cpp
   src/ripple/app/paths/PathRequest.cpp
   src/ripple/app/paths/PathRequests.cpp
   src/ripple/app/paths/Pathfinder.cpp
@@ -582,7 +600,9 @@ target_sources (rippled PRIVATE
   #]===============================]
   src/ripple/basics/impl/Archive.cpp
   src/ripple/basics/impl/BasicConfig.cpp
+  src/ripple/basics/impl/PerfCost.cpp
   src/ripple/basics/impl/ResolverAsio.cpp
+  src/ripple/basics/impl/ThreadAffinity.cpp
   src/ripple/basics/impl/UptimeClock.cpp
   src/ripple/basics/impl/make_SSLContext.cpp
   src/ripple/basics/impl/mulDiv.cpp
@@ -599,8 +619,10 @@ target_sources (rippled PRIVATE
        subdir: core
   #]===============================]
   src/ripple/core/impl/Config.cpp
+  src/ripple/core/impl/CoroStackPool.cpp
   src/ripple/core/impl/DatabaseCon.cpp
   src/ripple/core/impl/Job.cpp
+  src/ripple/core/impl/JobLatencyProbe.cpp
   src/ripple/core/impl/JobQueue.cpp
   src/ripple/core/impl/LoadEvent.cpp
   src/ripple/core/impl/LoadMonitor.cpp
@@ -621,6 +643,7 @@ target_sources (rippled PRIVATE
   src/ripple/ledger/impl/ApplyViewBase.cpp
   src/ripple/ledger/impl/ApplyViewImpl.cpp
   src/ripple/ledger/impl/BookDirs.cpp
+  src/ripple/ledger/impl/CachedSLEs.cpp
   src/ripple/ledger/impl/CachedView.cpp
   src/ripple/ledger/impl/Directory.cpp
   src/ripple/ledger/impl/OpenView.cpp
@@ -637,6 +660,7 @@ target_sources (rippled PRIVATE
   src/ripple/net/impl/HTTPDownloader.cpp
   src/ripple/net/impl/HTTPStream.cpp
   src/ripple/net/impl/InfoSub.cpp
+  src/ripple/net/impl/MultiApiMessage.cpp
   src/ripple/net/impl/RPCCall.cpp
   src/ripple/net/impl/RPCErr.cpp
   src/ripple/net/impl/RPCSub.cpp
@@ -651,6 +675,7 @@ target_sources (rippled PRIVATE
   src/ripple/nodestore/backend/NullFactory.cpp
   src/ripple/nodestore/backend/RocksDBFactory.cpp
   src/ripple/nodestore/impl/BatchWriter.cpp
+  src/ripple/nodestore/impl/CompressedCache.cpp
   src/ripple/nodestore/impl/Database.cpp
   src/ripple/nodestore/impl/DatabaseNodeImp.cpp
   src/ripple/nodestore/impl/DatabaseRotatingImp.cpp
@@ -658,24 +683,33 @@ target_sources (rippled PRIVATE
   src/ripple/nodestore/impl/DeterministicShard.cpp
   src/ripple/nodestore/impl/DecodedBlob.cpp
   src/ripple/nodestore/impl/DummyScheduler.cpp
+  src/ripple/nodestore/impl/ExistenceFilter.cpp
   src/ripple/nodestore/impl/ManagerImp.cpp
   src/ripple/nodestore/impl/NodeObject.cpp
   src/ripple/nodestore/impl/Shard.cpp
   src/ripple/nodestore/impl/ShardInfo.cpp
   src/ripple/nodestore/impl/TaskQueue.cpp
+  src/ripple/nodestore/impl/ZstdCodec.cpp
   #[===============================[
      main sources:
        subdir: overlay
   #]===============================]
   src/ripple/overlay/impl/Cluster.cpp
+  src/ripple/overlay/impl/Compression.cpp
   src/ripple/overlay/impl/ConnectAttempt.cpp
   src/ripple/overlay/impl/Handshake.cpp
+  src/ripple/overlay/impl/IOContextPool.cpp
+  src/ripple/overlay/impl/LastProposals.cpp
+  src/ripple/overlay/impl/LedgerReplyCache.cpp
   src/ripple/overlay/impl/Message.cpp
   src/ripple/overlay/impl/OverlayImpl.cpp
   src/ripple/overlay/impl/PeerImp.cpp
   src/ripple/overlay/impl/PeerReservationTable.cpp
   src/ripple/overlay/impl/PeerSet.cpp
   src/ripple/overlay/impl/ProtocolVersion.cpp
+  src/ripple/overlay/impl/SendQueue.cpp
+  src/ripple/overlay/impl/TLSSessionCache.cpp
+  src/ripple/overlay/impl/TrafficCapture.cpp
   src/ripple/overlay/impl/TrafficCount.cpp
   src/ripple/overlay/impl/TxMetrics.cpp
   #[===============================[
@@ -713,6 +747,7 @@ target_sources (rippled PRIVATE
   src/ripple/rpc/handlers/CanDelete.cpp
   src/ripple/rpc/handlers/Connect.cpp
   src/ripple/rpc/handlers/ConsensusInfo.cpp
+  src/ripple/rpc/handlers/ConsensusTimeline.cpp
   src/ripple/rpc/handlers/CrawlShards.cpp
   src/ripple/rpc/handlers/DepositAuthorized.cpp
   src/ripple/rpc/handlers/DownloadShard.cpp
@@ -741,6 +776,7 @@ target_sources (rippled PRIVATE
   src/ripple/rpc/handlers/PathFind.cpp
   src/ripple/rpc/handlers/PayChanClaim.cpp
   src/ripple/rpc/handlers/Peers.cpp
+  src/ripple/rpc/handlers/PerfTrace.cpp
   src/ripple/rpc/handlers/Ping.cpp
   src/ripple/rpc/handlers/Print.cpp
   src/ripple/rpc/handlers/Random.cpp
@@ -768,8 +804,10 @@ target_sources (rippled PRIVATE
   src/ripple/rpc/impl/DeliveredAmount.cpp
   src/ripple/rpc/impl/Handler.cpp
   src/ripple/rpc/impl/LegacyPathFind.cpp
+  src/ripple/rpc/impl/PortWorkers.cpp
   src/ripple/rpc/impl/RPCHandler.cpp
   src/ripple/rpc/impl/RPCHelpers.cpp
+  src/ripple/rpc/impl/ResponseCache.cpp
   src/ripple/rpc/impl/Role.cpp
   src/ripple/rpc/impl/ServerHandler.cpp
   src/ripple/rpc/impl/ShardArchiveHandler.cpp
@@ -781,6 +819,7 @@ target_sources (rippled PRIVATE
        subdir: perflog
   #]===============================]
   src/ripple/perflog/impl/PerfLogImp.cpp
+  src/ripple/perflog/impl/PerfTrace.cpp
 
   #[===============================[
      main sources:
@@ -792,15 +831,18 @@ target_sources (rippled PRIVATE
      main sources:
        subdir: shamap
   #]===============================]
+  src/ripple/shamap/impl/FullBelowCache.cpp
   src/ripple/shamap/impl/NodeFamily.cpp
   src/ripple/shamap/impl/SHAMap.cpp
   src/ripple/shamap/impl/SHAMapDelta.cpp
   src/ripple/shamap/impl/SHAMapInnerNode.cpp
   src/ripple/shamap/impl/SHAMapLeafNode.cpp
   src/ripple/shamap/impl/SHAMapNodeID.cpp
+  src/ripple/shamap/impl/SHAMapSnapshot.cpp
   src/ripple/shamap/impl/SHAMapSync.cpp
   src/ripple/shamap/impl/SHAMapTreeNode.cpp
-  src/ripple/shamap/impl/ShardFamily.cpp)
+  src/ripple/shamap/impl/ShardFamily.cpp
+  src/ripple/shamap/impl/TreeNodeCache.cpp)
 
   #[===============================[
      test sources:
@@ -808,14 +850,19 @@ target_sources (rippled PRIVATE
   #]===============================]
 if (tests)
   target_sources (rippled PRIVATE
+    src/test/app/AcceptedLedger_test.cpp
     src/test/app/AccountDelete_test.cpp
     src/test/app/AccountTxPaging_test.cpp
     src/test/app/AmendmentTable_test.cpp
     src/test/app/AMM_test.cpp
     src/test/app/AMMCalc_test.cpp
     src/test/app/AMMExtended_test.cpp
+    src/test/app/BuildLedger_test.cpp
+    src/test/app/CacheGovernor_test.cpp
+    src/test/app/CanonicalTXSet_test.cpp
     src/test/app/Check_test.cpp
     src/test/app/Clawback_test.cpp
+    src/test/app/CreateOffer_test.cpp
     src/test/app/CrossingLimits_test.cpp
     src/test/app/DeliverMin_test.cpp
     src/test/app/DepositAuth_test.cpp
@@ -827,11 +874,16 @@ if (tests)
     src/test/app/Flow_test.cpp
     src/test/app/Freeze_test.cpp
     src/test/app/HashRouter_test.cpp
+    src/test/app/LedgerCleaner_test.cpp
+    src/test/app/LedgerHashIndex_test.cpp
+    src/test/app/LedgerHeaderCache_test.cpp
     src/test/app/LedgerHistory_test.cpp
     src/test/app/LedgerLoad_test.cpp
     src/test/app/LedgerMaster_test.cpp
     src/test/app/LedgerReplay_test.cpp
+    src/test/app/LedgerToJson_test.cpp
     src/test/app/LoadFeeTrack_test.cpp
+    src/test/app/LoadGenerator_test.cpp
     src/test/app/Manifest_test.cpp
     src/test/app/MultiSign_test.cpp
     src/test/app/NetworkID_test.cpp
@@ -840,15 +892,24 @@ if (tests)
     src/test/app/NFTokenDir_test.cpp
     src/test/app/OfferStream_test.cpp
     src/test/app/Offer_test.cpp
+    src/test/app/OpenLedger_test.cpp
+    src/test/app/OrderBookDB_test.cpp
     src/test/app/OversizeMeta_test.cpp
+    src/test/app/PathDependencies_test.cpp
     src/test/app/Path_test.cpp
     src/test/app/PayChan_test.cpp
     src/test/app/PayStrand_test.cpp
+    src/test/app/PaymentBenchmark_test.cpp
+    src/test/app/PeerLatency_test.cpp
+    src/test/app/PeerThroughput_test.cpp
     src/test/app/PseudoTx_test.cpp
     src/test/app/RCLCensorshipDetector_test.cpp
+    src/test/app/RCLSpeculation_test.cpp
+    src/test/app/RCLTimelines_test.cpp
     src/test/app/RCLValidations_test.cpp
     src/test/app/ReducedOffer_test.cpp
     src/test/app/Regression_test.cpp
+    src/test/app/RippleLineCache_test.cpp
     src/test/app/SHAMapStore_test.cpp
     src/test/app/XChain_test.cpp
     src/test/app/SetAuth_test.cpp
@@ -868,16 +929,24 @@ if (tests)
        test sources:
          subdir: basics
     #]===============================]
+    src/test/basics/Archive_test.cpp
     src/test/basics/Buffer_test.cpp
+    src/test/basics/CountedObject_test.cpp
     src/test/basics/DetectCrash_test.cpp
     src/test/basics/Expected_test.cpp
     src/test/basics/FileUtilities_test.cpp
+    src/test/basics/IntrusiveShared_test.cpp
     src/test/basics/IOUAmount_test.cpp
     src/test/basics/KeyCache_test.cpp
+    src/test/basics/Log_test.cpp
     src/test/basics/Number_test.cpp
+    src/test/basics/PerfCost_test.cpp
     src/test/basics/PerfLog_test.cpp
+    src/test/basics/PerfTrace_test.cpp
+    src/test/basics/ProfiledMutex_test.cpp
     src/test/basics/RangeSet_test.cpp
     src/test/basics/scope_test.cpp
+    src/test/basics/SlabAllocator_test.cpp
     src/test/basics/Slice_test.cpp
     src/test/basics/StringUtilities_test.cpp
     src/test/basics/TaggedCache_test.cpp
@@ -901,6 +970,7 @@ if (tests)
     src/test/beast/beast_CurrentThreadName_test.cpp
     src/test/beast/beast_Journal_test.cpp
     src/test/beast/beast_PropertyStream_test.cpp
+    src/test/beast/beast_PrometheusCollector_test.cpp
     src/test/beast/beast_Zero_test.cpp
     src/test/beast/beast_abstract_clock_test.cpp
     src/test/beast/beast_basic_seconds_clock_test.cpp
@@ -916,6 +986,7 @@ if (tests)
          subdir: consensus
     #]===============================]
     src/test/consensus/ByzantineFailureSim_test.cpp
+    src/test/consensus/ConsensusBenchmark_test.cpp
     src/test/consensus/Consensus_test.cpp
     src/test/consensus/DistributedValidatorsSim_test.cpp
     src/test/consensus/LedgerTiming_test.cpp
@@ -1017,12 +1088,14 @@ if (tests)
          subdir: net
     #]===============================]
     src/test/net/DatabaseDownloader_test.cpp
+    src/test/net/MultiApiMessage_test.cpp
     #[===============================[
        test sources:
          subdir: nodestore
     #]===============================]
     src/test/nodestore/Backend_test.cpp
     src/test/nodestore/Basics_test.cpp
+    src/test/nodestore/Benchmark_test.cpp
     src/test/nodestore/DatabaseShard_test.cpp
     src/test/nodestore/Database_test.cpp
     src/test/nodestore/Timing_test.cpp
@@ -1032,12 +1105,20 @@ if (tests)
        test sources:
          subdir: overlay
     #]===============================]
+    src/test/overlay/IOContextPool_test.cpp
+    src/test/overlay/LastProposals_test.cpp
+    src/test/overlay/LedgerReplyCache_test.cpp
     src/test/overlay/ProtocolVersion_test.cpp
+    src/test/overlay/SendQueue_test.cpp
+    src/test/overlay/TLSSessionCache_test.cpp
+    src/test/overlay/TrafficCapture_test.cpp
+    src/test/overlay/TrafficCount_test.cpp
     src/test/overlay/cluster_test.cpp
     src/test/overlay/short_read_test.cpp
     src/test/overlay/compression_test.cpp
     src/test/overlay/reduce_relay_test.cpp
     src/test/overlay/handshake_test.cpp
+    src/test/overlay/overlay_replay_test.cpp
     src/test/overlay/tx_reduce_relay_test.cpp
     #[===============================[
        test sources:
@@ -1065,7 +1146,15 @@ if (tests)
     src/test/protocol/Seed_test.cpp
     src/test/protocol/SeqProxy_test.cpp
     src/test/protocol/TER_test.cpp
+    src/test/protocol/TxMeta_test.cpp
+    src/test/protocol/digest_test.cpp
+    src/test/protocol/tokens_test.cpp
     src/test/protocol/types_test.cpp
+    #[===============================[
+       test sources:
+         subdir: rdb
+    #]===============================]
+    src/test/rdb/RelationalDatabase_test.cpp
     #[===============================[
        test sources:
          subdir: resource
@@ -1103,10 +1192,12 @@ if (tests)
     src/test/rpc/NoRipple_test.cpp
     src/test/rpc/OwnerInfo_test.cpp
     src/test/rpc/Peers_test.cpp
+    src/test/rpc/PortWorkers_test.cpp
     src/test/rpc/ReportingETL_test.cpp
     src/test/rpc/Roles_test.cpp
     src/test/rpc/RPCCall_test.cpp
     src/test/rpc/RPCOverload_test.cpp
+    src/test/rpc/ResponseCache_test.cpp
     src/test/rpc/RobustTransaction_test.cpp
     src/test/rpc/ServerInfo_test.cpp
     src/test/rpc/ShardArchiveHandler_test.cpp
@@ -1130,8 +1221,12 @@ if (tests)
          subdir: shamap
     #]===============================]
     src/test/shamap/FetchPack_test.cpp
+    src/test/shamap/FullBelowCache_test.cpp
+    src/test/shamap/SHAMapBenchmark_test.cpp
+    src/test/shamap/SHAMapSnapshot_test.cpp
     src/test/shamap/SHAMapSync_test.cpp
     src/test/shamap/SHAMap_test.cpp
+    src/test/shamap/TreeNodeCache_test.cpp
     #[===============================[
        test sources:
          subdir: unit_test
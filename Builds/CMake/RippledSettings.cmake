@@ -111,6 +111,10 @@ option(single_io_service_thread
   "Restricts the number of threads calling io_service::run to one. \
   This can be useful when debugging."
   OFF)
+option(profile_locks
+  "Record the wait and hold times of the major subsystems' mutexes and \
+  report them through get_counts and insight."
+  OFF)
 option(boost_show_deprecated
   "Allow boost to fail on deprecated usage. Only useful if you're trying\
   to find deprecated calls."
@@ -21,6 +21,7 @@ class Xrpl(ConanFile):
         'static': [True, False],
         'tests': [True, False],
         'unity': [True, False],
+        'zstd': [True, False],
     }
 
     requires = [
@@ -49,6 +50,7 @@ class Xrpl(ConanFile):
         'static': True,
         'tests': True,
         'unity': False,
+        'zstd': True,
 
         'cassandra-cpp-driver:shared': False,
         'cassandra-cpp-driver:use_atomic': None,
@@ -86,6 +88,7 @@ class Xrpl(ConanFile):
         'soci:shared': False,
         'soci:with_sqlite3': True,
         'soci:with_boost': True,
+        'zstd:shared': False,
     }
 
     def set_version(self):
@@ -108,6 +111,8 @@ class Xrpl(ConanFile):
             self.requires('libpq/14.7')
         if self.options.rocksdb:
             self.requires('rocksdb/6.29.5')
+        if self.options.zstd:
+            self.requires('zstd/1.5.5')
 
     exports_sources = (
         'CMakeLists.txt', 'Builds/*', 'bin/getRippledInfo', 'src/*', 'cfg/*'
@@ -131,6 +136,7 @@ class Xrpl(ConanFile):
         tc.variables['BUILD_SHARED_LIBS'] = self.options.shared
         tc.variables['static'] = self.options.static
         tc.variables['unity'] = self.options.unity
+        tc.variables['zstd'] = self.options.zstd
         tc.generate()
 
     def build(self):
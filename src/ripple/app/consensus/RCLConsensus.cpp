@@ -26,6 +26,7 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/LocalTxs.h>
 #include <ripple/app/ledger/OpenLedger.h>
+#include <ripple/app/main/CollectorManager.h>
 #include <ripple/app/misc/AmendmentTable.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
@@ -34,6 +35,7 @@
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/app/misc/ValidatorKeys.h>
 #include <ripple/app/misc/ValidatorList.h>
+#include <ripple/basics/PerfTrace.h>
 #include <ripple/basics/random.h>
 #include <ripple/beast/core/LexicalCast.h>
 #include <ripple/consensus/LedgerTiming.h>
@@ -64,6 +66,7 @@ RCLConsensus::RCLConsensus(
           ledgerMaster,
           localTxs,
           inboundTransactions,
+          clock,
           validatorKeys,
           journal)
     , consensus_(clock, adaptor_, journal)
@@ -77,6 +80,7 @@ RCLConsensus::Adaptor::Adaptor(
     LedgerMaster& ledgerMaster,
     LocalTxs& localTxs,
     InboundTransactions& inboundTransactions,
+    RCLTimelines::clock_type const& clock,
     ValidatorKeys const& validatorKeys,
     beast::Journal journal)
     : app_(app)
@@ -84,6 +88,7 @@ RCLConsensus::Adaptor::Adaptor(
     , ledgerMaster_(ledgerMaster)
     , localTxs_(localTxs)
     , inboundTransactions_{inboundTransactions}
+    , clock_(clock)
     , j_(journal)
     , validatorKeys_(validatorKeys)
     , valCookie_(
@@ -92,6 +97,10 @@ RCLConsensus::Adaptor::Adaptor(
               crypto_prng(),
               std::numeric_limits<std::uint64_t>::max() - 1))
     , nUnlVote_(validatorKeys_.nodeID, j_)
+    , timelines_(
+          timelineRounds,
+          clock,
+          app_.getCollectorManager().group("consensus"))
 {
     assert(valCookie_ != 0);
 
@@ -299,6 +308,8 @@ RCLConsensus::Adaptor::onClose(
     NetClock::time_point const& closeTime,
     ConsensusMode mode) -> Result
 {
+    perf::trace::Scope trace("consensus", "close");
+
     const bool wrongLCL = mode == ConsensusMode::wrongLedger;
     const bool proposing = mode == ConsensusMode::proposing;
 
@@ -310,24 +321,21 @@ RCLConsensus::Adaptor::onClose(
     // Tell the ledger master not to acquire the ledger we're probably building
     ledgerMaster_.setBuildingLedger(prevLedger->info().seq + 1);
 
-    auto initialLedger = app_.openLedger().current();
-
-    auto initialSet =
-        std::make_shared<SHAMap>(SHAMapType::TRANSACTION, app_.getNodeFamily());
-    initialSet->setUnbacked();
+    // The open ledger keeps a SHAMap of its transactions, hashed as they
+    // were applied, so there is no need to build one here
+    auto [initialLedger, initialSet] = app_.openLedger().currentWithTxSet();
 
-    // Build SHAMap containing all transactions in our open ledger
-    for (auto const& tx : initialLedger->txs)
+    if (auto stream = j_.trace())
     {
-        JLOG(j_.trace()) << "Adding open ledger TX "
-                         << tx.first->getTransactionID();
-        Serializer s(2048);
-        tx.first->add(s);
-        initialSet->addItem(
-            SHAMapNodeType::tnTRANSACTION_NM,
-            make_shamapitem(tx.first->getTransactionID(), s.slice()));
+        for (auto const& tx : initialLedger->txs)
+            stream << "Adding open ledger TX " << tx.first->getTransactionID();
     }
 
+    // Keep the negative UNL scores current, so they are ready to vote
+    // with at the flag ledger
+    if (prevLedger->rules().enabled(featureNegativeUNL))
+        nUnlVote_.observe(prevLedger, app_.getValidations());
+
     // Add pseudo-transactions to the set
     if (app_.config().standalone() || (proposing && !wrongLCL))
     {
@@ -400,6 +408,8 @@ RCLConsensus::Adaptor::onForceAccept(
     ConsensusMode const& mode,
     Json::Value&& consensusJson)
 {
+    perf::trace::Scope trace("consensus", "accept");
+
     doAccept(
         result,
         prevLedger,
@@ -438,6 +448,132 @@ RCLConsensus::Adaptor::onAccept(
         });
 }
 
+// Put the transactions of a consensus set in the order they are applied,
+// noting as failed any that cannot be deserialized
+static CanonicalTXSet
+makeCanonicalTxSet(
+    RCLTxSet const& txns,
+    std::set<TxID>& failed,
+    beast::Journal j)
+{
+    // We want to put transactions in an unpredictable but deterministic order:
+    // we use the hash of the set.
+    //
+    // FIXME: Use a std::vector and a custom sorter instead of CanonicalTXSet?
+    CanonicalTXSet retriableTxs{txns.map_->getHash().as_uint256()};
+
+    JLOG(j.debug()) << "Building canonical tx set: " << retriableTxs.key();
+
+    for (auto const& item : *txns.map_)
+    {
+        try
+        {
+            retriableTxs.insert(
+                std::make_shared<STTx const>(SerialIter{item.slice()}));
+            JLOG(j.debug()) << "    Tx: " << item.key();
+        }
+        catch (std::exception const& ex)
+        {
+            failed.insert(item.key());
+            JLOG(j.warn()) << "    Tx: " << item.key()
+                           << " throws: " << ex.what();
+        }
+    }
+
+    return retriableTxs;
+}
+
+void
+RCLConsensus::Adaptor::onStablePosition(
+    Result const& result,
+    RCLCxLedger const& prevLedger,
+    NetClock::duration const& closeResolution,
+    ConsensusMode const& mode)
+{
+    if (!app_.config().SPECULATIVE_BUILD ||
+        mode == ConsensusMode::wrongLedger ||
+        result.position.closeTime() == NetClock::time_point{})
+        return;
+
+    SpeculationKey const key{
+        prevLedger.id(),
+        result.txns.id(),
+        effCloseTime(
+            result.position.closeTime(),
+            closeResolution,
+            prevLedger.closeTime()),
+        closeResolution};
+
+    // Built or building already; or still busy with an older position,
+    // which is left to finish before another starts
+    auto const handle = speculation_.start(key);
+    if (!handle)
+        return;
+
+    JLOG(j_.debug()) << "Building ledger " << (prevLedger.seq() + 1)
+                     << " ahead of consensus on " << key.txSet;
+
+    if (!app_.getJobQueue().addJob(
+            jtACCEPT,
+            "speculateLedger",
+            [this, handle, key, txns = result.txns, prevLedger]() {
+                perf::trace::Scope trace("consensus", "speculate_ledger");
+                try
+                {
+                    std::set<TxID> failed;
+                    auto retriableTxs = makeCanonicalTxSet(txns, failed, j_);
+                    auto ledger = buildLedger(
+                        prevLedger.ledger_,
+                        key.closeTime,
+                        true,
+                        key.closeResolution,
+                        app_,
+                        retriableTxs,
+                        failed,
+                        j_);
+                    speculation_.finish(
+                        handle,
+                        Speculation{
+                            std::move(ledger),
+                            std::move(retriableTxs),
+                            std::move(failed)});
+                }
+                catch (std::exception const& e)
+                {
+                    JLOG(j_.warn()) << "Speculative build failed: " << e.what();
+                    speculation_.finish(handle, std::nullopt);
+                }
+            }))
+    {
+        speculation_.finish(handle, std::nullopt);
+    }
+}
+
+auto
+RCLConsensus::Adaptor::takeSpeculation(
+    RCLCxLedger const& prevLedger,
+    uint256 const& txSet,
+    NetClock::time_point closeTime,
+    bool closeTimeCorrect,
+    NetClock::duration closeResolution) -> std::optional<Speculation>
+{
+    if (!closeTimeCorrect)
+    {
+        if (speculation_.discard())
+            JLOG(j_.debug()) << "Discarding the ledger built ahead of "
+                                "consensus";
+        return std::nullopt;
+    }
+
+    auto speculation = speculation_.take(
+        {prevLedger.id(), txSet, closeTime, closeResolution},
+        speculationWait);
+    if (speculation && !speculation->ledger)
+        return std::nullopt;
+
+    return speculation;
+}
+
 void
 RCLConsensus::Adaptor::doAccept(
     Result const& result,
@@ -482,31 +618,28 @@ RCLConsensus::Adaptor::doAccept(
 
     //--------------------------------------------------------------------------
     std::set<TxID> failed;
+    std::optional<CanonicalTXSet> retriable;
 
-    // We want to put transactions in an unpredictable but deterministic order:
-    // we use the hash of the set.
-    //
-    // FIXME: Use a std::vector and a custom sorter instead of CanonicalTXSet?
-    CanonicalTXSet retriableTxs{result.txns.map_->getHash().as_uint256()};
-
-    JLOG(j_.debug()) << "Building canonical tx set: " << retriableTxs.key();
+    auto speculation = takeSpeculation(
+        prevLedger,
+        result.txns.id(),
+        consensusCloseTime,
+        closeTimeCorrect,
+        closeResolution);
 
-    for (auto const& item : *result.txns.map_)
+    if (speculation)
     {
-        try
-        {
-            retriableTxs.insert(
-                std::make_shared<STTx const>(SerialIter{item.slice()}));
-            JLOG(j_.debug()) << "    Tx: " << item.key();
-        }
-        catch (std::exception const& ex)
-        {
-            failed.insert(item.key());
-            JLOG(j_.warn())
-                << "    Tx: " << item.key() << " throws: " << ex.what();
-        }
+        JLOG(j_.debug()) << "Using the ledger built ahead of consensus";
+        retriable.emplace(std::move(speculation->retriableTxs));
+        failed = std::move(speculation->failedTxs);
+    }
+    else
+    {
+        retriable.emplace(makeCanonicalTxSet(result.txns, failed, j_));
     }
 
+    CanonicalTXSet& retriableTxs = *retriable;
+
     auto built = buildLCL(
         prevLedger,
         retriableTxs,
@@ -514,11 +647,15 @@ RCLConsensus::Adaptor::doAccept(
         closeTimeCorrect,
         closeResolution,
         result.roundTime.read(),
-        failed);
+        failed,
+        speculation ? speculation->ledger : nullptr);
 
     auto const newLCLHash = built.id();
     JLOG(j_.debug()) << "Built ledger #" << built.seq() << ": " << newLCLHash;
 
+    auto timeline = result.timeline;
+    timeline.built = clock_.now();
+
     // Tell directly connected peers that we have a new LCL
     notify(protocol::neACCEPTED_LEDGER, built, haveCorrectLCL);
 
@@ -570,11 +707,15 @@ RCLConsensus::Adaptor::doAccept(
         app_.getValidations().canValidateSeq(built.seq()))
     {
         validate(built, result.txns, proposing);
+        timeline.validated = clock_.now();
         JLOG(j_.info()) << "CNF Val " << newLCLHash;
     }
     else
         JLOG(j_.info()) << "CNF buildLCL " << newLCLHash;
 
+    // Keep the timeline before the ledger can gather its quorum
+    timelines_.record(built.seq(), newLCLHash, timeline);
+
     // See if we can accept a ledger as fully-validated
     ledgerMaster_.consensusBuilt(
         built.ledger_, result.txns.id(), std::move(consensusJson));
@@ -753,14 +894,19 @@ RCLConsensus::Adaptor::buildLCL(
     bool closeTimeCorrect,
     NetClock::duration closeResolution,
     std::chrono::milliseconds roundTime,
-    std::set<TxID>& failedTxs)
+    std::set<TxID>& failedTxs,
+    std::shared_ptr<Ledger const> speculated)
 {
-    std::shared_ptr<Ledger> built = [&]() {
+    perf::trace::Scope trace("consensus", "build_ledger");
+
+    auto built = [&]() -> std::shared_ptr<Ledger const> {
         if (auto const replayData = ledgerMaster_.releaseReplay())
         {
             assert(replayData->parent()->info().hash == previousLedger.id());
             return buildLedger(*replayData, tapNONE, app_, j_);
         }
+        if (speculated)
+            return speculated;
         return buildLedger(
             previousLedger.ledger_,
             closeTime,
@@ -24,6 +24,9 @@
 #include <ripple/app/consensus/RCLCxLedger.h>
 #include <ripple/app/consensus/RCLCxPeerPos.h>
 #include <ripple/app/consensus/RCLCxTx.h>
+#include <ripple/app/consensus/RCLSpeculation.h>
+#include <ripple/app/consensus/RCLTimelines.h>
+#include <ripple/app/misc/CanonicalTXSet.h>
 #include <ripple/app/misc/FeeVote.h>
 #include <ripple/app/misc/NegativeUNLVote.h>
 #include <ripple/basics/CountedObject.h>
@@ -37,6 +40,7 @@
 #include <ripple/shamap/SHAMap.h>
 #include <atomic>
 #include <mutex>
+#include <optional>
 #include <set>
 namespace ripple {
 
@@ -53,6 +57,10 @@ class RCLConsensus
      */
     constexpr static unsigned int censorshipWarnInternal = 15;
 
+    /** The number of recent rounds whose timelines are kept.
+     */
+    constexpr static std::size_t timelineRounds = 256;
+
     // Implements the Adaptor template interface required by Consensus.
     class Adaptor
     {
@@ -61,6 +69,7 @@ class RCLConsensus
         LedgerMaster& ledgerMaster_;
         LocalTxs& localTxs_;
         InboundTransactions& inboundTransactions_;
+        RCLTimelines::clock_type const& clock_;
         beast::Journal const j_;
 
         // If the server is validating, the necessary keying information:
@@ -87,6 +96,35 @@ class RCLConsensus
         RCLCensorshipDetector<TxID, LedgerIndex> censorshipDetector_;
         NegativeUNLVote nUnlVote_;
 
+        // The timelines of recent rounds, which are thread safe
+        RCLTimelines timelines_;
+
+        // A ledger built from our position before the round ended, which
+        // is used if the round ends on the same set and close time
+        struct SpeculationKey
+        {
+            LedgerHash prevLedger;
+            uint256 txSet;
+            NetClock::time_point closeTime;
+            NetClock::duration closeResolution;
+
+            bool
+            operator==(SpeculationKey const&) const = default;
+        };
+
+        struct Speculation
+        {
+            std::shared_ptr<Ledger const> ledger;
+            CanonicalTXSet retriableTxs;
+            std::set<TxID> failedTxs;
+        };
+
+        // How long the end of a round waits for a build under way before
+        // building the ledger itself
+        static constexpr std::chrono::milliseconds speculationWait{500};
+
+        RCLSpeculation<SpeculationKey, Speculation> speculation_;
+
     public:
         using Ledger_t = RCLCxLedger;
         using NodeID_t = NodeID;
@@ -102,6 +140,7 @@ class RCLConsensus
             LedgerMaster& ledgerMaster,
             LocalTxs& localTxs,
             InboundTransactions& inboundTransactions,
+            RCLTimelines::clock_type const& clock,
             ValidatorKeys const& validatorKeys,
             beast::Journal journal);
 
@@ -129,6 +168,12 @@ class RCLConsensus
             return mode_;
         }
 
+        RCLTimelines&
+        timelines()
+        {
+            return timelines_;
+        }
+
         /** Called before kicking off a new consensus round.
 
             @param prevLedger Ledger that will be prior ledger for next round
@@ -305,6 +350,39 @@ class RCLConsensus
             NetClock::time_point const& closeTime,
             ConsensusMode mode);
 
+        /** Start building the ledger of our position ahead of consensus.
+
+            Does nothing unless speculative builds are configured, or if a
+            build for this position is done or under way.
+
+            @param result Our current position
+            @param prevLedger The closed ledger consensus works from
+            @param closeResolution The close time resolution of the round
+            @param mode Our participating mode
+        */
+        void
+        onStablePosition(
+            Result const& result,
+            RCLCxLedger const& prevLedger,
+            NetClock::duration const& closeResolution,
+            ConsensusMode const& mode);
+
+        /** Take the speculative build matching how the round ended.
+
+            Waits a little for the build if it is still under way.
+
+            @return The speculation, or empty if none matches, its build
+                    failed or it is not done in time. Any other
+                    speculation is discarded.
+        */
+        std::optional<Speculation>
+        takeSpeculation(
+            RCLCxLedger const& prevLedger,
+            uint256 const& txSet,
+            NetClock::time_point closeTime,
+            bool closeTimeCorrect,
+            NetClock::duration closeResolution);
+
         /** Process the accepted ledger.
 
             @param result The result of consensus
@@ -384,6 +462,7 @@ class RCLConsensus
             @param roundTime Duration of this consensus round
             @param failedTxs Populate with transactions that we could not
                              successfully apply.
+            @param speculated The same ledger, if already built
             @return The newly built ledger
         */
         RCLCxLedger
@@ -394,7 +473,8 @@ class RCLConsensus
             bool closeTimeCorrect,
             NetClock::duration closeResolution,
             std::chrono::milliseconds roundTime,
-            std::set<TxID>& failedTxs);
+            std::set<TxID>& failedTxs,
+            std::shared_ptr<Ledger const> speculated = {});
 
         /** Validate the given ledger and share with peers as necessary
 
@@ -475,6 +555,20 @@ public:
     Json::Value
     getJson(bool full) const;
 
+    //! @see RCLTimelines::getJson
+    Json::Value
+    getTimelineJson(std::size_t limit)
+    {
+        return adaptor_.timelines().getJson(limit);
+    }
+
+    //! @see RCLTimelines::quorum
+    void
+    gotQuorum(LedgerHash const& hash)
+    {
+        adaptor_.timelines().quorum(hash);
+    }
+
     /** Adjust the set of trusted validators and kick-off the next round of
        consensus. For more details, @see Consensus::startRound
      */
@@ -0,0 +1,142 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_CONSENSUS_RCLSPECULATION_H_INCLUDED
+#define RIPPLE_APP_CONSENSUS_RCLSPECULATION_H_INCLUDED
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace ripple {
+
+/** Keeps the one build started ahead of consensus.
+
+    A build is started for a position before the round ends, and taken when
+    the round ends if it ended on the same position. The build itself is run
+    elsewhere; this only tracks which position it is for and hands over its
+    result.
+
+    @tparam Key Identifies a position; must be equality comparable
+    @tparam Built The result of a build
+*/
+template <class Key, class Built>
+class RCLSpeculation
+{
+    struct Build
+    {
+        Key key;
+
+        // Set once the build is done; built is empty if it failed
+        bool done = false;
+        std::optional<Built> built;
+
+        explicit Build(Key const& key_) : key(key_)
+        {
+        }
+    };
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::shared_ptr<Build> current_;
+
+public:
+    using Handle = std::shared_ptr<Build>;
+
+    RCLSpeculation() = default;
+    RCLSpeculation(RCLSpeculation const&) = delete;
+    RCLSpeculation&
+    operator=(RCLSpeculation const&) = delete;
+
+    /** Start a build for a position.
+
+        @return The handle to finish the build with, or null if a build for
+                this position is done or under way, or a build for another
+                position is still under way.
+    */
+    Handle
+    start(Key const& key)
+    {
+        std::lock_guard lock(mutex_);
+        if (current_ && (!current_->done || current_->key == key))
+            return {};
+        current_ = std::make_shared<Build>(key);
+        return current_;
+    }
+
+    /** Finish a build.
+
+        A build that was taken or discarded meanwhile is dropped.
+
+        @param handle The handle start returned
+        @param built The result, or empty if the build failed
+    */
+    void
+    finish(Handle const& handle, std::optional<Built> built)
+    {
+        std::lock_guard lock(mutex_);
+        handle->built = std::move(built);
+        handle->done = true;
+        cond_.notify_all();
+    }
+
+    /** Take the build for the position the round ended on.
+
+        Any build is forgotten, whether it matches or not. A matching build
+        still under way is waited for, but only for so long: past that the
+        caller is better off building by itself than holding its thread.
+
+        @param key The position the round ended on
+        @param wait How long to wait for a build under way
+        @return The result, or empty if no build matches, it failed, or it
+                was not done in time.
+    */
+    std::optional<Built>
+    take(Key const& key, std::chrono::milliseconds wait)
+    {
+        std::unique_lock lock(mutex_);
+        auto build = std::move(current_);
+
+        if (!build || !(build->key == key))
+            return std::nullopt;
+
+        if (!cond_.wait_for(lock, wait, [&]() { return build->done; }))
+            return std::nullopt;
+
+        return std::move(build->built);
+    }
+
+    /** Forget any build.
+
+        @return Whether there was one.
+    */
+    bool
+    discard()
+    {
+        std::lock_guard lock(mutex_);
+        return std::exchange(current_, nullptr) != nullptr;
+    }
+};
+
+}  // namespace ripple
+
+#endif
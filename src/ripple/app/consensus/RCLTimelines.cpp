@@ -0,0 +1,149 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/consensus/RCLTimelines.h>
+#include <ripple/protocol/jss.h>
+
+#include <algorithm>
+#include <optional>
+
+namespace ripple {
+
+namespace {
+
+std::chrono::milliseconds
+since(
+    ConsensusTimeline::time_point from,
+    ConsensusTimeline::time_point to)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(to - from);
+}
+
+void
+addOffset(
+    Json::Value& json,
+    Json::StaticString const& key,
+    ConsensusTimeline::time_point opened,
+    std::optional<ConsensusTimeline::time_point> const& when)
+{
+    if (when)
+        json[key] = static_cast<Json::Int>(since(opened, *when).count());
+}
+
+}  // namespace
+
+RCLTimelines::RCLTimelines(
+    std::size_t capacity,
+    clock_type const& clock,
+    beast::insight::Collector::ptr const& collector)
+    : clock_(clock)
+    , open_(collector->make_event("open"))
+    , establish_(collector->make_event("establish"))
+    , build_(collector->make_event("build"))
+    , validate_(collector->make_event("validate"))
+    , quorum_(collector->make_event("quorum"))
+    , rounds_(capacity)
+{
+}
+
+void
+RCLTimelines::record(
+    LedgerIndex seq,
+    LedgerHash const& hash,
+    ConsensusTimeline const& timeline)
+{
+    if (timeline.closed)
+    {
+        open_.notify(since(timeline.opened, *timeline.closed));
+        if (timeline.consensus)
+            establish_.notify(since(*timeline.closed, *timeline.consensus));
+    }
+    if (timeline.consensus)
+    {
+        if (timeline.built)
+            build_.notify(since(*timeline.consensus, *timeline.built));
+        if (timeline.validated)
+            validate_.notify(since(*timeline.consensus, *timeline.validated));
+    }
+
+    std::lock_guard lock(mutex_);
+    rounds_.push_back({seq, hash, timeline});
+}
+
+void
+RCLTimelines::quorum(LedgerHash const& hash)
+{
+    auto const now = clock_.now();
+
+    std::lock_guard lock(mutex_);
+    // The ledger is most likely the newest, so search from the back
+    auto const it = std::find_if(
+        rounds_.rbegin(), rounds_.rend(), [&hash](Round const& round) {
+            return round.hash == hash;
+        });
+    if (it == rounds_.rend() || it->timeline.quorum)
+        return;
+
+    auto& timeline = it->timeline;
+    timeline.quorum = now;
+    if (timeline.closed)
+        quorum_.notify(since(*timeline.closed, now));
+}
+
+Json::Value
+RCLTimelines::getJson(std::size_t limit) const
+{
+    Json::Value ret(Json::objectValue);
+    auto& rounds = (ret[jss::rounds] = Json::arrayValue);
+
+    std::lock_guard lock(mutex_);
+    for (auto it = rounds_.rbegin(); it != rounds_.rend() && limit != 0;
+         ++it, --limit)
+    {
+        auto const& timeline = it->timeline;
+        auto const opened = timeline.opened;
+
+        Json::Value round(Json::objectValue);
+        round[jss::ledger_index] = it->seq;
+        round[jss::ledger_hash] = to_string(it->hash);
+        addOffset(round, jss::closed, opened, timeline.closed);
+        addOffset(round, jss::first_proposal, opened, timeline.firstProposal);
+        {
+            auto& changes = (round[jss::position_changes] = Json::arrayValue);
+            for (auto const& when : timeline.positionChanges)
+                changes.append(
+                    static_cast<Json::Int>(since(opened, when).count()));
+        }
+        addOffset(round, jss::consensus, opened, timeline.consensus);
+        addOffset(round, jss::built, opened, timeline.built);
+        addOffset(round, jss::validated, opened, timeline.validated);
+        addOffset(round, jss::quorum, opened, timeline.quorum);
+        rounds.append(std::move(round));
+    }
+    return ret;
+}
+
+std::size_t
+RCLTimelines::size() const
+{
+    std::lock_guard lock(mutex_);
+    return rounds_.size();
+}
+
+}  // namespace ripple
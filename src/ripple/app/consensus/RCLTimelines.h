@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_CONSENSUS_RCLTIMELINES_H_INCLUDED
+#define RIPPLE_APP_CONSENSUS_RCLTIMELINES_H_INCLUDED
+
+#include <ripple/beast/clock/abstract_clock.h>
+#include <ripple/beast/insight/Collector.h>
+#include <ripple/beast/insight/Event.h>
+#include <ripple/consensus/ConsensusTypes.h>
+#include <ripple/json/json_value.h>
+#include <ripple/protocol/Protocol.h>
+#include <ripple/protocol/RippleLedgerHash.h>
+#include <boost/circular_buffer.hpp>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+namespace ripple {
+
+/** Keeps the timelines of the most recent consensus rounds.
+
+    Each round that builds a ledger adds its timeline, and the oldest
+    round is dropped once the buffer is full. The quorum time is stamped
+    later, when the ledger gathers enough trusted validations.
+
+    The durations between the steps are also reported to the collector,
+    so they can be graphed without querying the rounds themselves.
+*/
+class RCLTimelines
+{
+public:
+    using clock_type = beast::abstract_clock<std::chrono::steady_clock>;
+
+    /** Create the buffer.
+
+        @param capacity The number of rounds to keep.
+        @param clock The clock the timelines are stamped with.
+        @param collector Receives the durations of each round's steps.
+    */
+    RCLTimelines(
+        std::size_t capacity,
+        clock_type const& clock,
+        beast::insight::Collector::ptr const& collector);
+
+    /** Keep the timeline of a round that built a ledger. */
+    void
+    record(
+        LedgerIndex seq,
+        LedgerHash const& hash,
+        ConsensusTimeline const& timeline);
+
+    /** Stamp when a ledger gathered a quorum of trusted validations.
+
+        Only the first quorum of a ledger is stamped, and ledgers that were
+        not built by a recent round are ignored.
+    */
+    void
+    quorum(LedgerHash const& hash);
+
+    /** The recent rounds, newest first.
+
+        Every time is in milliseconds since the start of its round.
+
+        @param limit The most rounds to return.
+    */
+    Json::Value
+    getJson(std::size_t limit) const;
+
+    /** The number of rounds kept. */
+    std::size_t
+    size() const;
+
+private:
+    struct Round
+    {
+        LedgerIndex seq;
+        LedgerHash hash;
+        ConsensusTimeline timeline;
+    };
+
+    clock_type const& clock_;
+
+    beast::insight::Event open_;
+    beast::insight::Event establish_;
+    beast::insight::Event build_;
+    beast::insight::Event validate_;
+    beast::insight::Event quorum_;
+
+    std::mutex mutable mutex_;
+    // Oldest first
+    boost::circular_buffer<Round> rounds_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -156,7 +156,7 @@ handleNewValidation(
 {
     auto const& signingKey = val->getSignerPublic();
     auto const& hash = val->getLedgerHash();
-    auto const seq = val->getFieldU32(sfLedgerSequence);
+    auto const seq = val->getLedgerSeq();
 
     // Ensure validation is marked as trusted if signer currently trusted
     auto masterKey = app.validators().getTrustedKey(signingKey);
@@ -21,6 +21,7 @@
 #define RIPPLE_APP_CONSENSUSS_VALIDATIONS_H_INCLUDED
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/basics/ProfiledMutex.h>
 #include <ripple/consensus/Validations.h>
 #include <ripple/protocol/Protocol.h>
 #include <ripple/protocol/RippleLedgerHash.h>
@@ -62,7 +63,7 @@ public:
     std::uint32_t
     seq() const
     {
-        return val_->getFieldU32(sfLedgerSequence);
+        return val_->getLedgerSeq();
     }
 
     /// Validation's signing time
@@ -206,7 +207,12 @@ class RCLValidationsAdaptor
 {
 public:
     // Type definitions for generic Validation
-    using Mutex = std::mutex;
+    struct Mutex : ProfiledMutex<std::mutex>
+    {
+        Mutex() : ProfiledMutex("Validations")
+        {
+        }
+    };
     using Validation = RCLValidation;
     using Ledger = RCLValidatedLedger;
 
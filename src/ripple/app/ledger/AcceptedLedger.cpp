@@ -19,7 +19,12 @@
 
 #include <ripple/app/ledger/AcceptedLedger.h>
 #include <ripple/app/main/Application.h>
+#include <ripple/core/JobQueue.h>
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <vector>
 
 namespace ripple {
 
@@ -28,26 +33,53 @@ AcceptedLedger::AcceptedLedger(
     Application& app)
     : mLedger(ledger)
 {
-    transactions_.reserve(256);
-
-    auto insertAll = [&](auto const& txns) {
-        for (auto const& item : txns)
-            transactions_.emplace_back(std::make_unique<AcceptedLedgerTx>(
-                ledger, item.first, item.second));
-    };
+    std::vector<ReadView::tx_type> txs;
 
     if (app.config().reporting())
-    {
-        auto const txs = flatFetchTransactions(*ledger, app);
-        transactions_.reserve(txs.size());
-        insertAll(txs);
-    }
+        txs = flatFetchTransactions(*ledger, app);
     else
     {
-        transactions_.reserve(256);
-        insertAll(ledger->txs);
+        txs.reserve(256);
+        for (auto const& item : ledger->txs)
+            txs.push_back(item);
     }
 
+    // Parsing the metadata and finding the affected accounts is most of
+    // the work, and each transaction is independent of the others
+    transactions_.resize(txs.size());
+
+    std::atomic<bool> failed = false;
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    // Small ledgers are not worth the jobs
+    app.getJobQueue().parallelFor(
+        jtPUBLEDGER,
+        "AcceptedLedger",
+        txs.size(),
+        txs.size() < 64 ? 1 : app.config().PUBLISH_WORKERS,
+        [&](std::size_t i) {
+            // Once one has failed, the rest are skipped
+            if (failed)
+                return;
+
+            try
+            {
+                transactions_[i] = std::make_unique<AcceptedLedgerTx>(
+                    ledger, txs[i].first, txs[i].second);
+            }
+            catch (...)
+            {
+                failed = true;
+                std::lock_guard lock(errorMutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        });
+
+    if (error)
+        std::rethrow_exception(error);
+
     std::sort(
         transactions_.begin(),
         transactions_.end(),
@@ -38,18 +38,22 @@ AcceptedLedgerTx::AcceptedLedgerTx(
     Serializer s;
     met->add(s);
     mRawMeta = std::move(s.modData());
+}
 
-    mJson = Json::objectValue;
-    mJson[jss::transaction] = mTxn->getJson(JsonOptions::none);
+Json::Value
+AcceptedLedgerTx::getJson(ReadView const& ledger) const
+{
+    Json::Value json(Json::objectValue);
+    json[jss::transaction] = mTxn->getJson(JsonOptions::none);
 
-    mJson[jss::meta] = mMeta.getJson(JsonOptions::none);
-    mJson[jss::raw_meta] = strHex(mRawMeta);
+    json[jss::meta] = mMeta.getJson(JsonOptions::none);
+    json[jss::raw_meta] = strHex(mRawMeta);
 
-    mJson[jss::result] = transHuman(mMeta.getResultTER());
+    json[jss::result] = transHuman(mMeta.getResultTER());
 
     if (!mAffected.empty())
     {
-        Json::Value& affected = (mJson[jss::affected] = Json::arrayValue);
+        Json::Value& affected = (json[jss::affected] = Json::arrayValue);
         for (auto const& account : mAffected)
             affected.append(toBase58(account));
     }
@@ -63,14 +67,15 @@ AcceptedLedgerTx::AcceptedLedgerTx(
         if (account != amount.issue().account)
         {
             auto const ownerFunds = accountFunds(
-                *ledger,
+                ledger,
                 account,
                 amount,
                 fhIGNORE_FREEZE,
                 beast::Journal{beast::Journal::getNullSink()});
-            mJson[jss::transaction][jss::owner_funds] = ownerFunds.getText();
+            json[jss::transaction][jss::owner_funds] = ownerFunds.getText();
         }
     }
+    return json;
 }
 
 std::string
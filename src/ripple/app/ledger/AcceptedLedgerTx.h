@@ -35,7 +35,7 @@ class Logs;
 
     An accepted ledger transaction contains additional information that the
     server needs to tell clients about the transaction. For example,
-        - The transaction in JSON form
+        - The serialized metadata
         - Which accounts are affected
           * This is used by InfoSub to report to clients
         - Cached stuff
@@ -88,18 +88,27 @@ public:
     std::string
     getEscMeta() const;
 
-    Json::Value const&
-    getJson() const
+    /** The serialized metadata. */
+    Blob const&
+    getRawMeta() const
     {
-        return mJson;
+        return mRawMeta;
     }
 
+    /** Describe the transaction, for logging.
+
+        This is built on each call, since it is rarely wanted.
+
+        @param ledger The ledger the transaction is in.
+    */
+    Json::Value
+    getJson(ReadView const& ledger) const;
+
 private:
     std::shared_ptr<STTx const> mTxn;
     TxMeta mMeta;
     boost::container::flat_set<AccountID> mAffected;
     Blob mRawMeta;
-    Json::Value mJson;
 };
 
 }  // namespace ripple
@@ -39,7 +39,7 @@ BookListeners::removeSubscriber(std::uint64_t seq)
 
 void
 BookListeners::publish(
-    MultiApiJson const& jvObj,
+    MultiApiMessage const& message,
     hash_set<std::uint64_t>& havePublished)
 {
     std::lock_guard sl(mLock);
@@ -51,12 +51,9 @@ BookListeners::publish(
 
         if (p)
         {
-            // Only publish jvObj if this is the first occurence
+            // Only publish the message if this is the first occurence
             if (havePublished.emplace(p->getSeq()).second)
-            {
-                p->send(
-                    jvObj.select(apiVersionSelector(p->getApiVersion())), true);
-            }
+                p->send(message, true);
             ++it;
         }
         else
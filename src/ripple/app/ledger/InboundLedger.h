@@ -21,11 +21,13 @@
 #define RIPPLE_APP_LEDGER_INBOUNDLEDGER_H_INCLUDED
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/PeerThroughput.h>
 #include <ripple/app/ledger/impl/TimeoutCounter.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/basics/CountedObject.h>
 #include <ripple/overlay/PeerSet.h>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <utility>
 
@@ -53,7 +55,8 @@ public:
         std::uint32_t seq,
         Reason reason,
         clock_type&,
-        std::unique_ptr<PeerSet> peerSet);
+        std::unique_ptr<PeerSet> peerSet,
+        std::shared_ptr<PeerThroughput> throughput = {});
 
     ~InboundLedger();
 
@@ -87,6 +90,25 @@ public:
         return mSeq;
     }
 
+    /** The job type the data received for this ledger is processed as.
+
+        Past ledgers are processed as jobs of their own, so backfilling
+        history does not hold up the ledgers the server needs to keep up.
+    */
+    JobType
+    dataJobType() const
+    {
+        return dataJobType(mReason);
+    }
+
+    static JobType
+    dataJobType(Reason reason)
+    {
+        return (reason == Reason::HISTORY || reason == Reason::SHARD)
+            ? jtHISTORY_DATA
+            : jtLEDGER_DATA;
+    }
+
     bool
     checkLocal();
     void
@@ -122,6 +144,19 @@ public:
 private:
     enum class TriggerReason { added, reply, timeout };
 
+    // The nodes of a TMLedgerData reply, parsed and hashed before the
+    // ledger's lock is taken. Root nodes are left empty and added from
+    // the packet itself.
+    struct ReceivedNodes
+    {
+        std::vector<std::pair<SHAMapNodeID, SharedIntrusive<SHAMapTreeNode>>>
+            nodes;
+    };
+
+    using ReceivedData = std::vector<std::pair<
+        std::weak_ptr<Peer>,
+        std::shared_ptr<protocol::TMLedgerData>>>;
+
     void
     filterNodes(
         std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
@@ -151,14 +186,26 @@ private:
     std::weak_ptr<TimeoutCounter>
     pmDowncast() override;
 
+    std::vector<std::optional<ReceivedNodes>>
+    parseData(ReceivedData const& data);
+
+    static ReceivedNodes
+    parseNodes(SHAMap const& map, protocol::TMLedgerData const& packet);
+
     int
-    processData(std::shared_ptr<Peer> peer, protocol::TMLedgerData& data);
+    processData(
+        std::shared_ptr<Peer> peer,
+        protocol::TMLedgerData& data,
+        std::optional<ReceivedNodes> nodes = std::nullopt);
 
     bool
     takeHeader(std::string const& data);
 
     void
-    receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode&);
+    receiveNode(
+        protocol::TMLedgerData& packet,
+        std::optional<ReceivedNodes> nodes,
+        SHAMapAddNode&);
 
     bool
     takeTxRootNode(Slice const& data, SHAMapAddNode&);
@@ -190,11 +237,13 @@ private:
 
     // Data we have received from peers
     std::mutex mReceivedDataLock;
-    std::vector<
-        std::pair<std::weak_ptr<Peer>, std::shared_ptr<protocol::TMLedgerData>>>
-        mReceivedData;
+    ReceivedData mReceivedData;
     bool mReceiveDispatched;
     std::unique_ptr<PeerSet> mPeerSet;
+
+    // Spreads past ledgers over the peers that deliver the most, if set
+    std::shared_ptr<PeerThroughput> const throughput_;
+    std::vector<Peer::id_t> assigned_;
 };
 
 }  // namespace ripple
@@ -466,12 +466,23 @@ Ledger::read(Keylet const& k) const
     return sle;
 }
 
+void
+Ledger::prefetch(std::vector<key_type> const& keys) const
+{
+    stateMap_.prefetch(keys);
+}
+
 //------------------------------------------------------------------------------
 
+// Scans of the state map, like ledger_data, touch every node in order.
+// Requesting the next few sibling subtrees while one is walked keeps the
+// node store busy instead of waiting on each read in turn.
+static constexpr int slesReadAhead = 8;
+
 auto
 Ledger::slesBegin() const -> std::unique_ptr<sles_type::iter_base>
 {
-    return std::make_unique<sles_iter_impl>(stateMap_.begin());
+    return std::make_unique<sles_iter_impl>(stateMap_.begin(slesReadAhead));
 }
 
 auto
@@ -484,7 +495,8 @@ auto
 Ledger::slesUpperBound(uint256 const& key) const
     -> std::unique_ptr<sles_type::iter_base>
 {
-    return std::make_unique<sles_iter_impl>(stateMap_.upper_bound(key));
+    return std::make_unique<sles_iter_impl>(
+        stateMap_.upper_bound(key, slesReadAhead));
 }
 
 auto
@@ -1146,6 +1158,14 @@ loadByHash(uint256 const& ledgerHash, Application& app, bool acquire)
     return {};
 }
 
+std::shared_ptr<Ledger>
+loadByInfo(LedgerInfo const& info, Application& app, bool acquire)
+{
+    std::shared_ptr<Ledger> ledger = loadLedgerHelper(info, app, acquire);
+    finishLoadByIndexOrHash(ledger, app.config(), app.journal("Ledger"));
+    return ledger;
+}
+
 std::vector<
     std::pair<std::shared_ptr<STTx const>, std::shared_ptr<STObject const>>>
 flatFetchTransactions(Application& app, std::vector<uint256>& nodestoreHashes)
@@ -185,6 +185,9 @@ public:
     std::shared_ptr<SLE const>
     read(Keylet const& k) const override;
 
+    void
+    prefetch(std::vector<key_type> const& keys) const override;
+
     std::unique_ptr<sles_type::iter_base>
     slesBegin() const override;
 
@@ -450,6 +453,13 @@ loadByIndex(std::uint32_t ledgerIndex, Application& app, bool acquire = true);
 std::shared_ptr<Ledger>
 loadByHash(uint256 const& ledgerHash, Application& app, bool acquire = true);
 
+/** Load a ledger whose header is already known, such as from a cache.
+    Unlike loadByIndex and loadByHash, this does not query the relational
+    database.
+*/
+std::shared_ptr<Ledger>
+loadByInfo(LedgerInfo const& info, Application& app, bool acquire = true);
+
 // Fetch the ledger with the highest sequence contained in the database
 extern std::tuple<std::shared_ptr<Ledger>, std::uint32_t, uint256>
 getLatestLedger(Application& app);
@@ -57,6 +57,14 @@ public:
     */
     virtual void
     clean(Json::Value const& parameters) = 0;
+
+    /** The range being cleaned, and the progress made on it.
+
+        Thread safety:
+            Safe to call from any thread at any time.
+    */
+    virtual Json::Value
+    getJson() const = 0;
 };
 
 std::unique_ptr<LedgerCleaner>
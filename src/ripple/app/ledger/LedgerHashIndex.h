@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_LEDGERHASHINDEX_H_INCLUDED
+#define RIPPLE_APP_LEDGER_LEDGERHASHINDEX_H_INCLUDED
+
+#include <ripple/protocol/Protocol.h>
+#include <ripple/protocol/RippleLedgerHash.h>
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+
+namespace ripple {
+
+/** The hashes of the validated ledgers we store, by sequence.
+
+    Finding the hash for a sequence otherwise means reading the skip lists
+    of a later ledger, which may have to be fetched, or a query to the
+    relational database. This keeps every hash in one run indexed by the
+    sequence, at 32 bytes a ledger, so the lookup is a bounds check and a
+    load.
+
+    Sequences inside the run that have no hash yet are held as zero. The
+    run is only grown by up to a bounded gap at a time, so a stray ledger
+    far from the rest cannot make it allocate for all the sequences between.
+*/
+class LedgerHashIndex
+{
+public:
+    /** The most unknown sequences a single insert may add to the run. */
+    static constexpr LedgerIndex maxGap = 65536;
+
+    /** Get the hash of a validated ledger, if it is held. */
+    std::optional<LedgerHash>
+    get(LedgerIndex seq) const;
+
+    /** Record the hash of a validated ledger.
+
+        @return false if the ledger lies too far outside the run to add.
+    */
+    bool
+    insert(LedgerIndex seq, LedgerHash const& hash);
+
+    /** Forget the hash of a ledger found not to be validated. */
+    void
+    erase(LedgerIndex seq);
+
+    /** Forget the hashes of ledgers older than a sequence. */
+    void
+    clearPrior(LedgerIndex seq);
+
+    /** The number of hashes held. */
+    std::size_t
+    size() const;
+
+private:
+    void
+    trim(std::unique_lock<std::shared_mutex> const&);
+
+    std::shared_mutex mutable mutex_;
+    // The sequence of hashes_.front()
+    LedgerIndex first_ = 0;
+    std::deque<LedgerHash> hashes_;
+    std::size_t known_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerHeaderCache.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace ripple {
+
+LedgerHeaderCache::LedgerHeaderCache(std::size_t budget, int depth)
+    : budget_(budget), depth_(depth)
+{
+}
+
+void
+LedgerHeaderCache::insert(Ledger const& ledger)
+{
+    Entry entry;
+    entry.info = ledger.info();
+    entry.nodes = ledger.stateMap().getTopInnerNodes(depth_);
+    {
+        auto txNodes = ledger.txMap().getTopInnerNodes(depth_);
+        entry.nodes.insert(
+            entry.nodes.end(),
+            std::make_move_iterator(txNodes.begin()),
+            std::make_move_iterator(txNodes.end()));
+    }
+
+    // Nodes shared with other ledgers are counted once for each of them,
+    // which overstates the bytes held but keeps the accounting local.
+    entry.bytes = sizeof(Entry);
+    for (auto const& node : entry.nodes)
+        entry.bytes += node->memoryUsage();
+
+    std::lock_guard lock(mutex_);
+    if (auto const it = index_.find(entry.info.hash); it != index_.end())
+    {
+        // Keep whichever nodes reach further down
+        bytes_ -= it->second->bytes;
+        if (it->second->nodes.size() > entry.nodes.size())
+            entry = std::move(*it->second);
+        entries_.erase(it->second);
+        index_.erase(it);
+    }
+
+    bytes_ += entry.bytes;
+    entries_.push_front(std::move(entry));
+    index_.emplace(entries_.front().info.hash, entries_.begin());
+    evict(lock);
+}
+
+std::optional<LedgerInfo>
+LedgerHeaderCache::fetch(LedgerHash const& hash)
+{
+    std::lock_guard lock(mutex_);
+    auto const it = index_.find(hash);
+    if (it == index_.end())
+    {
+        ++misses_;
+        return std::nullopt;
+    }
+
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->info;
+}
+
+void
+LedgerHeaderCache::clearPrior(LedgerIndex seq)
+{
+    std::lock_guard lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+        if (it->info.seq < seq)
+        {
+            bytes_ -= it->bytes;
+            index_.erase(it->info.hash);
+            it = entries_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+std::size_t
+LedgerHeaderCache::size() const
+{
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+std::size_t
+LedgerHeaderCache::bytes() const
+{
+    std::lock_guard lock(mutex_);
+    return bytes_;
+}
+
+float
+LedgerHeaderCache::getHitRate() const
+{
+    std::lock_guard lock(mutex_);
+    auto const total = static_cast<float>(hits_ + misses_);
+    return hits_ * (100.0f / std::max(1.0f, total));
+}
+
+void
+LedgerHeaderCache::evict(std::lock_guard<std::mutex> const&)
+{
+    // The newest entry stays, even if it alone is over the budget
+    while (bytes_ > budget_ && entries_.size() > 1)
+    {
+        auto& oldest = entries_.back();
+        bytes_ -= oldest.bytes;
+        index_.erase(oldest.info.hash);
+        entries_.pop_back();
+    }
+}
+
+}  // namespace ripple
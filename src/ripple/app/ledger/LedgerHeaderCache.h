@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_LEDGERHEADERCACHE_H_INCLUDED
+#define RIPPLE_APP_LEDGER_LEDGERHEADERCACHE_H_INCLUDED
+
+#include <ripple/app/ledger/Ledger.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/protocol/LedgerHeader.h>
+#include <ripple/protocol/RippleLedgerHash.h>
+#include <ripple/shamap/SHAMapInnerNode.h>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace ripple {
+
+/** Keeps the headers of ledgers, and the tops of their trees, in a budget.
+
+    A header costs far less than a ledger, so this cache covers a much
+    longer window than the ledger cache. A ledger that has left the ledger
+    cache can be rebuilt from its header without a query to the relational
+    database. The inner nodes at the top of its state and transaction maps
+    are held as well, which keeps them in the tree node cache, so the
+    rebuilt ledger does not read them from the node store either.
+
+    Once the bytes held go over the budget, the least recently used
+    headers are dropped first.
+*/
+class LedgerHeaderCache
+{
+public:
+    /** Create the cache.
+
+        @param budget The number of bytes the headers and nodes may hold.
+        @param depth The levels below each root to hold the inner nodes of.
+    */
+    LedgerHeaderCache(std::size_t budget, int depth);
+
+    /** Keep the header of a ledger and the top of its trees.
+
+        Only nodes already in memory are kept; nothing is fetched.
+    */
+    void
+    insert(Ledger const& ledger);
+
+    /** Get the header of a ledger, if it is held. */
+    std::optional<LedgerInfo>
+    fetch(LedgerHash const& hash);
+
+    /** Drop the headers of ledgers older than a sequence. */
+    void
+    clearPrior(LedgerIndex seq);
+
+    /** The number of headers held. */
+    std::size_t
+    size() const;
+
+    /** The estimated number of bytes held. */
+    std::size_t
+    bytes() const;
+
+    /** The fraction of fetches that found a header. */
+    float
+    getHitRate() const;
+
+private:
+    struct Entry
+    {
+        LedgerInfo info;
+        std::vector<SharedIntrusive<SHAMapInnerNode>> nodes;
+        std::size_t bytes = 0;
+    };
+
+    using List = std::list<Entry>;
+
+    void
+    evict(std::lock_guard<std::mutex> const&);
+
+    std::size_t const budget_;
+    int const depth_;
+
+    std::mutex mutable mutex_;
+    // Most recently used first
+    List entries_;
+    hash_map<LedgerHash, List::iterator> index_;
+    std::size_t bytes_ = 0;
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
@@ -22,10 +22,20 @@
 #include <ripple/basics/Log.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/basics/contract.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/json/to_string.h>
 
 namespace ripple {
 
+// The levels below the roots whose inner nodes the header cache holds
+static constexpr int headerCacheDepth = 1;
+
+// The requests in order by sequence that make a walk
+static constexpr int walkLength = 3;
+
+// The number of ledgers loaded ahead of a walk
+static constexpr int prefetchLength = 16;
+
 // FIXME: Need to clean up ledgers by index at some point
 
 LedgerHistory::LedgerHistory(
@@ -40,6 +50,10 @@ LedgerHistory::LedgerHistory(
           std::chrono::seconds{app_.config().getValueFor(SizedItem::ledgerAge)},
           stopwatch(),
           app_.journal("TaggedCache"))
+    , m_ledger_headers(
+          std::size_t(app_.config().getValueFor(SizedItem::ledgerHeaderCache))
+              << 20,
+          headerCacheDepth)
     , m_consensus_validated(
           "ConsensusValidated",
           64,
@@ -60,6 +74,8 @@ LedgerHistory::insert(
 
     assert(ledger->stateMap().getHash().isNonZero());
 
+    m_ledger_headers.insert(*ledger);
+
     std::unique_lock sl(m_ledgers_by_hash.peekMutex());
 
     const bool alreadyHad = m_ledgers_by_hash.canonicalize_replace_cache(
@@ -81,6 +97,15 @@ LedgerHistory::getLedgerHash(LedgerIndex index)
 
 std::shared_ptr<Ledger const>
 LedgerHistory::getLedgerBySeq(LedgerIndex index)
+{
+    auto ret = fetchBySeq(index);
+    if (ret)
+        trackWalk(index);
+    return ret;
+}
+
+std::shared_ptr<Ledger const>
+LedgerHistory::fetchBySeq(LedgerIndex index)
 {
     {
         std::unique_lock sl(m_ledgers_by_hash.peekMutex());
@@ -100,6 +125,7 @@ LedgerHistory::getLedgerBySeq(LedgerIndex index)
         return ret;
 
     assert(ret->info().seq == index);
+    m_ledger_headers.insert(*ret);
 
     {
         // Add this ledger to the local tracking by index
@@ -124,7 +150,11 @@ LedgerHistory::getLedgerByHash(LedgerHash const& hash)
         return ret;
     }
 
-    ret = loadByHash(hash, app_);
+    // The header cache spares a query to the relational database
+    if (auto const info = m_ledger_headers.fetch(hash))
+        ret = loadByInfo(*info, app_);
+    else
+        ret = loadByHash(hash, app_);
 
     if (!ret)
         return ret;
@@ -133,10 +163,72 @@ LedgerHistory::getLedgerByHash(LedgerHash const& hash)
     assert(ret->info().hash == hash);
     m_ledgers_by_hash.canonicalize_replace_client(ret->info().hash, ret);
     assert(ret->info().hash == hash);
+    m_ledger_headers.insert(*ret);
 
     return ret;
 }
 
+void
+LedgerHistory::trackWalk(LedgerIndex index)
+{
+    int direction = 0;
+    {
+        std::lock_guard lock(walkMutex_);
+        int step = 0;
+        if (index == lastIndex_ + 1)
+            step = 1;
+        else if (index + 1 == lastIndex_)
+            step = -1;
+
+        if (step != 0 && step == walkDirection_)
+        {
+            ++walkLength_;
+        }
+        else
+        {
+            walkDirection_ = step;
+            walkLength_ = (step != 0) ? 2 : 1;
+        }
+        lastIndex_ = index;
+
+        if (walkLength_ >= walkLength)
+            direction = walkDirection_;
+    }
+
+    if (direction == 0)
+        return;
+
+    if (prefetching_.test_and_set(std::memory_order_acquire))
+        return;
+
+    if (!app_.getJobQueue().addJob(
+            jtLEDGER_PREFETCH,
+            "LedgerHistory::prefetch",
+            [this, index, direction]() {
+                try
+                {
+                    // Stop at the first ledger we don't have
+                    LedgerIndex seq = index;
+                    for (int i = 0; i < prefetchLength; ++i)
+                    {
+                        seq = (direction > 0) ? seq + 1 : seq - 1;
+                        if (seq == 0 || !fetchBySeq(seq))
+                            break;
+                    }
+                }
+                catch (std::exception const& e)
+                {
+                    JLOG(j_.warn())
+                        << "Unable to prefetch ledgers after " << index << ": "
+                        << e.what();
+                }
+                prefetching_.clear(std::memory_order_release);
+            }))
+    {
+        prefetching_.clear(std::memory_order_release);
+    }
+}
+
 static void
 log_one(
     ReadView const& ledger,
@@ -527,6 +619,7 @@ LedgerHistory::clearLedgerCachePrior(LedgerIndex seq)
         if (!ledger || ledger->info().seq < seq)
             m_ledgers_by_hash.del(it, false);
     }
+    m_ledger_headers.clearPrior(seq);
 }
 
 }  // namespace ripple
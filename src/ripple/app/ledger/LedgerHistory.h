@@ -21,11 +21,14 @@
 #define RIPPLE_APP_LEDGER_LEDGERHISTORY_H_INCLUDED
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/LedgerHeaderCache.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/beast/insight/Collector.h>
 #include <ripple/beast/insight/Event.h>
 #include <ripple/protocol/RippleLedgerHash.h>
 
+#include <atomic>
+#include <mutex>
 #include <optional>
 
 namespace ripple {
@@ -55,7 +58,27 @@ public:
         return m_ledgers_by_hash.getHitRate();
     }
 
-    /** Get a ledger given its sequence number */
+    /** Get the ledger header cache hit rate
+        @return the hit rate
+    */
+    float
+    getHeaderCacheHitRate() const
+    {
+        return m_ledger_headers.getHitRate();
+    }
+
+    /** Get the number of bytes held by the ledger caches */
+    std::size_t
+    getCacheBytes() const
+    {
+        return m_ledgers_by_hash.getCacheBytes() + m_ledger_headers.bytes();
+    }
+
+    /** Get a ledger given its sequence number
+
+        When the requests walk the ledgers one by one, the next ledgers
+        of the walk are loaded in the background.
+    */
     std::shared_ptr<Ledger const>
     getLedgerBySeq(LedgerIndex ledgerIndex);
 
@@ -104,6 +127,15 @@ public:
     clearLedgerCachePrior(LedgerIndex seq);
 
 private:
+    std::shared_ptr<Ledger const>
+    fetchBySeq(LedgerIndex ledgerIndex);
+
+    /** Note a request for a ledger by sequence, and load the ledgers
+        ahead of it if the requests are walking them in order.
+    */
+    void
+    trackWalk(LedgerIndex ledgerIndex);
+
     /** Log details in the case where we build one ledger but
         validate a different one.
         @param built The hash of the ledger we built
@@ -126,10 +158,25 @@ private:
     beast::insight::Collector::ptr collector_;
     beast::insight::Counter mismatch_counter_;
 
-    using LedgersByHash = TaggedCache<LedgerHash, Ledger const>;
+    using LedgersByHash =
+        TaggedCache<LedgerHash, Ledger const, false, digest_hash>;
 
     LedgersByHash m_ledgers_by_hash;
 
+    // The headers of ledgers, including many that m_ledgers_by_hash has
+    // dropped
+    LedgerHeaderCache m_ledger_headers;
+
+    // The last ledger requested by sequence, and the direction and length
+    // of the walk in order that led to it
+    std::mutex walkMutex_;
+    LedgerIndex lastIndex_ = 0;
+    int walkDirection_ = 0;
+    int walkLength_ = 0;
+
+    // Set while the ledgers ahead of a walk are being loaded
+    std::atomic_flag prefetching_ = ATOMIC_FLAG_INIT;
+
     // Maps ledger indexes to the corresponding hashes
     // For debug and logging purposes
     struct cv_entry
@@ -23,6 +23,7 @@
 #include <ripple/app/ledger/AbstractFetchPackContainer.h>
 #include <ripple/app/ledger/InboundLedgers.h>
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/LedgerHashIndex.h>
 #include <ripple/app/ledger/LedgerHistory.h>
 #include <ripple/app/ledger/LedgerHolder.h>
 #include <ripple/app/ledger/LedgerReplay.h>
@@ -199,6 +200,12 @@ public:
     void
     setLedgerRangePresent(std::uint32_t minV, std::uint32_t maxV);
 
+    /** Load the hashes of the ledgers in the relational database into the
+        in-memory hash index.
+    */
+    void
+    loadHashIndex();
+
     std::optional<NetClock::time_point>
     getCloseTimeBySeq(LedgerIndex ledgerIndex);
 
@@ -225,6 +232,10 @@ public:
     sweep();
     float
     getCacheHitRate();
+    float
+    getHeaderCacheHitRate();
+    std::size_t
+    getCacheBytes() const;
 
     void
     checkAccept(std::shared_ptr<Ledger const> const& ledger);
@@ -304,6 +315,10 @@ private:
     void
     setPubLedger(std::shared_ptr<Ledger const> const& l);
 
+    // Write a state snapshot of the ledger, if one is due.
+    void
+    updateStateSnapshot(std::shared_ptr<Ledger const> const& l);
+
     void
     tryFill(std::shared_ptr<Ledger const> ledger);
 
@@ -313,8 +328,19 @@ private:
     std::optional<LedgerHash>
     getLedgerHashForHistory(LedgerIndex index, InboundLedger::Reason reason);
 
+    // The hash of a ledger the reference ledger descends from, taken from
+    // the hash index when the reference is validated and from its skip
+    // lists otherwise. May throw like hashOfSeq.
+    std::optional<LedgerHash>
+    chainHashOfSeq(ReadView const& ledger, LedgerIndex seq);
+
     std::size_t
     getNeededValidations();
+
+    // How many past ledgers to keep in flight while backfilling history
+    std::uint32_t
+    historyWindow();
+
     void
     fetchForHistory(
         std::uint32_t missing,
@@ -329,6 +355,14 @@ private:
     std::vector<std::shared_ptr<Ledger const>>
     findNewLedgersToPublish(std::unique_lock<std::recursive_mutex>&);
 
+    // Replay the ledgers after start up to finish from their deltas,
+    // splitting a long gap into consecutive tasks.
+    void
+    replayGap(
+        ReadView const& valLedger,
+        LedgerInfo const& start,
+        LedgerInfo const& finish);
+
     void
     updatePaths();
 
@@ -365,6 +399,9 @@ private:
 
     LedgerHistory mLedgerHistory;
 
+    // The hashes of validated ledgers by sequence
+    LedgerHashIndex mHashIndex;
+
     CanonicalTXSet mHeldTransactions{uint256()};
 
     // A set of transactions to replay during the next close
@@ -386,6 +423,9 @@ private:
     std::atomic_flag mGotFetchPackThread =
         ATOMIC_FLAG_INIT;  // GotFetchPack jobs dispatched
 
+    std::atomic_flag mSnapshotThread =
+        ATOMIC_FLAG_INIT;  // state snapshot job dispatched
+
     std::atomic<std::uint32_t> mPubLedgerClose{0};
     std::atomic<LedgerIndex> mPubLedgerSeq{0};
     std::atomic<std::uint32_t> mValidLedgerSign{0};
@@ -405,6 +445,27 @@ private:
 
     TaggedCache<uint256, Blob> fetch_packs_;
 
+    // The objects a fetch pack holds for one ledger: its header, the state
+    // nodes it does not share with its successor, and its transactions.
+    struct FetchPackSegment
+    {
+        google::protobuf::RepeatedPtrField<protocol::TMIndexedObject> objects;
+        std::size_t bytes = 0;
+
+        std::size_t
+        memoryUsage() const
+        {
+            return bytes;
+        }
+    };
+
+    // Peers catching up ask for packs along the same stretch of history,
+    // so the segments we built are kept for the next request.
+    TaggedCache<uint256, FetchPackSegment> fetchPackSegments_;
+
+    std::shared_ptr<FetchPackSegment>
+    makeFetchPackSegment(Ledger const& want, Ledger const& have) const;
+
     std::uint32_t fetch_seq_{0};
 
     // Try to keep a validator from switching from test to live network
@@ -97,13 +97,16 @@ public:
      * @param skipListAcquirer  shared_ptr of SkipListAcquire subtask,
      *        to make sure it will not be destroyed.
      * @param parameter  parameter of the task
+     * @param prior  an earlier task that builds this task's start ledger,
+     *        which is then taken from it rather than acquired
      */
     LedgerReplayTask(
         Application& app,
         InboundLedgers& inboundLedgers,
         LedgerReplayer& replayer,
         std::shared_ptr<SkipListAcquire>& skipListAcquirer,
-        TaskParameter&& parameter);
+        TaskParameter&& parameter,
+        std::shared_ptr<LedgerReplayTask> const& prior = {});
 
     ~LedgerReplayTask();
 
@@ -129,6 +132,10 @@ public:
     bool
     finished() const;
 
+    /** return the finish ledger if the task completed, otherwise nullptr */
+    std::shared_ptr<Ledger const>
+    finishLedger() const;
+
 private:
     void
     onTimer(bool progress, ScopedLockType& sl) override;
@@ -175,6 +182,7 @@ private:
     uint32_t maxTimeouts_;
     std::shared_ptr<SkipListAcquire> skipListAcquirer_;
     std::shared_ptr<Ledger const> parent_ = {};
+    std::weak_ptr<LedgerReplayTask> prior_;
     uint32_t deltaToBuild_ = 0;  // should not build until have parent
     std::vector<std::shared_ptr<LedgerDeltaAcquire>> deltas_;
 
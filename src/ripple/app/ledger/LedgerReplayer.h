@@ -59,8 +59,14 @@ auto constexpr SUB_TASK_FALLBACK_TIMEOUT = std::chrono::milliseconds{1000};
 // for LedgerReplayer to limit the number of LedgerReplayTask
 std::uint32_t constexpr MAX_TASKS = 10;
 
-// for LedgerReplayer to limit the number of ledgers to replay in one task
-std::uint32_t constexpr MAX_TASK_SIZE = 256;
+// for LedgerReplayer to limit the number of ledgers to replay in one task.
+// The finish ledger's skip list holds the 256 ledgers before it, so a task
+// can start as far back as 256 ledgers and replay 256 deltas.
+std::uint32_t constexpr MAX_TASK_SIZE = 257;
+
+// for LedgerMaster to limit the number of consecutive tasks started ahead
+// when catching up over a gap longer than MAX_TASK_SIZE
+std::uint32_t constexpr MAX_PIPELINED_TASKS = 4;
 
 // to limit the number of LedgerReplay related jobs in JobQueue
 std::uint32_t constexpr MAX_QUEUED_TASKS = 100;
@@ -84,13 +90,18 @@ public:
      * @param r  reason for the replay request
      * @param finishLedgerHash  hash of the last ledger
      * @param totalNumLedgers  total number of ledgers in the range, inclusive
-     * @note totalNumLedgers must > 0 && totalNumLedgers must <= 256
+     * @param priorFinishHash  finish ledger hash of an earlier replay whose
+     *        last ledger is the first ledger of this range, if any. The new
+     *        task waits for that replay instead of acquiring its start ledger.
+     * @note totalNumLedgers must > 0 &&
+     *       totalNumLedgers must <= LedgerReplayParameters::MAX_TASK_SIZE
      */
     void
     replay(
         InboundLedger::Reason r,
         uint256 const& finishLedgerHash,
-        std::uint32_t totalNumLedgers);
+        std::uint32_t totalNumLedgers,
+        uint256 const& priorFinishHash = {});
 
     /** Create LedgerDeltaAcquire subtasks for the LedgerReplayTask task */
     void
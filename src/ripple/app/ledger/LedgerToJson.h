@@ -25,7 +25,9 @@
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/basics/StringUtilities.h>
 #include <ripple/basics/chrono.h>
+#include <ripple/beast/utility/Journal.h>
 #include <ripple/json/Object.h>
+#include <ripple/json/Output.h>
 #include <ripple/protocol/STTx.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/protocol/serialize.h>
@@ -72,10 +74,24 @@ struct LedgerFill
 void
 addJson(Json::Value&, LedgerFill const&);
 
+void
+addJson(Json::Object&, LedgerFill const&);
+
 /** Return a new Json::Value representing the ledger with given options.*/
 Json::Value
 getJson(LedgerFill const&);
 
+/** Write the ledger with given options straight to an Output.
+
+    This produces the same document as getJson, but holds at most one
+    transaction or state entry as a Json::Value at a time, so even a full
+    ledger goes out as it is read.
+
+    @return The number of bytes written.
+*/
+std::size_t
+streamJson(LedgerFill const&, Json::Output const&, beast::Journal);
+
 }  // namespace ripple
 
 #endif
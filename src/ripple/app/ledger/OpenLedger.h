@@ -22,14 +22,17 @@
 
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/misc/CanonicalTXSet.h>
+#include <ripple/app/tx/applySteps.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/UnorderedContainers.h>
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/core/Config.h>
 #include <ripple/ledger/CachedSLEs.h>
 #include <ripple/ledger/OpenView.h>
+#include <ripple/shamap/SHAMap.h>
 #include <cassert>
 #include <mutex>
+#include <utility>
 
 namespace ripple {
 
@@ -49,11 +52,53 @@ using OrderedTxs = CanonicalTXSet;
 class OpenLedger
 {
 private:
+    /** Preflight results carried from one accept to the next.
+
+        A transaction replayed into each new open view is
+        preflighted once, for as long as the rules and the
+        flags it is applied with stay the same.
+    */
+    class Preflights
+    {
+    public:
+        /** The transaction is held so the result's reference to it
+            stays valid.
+        */
+        using value_type =
+            std::pair<std::shared_ptr<STTx const>, PreflightResult>;
+
+        /** Return the preflight result for a transaction.
+
+            The result kept for it is returned if it was found
+            under the same rules and flags. Otherwise preflight
+            is run and the result kept in place of the old one.
+        */
+        value_type
+        get(Application& app,
+            Rules const& rules,
+            std::shared_ptr<STTx const> const& tx,
+            ApplyFlags flags,
+            beast::Journal j);
+
+        /** Forget the results not asked for since the last call. */
+        void
+        rotate();
+
+    private:
+        std::mutex mutex_;
+        hash_map<uint256, value_type> recent_;
+        hash_map<uint256, value_type> previous_;
+    };
+
     beast::Journal const j_;
     CachedSLEs& cache_;
     std::mutex mutable modify_mutex_;
     std::mutex mutable current_mutex_;
     std::shared_ptr<OpenView const> current_;
+    // The txs of current_ as a consensus tx set, hashed as they arrive so
+    // that a close finds the hash mostly computed
+    std::shared_ptr<SHAMap> txSet_;
+    Preflights preflights_;
 
 public:
     /** Signature for modification functions.
@@ -77,10 +122,12 @@ public:
     /** Create a new open ledger object.
 
         @param ledger A closed ledger
+        @param family The family of the tx set kept with the open ledger
     */
-    explicit OpenLedger(
+    OpenLedger(
         std::shared_ptr<Ledger const> const& ledger,
         CachedSLEs& cache,
+        Family& family,
         beast::Journal journal);
 
     /** Returns `true` if there are no transactions.
@@ -112,6 +159,20 @@ public:
     std::shared_ptr<OpenView const>
     current() const;
 
+    /** Returns a view to the current open ledger, and its tx set.
+
+        Thread safety:
+            Can be called concurrently from any thread.
+
+        Effects:
+            The caller is given the same snapshot as
+            current() returns, and a mutable, unbacked
+            SHAMap holding exactly its transactions,
+            whose hash is already mostly computed.
+    */
+    std::pair<std::shared_ptr<OpenView const>, std::shared_ptr<SHAMap>>
+    currentWithTxSet() const;
+
     /** Modify the open ledger
 
         Thread safety:
@@ -177,7 +238,7 @@ private:
         used for consensus and building the open ledger.
     */
     template <class FwdRange>
-    static void
+    void
     apply(
         Application& app,
         OpenView& view,
@@ -192,7 +253,12 @@ private:
     std::shared_ptr<OpenView>
     create(Rules const& rules, std::shared_ptr<Ledger const> const& ledger);
 
-    static Result
+    // Add the txs of a layer of the open view to the tx set, and hash
+    // the nodes that changed
+    static void
+    addTxs(SHAMap& txSet, OpenView const& layer);
+
+    Result
     apply_one(
         Application& app,
         OpenView& view,
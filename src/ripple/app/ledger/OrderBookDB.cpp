@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/AcceptedLedger.h>
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/OrderBookDB.h>
 #include <ripple/app/main/Application.h>
@@ -29,6 +30,43 @@
 
 namespace ripple {
 
+// Count a directory root or AMM of a book in or out of the books
+static void
+adjustBook(
+    Book const& book,
+    int delta,
+    hardened_hash_map<Issue, hardened_hash_set<Issue>>& allBooks,
+    hash_set<Issue>& xrpBooks,
+    hash_map<Book, std::uint32_t>& bookRoots)
+{
+    if (delta > 0)
+    {
+        if (bookRoots[book]++ != 0)
+            return;
+
+        allBooks[book.in].insert(book.out);
+
+        if (isXRP(book.out))
+            xrpBooks.insert(book.in);
+        return;
+    }
+
+    auto const it = bookRoots.find(book);
+    if (it == bookRoots.end() || --it->second != 0)
+        return;
+    bookRoots.erase(it);
+
+    if (auto const books = allBooks.find(book.in); books != allBooks.end())
+    {
+        books->second.erase(book.out);
+        if (books->second.empty())
+            allBooks.erase(books);
+    }
+
+    if (isXRP(book.out))
+        xrpBooks.erase(book.in);
+}
+
 OrderBookDB::OrderBookDB(Application& app)
     : app_(app), seq_(0), j_(app.journal("OrderBookDB"))
 {
@@ -62,6 +100,11 @@ OrderBookDB::setup(std::shared_ptr<ReadView const> const& ledger)
 
     if (app_.config().PATH_SEARCH_MAX != 0)
     {
+        {
+            std::lock_guard sl(mLock);
+            updating_ = true;
+        }
+
         if (app_.config().standalone())
             update(ledger);
         else
@@ -88,9 +131,18 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
 
     decltype(allBooks_) allBooks;
     decltype(xrpBooks_) xrpBooks;
+    decltype(bookRoots_) bookRoots;
 
     allBooks.reserve(allBooks_.size());
     xrpBooks.reserve(xrpBooks_.size());
+    bookRoots.reserve(bookRoots_.size());
+
+    auto const abandon = [this]() {
+        seq_.store(0);
+        std::lock_guard sl(mLock);
+        updating_ = false;
+        pending_.clear();
+    };
 
     JLOG(j_.debug()) << "Beginning update (" << ledger->seq() << ")";
 
@@ -105,7 +157,7 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
             {
                 JLOG(j_.info())
                     << "Update halted because the process is stopping";
-                seq_.store(0);
+                abandon();
                 return;
             }
 
@@ -120,10 +172,7 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
                 book.out.currency = sle->getFieldH160(sfTakerGetsCurrency);
                 book.out.account = sle->getFieldH160(sfTakerGetsIssuer);
 
-                allBooks[book.in].insert(book.out);
-
-                if (isXRP(book.out))
-                    xrpBooks.insert(book.in);
+                adjustBook(book, 1, allBooks, xrpBooks, bookRoots);
 
                 ++cnt;
             }
@@ -132,10 +181,7 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
                 auto const issue1 = (*sle)[sfAsset];
                 auto const issue2 = (*sle)[sfAsset2];
                 auto addBook = [&](Issue const& in, Issue const& out) {
-                    allBooks[in].insert(out);
-
-                    if (isXRP(out))
-                        xrpBooks.insert(in);
+                    adjustBook({in, out}, 1, allBooks, xrpBooks, bookRoots);
 
                     ++cnt;
                 };
@@ -148,7 +194,7 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
     {
         JLOG(j_.info()) << "Missing node in " << ledger->seq()
                         << " during update: " << mn.what();
-        seq_.store(0);
+        abandon();
         return;
     }
 
@@ -157,13 +203,112 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
 
     {
         std::lock_guard sl(mLock);
+
+        // Catch up with the ledgers processed while the walk ran
+        for (auto const& [seq, book, delta] : pending_)
+        {
+            if (seq > ledger->seq())
+                adjustBook(book, delta, allBooks, xrpBooks, bookRoots);
+        }
+        pending_.clear();
+        updating_ = false;
+        processedSeq_ = std::max(processedSeq_, ledger->seq());
+
         allBooks_.swap(allBooks);
         xrpBooks_.swap(xrpBooks);
+        bookRoots_.swap(bookRoots);
     }
 
     app_.getLedgerMaster().newOrderBookDB();
 }
 
+void
+OrderBookDB::processLedger(AcceptedLedger const& ledger)
+{
+    if (app_.config().PATH_SEARCH_MAX == 0)
+        return;  // pathfinding has been disabled
+
+    auto const seq = ledger.getLedger()->seq();
+
+    // The books created and removed, from the metadata of every
+    // transaction: failed ones may still remove unfunded offers
+    std::vector<std::pair<Book, int>> changes;
+
+    for (auto const& tx : ledger)
+    {
+        for (auto const& node : tx->getMeta().getNodes())
+        {
+            try
+            {
+                bool const created = node.getFName() == sfCreatedNode;
+                if (!created && node.getFName() != sfDeletedNode)
+                    continue;
+
+                auto const type = node.getFieldU16(sfLedgerEntryType);
+                if (type != ltDIR_NODE && type != ltAMM)
+                    continue;
+
+                // New fields leave out the defaults, such as XRP
+                auto const fields = dynamic_cast<STObject const*>(
+                    node.peekAtPField(created ? sfNewFields : sfFinalFields));
+                if (!fields)
+                    continue;
+
+                int const delta = created ? 1 : -1;
+
+                if (type == ltAMM)
+                {
+                    auto const issue1 =
+                        (*fields)[~sfAsset].value_or(xrpIssue());
+                    auto const issue2 =
+                        (*fields)[~sfAsset2].value_or(xrpIssue());
+                    changes.emplace_back(Book{issue1, issue2}, delta);
+                    changes.emplace_back(Book{issue2, issue1}, delta);
+                }
+                else if (
+                    fields->isFieldPresent(sfExchangeRate) &&
+                    (*fields)[~sfRootIndex] == node.getFieldH256(sfLedgerIndex))
+                {
+                    Book book;
+
+                    book.in.currency =
+                        (*fields)[~sfTakerPaysCurrency].value_or(uint160{});
+                    book.in.account =
+                        (*fields)[~sfTakerPaysIssuer].value_or(uint160{});
+                    book.out.currency =
+                        (*fields)[~sfTakerGetsCurrency].value_or(uint160{});
+                    book.out.account =
+                        (*fields)[~sfTakerGetsIssuer].value_or(uint160{});
+
+                    changes.emplace_back(book, delta);
+                }
+            }
+            catch (std::exception const& ex)
+            {
+                JLOG(j_.info())
+                    << "processLedger: field not found (" << ex.what() << ")";
+            }
+        }
+    }
+
+    std::lock_guard sl(mLock);
+
+    if (seq <= processedSeq_)
+        return;
+    processedSeq_ = seq;
+
+    for (auto const& [book, delta] : changes)
+    {
+        adjustBook(book, delta, allBooks_, xrpBooks_, bookRoots_);
+        if (updating_)
+            pending_.emplace_back(seq, book, delta);
+    }
+
+    if (!changes.empty())
+        JLOG(j_.debug()) << "Ledger " << seq << " changed " << changes.size()
+                         << " order book roots";
+}
+
 void
 OrderBookDB::addOrderBook(Book const& book)
 {
@@ -244,6 +389,13 @@ OrderBookDB::getBookListeners(Book const& book)
     return ret;
 }
 
+bool
+OrderBookDB::haveBookListeners()
+{
+    std::lock_guard sl(mLock);
+    return !mListeners.empty();
+}
+
 // Based on the meta, send the meta to the streams that are listening.
 // We need to determine which streams a given meta effects.
 void
@@ -260,6 +412,7 @@ OrderBookDB::processTxn(
     // entries for the same book, or if it touches multiple books and a
     // single client has subscribed to those books.
     hash_set<std::uint64_t> havePublished;
+    MultiApiMessage const message{jvObj};
 
     for (auto const& node : alTx.getMeta().getNodes())
     {
@@ -277,7 +430,7 @@ OrderBookDB::processTxn(
                             {data->getFieldAmount(sfTakerGets).issue(),
                              data->getFieldAmount(sfTakerPays).issue()});
                         if (listeners)
-                            listeners->publish(jvObj, havePublished);
+                            listeners->publish(message, havePublished);
                     }
                 };
 
@@ -299,4 +452,74 @@ OrderBookDB::processTxn(
     }
 }
 
+std::optional<Json::Value>
+OrderBookDB::getBookSnapshot(
+    ReadView const& ledger,
+    Book const& book,
+    bool takerIsIssuer,
+    unsigned int limit)
+{
+    std::lock_guard sl(snapshotLock_);
+    if (ledger.info().hash != snapshotHash_)
+        return std::nullopt;
+
+    auto const& snapshots = snapshots_[takerIsIssuer];
+    auto const it = snapshots.find(book);
+    if (it == snapshots.end())
+        return std::nullopt;
+
+    auto const& offers = it->second.offers;
+    if (offers.size() < limit && !it->second.complete)
+        return std::nullopt;
+
+    // A shorter page is a prefix of a longer one
+    if (offers.size() <= limit)
+        return offers;
+
+    Json::Value page(Json::arrayValue);
+    for (Json::UInt i = 0; i < limit; ++i)
+        page.append(offers[i]);
+    return page;
+}
+
+void
+OrderBookDB::setBookSnapshot(
+    ReadView const& ledger,
+    Book const& book,
+    bool takerIsIssuer,
+    bool complete,
+    Json::Value const& offers)
+{
+    assert(!ledger.open());
+
+    // Bound the memory the snapshots of one ledger can take
+    static std::size_t constexpr maxBooks = 1000;
+
+    std::lock_guard sl(snapshotLock_);
+    if (ledger.info().hash != snapshotHash_)
+    {
+        // Requests for older ledgers do not displace the newest one
+        if (ledger.seq() < snapshotSeq_)
+            return;
+
+        snapshotSeq_ = ledger.seq();
+        snapshotHash_ = ledger.info().hash;
+        for (auto& snapshots : snapshots_)
+            snapshots.clear();
+    }
+
+    auto& snapshots = snapshots_[takerIsIssuer];
+    if (auto const it = snapshots.find(book); it != snapshots.end())
+    {
+        // Keep whichever covers more of the book
+        if (it->second.complete || it->second.offers.size() >= offers.size())
+            return;
+        it->second = {offers, complete};
+    }
+    else if (snapshots.size() < maxBooks)
+    {
+        snapshots.emplace(book, BookSnapshot{offers, complete});
+    }
+}
+
 }  // namespace ripple
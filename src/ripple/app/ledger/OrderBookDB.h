@@ -25,10 +25,16 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/json/MultivarJson.h>
 
+#include <array>
 #include <mutex>
+#include <optional>
+#include <tuple>
+#include <vector>
 
 namespace ripple {
 
+class AcceptedLedger;
+
 class OrderBookDB
 {
 public:
@@ -39,6 +45,16 @@ public:
     void
     update(std::shared_ptr<ReadView const> const& ledger);
 
+    /** Bring the books up to date with a validated ledger.
+
+        The book directories and AMMs the ledger's transactions created
+        and deleted are read from their metadata, so the books keep up
+        with the network without walking the state map. Only the full
+        update at startup, or after a gap, walks it.
+    */
+    void
+    processLedger(AcceptedLedger const& ledger);
+
     void
     addOrderBook(Book const&);
 
@@ -60,6 +76,10 @@ public:
     BookListeners::pointer
     makeBookListeners(Book const&);
 
+    /** Whether any book has listeners to publish transactions to. */
+    bool
+    haveBookListeners();
+
     // see if this txn effects any orderbook
     void
     processTxn(
@@ -67,6 +87,37 @@ public:
         const AcceptedLedgerTx& alTx,
         MultiApiJson const& jvObj);
 
+    /** Get the offers at the top of a book in a closed ledger.
+
+        Only the newest ledger a snapshot was stored for is held, so the
+        page book_offers and book subscriptions build for a busy book is
+        built once for each ledger, not once for each request.
+
+        @param takerIsIssuer Whether the taker issues what the book pays
+                             out, which exempts the offers from the
+                             transfer fee.
+        @return the first `limit` offers, with their owner funds, if a
+                long enough snapshot is held.
+    */
+    std::optional<Json::Value>
+    getBookSnapshot(
+        ReadView const& ledger,
+        Book const& book,
+        bool takerIsIssuer,
+        unsigned int limit);
+
+    /** Keep the offers at the top of a book in a closed ledger.
+
+        @param complete Whether the offers are all that are in the book.
+    */
+    void
+    setBookSnapshot(
+        ReadView const& ledger,
+        Book const& book,
+        bool takerIsIssuer,
+        bool complete,
+        Json::Value const& offers);
+
 private:
     Application& app_;
 
@@ -76,6 +127,18 @@ private:
     // does an order book to XRP exist
     hash_set<Issue> xrpBooks_;
 
+    // The number of directory roots and AMMs each book has in the newest
+    // validated ledger processed
+    hash_map<Book, std::uint32_t> bookRoots_;
+
+    // The newest validated ledger the books are up to date with
+    LedgerIndex processedSeq_ = 0;
+
+    // While a full update walks a ledger, the changes made by the ledgers
+    // processed meanwhile, to apply to its result
+    bool updating_ = false;
+    std::vector<std::tuple<LedgerIndex, Book, int>> pending_;
+
     std::recursive_mutex mLock;
 
     using BookToListenersMap = hash_map<Book, BookListeners::pointer>;
@@ -84,6 +147,19 @@ private:
 
     std::atomic<std::uint32_t> seq_;
 
+    struct BookSnapshot
+    {
+        Json::Value offers;
+        bool complete = false;
+    };
+
+    std::mutex snapshotLock_;
+    // The ledger the snapshots are of
+    LedgerIndex snapshotSeq_ = 0;
+    uint256 snapshotHash_;
+    // Indexed by whether the taker issues what the book pays out
+    std::array<hash_map<Book, BookSnapshot>, 2> snapshots_;
+
     beast::Journal const j_;
 };
 
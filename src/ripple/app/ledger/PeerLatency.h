@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_PEERLATENCY_H_INCLUDED
+#define RIPPLE_APP_LEDGER_PEERLATENCY_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/overlay/Peer.h>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+/** Tracks how quickly each peer answers our requests for data.
+
+    Every reply updates a moving average of the peer's latency, and a
+    request that goes unanswered counts as a reply that took the penalty.
+    Callers rank peers by these averages to send their requests to the
+    ones that answer fastest. Peers that have not been measured are
+    assumed to take the default latency.
+*/
+class PeerLatency
+{
+public:
+    using duration = std::chrono::milliseconds;
+
+    /** Create the tracker.
+
+        @param initial The latency assumed for a peer not yet measured.
+        @param penalty The latency recorded for an unanswered request.
+        @param capacity The most peers to track before the oldest go.
+    */
+    PeerLatency(duration initial, duration penalty, std::size_t capacity);
+
+    /** Record that a peer answered after some time. */
+    void
+    reply(Peer::id_t id, duration elapsed);
+
+    /** Record that a peer did not answer in time. */
+    void
+    timeout(Peer::id_t id);
+
+    /** The estimated latency of a peer. */
+    duration
+    latency(Peer::id_t id) const;
+
+    /** Order peers from the fastest to the slowest. */
+    void
+    rank(std::vector<Peer::id_t>& ids) const;
+
+    /** The number of peers tracked. */
+    std::size_t
+    size() const;
+
+private:
+    struct Entry
+    {
+        duration latency;
+        std::uint64_t updated;
+    };
+
+    void
+    update(Peer::id_t id, duration sample);
+
+    duration const initial_;
+    duration const penalty_;
+    std::size_t const capacity_;
+
+    std::mutex mutable mutex_;
+    hash_map<Peer::id_t, Entry> peers_;
+    std::uint64_t updates_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
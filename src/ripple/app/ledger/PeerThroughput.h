@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_PEERTHROUGHPUT_H_INCLUDED
+#define RIPPLE_APP_LEDGER_PEERTHROUGHPUT_H_INCLUDED
+
+#include <ripple/basics/DecayingSample.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/beast/clock/abstract_clock.h>
+#include <ripple/overlay/Peer.h>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+/** Tracks how much useful ledger data each peer sends us.
+
+    Backfilling history keeps many ledgers in flight at once. Each one is
+    assigned to the peers that rank best here: those delivering the most
+    useful nodes per second, shared out by the acquisitions each already
+    serves. That stripes the ledgers over every peer that has them rather
+    than queueing them all behind the same few. Every peer is credited a
+    base rate, so those idle or not yet measured still get a share.
+*/
+class PeerThroughput
+{
+public:
+    using clock_type = beast::abstract_clock<std::chrono::steady_clock>;
+
+    /** Create the tracker.
+
+        @param clock The clock the rates are measured by.
+        @param base The rate, in nodes per second, credited to every peer.
+        @param capacity The most peers to track before the oldest go.
+    */
+    PeerThroughput(clock_type& clock, double base, std::size_t capacity);
+
+    /** Record that a peer sent us some useful nodes. */
+    void
+    received(Peer::id_t id, std::size_t nodes);
+
+    /** Record that a peer was given an acquisition to serve. */
+    void
+    assign(Peer::id_t id);
+
+    /** Record that an acquisition the peer served is finished. */
+    void
+    release(Peer::id_t id);
+
+    /** The rate, in nodes per second, the peer recently sent us. */
+    double
+    rate(Peer::id_t id) const;
+
+    /** The number of acquisitions the peer serves. */
+    std::size_t
+    assigned(Peer::id_t id) const;
+
+    /** Order peers from the best to assign work to, to the worst. */
+    void
+    rank(std::vector<Peer::id_t>& ids) const;
+
+    /** The number of peers tracked. */
+    std::size_t
+    size() const;
+
+private:
+    struct Entry
+    {
+        explicit Entry(clock_type::time_point now) : nodes(now)
+        {
+        }
+
+        DecayWindow<30, clock_type> nodes;
+        std::size_t assigned = 0;
+        std::uint64_t updated = 0;
+    };
+
+    Entry&
+    touch(Peer::id_t id, std::lock_guard<std::mutex> const&);
+
+    double
+    score(Peer::id_t id, std::lock_guard<std::mutex> const&) const;
+
+    clock_type& clock_;
+    double const base_;
+    std::size_t const capacity_;
+
+    std::mutex mutable mutex_;
+    hash_map<Peer::id_t, Entry> mutable peers_;
+    std::uint64_t updates_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
@@ -22,10 +22,16 @@
 
 #include <ripple/app/misc/Transaction.h>
 #include <ripple/basics/RangeSet.h>
+#include <ripple/basics/UnorderedContainers.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/shamap/SHAMapItem.h>
 #include <ripple/shamap/SHAMapTreeNode.h>
 
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
 namespace ripple {
 
 class Application;
@@ -72,7 +78,13 @@ public:
         SHAMapNodeType type,
         std::uint32_t uCommitLedger);
 
-    // return value: true = we had the transaction already
+    /** Note that a transaction was saved as part of a validated ledger.
+
+        The ledger is remembered for transactions in the most recent
+        ledgers, so looking one of them up does not need the database.
+
+        @return true if the transaction was already in the cache.
+    */
     bool
     inLedger(uint256 const& hash, std::uint32_t ledger);
 
@@ -86,8 +98,22 @@ public:
     getCache();
 
 private:
+    using TxPair =
+        std::pair<std::shared_ptr<Transaction>, std::shared_ptr<TxMeta>>;
+
+    // Load a recently validated transaction from its ledger
+    std::optional<TxPair>
+    fetchRecent(uint256 const& txnID);
+
+    // How many validated ledgers the recent transaction index covers
+    static constexpr std::uint32_t recentLedgers = 256;
+
     Application& mApp;
     TaggedCache<uint256, Transaction> mCache;
+
+    std::mutex recentMutex_;
+    hash_map<uint256, std::uint32_t> recentTxns_;
+    std::map<std::uint32_t, std::vector<uint256>> recentByLedger_;
 };
 
 }  // namespace ripple
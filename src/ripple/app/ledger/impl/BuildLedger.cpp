@@ -24,7 +24,14 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/CanonicalTXSet.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/protocol/Feature.h>
+#include <algorithm>
+#include <optional>
+#include <set>
+#include <thread>
+#include <vector>
 
 namespace ripple {
 
@@ -67,7 +74,11 @@ buildLedgerImpl(
         // Write the final version of all modified SHAMap
         // nodes to the node store to preserve the new LCL
 
-        int const asf = built->stateMap().flushDirty(hotACCOUNT_NODE);
+        auto const flushWorkers = app.config().FLUSH_WORKERS > 0
+            ? app.config().FLUSH_WORKERS
+            : std::clamp(std::thread::hardware_concurrency(), 1u, 8u);
+        int const asf =
+            built->stateMap().flushDirty(hotACCOUNT_NODE, flushWorkers);
         int const tmf = built->txMap().flushDirty(hotTRANSACTION_NODE);
         JLOG(j.debug()) << "Flushed " << asf << " accounts and " << tmf
                         << " transaction nodes";
@@ -83,6 +94,273 @@ buildLedgerImpl(
     return built;
 }
 
+namespace {
+
+// Transactions applied ahead of time are taken this many at a time. Each
+// is tried against the state before its batch, so a larger batch costs
+// more transactions applied again when they touch the same entries.
+constexpr std::size_t speculativeBatchSize = 128;
+
+/** A view that records what is read through it.
+
+    A transaction applied ahead of time sees the state as it stood before
+    its batch. What it read tells whether the transactions ahead of it in
+    the batch changed anything its outcome depended on.
+*/
+class RecordingView final : public ReadView
+{
+private:
+    ReadView const& base_;
+
+    // Keys read or tested for existence
+    mutable std::vector<uint256> keys_;
+
+    // Open intervals searched for the next key
+    mutable std::vector<std::pair<uint256, std::optional<uint256>>> ranges_;
+
+    // Set when a whole map may have been seen
+    mutable bool all_ = false;
+
+public:
+    explicit RecordingView(ReadView const& base) : base_(base)
+    {
+    }
+
+    /** Returns true if changes made after the reads could alter them.
+
+        @param changed Keys of the entries created, modified or deleted
+        @param addedOrRemoved Keys of the entries created or deleted
+    */
+    bool
+    conflicts(
+        hash_set<uint256> const& changed,
+        std::set<uint256> const& addedOrRemoved) const
+    {
+        if (changed.empty())
+            return false;
+
+        if (all_)
+            return true;
+
+        for (auto const& key : keys_)
+        {
+            if (changed.count(key))
+                return true;
+        }
+
+        for (auto const& [key, last] : ranges_)
+        {
+            auto const it = addedOrRemoved.upper_bound(key);
+            if (it != addedOrRemoved.end() && (!last || *it < *last))
+                return true;
+        }
+
+        return false;
+    }
+
+    // ReadView
+
+    LedgerInfo const&
+    info() const override
+    {
+        return base_.info();
+    }
+
+    bool
+    open() const override
+    {
+        return base_.open();
+    }
+
+    Fees const&
+    fees() const override
+    {
+        return base_.fees();
+    }
+
+    Rules const&
+    rules() const override
+    {
+        return base_.rules();
+    }
+
+    bool
+    exists(Keylet const& k) const override
+    {
+        keys_.push_back(k.key);
+        return base_.exists(k);
+    }
+
+    std::optional<key_type>
+    succ(key_type const& key, std::optional<key_type> const& last)
+        const override
+    {
+        ranges_.emplace_back(key, last);
+        return base_.succ(key, last);
+    }
+
+    std::shared_ptr<SLE const>
+    read(Keylet const& k) const override
+    {
+        keys_.push_back(k.key);
+        return base_.read(k);
+    }
+
+    void
+    prefetch(std::vector<key_type> const& keys) const override
+    {
+        base_.prefetch(keys);
+    }
+
+    STAmount
+    balanceHook(
+        AccountID const& account,
+        AccountID const& issuer,
+        STAmount const& amount) const override
+    {
+        return base_.balanceHook(account, issuer, amount);
+    }
+
+    std::uint32_t
+    ownerCountHook(AccountID const& account, std::uint32_t count)
+        const override
+    {
+        return base_.ownerCountHook(account, count);
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesBegin() const override
+    {
+        all_ = true;
+        return base_.slesBegin();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesEnd() const override
+    {
+        all_ = true;
+        return base_.slesEnd();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesUpperBound(key_type const& key) const override
+    {
+        all_ = true;
+        return base_.slesUpperBound(key);
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsBegin() const override
+    {
+        all_ = true;
+        return base_.txsBegin();
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsEnd() const override
+    {
+        all_ = true;
+        return base_.txsEnd();
+    }
+
+    bool
+    txExists(key_type const& key) const override
+    {
+        all_ = true;
+        return base_.txExists(key);
+    }
+
+    tx_type
+    txRead(key_type const& key) const override
+    {
+        all_ = true;
+        return base_.txRead(key);
+    }
+};
+
+/** A transaction applied ahead of time to a view of its own. */
+struct Speculation
+{
+    std::unique_ptr<RecordingView> reads;
+    std::optional<OpenView> view;
+    ApplyResult result = ApplyResult::Retry;
+
+    // False if the transaction was not tried or threw
+    bool tried = false;
+};
+
+/** Apply each transaction of a batch to a view of its own.
+
+    Every view sees `view` as it stands, and numbers its transaction as
+    if all of those ahead of it in the batch were applied successfully.
+*/
+std::vector<Speculation>
+speculate(
+    Application& app,
+    OpenView const& view,
+    std::vector<CanonicalTXSet::const_iterator> const& batch,
+    bool certainRetry,
+    std::size_t workers,
+    beast::Journal j)
+{
+    std::vector<Speculation> result(batch.size());
+
+    // Consensus ledgers are built by acceptLedger jobs, so the helpers
+    // are jobs of that type too
+    app.getJobQueue().parallelFor(
+        jtACCEPT,
+        "applyTransactions",
+        batch.size(),
+        workers,
+        [&](std::size_t i) {
+            auto const& tx = *batch[i]->second;
+
+            // Pseudo-transactions can act on the server as well as on the
+            // ledger, so they are only ever applied in order.
+            if (isPseudoTx(tx))
+                return;
+
+            auto& s = result[i];
+            try
+            {
+                s.reads = std::make_unique<RecordingView>(view);
+                s.view.emplace(
+                    speculative, s.reads.get(), view.txCount() + i);
+                s.result = applyTransaction(
+                    app, *s.view, tx, certainRetry, tapNONE, j);
+                s.tried = true;
+            }
+            catch (...)
+            {
+                // Applied again in order, which reports the failure
+            }
+        });
+
+    return result;
+}
+
+// Note the entries which a transaction applied to the view changed.
+void
+noteChanges(
+    OpenView const& view,
+    TxID const& txid,
+    hash_set<uint256>& changed,
+    std::set<uint256>& addedOrRemoved)
+{
+    auto const meta = view.txRead(txid).second;
+    assert(meta);
+
+    for (auto const& node : meta->getFieldArray(sfAffectedNodes))
+    {
+        auto const& key = node.getFieldH256(sfLedgerIndex);
+        changed.insert(key);
+        if (node.getFName() != sfModifiedNode)
+            addedOrRemoved.insert(key);
+    }
+}
+
+}  // namespace
+
 /** Apply a set of consensus transactions to a ledger.
 
   @param app Handle to application
@@ -91,6 +369,15 @@ buildLedgerImpl(
   @param view ledger to apply to
   @param j Journal for logging
   @return number of transactions applied; transactions to retry left in txns
+
+  With [apply_workers] set above one, transactions are taken in batches and
+  first applied on up to that many threads, the caller's and JobQueue
+  jobs', each to a view of its own over the state before the batch. They
+  are then settled in canonical order. The outcome found ahead of time is
+  kept when nothing the transaction read was changed by those settled
+  before it; otherwise it is applied again to `view`. Either way the
+  ledger is the one that applying them in order builds. The signatures
+  are checked up front on as many threads.
 */
 
 std::size_t
@@ -105,56 +392,155 @@ applyTransactions(
     bool certainRetry = true;
     std::size_t count = 0;
 
+    std::size_t const workers = std::max(app.config().APPLY_WORKERS, 1);
+    std::size_t const batchSize = workers > 1 ? speculativeBatchSize : 1;
+
+    // Transactions first seen in the consensus set have not had their
+    // signatures checked. Check them all on the same workers up front, so
+    // the passes below only look the results up.
+    {
+        std::vector<std::shared_ptr<STTx const>> txs;
+        txs.reserve(txns.size());
+        for (auto const& item : txns)
+            txs.push_back(item.second);
+
+        checkValidity(
+            app.getHashRouter(),
+            txs,
+            view.rules(),
+            app.config(),
+            app.getJobQueue(),
+            jtACCEPT,
+            workers);
+    }
+
     // Attempt to apply all of the retriable transactions
     for (int pass = 0; pass < LEDGER_TOTAL_PASSES; ++pass)
     {
         JLOG(j.debug()) << (certainRetry ? "Pass: " : "Final pass: ") << pass
                         << " begins (" << txns.size() << " transactions)";
         int changes = 0;
+        int reapplied = 0;
 
         auto it = txns.begin();
 
         while (it != txns.end())
         {
-            auto const txid = it->first.getTXID();
+            std::vector<CanonicalTXSet::const_iterator> batch;
 
-            try
+            while (it != txns.end() && batch.size() < batchSize)
             {
-                if (pass == 0 && built->txExists(txid))
+                auto const txid = it->first.getTXID();
+
+                try
                 {
+                    if (pass == 0 && built->txExists(txid))
+                    {
+                        it = txns.erase(it);
+                        continue;
+                    }
+
+                    batch.push_back(it++);
+                }
+                catch (std::exception const& ex)
+                {
+                    JLOG(j.warn())
+                        << "Transaction " << txid << " throws: " << ex.what();
+                    failed.insert(txid);
                     it = txns.erase(it);
+                }
+            }
+
+            std::vector<Speculation> speculated;
+            if (batch.size() > 1)
+                speculated =
+                    speculate(app, view, batch, certainRetry, workers, j);
+
+            // The entries changed by the transactions settled so far
+            hash_set<uint256> changed;
+            std::set<uint256> addedOrRemoved;
+            bool changesKnown = true;
+
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                auto const txid = batch[i]->first.getTXID();
+                auto result = ApplyResult::Retry;
+
+                try
+                {
+                    auto const* s =
+                        i < speculated.size() ? &speculated[i] : nullptr;
+
+                    if (s && s->tried && changesKnown &&
+                        !s->reads->conflicts(changed, addedOrRemoved) &&
+                        (s->result != ApplyResult::Success ||
+                         s->view->txCount() == view.txCount() + 1))
+                    {
+                        result = s->result;
+                        if (result == ApplyResult::Success)
+                            s->view->apply(view);
+                    }
+                    else
+                    {
+                        if (s && s->tried)
+                            ++reapplied;
+                        result = applyTransaction(
+                            app,
+                            view,
+                            *batch[i]->second,
+                            certainRetry,
+                            tapNONE,
+                            j);
+                    }
+                }
+                catch (std::exception const& ex)
+                {
+                    JLOG(j.warn())
+                        << "Transaction " << txid << " throws: " << ex.what();
+                    failed.insert(txid);
+                    txns.erase(batch[i]);
                     continue;
                 }
 
-                switch (applyTransaction(
-                    app, view, *it->second, certainRetry, tapNONE, j))
+                switch (result)
                 {
                     case ApplyResult::Success:
-                        it = txns.erase(it);
+                        txns.erase(batch[i]);
                         ++changes;
                         break;
 
                     case ApplyResult::Fail:
                         failed.insert(txid);
-                        it = txns.erase(it);
+                        txns.erase(batch[i]);
                         break;
 
                     case ApplyResult::Retry:
-                        ++it;
+                        break;
+                }
+
+                if (result == ApplyResult::Success && changesKnown &&
+                    i + 1 < speculated.size())
+                {
+                    try
+                    {
+                        noteChanges(view, txid, changed, addedOrRemoved);
+                    }
+                    catch (std::exception const&)
+                    {
+                        // Apply the rest of the batch in order
+                        changesKnown = false;
+                    }
                 }
-            }
-            catch (std::exception const& ex)
-            {
-                JLOG(j.warn())
-                    << "Transaction " << txid << " throws: " << ex.what();
-                failed.insert(txid);
-                it = txns.erase(it);
             }
         }
 
         JLOG(j.debug()) << (certainRetry ? "Pass: " : "Final pass: ") << pass
                         << " completed (" << changes << " changes)";
 
+        if (workers > 1)
+            JLOG(j.debug()) << "Pass: " << pass << " applied " << reapplied
+                            << " transactions again";
+
         // Accumulate changes.
         count += changes;
 
@@ -218,7 +604,9 @@ buildLedger(
     LedgerReplay const& replayData,
     ApplyFlags applyFlags,
     Application& app,
-    beast::Journal j)
+    beast::Journal j,
+    std::function<void(STTx const&, std::chrono::steady_clock::duration)> const&
+        onApplied)
 {
     auto const& replayLedger = replayData.replay();
 
@@ -233,7 +621,18 @@ buildLedger(
         j,
         [&](OpenView& accum, std::shared_ptr<Ledger> const& built) {
             for (auto& tx : replayData.orderedTxns())
+            {
+                if (!onApplied)
+                {
+                    applyTransaction(
+                        app, accum, *tx.second, false, applyFlags, j);
+                    continue;
+                }
+
+                auto const start = std::chrono::steady_clock::now();
                 applyTransaction(app, accum, *tx.second, false, applyFlags, j);
+                onApplied(*tx.second, std::chrono::steady_clock::now() - start);
+            }
         });
 }
 
@@ -80,12 +80,13 @@ InboundLedger::InboundLedger(
     std::uint32_t seq,
     Reason reason,
     clock_type& clock,
-    std::unique_ptr<PeerSet> peerSet)
+    std::unique_ptr<PeerSet> peerSet,
+    std::shared_ptr<PeerThroughput> throughput)
     : TimeoutCounter(
           app,
           hash,
           ledgerAcquireTimeout,
-          {jtLEDGER_DATA, "InboundLedger", 5},
+          {dataJobType(reason), "InboundLedger", 5},
           app.journal("InboundLedger"))
     , m_clock(clock)
     , mHaveHeader(false)
@@ -97,6 +98,7 @@ InboundLedger::InboundLedger(
     , mReason(reason)
     , mReceiveDispatched(false)
     , mPeerSet(std::move(peerSet))
+    , throughput_(std::move(throughput))
 {
     JLOG(journal_.trace()) << "Acquiring ledger " << hash_;
     touch();
@@ -222,6 +224,11 @@ InboundLedger::~InboundLedger()
         if (entry.second->type() == protocol::liAS_NODE)
             app_.getInboundLedgers().gotStaleData(entry.second);
     }
+    if (throughput_)
+    {
+        for (auto const id : assigned_)
+            throughput_->release(id);
+    }
     if (!isDone())
     {
         JLOG(journal_.debug())
@@ -452,15 +459,51 @@ InboundLedger::onTimer(bool wasProgress, ScopedLockType&)
 void
 InboundLedger::addPeers()
 {
+    auto const limit = (getPeerCount() == 0) ? peerCountStart : peerCountAdd;
+
+    auto const onPeerAdded = [this](auto peer) {
+        if (throughput_)
+        {
+            throughput_->assign(peer->id());
+            assigned_.push_back(peer->id());
+        }
+
+        // For historical nodes, do not trigger too soon
+        // since a fetch pack is probably coming
+        if (mReason != Reason::HISTORY)
+            trigger(peer, TriggerReason::added);
+    };
+
+    if (!throughput_)
+    {
+        mPeerSet->addPeers(
+            limit,
+            [this](auto peer) { return peer->hasLedger(hash_, mSeq); },
+            onPeerAdded);
+        return;
+    }
+
+    // Of the peers that have the ledger, count as having it only the ones
+    // that rank best for more work, so each ledger of a backfill goes to
+    // the least loaded of the fastest peers
+    std::vector<Peer::id_t> candidates;
+    app_.overlay().foreach([&](std::shared_ptr<Peer> const& peer) {
+        if (!mPeerSet->getPeerIds().count(peer->id()) &&
+            peer->hasLedger(hash_, mSeq))
+            candidates.push_back(peer->id());
+    });
+    throughput_->rank(candidates);
+    if (candidates.size() > limit)
+        candidates.resize(limit);
+
     mPeerSet->addPeers(
-        (getPeerCount() == 0) ? peerCountStart : peerCountAdd,
-        [this](auto peer) { return peer->hasLedger(hash_, mSeq); },
-        [this](auto peer) {
-            // For historical nodes, do not trigger too soon
-            // since a fetch pack is probably coming
-            if (mReason != Reason::HISTORY)
-                trigger(peer, TriggerReason::added);
-        });
+        limit,
+        [&candidates](auto peer) {
+            return std::find(
+                       candidates.begin(), candidates.end(), peer->id()) !=
+                candidates.end();
+        },
+        onPeerAdded);
 }
 
 std::weak_ptr<TimeoutCounter>
@@ -894,7 +937,10 @@ InboundLedger::takeHeader(std::string const& data)
     Call with a lock
 */
 void
-InboundLedger::receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode& san)
+InboundLedger::receiveNode(
+    protocol::TMLedgerData& packet,
+    std::optional<ReceivedNodes> nodes,
+    SHAMapAddNode& san)
 {
     if (!mHaveHeader)
     {
@@ -935,27 +981,47 @@ InboundLedger::receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode& san)
     {
         auto const f = filter.get();
 
-        for (auto const& node : packet.nodes())
-        {
-            auto const nodeID = deserializeSHAMapNodeID(node.nodeid());
+        // Replies are normally parsed and hashed before the lock is taken
+        if (!nodes)
+            nodes = parseNodes(map, packet);
+
+        // Runs of non-root nodes are added together, stopping at the first
+        // node that isn't good
+        auto& parsed = nodes->nodes;
+        auto first = parsed.begin();
 
-            if (!nodeID)
-                throw std::runtime_error("data does not properly deserialize");
+        auto const addNodes = [&](auto last) {
+            if (first == last)
+                return true;
 
-            if (nodeID->isRoot())
+            san += map.addKnownNodes(std::span(first, last), f);
+            return san.isGood();
+        };
+
+        for (auto iter = parsed.begin(); iter != parsed.end(); ++iter)
+        {
+            if (!iter->first.isRoot())
+                continue;
+
+            if (addNodes(iter))
             {
+                auto const& node = packet.nodes(iter - parsed.begin());
                 san += map.addRootNode(rootHash, makeSlice(node.nodedata()), f);
             }
-            else
-            {
-                san += map.addKnownNode(*nodeID, makeSlice(node.nodedata()), f);
-            }
 
             if (!san.isGood())
             {
                 JLOG(journal_.warn()) << "Received bad node data";
                 return;
             }
+
+            first = std::next(iter);
+        }
+
+        if (!addNodes(parsed.end()))
+        {
+            JLOG(journal_.warn()) << "Received bad node data";
+            return;
         }
     }
     catch (std::exception const& e)
@@ -1089,6 +1155,96 @@ InboundLedger::gotData(
     return true;
 }
 
+/** Parse and hash the nodes of a liTX_NODE or liAS_NODE reply for a map.
+    This does not need the lock. Throws if the reply is malformed.
+*/
+InboundLedger::ReceivedNodes
+InboundLedger::parseNodes(
+    SHAMap const& map,
+    protocol::TMLedgerData const& packet)
+{
+    ReceivedNodes result;
+    result.nodes.reserve(packet.nodes().size());
+
+    std::vector<Slice> rawNodes;
+    rawNodes.reserve(packet.nodes().size());
+
+    for (auto const& node : packet.nodes())
+    {
+        auto const nodeID = deserializeSHAMapNodeID(node.nodeid());
+
+        if (!nodeID)
+            throw std::runtime_error("data does not properly deserialize");
+
+        result.nodes.emplace_back(*nodeID, nullptr);
+        if (!nodeID->isRoot())
+            rawNodes.push_back(makeSlice(node.nodedata()));
+    }
+
+    auto parsed = map.parseNodes(rawNodes);
+    auto iter = parsed.begin();
+    for (auto& node : result.nodes)
+    {
+        if (!node.first.isRoot())
+            node.second = std::move(*iter++);
+    }
+
+    return result;
+}
+
+/** Parse the nodes of a batch of replies before they are processed
+    Replies are parsed by several jobs when there are several, so that
+    only adding the nodes to the ledger happens under the lock. A reply
+    that can't be parsed here is left to receiveNode, which reports the
+    error.
+*/
+std::vector<std::optional<InboundLedger::ReceivedNodes>>
+InboundLedger::parseData(ReceivedData const& data)
+{
+    std::vector<std::optional<ReceivedNodes>> result(data.size());
+
+    std::shared_ptr<Ledger> ledger;
+    bool haveTransactions;
+    bool haveState;
+
+    {
+        ScopedLockType sl(mtx_);
+
+        if (!mHaveHeader || failed_)
+            return result;
+
+        ledger = mLedger;
+        haveTransactions = mHaveTransactions;
+        haveState = mHaveState;
+    }
+
+    auto const parse = [&](std::size_t i) {
+        auto const& packet = *data[i].second;
+
+        SHAMap const* map = nullptr;
+        if (packet.type() == protocol::liTX_NODE && !haveTransactions)
+            map = &ledger->txMap();
+        else if (packet.type() == protocol::liAS_NODE && !haveState)
+            map = &ledger->stateMap();
+
+        if (!map || data[i].first.expired())
+            return;
+
+        try
+        {
+            result[i] = parseNodes(*map, packet);
+        }
+        catch (std::exception const&)
+        {
+        }
+    };
+
+    app_.getJobQueue().parallelFor(
+        jtLEDGER_DATA, "InboundLedger::parseData", data.size(), 4, parse);
+
+    return result;
+}
+
 /** Process one TMLedgerData
     Returns the number of useful nodes
 */
@@ -1100,7 +1256,8 @@ InboundLedger::gotData(
 int
 InboundLedger::processData(
     std::shared_ptr<Peer> peer,
-    protocol::TMLedgerData& packet)
+    protocol::TMLedgerData& packet,
+    std::optional<ReceivedNodes> nodes)
 {
     if (packet.type() == protocol::liBASE)
     {
@@ -1169,8 +1326,6 @@ InboundLedger::processData(
             return -1;
         }
 
-        ScopedLockType sl(mtx_);
-
         // Verify node IDs and data are complete
         for (auto const& node : packet.nodes())
         {
@@ -1182,8 +1337,10 @@ InboundLedger::processData(
             }
         }
 
+        ScopedLockType sl(mtx_);
+
         SHAMapAddNode san;
-        receiveNode(packet, san);
+        receiveNode(packet, std::move(nodes), san);
 
         JLOG(journal_.debug())
             << "Ledger "
@@ -1306,11 +1463,16 @@ InboundLedger::runData()
             data.swap(mReceivedData);
         }
 
-        for (auto& entry : data)
+        auto nodes = parseData(data);
+
+        for (std::size_t i = 0; i != data.size(); ++i)
         {
-            if (auto peer = entry.first.lock())
+            if (auto peer = data[i].first.lock())
             {
-                int count = processData(peer, *(entry.second));
+                int count =
+                    processData(peer, *data[i].second, std::move(nodes[i]));
+                if (throughput_ && count > 0)
+                    throughput_->received(peer->id(), count);
                 dataCounts.update(std::move(peer), count);
             }
         }
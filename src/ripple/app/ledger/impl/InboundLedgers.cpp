@@ -47,6 +47,12 @@ public:
     // How long before we try again to acquire the same ledger
     static constexpr std::chrono::minutes const kReacquireInterval{5};
 
+    // The rate, in nodes per second, every peer is credited for history
+    static constexpr double const kHistoryBaseRate{64};
+
+    // The most peers whose history throughput we track
+    static constexpr std::size_t const kHistoryPeers{128};
+
     InboundLedgersImp(
         Application& app,
         clock_type& clock,
@@ -59,6 +65,10 @@ public:
         , mRecentFailures(clock)
         , mCounter(collector->make_counter("ledger_fetches"))
         , mPeerSetBuilder(std::move(peerSetBuilder))
+        , mThroughput(std::make_shared<PeerThroughput>(
+              clock,
+              kHistoryBaseRate,
+              kHistoryPeers))
     {
     }
 
@@ -103,7 +113,11 @@ public:
                     seq,
                     reason,
                     std::ref(m_clock),
-                    mPeerSetBuilder->build());
+                    mPeerSetBuilder->build(),
+                    (reason == InboundLedger::Reason::HISTORY ||
+                     reason == InboundLedger::Reason::SHARD)
+                        ? mThroughput
+                        : nullptr);
                 mLedgers.emplace(hash, inbound);
                 inbound->init(sl);
                 ++mCounter;
@@ -190,7 +204,7 @@ public:
             // dispatch
             if (ledger->gotData(std::weak_ptr<Peer>(peer), packet))
                 app_.getJobQueue().addJob(
-                    jtLEDGER_DATA, "processLedgerData", [ledger]() {
+                    ledger->dataJobType(), "processLedgerData", [ledger]() {
                         ledger->runData();
                     });
 
@@ -433,6 +447,9 @@ private:
     beast::insight::Counter mCounter;
 
     std::unique_ptr<PeerSetBuilder> mPeerSetBuilder;
+
+    // Shared by the acquisitions of past ledgers, to spread them over peers
+    std::shared_ptr<PeerThroughput> mThroughput;
 };
 
 //------------------------------------------------------------------------------
@@ -37,8 +37,17 @@ enum {
 
     // How many rounds to keep a set
     setKeepRounds = 3,
+
+    // How many peers to remember the latency of
+    latencyPeers = 256,
 };
 
+// The latency assumed for a peer we have not asked for a set yet
+auto constexpr latencyInitial = std::chrono::milliseconds{100};
+
+// The latency recorded when a peer does not answer a request
+auto constexpr latencyPenalty = std::chrono::milliseconds{500};
+
 class InboundTransactionSet
 {
     // A transaction set we generated, acquired, or are acquiring
@@ -72,6 +81,10 @@ public:
         , m_gotSet(std::move(gotSet))
         , m_peerSetBuilder(std::move(peerSetBuilder))
         , j_(app_.journal("InboundTransactions"))
+        , latency_(std::make_shared<PeerLatency>(
+              latencyInitial,
+              latencyPenalty,
+              latencyPeers))
     {
         m_zeroSet.mSet = std::make_shared<SHAMap>(
             SHAMapType::TRANSACTION, uint256(), app_.getNodeFamily());
@@ -117,7 +130,7 @@ public:
                 return std::shared_ptr<SHAMap>();
 
             ta = std::make_shared<TransactionAcquire>(
-                app_, hash, m_peerSetBuilder->build());
+                app_, hash, m_peerSetBuilder->build(), latency_);
 
             auto& obj = m_map[hash];
             obj.mAcquire = ta;
@@ -259,6 +272,10 @@ private:
     std::unique_ptr<PeerSetBuilder> m_peerSetBuilder;
 
     beast::Journal j_;
+
+    // Shared by every acquisition, so what is learned about a peer in one
+    // round carries over to the next
+    std::shared_ptr<PeerLatency> latency_;
 };
 
 //------------------------------------------------------------------------------
@@ -22,8 +22,14 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/beast/core/CurrentThreadName.h>
+#include <ripple/core/impl/Workers.h>
 #include <ripple/protocol/jss.h>
 
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <thread>
+
 namespace ripple {
 
 /*
@@ -40,8 +46,11 @@ Cleans up the ledger. Specifically, resolves these issues:
 
 */
 
-class LedgerCleanerImp : public LedgerCleaner
+class LedgerCleanerImp : public LedgerCleaner, private Workers::Callback
 {
+    // The most workers the cleaner may be asked to run
+    static constexpr std::size_t maxWorkers = 16;
+
     Application& app_;
     beast::Journal const j_;
     mutable std::mutex mutex_;
@@ -69,10 +78,40 @@ class LedgerCleanerImp : public LedgerCleaner
     // Number of errors encountered since last success
     int failures_ = 0;
 
+    // The number of threads checking ledgers of the range at once
+    std::size_t workers_ = 1;
+
+    // The most ledgers to check per second, over all the workers, or zero
+    // to pause briefly after each one instead
+    std::uint32_t maxRate_ = 0;
+
+    // The next ledger of the range to hand out, counting down, and those
+    // that failed and are to be tried again
+    LedgerIndex next_ = 0;
+    std::set<LedgerIndex> retry_;
+
+    // The ledgers being checked now
+    std::set<LedgerIndex> busy_;
+
+    // When the next ledger may start, to keep to the rate
+    std::chrono::steady_clock::time_point nextStart_;
+
+    // The ledgers cleaned since the range was set, to report throughput
+    std::uint32_t cleaned_ = 0;
+    std::chrono::steady_clock::time_point started_;
+
+    // The workers other than the cleaner's own thread still cleaning
+    std::size_t helpers_ = 0;
+    std::condition_variable helpersDone_;
+
+    // The threads of the other workers, kept from one range to the next.
+    // Last, so the threads go before the state they use.
+    Workers pool_;
+
     //--------------------------------------------------------------------------
 public:
     LedgerCleanerImp(Application& app, beast::Journal journal)
-        : app_(app), j_(journal)
+        : app_(app), j_(journal), pool_(*this, nullptr, "LedgerCleaner", 0)
     {
     }
 
@@ -98,6 +137,7 @@ public:
             wakeup_.notify_one();
         }
         thread_.join();
+        pool_.stop();
     }
 
     //--------------------------------------------------------------------------
@@ -117,9 +157,11 @@ public:
         {
             map["status"] = "running";
             map["min_ledger"] = minRange_;
-            map["max_ledger"] = maxRange_;
+            map["max_ledger"] = remaining(lock);
             map["check_nodes"] = checkNodes_ ? "true" : "false";
             map["fix_txns"] = fixTxns_ ? "true" : "false";
+            map["workers"] = workers_;
+            map["cleaned"] = cleaned_;
             if (failures_ > 0)
                 map["fail_counts"] = failures_;
         }
@@ -146,6 +188,8 @@ public:
             checkNodes_ = false;
             fixTxns_ = false;
             failures_ = 0;
+            workers_ = 1;
+            maxRate_ = 0;
 
             /*
             JSON Parameters:
@@ -175,6 +219,16 @@ public:
                 "stop"
                     A boolean, when true informs the cleaner to gracefully
                     stop its current activities if any cleaning is taking place.
+
+                "workers"
+                    An unsigned integer, up to 16, of the ledgers to check at
+                    once. Defaults to 1.
+
+                "max_rate"
+                    An unsigned integer of the most ledgers to check per
+                    second, over all the workers, to bound the I/O the
+                    cleaner causes. By default each worker pauses briefly
+                    after each ledger.
             */
 
             // Quick way to fix a single ledger
@@ -201,14 +255,59 @@ public:
             if (params.isMember(jss::check_nodes))
                 checkNodes_ = params[jss::check_nodes].asBool();
 
+            if (params.isMember(jss::workers))
+                workers_ = std::clamp<std::size_t>(
+                    params[jss::workers].asUInt(), 1, maxWorkers);
+
+            if (params.isMember(jss::max_rate))
+                maxRate_ = params[jss::max_rate].asUInt();
+
             if (params.isMember(jss::stop) && params[jss::stop].asBool())
                 minRange_ = maxRange_ = 0;
 
+            next_ = maxRange_;
+            retry_.clear();
+            cleaned_ = 0;
+            started_ = nextStart_ = std::chrono::steady_clock::now();
+
             state_ = State::cleaning;
             wakeup_.notify_one();
         }
     }
 
+    Json::Value
+    getJson() const override
+    {
+        std::lock_guard lock(mutex_);
+
+        Json::Value ret(Json::objectValue);
+        if (maxRange_ == 0)
+        {
+            ret[jss::state] = "idle";
+            return ret;
+        }
+
+        ret[jss::state] = "running";
+        ret[jss::min_ledger] = minRange_;
+        ret[jss::max_ledger] = remaining(lock);
+        ret[jss::check_nodes] = checkNodes_;
+        ret[jss::fix_txns] = fixTxns_;
+        ret[jss::workers] = static_cast<Json::UInt>(workers_);
+        if (maxRate_ != 0)
+            ret[jss::max_rate] = maxRate_;
+        ret[jss::cleaned] = cleaned_;
+
+        using namespace std::chrono;
+        auto const elapsed =
+            duration<double>(steady_clock::now() - started_).count();
+        if (elapsed > 0)
+            ret[jss::ledgers_per_second] = cleaned_ / elapsed;
+
+        if (failures_ > 0)
+            ret[jss::fail_counts] = failures_;
+        return ret;
+    }
+
     //--------------------------------------------------------------------------
     //
     // LedgerCleanerImp
@@ -372,9 +471,63 @@ private:
         return ledgerHash;
     }
 
+    // The highest ledger of the range not yet cleaned
+    LedgerIndex
+    remaining(std::lock_guard<std::mutex> const&) const
+    {
+        LedgerIndex ret = std::max(next_, minRange_ ? minRange_ - 1 : 0);
+        if (!retry_.empty())
+            ret = std::max(ret, *retry_.rbegin());
+        if (!busy_.empty())
+            ret = std::max(ret, *busy_.rbegin());
+        return ret;
+    }
+
     /** Run the ledger cleaner. */
     void
     doLedgerCleaner()
+    {
+        std::size_t workers;
+        {
+            std::lock_guard lock(mutex_);
+            workers = workers_;
+        }
+
+        if (workers > 1)
+        {
+            auto const helpers = static_cast<int>(workers - 1);
+            if (pool_.getNumberOfThreads() < helpers)
+                pool_.setNumberOfThreads(helpers);
+
+            {
+                std::lock_guard lock(mutex_);
+                helpers_ = workers - 1;
+            }
+            pool_.addTasks(workers - 1);
+        }
+        cleanLedgers();
+
+        std::unique_lock lock(mutex_);
+        helpersDone_.wait(lock, [this] { return helpers_ == 0; });
+
+        // Unless a new range was set once the workers were done
+        if (retry_.empty() && next_ < minRange_)
+            minRange_ = maxRange_ = 0;
+    }
+
+    void
+    processTask(int) override
+    {
+        cleanLedgers();
+
+        std::lock_guard lock(mutex_);
+        if (--helpers_ == 0)
+            helpersDone_.notify_all();
+    }
+
+    /** Clean ledgers of the range until none is left to hand out. */
+    void
+    cleanLedgers()
     {
         auto shouldExit = [this] {
             std::lock_guard lock(mutex_);
@@ -389,6 +542,8 @@ private:
             LedgerHash ledgerHash;
             bool doNodes;
             bool doTxns;
+            bool paced;
+            std::chrono::steady_clock::time_point start;
 
             if (app_.getFeeTrack().isLoadedLocal())
             {
@@ -402,14 +557,40 @@ private:
                 if ((minRange_ > maxRange_) || (maxRange_ == 0) ||
                     (minRange_ == 0))
                 {
-                    minRange_ = maxRange_ = 0;
                     return;
                 }
-                ledgerIndex = maxRange_;
+
+                // Try the failed ledgers again first, then the highest not
+                // yet handed out
+                if (!retry_.empty())
+                {
+                    ledgerIndex = *retry_.rbegin();
+                    retry_.erase(ledgerIndex);
+                }
+                else if (next_ >= minRange_ && next_ <= maxRange_)
+                    ledgerIndex = next_--;
+                else
+                    return;
+
+                busy_.insert(ledgerIndex);
                 doNodes = checkNodes_;
                 doTxns = fixTxns_;
+
+                paced = maxRate_ != 0;
+                start = nextStart_;
+                if (paced)
+                {
+                    start = std::max(start, std::chrono::steady_clock::now());
+                    nextStart_ = start +
+                        std::chrono::steady_clock::duration(
+                            std::chrono::seconds(1)) /
+                            maxRate_;
+                }
             }
 
+            if (paced)
+                std::this_thread::sleep_until(start);
+
             ledgerHash = getHash(ledgerIndex, goodLedger);
 
             bool fail = false;
@@ -425,25 +606,34 @@ private:
                 fail = true;
             }
 
-            if (fail)
             {
+                std::lock_guard lock(mutex_);
+                busy_.erase(ledgerIndex);
+
+                // The range may have been reset while the ledger was checked
+                bool const inRange =
+                    ledgerIndex >= minRange_ && ledgerIndex <= maxRange_;
+                if (fail)
                 {
-                    std::lock_guard lock(mutex_);
                     ++failures_;
+                    if (inRange)
+                        retry_.insert(ledgerIndex);
                 }
+                else
+                {
+                    failures_ = 0;
+                    if (inRange)
+                        ++cleaned_;
+                }
+            }
+
+            if (fail)
+            {
                 // Wait for acquiring to catch up to us
                 std::this_thread::sleep_for(std::chrono::seconds(2));
             }
-            else
+            else if (!paced)
             {
-                {
-                    std::lock_guard lock(mutex_);
-                    if (ledgerIndex == minRange_)
-                        ++minRange_;
-                    if (ledgerIndex == maxRange_)
-                        --maxRange_;
-                    failures_ = 0;
-                }
                 // Reduce I/O pressure and wait for acquiring to catch up to us
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
             }
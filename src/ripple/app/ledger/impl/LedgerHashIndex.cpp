@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerHashIndex.h>
+
+namespace ripple {
+
+std::optional<LedgerHash>
+LedgerHashIndex::get(LedgerIndex seq) const
+{
+    std::shared_lock sl(mutex_);
+    if (seq < first_ || seq - first_ >= hashes_.size())
+        return std::nullopt;
+
+    auto const& hash = hashes_[seq - first_];
+    if (hash.isZero())
+        return std::nullopt;
+    return hash;
+}
+
+bool
+LedgerHashIndex::insert(LedgerIndex seq, LedgerHash const& hash)
+{
+    if (hash.isZero())
+        return false;
+
+    std::unique_lock sl(mutex_);
+    if (hashes_.empty())
+    {
+        first_ = seq;
+        hashes_.push_back(hash);
+        known_ = 1;
+        return true;
+    }
+
+    LedgerIndex const last = first_ + hashes_.size() - 1;
+    if (seq < first_)
+    {
+        if (first_ - seq - 1 > maxGap)
+            return false;
+        hashes_.insert(hashes_.begin(), first_ - seq, LedgerHash{});
+        first_ = seq;
+        hashes_.front() = hash;
+        ++known_;
+        return true;
+    }
+
+    if (seq > last)
+    {
+        if (seq - last - 1 > maxGap)
+            return false;
+        hashes_.resize(hashes_.size() + (seq - last));
+        hashes_.back() = hash;
+        ++known_;
+        return true;
+    }
+
+    auto& held = hashes_[seq - first_];
+    if (held.isZero())
+        ++known_;
+    held = hash;
+    return true;
+}
+
+void
+LedgerHashIndex::erase(LedgerIndex seq)
+{
+    std::unique_lock sl(mutex_);
+    if (seq < first_ || seq - first_ >= hashes_.size())
+        return;
+
+    auto& held = hashes_[seq - first_];
+    if (held.isZero())
+        return;
+    held.zero();
+    --known_;
+    trim(sl);
+}
+
+void
+LedgerHashIndex::clearPrior(LedgerIndex seq)
+{
+    std::unique_lock sl(mutex_);
+    while (!hashes_.empty() && first_ < seq)
+    {
+        if (hashes_.front().isNonZero())
+            --known_;
+        hashes_.pop_front();
+        ++first_;
+    }
+    trim(sl);
+}
+
+std::size_t
+LedgerHashIndex::size() const
+{
+    std::shared_lock sl(mutex_);
+    return known_;
+}
+
+void
+LedgerHashIndex::trim(std::unique_lock<std::shared_mutex> const&)
+{
+    while (!hashes_.empty() && hashes_.front().isZero())
+    {
+        hashes_.pop_front();
+        ++first_;
+    }
+    while (!hashes_.empty() && hashes_.back().isZero())
+        hashes_.pop_back();
+    if (hashes_.empty())
+        first_ = 0;
+}
+
+}  // namespace ripple
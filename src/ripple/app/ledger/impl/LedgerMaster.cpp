@@ -26,6 +26,7 @@
 #include <ripple/app/ledger/PendingSaves.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/AmendmentTable.h>
+#include <ripple/app/misc/GatewayBalancesIndex.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
@@ -36,6 +37,7 @@
 #include <ripple/app/paths/PathRequests.h>
 #include <ripple/app/rdb/backend/PostgresDatabase.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/basics/ByteUtilities.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/MathUtilities.h>
 #include <ripple/basics/TaggedCache.h>
@@ -52,6 +54,7 @@
 #include <ripple/protocol/HashPrefix.h>
 #include <ripple/protocol/digest.h>
 #include <ripple/resource/Fees.h>
+#include <ripple/shamap/SHAMapSnapshot.h>
 #include <algorithm>
 #include <cassert>
 #include <chrono>
@@ -199,8 +202,15 @@ LedgerMaster::LedgerMaster(
           std::chrono::seconds{45},
           stopwatch,
           app_.journal("TaggedCache"))
+    , fetchPackSegments_(
+          "FetchPackSegments",
+          0,
+          std::chrono::seconds{45},
+          stopwatch,
+          app_.journal("TaggedCache"))
     , m_stats(std::bind(&LedgerMaster::collect_metrics, this), collector)
 {
+    fetchPackSegments_.setTargetBytes(megabytes(32));
 }
 
 LedgerIndex
@@ -373,9 +383,13 @@ LedgerMaster::setValidLedger(std::shared_ptr<Ledger const> const& l)
         l->info().seq + max_ledger_difference_ > app_.getMaxDisallowedLedger());
     (void)max_ledger_difference_;
     mValidLedgerSeq = l->info().seq;
+    mHashIndex.insert(l->info().seq, l->info().hash);
 
     app_.getOPs().updateLocalTx(*l);
     app_.getSHAMapStore().onLedgerClosed(getValidatedLedger());
+    updateStateSnapshot(l);
+    if (auto const index = app_.getGatewayBalancesIndex())
+        index->onValidatedLedger(l);
     mLedgerHistory.validatedLedger(l, consensusHash);
     app_.getAmendmentTable().doValidatedLedger(l);
     if (!app_.getOPs().isBlocked())
@@ -413,6 +427,48 @@ LedgerMaster::setValidLedger(std::shared_ptr<Ledger const> const& l)
     }
 }
 
+void
+LedgerMaster::updateStateSnapshot(std::shared_ptr<Ledger const> const& l)
+{
+    auto const& config = app_.config();
+    if (config.STATE_SNAPSHOT_PATH.empty() ||
+        (l->info().seq % config.STATE_SNAPSHOT_INTERVAL) != 0)
+        return;
+
+    // Only one snapshot is written at a time
+    if (mSnapshotThread.test_and_set(std::memory_order_acquire))
+        return;
+
+    if (!app_.getJobQueue().addJob(
+            jtSNAPSHOT, "LedgerMaster::writeStateSnapshot", [this, l]() {
+                using namespace std::chrono;
+                try
+                {
+                    auto const start = steady_clock::now();
+                    auto const nodes = writeSHAMapSnapshot(
+                        l->stateMap(),
+                        l->info().seq,
+                        app_.config().STATE_SNAPSHOT_PATH);
+                    JLOG(m_journal.info())
+                        << "Wrote state snapshot of ledger " << l->info().seq
+                        << ": " << nodes << " inner nodes in "
+                        << duration_cast<milliseconds>(
+                               steady_clock::now() - start)
+                               .count()
+                        << "ms";
+                }
+                catch (std::exception const& e)
+                {
+                    JLOG(m_journal.warn())
+                        << "Unable to write state snapshot: " << e.what();
+                }
+                mSnapshotThread.clear(std::memory_order_release);
+            }))
+    {
+        mSnapshotThread.clear(std::memory_order_release);
+    }
+}
+
 void
 LedgerMaster::setPubLedger(std::shared_ptr<Ledger const> const& l)
 {
@@ -529,6 +585,7 @@ LedgerMaster::switchLCL(std::shared_ptr<Ledger const> const& lastClosed)
 bool
 LedgerMaster::fixIndex(LedgerIndex ledgerIndex, LedgerHash const& ledgerHash)
 {
+    mHashIndex.insert(ledgerIndex, ledgerHash);
     return mLedgerHistory.fixIndex(ledgerIndex, ledgerHash);
 }
 
@@ -629,6 +686,7 @@ LedgerMaster::isValidated(ReadView const& ledger)
                 if (valHash == ledger.info().hash)
                 {
                     // SQL database doesn't match ledger chain
+                    mHashIndex.insert(seq, *hash);
                     clearLedger(seq);
                 }
             }
@@ -942,6 +1000,11 @@ LedgerMaster::fixMismatch(ReadView const& ledger)
                 }
             }
 
+            // This ledger's skip list holds the hash the chain agrees on
+            if (hash)
+                mHashIndex.insert(lSeq, *hash);
+            else
+                mHashIndex.erase(lSeq);
             clearLedger(lSeq);
             ++invalidate;
         }
@@ -969,6 +1032,10 @@ LedgerMaster::setFullLedger(
     ledger->setValidated();
     ledger->setFull();
 
+    mHashIndex.insert(ledger->info().seq, ledger->info().hash);
+    if (ledger->info().seq > 1)
+        mHashIndex.insert(ledger->info().seq - 1, ledger->info().parentHash);
+
     if (isCurrent)
         mLedgerHistory.insert(ledger, true);
 
@@ -1120,6 +1187,7 @@ LedgerMaster::checkAccept(std::shared_ptr<Ledger const> const& ledger)
     ledger->setValidated();
     ledger->setFull();
     setValidLedger(ledger);
+    app_.getOPs().consensusQuorum(ledger->info().hash);
     if (!mPubLedger)
     {
         pendSaveValidated(app_, ledger, true, true);
@@ -1301,7 +1369,7 @@ LedgerMaster::consensusBuilt(
     for (auto const& v : validations)
     {
         valSeq& vs = count[v->getLedgerHash()];
-        vs.mergeValidation(v->getFieldU32(sfLedgerSequence));
+        vs.mergeValidation(v->getLedgerSeq());
     }
 
     auto const neededValidations = getNeededValidations();
@@ -1347,7 +1415,7 @@ LedgerMaster::getLedgerHashForHistory(
 
     if (l && l->info().seq >= index)
     {
-        ret = hashOfSeq(*l, index, m_journal);
+        ret = chainHashOfSeq(*l, index);
         if (!ret)
             ret = walkHashBySeq(index, l, reason);
     }
@@ -1358,6 +1426,17 @@ LedgerMaster::getLedgerHashForHistory(
     return ret;
 }
 
+std::optional<LedgerHash>
+LedgerMaster::chainHashOfSeq(ReadView const& ledger, LedgerIndex seq)
+{
+    if (ledger.info().validated && seq < ledger.info().seq)
+    {
+        if (auto const hash = mHashIndex.get(seq))
+            return hash;
+    }
+    return hashOfSeq(ledger, seq, m_journal);
+}
+
 std::vector<std::shared_ptr<Ledger const>>
 LedgerMaster::findNewLedgersToPublish(
     std::unique_lock<std::recursive_mutex>& sl)
@@ -1415,7 +1494,7 @@ LedgerMaster::findNewLedgersToPublish(
 
             std::shared_ptr<Ledger const> ledger;
             // This can throw
-            auto hash = hashOfSeq(*valLedger, seq, m_journal);
+            auto hash = chainHashOfSeq(*valLedger, seq);
             // VFALCO TODO Restructure this code so that zero is not
             // used.
             if (!hash)
@@ -1483,18 +1562,16 @@ LedgerMaster::findNewLedgersToPublish(
             }
             else
             {
-                auto numberLedgers =
-                    finishLedger->seq() - startLedger->seq() + 1;
-                JLOG(m_journal.debug())
-                    << "Publish LedgerReplays " << numberLedgers
-                    << " ledgers, from seq=" << startLedger->info().seq << ", "
-                    << startLedger->info().hash
-                    << " to seq=" << finishLedger->info().seq << ", "
-                    << finishLedger->info().hash;
-                app_.getLedgerReplayer().replay(
-                    InboundLedger::Reason::GENERIC,
-                    finishLedger->info().hash,
-                    numberLedgers);
+                try
+                {
+                    replayGap(
+                        *valLedger, startLedger->info(), finishLedger->info());
+                }
+                catch (std::exception const& ex)
+                {
+                    JLOG(m_journal.error())
+                        << "Exception while replaying ledgers: " << ex.what();
+                }
                 break;
             }
         }
@@ -1503,6 +1580,60 @@ LedgerMaster::findNewLedgersToPublish(
     return ret;
 }
 
+void
+LedgerMaster::replayGap(
+    ReadView const& valLedger,
+    LedgerInfo const& start,
+    LedgerInfo const& finish)
+{
+    using namespace LedgerReplayParameters;
+
+    // A task can only finish on a ledger whose hash the validated ledger
+    // proves: one of the last 256, or a flag ledger further back. Each task
+    // after the first starts on the ledger the one before it finishes on,
+    // and waits for that task rather than acquiring it. Their deltas are
+    // all acquired at once.
+    LedgerIndex seq = start.seq;
+    uint256 prior;
+    for (std::uint32_t i = 0; i < MAX_PIPELINED_TASKS && seq < finish.seq;
+         ++i)
+    {
+        LedgerIndex finishSeq = finish.seq;
+        uint256 finishHash = finish.hash;
+        if (finishSeq - seq + 1 > MAX_TASK_SIZE)
+        {
+            finishSeq = seq + MAX_TASK_SIZE - 1;
+            auto hash = chainHashOfSeq(valLedger, finishSeq);
+            if (!hash)
+            {
+                finishSeq = (seq | 0xff) + 1;
+                hash = chainHashOfSeq(valLedger, finishSeq);
+            }
+            if (!hash)
+            {
+                JLOG(m_journal.warn())
+                    << "Can't replay ledgers after " << seq
+                    << ": no hash for " << finishSeq;
+                return;
+            }
+            finishHash = *hash;
+        }
+
+        JLOG(m_journal.debug())
+            << "Publish LedgerReplays " << finishSeq - seq + 1
+            << " ledgers, from seq=" << seq << " to seq=" << finishSeq
+            << ", " << finishHash;
+        app_.getLedgerReplayer().replay(
+            InboundLedger::Reason::GENERIC,
+            finishHash,
+            finishSeq - seq + 1,
+            prior);
+
+        prior = finishHash;
+        seq = finishSeq;
+    }
+}
+
 void
 LedgerMaster::tryAdvance()
 {
@@ -1795,12 +1926,17 @@ LedgerMaster::getCloseTimeByHash(
 uint256
 LedgerMaster::getHashBySeq(std::uint32_t index)
 {
+    if (auto const hash = mHashIndex.get(index))
+        return *hash;
+
     uint256 hash = mLedgerHistory.getLedgerHash(index);
 
     if (hash.isNonZero())
         return hash;
 
-    return app_.getRelationalDatabase().getHashByIndex(index);
+    hash = app_.getRelationalDatabase().getHashByIndex(index);
+    mHashIndex.insert(index, hash);
+    return hash;
 }
 
 std::optional<LedgerHash>
@@ -1827,14 +1963,14 @@ LedgerMaster::walkHashBySeq(
     }
 
     // See if the hash for the ledger we need is in the reference ledger
-    auto ledgerHash = hashOfSeq(*referenceLedger, index, m_journal);
+    auto ledgerHash = chainHashOfSeq(*referenceLedger, index);
     if (ledgerHash)
         return ledgerHash;
 
     // The hash is not in the reference ledger. Get another ledger which can
     // be located easily and should contain the hash.
     LedgerIndex refIndex = getCandidateLedger(index);
-    auto const refHash = hashOfSeq(*referenceLedger, refIndex, m_journal);
+    auto const refHash = chainHashOfSeq(*referenceLedger, refIndex);
     assert(refHash);
     if (refHash)
     {
@@ -1845,7 +1981,7 @@ LedgerMaster::walkHashBySeq(
         {
             try
             {
-                ledgerHash = hashOfSeq(*ledger, index, m_journal);
+                ledgerHash = chainHashOfSeq(*ledger, index);
             }
             catch (SHAMapMissingNode const&)
             {
@@ -1859,7 +1995,7 @@ LedgerMaster::walkHashBySeq(
             if (auto const l = app_.getInboundLedgers().acquire(
                     *refHash, refIndex, reason))
             {
-                ledgerHash = hashOfSeq(*l, index, m_journal);
+                ledgerHash = chainHashOfSeq(*l, index);
                 assert(ledgerHash);
             }
         }
@@ -1880,7 +2016,7 @@ LedgerMaster::getLedgerBySeq(std::uint32_t index)
 
             try
             {
-                auto const hash = hashOfSeq(*valid, index, m_journal);
+                auto const hash = chainHashOfSeq(*valid, index);
 
                 if (hash)
                     return mLedgerHistory.getLedgerByHash(*hash);
@@ -1923,11 +2059,48 @@ LedgerMaster::setLedgerRangePresent(std::uint32_t minV, std::uint32_t maxV)
     mCompleteLedgers.insert(range(minV, maxV));
 }
 
+void
+LedgerMaster::loadHashIndex()
+{
+    auto& db = app_.getRelationalDatabase();
+    auto const minSeq = db.getMinLedgerSeq();
+    auto const maxSeq = db.getMaxLedgerSeq();
+    if (!minSeq || !maxSeq)
+        return;
+
+    // Load newest first, in bounded queries, so that if a gap in the
+    // database is too wide to index it is the oldest ledgers left out.
+    LedgerIndex constexpr chunk = 16384;
+    LedgerIndex hi = *maxSeq;
+    bool more = true;
+    while (more)
+    {
+        LedgerIndex const lo = hi - std::min(hi - *minSeq, chunk - 1);
+        auto const hashes = db.getHashesByIndex(lo, hi);
+        for (auto it = hashes.rbegin(); more && it != hashes.rend(); ++it)
+        {
+            if (!mHashIndex.insert(it->first, it->second.ledgerHash))
+            {
+                JLOG(m_journal.warn())
+                    << "Ledger hashes before " << it->first + 1
+                    << " are too far apart to index";
+                more = false;
+            }
+        }
+        more = more && lo != *minSeq;
+        hi = lo - 1;
+    }
+
+    JLOG(m_journal.info()) << "Indexed " << mHashIndex.size()
+                           << " ledger hashes";
+}
+
 void
 LedgerMaster::sweep()
 {
     mLedgerHistory.sweep();
     fetch_packs_.sweep();
+    fetchPackSegments_.sweep();
 }
 
 float
@@ -1936,9 +2109,23 @@ LedgerMaster::getCacheHitRate()
     return mLedgerHistory.getCacheHitRate();
 }
 
+float
+LedgerMaster::getHeaderCacheHitRate()
+{
+    return mLedgerHistory.getHeaderCacheHitRate();
+}
+
+std::size_t
+LedgerMaster::getCacheBytes() const
+{
+    return mLedgerHistory.getCacheBytes();
+}
+
 void
 LedgerMaster::clearPriorLedgers(LedgerIndex seq)
 {
+    mHashIndex.clearPrior(seq);
+
     std::lock_guard sl(mCompleteLock);
     if (seq > 0)
         mCompleteLedgers.erase(range(0u, seq - 1));
@@ -1962,6 +2149,17 @@ LedgerMaster::releaseReplay()
     return std::move(replayData);
 }
 
+std::uint32_t
+LedgerMaster::historyWindow()
+{
+    // Widen the window while the server keeps up with its writes and with
+    // the data of the past ledgers already in flight
+    if (app_.getNodeStore().getWriteLoad() < MAX_WRITE_LOAD_ACQUIRE / 4 &&
+        app_.getJobQueue().getJobCount(jtHISTORY_DATA) < 4)
+        return ledger_fetch_size_ * 4;
+    return ledger_fetch_size_;
+}
+
 void
 LedgerMaster::fetchForHistory(
     std::uint32_t missing,
@@ -2039,24 +2237,31 @@ LedgerMaster::fetchForHistory(
         }
         else
         {
-            std::uint32_t fetchSz;
+            std::uint32_t first;
             if (reason == InboundLedger::Reason::SHARD)
                 // Do not fetch ledger sequences lower
                 // than the shard's first ledger sequence
-                fetchSz = app_.getShardStore()->firstLedgerSeq(
+                first = app_.getShardStore()->firstLedgerSeq(
                     app_.getShardStore()->seqToShardIndex(missing));
             else
                 // Do not fetch ledger sequences lower
                 // than the earliest ledger sequence
-                fetchSz = app_.getNodeStore().earliestLedgerSeq();
-            fetchSz = missing >= fetchSz
-                ? std::min(ledger_fetch_size_, (missing - fetchSz) + 1)
-                : 0;
+                first = app_.getNodeStore().earliestLedgerSeq();
             try
             {
-                for (std::uint32_t i = 0; i < fetchSz; ++i)
+                // Keep a window of the ledgers from the missing one down in
+                // flight, skipping over those we already have
+                auto const window = historyWindow();
+                std::uint32_t fetched = 0;
+                for (auto seq = missing; seq >= first && fetched < window &&
+                     missing - seq < 2 * window;
+                     --seq)
                 {
-                    std::uint32_t seq = missing - i;
+                    if (seq != missing &&
+                        reason == InboundLedger::Reason::HISTORY &&
+                        haveLedger(seq))
+                        continue;
+                    ++fetched;
                     if (auto h = getLedgerHashForHistory(seq, reason))
                     {
                         assert(h->isNonZero());
@@ -2278,6 +2483,42 @@ populateFetchPack(
         });
 }
 
+std::shared_ptr<LedgerMaster::FetchPackSegment>
+LedgerMaster::makeFetchPackSegment(Ledger const& want, Ledger const& have) const
+{
+    std::uint32_t const lSeq = want.info().seq;
+
+    protocol::TMGetObjectByHash into;
+
+    {
+        // Serialize the ledger header:
+        Serializer hdr(128);
+
+        hdr.add32(HashPrefix::ledgerMaster);
+        addRaw(want.info(), hdr);
+
+        // Add the data
+        protocol::TMIndexedObject* obj = into.add_objects();
+        obj->set_hash(want.info().hash.data(), want.info().hash.size());
+        obj->set_data(hdr.getDataPtr(), hdr.getLength());
+        obj->set_ledgerseq(lSeq);
+    }
+
+    populateFetchPack(want.stateMap(), &have.stateMap(), 16384, &into, lSeq);
+
+    // We use nullptr here because transaction maps are per ledger
+    // and so the requestor is unlikely to already have it.
+    if (want.info().txHash.isNonZero())
+        populateFetchPack(want.txMap(), nullptr, 512, &into, lSeq);
+
+    auto segment = std::make_shared<FetchPackSegment>();
+    segment->objects.Swap(into.mutable_objects());
+    segment->bytes = sizeof(FetchPackSegment);
+    for (auto const& obj : segment->objects)
+        segment->bytes += sizeof(obj) + obj.hash().size() + obj.data().size();
+    return segment;
+}
+
 void
 LedgerMaster::makeFetchPack(
     std::weak_ptr<Peer> const& wPeer,
@@ -2341,8 +2582,6 @@ LedgerMaster::makeFetchPack(
 
     try
     {
-        Serializer hdr(128);
-
         protocol::TMGetObjectByHash reply;
         reply.set_query(false);
 
@@ -2353,54 +2592,116 @@ LedgerMaster::makeFetchPack(
         reply.set_type(protocol::TMGetObjectByHash::otFETCH_PACK);
 
         // Building a fetch pack:
-        //  1. Add the header for the requested ledger.
-        //  2. Add the nodes for the AccountStateMap of that ledger.
-        //  3. If there are transactions, add the nodes for the
-        //     transactions of the ledger.
-        //  4. If the FetchPack now contains at least 512 entries then stop.
-        //  5. If not very much time has elapsed, then loop back and repeat
-        //     the same process adding the previous ledger to the FetchPack.
+        //  1. Gather the next few ledgers, walking back from the one
+        //     requested, and make the segment of each one that is not
+        //     cached, in parallel. A segment holds the header of the
+        //     ledger, the nodes for its AccountStateMap and, if there are
+        //     transactions, the nodes for them.
+        //  2. Add the segments to the FetchPack in order and send what we
+        //     have, so the peer can start on it while we make more.
+        //  3. If the FetchPack now holds at least 512 entries then stop.
+        //  4. If not very much time has elapsed, then loop back and repeat
+        //     the same process with the ledgers before those.
+        std::size_t const perRound = 4;
+
+        struct Pending
+        {
+            std::shared_ptr<Ledger const> want;
+            std::shared_ptr<Ledger const> have;
+            uint256 key;
+        };
+
+        std::vector<Pending> round;
+        std::vector<std::shared_ptr<FetchPackSegment>> segments;
+        std::size_t objects = 0;
+        std::size_t bytes = 0;
+        std::size_t built = 0;
+        bool full = false;
+
         do
         {
-            std::uint32_t lSeq = want->info().seq;
+            round.clear();
+            while (want && round.size() < perRound)
+            {
+                auto parent = getLedgerByHash(want->info().parentHash);
+                auto key = sha512Half(want->info().hash, have->info().hash);
+                round.push_back({want, have, key});
+                have = std::move(want);
+                want = std::move(parent);
+            }
 
+            segments.assign(round.size(), nullptr);
+            std::vector<std::size_t> missing;
+            for (std::size_t i = 0; i < round.size(); ++i)
             {
-                // Serialize the ledger header:
-                hdr.erase();
-
-                hdr.add32(HashPrefix::ledgerMaster);
-                addRaw(want->info(), hdr);
-
-                // Add the data
-                protocol::TMIndexedObject* obj = reply.add_objects();
-                obj->set_hash(
-                    want->info().hash.data(), want->info().hash.size());
-                obj->set_data(hdr.getDataPtr(), hdr.getLength());
-                obj->set_ledgerseq(lSeq);
+                segments[i] = fetchPackSegments_.fetch(
+                    round[i].key, round[i].want->info().seq);
+                if (!segments[i])
+                    missing.push_back(i);
             }
 
-            populateFetchPack(
-                want->stateMap(), &have->stateMap(), 16384, &reply, lSeq);
+            // A segment that fails to build is left empty, and the pack
+            // ends before it. The other segments are built by jobs of
+            // another type, since this is the only jtPACK job that may run.
+            app_.getJobQueue().parallelFor(
+                jtLEDGER_REQ,
+                "LedgerMaster::makeFetchPack",
+                missing.size(),
+                perRound,
+                [&](std::size_t i) {
+                    auto const& p = round[missing[i]];
+                    try
+                    {
+                        segments[missing[i]] =
+                            makeFetchPackSegment(*p.want, *p.have);
+                    }
+                    catch (std::exception const& ex)
+                    {
+                        JLOG(m_journal.warn())
+                            << "Exception building fetch pack segment for "
+                            << p.want->info().seq << ": " << ex.what();
+                    }
+                });
+
+            for (auto const i : missing)
+            {
+                if (segments[i])
+                    fetchPackSegments_.canonicalize_replace_client(
+                        round[i].key, segments[i], round[i].want->info().seq);
+            }
+            built += missing.size();
 
-            // We use nullptr here because transaction maps are per ledger
-            // and so the requestor is unlikely to already have it.
-            if (want->info().txHash.isNonZero())
-                populateFetchPack(want->txMap(), nullptr, 512, &reply, lSeq);
+            for (auto const& segment : segments)
+            {
+                if (!segment)
+                {
+                    full = true;
+                    break;
+                }
 
-            if (reply.objects().size() >= 512)
-                break;
+                reply.mutable_objects()->MergeFrom(segment->objects);
 
-            have = std::move(want);
-            want = getLedgerByHash(have->info().parentHash);
-        } while (want && UptimeClock::now() <= uptime + 1s);
+                if (objects + reply.objects().size() >= 512)
+                {
+                    full = true;
+                    break;
+                }
+            }
 
-        auto msg = std::make_shared<Message>(reply, protocol::mtGET_OBJECTS);
+            if (!reply.objects().empty())
+            {
+                auto msg =
+                    std::make_shared<Message>(reply, protocol::mtGET_OBJECTS);
+                objects += reply.objects().size();
+                bytes += msg->getBufferSize();
+                peer->send(msg);
+                reply.clear_objects();
+            }
+        } while (!full && want && UptimeClock::now() <= uptime + 1s);
 
         JLOG(m_journal.info())
-            << "Built fetch pack with " << reply.objects().size() << " nodes ("
-            << msg->getBufferSize() << " bytes)";
-
-        peer->send(msg);
+            << "Built fetch pack with " << objects << " nodes (" << bytes
+            << " bytes, " << built << " segments built)";
     }
     catch (std::exception const& ex)
     {
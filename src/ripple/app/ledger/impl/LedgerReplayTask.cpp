@@ -86,7 +86,8 @@ LedgerReplayTask::LedgerReplayTask(
     InboundLedgers& inboundLedgers,
     LedgerReplayer& replayer,
     std::shared_ptr<SkipListAcquire>& skipListAcquirer,
-    TaskParameter&& parameter)
+    TaskParameter&& parameter,
+    std::shared_ptr<LedgerReplayTask> const& prior)
     : TimeoutCounter(
           app,
           parameter.finishHash_,
@@ -103,6 +104,7 @@ LedgerReplayTask::LedgerReplayTask(
           parameter.totalLedgers_ *
               LedgerReplayParameters::TASK_MAX_TIMEOUTS_MULTIPLIER))
     , skipListAcquirer_(skipListAcquirer)
+    , prior_(prior)
 {
     JLOG(journal_.trace()) << "Create " << hash_;
 }
@@ -152,6 +154,22 @@ LedgerReplayTask::trigger(ScopedLockType& sl)
     if (!parent_)
     {
         parent_ = app_.getLedgerMaster().getLedgerByHash(parameter_.startHash_);
+        if (auto const prior = prior_.lock(); !parent_ && prior)
+        {
+            // The start ledger is being built by an earlier task, so wait
+            // for it rather than acquire the whole ledger
+            if (!prior->finished())
+            {
+                JLOG(journal_.trace()) << "Task " << hash_ << " waiting for "
+                                       << parameter_.startHash_;
+                return;
+            }
+
+            if (auto const l = prior->finishLedger();
+                l && l->info().hash == parameter_.startHash_)
+                parent_ = l;
+            prior_.reset();
+        }
         if (!parent_)
         {
             parent_ = inboundLedgers_.acquire(
@@ -303,4 +321,13 @@ LedgerReplayTask::finished() const
     return isDone();
 }
 
+std::shared_ptr<Ledger const>
+LedgerReplayTask::finishLedger() const
+{
+    ScopedLockType sl(mtx_);
+    if (!complete_)
+        return {};
+    return parent_;
+}
+
 }  // namespace ripple
@@ -22,6 +22,8 @@
 #include <ripple/app/ledger/impl/SkipListAcquire.h>
 #include <ripple/core/JobQueue.h>
 
+#include <algorithm>
+
 namespace ripple {
 
 LedgerReplayer::LedgerReplayer(
@@ -45,7 +47,8 @@ void
 LedgerReplayer::replay(
     InboundLedger::Reason r,
     uint256 const& finishLedgerHash,
-    std::uint32_t totalNumLedgers)
+    std::uint32_t totalNumLedgers,
+    uint256 const& priorFinishHash)
 {
     assert(
         finishLedgerHash.isNonZero() && totalNumLedgers > 0 &&
@@ -97,8 +100,25 @@ LedgerReplayer::replay(
             newSkipList = true;
         }
 
+        std::shared_ptr<LedgerReplayTask> prior;
+        if (priorFinishHash.isNonZero())
+        {
+            auto const i = std::find_if(
+                tasks_.begin(), tasks_.end(), [&](auto const& t) {
+                    return t->getTaskParameter().finishHash_ ==
+                        priorFinishHash;
+                });
+            if (i != tasks_.end())
+                prior = *i;
+        }
+
         task = std::make_shared<LedgerReplayTask>(
-            app_, inboundLedgers_, *this, skipList, std::move(parameter));
+            app_,
+            inboundLedgers_,
+            *this,
+            skipList,
+            std::move(parameter),
+            prior);
         tasks_.push_back(task);
     }
 
@@ -28,6 +28,7 @@
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/DeliveredAmount.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
+#include <chrono>
 
 namespace ripple {
 
@@ -312,7 +313,10 @@ fillJsonQueue(Object& json, LedgerFill const& fill)
         if (fill.context->apiVersion > 1)
             copyFrom(txJson, temp);
         else
-            copyFrom(txJson[jss::tx], temp);
+        {
+            auto&& tx = Json::addObject(txJson, jss::tx);
+            copyFrom(tx, temp);
+        }
     }
 }
 
@@ -353,6 +357,18 @@ addJson(Json::Value& json, LedgerFill const& fill)
         fillJsonQueue(json, fill);
 }
 
+void
+addJson(Json::Object& json, LedgerFill const& fill)
+{
+    {
+        auto&& object = Json::addObject(json, jss::ledger);
+        fillJson(object, fill);
+    }
+
+    if ((fill.options & LedgerFill::dumpQueue) && !fill.txQueue.empty())
+        fillJsonQueue(json, fill);
+}
+
 Json::Value
 getJson(LedgerFill const& fill)
 {
@@ -361,4 +377,32 @@ getJson(LedgerFill const& fill)
     return json;
 }
 
+std::size_t
+streamJson(
+    LedgerFill const& fill,
+    Json::Output const& output,
+    beast::Journal j)
+{
+    using namespace std::chrono;
+
+    std::size_t bytes = 0;
+    auto const start = steady_clock::now();
+    {
+        Json::Writer writer([&](boost::beast::string_view const& b) {
+            bytes += b.size();
+            output(b);
+        });
+        Json::Object::Root root(writer);
+        fillJson(root, fill);
+    }
+    auto const elapsed =
+        duration_cast<microseconds>(steady_clock::now() - start);
+
+    JLOG(j.debug()) << "Streamed ledger " << fill.ledger.seq() << ": " << bytes
+                    << " bytes in " << elapsed.count() << "us ("
+                    << (elapsed.count() ? bytes * 1000000 / elapsed.count() : 0)
+                    << " bytes/s)";
+    return bytes;
+}
+
 }  // namespace ripple
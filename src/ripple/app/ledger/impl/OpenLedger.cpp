@@ -34,9 +34,15 @@ namespace ripple {
 OpenLedger::OpenLedger(
     std::shared_ptr<Ledger const> const& ledger,
     CachedSLEs& cache,
+    Family& family,
     beast::Journal journal)
-    : j_(journal), cache_(cache), current_(create(ledger->rules(), ledger))
+    : j_(journal)
+    , cache_(cache)
+    , current_(create(ledger->rules(), ledger))
+    , txSet_(std::make_shared<SHAMap>(SHAMapType::TRANSACTION, family))
 {
+    txSet_->setUnbacked();
+    txSet_->setItemArena();
 }
 
 bool
@@ -53,16 +59,28 @@ OpenLedger::current() const
     return current_;
 }
 
+std::pair<std::shared_ptr<OpenView const>, std::shared_ptr<SHAMap>>
+OpenLedger::currentWithTxSet() const
+{
+    // Both change only under this lock
+    std::lock_guard lock(modify_mutex_);
+    return {current_, txSet_->snapShot(true)};
+}
+
 bool
 OpenLedger::modify(modify_type const& f)
 {
     std::lock_guard lock1(modify_mutex_);
-    auto next = std::make_shared<OpenView>(*current_);
+    // Record the changes in a layer on top of the current view instead
+    // of copying it, so the cost is proportional to the changes made.
+    auto next = std::make_shared<OpenView>(layered, current_);
     auto const changed = f(*next, j_);
     if (changed)
     {
+        addTxs(*txSet_, *next);
+        auto collapsed = OpenView::collapse(std::move(next));
         std::lock_guard lock2(current_mutex_);
-        current_ = std::move(next);
+        current_ = std::move(collapsed);
     }
     return changed;
 }
@@ -136,6 +154,15 @@ OpenLedger::accept(
         }
     }
 
+    preflights_.rotate();
+
+    auto txSet = std::make_shared<SHAMap>(
+        SHAMapType::TRANSACTION, txSet_->family());
+    txSet->setUnbacked();
+    txSet->setItemArena();
+    addTxs(*txSet, *next);
+    txSet_ = std::move(txSet);
+
     // Switch to the new open view
     std::lock_guard lock2(current_mutex_);
     current_ = std::move(next);
@@ -143,6 +170,19 @@ OpenLedger::accept(
 
 //------------------------------------------------------------------------------
 
+void
+OpenLedger::addTxs(SHAMap& txSet, OpenView const& layer)
+{
+    layer.forEachLayerTx([&txSet](uint256 const& key, Slice txn) {
+        txSet.addItem(
+            SHAMapNodeType::tnTRANSACTION_NM, txSet.makeItem(key, txn));
+    });
+
+    // Hash the changed nodes now; a later snapshot has only to hash
+    // what changes after this
+    txSet.getHash();
+}
+
 std::shared_ptr<OpenView>
 OpenLedger::create(
     Rules const& rules,
@@ -165,8 +205,16 @@ OpenLedger::apply_one(
 {
     if (retry)
         flags = flags | tapRETRY;
+
+    // As ripple::apply, but with the preflight result kept across accepts
+    CachedSLEs::Scope const caller{CachedSLEs::Caller::transaction};
+    STAmountSO stAmountSO{view.rules().enabled(fixSTAmountCanonicalize)};
+    NumberSO stNumberSO{view.rules().enabled(fixUniversalNumber)};
+    auto const preflighted = preflights_.get(app, view.rules(), tx, flags, j);
+
     // If it's in anybody's proposed set, try to keep it in the ledger
-    auto const result = ripple::apply(app, view, *tx, flags, j);
+    auto const result =
+        doApply(preclaim(preflighted.second, app, view), app, view);
     if (result.second || result.first == terQUEUED)
         return Result::success;
     if (isTefFailure(result.first) || isTemMalformed(result.first) ||
@@ -177,6 +225,52 @@ OpenLedger::apply_one(
 
 //------------------------------------------------------------------------------
 
+auto
+OpenLedger::Preflights::get(
+    Application& app,
+    Rules const& rules,
+    std::shared_ptr<STTx const> const& tx,
+    ApplyFlags flags,
+    beast::Journal j) -> value_type
+{
+    auto const id = tx->getTransactionID();
+    auto const usable = [&](value_type const& kept) {
+        return kept.second.rules == rules && kept.second.flags == flags;
+    };
+
+    {
+        std::lock_guard lock(mutex_);
+
+        if (auto const it = recent_.find(id); it != recent_.end())
+        {
+            if (usable(it->second))
+                return it->second;
+        }
+        else if (auto node = previous_.extract(id))
+        {
+            if (usable(node.mapped()))
+                return recent_.insert(std::move(node)).position->second;
+        }
+    }
+
+    value_type result{tx, preflight(app, rules, *tx, flags, j)};
+
+    std::lock_guard lock(mutex_);
+    recent_.erase(id);
+    recent_.emplace(id, result);
+    return result;
+}
+
+void
+OpenLedger::Preflights::rotate()
+{
+    std::lock_guard lock(mutex_);
+    previous_ = std::move(recent_);
+    recent_.clear();
+}
+
+//------------------------------------------------------------------------------
+
 std::string
 debugTxstr(std::shared_ptr<STTx const> const& tx)
 {
@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/PeerLatency.h>
+
+#include <algorithm>
+
+namespace ripple {
+
+PeerLatency::PeerLatency(
+    duration initial,
+    duration penalty,
+    std::size_t capacity)
+    : initial_(initial), penalty_(penalty), capacity_(capacity)
+{
+}
+
+void
+PeerLatency::reply(Peer::id_t id, duration elapsed)
+{
+    update(id, elapsed);
+}
+
+void
+PeerLatency::timeout(Peer::id_t id)
+{
+    update(id, penalty_);
+}
+
+PeerLatency::duration
+PeerLatency::latency(Peer::id_t id) const
+{
+    std::lock_guard lock(mutex_);
+    if (auto const it = peers_.find(id); it != peers_.end())
+        return it->second.latency;
+    return initial_;
+}
+
+void
+PeerLatency::rank(std::vector<Peer::id_t>& ids) const
+{
+    std::lock_guard lock(mutex_);
+    auto const latencyOf = [this](Peer::id_t id) {
+        if (auto const it = peers_.find(id); it != peers_.end())
+            return it->second.latency;
+        return initial_;
+    };
+    std::stable_sort(
+        ids.begin(), ids.end(), [&](Peer::id_t lhs, Peer::id_t rhs) {
+            return latencyOf(lhs) < latencyOf(rhs);
+        });
+}
+
+std::size_t
+PeerLatency::size() const
+{
+    std::lock_guard lock(mutex_);
+    return peers_.size();
+}
+
+void
+PeerLatency::update(Peer::id_t id, duration sample)
+{
+    std::lock_guard lock(mutex_);
+    auto const [it, inserted] =
+        peers_.try_emplace(id, Entry{sample, ++updates_});
+    if (!inserted)
+    {
+        // Weigh the new sample by a quarter, as TCP does for round trips
+        it->second.latency = (3 * it->second.latency + sample) / 4;
+        it->second.updated = updates_;
+        return;
+    }
+
+    // Peer ids are never reused, so drop the peer updated longest ago
+    if (peers_.size() > capacity_)
+    {
+        peers_.erase(std::min_element(
+            peers_.begin(), peers_.end(), [](auto const& lhs, auto const& rhs) {
+                return lhs.second.updated < rhs.second.updated;
+            }));
+    }
+}
+
+}  // namespace ripple
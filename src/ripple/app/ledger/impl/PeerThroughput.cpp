@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/PeerThroughput.h>
+
+#include <algorithm>
+
+namespace ripple {
+
+PeerThroughput::PeerThroughput(
+    clock_type& clock,
+    double base,
+    std::size_t capacity)
+    : clock_(clock), base_(base), capacity_(capacity)
+{
+}
+
+void
+PeerThroughput::received(Peer::id_t id, std::size_t nodes)
+{
+    std::lock_guard lock(mutex_);
+    touch(id, lock).nodes.add(nodes, clock_.now());
+}
+
+void
+PeerThroughput::assign(Peer::id_t id)
+{
+    std::lock_guard lock(mutex_);
+    ++touch(id, lock).assigned;
+}
+
+void
+PeerThroughput::release(Peer::id_t id)
+{
+    std::lock_guard lock(mutex_);
+    if (auto const it = peers_.find(id);
+        it != peers_.end() && it->second.assigned != 0)
+        --it->second.assigned;
+}
+
+double
+PeerThroughput::rate(Peer::id_t id) const
+{
+    std::lock_guard lock(mutex_);
+    if (auto const it = peers_.find(id); it != peers_.end())
+        return it->second.nodes.value(clock_.now());
+    return 0;
+}
+
+std::size_t
+PeerThroughput::assigned(Peer::id_t id) const
+{
+    std::lock_guard lock(mutex_);
+    if (auto const it = peers_.find(id); it != peers_.end())
+        return it->second.assigned;
+    return 0;
+}
+
+void
+PeerThroughput::rank(std::vector<Peer::id_t>& ids) const
+{
+    std::lock_guard lock(mutex_);
+    std::vector<std::pair<double, Peer::id_t>> scored;
+    scored.reserve(ids.size());
+    for (auto const id : ids)
+        scored.emplace_back(score(id, lock), id);
+    std::stable_sort(
+        scored.begin(), scored.end(), [](auto const& lhs, auto const& rhs) {
+            return lhs.first > rhs.first;
+        });
+    for (std::size_t i = 0; i < ids.size(); ++i)
+        ids[i] = scored[i].second;
+}
+
+std::size_t
+PeerThroughput::size() const
+{
+    std::lock_guard lock(mutex_);
+    return peers_.size();
+}
+
+PeerThroughput::Entry&
+PeerThroughput::touch(Peer::id_t id, std::lock_guard<std::mutex> const&)
+{
+    auto [it, inserted] = peers_.try_emplace(id, clock_.now());
+    it->second.updated = ++updates_;
+    if (!inserted || peers_.size() <= capacity_)
+        return it->second;
+
+    // Peer ids are never reused, so drop the idle peer updated longest ago
+    auto oldest = peers_.end();
+    for (auto i = peers_.begin(); i != peers_.end(); ++i)
+    {
+        if (i->second.assigned == 0 && i != it &&
+            (oldest == peers_.end() ||
+             i->second.updated < oldest->second.updated))
+            oldest = i;
+    }
+    if (oldest != peers_.end())
+        peers_.erase(oldest);
+    return it->second;
+}
+
+double
+PeerThroughput::score(Peer::id_t id, std::lock_guard<std::mutex> const&) const
+{
+    auto const it = peers_.find(id);
+    if (it == peers_.end())
+        return base_;
+
+    // Each acquisition the peer already serves takes a share of its rate
+    return (base_ + it->second.nodes.value(clock_.now())) /
+        (1 + it->second.assigned);
+}
+
+}  // namespace ripple
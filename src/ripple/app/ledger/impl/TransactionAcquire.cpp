@@ -26,6 +26,7 @@
 #include <ripple/overlay/Overlay.h>
 #include <ripple/overlay/impl/ProtocolMessage.h>
 
+#include <algorithm>
 #include <memory>
 
 namespace ripple {
@@ -38,12 +39,19 @@ auto constexpr TX_ACQUIRE_TIMEOUT = 250ms;
 enum {
     NORM_TIMEOUTS = 4,
     MAX_TIMEOUTS = 20,
+
+    // How many of the fastest peers to spread each request over
+    STRIPE_PEERS = 3,
+
+    // How many of the deepest missing nodes to also ask a second peer for
+    SPECULATIVE_NODES = 8,
 };
 
 TransactionAcquire::TransactionAcquire(
     Application& app,
     uint256 const& hash,
-    std::unique_ptr<PeerSet> peerSet)
+    std::unique_ptr<PeerSet> peerSet,
+    std::shared_ptr<PeerLatency> latency)
     : TimeoutCounter(
           app,
           hash,
@@ -52,10 +60,12 @@ TransactionAcquire::TransactionAcquire(
           app.journal("TransactionAcquire"))
     , mHaveRoot(false)
     , mPeerSet(std::move(peerSet))
+    , latency_(std::move(latency))
 {
     mMap = std::make_shared<SHAMap>(
         SHAMapType::TRANSACTION, hash, app_.getNodeFamily());
     mMap->setUnbacked();
+    mMap->setItemArena();
 }
 
 void
@@ -97,7 +107,9 @@ TransactionAcquire::onTimer(bool progress, ScopedLockType& psl)
         return;
     }
 
-    if (timeouts_ >= NORM_TIMEOUTS)
+    // A peer that is slow to answer should not hold up the set, so ask
+    // the others for what it was sent as soon as it falls behind.
+    if (expirePending() || timeouts_ >= NORM_TIMEOUTS)
         trigger(nullptr);
 
     addPeers(1);
@@ -136,7 +148,7 @@ TransactionAcquire::trigger(std::shared_ptr<Peer> const& peer)
             tmGL.set_querytype(protocol::qtINDIRECT);
 
         *(tmGL.add_nodeids()) = SHAMapNodeID().getRawString();
-        mPeerSet->sendRequest(tmGL, peer);
+        sendRequest(tmGL, peer);
     }
     else if (!mMap->isValid())
     {
@@ -166,12 +178,111 @@ TransactionAcquire::trigger(std::shared_ptr<Peer> const& peer)
         if (timeouts_ != 0)
             tmGL.set_querytype(protocol::qtINDIRECT);
 
+        stripeRequest(tmGL, std::move(nodes), peer);
+    }
+}
+
+void
+TransactionAcquire::sendRequest(
+    protocol::TMGetLedger const& request,
+    std::shared_ptr<Peer> const& peer)
+{
+    // Only the first unanswered request is timed
+    auto const now = stopwatch().now();
+    if (peer)
+        pending_.try_emplace(peer->id(), now);
+    else
+        for (auto const id : mPeerSet->getPeerIds())
+            pending_.try_emplace(id, now);
+
+    mPeerSet->sendRequest(request, peer);
+}
+
+void
+TransactionAcquire::stripeRequest(
+    protocol::TMGetLedger const& request,
+    std::vector<std::pair<SHAMapNodeID, uint256>> nodes,
+    std::shared_ptr<Peer> const& peer)
+{
+    // Spread the nodes over the fastest peers that are not still busy
+    // with an earlier request.
+    std::vector<std::shared_ptr<Peer>> peers;
+    {
+        std::vector<Peer::id_t> ids;
+        for (auto const id : mPeerSet->getPeerIds())
+            if (!pending_.count(id))
+                ids.push_back(id);
+        latency_->rank(ids);
+
+        for (auto const id : ids)
+        {
+            if (peers.size() == STRIPE_PEERS)
+                break;
+            if (auto p = app_.overlay().findPeerByShortID(id))
+                peers.push_back(std::move(p));
+        }
+    }
+
+    if (peers.empty())
+    {
+        // Everyone is busy: fall back to the peer that answered, or to
+        // every peer if we are retrying.
+        auto message = request;
         for (auto const& node : nodes)
+            *message.add_nodeids() = node.first.getRawString();
+        sendRequest(message, peer);
+        return;
+    }
+
+    // The deepest nodes are handed out first and are also sent to a
+    // second peer, since a slow answer for them delays every node below.
+    std::stable_sort(
+        nodes.begin(), nodes.end(), [](auto const& lhs, auto const& rhs) {
+            return lhs.first.getDepth() > rhs.first.getDepth();
+        });
+
+    std::vector<protocol::TMGetLedger> messages(peers.size(), request);
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+        auto const id = nodes[i].first.getRawString();
+        *messages[i % peers.size()].add_nodeids() = id;
+        if (i < SPECULATIVE_NODES && peers.size() > 1)
+            *messages[(i + 1) % peers.size()].add_nodeids() = id;
+    }
+
+    JLOG(journal_.trace()) << "TX set " << hash_ << ": " << nodes.size()
+                           << " nodes over " << peers.size() << " peers";
+
+    for (std::size_t i = 0; i < peers.size(); ++i)
+    {
+        if (messages[i].nodeids_size() != 0)
+            sendRequest(messages[i], peers[i]);
+    }
+}
+
+bool
+TransactionAcquire::expirePending()
+{
+    bool expired = false;
+    auto const now = stopwatch().now();
+    for (auto it = pending_.begin(); it != pending_.end();)
+    {
+        // Allow each peer twice its usual latency before giving up on it
+        auto const limit = std::max<PeerLatency::duration>(
+            TX_ACQUIRE_TIMEOUT / 2, 2 * latency_->latency(it->first));
+        if (now - it->second < limit)
         {
-            *tmGL.add_nodeids() = node.first.getRawString();
+            ++it;
+            continue;
         }
-        mPeerSet->sendRequest(tmGL, peer);
+
+        JLOG(journal_.debug()) << "TX set " << hash_ << ": peer " << it->first
+                               << " is slow to answer";
+        latency_->timeout(it->first);
+        it = pending_.erase(it);
+        expired = true;
     }
+    return expired;
 }
 
 SHAMapAddNode
@@ -193,6 +304,15 @@ TransactionAcquire::takeNodes(
         return SHAMapAddNode();
     }
 
+    if (auto const it = pending_.find(peer->id()); it != pending_.end())
+    {
+        latency_->reply(
+            peer->id(),
+            std::chrono::duration_cast<PeerLatency::duration>(
+                stopwatch().now() - it->second));
+        pending_.erase(it);
+    }
+
     try
     {
         if (data.empty())
@@ -20,7 +20,9 @@
 #ifndef RIPPLE_APP_LEDGER_TRANSACTIONACQUIRE_H_INCLUDED
 #define RIPPLE_APP_LEDGER_TRANSACTIONACQUIRE_H_INCLUDED
 
+#include <ripple/app/ledger/PeerLatency.h>
 #include <ripple/app/main/Application.h>
+#include <ripple/basics/chrono.h>
 #include <ripple/overlay/PeerSet.h>
 #include <ripple/shamap/SHAMap.h>
 
@@ -39,7 +41,8 @@ public:
     TransactionAcquire(
         Application& app,
         uint256 const& hash,
-        std::unique_ptr<PeerSet> peerSet);
+        std::unique_ptr<PeerSet> peerSet,
+        std::shared_ptr<PeerLatency> latency);
     ~TransactionAcquire() = default;
 
     SHAMapAddNode
@@ -57,6 +60,10 @@ private:
     std::shared_ptr<SHAMap> mMap;
     bool mHaveRoot;
     std::unique_ptr<PeerSet> mPeerSet;
+    std::shared_ptr<PeerLatency> latency_;
+
+    // When each peer was last asked for nodes and has not answered yet
+    hash_map<Peer::id_t, Stopwatch::time_point> pending_;
 
     void
     onTimer(bool progress, ScopedLockType& peerSetLock) override;
@@ -69,6 +76,22 @@ private:
 
     void
     trigger(std::shared_ptr<Peer> const&);
+
+    void
+    sendRequest(
+        protocol::TMGetLedger const& request,
+        std::shared_ptr<Peer> const& peer);
+
+    void
+    stripeRequest(
+        protocol::TMGetLedger const& request,
+        std::vector<std::pair<SHAMapNodeID, uint256>> nodes,
+        std::shared_ptr<Peer> const& peer);
+
+    // Give up on peers that have not answered in time; true if any
+    bool
+    expirePending();
+
     std::weak_ptr<TimeoutCounter>
     pmDowncast() override;
 };
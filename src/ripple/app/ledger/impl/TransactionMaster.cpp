@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/Transaction.h>
@@ -39,6 +40,25 @@ TransactionMaster::TransactionMaster(Application& app)
 bool
 TransactionMaster::inLedger(uint256 const& hash, std::uint32_t ledger)
 {
+    {
+        std::lock_guard lock(recentMutex_);
+        recentTxns_[hash] = ledger;
+        recentByLedger_[ledger].push_back(hash);
+
+        while (recentByLedger_.size() > recentLedgers)
+        {
+            auto const oldest = recentByLedger_.begin();
+            for (auto const& id : oldest->second)
+            {
+                // The transaction may have been seen again in a later ledger
+                if (auto const it = recentTxns_.find(id);
+                    it != recentTxns_.end() && it->second == oldest->first)
+                    recentTxns_.erase(it);
+            }
+            recentByLedger_.erase(oldest);
+        }
+    }
+
     auto txn = mCache.fetch(hash);
 
     if (!txn)
@@ -54,17 +74,45 @@ TransactionMaster::fetch_from_cache(uint256 const& txnID)
     return mCache.fetch(txnID);
 }
 
+std::optional<TransactionMaster::TxPair>
+TransactionMaster::fetchRecent(uint256 const& txnID)
+{
+    std::uint32_t seq;
+    {
+        std::lock_guard lock(recentMutex_);
+        auto const it = recentTxns_.find(txnID);
+        if (it == recentTxns_.end())
+            return std::nullopt;
+        seq = it->second;
+    }
+
+    auto const ledger = mApp.getLedgerMaster().getLedgerBySeq(seq);
+    if (!ledger)
+        return std::nullopt;
+
+    auto [sttx, meta] = ledger->txRead(txnID);
+    if (!sttx || !meta)
+        return std::nullopt;
+
+    std::string reason;
+    auto txn = std::make_shared<Transaction>(sttx, reason, mApp);
+    txn->setStatus(COMMITTED, seq);
+    mCache.canonicalize_replace_client(txnID, txn);
+
+    return TxPair{std::move(txn), std::make_shared<TxMeta>(txnID, seq, *meta)};
+}
+
 std::variant<
     std::pair<std::shared_ptr<Transaction>, std::shared_ptr<TxMeta>>,
     TxSearched>
 TransactionMaster::fetch(uint256 const& txnID, error_code_i& ec)
 {
-    using TxPair =
-        std::pair<std::shared_ptr<Transaction>, std::shared_ptr<TxMeta>>;
-
     if (auto txn = fetch_from_cache(txnID); txn && !txn->isValidated())
         return std::pair{std::move(txn), nullptr};
 
+    if (auto recent = fetchRecent(txnID))
+        return std::move(*recent);
+
     auto v = Transaction::load(txnID, mApp, ec);
 
     if (std::holds_alternative<TxSearched>(v))
@@ -86,12 +134,14 @@ TransactionMaster::fetch(
     ClosedInterval<uint32_t> const& range,
     error_code_i& ec)
 {
-    using TxPair =
-        std::pair<std::shared_ptr<Transaction>, std::shared_ptr<TxMeta>>;
-
     if (auto txn = fetch_from_cache(txnID); txn && !txn->isValidated())
         return std::pair{std::move(txn), nullptr};
 
+    // As with the database, a transaction that is found is returned even
+    // if it lies outside the range
+    if (auto recent = fetchRecent(txnID))
+        return std::move(*recent);
+
     auto v = Transaction::load(txnID, mApp, range, ec);
 
     if (std::holds_alternative<TxSearched>(v))
@@ -18,10 +18,12 @@
 //==============================================================================
 
 #include <ripple/app/consensus/RCLValidations.h>
+#include <ripple/app/ledger/BuildLedger.h>
 #include <ripple/app/ledger/InboundLedgers.h>
 #include <ripple/app/ledger/InboundTransactions.h>
 #include <ripple/app/ledger/LedgerCleaner.h>
 #include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/LedgerReplay.h>
 #include <ripple/app/ledger/LedgerReplayer.h>
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/app/ledger/OpenLedger.h>
@@ -30,13 +32,16 @@
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/main/BasicApp.h>
+#include <ripple/app/main/CacheGovernor.h>
 #include <ripple/app/main/DBInit.h>
 #include <ripple/app/main/GRPCServer.h>
 #include <ripple/app/main/LoadManager.h>
+#include <ripple/app/main/MemoryUsage.h>
 #include <ripple/app/main/NodeIdentity.h>
 #include <ripple/app/main/NodeStoreScheduler.h>
 #include <ripple/app/main/Tuning.h>
 #include <ripple/app/misc/AmendmentTable.h>
+#include <ripple/app/misc/GatewayBalancesIndex.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
@@ -50,13 +55,17 @@
 #include <ripple/app/reporting/ReportingETL.h>
 #include <ripple/app/tx/apply.h>
 #include <ripple/basics/ByteUtilities.h>
+#include <ripple/basics/CountedObject.h>
 #include <ripple/basics/PerfLog.h>
+#include <ripple/basics/ProfiledMutex.h>
 #include <ripple/basics/ResolverAsio.h>
 #include <ripple/basics/random.h>
 #include <ripple/basics/safe_cast.h>
 #include <ripple/beast/asio/io_latency_probe.h>
+#include <ripple/beast/core/CurrentThreadName.h>
 #include <ripple/beast/core/LexicalCast.h>
 #include <ripple/core/DatabaseCon.h>
+#include <ripple/core/JobLatencyProbe.h>
 #include <ripple/crypto/csprng.h>
 #include <ripple/json/json_reader.h>
 #include <ripple/nodestore/DatabaseShard.h>
@@ -69,10 +78,14 @@
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/Protocol.h>
 #include <ripple/protocol/STParsedJSON.h>
+#include <ripple/protocol/TxFormats.h>
 #include <ripple/resource/Fees.h>
+#include <ripple/rpc/BookChanges.h>
 #include <ripple/rpc/ShardArchiveHandler.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
+#include <ripple/rpc/impl/ResponseCache.h>
 #include <ripple/shamap/NodeFamily.h>
+#include <ripple/shamap/SHAMapSnapshot.h>
 #include <ripple/shamap/ShardFamily.h>
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -84,16 +97,104 @@
 #include <chrono>
 #include <condition_variable>
 #include <cstring>
+#include <future>
 #include <iostream>
 #include <limits>
 #include <mutex>
 #include <optional>
 #include <sstream>
+#include <tuple>
 #include <utility>
 #include <variant>
 
 namespace ripple {
 
+namespace {
+
+// How long each step of setting up the server took
+class StartupTimes
+{
+public:
+    class Step
+    {
+    public:
+        Step(StartupTimes& times, char const* name, bool concurrent)
+            : times_(times)
+            , name_(name)
+            , concurrent_(concurrent)
+            , start_(std::chrono::steady_clock::now())
+        {
+        }
+
+        Step(Step const&) = delete;
+        Step&
+        operator=(Step const&) = delete;
+
+        ~Step()
+        {
+            times_.add(
+                name_, concurrent_, std::chrono::steady_clock::now() - start_);
+        }
+
+    private:
+        StartupTimes& times_;
+        char const* name_;
+        bool concurrent_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    /** Time a step until the returned object is destroyed.
+
+        @param concurrent Whether the step runs alongside the others.
+    */
+    Step
+    step(char const* name, bool concurrent = false)
+    {
+        return Step(*this, name, concurrent);
+    }
+
+    std::string
+    str() const
+    {
+        using namespace std::chrono;
+        std::ostringstream ss;
+        ss << "Setup took "
+           << duration_cast<milliseconds>(steady_clock::now() - start_).count()
+           << "ms:";
+
+        std::lock_guard lock(mutex_);
+        char const* sep = " ";
+        for (auto const& [name, concurrent, elapsed] : steps_)
+        {
+            ss << sep << name << ' '
+               << duration_cast<milliseconds>(elapsed).count() << "ms";
+            if (concurrent)
+                ss << " (concurrent)";
+            sep = ", ";
+        }
+        return ss.str();
+    }
+
+private:
+    void
+    add(char const* name,
+        bool concurrent,
+        std::chrono::steady_clock::duration elapsed)
+    {
+        std::lock_guard lock(mutex_);
+        steps_.emplace_back(name, concurrent, elapsed);
+    }
+
+    std::chrono::steady_clock::time_point const start_ =
+        std::chrono::steady_clock::now();
+    std::mutex mutable mutex_;
+    std::vector<
+        std::tuple<char const*, bool, std::chrono::steady_clock::duration>>
+        steps_;
+};
+
+}  // namespace
+
 // VFALCO TODO Move the function definitions into the class declaration
 class ApplicationImp : public Application, public BasicApp
 {
@@ -105,17 +206,25 @@ private:
         beast::Journal m_journal;
         beast::io_latency_probe<std::chrono::steady_clock> m_probe;
         std::atomic<std::chrono::milliseconds> lastSample_;
+        JobLatencyProbe& jobs_;
+
+        // The samples by the name of the io_service thread that ran them,
+        // in microseconds
+        std::mutex mutable threadsMutex_;
+        std::map<std::string, Histogram> threads_;
 
     public:
         io_latency_sampler(
             beast::insight::Event ev,
             beast::Journal journal,
             std::chrono::milliseconds interval,
-            boost::asio::io_service& ios)
+            boost::asio::io_service& ios,
+            JobLatencyProbe& jobs)
             : m_event(ev)
             , m_journal(journal)
             , m_probe(interval, ios)
             , lastSample_{}
+            , jobs_(jobs)
         {
         }
 
@@ -141,6 +250,16 @@ private:
                 JLOG(m_journal.warn())
                     << "io_service latency = " << lastSample.count();
             }
+
+            {
+                auto const thread = beast::getCurrentThreadName();
+                std::lock_guard lock(threadsMutex_);
+                threads_[thread].add(
+                    duration_cast<microseconds>(elapsed).count());
+            }
+
+            // The job probes keep their own, longer, interval
+            jobs_.sample();
         }
 
         std::chrono::milliseconds
@@ -149,6 +268,16 @@ private:
             return lastSample_.load();
         }
 
+        Json::Value
+        getJson() const
+        {
+            Json::Value ret(Json::objectValue);
+            std::lock_guard lock(threadsMutex_);
+            for (auto const& [thread, latencies] : threads_)
+                ret[thread] = toJson(latencies);
+            return ret;
+        }
+
         void
         cancel()
         {
@@ -185,6 +314,8 @@ public:
 
     NodeCache m_tempNodeCache;
     CachedSLEs cachedSLEs_;
+    std::unique_ptr<RPC::ResponseCache> rpcResponseCache_;
+    std::unique_ptr<GatewayBalancesIndex> gatewayBalancesIndex_;
     std::pair<PublicKey, SecretKey> nodeIdentity_;
     ValidatorKeys const validatorKeys_;
 
@@ -204,6 +335,7 @@ public:
     std::unique_ptr<InboundTransactions> m_inboundTransactions;
     std::unique_ptr<LedgerReplayer> m_ledgerReplayer;
     TaggedCache<uint256, AcceptedLedger> m_acceptedLedgerCache;
+    RPC::BookChangesCache bookChangesCache_;
     std::unique_ptr<NetworkOPs> m_networkOPs;
     std::unique_ptr<Cluster> cluster_;
     std::unique_ptr<PeerReservationTable> peerReservations_;
@@ -238,11 +370,16 @@ public:
 
     std::unique_ptr<ResolverAsio> m_resolver;
 
+    JobLatencyProbe jobLatencyProbe_;
     io_latency_sampler m_io_latency_sampler;
 
     std::unique_ptr<GRPCServer> grpcServer_;
     std::unique_ptr<ReportingETL> reportingETL_;
 
+    std::unique_ptr<MemoryGauges> memoryGauges_;
+    std::unique_ptr<LockGauges> lockGauges_;
+    std::unique_ptr<CacheGovernor> cacheGovernor_;
+
     //--------------------------------------------------------------------------
 
     static std::size_t
@@ -273,7 +410,10 @@ public:
         std::unique_ptr<Config> config,
         std::unique_ptr<Logs> logs,
         std::unique_ptr<TimeKeeper> timeKeeper)
-        : BasicApp(numberOfThreads(*config))
+        : BasicApp(
+              numberOfThreads(*config),
+              config->IO_CPUS,
+              logs->journal("Application"))
         , config_(std::move(config))
         , logs_(std::move(logs))
         , timeKeeper_(std::move(timeKeeper))
@@ -326,9 +466,14 @@ public:
               m_collectorManager->group("jobq"),
               logs_->journal("JobQueue"),
               *logs_,
-              *perfLog_))
+              *perfLog_,
+              config_->JOB_QUEUE_CPUS,
+              CoroStackPool::Setup{
+                  kilobytes(config_->CORO_STACK_KB),
+                  config_->CORO_STACK_GUARD,
+                  config_->CORO_STACK_POOLED}))
 
-        , m_nodeStoreScheduler(*m_jobQueue)
+        , m_nodeStoreScheduler(*m_jobQueue, *m_collectorManager)
 
         , m_shaMapStore(make_SHAMapStore(
               *this,
@@ -349,6 +494,14 @@ public:
               stopwatch(),
               logs_->journal("CachedSLEs"))
 
+        , rpcResponseCache_(
+              config_->RPC_RESPONSE_CACHE_METHODS.empty()
+                  ? nullptr
+                  : std::make_unique<RPC::ResponseCache>(
+                        megabytes(config_->RPC_RESPONSE_CACHE_MB),
+                        config_->RPC_RESPONSE_CACHE_METHODS,
+                        logs_->journal("RPCResponseCache")))
+
         , validatorKeys_(*config_, m_journal)
 
         , m_resourceManager(Resource::make_Manager(
@@ -410,6 +563,13 @@ public:
               stopwatch(),
               logs_->journal("TaggedCache"))
 
+        , bookChangesCache_(
+              "BookChanges",
+              256,
+              std::chrono::minutes{15},
+              stopwatch(),
+              logs_->journal("TaggedCache"))
+
         , m_networkOPs(make_NetworkOPs(
               *this,
               stopwatch(),
@@ -481,11 +641,17 @@ public:
         , m_resolver(
               ResolverAsio::New(get_io_service(), logs_->journal("Resolver")))
 
+        , jobLatencyProbe_(
+              *m_jobQueue,
+              m_collectorManager->group("job_latency"),
+              std::chrono::seconds(1))
+
         , m_io_latency_sampler(
               m_collectorManager->collector()->make_event("ios_latency"),
               logs_->journal("Application"),
               std::chrono::milliseconds(100),
-              get_io_service())
+              get_io_service(),
+              jobLatencyProbe_)
         , grpcServer_(std::make_unique<GRPCServer>(*this))
         , reportingETL_(
               config_->reporting() ? std::make_unique<ReportingETL>(*this)
@@ -621,6 +787,15 @@ public:
         return m_io_latency_sampler.get();
     }
 
+    Json::Value
+    getLatencyJson() override
+    {
+        Json::Value ret(Json::objectValue);
+        ret[jss::jobs] = jobLatencyProbe_.getJson();
+        ret[jss::threads] = m_io_latency_sampler.getJson();
+        return ret;
+    }
+
     LedgerMaster&
     getLedgerMaster() override
     {
@@ -657,6 +832,12 @@ public:
         return m_acceptedLedgerCache;
     }
 
+    RPC::BookChangesCache&
+    getBookChangesCache() override
+    {
+        return bookChangesCache_;
+    }
+
     void
     gotTXSet(std::shared_ptr<SHAMap> const& set, bool fromAcquire)
     {
@@ -790,6 +971,18 @@ public:
         return cachedSLEs_;
     }
 
+    RPC::ResponseCache*
+    getRPCResponseCache() override
+    {
+        return rpcResponseCache_.get();
+    }
+
+    GatewayBalancesIndex*
+    getGatewayBalancesIndex() override
+    {
+        return gatewayBalancesIndex_.get();
+    }
+
     AmendmentTable&
     getAmendmentTable() override
     {
@@ -1061,6 +1254,10 @@ public:
             signalStop();
         }
 
+        // Resize the caches before they are swept to their new targets
+        if (cacheGovernor_)
+            cacheGovernor_->update(residentBytes());
+
         // VFALCO NOTE Does the order of calls matter?
         // VFALCO TODO fix the dependency inversion using an observer,
         //         have listeners register for "onSweep ()" notification.
@@ -1222,6 +1419,15 @@ public:
                 << oldAcceptedLedgerSize
                 << "; size after: " << m_acceptedLedgerCache.size();
         }
+        {
+            std::size_t const oldSize = bookChangesCache_.size();
+
+            bookChangesCache_.sweep();
+
+            JLOG(m_journal.debug())
+                << "BookChangesCache sweep.  Size before: " << oldSize
+                << "; size after: " << bookChangesCache_.size();
+        }
         {
             std::size_t const oldCachedSLEsSize = cachedSLEs_.size();
 
@@ -1231,6 +1437,16 @@ public:
                 << "CachedSLEs sweep.  Size before: " << oldCachedSLEsSize
                 << "; size after: " << cachedSLEs_.size();
         }
+        if (rpcResponseCache_)
+        {
+            std::size_t const oldSize = rpcResponseCache_->size();
+
+            rpcResponseCache_->sweep();
+
+            JLOG(m_journal.debug())
+                << "RPCResponseCache sweep.  Size before: " << oldSize
+                << "; size after: " << rpcResponseCache_->size();
+        }
 
 #ifdef RIPPLED_REPORTING
         if (auto pg = dynamic_cast<PostgresDatabase*>(&*mRelationalDatabase))
@@ -1267,6 +1483,15 @@ private:
     bool
     loadOldLedger(std::string const& ledgerID, bool replay, bool isFilename);
 
+    // Replay the ledgers after the last closed one as a benchmark
+    bool
+    replayLedgers(std::uint32_t count);
+
+    // Load the manifests and the lists of trusted validators and their
+    // publishers. This reads only the config and the wallet database.
+    bool
+    loadValidators();
+
     void
     setMaxDisallowedLedger();
 };
@@ -1299,6 +1524,10 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
                 signalStop();
         });
 
+    logs_->json(config_->LOG_JSON);
+    if (config_->LOG_QUEUE != 0)
+        logs_->writeAsync(config_->LOG_QUEUE);
+
     auto debug_log = config_->getDebugLogFile();
 
     if (!debug_log.empty())
@@ -1327,11 +1556,17 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
     // Optionally turn off logging to console.
     logs_->silent(config_->silent());
 
-    if (!initRelationalDatabase() || !initNodeStore())
-        return false;
+    StartupTimes startup;
+
+    {
+        auto const step = startup.step("databases");
+        if (!initRelationalDatabase() || !initNodeStore())
+            return false;
+    }
 
     if (shardStore_)
     {
+        auto const step = startup.step("shard store");
         shardFamily_ =
             std::make_unique<ShardFamily>(*this, *m_collectorManager);
 
@@ -1378,10 +1613,66 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
 
     Pathfinder::initPathTable();
 
+    if (!config_->GATEWAY_BALANCES_INDEX.empty())
+    {
+        std::set<AccountID> issuers;
+        for (auto const& issuer : config_->GATEWAY_BALANCES_INDEX)
+        {
+            auto const id = parseBase58<AccountID>(issuer);
+            if (!id)
+            {
+                JLOG(m_journal.fatal())
+                    << "Invalid " SECTION_GATEWAY_BALANCES_INDEX " account: "
+                    << issuer;
+                return false;
+            }
+            issuers.insert(*id);
+        }
+        gatewayBalancesIndex_ = std::make_unique<GatewayBalancesIndex>(
+            std::move(issuers),
+            *m_jobQueue,
+            logs_->journal("GatewayBalancesIndex"));
+    }
+
+    // Nothing before consensus starts needs the trusted validators, and
+    // loading them does not touch the ledgers, so it runs while the ledger
+    // is loaded. If setup fails first, the future waits for it on return.
+    std::future<bool> validatorsLoaded;
+    if (!config_->reporting())
+    {
+        validatorsLoaded = std::async(std::launch::async, [this, &startup] {
+            beast::setCurrentThreadName("rippled: validators");
+            auto const step = startup.step("validators", true);
+            return loadValidators();
+        });
+    }
+
     auto const startUp = config_->START_UP;
     JLOG(m_journal.debug()) << "startUp: " << startUp;
     if (!config_->reporting())
     {
+        // Warm the tree node cache from the last state snapshot
+        if (startUp != Config::FRESH && !config_->STATE_SNAPSHOT_PATH.empty())
+        {
+            using namespace std::chrono;
+            auto const step = startup.step("snapshot");
+            auto const start = steady_clock::now();
+            if (auto const snapshot = loadSHAMapSnapshot(
+                    config_->STATE_SNAPSHOT_PATH,
+                    *nodeFamily_.getTreeNodeCache(0),
+                    m_journal))
+            {
+                JLOG(m_journal.info())
+                    << "Loaded " << snapshot->nodes
+                    << " inner nodes of ledger " << snapshot->ledgerSeq
+                    << " from the state snapshot in "
+                    << duration_cast<milliseconds>(steady_clock::now() - start)
+                           .count()
+                    << "ms";
+            }
+        }
+
+        auto const step = startup.step("ledger");
         if (startUp == Config::FRESH)
         {
             JLOG(m_journal.info()) << "Starting new Ledger";
@@ -1412,6 +1703,12 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
                     return false;
                 }
             }
+            else if (startUp == Config::REPLAY && config_->REPLAY_COUNT != 0)
+            {
+                if (!replayLedgers(config_->REPLAY_COUNT))
+                    return false;
+                signalStop("replay benchmark complete");
+            }
         }
         else if (startUp == Config::NETWORK)
         {
@@ -1435,7 +1732,16 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
     }
 
     if (!config().reporting())
+    {
+        auto const step = startup.step("ledger hashes");
+        m_ledgerMaster->loadHashIndex();
+    }
+
+    if (!config().reporting())
+    {
+        auto const step = startup.step("order books");
         m_orderBookDB.setup(getLedgerMaster().getCurrentLedger());
+    }
 
     nodeIdentity_ = getNodeIdentity(*this, cmdline);
 
@@ -1447,44 +1753,8 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
 
     if (!config().reporting())
     {
-        {
-            if (validatorKeys_.configInvalid())
-                return false;
-
-            if (!validatorManifests_->load(
-                    getWalletDB(),
-                    "ValidatorManifests",
-                    validatorKeys_.manifest,
-                    config()
-                        .section(SECTION_VALIDATOR_KEY_REVOCATION)
-                        .values()))
-            {
-                JLOG(m_journal.fatal())
-                    << "Invalid configured validator manifest.";
-                return false;
-            }
-
-            publisherManifests_->load(getWalletDB(), "PublisherManifests");
-
-            // Setup trusted validators
-            if (!validators_->load(
-                    validatorKeys_.publicKey,
-                    config().section(SECTION_VALIDATORS).values(),
-                    config().section(SECTION_VALIDATOR_LIST_KEYS).values()))
-            {
-                JLOG(m_journal.fatal())
-                    << "Invalid entry in validator configuration.";
-                return false;
-            }
-        }
-
-        if (!validatorSites_->load(
-                config().section(SECTION_VALIDATOR_LIST_SITES).values()))
-        {
-            JLOG(m_journal.fatal())
-                << "Invalid entry in [" << SECTION_VALIDATOR_LIST_SITES << "]";
+        if (!validatorsLoaded.get())
             return false;
-        }
 
         // Tell the AmendmentTable who the trusted validators are.
         m_amendmentTable->trustChanged(validators_->getQuorumKeys().second);
@@ -1502,6 +1772,7 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
     //             if (!config_.standalone())
     if (!config_->reporting())
     {
+        auto const step = startup.step("overlay");
         overlay_ = make_Overlay(
             *this,
             setup_Overlay(*config_),
@@ -1514,6 +1785,43 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
         add(*overlay_);  // add to PropertyStream
     }
 
+    memoryGauges_ = std::make_unique<MemoryGauges>(
+        *this, m_collectorManager->group("memory"));
+    lockGauges_ =
+        std::make_unique<LockGauges>(m_collectorManager->group("locks"));
+
+    if (auto const limit = config_->MEMORY_LIMIT)
+    {
+        auto const bytes = *limit ? megabytes(*limit) : cgroupMemoryLimit();
+        if (bytes == 0)
+        {
+            JLOG(m_journal.warn())
+                << "No cgroup memory limit; caches will not be resized";
+        }
+        else
+        {
+            cacheGovernor_ = std::make_unique<CacheGovernor>(
+                bytes, logs_->journal("CacheGovernor"));
+            cacheGovernor_->add(
+                "treenode", *nodeFamily_.getTreeNodeCache(0));
+            if (shardFamily_)
+            {
+                // The shard caches come and go, so they are governed as one
+                cacheGovernor_->add(
+                    "shard_treenode",
+                    [this]() {
+                        return shardFamily_->getTreeNodeCacheLookups();
+                    },
+                    [this](double factor) {
+                        shardFamily_->setTreeNodeCacheFactor(factor);
+                    });
+            }
+            cacheGovernor_->add(
+                "transactions", getMasterTransaction().getCache());
+            cacheGovernor_->add("accepted_ledgers", m_acceptedLedgerCache);
+        }
+    }
+
     if (!config_->standalone())
     {
         // NodeStore import into the ShardStore requires the SQLite database
@@ -1531,6 +1839,7 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
     }
 
     {
+        auto const step = startup.step("server handler");
         try
         {
             auto setup = setup_ServerHandler(
@@ -1672,6 +1981,7 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
     if (reportingETL_)
         reportingETL_->start();
 
+    JLOG(m_journal.info()) << startup.str();
     return true;
 }
 
@@ -1879,7 +2189,8 @@ ApplicationImp::startGenesisLedger()
         next->info().seq < XRP_LEDGER_EARLIEST_FEES ||
         next->read(keylet::fees()));
     next->setImmutable();
-    openLedger_.emplace(next, cachedSLEs_, logs_->journal("OpenLedger"));
+    openLedger_.emplace(
+        next, cachedSLEs_, getNodeFamily(), logs_->journal("OpenLedger"));
     m_ledgerMaster->storeLedger(next);
     m_ledgerMaster->switchLCL(next);
 }
@@ -1913,8 +2224,9 @@ ApplicationImp::getLastFullLedger()
         if (auto stream = j.error())
         {
             stream << "Failed on ledger";
-            Json::Value p;
-            addJson(p, {*ledger, nullptr, LedgerFill::full});
+            std::string p;
+            streamJson(
+                {*ledger, nullptr, LedgerFill::full}, Json::stringOutput(p), j);
             stream << p;
         }
 
@@ -2203,7 +2515,10 @@ ApplicationImp::loadOldLedger(
         loadLedger->setValidated();
         m_ledgerMaster->setFullLedger(loadLedger, true, false);
         openLedger_.emplace(
-            loadLedger, cachedSLEs_, logs_->journal("OpenLedger"));
+            loadLedger,
+            cachedSLEs_,
+            getNodeFamily(),
+            logs_->journal("OpenLedger"));
 
         if (replay)
         {
@@ -2248,6 +2563,117 @@ ApplicationImp::loadOldLedger(
     return true;
 }
 
+bool
+ApplicationImp::replayLedgers(std::uint32_t count)
+{
+    using namespace std::chrono;
+    using clock_type = steady_clock;
+
+    // Time spent applying each type of transaction
+    struct Cost
+    {
+        std::uint64_t count = 0;
+        clock_type::duration elapsed{};
+    };
+    std::map<TxType, Cost> costs;
+
+    auto liveObjects = [] {
+        std::int64_t n = 0;
+        for (auto const& [name, live] :
+             CountedObjects::getInstance().getCounts(0))
+            n += live;
+        return n;
+    };
+
+    std::shared_ptr<Ledger const> parent = m_ledgerMaster->getClosedLedger();
+    std::uint64_t txns = 0;
+    clock_type::duration building{};
+    std::int64_t peakObjects = 0;
+    auto const startObjects = liveObjects();
+
+    JLOG(m_journal.warn()) << "Replaying " << count << " ledgers after "
+                           << parent->info().seq;
+
+    try
+    {
+        for (std::uint32_t i = 0; i != count; ++i)
+        {
+            auto const target = loadByIndex(parent->info().seq + 1, *this);
+            if (!target || target->info().parentHash != parent->info().hash)
+            {
+                JLOG(m_journal.fatal())
+                    << "Replay ledger " << parent->info().seq + 1
+                    << " is missing or does not follow its parent";
+                return false;
+            }
+
+            LedgerReplay const replay(parent, target);
+
+            // Signatures are checked before consensus, not while a ledger
+            // is built, so leave them out of what is measured
+            for (auto const& [_, tx] : replay.orderedTxns())
+            {
+                (void)_;
+                forceValidity(
+                    getHashRouter(),
+                    tx->getTransactionID(),
+                    Validity::SigGoodOnly);
+            }
+
+            auto const start = clock_type::now();
+            auto const built = buildLedger(
+                replay,
+                tapNONE,
+                *this,
+                journal("BuildLedger"),
+                [&](STTx const& tx, clock_type::duration elapsed) {
+                    auto& cost = costs[tx.getTxnType()];
+                    ++cost.count;
+                    cost.elapsed += elapsed;
+                });
+            building += clock_type::now() - start;
+            txns += replay.orderedTxns().size();
+            peakObjects = std::max(peakObjects, liveObjects() - startObjects);
+
+            if (built->info().hash != target->info().hash)
+            {
+                JLOG(m_journal.fatal())
+                    << "Replay of ledger " << target->info().seq
+                    << " built " << built->info().hash << " instead of "
+                    << target->info().hash;
+                return false;
+            }
+
+            parent = built;
+        }
+    }
+    catch (SHAMapMissingNode const& mn)
+    {
+        JLOG(m_journal.fatal()) << "While replaying ledgers: " << mn.what();
+        return false;
+    }
+
+    auto const secs = duration<double>(building).count();
+    JLOG(m_journal.warn())
+        << "Replayed and verified " << count << " ledgers with " << txns
+        << " transactions in " << secs << " seconds: "
+        << (secs > 0 ? txns / secs : 0) << " transactions per second, "
+        << (count ? 1000 * secs / count : 0) << " ms per ledger, "
+        << "at most " << peakObjects << " more counted objects live";
+
+    for (auto const& [type, cost] : costs)
+    {
+        auto const item = TxFormats::getInstance().findByType(type);
+        auto const us = duration_cast<microseconds>(cost.elapsed).count();
+        JLOG(m_journal.warn())
+            << (item ? item->getName() : std::to_string(type)) << ": "
+            << cost.count << " transactions, " << us << " us, "
+            << us / std::max<std::uint64_t>(cost.count, 1) << " us each";
+    }
+
+    return true;
+}
+
 bool
 ApplicationImp::serverOkay(std::string& reason)
 {
@@ -2323,6 +2749,45 @@ ApplicationImp::nodeToShards()
     return true;
 }
 
+bool
+ApplicationImp::loadValidators()
+{
+    if (validatorKeys_.configInvalid())
+        return false;
+
+    if (!validatorManifests_->load(
+            getWalletDB(),
+            "ValidatorManifests",
+            validatorKeys_.manifest,
+            config().section(SECTION_VALIDATOR_KEY_REVOCATION).values()))
+    {
+        JLOG(m_journal.fatal()) << "Invalid configured validator manifest.";
+        return false;
+    }
+
+    publisherManifests_->load(getWalletDB(), "PublisherManifests");
+
+    // Setup trusted validators
+    if (!validators_->load(
+            validatorKeys_.publicKey,
+            config().section(SECTION_VALIDATORS).values(),
+            config().section(SECTION_VALIDATOR_LIST_KEYS).values()))
+    {
+        JLOG(m_journal.fatal()) << "Invalid entry in validator configuration.";
+        return false;
+    }
+
+    if (!validatorSites_->load(
+            config().section(SECTION_VALIDATOR_LIST_SITES).values()))
+    {
+        JLOG(m_journal.fatal())
+            << "Invalid entry in [" << SECTION_VALIDATOR_LIST_SITES << "]";
+        return false;
+    }
+
+    return true;
+}
+
 void
 ApplicationImp::setMaxDisallowedLedger()
 {
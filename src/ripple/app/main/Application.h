@@ -48,26 +48,19 @@ namespace perf {
 class PerfLog;
 }
 namespace RPC {
+struct BookChanges;
+class ResponseCache;
 class ShardArchiveHandler;
 }
 
 // VFALCO TODO Fix forward declares required for header dependency loops
 class AmendmentTable;
 
-template <
-    class Key,
-    class T,
-    bool IsKeyCache,
-    class Hash,
-    class KeyEqual,
-    class Mutex>
-class TaggedCache;
-class STLedgerEntry;
-using SLE = STLedgerEntry;
-using CachedSLEs = TaggedCache<uint256, SLE const>;
+class CachedSLEs;
 
 class CollectorManager;
 class Family;
+class GatewayBalancesIndex;
 class HashRouter;
 class Logs;
 class LoadFeeTrack;
@@ -182,6 +175,12 @@ public:
     getTempNodeCache() = 0;
     virtual CachedSLEs&
     cachedSLEs() = 0;
+    /** The cache of RPC results, or null if none are kept. */
+    virtual RPC::ResponseCache*
+    getRPCResponseCache() = 0;
+    /** The gateway balances index, or null if no issuers are indexed. */
+    virtual GatewayBalancesIndex*
+    getGatewayBalancesIndex() = 0;
     virtual AmendmentTable&
     getAmendmentTable() = 0;
     virtual HashRouter&
@@ -222,6 +221,9 @@ public:
     virtual TaggedCache<uint256, AcceptedLedger>&
     getAcceptedLedgerCache() = 0;
 
+    virtual TaggedCache<uint256, RPC::BookChanges const>&
+    getBookChangesCache() = 0;
+
     virtual LedgerMaster&
     getLedgerMaster() = 0;
     virtual LedgerCleaner&
@@ -263,6 +265,10 @@ public:
     virtual std::chrono::milliseconds
     getIOLatency() = 0;
 
+    /** Returns the latencies of the job and io_service probes. */
+    virtual Json::Value
+    getLatencyJson() = 0;
+
     virtual ReportingETL&
     getReportingETL() = 0;
 
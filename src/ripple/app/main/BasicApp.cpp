@@ -18,18 +18,23 @@
 //==============================================================================
 
 #include <ripple/app/main/BasicApp.h>
+#include <ripple/basics/ThreadAffinity.h>
 #include <ripple/beast/core/CurrentThreadName.h>
 
-BasicApp::BasicApp(std::size_t numberOfThreads)
+BasicApp::BasicApp(
+    std::size_t numberOfThreads,
+    std::vector<unsigned> const& cpus,
+    beast::Journal journal)
 {
     work_.emplace(io_service_);
     threads_.reserve(numberOfThreads);
 
     while (numberOfThreads--)
     {
-        threads_.emplace_back([this, numberOfThreads]() {
+        threads_.emplace_back([this, numberOfThreads, cpus, journal]() {
             beast::setCurrentThreadName(
                 "io svc #" + std::to_string(numberOfThreads));
+            ripple::setCurrentThreadAffinity(cpus, journal);
             this->io_service_.run();
         });
     }
@@ -20,6 +20,7 @@
 #ifndef RIPPLE_APP_BASICAPP_H_INCLUDED
 #define RIPPLE_APP_BASICAPP_H_INCLUDED
 
+#include <ripple/beast/utility/Journal.h>
 #include <boost/asio/io_service.hpp>
 #include <optional>
 #include <thread>
@@ -34,7 +35,10 @@ private:
     boost::asio::io_service io_service_;
 
 public:
-    BasicApp(std::size_t numberOfThreads);
+    BasicApp(
+        std::size_t numberOfThreads,
+        std::vector<unsigned> const& cpus = {},
+        beast::Journal journal = beast::Journal{beast::Journal::getNullSink()});
     ~BasicApp();
 
     boost::asio::io_service&
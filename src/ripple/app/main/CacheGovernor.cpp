@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/main/CacheGovernor.h>
+#include <ripple/basics/Log.h>
+#include <boost/predef.h>
+#include <fstream>
+#include <limits>
+
+#if BOOST_OS_LINUX
+#include <unistd.h>
+#endif
+
+namespace ripple {
+
+CacheGovernor::CacheGovernor(std::size_t limit, beast::Journal journal)
+    : limit_(limit), j_(journal)
+{
+}
+
+void
+CacheGovernor::add(std::string name, Lookups lookups, Scale scale)
+{
+    auto const [hits, misses] = lookups();
+    Entry entry{std::move(name), std::move(lookups), std::move(scale)};
+    entry.hits = hits;
+    entry.misses = misses;
+    caches_.push_back(std::move(entry));
+}
+
+double
+CacheGovernor::factor(std::string const& name) const
+{
+    for (auto const& entry : caches_)
+        if (entry.name == name)
+            return entry.factor;
+    return 0;
+}
+
+void
+CacheGovernor::rescale(Entry& entry, double factor)
+{
+    factor = std::clamp(factor, minFactor, 1.0);
+    if (factor == entry.factor)
+        return;
+
+    JLOG(j_.info()) << "Cache " << entry.name << " scaled from "
+                    << entry.factor << " to " << factor
+                    << " of its targets; hit rate " << entry.hitRate;
+    entry.factor = factor;
+    entry.scale(factor);
+}
+
+void
+CacheGovernor::update(std::size_t resident)
+{
+    // The hit rate since the last update stands in for the value of the
+    // last bytes a cache has: a cache that seldom finds what it is asked
+    // for loses little by holding less.
+    for (auto& entry : caches_)
+    {
+        auto const [hits, misses] = entry.lookups();
+        auto const dh = hits - entry.hits;
+        auto const dm = misses - entry.misses;
+        entry.hits = hits;
+        entry.misses = misses;
+        if (dh + dm != 0)
+            entry.hitRate = static_cast<double>(dh) / (dh + dm);
+    }
+
+    if (limit_ == 0 || caches_.empty())
+        return;
+
+    JLOG(j_.debug()) << "Resident " << resident << " of " << limit_;
+
+    if (resident > limit_)
+    {
+        for (auto& entry : caches_)
+            rescale(entry, entry.factor * shrinkStep);
+        return;
+    }
+
+    auto const byHitRate = [](Entry const& a, Entry const& b) {
+        return a.hitRate < b.hitRate;
+    };
+
+    if (resident > limit_ * highMark)
+    {
+        auto victim = caches_.end();
+        for (auto it = caches_.begin(); it != caches_.end(); ++it)
+            if (it->factor > minFactor &&
+                (victim == caches_.end() || byHitRate(*it, *victim)))
+                victim = it;
+        if (victim != caches_.end())
+            rescale(*victim, victim->factor * shrinkStep);
+    }
+    else if (resident < limit_ * lowMark)
+    {
+        auto winner = caches_.end();
+        for (auto it = caches_.begin(); it != caches_.end(); ++it)
+            if (it->factor < 1.0 &&
+                (winner == caches_.end() || byHitRate(*winner, *it)))
+                winner = it;
+        if (winner != caches_.end())
+            rescale(*winner, winner->factor * growStep);
+    }
+}
+
+std::size_t
+residentBytes()
+{
+#if BOOST_OS_LINUX
+    // The second field is the resident set, in pages
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size = 0;
+    std::size_t resident = 0;
+    if (statm >> size >> resident)
+        return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    return 0;
+}
+
+std::size_t
+cgroupMemoryLimit()
+{
+#if BOOST_OS_LINUX
+    // cgroup v2 writes "max" when there is no limit, which fails to parse
+    {
+        std::ifstream in("/sys/fs/cgroup/memory.max");
+        std::size_t limit = 0;
+        if (in >> limit)
+            return limit;
+    }
+
+    // cgroup v1 writes a huge number when there is no limit
+    {
+        std::ifstream in("/sys/fs/cgroup/memory/memory.limit_in_bytes");
+        std::size_t limit = 0;
+        if (in >> limit && limit < std::numeric_limits<std::size_t>::max() / 2)
+            return limit;
+    }
+#endif
+    return 0;
+}
+
+}  // namespace ripple
@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_MAIN_CACHEGOVERNOR_H_INCLUDED
+#define RIPPLE_APP_MAIN_CACHEGOVERNOR_H_INCLUDED
+
+#include <ripple/beast/utility/Journal.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** Resizes caches at run time to keep the process within a memory limit.
+
+    On each update the governor compares the resident size of the process
+    with its limit. Above the high mark it shrinks the cache whose recent
+    fetches found the least, and above the limit it shrinks them all.
+    Below the low mark it gives room back to the cache whose recent
+    fetches found the most. Memory thus goes to the caches that save the
+    most work, while no cache grows past the targets it started with.
+
+    Caches are added once, before the first update. Updates come from the
+    sweep, so they are not synchronized.
+*/
+class CacheGovernor
+{
+public:
+    /** Scales the targets of a cache by a factor of those it started with.
+     */
+    using Scale = std::function<void(double)>;
+
+    /** Returns the fetches that found an entry, and that did not. */
+    using Lookups = std::function<std::pair<std::uint64_t, std::uint64_t>()>;
+
+    // The smallest factor a cache is cut to
+    static constexpr double minFactor = 0.1;
+
+    // How much one update shrinks or grows a cache by
+    static constexpr double shrinkStep = 0.75;
+    static constexpr double growStep = 1.1;
+
+    // The fractions of the limit above which caches shrink, and below
+    // which they grow
+    static constexpr double highMark = 0.9;
+    static constexpr double lowMark = 0.75;
+
+    /** @param limit The bytes the process may be resident in. */
+    CacheGovernor(std::size_t limit, beast::Journal journal);
+
+    void
+    add(std::string name, Lookups lookups, Scale scale);
+
+    /** Governs a cache with the targets and lookups of a TaggedCache. */
+    template <class Cache>
+    void
+    add(std::string name, Cache& cache)
+    {
+        using duration = typename Cache::clock_type::duration;
+
+        auto const size = cache.getTargetSize();
+        auto const bytes = cache.getTargetBytes();
+        auto const age = cache.getTargetAge();
+
+        add(std::move(name),
+            [&cache]() { return cache.getLookups(); },
+            [&cache, size, bytes, age](double factor) {
+                if (size > 0)
+                    cache.setTargetSize(
+                        std::max(1, static_cast<int>(size * factor)));
+                if (bytes > 0)
+                    cache.setTargetBytes(std::max<std::size_t>(
+                        1, static_cast<std::size_t>(bytes * factor)));
+                cache.setTargetAge(
+                    std::chrono::duration_cast<duration>(age * factor));
+            });
+    }
+
+    /** Adjusts the caches for the bytes the process is resident in. */
+    void
+    update(std::size_t resident);
+
+    std::size_t
+    limit() const
+    {
+        return limit_;
+    }
+
+    /** The factor a cache is scaled by, or 0 if it is not governed. */
+    double
+    factor(std::string const& name) const;
+
+private:
+    struct Entry
+    {
+        std::string name;
+        Lookups lookups;
+        Scale scale;
+        double factor = 1.0;
+
+        // The lookups at the last update, and the hit rate since the one
+        // before
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        double hitRate = 0;
+    };
+
+    void
+    rescale(Entry& entry, double factor);
+
+    std::size_t const limit_;
+    beast::Journal const j_;
+    std::vector<Entry> caches_;
+};
+
+/** The bytes this process is resident in, or 0 if that is unknown. */
+std::size_t
+residentBytes();
+
+/** The memory limit of the cgroup of this process, or 0 if it has none. */
+std::size_t
+cgroupMemoryLimit();
+
+}  // namespace ripple
+
+#endif
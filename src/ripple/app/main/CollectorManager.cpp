@@ -27,6 +27,7 @@ class CollectorManagerImp : public CollectorManager
 public:
     beast::Journal m_journal;
     beast::insight::Collector::ptr m_collector;
+    std::shared_ptr<beast::insight::PrometheusCollector> m_prometheus;
     std::unique_ptr<beast::insight::Groups> m_groups;
 
     CollectorManagerImp(Section const& params, beast::Journal journal)
@@ -43,6 +44,12 @@ public:
             m_collector =
                 beast::insight::StatsDCollector::New(address, prefix, journal);
         }
+        else if (server == "prometheus")
+        {
+            m_prometheus = beast::insight::PrometheusCollector::New(
+                get(params, "prefix"), journal);
+            m_collector = m_prometheus;
+        }
         else
         {
             m_collector = beast::insight::NullCollector::New();
@@ -64,6 +71,14 @@ public:
     {
         return m_groups->get(name);
     }
+
+    std::optional<std::string>
+    metrics() override
+    {
+        if (!m_prometheus)
+            return std::nullopt;
+        return m_prometheus->format();
+    }
 };
 
 //------------------------------------------------------------------------------
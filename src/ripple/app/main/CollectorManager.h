@@ -22,6 +22,8 @@
 
 #include <ripple/basics/BasicConfig.h>
 #include <ripple/beast/insight/Insight.h>
+#include <optional>
+#include <string>
 
 namespace ripple {
 
@@ -36,6 +38,13 @@ public:
 
     virtual beast::insight::Group::ptr const&
     group(std::string const& name) = 0;
+
+    /** The metrics in the Prometheus text format.
+
+        Returns nothing unless the collector keeps its metrics for a scrape.
+    */
+    virtual std::optional<std::string>
+    metrics() = 0;
 };
 
 std::unique_ptr<CollectorManager>
@@ -25,6 +25,8 @@
 #include <ripple/beast/net/IPAddressConversion.h>
 #include <ripple/core/ConfigSections.h>
 
+#include <algorithm>
+
 namespace ripple {
 
 namespace {
@@ -424,6 +426,240 @@ GRPCServerImpl::CallData<Request, Response>::getUsage()
     Throw<std::runtime_error>("Failed to get client endpoint");
 }
 
+GRPCServerImpl::LedgerDataStreamCall::LedgerDataStreamCall(
+    org::xrpl::rpc::v1::XRPLedgerAPIService::AsyncService& service,
+    grpc::ServerCompletionQueue& cq,
+    Application& app,
+    std::vector<boost::asio::ip::address> const& secureGatewayIPs)
+    : service_(service)
+    , cq_(cq)
+    , app_(app)
+    , writer_(&ctx_)
+    , secureGatewayIPs_(secureGatewayIPs)
+{
+    service_.RequestStreamLedgerData(
+        &ctx_, &request_, &writer_, &cq_, &cq_, this);
+}
+
+std::shared_ptr<Processor>
+GRPCServerImpl::LedgerDataStreamCall::clone()
+{
+    return std::make_shared<LedgerDataStreamCall>(
+        service_, cq_, app_, secureGatewayIPs_);
+}
+
+void
+GRPCServerImpl::LedgerDataStreamCall::process()
+{
+    BOOST_ASSERT(!started_);
+    started_ = true;
+    if (!app_.getJobQueue().addJob(
+            JobType::jtRPC,
+            "gRPC-Stream",
+            [self = shared_from_this()]() { self->start(); }))
+    {
+        std::lock_guard lock(mutex_);
+        finish(
+            {grpc::StatusCode::INTERNAL, "Job Queue is already stopped"},
+            lock);
+    }
+}
+
+bool
+GRPCServerImpl::LedgerDataStreamCall::isFinished()
+{
+    return finished_;
+}
+
+bool
+GRPCServerImpl::LedgerDataStreamCall::isStreaming()
+{
+    return started_ && !finished_;
+}
+
+void
+GRPCServerImpl::LedgerDataStreamCall::resume()
+{
+    std::lock_guard lock(mutex_);
+    writing_ = false;
+    if (cancelled_)
+        return;
+
+    if (ready_)
+    {
+        auto response = std::move(*ready_);
+        ready_.reset();
+        write(std::move(response), lock);
+    }
+    else if (!more_)
+    {
+        finish(status_, lock);
+    }
+    // Otherwise the next message is still being built, and is written as
+    // soon as it is done
+}
+
+void
+GRPCServerImpl::LedgerDataStreamCall::cancel()
+{
+    std::lock_guard lock(mutex_);
+    cancelled_ = true;
+    ready_.reset();
+}
+
+void
+GRPCServerImpl::LedgerDataStreamCall::start()
+{
+    try
+    {
+        auto const endpoint = getEndpoint(ctx_.peer());
+        if (!endpoint)
+            Throw<std::runtime_error>("Failed to get client endpoint");
+        usage_ = app_.getResourceManager().newInboundEndpoint(
+            beast::IP::from_asio(*endpoint));
+
+        if (!request_.user().empty())
+        {
+            isUnlimited_ = std::find(
+                               secureGatewayIPs_.begin(),
+                               secureGatewayIPs_.end(),
+                               endpoint->address()) != secureGatewayIPs_.end();
+        }
+
+        if (!isUnlimited_ && usage_->disconnect(app_.journal("gRPCServer")))
+        {
+            std::lock_guard lock(mutex_);
+            finish(
+                {grpc::StatusCode::RESOURCE_EXHAUSTED,
+                 "usage balance exceeds threshold"},
+                lock);
+            return;
+        }
+
+        Resource::Charge loadType = Resource::feeMediumBurdenRPC;
+        RPC::GRPCContext<Request> context{
+            {app_.journal("gRPCServer"),
+             app_,
+             loadType,
+             app_.getOPs(),
+             app_.getLedgerMaster(),
+             *usage_,
+             isUnlimited_ ? Role::IDENTIFIED : Role::USER,
+             nullptr,
+             InfoSub::pointer(),
+             apiVersion},
+            request_};
+
+        if (auto const status = stream_.open(context); !status.ok())
+        {
+            std::lock_guard lock(mutex_);
+            finish(status, lock);
+            return;
+        }
+    }
+    catch (std::exception const& ex)
+    {
+        std::lock_guard lock(mutex_);
+        finish({grpc::StatusCode::INTERNAL, ex.what()}, lock);
+        return;
+    }
+
+    build();
+}
+
+void
+GRPCServerImpl::LedgerDataStreamCall::build()
+{
+    Response response;
+    bool more;
+    try
+    {
+        more = stream_.next(response);
+    }
+    catch (std::exception const& ex)
+    {
+        std::lock_guard lock(mutex_);
+        finish({grpc::StatusCode::INTERNAL, ex.what()}, lock);
+        return;
+    }
+
+    // Each message costs what a page of GetLedgerData does
+    if (isUnlimited_)
+    {
+        response.set_is_unlimited(true);
+    }
+    else
+    {
+        usage_->charge(Resource::feeMediumBurdenRPC);
+        if (usage_->disconnect(app_.journal("gRPCServer")))
+        {
+            std::lock_guard lock(mutex_);
+            finish(
+                {grpc::StatusCode::RESOURCE_EXHAUSTED,
+                 "usage balance exceeds threshold"},
+                lock);
+            return;
+        }
+    }
+
+    std::lock_guard lock(mutex_);
+    if (cancelled_ || !more_)
+        return;
+
+    more_ = more;
+    if (writing_)
+        ready_ = std::move(response);
+    else
+        write(std::move(response), lock);
+}
+
+void
+GRPCServerImpl::LedgerDataStreamCall::postBuild(
+    std::lock_guard<std::mutex> const&)
+{
+    if (!app_.getJobQueue().addJob(
+            JobType::jtRPC,
+            "gRPC-Stream",
+            [self = shared_from_this()]() { self->build(); }))
+    {
+        more_ = false;
+        status_ = {grpc::StatusCode::INTERNAL, "Job Queue is already stopped"};
+    }
+}
+
+void
+GRPCServerImpl::LedgerDataStreamCall::write(
+    Response&& response,
+    std::lock_guard<std::mutex> const& lock)
+{
+    writing_ = true;
+    writer_.Write(response, this);
+
+    // Build the next message while this one is being sent
+    if (more_)
+        postBuild(lock);
+}
+
+void
+GRPCServerImpl::LedgerDataStreamCall::finish(
+    grpc::Status const& status,
+    std::lock_guard<std::mutex> const&)
+{
+    // Only one operation may be outstanding. If a message is still being
+    // written, the stream ends once it has been sent.
+    if (writing_)
+    {
+        status_ = status;
+        more_ = false;
+        ready_.reset();
+        return;
+    }
+
+    // Set before the call, since the event it returns may be handled at once
+    finished_ = true;
+    writer_.Finish(status, this);
+}
+
 GRPCServerImpl::GRPCServerImpl(Application& app)
     : app_(app), journal_(app_.journal("gRPC Server"))
 {
@@ -557,8 +793,14 @@ GRPCServerImpl::handleRpcs()
         {
             JLOG(journal_.debug()) << "Request listener cancelled. "
                                    << "Destroying object";
+            ptr->cancel();
             erase(ptr);
         }
+        else if (ptr->isStreaming())
+        {
+            JLOG(journal_.trace()) << "Sent message. Continuing stream";
+            ptr->resume();
+        }
         else
         {
             if (!ptr->isFinished())
@@ -659,6 +901,8 @@ GRPCServerImpl::setupListeners()
             Resource::feeMediumBurdenRPC,
             secureGatewayIPs_));
     }
+    addToRequests(std::make_shared<LedgerDataStreamCall>(
+        service_, *cq_, app_, secureGatewayIPs_));
     return requests;
 }
 
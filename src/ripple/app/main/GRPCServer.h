@@ -35,6 +35,10 @@
 #include "org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h"
 #include <grpcpp/grpcpp.h>
 
+#include <atomic>
+#include <mutex>
+#include <optional>
+
 namespace ripple {
 
 // Interface that CallData implements
@@ -65,6 +69,28 @@ public:
     // deleted once this function returns true
     virtual bool
     isFinished() = 0;
+
+    // true if this object has started processing a request, but has not
+    // finished. Only a streaming call is ever in this state, since it gets
+    // an event for each message written to the client
+    virtual bool
+    isStreaming()
+    {
+        return false;
+    }
+
+    // called when a message written to a stream has been sent
+    virtual void
+    resume()
+    {
+    }
+
+    // called when an operation on this object has been cancelled, after
+    // which it gets no more events
+    virtual void
+    cancel()
+    {
+    }
 };
 
 class GRPCServerImpl final
@@ -291,6 +317,104 @@ private:
 
     };  // CallData
 
+    // Serves a StreamLedgerData call. Each message is built on the JobQueue
+    // while the one before it is being written, and only one write is ever
+    // outstanding, so a slow client holds back the walk of the ledger
+    // instead of having messages pile up in memory.
+    class LedgerDataStreamCall
+        : public Processor,
+          public std::enable_shared_from_this<LedgerDataStreamCall>
+    {
+    private:
+        using Request = LedgerDataStream::Request;
+        using Response = LedgerDataStream::Response;
+
+        org::xrpl::rpc::v1::XRPLedgerAPIService::AsyncService& service_;
+
+        grpc::ServerCompletionQueue& cq_;
+
+        grpc::ServerContext ctx_;
+
+        Application& app_;
+
+        Request request_;
+
+        grpc::ServerAsyncWriter<Response> writer_;
+
+        std::vector<boost::asio::ip::address> const& secureGatewayIPs_;
+
+        LedgerDataStream stream_;
+
+        std::optional<Resource::Consumer> usage_;
+
+        bool isUnlimited_ = false;
+
+        std::atomic_bool started_{false};
+
+        std::atomic_bool finished_{false};
+
+        std::mutex mutex_;
+
+        // true while a message is being written
+        bool writing_ = false;
+
+        // true if the stream has more messages after the last one built
+        bool more_ = true;
+
+        // true once the client has gone away
+        bool cancelled_ = false;
+
+        // A message built while the one before it is still being written
+        std::optional<Response> ready_;
+
+        // What the stream ends with, once the last message is written
+        grpc::Status status_;
+
+    public:
+        LedgerDataStreamCall(
+            org::xrpl::rpc::v1::XRPLedgerAPIService::AsyncService& service,
+            grpc::ServerCompletionQueue& cq,
+            Application& app,
+            std::vector<boost::asio::ip::address> const& secureGatewayIPs);
+
+        void
+        process() override;
+
+        bool
+        isFinished() override;
+
+        bool
+        isStreaming() override;
+
+        void
+        resume() override;
+
+        void
+        cancel() override;
+
+        std::shared_ptr<Processor>
+        clone() override;
+
+    private:
+        // Find the ledger and build the first message. Runs as a job.
+        void
+        start();
+
+        // Build the next message. Runs as a job.
+        void
+        build();
+
+        // Post a job to build the next message
+        void
+        postBuild(std::lock_guard<std::mutex> const&);
+
+        void
+        write(Response&& response, std::lock_guard<std::mutex> const&);
+
+        void
+        finish(grpc::Status const& status, std::lock_guard<std::mutex> const&);
+    };
+
 };  // GRPCServerImpl
 
 class GRPCServer
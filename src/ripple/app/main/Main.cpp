@@ -400,6 +400,10 @@ run(int argc, char** argv)
         "net", "Get the initial ledger from the network.")(
         "nodetoshard", "Import node store into shards")(
         "replay", "Replay a ledger close.")(
+        "replay_count",
+        po::value<std::uint32_t>(),
+        "With --replay, replay and verify this many consecutive ledgers as "
+        "a benchmark, then exit.")(
         "start", "Start from a fresh Ledger.")(
         "startReporting",
         po::value<std::string>(),
@@ -693,6 +697,17 @@ run(int argc, char** argv)
         config->START_UP = Config::LOAD;
     }
 
+    if (vm.count("replay_count"))
+    {
+        if (config->START_UP != Config::REPLAY)
+        {
+            std::cerr << "replay_count requires --replay and --ledger"
+                      << std::endl;
+            return -1;
+        }
+        config->REPLAY_COUNT = vm["replay_count"].as<std::uint32_t>();
+    }
+
     if (vm.count("net") && !config->FAST_LOAD)
     {
         if ((config->START_UP == Config::LOAD) ||
@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/main/Application.h>
+#include <ripple/app/main/MemoryUsage.h>
+#include <ripple/ledger/CachedSLEs.h>
+#include <ripple/nodestore/Database.h>
+#include <ripple/overlay/Overlay.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/impl/ResponseCache.h>
+#include <ripple/shamap/SHAMapItem.h>
+#include <ripple/shamap/TreeNodeCache.h>
+#include <string>
+
+namespace ripple {
+
+MemoryUsage
+getMemoryUsage(Application& app)
+{
+    MemoryUsage usage;
+
+    usage.treeNodeCache =
+        app.getNodeFamily().getTreeNodeCache(0)->getCacheBytes();
+    for (auto const& c : detail::slabber.getCounts())
+        usage.shamapItems += c.capacity * c.itemSize;
+    usage.nodeStoreCache = app.getNodeStore().getCacheBytes();
+    usage.ledgerCache = app.getLedgerMaster().getCacheBytes();
+    usage.sleCache = app.cachedSLEs().bytes();
+    if (auto const cache = app.getRPCResponseCache())
+        usage.rpcResponses = cache->bytes();
+    if (!app.config().reporting())
+        usage.sendQueues = app.overlay().getSendQueueBytes();
+
+    return usage;
+}
+
+Json::Value
+toJson(MemoryUsage const& usage)
+{
+    Json::Value ret(Json::objectValue);
+    ret[jss::treenode_cache] = std::to_string(usage.treeNodeCache);
+    ret[jss::shamap_items] = std::to_string(usage.shamapItems);
+    ret[jss::node_cache] = std::to_string(usage.nodeStoreCache);
+    ret[jss::ledger_cache] = std::to_string(usage.ledgerCache);
+    ret[jss::sle_cache] = std::to_string(usage.sleCache);
+    ret[jss::rpc_responses] = std::to_string(usage.rpcResponses);
+    ret[jss::send_queues] = std::to_string(usage.sendQueues);
+    ret[jss::total] = std::to_string(usage.total());
+    return ret;
+}
+
+MemoryGauges::MemoryGauges(
+    Application& app,
+    beast::insight::Collector::ptr const& collector)
+    : app_(app)
+    , treeNodeCache_(collector->make_gauge("treenode_cache"))
+    , shamapItems_(collector->make_gauge("shamap_items"))
+    , nodeStoreCache_(collector->make_gauge("node_cache"))
+    , ledgerCache_(collector->make_gauge("ledger_cache"))
+    , sleCache_(collector->make_gauge("sle_cache"))
+    , rpcResponses_(collector->make_gauge("rpc_responses"))
+    , sendQueues_(collector->make_gauge("send_queues"))
+    , total_(collector->make_gauge("total"))
+    , hook_(collector->make_hook([this]() { collect_metrics(); }))
+{
+}
+
+void
+MemoryGauges::collect_metrics()
+{
+    auto const usage = getMemoryUsage(app_);
+    treeNodeCache_.set(usage.treeNodeCache);
+    shamapItems_.set(usage.shamapItems);
+    nodeStoreCache_.set(usage.nodeStoreCache);
+    ledgerCache_.set(usage.ledgerCache);
+    sleCache_.set(usage.sleCache);
+    rpcResponses_.set(usage.rpcResponses);
+    sendQueues_.set(usage.sendQueues);
+    total_.set(usage.total());
+}
+
+}  // namespace ripple
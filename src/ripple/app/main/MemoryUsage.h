@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_MAIN_MEMORYUSAGE_H_INCLUDED
+#define RIPPLE_APP_MAIN_MEMORYUSAGE_H_INCLUDED
+
+#include <ripple/beast/insight/Collector.h>
+#include <ripple/json/json_value.h>
+#include <cstddef>
+
+namespace ripple {
+
+class Application;
+
+/** The approximate number of bytes held by each major subsystem.
+
+    The figures come from the byte accounting the caches already keep for
+    their budgets, so they cost little to gather. Memory that is shared,
+    such as a tree node held by both a ledger and the tree node cache, is
+    counted by each subsystem that holds it.
+*/
+struct MemoryUsage
+{
+    std::size_t treeNodeCache = 0;
+    std::size_t shamapItems = 0;
+    std::size_t nodeStoreCache = 0;
+    std::size_t ledgerCache = 0;
+    std::size_t sleCache = 0;
+    std::size_t rpcResponses = 0;
+    std::size_t sendQueues = 0;
+
+    std::size_t
+    total() const
+    {
+        return treeNodeCache + shamapItems + nodeStoreCache + ledgerCache +
+            sleCache + rpcResponses + sendQueues;
+    }
+};
+
+MemoryUsage
+getMemoryUsage(Application& app);
+
+/** Report the byte figures of a MemoryUsage, as strings. */
+Json::Value
+toJson(MemoryUsage const& usage);
+
+/** Exports the memory usage of each subsystem as insight gauges. */
+class MemoryGauges
+{
+public:
+    MemoryGauges(
+        Application& app,
+        beast::insight::Collector::ptr const& collector);
+
+    MemoryGauges(MemoryGauges const&) = delete;
+    MemoryGauges&
+    operator=(MemoryGauges const&) = delete;
+
+private:
+    void
+    collect_metrics();
+
+    Application& app_;
+    beast::insight::Gauge treeNodeCache_;
+    beast::insight::Gauge shamapItems_;
+    beast::insight::Gauge nodeStoreCache_;
+    beast::insight::Gauge ledgerCache_;
+    beast::insight::Gauge sleCache_;
+    beast::insight::Gauge rpcResponses_;
+    beast::insight::Gauge sendQueues_;
+    beast::insight::Gauge total_;
+    // Declared last so that no gauge is used before it is constructed
+    beast::insight::Hook hook_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -22,8 +22,17 @@
 
 namespace ripple {
 
-NodeStoreScheduler::NodeStoreScheduler(JobQueue& jobQueue) : jobQueue_(jobQueue)
+NodeStoreScheduler::NodeStoreScheduler(
+    JobQueue& jobQueue,
+    CollectorManager& cm)
+    : jobQueue_(jobQueue)
 {
+    auto const& group(cm.group("nodestore"));
+    writeQueueDepth_ = group->make_gauge("write_queue_depth");
+    writeBytes_ = group->make_counter("write_bytes");
+    writeBatchSize_ = group->make_event("write_batch_size");
+    writeTime_ = group->make_event("write_time");
+    writeStall_ = group->make_event("write_stall");
 }
 
 void
@@ -62,6 +71,16 @@ NodeStoreScheduler::onBatchWrite(NodeStore::BatchWriteReport const& report)
         return;
 
     jobQueue_.addLoadEvents(jtNS_WRITE, report.writeCount, report.elapsed);
+
+    writeQueueDepth_ = report.queueDepth;
+    writeBytes_ += report.writeBytes;
+    writeBatchSize_.notify(
+        beast::insight::Event::value_type{report.writeCount});
+    writeTime_.notify(report.elapsed);
+    if (report.stallTime.count() > 0)
+        writeStall_.notify(
+            std::chrono::duration_cast<beast::insight::Event::value_type>(
+                report.stallTime));
 }
 
 }  // namespace ripple
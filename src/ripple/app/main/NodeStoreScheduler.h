@@ -20,6 +20,7 @@
 #ifndef RIPPLE_APP_MAIN_NODESTORESCHEDULER_H_INCLUDED
 #define RIPPLE_APP_MAIN_NODESTORESCHEDULER_H_INCLUDED
 
+#include <ripple/app/main/CollectorManager.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/nodestore/Scheduler.h>
 #include <atomic>
@@ -30,7 +31,7 @@ namespace ripple {
 class NodeStoreScheduler : public NodeStore::Scheduler
 {
 public:
-    explicit NodeStoreScheduler(JobQueue& jobQueue);
+    NodeStoreScheduler(JobQueue& jobQueue, CollectorManager& cm);
 
     void
     scheduleTask(NodeStore::Task& task) override;
@@ -41,6 +42,13 @@ public:
 
 private:
     JobQueue& jobQueue_;
+
+    // Batch write metrics
+    beast::insight::Gauge writeQueueDepth_;
+    beast::insight::Counter writeBytes_;
+    beast::insight::Event writeBatchSize_;
+    beast::insight::Event writeTime_;
+    beast::insight::Event writeStall_;
 };
 
 }  // namespace ripple
@@ -19,6 +19,9 @@
 
 #include <ripple/app/misc/CanonicalTXSet.h>
 
+#include <algorithm>
+#include <cassert>
+
 namespace ripple {
 
 bool
@@ -48,14 +51,59 @@ CanonicalTXSet::accountKey(AccountID const& account)
     return ret;
 }
 
+void
+CanonicalTXSet::settle() const
+{
+    if (pending_.empty())
+        return;
+
+    auto const less = [](Entry const& lhs, Entry const& rhs) {
+        return lhs.first < rhs.first;
+    };
+
+    // Close the gaps, then merge in the new transactions. Both sorts are
+    // stable and the earlier of two equal keys is kept, so inserting a
+    // transaction that is already held changes nothing.
+    std::erase_if(entries_, [](Entry const& e) { return !e.second; });
+    std::stable_sort(pending_.begin(), pending_.end(), less);
+    auto const held = entries_.size();
+    entries_.insert(
+        entries_.end(),
+        std::make_move_iterator(pending_.begin()),
+        std::make_move_iterator(pending_.end()));
+    pending_.clear();
+    std::inplace_merge(
+        entries_.begin(), entries_.begin() + held, entries_.end(), less);
+    entries_.erase(
+        std::unique(
+            entries_.begin(),
+            entries_.end(),
+            [](Entry const& lhs, Entry const& rhs) {
+                return !(lhs.first < rhs.first) && !(rhs.first < lhs.first);
+            }),
+        entries_.end());
+    size_ = entries_.size();
+}
+
 void
 CanonicalTXSet::insert(std::shared_ptr<STTx const> const& txn)
 {
-    map_.insert(std::make_pair(
+    pending_.emplace_back(
         Key(accountKey(txn->getAccountID(sfAccount)),
             txn->getSeqProxy(),
             txn->getTransactionID()),
-        txn));
+        txn);
+}
+
+CanonicalTXSet::const_iterator
+CanonicalTXSet::erase(const_iterator const& it)
+{
+    assert(pending_.empty());
+    assert(it.pos_ && it.pos_->second);
+    auto& entry = entries_[it.pos_ - entries_.data()];
+    entry.second.reset();
+    --size_;
+    return {it.pos_ + 1, it.end_};
 }
 
 std::shared_ptr<STTx const>
@@ -74,13 +122,20 @@ CanonicalTXSet::popAcctTransaction(std::shared_ptr<STTx const> const& tx)
     std::shared_ptr<STTx const> result;
     uint256 const effectiveAccount{accountKey(tx->getAccountID(sfAccount))};
 
+    settle();
     Key const after(effectiveAccount, tx->getSeqProxy(), beast::zero);
-    auto const itrNext{map_.lower_bound(after)};
-    if (itrNext != map_.end() &&
+    auto itrNext = std::lower_bound(
+        entries_.begin(),
+        entries_.end(),
+        after,
+        [](Entry const& e, Key const& key) { return e.first < key; });
+    while (itrNext != entries_.end() && !itrNext->second)
+        ++itrNext;
+    if (itrNext != entries_.end() &&
         itrNext->first.getAccount() == effectiveAccount)
     {
         result = std::move(itrNext->second);
-        map_.erase(itrNext);
+        --size_;
     }
 
     return result;
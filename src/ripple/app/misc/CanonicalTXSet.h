@@ -25,6 +25,12 @@
 #include <ripple/protocol/STTx.h>
 #include <ripple/protocol/SeqProxy.h>
 
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace ripple {
 
 /** Holds transactions which were deferred to the next pass of consensus.
@@ -33,6 +39,10 @@ namespace ripple {
 
     - Puts transactions from the same account in SeqProxy order
 
+    The transactions are kept in a vector sorted once, when it is first
+    read after a run of inserts, rather than in a node based tree. Erasing
+    leaves a gap that iteration skips, so iterators other than the erased
+    one stay valid. Inserting invalidates every iterator.
 */
 // VFALCO TODO rename to SortedTxSet
 class CanonicalTXSet : public CountedObject<CanonicalTXSet>
@@ -100,13 +110,87 @@ private:
     friend bool
     operator<(Key const& lhs, Key const& rhs);
 
+    // An entry with a null transaction has been erased
+    using Entry = std::pair<Key, std::shared_ptr<STTx const>>;
+
     // Calculate the salted key for the given account
     uint256
     accountKey(AccountID const& account);
 
+    // Sort and merge in the transactions inserted since the last read
+    void
+    settle() const;
+
 public:
-    using const_iterator =
-        std::map<Key, std::shared_ptr<STTx const>>::const_iterator;
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Entry const*;
+        using reference = Entry const&;
+
+        const_iterator() = default;
+
+        reference
+        operator*() const
+        {
+            return *pos_;
+        }
+
+        pointer
+        operator->() const
+        {
+            return pos_;
+        }
+
+        const_iterator&
+        operator++()
+        {
+            ++pos_;
+            skip();
+            return *this;
+        }
+
+        const_iterator
+        operator++(int)
+        {
+            auto const prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        friend bool
+        operator==(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            return lhs.pos_ == rhs.pos_;
+        }
+
+        friend bool
+        operator!=(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class CanonicalTXSet;
+
+        const_iterator(pointer pos, pointer end) : pos_(pos), end_(end)
+        {
+            skip();
+        }
+
+        void
+        skip()
+        {
+            while (pos_ != end_ && !pos_->second)
+                ++pos_;
+        }
+
+        pointer pos_ = nullptr;
+        pointer end_ = nullptr;
+    };
 
 public:
     explicit CanonicalTXSet(LedgerHash const& saltHash) : salt_(saltHash)
@@ -130,36 +214,39 @@ public:
     reset(LedgerHash const& salt)
     {
         salt_ = salt;
-        map_.clear();
+        entries_.clear();
+        pending_.clear();
+        size_ = 0;
     }
 
     const_iterator
-    erase(const_iterator const& it)
-    {
-        return map_.erase(it);
-    }
+    erase(const_iterator const& it);
 
     const_iterator
     begin() const
     {
-        return map_.begin();
+        settle();
+        return {entries_.data(), entries_.data() + entries_.size()};
     }
 
     const_iterator
     end() const
     {
-        return map_.end();
+        settle();
+        auto const last = entries_.data() + entries_.size();
+        return {last, last};
     }
 
     size_t
     size() const
     {
-        return map_.size();
+        settle();
+        return size_;
     }
     bool
     empty() const
     {
-        return map_.empty();
+        return size() == 0;
     }
 
     uint256 const&
@@ -169,7 +256,12 @@ public:
     }
 
 private:
-    std::map<Key, std::shared_ptr<STTx const>> map_;
+    // Sorted by key, with gaps where transactions were erased
+    mutable std::vector<Entry> entries_;
+    // Inserted since entries_ was last sorted
+    mutable std::vector<Entry> pending_;
+    // The number of transactions in entries_, not counting the gaps
+    mutable std::size_t size_ = 0;
 
     // Used to salt the accounts so people can't mine for low account numbers
     uint256 salt_;
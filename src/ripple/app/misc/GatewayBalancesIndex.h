@@ -0,0 +1,151 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_MISC_GATEWAYBALANCESINDEX_H_INCLUDED
+#define RIPPLE_APP_MISC_GATEWAYBALANCESINDEX_H_INCLUDED
+
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/UintTypes.h>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+
+namespace ripple {
+
+class JobQueue;
+
+/** Keeps what chosen issuers owe and are owed, for gateway_balances.
+
+    Answering gateway_balances walks every trust line of the issuer,
+    which for a large gateway reads hundreds of thousands of entries. The
+    index holds the totals for the issuers named in the configuration as
+    of the last validated ledger. It is built once by walking the lines,
+    then kept up to date from the lines each validated ledger changes, on
+    one background job.
+
+    Hot wallets are chosen by each request, so what the issuer owes them
+    is included in the obligations here. The request reads its hot
+    wallets' lines and takes them out.
+*/
+class GatewayBalancesIndex
+{
+public:
+    /** The trust line totals of one issuer at one ledger. */
+    struct Balances
+    {
+        struct Sum
+        {
+            /// The total of the lines, as of the last call to total()
+            STAmount amount;
+
+            /// What the issuer owes on each line, by holder
+            std::map<AccountID, STAmount> lines;
+        };
+
+        /// What the issuer owes on lines it has not frozen, by currency
+        std::map<Currency, Sum> obligations;
+
+        /// What the issuer owes on lines it has frozen, by holder
+        std::map<AccountID, std::map<Currency, STAmount>> frozen;
+
+        /// What is owed to the issuer, by counterparty
+        std::map<AccountID, std::map<Currency, STAmount>> assets;
+    };
+
+    GatewayBalancesIndex(
+        std::set<AccountID> issuers,
+        JobQueue& jobQueue,
+        beast::Journal journal);
+
+    GatewayBalancesIndex(GatewayBalancesIndex const&) = delete;
+    GatewayBalancesIndex&
+    operator=(GatewayBalancesIndex const&) = delete;
+
+    /** Whether an issuer's balances are indexed. */
+    bool
+    tracks(AccountID const& issuer) const;
+
+    /** Bring the index up to a newly validated ledger. */
+    void
+    onValidatedLedger(std::shared_ptr<ReadView const> const& ledger);
+
+    /** The balances of an issuer, if the index is at exactly this ledger. */
+    std::shared_ptr<Balances const>
+    balances(AccountID const& issuer, ReadView const& ledger) const;
+
+    /** Add or remove the part of a trust line in an issuer's balances.
+
+        Obligations keep what each line contributes, and are only totalled
+        by total(), so repeated changes never accumulate rounding.
+
+        @return The currency of the obligations the line changed, if any.
+    */
+    static std::optional<Currency>
+    apply(
+        Balances& balances,
+        AccountID const& issuer,
+        std::shared_ptr<SLE const> const& line,
+        bool add);
+
+    /** Add up the lines of the obligations in one currency again. */
+    static void
+    total(Balances& balances, Currency const& currency);
+
+private:
+    // The balances of every issuer at one ledger, never changed once built
+    struct Snapshot
+    {
+        std::shared_ptr<ReadView const> ledger;
+        std::map<AccountID, std::shared_ptr<Balances const>> issuers;
+    };
+
+    // Validated ledgers waiting for the job. Past this many, the index is
+    // rebuilt at the newest instead of catching up.
+    static constexpr std::size_t maxPending = 256;
+
+    void
+    update();
+
+    std::shared_ptr<Snapshot const>
+    advance(
+        std::shared_ptr<Snapshot const> const& prior,
+        std::shared_ptr<ReadView const> const& ledger) const;
+
+    std::shared_ptr<Balances const>
+    build(AccountID const& issuer, ReadView const& ledger) const;
+
+    std::set<AccountID> const issuers_;
+    JobQueue& jobQueue_;
+    beast::Journal const j_;
+
+    mutable std::mutex mutex_;
+    std::shared_ptr<Snapshot const> snapshot_;
+    std::deque<std::shared_ptr<ReadView const>> pending_;
+    bool running_ = false;
+};
+
+}  // namespace ripple
+
+#endif
@@ -22,29 +22,33 @@
 namespace ripple {
 
 auto
-HashRouter::emplace(uint256 const& key) -> std::pair<Entry&, bool>
+HashRouter::emplace(SuppressionMap& suppressionMap, uint256 const& key)
+    -> std::pair<Entry&, bool>
 {
-    auto iter = suppressionMap_.find(key);
+    auto iter = suppressionMap.find(key);
 
-    if (iter != suppressionMap_.end())
+    if (iter != suppressionMap.end())
     {
-        suppressionMap_.touch(iter);
+        suppressionMap.touch(iter);
         return std::make_pair(std::ref(iter->second), false);
     }
 
-    // See if any supressions need to be expired
-    expire(suppressionMap_, holdTime_);
+    // See if any supressions in this partition need to be expired. Each
+    // insertion expires only a few, so that a burst of entries which were
+    // inserted together does not all expire inside a single call.
+    expire(suppressionMap, holdTime_, expireBatch);
 
     return std::make_pair(
-        std::ref(suppressionMap_.emplace(key, Entry()).first->second), true);
+        std::ref(suppressionMap.emplace(key, Entry()).first->second), true);
 }
 
 void
 HashRouter::addSuppression(uint256 const& key)
 {
-    std::lock_guard lock(mutex_);
+    auto& p = partition(key);
+    std::lock_guard lock(p.mutex);
 
-    emplace(key);
+    emplace(p.suppressionMap, key);
 }
 
 bool
@@ -56,9 +60,10 @@ HashRouter::addSuppressionPeer(uint256 const& key, PeerShortID peer)
 std::pair<bool, std::optional<Stopwatch::time_point>>
 HashRouter::addSuppressionPeerWithStatus(const uint256& key, PeerShortID peer)
 {
-    std::lock_guard lock(mutex_);
+    auto& p = partition(key);
+    std::lock_guard lock(p.mutex);
 
-    auto result = emplace(key);
+    auto result = emplace(p.suppressionMap, key);
     result.first.addPeer(peer);
     return {result.second, result.first.relayed()};
 }
@@ -66,9 +71,10 @@ HashRouter::addSuppressionPeerWithStatus(const uint256& key, PeerShortID peer)
 bool
 HashRouter::addSuppressionPeer(uint256 const& key, PeerShortID peer, int& flags)
 {
-    std::lock_guard lock(mutex_);
+    auto& p = partition(key);
+    std::lock_guard lock(p.mutex);
 
-    auto [s, created] = emplace(key);
+    auto [s, created] = emplace(p.suppressionMap, key);
     s.addPeer(peer);
     flags = s.getFlags();
     return created;
@@ -81,21 +87,32 @@ HashRouter::shouldProcess(
     int& flags,
     std::chrono::seconds tx_interval)
 {
-    std::lock_guard lock(mutex_);
+    auto& p = partition(key);
+    std::lock_guard lock(p.mutex);
 
-    auto result = emplace(key);
+    auto result = emplace(p.suppressionMap, key);
     auto& s = result.first;
     s.addPeer(peer);
     flags = s.getFlags();
-    return s.shouldProcess(suppressionMap_.clock().now(), tx_interval);
+    return s.shouldProcess(p.suppressionMap.clock().now(), tx_interval);
 }
 
 int
 HashRouter::getFlags(uint256 const& key)
 {
-    std::lock_guard lock(mutex_);
+    auto& p = partition(key);
+    std::lock_guard lock(p.mutex);
 
-    return emplace(key).first.getFlags();
+    return emplace(p.suppressionMap, key).first.getFlags();
+}
+
+bool
+HashRouter::contains(uint256 const& key)
+{
+    auto& p = partition(key);
+    std::lock_guard lock(p.mutex);
+
+    return p.suppressionMap.find(key) != p.suppressionMap.end();
 }
 
 bool
@@ -103,9 +120,10 @@ HashRouter::setFlags(uint256 const& key, int flags)
 {
     assert(flags != 0);
 
-    std::lock_guard lock(mutex_);
+    auto& p = partition(key);
+    std::lock_guard lock(p.mutex);
 
-    auto& s = emplace(key).first;
+    auto& s = emplace(p.suppressionMap, key).first;
 
     if ((s.getFlags() & flags) == flags)
         return false;
@@ -118,11 +136,12 @@ auto
 HashRouter::shouldRelay(uint256 const& key)
     -> std::optional<std::set<PeerShortID>>
 {
-    std::lock_guard lock(mutex_);
+    auto& p = partition(key);
+    std::lock_guard lock(p.mutex);
 
-    auto& s = emplace(key).first;
+    auto& s = emplace(p.suppressionMap, key).first;
 
-    if (!s.shouldRelay(suppressionMap_.clock().now(), holdTime_))
+    if (!s.shouldRelay(p.suppressionMap.clock().now(), holdTime_))
         return {};
 
     return s.releasePeerSet();
@@ -21,12 +21,16 @@
 #define RIPPLE_APP_MISC_HASHROUTER_H_INCLUDED
 
 #include <ripple/basics/CountedObject.h>
+#include <ripple/basics/ProfiledMutex.h>
 #include <ripple/basics/UnorderedContainers.h>
 #include <ripple/basics/base_uint.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/container/aged_unordered_map.h>
 
+#include <array>
+#include <mutex>
 #include <optional>
+#include <utility>
 
 namespace ripple {
 
@@ -49,6 +53,17 @@ namespace ripple {
     This table keeps track of which hashes have been received by which peers.
     It is used to manage the routing and broadcasting of messages in the peer
     to peer overlay.
+
+    Every message relayed by every peer passes through here, so the table is
+    split into partitions by hash, each with a lock of its own. Entries age
+    and expire within their partition.
+
+    This table also keeps signed messages from being verified more than
+    once. Proposals and validations are keyed by hashes that cover their
+    signatures, and transactions by their IDs. Copies that arrive from
+    other peers are suppressed here, on receipt, before any signature is
+    checked. The outcome of a transaction's signature check is kept in
+    the entry's flags.
 */
 class HashRouter
 {
@@ -144,7 +159,10 @@ public:
     }
 
     HashRouter(Stopwatch& clock, std::chrono::seconds entryHoldTimeInSeconds)
-        : suppressionMap_(clock), holdTime_(entryHoldTimeInSeconds)
+        : HashRouter(
+              clock,
+              entryHoldTimeInSeconds,
+              std::make_index_sequence<partitionCount>{})
     {
     }
 
@@ -190,6 +208,14 @@ public:
     int
     getFlags(uint256 const& key);
 
+    /** Determines whether the hash has an entry, without adding one.
+
+        Unlike the other members, this does not refresh the entry's
+        hold time.
+    */
+    bool
+    contains(uint256 const& key);
+
     /** Determines whether the hashed item should be relayed.
 
         Effects:
@@ -206,19 +232,54 @@ public:
     shouldRelay(uint256 const& key);
 
 private:
-    // pair.second indicates whether the entry was created
-    std::pair<Entry&, bool>
-    emplace(uint256 const&);
+    // A power of two, so a partition is picked with a mask
+    static constexpr std::size_t partitionCount = 32;
 
-    std::mutex mutable mutex_;
+    // The most entries one insertion expires. More than one, so that the
+    // expired entries are removed faster than new ones arrive.
+    static constexpr std::size_t expireBatch = 8;
 
-    // Stores all suppressed hashes and their expiration time
-    beast::aged_unordered_map<
+    using SuppressionMap = beast::aged_unordered_map<
         uint256,
         Entry,
         Stopwatch::clock_type,
-        hardened_hash<strong_hash>>
-        suppressionMap_;
+        hardened_hash<strong_hash>>;
+
+    struct Partition
+    {
+        Partition(Stopwatch& clock)
+            : mutex("HashRouter"), suppressionMap(clock)
+        {
+        }
+
+        ProfiledMutex<std::mutex> mutex;
+
+        // Stores the suppressed hashes and their expiration time
+        SuppressionMap suppressionMap;
+    };
+
+    template <std::size_t... Is>
+    HashRouter(
+        Stopwatch& clock,
+        std::chrono::seconds entryHoldTimeInSeconds,
+        std::index_sequence<Is...>)
+        : partitions_{{(static_cast<void>(Is), clock)...}}
+        , holdTime_(entryHoldTimeInSeconds)
+    {
+    }
+
+    Partition&
+    partition(uint256 const& key)
+    {
+        // The keys are hashes, so any of their bits spread them evenly
+        return partitions_[*key.data() & (partitionCount - 1)];
+    }
+
+    // pair.second indicates whether the entry was created
+    std::pair<Entry&, bool>
+    emplace(SuppressionMap& suppressionMap, uint256 const&);
+
+    std::array<Partition, partitionCount> partitions_;
 
     std::chrono::seconds const holdTime_;
 };
@@ -193,15 +193,21 @@ NegativeUNLVote::buildScoreTable(
         scoreTable[k] = 0;
     }
 
-    // Query the validation container for every ledger hash and fill
-    // the score table.
-    for (int i = 0; i < FLAG_LEDGER_INTERVAL; ++i)
+    // Use the scores kept as ledgers were built. Otherwise, for instance
+    // just after start up or a switch of chains, query the validation
+    // container for every ledger hash and fill the score table.
+    if (!scoreFromWindow(seq, ledgerAncestors, scoreTable))
     {
-        for (auto const& v : validations.getTrustedForLedger(
-                 ledgerAncestors[numAncestors - 1 - i], seq - 2 - i))
+        JLOG(j_.debug()) << "N-UNL: ledger " << seq
+                         << " rebuilding scores from validations.";
+        for (int i = 0; i < FLAG_LEDGER_INTERVAL; ++i)
         {
-            if (scoreTable.count(v->getNodeID()))
-                ++scoreTable[v->getNodeID()];
+            for (auto const& v : validations.getTrustedForLedger(
+                     ledgerAncestors[numAncestors - 1 - i], seq - 2 - i))
+            {
+                if (scoreTable.count(v->getNodeID()))
+                    ++scoreTable[v->getNodeID()];
+            }
         }
     }
 
@@ -238,6 +244,79 @@ NegativeUNLVote::buildScoreTable(
     }
 }
 
+bool
+NegativeUNLVote::scoreFromWindow(
+    LedgerIndex seq,
+    std::vector<uint256> const& ancestors,
+    hash_map<NodeID, std::uint32_t>& scoreTable)
+{
+    std::lock_guard lock(mutex_);
+    if (window_.size() != FLAG_LEDGER_INTERVAL ||
+        ancestors.size() < FLAG_LEDGER_INTERVAL)
+        return false;
+
+    // The window must end at the parent of the parent ledger and follow
+    // the same chain.
+    auto const numAncestors = ancestors.size();
+    for (std::size_t i = 0; i < FLAG_LEDGER_INTERVAL; ++i)
+    {
+        auto const& ledger = window_[FLAG_LEDGER_INTERVAL - 1 - i];
+        if (ledger.seq != seq - 2 - i ||
+            ledger.hash != ancestors[numAncestors - 1 - i])
+            return false;
+    }
+
+    for (auto& [nodeId, score] : scoreTable)
+    {
+        if (auto const it = windowScores_.find(nodeId);
+            it != windowScores_.end())
+            score = it->second;
+    }
+    return true;
+}
+
+void
+NegativeUNLVote::observe(
+    std::shared_ptr<Ledger const> const& prevLedger,
+    RCLValidations& validations)
+{
+    if (prevLedger->seq() < 2)
+        return;
+
+    Participation ledger{
+        prevLedger->seq() - 1, prevLedger->info().parentHash, {}};
+    for (auto const& v :
+         validations.getTrustedForLedger(ledger.hash, ledger.seq))
+        ledger.validators.push_back(v->getNodeID());
+
+    std::lock_guard lock(mutex_);
+    if (!window_.empty() && window_.back().seq == ledger.seq &&
+        window_.back().hash == ledger.hash)
+        return;
+
+    // Start over if this ledger does not follow the last one observed
+    if (!window_.empty() && window_.back().seq + 1 != ledger.seq)
+    {
+        window_.clear();
+        windowScores_.clear();
+    }
+
+    for (auto const& nodeId : ledger.validators)
+        ++windowScores_[nodeId];
+    window_.push_back(std::move(ledger));
+
+    while (window_.size() > FLAG_LEDGER_INTERVAL)
+    {
+        for (auto const& nodeId : window_.front().validators)
+        {
+            auto const it = windowScores_.find(nodeId);
+            if (--it->second == 0)
+                windowScores_.erase(it);
+        }
+        window_.pop_front();
+    }
+}
+
 NegativeUNLVote::Candidates const
 NegativeUNLVote::findAllCandidates(
     hash_set<NodeID> const& unl,
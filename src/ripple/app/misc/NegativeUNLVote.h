@@ -26,6 +26,7 @@
 #include <ripple/protocol/PublicKey.h>
 #include <ripple/protocol/UintTypes.h>
 
+#include <deque>
 #include <optional>
 
 namespace ripple {
@@ -123,12 +124,42 @@ public:
     void
     newValidators(LedgerIndex seq, hash_set<NodeID> const& nowTrusted);
 
+    /**
+     * Count the validations of the parent of a ledger towards the scores.
+     *
+     * Called for every ledger we build on, so that the score table is
+     * ready at the flag ledger without a walk back through the validation
+     * container.
+     *
+     * @param prevLedger the parent of the ledger being built
+     * @param validations the validation message container
+     */
+    void
+    observe(
+        std::shared_ptr<Ledger const> const& prevLedger,
+        RCLValidations& validations);
+
 private:
     NodeID const myId_;
     beast::Journal j_;
     mutable std::mutex mutex_;
     hash_map<NodeID, LedgerIndex> newValidators_;
 
+    /**
+     * The trusted validators that validated a ledger
+     */
+    struct Participation
+    {
+        LedgerIndex seq;
+        uint256 hash;
+        std::vector<NodeID> validators;
+    };
+
+    // The last FLAG_LEDGER_INTERVAL ledgers observed, oldest first, and
+    // how many of them each validator validated
+    std::deque<Participation> window_;
+    hash_map<NodeID, std::uint32_t> windowScores_;
+
     /**
      * UNLModify Tx candidates
      */
@@ -185,6 +216,21 @@ private:
         hash_set<NodeID> const& unl,
         RCLValidations& validations);
 
+    /**
+     * Fill the score table from the observed window, if the window holds
+     * exactly the ledgers the table must cover.
+     *
+     * @param seq the LedgerIndex of the ledger being built
+     * @param ancestors the hashes of the ledgers before the parent ledger
+     * @param scoreTable the table with an entry for every trusted validator
+     * @return true if the table was filled
+     */
+    bool
+    scoreFromWindow(
+        LedgerIndex seq,
+        std::vector<uint256> const& ancestors,
+        hash_map<NodeID, std::uint32_t>& scoreTable);
+
     /**
      * Process the score table and find all disabling and re-enabling
      * candidates.
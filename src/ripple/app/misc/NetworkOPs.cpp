@@ -63,6 +63,7 @@
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/STParsedJSON.h>
 #include <ripple/protocol/jss.h>
+#include <ripple/protocol/serialize.h>
 #include <ripple/resource/Fees.h>
 #include <ripple/resource/ResourceManager.h>
 #include <ripple/rpc/BookChanges.h>
@@ -73,6 +74,7 @@
 #include <boost/asio/steady_timer.hpp>
 
 #include <algorithm>
+#include <condition_variable>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -426,6 +428,10 @@ public:
     Json::Value
     getConsensusInfo() override;
     Json::Value
+    getConsensusTimeline(std::size_t limit) override;
+    void
+    consensusQuorum(uint256 const& ledgerHash) override;
+    Json::Value
     getServerInfo(bool human, bool admin, bool counters) override;
     void
     clearLedgerFetch() override;
@@ -629,16 +635,29 @@ private:
         std::shared_ptr<ReadView const> const& ledger,
         std::optional<std::reference_wrapper<TxMeta const>> meta);
 
+    // The message for a validated transaction sent to binary subscribers
+    Json::Value
+    transBinaryJson(
+        std::shared_ptr<ReadView const> const& ledger,
+        AcceptedLedgerTx const& transaction);
+
+    // Whether any subscriber wants the JSON of validated transactions
+    bool
+    needTransactionJson();
+
+    // jvObj is null when no subscriber needs the JSON
     void
     pubValidatedTransaction(
         std::shared_ptr<ReadView const> const& ledger,
         AcceptedLedgerTx const& transaction,
+        MultiApiJson const* jvObj,
         bool last);
 
     void
     pubAccountTransaction(
         std::shared_ptr<ReadView const> const& ledger,
         AcceptedLedgerTx const& transaction,
+        MultiApiJson const& jvTx,
         bool last);
 
     void
@@ -655,6 +674,16 @@ private:
     std::string
     getHostId(bool forAdmin);
 
+    Json::Value
+    buildServerInfo(bool human, bool admin, bool counters);
+
+    // Makes the next server_info build a new snapshot
+    void
+    serverInfoChanged()
+    {
+        ++serverInfoEpoch_;
+    }
+
 private:
     using SubMapType = hash_map<std::uint64_t, InfoSub::wptr>;
     using SubInfoMapType = hash_map<AccountID, SubMapType>;
@@ -782,6 +811,25 @@ private:
 
     StateAccounting accounting_{};
 
+    // Load balancers and monitors poll server_info and /health many times
+    // a second. Their requests, which are neither admin nor ask for
+    // counters, share a snapshot instead of each taking the locks of
+    // every subsystem reported. The snapshot is rebuilt once it is older
+    // than serverInfoTTL_, or at once if the operating mode, a warning
+    // or the published ledger changes.
+    struct ServerInfoSnapshot
+    {
+        Json::Value info;
+        std::chrono::steady_clock::time_point built;
+        std::uint64_t epoch;
+    };
+
+    static constexpr std::chrono::seconds serverInfoTTL_{1};
+    std::atomic<std::uint64_t> serverInfoEpoch_{0};
+    std::mutex serverInfoMutex_;
+    // Indexed by whether the snapshot is human readable
+    std::array<std::shared_ptr<ServerInfoSnapshot const>, 2> serverInfo_;
+
 private:
     struct Stats
     {
@@ -884,12 +932,14 @@ inline void
 NetworkOPsImp::setNeedNetworkLedger()
 {
     needNetworkLedger_ = true;
+    serverInfoChanged();
 }
 
 inline void
 NetworkOPsImp::clearNeedNetworkLedger()
 {
     needNetworkLedger_ = false;
+    serverInfoChanged();
 }
 
 inline bool
@@ -1329,6 +1379,24 @@ NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
 
     batchLock.unlock();
 
+    // Check whatever signatures are still unknown across threads before
+    // the locks below are taken, so applying the batch only looks them up.
+    {
+        std::vector<std::shared_ptr<STTx const>> txs;
+        txs.reserve(transactions.size());
+        for (auto const& e : transactions)
+            txs.push_back(e.transaction->getSTransaction());
+
+        checkValidity(
+            app_.getHashRouter(),
+            txs,
+            app_.openLedger().current()->rules(),
+            app_.config(),
+            m_job_queue,
+            jtBATCH,
+            std::max(app_.config().APPLY_WORKERS, 1));
+    }
+
     {
         std::unique_lock masterLock{app_.getMasterMutex(), std::defer_lock};
         bool changed = false;
@@ -1483,6 +1551,10 @@ NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
                     tx.set_receivetimestamp(
                         app_.timeKeeper().now().time_since_epoch().count());
                     tx.set_deferred(e.result == terQUEUED);
+                    // The transaction passed its checks before it was
+                    // applied, which cluster members may take our word for
+                    if (app_.config().CLUSTER_VERIFY)
+                        tx.set_verified(true);
                     // FIXME: This should be when we received it
                     app_.overlay().relay(e.transaction->getID(), tx, *toSkip);
                     e.transaction->setBroadcast();
@@ -1605,6 +1677,7 @@ void
 NetworkOPsImp::setAmendmentBlocked()
 {
     amendmentBlocked_ = true;
+    serverInfoChanged();
     setMode(OperatingMode::CONNECTED);
 }
 
@@ -1618,12 +1691,14 @@ inline void
 NetworkOPsImp::setAmendmentWarned()
 {
     amendmentWarned_ = true;
+    serverInfoChanged();
 }
 
 inline void
 NetworkOPsImp::clearAmendmentWarned()
 {
     amendmentWarned_ = false;
+    serverInfoChanged();
 }
 
 inline bool
@@ -1636,6 +1711,7 @@ void
 NetworkOPsImp::setUNLBlocked()
 {
     unlBlocked_ = true;
+    serverInfoChanged();
     setMode(OperatingMode::CONNECTED);
 }
 
@@ -1643,6 +1719,7 @@ inline void
 NetworkOPsImp::clearUNLBlocked()
 {
     unlBlocked_ = false;
+    serverInfoChanged();
 }
 
 bool
@@ -1981,12 +2058,13 @@ NetworkOPsImp::pubManifest(Manifest const& mo)
             jvObj[jss::domain] = mo.domain;
         jvObj[jss::manifest] = strHex(mo.serialized);
 
+        MultiApiMessage const message{jvObj};
         for (auto i = mStreamMaps[sManifests].begin();
              i != mStreamMaps[sManifests].end();)
         {
             if (auto p = i->second.lock())
             {
-                p->send(jvObj, true);
+                p->send(message, true);
                 ++i;
             }
             else
@@ -2084,6 +2162,7 @@ NetworkOPsImp::pubServer()
 
         mLastFeeSummary = f;
 
+        MultiApiMessage const message{jvObj};
         for (auto i = mStreamMaps[sServer].begin();
              i != mStreamMaps[sServer].end();)
         {
@@ -2094,7 +2173,7 @@ NetworkOPsImp::pubServer()
             //             sending of JSON data.
             if (p)
             {
-                p->send(jvObj, true);
+                p->send(message, true);
                 ++i;
             }
             else
@@ -2117,11 +2196,12 @@ NetworkOPsImp::pubConsensus(ConsensusPhase phase)
         jvObj[jss::type] = "consensusPhase";
         jvObj[jss::consensus] = to_string(phase);
 
+        MultiApiMessage const message{jvObj};
         for (auto i = streamMap.begin(); i != streamMap.end();)
         {
             if (auto p = i->second.lock())
             {
-                p->send(jvObj, true);
+                p->send(message, true);
                 ++i;
             }
             else
@@ -2224,14 +2304,13 @@ NetworkOPsImp::pubValidation(std::shared_ptr<STValidation> const& val)
                 }
             });
 
+        MultiApiMessage const message{multiObj};
         for (auto i = mStreamMaps[sValidations].begin();
              i != mStreamMaps[sValidations].end();)
         {
             if (auto p = i->second.lock())
             {
-                p->send(
-                    multiObj.select(apiVersionSelector(p->getApiVersion())),
-                    true);
+                p->send(message, true);
                 ++i;
             }
             else
@@ -2253,6 +2332,7 @@ NetworkOPsImp::pubPeerStatus(std::function<Json::Value(void)> const& func)
 
         jvObj[jss::type] = "peerStatusChange";
 
+        MultiApiMessage const message{jvObj};
         for (auto i = mStreamMaps[sPeerStatus].begin();
              i != mStreamMaps[sPeerStatus].end();)
         {
@@ -2260,7 +2340,7 @@ NetworkOPsImp::pubPeerStatus(std::function<Json::Value(void)> const& func)
 
             if (p)
             {
-                p->send(jvObj, true);
+                p->send(message, true);
                 ++i;
             }
             else
@@ -2293,6 +2373,7 @@ NetworkOPsImp::setMode(OperatingMode om)
         return;
 
     mMode = om;
+    serverInfoChanged();
 
     accounting_.mode(om);
 
@@ -2323,8 +2404,51 @@ NetworkOPsImp::getConsensusInfo()
     return mConsensus.getJson(true);
 }
 
+Json::Value
+NetworkOPsImp::getConsensusTimeline(std::size_t limit)
+{
+    return mConsensus.getTimelineJson(limit);
+}
+
+void
+NetworkOPsImp::consensusQuorum(uint256 const& ledgerHash)
+{
+    mConsensus.gotQuorum(ledgerHash);
+}
+
 Json::Value
 NetworkOPsImp::getServerInfo(bool human, bool admin, bool counters)
+{
+    if (admin || counters)
+        return buildServerInfo(human, admin, counters);
+
+    auto const now = std::chrono::steady_clock::now();
+    std::shared_ptr<ServerInfoSnapshot const> snapshot;
+    {
+        // Concurrent requests for a stale snapshot wait for one build
+        std::lock_guard lock(serverInfoMutex_);
+        auto const epoch = serverInfoEpoch_.load();
+        auto& cached = serverInfo_[human];
+        if (!cached || cached->epoch != epoch ||
+            now - cached->built >= serverInfoTTL_)
+        {
+            cached = std::make_shared<ServerInfoSnapshot const>(
+                ServerInfoSnapshot{
+                    buildServerInfo(human, admin, counters), now, epoch});
+        }
+        snapshot = cached;
+    }
+
+    // The clocks are cheap to read, so they are never stale
+    Json::Value info = snapshot->info;
+    info[jss::time] = to_string(std::chrono::floor<std::chrono::microseconds>(
+        std::chrono::system_clock::now()));
+    info[jss::uptime] = UptimeClock::now().time_since_epoch().count();
+    return info;
+}
+
+Json::Value
+NetworkOPsImp::buildServerInfo(bool human, bool admin, bool counters)
 {
     Json::Value info = Json::objectValue;
 
@@ -2477,6 +2601,8 @@ NetworkOPsImp::getServerInfo(bool human, bool admin, bool counters)
         else
             app_.getNodeStore().getCountsJson(nodestore);
         info[jss::counters][jss::nodestore] = nodestore;
+        info[jss::counters][jss::traffic] = app_.overlay().trafficMetrics();
+        info[jss::counters][jss::latency] = app_.getLatencyJson();
         info[jss::current_activities] = app_.getPerfLog().currentJson();
     }
 
@@ -2515,8 +2641,17 @@ NetworkOPsImp::getServerInfo(bool human, bool admin, bool counters)
     //  info[jss::consensus] = mConsensus.getJson();
 
     if (admin)
+    {
         info[jss::load] = m_job_queue.getJson();
 
+        if (auto const progress = app_.getSHAMapStore().sqlDeleteProgress())
+        {
+            Json::Value& onlineDelete = info[jss::online_delete];
+            onlineDelete[jss::table] = progress->first;
+            onlineDelete[jss::remaining] = progress->second;
+        }
+    }
+
     if (!app_.config().reporting())
     {
         if (auto const netid = app_.overlay().networkID())
@@ -2716,6 +2851,13 @@ NetworkOPsImp::getServerInfo(bool human, bool admin, bool counters)
                 jv[jss::protocol] = Json::Value{Json::arrayValue};
                 for (auto const& p : proto)
                     jv[jss::protocol].append(p);
+                if (admin)
+                {
+                    auto workers =
+                        app_.getServerHandler().getWorkersJson(port);
+                    if (!workers.isNull())
+                        jv[jss::workers] = std::move(workers);
+                }
             }
         }
 
@@ -2761,6 +2903,7 @@ NetworkOPsImp::pubProposedTransaction(
     {
         std::lock_guard sl(mSubLock);
 
+        MultiApiMessage const message{jvObj};
         auto it = mStreamMaps[sRTTransactions].begin();
         while (it != mStreamMaps[sRTTransactions].end())
         {
@@ -2768,8 +2911,7 @@ NetworkOPsImp::pubProposedTransaction(
 
             if (p)
             {
-                p->send(
-                    jvObj.select(apiVersionSelector(p->getApiVersion())), true);
+                p->send(message, true);
                 ++it;
             }
             else
@@ -2793,6 +2935,7 @@ NetworkOPsImp::forwardProposedTransaction(Json::Value const& jvObj)
     {
         std::lock_guard sl(mSubLock);
 
+        MultiApiMessage const message{jvObj};
         auto it = mStreamMaps[sRTTransactions].begin();
         while (it != mStreamMaps[sRTTransactions].end())
         {
@@ -2800,7 +2943,7 @@ NetworkOPsImp::forwardProposedTransaction(Json::Value const& jvObj)
 
             if (p)
             {
-                p->send(jvObj, true);
+                p->send(message, true);
                 ++it;
             }
             else
@@ -2818,12 +2961,13 @@ NetworkOPsImp::forwardValidation(Json::Value const& jvObj)
 {
     std::lock_guard sl(mSubLock);
 
+    MultiApiMessage const message{jvObj};
     for (auto i = mStreamMaps[sValidations].begin();
          i != mStreamMaps[sValidations].end();)
     {
         if (auto p = i->second.lock())
         {
-            p->send(jvObj, true);
+            p->send(message, true);
             ++i;
         }
         else
@@ -2838,12 +2982,13 @@ NetworkOPsImp::forwardManifest(Json::Value const& jvObj)
 {
     std::lock_guard sl(mSubLock);
 
+    MultiApiMessage const message{jvObj};
     for (auto i = mStreamMaps[sManifests].begin();
          i != mStreamMaps[sManifests].end();)
     {
         if (auto p = i->second.lock())
         {
-            p->send(jvObj, true);
+            p->send(message, true);
             ++i;
         }
         else
@@ -2934,8 +3079,9 @@ NetworkOPsImp::forwardProposedAccountTransaction(Json::Value const& jvObj)
 
     if (!notify.empty())
     {
+        MultiApiMessage const message{jvObj};
         for (InfoSub::ref isrListener : notify)
-            isrListener->send(jvObj, true);
+            isrListener->send(message, true);
     }
 }
 
@@ -2945,6 +3091,8 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
     // Ledgers are published only when they acquire sufficient validations
     // Holes are filled across connection loss or other catastrophe
 
+    serverInfoChanged();
+
     std::shared_ptr<AcceptedLedger> alpAccepted =
         app_.getAcceptedLedgerCache().fetch(lpAccepted->info().hash);
     if (!alpAccepted)
@@ -2956,6 +3104,8 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
 
     assert(alpAccepted->getLedger().get() == lpAccepted.get());
 
+    app_.getOrderBookDB().processLedger(*alpAccepted);
+
     {
         JLOG(m_journal.debug())
             << "Publishing ledger " << lpAccepted->info().seq << " "
@@ -2989,13 +3139,35 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
                     app_.getLedgerMaster().getCompleteLedgers();
             }
 
+            MultiApiMessage const message{jvObj};
+
+            // Binary subscribers are sent the serialized header as well
+            Json::Value jvBinary;
+            std::optional<MultiApiMessage> binary;
+
             auto it = mStreamMaps[sLedger].begin();
             while (it != mStreamMaps[sLedger].end())
             {
                 InfoSub::pointer p = it->second.lock();
                 if (p)
                 {
-                    p->send(jvObj, true);
+                    if (!p->isBinary())
+                    {
+                        p->send(message, true);
+                    }
+                    else
+                    {
+                        if (!binary)
+                        {
+                            Serializer header;
+                            addRaw(lpAccepted->info(), header);
+                            jvBinary = jvObj;
+                            jvBinary[jss::ledger_data] =
+                                strHex(header.peekData());
+                            binary.emplace(jvBinary);
+                        }
+                        p->send(*binary, true);
+                    }
                     ++it;
                 }
                 else
@@ -3005,15 +3177,17 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
 
         if (!mStreamMaps[sBookChanges].empty())
         {
-            Json::Value jvObj = ripple::RPC::computeBookChanges(lpAccepted);
+            auto const changes = ripple::RPC::getBookChanges(
+                app_.getBookChangesCache(), lpAccepted);
 
+            MultiApiMessage const message{changes->json};
             auto it = mStreamMaps[sBookChanges].begin();
             while (it != mStreamMaps[sBookChanges].end())
             {
                 InfoSub::pointer p = it->second.lock();
                 if (p)
                 {
-                    p->send(jvObj, true);
+                    p->send(message, true);
                     ++it;
                 }
                 else
@@ -3043,12 +3217,64 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
         }
     }
 
+    auto const buildJson = [&](AcceptedLedgerTx const& accTx) {
+        // Create two different Json objects, for different API versions
+        return transJson(
+            accTx.getTxn(),
+            accTx.getResult(),
+            true,
+            lpAccepted,
+            std::ref(accTx.getMeta()));
+    };
+
+    // Binary subscribers are sent the serialized transactions, so the
+    // Json is only built if some other subscriber needs it
+    bool const needJson = needTransactionJson();
+
+    // Build the Json of all the transactions at once, across jobs, so that
+    // sending them is all that is left to do in order
+    auto const count = alpAccepted->size();
+    std::vector<std::optional<MultiApiJson>> built(count);
+    if (needJson && count > 1)
+    {
+        std::vector<AcceptedLedgerTx const*> txs;
+        txs.reserve(count);
+        for (auto const& accTx : *alpAccepted)
+            txs.push_back(accTx.get());
+
+        m_job_queue.parallelFor(
+            jtPUBLEDGER,
+            "pubLedger->buildJson",
+            count,
+            app_.config().PUBLISH_WORKERS,
+            [&](std::size_t i) {
+                try
+                {
+                    built[i] = buildJson(*txs[i]);
+                }
+                catch (std::exception const& e)
+                {
+                    // Left for the publisher to build, and throw, itself
+                    JLOG(m_journal.debug())
+                        << "pubLedger: building transaction: " << e.what();
+                }
+            });
+    }
+
     // Don't lock since pubAcceptedTransaction is locking.
-    for (auto const& accTx : *alpAccepted)
+    auto it = alpAccepted->begin();
+    for (std::size_t i = 0; i < count; ++i, ++it)
     {
-        JLOG(m_journal.trace()) << "pubAccepted: " << accTx->getJson();
+        auto& jvObj = built[i];
+
+        // A subscriber that wants the Json may have arrived since
+        if (!jvObj && (needJson || needTransactionJson()))
+            jvObj = buildJson(**it);
+
+        JLOG(m_journal.trace())
+            << "pubAccepted: " << (*it)->getJson(*lpAccepted);
         pubValidatedTransaction(
-            lpAccepted, *accTx, accTx == *(--alpAccepted->end()));
+            lpAccepted, **it, jvObj ? &*jvObj : nullptr, i + 1 == count);
     }
 }
 
@@ -3186,22 +3412,87 @@ NetworkOPsImp::transJson(
     return multiObj;
 }
 
+Json::Value
+NetworkOPsImp::transBinaryJson(
+    std::shared_ptr<ReadView const> const& ledger,
+    AcceptedLedgerTx const& transaction)
+{
+    std::string sToken;
+    std::string sHuman;
+    transResultInfo(transaction.getResult(), sToken, sHuman);
+
+    Json::Value jvObj(Json::objectValue);
+    jvObj[jss::type] = "transaction";
+    jvObj[jss::tx_blob] = serializeHex(*transaction.getTxn());
+    jvObj[jss::meta] = strHex(transaction.getRawMeta());
+    jvObj[jss::hash] = to_string(transaction.getTransactionID());
+    jvObj[jss::ledger_hash] = to_string(ledger->info().hash);
+    jvObj[jss::ledger_index] = ledger->info().seq;
+    jvObj[jss::validated] = true;
+    jvObj[jss::status] = "closed";
+    jvObj[jss::engine_result] = sToken;
+    jvObj[jss::engine_result_code] = transaction.getResult();
+    return jvObj;
+}
+
+bool
+NetworkOPsImp::needTransactionJson()
+{
+    if (app_.getOrderBookDB().haveBookListeners())
+        return true;
+
+    std::lock_guard sl(mSubLock);
+
+    if (!mSubAccount.empty() || !mSubRTAccount.empty() ||
+        !mSubAccountHistory.empty())
+        return true;
+
+    for (auto const stream : {sTransactions, sRTTransactions})
+    {
+        for (auto const& [id, weak] : mStreamMaps[stream])
+        {
+            if (auto const p = weak.lock(); p && !p->isBinary())
+                return true;
+        }
+    }
+
+    return false;
+}
+
 void
 NetworkOPsImp::pubValidatedTransaction(
     std::shared_ptr<ReadView const> const& ledger,
     const AcceptedLedgerTx& transaction,
+    MultiApiJson const* jvObj,
     bool last)
 {
-    auto const& stTxn = transaction.getTxn();
-
-    // Create two different Json objects, for different API versions
-    auto const metaRef = std::ref(transaction.getMeta());
-    auto const trResult = transaction.getResult();
-    MultiApiJson jvObj = transJson(stTxn, trResult, true, ledger, metaRef);
-
     {
         std::lock_guard sl(mSubLock);
 
+        std::optional<MultiApiMessage> message;
+        if (jvObj)
+            message.emplace(*jvObj);
+
+        Json::Value jvBinary;
+        std::optional<MultiApiMessage> binary;
+
+        auto const send = [&](InfoSub::pointer const& p) {
+            if (!p->isBinary())
+            {
+                // Not built if the subscriber arrived during publishing
+                if (message)
+                    p->send(*message, true);
+                return;
+            }
+
+            if (!binary)
+            {
+                jvBinary = transBinaryJson(ledger, transaction);
+                binary.emplace(jvBinary);
+            }
+            p->send(*binary, true);
+        };
+
         auto it = mStreamMaps[sTransactions].begin();
         while (it != mStreamMaps[sTransactions].end())
         {
@@ -3209,8 +3500,7 @@ NetworkOPsImp::pubValidatedTransaction(
 
             if (p)
             {
-                p->send(
-                    jvObj.select(apiVersionSelector(p->getApiVersion())), true);
+                send(p);
                 ++it;
             }
             else
@@ -3225,8 +3515,7 @@ NetworkOPsImp::pubValidatedTransaction(
 
             if (p)
             {
-                p->send(
-                    jvObj.select(apiVersionSelector(p->getApiVersion())), true);
+                send(p);
                 ++it;
             }
             else
@@ -3234,16 +3523,20 @@ NetworkOPsImp::pubValidatedTransaction(
         }
     }
 
+    if (!jvObj)
+        return;
+
     if (transaction.getResult() == tesSUCCESS)
-        app_.getOrderBookDB().processTxn(ledger, transaction, jvObj);
+        app_.getOrderBookDB().processTxn(ledger, transaction, *jvObj);
 
-    pubAccountTransaction(ledger, transaction, last);
+    pubAccountTransaction(ledger, transaction, *jvObj, last);
 }
 
 void
 NetworkOPsImp::pubAccountTransaction(
     std::shared_ptr<ReadView const> const& ledger,
     AcceptedLedgerTx const& transaction,
+    MultiApiJson const& jvTx,
     bool last)
 {
     hash_set<InfoSub::pointer> notify;
@@ -3337,18 +3630,13 @@ NetworkOPsImp::pubAccountTransaction(
 
     if (!notify.empty() || !accountHistoryNotify.empty())
     {
-        auto const& stTxn = transaction.getTxn();
-
-        // Create two different Json objects, for different API versions
-        auto const metaRef = std::ref(transaction.getMeta());
-        auto const trResult = transaction.getResult();
-        MultiApiJson jvObj = transJson(stTxn, trResult, true, ledger, metaRef);
+        // The account history fields are added to a copy
+        MultiApiJson jvObj = jvTx;
 
-        for (InfoSub::ref isrListener : notify)
         {
-            isrListener->send(
-                jvObj.select(apiVersionSelector(isrListener->getApiVersion())),
-                true);
+            MultiApiMessage const message{jvObj};
+            for (InfoSub::ref isrListener : notify)
+                isrListener->send(message, true);
         }
 
         if (last)
@@ -3424,10 +3712,11 @@ NetworkOPsImp::pubProposedAccountTransaction(
         // Create two different Json objects, for different API versions
         MultiApiJson jvObj = transJson(tx, result, false, ledger, std::nullopt);
 
-        for (InfoSub::ref isrListener : notify)
-            isrListener->send(
-                jvObj.select(apiVersionSelector(isrListener->getApiVersion())),
-                true);
+        {
+            MultiApiMessage const message{jvObj};
+            for (InfoSub::ref isrListener : notify)
+                isrListener->send(message, true);
+        }
 
         assert(
             jvObj.isMember(jss::account_history_tx_stream) ==
@@ -4311,6 +4600,20 @@ NetworkOPsImp::getBookPage(
     Json::Value const& jvMarker,
     Json::Value& jvResult)
 {  // CAUTION: This is the old get book page logic
+    // The page of a closed ledger is the same for every taker, except the
+    // issuer of what the book pays out, so it is built once per ledger
+    bool const takerIsIssuer = uTakerID == book.out.account;
+    bool const cacheable = !lpLedger->open();
+    if (cacheable)
+    {
+        if (auto offers = app_.getOrderBookDB().getBookSnapshot(
+                *lpLedger, book, takerIsIssuer, iLimit))
+        {
+            jvResult[jss::offers] = std::move(*offers);
+            return;
+        }
+    }
+
     Json::Value& jvOffers =
         (jvResult[jss::offers] = Json::Value(Json::arrayValue));
 
@@ -4499,6 +4802,10 @@ NetworkOPsImp::getBookPage(
         }
     }
 
+    if (cacheable)
+        app_.getOrderBookDB().setBookSnapshot(
+            *lpLedger, book, takerIsIssuer, bDone, jvOffers);
+
     //  jvResult[jss::marker]  = Json::Value(Json::arrayValue);
     //  jvResult[jss::nodes]   = Json::Value(Json::arrayValue);
 }
@@ -222,6 +222,10 @@ public:
     virtual Json::Value
     getConsensusInfo() = 0;
     virtual Json::Value
+    getConsensusTimeline(std::size_t limit) = 0;
+    virtual void
+    consensusQuorum(uint256 const& ledgerHash) = 0;
+    virtual Json::Value
     getServerInfo(bool human, bool admin, bool counters) = 0;
     virtual void
     clearLedgerFetch() = 0;
@@ -24,6 +24,8 @@
 #include <ripple/nodestore/Manager.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <optional>
+#include <string>
+#include <utility>
 
 namespace ripple {
 
@@ -97,6 +99,15 @@ public:
     */
     virtual std::optional<LedgerIndex>
     minimumOnline() const = 0;
+
+    /** Progress of online deletion through the SQL databases.
+
+        @return While a table is being pruned, its name and the number of
+            ledgers still to be deleted from it. Otherwise an unseated
+            optional.
+    */
+    virtual std::optional<std::pair<std::string, LedgerIndex>>
+    sqlDeleteProgress() const = 0;
 };
 
 //------------------------------------------------------------------------------
@@ -20,6 +20,7 @@
 #include <ripple/app/misc/SHAMapStoreImp.h>
 
 #include <ripple/app/ledger/TransactionMaster.h>
+#include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/rdb/State.h>
 #include <ripple/app/rdb/backend/SQLiteDatabase.h>
@@ -142,6 +143,9 @@ SHAMapStoreImp::SHAMapStoreImp(
             recoveryWaitTime_ = std::chrono::seconds{temp};
 
         get_if_exists(section, "advisory_delete", advisoryDelete_);
+        get_if_exists(
+            section, "incremental_rotation", incrementalRotation_);
+        get_if_exists(section, "adaptive_delete", adaptiveDelete_);
 
         auto const minInterval = config.standalone()
             ? minimumDeletionIntervalSA_
@@ -184,6 +188,13 @@ SHAMapStoreImp::makeNodeStore(int readThreads)
             std::to_string(app_.config().getValueFor(
                 SizedItem::treeCacheAge, std::nullopt)));
 
+    if (!nscfg.exists("read_cpus"))
+    {
+        if (auto const cpus =
+                app_.config().section(SECTION_THREADS).get("nodestore_read"))
+            nscfg.set("read_cpus", *cpus);
+    }
+
     std::unique_ptr<NodeStore::Database> db;
 
     if (deleteInterval_)
@@ -276,6 +287,62 @@ SHAMapStoreImp::copyNode(std::uint64_t& nodeCount, SHAMapTreeNode const& node)
     return true;
 }
 
+std::shared_ptr<SHAMap>
+SHAMapStoreImp::loadStateMap(uint256 const& hash) const
+{
+    auto map = std::make_shared<SHAMap>(
+        SHAMapType::STATE, hash, app_.getNodeFamily());
+    if (!map->fetchRoot(SHAMapHash{hash}, nullptr))
+        return {};
+    map->setImmutable();
+    return map;
+}
+
+void
+SHAMapStoreImp::copyForward(uint256 const& stateHash)
+{
+    auto const map = loadStateMap(stateHash);
+    if (!map)
+    {
+        JLOG(journal_.warn()) << "copy forward: missing state map root "
+                              << stateHash;
+        return;
+    }
+
+    JLOG(journal_.debug()) << "copying forward state " << stateHash;
+    std::uint64_t nodeCount = 0;
+    bool stopped = false;
+
+    try
+    {
+        map->visitNodes([&](SHAMapTreeNode& node) {
+            if (!copyNode(nodeCount, node))
+            {
+                stopped = true;
+                return false;
+            }
+
+            // Leave the backend to live traffic between chunks
+            if (!(nodeCount % checkHealthInterval_))
+                std::this_thread::sleep_for(backOff_);
+            return true;
+        });
+    }
+    catch (SHAMapMissingNode const& e)
+    {
+        JLOG(journal_.error())
+            << "Missing node while copying forward: " << e.what();
+        return;
+    }
+
+    if (stopped)
+        return;
+
+    copiedState_ = stateHash;
+    JLOG(journal_.debug()) << "copied forward state " << stateHash
+                           << " nodecount " << nodeCount;
+}
+
 void
 SHAMapStoreImp::run()
 {
@@ -367,12 +434,25 @@ SHAMapStoreImp::run()
 
             try
             {
-                validatedLedger->stateMap().snapShot(false)->visitNodes(
-                    std::bind(
-                        &SHAMapStoreImp::copyNode,
-                        this,
-                        std::ref(nodeCount),
-                        std::placeholders::_1));
+                auto const snapshot =
+                    validatedLedger->stateMap().snapShot(false);
+                auto const copy = [&](SHAMapTreeNode const& node) {
+                    return copyNode(nodeCount, node);
+                };
+
+                // If an earlier state is already in the writable backend,
+                // only the nodes that differ from it need to be copied.
+                if (auto const have =
+                        copiedState_ ? loadStateMap(*copiedState_) : nullptr)
+                {
+                    JLOG(journal_.debug())
+                        << "copying differences from " << *copiedState_;
+                    snapshot->visitDifferences(have.get(), copy);
+                }
+                else
+                {
+                    snapshot->visitNodes(copy);
+                }
             }
             catch (SHAMapMissingNode const& e)
             {
@@ -414,12 +494,25 @@ SHAMapStoreImp::run()
                     savedState.lastRotated = lastRotated;
                     state_db_.setState(savedState);
 
+                    // Clear the caches before the new backend is swapped in,
+                    // or a stale full below or tree node entry would let a
+                    // fetch or the copy forward skip a node that was never
+                    // written to the new writable backend.
                     clearCaches(validatedSeq);
 
                     return std::move(newBackend);
                 });
 
             JLOG(journal_.warn()) << "finished rotation " << validatedSeq;
+
+            // The new writable backend starts out empty
+            copiedState_.reset();
+            if (incrementalRotation_)
+            {
+                copyForward(validatedLedger->info().accountHash);
+                if (healthWait() == stopping)
+                    return;
+            }
         }
     }
 }
@@ -577,24 +670,62 @@ SHAMapStoreImp::clearSql(
 
     JLOG(journal_.debug()) << "start deleting in: " << TableName << " from "
                            << min << " to " << lastRotated;
+
+    auto setProgress = [this, &TableName](LedgerIndex remaining) {
+        std::lock_guard lock(sqlDeleteMutex_);
+        if (remaining)
+            sqlDeleteProgress_.emplace(TableName, remaining);
+        else
+            sqlDeleteProgress_.reset();
+    };
+    setProgress(lastRotated - min);
+
+    // With adaptive pacing, the number of ledgers deleted at a time grows
+    // while deletes finish well within the back off, and shrinks when
+    // they take longer. The pause after each delete is at least as long
+    // as the delete took, so deletion never holds the database more than
+    // half of the time, and doubles while the server is loaded.
+    std::uint32_t step = deleteBatch_;
+    std::uint32_t const maxStep = deleteBatch_ * 16;
     while (min < lastRotated)
     {
-        min = std::min(lastRotated, min + deleteBatch_);
+        min = std::min(lastRotated, min + step);
         JLOG(journal_.trace())
-            << "Begin: Delete up to " << deleteBatch_
-            << " rows with LedgerSeq < " << min << " from: " << TableName;
+            << "Begin: Delete up to " << step << " rows with LedgerSeq < "
+            << min << " from: " << TableName;
+        auto const start = std::chrono::steady_clock::now();
         deleteBeforeSeq(min);
+        auto const elapsed =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
         JLOG(journal_.trace())
-            << "End: Delete up to " << deleteBatch_ << " rows with LedgerSeq < "
-            << min << " from: " << TableName;
+            << "End: Delete up to " << step << " rows with LedgerSeq < " << min
+            << " from: " << TableName << " in " << elapsed.count() << "ms";
+        setProgress(lastRotated - min);
+
+        auto pause = backOff_;
+        if (adaptiveDelete_)
+        {
+            if (elapsed > backOff_)
+                step = std::max<std::uint32_t>(1, step / 2);
+            else if (elapsed < backOff_ / 4)
+                step = std::min(maxStep, step + std::max(1u, step / 4));
+
+            pause = std::max(pause, elapsed);
+            if (app_.getFeeTrack().isLoadedLocal())
+                pause *= 2;
+        }
+
         if (healthWait() == stopping)
-            return;
+            break;
         if (min < lastRotated)
-            std::this_thread::sleep_for(backOff_);
+            std::this_thread::sleep_for(pause);
         if (healthWait() == stopping)
-            return;
+            break;
     }
-    JLOG(journal_.debug()) << "finished deleting from: " << TableName;
+    setProgress(0);
+    if (min == lastRotated)
+        JLOG(journal_.debug()) << "finished deleting from: " << TableName;
 }
 
 void
@@ -722,6 +853,13 @@ SHAMapStoreImp::minimumOnline() const
     return app_.getLedgerMaster().minSqlSeq();
 }
 
+std::optional<std::pair<std::string, LedgerIndex>>
+SHAMapStoreImp::sqlDeleteProgress() const
+{
+    std::lock_guard lock(sqlDeleteMutex_);
+    return sqlDeleteProgress_;
+}
+
 //------------------------------------------------------------------------------
 
 std::unique_ptr<SHAMapStore>
@@ -109,6 +109,22 @@ private:
     /// recovery.
     /// See also: "recovery_wait_seconds" in rippled-example.cfg
     std::chrono::seconds recoveryWaitTime_{5};
+    /// Copy the validated state into each new writable backend gradually,
+    /// between rotations, so that a rotation only has to copy the nodes
+    /// that changed since the previous one.
+    /// See also: "incremental_rotation" in rippled-example.cfg
+    bool incrementalRotation_ = false;
+    /// Pace SQL deletion by how long each batch takes and by the server's
+    /// load, instead of by delete_batch and back_off_milliseconds alone.
+    /// See also: "adaptive_delete" in rippled-example.cfg
+    bool adaptiveDelete_ = false;
+    // The table clearSql is pruning, if any, and the number of ledgers
+    // left to delete from it
+    mutable std::mutex sqlDeleteMutex_;
+    std::optional<std::pair<std::string, LedgerIndex>> sqlDeleteProgress_;
+    // Root hash of a state map whose nodes are all known to be in the
+    // current writable backend. Only accessed by the rotation thread.
+    std::optional<uint256> copiedState_;
 
     // these do not exist upon SHAMapStore creation, but do exist
     // as of run() or before
@@ -176,10 +192,20 @@ public:
     std::optional<LedgerIndex>
     minimumOnline() const override;
 
+    std::optional<std::pair<std::string, LedgerIndex>>
+    sqlDeleteProgress() const override;
+
 private:
     // callback for visitNodes
     bool
     copyNode(std::uint64_t& nodeCount, SHAMapTreeNode const& node);
+    // Load an unshared, immutable copy of a state map from the node store
+    std::shared_ptr<SHAMap>
+    loadStateMap(uint256 const& hash) const;
+    // Copy a state map into the writable backend, pausing between chunks
+    // of nodes. Sets copiedState_ if the copy completes.
+    void
+    copyForward(uint256 const& stateHash);
     void
     run();
     void
@@ -29,6 +29,7 @@
 #include <ripple/protocol/TER.h>
 #include <boost/circular_buffer.hpp>
 #include <boost/intrusive/set.hpp>
+#include <chrono>
 #include <optional>
 
 namespace ripple {
@@ -150,6 +151,13 @@ public:
             processed.
         */
         std::uint32_t minimumLastLedgerBuffer = 2;
+        /** Maximum number of queued transactions @ref TxQ::accept tries
+            to apply while the new open ledger is being built. Any which
+            could still go in are applied afterward by jobs which each
+            take the open ledger for at most this many. Zero means no
+            limit, so the whole queue is processed at once.
+        */
+        std::uint32_t acceptBatchSize = 0;
         /// Use standalone mode behavior.
         bool standAlone = false;
     };
@@ -181,6 +189,8 @@ public:
         /// Minimum fee level to get into the current open ledger,
         /// bypassing the queue
         FeeLevel64 openLedgerFeeLevel;
+        /// How long the last batch of @ref TxQ::accept held the queue
+        std::chrono::microseconds acceptDuration;
     };
 
     /**
@@ -738,6 +748,48 @@ private:
         ApplyFlags flags,
         beast::Journal j);
 
+    /** The parts of @ref Metrics which don't depend on the open view,
+        as of the last change to the queue or the fee metrics.
+    */
+    struct PublishedMetrics
+    {
+        std::size_t txCount = 0;
+        std::optional<std::size_t> txQMaxSize;
+        FeeLevel64 minProcessingFeeLevel{baseLevel};
+        std::size_t txnsExpected = 0;
+        FeeLevel64 escalationMultiplier{0};
+        std::chrono::microseconds acceptDuration{0};
+    };
+
+    /** Apply queued transactions to the view in fee order, trying
+        at most `setup_.acceptBatchSize` of them.
+
+        Sets acceptPending_ if it stopped early because of the limit.
+
+        @return Whether any transactions were added to the `view`.
+    */
+    bool
+    acceptBatch(
+        Application& app,
+        OpenView& view,
+        std::lock_guard<std::mutex> const& lock);
+
+    /// Queue a job to continue an accept which hit its batch limit
+    void
+    scheduleAccept(Application& app, std::lock_guard<std::mutex> const&);
+
+    /// Apply the next batch of an accept to the open ledger
+    bool
+    acceptMore(Application& app, OpenView& view);
+
+    /// Refresh published_ from the state guarded by mutex_
+    void
+    publishMetrics(std::lock_guard<std::mutex> const&);
+
+    /// Return a copy of published_
+    PublishedMetrics
+    getPublishedMetrics() const;
+
     // Helper function that removes a replaced entry in _byFee.
     std::optional<TxQAccount::TxMap::iterator>
     removeFromByFee(
@@ -784,6 +836,20 @@ private:
         locked mutex_
     */
     std::optional<size_t> maxSize_;
+    /** Sequence of the open ledger last filled by accept, whether
+        transactions which could go in it remain in the queue, and
+        whether a job to apply them is queued.
+        @note These members must always and only be accessed under
+        locked mutex_
+    */
+    LedgerIndex acceptSeq_ = 0;
+    bool acceptPending_ = false;
+    bool acceptJobQueued_ = false;
+    /** How long the last batch of accept held mutex_.
+        @note This member must always and only be accessed under
+        locked mutex_
+    */
+    std::chrono::microseconds acceptDuration_{0};
 
 #if !NDEBUG
     /**
@@ -798,6 +864,14 @@ private:
     */
     std::mutex mutable mutex_;
 
+    /** Copied out by fee queries so they need not wait on mutex_,
+        which is held for the length of every queue operation.
+        @note This member must always and only be accessed under
+        locked publishedMutex_
+    */
+    PublishedMetrics published_;
+    std::mutex mutable publishedMutex_;
+
 private:
     /// Is the queue at least `fillPercentage` full?
     template <size_t fillPercentage = 100>
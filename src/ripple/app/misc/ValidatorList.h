@@ -31,6 +31,8 @@
 #include <boost/iterator/counting_iterator.hpp>
 #include <boost/range/adaptors.hpp>
 #include <boost/thread/shared_mutex.hpp>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <numeric>
 #include <shared_mutex>
@@ -252,6 +254,21 @@ class ValidatorList
     // The master public keys of the current negative UNL
     hash_set<PublicKey> negativeUNL_;
 
+    // A blob whose signature was checked and whose JSON was parsed. The
+    // same blob reaches us from every peer that relays it, so the outcome
+    // is kept rather than checking it again.
+    struct VerifiedBlob
+    {
+        std::string blob;
+        // Null if the signature or the JSON was invalid
+        std::shared_ptr<Json::Value const> list;
+    };
+
+    // Keyed by the signing key and signature; oldest first in the order
+    hash_map<uint256, VerifiedBlob> verifiedBlobs_;
+    std::deque<uint256> verifiedBlobOrder_;
+    static constexpr std::size_t maxVerifiedBlobs = 32;
+
     // Currently supported versions of publisher list format
     static constexpr std::uint32_t supportedListVersions[]{1, 2};
     // In the initial release, to prevent potential abuse and attacks, any VL
@@ -852,12 +869,30 @@ private:
     ListDisposition
     verify(
         lock_guard const&,
-        Json::Value& list,
+        std::shared_ptr<Json::Value const>& list,
         PublicKey& pubKey,
         std::string const& manifest,
         std::string const& blob,
         std::string const& signature);
 
+    /** Check the signature of a blob and parse it
+
+        The outcome is remembered, so a blob seen again is neither checked
+        nor parsed again.
+
+        @return The parsed list, or null if the blob is invalid
+
+        @par Thread Safety
+
+        Calling public member function is expected to lock mutex
+    */
+    std::shared_ptr<Json::Value const>
+    verifyBlob(
+        lock_guard const&,
+        PublicKey const& signingKey,
+        std::string const& blob,
+        std::string const& signature);
+
     /** Stop trusting publisher's list of keys.
 
         @param publisherKey Publisher public key
@@ -0,0 +1,325 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/misc/GatewayBalancesIndex.h>
+#include <ripple/app/paths/TrustLine.h>
+#include <ripple/basics/Log.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/ledger/View.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/STArray.h>
+#include <ripple/shamap/SHAMapMissingNode.h>
+#include <chrono>
+
+namespace ripple {
+
+GatewayBalancesIndex::GatewayBalancesIndex(
+    std::set<AccountID> issuers,
+    JobQueue& jobQueue,
+    beast::Journal journal)
+    : issuers_(std::move(issuers)), jobQueue_(jobQueue), j_(journal)
+{
+}
+
+bool
+GatewayBalancesIndex::tracks(AccountID const& issuer) const
+{
+    return issuers_.count(issuer) != 0;
+}
+
+void
+GatewayBalancesIndex::onValidatedLedger(
+    std::shared_ptr<ReadView const> const& ledger)
+{
+    std::lock_guard lock(mutex_);
+    if (pending_.size() == maxPending)
+        pending_.clear();
+    pending_.push_back(ledger);
+
+    if (running_)
+        return;
+
+    running_ = jobQueue_.addJob(
+        jtGATEWAY_INDEX, "GatewayBalancesIndex::update", [this]() {
+            update();
+        });
+}
+
+std::shared_ptr<GatewayBalancesIndex::Balances const>
+GatewayBalancesIndex::balances(AccountID const& issuer, ReadView const& ledger)
+    const
+{
+    std::shared_ptr<Snapshot const> snapshot;
+    {
+        std::lock_guard lock(mutex_);
+        snapshot = snapshot_;
+    }
+
+    if (!snapshot || snapshot->ledger->info().hash != ledger.info().hash)
+        return nullptr;
+
+    auto const iter = snapshot->issuers.find(issuer);
+    if (iter == snapshot->issuers.end())
+        return nullptr;
+    return iter->second;
+}
+
+std::optional<Currency>
+GatewayBalancesIndex::apply(
+    Balances& balances,
+    AccountID const& issuer,
+    std::shared_ptr<SLE const> const& line,
+    bool add)
+{
+    auto const item = PathFindTrustLine::makeItem(issuer, line);
+    if (!item)
+        return std::nullopt;
+
+    // From the issuer's side: negative when the issuer owes the peer
+    auto const& balance = item->getBalance();
+    if (balance.signum() == 0)
+        return std::nullopt;
+
+    auto const& peer = item->getAccountIDPeer();
+    auto const& currency = balance.getCurrency();
+
+    auto set = [&](auto& byPeer, STAmount const& amount) {
+        if (add)
+        {
+            byPeer[peer][currency] = amount;
+            return;
+        }
+        if (auto iter = byPeer.find(peer); iter != byPeer.end())
+        {
+            iter->second.erase(currency);
+            if (iter->second.empty())
+                byPeer.erase(iter);
+        }
+    };
+
+    if (balance.signum() > 0)
+    {
+        set(balances.assets, balance);
+        return std::nullopt;
+    }
+
+    if (item->getFreeze())
+    {
+        set(balances.frozen, -balance);
+        return std::nullopt;
+    }
+
+    if (add)
+    {
+        balances.obligations[currency].lines[peer] = -balance;
+        return currency;
+    }
+
+    auto iter = balances.obligations.find(currency);
+    if (iter == balances.obligations.end())
+        return std::nullopt;
+
+    iter->second.lines.erase(peer);
+    if (iter->second.lines.empty())
+        balances.obligations.erase(iter);
+    return currency;
+}
+
+void
+GatewayBalancesIndex::total(Balances& balances, Currency const& currency)
+{
+    auto iter = balances.obligations.find(currency);
+    if (iter == balances.obligations.end())
+        return;
+
+    auto& [amount, lines] = iter->second;
+    amount.clear();
+    for (auto const& [_, owed] : lines)
+    {
+        if (amount == beast::zero)
+        {
+            // The first line sets the currency of the sum
+            amount = owed;
+            continue;
+        }
+
+        try
+        {
+            amount += owed;
+        }
+        catch (std::runtime_error const&)
+        {
+            // On overflow keep the largest valid STAmount, as
+            // gateway_balances does. Very large sums are approximations
+            // anyway.
+            amount = STAmount(
+                amount.issue(), STAmount::cMaxValue, STAmount::cMaxOffset);
+            break;
+        }
+    }
+}
+
+std::shared_ptr<GatewayBalancesIndex::Balances const>
+GatewayBalancesIndex::build(AccountID const& issuer, ReadView const& ledger)
+    const
+{
+    auto balances = std::make_shared<Balances>();
+    forEachItem(ledger, issuer, [&](std::shared_ptr<SLE const> const& sle) {
+        apply(*balances, issuer, sle, true);
+    });
+    for (auto const& [currency, _] : balances->obligations)
+        total(*balances, currency);
+    return balances;
+}
+
+std::shared_ptr<GatewayBalancesIndex::Snapshot const>
+GatewayBalancesIndex::advance(
+    std::shared_ptr<Snapshot const> const& prior,
+    std::shared_ptr<ReadView const> const& ledger) const
+{
+    auto next = std::make_shared<Snapshot>();
+    next->ledger = ledger;
+
+    if (!prior || prior->ledger->info().hash != ledger->info().parentHash)
+    {
+        using namespace std::chrono;
+        auto const start = steady_clock::now();
+        for (auto const& issuer : issuers_)
+            next->issuers[issuer] = build(issuer, *ledger);
+        JLOG(j_.info()) << "Built gateway balances index at ledger "
+                        << ledger->info().seq << " in "
+                        << duration_cast<milliseconds>(
+                               steady_clock::now() - start)
+                               .count()
+                        << "ms";
+        return next;
+    }
+
+    // Compare the trust lines the ledger touched with their state in the
+    // parent, so lines changed by several transactions are counted once
+    std::set<uint256> lines;
+    for (auto const& [tx, meta] : ledger->txs)
+    {
+        (void)tx;
+        if (!meta)
+            continue;
+        for (auto const& node : meta->getFieldArray(sfAffectedNodes))
+        {
+            if (node.getFieldU16(sfLedgerEntryType) == ltRIPPLE_STATE)
+                lines.insert(node.getFieldH256(sfLedgerIndex));
+        }
+    }
+
+    next->issuers = prior->issuers;
+
+    // The balances copied for each changed issuer, and the currencies whose
+    // obligations must be totalled again
+    struct Changed
+    {
+        std::shared_ptr<Balances> balances;
+        std::set<Currency> currencies;
+    };
+    std::map<AccountID, Changed> changed;
+    auto changedOf = [&](AccountID const& issuer) -> Changed* {
+        if (!tracks(issuer))
+            return nullptr;
+        auto& entry = changed[issuer];
+        if (!entry.balances)
+        {
+            entry.balances =
+                std::make_shared<Balances>(*next->issuers[issuer]);
+            next->issuers[issuer] = entry.balances;
+        }
+        return &entry;
+    };
+
+    for (auto const& key : lines)
+    {
+        Keylet const keylet(ltRIPPLE_STATE, key);
+        auto const before = prior->ledger->read(keylet);
+        auto const after = ledger->read(keylet);
+        auto const& line = after ? after : before;
+        if (!line)
+            continue;
+
+        for (auto const& field : {&sfLowLimit, &sfHighLimit})
+        {
+            auto const issuer = line->getFieldAmount(*field).getIssuer();
+            if (auto const entry = changedOf(issuer))
+            {
+                for (auto const& [sle, add] :
+                     {std::pair{before, false}, std::pair{after, true}})
+                {
+                    if (!sle)
+                        continue;
+                    if (auto const currency =
+                            apply(*entry->balances, issuer, sle, add))
+                        entry->currencies.insert(*currency);
+                }
+            }
+        }
+    }
+
+    for (auto& [_, entry] : changed)
+    {
+        for (auto const& currency : entry.currencies)
+            total(*entry.balances, currency);
+    }
+
+    return next;
+}
+
+void
+GatewayBalancesIndex::update()
+{
+    for (;;)
+    {
+        std::shared_ptr<Snapshot const> prior;
+        std::shared_ptr<ReadView const> ledger;
+        {
+            std::lock_guard lock(mutex_);
+            if (pending_.empty())
+            {
+                running_ = false;
+                return;
+            }
+            ledger = std::move(pending_.front());
+            pending_.pop_front();
+            prior = snapshot_;
+        }
+
+        if (prior && prior->ledger->info().seq >= ledger->info().seq)
+            continue;
+
+        try
+        {
+            auto next = advance(prior, ledger);
+            std::lock_guard lock(mutex_);
+            snapshot_ = std::move(next);
+        }
+        catch (SHAMapMissingNode const& e)
+        {
+            JLOG(j_.warn())
+                << "Unable to index gateway balances at ledger "
+                << ledger->info().seq << ": " << e.what();
+        }
+    }
+}
+
+}  // namespace ripple
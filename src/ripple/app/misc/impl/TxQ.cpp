@@ -23,6 +23,8 @@
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/app/tx/apply.h>
 #include <ripple/basics/mulDiv.h>
+#include <ripple/basics/scope.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/protocol/st.h>
@@ -354,6 +356,8 @@ TxQ::TxQAccount::remove(SeqProxy seqProx)
 TxQ::TxQ(Setup const& setup, beast::Journal j)
     : setup_(setup), j_(j), feeMetrics_(setup, j), maxSize_(std::nullopt)
 {
+    std::lock_guard lock(mutex_);
+    publishMetrics(lock);
 }
 
 TxQ::~TxQ()
@@ -764,6 +768,7 @@ TxQ::apply(
     }
 
     std::lock_guard lock(mutex_);
+    scope_exit publish([this, &lock] { publishMetrics(lock); });
 
     // accountIter is not const because it may be updated further down.
     AccountMap::iterator accountIter = byAccount_.find(account);
@@ -1381,6 +1386,8 @@ TxQ::processClosedLedger(Application& app, ReadView const& view, bool timeLeap)
         else
             ++txQAccountIter;
     }
+
+    publishMetrics(lock);
 }
 
 /*
@@ -1407,6 +1414,10 @@ TxQ::processClosedLedger(Application& app, ReadView const& view, bool timeLeap)
                         and continue iterating.
     2. Return indicator of whether the open ledger was modified.
 
+    If `acceptBatchSize` is set, step 1 stops after trying that many
+        txs, and jobs repeat it on the open ledger, one batch at a time,
+        until it stops for any other reason.
+
     "Appropriate candidate" is defined as the tx that has the
         highest fee level of:
         * the tx for the current account with the next sequence.
@@ -1421,12 +1432,67 @@ TxQ::accept(Application& app, OpenView& view)
        level.
     */
 
-    auto ledgerChanged = false;
-
     std::lock_guard lock(mutex_);
+    auto const start = std::chrono::steady_clock::now();
+
+    acceptSeq_ = view.info().seq;
+    auto const ledgerChanged = acceptBatch(app, view, lock);
+
+    // All transactions that can be moved out of the queue into the open
+    // ledger have been, or will be by the jobs continuing a batched
+    // accept. Rebuild the queue using the open ledger's
+    // parent hash, so that transactions paying the same fee are
+    // reordered.
+    LedgerHash const& parentHash = view.info().parentHash;
+#if !NDEBUG
+    auto const startingSize = byFee_.size();
+    assert(parentHash != parentHash_);
+    parentHash_ = parentHash;
+#endif
+    // byFee_ doesn't "own" the candidate objects inside it, so it's
+    // perfectly safe to wipe it and start over, repopulating from
+    // byAccount_.
+    //
+    // In the absence of a "re-sort the list in place" function, this
+    // was the fastest method tried to repopulate the list.
+    // Other methods included: create a new list and moving items over one at a
+    // time, create a new list and merge the old list into it.
+    byFee_.clear();
+
+    MaybeTx::parentHashComp = parentHash;
+
+    for (auto& [_, account] : byAccount_)
+    {
+        for (auto& [_, candidate] : account.transactions)
+        {
+            byFee_.insert(candidate);
+        }
+    }
+    assert(byFee_.size() == startingSize);
+
+    if (acceptPending_)
+        scheduleAccept(app, lock);
+
+    acceptDuration_ = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    JLOG(j_.debug()) << "accept held the queue for "
+                     << acceptDuration_.count() << "us";
+    publishMetrics(lock);
+    return ledgerChanged;
+}
+
+bool
+TxQ::acceptBatch(
+    Application& app,
+    OpenView& view,
+    std::lock_guard<std::mutex> const& lock)
+{
+    auto ledgerChanged = false;
+    std::uint32_t tried = 0;
 
     auto const metricsSnapshot = feeMetrics_.getSnapshot();
 
+    acceptPending_ = false;
     for (auto candidateIter = byFee_.begin(); candidateIter != byFee_.end();)
     {
         auto& account = byAccount_.at(candidateIter->account);
@@ -1453,6 +1519,15 @@ TxQ::accept(Application& app, OpenView& view)
                          << " needs at least " << requiredFeeLevel;
         if (feeLevelPaid >= requiredFeeLevel)
         {
+            if (setup_.acceptBatchSize && tried == setup_.acceptBatchSize)
+            {
+                // Leave the rest for a later batch, so clients
+                // submitting to the open ledger aren't held up.
+                acceptPending_ = true;
+                break;
+            }
+            ++tried;
+
             JLOG(j_.trace()) << "Applying queued transaction "
                              << candidateIter->txID << " to open ledger.";
 
@@ -1546,37 +1621,44 @@ TxQ::accept(Application& app, OpenView& view)
         }
     }
 
-    // All transactions that can be moved out of the queue into the open
-    // ledger have been. Rebuild the queue using the open ledger's
-    // parent hash, so that transactions paying the same fee are
-    // reordered.
-    LedgerHash const& parentHash = view.info().parentHash;
-#if !NDEBUG
-    auto const startingSize = byFee_.size();
-    assert(parentHash != parentHash_);
-    parentHash_ = parentHash;
-#endif
-    // byFee_ doesn't "own" the candidate objects inside it, so it's
-    // perfectly safe to wipe it and start over, repopulating from
-    // byAccount_.
-    //
-    // In the absence of a "re-sort the list in place" function, this
-    // was the fastest method tried to repopulate the list.
-    // Other methods included: create a new list and moving items over one at a
-    // time, create a new list and merge the old list into it.
-    byFee_.clear();
+    return ledgerChanged;
+}
 
-    MaybeTx::parentHashComp = parentHash;
+void
+TxQ::scheduleAccept(Application& app, std::lock_guard<std::mutex> const&)
+{
+    if (acceptJobQueued_)
+        return;
+
+    acceptJobQueued_ =
+        app.getJobQueue().addJob(jtBATCH, "TxQ::accept", [this, &app]() {
+            app.openLedger().modify(
+                [this, &app](OpenView& view, beast::Journal) {
+                    return acceptMore(app, view);
+                });
+        });
+}
 
-    for (auto& [_, account] : byAccount_)
-    {
-        for (auto& [_, candidate] : account.transactions)
-        {
-            byFee_.insert(candidate);
-        }
-    }
-    assert(byFee_.size() == startingSize);
+bool
+TxQ::acceptMore(Application& app, OpenView& view)
+{
+    std::lock_guard lock(mutex_);
+    acceptJobQueued_ = false;
+
+    // A new open ledger was built since this job was queued,
+    // and accept has already filled it.
+    if (!acceptPending_ || view.info().seq != acceptSeq_)
+        return false;
+
+    auto const start = std::chrono::steady_clock::now();
+    auto const ledgerChanged = acceptBatch(app, view, lock);
+
+    if (acceptPending_)
+        scheduleAccept(app, lock);
 
+    acceptDuration_ = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    publishMetrics(lock);
     return ledgerChanged;
 }
 
@@ -1718,6 +1800,7 @@ TxQ::tryDirectApply(
                     removeFromByFee(existingIter, tx);
                 }
             }
+            publishMetrics(lock);
         }
         return {std::pair(txnResult, didApply)};
     }
@@ -1744,24 +1827,49 @@ TxQ::removeFromByFee(
     return std::nullopt;
 }
 
+void
+TxQ::publishMetrics(std::lock_guard<std::mutex> const&)
+{
+    auto const snapshot = feeMetrics_.getSnapshot();
+
+    PublishedMetrics next;
+    next.txCount = byFee_.size();
+    next.txQMaxSize = maxSize_;
+    next.minProcessingFeeLevel =
+        isFull() ? byFee_.rbegin()->feeLevel + FeeLevel64{1} : baseLevel;
+    next.txnsExpected = snapshot.txnsExpected;
+    next.escalationMultiplier = snapshot.escalationMultiplier;
+    next.acceptDuration = acceptDuration_;
+
+    std::lock_guard lock(publishedMutex_);
+    published_ = next;
+}
+
+TxQ::PublishedMetrics
+TxQ::getPublishedMetrics() const
+{
+    std::lock_guard lock(publishedMutex_);
+    return published_;
+}
+
 TxQ::Metrics
 TxQ::getMetrics(OpenView const& view) const
 {
     Metrics result;
 
-    std::lock_guard lock(mutex_);
-
-    auto const snapshot = feeMetrics_.getSnapshot();
+    auto const published = getPublishedMetrics();
+    FeeMetrics::Snapshot const snapshot{
+        published.txnsExpected, published.escalationMultiplier};
 
-    result.txCount = byFee_.size();
-    result.txQMaxSize = maxSize_;
+    result.txCount = published.txCount;
+    result.txQMaxSize = published.txQMaxSize;
     result.txInLedger = view.txCount();
     result.txPerLedger = snapshot.txnsExpected;
     result.referenceFeeLevel = baseLevel;
-    result.minProcessingFeeLevel =
-        isFull() ? byFee_.rbegin()->feeLevel + FeeLevel64{1} : baseLevel;
+    result.minProcessingFeeLevel = published.minProcessingFeeLevel;
     result.medFeeLevel = snapshot.escalationMultiplier;
     result.openLedgerFeeLevel = FeeMetrics::scaleFeeLevel(snapshot, view);
+    result.acceptDuration = published.acceptDuration;
 
     return result;
 }
@@ -1773,16 +1881,20 @@ TxQ::getTxRequiredFeeAndSeq(
 {
     auto const account = (*tx)[sfAccount];
 
-    std::lock_guard lock(mutex_);
-
-    auto const snapshot = feeMetrics_.getSnapshot();
+    auto const published = getPublishedMetrics();
+    FeeMetrics::Snapshot const snapshot{
+        published.txnsExpected, published.escalationMultiplier};
     auto const baseFee = calculateBaseFee(view, *tx);
     auto const fee = FeeMetrics::scaleFeeLevel(snapshot, view);
 
     auto const sle = view.read(keylet::account(account));
 
     std::uint32_t const accountSeq = sle ? (*sle)[sfSequence] : 0;
-    std::uint32_t const availableSeq = nextQueuableSeqImpl(sle, lock).value();
+    std::uint32_t const availableSeq = [this, &sle]() {
+        // Only the account's queue needs the lock
+        std::lock_guard lock(mutex_);
+        return nextQueuableSeqImpl(sle, lock).value();
+    }();
     return {
         mulDiv(fee, baseFee, baseLevel)
             .value_or(XRPAmount(std::numeric_limits<std::int64_t>::max())),
@@ -1944,6 +2056,7 @@ setup_TxQ(Config const& config)
 
     set(setup.maximumTxnPerAccount, "maximum_txn_per_account", section);
     set(setup.minimumLastLedgerBuffer, "minimum_last_ledger_buffer", section);
+    set(setup.acceptBatchSize, "accept_batch_size", section);
 
     setup.standAlone = config.standalone();
     return setup;
@@ -1069,10 +1069,11 @@ ValidatorList::applyList(
 {
     using namespace std::string_literals;
 
-    Json::Value list;
+    std::shared_ptr<Json::Value const> verified;
     PublicKey pubKey;
     auto const& manifest = localManifest ? *localManifest : globalManifest;
-    auto const result = verify(lock, list, pubKey, manifest, blob, signature);
+    auto const result =
+        verify(lock, verified, pubKey, manifest, blob, signature);
     if (result > ListDisposition::pending)
     {
         if (publisherLists_.count(pubKey))
@@ -1095,6 +1096,7 @@ ValidatorList::applyList(
     }
 
     // Update publisher's list
+    auto const& list = *verified;
     auto& pubCollection = publisherLists_[pubKey];
     auto const sequence = list[jss::sequence].asUInt();
     auto const accepted =
@@ -1258,7 +1260,7 @@ ValidatorList::loadLists()
 ListDisposition
 ValidatorList::verify(
     ValidatorList::lock_guard const& lock,
-    Json::Value& list,
+    std::shared_ptr<Json::Value const>& verified,
     PublicKey& pubKey,
     std::string const& manifest,
     std::string const& blob,
@@ -1284,19 +1286,12 @@ ValidatorList::verify(
     if (revoked || result == ManifestDisposition::invalid)
         return ListDisposition::untrusted;
 
-    auto const sig = strUnHex(signature);
-    auto const data = base64_decode(blob);
-    if (!sig ||
-        !ripple::verify(
-            publisherManifests_.getSigningKey(pubKey),
-            makeSlice(data),
-            makeSlice(*sig)))
-        return ListDisposition::invalid;
-
-    Json::Reader r;
-    if (!r.parse(data, list))
+    verified = verifyBlob(
+        lock, publisherManifests_.getSigningKey(pubKey), blob, signature);
+    if (!verified)
         return ListDisposition::invalid;
 
+    auto const& list = *verified;
     if (list.isMember(jss::sequence) && list[jss::sequence].isInt() &&
         list.isMember(jss::expiration) && list[jss::expiration].isInt() &&
         (!list.isMember(jss::effective) || list[jss::effective].isInt()) &&
@@ -1345,6 +1340,49 @@ ValidatorList::verify(
     return ListDisposition::accepted;
 }
 
+std::shared_ptr<Json::Value const>
+ValidatorList::verifyBlob(
+    ValidatorList::lock_guard const&,
+    PublicKey const& signingKey,
+    std::string const& blob,
+    std::string const& signature)
+{
+    // The signature only matches one blob, but the blob itself is compared
+    // too, so a forged blob that reuses the signature is never accepted.
+    auto const key = sha512Half(signingKey, makeSlice(signature));
+    if (auto const it = verifiedBlobs_.find(key);
+        it != verifiedBlobs_.end() && it->second.blob == blob)
+        return it->second.list;
+
+    std::shared_ptr<Json::Value const> result;
+    auto const sig = strUnHex(signature);
+    auto const data = base64_decode(blob);
+    if (sig && ripple::verify(signingKey, makeSlice(data), makeSlice(*sig)))
+    {
+        auto list = std::make_shared<Json::Value>();
+        Json::Reader r;
+        if (r.parse(data, *list))
+            result = std::move(list);
+    }
+
+    if (auto const [it, inserted] =
+            verifiedBlobs_.try_emplace(key, VerifiedBlob{blob, result});
+        inserted)
+    {
+        verifiedBlobOrder_.push_back(key);
+        if (verifiedBlobOrder_.size() > maxVerifiedBlobs)
+        {
+            verifiedBlobs_.erase(verifiedBlobOrder_.front());
+            verifiedBlobOrder_.pop_front();
+        }
+    }
+    else
+    {
+        it->second = VerifiedBlob{blob, result};
+    }
+    return result;
+}
+
 bool
 ValidatorList::listed(PublicKey const& identity) const
 {
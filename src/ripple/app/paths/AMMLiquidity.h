@@ -23,17 +23,16 @@
 #include "ripple/app/misc/AMMHelpers.h"
 #include "ripple/app/misc/AMMUtils.h"
 #include "ripple/app/paths/AMMContext.h"
+#include "ripple/app/paths/AMMOffer.h"
 #include "ripple/basics/Log.h"
 #include "ripple/ledger/ReadView.h"
 #include "ripple/ledger/View.h"
 #include "ripple/protocol/Quality.h"
+#include "ripple/protocol/QualityFunction.h"
 #include "ripple/protocol/STLedgerEntry.h"
 
 namespace ripple {
 
-template <typename TIn, typename TOut>
-class AMMOffer;
-
 /** AMMLiquidity class provides AMM offers to BookStep class.
  * The offers are generated in two ways. If there are multiple
  * paths specified to the payment transaction then the offers
@@ -62,6 +61,29 @@ private:
     TAmounts<TIn, TOut> const initialBalances_;
     beast::Journal const j_;
 
+    // An offer depends only on the pool balances, the competing CLOB
+    // quality and the AMM iteration, so while BookStep asks again for the
+    // same pool (the reverse and forward passes, the quality bounds and
+    // the strand's quality function) the last offer is handed out again.
+    struct CachedOffer
+    {
+        TAmounts<TIn, TOut> balances;
+        std::optional<Quality> clobQuality;
+        std::uint16_t iters;
+        bool multiPath;
+        Number::rounding_mode mode;
+        std::optional<AMMOffer<TIn, TOut>> offer;
+    };
+    mutable std::optional<CachedOffer> cachedOffer_;
+
+    struct CachedQualityFunc
+    {
+        TAmounts<TIn, TOut> balances;
+        Number::rounding_mode mode;
+        QualityFunction qf;
+    };
+    mutable std::optional<CachedQualityFunc> cachedQualityFunc_;
+
 public:
     AMMLiquidity(
         ReadView const& view,
@@ -121,6 +143,12 @@ public:
         return issueOut_;
     }
 
+    /** Returns the single path quality function of the pool at the given
+     * balances.
+     */
+    QualityFunction const&
+    qualityFunc(TAmounts<TIn, TOut> const& balances) const;
+
 private:
     /** Fetches current AMM balances.
      */
@@ -141,6 +169,13 @@ private:
      */
     AMMOffer<TIn, TOut>
     maxOffer(TAmounts<TIn, TOut> const& balances) const;
+
+    /** Generate AMM offer from the fetched balances.
+     */
+    std::optional<AMMOffer<TIn, TOut>>
+    makeOffer(
+        TAmounts<TIn, TOut> const& balances,
+        std::optional<Quality> const& clobQuality) const;
 };
 
 }  // namespace ripple
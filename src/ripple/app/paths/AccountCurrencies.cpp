@@ -33,25 +33,9 @@ accountSourceCurrencies(
     if (includeXRP)
         currencies.insert(xrpCurrency());
 
-    if (auto const lines =
-            lrCache->getRippleLines(account, LineDirection::outgoing))
-    {
-        for (auto const& rspEntry : *lines)
-        {
-            auto& saBalance = rspEntry.getBalance();
-
-            // Filter out non
-            if (saBalance > beast::zero
-                // Have IOUs to send.
-                ||
-                (rspEntry.getLimitPeer()
-                 // Peer extends credit.
-                 && ((-saBalance) < rspEntry.getLimitPeer())))  // Credit left.
-            {
-                currencies.insert(saBalance.getCurrency());
-            }
-        }
-    }
+    if (auto const index =
+            lrCache->getLineIndex(account, LineDirection::outgoing))
+        currencies.insert(index->send.begin(), index->send.end());
 
     currencies.erase(badCurrency());
     return currencies;
@@ -69,17 +53,9 @@ accountDestCurrencies(
         currencies.insert(xrpCurrency());
     // Even if account doesn't exist
 
-    if (auto const lines =
-            lrCache->getRippleLines(account, LineDirection::outgoing))
-    {
-        for (auto const& rspEntry : *lines)
-        {
-            auto& saBalance = rspEntry.getBalance();
-
-            if (saBalance < rspEntry.getLimit())  // Can take more
-                currencies.insert(saBalance.getCurrency());
-        }
-    }
+    if (auto const index =
+            lrCache->getLineIndex(account, LineDirection::outgoing))
+        currencies.insert(index->receive.begin(), index->receive.end());
 
     currencies.erase(badCurrency());
     return currencies;
@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/paths/PathDependencies.h>
+#include <ripple/protocol/STArray.h>
+#include <ripple/protocol/STLedgerEntry.h>
+
+namespace ripple {
+
+void
+PathDependencies::merge(PathDependencies const& other)
+{
+    accounts.insert(other.accounts.begin(), other.accounts.end());
+    books.insert(other.books.begin(), other.books.end());
+    keys.insert(other.keys.begin(), other.keys.end());
+    ranges.insert(ranges.end(), other.ranges.begin(), other.ranges.end());
+    if (other.expires && (!expires || *other.expires < *expires))
+        expires = other.expires;
+}
+
+//------------------------------------------------------------------------------
+
+LedgerChanges::LedgerChanges(ReadView const& ledger)
+    : parentCloseTime_(ledger.parentCloseTime())
+{
+    for (auto const& [tx, meta] : ledger.txs)
+    {
+        if (!meta)
+            continue;
+
+        for (auto const& node : meta->getFieldArray(sfAffectedNodes))
+        {
+            keys_.insert(node.getFieldH256(sfLedgerIndex));
+
+            auto const type = node.getFieldU16(sfLedgerEntryType);
+            if (type == ltFEE_SETTINGS || type == ltAMENDMENTS)
+            {
+                all_ = true;
+                continue;
+            }
+
+            auto const& fieldName = node.getFName() == sfCreatedNode
+                ? sfNewFields
+                : sfFinalFields;
+            if (!node.isFieldPresent(fieldName))
+                continue;
+            auto const& fields =
+                node.peekAtField(fieldName).downcast<STObject>();
+
+            if (type == ltRIPPLE_STATE)
+            {
+                for (auto const& limit : {&sfLowLimit, &sfHighLimit})
+                {
+                    if (fields.isFieldPresent(*limit))
+                        lineAccounts_.insert(
+                            fields.getFieldAmount(*limit).getIssuer());
+                }
+            }
+            else if (type == ltACCOUNT_ROOT)
+            {
+                if (fields.isFieldPresent(sfAccount))
+                    accounts_.insert(fields.getAccountID(sfAccount));
+            }
+            else if (type == ltOFFER)
+            {
+                if (fields.isFieldPresent(sfTakerPays))
+                    books_.insert(fields.getFieldAmount(sfTakerPays).issue());
+            }
+        }
+    }
+}
+
+bool
+LedgerChanges::affects(PathDependencies const& deps) const
+{
+    if (all_)
+        return true;
+
+    // The offers in a book are checked for expiry as of the parent's close
+    if (deps.expires && *deps.expires <= parentCloseTime_)
+        return true;
+
+    for (auto const& account : deps.accounts)
+    {
+        if (lineAccounts_.count(account) || accounts_.count(account))
+            return true;
+    }
+
+    for (auto const& issue : deps.books)
+    {
+        if (books_.count(issue))
+            return true;
+    }
+
+    for (auto const& key : keys_)
+    {
+        if (deps.keys.count(key))
+            return true;
+
+        for (auto const& [first, last] : deps.ranges)
+        {
+            if (key > first && (!last || key < *last))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------
+
+bool
+RecordingView::exists(Keylet const& k) const
+{
+    deps_.keys.insert(k.key);
+    return base_.exists(k);
+}
+
+std::optional<ReadView::key_type>
+RecordingView::succ(key_type const& key, std::optional<key_type> const& last)
+    const
+{
+    deps_.ranges.emplace_back(key, last);
+    return base_.succ(key, last);
+}
+
+std::shared_ptr<SLE const>
+RecordingView::read(Keylet const& k) const
+{
+    deps_.keys.insert(k.key);
+    auto sle = base_.read(k);
+    if (sle && sle->getType() == ltOFFER && sle->isFieldPresent(sfExpiration))
+    {
+        NetClock::time_point const expires{
+            NetClock::duration{sle->getFieldU32(sfExpiration)}};
+        if (!deps_.expires || expires < *deps_.expires)
+            deps_.expires = expires;
+    }
+    return sle;
+}
+
+}  // namespace ripple
@@ -0,0 +1,210 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_PATHS_PATHDEPENDENCIES_H_INCLUDED
+#define RIPPLE_APP_PATHS_PATHDEPENDENCIES_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/Issue.h>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** The parts of a ledger that a path search depended on.
+
+    A later ledger that changes none of them gives the search the same
+    result.
+*/
+struct PathDependencies
+{
+    // Accounts whose roots or trust lines were read
+    hash_set<AccountID> accounts;
+
+    // The issues taken by the order books that were looked up
+    hash_set<Issue> books;
+
+    // State entries read while checking the paths
+    hash_set<uint256> keys;
+
+    // Open key ranges searched for their first entry, such as a book's tip.
+    // An unseated end means the range runs to the end of the ledger.
+    std::vector<std::pair<uint256, std::optional<uint256>>> ranges;
+
+    // When the first of the offers that were read expires
+    std::optional<NetClock::time_point> expires;
+
+    void
+    merge(PathDependencies const& other);
+};
+
+/** What the transactions in a closed ledger changed in its parent. */
+class LedgerChanges
+{
+public:
+    explicit LedgerChanges(ReadView const& ledger);
+
+    /** The accounts on either side of the trust lines that changed. */
+    hash_set<AccountID> const&
+    lineAccounts() const
+    {
+        return lineAccounts_;
+    }
+
+    /** Whether a search on the parent ledger could find something else.
+
+        @param deps What the search depended on.
+    */
+    bool
+    affects(PathDependencies const& deps) const;
+
+private:
+    hash_set<uint256> keys_;
+    hash_set<AccountID> lineAccounts_;
+    hash_set<AccountID> accounts_;
+    hash_set<Issue> books_;
+
+    // Offers are checked for expiry against this
+    NetClock::time_point parentCloseTime_;
+
+    // The fees or amendments changed, which can change any search
+    bool all_ = false;
+};
+
+/** A view that records every state entry read through it.
+
+    The entries that are read are added to a set of dependencies. The view
+    is not safe to use from more than one thread at a time.
+*/
+class RecordingView : public ReadView
+{
+private:
+    ReadView const& base_;
+    PathDependencies& deps_;
+
+public:
+    RecordingView(ReadView const& base, PathDependencies& deps)
+        : base_(base), deps_(deps)
+    {
+    }
+
+    RecordingView(RecordingView const&) = delete;
+    RecordingView&
+    operator=(RecordingView const&) = delete;
+
+    LedgerInfo const&
+    info() const override
+    {
+        return base_.info();
+    }
+
+    bool
+    open() const override
+    {
+        return base_.open();
+    }
+
+    Fees const&
+    fees() const override
+    {
+        return base_.fees();
+    }
+
+    Rules const&
+    rules() const override
+    {
+        return base_.rules();
+    }
+
+    bool
+    exists(Keylet const& k) const override;
+
+    std::optional<key_type>
+    succ(
+        key_type const& key,
+        std::optional<key_type> const& last = std::nullopt) const override;
+
+    std::shared_ptr<SLE const>
+    read(Keylet const& k) const override;
+
+    STAmount
+    balanceHook(
+        AccountID const& account,
+        AccountID const& issuer,
+        STAmount const& amount) const override
+    {
+        return base_.balanceHook(account, issuer, amount);
+    }
+
+    std::uint32_t
+    ownerCountHook(AccountID const& account, std::uint32_t count)
+        const override
+    {
+        return base_.ownerCountHook(account, count);
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesBegin() const override
+    {
+        return base_.slesBegin();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesEnd() const override
+    {
+        return base_.slesEnd();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesUpperBound(key_type const& key) const override
+    {
+        return base_.slesUpperBound(key);
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsBegin() const override
+    {
+        return base_.txsBegin();
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsEnd() const override
+    {
+        return base_.txsEnd();
+    }
+
+    bool
+    txExists(key_type const& key) const override
+    {
+        return base_.txExists(key);
+    }
+
+    tx_type
+    txRead(key_type const& key) const override
+    {
+        return base_.txRead(key);
+    }
+};
+
+}  // namespace ripple
+
+#endif
@@ -28,13 +28,19 @@
 #include <ripple/basics/Log.h>
 #include <ripple/beast/core/LexicalCast.h>
 #include <ripple/core/Config.h>
+#include <ripple/ledger/CachedSLEs.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/Serializer.h>
 #include <ripple/protocol/UintTypes.h>
 
 #include <ripple/rpc/impl/Tuning.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
 #include <optional>
-
+#include <thread>
 #include <tuple>
 
 namespace ripple {
@@ -57,6 +63,7 @@ PathRequest::PathRequest(
     , bLastSuccess(false)
     , iIdentifier(id)
     , created_(std::chrono::steady_clock::now())
+    , iDependencyLevel(0)
 {
     JLOG(m_journal.debug()) << iIdentifier << " created";
 }
@@ -80,6 +87,7 @@ PathRequest::PathRequest(
     , bLastSuccess(false)
     , iIdentifier(id)
     , created_(std::chrono::steady_clock::now())
+    , iDependencyLevel(0)
 {
     JLOG(m_journal.debug()) << iIdentifier << " created";
 }
@@ -463,18 +471,15 @@ PathRequest::doAborting() const
     JLOG(m_journal.info()) << iIdentifier << " aborting early";
 }
 
-std::unique_ptr<Pathfinder> const&
-PathRequest::getPathFinder(
+std::unique_ptr<Pathfinder>
+PathRequest::makePathFinder(
     std::shared_ptr<RippleLineCache> const& cache,
-    hash_map<Currency, std::unique_ptr<Pathfinder>>& currency_map,
     Currency const& currency,
     STAmount const& dst_amount,
     int const level,
-    std::function<bool(void)> const& continueCallback)
+    std::function<bool(void)> const& continueCallback,
+    std::size_t threads)
 {
-    auto i = currency_map.find(currency);
-    if (i != currency_map.end())
-        return i->second;
     auto pathfinder = std::make_unique<Pathfinder>(
         cache,
         *raSrcAccount,
@@ -485,10 +490,104 @@ PathRequest::getPathFinder(
         saSendMax,
         app_);
     if (pathfinder->findPaths(level, continueCallback))
-        pathfinder->computePathRanks(max_paths_, continueCallback);
+        pathfinder->computePathRanks(max_paths_, continueCallback, threads);
     else
         pathfinder.reset();  // It's a bad request - clear it.
-    return currency_map[currency] = std::move(pathfinder);
+    return pathfinder;
+}
+
+std::unique_ptr<Pathfinder> const&
+PathRequest::getPathFinder(
+    std::shared_ptr<RippleLineCache> const& cache,
+    hash_map<Currency, std::unique_ptr<Pathfinder>>& currency_map,
+    Currency const& currency,
+    STAmount const& dst_amount,
+    int const level,
+    std::function<bool(void)> const& continueCallback)
+{
+    auto i = currency_map.find(currency);
+    if (i != currency_map.end())
+        return i->second;
+    return currency_map[currency] = makePathFinder(
+               cache, currency, dst_amount, level, continueCallback, 1);
+}
+
+void
+PathRequest::makePathFinders(
+    std::shared_ptr<RippleLineCache> const& cache,
+    hash_map<Currency, std::unique_ptr<Pathfinder>>& currency_map,
+    std::vector<Currency> const& currencies,
+    STAmount const& dst_amount,
+    int const level,
+    std::function<bool(void)> const& continueCallback,
+    std::size_t threads)
+{
+    // With a single currency, its paths are ranked on all the threads
+    if (currencies.size() == 1)
+    {
+        currency_map[currencies.front()] = makePathFinder(
+            cache,
+            currencies.front(),
+            dst_amount,
+            level,
+            continueCallback,
+            threads);
+        return;
+    }
+
+    // Every pathfinder reads the same ledger and line cache but keeps all
+    // of its own state, and checks its paths in sandboxes of its own.
+    std::vector<std::unique_ptr<Pathfinder>> pathfinders(currencies.size());
+    std::vector<char> searched(currencies.size(), false);
+    std::atomic<std::size_t> next{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    auto const worker = [&]() {
+        try
+        {
+            for (auto i = next++; i < currencies.size(); i = next++)
+            {
+                if (continueCallback && !continueCallback())
+                    break;
+                pathfinders[i] = makePathFinder(
+                    cache,
+                    currencies[i],
+                    dst_amount,
+                    level,
+                    continueCallback,
+                    1);
+                searched[i] = true;
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard lock(errorMutex);
+            if (!error)
+                error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    auto const count = std::min(threads, currencies.size());
+    if (count > 1)
+        workers.reserve(count - 1);
+    for (std::size_t i = 1; i < count; ++i)
+        workers.emplace_back(worker);
+    worker();
+
+    for (auto& w : workers)
+        w.join();
+
+    if (error)
+        std::rethrow_exception(error);
+
+    // A currency that was not reached is searched again when it is needed
+    for (std::size_t i = 0; i < currencies.size(); ++i)
+    {
+        if (searched[i])
+            currency_map[currencies[i]] = std::move(pathfinders[i]);
+    }
 }
 
 bool
@@ -496,8 +595,11 @@ PathRequest::findPaths(
     std::shared_ptr<RippleLineCache> const& cache,
     int const level,
     Json::Value& jvArray,
-    std::function<bool(void)> const& continueCallback)
+    PathDependencies& deps,
+    std::function<bool(void)> const& continueCallback,
+    std::size_t threads)
 {
+    deps.accounts.insert({*raSrcAccount, *raDstAccount});
     auto sourceCurrencies = sciSourceCurrencies;
     if (sourceCurrencies.empty() && saSendMax)
     {
@@ -521,6 +623,30 @@ PathRequest::findPaths(
 
     auto const dst_amount = convertAmount(saDstAmount, convert_all_);
     hash_map<Currency, std::unique_ptr<Pathfinder>> currency_map;
+    if (threads > 1)
+    {
+        // Search every source currency up front, in parallel. The results
+        // are then used in the same order as a serial search would.
+        std::vector<Currency> currencies;
+        for (auto const& issue : sourceCurrencies)
+        {
+            if (std::find(
+                    currencies.begin(), currencies.end(), issue.currency) ==
+                currencies.end())
+                currencies.push_back(issue.currency);
+        }
+        makePathFinders(
+            cache,
+            currency_map,
+            currencies,
+            dst_amount,
+            level,
+            continueCallback,
+            threads);
+    }
+
+    // The payments are checked through a view that notes what they read
+    RecordingView const view{*cache->getLedger(), deps};
     for (auto const& issue : sourceCurrencies)
     {
         if (continueCallback && !continueCallback())
@@ -541,7 +667,6 @@ PathRequest::findPaths(
             JLOG(m_journal.debug()) << iIdentifier << " No paths found";
             continue;
         }
-
         STPath fullLiquidityPath;
         auto ps = pathfinder->getBestPaths(
             max_paths_,
@@ -551,6 +676,10 @@ PathRequest::findPaths(
             continueCallback);
         mContext[issue] = ps;
 
+        // Ranking the last result's paths added to what the search read
+        deps.merge(pathfinder->dependencies());
+        deps.accounts.insert(issue.account);
+
         auto const& sourceAccount = [&] {
             if (!isXRP(issue.account))
                 return issue.account;
@@ -571,7 +700,7 @@ PathRequest::findPaths(
         if (convert_all_)
             rcInput.partialPaymentAllowed = true;
         auto sandbox =
-            std::make_unique<PaymentSandbox>(&*cache->getLedger(), tapNONE);
+            std::make_unique<PaymentSandbox>(&view, tapNONE);
         auto rc = path::RippleCalc::rippleCalculate(
             *sandbox,
             saMaxAmount,    // --> Amount to send is unlimited
@@ -591,7 +720,7 @@ PathRequest::findPaths(
 
             ps.push_back(fullLiquidityPath);
             sandbox =
-                std::make_unique<PaymentSandbox>(&*cache->getLedger(), tapNONE);
+                std::make_unique<PaymentSandbox>(&view, tapNONE);
             rc = path::RippleCalc::rippleCalculate(
                 *sandbox,
                 saMaxAmount,    // --> Amount to send is unlimited
@@ -659,6 +788,7 @@ PathRequest::doUpdate(
     std::function<bool(void)> const& continueCallback)
 {
     using namespace std::chrono;
+    CachedSLEs::Scope const caller{CachedSLEs::Caller::pathfinding};
     JLOG(m_journal.debug())
         << iIdentifier << " update " << (fast ? "fast" : "normal");
 
@@ -724,8 +854,21 @@ PathRequest::doUpdate(
 
     JLOG(m_journal.debug()) << iIdentifier << " processing at level " << iLevel;
 
+    if (!fast && canReuse(cache))
+    {
+        JLOG(m_journal.debug())
+            << iIdentifier << " reusing the last result, nothing changed";
+        mDependencyLedger = cache->getLedger()->info().hash;
+        std::lock_guard sl(mLock);
+        return jvStatus;
+    }
+
     Json::Value jvArray = Json::arrayValue;
-    if (findPaths(cache, iLevel, jvArray, continueCallback))
+    PathDependencies deps;
+    // Leave the other threads to the rest of the server when it is busy
+    std::size_t const threads =
+        loaded ? 1 : app_.config().PATH_SEARCH_THREADS;
+    if (findPaths(cache, iLevel, jvArray, deps, continueCallback, threads))
     {
         bLastSuccess = jvArray.size() != 0;
         newStatus[jss::alternatives] = std::move(jvArray);
@@ -736,6 +879,18 @@ PathRequest::doUpdate(
         newStatus = rpcError(rpcINTERNAL);
     }
 
+    // A fast search looks less far, so it never stands in for a full one
+    if (fast)
+    {
+        mDependencies.reset();
+    }
+    else
+    {
+        mDependencies = std::move(deps);
+        mDependencyLedger = cache->getLedger()->info().hash;
+        iDependencyLevel = iLevel;
+    }
+
     if (fast && quick_reply_ == steady_clock::time_point{})
     {
         quick_reply_ = steady_clock::now();
@@ -757,6 +912,77 @@ PathRequest::doUpdate(
     return newStatus;
 }
 
+std::optional<uint256>
+PathRequest::getQuery()
+{
+    if (!raSrcAccount || !raDstAccount)
+        return std::nullopt;
+
+    // The parameters do not change once the request is created
+    Serializer s;
+    s.addBitString(*raSrcAccount);
+    s.addBitString(*raDstAccount);
+    saDstAmount.add(s);
+    s.add8(saSendMax ? 1 : 0);
+    if (saSendMax)
+        saSendMax->add(s);
+    s.add32(sciSourceCurrencies.size());
+    for (auto const& issue : sciSourceCurrencies)
+    {
+        s.addBitString(issue.currency);
+        s.addBitString(issue.account);
+    }
+    s.add8(convert_all_ ? 1 : 0);
+    // Old ripple_path_find requests are answered differently
+    s.add8(hasCompletion() ? 1 : 0);
+    return s.getSHA512Half();
+}
+
+Json::Value
+PathRequest::doShare(PathRequest const& leader, Json::Value status)
+{
+    using namespace std::chrono;
+    JLOG(m_journal.debug())
+        << iIdentifier << " sharing the update of " << leader.iIdentifier;
+
+    iLevel = leader.iLevel;
+    bLastSuccess = leader.bLastSuccess;
+    mContext = leader.mContext;
+    mDependencies = leader.mDependencies;
+    mDependencyLedger = leader.mDependencyLedger;
+    iDependencyLevel = leader.iDependencyLevel;
+
+    status.removeMember(jss::id);
+    if (jvId)
+        status[jss::id] = jvId;
+
+    if (full_reply_ == steady_clock::time_point{})
+    {
+        full_reply_ = steady_clock::now();
+        mOwner.reportFull(duration_cast<milliseconds>(full_reply_ - created_));
+    }
+
+    std::lock_guard sl(mLock);
+    jvStatus = status;
+    return status;
+}
+
+bool
+PathRequest::canReuse(std::shared_ptr<RippleLineCache> const& cache) const
+{
+    if (!mDependencies || iLevel != iDependencyLevel)
+        return false;
+
+    auto const& info = cache->getLedger()->info();
+    if (info.hash == mDependencyLedger)
+        return true;
+
+    // Only the changes made by a single ledger are known
+    auto const& changes = cache->changes();
+    return changes && info.parentHash == mDependencyLedger &&
+        !changes->affects(*mDependencies);
+}
+
 InfoSub::pointer
 PathRequest::getSubscriber() const
 {
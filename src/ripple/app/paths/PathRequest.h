@@ -21,10 +21,12 @@
 #define RIPPLE_APP_PATHS_PATHREQUEST_H_INCLUDED
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/paths/PathDependencies.h>
 #include <ripple/app/paths/Pathfinder.h>
 #include <ripple/app/paths/RippleLineCache.h>
 #include <ripple/json/json_value.h>
 #include <ripple/net/InfoSub.h>
+#include <ripple/protocol/RippleLedgerHash.h>
 #include <ripple/protocol/UintTypes.h>
 #include <map>
 #include <mutex>
@@ -101,6 +103,24 @@ public:
         std::shared_ptr<RippleLineCache> const&,
         bool fast,
         std::function<bool(void)> const& continueCallback = {});
+    /** Identifies what the request asks, so that requests asking the same
+        can share an update.
+
+        @return nothing if the request was not created.
+    */
+    std::optional<uint256>
+    getQuery();
+
+    /** Take the result of a full update of a request asking the same.
+
+        The request is left as if it had found that result itself, so its
+        next update starts from the paths and the level `leader` used.
+
+        @param status What `leader`'s update returned.
+    */
+    Json::Value
+    doShare(PathRequest const& leader, Json::Value status);
+
     InfoSub::pointer
     getSubscriber() const;
     bool
@@ -110,6 +130,15 @@ private:
     bool
     isValid(std::shared_ptr<RippleLineCache> const& crCache);
 
+    std::unique_ptr<Pathfinder>
+    makePathFinder(
+        std::shared_ptr<RippleLineCache> const&,
+        Currency const&,
+        STAmount const&,
+        int const,
+        std::function<bool(void)> const&,
+        std::size_t threads);
+
     std::unique_ptr<Pathfinder> const&
     getPathFinder(
         std::shared_ptr<RippleLineCache> const&,
@@ -119,15 +148,40 @@ private:
         int const,
         std::function<bool(void)> const&);
 
+    /** Build the pathfinders for several source currencies at once.
+
+        Each currency is searched on its own, so up to `threads` are
+        searched at the same time.
+    */
+    void
+    makePathFinders(
+        std::shared_ptr<RippleLineCache> const&,
+        hash_map<Currency, std::unique_ptr<Pathfinder>>&,
+        std::vector<Currency> const&,
+        STAmount const&,
+        int const,
+        std::function<bool(void)> const&,
+        std::size_t threads);
+
     /** Finds and sets a PathSet in the JSON argument.
         Returns false if the source currencies are inavlid.
+        What the search depended on is added to `deps`.
     */
     bool
     findPaths(
         std::shared_ptr<RippleLineCache> const&,
         int const,
         Json::Value&,
-        std::function<bool(void)> const&);
+        PathDependencies& deps,
+        std::function<bool(void)> const&,
+        std::size_t threads = 1);
+
+    /** Whether the last full update still holds for the cache's ledger.
+
+        It holds while each ledger since changes nothing it depended on.
+    */
+    bool
+    canReuse(std::shared_ptr<RippleLineCache> const& cache) const;
 
     int
     parseJson(Json::Value const&);
@@ -170,6 +224,12 @@ private:
     std::chrono::steady_clock::time_point quick_reply_;
     std::chrono::steady_clock::time_point full_reply_;
 
+    // What the last full update depended on, with the ledger and the level
+    // it searched at
+    std::optional<PathDependencies> mDependencies;
+    LedgerHash mDependencyLedger;
+    int iDependencyLevel;
+
     static unsigned int const max_paths_ = 4;
 };
 
@@ -27,6 +27,7 @@
 #include <ripple/protocol/jss.h>
 #include <ripple/resource/Fees.h>
 #include <algorithm>
+#include <optional>
 
 namespace ripple {
 
@@ -57,13 +58,39 @@ PathRequests::getLineCache(
             << "getLineCache creating new cache for " << lgrSeq;
         // Assign to the local before the member, because the member is a
         // weak_ptr, and will immediately discard it if there are no other
-        // references.
-        lineCache_ = lineCache = std::make_shared<RippleLineCache>(
-            ledger, app_.journal("RippleLineCache"));
+        // references. Moving on to the next ledger keeps the lines of the
+        // accounts it did not change.
+        if (lineCache && lgrSeq == lineSeq + 1)
+            lineCache_ = lineCache = std::make_shared<RippleLineCache>(
+                ledger, *lineCache, app_.journal("RippleLineCache"));
+        else
+            lineCache_ = lineCache = std::make_shared<RippleLineCache>(
+                ledger, app_.journal("RippleLineCache"));
+
+        if (authoritative)
+            heldLineCache_ = lineCache;
     }
     return lineCache;
 }
 
+std::shared_ptr<RippleLineCache>
+PathRequests::findLineCache(std::shared_ptr<ReadView const> const& ledger)
+{
+    std::lock_guard sl(mLock);
+
+    auto lineCache = lineCache_.lock();
+    if (!lineCache)
+        return nullptr;
+
+    // Open ledgers have no hash to tell them apart
+    auto const& cached = lineCache->getLedger();
+    if (cached == ledger ||
+        (!cached->open() && !ledger->open() &&
+         cached->info().hash == ledger->info().hash))
+        return lineCache;
+    return nullptr;
+}
+
 void
 PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
 {
@@ -86,7 +113,48 @@ PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
     JLOG(mJournal.trace()) << "updateAll seq=" << cache->getLedger()->seq()
                            << ", " << requests.size() << " requests";
 
-    int processed = 0, removed = 0;
+    int processed = 0, removed = 0, shared = 0;
+
+    // Requests asking the same share the first full update made for them
+    // on a ledger, so the work grows with the distinct questions asked
+    // rather than with the clients asking them.
+    struct Group
+    {
+        PathRequest::pointer leader;
+        LedgerHash ledger;
+        Json::Value status;
+        std::size_t size;
+    };
+    hash_map<uint256, Group> groups;
+
+    auto const update = [&](PathRequest::pointer const& request,
+                            std::optional<uint256> const& query,
+                            std::function<bool(void)> const& continueCallback) {
+        if (query)
+        {
+            if (auto it = groups.find(*query); it != groups.end() &&
+                it->second.ledger == cache->getLedger()->info().hash)
+            {
+                ++it->second.size;
+                ++shared;
+                return request->doShare(*it->second.leader, it->second.status);
+            }
+        }
+        return request->doUpdate(cache, false, continueCallback);
+    };
+
+    // Only an update that ran to completion is shared
+    auto const lead = [&](PathRequest::pointer const& request,
+                          std::optional<uint256> const& query,
+                          Json::Value const& status) {
+        auto const& ledger = cache->getLedger()->info().hash;
+        if (!query)
+            return;
+        auto& group = groups[*query];
+        if (group.leader && group.ledger == ledger)
+            return;
+        group = {request, ledger, status, 1};
+    };
 
     auto getSubscriber =
         [](PathRequest::pointer const& request) -> InfoSub::pointer {
@@ -133,13 +201,15 @@ PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
                             // it can be freed if the client disconnects, and
                             // thus fail to lock later.
                             ipSub.reset();
-                            Json::Value update = request->doUpdate(
-                                cache, false, continueCallback);
+                            auto const query = request->getQuery();
+                            Json::Value status =
+                                update(request, query, continueCallback);
                             request->updateComplete();
-                            update[jss::type] = "path_find";
                             if ((ipSub = getSubscriber(request)))
                             {
-                                ipSub->send(update, false);
+                                lead(request, query, status);
+                                status[jss::type] = "path_find";
+                                ipSub->send(status, false);
                                 remove = false;
                                 ++processed;
                             }
@@ -148,7 +218,8 @@ PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
                     else if (request->hasCompletion())
                     {
                         // One-shot request with completion function
-                        request->doUpdate(cache, false);
+                        auto const query = request->getQuery();
+                        lead(request, query, update(request, query, {}));
                         request->updateComplete();
                         ++processed;
                     }
@@ -215,8 +286,23 @@ PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
         }
     } while (!app_.getJobQueue().isStopping());
 
+    // With no requests left there is no next ledger to start a cache from
+    std::shared_ptr<RippleLineCache> heldCache;
+    {
+        std::lock_guard sl(mLock);
+        if (requests_.empty())
+            std::swap(heldCache, heldLineCache_);
+    }
+
+    std::size_t groupMax = 0;
+    for (auto const& entry : groups)
+        groupMax = std::max(groupMax, entry.second.size);
+    mShared += shared;
+    mGroupMax = groupMax;
+
     JLOG(mJournal.debug()) << "updateAll complete: " << processed
-                           << " processed and " << removed << " removed";
+                           << " processed, " << shared << " shared and "
+                           << removed << " removed";
 }
 
 bool
@@ -42,6 +42,8 @@ public:
     {
         mFast = collector->make_event("pathfind_fast");
         mFull = collector->make_event("pathfind_full");
+        mShared = collector->make_meter("pathfind_shared");
+        mGroupMax = collector->make_gauge("pathfind_group_max");
     }
 
     /** Update all of the contained PathRequest instances.
@@ -59,6 +61,11 @@ public:
         std::shared_ptr<ReadView const> const& ledger,
         bool authoritative);
 
+    /** Return the line cache if it is for this ledger, without making one.
+     */
+    std::shared_ptr<RippleLineCache>
+    findLineCache(std::shared_ptr<ReadView const> const& ledger);
+
     // Create a new-style path request that pushes
     // updates to a subscriber
     Json::Value
@@ -108,12 +115,21 @@ private:
     beast::insight::Event mFast;
     beast::insight::Event mFull;
 
+    // Updates taken from a request asking the same, and the most requests
+    // that asked the same in the last updateAll
+    beast::insight::Meter mShared;
+    beast::insight::Gauge mGroupMax;
+
     // Track all requests
     std::vector<PathRequest::wptr> requests_;
 
     // Use a RippleLineCache
     std::weak_ptr<RippleLineCache> lineCache_;
 
+    // The cache for the last authoritative ledger, kept while there are
+    // requests so that the next ledger's cache can start from it
+    std::shared_ptr<RippleLineCache> heldLineCache_;
+
     std::atomic<int> mLastIdentifier;
 
     std::recursive_mutex mutable mLock;
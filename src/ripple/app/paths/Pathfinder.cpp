@@ -30,6 +30,10 @@
 #include <ripple/json/to_string.h>
 #include <ripple/ledger/PaymentSandbox.h>
 
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include <tuple>
 
 /*
@@ -189,6 +193,9 @@ Pathfinder::Pathfinder(
     , j_(app.journal("Pathfinder"))
 {
     assert(!uSrcIssuer || isXRP(uSrcCurrency) == isXRP(uSrcIssuer.value()));
+    mDependencies.accounts.insert({mSrcAccount, mDstAccount, mEffectiveDst});
+    if (mSrcIssuer)
+        mDependencies.accounts.insert(*mSrcIssuer);
 }
 
 bool
@@ -345,6 +352,7 @@ Pathfinder::getPathLiquidity(
     STPath const& path,            // IN:  The path to check.
     STAmount const& minDstAmount,  // IN:  The minimum output this path must
                                    //      deliver to be worth keeping.
+    PathDependencies& deps,        // OUT: What the check read.
     STAmount& amountOut,           // OUT: The actual liquidity along the path.
     uint64_t& qualityOut) const    // OUT: The returned initial quality
 {
@@ -354,7 +362,8 @@ Pathfinder::getPathLiquidity(
     path::RippleCalc::Input rcInput;
     rcInput.defaultPathsAllowed = false;
 
-    PaymentSandbox sandbox(&*mLedger, tapNONE);
+    RecordingView const view{*mLedger, deps};
+    PaymentSandbox sandbox(&view, tapNONE);
 
     try
     {
@@ -410,14 +419,16 @@ Pathfinder::getPathLiquidity(
 void
 Pathfinder::computePathRanks(
     int maxPaths,
-    std::function<bool(void)> const& continueCallback)
+    std::function<bool(void)> const& continueCallback,
+    std::size_t threads)
 {
     mRemainingAmount = convertAmount(mDstAmount, convert_all_);
 
     // Must subtract liquidity in default path from remaining amount.
     try
     {
-        PaymentSandbox sandbox(&*mLedger, tapNONE);
+        RecordingView const view{*mLedger, mDependencies};
+        PaymentSandbox sandbox(&view, tapNONE);
 
         path::RippleCalc::Input rcInput;
         rcInput.partialPaymentAllowed = true;
@@ -448,7 +459,7 @@ Pathfinder::computePathRanks(
         JLOG(j_.debug()) << "Default path causes exception";
     }
 
-    rankPaths(maxPaths, mCompletePaths, mPathRanks, continueCallback);
+    rankPaths(maxPaths, mCompletePaths, mPathRanks, continueCallback, threads);
 }
 
 static bool
@@ -490,7 +501,8 @@ Pathfinder::rankPaths(
     int maxPaths,
     STPathSet const& paths,
     std::vector<PathRank>& rankedPaths,
-    std::function<bool(void)> const& continueCallback)
+    std::function<bool(void)> const& continueCallback,
+    std::size_t threads)
 {
     JLOG(j_.trace()) << "rankPaths with " << paths.size() << " candidates, and "
                      << maxPaths << " maximum";
@@ -509,32 +521,96 @@ Pathfinder::rankPaths(
         return largestAmount(mDstAmount);
     }();
 
-    for (int i = 0; i < paths.size(); ++i)
-    {
-        if (continueCallback && !continueCallback())
-            return;
+    auto const rank = [&](int i,
+                          PathDependencies& deps) -> std::optional<PathRank> {
         auto const& currentPath = paths[i];
-        if (!currentPath.empty())
+        if (currentPath.empty())
+            return std::nullopt;
+
+        STAmount liquidity;
+        uint64_t uQuality;
+        auto const resultCode = getPathLiquidity(
+            currentPath, saMinDstAmount, deps, liquidity, uQuality);
+        if (resultCode != tesSUCCESS)
+        {
+            JLOG(j_.debug())
+                << "findPaths: dropping : " << transToken(resultCode) << ": "
+                << currentPath.getJson(JsonOptions::none);
+            return std::nullopt;
+        }
+
+        JLOG(j_.debug()) << "findPaths: quality: " << uQuality << ": "
+                         << currentPath.getJson(JsonOptions::none);
+        return PathRank{uQuality, currentPath.size(), liquidity, i};
+    };
+
+    if (threads <= 1 || paths.size() <= 1)
+    {
+        for (int i = 0; i < paths.size(); ++i)
         {
-            STAmount liquidity;
-            uint64_t uQuality;
-            auto const resultCode = getPathLiquidity(
-                currentPath, saMinDstAmount, liquidity, uQuality);
-            if (resultCode != tesSUCCESS)
+            if (continueCallback && !continueCallback())
+                return;
+            if (auto r = rank(i, mDependencies))
+                rankedPaths.push_back(std::move(*r));
+        }
+    }
+    else
+    {
+        // Each path is checked against its own sandbox, so the paths can
+        // be ranked independently. The ranks are collected in path order,
+        // which keeps the result the same for any number of threads, and
+        // what each check read is kept apart until the threads are done.
+        std::vector<std::optional<PathRank>> ranks(paths.size());
+        std::vector<PathDependencies> deps(paths.size());
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> stopped{false};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+
+        auto const worker = [&]() {
+            try
             {
-                JLOG(j_.debug())
-                    << "findPaths: dropping : " << transToken(resultCode)
-                    << ": " << currentPath.getJson(JsonOptions::none);
+                for (auto i = next++; i < paths.size() && !stopped; i = next++)
+                {
+                    if (continueCallback && !continueCallback())
+                        stopped = true;
+                    else
+                        ranks[i] = rank(i, deps[i]);
+                }
             }
-            else
+            catch (...)
             {
-                JLOG(j_.debug()) << "findPaths: quality: " << uQuality << ": "
-                                 << currentPath.getJson(JsonOptions::none);
-
-                rankedPaths.push_back(
-                    {uQuality, currentPath.size(), liquidity, i});
+                std::lock_guard lock(errorMutex);
+                if (!error)
+                    error = std::current_exception();
+                stopped = true;
             }
+        };
+
+        std::vector<std::thread> workers;
+        auto const count = std::min(threads, paths.size());
+        workers.reserve(count - 1);
+        for (std::size_t i = 1; i < count; ++i)
+            workers.emplace_back(worker);
+        worker();
+
+        for (auto& w : workers)
+            w.join();
+
+        for (auto const& d : deps)
+            mDependencies.merge(d);
+
+        if (error)
+            std::rethrow_exception(error);
+
+        for (auto& r : ranks)
+        {
+            if (r)
+                rankedPaths.push_back(std::move(*r));
         }
+
+        if (stopped)
+            return;
     }
 
     // Sort paths by:
@@ -721,6 +797,8 @@ Pathfinder::getPathsOut(
     if (!inserted)
         return it->second;
 
+    mDependencies.accounts.insert(account);
+    mDependencies.books.insert(issue);
     auto sleAccount = mLedger->read(keylet::account(account));
 
     if (!sleAccount)
@@ -736,22 +814,32 @@ Pathfinder::getPathsOut(
     {
         count = app_.getOrderBookDB().getBookSize(issue);
 
-        if (auto const lines = mRLCache->getRippleLines(account, direction))
+        auto const index = mRLCache->getLineIndex(account, direction);
+        RippleLineCache::LineIndex::Out const* out = nullptr;
+        if (index)
+        {
+            if (auto const iter = index->out.find(currency);
+                iter != index->out.end())
+                out = &iter->second;
+        }
+
+        if (out && !isDstCurrency)
         {
-            for (auto const& rspEntry : *lines)
+            count += bAuthRequired ? out->authorized : out->rippling;
+        }
+        else if (out)
+        {
+            // A line to the destination counts extra, so look at each
+            for (auto const i : out->positions)
             {
-                if (currency != rspEntry.getLimit().getCurrency())
-                {
-                }
-                else if (
-                    rspEntry.getBalance() <= beast::zero &&
+                auto const& rspEntry = (*index->lines)[i];
+                if (rspEntry.getBalance() <= beast::zero &&
                     (!rspEntry.getLimitPeer() ||
                      -rspEntry.getBalance() >= rspEntry.getLimitPeer() ||
                      (bAuthRequired && !rspEntry.getAuth())))
                 {
                 }
-                else if (
-                    isDstCurrency && dstAccount == rspEntry.getAccountIDPeer())
+                else if (dstAccount == rspEntry.getAccountIDPeer())
                 {
                     count += 10000;  // count a path to the destination extra
                 }
@@ -887,6 +975,7 @@ Pathfinder::isNoRipple(
     AccountID const& toAccount,
     Currency const& currency)
 {
+    mDependencies.accounts.insert({fromAccount, toAccount});
     auto sleRipple =
         mLedger->read(keylet::line(toAccount, fromAccount, currency));
 
@@ -970,6 +1059,7 @@ Pathfinder::addLink(
         else
         {
             // search for accounts to add
+            mDependencies.accounts.insert(uEndAccount);
             auto const sleEnd = mLedger->read(keylet::account(uEndAccount));
 
             if (sleEnd)
@@ -1115,6 +1205,7 @@ Pathfinder::addLink(
     if (addFlags & afADD_BOOKS)
     {
         // add order books
+        mDependencies.books.insert({uEndCurrency, uEndIssuer});
         if (addFlags & afOB_XRP)
         {
             // to XRP only
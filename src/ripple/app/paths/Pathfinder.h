@@ -21,6 +21,7 @@
 #define RIPPLE_APP_PATHS_PATHFINDER_H_INCLUDED
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/paths/PathDependencies.h>
 #include <ripple/app/paths/RippleLineCache.h>
 #include <ripple/basics/CountedObject.h>
 #include <ripple/core/LoadEvent.h>
@@ -61,11 +62,16 @@ public:
         int searchLevel,
         std::function<bool(void)> const& continueCallback = {});
 
-    /** Compute the rankings of the paths. */
+    /** Compute the rankings of the paths.
+
+        @param threads The most threads to rank the paths with. The ranks
+                       are the same for any number of threads.
+    */
     void
     computePathRanks(
         int maxPaths,
-        std::function<bool(void)> const& continueCallback = {});
+        std::function<bool(void)> const& continueCallback = {},
+        std::size_t threads = 1);
 
     /* Get the best paths, up to maxPaths in number, from mCompletePaths.
 
@@ -80,6 +86,15 @@ public:
         AccountID const& srcIssuer,
         std::function<bool(void)> const& continueCallback = {});
 
+    /** The accounts and books the search looked at, and the entries read
+        while ranking the paths.
+    */
+    PathDependencies const&
+    dependencies() const
+    {
+        return mDependencies;
+    }
+
     enum NodeType {
         nt_SOURCE,     // The source account: with an issuer account, if needed.
         nt_ACCOUNTS,   // Accounts that connect from this source/currency.
@@ -171,6 +186,7 @@ private:
         STPath const& path,            // IN:  The path to check.
         STAmount const& minDstAmount,  // IN:  The minimum output this path must
                                        //      deliver to be worth keeping.
+        PathDependencies& deps,        // OUT: What the check read.
         STAmount& amountOut,           // OUT: The actual liquidity on the path.
         uint64_t& qualityOut) const;   // OUT: The returned initial quality
 
@@ -191,7 +207,8 @@ private:
         int maxPaths,
         STPathSet const& paths,
         std::vector<PathRank>& rankedPaths,
-        std::function<bool(void)> const& continueCallback);
+        std::function<bool(void)> const& continueCallback,
+        std::size_t threads = 1);
 
     AccountID mSrcAccount;
     AccountID mDstAccount;
@@ -215,6 +232,7 @@ private:
     std::map<PathType, STPathSet> mPaths;
 
     hash_map<Issue, int> mPathsOutCountMap;
+    PathDependencies mDependencies;
 
     Application& app_;
     beast::Journal const j_;
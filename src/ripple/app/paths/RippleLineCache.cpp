@@ -28,9 +28,59 @@ RippleLineCache::RippleLineCache(
     beast::Journal j)
     : ledger_(ledger), journal_(j)
 {
+    if (!ledger_->open())
+        changes_.emplace(*ledger_);
     JLOG(journal_.debug()) << "created for ledger " << ledger_->info().seq;
 }
 
+RippleLineCache::RippleLineCache(
+    std::shared_ptr<ReadView const> const& ledger,
+    RippleLineCache& previous,
+    beast::Journal j)
+    : hasher_(previous.hasher_), ledger_(ledger), journal_(j)
+{
+    if (!ledger_->open())
+        changes_.emplace(*ledger_);
+
+    if (!changes_ ||
+        ledger_->info().parentHash != previous.ledger_->info().hash)
+    {
+        JLOG(journal_.debug()) << "created for ledger " << ledger_->info().seq;
+        return;
+    }
+
+    // The lines are read only once built, so both caches can share them.
+    // The hasher is copied too, so the keys hash the same in both.
+    auto const& changed = changes_->lineAccounts();
+    std::size_t dropped = 0;
+    {
+        std::lock_guard sl(previous.mLock);
+        for (auto const& [key, lines] : previous.lines_)
+        {
+            if (changed.count(key.account_))
+            {
+                ++dropped;
+                continue;
+            }
+            lines_.emplace(key, lines);
+            if (lines)
+                totalLineCount_ += lines->size();
+        }
+        for (auto const& [key, index] : previous.indexes_)
+        {
+            if (!changed.count(key.account_))
+                indexes_.emplace(key, index);
+        }
+    }
+
+    JLOG(journal_.debug()) << "created for ledger " << ledger_->info().seq
+                           << " carrying " << lines_.size()
+                           << " accounts and " << totalLineCount_
+                           << " trust lines over from ledger "
+                           << previous.ledger_->info().seq << ", dropping "
+                           << dropped << " accounts";
+}
+
 RippleLineCache::~RippleLineCache()
 {
     JLOG(journal_.debug()) << "destroyed for ledger " << ledger_->info().seq
@@ -125,4 +175,55 @@ RippleLineCache::getRippleLines(
     return it->second;
 }
 
+std::shared_ptr<RippleLineCache::LineIndex const>
+RippleLineCache::getLineIndex(
+    AccountID const& accountID,
+    LineDirection direction)
+{
+    auto lines = getRippleLines(accountID, direction);
+    if (!lines)
+        return nullptr;
+
+    AccountKey const key(accountID, direction, hasher_(accountID));
+
+    std::lock_guard sl(mLock);
+
+    // The lines may have been replaced by a superset since the index
+    // was made, in which case it is made again.
+    if (auto const it = indexes_.find(key);
+        it != indexes_.end() && it->second->lines == lines)
+        return it->second;
+
+    auto index = std::make_shared<LineIndex>();
+    for (std::size_t i = 0; i < lines->size(); ++i)
+    {
+        auto const& line = (*lines)[i];
+        auto const& balance = line.getBalance();
+        auto const& currency = balance.getCurrency();
+
+        // Has IOUs to send, or the peer extends credit that is left
+        bool const canSend = balance > beast::zero ||
+            (line.getLimitPeer() && -balance < line.getLimitPeer());
+        if (canSend)
+            index->send.insert(currency);
+        if (balance < line.getLimit())
+            index->receive.insert(currency);
+
+        auto& out = index->out[currency];
+        out.positions.push_back(i);
+        if (canSend && !line.getNoRipplePeer() && !line.getFreezePeer())
+        {
+            ++out.rippling;
+            if (balance > beast::zero || line.getAuth())
+                ++out.authorized;
+        }
+    }
+    index->send.erase(badCurrency());
+    index->receive.erase(badCurrency());
+    index->lines = std::move(lines);
+
+    indexes_.insert_or_assign(key, index);
+    return index;
+}
+
 }  // namespace ripple
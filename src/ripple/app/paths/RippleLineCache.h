@@ -21,6 +21,7 @@
 #define RIPPLE_APP_PATHS_RIPPLELINECACHE_H_INCLUDED
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/paths/PathDependencies.h>
 #include <ripple/app/paths/TrustLine.h>
 #include <ripple/basics/CountedObject.h>
 #include <ripple/basics/hardened_hash.h>
@@ -28,6 +29,7 @@
 #include <cstddef>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 namespace ripple {
@@ -39,6 +41,19 @@ public:
     explicit RippleLineCache(
         std::shared_ptr<ReadView const> const& l,
         beast::Journal j);
+
+    /** Create a cache for the ledger that follows another cache's ledger.
+
+        The trust lines of every account whose lines the new ledger did not
+        touch are carried over from the other cache, so they are not read
+        again. Nothing is carried over unless the new ledger is closed and
+        builds directly on the other cache's ledger.
+    */
+    RippleLineCache(
+        std::shared_ptr<ReadView const> const& l,
+        RippleLineCache& previous,
+        beast::Journal j);
+
     ~RippleLineCache();
 
     std::shared_ptr<ReadView const> const&
@@ -47,6 +62,16 @@ public:
         return ledger_;
     }
 
+    /** What the ledger's transactions changed in its parent.
+
+        This is unseated for an open ledger.
+    */
+    std::optional<LedgerChanges> const&
+    changes() const
+    {
+        return changes_;
+    }
+
     /** Find the trust lines associated with an account.
 
        @param accountID The account
@@ -62,11 +87,49 @@ public:
     std::shared_ptr<std::vector<PathFindTrustLine>>
     getRippleLines(AccountID const& accountID, LineDirection direction);
 
+    /** What an account's trust lines allow, worked out from its lines once.
+     */
+    struct LineIndex
+    {
+        // The lines of one currency that lead out of the account
+        struct Out
+        {
+            // Lines with something to send that are neither frozen nor
+            // set to no ripple on the peer's side
+            int rippling = 0;
+            // Those of them the peer may use when the account requires
+            // authorization
+            int authorized = 0;
+            // Where all the lines of the currency are in `lines`
+            std::vector<std::size_t> positions;
+        };
+
+        // The lines the index was made from
+        std::shared_ptr<std::vector<PathFindTrustLine>> lines;
+
+        // The currencies the account can send or receive, without XRP
+        hash_set<Currency> send;
+        hash_set<Currency> receive;
+
+        hash_map<Currency, Out> out;
+    };
+
+    /** Find the index of the trust lines associated with an account.
+
+        The index is made from what getRippleLines returns for the same
+        arguments, and kept for as long as those lines are.
+
+        @return The index, or nullptr if the account has no usable lines.
+    */
+    std::shared_ptr<LineIndex const>
+    getLineIndex(AccountID const& accountID, LineDirection direction);
+
 private:
     std::mutex mLock;
 
     ripple::hardened_hash<> hasher_;
     std::shared_ptr<ReadView const> ledger_;
+    std::optional<LedgerChanges> changes_;
 
     beast::Journal journal_;
 
@@ -125,6 +188,9 @@ private:
         AccountKey::Hash>
         lines_;
     std::size_t totalLineCount_ = 0;
+
+    hash_map<AccountKey, std::shared_ptr<LineIndex const>, AccountKey::Hash>
+        indexes_;
 };
 
 }  // namespace ripple
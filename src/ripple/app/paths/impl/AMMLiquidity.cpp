@@ -129,6 +129,33 @@ AMMLiquidity<TIn, TOut>::getOffer(
 
     auto const balances = fetchBalances(view);
 
+    if (cachedOffer_ && cachedOffer_->balances == balances &&
+        cachedOffer_->clobQuality == clobQuality &&
+        cachedOffer_->iters == ammContext_.curIters() &&
+        cachedOffer_->multiPath == ammContext_.multiPath() &&
+        cachedOffer_->mode == Number::getround())
+    {
+        JLOG(j_.trace()) << "AMMLiquidity::getOffer, unchanged pool";
+        return cachedOffer_->offer;
+    }
+
+    auto offer = makeOffer(balances, clobQuality);
+    cachedOffer_.emplace(CachedOffer{
+        balances,
+        clobQuality,
+        ammContext_.curIters(),
+        ammContext_.multiPath(),
+        Number::getround(),
+        offer});
+    return offer;
+}
+
+template <typename TIn, typename TOut>
+std::optional<AMMOffer<TIn, TOut>>
+AMMLiquidity<TIn, TOut>::makeOffer(
+    TAmounts<TIn, TOut> const& balances,
+    std::optional<Quality> const& clobQuality) const
+{
     // Frozen accounts
     if (balances.in == beast::zero || balances.out == beast::zero)
     {
@@ -215,6 +242,21 @@ AMMLiquidity<TIn, TOut>::getOffer(
     return std::nullopt;
 }
 
+template <typename TIn, typename TOut>
+QualityFunction const&
+AMMLiquidity<TIn, TOut>::qualityFunc(TAmounts<TIn, TOut> const& balances) const
+{
+    if (!cachedQualityFunc_ || cachedQualityFunc_->balances != balances ||
+        cachedQualityFunc_->mode != Number::getround())
+    {
+        cachedQualityFunc_.emplace(CachedQualityFunc{
+            balances,
+            Number::getround(),
+            QualityFunction{balances, tradingFee_, QualityFunction::AMMTag{}}});
+    }
+    return cachedQualityFunc_->qf;
+}
+
 template class AMMLiquidity<STAmount, STAmount>;
 template class AMMLiquidity<IOUAmount, IOUAmount>;
 template class AMMLiquidity<XRPAmount, IOUAmount>;
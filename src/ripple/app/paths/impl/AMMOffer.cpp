@@ -131,8 +131,7 @@ AMMOffer<TIn, TOut>::getQualityFunc() const
 {
     if (ammLiquidity_.multiPath())
         return QualityFunction{quality(), QualityFunction::CLOBLikeTag{}};
-    return QualityFunction{
-        *balances_, ammLiquidity_.tradingFee(), QualityFunction::AMMTag{}};
+    return ammLiquidity_.qualityFunc(*balances_);
 }
 
 template class AMMOffer<STAmount, STAmount>;
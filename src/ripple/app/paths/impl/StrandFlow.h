@@ -422,6 +422,13 @@ private:
     std::vector<Strand const*> cur_;
     // Strands that may be explored for liquidity on the next iteration
     std::vector<Strand const*> next_;
+    // The quality upper bounds of the strands in `cur_`, if they were worked
+    // out to sort them. The view does not change until the best liquidity
+    // of the iteration is used, so they hold for the rest of the iteration.
+    std::vector<Quality> curQuals_;
+    // The AMM offers depend on whether the payment has several paths, which
+    // may change once the strands are sorted
+    bool curMultiPath_ = false;
 
 public:
     ActiveStrands(std::vector<Strand> const& strands)
@@ -435,11 +442,16 @@ public:
     // Start a new iteration in the search for liquidity
     // Set the current strands to the strands in `next_`
     void
-    activateNext(ReadView const& v, std::optional<Quality> const& limitQuality)
+    activateNext(
+        ReadView const& v,
+        std::optional<Quality> const& limitQuality,
+        AMMContext const& ammContext)
     {
         // add the strands in `next_` to `cur_`, sorted by theoretical quality.
         // Best quality first.
         cur_.clear();
+        curQuals_.clear();
+        curMultiPath_ = ammContext.multiPath();
         if (v.rules().enabled(featureFlowSortStrands) && !next_.empty())
         {
             std::vector<std::pair<Quality, Strand const*>> strandQuals;
@@ -479,9 +491,11 @@ public:
                     });
                 next_.clear();
                 next_.reserve(strandQuals.size());
+                curQuals_.reserve(strandQuals.size());
                 for (auto const& sq : strandQuals)
                 {
                     next_.push_back(std::get<Strand const*>(sq));
+                    curQuals_.push_back(std::get<Quality>(sq));
                 }
             }
         }
@@ -499,6 +513,21 @@ public:
         return cur_[i];
     }
 
+    // The quality upper bound of the strand at index i of `cur_`. The bound
+    // found while sorting is used if the view has not changed since.
+    std::optional<Quality>
+    curQualityUpperBound(
+        ReadView const& v,
+        size_t i,
+        AMMContext const& ammContext) const
+    {
+        if (i < curQuals_.size() && curMultiPath_ == ammContext.multiPath())
+            return curQuals_[i];
+        if (auto const strand = get(i))
+            return qualityUpperBound(v, *strand);
+        return std::nullopt;
+    }
+
     void
     push(Strand const* s)
     {
@@ -643,7 +672,7 @@ flow(
             return {telFAILED_PROCESSING, std::move(ofrsToRmOnFail)};
         }
 
-        activeStrands.activateNext(sb, limitQuality);
+        activeStrands.activateNext(sb, limitQuality, ammContext);
 
         ammContext.setMultiPath(activeStrands.size() > 1);
 
@@ -681,7 +710,8 @@ flow(
             ammContext.clear();
             if (offerCrossing && limitQuality)
             {
-                auto const strandQ = qualityUpperBound(sb, *strand);
+                auto const strandQ = activeStrands.curQualityUpperBound(
+                    sb, strandIndex, ammContext);
                 if (!strandQ || *strandQ < *limitQuality)
                     continue;
             }
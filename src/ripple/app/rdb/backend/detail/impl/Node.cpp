@@ -27,12 +27,15 @@
 #include <ripple/app/rdb/backend/detail/Node.h>
 #include <ripple/basics/BasicConfig.h>
 #include <ripple/basics/StringUtilities.h>
+#include <ripple/basics/contract.h>
 #include <ripple/core/DatabaseCon.h>
 #include <ripple/core/SociDB.h>
 #include <ripple/json/to_string.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <soci/sqlite3/soci-sqlite3.h>
+#include <chrono>
+#include <string_view>
 
 namespace ripple {
 namespace detail {
@@ -78,9 +81,20 @@ makeLedgerDBs(
 
     if (config.useTxTables())
     {
-        // transaction database
+        // transaction database, with connections of its own for the
+        // queries that only read
+        auto txSetup = setup;
+        txSetup.readConnections = 4;
+        set(txSetup.readConnections,
+            "read_connections",
+            config.section("sqlite"));
+        if (txSetup.readConnections > 64)
+            Throw<std::runtime_error>(
+                "Invalid read_connections value: " +
+                std::to_string(txSetup.readConnections));
+
         auto tx{std::make_unique<DatabaseCon>(
-            setup, TxDBName, TxDBPragma, TxDBInit, checkpointerSetup)};
+            txSetup, TxDBName, TxDBPragma, TxDBInit, checkpointerSetup)};
         tx->getSession() << boost::str(
             boost::format("PRAGMA cache_size=-%d;") %
             kilobytes(config.getValueFor(SizedItem::txnDBCache)));
@@ -183,6 +197,61 @@ getRowsMinMax(soci::session& session, TableType type)
     return res;
 }
 
+/**
+ * @brief MultiRowStatement Accumulates rows into one multi-row SQL
+ *        statement, which is run whenever it grows past a size bound and
+ *        once more when flushed, instead of one statement per row.
+ */
+class MultiRowStatement
+{
+    static constexpr std::size_t maxBytes = 1 << 20;
+
+    soci::session& session_;
+    std::string const head_;
+    char const* const tail_;
+    std::string sql_;
+
+public:
+    /**
+     * @param session Session to run the statements with.
+     * @param head Text preceding the rows, such as "INSERT ... VALUES ".
+     * @param tail Text following the rows.
+     */
+    MultiRowStatement(
+        soci::session& session,
+        std::string head,
+        char const* tail = ";")
+        : session_(session), head_(std::move(head)), tail_(tail)
+    {
+    }
+
+    MultiRowStatement(MultiRowStatement const&) = delete;
+    MultiRowStatement&
+    operator=(MultiRowStatement const&) = delete;
+
+    void
+    add(std::string_view row)
+    {
+        if (sql_.empty())
+            sql_ = head_;
+        else
+            sql_ += ", ";
+        sql_ += row;
+        if (sql_.size() >= maxBytes)
+            flush();
+    }
+
+    void
+    flush()
+    {
+        if (sql_.empty())
+            return;
+        sql_ += tail_;
+        session_ << sql_;
+        sql_.clear();
+    }
+};
+
 bool
 saveValidatedLedger(
     DatabaseCon& ldgDB,
@@ -252,9 +321,6 @@ saveValidatedLedger(
             "DELETE FROM Transactions WHERE LedgerSeq = %u;");
         static boost::format deleteTrans2(
             "DELETE FROM AccountTransactions WHERE LedgerSeq = %u;");
-        static boost::format deleteAcctTrans(
-            "DELETE FROM AccountTransactions WHERE TransID = '%s';");
-
         {
             auto db = ldgDB.checkoutDb();
             *db << boost::str(deleteLedger % seq);
@@ -269,8 +335,33 @@ saveValidatedLedger(
             *db << boost::str(deleteTrans1 % seq);
             *db << boost::str(deleteTrans2 % seq);
 
+            static std::string const deleteAcctTrans(
+                "DELETE FROM AccountTransactions WHERE TransID IN (");
+            static std::string const insertAcctTrans(
+                "INSERT INTO AccountTransactions "
+                "(TransID, Account, LedgerSeq, TxnSeq) VALUES ");
+
+            auto const start = std::chrono::steady_clock::now();
             std::string const ledgerSeq(std::to_string(seq));
 
+            // The rows of every transaction in the ledger go out in a few
+            // multi-row statements. All of the stale account rows must be
+            // gone before any new ones are inserted.
+            {
+                MultiRowStatement deletes(*db, deleteAcctTrans, ");");
+                for (auto const& acceptedLedgerTx : *aLedger)
+                {
+                    deletes.add(
+                        "'" + to_string(acceptedLedgerTx->getTransactionID()) +
+                        "'");
+                }
+                deletes.flush();
+            }
+
+            MultiRowStatement accountRows(*db, insertAcctTrans);
+            MultiRowStatement txRows(
+                *db, STTx::getMetaSQLInsertReplaceHeader());
+            std::string row;
             for (auto const& acceptedLedgerTx : *aLedger)
             {
                 uint256 transactionID = acceptedLedgerTx->getTransactionID();
@@ -279,44 +370,23 @@ saveValidatedLedger(
                 std::string const txnSeq(
                     std::to_string(acceptedLedgerTx->getTxnSeq()));
 
-                *db << boost::str(deleteAcctTrans % transactionID);
-
                 auto const& accts = acceptedLedgerTx->getAffected();
 
                 if (!accts.empty())
                 {
-                    std::string sql(
-                        "INSERT INTO AccountTransactions "
-                        "(TransID, Account, LedgerSeq, TxnSeq) VALUES ");
-
-                    // Try to make an educated guess on how much space we'll
-                    // need for our arguments. In argument order we have: 64
-                    // + 34 + 10 + 10 = 118 + 10 extra = 128 bytes
-                    sql.reserve(sql.length() + (accts.size() * 128));
-
-                    bool first = true;
                     for (auto const& account : accts)
                     {
-                        if (!first)
-                            sql += ", ('";
-                        else
-                        {
-                            sql += "('";
-                            first = false;
-                        }
-
-                        sql += txnId;
-                        sql += "','";
-                        sql += toBase58(account);
-                        sql += "',";
-                        sql += ledgerSeq;
-                        sql += ",";
-                        sql += txnSeq;
-                        sql += ")";
+                        row = "('";
+                        row += txnId;
+                        row += "','";
+                        row += toBase58(account);
+                        row += "',";
+                        row += ledgerSeq;
+                        row += ",";
+                        row += txnSeq;
+                        row += ")";
+                        accountRows.add(row);
                     }
-                    sql += ";";
-                    JLOG(j.trace()) << "ActTx: " << sql;
-                    *db << sql;
                 }
                 else if (auto const& sleTxn = acceptedLedgerTx->getTxn();
                          !isPseudoTx(*sleTxn))
@@ -328,16 +398,23 @@ saveValidatedLedger(
                     JLOG(j.warn()) << sleTxn->getJson(JsonOptions::none);
                 }
 
-                *db
-                    << (STTx::getMetaSQLInsertReplaceHeader() +
-                        acceptedLedgerTx->getTxn()->getMetaSQL(
-                            seq, acceptedLedgerTx->getEscMeta()) +
-                        ";");
+                txRows.add(acceptedLedgerTx->getTxn()->getMetaSQL(
+                    seq, acceptedLedgerTx->getEscMeta()));
 
                 app.getMasterTransaction().inLedger(transactionID, seq);
             }
+            accountRows.flush();
+            txRows.flush();
 
             tr.commit();
+
+            JLOG(j.debug())
+                << "Saved " << aLedger->size() << " transactions of ledger "
+                << seq << " in "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count()
+                << "ms";
         }
 
         {
@@ -383,38 +460,33 @@ saveValidatedLedger(
  * @brief getLedgerInfo Returns the info of the ledger retrieved from the
  *        database by using the provided SQL query suffix.
  * @param session Session with the database.
- * @param sqlSuffix SQL string used to specify the sought ledger.
+ * @param sqlSuffix SQL string used to specify the sought ledger, with a
+ *        single parameter.
+ * @param bind Callback binding the parameter of the query, if any.
  * @param j Journal.
  * @return Ledger info or no value if the ledger was not found.
  */
+template <class Bind>
 static std::optional<LedgerInfo>
 getLedgerInfo(
     soci::session& session,
     std::string const& sqlSuffix,
+    Bind const& bind,
     beast::Journal j)
 {
-    // SOCI requires boost::optional (not std::optional) as parameters.
-    boost::optional<std::string> hash, parentHash, accountHash, txHash;
-    boost::optional<std::uint64_t> seq, drops, closeTime, parentCloseTime,
-        closeTimeResolution, closeFlags;
-
-    std::string const sql =
+    CachedStatement st(
+        session,
         "SELECT "
         "LedgerHash, PrevHash, AccountSetHash, TransSetHash, "
         "TotalCoins,"
         "ClosingTime, PrevClosingTime, CloseTimeRes, CloseFlags,"
         "LedgerSeq FROM Ledgers " +
-        sqlSuffix + ";";
-
-    session << sql, soci::into(hash), soci::into(parentHash),
-        soci::into(accountHash), soci::into(txHash), soci::into(drops),
-        soci::into(closeTime), soci::into(parentCloseTime),
-        soci::into(closeTimeResolution), soci::into(closeFlags),
-        soci::into(seq);
+            sqlSuffix + ";");
+    bind(st);
 
-    if (!session.got_data())
+    if (!st.step())
     {
-        JLOG(j.debug()) << "Ledger not found: " << sqlSuffix;
+        JLOG(j.debug()) << "Ledger not found: " << st.sql();
         return {};
     }
 
@@ -423,36 +495,32 @@ getLedgerInfo(
 
     LedgerInfo info;
 
-    if (hash && !info.hash.parseHex(*hash))
-    {
-        JLOG(j.debug()) << "Hash parse error for ledger: " << sqlSuffix;
-        return {};
-    }
-
-    if (parentHash && !info.parentHash.parseHex(*parentHash))
-    {
-        JLOG(j.debug()) << "parentHash parse error for ledger: " << sqlSuffix;
-        return {};
-    }
+    auto const parse = [&](int column, uint256& to, char const* name) {
+        auto const hash = st.getText(column);
+        if (hash && !to.parseHex(*hash))
+        {
+            JLOG(j.debug()) << name << " parse error for ledger: " << st.sql();
+            return false;
+        }
+        return true;
+    };
 
-    if (accountHash && !info.accountHash.parseHex(*accountHash))
-    {
-        JLOG(j.debug()) << "accountHash parse error for ledger: " << sqlSuffix;
+    if (!parse(0, info.hash, "Hash") ||
+        !parse(1, info.parentHash, "parentHash") ||
+        !parse(2, info.accountHash, "accountHash") ||
+        !parse(3, info.txHash, "txHash"))
         return {};
-    }
 
-    if (txHash && !info.txHash.parseHex(*txHash))
-    {
-        JLOG(j.debug()) << "txHash parse error for ledger: " << sqlSuffix;
-        return {};
-    }
+    auto const column = [&](int index) {
+        return static_cast<std::uint64_t>(st.getInt(index).value_or(0));
+    };
 
-    info.seq = rangeCheckedCast<std::uint32_t>(seq.value_or(0));
-    info.drops = drops.value_or(0);
-    info.closeTime = time_point{duration{closeTime.value_or(0)}};
-    info.parentCloseTime = time_point{duration{parentCloseTime.value_or(0)}};
-    info.closeFlags = closeFlags.value_or(0);
-    info.closeTimeResolution = duration{closeTimeResolution.value_or(0)};
+    info.seq = rangeCheckedCast<std::uint32_t>(column(9));
+    info.drops = column(4);
+    info.closeTime = time_point{duration{column(5)}};
+    info.parentCloseTime = time_point{duration{column(6)}};
+    info.closeFlags = column(8);
+    info.closeTimeResolution = duration{column(7)};
 
     return info;
 }
@@ -463,17 +531,21 @@ getLedgerInfoByIndex(
     LedgerIndex ledgerSeq,
     beast::Journal j)
 {
-    std::ostringstream s;
-    s << "WHERE LedgerSeq = " << ledgerSeq;
-    return getLedgerInfo(session, s.str(), j);
+    return getLedgerInfo(
+        session,
+        "WHERE LedgerSeq = ?",
+        [&](CachedStatement& st) { st.bind(1, ledgerSeq); },
+        j);
 }
 
 std::optional<LedgerInfo>
 getNewestLedgerInfo(soci::session& session, beast::Journal j)
 {
-    std::ostringstream s;
-    s << "ORDER BY LedgerSeq DESC LIMIT 1";
-    return getLedgerInfo(session, s.str(), j);
+    return getLedgerInfo(
+        session,
+        "ORDER BY LedgerSeq DESC LIMIT 1",
+        [](CachedStatement&) {},
+        j);
 }
 
 std::optional<LedgerInfo>
@@ -482,10 +554,11 @@ getLimitedOldestLedgerInfo(
     LedgerIndex ledgerFirstIndex,
     beast::Journal j)
 {
-    std::ostringstream s;
-    s << "WHERE LedgerSeq >= " + std::to_string(ledgerFirstIndex) +
-            " ORDER BY LedgerSeq ASC LIMIT 1";
-    return getLedgerInfo(session, s.str(), j);
+    return getLedgerInfo(
+        session,
+        "WHERE LedgerSeq >= ? ORDER BY LedgerSeq ASC LIMIT 1",
+        [&](CachedStatement& st) { st.bind(1, ledgerFirstIndex); },
+        j);
 }
 
 std::optional<LedgerInfo>
@@ -494,10 +567,11 @@ getLimitedNewestLedgerInfo(
     LedgerIndex ledgerFirstIndex,
     beast::Journal j)
 {
-    std::ostringstream s;
-    s << "WHERE LedgerSeq >= " + std::to_string(ledgerFirstIndex) +
-            " ORDER BY LedgerSeq DESC LIMIT 1";
-    return getLedgerInfo(session, s.str(), j);
+    return getLedgerInfo(
+        session,
+        "WHERE LedgerSeq >= ? ORDER BY LedgerSeq DESC LIMIT 1",
+        [&](CachedStatement& st) { st.bind(1, ledgerFirstIndex); },
+        j);
 }
 
 std::optional<LedgerInfo>
@@ -506,9 +580,11 @@ getLedgerInfoByHash(
     uint256 const& ledgerHash,
     beast::Journal j)
 {
-    std::ostringstream s;
-    s << "WHERE LedgerHash = '" << ledgerHash << "'";
-    return getLedgerInfo(session, s.str(), j);
+    return getLedgerInfo(
+        session,
+        "WHERE LedgerHash = ?",
+        [&](CachedStatement& st) { st.bind(1, to_string(ledgerHash)); },
+        j);
 }
 
 uint256
@@ -516,26 +592,20 @@ getHashByIndex(soci::session& session, LedgerIndex ledgerIndex)
 {
     uint256 ret;
 
-    std::string sql =
-        "SELECT LedgerHash FROM Ledgers INDEXED BY SeqLedger WHERE LedgerSeq='";
-    sql.append(std::to_string(ledgerIndex));
-    sql.append("';");
-
-    std::string hash;
-    {
-        // SOCI requires boost::optional (not std::optional) as the parameter.
-        boost::optional<std::string> lh;
-        session << sql, soci::into(lh);
+    CachedStatement st(
+        session,
+        "SELECT LedgerHash FROM Ledgers INDEXED BY SeqLedger "
+        "WHERE LedgerSeq = ?;");
+    st.bind(1, ledgerIndex);
 
-        if (!session.got_data() || !lh)
-            return ret;
+    if (!st.step())
+        return ret;
 
-        hash = *lh;
-        if (hash.empty())
-            return ret;
-    }
+    auto const hash = st.getText(0);
+    if (!hash || hash->empty())
+        return ret;
 
-    if (!ret.parseHex(hash))
+    if (!ret.parseHex(*hash))
         return ret;
 
     return ret;
@@ -547,12 +617,18 @@ getHashesByIndex(
     LedgerIndex ledgerIndex,
     beast::Journal j)
 {
-    // SOCI requires boost::optional (not std::optional) as the parameter.
-    boost::optional<std::string> lhO, phO;
+    CachedStatement st(
+        session,
+        "SELECT LedgerHash,PrevHash FROM Ledgers "
+        "INDEXED BY SeqLedger WHERE LedgerSeq = ?;");
+    st.bind(1, ledgerIndex);
 
-    session << "SELECT LedgerHash,PrevHash FROM Ledgers "
-               "INDEXED BY SeqLedger WHERE LedgerSeq = :ls;",
-        soci::into(lhO), soci::into(phO), soci::use(ledgerIndex);
+    std::optional<std::string> lhO, phO;
+    if (st.step())
+    {
+        lhO = st.getText(0);
+        phO = st.getText(1);
+    }
 
     if (!lhO || !phO)
     {
@@ -625,36 +701,31 @@ getTxHistory(
     int quantity,
     bool count)
 {
-    std::string sql = boost::str(
-        boost::format(
-            "SELECT LedgerSeq, Status, RawTxn "
-            "FROM Transactions ORDER BY LedgerSeq DESC LIMIT %u,%u;") %
-        startIndex % quantity);
-
     std::vector<std::shared_ptr<Transaction>> txs;
     int total = 0;
 
     {
-        // SOCI requires boost::optional (not std::optional) as parameters.
+        CachedStatement st(
+            session,
+            "SELECT LedgerSeq, Status, RawTxn "
+            "FROM Transactions ORDER BY LedgerSeq DESC LIMIT ?,?;");
+        st.bind(1, startIndex);
+        st.bind(2, quantity);
+
+        // transactionFromSQL takes boost::optional (not std::optional).
         boost::optional<std::uint64_t> ledgerSeq;
         boost::optional<std::string> status;
-        soci::blob sociRawTxnBlob(session);
-        soci::indicator rti;
         Blob rawTxn;
 
-        soci::statement st =
-            (session.prepare << sql,
-             soci::into(ledgerSeq),
-             soci::into(status),
-             soci::into(sociRawTxnBlob, rti));
-
-        st.execute();
-        while (st.fetch())
+        while (st.step())
         {
-            if (soci::i_ok == rti)
-                convert(sociRawTxnBlob, rawTxn);
-            else
-                rawTxn.clear();
+            ledgerSeq = boost::none;
+            if (auto const seq = st.getInt(0))
+                ledgerSeq = static_cast<std::uint64_t>(*seq);
+            status = boost::none;
+            if (auto text = st.getText(1))
+                status = std::move(*text);
+            st.getBlob(2, rawTxn);
 
             if (auto trans = Transaction::transactionFromSQL(
                     ledgerSeq, status, rawTxn, app))
@@ -1107,89 +1178,71 @@ accountTxPage(
     if (limit_used > 0)
         newmarker = options.marker;
 
-    static std::string const prefix(
-        R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
-          Status,RawTxn,TxnMeta
-          FROM AccountTransactions INNER JOIN Transactions
-          ON Transactions.TransID = AccountTransactions.TransID
-          AND AccountTransactions.Account = '%s' WHERE
-          )");
-
-    std::string sql;
-
+    // The page is found by seeking into the AcctTxIndex index, which
+    // covers (Account, LedgerSeq, TxnSeq, TransID), from the marker. Only
+    // the rows of the page are then joined against Transactions to load
+    // their blobs, so a page costs the same however deep into the history
+    // of the account it is.
+    //
     // SQL's BETWEEN uses a closed interval ([a,b])
-
-    const char* const order = forward ? "ASC" : "DESC";
-
-    if (findLedger == 0)
+    static std::string const queries[] = {
+        R"(SELECT Page.LedgerSeq,Page.TxnSeq,Status,RawTxn,TxnMeta
+          FROM (SELECT TransID,LedgerSeq,TxnSeq
+            FROM AccountTransactions INDEXED BY AcctTxIndex
+            WHERE Account = ?1 AND LedgerSeq BETWEEN ?2 AND ?3
+            AND (LedgerSeq, TxnSeq) <= (?4, ?5)
+            ORDER BY LedgerSeq DESC, TxnSeq DESC
+            LIMIT ?6) AS Page
+          INNER JOIN Transactions ON Transactions.TransID = Page.TransID
+          ORDER BY Page.LedgerSeq DESC, Page.TxnSeq DESC;)",
+        R"(SELECT Page.LedgerSeq,Page.TxnSeq,Status,RawTxn,TxnMeta
+          FROM (SELECT TransID,LedgerSeq,TxnSeq
+            FROM AccountTransactions INDEXED BY AcctTxIndex
+            WHERE Account = ?1 AND LedgerSeq BETWEEN ?2 AND ?3
+            AND (LedgerSeq, TxnSeq) >= (?4, ?5)
+            ORDER BY LedgerSeq ASC, TxnSeq ASC
+            LIMIT ?6) AS Page
+          INNER JOIN Transactions ON Transactions.TransID = Page.TransID
+          ORDER BY Page.LedgerSeq ASC, Page.TxnSeq ASC;)"};
+
+    // Without a marker, the row comparison admits the whole range
+    std::uint32_t minLedger = options.minLedger;
+    std::uint32_t maxLedger = options.maxLedger;
+    std::uint32_t seekLedger = forward ? 0 : maxLedger;
+    std::uint32_t seekSeq =
+        forward ? 0 : std::numeric_limits<std::uint32_t>::max();
+    if (findLedger != 0)
     {
-        sql = boost::str(
-            boost::format(
-                prefix + (R"(AccountTransactions.LedgerSeq BETWEEN '%u' AND '%u'
-             ORDER BY AccountTransactions.LedgerSeq %s,
-             AccountTransactions.TxnSeq %s
-             LIMIT %u;)")) %
-            toBase58(options.account) % options.minLedger % options.maxLedger %
-            order % order % queryLimit);
-    }
-    else
-    {
-        const char* const compare = forward ? ">=" : "<=";
-        const std::uint32_t minLedger =
-            forward ? findLedger + 1 : options.minLedger;
-        const std::uint32_t maxLedger =
-            forward ? options.maxLedger : findLedger - 1;
-
-        auto b58acct = toBase58(options.account);
-        sql = boost::str(
-            boost::format((
-                R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
-            Status,RawTxn,TxnMeta
-            FROM AccountTransactions, Transactions WHERE
-            (AccountTransactions.TransID = Transactions.TransID AND
-            AccountTransactions.Account = '%s' AND
-            AccountTransactions.LedgerSeq BETWEEN '%u' AND '%u')
-            OR
-            (AccountTransactions.TransID = Transactions.TransID AND
-            AccountTransactions.Account = '%s' AND
-            AccountTransactions.LedgerSeq = '%u' AND
-            AccountTransactions.TxnSeq %s '%u')
-            ORDER BY AccountTransactions.LedgerSeq %s,
-            AccountTransactions.TxnSeq %s
-            LIMIT %u;
-            )")) %
-            b58acct % minLedger % maxLedger % b58acct % findLedger % compare %
-            findSeq % order % order % queryLimit);
+        if (forward)
+            minLedger = findLedger;
+        else
+            maxLedger = findLedger;
+        seekLedger = findLedger;
+        seekSeq = findSeq;
     }
 
     {
         Blob rawData;
         Blob rawMeta;
 
-        // SOCI requires boost::optional (not std::optional) as parameters.
-        boost::optional<std::uint64_t> ledgerSeq;
-        boost::optional<std::uint32_t> txnSeq;
-        boost::optional<std::string> status;
-        soci::blob txnData(session);
-        soci::blob txnMeta(session);
-        soci::indicator dataPresent, metaPresent;
-
-        soci::statement st =
-            (session.prepare << sql,
-             soci::into(ledgerSeq),
-             soci::into(txnSeq),
-             soci::into(status),
-             soci::into(txnData, dataPresent),
-             soci::into(txnMeta, metaPresent));
-
-        st.execute();
+        CachedStatement st(session, queries[forward]);
+        st.bind(1, toBase58(options.account));
+        st.bind(2, minLedger);
+        st.bind(3, maxLedger);
+        st.bind(4, seekLedger);
+        st.bind(5, seekSeq);
+        st.bind(6, queryLimit);
 
-        while (st.fetch())
+        while (st.step())
         {
+            auto const ledgerSeq =
+                rangeCheckedCast<std::uint32_t>(st.getInt(0).value_or(0));
+            auto const txnSeq =
+                rangeCheckedCast<std::uint32_t>(st.getInt(1).value_or(0));
+
             if (lookingForMarker)
             {
-                if (findLedger == ledgerSeq.value_or(0) &&
-                    findSeq == txnSeq.value_or(0))
+                if (findLedger == ledgerSeq && findSeq == txnSeq)
                 {
                     lookingForMarker = false;
                 }
@@ -1198,37 +1251,29 @@ accountTxPage(
             }
             else if (numberOfResults == 0)
             {
-                newmarker = {
-                    rangeCheckedCast<std::uint32_t>(ledgerSeq.value_or(0)),
-                    txnSeq.value_or(0)};
+                newmarker = {ledgerSeq, txnSeq};
                 break;
             }
 
-            if (dataPresent == soci::i_ok)
-                convert(txnData, rawData);
-            else
-                rawData.clear();
-
-            if (metaPresent == soci::i_ok)
-                convert(txnMeta, rawMeta);
-            else
-                rawMeta.clear();
+            auto const status = st.getText(2);
+            st.getBlob(3, rawData);
+            st.getBlob(4, rawMeta);
 
             // Work around a bug that could leave the metadata missing
             if (rawMeta.size() == 0)
-                onUnsavedLedger(ledgerSeq.value_or(0));
+                onUnsavedLedger(ledgerSeq);
 
             // `rawData` and `rawMeta` will be used after they are moved.
             // That's OK.
             onTransaction(
-                rangeCheckedCast<std::uint32_t>(ledgerSeq.value_or(0)),
-                *status,
+                ledgerSeq,
+                status.value_or(""),
                 std::move(rawData),
                 std::move(rawMeta));
             // Note some callbacks will move the data, some will not. Clear
             // them so code doesn't depend on if the data was actually moved
             // or not. The code will be more efficient if `rawData` and
-            // `rawMeta` don't have to allocate in `convert`, so don't
+            // `rawMeta` don't have to allocate in `getBlob`, so don't
             // refactor my moving these variables into loop scope.
             rawData.clear();
             rawMeta.clear();
@@ -1291,50 +1336,48 @@ getTransaction(
     std::optional<ClosedInterval<uint32_t>> const& range,
     error_code_i& ec)
 {
-    std::string sql =
-        "SELECT LedgerSeq,Status,RawTxn,TxnMeta "
-        "FROM Transactions WHERE TransID='";
-
-    sql.append(to_string(id));
-    sql.append("';");
-
-    // SOCI requires boost::optional (not std::optional) as parameters.
+    // transactionFromSQL takes boost::optional (not std::optional).
     boost::optional<std::uint64_t> ledgerSeq;
     boost::optional<std::string> status;
     Blob rawTxn, rawMeta;
     {
-        soci::blob sociRawTxnBlob(session), sociRawMetaBlob(session);
-        soci::indicator txn, meta;
+        CachedStatement st(
+            session,
+            "SELECT LedgerSeq,Status,RawTxn,TxnMeta "
+            "FROM Transactions WHERE TransID = ?;");
+        st.bind(1, to_string(id));
 
-        session << sql, soci::into(ledgerSeq), soci::into(status),
-            soci::into(sociRawTxnBlob, txn), soci::into(sociRawMetaBlob, meta);
+        auto const got_data = st.step();
+        bool const txn = got_data && st.getBlob(2, rawTxn);
+        bool const meta = got_data && st.getBlob(3, rawMeta);
 
-        auto const got_data = session.got_data();
-
-        if ((!got_data || txn != soci::i_ok || meta != soci::i_ok) && !range)
+        if ((!got_data || !txn || !meta) && !range)
             return TxSearched::unknown;
 
         if (!got_data)
         {
-            uint64_t count = 0;
-            soci::indicator rti;
-
-            session
-                << "SELECT COUNT(DISTINCT LedgerSeq) FROM Transactions WHERE "
-                   "LedgerSeq BETWEEN "
-                << range->first() << " AND " << range->last() << ";",
-                soci::into(count, rti);
-
-            if (!session.got_data() || rti != soci::i_ok)
+            CachedStatement count(
+                session,
+                "SELECT COUNT(DISTINCT LedgerSeq) FROM Transactions WHERE "
+                "LedgerSeq BETWEEN ? AND ?;");
+            count.bind(1, range->first());
+            count.bind(2, range->last());
+
+            std::optional<std::int64_t> n;
+            if (count.step())
+                n = count.getInt(0);
+            if (!n)
                 return TxSearched::some;
 
-            return count == (range->last() - range->first() + 1)
+            return *n == (range->last() - range->first() + 1)
                 ? TxSearched::all
                 : TxSearched::some;
         }
 
-        convert(sociRawTxnBlob, rawTxn);
-        convert(sociRawMetaBlob, rawMeta);
+        if (auto const seq = st.getInt(0))
+            ledgerSeq = static_cast<std::uint64_t>(*seq);
+        if (auto text = st.getText(1))
+            status = std::move(*text);
     }
 
     try
@@ -567,32 +567,53 @@ PostgresDatabaseImp::writeLedgerAndTransactions(
             return false;
         }
 
-        std::stringstream transactionsCopyBuffer;
-        std::stringstream accountTransactionsCopyBuffer;
-        for (auto const& data : accountTxData)
-        {
-            std::string txHash = strHex(data.txHash);
-            std::string nodestoreHash = strHex(data.nodestoreHash);
-            auto idx = data.transactionIndex;
-            auto ledgerSeq = data.ledgerSequence;
-
-            transactionsCopyBuffer << std::to_string(ledgerSeq) << '\t'
-                                   << std::to_string(idx) << '\t' << "\\\\x"
-                                   << txHash << '\t' << "\\\\x" << nodestoreHash
-                                   << '\n';
-
-            for (auto const& a : data.accounts)
+        // Rows are formatted and sent in chunks of about this many bytes,
+        // so a large ledger is never held in memory as one COPY buffer.
+        constexpr std::size_t copyChunkBytes = 256 * 1024;
+        std::string chunk;
+        chunk.reserve(copyChunkBytes + 1024);
+
+        auto txIt = accountTxData.begin();
+        pg.bulkInsert("transactions", [&](std::string_view& out) {
+            chunk.clear();
+            for (; txIt != accountTxData.end() && chunk.size() < copyChunkBytes;
+                 ++txIt)
             {
-                std::string acct = strHex(a);
-                accountTransactionsCopyBuffer
-                    << "\\\\x" << acct << '\t' << std::to_string(ledgerSeq)
-                    << '\t' << std::to_string(idx) << '\n';
+                chunk += std::to_string(txIt->ledgerSequence);
+                chunk += '\t';
+                chunk += std::to_string(txIt->transactionIndex);
+                chunk += "\t\\\\x";
+                chunk += strHex(txIt->txHash);
+                chunk += "\t\\\\x";
+                chunk += strHex(txIt->nodestoreHash);
+                chunk += '\n';
             }
-        }
-
-        pg.bulkInsert("transactions", transactionsCopyBuffer.str());
-        pg.bulkInsert(
-            "account_transactions", accountTransactionsCopyBuffer.str());
+            out = chunk;
+            return !chunk.empty();
+        });
+
+        txIt = accountTxData.begin();
+        pg.bulkInsert("account_transactions", [&](std::string_view& out) {
+            chunk.clear();
+            for (; txIt != accountTxData.end() && chunk.size() < copyChunkBytes;
+                 ++txIt)
+            {
+                auto const seq = std::to_string(txIt->ledgerSequence);
+                auto const idx = std::to_string(txIt->transactionIndex);
+                for (auto const& a : txIt->accounts)
+                {
+                    chunk += "\\\\x";
+                    chunk += strHex(a);
+                    chunk += '\t';
+                    chunk += seq;
+                    chunk += '\t';
+                    chunk += idx;
+                    chunk += '\n';
+                }
+            }
+            out = chunk;
+            return !chunk.empty();
+        });
 
         res = pg("COMMIT");
         if (!res || res.status() != PGRES_COMMAND_OK)
@@ -314,6 +314,18 @@ private:
         return txdb_->checkoutDb();
     }
 
+    /**
+     * @brief checkoutTransactionRead Checks out a read-only session to the
+     *        node store transaction database, so that queries do not wait
+     *        on the session that writes.
+     * @return Session to the node store transaction database.
+     */
+    auto
+    checkoutTransactionRead()
+    {
+        return txdb_->checkoutReadDb();
+    }
+
     /**
      * @brief doLedger Checks out the ledger database owned by the shard
      *        containing the given ledger, and invokes the provided callback
@@ -389,7 +401,7 @@ private:
             bool(soci::session& session, std::uint32_t shardIndex)> const&
             callback)
     {
-        return app_.getShardStore()->iterateLedgerSQLsForward(
+        return app_.getShardStore()->iterateTransactionSQLsForward(
             firstIndex, callback);
     }
 
@@ -435,7 +447,7 @@ private:
             bool(soci::session& session, std::uint32_t shardIndex)> const&
             callback)
     {
-        return app_.getShardStore()->iterateLedgerSQLsBack(
+        return app_.getShardStore()->iterateTransactionSQLsBack(
             firstIndex, callback);
     }
 };
@@ -1044,7 +1056,7 @@ SQLiteDatabaseImp::getTxHistory(LedgerIndex startIndex)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         auto const res =
             detail::getTxHistory(*db, app_, startIndex, 20, false).first;
 
@@ -1091,7 +1103,7 @@ SQLiteDatabaseImp::getOldestAccountTxs(AccountTxOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         return detail::getOldestAccountTxs(
                    *db, app_, ledgerMaster, options, {}, j_)
             .first;
@@ -1151,7 +1163,7 @@ SQLiteDatabaseImp::getNewestAccountTxs(AccountTxOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         return detail::getNewestAccountTxs(
                    *db, app_, ledgerMaster, options, {}, j_)
             .first;
@@ -1209,7 +1221,7 @@ SQLiteDatabaseImp::getOldestAccountTxsB(AccountTxOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         return detail::getOldestAccountTxsB(*db, app_, options, {}, j_).first;
     }
 
@@ -1265,7 +1277,7 @@ SQLiteDatabaseImp::getNewestAccountTxsB(AccountTxOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         return detail::getNewestAccountTxsB(*db, app_, options, {}, j_).first;
     }
 
@@ -1336,7 +1348,7 @@ SQLiteDatabaseImp::oldestAccountTxPage(AccountTxPageOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         auto newmarker =
             detail::oldestAccountTxPage(
                 *db, onUnsavedLedger, onTransaction, options, 0, page_length)
@@ -1353,7 +1365,7 @@ SQLiteDatabaseImp::oldestAccountTxPage(AccountTxPageOptions const& options)
                           : std::optional<std::uint32_t>(),
             [&](soci::session& session, std::uint32_t shardIndex) {
                 if (opt.maxLedger != UINT32_MAX &&
-                    shardIndex > seqToShardIndex(opt.minLedger))
+                    shardIndex > seqToShardIndex(opt.maxLedger))
                     return false;
                 auto [marker, total] = detail::oldestAccountTxPage(
                     session,
@@ -1398,7 +1410,7 @@ SQLiteDatabaseImp::newestAccountTxPage(AccountTxPageOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         auto newmarker =
             detail::newestAccountTxPage(
                 *db, onUnsavedLedger, onTransaction, options, 0, page_length)
@@ -1459,7 +1471,7 @@ SQLiteDatabaseImp::oldestAccountTxPageB(AccountTxPageOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         auto newmarker =
             detail::oldestAccountTxPage(
                 *db, onUnsavedLedger, onTransaction, options, 0, page_length)
@@ -1476,7 +1488,7 @@ SQLiteDatabaseImp::oldestAccountTxPageB(AccountTxPageOptions const& options)
                           : std::optional<std::uint32_t>(),
             [&](soci::session& session, std::uint32_t shardIndex) {
                 if (opt.maxLedger != UINT32_MAX &&
-                    shardIndex > seqToShardIndex(opt.minLedger))
+                    shardIndex > seqToShardIndex(opt.maxLedger))
                     return false;
                 auto [marker, total] = detail::oldestAccountTxPage(
                     session,
@@ -1520,7 +1532,7 @@ SQLiteDatabaseImp::newestAccountTxPageB(AccountTxPageOptions const& options)
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         auto newmarker =
             detail::newestAccountTxPage(
                 *db, onUnsavedLedger, onTransaction, options, 0, page_length)
@@ -1570,7 +1582,7 @@ SQLiteDatabaseImp::getTransaction(
 
     if (existsTransaction())
     {
-        auto db = checkoutTransaction();
+        auto db = checkoutTransactionRead();
         return detail::getTransaction(*db, app_, id, range, ec);
     }
 
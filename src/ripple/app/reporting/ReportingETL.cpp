@@ -27,12 +27,19 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <charconv>
 #include <cstdlib>
+#include <exception>
 #include <iostream>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <variant>
+#include <vector>
 
 namespace ripple {
 
@@ -72,32 +79,95 @@ ReportingETL::consumeLedgerData(
     }
 }
 
+namespace {
+
+// Calls f(i) for each i in [0, count), spread over up to `threads` threads.
+// The first exception thrown, if any, is rethrown once all threads finish.
+template <class F>
+void
+parallelFor(std::size_t threads, std::size_t count, F&& f)
+{
+    threads = std::min(threads, count);
+    if (threads <= 1)
+    {
+        for (std::size_t i = 0; i != count; ++i)
+            f(i);
+        return;
+    }
+
+    std::atomic<std::size_t> next = 0;
+    std::mutex mutex;
+    std::exception_ptr error;
+
+    auto work = [&]() {
+        try
+        {
+            for (auto i = next++; i < count; i = next++)
+                f(i);
+        }
+        catch (...)
+        {
+            std::lock_guard lock(mutex);
+            if (!error)
+                error = std::current_exception();
+            next = count;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (std::size_t i = 1; i != threads; ++i)
+        pool.emplace_back(work);
+    work();
+    for (auto& t : pool)
+        t.join();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+}  // namespace
+
 std::vector<AccountTransactionsData>
 ReportingETL::insertTransactions(
     std::shared_ptr<Ledger>& ledger,
     org::xrpl::rpc::v1::GetLedgerResponse& data)
 {
-    std::vector<AccountTransactionsData> accountTxData;
-    for (auto& txn : data.transactions_list().transactions())
-    {
-        auto& raw = txn.transaction_blob();
+    auto const& txns = data.transactions_list().transactions();
 
+    // Decoding is independent for each transaction, so it is done in
+    // parallel; the inserts that follow must happen one at a time.
+    std::vector<std::optional<TxMeta>> metas(txns.size());
+    parallelFor(transformThreads_, txns.size(), [&](std::size_t i) {
+        auto const& raw = txns[i].transaction_blob();
         SerialIter it{raw.data(), raw.size()};
-        STTx sttx{it};
-
-        auto txSerializer = std::make_shared<Serializer>(sttx.getSerializer());
-
-        TxMeta txMeta{
-            sttx.getTransactionID(), ledger->info().seq, txn.metadata_blob()};
+        STTx const sttx{it};
+        metas[i].emplace(
+            sttx.getTransactionID(),
+            ledger->info().seq,
+            txns[i].metadata_blob());
+    });
 
+    std::vector<AccountTransactionsData> accountTxData;
+    accountTxData.reserve(txns.size());
+    for (int i = 0; i != txns.size(); ++i)
+    {
+        // The blobs are exactly what the ledger holds, so they are stored
+        // as received rather than serialized again.
+        auto const& raw = txns[i].transaction_blob();
+        auto const& rawMeta = txns[i].metadata_blob();
+        auto txSerializer =
+            std::make_shared<Serializer>(raw.data(), raw.size());
         auto metaSerializer =
-            std::make_shared<Serializer>(txMeta.getAsObject().getSerializer());
+            std::make_shared<Serializer>(rawMeta.data(), rawMeta.size());
+
+        auto const& txMeta = *metas[i];
 
         JLOG(journal_.trace())
             << __func__ << " : "
-            << "Inserting transaction = " << sttx.getTransactionID();
+            << "Inserting transaction = " << txMeta.getTxID();
         uint256 nodestoreHash = ledger->rawTxInsertWithHash(
-            sttx.getTransactionID(), txSerializer, metaSerializer);
+            txMeta.getTxID(), txSerializer, metaSerializer);
         accountTxData.emplace_back(txMeta, std::move(nodestoreHash), journal_);
     }
     return accountTxData;
@@ -405,39 +475,50 @@ ReportingETL::buildNextLedger(
         << "Inserted all transactions. Number of transactions  = "
         << rawData.transactions_list().transactions_size();
 
-    for (auto& obj : rawData.ledger_objects().objects())
-    {
-        auto key = uint256::fromVoidChecked(obj.key());
+    auto const& objects = rawData.ledger_objects().objects();
+
+    // Decode the objects in parallel, then apply them in order
+    std::vector<std::shared_ptr<SLE>> sles(objects.size());
+    parallelFor(transformThreads_, objects.size(), [&](std::size_t i) {
+        auto key = uint256::fromVoidChecked(objects[i].key());
         if (!key)
             throw std::runtime_error("Recevied malformed object ID");
 
-        auto& data = obj.data();
+        auto& data = objects[i].data();
+
+        // An empty object indicates a deletion, and is left null
+        if (data.size() != 0)
+        {
+            SerialIter it{data.data(), data.size()};
+            sles[i] = std::make_shared<SLE>(it, *key);
+        }
+    });
+
+    for (int i = 0; i != objects.size(); ++i)
+    {
+        // The key was checked while decoding
+        auto key = *uint256::fromVoidChecked(objects[i].key());
+        auto& sle = sles[i];
 
         // indicates object was deleted
-        if (data.size() == 0)
+        if (!sle)
+        {
+            JLOG(journal_.trace()) << __func__ << " : "
+                                   << "Erasing object = " << key;
+            if (next->exists(key))
+                next->rawErase(key);
+        }
+        else if (next->exists(key))
         {
             JLOG(journal_.trace()) << __func__ << " : "
-                                   << "Erasing object = " << *key;
-            if (next->exists(*key))
-                next->rawErase(*key);
+                                   << "Replacing object = " << key;
+            next->rawReplace(sle);
         }
         else
         {
-            SerialIter it{data.data(), data.size()};
-            std::shared_ptr<SLE> sle = std::make_shared<SLE>(it, *key);
-
-            if (next->exists(*key))
-            {
-                JLOG(journal_.trace()) << __func__ << " : "
-                                       << "Replacing object = " << *key;
-                next->rawReplace(sle);
-            }
-            else
-            {
-                JLOG(journal_.trace()) << __func__ << " : "
-                                       << "Inserting object = " << *key;
-                next->rawInsert(sle);
-            }
+            JLOG(journal_.trace()) << __func__ << " : "
+                                   << "Inserting object = " << key;
+            next->rawInsert(sle);
         }
     }
     JLOG(journal_.debug())
@@ -501,7 +582,7 @@ ReportingETL::runETLPipeline(uint32_t startSequence)
 
     std::atomic_bool writeConflict = false;
     std::optional<uint32_t> lastPublishedSequence;
-    constexpr uint32_t maxQueueSize = 1000;
+    auto const maxQueueSize = static_cast<uint32_t>(queueDepth_);
 
     ThreadSafeQueue<std::optional<org::xrpl::rpc::v1::GetLedgerResponse>>
         transformQueue{maxQueueSize};
@@ -954,6 +1035,20 @@ ReportingETL::ReportingETL(Application& app)
                 numMarkers_,
                 *optNumMarkers,
                 "Expected integral num_markers config entry.  Got: ");
+
+        auto const optTransformThreads = section.get("transform_threads");
+        if (optTransformThreads)
+            asciiToIntThrows(
+                transformThreads_,
+                *optTransformThreads,
+                "Expected integral transform_threads config entry.  Got: ");
+
+        auto const optQueueDepth = section.get("queue_depth");
+        if (optQueueDepth)
+            asciiToIntThrows(
+                queueDepth_,
+                *optQueueDepth,
+                "Expected integral queue_depth config entry.  Got: ");
     }
 }
 
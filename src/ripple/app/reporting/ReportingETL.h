@@ -125,6 +125,15 @@ private:
     /// more load on the ETL source.
     size_t numMarkers_ = 2;
 
+    /// The number of threads that decode the transactions and ledger objects
+    /// of each new ledger. The decoded data is still applied to the ledger by
+    /// a single thread, since a SHAMap cannot be modified concurrently.
+    size_t transformThreads_ = 1;
+
+    /// The number of ledgers each stage of the ETL pipeline may hold for the
+    /// next stage before it has to wait.
+    size_t queueDepth_ = 1000;
+
     /// Whether the process is in strict read-only mode. In strict read-only
     /// mode, the process will never attempt to become the ETL writer, and will
     /// only publish ledgers as they are written to the database.
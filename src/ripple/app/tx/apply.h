@@ -22,16 +22,19 @@
 
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/core/Config.h>
+#include <ripple/core/Job.h>
 #include <ripple/ledger/View.h>
 #include <ripple/protocol/STTx.h>
 #include <ripple/protocol/TER.h>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace ripple {
 
 class Application;
 class HashRouter;
+class JobQueue;
 
 /** Describes the pre-processing validity of a transaction.
 
@@ -66,6 +69,28 @@ checkValidity(
     Rules const& rules,
     Config const& config);
 
+/** Checks the signatures of several transactions at once.
+
+    Every transaction whose signature the router has not yet
+    judged is checked as by the function above, with the work
+    spread over the calling thread and up to `workers` - 1 jobs
+    of the given type. Nothing is returned: the results are
+    cached, so a later call for any one of the transactions
+    only looks them up.
+
+    @note Exceptions from a single check are swallowed; the
+          transaction's own check later will report them.
+*/
+void
+checkValidity(
+    HashRouter& router,
+    std::vector<std::shared_ptr<STTx const>> const& txs,
+    Rules const& rules,
+    Config const& config,
+    JobQueue& jobQueue,
+    JobType type,
+    std::size_t workers);
+
 /** Sets the validity of a given transaction in the cache.
 
     @warning Use with extreme care.
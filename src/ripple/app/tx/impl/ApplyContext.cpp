@@ -21,10 +21,14 @@
 #include <ripple/app/tx/impl/InvariantCheck.h>
 #include <ripple/app/tx/impl/Transactor.h>
 #include <ripple/basics/Log.h>
+#include <ripple/basics/PerfLog.h>
 #include <ripple/json/to_string.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/Indexes.h>
 #include <cassert>
+#include <chrono>
+#include <tuple>
+#include <vector>
 
 namespace ripple {
 
@@ -99,25 +103,45 @@ ApplyContext::checkInvariantsHelper(
     {
         auto checkers = getInvariantChecks();
 
-        // call each check's per-entry method
-        visit([&checkers](
-                  uint256 const& index,
+        // Read the modified entries, and the fields that several checks
+        // share, in a single pass.
+        std::vector<std::tuple<bool, InvariantEntry, InvariantEntry>> entries;
+        entries.reserve(size());
+        visit([&entries](
+                  uint256 const&,
                   bool isDelete,
                   std::shared_ptr<SLE const> const& before,
                   std::shared_ptr<SLE const> const& after) {
-            (..., std::get<Is>(checkers).visitEntry(isDelete, before, after));
+            entries.emplace_back(
+                isDelete, InvariantEntry{before}, InvariantEntry{after});
         });
 
+        // Run each check over all of the entries and then finalize it, so
+        // that the time spent in each check can be reported on its own.
+        auto& perfLog = app.getPerfLog();
+        auto run = [&](auto& checker) {
+            using namespace std::chrono;
+            auto const start = steady_clock::now();
+            for (auto const& [isDelete, before, after] : entries)
+                checker.visitEntry(isDelete, before, after);
+            bool const passed =
+                checker.finalize(tx, result, fee, *view_, journal);
+            perfLog.invariantCheck(
+                checker.name,
+                duration_cast<nanoseconds>(steady_clock::now() - start),
+                passed);
+            return passed;
+        };
+
         // Note: do not replace this logic with a `...&&` fold expression.
         // The fold expression will only run until the first check fails (it
         // short-circuits). While the logic is still correct, the log
         // message won't be. Every failed invariant should write to the log,
         // not just the first one.
         std::array<bool, sizeof...(Is)> finalizers{
-            {std::get<Is>(checkers).finalize(
-                tx, result, fee, *view_, journal)...}};
+            {run(std::get<Is>(checkers))...}};
 
-        // call each check's finalizer to see that it passes
+        // see that every check passed
         if (!std::all_of(
                 finalizers.cbegin(), finalizers.cend(), [](auto const& b) {
                     return b;
@@ -20,11 +20,14 @@
 #include <ripple/app/tx/impl/BookTip.h>
 #include <ripple/basics/Log.h>
 
+#include <algorithm>
+
 namespace ripple {
 
 BookTip::BookTip(ApplyView& view, Book const& book)
     : view_(view)
     , m_valid(false)
+    , m_issues(book)
     , m_book(getBookBase(book))
     , m_end(getQualityNext(m_book))
 {
@@ -57,8 +60,12 @@ BookTip::step(beast::Journal j)
 
         if (dirFirst(view_, *first_page, dir, di, m_index))
         {
+            if (m_ahead.count(m_index) == 0)
+                prefetchAhead(*dir);
+
             m_dir = dir->key();
             m_entry = view_.peek(keylet::offer(m_index));
+            ++m_consumed;
             m_quality = Quality(getQuality(*first_page));
             m_valid = true;
 
@@ -79,4 +86,51 @@ BookTip::step(beast::Journal j)
     return true;
 }
 
+void
+BookTip::prefetchAhead(SLE const& dir)
+{
+    // The directory walk has already asked for the offers themselves, but
+    // what funds them is only known once they are read. Read the next few
+    // now and start loading their owners' account roots and trust lines
+    // together, instead of one owner at a time as the crossing reaches them.
+    auto const& indexes = dir.getFieldV256(sfIndexes);
+    auto const count = std::min(indexes.size(), lookahead);
+
+    std::vector<uint256> keys;
+    keys.reserve(2 + 3 * count);
+
+    for (auto const& issue : {m_issues.in, m_issues.out})
+    {
+        if (!isXRP(issue))
+            keys.push_back(keylet::account(issue.account).key);
+    }
+
+    std::vector<AccountID> owners;
+    owners.reserve(count);
+
+    m_ahead.clear();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        m_ahead.insert(indexes[i]);
+
+        auto const offer = view_.read(keylet::offer(indexes[i]));
+        if (!offer)
+            continue;
+
+        auto const owner = offer->getAccountID(sfAccount);
+        if (std::find(owners.begin(), owners.end(), owner) != owners.end())
+            continue;
+        owners.push_back(owner);
+
+        keys.push_back(keylet::account(owner).key);
+        for (auto const& issue : {m_issues.in, m_issues.out})
+        {
+            if (!isXRP(issue))
+                keys.push_back(keylet::line(owner, issue).key);
+        }
+    }
+
+    view_.prefetch(keys);
+}
+
 }  // namespace ripple
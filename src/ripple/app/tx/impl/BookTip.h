@@ -24,6 +24,9 @@
 #include <ripple/protocol/Indexes.h>
 #include <ripple/protocol/Quality.h>
 
+#include <boost/container/flat_set.hpp>
+
+#include <cstdint>
 #include <functional>
 
 namespace ripple {
@@ -37,14 +40,23 @@ class Logs;
 class BookTip
 {
 private:
+    // How many offers a lookahead starts loading at once
+    static constexpr std::size_t lookahead = 8;
+
     ApplyView& view_;
     bool m_valid;
+    Book const m_issues;
     uint256 m_book;
     uint256 m_end;
     uint256 m_dir;
     uint256 m_index;
     std::shared_ptr<SLE> m_entry;
     Quality m_quality;
+    boost::container::flat_set<uint256> m_ahead;
+    std::uint32_t m_consumed = 0;
+
+    void
+    prefetchAhead(SLE const& dir);
 
 public:
     /** Create the iterator. */
@@ -74,6 +86,13 @@ public:
         return m_entry;
     }
 
+    /** Returns how many offers the tip has been on. */
+    std::uint32_t
+    consumed() const noexcept
+    {
+        return m_consumed;
+    }
+
     /** Erases the current offer and advance to the next offer.
         Complexity: Constant
         @return `true` if there is a next offer
@@ -756,6 +756,14 @@ CreateOffer::flowCross(
                     STAmount::cMaxOffset};
         }
 
+        // Resting orders, usually from market makers, meet nothing in the
+        // book. Don't build the payment engine just to find that out.
+        if (crossesNothing(psb, takerAmount, threshold))
+        {
+            JLOG(j_.trace()) << "Not crossing: no offer meets the threshold.";
+            return {tesSUCCESS, takerAmount};
+        }
+
         // Call the payment engine's flow() to do the actual work.
         auto const result = flow(
             psb,
@@ -868,6 +876,29 @@ CreateOffer::flowCross(
     return {tecINTERNAL, takerAmount};
 }
 
+bool
+CreateOffer::crossesNothing(
+    ReadView const& view,
+    Amounts const& takerAmount,
+    Quality const& threshold)
+{
+    // Offers between two tokens also cross through XRP
+    if (takerAmount.in.native() == takerAmount.out.native())
+        return false;
+
+    Issue const& in = takerAmount.in.issue();
+    Issue const& out = takerAmount.out.issue();
+    if (view.exists(keylet::amm(in, out)))
+        return false;
+
+    // The quality of a book's best offer is in the key of its first page.
+    // No offer the strand could take is any better, and neither are the
+    // bounds flow() holds the threshold against.
+    auto const base = getBookBase(Book(in, out));
+    auto const first = view.succ(base, getQualityNext(base));
+    return !first || Quality(getQuality(*first)) < threshold;
+}
+
 std::pair<TER, Amounts>
 CreateOffer::cross(Sandbox& sb, Sandbox& sbCancel, Amounts const& takerAmount)
 {
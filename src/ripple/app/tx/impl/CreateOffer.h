@@ -61,6 +61,22 @@ public:
     TER
     doApply() override;
 
+    /** Whether offer crossing would find nothing to cross.
+
+        That is the case for an offer between XRP and a token when the pair
+        has no AMM and the best offer of the book it crosses, if any, is of
+        lower quality than the threshold. Every strand flow() would build
+        then falls short of the threshold, so flow() changes nothing.
+
+        @param takerAmount What the taker pays and gets, as in flowCross.
+        @param threshold The lowest quality the taker accepts.
+    */
+    static bool
+    crossesNothing(
+        ReadView const& view,
+        Amounts const& takerAmount,
+        Quality const& threshold);
+
 private:
     std::pair<TER, bool>
     applyGuts(Sandbox& view, Sandbox& view_cancel);
@@ -32,11 +32,37 @@
 
 namespace ripple {
 
+InvariantEntry::InvariantEntry(std::shared_ptr<SLE const> entry)
+    : sle(std::move(entry))
+{
+    if (!sle)
+        return;
+
+    type = sle->getType();
+    switch (type)
+    {
+        case ltACCOUNT_ROOT:
+            balance = (*sle)[sfBalance];
+            break;
+        case ltPAYCHAN:
+            balance = (*sle)[sfBalance];
+            amount = (*sle)[sfAmount];
+            break;
+        case ltESCROW:
+            amount = (*sle)[sfAmount];
+            break;
+        default:
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+
 void
 TransactionFeeCheck::visitEntry(
     bool,
-    std::shared_ptr<SLE const> const&,
-    std::shared_ptr<SLE const> const&)
+    InvariantEntry const&,
+    InvariantEntry const&)
 {
     // nothing to do
 }
@@ -83,8 +109,8 @@ TransactionFeeCheck::finalize(
 void
 XRPNotCreated::visitEntry(
     bool isDelete,
-    std::shared_ptr<SLE const> const& before,
-    std::shared_ptr<SLE const> const& after)
+    InvariantEntry const& before,
+    InvariantEntry const& after)
 {
     /* We go through all modified ledger entries, looking only at account roots,
      * escrow payments, and payment channels. We remove from the total any
@@ -93,45 +119,36 @@ XRPNotCreated::visitEntry(
      * balance) and deletions are ignored for paychan and escrow because the
      * amount fields have not been adjusted for those in the case of deletion.
      */
-    if (before)
+    switch (before.type)
     {
-        switch (before->getType())
-        {
-            case ltACCOUNT_ROOT:
-                drops_ -= (*before)[sfBalance].xrp().drops();
-                break;
-            case ltPAYCHAN:
-                drops_ -=
-                    ((*before)[sfAmount] - (*before)[sfBalance]).xrp().drops();
-                break;
-            case ltESCROW:
-                drops_ -= (*before)[sfAmount].xrp().drops();
-                break;
-            default:
-                break;
-        }
+        case ltACCOUNT_ROOT:
+            drops_ -= before.balance->xrp().drops();
+            break;
+        case ltPAYCHAN:
+            drops_ -= (*before.amount - *before.balance).xrp().drops();
+            break;
+        case ltESCROW:
+            drops_ -= before.amount->xrp().drops();
+            break;
+        default:
+            break;
     }
 
-    if (after)
+    switch (after.type)
     {
-        switch (after->getType())
-        {
-            case ltACCOUNT_ROOT:
-                drops_ += (*after)[sfBalance].xrp().drops();
-                break;
-            case ltPAYCHAN:
-                if (!isDelete)
-                    drops_ += ((*after)[sfAmount] - (*after)[sfBalance])
-                                  .xrp()
-                                  .drops();
-                break;
-            case ltESCROW:
-                if (!isDelete)
-                    drops_ += (*after)[sfAmount].xrp().drops();
-                break;
-            default:
-                break;
-        }
+        case ltACCOUNT_ROOT:
+            drops_ += after.balance->xrp().drops();
+            break;
+        case ltPAYCHAN:
+            if (!isDelete)
+                drops_ += (*after.amount - *after.balance).xrp().drops();
+            break;
+        case ltESCROW:
+            if (!isDelete)
+                drops_ += after.amount->xrp().drops();
+            break;
+        default:
+            break;
     }
 }
 
@@ -168,8 +185,8 @@ XRPNotCreated::finalize(
 void
 XRPBalanceChecks::visitEntry(
     bool,
-    std::shared_ptr<SLE const> const& before,
-    std::shared_ptr<SLE const> const& after)
+    InvariantEntry const& before,
+    InvariantEntry const& after)
 {
     auto isBad = [](STAmount const& balance) {
         if (!balance.native())
@@ -189,11 +206,11 @@ XRPBalanceChecks::visitEntry(
         return false;
     };
 
-    if (before && before->getType() == ltACCOUNT_ROOT)
-        bad_ |= isBad((*before)[sfBalance]);
+    if (before.type == ltACCOUNT_ROOT)
+        bad_ |= isBad(*before.balance);
 
-    if (after && after->getType() == ltACCOUNT_ROOT)
-        bad_ |= isBad((*after)[sfBalance]);
+    if (after.type == ltACCOUNT_ROOT)
+        bad_ |= isBad(*after.balance);
 }
 
 bool
@@ -218,8 +235,8 @@ XRPBalanceChecks::finalize(
 void
 NoBadOffers::visitEntry(
     bool isDelete,
-    std::shared_ptr<SLE const> const& before,
-    std::shared_ptr<SLE const> const& after)
+    InvariantEntry const& before,
+    InvariantEntry const& after)
 {
     auto isBad = [](STAmount const& pays, STAmount const& gets) {
         // An offer should never be negative
@@ -233,11 +250,11 @@ NoBadOffers::visitEntry(
         return pays.native() && gets.native();
     };
 
-    if (before && before->getType() == ltOFFER)
-        bad_ |= isBad((*before)[sfTakerPays], (*before)[sfTakerGets]);
+    if (before.type == ltOFFER)
+        bad_ |= isBad((*before.sle)[sfTakerPays], (*before.sle)[sfTakerGets]);
 
-    if (after && after->getType() == ltOFFER)
-        bad_ |= isBad((*after)[sfTakerPays], (*after)[sfTakerGets]);
+    if (after.type == ltOFFER)
+        bad_ |= isBad((*after.sle)[sfTakerPays], (*after.sle)[sfTakerGets]);
 }
 
 bool
@@ -262,8 +279,8 @@ NoBadOffers::finalize(
 void
 NoZeroEscrow::visitEntry(
     bool isDelete,
-    std::shared_ptr<SLE const> const& before,
-    std::shared_ptr<SLE const> const& after)
+    InvariantEntry const& before,
+    InvariantEntry const& after)
 {
     auto isBad = [](STAmount const& amount) {
         if (!amount.native())
@@ -278,11 +295,11 @@ NoZeroEscrow::visitEntry(
         return false;
     };
 
-    if (before && before->getType() == ltESCROW)
-        bad_ |= isBad((*before)[sfAmount]);
+    if (before.type == ltESCROW)
+        bad_ |= isBad(*before.amount);
 
-    if (after && after->getType() == ltESCROW)
-        bad_ |= isBad((*after)[sfAmount]);
+    if (after.type == ltESCROW)
+        bad_ |= isBad(*after.amount);
 }
 
 bool
@@ -307,10 +324,10 @@ NoZeroEscrow::finalize(
 void
 AccountRootsNotDeleted::visitEntry(
     bool isDelete,
-    std::shared_ptr<SLE const> const& before,
-    std::shared_ptr<SLE const> const&)
+    InvariantEntry const& before,
+    InvariantEntry const&)
 {
-    if (isDelete && before && before->getType() == ltACCOUNT_ROOT)
+    if (isDelete && before.type == ltACCOUNT_ROOT)
         accountsDeleted_++;
 }
 
@@ -361,15 +378,15 @@ AccountRootsNotDeleted::finalize(
 void
 LedgerEntryTypesMatch::visitEntry(
     bool,
-    std::shared_ptr<SLE const> const& before,
-    std::shared_ptr<SLE const> const& after)
+    InvariantEntry const& before,
+    InvariantEntry const& after)
 {
-    if (before && after && before->getType() != after->getType())
+    if (before && after && before.type != after.type)
         typeMismatch_ = true;
 
     if (after)
     {
-        switch (after->getType())
+        switch (after.type)
         {
             case ltACCOUNT_ROOT:
             case ltDIR_NODE:
@@ -429,17 +446,17 @@ LedgerEntryTypesMatch::finalize(
 void
 NoXRPTrustLines::visitEntry(
     bool,
-    std::shared_ptr<SLE const> const&,
-    std::shared_ptr<SLE const> const& after)
+    InvariantEntry const&,
+    InvariantEntry const& after)
 {
-    if (after && after->getType() == ltRIPPLE_STATE)
+    if (after.type == ltRIPPLE_STATE)
     {
         // checking the issue directly here instead of
         // relying on .native() just in case native somehow
         // were systematically incorrect
         xrpTrustLine_ =
-            after->getFieldAmount(sfLowLimit).issue() == xrpIssue() ||
-            after->getFieldAmount(sfHighLimit).issue() == xrpIssue();
+            after.sle->getFieldAmount(sfLowLimit).issue() == xrpIssue() ||
+            after.sle->getFieldAmount(sfHighLimit).issue() == xrpIssue();
     }
 }
 
@@ -463,13 +480,13 @@ NoXRPTrustLines::finalize(
 void
 ValidNewAccountRoot::visitEntry(
     bool,
-    std::shared_ptr<SLE const> const& before,
-    std::shared_ptr<SLE const> const& after)
+    InvariantEntry const& before,
+    InvariantEntry const& after)
 {
-    if (!before && after->getType() == ltACCOUNT_ROOT)
+    if (!before && after.type == ltACCOUNT_ROOT)
     {
         accountsCreated_++;
-        accountSeq_ = (*after)[sfSequence];
+        accountSeq_ = (*after.sle)[sfSequence];
     }
 }
 
@@ -520,8 +537,8 @@ ValidNewAccountRoot::finalize(
 void
 ValidNFTokenPage::visitEntry(
     bool isDelete,
-    std::shared_ptr<SLE const> const& before,
-    std::shared_ptr<SLE const> const& after)
+    InvariantEntry const& before,
+    InvariantEntry const& after)
 {
     static constexpr uint256 const& pageBits = nft::pageMask;
     static constexpr uint256 const accountBits = ~pageBits;
@@ -587,11 +604,11 @@ ValidNFTokenPage::visitEntry(
         }
     };
 
-    if (before && before->getType() == ltNFTOKEN_PAGE)
-        check(before);
+    if (before.type == ltNFTOKEN_PAGE)
+        check(before.sle);
 
-    if (after && after->getType() == ltNFTOKEN_PAGE)
-        check(after);
+    if (after.type == ltNFTOKEN_PAGE)
+        check(after.sle);
 }
 
 bool
@@ -639,19 +656,19 @@ ValidNFTokenPage::finalize(
 void
 NFTokenCountTracking::visitEntry(
     bool,
-    std::shared_ptr<SLE const> const& before,
-    std::shared_ptr<SLE const> const& after)
+    InvariantEntry const& before,
+    InvariantEntry const& after)
 {
-    if (before && before->getType() == ltACCOUNT_ROOT)
+    if (before.type == ltACCOUNT_ROOT)
     {
-        beforeMintedTotal += (*before)[~sfMintedNFTokens].value_or(0);
-        beforeBurnedTotal += (*before)[~sfBurnedNFTokens].value_or(0);
+        beforeMintedTotal += (*before.sle)[~sfMintedNFTokens].value_or(0);
+        beforeBurnedTotal += (*before.sle)[~sfBurnedNFTokens].value_or(0);
     }
 
-    if (after && after->getType() == ltACCOUNT_ROOT)
+    if (after.type == ltACCOUNT_ROOT)
     {
-        afterMintedTotal += (*after)[~sfMintedNFTokens].value_or(0);
-        afterBurnedTotal += (*after)[~sfBurnedNFTokens].value_or(0);
+        afterMintedTotal += (*after.sle)[~sfMintedNFTokens].value_or(0);
+        afterBurnedTotal += (*after.sle)[~sfBurnedNFTokens].value_or(0);
     }
 }
 
@@ -746,10 +763,10 @@ NFTokenCountTracking::finalize(
 void
 ValidClawback::visitEntry(
     bool,
-    std::shared_ptr<SLE const> const& before,
-    std::shared_ptr<SLE const> const&)
+    InvariantEntry const& before,
+    InvariantEntry const&)
 {
-    if (before && before->getType() == ltRIPPLE_STATE)
+    if (before.type == ltRIPPLE_STATE)
         trustlinesChanged++;
 }
 
@@ -28,6 +28,8 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
+#include <optional>
 #include <tuple>
 #include <utility>
 
@@ -35,6 +37,35 @@ namespace ripple {
 
 class ReadView;
 
+/**
+ * @brief A ledger entry as it was before or after the transaction, together
+ * with the fields that more than one invariant check needs.
+ *
+ * The fields are read once for each modified entry when the checks start,
+ * and the same instance is handed to every checker.
+ */
+struct InvariantEntry
+{
+    explicit InvariantEntry(std::shared_ptr<SLE const> sle);
+
+    explicit operator bool() const
+    {
+        return static_cast<bool>(sle);
+    }
+
+    /** The entry, or nullptr if it does not exist on this side. */
+    std::shared_ptr<SLE const> sle;
+
+    /** The entry type, or ltANY if there is no entry. */
+    LedgerEntryType type = ltANY;
+
+    /** sfBalance of an account root or payment channel. */
+    std::optional<STAmount> balance;
+
+    /** sfAmount of an escrow or payment channel. */
+    std::optional<STAmount> amount;
+};
+
 #if GENERATING_DOCS
 /**
  * @brief Prototype for invariant check implementations.
@@ -47,6 +78,9 @@ class ReadView;
 class InvariantChecker_PROTOTYPE
 {
 public:
+    /** The name the check's counters are reported under. */
+    static constexpr char const* name = "InvariantChecker_PROTOTYPE";
+
     explicit InvariantChecker_PROTOTYPE() = default;
 
     /**
@@ -59,8 +93,8 @@ public:
     void
     visitEntry(
         bool isDelete,
-        std::shared_ptr<SLE const> const& before,
-        std::shared_ptr<SLE const> const& after);
+        InvariantEntry const& before,
+        InvariantEntry const& after);
 
     /**
      * @brief called after all ledger entries have been visited to determine
@@ -93,11 +127,10 @@ public:
 class TransactionFeeCheck
 {
 public:
+    static constexpr char const* name = "TransactionFeeCheck";
+
     void
-    visitEntry(
-        bool,
-        std::shared_ptr<SLE const> const&,
-        std::shared_ptr<SLE const> const&);
+    visitEntry(bool, InvariantEntry const&, InvariantEntry const&);
 
     bool
     finalize(
@@ -121,11 +154,10 @@ class XRPNotCreated
     std::int64_t drops_ = 0;
 
 public:
+    static constexpr char const* name = "XRPNotCreated";
+
     void
-    visitEntry(
-        bool,
-        std::shared_ptr<SLE const> const&,
-        std::shared_ptr<SLE const> const&);
+    visitEntry(bool, InvariantEntry const&, InvariantEntry const&);
 
     bool
     finalize(
@@ -149,11 +181,10 @@ class AccountRootsNotDeleted
     std::uint32_t accountsDeleted_ = 0;
 
 public:
+    static constexpr char const* name = "AccountRootsNotDeleted";
+
     void
-    visitEntry(
-        bool,
-        std::shared_ptr<SLE const> const&,
-        std::shared_ptr<SLE const> const&);
+    visitEntry(bool, InvariantEntry const&, InvariantEntry const&);
 
     bool
     finalize(
@@ -176,11 +207,10 @@ class XRPBalanceChecks
     bool bad_ = false;
 
 public:
+    static constexpr char const* name = "XRPBalanceChecks";
+
     void
-    visitEntry(
-        bool,
-        std::shared_ptr<SLE const> const&,
-        std::shared_ptr<SLE const> const&);
+    visitEntry(bool, InvariantEntry const&, InvariantEntry const&);
 
     bool
     finalize(
@@ -201,11 +231,10 @@ class LedgerEntryTypesMatch
     bool invalidTypeAdded_ = false;
 
 public:
+    static constexpr char const* name = "LedgerEntryTypesMatch";
+
     void
-    visitEntry(
-        bool,
-        std::shared_ptr<SLE const> const&,
-        std::shared_ptr<SLE const> const&);
+    visitEntry(bool, InvariantEntry const&, InvariantEntry const&);
 
     bool
     finalize(
@@ -227,11 +256,10 @@ class NoXRPTrustLines
     bool xrpTrustLine_ = false;
 
 public:
+    static constexpr char const* name = "NoXRPTrustLines";
+
     void
-    visitEntry(
-        bool,
-        std::shared_ptr<SLE const> const&,
-        std::shared_ptr<SLE const> const&);
+    visitEntry(bool, InvariantEntry const&, InvariantEntry const&);
 
     bool
     finalize(
@@ -254,11 +282,10 @@ class NoBadOffers
     bool bad_ = false;
 
 public:
+    static constexpr char const* name = "NoBadOffers";
+
     void
-    visitEntry(
-        bool,
-        std::shared_ptr<SLE const> const&,
-        std::shared_ptr<SLE const> const&);
+    visitEntry(bool, InvariantEntry const&, InvariantEntry const&);
 
     bool
     finalize(
@@ -278,11 +305,10 @@ class NoZeroEscrow
     bool bad_ = false;
 
 public:
+    static constexpr char const* name = "NoZeroEscrow";
+
     void
-    visitEntry(
-        bool,
-        std::shared_ptr<SLE const> const&,
-        std::shared_ptr<SLE const> const&);
+    visitEntry(bool, InvariantEntry const&, InvariantEntry const&);
 
     bool
     finalize(
@@ -304,11 +330,10 @@ class ValidNewAccountRoot
     std::uint32_t accountSeq_ = 0;
 
 public:
+    static constexpr char const* name = "ValidNewAccountRoot";
+
     void
-    visitEntry(
-        bool,
-        std::shared_ptr<SLE const> const&,
-        std::shared_ptr<SLE const> const&);
+    visitEntry(bool, InvariantEntry const&, InvariantEntry const&);
 
     bool
     finalize(
@@ -339,11 +364,10 @@ class ValidNFTokenPage
     bool invalidSize_ = false;
 
 public:
+    static constexpr char const* name = "ValidNFTokenPage";
+
     void
-    visitEntry(
-        bool,
-        std::shared_ptr<SLE const> const&,
-        std::shared_ptr<SLE const> const&);
+    visitEntry(bool, InvariantEntry const&, InvariantEntry const&);
 
     bool
     finalize(
@@ -375,11 +399,10 @@ class NFTokenCountTracking
     std::uint32_t afterBurnedTotal = 0;
 
 public:
+    static constexpr char const* name = "NFTokenCountTracking";
+
     void
-    visitEntry(
-        bool,
-        std::shared_ptr<SLE const> const&,
-        std::shared_ptr<SLE const> const&);
+    visitEntry(bool, InvariantEntry const&, InvariantEntry const&);
 
     bool
     finalize(
@@ -403,11 +426,10 @@ class ValidClawback
     std::uint32_t trustlinesChanged = 0;
 
 public:
+    static constexpr char const* name = "ValidClawback";
+
     void
-    visitEntry(
-        bool,
-        std::shared_ptr<SLE const> const&,
-        std::shared_ptr<SLE const> const&);
+    visitEntry(bool, InvariantEntry const&, InvariantEntry const&);
 
     bool
     finalize(
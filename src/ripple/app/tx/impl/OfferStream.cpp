@@ -54,6 +54,13 @@ TOfferStreamBase<TIn, TOut>::TOfferStreamBase(
     assert(validBook_);
 }
 
+template <class TIn, class TOut>
+TOfferStreamBase<TIn, TOut>::~TOfferStreamBase()
+{
+    JLOG(j_.trace()) << "Crossing " << book_ << " consumed "
+                     << tip_.consumed() << " offers";
+}
+
 // Handle the case where a directory item with no corresponding ledger entry
 // is found. This shouldn't happen but if it does we clean it up.
 template <class TIn, class TOut>
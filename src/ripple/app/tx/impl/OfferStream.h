@@ -98,7 +98,7 @@ public:
         StepCounter& counter,
         beast::Journal journal);
 
-    virtual ~TOfferStreamBase() = default;
+    virtual ~TOfferStreamBase();
 
     /** Returns the offer at the tip of the order book.
         Offers are always presented in decreasing quality.
@@ -125,6 +125,15 @@ public:
     {
         return *ownerFunds_;
     }
+
+    /** Returns how many offers this stream has stepped onto.
+        This counts the offers it removed along with those it presented.
+    */
+    std::uint32_t
+    offersConsumed() const
+    {
+        return tip_.consumed();
+    }
 };
 
 /** Presents and consumes the offers in an order book.
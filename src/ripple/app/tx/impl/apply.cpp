@@ -21,6 +21,8 @@
 #include <ripple/app/tx/apply.h>
 #include <ripple/app/tx/applySteps.h>
 #include <ripple/basics/Log.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/ledger/CachedSLEs.h>
 #include <ripple/protocol/Feature.h>
 
 namespace ripple {
@@ -85,6 +87,44 @@ checkValidity(
     return {Validity::Valid, ""};
 }
 
+void
+checkValidity(
+    HashRouter& router,
+    std::vector<std::shared_ptr<STTx const>> const& txs,
+    Rules const& rules,
+    Config const& config,
+    JobQueue& jobQueue,
+    JobType type,
+    std::size_t workers)
+{
+    // Queueing a job costs about as much as a few checks
+    constexpr std::size_t checksPerWorker = 4;
+
+    std::vector<STTx const*> unknown;
+    for (auto const& tx : txs)
+    {
+        if (!(router.getFlags(tx->getTransactionID()) &
+              (SF_SIGBAD | SF_SIGGOOD)))
+            unknown.push_back(tx.get());
+    }
+
+    jobQueue.parallelFor(
+        type,
+        "checkValidity",
+        unknown.size(),
+        std::min(workers, unknown.size() / checksPerWorker),
+        [&](std::size_t i) {
+            try
+            {
+                checkValidity(router, *unknown[i], rules, config);
+            }
+            catch (std::exception const&)
+            {
+                // Left for the transaction's own check to report
+            }
+        });
+}
+
 void
 forceValidity(HashRouter& router, uint256 const& txid, Validity validity)
 {
@@ -113,6 +153,7 @@ apply(
     ApplyFlags flags,
     beast::Journal j)
 {
+    CachedSLEs::Scope const caller{CachedSLEs::Caller::transaction};
     STAmountSO stAmountSO{view.rules().enabled(fixSTAmountCanonicalize)};
     NumberSO stNumberSO{view.rules().enabled(fixUniversalNumber)};
 
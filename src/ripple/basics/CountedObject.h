@@ -21,7 +21,9 @@
 #define RIPPLE_BASICS_COUNTEDOBJECT_H_INCLUDED
 
 #include <ripple/beast/type_name.h>
+#include <array>
 #include <atomic>
+#include <cstddef>
 #include <string>
 #include <utility>
 #include <vector>
@@ -44,12 +46,20 @@ public:
 public:
     /** Implementation for @ref CountedObject.
 
+        The count is split over several cache lines, and each thread only
+        changes the one it was assigned. Objects made and destroyed on many
+        cores at once then do not fight over a single line. Reading sums
+        the lines, so a read concurrent with changes may be a little off.
+
         @internal
     */
     class Counter
     {
     public:
-        Counter(std::string name) noexcept : name_(std::move(name)), count_(0)
+        /** The number of cache lines a count is split over. */
+        static constexpr std::size_t slotCount = 16;
+
+        Counter(std::string name) noexcept : name_(std::move(name))
         {
             // Insert ourselves at the front of the lock-free linked list
             CountedObjects& instance = CountedObjects::getInstance();
@@ -66,22 +76,27 @@ public:
 
         ~Counter() noexcept = default;
 
-        int
+        void
         increment() noexcept
         {
-            return ++count_;
+            slots_[threadSlot()].count.fetch_add(1, std::memory_order_relaxed);
         }
 
-        int
+        void
         decrement() noexcept
         {
-            return --count_;
+            // The slot may not be the one the object was counted in, but
+            // only the sum over all slots has meaning.
+            slots_[threadSlot()].count.fetch_sub(1, std::memory_order_relaxed);
         }
 
         int
         getCount() const noexcept
         {
-            return count_.load();
+            int total = 0;
+            for (auto const& slot : slots_)
+                total += slot.count.load(std::memory_order_relaxed);
+            return total;
         }
 
         Counter*
@@ -97,8 +112,22 @@ public:
         }
 
     private:
+        struct alignas(64) Slot
+        {
+            std::atomic<int> count{0};
+        };
+
+        static std::size_t
+        threadSlot() noexcept
+        {
+            static std::atomic<std::size_t> next{0};
+            thread_local std::size_t const slot =
+                next.fetch_add(1, std::memory_order_relaxed) % slotCount;
+            return slot;
+        }
+
         std::string const name_;
-        std::atomic<int> count_;
+        std::array<Slot, slotCount> slots_;
         Counter* next_;
     };
 
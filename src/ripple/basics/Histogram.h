@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_HISTOGRAM_H_INCLUDED
+#define RIPPLE_BASICS_HISTOGRAM_H_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace ripple {
+
+/** Counts samples in buckets bounded by powers of two.
+
+    Adding a sample takes a few relaxed atomic operations and no lock,
+    so it may be done from any thread. A percentile is reported as the
+    upper bound of the bucket it falls in.
+*/
+class Histogram
+{
+public:
+    // Bucket 0 holds zero, bucket i holds [2^(i-1), 2^i) and the last
+    // bucket holds everything larger.
+    static constexpr std::size_t bucketCount = 33;
+
+    Histogram() = default;
+
+    Histogram(Histogram const& h)
+        : count_(h.count_.load())
+        , sum_(h.sum_.load())
+        , max_(h.max_.load())
+    {
+        for (std::size_t i = 0; i < bucketCount; ++i)
+            buckets_[i] = h.buckets_[i].load();
+    }
+
+    void
+    add(std::uint64_t value)
+    {
+        auto const i = std::min<std::size_t>(
+            std::bit_width(value), bucketCount - 1);
+        buckets_[i].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+
+        auto prev = max_.load(std::memory_order_relaxed);
+        while (prev < value &&
+               !max_.compare_exchange_weak(
+                   prev, value, std::memory_order_relaxed))
+            ;
+    }
+
+    std::uint64_t
+    count() const
+    {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t
+    sum() const
+    {
+        return sum_.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t
+    max() const
+    {
+        return max_.load(std::memory_order_relaxed);
+    }
+
+    /** The value below which the given percent of the samples fall. */
+    std::uint64_t
+    percentile(double percent) const
+    {
+        auto const total = count();
+        if (total == 0)
+            return 0;
+
+        auto const rank = std::max<std::uint64_t>(
+            1,
+            static_cast<std::uint64_t>(std::ceil(total * percent / 100)));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < bucketCount - 1; ++i)
+        {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= rank)
+                return std::min(
+                    i == 0 ? 0 : (std::uint64_t{1} << i) - 1, max());
+        }
+        return max();
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, bucketCount> buckets_{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,383 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_INTRUSIVEPOINTER_H_INCLUDED
+#define RIPPLE_BASICS_INTRUSIVEPOINTER_H_INCLUDED
+
+#include <ripple/basics/IntrusiveRefCounts.h>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+
+namespace ripple {
+
+template <class T>
+class WeakIntrusive;
+
+/** Tag to view a SharedIntrusive as a pointer to a related type. */
+struct StaticCastTagSharedIntrusive
+{
+};
+
+/** Tag to view a SharedIntrusive as a pointer to a derived type, if the
+    object is of that type. */
+struct DynamicCastTagSharedIntrusive
+{
+};
+
+/** A strong pointer to an object that keeps its own reference counts.
+
+    This works like std::shared_ptr, for types derived from
+    IntrusiveRefCounts. It is the size of a raw pointer and copying it
+    only touches the counts inside the object.
+*/
+template <class T>
+class SharedIntrusive
+{
+public:
+    using element_type = T;
+
+    SharedIntrusive() noexcept = default;
+
+    SharedIntrusive(std::nullptr_t) noexcept
+    {
+    }
+
+    /** Take a strong reference to p. */
+    explicit SharedIntrusive(T* p) noexcept : ptr_(p)
+    {
+        if (ptr_)
+            ptr_->addStrongRef();
+    }
+
+    SharedIntrusive(SharedIntrusive const& rhs) noexcept : ptr_(rhs.ptr_)
+    {
+        if (ptr_)
+            ptr_->addStrongRef();
+    }
+
+    template <class U>
+        requires std::convertible_to<U*, T*>
+    SharedIntrusive(SharedIntrusive<U> const& rhs) noexcept : ptr_(rhs.get())
+    {
+        if (ptr_)
+            ptr_->addStrongRef();
+    }
+
+    SharedIntrusive(SharedIntrusive&& rhs) noexcept
+        : ptr_(std::exchange(rhs.ptr_, nullptr))
+    {
+    }
+
+    template <class U>
+        requires std::convertible_to<U*, T*>
+    SharedIntrusive(SharedIntrusive<U>&& rhs) noexcept
+        : ptr_(std::exchange(rhs.ptr_, nullptr))
+    {
+    }
+
+    template <class U>
+    SharedIntrusive(
+        SharedIntrusive<U> const& rhs,
+        StaticCastTagSharedIntrusive) noexcept
+        : ptr_(static_cast<T*>(rhs.get()))
+    {
+        if (ptr_)
+            ptr_->addStrongRef();
+    }
+
+    template <class U>
+    SharedIntrusive(
+        SharedIntrusive<U>&& rhs,
+        StaticCastTagSharedIntrusive) noexcept
+        : ptr_(static_cast<T*>(std::exchange(rhs.ptr_, nullptr)))
+    {
+    }
+
+    template <class U>
+    SharedIntrusive(
+        SharedIntrusive<U> const& rhs,
+        DynamicCastTagSharedIntrusive) noexcept
+        : ptr_(dynamic_cast<T*>(rhs.get()))
+    {
+        if (ptr_)
+            ptr_->addStrongRef();
+    }
+
+    ~SharedIntrusive()
+    {
+        release();
+    }
+
+    SharedIntrusive&
+    operator=(SharedIntrusive const& rhs) noexcept
+    {
+        SharedIntrusive(rhs).swap(*this);
+        return *this;
+    }
+
+    SharedIntrusive&
+    operator=(SharedIntrusive&& rhs) noexcept
+    {
+        SharedIntrusive(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    template <class U>
+        requires std::convertible_to<U*, T*>
+    SharedIntrusive&
+    operator=(SharedIntrusive<U> const& rhs) noexcept
+    {
+        SharedIntrusive(rhs).swap(*this);
+        return *this;
+    }
+
+    template <class U>
+        requires std::convertible_to<U*, T*>
+    SharedIntrusive&
+    operator=(SharedIntrusive<U>&& rhs) noexcept
+    {
+        SharedIntrusive(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    void
+    reset() noexcept
+    {
+        SharedIntrusive().swap(*this);
+    }
+
+    void
+    swap(SharedIntrusive& rhs) noexcept
+    {
+        std::swap(ptr_, rhs.ptr_);
+    }
+
+    T*
+    get() const noexcept
+    {
+        return ptr_;
+    }
+
+    T&
+    operator*() const noexcept
+    {
+        return *ptr_;
+    }
+
+    T*
+    operator->() const noexcept
+    {
+        return ptr_;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return ptr_ != nullptr;
+    }
+
+    std::size_t
+    use_count() const noexcept
+    {
+        return ptr_ ? ptr_->use_count() : 0;
+    }
+
+private:
+    template <class U>
+    friend class SharedIntrusive;
+
+    friend class WeakIntrusive<T>;
+
+    struct AdoptTag
+    {
+    };
+
+    // Take over a strong reference that was already counted
+    SharedIntrusive(T* p, AdoptTag) noexcept : ptr_(p)
+    {
+    }
+
+    void
+    release() noexcept
+    {
+        if (!ptr_)
+            return;
+
+        switch (ptr_->releaseStrongRef())
+        {
+            case ReleaseStrongRefAction::noop:
+                break;
+            case ReleaseStrongRefAction::destroy:
+                delete ptr_;
+                break;
+            case ReleaseStrongRefAction::partialDestroy:
+                ptr_->partialDestructor();
+                if (ptr_->partialDestructorFinished())
+                    delete ptr_;
+                break;
+        }
+
+        ptr_ = nullptr;
+    }
+
+    T* ptr_ = nullptr;
+};
+
+template <class T, class U>
+bool
+operator==(SharedIntrusive<T> const& lhs, SharedIntrusive<U> const& rhs)
+{
+    return lhs.get() == rhs.get();
+}
+
+template <class T>
+bool
+operator==(SharedIntrusive<T> const& lhs, std::nullptr_t)
+{
+    return lhs.get() == nullptr;
+}
+
+/** Make an object and return a strong pointer to it. */
+template <class T, class... Args>
+SharedIntrusive<T>
+make_SharedIntrusive(Args&&... args)
+{
+    return SharedIntrusive<T>(new T(std::forward<Args>(args)...));
+}
+
+template <class T, class U>
+SharedIntrusive<T>
+static_pointer_cast(SharedIntrusive<U> const& p)
+{
+    return SharedIntrusive<T>(p, StaticCastTagSharedIntrusive{});
+}
+
+template <class T, class U>
+SharedIntrusive<T>
+static_pointer_cast(SharedIntrusive<U>&& p)
+{
+    return SharedIntrusive<T>(std::move(p), StaticCastTagSharedIntrusive{});
+}
+
+template <class T, class U>
+SharedIntrusive<T>
+dynamic_pointer_cast(SharedIntrusive<U> const& p)
+{
+    return SharedIntrusive<T>(p, DynamicCastTagSharedIntrusive{});
+}
+
+//------------------------------------------------------------------------------
+
+/** A weak pointer to an object that keeps its own reference counts.
+
+    This works like std::weak_ptr: it does not keep the object alive, but
+    a strong pointer can be had from it for as long as the object is.
+*/
+template <class T>
+class WeakIntrusive
+{
+public:
+    WeakIntrusive() noexcept = default;
+
+    WeakIntrusive(SharedIntrusive<T> const& rhs) noexcept : ptr_(rhs.get())
+    {
+        if (ptr_)
+            ptr_->addWeakRef();
+    }
+
+    WeakIntrusive(WeakIntrusive const& rhs) noexcept : ptr_(rhs.ptr_)
+    {
+        if (ptr_)
+            ptr_->addWeakRef();
+    }
+
+    WeakIntrusive(WeakIntrusive&& rhs) noexcept
+        : ptr_(std::exchange(rhs.ptr_, nullptr))
+    {
+    }
+
+    ~WeakIntrusive()
+    {
+        release();
+    }
+
+    WeakIntrusive&
+    operator=(WeakIntrusive const& rhs) noexcept
+    {
+        WeakIntrusive(rhs).swap(*this);
+        return *this;
+    }
+
+    WeakIntrusive&
+    operator=(WeakIntrusive&& rhs) noexcept
+    {
+        WeakIntrusive(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    WeakIntrusive&
+    operator=(SharedIntrusive<T> const& rhs) noexcept
+    {
+        WeakIntrusive(rhs).swap(*this);
+        return *this;
+    }
+
+    void
+    reset() noexcept
+    {
+        WeakIntrusive().swap(*this);
+    }
+
+    void
+    swap(WeakIntrusive& rhs) noexcept
+    {
+        std::swap(ptr_, rhs.ptr_);
+    }
+
+    /** Return a strong pointer, or null if the object is gone. */
+    SharedIntrusive<T>
+    lock() const noexcept
+    {
+        if (ptr_ && ptr_->checkoutStrongRefFromWeak())
+            return SharedIntrusive<T>(
+                ptr_, typename SharedIntrusive<T>::AdoptTag{});
+        return {};
+    }
+
+    bool
+    expired() const noexcept
+    {
+        return !ptr_ || ptr_->expired();
+    }
+
+private:
+    void
+    release() noexcept
+    {
+        if (ptr_ && ptr_->releaseWeakRef() == ReleaseWeakRefAction::destroy)
+            delete ptr_;
+        ptr_ = nullptr;
+    }
+
+    T* ptr_ = nullptr;
+};
+
+}  // namespace ripple
+
+#endif
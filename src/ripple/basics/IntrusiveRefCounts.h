@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_INTRUSIVEREFCOUNTS_H_INCLUDED
+#define RIPPLE_BASICS_INTRUSIVEREFCOUNTS_H_INCLUDED
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+
+namespace ripple {
+
+/** What the owner of the last strong reference must do. */
+enum class ReleaseStrongRefAction { noop, partialDestroy, destroy };
+
+/** What the owner of the last weak reference must do. */
+enum class ReleaseWeakRefAction { noop, destroy };
+
+/** Strong and weak reference counts kept inside the object they count.
+
+    Objects deriving from this are owned through SharedIntrusive and
+    observed through WeakIntrusive. Unlike std::shared_ptr, there is no
+    separate control block: a pointer is one word and both counts share
+    a single atomic inside the object.
+
+    When the last strong reference goes away while weak references remain,
+    the object's `partialDestructor()` member is called so that it can
+    release whatever it owns. The memory itself is freed by whoever drops
+    the last reference of either kind, once the partial destruction is
+    complete.
+
+    @note A derived class that is deleted through a pointer to one of its
+          bases must give that base a virtual destructor.
+*/
+class IntrusiveRefCounts
+{
+public:
+    IntrusiveRefCounts(IntrusiveRefCounts const&) = delete;
+    IntrusiveRefCounts&
+    operator=(IntrusiveRefCounts const&) = delete;
+
+    void
+    addStrongRef() const noexcept
+    {
+        refCounts_.fetch_add(strongDelta, std::memory_order_relaxed);
+    }
+
+    void
+    addWeakRef() const noexcept
+    {
+        refCounts_.fetch_add(weakDelta, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] ReleaseStrongRefAction
+    releaseStrongRef() const noexcept
+    {
+        auto const prev =
+            refCounts_.fetch_sub(strongDelta, std::memory_order_acq_rel);
+        assert((prev & strongMask) != 0);
+
+        if ((prev & strongMask) != strongDelta)
+            return ReleaseStrongRefAction::noop;
+
+        if ((prev & weakMask) == 0)
+            return ReleaseStrongRefAction::destroy;
+
+        return ReleaseStrongRefAction::partialDestroy;
+    }
+
+    [[nodiscard]] ReleaseWeakRefAction
+    releaseWeakRef() const noexcept
+    {
+        auto const prev =
+            refCounts_.fetch_sub(weakDelta, std::memory_order_acq_rel);
+        assert((prev & weakMask) != 0);
+
+        if (((prev & weakMask) != weakDelta) || ((prev & strongMask) != 0))
+            return ReleaseWeakRefAction::noop;
+
+        // If the partial destruction is still running, the thread running
+        // it frees the object when it is done.
+        if ((prev & partialDestroyedBit) == 0)
+            return ReleaseWeakRefAction::noop;
+
+        return ReleaseWeakRefAction::destroy;
+    }
+
+    /** Record that the partial destructor has run.
+
+        @return true if no weak references are left, in which case the
+                caller must free the object.
+    */
+    [[nodiscard]] bool
+    partialDestructorFinished() const noexcept
+    {
+        auto const prev = refCounts_.fetch_or(
+            partialDestroyedBit, std::memory_order_acq_rel);
+        assert((prev & strongMask) == 0);
+        assert((prev & partialDestroyedBit) == 0);
+        return (prev & weakMask) == 0;
+    }
+
+    /** Add a strong reference if the object still has one.
+
+        @return false if the object has no strong references left.
+    */
+    [[nodiscard]] bool
+    checkoutStrongRefFromWeak() const noexcept
+    {
+        auto cur = refCounts_.load(std::memory_order_acquire);
+        while ((cur & strongMask) != 0)
+        {
+            if (refCounts_.compare_exchange_weak(
+                    cur, cur + strongDelta, std::memory_order_acq_rel))
+                return true;
+        }
+        return false;
+    }
+
+    bool
+    expired() const noexcept
+    {
+        return (refCounts_.load(std::memory_order_acquire) & strongMask) == 0;
+    }
+
+    std::size_t
+    use_count() const noexcept
+    {
+        return refCounts_.load(std::memory_order_acquire) & strongMask;
+    }
+
+protected:
+    IntrusiveRefCounts() noexcept = default;
+    ~IntrusiveRefCounts() = default;
+
+private:
+    // The strong count is in the low 32 bits, the weak count in the next
+    // 31, and the top bit is set once the partial destructor has run.
+    static constexpr std::uint64_t strongDelta = 1;
+    static constexpr std::uint64_t strongMask = 0xffffffffULL;
+    static constexpr std::uint64_t weakDelta = 1ULL << 32;
+    static constexpr std::uint64_t weakMask = 0x7fffffffULL << 32;
+    static constexpr std::uint64_t partialDestroyedBit = 1ULL << 63;
+
+    mutable std::atomic<std::uint64_t> refCounts_{0};
+};
+
+}  // namespace ripple
+
+#endif
@@ -24,10 +24,15 @@
 #include <ripple/beast/utility/Journal.h>
 #include <boost/beast/core/string.hpp>
 #include <boost/filesystem.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace ripple {
 
@@ -146,6 +151,10 @@ private:
         }
         /** @} */
 
+        /** Write out anything buffered. */
+        void
+        flush();
+
     private:
         std::unique_ptr<std::ofstream> m_stream;
         boost::filesystem::path m_path;
@@ -160,6 +169,18 @@ private:
     beast::severities::Severity thresh_;
     File file_;
     bool silent_ = false;
+    std::atomic<bool> json_ = false;
+
+    // Lines formatted by the callers of write, waiting for the writer
+    // thread. Only used once writeAsync has been called.
+    std::atomic<bool> async_ = false;
+    std::mutex queueMutex_;
+    std::condition_variable queueCond_;
+    std::vector<std::string> queue_;
+    std::size_t queueLimit_ = 0;
+    bool stopping_ = false;
+    std::atomic<std::uint64_t> dropped_ = 0;
+    std::thread writer_;
 
 public:
     Logs(beast::severities::Severity level);
@@ -168,7 +189,7 @@ public:
     Logs&
     operator=(Logs const&) = delete;
 
-    virtual ~Logs() = default;
+    virtual ~Logs();
 
     bool
     open(boost::filesystem::path const& pathToLogFile);
@@ -201,6 +222,32 @@ public:
     std::string
     rotate();
 
+    /** Write lines from a background thread rather than the caller's.
+
+        write then only formats the line and queues it. The writer thread
+        takes all the lines queued at once, and writes and flushes them
+        together. When the queue is full, lines below warning are dropped
+        and counted, so that callers never wait on the file.
+
+        @param queueLimit The most lines that may wait to be written.
+    */
+    void
+    writeAsync(std::size_t queueLimit);
+
+    /** The number of lines dropped because the queue was full. */
+    std::uint64_t
+    dropped() const
+    {
+        return dropped_;
+    }
+
+    /** Set whether lines are written as JSON objects, one per line. */
+    void
+    json(bool json)
+    {
+        json_ = json;
+    }
+
     /**
      * Set flag to write logs to stderr (false) or not (true).
      *
@@ -242,7 +289,15 @@ private:
         std::string& output,
         std::string const& message,
         beast::severities::Severity severity,
-        std::string const& partition);
+        std::string const& partition,
+        bool json = false);
+
+    // Write lines to the file and the console
+    void
+    writeLines(std::vector<std::string> const& lines);
+
+    void
+    runWriter();
 };
 
 // Wraps a Journal::Stream to skip evaluation of
@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_PERFCOST_H_INCLUDED
+#define RIPPLE_BASICS_PERFCOST_H_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace ripple {
+namespace perf {
+
+/** The resources a thread used over a span of its work. */
+struct Cost
+{
+    /// CPU time used by the thread
+    std::chrono::microseconds cpu{0};
+    /// Number of nodestore fetches the thread made
+    std::uint64_t fetches = 0;
+    /// Time the thread spent waiting in those fetches. The CPU time it
+    /// used in them is already in cpu, and is not counted again here.
+    std::chrono::microseconds fetchTime{0};
+};
+
+/** Return the CPU time the calling thread has used, if it can be told. */
+std::chrono::microseconds
+threadCpuTime() noexcept;
+
+/** Count a nodestore fetch made by the calling thread.
+
+    @param elapsed The wall time the fetch took.
+    @param cpu The CPU time the thread used in it.
+*/
+void
+onFetch(
+    std::chrono::microseconds elapsed,
+    std::chrono::microseconds cpu) noexcept;
+
+/** Measures the resources the calling thread uses during a scope.
+
+    Only the thread which created the meter is measured. If the work
+    moves to another thread, as when a coroutine resumes elsewhere,
+    what the threads did in between can't be told apart from it, so
+    nothing is reported.
+*/
+class CostMeter
+{
+public:
+    CostMeter() noexcept;
+
+    CostMeter(CostMeter const&) = delete;
+    CostMeter&
+    operator=(CostMeter const&) = delete;
+
+    /** Return what the thread used since the meter was created. */
+    Cost
+    elapsed() const noexcept;
+
+private:
+    std::thread::id const thread_;
+    Cost const start_;
+};
+
+}  // namespace perf
+}  // namespace ripple
+
+#endif
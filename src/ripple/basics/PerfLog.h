@@ -55,6 +55,7 @@ public:
     using seconds = std::chrono::seconds;
     using milliseconds = std::chrono::milliseconds;
     using microseconds = std::chrono::microseconds;
+    using nanoseconds = std::chrono::nanoseconds;
 
     /**
      * Configuration from [perf] section of rippled.cfg.
@@ -66,6 +67,21 @@ public:
         milliseconds logInterval{seconds(1)};
     };
 
+    /**
+     * Where the time of one RPC call went.
+     */
+    struct RpcTimes
+    {
+        // From the request being read until a thread picks it up
+        microseconds queue{0};
+        // Looking up the ledgers the request names
+        microseconds ledger{0};
+        // Running the method, less the ledger lookups
+        microseconds handler{0};
+        // Rendering the response
+        microseconds serialize{0};
+    };
+
     virtual ~PerfLog() = default;
 
     virtual void
@@ -105,6 +121,15 @@ public:
     virtual void
     rpcError(std::string const& method, std::uint64_t requestId) = 0;
 
+    /**
+     * Log where the time of an RPC call went
+     *
+     * @param method RPC command
+     * @param times Time spent in each phase of the call
+     */
+    virtual void
+    rpcTimes(std::string const& method, RpcTimes const& times) = 0;
+
     /**
      * Log queued job
      *
@@ -138,6 +163,16 @@ public:
     virtual void
     jobFinish(JobType const type, microseconds dur, int instance) = 0;
 
+    /**
+     * Log an invariant checker's run over one transaction
+     *
+     * @param name Invariant checker
+     * @param dur Time spent visiting entries and finalizing
+     * @param passed Whether the transaction passed the check
+     */
+    virtual void
+    invariantCheck(char const* name, nanoseconds dur, bool passed) = 0;
+
     /**
      * Render performance counters in Json
      *
@@ -146,6 +181,14 @@ public:
     virtual Json::Value
     countersJson() const = 0;
 
+    /**
+     * Render the latency percentiles of each phase of RPC calls in Json
+     *
+     * @return Latency Json object, by method
+     */
+    virtual Json::Value
+    rpcLatencyJson() const = 0;
+
     /**
      * Render currently executing jobs and RPC calls and durations in Json
      *
@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_PERFTRACE_H_INCLUDED
+#define RIPPLE_BASICS_PERFTRACE_H_INCLUDED
+
+#include <ripple/json/json_value.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace ripple {
+namespace perf {
+
+/** Records timed events on the threads that run them, for timeline views.
+
+    Each thread writes to a ring of its own, so recording takes no lock
+    and is a few relaxed stores. When tracing is off, a traced scope costs
+    one relaxed load. The rings only hold the most recent events of each
+    thread; older ones are overwritten.
+
+    Names and categories are not copied, so they must outlive the trace:
+    string literals, or strings that live as long as the process.
+
+    The events are exported in the Chrome trace event format, which
+    chrome://tracing and Perfetto open directly.
+*/
+namespace trace {
+
+using clock_type = std::chrono::steady_clock;
+
+namespace detail {
+extern std::atomic<bool> enabled;
+}  // namespace detail
+
+/** The number of events each thread's ring holds. */
+constexpr std::size_t eventsPerThread = 16384;
+
+/** Whether events are being recorded. */
+inline bool
+enabled() noexcept
+{
+    return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/** Start recording. Events recorded before this are no longer exported. */
+void
+start();
+
+/** Stop recording. The events recorded so far can still be exported. */
+void
+stop();
+
+/** Record an event that ran over a span of time.
+
+    @param category The subsystem the event belongs to.
+    @param name What ran.
+    @param begin When it started.
+    @param end When it finished.
+    @param argName If not null, the name of a value shown with the event.
+    @param arg The value shown with the event.
+*/
+void
+complete(
+    char const* category,
+    char const* name,
+    clock_type::time_point begin,
+    clock_type::time_point end,
+    char const* argName = nullptr,
+    std::int64_t arg = 0);
+
+/** Record an event that happened at a moment. */
+void
+instant(
+    char const* category,
+    char const* name,
+    char const* argName = nullptr,
+    std::int64_t arg = 0);
+
+/** Render the events recorded since tracing started as a Chrome trace. */
+Json::Value
+toJson();
+
+/** Records the lifetime of a scope as one event, if tracing is on. */
+class Scope
+{
+public:
+    Scope(
+        char const* category,
+        char const* name,
+        char const* argName = nullptr,
+        std::int64_t arg = 0) noexcept
+        : category_(category)
+        , name_(name)
+        , argName_(argName)
+        , arg_(arg)
+        , begin_(enabled() ? clock_type::now() : clock_type::time_point{})
+    {
+    }
+
+    ~Scope()
+    {
+        if (begin_ != clock_type::time_point{} && enabled())
+            complete(
+                category_, name_, begin_, clock_type::now(), argName_, arg_);
+    }
+
+    Scope(Scope const&) = delete;
+    Scope&
+    operator=(Scope const&) = delete;
+
+private:
+    char const* const category_;
+    char const* const name_;
+    char const* const argName_;
+    std::int64_t const arg_;
+    clock_type::time_point const begin_;
+};
+
+}  // namespace trace
+}  // namespace perf
+}  // namespace ripple
+
+#endif
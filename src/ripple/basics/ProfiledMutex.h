@@ -0,0 +1,238 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_PROFILEDMUTEX_H_INCLUDED
+#define RIPPLE_BASICS_PROFILEDMUTEX_H_INCLUDED
+
+#include <ripple/basics/ThreadSafetyAnalysis.h>
+#include <ripple/beast/insight/Collector.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+/** The wait and hold times of every mutex which shares a name.
+
+    Sharded locks share one profile, so it shows the cost of the
+    subsystem's locking rather than of one shard.
+*/
+class LockProfile
+{
+public:
+    struct Counts
+    {
+        /// Number of times the lock was taken
+        std::uint64_t acquisitions = 0;
+        /// Number of those times it was held by another thread
+        std::uint64_t contentions = 0;
+        /// Total and longest time spent waiting for the lock
+        std::chrono::nanoseconds wait{0};
+        std::chrono::nanoseconds maxWait{0};
+        /// Total time the lock was held
+        std::chrono::nanoseconds hold{0};
+    };
+
+    LockProfile() = default;
+    LockProfile(LockProfile const&) = delete;
+    LockProfile&
+    operator=(LockProfile const&) = delete;
+
+    void
+    onAcquire(std::chrono::nanoseconds wait, bool contended) noexcept;
+
+    void
+    onRelease(std::chrono::nanoseconds held) noexcept;
+
+    Counts
+    counts() const noexcept;
+
+private:
+    std::atomic<std::uint64_t> acquisitions_{0};
+    std::atomic<std::uint64_t> contentions_{0};
+    std::atomic<std::uint64_t> waitNs_{0};
+    std::atomic<std::uint64_t> maxWaitNs_{0};
+    std::atomic<std::uint64_t> holdNs_{0};
+};
+
+/** Manages the profiles of all profiled mutexes. */
+class LockProfiles
+{
+public:
+    using Entry = std::pair<std::string, LockProfile::Counts>;
+    using List = std::vector<Entry>;
+
+    static LockProfiles&
+    getInstance() noexcept;
+
+    /** Return the profile of the locks with a name, creating it if needed.
+
+        The profile lives as long as the program.
+    */
+    LockProfile&
+    get(std::string const& name);
+
+    /** Return the counts of every profile, ordered by name. */
+    List
+    getCounts() const;
+
+private:
+    LockProfiles() = default;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, LockProfile> profiles_;
+};
+
+/** Exports the profile of each named lock as insight gauges. */
+class LockGauges
+{
+public:
+    explicit LockGauges(beast::insight::Collector::ptr const& collector);
+
+    LockGauges(LockGauges const&) = delete;
+    LockGauges&
+    operator=(LockGauges const&) = delete;
+
+private:
+    struct Gauges
+    {
+        beast::insight::Gauge acquisitions;
+        beast::insight::Gauge contentions;
+        beast::insight::Gauge waitUs;
+        beast::insight::Gauge holdUs;
+    };
+
+    void
+    collect_metrics();
+
+    beast::insight::Collector::ptr const collector_;
+    // Only touched by the hook, which the collector calls on one thread
+    std::map<std::string, Gauges> gauges_;
+    // Declared last so that no gauge is used before it is constructed
+    beast::insight::Hook hook_;
+};
+
+#ifdef RIPPLE_PROFILE_LOCKS
+
+/** A mutex which records how long it is waited for and held.
+
+    Every mutex constructed with the same name adds to one LockProfile.
+    Taking the lock costs two reads of the steady clock more than the
+    plain mutex, and the counters of a profile are shared by all of its
+    mutexes, so this is meant for diagnostic builds.
+
+    Built without RIPPLE_PROFILE_LOCKS, this is the plain mutex and the
+    name is ignored.
+
+    @tparam Mutex std::mutex or std::recursive_mutex.
+*/
+template <class Mutex>
+class CAPABILITY("mutex") ProfiledMutex
+{
+public:
+    explicit ProfiledMutex(std::string const& name)
+        : profile_(LockProfiles::getInstance().get(name))
+    {
+    }
+
+    ProfiledMutex(ProfiledMutex const&) = delete;
+    ProfiledMutex&
+    operator=(ProfiledMutex const&) = delete;
+
+    void
+    lock() ACQUIRE()
+    {
+        if (mutex_.try_lock())
+            return acquired({}, false);
+
+        auto const start = clock_type::now();
+        mutex_.lock();
+        acquired(clock_type::now() - start, true);
+    }
+
+    bool
+    try_lock() TRY_ACQUIRE(true)
+    {
+        if (!mutex_.try_lock())
+            return false;
+        acquired({}, false);
+        return true;
+    }
+
+    void
+    unlock() RELEASE()
+    {
+        if (--depth_ == 0)
+            profile_.onRelease(clock_type::now() - heldSince_);
+        mutex_.unlock();
+    }
+
+private:
+    using clock_type = std::chrono::steady_clock;
+
+    // Called with the lock held. A recursive mutex is only counted when
+    // its owner first takes it.
+    void
+    acquired(clock_type::duration wait, bool contended)
+    {
+        if (depth_++ != 0)
+            return;
+        heldSince_ = clock_type::now();
+        profile_.onAcquire(wait, contended);
+    }
+
+    Mutex mutex_;
+    LockProfile& profile_;
+    std::size_t depth_ = 0;
+    clock_type::time_point heldSince_;
+};
+
+/** The condition variable to wait on a ProfiledMutex with. */
+using ProfiledConditionVariable = std::condition_variable_any;
+
+/** The lock to wait on a ProfiledConditionVariable with. */
+template <class Mutex>
+using ProfiledUniqueLock = std::unique_lock<ProfiledMutex<Mutex>>;
+
+#else
+
+template <class Mutex>
+class CAPABILITY("mutex") ProfiledMutex : public Mutex
+{
+public:
+    explicit ProfiledMutex(std::string const&) noexcept
+    {
+    }
+};
+
+using ProfiledConditionVariable = std::condition_variable;
+
+template <class Mutex>
+using ProfiledUniqueLock = std::unique_lock<Mutex>;
+
+#endif
+
+}  // namespace ripple
+
+#endif
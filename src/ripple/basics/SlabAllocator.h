@@ -20,6 +20,7 @@
 #ifndef RIPPLE_BASICS_SLABALLOCATOR_H_INCLUDED
 #define RIPPLE_BASICS_SLABALLOCATOR_H_INCLUDED
 
+#include <ripple/basics/ByteUtilities.h>
 #include <ripple/beast/type_name.h>
 
 #include <boost/align.hpp>
@@ -27,11 +28,13 @@
 #include <boost/predef.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <cstring>
 #include <mutex>
+#include <vector>
 
 #if BOOST_OS_LINUX
 #include <sys/mman.h>
@@ -39,6 +42,14 @@
 
 namespace ripple {
 
+/** Allocates objects of a fixed size from large slabs of memory.
+
+    Each thread keeps a small magazine of free items for each allocator,
+    so that most allocations and frees don't need to take a slab's lock.
+    An empty magazine is refilled from the slabs, and a full one returns
+    half of its items to them, in a batch each time. A thread's magazines
+    go back to the slabs when the thread exits.
+*/
 template <typename Type>
 class SlabAllocator
 {
@@ -66,6 +77,10 @@ class SlabAllocator
         // The extent of the underlying memory block:
         std::size_t const size_;
 
+        // The number of items the block holds, and of those that are free:
+        std::size_t capacity_ = 0;
+        std::size_t free_ = 0;
+
         SlabBlock(
             SlabBlock* next,
             std::uint8_t* data,
@@ -83,7 +98,10 @@ class SlabAllocator
                 std::memcpy(data, &l_, sizeof(std::uint8_t*));
                 l_ = data;
                 data += item;
+                ++capacity_;
             }
+
+            free_ = capacity_;
         }
 
         ~SlabBlock()
@@ -123,12 +141,43 @@ class SlabAllocator
                     // Use memcpy to avoid unaligned UB
                     // (will optimize to equivalent code)
                     std::memcpy(&l_, ret, sizeof(std::uint8_t*));
+                    --free_;
                 }
             }
 
             return ret;
         }
 
+        /** Take up to `count` items off the freelist at once.
+
+            @return the number of items stored in `items`.
+         */
+        std::size_t
+        allocate(std::uint8_t** items, std::size_t count) noexcept
+        {
+            std::lock_guard l(m_);
+
+            std::size_t n = 0;
+
+            while (n != count && l_)
+            {
+                items[n] = l_;
+                std::memcpy(&l_, items[n], sizeof(std::uint8_t*));
+                ++n;
+            }
+
+            free_ -= n;
+            return n;
+        }
+
+        /** Returns the number of items that are not on the freelist. */
+        std::size_t
+        used() noexcept
+        {
+            std::lock_guard l(m_);
+            return capacity_ - free_;
+        }
+
         /** Return an item to this allocator's freelist.
 
             @param ptr The pointer to the chunk of memory being deallocated.
@@ -149,9 +198,77 @@ class SlabAllocator
             // (will optimize to equivalent code)
             std::memcpy(ptr, &l_, sizeof(std::uint8_t*));
             l_ = ptr;
+            ++free_;
+        }
+    };
+
+    // The most items a thread keeps for each allocator:
+    static constexpr std::size_t magazineSize = 32;
+
+    // The most allocators for a type that get magazines:
+    static constexpr std::size_t maxMagazines = 16;
+
+    /** Free items that a thread keeps for one allocator. */
+    struct Magazine
+    {
+        std::size_t count = 0;
+
+        // Allocations made without a lock, not yet added to the allocator's
+        std::uint64_t hits = 0;
+
+        std::array<std::uint8_t*, magazineSize> items;
+        std::array<SlabBlock*, magazineSize> slabs;
+
+        /** Return items from the top of the magazine to their slabs. */
+        void
+        flush(std::size_t n) noexcept
+        {
+            assert(n <= count);
+
+            while (n-- != 0)
+            {
+                --count;
+                slabs[count]->deallocate(items[count]);
+            }
         }
     };
 
+    /** A thread's magazines for all the allocators of this type.
+
+        Slabs are never freed, so these can go back to them even after the
+        allocators they came from are gone. Items that the thread frees
+        after that, as it exits, go straight back to their slabs.
+     */
+    struct Magazines
+    {
+        std::array<Magazine, maxMagazines> magazines;
+
+        ~Magazines()
+        {
+            for (auto& m : magazines)
+                m.flush(m.count);
+            magazinesGone_ = true;
+        }
+    };
+
+    static inline thread_local Magazines magazines_;
+
+    // Set once this thread's magazines are destroyed. It has no destructor,
+    // so it can still be read by frees that run later as the thread exits.
+    static inline thread_local bool magazinesGone_ = false;
+
+    /** This allocator's magazine for this thread, if it can use one. */
+    Magazine*
+    magazine() const noexcept
+    {
+        if (magazine_ >= maxMagazines || magazinesGone_)
+            return nullptr;
+        return &magazines_.magazines[magazine_];
+    }
+
+    // Hands out the magazine slots to allocators of this type:
+    static inline std::atomic<std::size_t> nextMagazine_ = 0;
+
 private:
     // A linked list of slabs
     std::atomic<SlabBlock*> slabs_ = nullptr;
@@ -166,6 +283,99 @@ private:
     // The size of each individual slab:
     std::size_t const slabSize_;
 
+    // This allocator's slot in each thread's magazines, if it has one:
+    std::size_t const magazine_;
+
+    // Allocations that the magazines satisfied without a lock:
+    std::atomic<std::uint64_t> magazineHits_ = 0;
+
+    /** Allocate and link a new slab, returning it or nullptr. */
+    SlabBlock*
+    addSlab() noexcept
+    {
+        std::size_t size = slabSize_;
+
+        // We want to allocate the memory at a 2 MiB boundary, to make it
+        // possible to use hugepage mappings on Linux:
+        auto buf =
+            boost::alignment::aligned_alloc(megabytes(std::size_t(2)), size);
+
+        // clang-format off
+        if (!buf) [[unlikely]]
+            return nullptr;
+            // clang-format on
+
+#if BOOST_OS_LINUX
+        // When allocating large blocks, attempt to leverage Linux's
+        // transparent hugepage support. It is unclear and difficult
+        // to accurately determine if doing this impacts performance
+        // enough to justify using platform-specific tricks.
+        if (size >= megabytes(std::size_t(4)))
+            madvise(buf, size, MADV_HUGEPAGE);
+#endif
+
+        // We need to carve out a bit of memory for the slab header
+        // and then align the rest appropriately:
+        auto slabData = reinterpret_cast<void*>(
+            reinterpret_cast<std::uint8_t*>(buf) + sizeof(SlabBlock));
+        auto slabSize = size - sizeof(SlabBlock);
+
+        // This operation is essentially guaranteed not to fail but
+        // let's be careful anyways.
+        if (!boost::alignment::align(
+                itemAlignment_, itemSize_, slabData, slabSize))
+        {
+            boost::alignment::aligned_free(buf);
+            return nullptr;
+        }
+
+        auto slab = new (buf) SlabBlock(
+            slabs_.load(),
+            reinterpret_cast<std::uint8_t*>(slabData),
+            slabSize,
+            itemSize_);
+
+        // Link the new slab
+        while (!slabs_.compare_exchange_weak(
+            slab->next_,
+            slab,
+            std::memory_order_release,
+            std::memory_order_relaxed))
+        {
+            ;  // Nothing to do
+        }
+
+        return slab;
+    }
+
+    /** Fill half of an empty magazine from the slabs. */
+    void
+    refill(Magazine& m) noexcept
+    {
+        assert(m.count == 0);
+
+        magazineHits_.fetch_add(m.hits, std::memory_order_relaxed);
+        m.hits = 0;
+
+        auto take = [&m](SlabBlock* slab) {
+            auto const n = slab->allocate(
+                m.items.data() + m.count, magazineSize / 2 - m.count);
+            std::fill_n(m.slabs.begin() + m.count, n, slab);
+            m.count += n;
+        };
+
+        for (auto slab = slabs_.load();
+             slab != nullptr && m.count != magazineSize / 2;
+             slab = slab->next_)
+            take(slab);
+
+        if (m.count == 0)
+        {
+            if (auto slab = addSlab())
+                take(slab);
+        }
+    }
+
 public:
     /** Constructs a slab allocator able to allocate objects of a fixed size
 
@@ -175,7 +385,7 @@ public:
                      contexts (e.g. when mimimal memory usage is needed) and
                      allows for graceful failure.
      */
-    constexpr explicit SlabAllocator(
+    explicit SlabAllocator(
         std::size_t extra,
         std::size_t alloc = 0,
         std::size_t align = 0)
@@ -183,6 +393,7 @@ public:
         , itemSize_(
               boost::alignment::align_up(sizeof(Type) + extra, itemAlignment_))
         , slabSize_(alloc)
+        , magazine_(nextMagazine_++)
     {
         assert((itemAlignment_ & (itemAlignment_ - 1)) == 0);
     }
@@ -217,6 +428,24 @@ public:
     std::uint8_t*
     allocate() noexcept
     {
+        if (auto const mp = magazine())
+        {
+            auto& m = *mp;
+
+            if (m.count != 0)
+            {
+                ++m.hits;
+                return m.items[--m.count];
+            }
+
+            refill(m);
+
+            if (m.count != 0)
+                return m.items[--m.count];
+
+            return nullptr;
+        }
+
         auto slab = slabs_.load();
 
         while (slab != nullptr)
@@ -229,59 +458,10 @@ public:
 
         // No slab can satisfy our request, so we attempt to allocate a new
         // one here:
-        std::size_t size = slabSize_;
-
-        // We want to allocate the memory at a 2 MiB boundary, to make it
-        // possible to use hugepage mappings on Linux:
-        auto buf =
-            boost::alignment::aligned_alloc(megabytes(std::size_t(2)), size);
-
-        // clang-format off
-        if (!buf) [[unlikely]]
-            return nullptr;
-            // clang-format on
-
-#if BOOST_OS_LINUX
-        // When allocating large blocks, attempt to leverage Linux's
-        // transparent hugepage support. It is unclear and difficult
-        // to accurately determine if doing this impacts performance
-        // enough to justify using platform-specific tricks.
-        if (size >= megabytes(std::size_t(4)))
-            madvise(buf, size, MADV_HUGEPAGE);
-#endif
-
-        // We need to carve out a bit of memory for the slab header
-        // and then align the rest appropriately:
-        auto slabData = reinterpret_cast<void*>(
-            reinterpret_cast<std::uint8_t*>(buf) + sizeof(SlabBlock));
-        auto slabSize = size - sizeof(SlabBlock);
+        if (slab = addSlab(); slab != nullptr)
+            return slab->allocate();
 
-        // This operation is essentially guaranteed not to fail but
-        // let's be careful anyways.
-        if (!boost::alignment::align(
-                itemAlignment_, itemSize_, slabData, slabSize))
-        {
-            boost::alignment::aligned_free(buf);
-            return nullptr;
-        }
-
-        slab = new (buf) SlabBlock(
-            slabs_.load(),
-            reinterpret_cast<std::uint8_t*>(slabData),
-            slabSize,
-            itemSize_);
-
-        // Link the new slab
-        while (!slabs_.compare_exchange_weak(
-            slab->next_,
-            slab,
-            std::memory_order_release,
-            std::memory_order_relaxed))
-        {
-            ;  // Nothing to do
-        }
-
-        return slab->allocate();
+        return nullptr;
     }
 
     /** Returns the memory block to the allocator.
@@ -300,13 +480,67 @@ public:
         {
             if (slab->own(ptr))
             {
-                slab->deallocate(ptr);
+                auto const mp = magazine();
+                if (!mp)
+                {
+                    slab->deallocate(ptr);
+                    return true;
+                }
+
+                auto& m = *mp;
+
+                if (m.count == magazineSize)
+                {
+                    magazineHits_.fetch_add(m.hits, std::memory_order_relaxed);
+                    m.hits = 0;
+                    m.flush(magazineSize / 2);
+                }
+
+                m.items[m.count] = ptr;
+                m.slabs[m.count] = slab;
+                ++m.count;
                 return true;
             }
         }
 
         return false;
     }
+
+    /** Statistics about an allocator. */
+    struct Counts
+    {
+        // The size of the items it hands out
+        std::size_t itemSize = 0;
+
+        // The slabs it allocated, and the items they can hold
+        std::size_t slabs = 0;
+        std::size_t capacity = 0;
+
+        // The items taken from the slabs, including those that threads
+        // keep in their magazines
+        std::size_t outstanding = 0;
+
+        // Allocations satisfied by a magazine without taking a lock. Each
+        // thread reports these as its magazine is refilled or flushed.
+        std::uint64_t magazineHits = 0;
+    };
+
+    Counts
+    getCounts() const noexcept
+    {
+        Counts c;
+        c.itemSize = itemSize_;
+        c.magazineHits = magazineHits_.load(std::memory_order_relaxed);
+
+        for (auto slab = slabs_.load(); slab != nullptr; slab = slab->next_)
+        {
+            ++c.slabs;
+            c.capacity += slab->capacity_;
+            c.outstanding += slab->used();
+        }
+
+        return c;
+    }
 };
 
 /** A collection of slab allocators of various sizes for a given type. */
@@ -425,6 +659,17 @@ public:
 
         return false;
     }
+
+    /** Returns statistics for each allocator, from smallest to largest. */
+    std::vector<typename SlabAllocator<Type>::Counts>
+    getCounts() const
+    {
+        std::vector<typename SlabAllocator<Type>::Counts> ret;
+        ret.reserve(allocators_.size());
+        for (auto const& a : allocators_)
+            ret.push_back(a.getCounts());
+        return ret;
+    }
 };
 
 }  // namespace ripple
@@ -22,14 +22,19 @@
 
 #include <ripple/basics/Log.h>
 #include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/ProfiledMutex.h>
 #include <ripple/basics/hardened_hash.h>
 #include <ripple/beast/clock/abstract_clock.h>
 #include <ripple/beast/insight/Insight.h>
 #include <atomic>
+#include <cassert>
 #include <functional>
+#include <map>
 #include <mutex>
+#include <optional>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace ripple {
@@ -43,6 +48,26 @@ namespace ripple {
     If it stays in memory even after it is ejected from the cache,
     the map will track it.
 
+    The cache holds objects through SharedPointerType and tracks them
+    through WeakPointerType once they leave it. These are std::shared_ptr
+    and std::weak_ptr unless the type brings its own reference counts.
+
+    Besides a number of entries, the cache can be given a budget in bytes.
+    An object counts as sizeof(T), or as what its memoryUsage() member
+    function returns, if T has one. Callers may also tag the entries they
+    use with a generation, such as a ledger sequence: an entry keeps the
+    newest generation that used it, and when the cache is over its budget
+    the entries of the oldest generations are the first to go.
+
+    Normally a periodic sweep expires entries by age, which walks every
+    entry under the lock. With clock eviction, a cache that has a target
+    size or number of bytes instead evicts as it goes: each new key moves
+    a hand a bounded number of steps around the entries, giving those used
+    since it last passed a second chance and evicting the others, until
+    the cache is within its targets again. Sweeps then do nothing.
+
+    The default lock is a ProfiledMutex with the name of the cache.
+
     @note Callers must not modify data objects that are stored in the cache
           unless they hold their own lock over all cache operations.
 */
@@ -52,7 +77,9 @@ template <
     bool IsKeyCache = false,
     class Hash = hardened_hash<>,
     class KeyEqual = std::equal_to<Key>,
-    class Mutex = std::recursive_mutex>
+    class Mutex = ProfiledMutex<std::recursive_mutex>,
+    class SharedPointerType = std::shared_ptr<T>,
+    class WeakPointerType = std::weak_ptr<T>>
 class TaggedCache
 {
 public:
@@ -69,17 +96,20 @@ public:
         clock_type& clock,
         beast::Journal journal,
         beast::insight::Collector::ptr const& collector =
-            beast::insight::NullCollector::New())
+            beast::insight::NullCollector::New(),
+        std::size_t partitions = 0)
         : m_journal(journal)
         , m_clock(clock)
         , m_stats(
               name,
               std::bind(&TaggedCache::collect_metrics, this),
               collector)
+        , m_mutex(name)
         , m_name(name)
         , m_target_size(size)
         , m_target_age(expiration)
         , m_cache_count(0)
+        , m_cache(partitions)
         , m_hits(0)
         , m_misses(0)
     {
@@ -101,6 +131,13 @@ public:
         return m_cache.size();
     }
 
+    int
+    getTargetSize() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_target_size;
+    }
+
     void
     setTargetSize(int s)
     {
@@ -144,6 +181,60 @@ public:
         return m_cache_count;
     }
 
+    /** Set the desired number of bytes held by cached objects (0 = ignore).
+     */
+    void
+    setTargetBytes(std::size_t bytes)
+    {
+        std::lock_guard lock(m_mutex);
+        m_target_bytes = bytes;
+        JLOG(m_journal.debug())
+            << m_name << " target bytes set to " << m_target_bytes;
+    }
+
+    std::size_t
+    getTargetBytes() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_target_bytes;
+    }
+
+    /** Evict entries as new keys are added, rather than when swept.
+
+        This only applies while the cache has a target size or a target
+        number of bytes; without either it is swept by age as usual.
+    */
+    void
+    setClockEviction(bool enable)
+    {
+        std::lock_guard lock(m_mutex);
+        m_clock_eviction = enable;
+        m_clock_hand.reset();
+        JLOG(m_journal.debug())
+            << m_name << " clock eviction " << (enable ? "on" : "off");
+    }
+
+    /** Set a function called with each object a sweep drops.
+
+        It is called after the sweep releases the lock, with objects that
+        nothing else references any more. Objects evicted as keys are added
+        are not passed to it.
+    */
+    void
+    setSweepHandler(std::function<void(SharedPointerType const&)> handler)
+    {
+        std::lock_guard lock(m_mutex);
+        m_sweep_handler = std::move(handler);
+    }
+
+    /** Returns the number of bytes held by cached objects. */
+    std::size_t
+    getCacheBytes() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_cache_bytes;
+    }
+
     int
     getTrackSize() const
     {
@@ -151,6 +242,15 @@ public:
         return m_cache.size();
     }
 
+    /** Returns the number of fetches that found an entry, and that did not.
+     */
+    std::pair<std::uint64_t, std::uint64_t>
+    getLookups() const
+    {
+        std::lock_guard lock(m_mutex);
+        return {m_hits, m_misses};
+    }
+
     float
     getHitRate()
     {
@@ -165,6 +265,9 @@ public:
         std::lock_guard lock(m_mutex);
         m_cache.clear();
         m_cache_count = 0;
+        m_cache_bytes = 0;
+        m_generation_bytes.clear();
+        m_clock_hand.reset();
     }
 
     void
@@ -173,16 +276,20 @@ public:
         std::lock_guard lock(m_mutex);
         m_cache.clear();
         m_cache_count = 0;
+        m_cache_bytes = 0;
+        m_generation_bytes.clear();
+        m_clock_hand.reset();
         m_hits = 0;
         m_misses = 0;
     }
 
     /** Refresh the last access time on a key if present.
+        @param generation The generation using the key, if any.
         @return `true` If the key was found.
     */
     template <class KeyComparable>
     bool
-    touch_if_exists(KeyComparable const& key)
+    touch_if_exists(KeyComparable const& key, std::uint32_t generation = 0)
     {
         std::lock_guard lock(m_mutex);
         auto const iter(m_cache.find(key));
@@ -192,13 +299,15 @@ public:
             return false;
         }
         iter->second.touch(m_clock.now());
+        if constexpr (!IsKeyCache)
+            retag(iter->second, generation);
         ++m_stats.hits;
         return true;
     }
 
     using SweptPointersVector = std::pair<
-        std::vector<std::shared_ptr<mapped_type>>,
-        std::vector<std::weak_ptr<mapped_type>>>;
+        std::vector<SharedPointerType>,
+        std::vector<WeakPointerType>>;
 
     void
     sweep()
@@ -208,13 +317,27 @@ public:
         // is destroyed but still within the main cache lock.
         std::vector<SweptPointersVector> allStuffToSweep(m_cache.partitions());
 
+        // The bytes each partition frees, by generation
+        std::vector<GenerationBytes> allFreed(m_cache.partitions());
+
         clock_type::time_point const now(m_clock.now());
         clock_type::time_point when_expire;
 
+        // Cached entries of older generations than this are removed
+        std::uint32_t minGeneration = 0;
+
+        std::function<void(SharedPointerType const&)> handler;
+
         auto const start = std::chrono::steady_clock::now();
         {
             std::lock_guard lock(m_mutex);
 
+            // Entries were evicted as they were added
+            if (clockEvicts())
+                return;
+
+            handler = m_sweep_handler;
+
             if (m_target_size == 0 ||
                 (static_cast<int>(m_cache.size()) <= m_target_size))
             {
@@ -236,24 +359,94 @@ public:
                     << m_target_age.count();
             }
 
-            std::vector<std::thread> workers;
-            workers.reserve(m_cache.partitions());
+            if (m_target_bytes != 0 && m_cache_bytes > m_target_bytes)
+            {
+                // Drop whole generations, oldest first, until enough bytes
+                // go. The newest generation is never dropped this way.
+                auto const newest = m_generation_bytes.rbegin();
+                std::size_t excess = m_cache_bytes - m_target_bytes;
+
+                for (auto const& [generation, bytes] : m_generation_bytes)
+                {
+                    if (generation == newest->first)
+                        break;
+
+                    minGeneration = generation + 1;
+
+                    if (bytes >= excess)
+                    {
+                        excess = 0;
+                        break;
+                    }
+
+                    excess -= bytes;
+                }
+
+                // If the newest generation alone is over the budget, age
+                // it faster, as when there are too many entries
+                if (excess != 0 && newest->second > m_target_bytes)
+                {
+                    auto const scale =
+                        static_cast<double>(m_target_bytes) / newest->second;
+                    auto const age =
+                        std::chrono::duration_cast<clock_type::duration>(
+                            m_target_age * scale);
+
+                    clock_type::duration const minimumAge(
+                        std::chrono::seconds(1));
+                    when_expire =
+                        std::max(when_expire, now - std::max(age, minimumAge));
+                }
+
+                JLOG(m_journal.trace())
+                    << m_name << " is over budget " << m_cache_bytes << " of "
+                    << m_target_bytes << " bytes, removing generations below "
+                    << minGeneration;
+            }
+
             std::atomic<int> allRemovals = 0;
 
-            for (std::size_t p = 0; p < m_cache.partitions(); ++p)
+            // A cache of one partition is swept on this thread
+            if (m_cache.partitions() == 1)
             {
-                workers.push_back(sweepHelper(
+                sweepHelper(
                     when_expire,
                     now,
-                    m_cache.map()[p],
-                    allStuffToSweep[p],
+                    minGeneration,
+                    m_cache.map()[0],
+                    allStuffToSweep[0],
+                    allFreed[0],
                     allRemovals,
-                    lock));
+                    lock)();
+            }
+            else
+            {
+                std::vector<std::thread> workers;
+                workers.reserve(m_cache.partitions());
+
+                for (std::size_t p = 0; p < m_cache.partitions(); ++p)
+                {
+                    workers.emplace_back(sweepHelper(
+                        when_expire,
+                        now,
+                        minGeneration,
+                        m_cache.map()[p],
+                        allStuffToSweep[p],
+                        allFreed[p],
+                        allRemovals,
+                        lock));
+                }
+                for (std::thread& worker : workers)
+                    worker.join();
             }
-            for (std::thread& worker : workers)
-                worker.join();
 
             m_cache_count -= allRemovals;
+
+            for (auto const& freed : allFreed)
+            {
+                for (auto const& [generation, bytes] : freed)
+                    removeBytes(generation, bytes);
+            }
         }
         // At this point allStuffToSweep will go out of scope outside the lock
         // and decrement the reference count on each strong pointer.
@@ -263,6 +456,15 @@ public:
                    std::chrono::steady_clock::now() - start)
                    .count()
             << "ms";
+
+        if (handler)
+        {
+            for (auto const& swept : allStuffToSweep)
+            {
+                for (auto const& ptr : swept.first)
+                    handler(ptr);
+            }
+        }
     }
 
     bool
@@ -284,6 +486,7 @@ public:
         if (entry.isCached())
         {
             --m_cache_count;
+            removeBytes(entry.generation, entry.bytes);
             entry.ptr.reset();
             ret = true;
         }
@@ -304,6 +507,7 @@ public:
         @param key The key corresponding to the object
         @param data A shared pointer to the data corresponding to the object.
         @param replace Function that decides if cache should be replaced
+        @param generation The generation using the object, if any.
 
         @return `true` If the key already existed.
     */
@@ -311,34 +515,44 @@ public:
     bool
     canonicalize(
         const key_type& key,
-        std::shared_ptr<T>& data,
-        std::function<bool(std::shared_ptr<T> const&)>&& replace)
+        SharedPointerType& data,
+        std::function<bool(SharedPointerType const&)>&& replace,
+        std::uint32_t generation = 0)
     {
         // Return canonical value, store if needed, refresh in cache
         // Return values: true=we had the data already
+
+        // Evicted objects are released once the lock is
+        SweptPointersVector evicted;
         std::lock_guard lock(m_mutex);
 
         auto cit = m_cache.find(key);
 
         if (cit == m_cache.end())
         {
-            m_cache.emplace(
+            evict(evicted, lock);
+            auto const [it, inserted] = m_cache.emplace(
                 std::piecewise_construct,
                 std::forward_as_tuple(key),
                 std::forward_as_tuple(m_clock.now(), data));
+            it->second.generation = generation;
+            addBytes(it->second);
             ++m_cache_count;
             return false;
         }
 
         Entry& entry = cit->second;
         entry.touch(m_clock.now());
+        retag(entry, generation);
 
         if (entry.isCached())
         {
             if (replace(entry.ptr))
             {
+                removeBytes(entry.generation, entry.bytes);
                 entry.ptr = data;
                 entry.weak_ptr = data;
+                addBytes(entry);
             }
             else
             {
@@ -363,12 +577,14 @@ public:
                 data = cachedData;
             }
 
+            addBytes(entry);
             ++m_cache_count;
             return true;
         }
 
         entry.ptr = data;
         entry.weak_ptr = data;
+        addBytes(entry);
         ++m_cache_count;
 
         return false;
@@ -377,26 +593,34 @@ public:
     bool
     canonicalize_replace_cache(
         const key_type& key,
-        std::shared_ptr<T> const& data)
+        SharedPointerType const& data,
+        std::uint32_t generation = 0)
     {
         return canonicalize(
             key,
-            const_cast<std::shared_ptr<T>&>(data),
-            [](std::shared_ptr<T> const&) { return true; });
+            const_cast<SharedPointerType&>(data),
+            [](SharedPointerType const&) { return true; },
+            generation);
     }
 
     bool
-    canonicalize_replace_client(const key_type& key, std::shared_ptr<T>& data)
+    canonicalize_replace_client(
+        const key_type& key,
+        SharedPointerType& data,
+        std::uint32_t generation = 0)
     {
         return canonicalize(
-            key, data, [](std::shared_ptr<T> const&) { return false; });
+            key,
+            data,
+            [](SharedPointerType const&) { return false; },
+            generation);
     }
 
-    std::shared_ptr<T>
-    fetch(const key_type& key)
+    SharedPointerType
+    fetch(const key_type& key, std::uint32_t generation = 0)
     {
         std::lock_guard<mutex_type> l(m_mutex);
-        auto ret = initialFetch(key, l);
+        auto ret = initialFetch(key, l, generation);
         if (!ret)
             ++m_misses;
         return ret;
@@ -419,14 +643,17 @@ public:
     auto
     insert(key_type const& key) -> std::enable_if_t<IsKeyCache, ReturnType>
     {
+        SweptPointersVector evicted;
         std::lock_guard lock(m_mutex);
         clock_type::time_point const now(m_clock.now());
+        if (m_cache.find(key) == m_cache.end())
+            evict(evicted, lock);
         auto [it, inserted] = m_cache.emplace(
             std::piecewise_construct,
             std::forward_as_tuple(key),
             std::forward_as_tuple(now));
         if (!inserted)
-            it->second.last_access = now;
+            it->second.touch(now);
         return inserted;
     }
 
@@ -486,8 +713,10 @@ public:
         will be called with this signature:
             std::shared_ptr<SLE const>(void)
     */
-    template <class Handler>
-    std::shared_ptr<T>
+    template <
+        class Handler,
+        class = std::enable_if_t<std::is_invocable_v<Handler const&>>>
+    SharedPointerType
     fetch(key_type const& digest, Handler const& h)
     {
         {
@@ -500,19 +729,27 @@ public:
         if (!sle)
             return {};
 
+        SweptPointersVector evicted;
         std::lock_guard l(m_mutex);
         ++m_misses;
+        if (m_cache.find(digest) == m_cache.end())
+            evict(evicted, l);
         auto const [it, inserted] =
             m_cache.emplace(digest, Entry(m_clock.now(), std::move(sle)));
-        if (!inserted)
+        if (inserted)
+            addBytes(it->second);
+        else
             it->second.touch(m_clock.now());
         return it->second.ptr;
     }
     // End CachedSLEs functions.
 
 private:
-    std::shared_ptr<T>
-    initialFetch(key_type const& key, std::lock_guard<mutex_type> const& l)
+    SharedPointerType
+    initialFetch(
+        key_type const& key,
+        std::lock_guard<mutex_type> const& l,
+        std::uint32_t generation = 0)
     {
         auto cit = m_cache.find(key);
         if (cit == m_cache.end())
@@ -523,6 +760,7 @@ private:
         {
             ++m_hits;
             entry.touch(m_clock.now());
+            retag(entry, generation);
             return entry.ptr;
         }
         entry.ptr = entry.lock();
@@ -531,6 +769,8 @@ private:
             // independent of cache size, so not counted as a hit
             ++m_cache_count;
             entry.touch(m_clock.now());
+            addBytes(entry);
+            retag(entry, generation);
             return entry.ptr;
         }
 
@@ -584,6 +824,9 @@ private:
     public:
         clock_type::time_point last_access;
 
+        // Used since the clock hand last passed
+        bool referenced = true;
+
         explicit KeyOnlyEntry(clock_type::time_point const& last_access_)
             : last_access(last_access_)
         {
@@ -593,19 +836,29 @@ private:
         touch(clock_type::time_point const& now)
         {
             last_access = now;
+            referenced = true;
         }
     };
 
     class ValueEntry
     {
     public:
-        std::shared_ptr<mapped_type> ptr;
-        std::weak_ptr<mapped_type> weak_ptr;
+        SharedPointerType ptr;
+        WeakPointerType weak_ptr;
         clock_type::time_point last_access;
 
+        // The newest generation that used the object
+        std::uint32_t generation = 0;
+
+        // The bytes counted for the object while it's cached
+        std::uint32_t bytes = 0;
+
+        // Used since the clock hand last passed
+        bool referenced = true;
+
         ValueEntry(
             clock_type::time_point const& last_access_,
-            std::shared_ptr<mapped_type> const& ptr_)
+            SharedPointerType const& ptr_)
             : ptr(ptr_), weak_ptr(ptr_), last_access(last_access_)
         {
         }
@@ -625,7 +878,7 @@ private:
         {
             return weak_ptr.expired();
         }
-        std::shared_ptr<mapped_type>
+        SharedPointerType
         lock()
         {
             return weak_ptr.lock();
@@ -634,6 +887,7 @@ private:
         touch(clock_type::time_point const& now)
         {
             last_access = now;
+            referenced = true;
         }
     };
 
@@ -650,16 +904,195 @@ private:
     using cache_type =
         hardened_partitioned_hash_map<key_type, Entry, Hash, KeyEqual>;
 
-    [[nodiscard]] std::thread
+    // The bytes of cached objects, by the generation of their entries
+    using GenerationBytes = std::map<std::uint32_t, std::size_t>;
+
+    static std::size_t
+    bytesOf(T const& object)
+    {
+        if constexpr (requires { object.memoryUsage(); })
+            return object.memoryUsage();
+        else
+            return sizeof(T);
+    }
+
+    // Count the object of an entry that just became cached
+    void
+    addBytes(ValueEntry& entry)
+    {
+        entry.bytes = static_cast<std::uint32_t>(bytesOf(*entry.ptr));
+        m_cache_bytes += entry.bytes;
+        m_generation_bytes[entry.generation] += entry.bytes;
+    }
+
+    void
+    removeBytes(std::uint32_t generation, std::size_t bytes)
+    {
+        m_cache_bytes -= bytes;
+
+        auto const it = m_generation_bytes.find(generation);
+        assert(it != m_generation_bytes.end() && it->second >= bytes);
+        if ((it->second -= bytes) == 0)
+            m_generation_bytes.erase(it);
+    }
+
+    // Record that a newer generation uses an entry
+    void
+    retag(ValueEntry& entry, std::uint32_t generation)
+    {
+        if (generation <= entry.generation)
+            return;
+
+        if (entry.isCached())
+        {
+            removeBytes(entry.generation, entry.bytes);
+            m_generation_bytes[generation] += entry.bytes;
+            m_cache_bytes += entry.bytes;
+        }
+
+        entry.generation = generation;
+    }
+
+    bool
+    clockEvicts() const
+    {
+        return m_clock_eviction && (m_target_size > 0 || m_target_bytes != 0);
+    }
+
+    bool
+    overTarget() const
+    {
+        if constexpr (IsKeyCache)
+            return m_target_size > 0 &&
+                static_cast<int>(m_cache.size()) >= m_target_size;
+        else
+            return (m_target_size > 0 && m_cache_count >= m_target_size) ||
+                (m_target_bytes != 0 && m_cache_bytes > m_target_bytes);
+    }
+
+    // Make room for a new key by moving the clock hand a bounded number of
+    // steps. Weak entries whose objects are gone are dropped as they are
+    // passed, so the map does not fill up with them either.
+    template <class Lock>
+    void
+    evict(SweptPointersVector& evicted, Lock const&)
+    {
+        if (!clockEvicts())
+            return;
+
+        bool const tooManyWeak = [this]() {
+            if constexpr (IsKeyCache)
+                return false;
+            else
+                return static_cast<int>(m_cache.size()) > 2 * m_cache_count;
+        }();
+
+        auto& partitions = m_cache.map();
+        auto cit = partitions[m_clock_partition].begin();
+        if (m_clock_hand)
+        {
+            if (auto const it = partitions[m_clock_partition].find(
+                    *m_clock_hand);
+                it != partitions[m_clock_partition].end())
+                cit = it;
+        }
+
+        for (int steps = 0; steps < clockSteps; ++steps)
+        {
+            if (!tooManyWeak && !overTarget())
+                break;
+
+            // Move on to the next partition that has entries
+            for (std::size_t n = 0;
+                 cit == partitions[m_clock_partition].end() &&
+                 n <= partitions.size();
+                 ++n)
+            {
+                m_clock_partition = (m_clock_partition + 1) % partitions.size();
+                cit = partitions[m_clock_partition].begin();
+            }
+            if (cit == partitions[m_clock_partition].end())
+                break;
+
+            if (!clockStep(partitions[m_clock_partition], cit, evicted))
+                ++cit;
+        }
+
+        if (cit == partitions[m_clock_partition].end())
+            m_clock_hand.reset();
+        else
+            m_clock_hand = cit->first;
+    }
+
+    // Process the entry under the hand, returning true if it was erased
+    // (and the iterator advanced)
+    template <class Partition>
+    bool
+    clockStep(
+        Partition& partition,
+        typename Partition::iterator& cit,
+        SweptPointersVector& evicted)
+    {
+        auto& entry = cit->second;
+
+        if constexpr (IsKeyCache)
+        {
+            if (entry.referenced)
+            {
+                entry.referenced = false;
+                return false;
+            }
+            cit = partition.erase(cit);
+            return true;
+        }
+        else
+        {
+            if (entry.isWeak())
+            {
+                if (!entry.isExpired())
+                    return false;
+                evicted.second.push_back(std::move(entry.weak_ptr));
+                cit = partition.erase(cit);
+                return true;
+            }
+
+            if (!overTarget())
+                return false;
+
+            if (entry.referenced)
+            {
+                entry.referenced = false;
+                return false;
+            }
+
+            --m_cache_count;
+            removeBytes(entry.generation, entry.bytes);
+            if (entry.ptr.use_count() == 1)
+            {
+                evicted.first.push_back(std::move(entry.ptr));
+                cit = partition.erase(cit);
+                return true;
+            }
+
+            // remains weakly cached
+            entry.ptr.reset();
+            return false;
+        }
+    }
+
+    // Returns the sweep of one partition, to run on any thread
+    [[nodiscard]] auto
     sweepHelper(
         clock_type::time_point const& when_expire,
         [[maybe_unused]] clock_type::time_point const& now,
+        std::uint32_t minGeneration,
         typename KeyValueCacheType::map_type& partition,
         SweptPointersVector& stuffToSweep,
+        GenerationBytes& freed,
         std::atomic<int>& allRemovals,
-        std::lock_guard<std::recursive_mutex> const&)
+        std::lock_guard<mutex_type> const&)
     {
-        return std::thread([&, this]() {
+        return [&, this, minGeneration]() {
             int cacheRemovals = 0;
             int mapRemovals = 0;
 
@@ -686,10 +1119,13 @@ private:
                             ++cit;
                         }
                     }
-                    else if (cit->second.last_access <= when_expire)
+                    else if (
+                        cit->second.last_access <= when_expire ||
+                        cit->second.generation < minGeneration)
                     {
                         // strong, expired
                         ++cacheRemovals;
+                        freed[cit->second.generation] += cit->second.bytes;
                         if (cit->second.ptr.use_count() == 1)
                         {
                             stuffToSweep.first.push_back(
@@ -721,19 +1157,21 @@ private:
             }
 
             allRemovals += cacheRemovals;
-        });
+        };
     }
 
-    [[nodiscard]] std::thread
+    [[nodiscard]] auto
     sweepHelper(
         clock_type::time_point const& when_expire,
         clock_type::time_point const& now,
+        std::uint32_t,
         typename KeyOnlyCacheType::map_type& partition,
         SweptPointersVector&,
+        GenerationBytes&,
         std::atomic<int>& allRemovals,
-        std::lock_guard<std::recursive_mutex> const&)
+        std::lock_guard<mutex_type> const&)
     {
-        return std::thread([&, this]() {
+        return [&, this]() {
             int cacheRemovals = 0;
             int mapRemovals = 0;
 
@@ -768,7 +1206,7 @@ private:
             }
 
             allRemovals += cacheRemovals;
-        });
+        };
     };
 
     beast::Journal m_journal;
@@ -786,8 +1224,29 @@ private:
     // Desired maximum cache age
     clock_type::duration m_target_age;
 
+    // Desired number of bytes held by cached objects (0 = ignore)
+    std::size_t m_target_bytes = 0;
+
+    // Evict entries as keys are added instead of sweeping them
+    bool m_clock_eviction = false;
+
+    // Called with the objects a sweep drops, if set
+    std::function<void(SharedPointerType const&)> m_sweep_handler;
+
+    // The most entries that the clock hand passes for each key added
+    static constexpr int clockSteps = 32;
+
+    // Where the clock hand is: a partition and the key it points at, if
+    // any. A key that is no longer there starts the partition over.
+    std::size_t m_clock_partition = 0;
+    std::optional<key_type> m_clock_hand;
+
     // Number of items cached
     int m_cache_count;
+
+    // Bytes held by cached objects, in all and by generation
+    std::size_t m_cache_bytes = 0;
+    GenerationBytes m_generation_bytes;
     cache_type m_cache;  // Hold strong reference to recent objects
     std::uint64_t m_hits;
     std::uint64_t m_misses;
@@ -0,0 +1,57 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_THREADAFFINITY_H_INCLUDED
+#define RIPPLE_BASICS_THREADAFFINITY_H_INCLUDED
+
+#include <ripple/beast/utility/Journal.h>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+/** Parse a set of CPUs.
+
+    The set is a list of CPU numbers and ranges, such as "0-7,16-23", and
+    of NUMA nodes, such as "node1", which stand for the CPUs of that node.
+    Items are separated by commas or spaces.
+
+    @throws std::runtime_error if the set is malformed, or names a node
+            that does not exist on this machine.
+    @return The CPUs, in ascending order and without duplicates.
+*/
+std::vector<unsigned>
+parseCpuSet(std::string const& set);
+
+/** Let the calling thread run only on the given CPUs.
+
+    An empty set leaves the thread where it is. A set that can not be
+    applied is logged as a warning, and leaves the thread where it is.
+
+    @param cpus The CPUs to run on.
+    @param j Where to report a failure.
+    @return false if the set could not be applied, or if this platform
+            does not support it.
+*/
+bool
+setCurrentThreadAffinity(std::vector<unsigned> const& cpus, beast::Journal j);
+
+}  // namespace ripple
+
+#endif
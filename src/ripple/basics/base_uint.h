@@ -230,6 +230,13 @@ private:
         if (sv.size() != size() * 2)
             return Unexpected(ParseResult::badLength);
 
+        if (!std::is_constant_evaluated())
+        {
+            if (!detail::hexDecode(sv.data(), bytes, ret.data()))
+                return Unexpected(ParseResult::badChar);
+            return ret;
+        }
+
         std::size_t i = 0u;
         auto in = sv.begin();
         while (in != sv.end())
@@ -553,29 +560,41 @@ template <std::size_t Bits, class Tag>
 [[nodiscard]] inline constexpr std::strong_ordering
 operator<=>(base_uint<Bits, Tag> const& lhs, base_uint<Bits, Tag> const& rhs)
 {
-    // This comparison might seem wrong on a casual inspection because it
-    // compares data internally stored as std::uint32_t byte-by-byte. But
-    // note that the underlying data is stored in big endian, even if the
-    // plaform is little endian. This makes the comparison correct.
-    //
-    // FIXME: use std::lexicographical_compare_three_way once support is
-    //        added to MacOS.
+    // The underlying data is stored in big endian, even if the platform is
+    // little endian, so it compares byte by byte in order. Loading it eight
+    // bytes at a time as big endian integers compares the same way.
+    constexpr auto bytes = base_uint<Bits, Tag>::bytes;
+    auto const a = lhs.data();
+    auto const b = rhs.data();
 
-    auto const ret = std::mismatch(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+    std::size_t i = 0;
+    for (; i + 8 <= bytes; i += 8)
+    {
+        std::uint64_t x, y;
+        std::memcpy(&x, a + i, 8);
+        std::memcpy(&y, b + i, 8);
+        if (x != y)
+            return boost::endian::big_to_native(x) <=>
+                boost::endian::big_to_native(y);
+    }
 
-    // a == b
-    if (ret.first == lhs.cend())
-        return std::strong_ordering::equivalent;
+    if constexpr (bytes % 8 != 0)
+    {
+        std::uint32_t x, y;
+        std::memcpy(&x, a + i, 4);
+        std::memcpy(&y, b + i, 4);
+        return boost::endian::big_to_native(x) <=>
+            boost::endian::big_to_native(y);
+    }
 
-    return (*ret.first > *ret.second) ? std::strong_ordering::greater
-                                      : std::strong_ordering::less;
+    return std::strong_ordering::equivalent;
 }
 
 template <std::size_t Bits, typename Tag>
 [[nodiscard]] inline constexpr bool
 operator==(base_uint<Bits, Tag> const& lhs, base_uint<Bits, Tag> const& rhs)
 {
-    return (lhs <=> rhs) == 0;
+    return std::memcmp(lhs.data(), rhs.data(), lhs.bytes) == 0;
 }
 
 //------------------------------------------------------------------------------
@@ -630,6 +649,14 @@ operator<<(std::ostream& out, base_uint<Bits, Tag> const& u)
     return out << to_string(u);
 }
 
+// The hashes of ledgers, transactions and nodes, and the keys of ledger
+// entries, are all SHA-512Half digests or, for a few kinds of entry, mostly
+// made of one.
+template <>
+struct is_digest<uint256> : std::true_type
+{
+};
+
 #ifndef __INTELLISENSE__
 static_assert(sizeof(uint128) == 128 / 8, "There should be no padding bytes");
 static_assert(sizeof(uint160) == 160 / 8, "There should be no padding bytes");
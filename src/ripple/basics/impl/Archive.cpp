@@ -48,9 +48,10 @@ extractTarLz4(
     if (archive_read_support_filter_lz4(ar.get()) < ARCHIVE_OK)
         Throw<std::runtime_error>(archive_error_string(ar.get()));
 
-    // Examples suggest this block size
-    if (archive_read_open_filename(ar.get(), src.string().c_str(), 10240) <
-        ARCHIVE_OK)
+    // Shard archives run to gigabytes, so read them in large blocks rather
+    // than the 10KiB the libarchive examples use
+    if (archive_read_open_filename(
+            ar.get(), src.string().c_str(), 1024 * 1024) < ARCHIVE_OK)
     {
         Throw<std::runtime_error>(archive_error_string(ar.get()));
     }
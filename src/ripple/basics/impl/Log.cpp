@@ -20,7 +20,9 @@
 #include <ripple/basics/Log.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/basics/contract.h>
+#include <ripple/beast/core/CurrentThreadName.h>
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <functional>
@@ -113,6 +115,13 @@ Logs::File::writeln(char const* text)
     }
 }
 
+void
+Logs::File::flush()
+{
+    if (m_stream != nullptr)
+        m_stream->flush();
+}
+
 //------------------------------------------------------------------------------
 
 Logs::Logs(beast::severities::Severity thresh)
@@ -120,6 +129,19 @@ Logs::Logs(beast::severities::Severity thresh)
 {
 }
 
+Logs::~Logs()
+{
+    if (writer_.joinable())
+    {
+        {
+            std::lock_guard lock(queueMutex_);
+            stopping_ = true;
+        }
+        queueCond_.notify_one();
+        writer_.join();
+    }
+}
+
 bool
 Logs::open(boost::filesystem::path const& pathToLogFile)
 {
@@ -180,7 +202,24 @@ Logs::write(
     bool console)
 {
     std::string s;
-    format(s, text, level, partition);
+    format(s, text, level, partition, json_);
+
+    if (async_)
+    {
+        {
+            std::lock_guard lock(queueMutex_);
+            if (queue_.size() >= queueLimit_ &&
+                level < beast::severities::kWarning)
+            {
+                ++dropped_;
+                return;
+            }
+            queue_.push_back(std::move(s));
+        }
+        queueCond_.notify_one();
+        return;
+    }
+
     std::lock_guard lock(mutex_);
     file_.writeln(s);
     if (!silent_)
@@ -190,6 +229,69 @@ Logs::write(
     //    out_.write_console(s);
 }
 
+void
+Logs::writeAsync(std::size_t queueLimit)
+{
+    std::lock_guard lock(queueMutex_);
+    queueLimit_ = std::max<std::size_t>(queueLimit, 1);
+    if (!writer_.joinable())
+    {
+        writer_ = std::thread(&Logs::runWriter, this);
+        async_ = true;
+    }
+}
+
+void
+Logs::writeLines(std::vector<std::string> const& lines)
+{
+    std::lock_guard lock(mutex_);
+    for (auto const& line : lines)
+    {
+        file_.write(line);
+        file_.write("\n");
+        if (!silent_)
+            std::cerr << line << '\n';
+    }
+    file_.flush();
+}
+
+void
+Logs::runWriter()
+{
+    beast::setCurrentThreadName("log writer");
+
+    std::vector<std::string> lines;
+    std::uint64_t reported = 0;
+    std::unique_lock lock(queueMutex_);
+    while (true)
+    {
+        queueCond_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty())
+            break;
+
+        lines.swap(queue_);
+        lock.unlock();
+
+        // Say where lines are missing, after the ones that made it
+        if (auto const dropped = dropped_.load(); dropped != reported)
+        {
+            lines.emplace_back();
+            format(
+                lines.back(),
+                std::to_string(dropped - reported) +
+                    " log lines dropped, the writer is behind",
+                beast::severities::kWarning,
+                "Logs",
+                json_);
+            reported = dropped;
+        }
+
+        writeLines(lines);
+        lines.clear();
+        lock.lock();
+    }
+}
+
 std::string
 Logs::rotate()
 {
@@ -307,47 +409,155 @@ Logs::fromString(std::string const& s)
     return lsINVALID;
 }
 
+namespace {
+
+// Attempt to prevent sensitive information from appearing in log files by
+// redacting it with asterisks.
+void
+scrub(std::string& output)
+{
+    auto scrubber = [&output](char const* token) {
+        auto first = output.find(token);
+
+        // If we have found the specified token, then attempt to isolate the
+        // sensitive data (it's enclosed by double quotes) and mask it off:
+        if (first != std::string::npos)
+        {
+            first = output.find('\"', first + std::strlen(token));
+
+            if (first != std::string::npos)
+            {
+                auto last = output.find('\"', ++first);
+
+                if (last == std::string::npos)
+                    last = output.size();
+
+                output.replace(first, last - first, last - first, '*');
+            }
+        }
+    };
+
+    scrubber("\"seed\"");
+    scrubber("\"seed_hex\"");
+    scrubber("\"secret\"");
+    scrubber("\"master_key\"");
+    scrubber("\"master_seed\"");
+    scrubber("\"master_seed_hex\"");
+    scrubber("\"passphrase\"");
+}
+
+// Append text as a quoted JSON string
+void
+appendQuoted(std::string& output, std::string const& text)
+{
+    static char const hex[] = "0123456789abcdef";
+
+    output += '"';
+    for (unsigned char const c : text)
+    {
+        switch (c)
+        {
+            case '"':
+                output += "\\\"";
+                break;
+            case '\\':
+                output += "\\\\";
+                break;
+            case '\n':
+                output += "\\n";
+                break;
+            case '\r':
+                output += "\\r";
+                break;
+            case '\t':
+                output += "\\t";
+                break;
+            default:
+                if (c < 0x20)
+                {
+                    output += "\\u00";
+                    output += hex[c >> 4];
+                    output += hex[c & 0xf];
+                }
+                else
+                {
+                    output += static_cast<char>(c);
+                }
+        }
+    }
+    output += '"';
+}
+
+}  // namespace
+
 void
 Logs::format(
     std::string& output,
     std::string const& message,
     beast::severities::Severity severity,
-    std::string const& partition)
+    std::string const& partition,
+    bool json)
 {
-    output.reserve(message.size() + partition.size() + 100);
-
-    output = to_string(std::chrono::system_clock::now());
-
-    output += " ";
-    if (!partition.empty())
-        output += partition + ":";
-
+    char const* level;
     using namespace beast::severities;
     switch (severity)
     {
         case kTrace:
-            output += "TRC ";
+            level = "TRC";
             break;
         case kDebug:
-            output += "DBG ";
+            level = "DBG";
             break;
         case kInfo:
-            output += "NFO ";
+            level = "NFO";
             break;
         case kWarning:
-            output += "WRN ";
+            level = "WRN";
             break;
         case kError:
-            output += "ERR ";
+            level = "ERR";
             break;
         default:
             assert(false);
             [[fallthrough]];
         case kFatal:
-            output += "FTL ";
+            level = "FTL";
             break;
     }
 
+    if (json)
+    {
+        // The message is scrubbed before it is quoted, which would escape
+        // the quotes the scrubber looks for.
+        std::string text = message.size() > maximumMessageCharacters
+            ? message.substr(0, maximumMessageCharacters - 3) + "..."
+            : message;
+        scrub(text);
+
+        output.clear();
+        output.reserve(text.size() + partition.size() + 100);
+        output += "{\"time\":";
+        appendQuoted(output, to_string(std::chrono::system_clock::now()));
+        output += ",\"partition\":";
+        appendQuoted(output, partition);
+        output += ",\"severity\":\"";
+        output += level;
+        output += "\",\"message\":";
+        appendQuoted(output, text);
+        output += '}';
+        return;
+    }
+
+    output.reserve(message.size() + partition.size() + 100);
+
+    output = to_string(std::chrono::system_clock::now());
+
+    output += " ";
+    if (!partition.empty())
+        output += partition + ":";
+
+    output += level;
+    output += ' ';
     output += message;
 
     // Limit the maximum length of the output
@@ -357,36 +567,7 @@ Logs::format(
         output += "...";
     }
 
-    // Attempt to prevent sensitive information from appearing in log files by
-    // redacting it with asterisks.
-    auto scrubber = [&output](char const* token) {
-        auto first = output.find(token);
-
-        // If we have found the specified token, then attempt to isolate the
-        // sensitive data (it's enclosed by double quotes) and mask it off:
-        if (first != std::string::npos)
-        {
-            first = output.find('\"', first + std::strlen(token));
-
-            if (first != std::string::npos)
-            {
-                auto last = output.find('\"', ++first);
-
-                if (last == std::string::npos)
-                    last = output.size();
-
-                output.replace(first, last - first, last - first, '*');
-            }
-        }
-    };
-
-    scrubber("\"seed\"");
-    scrubber("\"seed_hex\"");
-    scrubber("\"secret\"");
-    scrubber("\"master_key\"");
-    scrubber("\"master_seed\"");
-    scrubber("\"master_seed_hex\"");
-    scrubber("\"passphrase\"");
+    scrub(output);
 }
 
 //------------------------------------------------------------------------------
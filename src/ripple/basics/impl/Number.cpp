@@ -20,6 +20,8 @@
 #include <ripple/basics/Number.h>
 #include <boost/predef.h>
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
 #include <numeric>
 #include <stdexcept>
@@ -33,6 +35,13 @@ using uint128_t = boost::multiprecision::uint128_t;
 using uint128_t = __uint128_t;
 #endif  // !defined(_MSVC_LANG)
 
+// The compiler's own 128 bit integers, where it has them, are much faster
+// than the multiprecision ones
+#ifdef __SIZEOF_INT128__
+#define RIPPLE_NUMBER_NATIVE_UINT128 1
+using native_uint128_t = unsigned __int128;
+#endif
+
 namespace ripple {
 
 thread_local Number::rounding_mode Number::mode_ = Number::to_nearest;
@@ -164,6 +173,81 @@ Number::Guard::round() noexcept
     return 0;
 }
 
+// Powers of ten and digit counts
+
+static constexpr auto pow10_64 = [] {
+    std::array<std::uint64_t, 20> table{};
+    std::uint64_t p = 1;
+    for (auto& t : table)
+    {
+        t = p;
+        p *= 10;
+    }
+    return table;
+}();
+
+// The number of decimal digits in a non-zero value
+static inline int
+digits10(std::uint64_t u) noexcept
+{
+    assert(u != 0);
+    // 1233 / 4096 is just under log10(2), so t is the count or one less
+    int const bits = 64 - std::countl_zero(u);
+    int const t = (bits * 1233) >> 12;
+    return t + (u >= pow10_64[t]);
+}
+
+#ifdef RIPPLE_NUMBER_NATIVE_UINT128
+static constexpr auto pow10_128 = [] {
+    std::array<native_uint128_t, 39> table{};
+    native_uint128_t p = 1;
+    for (auto& t : table)
+    {
+        t = p;
+        p *= 10;
+    }
+    return table;
+}();
+
+static inline int
+digits10(native_uint128_t u) noexcept
+{
+    auto const hi = static_cast<std::uint64_t>(u >> 64);
+    if (hi == 0)
+        return digits10(static_cast<std::uint64_t>(u));
+    int const bits = 128 - std::countl_zero(hi);
+    int const t = (bits * 1233) >> 12;
+    return t + (u >= pow10_128[t]);
+}
+#endif
+
+// Returns what Guard::round would for a guard that held the `cut` lowest
+// digits of a value, which are `dropped`. At most 16 digits may be cut, so
+// the guard needs no extra bit for the digits shifted off its end.
+static int
+roundDropped(std::uint64_t dropped, int cut, bool negative) noexcept
+{
+    assert(cut <= 16);
+    auto const mode = Number::getround();
+
+    if (mode == Number::towards_zero)
+        return -1;
+
+    if (mode == Number::downward)
+        return negative && dropped != 0 ? 1 : -1;
+
+    if (mode == Number::upward)
+        return !negative && dropped != 0 ? 1 : -1;
+
+    // Compare the dropped digits with half of the place they were cut from
+    auto const scale = pow10_64[cut];
+    if (2 * dropped > scale)
+        return 1;
+    if (2 * dropped < scale)
+        return -1;
+    return 0;
+}
+
 // Number
 
 constexpr Number one{1000000000000000, -15, Number::unchecked{}};
@@ -180,10 +264,12 @@ Number::normalize()
     auto m = static_cast<std::make_unsigned_t<rep>>(mantissa_);
     if (negative)
         m = -m;
-    while ((m < minMantissa) && (exponent_ > minExponent))
+    if ((m < minMantissa) && (exponent_ > minExponent))
     {
-        m *= 10;
-        --exponent_;
+        // Scale up to 16 digits in one step, as far as the exponent allows
+        auto const shift = std::min(16 - digits10(m), exponent_ - minExponent);
+        m *= pow10_64[shift];
+        exponent_ -= shift;
     }
     Guard g;
     if (negative)
@@ -391,9 +477,20 @@ Number::operator*=(Number const& y)
         ym = -ym;
         yn = -1;
     }
+    auto zn = xn * yn;
+#ifdef RIPPLE_NUMBER_NATIVE_UINT128
+    // Both mantissas are under 10^16, so the product has at most 32 digits.
+    // Cut it to 16 digits at once and round on the digits that were cut.
+    auto const zm = native_uint128_t(xm) * native_uint128_t(ym);
+    int const cut = std::max(digits10(zm), 16) - 16;
+    auto const scale = pow10_64[cut];
+    xm = static_cast<rep>(zm / scale);
+    xe = xe + ye + cut;
+    auto const dropped = static_cast<std::uint64_t>(zm % scale);
+    auto r = roundDropped(dropped, cut, zn == -1);
+#else
     auto zm = uint128_t(xm) * uint128_t(ym);
     auto ze = xe + ye;
-    auto zn = xn * yn;
     Guard g;
     if (zn == -1)
         g.set_negative();
@@ -408,6 +505,7 @@ Number::operator*=(Number const& y)
     xm = static_cast<rep>(zm);
     xe = ze;
     auto r = g.round();
+#endif
     if (r == 1 || (r == 0 && (xm & 1) == 1))
     {
         ++xm;
@@ -457,8 +555,14 @@ Number::operator/=(Number const& y)
     }
     // Shift by 10^17 gives greatest precision while not overflowing uint128_t
     // or the cast back to int64_t
+#ifdef RIPPLE_NUMBER_NATIVE_UINT128
+    const native_uint128_t f = 100'000'000'000'000'000;
+    mantissa_ = static_cast<std::int64_t>(
+        native_uint128_t(nm) * f / native_uint128_t(dm));
+#else
     const uint128_t f = 100'000'000'000'000'000;
     mantissa_ = static_cast<std::int64_t>(uint128_t(nm) * f / uint128_t(dm));
+#endif
     exponent_ = ne - de - 17;
     mantissa_ *= np * dp;
     normalize();
@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/PerfCost.h>
+#include <time.h>
+
+namespace ripple {
+namespace perf {
+
+namespace {
+
+// Fetches made by this thread since it started
+thread_local Cost threadFetches;
+
+Cost
+threadCost() noexcept
+{
+    Cost cost = threadFetches;
+    cost.cpu = threadCpuTime();
+    return cost;
+}
+
+}  // namespace
+
+std::chrono::microseconds
+threadCpuTime() noexcept
+{
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::seconds{ts.tv_sec} +
+            std::chrono::nanoseconds{ts.tv_nsec});
+#endif
+    return std::chrono::microseconds{0};
+}
+
+void
+onFetch(
+    std::chrono::microseconds elapsed,
+    std::chrono::microseconds cpu) noexcept
+{
+    ++threadFetches.fetches;
+    if (elapsed > cpu)
+        threadFetches.fetchTime += elapsed - cpu;
+}
+
+CostMeter::CostMeter() noexcept
+    : thread_(std::this_thread::get_id()), start_(threadCost())
+{
+}
+
+Cost
+CostMeter::elapsed() const noexcept
+{
+    if (std::this_thread::get_id() != thread_)
+        return {};
+
+    auto const now = threadCost();
+    Cost result;
+    result.cpu = now.cpu - start_.cpu;
+    result.fetches = now.fetches - start_.fetches;
+    result.fetchTime = now.fetchTime - start_.fetchTime;
+    return result;
+}
+
+}  // namespace perf
+}  // namespace ripple
@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/ProfiledMutex.h>
+
+namespace ripple {
+
+void
+LockProfile::onAcquire(std::chrono::nanoseconds wait, bool contended) noexcept
+{
+    acquisitions_.fetch_add(1, std::memory_order_relaxed);
+    if (!contended)
+        return;
+
+    auto const ns = static_cast<std::uint64_t>(wait.count());
+    contentions_.fetch_add(1, std::memory_order_relaxed);
+    waitNs_.fetch_add(ns, std::memory_order_relaxed);
+
+    auto max = maxWaitNs_.load(std::memory_order_relaxed);
+    while (ns > max &&
+           !maxWaitNs_.compare_exchange_weak(
+               max, ns, std::memory_order_relaxed))
+        ;
+}
+
+void
+LockProfile::onRelease(std::chrono::nanoseconds held) noexcept
+{
+    holdNs_.fetch_add(
+        static_cast<std::uint64_t>(held.count()), std::memory_order_relaxed);
+}
+
+LockProfile::Counts
+LockProfile::counts() const noexcept
+{
+    using std::chrono::nanoseconds;
+
+    Counts c;
+    c.acquisitions = acquisitions_.load(std::memory_order_relaxed);
+    c.contentions = contentions_.load(std::memory_order_relaxed);
+    c.wait = nanoseconds(waitNs_.load(std::memory_order_relaxed));
+    c.maxWait = nanoseconds(maxWaitNs_.load(std::memory_order_relaxed));
+    c.hold = nanoseconds(holdNs_.load(std::memory_order_relaxed));
+    return c;
+}
+
+LockProfiles&
+LockProfiles::getInstance() noexcept
+{
+    static LockProfiles instance;
+
+    return instance;
+}
+
+LockProfile&
+LockProfiles::get(std::string const& name)
+{
+    std::lock_guard lock(mutex_);
+    return profiles_.try_emplace(name).first->second;
+}
+
+LockProfiles::List
+LockProfiles::getCounts() const
+{
+    List counts;
+
+    std::lock_guard lock(mutex_);
+    counts.reserve(profiles_.size());
+    for (auto const& [name, profile] : profiles_)
+        counts.emplace_back(name, profile.counts());
+
+    return counts;
+}
+
+LockGauges::LockGauges(beast::insight::Collector::ptr const& collector)
+    : collector_(collector)
+    , hook_(collector->make_hook([this]() { collect_metrics(); }))
+{
+}
+
+void
+LockGauges::collect_metrics()
+{
+    using namespace std::chrono;
+
+    // Locks may be first constructed at any time, so the gauges of
+    // each are made the first time it is seen
+    for (auto const& [name, counts] : LockProfiles::getInstance().getCounts())
+    {
+        auto iter = gauges_.find(name);
+        if (iter == gauges_.end())
+        {
+            iter = gauges_
+                       .emplace(
+                           name,
+                           Gauges{
+                               collector_->make_gauge(name, "acquisitions"),
+                               collector_->make_gauge(name, "contentions"),
+                               collector_->make_gauge(name, "wait_us"),
+                               collector_->make_gauge(name, "hold_us")})
+                       .first;
+        }
+
+        auto& gauges = iter->second;
+        gauges.acquisitions.set(counts.acquisitions);
+        gauges.contentions.set(counts.contentions);
+        gauges.waitUs.set(duration_cast<microseconds>(counts.wait).count());
+        gauges.holdUs.set(duration_cast<microseconds>(counts.hold).count());
+    }
+}
+
+}  // namespace ripple
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Log.h>
+#include <ripple/basics/ThreadAffinity.h>
+#include <ripple/basics/contract.h>
+#include <ripple/beast/core/LexicalCast.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/predef.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#if BOOST_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace ripple {
+
+namespace {
+
+// Far more CPUs than any machine we run on has
+constexpr unsigned maxCpu = 65535;
+
+unsigned
+parseCpu(std::string const& set, std::string const& cpu)
+{
+    unsigned result;
+    if (!beast::lexicalCastChecked(result, cpu) || result > maxCpu)
+        Throw<std::runtime_error>("Invalid CPU set '" + set + "'");
+    return result;
+}
+
+// The CPUs of a NUMA node, as the kernel lists them
+std::string
+nodeCpus(std::string const& set, std::string const& node)
+{
+    std::ifstream in(
+        "/sys/devices/system/node/node" + std::to_string(parseCpu(set, node)) +
+        "/cpulist");
+    std::string cpus;
+    if (!std::getline(in, cpus) || cpus.empty())
+        Throw<std::runtime_error>(
+            "Invalid CPU set '" + set + "': no NUMA node " + node);
+    return cpus;
+}
+
+}  // namespace
+
+std::vector<unsigned>
+parseCpuSet(std::string const& set)
+{
+    std::vector<std::string> items;
+    boost::split(items, set, boost::is_any_of(", "));
+
+    std::vector<unsigned> cpus;
+    for (auto const& item : items)
+    {
+        if (item.empty())
+            continue;
+
+        if (item.starts_with("node"))
+        {
+            auto const node = parseCpuSet(nodeCpus(set, item.substr(4)));
+            cpus.insert(cpus.end(), node.begin(), node.end());
+            continue;
+        }
+
+        auto const dash = item.find('-');
+        auto const first = parseCpu(set, item.substr(0, dash));
+        auto const last = dash == std::string::npos
+            ? first
+            : parseCpu(set, item.substr(dash + 1));
+        if (last < first)
+            Throw<std::runtime_error>("Invalid CPU set '" + set + "'");
+        for (auto cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+    }
+
+    if (cpus.empty())
+        Throw<std::runtime_error>("Invalid CPU set '" + set + "': empty");
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+bool
+setCurrentThreadAffinity(std::vector<unsigned> const& cpus, beast::Journal j)
+{
+    if (cpus.empty())
+        return true;
+
+#if BOOST_OS_LINUX
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (auto const cpu : cpus)
+    {
+        if (cpu >= CPU_SETSIZE)
+        {
+            JLOG(j.warn()) << "Can not run a thread on CPU " << cpu
+                           << ": at most " << CPU_SETSIZE << " are supported";
+            return false;
+        }
+        CPU_SET(cpu, &mask);
+    }
+    if (auto const err =
+            pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask))
+    {
+        JLOG(j.warn()) << "Can not set the CPUs of a thread: "
+                       << std::strerror(err);
+        return false;
+    }
+    return true;
+#else
+    JLOG(j.warn()) << "Setting the CPUs of a thread is not supported here";
+    return false;
+#endif
+}
+
+}  // namespace ripple
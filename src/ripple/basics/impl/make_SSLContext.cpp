@@ -82,6 +82,19 @@ static constexpr char const defaultDH[] =
  */
 std::string const defaultCipherList = "TLSv1.2:!CBC:!DSS:!PSK:!eNULL:!aNULL";
 
+/** The TLS sessions a server keeps for clients to resume, and for how long.
+
+    A client that reconnects within the timeout, with the session or the
+    session ticket of its last connection, gets an abbreviated handshake
+    without a new key exchange.
+ */
+long const sessionCacheSize = 4096;
+long const sessionTimeout = 3600;
+
+/** Identifies the sessions of our contexts, which a server requires to
+    resume a session when it verifies its clients. */
+static constexpr unsigned char const sessionIdContext[] = "rippled";
+
 static void
 initAnonymous(boost::asio::ssl::context& context)
 {
@@ -353,6 +366,19 @@ get_context(std::string cipherList)
     // against OpenSSL versions prior to 1.1.1k.
     SSL_CTX_set_options(c->native_handle(), SSL_OP_NO_RENEGOTIATION);
 
+    // Let reconnecting clients resume their sessions, from the cache or
+    // from a ticket. Clients choose the sessions they offer themselves.
+    SSL_CTX_clear_options(c->native_handle(), SSL_OP_NO_TICKET);
+    SSL_CTX_set_session_cache_mode(
+        c->native_handle(), SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_CLIENT);
+    SSL_CTX_sess_set_cache_size(c->native_handle(), sessionCacheSize);
+    SSL_CTX_set_timeout(c->native_handle(), sessionTimeout);
+    if (SSL_CTX_set_session_id_context(
+            c->native_handle(),
+            sessionIdContext,
+            sizeof(sessionIdContext) - 1) != 1)
+        LogicError("SSL_CTX_set_session_id_context failed");
+
     return c;
 }
 
@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/strHex.h>
+#include <array>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define RIPPLE_HEX_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace ripple {
+namespace detail {
+
+namespace {
+
+constexpr char digits[] = "0123456789ABCDEF";
+
+// The value of every hex digit, and 0xFF for every other character
+constexpr std::array<std::uint8_t, 256> values = []() {
+    std::array<std::uint8_t, 256> t{};
+    for (auto& x : t)
+        x = 0xFF;
+    for (int i = 0; i < 10; ++i)
+        t['0' + i] = i;
+    for (int i = 0; i < 6; ++i)
+    {
+        t['A' + i] = 10 + i;
+        t['a' + i] = 10 + i;
+    }
+    return t;
+}();
+
+#if RIPPLE_HEX_SSE2
+
+// SSE2 is part of every x86-64 processor, so this needs no runtime check.
+
+// The digit for each nibble: '0' plus the nibble, and 7 more past 9
+__m128i
+toDigits(__m128i nibbles)
+{
+    auto const letters = _mm_and_si128(
+        _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8(7));
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+}
+
+// Non-zero bytes wherever a byte is at most the limit, without sign
+__m128i
+atMost(__m128i bytes, char limit)
+{
+    return _mm_cmpeq_epi8(_mm_min_epu8(bytes, _mm_set1_epi8(limit)), bytes);
+}
+
+// Read the values of sixteen hex digits, or fail if any is not one
+bool
+fromDigits(char const* in, __m128i& result)
+{
+    auto const chars = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in));
+    auto const decimal = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    auto const letter = _mm_sub_epi8(
+        _mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    auto const isDecimal = atMost(decimal, 9);
+    auto const isLetter = atMost(letter, 5);
+    if (_mm_movemask_epi8(_mm_or_si128(isDecimal, isLetter)) != 0xFFFF)
+        return false;
+
+    result = _mm_or_si128(
+        _mm_and_si128(isDecimal, decimal),
+        _mm_and_si128(
+            isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+    return true;
+}
+
+// Join the pairs of digit values into bytes, one to each 16-bit lane
+__m128i
+joinPairs(__m128i nibbles)
+{
+    return _mm_or_si128(
+        _mm_and_si128(_mm_slli_epi16(nibbles, 4), _mm_set1_epi16(0x00F0)),
+        _mm_srli_epi16(nibbles, 8));
+}
+
+#endif
+
+}  // namespace
+
+void
+hexEncode(void const* data, std::size_t size, char* out)
+{
+    auto in = static_cast<std::uint8_t const*>(data);
+    auto const end = in + size;
+
+#if RIPPLE_HEX_SSE2
+    auto const low = _mm_set1_epi8(0x0F);
+    for (; end - in >= 16; in += 16, out += 32)
+    {
+        auto const bytes =
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(in));
+        auto const high =
+            toDigits(_mm_and_si128(_mm_srli_epi16(bytes, 4), low));
+        auto const lowDigits = toDigits(_mm_and_si128(bytes, low));
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(out),
+            _mm_unpacklo_epi8(high, lowDigits));
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(out + 16),
+            _mm_unpackhi_epi8(high, lowDigits));
+    }
+#endif
+
+    for (; in != end; ++in)
+    {
+        *out++ = digits[*in >> 4];
+        *out++ = digits[*in & 0xF];
+    }
+}
+
+bool
+hexDecode(char const* in, std::size_t size, void* data)
+{
+    auto out = static_cast<std::uint8_t*>(data);
+    auto const end = out + size;
+
+#if RIPPLE_HEX_SSE2
+    for (; end - out >= 16; in += 32, out += 16)
+    {
+        __m128i first, second;
+        if (!fromDigits(in, first) || !fromDigits(in + 16, second))
+            return false;
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(out),
+            _mm_packus_epi16(joinPairs(first), joinPairs(second)));
+    }
+#endif
+
+    // The values of invalid characters all have the high bits set, so
+    // they are checked once at the end
+    std::uint8_t invalid = 0;
+    for (; out != end; in += 2)
+    {
+        auto const high = values[static_cast<unsigned char>(in[0])];
+        auto const low = values[static_cast<unsigned char>(in[1])];
+        invalid |= high | low;
+        *out++ = (high << 4) | (low & 0xF);
+    }
+    return (invalid & 0xF0) == 0;
+}
+
+}  // namespace detail
+}  // namespace ripple
@@ -22,9 +22,28 @@
 
 #include <boost/algorithm/hex.hpp>
 #include <boost/endian/conversion.hpp>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
 
 namespace ripple {
 
+namespace detail {
+
+/** Write two uppercase hex digits for each of `size` bytes to `out`. */
+void
+hexEncode(void const* data, std::size_t size, char* out);
+
+/** Read `size` bytes from twice as many hex digits, in either case.
+
+    @return false if any of the characters is not a hex digit.
+*/
+bool
+hexDecode(char const* in, std::size_t size, void* out);
+
+}  // namespace detail
+
 template <class FwdIt>
 std::string
 strHex(FwdIt begin, FwdIt end)
@@ -34,10 +53,22 @@ strHex(FwdIt begin, FwdIt end)
             typename std::iterator_traits<FwdIt>::iterator_category,
             std::forward_iterator_tag>::value,
         "FwdIt must be a forward iterator");
-    std::string result;
-    result.reserve(2 * std::distance(begin, end));
-    boost::algorithm::hex(begin, end, std::back_inserter(result));
-    return result;
+    if constexpr (
+        std::contiguous_iterator<FwdIt> &&
+        sizeof(typename std::iterator_traits<FwdIt>::value_type) == 1)
+    {
+        std::string result(2 * std::distance(begin, end), '\0');
+        detail::hexEncode(
+            std::to_address(begin), result.size() / 2, result.data());
+        return result;
+    }
+    else
+    {
+        std::string result;
+        result.reserve(2 * std::distance(begin, end));
+        boost::algorithm::hex(begin, end, std::back_inserter(result));
+        return result;
+    }
 }
 
 template <class T, class = decltype(std::declval<T>().begin())>
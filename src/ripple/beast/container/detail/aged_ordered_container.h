@@ -32,6 +32,7 @@
 #include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -2255,7 +2256,10 @@ swap(
     lhs.swap(rhs);
 }
 
-/** Expire aged container items past the specified age. */
+/** Expire at most `limit` aged container items past the specified age.
+
+    @return The number of items expired.
+*/
 template <
     bool IsMulti,
     bool IsMap,
@@ -2276,12 +2280,14 @@ expire(
         Clock,
         Compare,
         Allocator>& c,
-    std::chrono::duration<Rep, Period> const& age)
+    std::chrono::duration<Rep, Period> const& age,
+    std::size_t limit)
 {
     std::size_t n(0);
     auto const expired(c.clock().now() - age);
     for (auto iter(c.chronological.cbegin());
-         iter != c.chronological.cend() && iter.when() <= expired;)
+         n < limit && iter != c.chronological.cend() &&
+         iter.when() <= expired;)
     {
         iter = c.erase(iter);
         ++n;
@@ -2289,6 +2295,32 @@ expire(
     return n;
 }
 
+/** Expire aged container items past the specified age. */
+template <
+    bool IsMulti,
+    bool IsMap,
+    class Key,
+    class T,
+    class Clock,
+    class Compare,
+    class Allocator,
+    class Rep,
+    class Period>
+std::size_t
+expire(
+    detail::aged_ordered_container<
+        IsMulti,
+        IsMap,
+        Key,
+        T,
+        Clock,
+        Compare,
+        Allocator>& c,
+    std::chrono::duration<Rep, Period> const& age)
+{
+    return expire(c, age, std::numeric_limits<std::size_t>::max());
+}
+
 }  // namespace beast
 
 #endif
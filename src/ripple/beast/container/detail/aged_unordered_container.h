@@ -32,6 +32,7 @@
 #include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -3400,7 +3401,17 @@ swap(
     lhs.swap(rhs);
 }
 
-/** Expire aged container items past the specified age. */
+/** Expire at most `limit` aged container items past the specified age.
+
+    Every item lives for the same age and moves to the back of the
+    chronological list when it is inserted or touched, so that list is
+    already ordered by expiration and the work is proportional to the
+    number of items expired. Bounding it lets a caller that expires on
+    every insertion spread a backlog over many calls rather than paying
+    for all of it in one.
+
+    @return The number of items expired.
+*/
 template <
     bool IsMulti,
     bool IsMap,
@@ -3423,12 +3434,14 @@ expire(
         Hash,
         KeyEqual,
         Allocator>& c,
-    std::chrono::duration<Rep, Period> const& age) noexcept
+    std::chrono::duration<Rep, Period> const& age,
+    std::size_t limit) noexcept
 {
     std::size_t n(0);
     auto const expired(c.clock().now() - age);
     for (auto iter(c.chronological.cbegin());
-         iter != c.chronological.cend() && iter.when() <= expired;)
+         n < limit && iter != c.chronological.cend() &&
+         iter.when() <= expired;)
     {
         iter = c.erase(iter);
         ++n;
@@ -3436,6 +3449,34 @@ expire(
     return n;
 }
 
+/** Expire aged container items past the specified age. */
+template <
+    bool IsMulti,
+    bool IsMap,
+    class Key,
+    class T,
+    class Clock,
+    class Hash,
+    class KeyEqual,
+    class Allocator,
+    class Rep,
+    class Period>
+std::size_t
+expire(
+    beast::detail::aged_unordered_container<
+        IsMulti,
+        IsMap,
+        Key,
+        T,
+        Clock,
+        Hash,
+        KeyEqual,
+        Allocator>& c,
+    std::chrono::duration<Rep, Period> const& age) noexcept
+{
+    return expire(c, age, std::numeric_limits<std::size_t>::max());
+}
+
 }  // namespace beast
 
 #endif
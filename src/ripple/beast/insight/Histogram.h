@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef BEAST_INSIGHT_HISTOGRAM_H_INCLUDED
+#define BEAST_INSIGHT_HISTOGRAM_H_INCLUDED
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace beast {
+namespace insight {
+
+/** A lock-free histogram with power of two buckets.
+
+    Bucket i counts the values no greater than 2^i, and the last bucket
+    counts everything larger. Recording is a pair of relaxed atomic adds,
+    so any number of threads may record while another takes a snapshot.
+    A snapshot taken while values are being recorded may be missing some
+    of them, but it is never torn within a bucket.
+*/
+class Histogram
+{
+public:
+    /** The number of bounded buckets, which reach 2^(bounded - 1). */
+    static constexpr std::size_t bounded = 24;
+
+    struct Snapshot
+    {
+        /** The count in each bucket, not cumulative. The last is unbounded. */
+        std::array<std::uint64_t, bounded + 1> counts{};
+        std::int64_t sum = 0;
+
+        std::uint64_t
+        count() const
+        {
+            std::uint64_t total = 0;
+            for (auto const c : counts)
+                total += c;
+            return total;
+        }
+    };
+
+    /** The largest value counted in a bounded bucket. */
+    static constexpr std::int64_t
+    upperBound(std::size_t bucket)
+    {
+        return std::int64_t{1} << bucket;
+    }
+
+    /** The bucket a value is counted in. */
+    static constexpr std::size_t
+    bucketFor(std::int64_t value)
+    {
+        if (value <= 1)
+            return 0;
+        auto const width = static_cast<std::size_t>(
+            std::bit_width(static_cast<std::uint64_t>(value - 1)));
+        return width < bounded ? width : bounded;
+    }
+
+    void
+    record(std::int64_t value) noexcept
+    {
+        counts_[bucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    Snapshot
+    snapshot() const
+    {
+        Snapshot s;
+        for (std::size_t i = 0; i < counts_.size(); ++i)
+            s.counts[i] = counts_[i].load(std::memory_order_relaxed);
+        s.sum = sum_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, bounded + 1> counts_{};
+    std::atomic<std::int64_t> sum_{0};
+};
+
+}  // namespace insight
+}  // namespace beast
+
+#endif
@@ -29,9 +29,11 @@
 #include <ripple/beast/insight/GaugeImpl.h>
 #include <ripple/beast/insight/Group.h>
 #include <ripple/beast/insight/Groups.h>
+#include <ripple/beast/insight/Histogram.h>
 #include <ripple/beast/insight/Hook.h>
 #include <ripple/beast/insight/HookImpl.h>
 #include <ripple/beast/insight/NullCollector.h>
+#include <ripple/beast/insight/PrometheusCollector.h>
 #include <ripple/beast/insight/StatsDCollector.h>
 
 #endif
@@ -0,0 +1,61 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef BEAST_INSIGHT_PROMETHEUSCOLLECTOR_H_INCLUDED
+#define BEAST_INSIGHT_PROMETHEUSCOLLECTOR_H_INCLUDED
+
+#include <ripple/beast/insight/Collector.h>
+
+#include <ripple/beast/utility/Journal.h>
+
+#include <string>
+
+namespace beast {
+namespace insight {
+
+/** A Collector that keeps metrics in process for a Prometheus scrape.
+
+    Nothing is sent anywhere. Counters and meters become Prometheus
+    counters, gauges stay gauges, and each event is a histogram of its
+    millisecond values. Hooks are called at the start of every scrape.
+
+    Reference:
+        https://prometheus.io/docs/instrumenting/exposition_formats/
+*/
+class PrometheusCollector : public Collector
+{
+public:
+    explicit PrometheusCollector() = default;
+
+    /** Create a Prometheus collector.
+        @param prefix A string pre-pended before each metric name.
+        @param journal Destination for logging output.
+    */
+    static std::shared_ptr<PrometheusCollector>
+    New(std::string const& prefix, Journal journal);
+
+    /** Return the current value of every metric in the text format. */
+    virtual std::string
+    format() = 0;
+};
+
+}  // namespace insight
+}  // namespace beast
+
+#endif
@@ -0,0 +1,463 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/core/List.h>
+#include <ripple/beast/insight/CounterImpl.h>
+#include <ripple/beast/insight/EventImpl.h>
+#include <ripple/beast/insight/GaugeImpl.h>
+#include <ripple/beast/insight/Histogram.h>
+#include <ripple/beast/insight/HookImpl.h>
+#include <ripple/beast/insight/MeterImpl.h>
+#include <ripple/beast/insight/PrometheusCollector.h>
+#include <atomic>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string_view>
+
+namespace beast {
+namespace insight {
+
+namespace detail {
+
+class PrometheusCollectorImp;
+
+// The metrics of one name, summed over every metric object that has it
+struct PrometheusFamily
+{
+    char const* type = nullptr;
+    std::int64_t value = 0;
+    std::optional<Histogram::Snapshot> histogram;
+};
+
+using PrometheusFamilies = std::map<std::string, PrometheusFamily>;
+
+//------------------------------------------------------------------------------
+
+class PrometheusMetricBase : public List<PrometheusMetricBase>::Node
+{
+public:
+    PrometheusMetricBase() = default;
+    virtual ~PrometheusMetricBase() = default;
+    PrometheusMetricBase(PrometheusMetricBase const&) = delete;
+    PrometheusMetricBase&
+    operator=(PrometheusMetricBase const&) = delete;
+
+    /** Called at the start of each scrape. */
+    virtual void
+    do_hook()
+    {
+    }
+
+    /** Add the current value to its family. */
+    virtual void
+    do_collect(PrometheusFamilies&)
+    {
+    }
+
+protected:
+    // Returns the family to add to, or nullptr if the name is already
+    // in use by a metric of another type.
+    static PrometheusFamily*
+    family(
+        PrometheusFamilies& families,
+        std::string const& name,
+        char const* type)
+    {
+        auto& f = families[name];
+        if (f.type == nullptr)
+            f.type = type;
+        return std::string_view(f.type) == type ? &f : nullptr;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusCollectorImp
+    : public PrometheusCollector,
+      public std::enable_shared_from_this<PrometheusCollectorImp>
+{
+private:
+    Journal m_journal;
+    std::string m_prefix;
+    std::recursive_mutex metricsLock_;
+    List<PrometheusMetricBase> metrics_;
+
+public:
+    PrometheusCollectorImp(std::string const& prefix, Journal journal)
+        : m_journal(journal), m_prefix(prefix)
+    {
+    }
+
+    Hook
+    make_hook(HookImpl::HandlerType const& handler) override;
+
+    Counter
+    make_counter(std::string const& name) override;
+
+    Event
+    make_event(std::string const& name) override;
+
+    Gauge
+    make_gauge(std::string const& name) override;
+
+    Meter
+    make_meter(std::string const& name) override;
+
+    std::string
+    format() override;
+
+    //--------------------------------------------------------------------------
+
+    void
+    add(PrometheusMetricBase& metric)
+    {
+        std::lock_guard _(metricsLock_);
+        metrics_.push_back(metric);
+    }
+
+    void
+    remove(PrometheusMetricBase& metric)
+    {
+        std::lock_guard _(metricsLock_);
+        metrics_.erase(metrics_.iterator_to(metric));
+    }
+
+    // Prometheus names are limited to [a-zA-Z_:][a-zA-Z0-9_:]*
+    std::string
+    metricName(std::string const& name) const
+    {
+        std::string s = m_prefix.empty() ? name : m_prefix + "_" + name;
+        for (auto& c : s)
+        {
+            if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                  (c >= '0' && c <= '9') || c == '_' || c == ':'))
+                c = '_';
+        }
+        if (s.empty() || (s[0] >= '0' && s[0] <= '9'))
+            s.insert(s.begin(), '_');
+        return s;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusHookImpl : public HookImpl, public PrometheusMetricBase
+{
+public:
+    PrometheusHookImpl(
+        HandlerType const& handler,
+        std::shared_ptr<PrometheusCollectorImp> const& impl)
+        : m_impl(impl), m_handler(handler)
+    {
+        m_impl->add(*this);
+    }
+
+    ~PrometheusHookImpl() override
+    {
+        m_impl->remove(*this);
+    }
+
+    void
+    do_hook() override
+    {
+        m_handler();
+    }
+
+private:
+    std::shared_ptr<PrometheusCollectorImp> m_impl;
+    HandlerType m_handler;
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusCounterImpl : public CounterImpl, public PrometheusMetricBase
+{
+public:
+    PrometheusCounterImpl(
+        std::string const& name,
+        std::shared_ptr<PrometheusCollectorImp> const& impl)
+        : m_impl(impl), m_name(impl->metricName(name))
+    {
+        m_impl->add(*this);
+    }
+
+    ~PrometheusCounterImpl() override
+    {
+        m_impl->remove(*this);
+    }
+
+    void
+    increment(CounterImpl::value_type amount) override
+    {
+        m_value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    void
+    do_collect(PrometheusFamilies& families) override
+    {
+        if (auto f = family(families, m_name, "counter"))
+            f->value += m_value.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::shared_ptr<PrometheusCollectorImp> m_impl;
+    std::string const m_name;
+    std::atomic<CounterImpl::value_type> m_value{0};
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusEventImpl : public EventImpl, public PrometheusMetricBase
+{
+public:
+    PrometheusEventImpl(
+        std::string const& name,
+        std::shared_ptr<PrometheusCollectorImp> const& impl)
+        : m_impl(impl), m_name(impl->metricName(name))
+    {
+        m_impl->add(*this);
+    }
+
+    ~PrometheusEventImpl() override
+    {
+        m_impl->remove(*this);
+    }
+
+    void
+    notify(EventImpl::value_type const& value) override
+    {
+        m_histogram.record(value.count());
+    }
+
+    void
+    do_collect(PrometheusFamilies& families) override
+    {
+        auto f = family(families, m_name, "histogram");
+        if (!f)
+            return;
+
+        auto const s = m_histogram.snapshot();
+        if (!f->histogram)
+        {
+            f->histogram = s;
+            return;
+        }
+        for (std::size_t i = 0; i < s.counts.size(); ++i)
+            f->histogram->counts[i] += s.counts[i];
+        f->histogram->sum += s.sum;
+    }
+
+private:
+    std::shared_ptr<PrometheusCollectorImp> m_impl;
+    std::string const m_name;
+    Histogram m_histogram;
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusGaugeImpl : public GaugeImpl, public PrometheusMetricBase
+{
+public:
+    PrometheusGaugeImpl(
+        std::string const& name,
+        std::shared_ptr<PrometheusCollectorImp> const& impl)
+        : m_impl(impl), m_name(impl->metricName(name))
+    {
+        m_impl->add(*this);
+    }
+
+    ~PrometheusGaugeImpl() override
+    {
+        m_impl->remove(*this);
+    }
+
+    void
+    set(GaugeImpl::value_type value) override
+    {
+        m_value.store(value, std::memory_order_relaxed);
+    }
+
+    void
+    increment(GaugeImpl::difference_type amount) override
+    {
+        using limits = std::numeric_limits<GaugeImpl::value_type>;
+        auto value = m_value.load(std::memory_order_relaxed);
+        GaugeImpl::value_type next;
+        do
+        {
+            // Saturate at the ends of the range, as the StatsD gauge does
+            next = value;
+            if (amount > 0)
+            {
+                auto const d = static_cast<GaugeImpl::value_type>(amount);
+                next += (d >= limits::max() - value) ? limits::max() - value
+                                                     : d;
+            }
+            else if (amount < 0)
+            {
+                auto const d = static_cast<GaugeImpl::value_type>(-amount);
+                next = (d >= value) ? 0 : value - d;
+            }
+        } while (!m_value.compare_exchange_weak(
+            value, next, std::memory_order_relaxed));
+    }
+
+    void
+    do_collect(PrometheusFamilies& families) override
+    {
+        if (auto f = family(families, m_name, "gauge"))
+            f->value += static_cast<std::int64_t>(
+                m_value.load(std::memory_order_relaxed));
+    }
+
+private:
+    std::shared_ptr<PrometheusCollectorImp> m_impl;
+    std::string const m_name;
+    std::atomic<GaugeImpl::value_type> m_value{0};
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusMeterImpl : public MeterImpl, public PrometheusMetricBase
+{
+public:
+    PrometheusMeterImpl(
+        std::string const& name,
+        std::shared_ptr<PrometheusCollectorImp> const& impl)
+        : m_impl(impl), m_name(impl->metricName(name))
+    {
+        m_impl->add(*this);
+    }
+
+    ~PrometheusMeterImpl() override
+    {
+        m_impl->remove(*this);
+    }
+
+    void
+    increment(MeterImpl::value_type amount) override
+    {
+        m_value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    void
+    do_collect(PrometheusFamilies& families) override
+    {
+        // A meter is a rate, which Prometheus derives from a total
+        if (auto f = family(families, m_name, "counter"))
+            f->value += static_cast<std::int64_t>(
+                m_value.load(std::memory_order_relaxed));
+    }
+
+private:
+    std::shared_ptr<PrometheusCollectorImp> m_impl;
+    std::string const m_name;
+    std::atomic<MeterImpl::value_type> m_value{0};
+};
+
+//------------------------------------------------------------------------------
+
+Hook
+PrometheusCollectorImp::make_hook(HookImpl::HandlerType const& handler)
+{
+    return Hook(std::make_shared<PrometheusHookImpl>(
+        handler, shared_from_this()));
+}
+
+Counter
+PrometheusCollectorImp::make_counter(std::string const& name)
+{
+    return Counter(
+        std::make_shared<PrometheusCounterImpl>(name, shared_from_this()));
+}
+
+Event
+PrometheusCollectorImp::make_event(std::string const& name)
+{
+    return Event(
+        std::make_shared<PrometheusEventImpl>(name, shared_from_this()));
+}
+
+Gauge
+PrometheusCollectorImp::make_gauge(std::string const& name)
+{
+    return Gauge(
+        std::make_shared<PrometheusGaugeImpl>(name, shared_from_this()));
+}
+
+Meter
+PrometheusCollectorImp::make_meter(std::string const& name)
+{
+    return Meter(
+        std::make_shared<PrometheusMeterImpl>(name, shared_from_this()));
+}
+
+std::string
+PrometheusCollectorImp::format()
+{
+    PrometheusFamilies families;
+    {
+        std::lock_guard _(metricsLock_);
+        for (auto& metric : metrics_)
+            metric.do_hook();
+        for (auto& metric : metrics_)
+            metric.do_collect(families);
+    }
+
+    std::ostringstream ss;
+    for (auto const& [name, f] : families)
+    {
+        ss << "# TYPE " << name << ' ' << f.type << '\n';
+        if (!f.histogram)
+        {
+            ss << name << ' ' << f.value << '\n';
+            continue;
+        }
+
+        auto const& h = *f.histogram;
+        std::uint64_t cumulative = 0;
+        for (std::size_t i = 0; i < Histogram::bounded; ++i)
+        {
+            cumulative += h.counts[i];
+            ss << name << "_bucket{le=\"" << Histogram::upperBound(i)
+               << "\"} " << cumulative << '\n';
+        }
+        cumulative += h.counts[Histogram::bounded];
+        ss << name << "_bucket{le=\"+Inf\"} " << cumulative << '\n';
+        ss << name << "_sum " << h.sum << '\n';
+        ss << name << "_count " << cumulative << '\n';
+    }
+    return ss.str();
+}
+
+}  // namespace detail
+
+//------------------------------------------------------------------------------
+
+std::shared_ptr<PrometheusCollector>
+PrometheusCollector::New(std::string const& prefix, Journal journal)
+{
+    return std::make_shared<detail::PrometheusCollectorImp>(prefix, journal);
+}
+
+}  // namespace insight
+}  // namespace beast
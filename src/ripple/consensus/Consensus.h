@@ -21,6 +21,7 @@
 #define RIPPLE_CONSENSUS_CONSENSUS_H_INCLUDED
 
 #include <ripple/basics/Log.h>
+#include <ripple/basics/PerfTrace.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/consensus/ConsensusParms.h>
@@ -247,6 +248,13 @@ checkConsensus(
       // Called when ledger closes
       Result onClose(Ledger const &, Ledger const & prev, Mode mode);
 
+      // Called, possibly repeatedly, once enough peers share our position
+      // that the round is likely to end on it
+      void onStablePosition(Result const & result,
+        RCLCxLedger const & prevLedger,
+        NetClock::duration closeResolution,
+        Mode const & mode);
+
       // Called when ledger is accepted by consensus
       void onAccept(Result const & result,
         RCLCxLedger const & prevLedger,
@@ -519,6 +527,11 @@ private:
     void
     updateOurPositions();
 
+    // Whether enough peers share our position, close time included, that
+    // the round will likely end on it
+    bool
+    positionStable() const;
+
     bool
     haveConsensus();
 
@@ -526,6 +539,10 @@ private:
     void
     createDisputes(TxSet_t const& o);
 
+    // Whether a tx set holds a transaction, remembered for the round.
+    bool
+    holds(TxSet_t const& set, typename Tx_t::ID const& txId);
+
     // Update our disputes given that this node has adopted a new position.
     // Will call createDisputes as needed.
     void
@@ -562,6 +579,9 @@ private:
     // Time it took for the last consensus round to converge
     std::chrono::milliseconds prevRoundTime_;
 
+    // When each step of the current round happened
+    ConsensusTimeline timeline_;
+
     //-------------------------------------------------------------------------
     // Network time measurements of consensus progress
 
@@ -670,6 +690,7 @@ Consensus<Adaptor>::startRoundInternal(
 {
     phase_ = ConsensusPhase::open;
     JLOG(j_.debug()) << "transitioned to ConsensusPhase::open";
+    perf::trace::instant("consensus", "open");
     mode_.set(mode, adaptor_);
     now_ = now;
     prevLedgerID_ = prevLedgerID;
@@ -678,6 +699,8 @@ Consensus<Adaptor>::startRoundInternal(
     convergePercent_ = 0;
     haveCloseTimeConsensus_ = false;
     openTime_.reset(clock_.now());
+    timeline_ = ConsensusTimeline{};
+    timeline_.opened = clock_.now();
     currPeerPositions_.clear();
     acquired_.clear();
     rawCloseTimes_.peers.clear();
@@ -779,6 +802,9 @@ Consensus<Adaptor>::peerProposalInternal(
             peerPosIt->second = newPeerPos;
         else
             currPeerPositions_.emplace(peerID, newPeerPos);
+
+        if (!timeline_.firstProposal)
+            timeline_.firstProposal = clock_.now();
     }
 
     if (newPeerProp.isInitial())
@@ -896,6 +922,9 @@ Consensus<Adaptor>::simulate(
     result_->proposers = prevProposers_ = currPeerPositions_.size();
     prevRoundTime_ = result_->roundTime.read();
     phase_ = ConsensusPhase::accepted;
+    perf::trace::instant("consensus", "accepted");
+    timeline_.consensus = clock_.now();
+    result_->timeline = timeline_;
     adaptor_.onForceAccept(
         *result_,
         previousLedger_,
@@ -1023,6 +1052,7 @@ Consensus<Adaptor>::handleWrongLedger(typename Ledger_t::ID const& lgrId)
         {
             result_->disputes.clear();
             result_->compares.clear();
+            result_->memberships.clear();
         }
 
         currPeerPositions_.clear();
@@ -1278,6 +1308,13 @@ Consensus<Adaptor>::phaseEstablish()
 
     updateOurPositions();
 
+    // Let the adaptor get ahead on the ledger our position would build
+    if (positionStable())
+    {
+        adaptor_.onStablePosition(
+            *result_, previousLedger_, closeResolution_, mode_.get());
+    }
+
     // Nothing to do if too many laggards or we don't have consensus.
     if (shouldPause() || !haveConsensus())
         return;
@@ -1295,6 +1332,9 @@ Consensus<Adaptor>::phaseEstablish()
     prevRoundTime_ = result_->roundTime.read();
     phase_ = ConsensusPhase::accepted;
     JLOG(j_.debug()) << "transitioned to ConsensusPhase::accepted";
+    perf::trace::instant("consensus", "accepted");
+    timeline_.consensus = clock_.now();
+    result_->timeline = timeline_;
     adaptor_.onAccept(
         *result_,
         previousLedger_,
@@ -1313,10 +1353,12 @@ Consensus<Adaptor>::closeLedger()
 
     phase_ = ConsensusPhase::establish;
     JLOG(j_.debug()) << "transitioned to ConsensusPhase::establish";
+    perf::trace::instant("consensus", "establish");
     rawCloseTimes_.self = now_;
 
     result_.emplace(adaptor_.onClose(previousLedger_, now_, mode_.get()));
     result_->roundTime.reset(clock_.now());
+    timeline_.closed = clock_.now();
     // Share the newly created transaction set if we haven't already
     // received it from a peer
     if (acquired_.emplace(result_->txns.id(), result_->txns).second)
@@ -1518,6 +1560,7 @@ Consensus<Adaptor>::updateOurPositions()
                         << ", tx " << newID;
 
         result_->position.changePosition(newID, consensusCloseTime, now_);
+        timeline_.positionChanges.push_back(clock_.now());
 
         // Share our new transaction set and update disputes
         // if we haven't already received it
@@ -1541,6 +1584,27 @@ Consensus<Adaptor>::updateOurPositions()
     }
 }
 
+template <class Adaptor>
+bool
+Consensus<Adaptor>::positionStable() const
+{
+    assert(result_);
+
+    if (!haveCloseTimeConsensus_ || result_->position.isBowOut())
+        return false;
+
+    auto const ourPosition = result_->position.position();
+    std::size_t agree = 1;
+    for (auto const& [nodeId, peerPos] : currPeerPositions_)
+    {
+        if (peerPos.proposal().position() == ourPosition)
+            ++agree;
+    }
+
+    return agree * 100 >= (currPeerPositions_.size() + 1) *
+        adaptor_.parms().avMID_CONSENSUS_PCT;
+}
+
 template <class Adaptor>
 bool
 Consensus<Adaptor>::haveConsensus()
@@ -1636,6 +1700,18 @@ Consensus<Adaptor>::createDisputes(TxSet_t const& o)
 
     auto differences = result_->txns.compare(o);
 
+    // The comparison already says which of the two sets holds each
+    // difference, so neither set is searched for them again.
+    {
+        auto& ours = result_->memberships[result_->txns.id()];
+        auto& theirs = result_->memberships[o.id()];
+        for (auto const& [txId, inThisSet] : differences)
+        {
+            ours.emplace(txId, inThisSet);
+            theirs.emplace(txId, !inThisSet);
+        }
+    }
+
     int dc = 0;
 
     for (auto const& [txId, inThisSet] : differences)
@@ -1656,7 +1732,7 @@ Consensus<Adaptor>::createDisputes(TxSet_t const& o)
 
         typename Result::Dispute_t dtx{
             tx,
-            result_->txns.exists(txID),
+            holds(result_->txns, txID),
             std::max(prevProposers_, currPeerPositions_.size()),
             j_};
 
@@ -1666,7 +1742,7 @@ Consensus<Adaptor>::createDisputes(TxSet_t const& o)
             Proposal_t const& peerProp = peerPos.proposal();
             auto const cit = acquired_.find(peerProp.position());
             if (cit != acquired_.end())
-                dtx.setVote(nodeId, cit->second.exists(txID));
+                dtx.setVote(nodeId, holds(cit->second, txID));
         }
         adaptor_.share(dtx.tx());
 
@@ -1690,10 +1766,23 @@ Consensus<Adaptor>::updateDisputes(NodeID_t const& node, TxSet_t const& other)
     for (auto& it : result_->disputes)
     {
         auto& d = it.second;
-        d.setVote(node, other.exists(d.tx().id()));
+        d.setVote(node, holds(other, d.tx().id()));
     }
 }
 
+template <class Adaptor>
+bool
+Consensus<Adaptor>::holds(TxSet_t const& set, typename Tx_t::ID const& txId)
+{
+    assert(result_);
+
+    auto& held = result_->memberships[set.id()];
+    auto const [it, inserted] = held.emplace(txId, false);
+    if (inserted)
+        it->second = set.exists(txId);
+    return it->second;
+}
+
 template <class Adaptor>
 NetClock::time_point
 Consensus<Adaptor>::asCloseTime(NetClock::time_point raw) const
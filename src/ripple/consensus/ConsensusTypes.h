@@ -25,6 +25,8 @@
 #include <ripple/consensus/DisputedTx.h>
 #include <chrono>
 #include <map>
+#include <optional>
+#include <vector>
 
 namespace ripple {
 
@@ -182,6 +184,41 @@ struct ConsensusCloseTimes
     NetClock::time_point self;
 };
 
+/** When each step of a consensus round happened.
+
+    Consensus stamps the steps it drives itself, from the start of the
+    open phase until the round is declared. The adaptor may stamp the
+    steps that follow, once it builds and validates the new ledger.
+*/
+struct ConsensusTimeline
+{
+    using time_point = std::chrono::steady_clock::time_point;
+
+    //! When the open phase began
+    time_point opened;
+
+    //! When we closed the ledger and took our initial position
+    std::optional<time_point> closed;
+
+    //! When the first peer proposal of the round arrived
+    std::optional<time_point> firstProposal;
+
+    //! Each time we changed our position
+    std::vector<time_point> positionChanges;
+
+    //! When we declared consensus or moved on without it
+    std::optional<time_point> consensus;
+
+    //! When the adaptor finished building the new ledger
+    std::optional<time_point> built;
+
+    //! When the adaptor sent our validation of the new ledger
+    std::optional<time_point> validated;
+
+    //! When the new ledger gathered a quorum of trusted validations
+    std::optional<time_point> quorum;
+};
+
 /** Whether we have or don't have a consensus */
 enum class ConsensusState {
     No,       //!< We do not have consensus
@@ -229,9 +266,17 @@ struct ConsensusResult
     // Set of TxSet ids we have already compared/created disputes
     hash_set<typename TxSet_t::ID> compares;
 
+    // Whether each tx set holds each disputed transaction. A set never
+    // changes under its id, so peers sharing a position look it up once.
+    hash_map<typename TxSet_t::ID, hash_map<typename Tx_t::ID, bool>>
+        memberships;
+
     // Measures the duration of the establish phase for this consensus round
     ConsensusTimer roundTime;
 
+    // When each step of this consensus round happened
+    ConsensusTimeline timeline;
+
     // Indicates state in which consensus ended.  Once in the accept phase
     // will be either Yes or MovedOn
     ConsensusState state = ConsensusState::No;
@@ -28,6 +28,8 @@
 #include <ripple/consensus/LedgerTrie.h>
 #include <ripple/protocol/PublicKey.h>
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <type_traits>
@@ -351,7 +353,137 @@ class Validations
     // Is NOT managed by the mutex_ above
     Adaptor adaptor_;
 
+    // The trusted full validations of one ledger, as readers see them.
+    // Built under mutex_ and never changed once published.
+    struct LedgerVotes
+    {
+        std::vector<Validation> trusted;
+    };
+
+    // Where the latest votes of one ledger are published. Adding a
+    // validation replaces the votes in the slot, so the map of slots is
+    // only copied when a ledger is first seen or sets expire.
+    class LedgerSlot
+    {
+        mutable std::mutex mutex_;
+        std::shared_ptr<LedgerVotes const> votes_;
+
+    public:
+        // When readers last used the votes, so that expire keeps the
+        // ledger as if it had been touched then
+        mutable std::atomic<std::chrono::steady_clock::time_point> lastRead{
+            std::chrono::steady_clock::time_point::min()};
+
+        explicit LedgerSlot(std::shared_ptr<LedgerVotes const> votes)
+            : votes_(std::move(votes))
+        {
+        }
+
+        std::shared_ptr<LedgerVotes const>
+        load() const
+        {
+            std::lock_guard lock(mutex_);
+            return votes_;
+        }
+
+        void
+        store(std::shared_ptr<LedgerVotes const> votes)
+        {
+            std::lock_guard lock(mutex_);
+            votes_ = std::move(votes);
+        }
+    };
+
+    using Published = hash_map<ID, std::shared_ptr<LedgerSlot>>;
+
+    // The ledgers of byLedger_, so that queries by ledger do not wait on
+    // mutex_ while validations are added. The mutex here is only held to
+    // copy the pointer.
+    mutable std::mutex publishedMutex_;
+    std::shared_ptr<Published const> published_;
+
 private:
+    std::shared_ptr<Published const>
+    published() const
+    {
+        std::lock_guard lock(publishedMutex_);
+        return published_;
+    }
+
+    void
+    setPublished(std::shared_ptr<Published const> published)
+    {
+        std::lock_guard lock(publishedMutex_);
+        published_ = std::move(published);
+    }
+
+    std::shared_ptr<LedgerVotes const>
+    makeVotes(hash_map<NodeID, Validation> const& validations) const
+    {
+        auto votes = std::make_shared<LedgerVotes>();
+        votes->trusted.reserve(validations.size());
+        for (auto const& [_, v] : validations)
+        {
+            (void)_;
+            if (v.trusted() && v.full())
+                votes->trusted.push_back(v);
+        }
+        return votes;
+    }
+
+    // Publish the validations of one ledger
+    void
+    publish(std::lock_guard<Mutex> const&, ID const& ledgerID)
+    {
+        auto const p = published();
+        auto const slot = p->find(ledgerID);
+        auto const it = byLedger_.find(ledgerID);
+        if (it == byLedger_.end())
+        {
+            if (slot == p->end())
+                return;
+            auto next = std::make_shared<Published>(*p);
+            next->erase(ledgerID);
+            setPublished(std::move(next));
+        }
+        else if (slot == p->end())
+        {
+            auto next = std::make_shared<Published>(*p);
+            next->emplace(
+                ledgerID, std::make_shared<LedgerSlot>(makeVotes(it->second)));
+            setPublished(std::move(next));
+        }
+        else
+        {
+            slot->second->store(makeVotes(it->second));
+        }
+    }
+
+    // Publish the validations of every ledger
+    void
+    publishAll(std::lock_guard<Mutex> const&)
+    {
+        auto next = std::make_shared<Published>();
+        next->reserve(byLedger_.size());
+        for (auto const& [ledgerID, validations] : byLedger_)
+            next->emplace(
+                ledgerID, std::make_shared<LedgerSlot>(makeVotes(validations)));
+        setPublished(std::move(next));
+    }
+
+    // Find the published validations of a ledger, without locking mutex_
+    std::shared_ptr<LedgerVotes const>
+    votes(ID const& ledgerID) const
+    {
+        auto const p = published();
+        auto const it = p->find(ledgerID);
+        if (it == p->end())
+            return nullptr;
+        it->second->lastRead.store(
+            byLedger_.clock().now(), std::memory_order_relaxed);
+        return it->second->load();
+    }
+
     // Remove support of a validated ledger
     void
     removeTrie(
@@ -530,37 +662,6 @@ private:
         }
     }
 
-    /** Iterate the set of validations associated with a given ledger id
-
-        @param lock Existing lock on mutex_
-        @param ledgerID The identifier of the ledger
-        @param pre Invokable with signature(std::size_t)
-        @param f Invokable with signature (NodeID const &, Validation const &)
-
-        @note The invokable `pre` is called prior to iterating validations. The
-              argument is the number of times `f` will be called.
-        @warning The invokable f is expected to be a simple transformation of
-       its arguments and will be called with mutex_ under lock.
-    */
-    template <class Pre, class F>
-    void
-    byLedger(
-        std::lock_guard<Mutex> const&,
-        ID const& ledgerID,
-        Pre&& pre,
-        F&& f)
-    {
-        auto it = byLedger_.find(ledgerID);
-        if (it != byLedger_.end())
-        {
-            // Update set time since it is being used
-            byLedger_.touch(it);
-            pre(it->second.size());
-            for (auto const& [key, val] : it->second)
-                f(key, val);
-        }
-    }
-
 public:
     /** Constructor
 
@@ -577,6 +678,7 @@ public:
         , bySequence_(c)
         , parms_(p)
         , adaptor_(std::forward<Ts>(ts)...)
+        , published_(std::make_shared<Published const>())
     {
     }
 
@@ -679,6 +781,7 @@ public:
             }
 
             byLedger_[val.ledgerID()].insert_or_assign(nodeID, val);
+            publish(lock, val.ledgerID());
 
             auto const [it, inserted] = current_.emplace(nodeID, val);
             if (!inserted)
@@ -768,7 +871,32 @@ public:
                 }
             }
 
-            beast::expire(byLedger_, parms_.validationSET_EXPIRES);
+            // Readers of the published votes do not touch byLedger_, so
+            // the sets read since they were last touched, and recently
+            // enough to keep, are touched before the sweep.
+            auto const now = byLedger_.clock().now();
+            for (auto const& [ledgerID, slot] : *published())
+            {
+                auto const read =
+                    slot->lastRead.load(std::memory_order_relaxed);
+                auto const it = byLedger_.find(ledgerID);
+                if (it != byLedger_.end() && it.when() < read &&
+                    now - read < parms_.validationSET_EXPIRES)
+                    byLedger_.touch(it);
+            }
+
+            if (beast::expire(byLedger_, parms_.validationSET_EXPIRES) != 0)
+            {
+                auto next = std::make_shared<Published>(*published());
+                for (auto it = next->begin(); it != next->end();)
+                {
+                    if (byLedger_.find(it->first) == byLedger_.end())
+                        it = next->erase(it);
+                    else
+                        ++it;
+                }
+                setPublished(std::move(next));
+            }
             beast::expire(bySequence_, parms_.validationSET_EXPIRES);
         }
         JLOG(j.debug())
@@ -822,6 +950,8 @@ public:
                 }
             }
         }
+
+        publishAll(lock);
     }
 
     Json::Value
@@ -1033,17 +1163,9 @@ public:
     std::size_t
     numTrustedForLedger(ID const& ledgerID)
     {
-        std::size_t count = 0;
-        std::lock_guard lock{mutex_};
-        byLedger(
-            lock,
-            ledgerID,
-            [&](std::size_t) {},  // nothing to reserve
-            [&](NodeID const&, Validation const& v) {
-                if (v.trusted() && v.full())
-                    ++count;
-            });
-        return count;
+        if (auto const v = votes(ledgerID))
+            return v->trusted.size();
+        return 0;
     }
 
     /**  Get trusted full validations for a specific ledger
@@ -1056,16 +1178,15 @@ public:
     getTrustedForLedger(ID const& ledgerID, Seq const& seq)
     {
         std::vector<WrappedValidationType> res;
-        std::lock_guard lock{mutex_};
-        byLedger(
-            lock,
-            ledgerID,
-            [&](std::size_t numValidations) { res.reserve(numValidations); },
-            [&](NodeID const&, Validation const& v) {
-                if (v.trusted() && v.full() && v.seq() == seq)
+        if (auto const votes = this->votes(ledgerID))
+        {
+            res.reserve(votes->trusted.size());
+            for (auto const& v : votes->trusted)
+            {
+                if (v.seq() == seq)
                     res.emplace_back(v.unwrap());
-            });
-
+            }
+        }
         return res;
     }
 
@@ -1079,21 +1200,18 @@ public:
     fees(ID const& ledgerID, std::uint32_t baseFee)
     {
         std::vector<std::uint32_t> res;
-        std::lock_guard lock{mutex_};
-        byLedger(
-            lock,
-            ledgerID,
-            [&](std::size_t numValidations) { res.reserve(numValidations); },
-            [&](NodeID const&, Validation const& v) {
-                if (v.trusted() && v.full())
-                {
-                    std::optional<std::uint32_t> loadFee = v.loadFee();
-                    if (loadFee)
-                        res.push_back(*loadFee);
-                    else
-                        res.push_back(baseFee);
-                }
-            });
+        if (auto const votes = this->votes(ledgerID))
+        {
+            res.reserve(votes->trusted.size());
+            for (auto const& v : votes->trusted)
+            {
+                std::optional<std::uint32_t> loadFee = v.loadFee();
+                if (loadFee)
+                    res.push_back(*loadFee);
+                else
+                    res.push_back(baseFee);
+            }
+        }
         return res;
     }
 
@@ -1160,8 +1278,7 @@ public:
     std::size_t
     sizeOfByLedgerCache() const
     {
-        std::lock_guard lock{mutex_};
-        return byLedger_.size();
+        return published()->size();
     }
 
     std::size_t
@@ -36,6 +36,7 @@
 #include <cstdint>
 #include <map>
 #include <optional>
+#include <set>
 #include <string>
 #include <type_traits>
 #include <unordered_set>
@@ -62,6 +63,7 @@ enum class SizedItem : std::size_t {
     burstSize,
     ramSizeGB,
     accountIdCacheSize,
+    ledgerHeaderCache,
 };
 
 /** Fee schedule for startup / standalone, and to vote for.
@@ -162,6 +164,10 @@ public:
 
     std::string START_LEDGER;
 
+    // With REPLAY, the number of consecutive ledgers to replay and verify
+    // as a benchmark before stopping. Zero replays just the one ledger.
+    std::uint32_t REPLAY_COUNT = 0;
+
     // Network parameters
     uint32_t NETWORK_ID = 0;
 
@@ -207,6 +213,9 @@ public:
     int PATH_SEARCH_FAST = 2;
     int PATH_SEARCH_MAX = 3;
 
+    // The most threads one path request may search with
+    std::size_t PATH_SEARCH_THREADS = 1;
+
     // Validation
     std::optional<std::size_t>
         VALIDATION_QUORUM;  // validations to consider ledger authoritative
@@ -228,10 +237,19 @@ public:
 
     // Compression
     bool COMPRESSION = false;
+    // zstd dictionary shared with peers for compression, if any
+    std::string COMPRESSION_DICTIONARY;
 
     // Enable the experimental Ledger Replay functionality
     bool LEDGER_REPLAY = false;
 
+    // Mark transactions relayed to cluster members as verified, and trust
+    // that mark on transactions they relay to us
+    bool CLUSTER_VERIFY = false;
+
+    // Build the ledger of our consensus position before the round ends
+    bool SPECULATIVE_BUILD = false;
+
     // Work queue limits
     int MAX_TRANSACTIONS = 250;
     static constexpr int MAX_JOB_QUEUE_TX = 1000;
@@ -244,14 +262,61 @@ public:
     int WORKERS = 0;           // jobqueue thread count. default: upto 6
     int IO_WORKERS = 0;        // io svc thread count. default: 2
     int PREFETCH_WORKERS = 0;  // prefetch thread count. default: 4
+    int FLUSH_WORKERS = 0;     // ledger flush thread count. default: upto 8
+    int APPLY_WORKERS = 0;     // speculative apply thread count. default: off
+    int PUBLISH_WORKERS = 4;   // ledger publishing thread count. default: 4
+
+    // The CPUs the job queue and io service threads may run on, from the
+    // [threads] section. Empty lets them run anywhere.
+    std::vector<unsigned> JOB_QUEUE_CPUS;
+    std::vector<unsigned> IO_CPUS;
+
+    // Kilobytes of stack for each coroutine, whether a guard page goes
+    // below each stack, and the most stacks kept for reuse.
+    std::size_t CORO_STACK_KB = 1024;
+    bool CORO_STACK_GUARD = true;
+    std::size_t CORO_STACK_POOLED = 256;
 
     // Can only be set in code, specifically unit tests
     bool FORCE_MULTI_THREAD = false;
 
+    // The most log lines that may wait for the log writer thread, or 0 to
+    // write them on the thread logging them, and whether to write them as
+    // JSON.
+    std::size_t LOG_QUEUE = 0;
+    bool LOG_JSON = false;
+
     // Normally the sweep timer is automatically deduced based on the node
     // size, but we allow admins to explicitly set it in the config.
     std::optional<int> SWEEP_INTERVAL;
 
+    // Megabytes that the tree node cache may hold. If set, this replaces
+    // the number of entries deduced from the node size.
+    std::optional<std::size_t> TREE_CACHE_BUDGET;
+
+    // Megabytes the process may be resident in, over which the larger
+    // caches are shrunk at run time, or 0 to take the limit of its cgroup.
+    // Caches keep the targets deduced at startup if this is unset.
+    std::optional<std::size_t> MEMORY_LIMIT;
+
+    // Whether the tree node cache evicts nodes as others are added, rather
+    // than expiring them by age when it is swept.
+    bool TREE_CACHE_CLOCK = false;
+
+    // Where to keep a snapshot of the validated state map's inner nodes,
+    // which warms the tree node cache on start, and how many ledgers apart
+    // to write it. No snapshot is kept if the path is empty.
+    boost::filesystem::path STATE_SNAPSHOT_PATH;
+    std::uint32_t STATE_SNAPSHOT_INTERVAL = 256;
+
+    // Megabytes of RPC results to keep, and the methods whose results may
+    // be kept. No results are kept unless some methods are named.
+    std::size_t RPC_RESPONSE_CACHE_MB = 64;
+    std::set<std::string> RPC_RESPONSE_CACHE_METHODS;
+
+    // The issuers whose gateway_balances are indexed in the background.
+    std::vector<std::string> GATEWAY_BALANCES_INDEX;
+
     // Reduce-relay - these parameters are experimental.
     // Enable reduce-relay features
     // Validation/proposal reduce-relay feature
@@ -265,6 +330,9 @@ public:
     // Set log level to debug so that the feature function can be
     // analyzed.
     bool VP_REDUCE_RELAY_SQUELCH = false;
+    // Select the peers that deliver a validator's messages first as the
+    // source of its messages, rather than random peers.
+    bool VP_REDUCE_RELAY_SELECT_FASTEST = false;
     // Transaction reduce-relay feature
     bool TX_REDUCE_RELAY_ENABLE = false;
     // If tx reduce-relay feature is disabled
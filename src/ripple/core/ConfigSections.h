@@ -49,13 +49,19 @@ struct ConfigSection
 // VFALCO TODO Rename and replace these macros with variables.
 #define SECTION_AMENDMENTS "amendments"
 #define SECTION_AMENDMENT_MAJORITY_TIME "amendment_majority_time"
+#define SECTION_APPLY_WORKERS "apply_workers"
 #define SECTION_BETA_RPC_API "beta_rpc_api"
 #define SECTION_CLUSTER_NODES "cluster_nodes"
+#define SECTION_CLUSTER_VERIFY "cluster_verify"
 #define SECTION_COMPRESSION "compression"
+#define SECTION_COMPRESSION_DICTIONARY "compression_dictionary"
+#define SECTION_CORO_STACKS "coro_stacks"
 #define SECTION_DEBUG_LOGFILE "debug_logfile"
 #define SECTION_ELB_SUPPORT "elb_support"
 #define SECTION_FEE_DEFAULT "fee_default"
 #define SECTION_FETCH_DEPTH "fetch_depth"
+#define SECTION_FLUSH_WORKERS "flush_workers"
+#define SECTION_GATEWAY_BALANCES_INDEX "gateway_balances_index"
 #define SECTION_HISTORICAL_SHARD_PATHS "historical_shard_paths"
 #define SECTION_INSIGHT "insight"
 #define SECTION_IO_WORKERS "io_workers"
@@ -63,7 +69,9 @@ struct ConfigSection
 #define SECTION_IPS_FIXED "ips_fixed"
 #define SECTION_LEDGER_HISTORY "ledger_history"
 #define SECTION_LEDGER_REPLAY "ledger_replay"
+#define SECTION_LOGGING "logging"
 #define SECTION_MAX_TRANSACTIONS "max_transactions"
+#define SECTION_MEMORY_LIMIT "memory_limit"
 #define SECTION_NETWORK_ID "network_id"
 #define SECTION_NETWORK_QUORUM "network_quorum"
 #define SECTION_NODE_SEED "node_seed"
@@ -73,24 +81,32 @@ struct ConfigSection
 #define SECTION_PATH_SEARCH "path_search"
 #define SECTION_PATH_SEARCH_FAST "path_search_fast"
 #define SECTION_PATH_SEARCH_MAX "path_search_max"
+#define SECTION_PATH_SEARCH_THREADS "path_search_threads"
 #define SECTION_PEER_PRIVATE "peer_private"
 #define SECTION_PEERS_MAX "peers_max"
 #define SECTION_PEERS_IN_MAX "peers_in_max"
 #define SECTION_PEERS_OUT_MAX "peers_out_max"
 #define SECTION_PORT_GRPC "port_grpc"
 #define SECTION_PREFETCH_WORKERS "prefetch_workers"
+#define SECTION_PUBLISH_WORKERS "publish_workers"
 #define SECTION_REDUCE_RELAY "reduce_relay"
 #define SECTION_RELATIONAL_DB "relational_db"
 #define SECTION_RELAY_PROPOSALS "relay_proposals"
 #define SECTION_RELAY_VALIDATIONS "relay_validations"
+#define SECTION_RPC_RESPONSE_CACHE "rpc_response_cache"
 #define SECTION_RPC_STARTUP "rpc_startup"
 #define SECTION_SIGNING_SUPPORT "signing_support"
 #define SECTION_SNTP "sntp_servers"
+#define SECTION_SPECULATIVE_BUILD "speculative_build"
+#define SECTION_STATE_SNAPSHOT "state_snapshot"
 #define SECTION_SSL_VERIFY "ssl_verify"
 #define SECTION_SSL_VERIFY_FILE "ssl_verify_file"
 #define SECTION_SSL_VERIFY_DIR "ssl_verify_dir"
 #define SECTION_SERVER_DOMAIN "server_domain"
 #define SECTION_SWEEP_INTERVAL "sweep_interval"
+#define SECTION_THREADS "threads"
+#define SECTION_TREE_CACHE_BUDGET "tree_cache_budget"
+#define SECTION_TREE_CACHE_EVICTION "tree_cache_eviction"
 #define SECTION_VALIDATORS_FILE "validators_file"
 #define SECTION_VALIDATION_SEED "validation_seed"
 #define SECTION_VALIDATOR_KEYS "validator_keys"
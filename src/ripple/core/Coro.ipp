@@ -20,8 +20,6 @@
 #ifndef RIPPLE_CORE_COROINL_H_INCLUDED
 #define RIPPLE_CORE_COROINL_H_INCLUDED
 
-#include <ripple/basics/ByteUtilities.h>
-
 namespace ripple {
 
 template <class F>
@@ -46,7 +44,8 @@ JobQueue::Coro::Coro(
               finished_ = true;
 #endif
           },
-          boost::coroutines::attributes(megabytes(1)))
+          boost::coroutines::attributes(jq.coroStacks_.size()),
+          jq.coroStacks_.allocator())
 {
 }
 
@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_CORE_COROSTACKPOOL_H_INCLUDED
+#define RIPPLE_CORE_COROSTACKPOOL_H_INCLUDED
+
+#include <ripple/basics/ByteUtilities.h>
+#include <ripple/json/json_value.h>
+#include <boost/coroutine/stack_context.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+/** Keeps the stacks of finished coroutines for the next ones to use.
+
+    Each stack is mapped on its own, with an optional guard page below it
+    which faults if a coroutine overflows its stack. Mapping a stack and
+    faulting in its pages costs far more than running a short request, so
+    a stack is kept once its coroutine finishes, up to a limit, rather
+    than unmapped.
+*/
+class CoroStackPool
+{
+public:
+    struct Setup
+    {
+        // The usable bytes of each stack, rounded up to whole pages
+        std::size_t size = megabytes(1);
+
+        // Whether to put a page that faults below each stack
+        bool guard = true;
+
+        // The most stacks kept once their coroutines finish
+        std::size_t maxPooled = 256;
+    };
+
+    /** What a coroutine allocates its stack with.
+
+        Boost keeps a copy of it in each coroutine, so it only refers to
+        the pool, which must outlive the coroutine.
+    */
+    class Allocator
+    {
+    public:
+        explicit Allocator(CoroStackPool& pool) : pool_(&pool)
+        {
+        }
+
+        void
+        allocate(boost::coroutines::stack_context& sctx, std::size_t size)
+        {
+            pool_->allocate(sctx, size);
+        }
+
+        void
+        deallocate(boost::coroutines::stack_context& sctx)
+        {
+            pool_->deallocate(sctx);
+        }
+
+    private:
+        CoroStackPool* pool_;
+    };
+
+    explicit CoroStackPool(Setup const& setup);
+
+    CoroStackPool(CoroStackPool const&) = delete;
+    CoroStackPool&
+    operator=(CoroStackPool const&) = delete;
+
+    ~CoroStackPool();
+
+    Allocator
+    allocator()
+    {
+        return Allocator(*this);
+    }
+
+    /** The usable bytes of each stack. */
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /** Stacks in use and kept, and how many were reused. */
+    Json::Value
+    getJson() const;
+
+private:
+    void
+    allocate(boost::coroutines::stack_context& sctx, std::size_t size);
+
+    void
+    deallocate(boost::coroutines::stack_context& sctx);
+
+    std::size_t const page_;
+    std::size_t const size_;
+    std::size_t const guard_;
+    std::size_t const maxPooled_;
+
+    std::mutex mutable mutex_;
+    // The tops of the stacks kept, most recently used last
+    std::vector<void*> pooled_;
+    std::size_t inUse_ = 0;
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
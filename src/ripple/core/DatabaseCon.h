@@ -24,9 +24,11 @@
 #include <ripple/core/Config.h>
 #include <ripple/core/SociDB.h>
 #include <boost/filesystem/path.hpp>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace soci {
 class session;
@@ -48,6 +50,12 @@ public:
         : session_(std::move(it)), lock_(m)
     {
     }
+    LockedSociSession(
+        std::shared_ptr<soci::session> it,
+        std::unique_lock<mutex> lock)
+        : session_(std::move(it)), lock_(std::move(lock))
+    {
+    }
     LockedSociSession(LockedSociSession&& rhs) noexcept
         : session_(std::move(rhs.session_)), lock_(std::move(rhs.lock_))
     {
@@ -92,6 +100,9 @@ public:
         // Indicates whether or not to return the `globalPragma`
         // from commonPragma()
         bool useGlobalPragma = false;
+        // The number of read-only connections to open next to the one
+        // that writes. Only used for databases on disk in WAL mode.
+        std::size_t readConnections = 0;
 
         std::vector<std::string> const*
         commonPragma() const
@@ -126,7 +137,8 @@ public:
                   : (setup.dataDir / dbName),
               setup.commonPragma(),
               pragma,
-              initSQL)
+              initSQL,
+              setup.readConnections)
     {
     }
 
@@ -149,7 +161,7 @@ public:
         std::string const& dbName,
         std::array<char const*, N> const& pragma,
         std::array<char const*, M> const& initSQL)
-        : DatabaseCon(dataDir / dbName, nullptr, pragma, initSQL)
+        : DatabaseCon(dataDir / dbName, nullptr, pragma, initSQL, 0)
     {
     }
 
@@ -180,6 +192,25 @@ public:
         return LockedSociSession(session_, lock_);
     }
 
+    /** Check out a connection that only reads.
+
+        Under WAL, readers do not block each other or the writer, so
+        queries that only read take one of the read-only connections
+        instead of waiting on the one that writes. A thread starts its
+        search at a connection of its own, so that threads spread over
+        them, and takes the first that is free. If none is, it waits on
+        its own. Without read-only connections, this is checkoutDb().
+    */
+    LockedSociSession
+    checkoutReadDb();
+
+    /** The number of read-only connections. */
+    std::size_t
+    readConnections() const
+    {
+        return readers_.size();
+    }
+
 private:
     void
     setupCheckpointing(JobQueue*, Logs&);
@@ -189,31 +220,53 @@ private:
         boost::filesystem::path const& pPath,
         std::vector<std::string> const* commonPragma,
         std::array<char const*, N> const& pragma,
-        std::array<char const*, M> const& initSQL)
+        std::array<char const*, M> const& initSQL,
+        std::size_t readConnections)
         : session_(std::make_shared<soci::session>())
     {
-        open(*session_, "sqlite", pPath.string());
+        auto const configure = [&](soci::session& session) {
+            open(session, "sqlite", pPath.string());
 
-        if (commonPragma)
-        {
-            for (auto const& p : *commonPragma)
+            if (commonPragma)
             {
-                soci::statement st = session_->prepare << p;
+                for (auto const& p : *commonPragma)
+                {
+                    soci::statement st = session.prepare << p;
+                    st.execute(true);
+                }
+            }
+            for (auto const& p : pragma)
+            {
+                soci::statement st = session.prepare << p;
                 st.execute(true);
             }
-        }
-        for (auto const& p : pragma)
-        {
-            soci::statement st = session_->prepare << p;
-            st.execute(true);
-        }
+        };
+
+        configure(*session_);
         for (auto const& sql : initSQL)
         {
             soci::statement st = session_->prepare << sql;
             st.execute(true);
         }
+
+        // A temporary database is private to its connection, and outside
+        // of WAL, a reader holds off the writer.
+        if (readConnections == 0 || pPath.empty() || !isWal())
+            return;
+
+        readers_.reserve(readConnections);
+        for (std::size_t i = 0; i < readConnections; ++i)
+        {
+            auto reader = std::make_unique<Reader>();
+            configure(*reader->session);
+            *reader->session << "PRAGMA query_only=ON;";
+            readers_.push_back(std::move(reader));
+        }
     }
 
+    bool
+    isWal();
+
     LockedSociSession::mutex lock_;
 
     // checkpointer may outlive the DatabaseCon when the checkpointer jobQueue
@@ -224,6 +277,16 @@ private:
     // shared_ptr in this class. session_ will never be null.
     std::shared_ptr<soci::session> const session_;
     std::shared_ptr<Checkpointer> checkpointer_;
+
+    struct Reader
+    {
+        std::shared_ptr<soci::session> const session =
+            std::make_shared<soci::session>();
+        LockedSociSession::mutex mutex;
+    };
+
+    // Connections opened with query_only, each behind its own lock
+    std::vector<std::unique_ptr<Reader>> readers_;
 };
 
 // Return the checkpointer from its id. If the checkpointer no longer exists, an
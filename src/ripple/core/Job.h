@@ -41,6 +41,10 @@ enum JobType {
     // insert a job at a specific priority, simply add it at the right location.
 
     jtPACK,               // Make a fetch pack for a peer
+    jtSNAPSHOT,           // Write a snapshot of the validated state map
+    jtGATEWAY_INDEX,      // Update the gateway balances index
+    jtLEDGER_PREFETCH,    // Load the ledgers ahead of a sequential walk
+    jtHISTORY_DATA,       // Received data for a past ledger we're acquiring
     jtPUBOLDLEDGER,       // An old ledger has been accepted
     jtCLIENT,             // A placeholder for the priority of all jtCLIENT jobs
     jtCLIENT_SUBSCRIBE,   // A websocket subscription by a client
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_CORE_JOBLATENCYPROBE_H_INCLUDED
+#define RIPPLE_CORE_JOBLATENCYPROBE_H_INCLUDED
+
+#include <ripple/basics/Histogram.h>
+#include <ripple/beast/insight/Collector.h>
+#include <ripple/beast/insight/Event.h>
+#include <ripple/core/Job.h>
+#include <ripple/json/json_value.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace ripple {
+
+class JobQueue;
+
+/** Returns the count, percentiles and largest of a latency histogram. */
+Json::Value
+toJson(Histogram const& latencies);
+
+/** Measures how long jobs wait in the JobQueue at several priorities.
+
+    Each sample queues a no-op job under every probed type that has no
+    probe waiting yet, and records the time until it starts. The JobQueue
+    only accounts for the waits of real jobs, and only while there are
+    some, where a probe shows what a new job would see at any time.
+*/
+class JobLatencyProbe
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    JobLatencyProbe(
+        JobQueue& jobQueue,
+        beast::insight::Collector::ptr const& collector,
+        std::chrono::milliseconds interval);
+
+    /** Queue the probes, if an interval has passed since the last ones. */
+    void
+    sample();
+
+    /** Returns the latency distribution for each probed job type. */
+    Json::Value
+    getJson() const;
+
+private:
+    struct Probe
+    {
+        Probe(JobType type, beast::insight::Event event)
+            : type(type), event(std::move(event))
+        {
+        }
+
+        JobType const type;
+        beast::insight::Event const event;
+        // In microseconds
+        Histogram latencies;
+        std::atomic<bool> waiting = false;
+    };
+
+    void
+    onStart(Probe& probe, clock_type::time_point queued);
+
+    JobQueue& jobQueue_;
+    std::chrono::milliseconds const interval_;
+    std::vector<std::unique_ptr<Probe>> probes_;
+    std::atomic<clock_type::time_point> last_{};
+};
+
+}  // namespace ripple
+
+#endif
@@ -21,7 +21,9 @@
 #define RIPPLE_CORE_JOBQUEUE_H_INCLUDED
 
 #include <ripple/basics/LocalValue.h>
+#include <ripple/basics/ProfiledMutex.h>
 #include <ripple/core/ClosureCounter.h>
+#include <ripple/core/CoroStackPool.h>
 #include <ripple/core/JobTypeData.h>
 #include <ripple/core/JobTypes.h>
 #include <ripple/core/impl/Workers.h>
@@ -29,6 +31,10 @@
 #include <boost/coroutine/all.hpp>
 #include <boost/range/begin.hpp>  // workaround for boost 1.72 bug
 #include <boost/range/end.hpp>    // workaround for boost 1.72 bug
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <vector>
 
 namespace ripple {
 
@@ -145,7 +151,9 @@ public:
         beast::insight::Collector::ptr const& collector,
         beast::Journal journal,
         Logs& logs,
-        perf::PerfLog& perfLog);
+        perf::PerfLog& perfLog,
+        std::vector<unsigned> const& cpus = {},
+        CoroStackPool::Setup const& coroStacks = {});
     ~JobQueue();
 
     /** Adds a job to the JobQueue.
@@ -173,6 +181,29 @@ public:
         return false;
     }
 
+    /** Calls a function for each index below a count, on several threads.
+
+        The calls are spread over the calling thread and up to jobs - 1
+        jobs of one type, queued together. The calling thread keeps taking
+        calls until none are left, so it never waits on a job that has not
+        started, and it may itself be a job of that type.
+
+        @param type The type of the helper jobs.
+        @param name Name of the helper jobs.
+        @param count The number of calls to make, f(0) to f(count - 1).
+        @param jobs The most threads to make calls on, including this one.
+        @param f The function to call. It must not throw.
+
+        Returns once every call has returned.
+    */
+    void
+    parallelFor(
+        JobType type,
+        std::string const& name,
+        std::size_t count,
+        std::size_t jobs,
+        std::function<void(std::size_t)> const& f);
+
     /** Creates a coroutine and adds a job to the queue which will run it.
 
         @param t The type of job.
@@ -243,21 +274,40 @@ private:
     using JobDataMap = std::map<JobType, JobTypeData>;
 
     beast::Journal m_journal;
-    mutable std::mutex m_mutex;
-    std::uint64_t m_lastJob;
-    std::set<Job> m_jobSet;
+    mutable ProfiledMutex<std::mutex> m_mutex{"JobQueue"};
+    std::atomic<std::uint64_t> m_lastJob;
     JobCounter jobCounter_;
     std::atomic_bool stopping_{false};
     std::atomic_bool stopped_{false};
     JobDataMap m_jobData;
     JobTypeData m_invalidJobData;
 
+    // The types the workers take jobs from, highest priority first. Each
+    // type keeps its own queue, so queueing a job allocates no tree node
+    // and the next job is found without walking past blocked ones.
+    std::vector<JobTypeData*> m_byPriority;
+
+    // The number of jobs waiting, of every type
+    std::size_t m_jobCount = 0;
+
+    // A job waiting past the deadline of its type is run ahead of jobs of
+    // higher priority, but never ahead of this type or those above it,
+    // which keep consensus and the ledger moving.
+    static constexpr JobType agingCeiling = jtTRANSACTION;
+
+    // The most late jobs run in a row ahead of the highest priority job
+    static constexpr int maxAgedInRow = 4;
+    int m_agedInRow = 0;
+
     // The number of jobs currently in processTask()
     int m_processCount;
 
     // The number of suspended coroutines
     int nSuspend_ = 0;
 
+    // Must outlive the workers, which run the coroutines
+    CoroStackPool coroStacks_;
+
     Workers m_workers;
 
     // Statistics tracking
@@ -266,7 +316,7 @@ private:
     beast::insight::Gauge job_count;
     beast::insight::Hook hook;
 
-    std::condition_variable cv_;
+    ProfiledConditionVariable cv_;
 
     void
     collect();
@@ -287,18 +337,35 @@ private:
         std::string const& name,
         JobFunction const& func);
 
+    // Adds reference counted jobs of one type under one lock and wakes the
+    // workers for those that are not deferred in a single step.
+    //
+    //    return true if the jobs were added to the queue.
+    bool
+    addRefCountedJobs(
+        JobType type,
+        std::string const& name,
+        std::vector<JobFunction> funcs);
+
     // Returns the next Job we should run now.
     //
     // RunnableJob:
-    //  A Job in the JobSet whose slots count for its type is greater than zero.
+    //  The oldest waiting Job of a type running fewer jobs than its limit.
+    //
+    // LateJob:
+    //  A RunnableJob that has waited longer than the deadline of its type.
     //
     // Pre-conditions:
-    //  mJobSet must not be empty.
-    //  mJobSet holds at least one RunnableJob
+    //  At least one Job is waiting.
+    //  At least one RunnableJob is waiting.
     //
     // Post-conditions:
-    //  job is a valid Job object.
-    //  job is removed from mJobQueue.
+    //  job is the RunnableJob of the highest priority type, unless that
+    //  type is below agingCeiling and a LateJob is waiting. Then job is
+    //  the LateJob furthest past its deadline, unless maxAgedInRow
+    //  LateJobs were just run that way.
+    //  The missed deadline count of its type is incremented if it is late.
+    //  job is removed from the queue of its type.
     //  Waiting job count of its type is decremented
     //  Running job count of its type is incremented
     //
@@ -310,7 +377,7 @@ private:
     // Indicates that a running Job has completed its task.
     //
     // Pre-conditions:
-    //  Job must not exist in mJobSet.
+    //  Job must not be waiting in the queue of its type.
     //  The JobType must not be invalid.
     //
     // Post-conditions:
@@ -326,7 +393,7 @@ private:
     // Runs the next appropriate waiting Job.
     //
     // Pre-conditions:
-    //  A RunnableJob must exist in the JobSet
+    //  A RunnableJob must be waiting
     //
     // Post-conditions:
     //  The chosen RunnableJob will have Job::doJob() called.
@@ -22,7 +22,10 @@
 
 #include <ripple/basics/Log.h>
 #include <ripple/beast/insight/Collector.h>
+#include <ripple/core/Job.h>
 #include <ripple/core/JobTypeInfo.h>
+#include <cstdint>
+#include <deque>
 
 namespace ripple {
 
@@ -38,6 +41,9 @@ public:
     /* The job category which we represent */
     JobTypeInfo const& info;
 
+    /* The jobs waiting, oldest first */
+    std::deque<Job> jobs;
+
     /* The number of jobs waiting */
     int waiting;
 
@@ -47,9 +53,13 @@ public:
     /* And the number we deferred executing because of job limits */
     int deferred;
 
+    /* The number that waited longer than the deadline of the type */
+    std::uint64_t missed;
+
     /* Notification callbacks */
     beast::insight::Event dequeue;
     beast::insight::Event execute;
+    beast::insight::Counter deadlineMissed;
 
     JobTypeData(
         JobTypeInfo const& info_,
@@ -61,6 +71,7 @@ public:
         , waiting(0)
         , running(0)
         , deferred(0)
+        , missed(0)
     {
         m_load.setTargetLatency(
             info.getAverageLatency(), info.getPeakLatency());
@@ -69,6 +80,9 @@ public:
         {
             dequeue = m_collector->make_event(info.name() + "_q");
             execute = m_collector->make_event(info.name());
+            if (info.getDeadline() != std::chrono::milliseconds{0})
+                deadlineMissed =
+                    m_collector->make_counter(info.name() + "_missed");
         }
     }
 
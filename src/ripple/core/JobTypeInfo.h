@@ -42,6 +42,13 @@ private:
     std::chrono::milliseconds const m_avgLatency;
     std::chrono::milliseconds const m_peakLatency;
 
+    /** How long a job of this type should wait at most. 0 is none.
+
+        A job waiting past its deadline is run ahead of jobs of higher
+        priority, up to the types that keep consensus and the ledger moving.
+     */
+    std::chrono::milliseconds const m_deadline;
+
 public:
     // Not default constructible
     JobTypeInfo() = delete;
@@ -51,12 +58,14 @@ public:
         std::string name,
         int limit,
         std::chrono::milliseconds avgLatency,
-        std::chrono::milliseconds peakLatency)
+        std::chrono::milliseconds peakLatency,
+        std::chrono::milliseconds deadline)
         : m_type(type)
         , m_name(std::move(name))
         , m_limit(limit)
         , m_avgLatency(avgLatency)
         , m_peakLatency(peakLatency)
+        , m_deadline(deadline)
     {
     }
 
@@ -95,6 +104,12 @@ public:
     {
         return m_peakLatency;
     }
+
+    std::chrono::milliseconds
+    getDeadline() const
+    {
+        return m_deadline;
+    }
 };
 
 }  // namespace ripple
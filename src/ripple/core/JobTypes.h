@@ -42,6 +42,7 @@ private:
               "invalid",
               0,
               std::chrono::milliseconds{0},
+              std::chrono::milliseconds{0},
               std::chrono::milliseconds{0})
     {
         using namespace std::chrono_literals;
@@ -52,14 +53,15 @@ private:
                        std::string name,
                        int limit,
                        std::chrono::milliseconds avgLatency,
-                       std::chrono::milliseconds peakLatency) {
+                       std::chrono::milliseconds peakLatency,
+                       std::chrono::milliseconds deadline) {
             assert(m_map.find(jt) == m_map.end());
 
             auto const [_, inserted] = m_map.emplace(
                 std::piecewise_construct,
                 std::forward_as_tuple(jt),
                 std::forward_as_tuple(
-                    jt, name, limit, avgLatency, peakLatency));
+                    jt, name, limit, avgLatency, peakLatency, deadline));
 
             assert(inserted == true);
             (void)_;
@@ -68,55 +70,59 @@ private:
 
         // clang-format off
         //                                                           avg     peak
-        //  JobType               name                    limit    latency  latency
-        add(jtPACK,              "makeFetchPack",               1,     0ms,     0ms);
-        add(jtPUBOLDLEDGER,      "publishAcqLedger",            2, 10000ms, 15000ms);
-        add(jtVALIDATION_ut,     "untrustedValidation",  maxLimit,  2000ms,  5000ms);
-        add(jtMANIFEST,          "manifest",             maxLimit,  2000ms,  5000ms);
-        add(jtTRANSACTION_l,     "localTransaction",     maxLimit,   100ms,   500ms);
-        add(jtREPLAY_REQ,        "ledgerReplayRequest",        10,   250ms,  1000ms);
-        add(jtLEDGER_REQ,        "ledgerRequest",               3,     0ms,     0ms);
-        add(jtPROPOSAL_ut,       "untrustedProposal",    maxLimit,   500ms,  1250ms);
-        add(jtREPLAY_TASK,       "ledgerReplayTask",     maxLimit,     0ms,     0ms);
-        add(jtLEDGER_DATA,       "ledgerData",                  3,     0ms,     0ms);
-        add(jtCLIENT,            "clientCommand",        maxLimit,  2000ms,  5000ms);
-        add(jtCLIENT_SUBSCRIBE,  "clientSubscribe",      maxLimit,  2000ms,  5000ms);
-        add(jtCLIENT_FEE_CHANGE, "clientFeeChange",      maxLimit,  2000ms,  5000ms);
-        add(jtCLIENT_CONSENSUS,  "clientConsensus",      maxLimit,  2000ms,  5000ms);
-        add(jtCLIENT_ACCT_HIST,  "clientAccountHistory", maxLimit,  2000ms,  5000ms);
-        add(jtCLIENT_SHARD,      "clientShardArchive",   maxLimit,  2000ms,  5000ms);
-        add(jtCLIENT_RPC,        "clientRPC",            maxLimit,  2000ms,  5000ms);
-        add(jtCLIENT_WEBSOCKET,  "clientWebsocket",      maxLimit,  2000ms,  5000ms);
-        add(jtRPC,               "RPC",                  maxLimit,     0ms,     0ms);
-        add(jtUPDATE_PF,         "updatePaths",                 1,     0ms,     0ms);
-        add(jtTRANSACTION,       "transaction",          maxLimit,   250ms,  1000ms);
-        add(jtBATCH,             "batch",                maxLimit,   250ms,  1000ms);
-        add(jtADVANCE,           "advanceLedger",        maxLimit,     0ms,     0ms);
-        add(jtPUBLEDGER,         "publishNewLedger",     maxLimit,  3000ms,  4500ms);
-        add(jtTXN_DATA,          "fetchTxnData",                5,     0ms,     0ms);
-        add(jtWAL,               "writeAhead",           maxLimit,  1000ms,  2500ms);
-        add(jtVALIDATION_t,      "trustedValidation",    maxLimit,   500ms,  1500ms);
-        add(jtWRITE,             "writeObjects",         maxLimit,  1750ms,  2500ms);
-        add(jtACCEPT,            "acceptLedger",         maxLimit,     0ms,     0ms);
-        add(jtPROPOSAL_t,        "trustedProposal",      maxLimit,   100ms,   500ms);
-        add(jtSWEEP,             "sweep",                       1,     0ms,     0ms);
-        add(jtNETOP_CLUSTER,     "clusterReport",               1,  9999ms,  9999ms);
-        add(jtNETOP_TIMER,       "heartbeat",                   1,   999ms,   999ms);
-        add(jtADMIN,             "administration",       maxLimit,     0ms,     0ms);
-        add(jtMISSING_TXN,       "handleHaveTransactions",   1200,     0ms,     0ms);
-        add(jtREQUESTED_TXN,     "doTransactions",           1200,     0ms,     0ms);
-
-        add(jtPEER,              "peerCommand",                 0,   200ms,  2500ms);
-        add(jtDISK,              "diskAccess",                  0,   500ms,  1000ms);
-        add(jtTXN_PROC,          "processTransaction",          0,     0ms,     0ms);
-        add(jtOB_SETUP,          "orderBookSetup",              0,     0ms,     0ms);
-        add(jtPATH_FIND,         "pathFind",                    0,     0ms,     0ms);
-        add(jtHO_READ,           "nodeRead",                    0,     0ms,     0ms);
-        add(jtHO_WRITE,          "nodeWrite",                   0,     0ms,     0ms);
-        add(jtGENERIC,           "generic",                     0,     0ms,     0ms);
-        add(jtNS_SYNC_READ,      "SyncReadNode",                0,     0ms,     0ms);
-        add(jtNS_ASYNC_READ,     "AsyncReadNode",               0,     0ms,     0ms);
-        add(jtNS_WRITE,          "WriteNode",                   0,     0ms,     0ms);
+        //  JobType               name                    limit    latency  latency  deadline
+        add(jtPACK,              "makeFetchPack",               1,     0ms,     0ms,  10000ms);
+        add(jtSNAPSHOT,          "stateSnapshot",               1,     0ms,     0ms,      0ms);
+        add(jtGATEWAY_INDEX,     "gatewayBalancesIndex",        1,     0ms,     0ms,      0ms);
+        add(jtLEDGER_PREFETCH,   "ledgerPrefetch",              1,     0ms,     0ms,      0ms);
+        add(jtHISTORY_DATA,      "historyData",                 2,     0ms,     0ms,      0ms);
+        add(jtPUBOLDLEDGER,      "publishAcqLedger",            2, 10000ms, 15000ms,      0ms);
+        add(jtVALIDATION_ut,     "untrustedValidation",  maxLimit,  2000ms,  5000ms,      0ms);
+        add(jtMANIFEST,          "manifest",             maxLimit,  2000ms,  5000ms,      0ms);
+        add(jtTRANSACTION_l,     "localTransaction",     maxLimit,   100ms,   500ms,      0ms);
+        add(jtREPLAY_REQ,        "ledgerReplayRequest",        10,   250ms,  1000ms,   1000ms);
+        add(jtLEDGER_REQ,        "ledgerRequest",               3,     0ms,     0ms,   1000ms);
+        add(jtPROPOSAL_ut,       "untrustedProposal",    maxLimit,   500ms,  1250ms,      0ms);
+        add(jtREPLAY_TASK,       "ledgerReplayTask",     maxLimit,     0ms,     0ms,      0ms);
+        add(jtLEDGER_DATA,       "ledgerData",                  3,     0ms,     0ms,      0ms);
+        add(jtCLIENT,            "clientCommand",        maxLimit,  2000ms,  5000ms,   2000ms);
+        add(jtCLIENT_SUBSCRIBE,  "clientSubscribe",      maxLimit,  2000ms,  5000ms,      0ms);
+        add(jtCLIENT_FEE_CHANGE, "clientFeeChange",      maxLimit,  2000ms,  5000ms,      0ms);
+        add(jtCLIENT_CONSENSUS,  "clientConsensus",      maxLimit,  2000ms,  5000ms,      0ms);
+        add(jtCLIENT_ACCT_HIST,  "clientAccountHistory", maxLimit,  2000ms,  5000ms,   2000ms);
+        add(jtCLIENT_SHARD,      "clientShardArchive",   maxLimit,  2000ms,  5000ms,      0ms);
+        add(jtCLIENT_RPC,        "clientRPC",            maxLimit,  2000ms,  5000ms,   1000ms);
+        add(jtCLIENT_WEBSOCKET,  "clientWebsocket",      maxLimit,  2000ms,  5000ms,   1000ms);
+        add(jtRPC,               "RPC",                  maxLimit,     0ms,     0ms,   1000ms);
+        add(jtUPDATE_PF,         "updatePaths",                 1,     0ms,     0ms,   2000ms);
+        add(jtTRANSACTION,       "transaction",          maxLimit,   250ms,  1000ms,      0ms);
+        add(jtBATCH,             "batch",                maxLimit,   250ms,  1000ms,      0ms);
+        add(jtADVANCE,           "advanceLedger",        maxLimit,     0ms,     0ms,      0ms);
+        add(jtPUBLEDGER,         "publishNewLedger",     maxLimit,  3000ms,  4500ms,      0ms);
+        add(jtTXN_DATA,          "fetchTxnData",                5,     0ms,     0ms,      0ms);
+        add(jtWAL,               "writeAhead",           maxLimit,  1000ms,  2500ms,      0ms);
+        add(jtVALIDATION_t,      "trustedValidation",    maxLimit,   500ms,  1500ms,      0ms);
+        add(jtWRITE,             "writeObjects",         maxLimit,  1750ms,  2500ms,      0ms);
+        add(jtACCEPT,            "acceptLedger",         maxLimit,     0ms,     0ms,      0ms);
+        add(jtPROPOSAL_t,        "trustedProposal",      maxLimit,   100ms,   500ms,      0ms);
+        add(jtSWEEP,             "sweep",                       1,     0ms,     0ms,      0ms);
+        add(jtNETOP_CLUSTER,     "clusterReport",               1,  9999ms,  9999ms,      0ms);
+        add(jtNETOP_TIMER,       "heartbeat",                   1,   999ms,   999ms,      0ms);
+        add(jtADMIN,             "administration",       maxLimit,     0ms,     0ms,      0ms);
+        add(jtMISSING_TXN,       "handleHaveTransactions",   1200,     0ms,     0ms,      0ms);
+        add(jtREQUESTED_TXN,     "doTransactions",           1200,     0ms,     0ms,      0ms);
+
+        add(jtPEER,              "peerCommand",                 0,   200ms,  2500ms,      0ms);
+        add(jtDISK,              "diskAccess",                  0,   500ms,  1000ms,      0ms);
+        add(jtTXN_PROC,          "processTransaction",          0,     0ms,     0ms,      0ms);
+        add(jtOB_SETUP,          "orderBookSetup",              0,     0ms,     0ms,      0ms);
+        add(jtPATH_FIND,         "pathFind",                    0,     0ms,     0ms,      0ms);
+        add(jtHO_READ,           "nodeRead",                    0,     0ms,     0ms,      0ms);
+        add(jtHO_WRITE,          "nodeWrite",                   0,     0ms,     0ms,      0ms);
+        add(jtGENERIC,           "generic",                     0,     0ms,     0ms,      0ms);
+        add(jtNS_SYNC_READ,      "SyncReadNode",                0,     0ms,     0ms,      0ms);
+        add(jtNS_ASYNC_READ,     "AsyncReadNode",               0,     0ms,     0ms,      0ms);
+        add(jtNS_WRITE,          "WriteNode",                   0,     0ms,     0ms,      0ms);
         // clang-format on
     }
 
@@ -240,6 +240,20 @@ Pg::query(pg_params const& dbParams)
 
 void
 Pg::bulkInsert(char const* table, std::string const& records)
+{
+    bool sent = false;
+    bulkInsert(table, [&records, &sent](std::string_view& chunk) {
+        if (std::exchange(sent, true))
+            return false;
+        chunk = records;
+        return true;
+    });
+}
+
+void
+Pg::bulkInsert(
+    char const* table,
+    std::function<bool(std::string_view&)> const& next)
 {
     // https://www.postgresql.org/docs/12/libpq-copy.html#LIBPQ-COPY-SEND
     assert(conn_.get());
@@ -255,13 +269,21 @@ Pg::bulkInsert(char const* table, std::string const& records)
         Throw<std::runtime_error>(ss.str());
     }
 
-    if (PQputCopyData(conn_.get(), records.c_str(), records.size()) == -1)
+    // The connection is blocking, so each chunk has been handed to libpq
+    // by the time PQputCopyData returns and the caller may reuse it.
+    std::string_view chunk;
+    while (next(chunk))
     {
-        std::stringstream ss;
-        ss << "bulkInsert to " << table
-           << ". PQputCopyData error: " << PQerrorMessage(conn_.get());
-        disconnect();
-        Throw<std::runtime_error>(ss.str());
+        if (chunk.empty())
+            continue;
+        if (PQputCopyData(conn_.get(), chunk.data(), chunk.size()) == -1)
+        {
+            std::stringstream ss;
+            ss << "bulkInsert to " << table
+               << ". PQputCopyData error: " << PQerrorMessage(conn_.get());
+            disconnect();
+            Throw<std::runtime_error>(ss.str());
+        }
     }
 
     if (PQputCopyEnd(conn_.get(), nullptr) == -1)
@@ -34,6 +34,7 @@
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -333,6 +334,22 @@ class Pg
     void
     bulkInsert(char const* table, std::string const& records);
 
+    /** Insert records into a table using Postgres' bulk COPY, sending them
+     *  in chunks as they are produced rather than all at once.
+     *
+     * Throws upon error.
+     *
+     * @param table Name of table for import.
+     * @param next Called until it returns false. Each call that returns
+     *             true sets its argument to the next chunk of records in
+     *             the COPY IN format, which must stay valid until the
+     *             following call.
+     */
+    void
+    bulkInsert(
+        char const* table,
+        std::function<bool(std::string_view&)> const& next);
+
 public:
     /** Constructor for Pg class.
      *
@@ -491,6 +508,22 @@ public:
     {
         pg_->bulkInsert(table, records);
     }
+
+    /** Insert records into a table using Postgres' bulk COPY, sending them
+     *  in chunks as they are produced.
+     *
+     * Throws upon error.
+     *
+     * @param table Name of table for import.
+     * @param next Produces the chunks, as for Pg::bulkInsert.
+     */
+    void
+    bulkInsert(
+        char const* table,
+        std::function<bool(std::string_view&)> const& next)
+    {
+        pg_->bulkInsert(table, next);
+    }
 };
 
 //-----------------------------------------------------------------------------
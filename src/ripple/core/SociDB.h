@@ -37,12 +37,14 @@
 #include <ripple/core/JobQueue.h>
 #define SOCI_USE_BOOST
 #include <cstdint>
+#include <optional>
 #include <soci/soci.h>
 #include <string>
 #include <vector>
 
 namespace sqlite_api {
 struct sqlite3;
+struct sqlite3_stmt;
 }
 
 namespace ripple {
@@ -111,6 +113,78 @@ convert(std::vector<std::uint8_t> const& from, soci::blob& to);
 void
 convert(std::string const& from, soci::blob& to);
 
+/** A statement prepared once for a connection and kept for reuse.
+
+    For small queries, building and parsing the SQL costs more than
+    running it. A statement taken through this class is prepared the first
+    time its SQL is seen on a connection, takes its values as bound
+    parameters, and goes back to the connection's cache, reset, when the
+    object is destroyed. If the cached statement is already in use, as by
+    a nested query, a statement of its own is prepared for the object.
+
+    The caller must hold the session for as long as it has the statement,
+    and clearStatementCache() must be called before the session closes.
+*/
+class CachedStatement
+{
+public:
+    CachedStatement(soci::session& session, std::string const& sql);
+    ~CachedStatement();
+
+    CachedStatement(CachedStatement const&) = delete;
+    CachedStatement&
+    operator=(CachedStatement const&) = delete;
+
+    /** Bind a value to a parameter, counting from 1. */
+    /** @{ */
+    void
+    bind(int index, std::int64_t value);
+
+    void
+    bind(int index, std::string const& value);
+    /** @} */
+
+    /** Step to the next row.
+
+        @return false once there are no more rows.
+    */
+    bool
+    step();
+
+    /** Read a column of the current row, counting from 0.
+
+        @return No value if the column is NULL.
+    */
+    /** @{ */
+    std::optional<std::int64_t>
+    getInt(int column) const;
+
+    std::optional<std::string>
+    getText(int column) const;
+    /** @} */
+
+    /** Read a blob column of the current row, counting from 0.
+
+        @return false, leaving to empty, if the column is NULL.
+    */
+    bool
+    getBlob(int column, std::vector<std::uint8_t>& to) const;
+
+    /** The SQL with the bound values in place, for logging. */
+    std::string
+    sql() const;
+
+private:
+    sqlite_api::sqlite3* conn_;
+    sqlite_api::sqlite3_stmt* stmt_ = nullptr;
+    // Set while the statement belongs to the cache
+    bool* inUse_ = nullptr;
+};
+
+/** Finalize the statements cached for a session. */
+void
+clearStatementCache(soci::session& session);
+
 class Checkpointer : public std::enable_shared_from_this<Checkpointer>
 {
 public:
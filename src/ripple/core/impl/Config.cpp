@@ -20,6 +20,7 @@
 #include <ripple/basics/FileUtilities.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/StringUtilities.h>
+#include <ripple/basics/ThreadAffinity.h>
 #include <ripple/basics/contract.h>
 #include <ripple/beast/core/LexicalCast.h>
 #include <ripple/core/Config.h>
@@ -107,7 +108,7 @@ namespace ripple {
 
 // clang-format off
 // The configurable node sizes are "tiny", "small", "medium", "large", "huge"
-inline constexpr std::array<std::pair<SizedItem, std::array<int, 5>>, 13>
+inline constexpr std::array<std::pair<SizedItem, std::array<int, 5>>, 14>
 sizedItems
 {{
     // FIXME: We should document each of these items, explaining exactly
@@ -127,7 +128,8 @@ sizedItems
     {SizedItem::openFinalLimit,     {{      8,      16,      32,      64,     128 }}},
     {SizedItem::burstSize,          {{      4,       8,      16,      32,      48 }}},
     {SizedItem::ramSizeGB,          {{      6,       8,      12,      24,       0 }}},
-    {SizedItem::accountIdCacheSize, {{  20047,   50053,   77081,  150061,  300007 }}}
+    {SizedItem::accountIdCacheSize, {{  20047,   50053,   77081,  150061,  300007 }}},
+    {SizedItem::ledgerHeaderCache,  {{      8,      16,      32,     128,     256 }}}
 }};
 
 // Ensure that the order of entries in the table corresponds to the
@@ -654,6 +656,15 @@ Config::loadFromString(std::string const& fileContents)
         PATH_SEARCH_FAST = beast::lexicalCastThrow<int>(strTemp);
     if (getSingleSection(secConfig, SECTION_PATH_SEARCH_MAX, strTemp, j_))
         PATH_SEARCH_MAX = beast::lexicalCastThrow<int>(strTemp);
+    if (getSingleSection(secConfig, SECTION_PATH_SEARCH_THREADS, strTemp, j_))
+    {
+        PATH_SEARCH_THREADS = beast::lexicalCastThrow<std::size_t>(strTemp);
+
+        if (PATH_SEARCH_THREADS < 1 || PATH_SEARCH_THREADS > 16)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_PATH_SEARCH_THREADS
+                ": must be between 1 and 16 inclusive");
+    }
 
     if (getSingleSection(secConfig, SECTION_DEBUG_LOGFILE, strTemp, j_))
         DEBUG_LOGFILE = strTemp;
@@ -667,6 +678,76 @@ Config::loadFromString(std::string const& fileContents)
                                       ": must be between 10 and 600 inclusive");
     }
 
+    if (getSingleSection(secConfig, SECTION_TREE_CACHE_BUDGET, strTemp, j_))
+    {
+        TREE_CACHE_BUDGET = beast::lexicalCastThrow<std::size_t>(strTemp);
+
+        if (*TREE_CACHE_BUDGET == 0)
+            Throw<std::runtime_error>("Invalid " SECTION_TREE_CACHE_BUDGET
+                                      ": must be a positive number");
+    }
+
+    if (getSingleSection(secConfig, SECTION_MEMORY_LIMIT, strTemp, j_))
+    {
+        if (boost::iequals(strTemp, "auto"))
+            MEMORY_LIMIT = 0;
+        else
+        {
+            MEMORY_LIMIT = beast::lexicalCastThrow<std::size_t>(strTemp);
+
+            if (*MEMORY_LIMIT == 0)
+                Throw<std::runtime_error>(
+                    "Invalid " SECTION_MEMORY_LIMIT
+                    ": must be auto or a positive number");
+        }
+    }
+
+    if (getSingleSection(secConfig, SECTION_TREE_CACHE_EVICTION, strTemp, j_))
+    {
+        if (boost::iequals(strTemp, "clock"))
+            TREE_CACHE_CLOCK = true;
+        else if (!boost::iequals(strTemp, "age"))
+            Throw<std::runtime_error>("Invalid " SECTION_TREE_CACHE_EVICTION
+                                      ": must be age or clock");
+    }
+
+    if (exists(SECTION_STATE_SNAPSHOT))
+    {
+        auto const sec = section(SECTION_STATE_SNAPSHOT);
+        if (auto const path = sec.get("path"))
+            STATE_SNAPSHOT_PATH = *path;
+        STATE_SNAPSHOT_INTERVAL =
+            sec.value_or("interval", STATE_SNAPSHOT_INTERVAL);
+
+        if (STATE_SNAPSHOT_INTERVAL == 0)
+            Throw<std::runtime_error>("Invalid " SECTION_STATE_SNAPSHOT
+                                      ": interval must be a positive number");
+    }
+
+    if (exists(SECTION_RPC_RESPONSE_CACHE))
+    {
+        auto const sec = section(SECTION_RPC_RESPONSE_CACHE);
+        RPC_RESPONSE_CACHE_MB = sec.value_or("size_mb", RPC_RESPONSE_CACHE_MB);
+        if (auto const methods = sec.get("methods"))
+        {
+            std::vector<std::string> names;
+            boost::split(names, *methods, boost::is_any_of(", "));
+            for (auto const& name : names)
+            {
+                if (!name.empty())
+                    RPC_RESPONSE_CACHE_METHODS.insert(name);
+            }
+        }
+
+        if (RPC_RESPONSE_CACHE_MB == 0)
+            Throw<std::runtime_error>("Invalid " SECTION_RPC_RESPONSE_CACHE
+                                      ": size_mb must be a positive number");
+    }
+
+    if (exists(SECTION_GATEWAY_BALANCES_INDEX))
+        GATEWAY_BALANCES_INDEX =
+            section(SECTION_GATEWAY_BALANCES_INDEX).values();
+
     if (getSingleSection(secConfig, SECTION_WORKERS, strTemp, j_))
     {
         WORKERS = beast::lexicalCastThrow<int>(strTemp);
@@ -697,17 +778,103 @@ Config::loadFromString(std::string const& fileContents)
                 ": must be between 1 and 1024 inclusive.");
     }
 
+    if (getSingleSection(secConfig, SECTION_FLUSH_WORKERS, strTemp, j_))
+    {
+        FLUSH_WORKERS = beast::lexicalCastThrow<int>(strTemp);
+
+        if (FLUSH_WORKERS < 1 || FLUSH_WORKERS > 16)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_FLUSH_WORKERS
+                ": must be between 1 and 16 inclusive.");
+    }
+
+    if (getSingleSection(secConfig, SECTION_APPLY_WORKERS, strTemp, j_))
+    {
+        APPLY_WORKERS = beast::lexicalCastThrow<int>(strTemp);
+
+        if (APPLY_WORKERS < 1 || APPLY_WORKERS > 64)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_APPLY_WORKERS
+                ": must be between 1 and 64 inclusive.");
+    }
+
+    if (getSingleSection(secConfig, SECTION_PUBLISH_WORKERS, strTemp, j_))
+    {
+        PUBLISH_WORKERS = beast::lexicalCastThrow<int>(strTemp);
+
+        if (PUBLISH_WORKERS < 1 || PUBLISH_WORKERS > 64)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_PUBLISH_WORKERS
+                ": must be between 1 and 64 inclusive.");
+    }
+
+    if (exists(SECTION_THREADS))
+    {
+        auto const sec = section(SECTION_THREADS);
+        if (auto const cpus = sec.get("job_queue"))
+            JOB_QUEUE_CPUS = parseCpuSet(*cpus);
+        if (auto const cpus = sec.get("io"))
+            IO_CPUS = parseCpuSet(*cpus);
+
+        // The node store reads this itself, but a bad set should stop the
+        // server here rather than when the store is opened.
+        if (auto const cpus = sec.get("nodestore_read"))
+            parseCpuSet(*cpus);
+    }
+
+    if (exists(SECTION_LOGGING))
+    {
+        auto const sec = section(SECTION_LOGGING);
+        LOG_QUEUE = sec.value_or("async_queue", LOG_QUEUE);
+        if (auto const format = sec.get("format"))
+        {
+            if (*format == "json")
+                LOG_JSON = true;
+            else if (*format != "text")
+                Throw<std::runtime_error>(
+                    "Invalid " SECTION_LOGGING
+                    ": format must be either text or json.");
+        }
+    }
+
+    if (exists(SECTION_CORO_STACKS))
+    {
+        auto const sec = section(SECTION_CORO_STACKS);
+        CORO_STACK_KB = sec.value_or("size_kb", CORO_STACK_KB);
+        CORO_STACK_GUARD = sec.value_or("guard", CORO_STACK_GUARD);
+        CORO_STACK_POOLED = sec.value_or("max_pooled", CORO_STACK_POOLED);
+
+        if (CORO_STACK_KB < 64 || CORO_STACK_KB > 65536)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_CORO_STACKS
+                ": size_kb must be between 64 and 65536 inclusive.");
+    }
+
     if (getSingleSection(secConfig, SECTION_COMPRESSION, strTemp, j_))
         COMPRESSION = beast::lexicalCastThrow<bool>(strTemp);
 
+    getSingleSection(
+        secConfig,
+        SECTION_COMPRESSION_DICTIONARY,
+        COMPRESSION_DICTIONARY,
+        j_);
+
     if (getSingleSection(secConfig, SECTION_LEDGER_REPLAY, strTemp, j_))
         LEDGER_REPLAY = beast::lexicalCastThrow<bool>(strTemp);
 
+    if (getSingleSection(secConfig, SECTION_CLUSTER_VERIFY, strTemp, j_))
+        CLUSTER_VERIFY = beast::lexicalCastThrow<bool>(strTemp);
+
+    if (getSingleSection(secConfig, SECTION_SPECULATIVE_BUILD, strTemp, j_))
+        SPECULATIVE_BUILD = beast::lexicalCastThrow<bool>(strTemp);
+
     if (exists(SECTION_REDUCE_RELAY))
     {
         auto sec = section(SECTION_REDUCE_RELAY);
         VP_REDUCE_RELAY_ENABLE = sec.value_or("vp_enable", false);
         VP_REDUCE_RELAY_SQUELCH = sec.value_or("vp_squelch", false);
+        VP_REDUCE_RELAY_SELECT_FASTEST =
+            sec.value_or("vp_select_fastest", false);
         TX_REDUCE_RELAY_ENABLE = sec.value_or("tx_enable", false);
         TX_REDUCE_RELAY_METRICS = sec.value_or("tx_metrics", false);
         TX_REDUCE_RELAY_MIN_PEERS = sec.value_or("tx_min_peers", 20);
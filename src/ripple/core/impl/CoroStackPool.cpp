@@ -0,0 +1,181 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/contract.h>
+#include <ripple/core/CoroStackPool.h>
+#include <ripple/protocol/jss.h>
+#include <boost/predef.h>
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <string>
+
+#if BOOST_OS_WINDOWS
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace ripple {
+
+namespace {
+
+std::size_t
+pageSize()
+{
+#if BOOST_OS_WINDOWS
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// Map a stack with a guard region of the given bytes below it
+void*
+mapStack(std::size_t size, std::size_t guard)
+{
+#if BOOST_OS_WINDOWS
+    void* const base = ::VirtualAlloc(
+        nullptr, guard + size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (base == nullptr)
+        Throw<std::bad_alloc>();
+    DWORD old;
+    if (guard != 0 && !::VirtualProtect(base, guard, PAGE_NOACCESS, &old))
+    {
+        ::VirtualFree(base, 0, MEM_RELEASE);
+        Throw<std::bad_alloc>();
+    }
+#else
+    void* const base = ::mmap(
+        nullptr,
+        guard + size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANON,
+        -1,
+        0);
+    if (base == MAP_FAILED)
+        Throw<std::bad_alloc>();
+    if (guard != 0 && ::mprotect(base, guard, PROT_NONE) != 0)
+    {
+        ::munmap(base, guard + size);
+        Throw<std::bad_alloc>();
+    }
+#endif
+    return static_cast<char*>(base) + guard + size;
+}
+
+void
+unmapStack(void* sp, std::size_t size, std::size_t guard)
+{
+    void* const base = static_cast<char*>(sp) - size - guard;
+#if BOOST_OS_WINDOWS
+    ::VirtualFree(base, 0, MEM_RELEASE);
+#else
+    ::munmap(base, guard + size);
+#endif
+}
+
+}  // namespace
+
+CoroStackPool::CoroStackPool(Setup const& setup)
+    : page_(pageSize())
+    , size_(std::max<std::size_t>(
+          2 * page_,
+          (setup.size + page_ - 1) / page_ * page_))
+    , guard_(setup.guard ? page_ : 0)
+    , maxPooled_(setup.maxPooled)
+{
+    pooled_.reserve(maxPooled_);
+}
+
+CoroStackPool::~CoroStackPool()
+{
+    assert(inUse_ == 0);
+    for (auto const sp : pooled_)
+        unmapStack(sp, size_, guard_);
+}
+
+void
+CoroStackPool::allocate(boost::coroutines::stack_context& sctx, std::size_t)
+{
+    {
+        std::lock_guard lock(mutex_);
+        ++inUse_;
+        if (!pooled_.empty())
+        {
+            ++hits_;
+            sctx.sp = pooled_.back();
+            sctx.size = size_;
+            pooled_.pop_back();
+            return;
+        }
+        ++misses_;
+    }
+
+    try
+    {
+        sctx.sp = mapStack(size_, guard_);
+        sctx.size = size_;
+    }
+    catch (std::bad_alloc const&)
+    {
+        std::lock_guard lock(mutex_);
+        --inUse_;
+        throw;
+    }
+}
+
+void
+CoroStackPool::deallocate(boost::coroutines::stack_context& sctx)
+{
+    assert(sctx.sp != nullptr && sctx.size == size_);
+    {
+        std::lock_guard lock(mutex_);
+        assert(inUse_ > 0);
+        --inUse_;
+        if (pooled_.size() < maxPooled_)
+        {
+            pooled_.push_back(sctx.sp);
+            sctx.sp = nullptr;
+            return;
+        }
+    }
+
+    unmapStack(sctx.sp, size_, guard_);
+    sctx.sp = nullptr;
+}
+
+Json::Value
+CoroStackPool::getJson() const
+{
+    Json::Value ret(Json::objectValue);
+    ret[jss::size] = static_cast<Json::UInt>(size_);
+
+    std::lock_guard lock(mutex_);
+    ret[jss::in_use] = static_cast<Json::UInt>(inUse_);
+    ret[jss::pooled] = static_cast<Json::UInt>(pooled_.size());
+    ret[jss::hits] = std::to_string(hits_);
+    ret[jss::misses] = std::to_string(misses_);
+    return ret;
+}
+
+}  // namespace ripple
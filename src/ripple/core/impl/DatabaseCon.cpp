@@ -25,7 +25,9 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
 
+#include <functional>
 #include <memory>
+#include <thread>
 #include <unordered_map>
 
 namespace ripple {
@@ -100,6 +102,11 @@ DatabaseCon::~DatabaseCon()
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
     }
+
+    // Statements left prepared would keep the connections from closing
+    clearStatementCache(*session_);
+    for (auto const& reader : readers_)
+        clearStatementCache(*reader->session);
 }
 
 DatabaseCon::Setup
@@ -244,6 +251,35 @@ setup_DatabaseCon(Config const& c, std::optional<beast::Journal> j)
 std::unique_ptr<std::vector<std::string> const>
     DatabaseCon::Setup::globalPragma;
 
+LockedSociSession
+DatabaseCon::checkoutReadDb()
+{
+    if (readers_.empty())
+        return checkoutDb();
+
+    auto const start =
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) %
+        readers_.size();
+    for (std::size_t i = 0; i < readers_.size(); ++i)
+    {
+        auto& reader = *readers_[(start + i) % readers_.size()];
+        std::unique_lock lock(reader.mutex, std::try_to_lock);
+        if (lock.owns_lock())
+            return LockedSociSession(reader.session, std::move(lock));
+    }
+
+    auto& reader = *readers_[start];
+    return LockedSociSession(reader.session, std::unique_lock(reader.mutex));
+}
+
+bool
+DatabaseCon::isWal()
+{
+    std::string mode;
+    *session_ << "PRAGMA journal_mode;", soci::into(mode);
+    return boost::iequals(mode, "wal");
+}
+
 void
 DatabaseCon::setupCheckpointing(JobQueue* q, Logs& l)
 {
@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/core/JobLatencyProbe.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/core/JobTypes.h>
+#include <ripple/protocol/jss.h>
+
+namespace ripple {
+
+Json::Value
+toJson(Histogram const& latencies)
+{
+    Json::Value ret(Json::objectValue);
+    ret[jss::count] = std::to_string(latencies.count());
+    ret[jss::p50] = std::to_string(latencies.percentile(50));
+    ret[jss::p90] = std::to_string(latencies.percentile(90));
+    ret[jss::p99] = std::to_string(latencies.percentile(99));
+    ret[jss::max] = std::to_string(latencies.max());
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+
+// From the lowest priority to the highest
+static constexpr JobType probedTypes[] = {
+    jtCLIENT,
+    jtTRANSACTION,
+    jtLEDGER_DATA,
+    jtVALIDATION_t,
+    jtADMIN};
+
+JobLatencyProbe::JobLatencyProbe(
+    JobQueue& jobQueue,
+    beast::insight::Collector::ptr const& collector,
+    std::chrono::milliseconds interval)
+    : jobQueue_(jobQueue), interval_(interval)
+{
+    probes_.reserve(std::size(probedTypes));
+    for (auto const type : probedTypes)
+        probes_.push_back(std::make_unique<Probe>(
+            type, collector->make_event(JobTypes::name(type))));
+}
+
+void
+JobLatencyProbe::sample()
+{
+    auto const now = clock_type::now();
+    auto last = last_.load();
+    if (now - last < interval_ || !last_.compare_exchange_strong(last, now))
+        return;
+
+    for (auto& probe : probes_)
+    {
+        if (probe->waiting.exchange(true))
+            continue;
+
+        if (!jobQueue_.addJob(
+                probe->type,
+                "latencyProbe",
+                [this, &probe = *probe, queued = now]() {
+                    onStart(probe, queued);
+                }))
+            probe->waiting = false;
+    }
+}
+
+void
+JobLatencyProbe::onStart(Probe& probe, clock_type::time_point queued)
+{
+    using namespace std::chrono;
+    auto const elapsed = clock_type::now() - queued;
+    probe.event.notify(elapsed);
+    probe.latencies.add(duration_cast<microseconds>(elapsed).count());
+    probe.waiting = false;
+}
+
+Json::Value
+JobLatencyProbe::getJson() const
+{
+    Json::Value ret(Json::objectValue);
+    for (auto const& probe : probes_)
+        ret[JobTypes::name(probe->type)] = toJson(probe->latencies);
+    return ret;
+}
+
+}  // namespace ripple
@@ -18,8 +18,12 @@
 //==============================================================================
 
 #include <ripple/basics/PerfLog.h>
+#include <ripple/basics/PerfTrace.h>
 #include <ripple/basics/contract.h>
 #include <ripple/core/JobQueue.h>
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 
 namespace ripple {
@@ -29,12 +33,15 @@ JobQueue::JobQueue(
     beast::insight::Collector::ptr const& collector,
     beast::Journal journal,
     Logs& logs,
-    perf::PerfLog& perfLog)
+    perf::PerfLog& perfLog,
+    std::vector<unsigned> const& cpus,
+    CoroStackPool::Setup const& coroStacks)
     : m_journal(journal)
     , m_lastJob(0)
     , m_invalidJobData(JobTypes::instance().getInvalid(), collector, logs)
     , m_processCount(0)
-    , m_workers(*this, &perfLog, "JobQueue", threadCount)
+    , coroStacks_(coroStacks)
+    , m_workers(*this, &perfLog, "JobQueue", threadCount, cpus, journal)
     , perfLog_(perfLog)
     , m_collector(collector)
 {
@@ -58,6 +65,10 @@ JobQueue::JobQueue(
             assert(result.second == true);
             (void)result.second;
         }
+
+        // The map is ordered by type, and later types have priority
+        for (auto iter = m_jobData.rbegin(); iter != m_jobData.rend(); ++iter)
+            m_byPriority.push_back(&iter->second);
     }
 }
 
@@ -71,7 +82,7 @@ void
 JobQueue::collect()
 {
     std::lock_guard lock(m_mutex);
-    job_count = m_jobSet.size();
+    job_count = m_jobCount;
 }
 
 bool
@@ -97,20 +108,17 @@ JobQueue::addRefCountedJob(
         (type >= jtCLIENT && type <= jtCLIENT_WEBSOCKET) ||
         m_workers.getNumberOfThreads() > 0);
 
+    // Build the job before taking the lock, so the lock only covers
+    // putting it in the queue of its type.
+    Job job(type, name, ++m_lastJob, data.load(), func);
+    perfLog_.jobQueue(type);
+
     {
         std::lock_guard lock(m_mutex);
-        auto result =
-            m_jobSet.emplace(type, name, ++m_lastJob, data.load(), func);
-        auto const& job = *result.first;
-
-        JobType const type(job.getType());
-        assert(type != jtINVALID);
-        assert(m_jobSet.find(job) != m_jobSet.end());
-        perfLog_.jobQueue(type);
-
-        JobTypeData& data(getJobTypeData(type));
+        data.jobs.push_back(std::move(job));
+        ++m_jobCount;
 
-        if (data.waiting + data.running < getJobLimit(type))
+        if (data.waiting + data.running < data.info.limit())
         {
             m_workers.addTask();
         }
@@ -124,6 +132,126 @@ JobQueue::addRefCountedJob(
     return true;
 }
 
+void
+JobQueue::parallelFor(
+    JobType type,
+    std::string const& name,
+    std::size_t count,
+    std::size_t jobs,
+    std::function<void(std::size_t)> const& f)
+{
+    // Kept alive by jobs that start after every call was made. Those find
+    // no index left, and never touch f.
+    struct State
+    {
+        std::size_t const count;
+        std::function<void(std::size_t)> const& f;
+        std::atomic<std::size_t> next = 0;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t done = 0;
+
+        State(std::size_t count_, std::function<void(std::size_t)> const& f_)
+            : count(count_), f(f_)
+        {
+        }
+
+        void
+        run()
+        {
+            std::size_t ran = 0;
+            for (std::size_t i; (i = next++) < count; ++ran)
+                f(i);
+
+            if (ran == 0)
+                return;
+
+            std::lock_guard lock(mutex);
+            done += ran;
+            if (done == count)
+                cv.notify_all();
+        }
+    };
+
+    if (count == 0)
+        return;
+
+    auto const state = std::make_shared<State>(count, f);
+
+    jobs = std::min(jobs, count);
+    if (jobs > 1)
+    {
+        // The helpers are queued together, under one lock
+        std::vector<JobFunction> helpers;
+        helpers.reserve(jobs - 1);
+        for (std::size_t i = 1; i < jobs; ++i)
+        {
+            auto counted = jobCounter_.wrap([state]() { state->run(); });
+            if (!counted)
+                break;
+            helpers.emplace_back(std::move(*counted));
+        }
+        addRefCountedJobs(type, name, std::move(helpers));
+    }
+
+    state->run();
+
+    std::unique_lock lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->done == count; });
+}
+
+bool
+JobQueue::addRefCountedJobs(
+    JobType type,
+    std::string const& name,
+    std::vector<JobFunction> funcs)
+{
+    assert(type != jtINVALID);
+
+    auto iter(m_jobData.find(type));
+    assert(iter != m_jobData.end());
+    if (iter == m_jobData.end())
+        return false;
+
+    if (funcs.empty())
+        return true;
+
+    JLOG(m_journal.debug()) << __func__ << " : Adding " << funcs.size()
+                            << " jobs : " << name << " : " << type;
+    JobTypeData& data(iter->second);
+
+    assert(
+        (type >= jtCLIENT && type <= jtCLIENT_WEBSOCKET) ||
+        m_workers.getNumberOfThreads() > 0);
+
+    std::vector<Job> jobs;
+    jobs.reserve(funcs.size());
+    for (auto& func : funcs)
+    {
+        jobs.emplace_back(type, name, ++m_lastJob, data.load(), func);
+        perfLog_.jobQueue(type);
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        std::size_t tasks = 0;
+        for (auto& job : jobs)
+        {
+            data.jobs.push_back(std::move(job));
+            ++m_jobCount;
+
+            if (data.waiting + data.running < data.info.limit())
+                ++tasks;
+            else
+                ++data.deferred;
+            ++data.waiting;
+        }
+        m_workers.addTasks(tasks);
+    }
+    return true;
+}
+
 int
 JobQueue::getJobCount(JobType t) const
 {
@@ -219,7 +347,8 @@ JobQueue::getJson(int c)
         int running(data.running);
 
         if ((stats.count != 0) || (waiting != 0) ||
-            (stats.latencyPeak != 0ms) || (running != 0))
+            (stats.latencyPeak != 0ms) || (running != 0) ||
+            (data.missed != 0))
         {
             Json::Value& pri = priorities.append(Json::objectValue);
 
@@ -242,10 +371,14 @@ JobQueue::getJson(int c)
 
             if (running != 0)
                 pri["in_progress"] = running;
+
+            if (data.missed != 0)
+                pri["deadline_missed"] = std::to_string(data.missed);
         }
     }
 
     ret["job_types"] = priorities;
+    ret["coro_stacks"] = coroStacks_.getJson();
 
     return ret;
 }
@@ -253,8 +386,8 @@ JobQueue::getJson(int c)
 void
 JobQueue::rendezvous()
 {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    cv_.wait(lock, [this] { return m_processCount == 0 && m_jobSet.empty(); });
+    ProfiledUniqueLock<std::mutex> lock(m_mutex);
+    cv_.wait(lock, [this] { return m_processCount == 0 && m_jobCount == 0; });
 }
 
 JobTypeData&
@@ -283,11 +416,11 @@ JobQueue::stop()
         // but there may still be some threads between the return of
         // `Job::doJob` and the return of `JobQueue::processTask`. That is why
         // we must wait on the condition variable to make these assertions.
-        std::unique_lock<std::mutex> lock(m_mutex);
+        ProfiledUniqueLock<std::mutex> lock(m_mutex);
         cv_.wait(
-            lock, [this] { return m_processCount == 0 && m_jobSet.empty(); });
+            lock, [this] { return m_processCount == 0 && m_jobCount == 0; });
         assert(m_processCount == 0);
-        assert(m_jobSet.empty());
+        assert(m_jobCount == 0);
         assert(nSuspend_ == 0);
         stopped_ = true;
     }
@@ -302,30 +435,85 @@ JobQueue::isStopped() const
 void
 JobQueue::getNextJob(Job& job)
 {
-    assert(!m_jobSet.empty());
+    assert(m_jobCount != 0);
 
-    std::set<Job>::const_iterator iter;
-    for (iter = m_jobSet.begin(); iter != m_jobSet.end(); ++iter)
+    using namespace std::chrono_literals;
+    auto const now = Job::clock_type::now();
+
+    // How long the oldest job of a type has waited past its deadline
+    auto const lateness = [now](JobTypeData const& data) {
+        auto const deadline = data.info.getDeadline();
+        if (deadline == 0ms)
+            return Job::clock_type::duration{0};
+        return now - data.jobs.front().queue_time() - deadline;
+    };
+
+    JobTypeData* next = nullptr;
+    JobTypeData* highest = nullptr;
+    auto overdue = Job::clock_type::duration{0};
+    for (auto const data : m_byPriority)
     {
-        JobType const type = iter->getType();
-        assert(type != jtINVALID);
+        if (data->jobs.empty())
+            continue;
+
+        assert(data->running <= data->info.limit());
 
-        JobTypeData& data(getJobTypeData(type));
-        assert(data.running <= getJobLimit(type));
+        // Only run the oldest job of this type if we're running below the
+        // limit.
+        if (data->running >= data->info.limit())
+            continue;
 
-        // Run this job if we're running below the limit.
-        if (data.running < getJobLimit(data.type()))
+        // These are first in the scan, and are never passed by a late job
+        if (data->type() >= agingCeiling)
         {
-            assert(data.waiting > 0);
-            --data.waiting;
-            ++data.running;
+            next = highest = data;
             break;
         }
+
+        if (next == nullptr)
+            next = highest = data;
+
+        // The job furthest past its deadline goes ahead of the rest
+        if (auto const late = lateness(*data); late > overdue)
+        {
+            next = data;
+            overdue = late;
+        }
+    }
+
+    assert(next != nullptr);
+
+    // Late jobs only pass so many in a row, so that the types between
+    // them and agingCeiling, most with no deadline of their own, still
+    // run while the late types are overloaded
+    if (next != highest)
+    {
+        if (m_agedInRow < maxAgedInRow)
+            ++m_agedInRow;
+        else
+        {
+            next = highest;
+            m_agedInRow = 0;
+        }
+    }
+    else
+    {
+        m_agedInRow = 0;
     }
 
-    assert(iter != m_jobSet.end());
-    job = *iter;
-    m_jobSet.erase(iter);
+    JobTypeData& data = *next;
+    if (lateness(data) > 0ms)
+    {
+        ++data.missed;
+        ++data.deadlineMissed;
+    }
+
+    assert(data.waiting > 0);
+    --data.waiting;
+    ++data.running;
+    job = std::move(data.jobs.front());
+    data.jobs.pop_front();
+    --m_jobCount;
 }
 
 void
@@ -383,6 +571,14 @@ JobQueue::processTask(int instance)
                 getJobTypeData(type).execute.notify(x_time);
             }
             perfLog_.jobFinish(type, x_time, instance);
+
+            perf::trace::complete(
+                "job",
+                data.name().c_str(),
+                start_time,
+                start_time + x_time,
+                "queued_us",
+                q_time.count());
         }
     }
 
@@ -392,7 +588,7 @@ JobQueue::processTask(int instance)
         // otherwise destructors with side effects can access
         // parent objects that are already destroyed.
         finishJob(type);
-        if (--m_processCount == 0 && m_jobSet.empty())
+        if (--m_processCount == 0 && m_jobCount == 0)
             cv_.notify_all();
     }
 
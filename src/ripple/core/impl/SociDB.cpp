@@ -29,8 +29,11 @@
 #include <ripple/core/DatabaseCon.h>
 #include <ripple/core/SociDB.h>
 #include <boost/filesystem.hpp>
+#include <cassert>
 #include <memory>
+#include <mutex>
 #include <soci/sqlite3/soci-sqlite3.h>
+#include <unordered_map>
 
 namespace ripple {
 
@@ -187,6 +190,194 @@ convert(std::string const& from, soci::blob& to)
 
 namespace {
 
+struct StatementCache
+{
+    struct Entry
+    {
+        sqlite_api::sqlite3_stmt* stmt = nullptr;
+        bool inUse = false;
+    };
+
+    // Entries are only touched by the thread holding the session
+    std::unordered_map<std::string, Entry> entries;
+};
+
+// The mutex only guards the map of connections
+std::mutex statementCachesMutex;
+std::unordered_map<sqlite_api::sqlite3*, std::unique_ptr<StatementCache>>
+    statementCaches;
+
+StatementCache&
+statementCache(sqlite_api::sqlite3* conn)
+{
+    std::lock_guard lock(statementCachesMutex);
+    auto& cache = statementCaches[conn];
+    if (!cache)
+        cache = std::make_unique<StatementCache>();
+    return *cache;
+}
+
+[[noreturn]] void
+throwSQLiteError(sqlite_api::sqlite3* conn, std::string const& sql)
+{
+    Throw<std::runtime_error>(
+        std::string("SQLite error: ") + sqlite_api::sqlite3_errmsg(conn) +
+        " in: " + sql);
+}
+
+sqlite_api::sqlite3_stmt*
+prepareStatement(
+    sqlite_api::sqlite3* conn,
+    std::string const& sql,
+    unsigned int flags)
+{
+    sqlite_api::sqlite3_stmt* stmt = nullptr;
+    if (sqlite_api::sqlite3_prepare_v3(
+            conn,
+            sql.data(),
+            static_cast<int>(sql.size()),
+            flags,
+            &stmt,
+            nullptr) != SQLITE_OK)
+        throwSQLiteError(conn, sql);
+    return stmt;
+}
+
+}  // namespace
+
+CachedStatement::CachedStatement(soci::session& session, std::string const& sql)
+    : conn_(getConnection(session))
+{
+    auto& entry = statementCache(conn_).entries[sql];
+    if (!entry.stmt)
+        entry.stmt = prepareStatement(conn_, sql, SQLITE_PREPARE_PERSISTENT);
+
+    if (!entry.inUse)
+    {
+        entry.inUse = true;
+        inUse_ = &entry.inUse;
+        stmt_ = entry.stmt;
+    }
+    else
+    {
+        stmt_ = prepareStatement(conn_, sql, 0);
+    }
+}
+
+CachedStatement::~CachedStatement()
+{
+    if (!inUse_)
+    {
+        sqlite_api::sqlite3_finalize(stmt_);
+        return;
+    }
+
+    sqlite_api::sqlite3_reset(stmt_);
+    sqlite_api::sqlite3_clear_bindings(stmt_);
+    *inUse_ = false;
+}
+
+void
+CachedStatement::bind(int index, std::int64_t value)
+{
+    if (sqlite_api::sqlite3_bind_int64(stmt_, index, value) != SQLITE_OK)
+        throwSQLiteError(conn_, sql());
+}
+
+void
+CachedStatement::bind(int index, std::string const& value)
+{
+    // The equivalent of SQLITE_TRANSIENT, which makes SQLite copy the value
+    auto const transient =
+        reinterpret_cast<sqlite_api::sqlite3_destructor_type>(-1);
+    if (sqlite_api::sqlite3_bind_text(
+            stmt_,
+            index,
+            value.data(),
+            static_cast<int>(value.size()),
+            transient) != SQLITE_OK)
+        throwSQLiteError(conn_, sql());
+}
+
+bool
+CachedStatement::step()
+{
+    switch (sqlite_api::sqlite3_step(stmt_))
+    {
+        case SQLITE_ROW:
+            return true;
+        case SQLITE_DONE:
+            return false;
+        default:
+            throwSQLiteError(conn_, sql());
+    }
+}
+
+std::optional<std::int64_t>
+CachedStatement::getInt(int column) const
+{
+    if (sqlite_api::sqlite3_column_type(stmt_, column) == SQLITE_NULL)
+        return std::nullopt;
+    return sqlite_api::sqlite3_column_int64(stmt_, column);
+}
+
+std::optional<std::string>
+CachedStatement::getText(int column) const
+{
+    if (sqlite_api::sqlite3_column_type(stmt_, column) == SQLITE_NULL)
+        return std::nullopt;
+    auto const text = reinterpret_cast<char const*>(
+        sqlite_api::sqlite3_column_text(stmt_, column));
+    return std::string(
+        text, sqlite_api::sqlite3_column_bytes(stmt_, column));
+}
+
+bool
+CachedStatement::getBlob(int column, std::vector<std::uint8_t>& to) const
+{
+    to.clear();
+    if (sqlite_api::sqlite3_column_type(stmt_, column) == SQLITE_NULL)
+        return false;
+    auto const data = static_cast<std::uint8_t const*>(
+        sqlite_api::sqlite3_column_blob(stmt_, column));
+    to.assign(data, data + sqlite_api::sqlite3_column_bytes(stmt_, column));
+    return true;
+}
+
+std::string
+CachedStatement::sql() const
+{
+    std::string result;
+    if (auto const expanded = sqlite_api::sqlite3_expanded_sql(stmt_))
+    {
+        result = expanded;
+        sqlite_api::sqlite3_free(expanded);
+    }
+    return result;
+}
+
+void
+clearStatementCache(soci::session& session)
+{
+    std::unique_ptr<StatementCache> cache;
+    {
+        std::lock_guard lock(statementCachesMutex);
+        auto const it = statementCaches.find(getConnection(session));
+        if (it == statementCaches.end())
+            return;
+        cache = std::move(it->second);
+        statementCaches.erase(it);
+    }
+
+    for (auto const& [sql, entry] : cache->entries)
+    {
+        assert(!entry.inUse);
+        sqlite_api::sqlite3_finalize(entry.stmt);
+    }
+}
+
+namespace {
+
 /** Run a thread to checkpoint the write ahead log (wal) for
     the given soci::session every 1000 pages. This is only implemented
     for sqlite databases.
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/basics/PerfLog.h>
+#include <ripple/basics/ThreadAffinity.h>
 #include <ripple/beast/core/CurrentThreadName.h>
 #include <ripple/core/impl/Workers.h>
 #include <cassert>
@@ -28,9 +29,13 @@ Workers::Workers(
     Callback& callback,
     perf::PerfLog* perfLog,
     std::string const& threadNames,
-    int numberOfThreads)
+    int numberOfThreads,
+    std::vector<unsigned> cpus,
+    beast::Journal journal)
     : m_callback(callback)
     , perfLog_(perfLog)
+    , m_cpus(std::move(cpus))
+    , m_journal(journal)
     , m_threadNames(threadNames)
     , m_allPaused(true)
     , m_semaphore(0)
@@ -128,6 +133,13 @@ Workers::addTask()
     m_semaphore.notify();
 }
 
+void
+Workers::addTasks(std::size_t count)
+{
+    if (count != 0)
+        m_semaphore.notify(count);
+}
+
 int
 Workers::numberOfCurrentlyRunningTasks() const noexcept
 {
@@ -191,6 +203,8 @@ Workers::Worker::notify()
 void
 Workers::Worker::run()
 {
+    setCurrentThreadAffinity(m_workers.m_cpus, m_workers.m_journal);
+
     bool shouldExit = true;
     do
     {
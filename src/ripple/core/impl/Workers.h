@@ -21,12 +21,14 @@
 #define RIPPLE_CORE_WORKERS_H_INCLUDED
 
 #include <ripple/beast/core/LockFreeStack.h>
+#include <ripple/beast/utility/Journal.h>
 #include <ripple/core/impl/semaphore.h>
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace ripple {
 
@@ -108,13 +110,17 @@ public:
         default is to create one thread per CPU.
 
         @param threadNames The name given to each created worker thread.
+        @param cpus The CPUs the worker threads may run on. Empty is any.
+        @param journal Where to report CPUs that can not be applied.
     */
     explicit Workers(
         Callback& callback,
         perf::PerfLog* perfLog,
         std::string const& threadNames = "Worker",
         int numberOfThreads =
-            static_cast<int>(std::thread::hardware_concurrency()));
+            static_cast<int>(std::thread::hardware_concurrency()),
+        std::vector<unsigned> cpus = {},
+        beast::Journal journal = beast::Journal{beast::Journal::getNullSink()});
 
     ~Workers();
 
@@ -157,6 +163,16 @@ public:
     void
     addTask();
 
+    /** Add count tasks to be performed.
+
+        The same as calling addTask count times, but waking the workers
+        takes the semaphore's lock once.
+
+        @note This function is thread-safe.
+    */
+    void
+    addTasks(std::size_t count);
+
     /** Get the number of currently executing calls of Callback::processTask.
         While this function is thread-safe, the value may not stay
         accurate for very long. It's mainly for diagnostic purposes.
@@ -217,6 +233,9 @@ private:
 private:
     Callback& m_callback;
     perf::PerfLog* perfLog_;
+    // The CPUs each thread may run on, or empty for any
+    std::vector<unsigned> const m_cpus;
+    beast::Journal const m_journal;
     std::string m_threadNames;     // The name to give each thread
     std::condition_variable m_cv;  // signaled when all threads paused
     std::mutex m_mut;
@@ -52,6 +52,16 @@ public:
         m_cond.notify_one();
     }
 
+    /** Increment the count by n and unblock up to n waiting threads. */
+    void
+    notify(size_type n)
+    {
+        std::lock_guard lock{m_mutex};
+        m_count += n;
+        while (n-- != 0)
+            m_cond.notify_one();
+    }
+
     /** Block until notify is called. */
     void
     wait()
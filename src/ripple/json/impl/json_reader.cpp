@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <cctype>
 #include <cstdint>
+#include <cstring>
 #include <istream>
 #include <string>
 
@@ -67,6 +68,37 @@ codePointToUTF8(unsigned int cp)
     return result;
 }
 
+// Find the first quote or backslash in a string, or its end.
+//
+// Strings are most of the text of a typical request, so they are scanned
+// eight bytes at a time until a word holds one of the two characters.
+static const char*
+findQuoteOrEscape(const char* current, const char* end)
+{
+    constexpr std::uint64_t ones = 0x0101010101010101ull;
+    constexpr std::uint64_t highs = 0x8080808080808080ull;
+
+    // Non-zero if any byte of a word is the given character
+    auto const has = [](std::uint64_t word, char c) {
+        std::uint64_t const v = word ^ (ones * static_cast<unsigned char>(c));
+        return (v - ones) & ~v & highs;
+    };
+
+    while (end - current >= 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, current, sizeof(word));
+        if (has(word, '"') | has(word, '\\'))
+            break;
+        current += 8;
+    }
+
+    while (current != end && *current != '"' && *current != '\\')
+        ++current;
+
+    return current;
+}
+
 // Class Reader
 // //////////////////////////////////////////////////////////////////
 
@@ -401,6 +433,7 @@ Reader::readString()
 
     while (current_ != end_)
     {
+        current_ = findQuoteOrEscape(current_, end_);
         c = getNextChar();
 
         if (c == '\\')
@@ -680,6 +713,14 @@ Reader::decodeString(Token& token, std::string& decoded)
 
     while (current != end)
     {
+        // Copy the characters up to the next escape at once
+        Location const plain = findQuoteOrEscape(current, end);
+        decoded.append(current, plain);
+        current = plain;
+
+        if (current == end)
+            break;
+
         Char c = *current++;
 
         if (c == '"')
@@ -741,10 +782,6 @@ Reader::decodeString(Token& token, std::string& decoded)
                         "Bad escape sequence in string", token, current);
             }
         }
-        else
-        {
-            decoded += c;
-        }
     }
 
     return true;
@@ -177,7 +177,7 @@ Value::CZString::isStaticString() const
  * memset( this, 0, sizeof(Value) )
  * This optimization is used in ValueInternalMap fast allocator.
  */
-Value::Value(ValueType type) : type_(type), allocated_(0)
+Value::Value(ValueType type) : type_(type), allocated_(0), inline_(0)
 {
     switch (type)
     {
@@ -226,18 +226,18 @@ Value::Value(double value) : type_(realValue)
     value_.real_ = value;
 }
 
-Value::Value(const char* value) : type_(stringValue), allocated_(true)
+Value::Value(const char* value) : type_(stringValue)
 {
-    value_.string_ = valueAllocator()->duplicateStringValue(value);
+    setString(value, value ? (unsigned int)strlen(value) : 0);
 }
 
-Value::Value(std::string const& value) : type_(stringValue), allocated_(true)
+Value::Value(std::string const& value) : type_(stringValue)
 {
-    value_.string_ = valueAllocator()->duplicateStringValue(
-        value.c_str(), (unsigned int)value.length());
+    setString(value.c_str(), (unsigned int)value.length());
 }
 
-Value::Value(const StaticString& value) : type_(stringValue), allocated_(false)
+Value::Value(const StaticString& value)
+    : type_(stringValue), allocated_(false), inline_(false)
 {
     value_.string_ = const_cast<char*>(value.c_str());
 }
@@ -260,14 +260,16 @@ Value::Value(const Value& other) : type_(other.type_)
             break;
 
         case stringValue:
-            if (other.value_.string_)
+            if (auto const str = other.stringData())
             {
-                value_.string_ = valueAllocator()->duplicateStringValue(
-                    other.value_.string_);
-                allocated_ = true;
+                setString(str, (unsigned int)strlen(str));
             }
             else
+            {
                 value_.string_ = 0;
+                allocated_ = false;
+                inline_ = false;
+            }
 
             break;
 
@@ -318,10 +320,14 @@ Value::operator=(Value const& other)
 }
 
 Value::Value(Value&& other) noexcept
-    : value_(other.value_), type_(other.type_), allocated_(other.allocated_)
+    : value_(other.value_)
+    , type_(other.type_)
+    , allocated_(other.allocated_)
+    , inline_(other.inline_)
 {
     other.type_ = nullValue;
     other.allocated_ = 0;
+    other.inline_ = 0;
 }
 
 Value&
@@ -344,6 +350,29 @@ Value::swap(Value& other) noexcept
     int temp2 = allocated_;
     allocated_ = other.allocated_;
     other.allocated_ = temp2;
+
+    temp2 = inline_;
+    inline_ = other.inline_;
+    other.inline_ = temp2;
+}
+
+void
+Value::setString(const char* value, unsigned int length)
+{
+    if (length < sizeof(value_.short_))
+    {
+        if (length != 0)
+            memcpy(value_.short_, value, length);
+        value_.short_[length] = 0;
+        allocated_ = false;
+        inline_ = true;
+    }
+    else
+    {
+        value_.string_ = valueAllocator()->duplicateStringValue(value, length);
+        allocated_ = true;
+        inline_ = false;
+    }
 }
 
 ValueType
@@ -392,10 +421,11 @@ operator<(const Value& x, const Value& y)
         case booleanValue:
             return x.value_.bool_ < y.value_.bool_;
 
-        case stringValue:
-            return (x.value_.string_ == 0 && y.value_.string_) ||
-                (y.value_.string_ && x.value_.string_ &&
-                 strcmp(x.value_.string_, y.value_.string_) < 0);
+        case stringValue: {
+            auto const xs = x.stringData();
+            auto const ys = y.stringData();
+            return (xs == 0 && ys) || (ys && xs && strcmp(xs, ys) < 0);
+        }
 
         case arrayValue:
         case objectValue: {
@@ -441,10 +471,11 @@ operator==(const Value& x, const Value& y)
         case booleanValue:
             return x.value_.bool_ == y.value_.bool_;
 
-        case stringValue:
-            return x.value_.string_ == y.value_.string_ ||
-                (y.value_.string_ && x.value_.string_ &&
-                 !strcmp(x.value_.string_, y.value_.string_));
+        case stringValue: {
+            auto const xs = x.stringData();
+            auto const ys = y.stringData();
+            return xs == ys || (ys && xs && !strcmp(xs, ys));
+        }
 
         case arrayValue:
         case objectValue:
@@ -462,7 +493,7 @@ const char*
 Value::asCString() const
 {
     JSON_ASSERT(type_ == stringValue);
-    return value_.string_;
+    return stringData();
 }
 
 std::string
@@ -474,7 +505,7 @@ Value::asString() const
             return "";
 
         case stringValue:
-            return value_.string_ ? value_.string_ : "";
+            return stringData() ? stringData() : "";
 
         case booleanValue:
             return value_.bool_ ? "true" : "false";
@@ -526,7 +557,7 @@ Value::asInt() const
             return value_.bool_ ? 1 : 0;
 
         case stringValue: {
-            char const* const str{value_.string_ ? value_.string_ : ""};
+            char const* const str{stringData() ? stringData() : ""};
             return beast::lexicalCastThrow<int>(str);
         }
 
@@ -568,7 +599,7 @@ Value::asUInt() const
             return value_.bool_ ? 1 : 0;
 
         case stringValue: {
-            char const* const str{value_.string_ ? value_.string_ : ""};
+            char const* const str{stringData() ? stringData() : ""};
             return beast::lexicalCastThrow<unsigned int>(str);
         }
 
@@ -634,7 +665,7 @@ Value::asBool() const
             return value_.bool_;
 
         case stringValue:
-            return value_.string_ && value_.string_[0] != 0;
+            return stringData() && stringData()[0] != 0;
 
         case arrayValue:
         case objectValue:
@@ -684,7 +715,7 @@ Value::isConvertibleTo(ValueType other) const
         case stringValue:
             return other == stringValue ||
                 (other == nullValue &&
-                 (!value_.string_ || value_.string_[0] == 0));
+                 (!stringData() || stringData()[0] == 0));
 
         case arrayValue:
             return other == arrayValue ||
@@ -18,70 +18,82 @@
 //==============================================================================
 
 #include <ripple/json/json_writer.h>
+#include <algorithm>
+#include <array>
 #include <cassert>
-#include <iomanip>
-#include <sstream>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <utility>
 
 namespace Json {
 
-static bool
-isControlCharacter(char ch)
+// The number of bytes escaping each character adds to the output: one for
+// the two character escapes, five for the other control characters, which
+// become \u00XX.
+static constexpr auto escapeLength = []() {
+    std::array<std::uint8_t, 256> table{};
+    for (int c = 1; c <= 0x1F; ++c)
+        table[c] = 5;
+    for (unsigned char c : {'"', '\\', '\b', '\f', '\n', '\r', '\t'})
+        table[c] = 1;
+    return table;
+}();
+
+// Find the first character in a string that must be escaped, or its end.
+//
+// Escapes are rare, so the string is scanned eight bytes at a time until
+// a word holds a quote, a backslash or a control character.
+static const char*
+findEscape(const char* current, const char* end)
 {
-    return ch > 0 && ch <= 0x1F;
-}
+    constexpr std::uint64_t ones = 0x0101010101010101ull;
+    constexpr std::uint64_t highs = 0x8080808080808080ull;
 
-static bool
-containsControlCharacter(const char* str)
-{
-    while (*str)
+    // Non-zero if any byte of a word is the given character
+    auto const has = [](std::uint64_t word, char c) {
+        std::uint64_t const v = word ^ (ones * static_cast<unsigned char>(c));
+        return (v - ones) & ~v & highs;
+    };
+
+    while (end - current >= 8)
     {
-        if (isControlCharacter(*(str++)))
-            return true;
+        std::uint64_t word;
+        std::memcpy(&word, current, sizeof(word));
+        if (has(word, '"') | has(word, '\\') |
+            ((word - ones * 0x20) & ~word & highs))
+            break;
+        current += 8;
     }
 
-    return false;
+    while (current != end &&
+           escapeLength[static_cast<unsigned char>(*current)] == 0)
+        ++current;
+
+    return current;
 }
-static void
-uintToString(unsigned int value, char*& current)
-{
-    *--current = 0;
 
-    do
-    {
-        *--current = (value % 10) + '0';
-        value /= 10;
-    } while (value != 0);
+template <class Integer>
+static std::string
+integerToString(Integer value)
+{
+    char buffer[24];
+    auto const result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    assert(result.ec == std::errc());
+    return std::string(buffer, result.ptr);
 }
 
 std::string
 valueToString(Int value)
 {
-    char buffer[32];
-    char* current = buffer + sizeof(buffer);
-    bool isNegative = value < 0;
-
-    if (isNegative)
-        value = -value;
-
-    uintToString(UInt(value), current);
-
-    if (isNegative)
-        *--current = '-';
-
-    assert(current >= buffer);
-    return current;
+    return integerToString(value);
 }
 
 std::string
 valueToString(UInt value)
 {
-    char buffer[32];
-    char* current = buffer + sizeof(buffer);
-    uintToString(value, current);
-    assert(current >= buffer);
-    return current;
+    return integerToString(value);
 }
 
 std::string
@@ -90,17 +102,17 @@ valueToString(double value)
     // Allocate a buffer that is more than large enough to store the 16 digits
     // of precision requested below.
     char buffer[32];
-    // Print into the buffer. We need not request the alternative representation
+    // Print as %.16g would. We need not request the alternative representation
     // that always has a decimal point because JSON doesn't distingish the
     // concepts of reals and integers.
-#if defined(_MSC_VER) && \
-    defined(__STDC_SECURE_LIB__)  // Use secure version with visual studio 2005
-                                  // to avoid warning.
-    sprintf_s(buffer, sizeof(buffer), "%.16g", value);
-#else
-    snprintf(buffer, sizeof(buffer), "%.16g", value);
-#endif
-    return buffer;
+    auto const result = std::to_chars(
+        buffer,
+        buffer + sizeof(buffer),
+        value,
+        std::chars_format::general,
+        16);
+    assert(result.ec == std::errc());
+    return std::string(buffer, result.ptr);
 }
 
 std::string
@@ -113,48 +125,51 @@ std::string
 valueToQuotedString(const char* value)
 {
     // Not sure how to handle unicode...
-    if (strpbrk(value, "\"\\\b\f\n\r\t") == nullptr &&
-        !containsControlCharacter(value))
-        return std::string("\"") + value + "\"";
+    auto const end = value + std::strlen(value);
+    auto next = findEscape(value, end);
 
-    // We have to walk value and escape any special characters.
-    // Appending to std::string is not efficient, but this should be rare.
+    // Size the result exactly before writing into it.
     // (Note: forward slashes are *not* rare, but I am not escaping them.)
-    unsigned maxsize = strlen(value) * 2 + 3;  // allescaped+quotes+NULL
-    std::string result;
-    result.reserve(maxsize);  // to avoid lots of mallocs
-    result += "\"";
+    std::size_t size = (end - value) + 2;
+    for (auto c = next; c != end; ++c)
+        size += escapeLength[static_cast<unsigned char>(*c)];
 
-    for (const char* c = value; *c != 0; ++c)
+    std::string result(size, '\0');
+    char* out = result.data();
+    *out++ = '"';
+
+    for (;;)
     {
-        switch (*c)
-        {
-            case '\"':
-                result += "\\\"";
-                break;
+        out = std::copy(value, next, out);
+        if (next == end)
+            break;
 
+        *out++ = '\\';
+        switch (*next)
+        {
+            case '"':
             case '\\':
-                result += "\\\\";
+                *out++ = *next;
                 break;
 
             case '\b':
-                result += "\\b";
+                *out++ = 'b';
                 break;
 
             case '\f':
-                result += "\\f";
+                *out++ = 'f';
                 break;
 
             case '\n':
-                result += "\\n";
+                *out++ = 'n';
                 break;
 
             case '\r':
-                result += "\\r";
+                *out++ = 'r';
                 break;
 
             case '\t':
-                result += "\\t";
+                *out++ = 't';
                 break;
 
                 // case '/':
@@ -164,25 +179,24 @@ valueToQuotedString(const char* value)
                 // blep notes: actually escaping \/ may be useful in javascript
                 // to avoid </ sequence. Should add a flag to allow this
                 // compatibility mode and prevent this sequence from occurring.
-            default:
-                if (isControlCharacter(*c))
-                {
-                    std::ostringstream oss;
-                    oss << "\\u" << std::hex << std::uppercase
-                        << std::setfill('0') << std::setw(4)
-                        << static_cast<int>(*c);
-                    result += oss.str();
-                }
-                else
-                {
-                    result += *c;
-                }
-
+            default: {
+                static constexpr char hex[] = "0123456789ABCDEF";
+                auto const c = static_cast<unsigned char>(*next);
+                *out++ = 'u';
+                *out++ = '0';
+                *out++ = '0';
+                *out++ = hex[c >> 4];
+                *out++ = hex[c & 0xF];
                 break;
+            }
         }
+
+        value = next + 1;
+        next = findEscape(value, end);
     }
 
-    result += "\"";
+    *out++ = '"';
+    assert(out == result.data() + result.size());
     return result;
 }
 
@@ -419,6 +419,16 @@ private:
     Value&
     resolveReference(const char* key, bool isStatic);
 
+    // Store a copy of a string, in place if it is short enough
+    void
+    setString(const char* value, unsigned int length);
+
+    const char*
+    stringData() const
+    {
+        return inline_ ? value_.short_ : value_.string_;
+    }
+
 private:
     union ValueHolder
     {
@@ -427,10 +437,13 @@ private:
         double real_;
         bool bool_;
         char* string_;
+        // Strings that fit here, with their terminator, are not allocated
+        char short_[sizeof(char*)];
         ObjectValues* map_{nullptr};
     } value_;
     ValueType type_ : 8;
     int allocated_ : 1;  // Notes: if declared as bool, bitfield is useless.
+    int inline_ : 1;     // The string is held in value_.short_
 };
 
 bool
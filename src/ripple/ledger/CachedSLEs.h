@@ -23,9 +23,116 @@
 #include <ripple/basics/TaggedCache.h>
 #include <ripple/basics/base_uint.h>
 #include <ripple/protocol/STLedgerEntry.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
 
 namespace ripple {
-using CachedSLEs = TaggedCache<uint256, SLE const>;
-}
+
+/** Ledger entries shared by every CachedView, keyed by digest.
+
+    The entries are spread by digest over independently locked shards,
+    so threads reading through different views seldom wait on each
+    other. Hits and misses are also counted for the kind of caller the
+    reading thread has declared with a CachedSLEs::Scope.
+*/
+class CachedSLEs
+{
+    using cache_type = TaggedCache<uint256, SLE const>;
+
+public:
+    using clock_type = cache_type::clock_type;
+
+    /** The kinds of callers that hit rates are reported for. */
+    enum class Caller : std::uint8_t { other, rpc, pathfinding, transaction };
+
+    static constexpr std::size_t callers = 4;
+
+    /** Attributes this thread's reads to a caller while it exists. */
+    class Scope
+    {
+        Caller const previous_;
+
+    public:
+        explicit Scope(Caller caller);
+        ~Scope();
+
+        Scope(Scope const&) = delete;
+        Scope&
+        operator=(Scope const&) = delete;
+    };
+
+    CachedSLEs(
+        std::string const& name,
+        int size,
+        clock_type::duration expiration,
+        clock_type& clock,
+        beast::Journal journal);
+
+    /** Fetch an entry, calling the handler to load it on a miss.
+
+        The handler has the signature std::shared_ptr<SLE const>(void).
+    */
+    template <class Handler>
+    std::shared_ptr<SLE const>
+    fetch(uint256 const& digest, Handler const& handler)
+    {
+        bool loaded = false;
+        auto sle = shard(digest).fetch(digest, [&]() {
+            loaded = true;
+            return handler();
+        });
+        // As with TaggedCache, a load that finds nothing is not counted.
+        if (!loaded || sle)
+            record(loaded);
+        return sle;
+    }
+
+    /** Returns the fraction of fetches that were hits. */
+    double
+    rate() const;
+
+    /** Returns the fraction of fetches by a caller that were hits. */
+    double
+    rate(Caller caller) const;
+
+    std::size_t
+    size() const;
+
+    /** Returns the number of bytes held by the cached entries. */
+    std::size_t
+    bytes() const;
+
+    /** Expire old entries, one shard at a time. */
+    void
+    sweep();
+
+private:
+    static constexpr std::size_t shardCount = 16;
+
+    struct alignas(64) Counts
+    {
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+    };
+
+    cache_type&
+    shard(uint256 const& digest)
+    {
+        // Digests are uniformly distributed, so any byte will do.
+        return *shards_[*digest.begin() % shardCount];
+    }
+
+    void
+    record(bool miss);
+
+    std::array<std::unique_ptr<cache_type>, shardCount> shards_;
+    std::array<Counts, callers> counts_;
+};
+
+}  // namespace ripple
 
 #endif  // RIPPLE_LEDGER_CACHEDSLES_H_INCLUDED
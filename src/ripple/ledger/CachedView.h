@@ -38,7 +38,12 @@ private:
     DigestAwareReadView const& base_;
     CachedSLEs& cache_;
     std::mutex mutable mutex_;
-    std::unordered_map<key_type, uint256, hardened_hash<>> mutable map_;
+    std::unordered_map<key_type, uint256, digest_hash> mutable map_;
+
+    // Gaps found between NFTokenPages, from the key ending each gap (a
+    // page or, past an owner's last page, the end of the owner's range)
+    // to the key the search started from.
+    std::map<key_type, key_type> mutable pageGaps_;
 
 public:
     CachedViewImpl() = delete;
@@ -61,6 +66,9 @@ public:
     std::shared_ptr<SLE const>
     read(Keylet const& k) const override;
 
+    void
+    prefetch(std::vector<key_type> const& keys) const override;
+
     bool
     open() const override
     {
@@ -88,10 +96,7 @@ public:
     std::optional<key_type>
     succ(
         key_type const& key,
-        std::optional<key_type> const& last = std::nullopt) const override
-    {
-        return base_.succ(key, last);
-    }
+        std::optional<key_type> const& last = std::nullopt) const override;
 
     std::unique_ptr<sles_type::iter_base>
     slesBegin() const override
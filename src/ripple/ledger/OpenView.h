@@ -46,6 +46,33 @@ struct open_ledger_t
 
 extern open_ledger_t const open_ledger;
 
+/** Speculative view construction tag.
+
+    Views constructed with this tag number the
+    transactions they hold after a given count,
+    as if they had been applied to a view which
+    already held that many transactions.
+*/
+struct speculative_t
+{
+    explicit speculative_t() = default;
+};
+
+extern speculative_t const speculative;
+
+/** Layered view construction tag.
+
+    Views constructed with this tag record only the
+    changes made on top of another OpenView, which
+    they share rather than copy.
+*/
+struct layered_t
+{
+    explicit layered_t() = default;
+};
+
+extern layered_t const layered;
+
 //------------------------------------------------------------------------------
 
 /** Writable ledger view that accumulates state and tx changes.
@@ -60,6 +87,9 @@ private:
     // It is unclear how the size initially chosen in qalloc.
     static constexpr size_t initialBufferSize = kilobytes(256);
 
+    // Layers usually hold a handful of changes, so start them small.
+    static constexpr size_t layerBufferSize = kilobytes(4);
+
     class txs_iter_impl;
 
     struct txData
@@ -94,10 +124,21 @@ private:
     Rules rules_;
     LedgerInfo info_;
     ReadView const* base_;
+    // The view this one is layered on, if any. It is also base_.
+    OpenView const* parent_ = nullptr;
     detail::RawStateTable items_;
     std::shared_ptr<void const> hold_;
+    std::size_t baseTxCount_ = 0;
     bool open_ = true;
 
+    // Number of state items and tx held by this layer
+    std::size_t
+    layerSize() const;
+
+    // Apply the changes held by this layer alone
+    void
+    applyLayer(TxsRawView& to) const;
+
 public:
     OpenView() = delete;
     OpenView&
@@ -170,6 +211,54 @@ public:
     */
     OpenView(ReadView const* base, std::shared_ptr<void const> hold = nullptr);
 
+    /** Construct a view to apply transactions ahead of time.
+
+        Effects:
+
+            As for the constructor above, except
+            that txCount() starts at `txCount`.
+
+        This lets metadata built in this view carry the
+        transaction index it would have had if the
+        transactions were applied directly to a view
+        holding `txCount` transactions.
+    */
+    OpenView(speculative_t, ReadView const* base, std::size_t txCount);
+
+    /** Construct a view layered on another open view.
+
+        Effects:
+            The LedgerInfo, rules and txCount() are
+            taken from `parent`, which is retained
+            until this view is destroyed.
+
+        Only the changes made to this view are stored
+        in it. Reads fall through to `parent`, and the
+        tx list presents the transactions of both. This
+        makes the view cheap to create no matter how
+        many changes `parent` holds, at the cost of one
+        extra lookup per layer on every read.
+
+        @see collapse
+    */
+    OpenView(layered_t, std::shared_ptr<OpenView const> const& parent);
+
+    /** Bound the depth of a chain of layered views.
+
+        The top layer is folded into a copy of the one
+        beneath it for as long as it holds at least as
+        many changes. Like carries in a binary counter,
+        this keeps the number of layers logarithmic in
+        the number of changes, while each change is
+        copied a logarithmic number of times.
+
+        @return The top of the resulting chain, which
+                presents the same state and tx list as
+                `view`.
+    */
+    static std::shared_ptr<OpenView const>
+    collapse(std::shared_ptr<OpenView const> view);
+
     /** Returns true if this reflects an open ledger. */
     bool
     open() const override
@@ -177,7 +266,8 @@ public:
         return open_;
     }
 
-    /** Return the number of tx inserted since creation.
+    /** Return the number of tx inserted since creation,
+        plus any starting count given on construction.
 
         This is used to set the "apply ordinal"
         when calculating transaction metadata.
@@ -185,10 +275,25 @@ public:
     std::size_t
     txCount() const;
 
-    /** Apply changes. */
+    /** Apply changes.
+
+        For a layered view, this applies the changes
+        of the views beneath it first.
+    */
     void
     apply(TxsRawView& to) const;
 
+    /** Call `f` with the key and serialized form of each tx
+        inserted in this view, but not in the views beneath it.
+    */
+    template <class F>
+    void
+    forEachLayerTx(F&& f) const
+    {
+        for (auto const& [key, data] : txs_)
+            f(key, data.txn->slice());
+    }
+
     // ReadView
 
     LedgerInfo const&
@@ -211,6 +316,9 @@ public:
     std::shared_ptr<SLE const>
     read(Keylet const& k) const override;
 
+    void
+    prefetch(std::vector<key_type> const& keys) const override;
+
     std::unique_ptr<sles_type::iter_base>
     slesBegin() const override;
 
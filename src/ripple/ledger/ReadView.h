@@ -40,6 +40,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_set>
+#include <vector>
 
 namespace ripple {
 
@@ -173,6 +174,17 @@ public:
     virtual std::shared_ptr<SLE const>
     read(Keylet const& k) const = 0;
 
+    /** Start loading state items that are about to be read.
+
+        This is only a hint: it never changes what a later read returns,
+        and the default does nothing. Views over a ledger's state map
+        fetch the missing nodes on the node store's read threads.
+    */
+    virtual void
+    prefetch(std::vector<key_type> const& keys) const
+    {
+    }
+
     // Accounts in a payment are not allowed to use assets acquired during that
     // payment. The PaymentSandbox tracks the debits, credits, and owner count
     // changes that accounts make during a payment. `balanceHook` adjusts
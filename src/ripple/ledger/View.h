@@ -156,6 +156,15 @@ xrpLiquid(
     std::int32_t ownerCountAdj,
     beast::Journal j);
 
+/** Start loading what a walk of a directory reads after a page.
+
+    That is the entries of the page and the few pages that follow it.
+    Pages are numbered in the order they were added, so those after the
+    next one are guessed from its number; a wrong guess costs one read.
+*/
+void
+prefetchDirectory(ReadView const& view, uint256 const& root, SLE const& page);
+
 /** Iterate all items in the given directory. */
 void
 forEachItem(
@@ -27,6 +27,13 @@
 #include <ripple/ledger/ReadView.h>
 #include <ripple/protocol/TER.h>
 #include <ripple/protocol/TxMeta.h>
+
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+
+#include <array>
+#include <cstddef>
+#include <map>
 #include <memory>
 
 namespace ripple {
@@ -38,6 +45,11 @@ class ApplyStateTable
 public:
     using key_type = ReadView::key_type;
 
+    // Size of the buffer allocated along with the first entry. Most
+    // transactions touch fewer than ten entries, whose nodes all fit in it,
+    // so building the table costs a single allocation.
+    static constexpr std::size_t initialBufferSize = kilobytes(1);
+
 private:
     enum class Action {
         cache,
@@ -46,13 +58,38 @@ private:
         modify,
     };
 
-    using items_t = std::map<key_type, std::pair<Action, std::shared_ptr<SLE>>>;
+    // Use boost::pmr functionality instead of the std::pmr
+    // functions b/c clang does not support pmr yet (as-of 9/2020)
+    using items_t = std::map<
+        key_type,
+        std::pair<Action, std::shared_ptr<SLE>>,
+        std::less<key_type>,
+        boost::container::pmr::polymorphic_allocator<std::pair<
+            key_type const,
+            std::pair<Action, std::shared_ptr<SLE>>>>>;
+
+    // The entries, the first buffer, and the resource which hands it out.
+    // Once the buffer is used up, the resource takes larger blocks from the
+    // heap.
+    struct Items
+    {
+        std::array<std::byte, initialBufferSize> buffer;
+        boost::container::pmr::monotonic_buffer_resource resource;
+        items_t map;
 
-    items_t items_;
+        Items() : resource(buffer.data(), buffer.size()), map(&resource)
+        {
+        }
+    };
+
+    // Made when the first entry is added, since many tables are only read
+    // through. A pointer, so the table may be easily moved.
+    std::unique_ptr<Items> items_;
     XRPAmount dropsDestroyed_{0};
 
 public:
     ApplyStateTable() = default;
+
     ApplyStateTable(ApplyStateTable&&) = default;
 
     ApplyStateTable(ApplyStateTable const&) = delete;
@@ -125,7 +162,20 @@ public:
     }
 
 private:
-    using Mods = hash_map<key_type, std::shared_ptr<SLE>>;
+    // The entries, which are none until the first is added
+    items_t const&
+    items() const;
+
+    // The entries, made if there are none yet
+    items_t&
+    writableItems();
+
+    using Mods = std::map<
+        key_type,
+        std::shared_ptr<SLE>,
+        std::less<key_type>,
+        boost::container::pmr::polymorphic_allocator<
+            std::pair<key_type const, std::shared_ptr<SLE>>>>;
 
     static void
     threadItem(TxMeta& meta, std::shared_ptr<SLE> const& to);
@@ -48,6 +48,12 @@ public:
               initialBufferSize)}
         , items_{monotonic_resource_.get()} {};
 
+    /** Create an empty table whose first buffer holds `bufferSize` bytes. */
+    explicit RawStateTable(std::size_t bufferSize)
+        : monotonic_resource_{std::make_unique<
+              boost::container::pmr::monotonic_buffer_resource>(bufferSize)}
+        , items_{monotonic_resource_.get()} {};
+
     RawStateTable(RawStateTable const& rhs)
         : monotonic_resource_{std::make_unique<
               boost::container::pmr::monotonic_buffer_resource>(
@@ -65,6 +71,13 @@ public:
     void
     apply(RawView& to) const;
 
+    /** Return the number of state items modified. */
+    std::size_t
+    size() const
+    {
+        return items_.size();
+    }
+
     bool
     exists(ReadView const& base, Keylet const& k) const;
 
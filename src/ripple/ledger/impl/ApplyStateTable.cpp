@@ -27,11 +27,26 @@
 namespace ripple {
 namespace detail {
 
+auto
+ApplyStateTable::items() const -> items_t const&
+{
+    static items_t const none;
+    return items_ ? items_->map : none;
+}
+
+auto
+ApplyStateTable::writableItems() -> items_t&
+{
+    if (!items_)
+        items_ = std::make_unique<Items>();
+    return items_->map;
+}
+
 void
 ApplyStateTable::apply(RawView& to) const
 {
     to.rawDestroyXRP(dropsDestroyed_);
-    for (auto const& item : items_)
+    for (auto const& item : items())
     {
         auto const& sle = item.second.second;
         switch (item.second.first)
@@ -55,7 +70,7 @@ std::size_t
 ApplyStateTable::size() const
 {
     std::size_t ret = 0;
-    for (auto& item : items_)
+    for (auto& item : items())
     {
         switch (item.second.first)
         {
@@ -79,7 +94,7 @@ ApplyStateTable::visit(
         std::shared_ptr<SLE const> const& before,
         std::shared_ptr<SLE const> const& after)> const& func) const
 {
-    for (auto& item : items_)
+    for (auto& item : items())
     {
         switch (item.second.first)
         {
@@ -126,8 +141,14 @@ ApplyStateTable::apply(
         TxMeta meta(tx.getTransactionID(), to.seq());
         if (deliver)
             meta.setDeliveredAmount(*deliver);
-        Mods newMod;
-        for (auto& item : items_)
+
+        // Only the owners threaded to land here, so a small buffer on the
+        // stack usually holds all of them.
+        std::array<std::byte, 512> modBuffer;
+        boost::container::pmr::monotonic_buffer_resource modResource(
+            modBuffer.data(), modBuffer.size());
+        Mods newMod(&modResource);
+        for (auto& item : items())
         {
             SField const* type;
             switch (item.second.first)
@@ -267,8 +288,8 @@ ApplyStateTable::apply(
 bool
 ApplyStateTable::exists(ReadView const& base, Keylet const& k) const
 {
-    auto const iter = items_.find(k.key);
-    if (iter == items_.end())
+    auto const iter = items().find(k.key);
+    if (iter == items().end())
         return base.exists(k);
     auto const& item = iter->second;
     auto const& sle = item.second;
@@ -301,10 +322,10 @@ ApplyStateTable::succ(
         next = base.succ(*next, last);
         if (!next)
             break;
-        iter = items_.find(*next);
-    } while (iter != items_.end() && iter->second.first == Action::erase);
+        iter = items().find(*next);
+    } while (iter != items().end() && iter->second.first == Action::erase);
     // Find non-deleted successor in our list
-    for (iter = items_.upper_bound(key); iter != items_.end(); ++iter)
+    for (iter = items().upper_bound(key); iter != items().end(); ++iter)
     {
         if (iter->second.first != Action::erase)
         {
@@ -324,8 +345,8 @@ ApplyStateTable::succ(
 std::shared_ptr<SLE const>
 ApplyStateTable::read(ReadView const& base, Keylet const& k) const
 {
-    auto const iter = items_.find(k.key);
-    if (iter == items_.end())
+    auto const iter = items().find(k.key);
+    if (iter == items().end())
         return base.read(k);
     auto const& item = iter->second;
     auto const& sle = item.second;
@@ -346,16 +367,19 @@ ApplyStateTable::read(ReadView const& base, Keylet const& k) const
 std::shared_ptr<SLE>
 ApplyStateTable::peek(ReadView const& base, Keylet const& k)
 {
-    auto iter = items_.lower_bound(k.key);
-    if (iter == items_.end() || iter->first != k.key)
+    // Don't make the entries only to find that the base has nothing either
+    items_t::const_iterator iter = items().lower_bound(k.key);
+    if (iter == items().end() || iter->first != k.key)
     {
         auto const sle = base.read(k);
         if (!sle)
             return nullptr;
+        bool const first = !items_;
+        auto& entries = writableItems();
         // Make our own copy
         using namespace std;
-        iter = items_.emplace_hint(
-            iter,
+        iter = entries.emplace_hint(
+            first ? entries.end() : iter,
             piecewise_construct,
             forward_as_tuple(sle->key()),
             forward_as_tuple(Action::cache, make_shared<SLE>(*sle)));
@@ -380,8 +404,9 @@ ApplyStateTable::peek(ReadView const& base, Keylet const& k)
 void
 ApplyStateTable::erase(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
-    auto const iter = items_.find(sle->key());
-    if (iter == items_.end())
+    auto& entries = writableItems();
+    auto const iter = entries.find(sle->key());
+    if (iter == entries.end())
         LogicError("ApplyStateTable::erase: missing key");
     auto& item = iter->second;
     if (item.second != sle)
@@ -392,7 +417,7 @@ ApplyStateTable::erase(ReadView const& base, std::shared_ptr<SLE> const& sle)
             LogicError("ApplyStateTable::erase: double erase");
             break;
         case Action::insert:
-            items_.erase(iter);
+            entries.erase(iter);
             break;
         case Action::cache:
         case Action::modify:
@@ -405,7 +430,8 @@ void
 ApplyStateTable::rawErase(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
     using namespace std;
-    auto const result = items_.emplace(
+    auto& entries = writableItems();
+    auto const result = entries.emplace(
         piecewise_construct,
         forward_as_tuple(sle->key()),
         forward_as_tuple(Action::erase, sle));
@@ -418,7 +444,7 @@ ApplyStateTable::rawErase(ReadView const& base, std::shared_ptr<SLE> const& sle)
             LogicError("ApplyStateTable::rawErase: double erase");
             break;
         case Action::insert:
-            items_.erase(result.first);
+            entries.erase(result.first);
             break;
         case Action::cache:
         case Action::modify:
@@ -431,11 +457,12 @@ ApplyStateTable::rawErase(ReadView const& base, std::shared_ptr<SLE> const& sle)
 void
 ApplyStateTable::insert(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
-    auto const iter = items_.lower_bound(sle->key());
-    if (iter == items_.end() || iter->first != sle->key())
+    auto& entries = writableItems();
+    auto const iter = entries.lower_bound(sle->key());
+    if (iter == entries.end() || iter->first != sle->key())
     {
         using namespace std;
-        items_.emplace_hint(
+        entries.emplace_hint(
             iter,
             piecewise_construct,
             forward_as_tuple(sle->key()),
@@ -461,11 +488,12 @@ ApplyStateTable::insert(ReadView const& base, std::shared_ptr<SLE> const& sle)
 void
 ApplyStateTable::replace(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
-    auto const iter = items_.lower_bound(sle->key());
-    if (iter == items_.end() || iter->first != sle->key())
+    auto& entries = writableItems();
+    auto const iter = entries.lower_bound(sle->key());
+    if (iter == entries.end() || iter->first != sle->key())
     {
         using namespace std;
-        items_.emplace_hint(
+        entries.emplace_hint(
             iter,
             piecewise_construct,
             forward_as_tuple(sle->key()),
@@ -490,8 +518,9 @@ ApplyStateTable::replace(ReadView const& base, std::shared_ptr<SLE> const& sle)
 void
 ApplyStateTable::update(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
-    auto const iter = items_.find(sle->key());
-    if (iter == items_.end())
+    auto& entries = writableItems();
+    auto const iter = entries.find(sle->key());
+    if (iter == entries.end())
         LogicError("ApplyStateTable::update: missing key");
     auto& item = iter->second;
     if (item.second != sle)
@@ -560,8 +589,8 @@ ApplyStateTable::getForMod(
         }
     }
     {
-        auto iter = items_.find(key);
-        if (iter != items_.end())
+        auto iter = items().find(key);
+        if (iter != items().end())
         {
             auto const& item = iter->second;
             if (item.first == Action::erase)
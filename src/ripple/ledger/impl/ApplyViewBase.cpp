@@ -73,6 +73,12 @@ ApplyViewBase::read(Keylet const& k) const
     return items_.read(*base_, k);
 }
 
+void
+ApplyViewBase::prefetch(std::vector<key_type> const& keys) const
+{
+    base_->prefetch(keys);
+}
+
 auto
 ApplyViewBase::slesBegin() const -> std::unique_ptr<sles_type::iter_base>
 {
@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/ledger/CachedSLEs.h>
+
+namespace ripple {
+
+namespace {
+
+thread_local CachedSLEs::Caller currentCaller = CachedSLEs::Caller::other;
+
+double
+hitRate(std::uint64_t hits, std::uint64_t misses)
+{
+    auto const total = hits + misses;
+    if (total == 0)
+        return 0;
+    return double(hits) / total;
+}
+
+}  // namespace
+
+CachedSLEs::Scope::Scope(Caller caller) : previous_(currentCaller)
+{
+    currentCaller = caller;
+}
+
+CachedSLEs::Scope::~Scope()
+{
+    currentCaller = previous_;
+}
+
+CachedSLEs::CachedSLEs(
+    std::string const& name,
+    int size,
+    clock_type::duration expiration,
+    clock_type& clock,
+    beast::Journal journal)
+{
+    for (auto& shard : shards_)
+        shard = std::make_unique<cache_type>(
+            name, size, expiration, clock, journal);
+}
+
+void
+CachedSLEs::record(bool miss)
+{
+    auto& counts = counts_[static_cast<std::size_t>(currentCaller)];
+    if (miss)
+        counts.misses.fetch_add(1, std::memory_order_relaxed);
+    else
+        counts.hits.fetch_add(1, std::memory_order_relaxed);
+}
+
+double
+CachedSLEs::rate() const
+{
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    for (auto const& counts : counts_)
+    {
+        hits += counts.hits.load(std::memory_order_relaxed);
+        misses += counts.misses.load(std::memory_order_relaxed);
+    }
+    return hitRate(hits, misses);
+}
+
+double
+CachedSLEs::rate(Caller caller) const
+{
+    auto const& counts = counts_[static_cast<std::size_t>(caller)];
+    return hitRate(
+        counts.hits.load(std::memory_order_relaxed),
+        counts.misses.load(std::memory_order_relaxed));
+}
+
+std::size_t
+CachedSLEs::size() const
+{
+    std::size_t total = 0;
+    for (auto const& shard : shards_)
+        total += shard->size();
+    return total;
+}
+
+std::size_t
+CachedSLEs::bytes() const
+{
+    std::size_t total = 0;
+    for (auto const& shard : shards_)
+        total += shard->getCacheBytes();
+    return total;
+}
+
+void
+CachedSLEs::sweep()
+{
+    for (auto& shard : shards_)
+        shard->sweep();
+}
+
+}  // namespace ripple
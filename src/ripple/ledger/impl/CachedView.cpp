@@ -20,6 +20,7 @@
 #include <ripple/basics/contract.h>
 #include <ripple/ledger/CachedView.h>
 #include <ripple/protocol/Serializer.h>
+#include <ripple/protocol/nftPageMask.h>
 
 namespace ripple {
 namespace detail {
@@ -80,5 +81,41 @@ CachedViewImpl::read(Keylet const& k) const
     return sle;
 }
 
+std::optional<uint256>
+CachedViewImpl::succ(key_type const& key, std::optional<key_type> const& last)
+    const
+{
+    // Locating an NFT searches the rest of its owner's page range. The
+    // base never changes, so each gap found there answers every later
+    // search starting inside it without walking the state map again.
+    if (!last || (key | nft::pageMask).next() != *last)
+        return base_.succ(key, last);
+
+    {
+        std::lock_guard lock(mutex_);
+        auto const iter = pageGaps_.upper_bound(key);
+        if (iter != pageGaps_.end() && iter->second <= key)
+        {
+            if (iter->first == *last)
+                return std::nullopt;
+            return iter->first;
+        }
+    }
+
+    auto const next = base_.succ(key, last);
+    std::lock_guard lock(mutex_);
+    auto const [iter, inserted] =
+        pageGaps_.emplace(next.value_or(*last), key);
+    if (!inserted && key < iter->second)
+        iter->second = key;
+    return next;
+}
+
+void
+CachedViewImpl::prefetch(std::vector<key_type> const& keys) const
+{
+    base_.prefetch(keys);
+}
+
 }  // namespace detail
 }  // namespace ripple
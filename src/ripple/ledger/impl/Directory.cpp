@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/ledger/Directory.h>
+#include <ripple/ledger/View.h>
 
 namespace ripple {
 
@@ -27,7 +28,10 @@ Dir::Dir(ReadView const& view, Keylet const& key)
     : view_(&view), root_(key), sle_(view_->read(root_))
 {
     if (sle_ != nullptr)
+    {
+        prefetchDirectory(*view_, root_.key, *sle_);
         indexes_ = &sle_->getFieldV256(sfIndexes);
+    }
 }
 
 auto
@@ -110,6 +114,7 @@ const_iterator::next_page()
         page_ = keylet::page(root_, next);
         sle_ = view_->read(page_);
         assert(sle_);
+        prefetchDirectory(*view_, root_.key, *sle_);
         indexes_ = &sle_->getFieldV256(sfIndexes);
         if (indexes_->empty())
         {
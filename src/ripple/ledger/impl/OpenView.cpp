@@ -19,54 +19,81 @@
 
 #include <ripple/basics/contract.h>
 #include <ripple/ledger/OpenView.h>
+#include <vector>
 
 namespace ripple {
 
 open_ledger_t const open_ledger{};
 
+speculative_t const speculative{};
+
+layered_t const layered{};
+
+// Visits the tx of every layer in a chain of views in key order
 class OpenView::txs_iter_impl : public txs_type::iter_base
 {
+public:
+    using range = std::pair<txs_map::const_iterator, txs_map::const_iterator>;
+
 private:
     bool metadata_;
-    txs_map::const_iterator iter_;
+    // The unvisited tx of each layer, top layer first
+    std::vector<range> ranges_;
+
+    // Return the index of the layer holding the lowest unvisited key
+    std::size_t
+    front() const
+    {
+        auto result = ranges_.size();
+        for (std::size_t i = 0; i < ranges_.size(); ++i)
+        {
+            auto const& r = ranges_[i];
+            if (r.first != r.second &&
+                (result == ranges_.size() ||
+                 r.first->first < ranges_[result].first->first))
+                result = i;
+        }
+        return result;
+    }
 
 public:
-    explicit txs_iter_impl(bool metadata, txs_map::const_iterator iter)
-        : metadata_(metadata), iter_(iter)
+    txs_iter_impl(bool metadata, std::vector<range> ranges)
+        : metadata_(metadata), ranges_(std::move(ranges))
     {
     }
 
     std::unique_ptr<base_type>
     copy() const override
     {
-        return std::make_unique<txs_iter_impl>(metadata_, iter_);
+        return std::make_unique<txs_iter_impl>(metadata_, ranges_);
     }
 
     bool
     equal(base_type const& impl) const override
     {
         if (auto const p = dynamic_cast<txs_iter_impl const*>(&impl))
-            return iter_ == p->iter_;
+            return ranges_ == p->ranges_;
         return false;
     }
 
     void
     increment() override
     {
-        ++iter_;
+        ++ranges_[front()].first;
     }
 
     value_type
     dereference() const override
     {
+        auto const& item = ranges_[front()].first->second;
         value_type result;
         {
-            SerialIter sit(iter_->second.txn->slice());
+            SerialIter sit(item.txn->slice());
             result.first = std::make_shared<STTx const>(sit);
         }
         if (metadata_)
         {
-            SerialIter sit(iter_->second.meta->slice());
+            SerialIter sit(item.meta->slice());
             result.second = std::make_shared<STObject const>(sit, sfMetadata);
         }
         return result;
@@ -84,8 +111,10 @@ OpenView::OpenView(OpenView const& rhs)
     , rules_{rhs.rules_}
     , info_{rhs.info_}
     , base_{rhs.base_}
+    , parent_{rhs.parent_}
     , items_{rhs.items_}
     , hold_{rhs.hold_}
+    , baseTxCount_{rhs.baseTxCount_}
     , open_{rhs.open_} {};
 
 OpenView::OpenView(
@@ -120,14 +149,61 @@ OpenView::OpenView(ReadView const* base, std::shared_ptr<void const> hold)
 {
 }
 
+OpenView::OpenView(speculative_t, ReadView const* base, std::size_t txCount)
+    : OpenView(base)
+{
+    baseTxCount_ = txCount;
+}
+
+OpenView::OpenView(layered_t, std::shared_ptr<OpenView const> const& parent)
+    : monotonic_resource_{std::make_unique<
+          boost::container::pmr::monotonic_buffer_resource>(layerBufferSize)}
+    , txs_{monotonic_resource_.get()}
+    , rules_(parent->rules_)
+    , info_(parent->info_)
+    , base_(parent.get())
+    , parent_(parent.get())
+    , items_(layerBufferSize)
+    , hold_(parent)
+    , baseTxCount_(parent->txCount())
+    , open_(parent->open_)
+{
+}
+
+std::shared_ptr<OpenView const>
+OpenView::collapse(std::shared_ptr<OpenView const> view)
+{
+    while (view->parent_ && view->layerSize() >= view->parent_->layerSize())
+    {
+        auto merged = std::make_shared<OpenView>(*view->parent_);
+        view->applyLayer(*merged);
+        view = std::move(merged);
+    }
+    return view;
+}
+
 std::size_t
 OpenView::txCount() const
 {
-    return txs_.size();
+    return baseTxCount_ + txs_.size();
 }
 
 void
 OpenView::apply(TxsRawView& to) const
+{
+    if (parent_)
+        parent_->apply(to);
+    applyLayer(to);
+}
+
+std::size_t
+OpenView::layerSize() const
+{
+    return items_.size() + txs_.size();
+}
+
+void
+OpenView::applyLayer(TxsRawView& to) const
 {
     items_.apply(to);
     for (auto const& item : txs_)
@@ -173,6 +249,12 @@ OpenView::read(Keylet const& k) const
     return items_.read(*base_, k);
 }
 
+void
+OpenView::prefetch(std::vector<key_type> const& keys) const
+{
+    base_->prefetch(keys);
+}
+
 auto
 OpenView::slesBegin() const -> std::unique_ptr<sles_type::iter_base>
 {
@@ -195,19 +277,30 @@ OpenView::slesUpperBound(uint256 const& key) const
 auto
 OpenView::txsBegin() const -> std::unique_ptr<txs_type::iter_base>
 {
-    return std::make_unique<txs_iter_impl>(!open(), txs_.cbegin());
+    std::vector<txs_iter_impl::range> ranges;
+    for (auto layer = this; layer; layer = layer->parent_)
+        ranges.emplace_back(layer->txs_.cbegin(), layer->txs_.cend());
+    return std::make_unique<txs_iter_impl>(!open(), std::move(ranges));
 }
 
 auto
 OpenView::txsEnd() const -> std::unique_ptr<txs_type::iter_base>
 {
-    return std::make_unique<txs_iter_impl>(!open(), txs_.cend());
+    std::vector<txs_iter_impl::range> ranges;
+    for (auto layer = this; layer; layer = layer->parent_)
+        ranges.emplace_back(layer->txs_.cend(), layer->txs_.cend());
+    return std::make_unique<txs_iter_impl>(!open(), std::move(ranges));
 }
 
 bool
 OpenView::txExists(key_type const& key) const
 {
-    return txs_.find(key) != txs_.end();
+    for (auto layer = this; layer; layer = layer->parent_)
+    {
+        if (layer->txs_.find(key) != layer->txs_.end())
+            return true;
+    }
+    return false;
 }
 
 auto
@@ -263,6 +356,8 @@ OpenView::rawTxInsert(
     std::shared_ptr<Serializer const> const& txn,
     std::shared_ptr<Serializer const> const& metaData)
 {
+    if (parent_ && parent_->txExists(key))
+        LogicError("rawTxInsert: duplicate TX id" + to_string(key));
     auto const result = txs_.emplace(
         std::piecewise_construct,
         std::forward_as_tuple(key),
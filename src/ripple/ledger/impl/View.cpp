@@ -28,6 +28,7 @@
 #include <ripple/protocol/st.h>
 #include <cassert>
 #include <optional>
+#include <vector>
 
 namespace ripple {
 
@@ -70,6 +71,7 @@ internalDirNext(
         if (!page)
             return false;
 
+        prefetchDirectory(view, root, *page);
         index = 0;
 
         return internalDirNext(view, root, page, index, entry);
@@ -101,6 +103,7 @@ internalDirFirst(
     if (!page)
         return false;
 
+    prefetchDirectory(view, root, *page);
     index = 0;
 
     return internalDirNext(view, root, page, index, entry);
@@ -380,6 +383,27 @@ xrpLiquid(
     return amount.xrp();
 }
 
+// How many pages beyond the current one a directory walk asks for
+static constexpr std::uint64_t dirPrefetchPages = 4;
+
+void
+prefetchDirectory(ReadView const& view, uint256 const& root, SLE const& page)
+{
+    auto const& indexes = page.getFieldV256(sfIndexes);
+
+    std::vector<uint256> keys;
+    keys.reserve(indexes.size() + dirPrefetchPages);
+    keys.insert(keys.end(), indexes.begin(), indexes.end());
+
+    if (auto const next = page.getFieldU64(sfIndexNext))
+    {
+        for (std::uint64_t i = 0; i < dirPrefetchPages; ++i)
+            keys.push_back(keylet::page(root, next + i).key);
+    }
+
+    view.prefetch(keys);
+}
+
 void
 forEachItem(
     ReadView const& view,
@@ -398,6 +422,7 @@ forEachItem(
         auto sle = view.read(pos);
         if (!sle)
             return;
+        prefetchDirectory(view, root.key, *sle);
         for (auto const& key : sle->getFieldV256(sfIndexes))
             f(view.read(keylet::child(key)));
         auto const next = sle->getFieldU64(sfIndexNext);
@@ -447,6 +472,7 @@ forEachItemAfter(
             auto const ownerDir = view.read(currentIndex);
             if (!ownerDir)
                 return found;
+            prefetchDirectory(view, root.key, *ownerDir);
             for (auto const& key : ownerDir->getFieldV256(sfIndexes))
             {
                 if (!found)
@@ -473,6 +499,7 @@ forEachItemAfter(
             auto const ownerDir = view.read(currentIndex);
             if (!ownerDir)
                 return true;
+            prefetchDirectory(view, root.key, *ownerDir);
             for (auto const& key : ownerDir->getFieldV256(sfIndexes))
                 if (f(view.read(keylet::child(key))) && limit-- <= 1)
                     return true;
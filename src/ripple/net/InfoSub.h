@@ -23,9 +23,11 @@
 #include <ripple/app/misc/Manifest.h>
 #include <ripple/basics/CountedObject.h>
 #include <ripple/json/json_value.h>
+#include <ripple/net/MultiApiMessage.h>
 #include <ripple/protocol/Book.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/resource/Consumer.h>
+#include <atomic>
 #include <mutex>
 
 namespace ripple {
@@ -201,6 +203,15 @@ public:
     virtual void
     send(Json::Value const& jvObj, bool broadcast) = 0;
 
+    /** Send a message published to many subscribers.
+
+        By default, this sends the JSON for this subscriber's API version.
+        Subscribers that send text override this to reuse the serialized
+        message, rather than serialize the JSON again.
+    */
+    virtual void
+    send(MultiApiMessage const& message, bool broadcast);
+
     std::uint64_t
     getSeq();
 
@@ -235,6 +246,15 @@ public:
     unsigned int
     getApiVersion() const noexcept;
 
+    /** Send this subscriber the serialized transactions and ledger headers,
+        as hex, rather than their JSON.
+    */
+    void
+    setBinary(bool binary);
+
+    bool
+    isBinary() const noexcept;
+
 protected:
     std::mutex mLock;
 
@@ -247,6 +267,7 @@ private:
     std::uint64_t mSeq;
     hash_set<AccountID> accountHistorySubscriptions_;
     unsigned int apiVersion_ = 0;
+    std::atomic<bool> binary_{false};
 
     static int
     assign_id()
@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NET_MULTIAPIMESSAGE_H_INCLUDED
+#define RIPPLE_NET_MULTIAPIMESSAGE_H_INCLUDED
+
+#include <ripple/json/MultivarJson.h>
+#include <ripple/json/json_value.h>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ripple {
+
+/** A message published to many subscribers, serialized once per version.
+
+    Publishing the same Json::Value to every subscriber of a stream used
+    to serialize it once for each of them. This wraps the JSON, which may
+    differ between API versions, and serializes each version at most once,
+    the first time a subscriber asks for it. Subscribers then share the
+    text through a reference-counted buffer.
+
+    The message refers to the JSON it is built from rather than copying
+    it, so that JSON must outlive the message and must not change while
+    it is in use. The buffers handed out may outlive both. A message is
+    meant to be built on the stack by the code publishing it, and is not
+    safe to share between threads.
+*/
+class MultiApiMessage
+{
+public:
+    using Buffer = std::shared_ptr<std::string const>;
+
+    /** A message whose JSON depends on the API version. */
+    explicit MultiApiMessage(MultiApiJson const& json);
+
+    /** A message whose JSON is the same for every API version. */
+    explicit MultiApiMessage(Json::Value const& json);
+
+    MultiApiMessage(MultiApiMessage const&) = delete;
+    MultiApiMessage&
+    operator=(MultiApiMessage const&) = delete;
+
+    /** The JSON to send to a subscriber using an API version. */
+    Json::Value const&
+    json(unsigned int apiVersion) const;
+
+    /** The JSON serialized for a subscriber using an API version. */
+    Buffer const&
+    serialized(unsigned int apiVersion) const;
+
+private:
+    std::size_t
+    index(unsigned int apiVersion) const;
+
+    std::array<Json::Value const*, MultiApiJson::size> json_;
+    // Every version shares the first slot when the JSON is the same
+    bool const uniform_;
+    mutable std::array<Buffer, MultiApiJson::size> serialized_;
+};
+
+}  // namespace ripple
+
+#endif
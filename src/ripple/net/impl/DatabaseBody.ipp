@@ -138,10 +138,14 @@ DatabaseBody::reader::put(
 
             if (post)
             {
+                // Hand the batch over rather than copying it
                 body_.strand_->post(
-                    [data = body_.batch_, this] { this->do_put(data); });
+                    [data = std::move(body_.batch_), this] {
+                        this->do_put(data);
+                    });
 
                 body_.batch_.clear();
+                body_.batch_.reserve(FLUSH_SIZE);
             }
         }
 
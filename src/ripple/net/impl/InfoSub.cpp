@@ -71,6 +71,12 @@ InfoSub::getConsumer()
     return m_consumer;
 }
 
+void
+InfoSub::send(MultiApiMessage const& message, bool broadcast)
+{
+    send(message.json(getApiVersion()), broadcast);
+}
+
 std::uint64_t
 InfoSub::getSeq()
 {
@@ -149,4 +155,16 @@ InfoSub::getApiVersion() const noexcept
     return apiVersion_;
 }
 
+void
+InfoSub::setBinary(bool binary)
+{
+    binary_ = binary;
+}
+
+bool
+InfoSub::isBinary() const noexcept
+{
+    return binary_;
+}
+
 }  // namespace ripple
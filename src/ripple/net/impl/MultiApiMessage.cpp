@@ -0,0 +1,64 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/json/json_writer.h>
+#include <ripple/net/MultiApiMessage.h>
+
+namespace ripple {
+
+MultiApiMessage::MultiApiMessage(MultiApiJson const& json) : uniform_(false)
+{
+    for (std::size_t i = 0; i < json_.size(); ++i)
+        json_[i] = &json.val[i];
+}
+
+MultiApiMessage::MultiApiMessage(Json::Value const& json) : uniform_(true)
+{
+    json_.fill(&json);
+}
+
+std::size_t
+MultiApiMessage::index(unsigned int apiVersion) const
+{
+    return uniform_ ? 0 : apiVersionSelector(apiVersion)();
+}
+
+Json::Value const&
+MultiApiMessage::json(unsigned int apiVersion) const
+{
+    return *json_[index(apiVersion)];
+}
+
+MultiApiMessage::Buffer const&
+MultiApiMessage::serialized(unsigned int apiVersion) const
+{
+    auto const i = index(apiVersion);
+    auto& buffer = serialized_[i];
+    if (!buffer)
+    {
+        auto text = std::make_shared<std::string>();
+        Json::stream(*json_[i], [&](void const* data, std::size_t n) {
+            text->append(static_cast<char const*>(data), n);
+        });
+        buffer = std::move(text);
+    }
+    return buffer;
+}
+
+}  // namespace ripple
@@ -418,6 +418,16 @@ private:
         return jvRequest;
     }
 
+    // consensus_timeline [<limit>]
+    Json::Value
+    parseConsensusTimeline(Json::Value const& jvParams)
+    {
+        Json::Value jvRequest(Json::objectValue);
+        if (jvParams.size() == 1)
+            jvRequest[jss::limit] = jvParams[0u].asUInt();
+        return jvRequest;
+    }
+
     // connect <ip[:port]> [port]
     Json::Value
     parseConnect(Json::Value const& jvParams)
@@ -901,6 +911,16 @@ private:
         return jvRequest;
     }
 
+    // perf_trace [start|stop]
+    Json::Value
+    parsePerfTrace(Json::Value const& jvParams)
+    {
+        Json::Value jvRequest(Json::objectValue);
+        if (jvParams.size() == 1)
+            jvRequest[jss::action] = jvParams[0u].asString();
+        return jvRequest;
+    }
+
     // ripple_path_find <json> [<ledger>]
     Json::Value
     parseRipplePathFind(Json::Value const& jvParams)
@@ -1200,6 +1220,7 @@ public:
             {"channel_verify", &RPCParser::parseChannelVerify, 4, 4},
             {"connect", &RPCParser::parseConnect, 1, 2},
             {"consensus_info", &RPCParser::parseAsIs, 0, 0},
+            {"consensus_timeline", &RPCParser::parseConsensusTimeline, 0, 1},
             {"crawl_shards", &RPCParser::parseAsIs, 0, 2},
             {"deposit_authorized", &RPCParser::parseDepositAuthorized, 2, 3},
             {"download_shard", &RPCParser::parseDownloadShard, 2, -1},
@@ -1223,6 +1244,7 @@ public:
             {"node_to_shard", &RPCParser::parseNodeToShard, 1, 1},
             {"owner_info", &RPCParser::parseAccountItems, 1, 3},
             {"peers", &RPCParser::parseAsIs, 0, 0},
+            {"perf_trace", &RPCParser::parsePerfTrace, 0, 1},
             {"ping", &RPCParser::parseAsIs, 0, 0},
             {"print", &RPCParser::parseAsIs, 0, 1},
             //      {   "profile",              &RPCParser::parseProfile, 1,  9
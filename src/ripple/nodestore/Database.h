@@ -21,13 +21,16 @@
 #define RIPPLE_NODESTORE_DATABASE_H_INCLUDED
 
 #include <ripple/basics/TaggedCache.h>
+#include <ripple/basics/hardened_hash.h>
 #include <ripple/nodestore/Backend.h>
 #include <ripple/nodestore/NodeObject.h>
 #include <ripple/nodestore/Scheduler.h>
 #include <ripple/protocol/SystemParameters.h>
 
 #include <condition_variable>
+#include <future>
 #include <thread>
+#include <unordered_map>
 
 namespace ripple {
 
@@ -211,6 +214,13 @@ public:
     void
     getCountsJson(Json::Value& obj);
 
+    /** Returns the number of bytes held by the database's caches. */
+    virtual std::size_t
+    getCacheBytes() const
+    {
+        return 0;
+    }
+
     /** Returns the number of file descriptors the database expects to need */
     int
     fdRequired() const
@@ -240,6 +250,19 @@ public:
         return earliestLedgerSeq_;
     }
 
+    /** @return Whether SHAMap nodes are written in tree order
+
+        When true, the nodes of each flushed subtree are stored parent
+        first, depth first, so that a later traversal of the subtree reads
+        them from neighbouring positions in the backend. Set with
+        'tree_ordered_writes'.
+    */
+    [[nodiscard]] bool
+    treeOrderedWrites() const noexcept
+    {
+        return treeOrderedWrites_;
+    }
+
     /** @return The earliest shard index
      */
     [[nodiscard]] std::uint32_t
@@ -329,6 +352,19 @@ protected:
     // advanced tunable, via the config file. The default value is 4.
     int const requestBundle_;
 
+    // The number of threads that check and store the objects read during an
+    // import. The source is still read by a single thread. This is an
+    // advanced tunable, via the config file. The default value is 1, which
+    // stores each batch on the reading thread.
+    int const importThreads_;
+
+    // Whether an import checks that each object's key is the hash of its
+    // payload, and skips those that are not. Set with 'import_verify'.
+    bool const importVerify_;
+
+    // See treeOrderedWrites()
+    bool const treeOrderedWrites_;
+
     void
     storeStats(std::uint64_t count, std::uint64_t sz)
     {
@@ -345,6 +381,22 @@ protected:
     bool
     storeLedger(Ledger const& srcLedger, std::shared_ptr<Backend> dstBackend);
 
+    /** Read an object, sharing the read with other threads.
+
+        A thread that asks for a key which another thread is already
+        reading waits for that read and gets its result, so that threads
+        which miss the caches on the same object at once cost a single
+        backend read.
+
+        @param hash The key of the object.
+        @param read Reads the object. It runs on the first thread to ask
+                    and should update any cache the caller keeps, so that
+                    later requests find the object there.
+    */
+    template <class Read>
+    std::shared_ptr<NodeObject>
+    fetchShared(uint256 const& hash, Read&& read);
+
     void
     updateFetchMetrics(uint64_t fetches, uint64_t hits, uint64_t duration)
     {
@@ -371,6 +423,15 @@ private:
             std::function<void(std::shared_ptr<NodeObject> const&)>>>>
         read_;
 
+    // Reads in progress on behalf of fetchShared
+    std::mutex sharedFetchMutex_;
+    std::unordered_map<
+        uint256,
+        std::shared_future<std::shared_ptr<NodeObject>>,
+        digest_hash>
+        sharedFetches_;
+    std::atomic<std::uint64_t> fetchSharedCount_{0};
+
     std::atomic<bool> readStopping_ = false;
     std::atomic<int> readThreads_ = 0;
     std::atomic<int> runningThreads_ = 0;
@@ -382,6 +443,19 @@ private:
         FetchReport& fetchReport,
         bool duplicate) = 0;
 
+    /** Fetch a bundle of objects on behalf of the asynchronous read threads.
+
+        The results are returned in the same order as the requests. The
+        default implementation fetches each object in turn. A database whose
+        backend can keep several reads outstanding overrides this to submit
+        the whole bundle at once.
+
+        @param requests Pairs of object hash and ledger sequence.
+    */
+    virtual std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<std::pair<uint256, std::uint32_t>> const& requests);
+
     /** Visit every object in the database
         This is usually called during import.
 
@@ -403,10 +477,58 @@ private:
         return std::nullopt;
     }
 
+    /** Add database specific counters to the get_counts report. */
+    virtual void
+    addCountsJson(Json::Value& obj) const
+    {
+    }
+
     void
     threadEntry();
 };
 
+template <class Read>
+std::shared_ptr<NodeObject>
+Database::fetchShared(uint256 const& hash, Read&& read)
+{
+    std::promise<std::shared_ptr<NodeObject>> promise;
+    {
+        std::unique_lock lock(sharedFetchMutex_);
+        auto const [it, inserted] = sharedFetches_.try_emplace(hash);
+        if (!inserted)
+        {
+            auto const future = it->second;
+            lock.unlock();
+            ++fetchSharedCount_;
+            return future.get();
+        }
+        it->second = promise.get_future().share();
+    }
+
+    // Forget the read before publishing its result: a thread that asks
+    // after that finds the object wherever the read left it
+    auto const finish = [&] {
+        std::lock_guard lock(sharedFetchMutex_);
+        sharedFetches_.erase(hash);
+    };
+
+    std::shared_ptr<NodeObject> nodeObject;
+    try
+    {
+        nodeObject = read();
+    }
+    catch (...)
+    {
+        finish();
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    finish();
+    promise.set_value(nodeObject);
+    return nodeObject;
+}
+
 }  // namespace NodeStore
 }  // namespace ripple
 
@@ -44,7 +44,11 @@ public:
 
     /** Rotates the backends.
 
-        @param f A function executed before the rotation and under the same lock
+        Fetches and stores are not held up while the rotation runs: they
+        keep using the current backends until the new pair is swapped in.
+
+        @param f A function executed before the rotation. No other rotation
+                 can run concurrently, but reads and writes can.
     */
     virtual void
     rotateWithLock(std::function<std::unique_ptr<NodeStore::Backend>(
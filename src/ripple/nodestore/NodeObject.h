@@ -94,6 +94,13 @@ public:
     Blob const&
     getData() const;
 
+    /** Returns the approximate number of bytes the object occupies. */
+    std::size_t
+    memoryUsage() const
+    {
+        return sizeof(NodeObject) + mData.capacity();
+    }
+
 private:
     NodeObjectType const mType;
     uint256 const mHash;
@@ -22,6 +22,7 @@
 
 #include <ripple/nodestore/Task.h>
 #include <chrono>
+#include <cstddef>
 
 namespace ripple {
 namespace NodeStore {
@@ -47,6 +48,15 @@ struct BatchWriteReport
 
     std::chrono::milliseconds elapsed;
     int writeCount;
+
+    /** Payload bytes in the batch. */
+    std::size_t writeBytes = 0;
+
+    /** Objects still queued when the batch completed. */
+    std::size_t queueDepth = 0;
+
+    /** Time callers spent blocked on a full queue since the last report. */
+    std::chrono::microseconds stallTime{0};
 };
 
 /** Scheduling for asynchronous backend activity
@@ -35,6 +35,7 @@
 #include <ripple/protocol/digest.h>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <chrono>
@@ -118,6 +119,17 @@ private:
     uint32_t maxRequestsOutstanding = 10000000;
     std::atomic_uint32_t numRequestsOutstanding_ = 0;
 
+    // When a latency target is configured, the limit on in flight writes
+    // adapts to the cluster: a write slower than the target, or one that
+    // fails, cuts the limit by an eighth, and every write that meets the
+    // target raises it by one, up to maxRequestsOutstanding. A target of
+    // zero keeps the limit fixed at maxRequestsOutstanding.
+    static constexpr std::uint32_t minWriteLimit = 64;
+    static constexpr std::uint32_t initialWriteLimit = 1024;
+    std::chrono::microseconds writeLatencyTarget_{0};
+    std::atomic_uint32_t writeLimit_ = 10000000;
+    std::atomic<std::chrono::steady_clock::rep> lastWriteLimitCut_ = 0;
+
     // mutex and condition_variable to limit the number of concurrent in flight
     // requests
     std::mutex throttleMutex_;
@@ -252,6 +264,14 @@ public:
         unsigned int const ioThreads = get<int>(config_, "io_threads", 4);
         maxRequestsOutstanding =
             get<int>(config_, "max_requests_outstanding", 10000000);
+        writeLatencyTarget_ = std::chrono::milliseconds(
+            get<int>(config_, "write_latency_target_ms", 0));
+        writeLimit_ = writeLatencyTarget_.count() == 0
+            ? maxRequestsOutstanding
+            : std::clamp(
+                  initialWriteLimit,
+                  std::min(minWriteLimit, maxRequestsOutstanding),
+                  maxRequestsOutstanding);
         JLOG(j_.info()) << "Configuring Cassandra driver to use " << ioThreads
                         << " IO threads. Capping maximum pending requests at "
                         << maxRequestsOutstanding;
@@ -578,6 +598,7 @@ public:
         CassandraBackend& backend;
         const void* const key;
         std::shared_ptr<NodeObject>& result;
+        std::mutex& mtx;
         std::condition_variable& cv;
 
         std::atomic_uint32_t& numFinished;
@@ -587,12 +608,14 @@ public:
             CassandraBackend& backend,
             const void* const key,
             std::shared_ptr<NodeObject>& result,
+            std::mutex& mtx,
             std::condition_variable& cv,
             std::atomic_uint32_t& numFinished,
             size_t batchSize)
             : backend(backend)
             , key(key)
             , result(result)
+            , mtx(mtx)
             , cv(cv)
             , numFinished(numFinished)
             , batchSize(batchSize)
@@ -600,6 +623,18 @@ public:
         }
 
         ReadCallbackData(ReadCallbackData const& other) = default;
+
+        // Count this read as done. The count is bumped under the lock the
+        // waiter checks it with, so the waiter can neither miss the
+        // notification nor return, and destroy the lock and the condition
+        // variable, while they are still in use here.
+        void
+        finish()
+        {
+            std::lock_guard lock(mtx);
+            if (++numFinished == batchSize)
+                cv.notify_all();
+        }
     };
 
     std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
@@ -620,6 +655,7 @@ public:
                 *this,
                 static_cast<void const*>(hashes[i]),
                 results[i],
+                mtx,
                 cv,
                 numFinished,
                 numHashes));
@@ -646,9 +682,7 @@ public:
             statement, 0, static_cast<cass_byte_t const*>(data.key), keyBytes_);
         if (rc != CASS_OK)
         {
-            size_t batchSize = data.batchSize;
-            if (++(data.numFinished) == batchSize)
-                data.cv.notify_all();
+            data.finish();
             cass_statement_free(statement);
             JLOG(j_.error()) << "Binding Cassandra fetch query: " << rc << ", "
                              << cass_error_desc(rc);
@@ -705,14 +739,14 @@ public:
             // value of maxRequestsOutstanding is 10 million, which is more
             // records than are present in any single ledger
             std::unique_lock<std::mutex> lck(throttleMutex_);
-            if (!isRetry && numRequestsOutstanding_ > maxRequestsOutstanding)
+            if (!isRetry && numRequestsOutstanding_ > writeLimit_)
             {
                 JLOG(j_.trace()) << __func__ << " : "
                                  << "Max outstanding requests reached. "
                                  << "Waiting for other requests to finish";
                 ++counters_.writesDelayed;
                 throttleCv_.wait(lck, [this]() {
-                    return numRequestsOutstanding_ < maxRequestsOutstanding;
+                    return numRequestsOutstanding_ < writeLimit_;
                 });
             }
         }
@@ -755,6 +789,39 @@ public:
         cass_future_free(fut);
     }
 
+    // Feed the outcome of a write into the limit on in flight writes
+    void
+    adjustWriteLimit(std::chrono::microseconds latency, bool failed)
+    {
+        if (writeLatencyTarget_.count() == 0)
+            return;
+
+        auto limit = writeLimit_.load();
+        if (failed || latency > writeLatencyTarget_)
+        {
+            // Writes issued under the old limit keep completing slowly for
+            // a while after a cut, so cut at most once per target interval
+            auto const now = std::chrono::steady_clock::now();
+            auto last = lastWriteLimitCut_.load();
+            if (now.time_since_epoch().count() - last <
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    writeLatencyTarget_)
+                    .count())
+                return;
+            if (!lastWriteLimitCut_.compare_exchange_strong(
+                    last, now.time_since_epoch().count()))
+                return;
+            writeLimit_ = std::max(
+                std::min(minWriteLimit, maxRequestsOutstanding),
+                limit - limit / 8);
+        }
+        else if (limit < maxRequestsOutstanding)
+        {
+            // Losing a race with another writer is harmless
+            writeLimit_.compare_exchange_weak(limit, limit + 1);
+        }
+    }
+
     void
     store(std::shared_ptr<NodeObject> const& no) override
     {
@@ -849,11 +916,7 @@ readCallback(CassFuture* fut, void* cbData)
     }
     else
     {
-        auto finish = [&requestParams]() {
-            size_t batchSize = requestParams.batchSize;
-            if (++(requestParams.numFinished) == batchSize)
-                requestParams.cv.notify_all();
-        };
+        auto finish = [&requestParams]() { requestParams.finish(); };
         CassResult const* res = cass_future_get_result(fut);
 
         CassRow const* row = cass_result_first_row(res);
@@ -916,6 +979,7 @@ writeCallback(CassFuture* fut, void* cbData)
             << "ERROR!!! Cassandra insert error: " << rc << ", "
             << cass_error_desc(rc) << ", retrying ";
         ++requestParams.totalWriteRetries;
+        backend.adjustWriteLimit({}, true);
         // exponential backoff with a max wait of 2^10 ms (about 1 second)
         auto wait = std::chrono::milliseconds(
             lround(std::pow(2, std::min(10u, requestParams.currentRetries))));
@@ -930,16 +994,26 @@ writeCallback(CassFuture* fut, void* cbData)
     }
     else
     {
-        backend.counters_.writeDurationUs +=
+        auto const latency =
             std::chrono::duration_cast<std::chrono::microseconds>(
-                std::chrono::steady_clock::now() - requestParams.begin)
-                .count();
-        --(backend.numRequestsOutstanding_);
+                std::chrono::steady_clock::now() - requestParams.begin);
+        backend.counters_.writeDurationUs += latency.count();
+        backend.adjustWriteLimit(latency, false);
+        delete &requestParams;
 
-        backend.throttleCv_.notify_all();
-        if (backend.numRequestsOutstanding_ == 0)
+        // Both waiters check the count under their own mutex, so take it
+        // before notifying or the wakeup can land between their check and
+        // their wait and be lost.
+        bool const drained = --(backend.numRequestsOutstanding_) == 0;
+        {
+            std::lock_guard lock(backend.throttleMutex_);
+            backend.throttleCv_.notify_all();
+        }
+        if (drained)
+        {
+            std::lock_guard lock(backend.syncMutex_);
             backend.syncCv_.notify_all();
-        delete &requestParams;
+        }
     }
 }
 
@@ -18,19 +18,27 @@
 //==============================================================================
 
 #include <ripple/basics/contract.h>
+#include <ripple/beast/core/CurrentThreadName.h>
 #include <ripple/nodestore/Factory.h>
 #include <ripple/nodestore/Manager.h>
 #include <ripple/nodestore/impl/DecodedBlob.h>
 #include <ripple/nodestore/impl/EncodedBlob.h>
 #include <ripple/nodestore/impl/codec.h>
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdio>
+#include <deque>
 #include <exception>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <nudb/nudb.hpp>
+#include <thread>
 
 namespace ripple {
 namespace NodeStore {
@@ -44,14 +52,27 @@ public:
     /* "SHRD" in ASCII */
     static constexpr std::uint64_t deterministicType = 0x5348524400000000ull;
 
+    /* Smallest number of keys handed to a single batch reader */
+    static constexpr std::size_t minKeysPerReader = 32;
+
     beast::Journal const j_;
     size_t const keyBytes_;
     std::size_t const burstSize_;
     std::string const name_;
+    std::size_t const batchReaders_;
+    std::unique_ptr<ZstdCodec> const zstd_;
     nudb::store db_;
     std::atomic<bool> deletePath_;
     Scheduler& scheduler_;
 
+    // Threads that read the shares of large batches not taken by the
+    // calling thread. They run while the database is open.
+    std::mutex readMutex_;
+    std::condition_variable readCond_;
+    std::deque<std::function<void()>> readQueue_;
+    bool readStopping_ = false;
+    std::vector<std::thread> readThreads_;
+
     NuDBBackend(
         size_t keyBytes,
         Section const& keyValues,
@@ -62,6 +83,8 @@ public:
         , keyBytes_(keyBytes)
         , burstSize_(burstSize)
         , name_(get(keyValues, "path"))
+        , batchReaders_(parseBatchReaders(keyValues))
+        , zstd_(ZstdCodec::make(keyValues, journal))
         , deletePath_(false)
         , scheduler_(scheduler)
     {
@@ -81,6 +104,8 @@ public:
         , keyBytes_(keyBytes)
         , burstSize_(burstSize)
         , name_(get(keyValues, "path"))
+        , batchReaders_(parseBatchReaders(keyValues))
+        , zstd_(ZstdCodec::make(keyValues, journal))
         , db_(context)
         , deletePath_(false)
         , scheduler_(scheduler)
@@ -161,6 +186,8 @@ public:
             (db_.appnum() & deterministicMask) != deterministicType)
             Throw<std::runtime_error>("nodestore: unknown appnum");
         db_.set_burst(burstSize_);
+
+        startReaders();
     }
 
     bool
@@ -178,6 +205,8 @@ public:
     void
     close() override
     {
+        stopReaders();
+
         if (db_.is_open())
         {
             nudb::error_code ec;
@@ -209,17 +238,9 @@ public:
         nudb::error_code ec;
         db_.fetch(
             key,
-            [key, pno, &status](void const* data, std::size_t size) {
-                nudb::detail::buffer bf;
-                auto const result = nodeobject_decompress(data, size, bf);
-                DecodedBlob decoded(key, result.first, result.second);
-                if (!decoded.wasOk())
-                {
-                    status = dataCorrupt;
-                    return;
-                }
-                *pno = decoded.createObject();
-                status = ok;
+            [this, key, pno, &status](void const* data, std::size_t size) {
+                *pno = decode(key, data, size);
+                status = *pno ? ok : dataCorrupt;
             },
             ec);
         if (ec == nudb::error::key_not_found)
@@ -232,19 +253,112 @@ public:
     std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
     fetchBatch(std::vector<uint256 const*> const& hashes) override
     {
-        std::vector<std::shared_ptr<NodeObject>> results;
-        results.reserve(hashes.size());
-        for (auto const& h : hashes)
+        std::vector<std::shared_ptr<NodeObject>> results(hashes.size());
+
+        // Visit the keys in sorted order. Duplicate keys are then adjacent
+        // and are read from disk only once.
+        std::vector<std::size_t> order(hashes.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+            return *hashes[lhs] < *hashes[rhs];
+        });
+
+        auto fetchRange = [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i != last; ++i)
+            {
+                auto const index = order[i];
+                if (i != first && *hashes[order[i - 1]] == *hashes[index])
+                {
+                    results[index] = results[order[i - 1]];
+                    continue;
+                }
+
+                std::shared_ptr<NodeObject> nObj;
+                if (fetch(hashes[index]->begin(), &nObj) == ok)
+                    results[index] = std::move(nObj);
+            }
+        };
+
+        // A single NuDB fetch blocks on one random read. Split large
+        // batches between the readers so that the device sees more than
+        // one request at a time; the calling thread takes the first share
+        // of the keys.
+        auto const readers = std::min(
+            readThreads_.size() + 1,
+            std::max<std::size_t>(1, hashes.size() / minKeysPerReader));
+
+        if (readers <= 1)
+        {
+            fetchRange(0, hashes.size());
+            return {std::move(results), ok};
+        }
+
+        auto const step = (hashes.size() + readers - 1) / readers;
+        std::vector<std::exception_ptr> errors(readers);
+        std::condition_variable finished;
+        std::size_t pending = readers - 1;
+
+        auto runRange = [&](std::size_t reader) {
+            try
+            {
+                auto const first = reader * step;
+                fetchRange(first, std::min(first + step, hashes.size()));
+            }
+            catch (...)
+            {
+                errors[reader] = std::current_exception();
+            }
+        };
+
+        {
+            std::lock_guard lock(readMutex_);
+            for (std::size_t reader = 1; reader < readers; ++reader)
+            {
+                readQueue_.emplace_back([&, reader]() {
+                    runRange(reader);
+
+                    std::lock_guard done(readMutex_);
+                    if (--pending == 0)
+                        finished.notify_one();
+                });
+            }
+        }
+        readCond_.notify_all();
+
+        runRange(0);
+
         {
-            std::shared_ptr<NodeObject> nObj;
-            Status status = fetch(h->begin(), &nObj);
-            if (status != ok)
-                results.push_back({});
-            else
-                results.push_back(nObj);
+            std::unique_lock lock(readMutex_);
+            finished.wait(lock, [&] { return pending == 0; });
         }
 
-        return {results, ok};
+        for (auto const& e : errors)
+        {
+            if (e)
+                std::rethrow_exception(e);
+        }
+
+        return {std::move(results), ok};
+    }
+
+    // Decompress a stored value directly into the buffer which becomes
+    // the object's data. Returns nullptr if the value is corrupt.
+    std::shared_ptr<NodeObject>
+    decode(void const* key, void const* data, std::size_t size) const
+    {
+        Blob storage;
+        auto const result = nodeobject_decompress(
+            data,
+            size,
+            [&storage](std::size_t n) {
+                storage.resize(n);
+                return storage.data();
+            },
+            zstd_.get());
+        DecodedBlob decoded(key, result.first, result.second);
+        if (!decoded.wasOk())
+            return {};
+        return decoded.createObject(std::move(storage));
     }
 
     void
@@ -253,7 +367,8 @@ public:
         EncodedBlob e(no);
         nudb::error_code ec;
         nudb::detail::buffer bf;
-        auto const result = nodeobject_compress(e.getData(), e.getSize(), bf);
+        auto const result = nodeobject_compress(
+            e.getData(), e.getSize(), bf, zstd_.get());
         db_.insert(e.getKey(), result.first, result.second, ec);
         if (ec && ec != nudb::error::key_exists)
             Throw<nudb::system_error>(ec);
@@ -307,15 +422,13 @@ public:
                 void const* data,
                 std::size_t size,
                 nudb::error_code&) {
-                nudb::detail::buffer bf;
-                auto const result = nodeobject_decompress(data, size, bf);
-                DecodedBlob decoded(key, result.first, result.second);
-                if (!decoded.wasOk())
+                auto object = decode(key, data, size);
+                if (!object)
                 {
                     ec = make_error_code(nudb::error::missing_value);
                     return;
                 }
-                f(decoded.createObject());
+                f(std::move(object));
             },
             nudb::no_progress{},
             ec);
@@ -362,6 +475,65 @@ public:
     {
         return 3;
     }
+
+private:
+    void
+    startReaders()
+    {
+        assert(readThreads_.empty());
+        readStopping_ = false;
+        readThreads_.reserve(batchReaders_ - 1);
+        for (std::size_t i = 1; i < batchReaders_; ++i)
+        {
+            readThreads_.emplace_back([this, i]() {
+                beast::setCurrentThreadName("nudb read #" + std::to_string(i));
+
+                std::unique_lock lock(readMutex_);
+                for (;;)
+                {
+                    readCond_.wait(lock, [this] {
+                        return readStopping_ || !readQueue_.empty();
+                    });
+                    if (readQueue_.empty())
+                        return;
+
+                    auto work = std::move(readQueue_.front());
+                    readQueue_.pop_front();
+
+                    lock.unlock();
+                    work();
+                    lock.lock();
+                }
+            });
+        }
+    }
+
+    void
+    stopReaders()
+    {
+        {
+            std::lock_guard lock(readMutex_);
+            readStopping_ = true;
+        }
+        readCond_.notify_all();
+
+        for (auto& t : readThreads_)
+            t.join();
+        readThreads_.clear();
+    }
+
+    static std::size_t
+    parseBatchReaders(Section const& keyValues)
+    {
+        std::size_t readers = 1;
+        if (get_if_exists(keyValues, "batch_read_threads", readers) &&
+            (readers < 1 || readers > 64))
+        {
+            Throw<std::runtime_error>(
+                "nodestore: batch_read_threads must be between 1 and 64");
+        }
+        return readers;
+    }
 };
 
 //------------------------------------------------------------------------------
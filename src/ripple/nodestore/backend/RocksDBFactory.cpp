@@ -31,9 +31,13 @@
 #include <ripple/nodestore/impl/BatchWriter.h>
 #include <ripple/nodestore/impl/DecodedBlob.h>
 #include <ripple/nodestore/impl/EncodedBlob.h>
+#include <ripple/protocol/HashPrefix.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <memory>
+#include <numeric>
 
 namespace ripple {
 namespace NodeStore {
@@ -87,6 +91,32 @@ class RocksDBBackend : public Backend, public BatchWriter::Callback
 private:
     std::atomic<bool> m_deletePath;
 
+    /** Column families used when `column_families` is enabled.
+
+        Inner nodes and leaves differ in size and in how they are read, so
+        each gets a family with its own block cache and compaction tuning.
+        Objects of unknown type go to the default family.
+    */
+    enum Family : std::size_t {
+        innerFamily,
+        accountFamily,
+        transactionFamily,
+        ledgerFamily,
+        familyCount
+    };
+
+    static constexpr std::array<char const*, familyCount> familyNames{
+        {"inner_node", "account_node", "transaction_node", "ledger"}};
+
+    bool m_useFamilies = false;
+    std::array<rocksdb::ColumnFamilyOptions, familyCount> m_familyOptions;
+
+    // Every family in the database, owned, in the order reads probe them
+    std::vector<rocksdb::ColumnFamilyHandle*> m_handles;
+
+    // Where each kind of object is written, or nullptr for the default
+    std::array<rocksdb::ColumnFamilyHandle*, familyCount> m_targets{};
+
 public:
     beast::Journal m_journal;
     size_t const m_keyBytes;
@@ -105,7 +135,7 @@ public:
         : m_deletePath(false)
         , m_journal(journal)
         , m_keyBytes(keyBytes)
-        , m_batch(*this, scheduler)
+        , m_batch(*this, scheduler, keyValues)
     {
         if (!get_if_exists(keyValues, "path", m_name))
             Throw<std::runtime_error>("Missing path in RocksDBFactory backend");
@@ -211,6 +241,34 @@ public:
                     s.ToString());
         }
 
+        m_useFamilies = get<bool>(keyValues, "column_families", false);
+
+        for (std::size_t i = 0; i < familyCount; ++i)
+        {
+            std::string const prefix = familyNames[i];
+            auto& options = m_familyOptions[i];
+            options = rocksdb::ColumnFamilyOptions(m_options);
+
+            if (keyValues.exists(prefix + "_cache_mb"))
+            {
+                auto familyTable = table_options;
+                familyTable.block_cache = rocksdb::NewLRUCache(
+                    megabytes(get<int>(keyValues, prefix + "_cache_mb")));
+                options.table_factory.reset(
+                    NewBlockBasedTableFactory(familyTable));
+            }
+
+            if (keyValues.exists(prefix + "_options"))
+            {
+                auto const s = rocksdb::GetColumnFamilyOptionsFromString(
+                    options, get(keyValues, prefix + "_options"), &options);
+                if (!s.ok())
+                    Throw<std::runtime_error>(
+                        "Unable to set RocksDB " + prefix +
+                        "_options: " + s.ToString());
+            }
+        }
+
         std::string s1, s2;
         rocksdb::GetStringFromDBOptions(&s1, m_options, "; ");
         rocksdb::GetStringFromColumnFamilyOptions(&s2, m_options, "; ");
@@ -232,14 +290,66 @@ public:
             JLOG(m_journal.error()) << "database is already open";
             return;
         }
-        rocksdb::DB* db = nullptr;
         m_options.create_if_missing = createIfMissing;
-        rocksdb::Status status = rocksdb::DB::Open(m_options, m_name, &db);
+        m_options.create_missing_column_families = true;
+
+        // Every family already in the database must be opened, even if
+        // column families have since been disabled, so that nothing which
+        // was written to them becomes unreachable.
+        std::vector<std::string> existing;
+        rocksdb::DB::ListColumnFamilies(m_options, m_name, &existing);
+
+        std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+        auto const add = [&](std::string const& name) {
+            for (auto const& d : descriptors)
+            {
+                if (d.name == name)
+                    return;
+            }
+            auto const it = std::find(
+                familyNames.begin(), familyNames.end(), name);
+            descriptors.emplace_back(
+                name,
+                it == familyNames.end()
+                    ? rocksdb::ColumnFamilyOptions(m_options)
+                    : m_familyOptions[it - familyNames.begin()]);
+        };
+
+        // Reads probe the most common objects first
+        if (m_useFamilies)
+        {
+            for (auto const name : familyNames)
+                add(name);
+        }
+        for (auto const name : familyNames)
+        {
+            if (std::find(existing.begin(), existing.end(), name) !=
+                existing.end())
+                add(name);
+        }
+        for (auto const& name : existing)
+            add(name);
+        add(rocksdb::kDefaultColumnFamilyName);
+
+        rocksdb::DB* db = nullptr;
+        rocksdb::Status status = rocksdb::DB::Open(
+            rocksdb::DBOptions(m_options),
+            m_name,
+            descriptors,
+            &m_handles,
+            &db);
         if (!status.ok() || !db)
             Throw<std::runtime_error>(
                 std::string("Unable to open/create RocksDB: ") +
                 status.ToString());
         m_db.reset(db);
+
+        m_targets.fill(nullptr);
+        if (m_useFamilies)
+        {
+            for (std::size_t i = 0; i < familyCount; ++i)
+                m_targets[i] = m_handles[i];
+        }
     }
 
     bool
@@ -253,6 +363,10 @@ public:
     {
         if (m_db)
         {
+            for (auto handle : m_handles)
+                m_db->DestroyColumnFamilyHandle(handle);
+            m_handles.clear();
+            m_targets.fill(nullptr);
             m_db.reset();
             if (m_deletePath)
             {
@@ -276,65 +390,79 @@ public:
         assert(m_db);
         pObject->reset();
 
-        Status status(ok);
-
         rocksdb::ReadOptions const options;
         rocksdb::Slice const slice(static_cast<char const*>(key), m_keyBytes);
 
-        std::string string;
-
-        rocksdb::Status getStatus = m_db->Get(options, slice, &string);
+        // Pinning reads the value in place from the block cache
+        rocksdb::PinnableSlice value;
 
-        if (getStatus.ok())
+        for (auto handle : m_handles)
         {
-            DecodedBlob decoded(key, string.data(), string.size());
+            rocksdb::Status getStatus =
+                m_db->Get(options, handle, slice, &value);
 
-            if (decoded.wasOk())
+            if (getStatus.IsNotFound())
             {
-                *pObject = decoded.createObject();
-            }
-            else
-            {
-                // Decoding failed, probably corrupted!
-                //
-                status = dataCorrupt;
+                value.Reset();
+                continue;
             }
-        }
-        else
-        {
-            if (getStatus.IsCorruption())
-            {
-                status = dataCorrupt;
-            }
-            else if (getStatus.IsNotFound())
-            {
-                status = notFound;
-            }
-            else
-            {
-                status =
-                    Status(customCode + unsafe_cast<int>(getStatus.code()));
 
-                JLOG(m_journal.error()) << getStatus.ToString();
-            }
+            return decode(key, getStatus, value, pObject);
         }
 
-        return status;
+        return notFound;
     }
 
     std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
     fetchBatch(std::vector<uint256 const*> const& hashes) override
     {
-        std::vector<std::shared_ptr<NodeObject>> results;
-        results.reserve(hashes.size());
-        for (auto const& h : hashes)
+        assert(m_db);
+        std::vector<std::shared_ptr<NodeObject>> results(hashes.size());
+
+        rocksdb::ReadOptions const options;
+
+        // Indexes of the hashes not yet found
+        std::vector<std::size_t> pending(hashes.size());
+        std::iota(pending.begin(), pending.end(), 0);
+
+        std::vector<rocksdb::Slice> keys;
+        std::vector<std::size_t> missing;
+
+        for (auto handle : m_handles)
         {
-            std::shared_ptr<NodeObject> nObj;
-            Status status = fetch(h->begin(), &nObj);
-            if (status != ok)
-                results.push_back({});
-            else
-                results.push_back(nObj);
+            if (pending.empty())
+                break;
+
+            keys.clear();
+            keys.reserve(pending.size());
+            for (auto const i : pending)
+                keys.emplace_back(
+                    reinterpret_cast<char const*>(hashes[i]->data()),
+                    m_keyBytes);
+
+            std::vector<rocksdb::PinnableSlice> values(keys.size());
+            std::vector<rocksdb::Status> statuses(keys.size());
+            m_db->MultiGet(
+                options,
+                handle,
+                keys.size(),
+                keys.data(),
+                values.data(),
+                statuses.data());
+
+            missing.clear();
+            for (std::size_t j = 0; j < pending.size(); ++j)
+            {
+                if (statuses[j].IsNotFound())
+                    missing.push_back(pending[j]);
+                else
+                    decode(
+                        hashes[pending[j]]->data(),
+                        statuses[j],
+                        values[j],
+                        &results[pending[j]]);
+            }
+            pending.swap(missing);
         }
 
         return {results, ok};
@@ -357,6 +485,7 @@ public:
             EncodedBlob encoded(e);
 
             wb.Put(
+                target(*e),
                 rocksdb::Slice(
                     reinterpret_cast<char const*>(encoded.getKey()),
                     m_keyBytes),
@@ -384,14 +513,25 @@ public:
         assert(m_db);
         rocksdb::ReadOptions const options;
 
-        std::unique_ptr<rocksdb::Iterator> it(m_db->NewIterator(options));
+        for (auto handle : m_handles)
+        {
+            std::unique_ptr<rocksdb::Iterator> it(
+                m_db->NewIterator(options, handle));
+            forEachIn(*it, f);
+        }
+    }
 
-        for (it->SeekToFirst(); it->Valid(); it->Next())
+    void
+    forEachIn(
+        rocksdb::Iterator& it,
+        std::function<void(std::shared_ptr<NodeObject>)> const& f)
+    {
+        for (it.SeekToFirst(); it.Valid(); it.Next())
         {
-            if (it->key().size() == m_keyBytes)
+            if (it.key().size() == m_keyBytes)
             {
                 DecodedBlob decoded(
-                    it->key().data(), it->value().data(), it->value().size());
+                    it.key().data(), it.value().data(), it.value().size());
 
                 if (decoded.wasOk())
                 {
@@ -401,7 +541,7 @@ public:
                 {
                     // Uh oh, corrupted data!
                     JLOG(m_journal.fatal())
-                        << "Corrupt NodeObject #" << it->key().ToString(true);
+                        << "Corrupt NodeObject #" << it.key().ToString(true);
                 }
             }
             else
@@ -409,7 +549,7 @@ public:
                 // VFALCO NOTE What does it mean to find an
                 //             incorrectly sized key? Corruption?
                 JLOG(m_journal.fatal())
-                    << "Bad key size = " << it->key().size();
+                    << "Bad key size = " << it.key().size();
             }
         }
     }
@@ -440,6 +580,76 @@ public:
     {
         return fdRequired_;
     }
+
+private:
+    // Turn the result of a point lookup into a fetch status
+    Status
+    decode(
+        void const* key,
+        rocksdb::Status const& getStatus,
+        rocksdb::Slice const& value,
+        std::shared_ptr<NodeObject>* pObject)
+    {
+        if (getStatus.ok())
+        {
+            DecodedBlob decoded(key, value.data(), value.size());
+
+            if (decoded.wasOk())
+            {
+                *pObject = decoded.createObject();
+                return ok;
+            }
+
+            // Decoding failed, probably corrupted!
+            //
+            return dataCorrupt;
+        }
+
+        if (getStatus.IsCorruption())
+            return dataCorrupt;
+
+        if (getStatus.IsNotFound())
+            return notFound;
+
+        JLOG(m_journal.error()) << getStatus.ToString();
+
+        return Status(customCode + unsafe_cast<int>(getStatus.code()));
+    }
+
+    // The column family an object is written to
+    rocksdb::ColumnFamilyHandle*
+    target(NodeObject const& object) const
+    {
+        rocksdb::ColumnFamilyHandle* handle = nullptr;
+
+        switch (object.getType())
+        {
+            case hotLEDGER:
+                handle = m_targets[ledgerFamily];
+                break;
+            case hotACCOUNT_NODE:
+            case hotTRANSACTION_NODE:
+            {
+                auto const& data = object.getData();
+                // Serialized inner nodes always begin with this prefix
+                if (data.size() >= 4 &&
+                    ((std::uint32_t{data[0]} << 24) |
+                     (std::uint32_t{data[1]} << 16) |
+                     (std::uint32_t{data[2]} << 8) | data[3]) ==
+                        static_cast<std::uint32_t>(HashPrefix::innerNode))
+                    handle = m_targets[innerFamily];
+                else if (object.getType() == hotACCOUNT_NODE)
+                    handle = m_targets[accountFamily];
+                else
+                    handle = m_targets[transactionFamily];
+                break;
+            }
+            default:
+                break;
+        }
+
+        return handle ? handle : m_db->DefaultColumnFamily();
+    }
 };
 
 //------------------------------------------------------------------------------
@@ -18,17 +18,31 @@
 //==============================================================================
 
 #include <ripple/nodestore/impl/BatchWriter.h>
+#include <algorithm>
+#include <cassert>
 
 namespace ripple {
 namespace NodeStore {
 
-BatchWriter::BatchWriter(Callback& callback, Scheduler& scheduler)
+BatchWriter::BatchWriter(
+    Callback& callback,
+    Scheduler& scheduler,
+    Section const& keyValues)
     : m_callback(callback)
     , m_scheduler(scheduler)
+    , mWriteLimit(std::max<std::size_t>(
+          1,
+          get<std::size_t>(
+              keyValues, "batch_write_limit", batchWriteLimitSize)))
+    , mGroupWindow(get<std::uint32_t>(keyValues, "batch_write_window", 0))
+    , mGroupBytes(get<std::size_t>(keyValues, "batch_write_bytes", 16777216))
     , mWriteLoad(0)
     , mWritePending(false)
+    , mWriteBytes(0)
+    , mStallTime(0)
 {
     mWriteSet.reserve(batchWritePreallocationSize);
+    mFlushSet.reserve(batchWritePreallocationSize);
 }
 
 BatchWriter::~BatchWriter()
@@ -42,11 +56,26 @@ BatchWriter::store(std::shared_ptr<NodeObject> const& object)
     std::unique_lock<decltype(mWriteMutex)> sl(mWriteMutex);
 
     // If the batch has reached its limit, we wait
-    // until the batch writer is finished
-    while (mWriteSet.size() >= batchWriteLimitSize)
-        mWriteCondition.wait(sl);
+    // until the batch writer has taken it
+    if (mWriteSet.size() >= mWriteLimit)
+    {
+        auto const start = std::chrono::steady_clock::now();
+
+        // A held batch is full, so there is no reason to keep holding it
+        mGroupCondition.notify_all();
+
+        while (mWriteSet.size() >= mWriteLimit)
+            mWriteCondition.wait(sl);
+
+        mStallTime += std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+    }
+
+    if (mWriteSet.empty())
+        mFirstWrite = std::chrono::steady_clock::now();
 
     mWriteSet.push_back(object);
+    mWriteBytes += object->getData().size();
 
     if (!mWritePending)
     {
@@ -54,6 +83,10 @@ BatchWriter::store(std::shared_ptr<NodeObject> const& object)
 
         m_scheduler.scheduleTask(*this);
     }
+    else if (mWriteBytes >= mGroupBytes)
+    {
+        mGroupCondition.notify_all();
+    }
 }
 
 int
@@ -75,36 +108,58 @@ BatchWriter::writeBatch()
 {
     for (;;)
     {
-        std::vector<std::shared_ptr<NodeObject>> set;
-
-        set.reserve(batchWritePreallocationSize);
+        BatchWriteReport report;
 
         {
-            std::lock_guard sl(mWriteMutex);
+            std::unique_lock<decltype(mWriteMutex)> sl(mWriteMutex);
 
-            mWriteSet.swap(set);
-            assert(mWriteSet.empty());
-            mWriteLoad = set.size();
+            // Group commit: give a small batch a chance to grow
+            if (mGroupWindow.count() > 0 && !mWriteSet.empty())
+            {
+                mGroupCondition.wait_until(
+                    sl, mFirstWrite + mGroupWindow, [this] {
+                        return mWriteBytes >= mGroupBytes ||
+                            mWriteSet.size() >= mWriteLimit;
+                    });
+            }
+
+            assert(mFlushSet.empty());
+            mWriteSet.swap(mFlushSet);
+            mWriteLoad = mFlushSet.size();
 
-            if (set.empty())
+            report.writeCount = mFlushSet.size();
+            report.writeBytes = mWriteBytes;
+            report.stallTime = mStallTime;
+            mWriteBytes = 0;
+            mStallTime = std::chrono::microseconds{0};
+
+            // Anyone waiting for room may continue filling the other buffer
+            mWriteCondition.notify_all();
+
+            if (mFlushSet.empty())
             {
                 mWritePending = false;
-                mWriteCondition.notify_all();
 
                 // VFALCO NOTE Fix this function to not return from the middle
                 return;
             }
         }
 
-        BatchWriteReport report;
-        report.writeCount = set.size();
         auto const before = std::chrono::steady_clock::now();
 
-        m_callback.writeBatch(set);
+        m_callback.writeBatch(mFlushSet);
 
         report.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::steady_clock::now() - before);
 
+        {
+            std::lock_guard sl(mWriteMutex);
+            report.queueDepth = mWriteSet.size();
+        }
+
+        // Keep the capacity for the next swap
+        mFlushSet.clear();
+
         m_scheduler.onBatchWrite(report);
     }
 }
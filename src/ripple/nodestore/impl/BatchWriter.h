@@ -20,9 +20,11 @@
 #ifndef RIPPLE_NODESTORE_BATCHWRITER_H_INCLUDED
 #define RIPPLE_NODESTORE_BATCHWRITER_H_INCLUDED
 
+#include <ripple/basics/BasicConfig.h>
 #include <ripple/nodestore/Scheduler.h>
 #include <ripple/nodestore/Task.h>
 #include <ripple/nodestore/Types.h>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 
@@ -35,6 +37,20 @@ namespace NodeStore {
     class it not required. A backend can implement its own write batching,
     or skip write batching if doing so yields a performance benefit.
 
+    Objects are collected in one buffer while the previous buffer is being
+    written, so callers only wait when the collecting buffer reaches its
+    limit. Optionally the writer holds a batch open for a short window, or
+    until it has collected enough bytes, so that bursts of stores are
+    committed together.
+
+    Configuration keys (all optional):
+
+        batch_write_limit       Objects which may be queued before callers
+                                of store() are made to wait.
+        batch_write_window      Milliseconds a batch is held open to group
+                                further writes with it. 0 disables.
+        batch_write_bytes       Bytes which close a held batch early.
+
     @see Scheduler
 */
 class BatchWriter : private Task
@@ -53,8 +69,14 @@ public:
         writeBatch(Batch const& batch) = 0;
     };
 
-    /** Create a batch writer. */
-    BatchWriter(Callback& callback, Scheduler& scheduler);
+    /** Create a batch writer.
+
+        @param keyValues The backend configuration, see above.
+    */
+    BatchWriter(
+        Callback& callback,
+        Scheduler& scheduler,
+        Section const& keyValues = Section{});
 
     /** Destroy a batch writer.
 
@@ -88,11 +110,21 @@ private:
 
     Callback& m_callback;
     Scheduler& m_scheduler;
+    std::size_t const mWriteLimit;
+    std::chrono::milliseconds const mGroupWindow;
+    std::size_t const mGroupBytes;
     LockType mWriteMutex;
     CondvarType mWriteCondition;
+    CondvarType mGroupCondition;
     int mWriteLoad;
     bool mWritePending;
     Batch mWriteSet;
+    std::size_t mWriteBytes;
+    std::chrono::steady_clock::time_point mFirstWrite;
+    std::chrono::microseconds mStallTime;
+
+    // Only touched by the writing task
+    Batch mFlushSet;
 };
 
 }  // namespace NodeStore
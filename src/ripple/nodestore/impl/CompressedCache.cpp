@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/CompressionAlgorithms.h>
+#include <ripple/nodestore/impl/CompressedCache.h>
+#include <ripple/protocol/jss.h>
+#include <cassert>
+
+namespace ripple {
+namespace NodeStore {
+
+CompressedCache::CompressedCache(std::size_t budget)
+    : partitionBudget_(budget / partitions)
+{
+}
+
+void
+CompressedCache::insert(NodeObject const& object)
+{
+    auto const& data = object.getData();
+    if (data.empty() || object.getType() == hotDUMMY)
+        return;
+
+    auto const& hash = object.getHash();
+    auto& p = partition(hash);
+
+    // An object never changes for its hash, so a cached copy is only
+    // refreshed rather than compressed again
+    {
+        std::lock_guard lock(p.mutex);
+        if (auto it = p.map.find(hash); it != p.map.end())
+        {
+            p.lru.splice(p.lru.begin(), p.lru, it->second.lru);
+            return;
+        }
+    }
+
+    // Compress outside the lock and keep only the bytes actually used
+    Buffer scratch;
+    auto const compressedSize = compression_algorithms::lz4Compress(
+        data.data(), data.size(), scratch);
+
+    Entry entry{
+        object.getType(),
+        static_cast<std::uint32_t>(data.size()),
+        Buffer(scratch.data(), compressedSize),
+        {}};
+    auto const bytes = footprint(entry);
+    if (bytes > partitionBudget_)
+        return;
+
+    std::lock_guard lock(p.mutex);
+
+    // Another thread cached it meanwhile
+    if (p.map.count(hash))
+        return;
+
+    while (p.bytes + bytes > partitionBudget_ && !p.lru.empty())
+    {
+        auto it = p.map.find(p.lru.back());
+        assert(it != p.map.end());
+        p.bytes -= footprint(it->second);
+        p.map.erase(it);
+        p.lru.pop_back();
+        ++evictions_;
+    }
+
+    p.lru.push_front(hash);
+    entry.lru = p.lru.begin();
+    p.map.emplace(hash, std::move(entry));
+    p.bytes += bytes;
+}
+
+std::shared_ptr<NodeObject>
+CompressedCache::fetch(uint256 const& hash)
+{
+    NodeObjectType type;
+    Blob data;
+    {
+        auto& p = partition(hash);
+        std::lock_guard lock(p.mutex);
+
+        auto it = p.map.find(hash);
+        if (it == p.map.end())
+        {
+            ++misses_;
+            return nullptr;
+        }
+
+        auto& entry = it->second;
+        p.lru.splice(p.lru.begin(), p.lru, entry.lru);
+
+        // Decompressing under the partition lock keeps the entry alive
+        // without copying the compressed bytes out first.
+        type = entry.type;
+        data.resize(entry.size);
+        compression_algorithms::lz4Decompress(
+            entry.compressed.data(),
+            entry.compressed.size(),
+            data.data(),
+            data.size());
+    }
+
+    ++hits_;
+    return NodeObject::createObject(type, std::move(data), hash);
+}
+
+std::size_t
+CompressedCache::bytes() const
+{
+    std::size_t bytes = 0;
+    for (auto& p : partitions_)
+    {
+        std::lock_guard lock(p.mutex);
+        bytes += p.bytes;
+    }
+    return bytes;
+}
+
+void
+CompressedCache::getCountsJson(Json::Value& obj) const
+{
+    std::size_t bytes = 0;
+    std::size_t size = 0;
+    for (auto& p : partitions_)
+    {
+        std::lock_guard lock(p.mutex);
+        bytes += p.bytes;
+        size += p.map.size();
+    }
+
+    obj[jss::compressed_cache_size] = std::to_string(size);
+    obj[jss::compressed_cache_bytes] = std::to_string(bytes);
+    obj[jss::compressed_cache_hits] = std::to_string(hits_);
+    obj[jss::compressed_cache_misses] = std::to_string(misses_);
+    obj[jss::compressed_cache_evictions] = std::to_string(evictions_);
+}
+
+}  // namespace NodeStore
+}  // namespace ripple
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_COMPRESSEDCACHE_H_INCLUDED
+#define RIPPLE_NODESTORE_COMPRESSEDCACHE_H_INCLUDED
+
+#include <ripple/basics/Buffer.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/json/json_value.h>
+#include <ripple/nodestore/NodeObject.h>
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+
+namespace ripple {
+namespace NodeStore {
+
+/** A byte-budgeted cache of LZ4 compressed node objects.
+
+    This sits behind the uncompressed TaggedCache of a database. Objects
+    swept from that cache are kept here in compressed form, so that one
+    which has aged out of it can be recovered with a decompression rather
+    than a disk read.
+
+    The cache is split into partitions, each with its own lock and an
+    equal share of the byte budget. Within a partition the least recently
+    used objects are evicted first.
+*/
+class CompressedCache
+{
+public:
+    /** Create a cache.
+
+        @param budget The approximate number of bytes the cache may hold.
+    */
+    explicit CompressedCache(std::size_t budget);
+
+    CompressedCache(CompressedCache const&) = delete;
+    CompressedCache&
+    operator=(CompressedCache const&) = delete;
+
+    /** Add an object to the cache, or refresh the copy it has. */
+    void
+    insert(NodeObject const& object);
+
+    /** Retrieve an object from the cache.
+
+        @return The decompressed object, or nullptr if it is not cached.
+    */
+    std::shared_ptr<NodeObject>
+    fetch(uint256 const& hash);
+
+    /** The approximate number of bytes held. */
+    std::size_t
+    bytes() const;
+
+    /** Report usage, hit and miss counters. */
+    void
+    getCountsJson(Json::Value& obj) const;
+
+private:
+    static constexpr std::size_t partitions = 16;
+
+    struct Entry
+    {
+        NodeObjectType type;
+        std::uint32_t size;
+        Buffer compressed;
+        std::list<uint256>::iterator lru;
+    };
+
+    struct Partition
+    {
+        mutable std::mutex mutex;
+        hash_map<uint256, Entry> map;
+        // Most recently used at the front
+        std::list<uint256> lru;
+        std::size_t bytes = 0;
+    };
+
+    std::size_t const partitionBudget_;
+    std::array<Partition, partitions> partitions_;
+
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+    std::atomic<std::uint64_t> evictions_{0};
+
+    Partition&
+    partition(uint256 const& hash)
+    {
+        return partitions_[*hash.data() % partitions];
+    }
+
+    // Approximate memory charged against the budget for one entry
+    static std::size_t
+    footprint(Entry const& entry)
+    {
+        return entry.compressed.size() + sizeof(Entry) + sizeof(uint256) +
+            4 * sizeof(void*);
+    }
+};
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
@@ -18,13 +18,18 @@
 //==============================================================================
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/basics/PerfCost.h>
+#include <ripple/basics/PerfTrace.h>
+#include <ripple/basics/ThreadAffinity.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/core/CurrentThreadName.h>
 #include <ripple/json/json_value.h>
 #include <ripple/nodestore/Database.h>
 #include <ripple/protocol/HashPrefix.h>
+#include <ripple/protocol/digest.h>
 #include <ripple/protocol/jss.h>
 #include <chrono>
+#include <deque>
 
 namespace ripple {
 namespace NodeStore {
@@ -44,6 +49,9 @@ Database::Database(
           get<std::uint32_t>(config, "earliest_seq", XRP_LEDGER_EARLIEST_SEQ))
     , earliestShardIndex_((earliestLedgerSeq_ - 1) / ledgersPerShard_)
     , requestBundle_(get<int>(config, "rq_bundle", 4))
+    , importThreads_(get<int>(config, "import_threads", 1))
+    , importVerify_(get<bool>(config, "import_verify", false))
+    , treeOrderedWrites_(get<bool>(config, "tree_ordered_writes", false))
     , readThreads_(std::max(1, readThreads))
 {
     assert(readThreads != 0);
@@ -57,14 +65,22 @@ Database::Database(
     if (requestBundle_ < 1 || requestBundle_ > 64)
         Throw<std::runtime_error>("Invalid rq_bundle");
 
+    if (importThreads_ < 1 || importThreads_ > 64)
+        Throw<std::runtime_error>("Invalid import_threads");
+
+    std::vector<unsigned> readCpus;
+    if (auto const cpus = config.get("read_cpus"))
+        readCpus = parseCpuSet(*cpus);
+
     for (int i = readThreads_.load(); i != 0; --i)
     {
         std::thread t(
-            [this](int i) {
+            [this, readCpus](int i) {
                 runningThreads_++;
 
                 beast::setCurrentThreadName(
                     "db prefetch #" + std::to_string(i));
+                setCurrentThreadAffinity(readCpus, j_);
 
                 decltype(read_) read;
 
@@ -94,16 +110,34 @@ Database::Database(
                             read.insert(read_.extract(read_.begin()));
                     }
 
-                    for (auto it = read.begin(); it != read.end(); ++it)
+                    // Submit the whole bundle at once so that databases
+                    // whose backend can keep several reads outstanding do
+                    // not wait on them one after another.
+                    std::vector<std::pair<uint256, std::uint32_t>> requests;
+                    requests.reserve(read.size());
+                    for (auto const& [hash, data] : read)
                     {
-                        assert(!it->second.empty());
+                        assert(!data.empty());
+                        requests.emplace_back(hash, data[0].first);
+                    }
 
+                    auto const objs = [&] {
+                        perf::trace::Scope trace(
+                            "nodestore",
+                            "fetch_batch",
+                            "count",
+                            requests.size());
+                        return fetchNodeObjects(requests);
+                    }();
+                    assert(objs.size() == requests.size());
+
+                    std::size_t i = 0;
+                    for (auto it = read.begin(); it != read.end(); ++it, ++i)
+                    {
                         auto const& hash = it->first;
                         auto const& data = it->second;
                         auto const seqn = data[0].first;
-
-                        auto obj =
-                            fetchNodeObject(hash, seqn, FetchType::async);
+                        auto const& obj = objs[i];
 
                         // This could be further optimized: if there are
                         // multiple requests for sequence numbers mapping to
@@ -212,9 +246,24 @@ Database::asyncFetch(
 void
 Database::importInternal(Backend& dstBackend, Database& srcDB)
 {
-    Batch batch;
-    batch.reserve(batchWritePreallocationSize);
-    auto storeBatch = [&, fname = __func__]() {
+    std::atomic<std::uint64_t> imported{0};
+    std::atomic<std::uint64_t> rejected{0};
+
+    auto storeBatch = [&, fname = __func__](Batch& batch) {
+        // An object whose key is not the hash of its payload was corrupted
+        // in the source, and copying it would only spread the damage.
+        if (importVerify_)
+        {
+            std::erase_if(batch, [&](std::shared_ptr<NodeObject> const& obj) {
+                if (obj->getHash() == sha512Half(makeSlice(obj->getData())))
+                    return false;
+                JLOG(j_.error()) << "Import skipped corrupt node object "
+                                 << obj->getHash();
+                ++rejected;
+                return true;
+            });
+        }
+
         try
         {
             dstBackend.storeBatch(batch);
@@ -230,21 +279,119 @@ Database::importInternal(Backend& dstBackend, Database& srcDB)
         for (auto const& nodeObject : batch)
             sz += nodeObject->getData().size();
         storeStats(batch.size(), sz);
-        batch.clear();
+        imported += batch.size();
     };
 
-    srcDB.for_each([&](std::shared_ptr<NodeObject> nodeObject) {
-        assert(nodeObject);
-        if (!nodeObject)  // This should never happen
-            return;
+    // Batches read from the source that wait for a thread to store them.
+    // The reader stops when enough are waiting, so that memory use is
+    // bounded by the slower of the two sides.
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Batch> pending;
+    std::size_t const maxPending = 2 * importThreads_;
+    bool reading = true;
+
+    std::vector<std::thread> threads;
+    if (importThreads_ > 1)
+    {
+        threads.reserve(importThreads_);
+        for (int i = 0; i != importThreads_; ++i)
+        {
+            threads.emplace_back([&, i] {
+                beast::setCurrentThreadName("db import #" + std::to_string(i));
+
+                while (true)
+                {
+                    Batch batch;
+                    {
+                        std::unique_lock lock(mutex);
+                        cv.wait(lock, [&] {
+                            return !pending.empty() || !reading;
+                        });
+                        if (pending.empty())
+                            return;
+                        batch = std::move(pending.front());
+                        pending.pop_front();
+                    }
+                    cv.notify_all();
+                    storeBatch(batch);
+                }
+            });
+        }
+    }
+
+    using namespace std::chrono;
+    auto const start = steady_clock::now();
+    auto lastReport = start;
+    std::uint64_t read{0};
 
-        batch.emplace_back(std::move(nodeObject));
-        if (batch.size() >= batchWritePreallocationSize)
-            storeBatch();
-    });
+    Batch batch;
+    batch.reserve(batchWritePreallocationSize);
+    auto flush = [&] {
+        if (threads.empty())
+        {
+            storeBatch(batch);
+            batch.clear();
+        }
+        else
+        {
+            std::unique_lock lock(mutex);
+            cv.wait(lock, [&] { return pending.size() < maxPending; });
+            pending.push_back(std::move(batch));
+            lock.unlock();
+            cv.notify_all();
+
+            batch = {};
+            batch.reserve(batchWritePreallocationSize);
+        }
+
+        if (auto const now = steady_clock::now(); now - lastReport >= 30s)
+        {
+            lastReport = now;
+            std::uint64_t const secs = std::max<std::uint64_t>(
+                duration_cast<seconds>(now - start).count(), 1);
+            JLOG(j_.warn()) << "Import read " << read << " and stored "
+                            << imported << " node objects in " << secs
+                            << " seconds (" << read / secs << " per second)";
+        }
+    };
 
-    if (!batch.empty())
-        storeBatch();
+    auto finish = [&] {
+        {
+            std::lock_guard lock(mutex);
+            reading = false;
+        }
+        cv.notify_all();
+        for (auto& t : threads)
+            t.join();
+    };
+
+    try
+    {
+        srcDB.for_each([&](std::shared_ptr<NodeObject> nodeObject) {
+            assert(nodeObject);
+            if (!nodeObject)  // This should never happen
+                return;
+
+            ++read;
+            batch.emplace_back(std::move(nodeObject));
+            if (batch.size() >= batchWritePreallocationSize)
+                flush();
+        });
+
+        if (!batch.empty())
+            flush();
+    }
+    catch (...)
+    {
+        finish();
+        throw;
+    }
+    finish();
+
+    JLOG(j_.warn()) << "Import stored " << imported << " of " << read
+                    << " node objects, skipping " << rejected
+                    << " that were corrupt";
 }
 
 // Perform a fetch and report the time it took
@@ -256,13 +403,17 @@ Database::fetchNodeObject(
     bool duplicate)
 {
     FetchReport fetchReport(fetchType);
+    perf::trace::Scope trace("nodestore", "fetch");
 
     using namespace std::chrono;
     auto const begin{steady_clock::now()};
+    auto const cpuBegin = perf::threadCpuTime();
 
     auto nodeObject{fetchNodeObject(hash, ledgerSeq, fetchReport, duplicate)};
     auto dur = steady_clock::now() - begin;
     fetchDurationUs_ += duration_cast<microseconds>(dur).count();
+    perf::onFetch(
+        duration_cast<microseconds>(dur), perf::threadCpuTime() - cpuBegin);
     if (nodeObject)
     {
         ++fetchHitCount_;
@@ -275,6 +426,17 @@ Database::fetchNodeObject(
     return nodeObject;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+Database::fetchNodeObjects(
+    std::vector<std::pair<uint256, std::uint32_t>> const& requests)
+{
+    std::vector<std::shared_ptr<NodeObject>> results;
+    results.reserve(requests.size());
+    for (auto const& [hash, ledgerSeq] : requests)
+        results.push_back(fetchNodeObject(hash, ledgerSeq, FetchType::async));
+    return results;
+}
+
 bool
 Database::storeLedger(
     Ledger const& srcLedger,
@@ -391,6 +553,7 @@ Database::getCountsJson(Json::Value& obj)
     obj[jss::node_writes] = std::to_string(storeCount_);
     obj[jss::node_reads_total] = std::to_string(fetchTotalCount_);
     obj[jss::node_reads_hit] = std::to_string(fetchHitCount_);
+    obj[jss::node_reads_shared] = std::to_string(fetchSharedCount_);
     obj[jss::node_written_bytes] = std::to_string(storeSz_);
     obj[jss::node_read_bytes] = std::to_string(fetchSz_);
     obj[jss::node_reads_duration_us] = std::to_string(fetchDurationUs_);
@@ -403,6 +566,8 @@ Database::getCountsJson(Json::Value& obj)
         obj[jss::node_writes_delayed] = std::to_string(c->writesDelayed);
         obj[jss::node_writes_duration_us] = std::to_string(c->writeDurationUs);
     }
+
+    addCountsJson(obj);
 }
 
 }  // namespace NodeStore
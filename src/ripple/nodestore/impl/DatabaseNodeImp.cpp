@@ -35,6 +35,7 @@ DatabaseNodeImp::store(
 
     auto obj = NodeObject::createObject(type, std::move(data), hash);
     backend_->store(obj);
+    cacheCompressed(*obj);
     if (cache_)
     {
         // After the store, replace a negative cache entry if there is one
@@ -51,18 +52,30 @@ DatabaseNodeImp::asyncFetch(
     std::uint32_t ledgerSeq,
     std::function<void(std::shared_ptr<NodeObject> const&)>&& callback)
 {
-    if (cache_)
+    if (auto obj = fetchFromCache(hash))
     {
-        std::shared_ptr<NodeObject> obj = cache_->fetch(hash);
-        if (obj)
-        {
-            callback(obj->getType() == hotDUMMY ? nullptr : obj);
-            return;
-        }
+        callback(obj->getType() == hotDUMMY ? nullptr : obj);
+        return;
     }
     Database::asyncFetch(hash, ledgerSeq, std::move(callback));
 }
 
+std::shared_ptr<NodeObject>
+DatabaseNodeImp::fetchFromCache(uint256 const& hash)
+{
+    std::shared_ptr<NodeObject> nodeObject =
+        cache_ ? cache_->fetch(hash) : nullptr;
+
+    if (!nodeObject && compressedCache_)
+    {
+        nodeObject = compressedCache_->fetch(hash);
+        if (nodeObject && cache_)
+            cache_->canonicalize_replace_client(hash, nodeObject);
+    }
+
+    return nodeObject;
+}
+
 void
 DatabaseNodeImp::sweep()
 {
@@ -77,57 +90,64 @@ DatabaseNodeImp::fetchNodeObject(
     FetchReport& fetchReport,
     bool duplicate)
 {
-    std::shared_ptr<NodeObject> nodeObject =
-        cache_ ? cache_->fetch(hash) : nullptr;
+    std::shared_ptr<NodeObject> nodeObject = fetchFromCache(hash);
 
     if (!nodeObject)
     {
         JLOG(j_.trace()) << "fetchNodeObject " << hash << ": record not "
-                         << (cache_ ? "cached" : "found");
+                         << (cache_ || compressedCache_ ? "cached" : "found");
 
-        Status status;
+        nodeObject = fetchShared(hash, [&] {
+            std::shared_ptr<NodeObject> object;
+            Status status;
 
-        try
-        {
-            status = backend_->fetch(hash.data(), &nodeObject);
-        }
-        catch (std::exception const& e)
-        {
-            JLOG(j_.fatal())
-                << "fetchNodeObject " << hash
-                << ": Exception fetching from backend: " << e.what();
-            Rethrow();
-        }
+            try
+            {
+                status = backend_->fetch(hash.data(), &object);
+            }
+            catch (std::exception const& e)
+            {
+                JLOG(j_.fatal())
+                    << "fetchNodeObject " << hash
+                    << ": Exception fetching from backend: " << e.what();
+                Rethrow();
+            }
 
-        switch (status)
-        {
-            case ok:
-                if (cache_)
-                {
-                    if (nodeObject)
-                        cache_->canonicalize_replace_client(hash, nodeObject);
-                    else
+            switch (status)
+            {
+                case ok:
+                    if (object)
+                        cacheCompressed(*object);
+                    if (cache_)
                     {
-                        auto notFound =
-                            NodeObject::createObject(hotDUMMY, {}, hash);
-                        cache_->canonicalize_replace_client(hash, notFound);
-                        if (notFound->getType() != hotDUMMY)
-                            nodeObject = notFound;
+                        if (object)
+                            cache_->canonicalize_replace_client(hash, object);
+                        else
+                        {
+                            auto notFound =
+                                NodeObject::createObject(hotDUMMY, {}, hash);
+                            cache_->canonicalize_replace_client(
+                                hash, notFound);
+                            if (notFound->getType() != hotDUMMY)
+                                object = notFound;
+                        }
                     }
-                }
-                break;
-            case notFound:
-                break;
-            case dataCorrupt:
-                JLOG(j_.fatal()) << "fetchNodeObject " << hash
-                                 << ": nodestore data is corrupted";
-                break;
-            default:
-                JLOG(j_.warn())
-                    << "fetchNodeObject " << hash
-                    << ": backend returns unknown result " << status;
-                break;
-        }
+                    break;
+                case notFound:
+                    break;
+                case dataCorrupt:
+                    JLOG(j_.fatal()) << "fetchNodeObject " << hash
+                                     << ": nodestore data is corrupted";
+                    break;
+                default:
+                    JLOG(j_.warn())
+                        << "fetchNodeObject " << hash
+                        << ": backend returns unknown result " << status;
+                    break;
+            }
+
+            return object;
+        });
     }
     else
     {
@@ -157,7 +177,7 @@ DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
     {
         auto const& hash = hashes[i];
         // See if the object already exists in the cache
-        auto nObj = cache_ ? cache_->fetch(hash) : nullptr;
+        auto nObj = fetchFromCache(hash);
         ++fetches;
         if (!nObj)
         {
@@ -186,6 +206,7 @@ DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
 
         if (nObj)
         {
+            cacheCompressed(*nObj);
             // Ensure all threads get the same object
             if (cache_)
                 cache_->canonicalize_replace_client(hash, nObj);
@@ -214,5 +235,90 @@ DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
     return results;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseNodeImp::fetchNodeObjects(
+    std::vector<std::pair<uint256, std::uint32_t>> const& requests)
+{
+    using namespace std::chrono;
+    auto const before = steady_clock::now();
+
+    std::vector<std::shared_ptr<NodeObject>> results{requests.size()};
+    std::vector<uint256 const*> cacheMisses;
+    std::vector<std::size_t> missIndex;
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        auto const& hash = requests[i].first;
+        auto nObj = fetchFromCache(hash);
+        if (!nObj)
+        {
+            cacheMisses.push_back(&hash);
+            missIndex.push_back(i);
+        }
+        else if (nObj->getType() != hotDUMMY)
+            results[i] = std::move(nObj);
+    }
+
+    if (!cacheMisses.empty())
+    {
+        std::vector<std::shared_ptr<NodeObject>> dbResults;
+        try
+        {
+            dbResults = backend_->fetchBatch(cacheMisses).first;
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.fatal()) << "fetchNodeObjects: Exception fetching "
+                             << cacheMisses.size()
+                             << " objects from backend: " << e.what();
+            Rethrow();
+        }
+
+        for (std::size_t i = 0; i < dbResults.size(); ++i)
+        {
+            auto nObj = std::move(dbResults[i]);
+            auto const& hash = *cacheMisses[i];
+            if (nObj)
+                cacheCompressed(*nObj);
+            if (cache_)
+            {
+                if (nObj)
+                    cache_->canonicalize_replace_client(hash, nObj);
+                else
+                {
+                    auto notFound =
+                        NodeObject::createObject(hotDUMMY, {}, hash);
+                    cache_->canonicalize_replace_client(hash, notFound);
+                    if (notFound->getType() != hotDUMMY)
+                        nObj = std::move(notFound);
+                }
+            }
+            results[missIndex[i]] = std::move(nObj);
+        }
+    }
+
+    std::uint64_t found = 0;
+    for (auto const& nObj : results)
+    {
+        if (nObj)
+        {
+            ++found;
+            fetchSz_ += nObj->getData().size();
+        }
+    }
+
+    auto const elapsed = steady_clock::now() - before;
+    updateFetchMetrics(
+        results.size(),
+        found,
+        duration_cast<microseconds>(elapsed).count());
+
+    FetchReport fetchReport(FetchType::async);
+    fetchReport.elapsed = duration_cast<milliseconds>(elapsed);
+    fetchReport.wasFound = found != 0;
+    scheduler_.onFetch(fetchReport);
+
+    return results;
+}
+
 }  // namespace NodeStore
 }  // namespace ripple
@@ -20,9 +20,11 @@
 #ifndef RIPPLE_NODESTORE_DATABASENODEIMP_H_INCLUDED
 #define RIPPLE_NODESTORE_DATABASENODEIMP_H_INCLUDED
 
+#include <ripple/basics/ByteUtilities.h>
 #include <ripple/basics/TaggedCache.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/nodestore/Database.h>
+#include <ripple/nodestore/impl/CompressedCache.h>
 
 namespace ripple {
 namespace NodeStore {
@@ -76,6 +78,22 @@ public:
                 j);
         }
 
+        if (auto const mb = get<std::size_t>(config, "compressed_cache_mb", 0))
+        {
+            compressedCache_ = std::make_unique<CompressedCache>(megabytes(mb));
+
+            // Objects are compressed as they are demoted from the
+            // uncompressed cache, rather than as each one is used
+            if (cache_)
+            {
+                cache_->setSweepHandler(
+                    [compressed = compressedCache_.get()](
+                        std::shared_ptr<NodeObject> const& object) {
+                        compressed->insert(*object);
+                    });
+            }
+        }
+
         assert(backend_);
     }
 
@@ -141,9 +159,27 @@ private:
     // Cache for database objects. This cache is not always initialized. Check
     // for null before using.
     std::shared_ptr<TaggedCache<uint256, NodeObject>> cache_;
+    // Compressed copies of recently used objects, consulted on a miss in
+    // cache_ before going to the backend. This cache is optional. Check
+    // for null before using.
+    std::unique_ptr<CompressedCache> compressedCache_;
     // Persistent key/value storage
     std::shared_ptr<Backend> backend_;
 
+    // Cache an object that was stored or read in compressed form. With an
+    // uncompressed cache this waits until the object is swept from it.
+    void
+    cacheCompressed(NodeObject const& object)
+    {
+        if (compressedCache_ && !cache_)
+            compressedCache_->insert(object);
+    }
+
+    // Look up an object in the uncompressed, then the compressed cache.
+    // The result may be a negative (hotDUMMY) entry.
+    std::shared_ptr<NodeObject>
+    fetchFromCache(uint256 const& hash);
+
     std::shared_ptr<NodeObject>
     fetchNodeObject(
         uint256 const& hash,
@@ -151,6 +187,10 @@ private:
         FetchReport& fetchReport,
         bool duplicate) override;
 
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(std::vector<std::pair<uint256, std::uint32_t>> const&
+                         requests) override;
+
     void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override
     {
@@ -162,6 +202,24 @@ private:
     {
         return backend_->counters();
     }
+
+    std::size_t
+    getCacheBytes() const override
+    {
+        std::size_t bytes = 0;
+        if (cache_)
+            bytes += cache_->getCacheBytes();
+        if (compressedCache_)
+            bytes += compressedCache_->bytes();
+        return bytes;
+    }
+
+    void
+    addCountsJson(Json::Value& obj) const override
+    {
+        if (compressedCache_)
+            compressedCache_->getCountsJson(obj);
+    }
 };
 
 }  // namespace NodeStore
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/basics/ByteUtilities.h>
 #include <ripple/nodestore/impl/DatabaseRotatingImp.h>
 #include <ripple/protocol/HashPrefix.h>
 
@@ -32,13 +33,35 @@ DatabaseRotatingImp::DatabaseRotatingImp(
     Section const& config,
     beast::Journal j)
     : DatabaseRotating(scheduler, readThreads, config, j)
-    , writableBackend_(std::move(writableBackend))
-    , archiveBackend_(std::move(archiveBackend))
+    , filterBytes_(megabytes(
+          get<std::size_t>(config, "existence_filter_mb", 0)))
 {
-    if (writableBackend_)
-        fdRequired_ += writableBackend_->fdRequired();
-    if (archiveBackend_)
-        fdRequired_ += archiveBackend_->fdRequired();
+    if (writableBackend)
+        fdRequired_ += writableBackend->fdRequired();
+    if (archiveBackend)
+        fdRequired_ += archiveBackend->fdRequired();
+
+    backends_ = std::make_shared<Backends const>(Backends{
+        std::move(writableBackend), std::move(archiveBackend), {}, {}});
+}
+
+auto
+DatabaseRotatingImp::backends() const -> std::shared_ptr<Backends const>
+{
+    std::lock_guard lock(mutex_);
+    return backends_;
+}
+
+void
+DatabaseRotatingImp::dropWritableFilter()
+{
+    std::lock_guard lock(mutex_);
+    if (backends_->writableFilter)
+    {
+        auto next = *backends_;
+        next.writableFilter.reset();
+        backends_ = std::make_shared<Backends const>(std::move(next));
+    }
 }
 
 void
@@ -46,55 +69,66 @@ DatabaseRotatingImp::rotateWithLock(
     std::function<std::unique_ptr<NodeStore::Backend>(
         std::string const& writableBackendName)> const& f)
 {
-    std::lock_guard lock(mutex_);
+    std::lock_guard rotateLock(rotateMutex_);
+
+    // Fetches and stores carry on against the current backends while the
+    // callback runs; only another rotation could change the writable one
+    std::shared_ptr<Backend> newBackend = f(backends()->writable->getName());
+
+    // The new backend starts out empty, so a fresh filter describes it
+    // exactly for as long as it sees every write.
+    std::shared_ptr<ExistenceFilter> newFilter;
+    if (filterBytes_ != 0)
+        newFilter = std::make_shared<ExistenceFilter>(filterBytes_);
+
+    std::shared_ptr<Backend> retired;
+    {
+        std::lock_guard lock(mutex_);
+        auto const& current = *backends_;
+        retired = current.archive;
+        backends_ = std::make_shared<Backends const>(Backends{
+            std::move(newBackend),
+            current.writable,
+            std::move(newFilter),
+            current.writableFilter});
+    }
 
-    auto newBackend = f(writableBackend_->getName());
-    archiveBackend_->setDeletePath();
-    archiveBackend_ = std::move(writableBackend_);
-    writableBackend_ = std::move(newBackend);
+    // Its files are removed once the last fetch using it lets go
+    retired->setDeletePath();
 }
 
 std::string
 DatabaseRotatingImp::getName() const
 {
-    std::lock_guard lock(mutex_);
-    return writableBackend_->getName();
+    return backends()->writable->getName();
 }
 
 std::int32_t
 DatabaseRotatingImp::getWriteLoad() const
 {
-    std::lock_guard lock(mutex_);
-    return writableBackend_->getWriteLoad();
+    return backends()->writable->getWriteLoad();
 }
 
 void
 DatabaseRotatingImp::importDatabase(Database& source)
 {
-    auto const backend = [&] {
-        std::lock_guard lock(mutex_);
-        return writableBackend_;
-    }();
-
-    importInternal(*backend, source);
+    // The import bypasses the filter
+    dropWritableFilter();
+    importInternal(*backends()->writable, source);
 }
 
 bool
 DatabaseRotatingImp::storeLedger(std::shared_ptr<Ledger const> const& srcLedger)
 {
-    auto const backend = [&] {
-        std::lock_guard lock(mutex_);
-        return writableBackend_;
-    }();
-
-    return Database::storeLedger(*srcLedger, backend);
+    // Storing a whole ledger writes to the backend directly
+    dropWritableFilter();
+    return Database::storeLedger(*srcLedger, backends()->writable);
 }
 
 void
 DatabaseRotatingImp::sync()
 {
-    std::lock_guard lock(mutex_);
-    writableBackend_->sync();
+    backends()->writable->sync();
 }
 
 void
@@ -105,14 +139,21 @@ DatabaseRotatingImp::store(
     std::uint32_t)
 {
     auto nObj = NodeObject::createObject(type, std::move(data), hash);
+    storeWritable(nObj);
+    storeStats(1, nObj->getData().size());
+}
 
-    auto const backend = [&] {
-        std::lock_guard lock(mutex_);
-        return writableBackend_;
-    }();
+void
+DatabaseRotatingImp::storeWritable(
+    std::shared_ptr<NodeObject> const& nodeObject)
+{
+    auto const current = backends();
 
-    backend->store(nObj);
-    storeStats(1, nObj->getData().size());
+    // Insert into the filter first so that a concurrent fetch which finds
+    // the key missing from the filter also finds it missing from the backend
+    if (current->writableFilter)
+        current->writableFilter->insert(nodeObject->getHash());
+    current->writable->store(nodeObject);
 }
 
 void
@@ -157,33 +198,35 @@ DatabaseRotatingImp::fetchNodeObject(
         return nodeObject;
     };
 
-    // See if the node object exists in the cache
-    std::shared_ptr<NodeObject> nodeObject;
+    auto const lookup = [&] {
+        std::shared_ptr<NodeObject> nodeObject;
 
-    auto [writable, archive] = [&] {
-        std::lock_guard lock(mutex_);
-        return std::make_pair(writableBackend_, archiveBackend_);
-    }();
+        auto const current = backends();
+        auto const& [writable, archive, writableFilter, archiveFilter] =
+            *current;
 
-    // Try to fetch from the writable backend
-    nodeObject = fetch(writable);
-    if (!nodeObject)
-    {
-        // Otherwise try to fetch from the archive backend
-        nodeObject = fetch(archive);
-        if (nodeObject)
+        // Try to fetch from the writable backend
+        if (!writableFilter || writableFilter->mayContain(hash))
+            nodeObject = fetch(writable);
+        if (!nodeObject)
         {
+            // Otherwise try to fetch from the archive backend
+            if (!archiveFilter || archiveFilter->mayContain(hash))
+                nodeObject = fetch(archive);
+            if (nodeObject)
             {
-                // Refresh the writable backend pointer
-                std::lock_guard lock(mutex_);
-                writable = writableBackend_;
+                // Update writable backend with data from the archive backend
+                if (duplicate)
+                    storeWritable(nodeObject);
             }
-
-            // Update writable backend with data from the archive backend
-            if (duplicate)
-                writable->store(nodeObject);
         }
-    }
+
+        return nodeObject;
+    };
+
+    // A fetch that copies forward must do its own lookup, since a shared
+    // one may not have copied anything
+    auto const nodeObject = duplicate ? lookup() : fetchShared(hash, lookup);
 
     if (nodeObject)
         fetchReport.wasFound = true;
@@ -195,16 +238,13 @@ void
 DatabaseRotatingImp::for_each(
     std::function<void(std::shared_ptr<NodeObject>)> f)
 {
-    auto [writable, archive] = [&] {
-        std::lock_guard lock(mutex_);
-        return std::make_pair(writableBackend_, archiveBackend_);
-    }();
+    auto const current = backends();
 
     // Iterate the writable backend
-    writable->for_each(f);
+    current->writable->for_each(f);
 
     // Iterate the archive backend
-    archive->for_each(f);
+    current->archive->for_each(f);
 }
 
 }  // namespace NodeStore
@@ -21,6 +21,9 @@
 #define RIPPLE_NODESTORE_DATABASEROTATINGIMP_H_INCLUDED
 
 #include <ripple/nodestore/DatabaseRotating.h>
+#include <ripple/nodestore/impl/ExistenceFilter.h>
+#include <memory>
+#include <mutex>
 
 namespace ripple {
 namespace NodeStore {
@@ -80,9 +83,38 @@ public:
     sweep() override;
 
 private:
-    std::shared_ptr<Backend> writableBackend_;
-    std::shared_ptr<Backend> archiveBackend_;
+    // The backends in use, which are replaced as a whole but never changed,
+    // so that readers hold the lock only to copy the pointer
+    struct Backends
+    {
+        std::shared_ptr<Backend> writable;
+        std::shared_ptr<Backend> archive;
+        // Filters over the keys of each backend, used to skip lookups that
+        // are certain to miss. A filter is only present if it has seen every
+        // write to its backend, which is the case for backends created by
+        // rotation.
+        std::shared_ptr<ExistenceFilter> writableFilter;
+        std::shared_ptr<ExistenceFilter> archiveFilter;
+    };
+
+    std::shared_ptr<Backends const> backends_;
+    // Size in bytes of the filter created for each new backend, 0 if none
+    std::size_t const filterBytes_;
+    // Guards backends_, only while the pointer is read or replaced
     mutable std::mutex mutex_;
+    // Serializes rotations, which run their callback outside mutex_
+    std::mutex rotateMutex_;
+
+    std::shared_ptr<Backends const>
+    backends() const;
+
+    // Stop using the writable filter, which is about to miss writes
+    void
+    dropWritableFilter();
+
+    // Store an object in the writable backend, keeping its filter current
+    void
+    storeWritable(std::shared_ptr<NodeObject> const& nodeObject);
 
     std::shared_ptr<NodeObject>
     fetchNodeObject(
@@ -1349,6 +1349,14 @@ DatabaseShardImp::initConfig(std::lock_guard<std::mutex> const&)
     {
         get_if_exists(section, "max_historical_shards", maxHistoricalShards_);
 
+        // Shards are independent of each other, so several of them may be
+        // verified and finalized at once
+        std::uint32_t finalizeThreads{1};
+        get_if_exists(section, "finalize_threads", finalizeThreads);
+        if (finalizeThreads < 1 || finalizeThreads > 16)
+            return fail("'finalize_threads' must be between 1 and 16");
+        taskQueue_.setThreads(finalizeThreads);
+
         Section const& historicalShardPaths =
             config.section(SECTION_HISTORICAL_SHARD_PATHS);
 
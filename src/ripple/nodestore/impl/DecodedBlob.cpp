@@ -87,5 +87,21 @@ DecodedBlob::createObject()
     return object;
 }
 
+std::shared_ptr<NodeObject>
+DecodedBlob::createObject(Blob&& storage)
+{
+    assert(m_success);
+
+    if (!m_success ||
+        storage.size() != static_cast<std::size_t>(m_dataBytes) + 9 ||
+        m_objectData != storage.data() + 9)
+        return createObject();
+
+    storage.erase(storage.begin(), storage.begin() + 9);
+
+    return NodeObject::createObject(
+        m_objectType, std::move(storage), uint256::fromVoid(m_key));
+}
+
 }  // namespace NodeStore
 }  // namespace ripple
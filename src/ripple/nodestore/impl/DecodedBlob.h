@@ -52,6 +52,16 @@ public:
     std::shared_ptr<NodeObject>
     createObject();
 
+    /** Create a NodeObject which takes over the buffer holding this data.
+
+        When the blob was decoded from `storage` the payload is moved to the
+        front of the buffer in place, and the buffer becomes the object's
+        data, so the payload is never copied into a second allocation.
+        Otherwise this behaves like createObject().
+    */
+    std::shared_ptr<NodeObject>
+    createObject(Blob&& storage);
+
 private:
     bool m_success;
 
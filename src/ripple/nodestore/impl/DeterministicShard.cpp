@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/app/main/Application.h>
+#include <ripple/beast/core/CurrentThreadName.h>
 #include <ripple/beast/hash/hash_append.h>
 #include <ripple/core/ConfigSections.h>
 #include <ripple/nodestore/Manager.h>
@@ -144,6 +145,7 @@ DeterministicShard::init(Serializer const& finalKey)
             ". Error: " + e.what());
     }
 
+    writer_ = std::thread(&DeterministicShard::run, this);
     return true;
 }
 
@@ -165,6 +167,18 @@ make_DeterministicShard(
 void
 DeterministicShard::close(bool cancel)
 {
+    if (writer_.joinable())
+    {
+        {
+            std::lock_guard lock(mutex_);
+            if (cancel)
+                queue_.clear();
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        writer_.join();
+    }
+
     try
     {
         if (cancel)
@@ -189,6 +203,67 @@ DeterministicShard::close(bool cancel)
 
 bool
 DeterministicShard::store(std::shared_ptr<NodeObject> const& nodeObject)
+{
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this] { return failed_ || queue_.size() < maxMemObjs_; });
+    if (failed_)
+        return false;
+
+    queue_.push_back(nodeObject);
+    if (queue_.size() == 1)
+        cv_.notify_all();
+    return true;
+}
+
+bool
+DeterministicShard::flush()
+{
+    std::unique_lock lock(mutex_);
+    cv_.wait(
+        lock, [this] { return failed_ || (queue_.empty() && !writing_); });
+    return !failed_;
+}
+
+void
+DeterministicShard::run()
+{
+    beast::setCurrentThreadName("det shard " + std::to_string(index_));
+
+    std::unique_lock lock(mutex_);
+    while (true)
+    {
+        cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty())
+            break;
+
+        // Take every object queued, which lets the caller queue more
+        decltype(queue_) batch;
+        batch.swap(queue_);
+        writing_ = true;
+        lock.unlock();
+        cv_.notify_all();
+
+        bool ok = true;
+        for (auto const& nodeObject : batch)
+        {
+            if (!(ok = write(nodeObject)))
+                break;
+        }
+
+        lock.lock();
+        writing_ = false;
+        if (!ok)
+        {
+            // Later objects can not be written in order, so drop them
+            failed_ = true;
+            queue_.clear();
+        }
+        cv_.notify_all();
+    }
+}
+
+bool
+DeterministicShard::write(std::shared_ptr<NodeObject> const& nodeObject)
 {
     try
     {
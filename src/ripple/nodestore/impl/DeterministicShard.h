@@ -23,7 +23,11 @@
 #include <ripple/nodestore/DatabaseShard.h>
 #include <ripple/nodestore/DummyScheduler.h>
 #include <nudb/nudb.hpp>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <set>
+#include <thread>
 
 namespace ripple {
 namespace NodeStore {
@@ -32,9 +36,11 @@ namespace NodeStore {
  *
  * 1. The init() method creates temporary folder dir_,
  *    and the deterministic shard is initialized in that folder.
- * 2. The store() method adds object to memory pool.
- * 3. The flush() method stores all objects from memory pool to the shard
- *    located in dir_ in sorted order.
+ * 2. The store() method queues the object for a writer thread, which
+ *    writes the objects to the shard located in dir_ in the order they
+ *    were stored, so the caller walks the next ledger while the last is
+ *    written, yet the files are the same as if it wrote them itself.
+ * 3. The flush() method waits until every stored object is written.
  * 4. The close(true) method closes the backend and removes the directory.
  */
 class DeterministicShard
@@ -92,16 +98,22 @@ public:
         return dir_;
     }
 
-    /** Store a node object in memory.
+    /** Queue a node object to be written to the shard.
      *
      * @param nodeObject The node object to store
-     * @return true on success.
-     * @note Flushes all objects in memory to the backend when the number
-     *       of node objects held in memory exceed a threshold
+     * @return true unless writing an earlier object failed.
+     * @note Blocks while the writer is a threshold of objects behind.
      */
     [[nodiscard]] bool
     store(std::shared_ptr<NodeObject> const& nodeObject);
 
+    /** Wait until every node object stored is written.
+     *
+     * @return true if all of them were written.
+     */
+    [[nodiscard]] bool
+    flush();
+
 private:
     /** Finalizes and closes the shard.
      *
@@ -111,6 +123,15 @@ private:
     void
     close(bool cancel);
 
+    // Write a node object to the backend, flushing it to the files when
+    // the number of node objects held in memory reaches a threshold
+    bool
+    write(std::shared_ptr<NodeObject> const& nodeObject);
+
+    // Body of the writer thread
+    void
+    run();
+
     // Application reference
     Application& app_;
 
@@ -138,6 +159,16 @@ private:
     // Maximum number of in-cache objects
     std::uint32_t const maxMemObjs_;
 
+    // Node objects stored but not yet taken by the writer, which are
+    // never more than maxMemObjs_
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::shared_ptr<NodeObject>> queue_;
+    bool writing_ = false;
+    bool failed_ = false;
+    bool stopping_ = false;
+    std::thread writer_;
+
     friend std::shared_ptr<DeterministicShard>
     make_DeterministicShard(
         Application& app,
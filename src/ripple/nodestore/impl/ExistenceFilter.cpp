@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/random.h>
+#include <ripple/nodestore/impl/ExistenceFilter.h>
+#include <algorithm>
+#include <cstring>
+
+namespace ripple {
+namespace NodeStore {
+
+namespace {
+
+// Split a key into the word that picks the block and the word that picks
+// the bits within it. Keys are already uniformly distributed hashes.
+std::pair<std::uint64_t, std::uint64_t>
+split(uint256 const& key, std::uint64_t salt)
+{
+    std::uint64_t w[2];
+    std::memcpy(w, key.data(), sizeof(w));
+    return {w[0] ^ salt, w[1] ^ (salt * 0x9E3779B97F4A7C15ull)};
+}
+
+}  // namespace
+
+ExistenceFilter::ExistenceFilter(std::size_t bytes)
+    : blocks_(std::max<std::size_t>(
+          1,
+          (bytes + blockWords * sizeof(std::uint64_t) - 1) /
+              (blockWords * sizeof(std::uint64_t))))
+    , bits_(new std::atomic<std::uint64_t>[blocks_ * blockWords])
+    , salt_(rand_int<std::uint64_t>())
+{
+    for (std::size_t i = 0; i < blocks_ * blockWords; ++i)
+        bits_[i].store(0, std::memory_order_relaxed);
+}
+
+std::atomic<std::uint64_t>*
+ExistenceFilter::block(uint256 const& key) const
+{
+    return &bits_[(split(key, salt_).first % blocks_) * blockWords];
+}
+
+void
+ExistenceFilter::insert(uint256 const& key)
+{
+    auto b = block(key);
+    auto h = split(key, salt_).second;
+    for (int i = 0; i < probes; ++i, h >>= 9)
+        b[(h >> 6) & (blockWords - 1)].fetch_or(
+            std::uint64_t(1) << (h & 63), std::memory_order_release);
+}
+
+bool
+ExistenceFilter::mayContain(uint256 const& key) const
+{
+    auto b = block(key);
+    auto h = split(key, salt_).second;
+    for (int i = 0; i < probes; ++i, h >>= 9)
+    {
+        auto const bit = std::uint64_t(1) << (h & 63);
+        if ((b[(h >> 6) & (blockWords - 1)].load(std::memory_order_acquire) &
+             bit) == 0)
+            return false;
+    }
+    return true;
+}
+
+}  // namespace NodeStore
+}  // namespace ripple
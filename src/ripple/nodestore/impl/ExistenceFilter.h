@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_EXISTENCEFILTER_H_INCLUDED
+#define RIPPLE_NODESTORE_EXISTENCEFILTER_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace ripple {
+namespace NodeStore {
+
+/** A blocked Bloom filter over the keys stored in a backend.
+
+    A negative answer from mayContain is definite: the key was never
+    inserted. A positive answer may be wrong, with a probability that
+    grows as the filter fills. All the bits for a key live in one cache
+    line, so a query costs a single memory access.
+
+    Insertions and queries may run concurrently. A key becomes visible to
+    queries as soon as insert returns, so callers should insert a key
+    before they write the object to the backend.
+
+    The filter is only meaningful if it has seen every key written to the
+    backend since the backend was created.
+*/
+class ExistenceFilter
+{
+public:
+    /** Create an empty filter.
+
+        @param bytes The size of the filter. It is rounded up to a whole
+                     number of blocks.
+    */
+    explicit ExistenceFilter(std::size_t bytes);
+
+    ExistenceFilter(ExistenceFilter const&) = delete;
+    ExistenceFilter&
+    operator=(ExistenceFilter const&) = delete;
+
+    void
+    insert(uint256 const& key);
+
+    /** Returns false only if the key was never inserted. */
+    bool
+    mayContain(uint256 const& key) const;
+
+private:
+    // Words per block; a block is one 64 byte cache line
+    static constexpr std::size_t blockWords = 8;
+    // Bits set per key
+    static constexpr int probes = 7;
+
+    std::size_t const blocks_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> bits_;
+    // Random per-filter salt so that crafted keys can not target a block
+    std::uint64_t const salt_;
+
+    std::atomic<std::uint64_t>*
+    block(uint256 const& key) const;
+};
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
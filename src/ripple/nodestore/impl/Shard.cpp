@@ -317,7 +317,7 @@ Shard::storeLedger(
     if (srcLedger->info().accountHash.isZero())
         return fail("Invalid account hash");
 
-    auto& srcDB{const_cast<Database&>(srcLedger->stateMap().family().db())};
+    auto const& srcDB{srcLedger->stateMap().family().db()};
     if (&srcDB == &(app_.getShardFamily()->db()))
         return fail("Source and destination databases are the same");
 
@@ -362,16 +362,19 @@ Shard::storeLedger(
     }
 
     bool error = false;
+    NodeObjectType nodeType = hotACCOUNT_NODE;
     auto visit = [&](SHAMapTreeNode const& node) {
         if (!stop_)
         {
-            if (auto nodeObject = srcDB.fetchNodeObject(
-                    node.getHash().as_uint256(), srcLedger->info().seq))
-            {
-                batch.emplace_back(std::move(nodeObject));
-                if (batch.size() < batchWritePreallocationSize || storeBatch())
-                    return true;
-            }
+            // The walk has already read the node from the source database,
+            // so serialize it as SHAMap::writeNode would instead of reading
+            // the same object a second time
+            Serializer s;
+            node.serializeWithPrefix(s);
+            batch.emplace_back(NodeObject::createObject(
+                nodeType, std::move(s.modData()), node.getHash().as_uint256()));
+            if (batch.size() < batchWritePreallocationSize || storeBatch())
+                return true;
         }
 
         error = true;
@@ -402,6 +405,7 @@ Shard::storeLedger(
         if (!srcLedger->txMap().isValid())
             return fail("Invalid transaction map");
 
+        nodeType = hotTRANSACTION_NODE;
         srcLedger->txMap().snapShot(false)->visitNodes(visit);
         if (error)
             return fail("Failed to store transaction map");
@@ -768,6 +772,8 @@ Shard::finalize(bool writeSQLite, std::optional<uint256> const& referenceHash)
         NodeObject::createObject(hotUNKNOWN, std::move(s.modData()), finalKey)};
     if (!dShard->store(nodeObject))
         return fail("failed to store node object");
+    if (!dShard->flush())
+        return fail("failed to write node objects");
 
     try
     {
@@ -1203,8 +1209,14 @@ Shard::verifyFetch(uint256 const& hash) const
 
     try
     {
-        std::lock_guard lock(mutex_);
-        switch (backend_->fetch(hash.data(), &nodeObject))
+        Status status;
+        {
+            std::lock_guard lock(mutex_);
+            status = backend_->fetch(hash.data(), &nodeObject);
+        }
+
+        // Hash the payload outside the lock, which also serves fetches
+        switch (status)
         {
             case ok:
                 // Verify that the hash of node object matches the payload
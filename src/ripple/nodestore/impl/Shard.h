@@ -23,9 +23,9 @@
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/rdb/RelationalDatabase.h>
 #include <ripple/basics/BasicConfig.h>
-#include <ripple/basics/KeyCache.h>
 #include <ripple/basics/MathUtilities.h>
 #include <ripple/basics/RangeSet.h>
+#include <ripple/basics/TaggedCache.h>
 #include <ripple/basics/ThreadSafetyAnalysis.h>
 #include <ripple/core/DatabaseCon.h>
 #include <ripple/nodestore/NodeObject.h>
@@ -41,7 +41,6 @@ namespace ripple {
 namespace NodeStore {
 
 using PCache = TaggedCache<uint256, NodeObject>;
-using NCache = KeyCache;
 class DatabaseShard;
 
 /* A range of historical ledgers backed by a node store.
@@ -44,6 +44,13 @@ TaskQueue::addTask(std::function<void()> task)
     workers_.addTask();
 }
 
+void
+TaskQueue::setThreads(int threads)
+{
+    assert(threads > 0);
+    workers_.setNumberOfThreads(threads);
+}
+
 size_t
 TaskQueue::size() const
 {
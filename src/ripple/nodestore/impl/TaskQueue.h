@@ -43,6 +43,13 @@ public:
     void
     addTask(std::function<void()> task);
 
+    /** Set the number of tasks that may run at the same time
+
+        @param threads Number of worker threads, at least one.
+    */
+    void
+    setThreads(int threads);
+
     /** Return the queue size
      */
     [[nodiscard]] size_t
@@ -0,0 +1,344 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Log.h>
+#include <ripple/basics/contract.h>
+#include <ripple/nodestore/impl/ZstdCodec.h>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+
+#if RIPPLE_ZSTD_AVAILABLE
+#include <zdict.h>
+#include <zstd.h>
+#endif
+
+namespace ripple {
+namespace NodeStore {
+
+#if RIPPLE_ZSTD_AVAILABLE
+
+namespace {
+
+// zstd contexts are costly to create, so each thread keeps one of each.
+ZSTD_CCtx*
+compressionContext()
+{
+    thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx{
+        ZSTD_createCCtx(), &ZSTD_freeCCtx};
+    return ctx.get();
+}
+
+ZSTD_DCtx*
+decompressionContext()
+{
+    thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx{
+        ZSTD_createDCtx(), &ZSTD_freeDCtx};
+    return ctx.get();
+}
+
+char const*
+dictionaryFile(std::size_t type)
+{
+    switch (type)
+    {
+        case hotLEDGER:
+            return "ledger.dict";
+        case hotACCOUNT_NODE:
+            return "account_node.dict";
+        case hotTRANSACTION_NODE:
+            return "transaction_node.dict";
+        default:
+            return nullptr;
+    }
+}
+
+}  // namespace
+
+ZstdCodec::ZstdCodec(int level, Dictionaries const& dictionaries)
+    : level_(level)
+{
+    for (std::size_t type = 0; type < dictionarySlots; ++type)
+    {
+        auto const& dict = dictionaries[type];
+        if (dict.empty())
+            continue;
+        cdicts_[type] = ZSTD_createCDict(dict.data(), dict.size(), level_);
+        ddicts_[type] = ZSTD_createDDict(dict.data(), dict.size());
+        if (!cdicts_[type] || !ddicts_[type])
+        {
+            release();
+            Throw<std::runtime_error>(
+                "nodestore: invalid zstd dictionary for type " +
+                std::to_string(type));
+        }
+    }
+}
+
+ZstdCodec::~ZstdCodec()
+{
+    release();
+}
+
+void
+ZstdCodec::release()
+{
+    for (auto& cdict : cdicts_)
+    {
+        ZSTD_freeCDict(cdict);
+        cdict = nullptr;
+    }
+    for (auto& ddict : ddicts_)
+    {
+        ZSTD_freeDDict(ddict);
+        ddict = nullptr;
+    }
+}
+
+std::unique_ptr<ZstdCodec>
+ZstdCodec::make(Section const& section, beast::Journal journal)
+{
+    std::string compression = "lz4";
+    set(compression, "compression", section);
+    if (boost::iequals(compression, "lz4"))
+        return {};
+    if (!boost::iequals(compression, "zstd"))
+        Throw<std::runtime_error>(
+            "nodestore: unknown compression '" + compression + "'");
+
+    int level = 3;
+    set(level, "zstd_level", section);
+    if (level < 1 || level > ZSTD_maxCLevel())
+        Throw<std::runtime_error>(
+            "nodestore: zstd_level must be between 1 and " +
+            std::to_string(ZSTD_maxCLevel()));
+
+    Dictionaries dictionaries;
+    std::string dir;
+    if (set(dir, "zstd_dictionaries", section))
+    {
+        for (std::size_t type = 0; type < dictionarySlots; ++type)
+        {
+            auto const name = dictionaryFile(type);
+            if (!name)
+                continue;
+            auto const path = boost::filesystem::path(dir) / name;
+            if (!boost::filesystem::exists(path))
+            {
+                JLOG(journal.warn()) << "No zstd dictionary at " << path;
+                continue;
+            }
+            std::ifstream ifs(path.string(), std::ios::binary);
+            dictionaries[type].assign(
+                std::istreambuf_iterator<char>(ifs),
+                std::istreambuf_iterator<char>());
+            JLOG(journal.info()) << "Loaded zstd dictionary " << path << " ("
+                                 << dictionaries[type].size() << " bytes)";
+        }
+    }
+
+    return std::make_unique<ZstdCodec>(level, dictionaries);
+}
+
+ZstdCodec const&
+ZstdCodec::plain()
+{
+    static ZstdCodec const codec(3, Dictionaries{});
+    return codec;
+}
+
+Blob
+ZstdCodec::train(std::vector<Blob> const& samples, std::size_t capacity)
+{
+    Blob joined;
+    std::vector<std::size_t> sizes;
+    joined.reserve(std::accumulate(
+        samples.begin(),
+        samples.end(),
+        std::size_t{0},
+        [](std::size_t n, Blob const& b) { return n + b.size(); }));
+    sizes.reserve(samples.size());
+    for (auto const& sample : samples)
+    {
+        joined.insert(joined.end(), sample.begin(), sample.end());
+        sizes.push_back(sample.size());
+    }
+
+    Blob dict(capacity);
+    auto const n = ZDICT_trainFromBuffer(
+        dict.data(),
+        dict.size(),
+        joined.data(),
+        sizes.data(),
+        static_cast<unsigned>(sizes.size()));
+    if (ZDICT_isError(n))
+        return {};
+    dict.resize(n);
+    return dict;
+}
+
+bool
+ZstdCodec::hasDictionary(std::size_t type) const
+{
+    return type < dictionarySlots && cdicts_[type] != nullptr;
+}
+
+std::size_t
+ZstdCodec::compressBound(std::size_t size)
+{
+    return ZSTD_compressBound(size);
+}
+
+std::size_t
+ZstdCodec::compress(
+    void* out,
+    std::size_t outCapacity,
+    void const* in,
+    std::size_t inSize,
+    std::size_t type) const
+{
+    std::size_t n;
+    if (hasDictionary(type))
+        n = ZSTD_compress_usingCDict(
+            compressionContext(), out, outCapacity, in, inSize, cdicts_[type]);
+    else
+        n = ZSTD_compressCCtx(
+            compressionContext(), out, outCapacity, in, inSize, level_);
+    if (ZSTD_isError(n))
+        Throw<std::runtime_error>(
+            std::string("zstd compress: ") + ZSTD_getErrorName(n));
+    return n;
+}
+
+std::size_t
+ZstdCodec::decompress(
+    void* out,
+    std::size_t outCapacity,
+    void const* in,
+    std::size_t inSize,
+    std::size_t type) const
+{
+    std::size_t n;
+    if (type == hotUNKNOWN)
+        n = ZSTD_decompressDCtx(
+            decompressionContext(), out, outCapacity, in, inSize);
+    else if (type < dictionarySlots && ddicts_[type])
+        n = ZSTD_decompress_usingDDict(
+            decompressionContext(),
+            out,
+            outCapacity,
+            in,
+            inSize,
+            ddicts_[type]);
+    else
+        Throw<std::runtime_error>(
+            "zstd decompress: no dictionary for type " +
+            std::to_string(type));
+    if (ZSTD_isError(n))
+        Throw<std::runtime_error>(
+            std::string("zstd decompress: ") + ZSTD_getErrorName(n));
+    return n;
+}
+
+#else
+
+namespace {
+
+[[noreturn]] void
+unavailable()
+{
+    Throw<std::runtime_error>("nodestore: rippled was built without zstd");
+}
+
+}  // namespace
+
+ZstdCodec::ZstdCodec(int level, Dictionaries const&) : level_(level)
+{
+    unavailable();
+}
+
+ZstdCodec::~ZstdCodec() = default;
+
+void
+ZstdCodec::release()
+{
+}
+
+std::unique_ptr<ZstdCodec>
+ZstdCodec::make(Section const& section, beast::Journal)
+{
+    std::string compression = "lz4";
+    set(compression, "compression", section);
+    if (boost::iequals(compression, "lz4"))
+        return {};
+    if (!boost::iequals(compression, "zstd"))
+        Throw<std::runtime_error>(
+            "nodestore: unknown compression '" + compression + "'");
+    unavailable();
+}
+
+ZstdCodec const&
+ZstdCodec::plain()
+{
+    unavailable();
+}
+
+Blob
+ZstdCodec::train(std::vector<Blob> const&, std::size_t)
+{
+    unavailable();
+}
+
+bool
+ZstdCodec::hasDictionary(std::size_t) const
+{
+    return false;
+}
+
+std::size_t
+ZstdCodec::compressBound(std::size_t)
+{
+    unavailable();
+}
+
+std::size_t
+ZstdCodec::compress(void*, std::size_t, void const*, std::size_t, std::size_t)
+    const
+{
+    unavailable();
+}
+
+std::size_t
+ZstdCodec::decompress(
+    void*,
+    std::size_t,
+    void const*,
+    std::size_t,
+    std::size_t) const
+{
+    unavailable();
+}
+
+#endif
+
+}  // namespace NodeStore
+}  // namespace ripple
@@ -0,0 +1,149 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_ZSTDCODEC_H_INCLUDED
+#define RIPPLE_NODESTORE_ZSTDCODEC_H_INCLUDED
+
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/basics/Blob.h>
+#include <ripple/basics/ByteUtilities.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/nodestore/NodeObject.h>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace ripple {
+namespace NodeStore {
+
+/** Zstandard compression of node object blobs with per-type dictionaries.
+
+    Node objects are small and individually compress poorly, but objects of
+    the same type share a great deal of structure. A dictionary trained on
+    a sample of each NodeObjectType lets zstd exploit that structure one
+    object at a time.
+
+    The dictionary used for a blob is recorded in the blob itself (see
+    nodeobject_compress), so a database may freely mix lz4 blobs, zstd
+    blobs without a dictionary and zstd blobs with a dictionary. A blob
+    that names a dictionary can only be read by a codec that holds it.
+
+    zstd is optional at build time. Without it, configuring zstd and
+    reading a zstd blob both throw.
+*/
+class ZstdCodec
+{
+public:
+    /** One dictionary slot per NodeObjectType value. */
+    static constexpr std::size_t dictionarySlots = hotTRANSACTION_NODE + 1;
+
+    using Dictionaries = std::array<Blob, dictionarySlots>;
+
+    /** The largest decompressed size a blob may claim.
+
+        Far above any real node object; a blob claiming more is corrupt,
+        and is rejected before anything is allocated for it.
+    */
+    static constexpr std::size_t maxDecompressedSize =
+        megabytes(std::size_t(64));
+
+    /** Create a codec.
+
+        @param level The zstd compression level.
+        @param dictionaries Raw dictionary contents, indexed by
+                            NodeObjectType. Empty entries are unused.
+    */
+    ZstdCodec(int level, Dictionaries const& dictionaries);
+
+    ~ZstdCodec();
+
+    ZstdCodec(ZstdCodec const&) = delete;
+    ZstdCodec&
+    operator=(ZstdCodec const&) = delete;
+
+    /** Create a codec from a backend configuration.
+
+        @return The codec, or nullptr if the section does not ask for zstd.
+    */
+    static std::unique_ptr<ZstdCodec>
+    make(Section const& section, beast::Journal journal);
+
+    /** A codec with no dictionaries, able to read undictionaried blobs. */
+    static ZstdCodec const&
+    plain();
+
+    /** Train a dictionary from a set of sample blobs.
+
+        @param samples Encoded blobs of a single NodeObjectType.
+        @param capacity The maximum size of the dictionary in bytes.
+        @return The dictionary, or an empty Blob if training failed.
+    */
+    static Blob
+    train(std::vector<Blob> const& samples, std::size_t capacity);
+
+    /** Return `true` if a dictionary is held for the given type. */
+    bool
+    hasDictionary(std::size_t type) const;
+
+    /** The largest output compress() may produce for `size` input bytes. */
+    static std::size_t
+    compressBound(std::size_t size);
+
+    /** Compress a buffer.
+
+        @param type The dictionary to use, or hotUNKNOWN for none.
+        @return The number of bytes written to `out`.
+    */
+    std::size_t
+    compress(
+        void* out,
+        std::size_t outCapacity,
+        void const* in,
+        std::size_t inSize,
+        std::size_t type) const;
+
+    /** Decompress a buffer produced by compress() with the same type.
+
+        @return The number of bytes written to `out`.
+    */
+    std::size_t
+    decompress(
+        void* out,
+        std::size_t outCapacity,
+        void const* in,
+        std::size_t inSize,
+        std::size_t type) const;
+
+private:
+    int const level_;
+    std::array<ZSTD_CDict_s*, dictionarySlots> cdicts_{};
+    std::array<ZSTD_DDict_s*, dictionarySlots> ddicts_{};
+
+    void
+    release();
+};
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
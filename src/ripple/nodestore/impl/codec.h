@@ -26,6 +26,7 @@
 #include <ripple/basics/contract.h>
 #include <ripple/basics/safe_cast.h>
 #include <ripple/nodestore/NodeObject.h>
+#include <ripple/nodestore/impl/ZstdCodec.h>
 #include <ripple/nodestore/impl/varint.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <cstddef>
@@ -101,11 +102,83 @@ lz4_compress(void const* in, std::size_t in_size, BufferFactory&& bf)
     1 = lz4 compressed
     2 = inner node compressed
     3 = full inner node
+    4 = zstd compressed
+
+    A zstd blob carries two more varints ahead of the zstd frame: the
+    NodeObjectType whose dictionary was used (0 for none) and the size
+    of the decompressed data.
 */
 
 template <class BufferFactory>
 std::pair<void const*, std::size_t>
-nodeobject_decompress(void const* in, std::size_t in_size, BufferFactory&& bf)
+zstd_decompress(
+    void const* in,
+    std::size_t in_size,
+    BufferFactory&& bf,
+    ZstdCodec const& codec)
+{
+    auto const p = reinterpret_cast<std::uint8_t const*>(in);
+
+    std::size_t dict = 0;
+    auto const dn = read_varint(p, in_size, dict);
+    if (dn == 0 || dn >= in_size)
+        Throw<std::runtime_error>("zstd_decompress: invalid blob");
+
+    std::size_t outSize = 0;
+    auto const sn = read_varint(p + dn, in_size - dn, outSize);
+    if (sn == 0 || dn + sn >= in_size)
+        Throw<std::runtime_error>("zstd_decompress: invalid blob");
+
+    if (outSize == 0 || outSize > ZstdCodec::maxDecompressedSize)
+        Throw<std::runtime_error>(
+            "zstd_decompress: invalid size " + std::to_string(outSize));
+
+    void* const out = bf(outSize);
+
+    if (codec.decompress(out, outSize, p + dn + sn, in_size - dn - sn, dict) !=
+        outSize)
+        Throw<std::runtime_error>("zstd_decompress: size mismatch");
+
+    return {out, outSize};
+}
+
+template <class BufferFactory>
+std::pair<void const*, std::size_t>
+zstd_compress(
+    void const* in,
+    std::size_t in_size,
+    BufferFactory&& bf,
+    ZstdCodec const& codec)
+{
+    using namespace nudb::detail;
+
+    // The object type follows the 8 byte prefix of an encoded blob.
+    std::size_t dict = hotUNKNOWN;
+    if (in_size > 8)
+    {
+        auto const type = reinterpret_cast<std::uint8_t const*>(in)[8];
+        if (codec.hasDictionary(type))
+            dict = type;
+    }
+
+    std::array<std::uint8_t, 2 * varint_traits<std::size_t>::max> vi;
+    auto n = write_varint(vi.data(), dict);
+    n += write_varint(vi.data() + n, in_size);
+
+    auto const out_max = ZstdCodec::compressBound(in_size);
+    std::uint8_t* out = reinterpret_cast<std::uint8_t*>(bf(n + out_max));
+    std::memcpy(out, vi.data(), n);
+    auto const out_size = codec.compress(out + n, out_max, in, in_size, dict);
+    return {out, n + out_size};
+}
+
+template <class BufferFactory>
+std::pair<void const*, std::size_t>
+nodeobject_decompress(
+    void const* in,
+    std::size_t in_size,
+    BufferFactory&& bf,
+    ZstdCodec const* zstd = nullptr)
 {
     using namespace nudb::detail;
 
@@ -199,6 +272,12 @@ nodeobject_decompress(void const* in, std::size_t in_size, BufferFactory&& bf)
             write(os, is(512), 512);
             break;
         }
+        case 4:  // zstd
+        {
+            result = zstd_decompress(
+                p, in_size, bf, zstd ? *zstd : ZstdCodec::plain());
+            break;
+        }
         default:
             Throw<std::runtime_error>(
                 "nodeobject codec: bad type=" + std::to_string(type));
@@ -214,9 +293,18 @@ zero32()
     return v.data();
 }
 
+/** Compress an encoded blob for storage.
+
+    Inner nodes are always stored in their compact form. Other objects are
+    compressed with zstd if a codec is given and with lz4 otherwise.
+*/
 template <class BufferFactory>
 std::pair<void const*, std::size_t>
-nodeobject_compress(void const* in, std::size_t in_size, BufferFactory&& bf)
+nodeobject_compress(
+    void const* in,
+    std::size_t in_size,
+    BufferFactory&& bf,
+    ZstdCodec const* zstd = nullptr)
 {
     using std::runtime_error;
     using namespace nudb::detail;
@@ -280,7 +368,7 @@ nodeobject_compress(void const* in, std::size_t in_size, BufferFactory&& bf)
 
     std::array<std::uint8_t, varint_traits<std::size_t>::max> vi;
 
-    constexpr std::size_t codecType = 1;
+    std::size_t const codecType = zstd ? 4 : 1;
     auto const vn = write_varint(vi.data(), codecType);
     std::pair<void const*, std::size_t> result;
     switch (codecType)
@@ -299,6 +387,22 @@ nodeobject_compress(void const* in, std::size_t in_size, BufferFactory&& bf)
             result.second = vn + lzr.second;
             break;
         }
+        case 4:  // zstd
+        {
+            std::uint8_t* p;
+            auto const zr = NodeStore::zstd_compress(
+                in,
+                in_size,
+                [&p, &vn, &bf](std::size_t n) {
+                    p = reinterpret_cast<std::uint8_t*>(bf(vn + n));
+                    return p + vn;
+                },
+                *zstd);
+            std::memcpy(p, vi.data(), vn);
+            result.first = p;
+            result.second = vn + zr.second;
+            break;
+        }
         default:
             Throw<std::logic_error>(
                 "nodeobject codec: unknown=" + std::to_string(codecType));
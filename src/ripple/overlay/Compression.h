@@ -21,8 +21,19 @@
 #define RIPPLED_COMPRESSION_H_INCLUDED
 
 #include <ripple/basics/CompressionAlgorithms.h>
+#include <ripple/basics/Blob.h>
 #include <ripple/basics/Log.h>
+#include <ripple/basics/contract.h>
 #include <lz4frame.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 namespace ripple {
 
@@ -33,10 +44,145 @@ std::size_t constexpr headerBytesCompressed = 10;
 
 // All values other than 'none' must have the high bit. The low order four bits
 // must be 0.
-enum class Algorithm : std::uint8_t { None = 0x00, LZ4 = 0x90 };
+enum class Algorithm : std::uint8_t { None = 0x00, LZ4 = 0x90, Zstd = 0xA0 };
 
 enum class Compressed : std::uint8_t { On, Off };
 
+/** A zstd dictionary shared by peers for compressing protocol messages.
+
+    Transactions, proposals and validations are too small to compress well
+    on their own, but messages of the same type share most of their
+    structure. A dictionary trained on a sample of them lets zstd compress
+    each message against that structure.
+
+    Both ends of a link must hold the same dictionary, so it is named in the
+    handshake by its zstd dictionary ID and used only when the IDs match.
+*/
+class ZstdDictionary
+{
+public:
+    /** Load a dictionary.
+
+        @param data The raw dictionary, as produced by zstd training.
+        @throws std::runtime_error if the dictionary is not valid.
+    */
+    explicit ZstdDictionary(Blob const& data);
+
+    ~ZstdDictionary();
+
+    ZstdDictionary(ZstdDictionary const&) = delete;
+    ZstdDictionary&
+    operator=(ZstdDictionary const&) = delete;
+
+    /** The zstd dictionary ID, used to match dictionaries in the handshake.
+     */
+    std::uint32_t
+    id() const
+    {
+        return id_;
+    }
+
+    ZSTD_CDict_s const*
+    cdict() const
+    {
+        return cdict_;
+    }
+
+    ZSTD_DDict_s const*
+    ddict() const
+    {
+        return ddict_;
+    }
+
+private:
+    std::uint32_t id_;
+    ZSTD_CDict_s* cdict_;
+    ZSTD_DDict_s* ddict_;
+};
+
+/** The dictionary used for zstd protocol messages, or nullptr if none. */
+std::shared_ptr<ZstdDictionary const>
+zstdDictionary();
+
+/** Set the dictionary used for zstd protocol messages.
+
+    This is done once, when the overlay starts, before any peer connects.
+*/
+void
+setZstdDictionary(std::shared_ptr<ZstdDictionary const> dictionary);
+
+/** The largest output zstdCompress() may produce for `size` input bytes. */
+std::size_t
+zstdCompressBound(std::size_t size);
+
+/** Compress a buffer with zstd and the shared dictionary, if there is one.
+ * @return Size of compressed data
+ * @throws std::runtime_error if compression fails
+ */
+std::size_t
+zstdCompress(
+    void* out,
+    std::size_t outCapacity,
+    void const* in,
+    std::size_t inSize);
+
+/** Decompress a buffer produced by zstdCompress().
+ * @return Size of decompressed data
+ * @throws std::runtime_error if decompression fails
+ */
+std::size_t
+zstdDecompress(
+    std::uint8_t* out,
+    std::size_t outCapacity,
+    void const* in,
+    std::size_t inSize);
+
+/** zstd decompression of an input stream.
+ * @tparam InputStream ZeroCopyInputStream
+ * @param in Input source stream
+ * @param inSize Size of compressed data
+ * @param decompressed Buffer to hold decompressed data
+ * @param decompressedSize Size of the decompressed buffer
+ * @return size of the decompressed data
+ */
+template <typename InputStream>
+std::size_t
+zstdDecompress(
+    InputStream& in,
+    std::size_t inSize,
+    std::uint8_t* decompressed,
+    std::size_t decompressedSize)
+{
+    // Messages compressed with zstd are small, so the compressed bytes are
+    // gathered into one buffer rather than decompressed chunk by chunk.
+    std::vector<std::uint8_t> compressed;
+    compressed.reserve(inSize);
+
+    void const* chunk = nullptr;
+    int chunkSize = 0;
+    while (compressed.size() < inSize && in.Next(&chunk, &chunkSize))
+    {
+        auto const data = static_cast<std::uint8_t const*>(chunk);
+        auto const n = std::min<std::size_t>(
+            chunkSize, inSize - compressed.size());
+        compressed.insert(compressed.end(), data, data + n);
+
+        // Put back unused bytes
+        if (n < static_cast<std::size_t>(chunkSize))
+            in.BackUp(static_cast<int>(chunkSize - n));
+    }
+
+    if (compressed.size() != inSize)
+        Throw<std::runtime_error>("zstd decompress: insufficient input size");
+
+    auto const size = zstdDecompress(
+        decompressed, decompressedSize, compressed.data(), compressed.size());
+    if (size != decompressedSize)
+        Throw<std::runtime_error>("zstd decompress: size mismatch");
+
+    return size;
+}
+
 /** Decompress input stream.
  * @tparam InputStream ZeroCopyInputStream
  * @param in Input source stream
@@ -59,6 +205,8 @@ decompress(
         if (algorithm == Algorithm::LZ4)
             return ripple::compression_algorithms::lz4Decompress(
                 in, inSize, decompressed, decompressedSize);
+        else if (algorithm == Algorithm::Zstd)
+            return zstdDecompress(in, inSize, decompressed, decompressedSize);
         else
         {
             JLOG(debugLog().warn())
@@ -95,6 +243,11 @@ compress(
         if (algorithm == Algorithm::LZ4)
             return ripple::compression_algorithms::lz4Compress(
                 in, inSize, std::forward<BufferFactory>(bf));
+        else if (algorithm == Algorithm::Zstd)
+        {
+            auto const outCapacity = zstdCompressBound(inSize);
+            return zstdCompress(bf(outCapacity), outCapacity, in, inSize);
+        }
         else
         {
             JLOG(debugLog().warn()) << "compress: invalid compression algorithm"
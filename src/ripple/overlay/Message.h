@@ -86,6 +86,15 @@ public:
     std::vector<uint8_t> const&
     getBuffer(Compressed tryCompressed);
 
+    /** Retrieve the packed message data compressed with an algorithm. If the
+     * message is not compressible then the uncompressed buffer is returned.
+     * @param algorithm Compression algorithm, or None for the uncompressed
+     *     payload buffer
+     * @return Payload buffer
+     */
+    std::vector<uint8_t> const&
+    getBuffer(Algorithm algorithm);
+
     /** Get the traffic category */
     std::size_t
     getCategory() const
@@ -103,8 +112,10 @@ public:
 private:
     std::vector<uint8_t> buffer_;
     std::vector<uint8_t> bufferCompressed_;
+    std::vector<uint8_t> bufferZstd_;
     std::size_t category_;
     std::once_flag once_flag_;
+    std::once_flag zstdOnceFlag_;
     std::optional<PublicKey> validatorKey_;
 
     /** Set the payload header
@@ -112,7 +123,7 @@ private:
      * @param payloadBytes Size of the payload excluding the header size
      * @param type Protocol message type
      * @param compression Compression algorithm used in compression,
-     *   currently LZ4 only. If None then the message is uncompressed.
+     *   LZ4 or Zstd. If None then the message is uncompressed.
      * @param uncompressedBytes Size of the uncompressed message
      */
     void
@@ -124,11 +135,14 @@ private:
         std::uint32_t uncompressedBytes);
 
     /** Try to compress the payload.
-     * Can be called concurrently by multiple peers but is compressed once.
-     * If the message is not compressible then the serialized buffer_ is used.
+     * Can be called concurrently by multiple peers but is compressed once
+     * with each algorithm. If the message is not compressible then the
+     * serialized buffer_ is used.
+     * @param algorithm Compression algorithm, LZ4 or Zstd
+     * @param compressed Buffer to hold the compressed message
      */
     void
-    compress();
+    compress(Algorithm algorithm, std::vector<uint8_t>& compressed);
 
     /** Get the message type from the payload header.
      * First four bytes are the compression/algorithm flag and the payload size.
@@ -74,6 +74,13 @@ public:
         std::uint32_t crawlOptions = 0;
         std::optional<std::uint32_t> networkID;
         bool vlEnabled = true;
+        // Threads dedicated to peer connections, 0 to share io_service
+        std::size_t ioThreads = 0;
+        // Megabytes of ledger data kept to serve again, 0 to keep none
+        std::size_t ledgerReplyCacheMB = 64;
+        // A file to record the messages received from peers into, if any
+        std::string captureFile;
+        std::size_t captureMaxMB = 1024;
     };
 
     using PeerSequence = std::vector<std::shared_ptr<Peer>>;
@@ -219,6 +226,10 @@ public:
     virtual std::uint64_t
     getPeerDisconnectCharges() const = 0;
 
+    /** Returns the bytes of the messages queued to be sent to peers. */
+    virtual std::uint64_t
+    getSendQueueBytes() const = 0;
+
     /** Returns information reported to the crawl shard RPC command.
 
         @param includePublicKey include peer public keys in the result.
@@ -244,6 +255,18 @@ public:
      */
     virtual Json::Value
     txMetrics() const = 0;
+
+    /** Returns validation/proposal reduce-relay peer selection state
+        @return json value of the selection state of each validator
+     */
+    virtual Json::Value
+    vpMetrics() const = 0;
+
+    /** Returns the size, queueing delay and handler time distributions
+        @return json value of the histograms of each traffic category
+     */
+    virtual Json::Value
+    trafficMetrics() const = 0;
 };
 
 }  // namespace ripple
@@ -21,6 +21,7 @@
 #define RIPPLE_OVERLAY_REDUCERELAYCOMMON_H_INCLUDED
 
 #include <chrono>
+#include <cstdint>
 
 namespace ripple {
 
@@ -49,6 +50,9 @@ static constexpr uint16_t MIN_MESSAGE_THRESHOLD = 9;
 static constexpr uint16_t MAX_MESSAGE_THRESHOLD = 10;
 // Max selected peers to choose as the source of messages from validator
 static constexpr uint16_t MAX_SELECTED_PEERS = 5;
+// Weight of the latest arrival delay in a peer's smoothed delay, when the
+// fastest peers are selected: smoothed = (smoothed * (N - 1) + delay) / N
+static constexpr std::uint16_t DELAY_SMOOTHING = 4;
 // Wait before reduce-relay feature is enabled on boot up to let
 // the server establish peer connections
 static constexpr auto WAIT_ON_BOOTUP = std::chrono::minutes{10};
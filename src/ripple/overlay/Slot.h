@@ -24,10 +24,12 @@
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/container/aged_unordered_map.h>
 #include <ripple/beast/utility/Journal.h>
+#include <ripple/json/json_value.h>
 #include <ripple/overlay/Peer.h>
 #include <ripple/overlay/ReduceRelayCommon.h>
 #include <ripple/overlay/Squelch.h>
 #include <ripple/protocol/PublicKey.h>
+#include <ripple/protocol/jss.h>
 #include <ripple/protocol/messages.h>
 
 #include <algorithm>
@@ -37,6 +39,8 @@
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace ripple {
 
@@ -107,15 +111,22 @@ private:
     friend class Slots<clock_type>;
     using id_t = Peer::id_t;
     using time_point = typename clock_type::time_point;
+    using duration = typename clock_type::duration;
 
     /** Constructor
      * @param journal Journal for logging
      * @param handler Squelch/Unsquelch implementation
+     * @param selectFastest If true then select the peers with the lowest
+     *     smoothed arrival delay instead of random peers
      */
-    Slot(SquelchHandler const& handler, beast::Journal journal)
+    Slot(
+        SquelchHandler const& handler,
+        beast::Journal journal,
+        bool selectFastest)
         : reachedThreshold_(0)
         , lastSelected_(clock_type::now())
         , state_(SlotState::Counting)
+        , selectFastest_(selectFastest)
         , handler_(handler)
         , journal_(journal)
     {
@@ -128,8 +139,9 @@ private:
      * slot's state to Counting. If the number of messages for the peer is >
      * MIN_MESSAGE_THRESHOLD then add peer to considered peers pool. If the
      * number of considered peers who reached MAX_MESSAGE_THRESHOLD is
-     * MAX_SELECTED_PEERS then randomly select MAX_SELECTED_PEERS from
-     * considered peers, and call squelch handler for each peer, which is not
+     * MAX_SELECTED_PEERS then select MAX_SELECTED_PEERS from considered
+     * peers, randomly or by lowest smoothed arrival delay, and call squelch
+     * handler for each peer, which is not
      * selected and not already in Squelched state. Set the state for those
      * peers to Squelched and reset the count of all peers. Set slot's state to
      * Selected. Message count is not updated when the slot is in Selected
@@ -138,9 +150,15 @@ private:
      * @param id Peer id which received the message
      * @param type  Message type (Validation and Propose Set only,
      *     others are ignored, future use)
+     * @param delay Time since the first copy of the message arrived from
+     *     any peer, if known
      */
     void
-    update(PublicKey const& validator, id_t id, protocol::MessageType type);
+    update(
+        PublicKey const& validator,
+        id_t id,
+        protocol::MessageType type,
+        std::optional<duration> delay = std::nullopt);
 
     /** Handle peer deletion when a peer disconnects.
      * If the peer is in Selected state then
@@ -205,6 +223,12 @@ private:
     std::chrono::seconds
     getSquelchDuration(std::size_t npeers);
 
+    /** Get the slot's state, and each peer's state, message count and
+     * smoothed arrival delay, as JSON.
+     */
+    Json::Value
+    getJson() const;
+
 private:
     /** Reset counts of peers in Selected or Counting state */
     void
@@ -221,7 +245,20 @@ private:
         std::size_t count;       // message count
         time_point expire;       // squelch expiration time
         time_point lastMessage;  // time last message received
+        // smoothed delay behind the first copy of the validator's messages
+        std::optional<std::chrono::microseconds> delay;
     };
+
+    /** Fold a message's arrival delay into the peer's smoothed delay */
+    static void
+    addDelay(PeerInfo& peer, std::optional<duration> delay);
+
+    /** Select the considered peers with the lowest smoothed delay.
+     * Idle peers are excluded and peers without a delay go last.
+     */
+    std::unordered_set<id_t>
+    selectFastest(PublicKey const& validator, time_point now) const;
+
     std::unordered_map<id_t, PeerInfo> peers_;  // peer's data
     // pool of peers considered as the source of messages
     // from validator - peers that reached MIN_MESSAGE_THRESHOLD
@@ -231,6 +268,7 @@ private:
     // last time peers were selected, used to age the slot
     typename clock_type::time_point lastSelected_;
     SlotState state_;                // slot's state
+    bool const selectFastest_;       // select by delay instead of randomly
     SquelchHandler const& handler_;  // squelch/unsquelch handler
     beast::Journal const journal_;   // logging
 };
@@ -258,12 +296,62 @@ Slot<clock_type>::deleteIdlePeer(PublicKey const& validator)
     }
 }
 
+template <typename clock_type>
+void
+Slot<clock_type>::addDelay(PeerInfo& peer, std::optional<duration> delay)
+{
+    using namespace std::chrono;
+    if (!delay)
+        return;
+    auto const d = duration_cast<microseconds>(*delay);
+    if (!peer.delay)
+        peer.delay = d;
+    else
+        peer.delay =
+            (*peer.delay * (DELAY_SMOOTHING - 1) + d) / DELAY_SMOOTHING;
+}
+
+template <typename clock_type>
+std::unordered_set<typename Peer::id_t>
+Slot<clock_type>::selectFastest(PublicKey const& validator, time_point now)
+    const
+{
+    using namespace std::chrono;
+    std::vector<std::pair<microseconds, id_t>> candidates;
+    candidates.reserve(considered_.size());
+    for (auto const candidate : considered_)
+    {
+        auto const& itpeers = peers_.find(candidate);
+        if (itpeers == peers_.end())
+        {
+            JLOG(journal_.error()) << "update: peer not found "
+                                   << Slice(validator) << " " << candidate;
+            continue;
+        }
+        if (now - itpeers->second.lastMessage < IDLED)
+            candidates.emplace_back(
+                itpeers->second.delay.value_or(microseconds::max()),
+                candidate);
+    }
+
+    auto const n =
+        std::min<std::size_t>(candidates.size(), MAX_SELECTED_PEERS);
+    std::partial_sort(
+        candidates.begin(), candidates.begin() + n, candidates.end());
+
+    std::unordered_set<id_t> selected;
+    for (std::size_t i = 0; i < n; ++i)
+        selected.insert(candidates[i].second);
+    return selected;
+}
+
 template <typename clock_type>
 void
 Slot<clock_type>::update(
     PublicKey const& validator,
     id_t id,
-    protocol::MessageType type)
+    protocol::MessageType type,
+    std::optional<duration> delay)
 {
     using namespace std::chrono;
     auto now = clock_type::now();
@@ -273,8 +361,12 @@ Slot<clock_type>::update(
     {
         JLOG(journal_.trace())
             << "update: adding peer " << Slice(validator) << " " << id;
-        peers_.emplace(
-            std::make_pair(id, PeerInfo{PeerState::Counting, 0, now, now}));
+        auto& peer =
+            peers_
+                .emplace(std::make_pair(
+                    id, PeerInfo{PeerState::Counting, 0, now, now, {}}))
+                .first->second;
+        addDelay(peer, delay);
         initCounting();
         return;
     }
@@ -285,6 +377,7 @@ Slot<clock_type>::update(
             << "update: squelch expired " << Slice(validator) << " " << id;
         it->second.state = PeerState::Counting;
         it->second.lastMessage = now;
+        addDelay(it->second, delay);
         initCounting();
         return;
     }
@@ -300,6 +393,7 @@ Slot<clock_type>::update(
         << " " << (type == protocol::mtVALIDATION ? "validation" : "proposal");
 
     peer.lastMessage = now;
+    addDelay(peer, delay);
 
     if (state_ != SlotState::Counting || peer.state == PeerState::Squelched)
         return;
@@ -320,30 +414,37 @@ Slot<clock_type>::update(
 
     if (reachedThreshold_ == MAX_SELECTED_PEERS)
     {
-        // Randomly select MAX_SELECTED_PEERS peers from considered.
-        // Exclude peers that have been idling > IDLED -
+        // Select MAX_SELECTED_PEERS peers from considered, randomly or
+        // by delay. Exclude peers that have been idling > IDLED -
         // it's possible that deleteIdlePeer() has not been called yet.
         // If number of remaining peers != MAX_SELECTED_PEERS
         // then reset the Counting state and let deleteIdlePeer() handle
         // idled peers.
         std::unordered_set<id_t> selected;
         auto const consideredPoolSize = considered_.size();
-        while (selected.size() != MAX_SELECTED_PEERS && considered_.size() != 0)
+        if (selectFastest_)
+            selected = selectFastest(validator, now);
+        else
         {
-            auto i =
-                considered_.size() == 1 ? 0 : rand_int(considered_.size() - 1);
-            auto it = std::next(considered_.begin(), i);
-            auto id = *it;
-            considered_.erase(it);
-            auto const& itpeers = peers_.find(id);
-            if (itpeers == peers_.end())
+            while (selected.size() != MAX_SELECTED_PEERS &&
+                   considered_.size() != 0)
             {
-                JLOG(journal_.error()) << "update: peer not found "
-                                       << Slice(validator) << " " << id;
-                continue;
+                auto i = considered_.size() == 1
+                    ? 0
+                    : rand_int(considered_.size() - 1);
+                auto it = std::next(considered_.begin(), i);
+                auto id = *it;
+                considered_.erase(it);
+                auto const& itpeers = peers_.find(id);
+                if (itpeers == peers_.end())
+                {
+                    JLOG(journal_.error()) << "update: peer not found "
+                                           << Slice(validator) << " " << id;
+                    continue;
+                }
+                if (now - itpeers->second.lastMessage < IDLED)
+                    selected.insert(id);
             }
-            if (now - itpeers->second.lastMessage < IDLED)
-                selected.insert(id);
         }
 
         if (selected.size() != MAX_SELECTED_PEERS)
@@ -524,6 +625,39 @@ Slot<clock_type>::getPeers() const
     return r;
 }
 
+template <typename clock_type>
+Json::Value
+Slot<clock_type>::getJson() const
+{
+    using namespace std::chrono;
+    auto const stateName = [](PeerState state) {
+        switch (state)
+        {
+            case PeerState::Counting:
+                return "counting";
+            case PeerState::Selected:
+                return "selected";
+            case PeerState::Squelched:
+                return "squelched";
+        }
+        return "unknown";
+    };
+
+    Json::Value json(Json::objectValue);
+    json[jss::state] =
+        state_ == SlotState::Counting ? "counting" : "selected";
+    Json::Value& peers = (json[jss::peers] = Json::objectValue);
+    for (auto const& [id, info] : peers_)
+    {
+        Json::Value& peer = (peers[std::to_string(id)] = Json::objectValue);
+        peer[jss::state] = stateName(info.state);
+        peer[jss::count] = static_cast<Json::UInt>(info.count);
+        if (info.delay)
+            peer[jss::delay_us] = std::to_string(info.delay->count());
+    }
+    return json;
+}
+
 /** Slots is a container for validator's Slot and handles Slot update
  * when a message is received from a validator. It also handles Slot aging
  * and checks for peers which are disconnected or stopped relaying the messages.
@@ -543,9 +677,17 @@ public:
     /**
      * @param app Applicaton reference
      * @param handler Squelch/unsquelch implementation
+     * @param selectFastest If true then select the peers that deliver a
+     *     validator's messages first instead of random peers
      */
-    Slots(Logs& logs, SquelchHandler const& handler)
-        : handler_(handler), logs_(logs), journal_(logs.journal("Slots"))
+    Slots(
+        Logs& logs,
+        SquelchHandler const& handler,
+        bool selectFastest = false)
+        : handler_(handler)
+        , logs_(logs)
+        , journal_(logs.journal("Slots"))
+        , selectFastest_(selectFastest)
     {
     }
     ~Slots() = default;
@@ -641,17 +783,27 @@ public:
     void
     deletePeer(id_t id, bool erase);
 
+    /** Get the selection policy and the state of every Slot as JSON */
+    Json::Value
+    getJson() const;
+
 private:
     /** Add message/peer if have not seen this message
      * from the peer. A message is aged after IDLED seconds.
+     * @param delay Set to the time since the message was first added,
+     *     if the message has a key
      * Return true if added */
     bool
-    addPeerMessage(uint256 const& key, id_t id);
+    addPeerMessage(
+        uint256 const& key,
+        id_t id,
+        std::optional<typename clock_type::duration>& delay);
 
     hash_map<PublicKey, Slot<clock_type>> slots_;
     SquelchHandler const& handler_;  // squelch/unsquelch handler
     Logs& logs_;
     beast::Journal const journal_;
+    bool const selectFastest_;
     // Maintain aged container of message/peers. This is required
     // to discard duplicate message from the same peer. A message
     // is aged after IDLED seconds. A message received IDLED seconds
@@ -662,7 +814,10 @@ private:
 
 template <typename clock_type>
 bool
-Slots<clock_type>::addPeerMessage(uint256 const& key, id_t id)
+Slots<clock_type>::addPeerMessage(
+    uint256 const& key,
+    id_t id,
+    std::optional<typename clock_type::duration>& delay)
 {
     beast::expire(peersWithMessage_, reduce_relay::IDLED);
 
@@ -674,6 +829,7 @@ Slots<clock_type>::addPeerMessage(uint256 const& key, id_t id)
             JLOG(journal_.trace())
                 << "addPeerMessage: new " << to_string(key) << " " << id;
             peersWithMessage_.emplace(key, std::unordered_set<id_t>{id});
+            delay = typename clock_type::duration{0};
             return true;
         }
 
@@ -688,6 +844,8 @@ Slots<clock_type>::addPeerMessage(uint256 const& key, id_t id)
             << "addPeerMessage: added " << to_string(key) << " " << id;
 
         it->second.insert(id);
+        // The message is not touched, so it is timed from its first copy
+        delay = clock_type::now() - it.when();
     }
 
     return true;
@@ -701,7 +859,8 @@ Slots<clock_type>::updateSlotAndSquelch(
     id_t id,
     protocol::MessageType type)
 {
-    if (!addPeerMessage(key, id))
+    std::optional<typename clock_type::duration> delay;
+    if (!addPeerMessage(key, id, delay))
         return;
 
     auto it = slots_.find(validator);
@@ -712,12 +871,15 @@ Slots<clock_type>::updateSlotAndSquelch(
         auto it = slots_
                       .emplace(std::make_pair(
                           validator,
-                          Slot<clock_type>(handler_, logs_.journal("Slot"))))
+                          Slot<clock_type>(
+                              handler_,
+                              logs_.journal("Slot"),
+                              selectFastest_)))
                       .first;
-        it->second.update(validator, id, type);
+        it->second.update(validator, id, type, delay);
     }
     else
-        it->second.update(validator, id, type);
+        it->second.update(validator, id, type, delay);
 }
 
 template <typename clock_type>
@@ -728,6 +890,18 @@ Slots<clock_type>::deletePeer(id_t id, bool erase)
         slot.deletePeer(validator, id, erase);
 }
 
+template <typename clock_type>
+Json::Value
+Slots<clock_type>::getJson() const
+{
+    Json::Value json(Json::objectValue);
+    json[jss::policy] = selectFastest_ ? "fastest" : "random";
+    Json::Value& slots = (json[jss::validators] = Json::objectValue);
+    for (auto const& [validator, slot] : slots_)
+        slots[toBase58(TokenType::NodePublic, validator)] = slot.getJson();
+    return json;
+}
+
 template <typename clock_type>
 void
 Slots<clock_type>::deleteIdlePeers()
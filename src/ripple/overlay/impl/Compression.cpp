@@ -0,0 +1,187 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/overlay/Compression.h>
+#include <mutex>
+
+#if RIPPLE_ZSTD_AVAILABLE
+#include <zstd.h>
+#endif
+
+namespace ripple {
+
+namespace compression {
+
+namespace {
+
+std::mutex dictionaryMutex;
+std::shared_ptr<ZstdDictionary const> dictionary;
+
+}  // namespace
+
+std::shared_ptr<ZstdDictionary const>
+zstdDictionary()
+{
+    std::lock_guard lock(dictionaryMutex);
+    return dictionary;
+}
+
+void
+setZstdDictionary(std::shared_ptr<ZstdDictionary const> d)
+{
+    std::lock_guard lock(dictionaryMutex);
+    dictionary = std::move(d);
+}
+
+#if RIPPLE_ZSTD_AVAILABLE
+
+namespace {
+
+// zstd contexts are costly to create, so each thread keeps one of each.
+ZSTD_CCtx*
+compressionContext()
+{
+    thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx{
+        ZSTD_createCCtx(), &ZSTD_freeCCtx};
+    return ctx.get();
+}
+
+ZSTD_DCtx*
+decompressionContext()
+{
+    thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx{
+        ZSTD_createDCtx(), &ZSTD_freeDCtx};
+    return ctx.get();
+}
+
+// Messages are compressed as they are relayed, so favor speed over ratio;
+// the dictionary does most of the work for small messages.
+int constexpr zstdLevel = 3;
+
+}  // namespace
+
+ZstdDictionary::ZstdDictionary(Blob const& data)
+    : id_(ZSTD_getDictID_fromDict(data.data(), data.size()))
+    , cdict_(ZSTD_createCDict(data.data(), data.size(), zstdLevel))
+    , ddict_(ZSTD_createDDict(data.data(), data.size()))
+{
+    // A dictionary without an ID can't be matched with a peer's
+    if (id_ == 0 || !cdict_ || !ddict_)
+    {
+        ZSTD_freeCDict(cdict_);
+        ZSTD_freeDDict(ddict_);
+        Throw<std::runtime_error>("compression: invalid zstd dictionary");
+    }
+}
+
+ZstdDictionary::~ZstdDictionary()
+{
+    ZSTD_freeCDict(cdict_);
+    ZSTD_freeDDict(ddict_);
+}
+
+std::size_t
+zstdCompressBound(std::size_t size)
+{
+    return ZSTD_compressBound(size);
+}
+
+std::size_t
+zstdCompress(
+    void* out,
+    std::size_t outCapacity,
+    void const* in,
+    std::size_t inSize)
+{
+    std::size_t n;
+    if (auto const d = zstdDictionary())
+        n = ZSTD_compress_usingCDict(
+            compressionContext(), out, outCapacity, in, inSize, d->cdict());
+    else
+        n = ZSTD_compressCCtx(
+            compressionContext(), out, outCapacity, in, inSize, zstdLevel);
+    if (ZSTD_isError(n))
+        Throw<std::runtime_error>(
+            std::string("zstd compress: ") + ZSTD_getErrorName(n));
+    return n;
+}
+
+std::size_t
+zstdDecompress(
+    std::uint8_t* out,
+    std::size_t outCapacity,
+    void const* in,
+    std::size_t inSize)
+{
+    std::size_t n;
+    if (auto const d = zstdDictionary())
+        n = ZSTD_decompress_usingDDict(
+            decompressionContext(), out, outCapacity, in, inSize, d->ddict());
+    else
+        n = ZSTD_decompressDCtx(
+            decompressionContext(), out, outCapacity, in, inSize);
+    if (ZSTD_isError(n))
+        Throw<std::runtime_error>(
+            std::string("zstd decompress: ") + ZSTD_getErrorName(n));
+    return n;
+}
+
+#else
+
+namespace {
+
+[[noreturn]] void
+unavailable()
+{
+    Throw<std::runtime_error>("compression: rippled was built without zstd");
+}
+
+}  // namespace
+
+ZstdDictionary::ZstdDictionary(Blob const&)
+    : id_(0), cdict_(nullptr), ddict_(nullptr)
+{
+    unavailable();
+}
+
+ZstdDictionary::~ZstdDictionary() = default;
+
+std::size_t
+zstdCompressBound(std::size_t)
+{
+    unavailable();
+}
+
+std::size_t
+zstdCompress(void*, std::size_t, void const*, std::size_t)
+{
+    unavailable();
+}
+
+std::size_t
+zstdDecompress(std::uint8_t*, std::size_t, void const*, std::size_t)
+{
+    unavailable();
+}
+
+#endif
+
+}  // namespace compression
+
+}  // namespace ripple
@@ -170,6 +170,12 @@ ConnectAttempt::onConnect(error_code ec)
 
     setTimer();
     stream_.set_verify_mode(boost::asio::ssl::verify_none);
+
+    // Offer the session of our last connection to this server, if we
+    // have one, so that it can be resumed without a full handshake.
+    if (auto const session = overlay_.tlsSessions().fetch(remote_endpoint_))
+        SSL_set_session(stream_.native_handle(), session.get());
+
     stream_.async_handshake(
         boost::asio::ssl::stream_base::client,
         strand_.wrap(std::bind(
@@ -191,7 +197,10 @@ ConnectAttempt::onHandshake(error_code ec)
         local_endpoint = socket_.local_endpoint(ec);
     if (ec)
         return fail("onHandshake", ec);
-    JLOG(journal_.trace()) << "onHandshake";
+    JLOG(journal_.trace()) << "onHandshake"
+                           << (SSL_session_reused(stream_.native_handle())
+                                   ? " (resumed)"
+                                   : "");
 
     if (!overlay_.peerFinder().onConnected(
             slot_, beast::IPAddressConversion::from_asio(local_endpoint)))
@@ -285,6 +294,25 @@ ConnectAttempt::onShutdown(error_code ec)
 
 //--------------------------------------------------------------------------
 
+void
+ConnectAttempt::saveSession()
+{
+    // The handshake signature is bound to the TLS finished messages. Those
+    // of a resumed TLS 1.2 session can be replayed unless the extended
+    // master secret was used, so only such sessions, or TLS 1.3 ones, are
+    // kept to resume.
+    auto const ssl = stream_.native_handle();
+    if (SSL_version(ssl) != TLS1_3_VERSION && SSL_get_extms_support(ssl) != 1)
+        return;
+
+    auto const session = SSL_get1_session(ssl);
+    if (session && SSL_SESSION_is_resumable(session))
+        return overlay_.tlsSessions().insert(remote_endpoint_, session);
+
+    if (session)
+        SSL_SESSION_free(session);
+}
+
 void
 ConnectAttempt::processResponse()
 {
@@ -378,6 +406,8 @@ ConnectAttempt::processResponse()
         if (result != PeerFinder::Result::success)
             return fail("Outbound slots full");
 
+        saveSession();
+
         auto const peer = std::make_shared<PeerImp>(
             app_,
             std::move(stream_ptr_),
@@ -106,6 +106,9 @@ private:
     onShutdown(error_code ec);
     void
     processResponse();
+    // Keep the TLS session to resume when we next connect to this server
+    void
+    saveSession();
 
     template <class = void>
     static boost::asio::ip::tcp::endpoint
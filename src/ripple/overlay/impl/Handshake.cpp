@@ -72,6 +72,29 @@ featureEnabled(
     return isFeatureValue(headers, feature, "1");
 }
 
+std::string
+makeZstdFeatureValue(std::uint32_t dictionaryID)
+{
+    return "zstd." + std::to_string(dictionaryID);
+}
+
+compression::Algorithm
+peerCompressionAlgorithm(
+    boost::beast::http::fields const& headers,
+    bool config)
+{
+    using namespace compression;
+    if (!config)
+        return Algorithm::None;
+    if (auto const dictionary = zstdDictionary(); dictionary &&
+        isFeatureValue(
+            headers, FEATURE_COMPR, makeZstdFeatureValue(dictionary->id())))
+        return Algorithm::Zstd;
+    if (isFeatureValue(headers, FEATURE_COMPR, "lz4"))
+        return Algorithm::LZ4;
+    return Algorithm::None;
+}
+
 std::string
 makeFeaturesRequestHeader(
     bool comprEnabled,
@@ -81,7 +104,13 @@ makeFeaturesRequestHeader(
 {
     std::stringstream str;
     if (comprEnabled)
-        str << FEATURE_COMPR << "=lz4" << DELIM_FEATURE;
+    {
+        // Peers that don't hold our dictionary fall back to lz4
+        str << FEATURE_COMPR << "=";
+        if (auto const dictionary = compression::zstdDictionary())
+            str << makeZstdFeatureValue(dictionary->id()) << DELIM_VALUE;
+        str << "lz4" << DELIM_FEATURE;
+    }
     if (ledgerReplayEnabled)
         str << FEATURE_LEDGER_REPLAY << "=1" << DELIM_FEATURE;
     if (txReduceRelayEnabled)
@@ -100,8 +129,15 @@ makeFeaturesResponseHeader(
     bool vpReduceRelayEnabled)
 {
     std::stringstream str;
-    if (comprEnabled && isFeatureValue(headers, FEATURE_COMPR, "lz4"))
-        str << FEATURE_COMPR << "=lz4" << DELIM_FEATURE;
+    if (auto const algorithm = peerCompressionAlgorithm(headers, comprEnabled);
+        algorithm != compression::Algorithm::None)
+    {
+        str << FEATURE_COMPR << "=";
+        if (algorithm == compression::Algorithm::Zstd)
+            str << makeZstdFeatureValue(compression::zstdDictionary()->id())
+                << DELIM_VALUE;
+        str << "lz4" << DELIM_FEATURE;
+    }
     if (ledgerReplayEnabled && featureEnabled(headers, FEATURE_LEDGER_REPLAY))
         str << FEATURE_LEDGER_REPLAY << "=1" << DELIM_FEATURE;
     if (txReduceRelayEnabled && featureEnabled(headers, FEATURE_TXRR))
@@ -146,6 +182,19 @@ hashLastMessage(SSL const* ssl, size_t (*get)(const SSL*, void*, size_t))
 std::optional<uint256>
 makeSharedValue(stream_type& ssl, beast::Journal journal)
 {
+    // The finished messages of a resumed TLS 1.2 session without the
+    // extended master secret can be replayed on another connection, so
+    // they cannot vouch for this one.
+    if (SSL_session_reused(ssl.native_handle()) &&
+        SSL_version(ssl.native_handle()) != TLS1_3_VERSION &&
+        SSL_get_extms_support(ssl.native_handle()) != 1)
+    {
+        JLOG(journal.error())
+            << "Cookie generation: resumed session without extended master "
+               "secret";
+        return std::nullopt;
+    }
+
     auto const cookie1 = hashLastMessage(ssl.native_handle(), SSL_get_finished);
     if (!cookie1)
     {
@@ -22,6 +22,7 @@
 
 #include <ripple/app/main/Application.h>
 #include <ripple/beast/utility/Journal.h>
+#include <ripple/overlay/Compression.h>
 #include <ripple/overlay/impl/ProtocolVersion.h>
 #include <ripple/protocol/BuildInfo.h>
 #include <boost/asio/ip/tcp.hpp>
@@ -52,7 +53,8 @@ using http_response_type =
 
     When there is no man in the middle, both sides will compute the same
     value. In the presence of an attacker, the computed values will be
-    different.
+    different. A resumed TLS 1.2 session that did not use the extended
+    master secret is refused, since its finished messages can be replayed.
 
     @param ssl the SSL/TLS connection state.
     @return A 256-bit value on success; an unseated optional otherwise.
@@ -216,6 +218,24 @@ peerFeatureEnabled(
     return config && peerFeatureEnabled(request, feature, "1", config);
 }
 
+/** Make the compression feature value that names a zstd dictionary
+   @param dictionaryID the zstd dictionary ID
+   @return the feature value, i.e. zstd.<dictionaryID>
+ */
+std::string
+makeZstdFeatureValue(std::uint32_t dictionaryID);
+
+/** Get the compression algorithm to use with a peer. zstd is used if the
+    http header names the zstd dictionary we hold, lz4 otherwise.
+   @param headers request (inbound) or response (outbound) header
+   @param config compression's configuration value
+   @return the compression algorithm, None if compression is disabled
+ */
+compression::Algorithm
+peerCompressionAlgorithm(
+    boost::beast::http::fields const& headers,
+    bool config);
+
 /** Make request header X-Protocol-Ctl value with supported features
    @param comprEnabled if true then compression feature is enabled
    @param ledgerReplayEnabled if true then ledger-replay feature is enabled
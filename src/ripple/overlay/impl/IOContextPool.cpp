@@ -0,0 +1,64 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/core/CurrentThreadName.h>
+#include <ripple/overlay/impl/IOContextPool.h>
+#include <cassert>
+#include <string>
+
+namespace ripple {
+
+IOContextPool::IOContextPool(std::size_t size)
+{
+    assert(size != 0);
+    contexts_.reserve(size);
+    work_.reserve(size);
+    threads_.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        // Each context is run by exactly one thread
+        contexts_.push_back(std::make_unique<boost::asio::io_context>(1));
+        work_.push_back(boost::asio::make_work_guard(*contexts_.back()));
+    }
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        threads_.emplace_back([this, i] {
+            beast::setCurrentThreadName("peer io #" + std::to_string(i));
+            contexts_[i]->run();
+        });
+    }
+}
+
+IOContextPool::~IOContextPool()
+{
+    work_.clear();
+    for (auto& context : contexts_)
+        context->stop();
+    for (auto& thread : threads_)
+        thread.join();
+}
+
+boost::asio::io_context&
+IOContextPool::next()
+{
+    return *contexts_[next_.fetch_add(1, std::memory_order_relaxed) %
+                      contexts_.size()];
+}
+
+}  // namespace ripple
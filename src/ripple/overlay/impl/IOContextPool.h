@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_IOCONTEXTPOOL_H_INCLUDED
+#define RIPPLE_OVERLAY_IOCONTEXTPOOL_H_INCLUDED
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+
+/** A set of io_contexts, each run by its own thread.
+
+    With many peers, every peer strand competes for the one scheduler queue
+    of the application's io_service, and a peer's handlers move from core
+    to core. Spreading peers over several io_contexts, with one thread
+    each, keeps each peer's I/O on one thread and splits the queue.
+
+    Peers are handed out round robin as their sockets are opened.
+*/
+class IOContextPool
+{
+public:
+    /** Create the pool and start its threads. */
+    explicit IOContextPool(std::size_t size);
+
+    /** Stop the io_contexts and join their threads.
+        Anything still running on them should already be closed.
+    */
+    ~IOContextPool();
+
+    IOContextPool(IOContextPool const&) = delete;
+    IOContextPool&
+    operator=(IOContextPool const&) = delete;
+
+    /** Get the io_context for the next socket. Thread safe. */
+    boost::asio::io_context&
+    next();
+
+    std::size_t
+    size() const
+    {
+        return contexts_.size();
+    }
+
+private:
+    using work_guard = boost::asio::executor_work_guard<
+        boost::asio::io_context::executor_type>;
+
+    std::vector<std::unique_ptr<boost::asio::io_context>> contexts_;
+    std::vector<work_guard> work_;
+    std::vector<std::thread> threads_;
+    std::atomic<std::size_t> next_{0};
+};
+
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,77 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/overlay/impl/LastProposals.h>
+
+namespace ripple {
+
+LastProposals::LastProposals(Stopwatch& clock) : clock_(clock)
+{
+}
+
+bool
+LastProposals::superseded(
+    PublicKey const& validator,
+    uint256 const& prevLedger,
+    std::uint32_t proposeSeq) const
+{
+    std::lock_guard lock(mutex_);
+    auto const it = last_.find(validator);
+    return it != last_.end() && it->second.prevLedger == prevLedger &&
+        it->second.proposeSeq > proposeSeq;
+}
+
+void
+LastProposals::verified(
+    PublicKey const& validator,
+    uint256 const& prevLedger,
+    std::uint32_t proposeSeq)
+{
+    auto const now = clock_.now();
+    std::lock_guard lock(mutex_);
+    auto const [it, inserted] =
+        last_.try_emplace(validator, Last{prevLedger, proposeSeq, now});
+    if (!inserted &&
+        (it->second.prevLedger != prevLedger ||
+         it->second.proposeSeq < proposeSeq))
+        it->second = {prevLedger, proposeSeq, now};
+}
+
+void
+LastProposals::sweep(std::chrono::seconds age)
+{
+    auto const now = clock_.now();
+    std::lock_guard lock(mutex_);
+    for (auto it = last_.begin(); it != last_.end();)
+    {
+        if (now - it->second.when > age)
+            it = last_.erase(it);
+        else
+            ++it;
+    }
+}
+
+std::size_t
+LastProposals::size() const
+{
+    std::lock_guard lock(mutex_);
+    return last_.size();
+}
+
+}  // namespace ripple
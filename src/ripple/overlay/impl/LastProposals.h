@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_LASTPROPOSALS_H_INCLUDED
+#define RIPPLE_OVERLAY_LASTPROPOSALS_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/protocol/PublicKey.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace ripple {
+
+/** The newest verified proposal of each trusted validator.
+
+    A proposal is superseded once one with a higher sequence, from the
+    same validator and built on the same ledger, has been verified. Under
+    a burst of relayed proposals, the older positions still waiting in the
+    job queue can then be dropped without checking their signatures. Only
+    verified proposals may be recorded, so a forged one can not hide a
+    genuine one.
+
+    Validators that stop proposing, or whose keys change, are forgotten
+    once their last proposal is older than the age given to sweep.
+*/
+class LastProposals
+{
+public:
+    explicit LastProposals(Stopwatch& clock);
+
+    /** Whether a proposal need not be verified. */
+    bool
+    superseded(
+        PublicKey const& validator,
+        uint256 const& prevLedger,
+        std::uint32_t proposeSeq) const;
+
+    /** Record a proposal whose signature was verified. */
+    void
+    verified(
+        PublicKey const& validator,
+        uint256 const& prevLedger,
+        std::uint32_t proposeSeq);
+
+    /** Forget the validators whose last proposal is older than age. */
+    void
+    sweep(std::chrono::seconds age);
+
+    std::size_t
+    size() const;
+
+private:
+    struct Last
+    {
+        uint256 prevLedger;
+        std::uint32_t proposeSeq;
+        Stopwatch::time_point when;
+    };
+
+    Stopwatch& clock_;
+    mutable std::mutex mutex_;
+    hash_map<PublicKey, Last> last_;
+};
+
+}  // namespace ripple
+
+#endif
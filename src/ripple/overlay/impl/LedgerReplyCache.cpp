@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/chrono.h>
+#include <ripple/overlay/impl/LedgerReplyCache.h>
+#include <ripple/overlay/impl/Tuning.h>
+#include <ripple/protocol/digest.h>
+#include <cassert>
+
+namespace ripple {
+
+LedgerReplyCache::LedgerReplyCache(std::size_t bytes, beast::Journal journal)
+    : nodes_(
+          "LedgerReplyNodes",
+          0,
+          Tuning::ledgerReplyCacheAge,
+          stopwatch(),
+          journal)
+    , replies_(
+          "LedgerReplies",
+          0,
+          Tuning::ledgerReplyCacheAge,
+          stopwatch(),
+          journal)
+{
+    // Most of the budget goes to the nodes, which replies are built from
+    nodes_.setTargetBytes(bytes - bytes / 4);
+    replies_.setTargetBytes(bytes / 4);
+}
+
+uint256
+LedgerReplyCache::nodesKey(
+    uint256 const& mapHash,
+    SHAMapNodeID const& nodeID,
+    int depth,
+    bool fatLeaves)
+{
+    return sha512Half(mapHash, nodeID.getRawString(), depth, fatLeaves);
+}
+
+uint256
+LedgerReplyCache::replyKey(
+    uint256 const& ledgerHash,
+    uint256 const& mapHash,
+    protocol::TMGetLedger const& request,
+    int depth)
+{
+    assert(!request.has_requestcookie());
+
+    sha512_half_hasher h;
+    using beast::hash_append;
+    hash_append(
+        h, ledgerHash, mapHash, static_cast<int>(request.itype()), depth);
+    for (auto const& nodeID : request.nodeids())
+        hash_append(h, nodeID);
+    return static_cast<sha512_half_hasher::result_type>(h);
+}
+
+std::shared_ptr<LedgerReplyCache::Nodes const>
+LedgerReplyCache::fetchNodes(uint256 const& key, LedgerIndex seq)
+{
+    if (auto const entry = nodes_.fetch(key, seq))
+        return {entry, &entry->nodes};
+    return {};
+}
+
+std::shared_ptr<LedgerReplyCache::Nodes const>
+LedgerReplyCache::insertNodes(
+    uint256 const& key,
+    LedgerIndex seq,
+    Nodes&& nodes)
+{
+    auto entry = std::make_shared<NodesEntry>();
+    entry->bytes =
+        sizeof(NodesEntry) + nodes.size() * sizeof(Nodes::value_type);
+    for (auto const& node : nodes)
+        entry->bytes += node.second.size();
+    entry->nodes = std::move(nodes);
+
+    // Another thread may have found the same nodes; share its copy
+    nodes_.canonicalize_replace_client(key, entry, seq);
+    return {entry, &entry->nodes};
+}
+
+std::shared_ptr<Message>
+LedgerReplyCache::fetchReply(uint256 const& key, LedgerIndex seq)
+{
+    if (auto const entry = replies_.fetch(key, seq))
+        return entry->message;
+    return {};
+}
+
+void
+LedgerReplyCache::insertReply(
+    uint256 const& key,
+    LedgerIndex seq,
+    std::shared_ptr<Message> const& reply)
+{
+    auto entry = std::make_shared<ReplyEntry>();
+    entry->message = reply;
+    // The compressed buffer, made on the first send to a peer that wants
+    // one, can take as much again as the uncompressed one
+    entry->bytes = sizeof(ReplyEntry) + sizeof(Message) +
+        2 * reply->getBuffer(compression::Algorithm::None).size();
+    replies_.canonicalize_replace_client(key, entry, seq);
+}
+
+void
+LedgerReplyCache::sweep()
+{
+    nodes_.sweep();
+    replies_.sweep();
+}
+
+}  // namespace ripple
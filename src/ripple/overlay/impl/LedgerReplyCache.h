@@ -0,0 +1,136 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_LEDGERREPLYCACHE_H_INCLUDED
+#define RIPPLE_OVERLAY_LEDGERREPLYCACHE_H_INCLUDED
+
+#include <ripple/basics/Blob.h>
+#include <ripple/basics/TaggedCache.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/overlay/Message.h>
+#include <ripple/protocol/Protocol.h>
+#include <ripple/protocol/messages.h>
+#include <ripple/shamap/SHAMapNodeID.h>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** Keeps the ledger data we served, ready to serve again.
+
+    Syncing peers tend to ask for the same nodes of the same recent
+    ledgers. The serialized nodes found from a node ID are kept by the hash
+    of their map, the node ID, the depth and whether leaves were included,
+    so that the next request for them does not read and serialize them
+    again. Replies to requests without a cookie are kept whole, ready to
+    send to the next peer making the same request.
+
+    Entries are tagged with the sequence of their ledger. Once the cache
+    is over its budget, those of the oldest ledgers are the first to go.
+*/
+class LedgerReplyCache
+{
+public:
+    using Nodes = std::vector<std::pair<SHAMapNodeID, Blob>>;
+
+    /** Create the cache.
+
+        @param bytes The number of bytes the nodes and replies may hold.
+        @param journal Where to log.
+    */
+    LedgerReplyCache(std::size_t bytes, beast::Journal journal);
+
+    /** The key of the nodes found from a node ID. */
+    static uint256
+    nodesKey(
+        uint256 const& mapHash,
+        SHAMapNodeID const& nodeID,
+        int depth,
+        bool fatLeaves);
+
+    /** The key of the reply to a request.
+
+        @param ledgerHash The hash of the ledger the reply is for. Ledgers
+                          that share a map have replies of their own.
+        @param mapHash The hash of the map the request was resolved to.
+        @param request The request, which must not have a cookie.
+        @param depth The depth the nodes are searched to.
+    */
+    static uint256
+    replyKey(
+        uint256 const& ledgerHash,
+        uint256 const& mapHash,
+        protocol::TMGetLedger const& request,
+        int depth);
+
+    std::shared_ptr<Nodes const>
+    fetchNodes(uint256 const& key, LedgerIndex seq);
+
+    /** Keep nodes, returning the copy held by the cache. */
+    std::shared_ptr<Nodes const>
+    insertNodes(uint256 const& key, LedgerIndex seq, Nodes&& nodes);
+
+    std::shared_ptr<Message>
+    fetchReply(uint256 const& key, LedgerIndex seq);
+
+    void
+    insertReply(
+        uint256 const& key,
+        LedgerIndex seq,
+        std::shared_ptr<Message> const& reply);
+
+    /** Drop the entries that are too old, or over the budget. */
+    void
+    sweep();
+
+private:
+    struct NodesEntry
+    {
+        Nodes nodes;
+        std::size_t bytes = 0;
+
+        std::size_t
+        memoryUsage() const
+        {
+            return bytes;
+        }
+    };
+
+    struct ReplyEntry
+    {
+        std::shared_ptr<Message> message;
+        std::size_t bytes = 0;
+
+        std::size_t
+        memoryUsage() const
+        {
+            return bytes;
+        }
+    };
+
+    TaggedCache<uint256, NodesEntry> nodes_;
+    TaggedCache<uint256, ReplyEntry> replies_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -65,14 +65,32 @@ Message::totalSize(::google::protobuf::Message const& message)
 }
 
 void
-Message::compress()
+Message::compress(Algorithm algorithm, std::vector<uint8_t>& compressed)
 {
     using namespace ripple::compression;
     auto const messageBytes = buffer_.size() - headerBytes;
 
     auto type = getType(buffer_.data());
 
+    // With a shared dictionary, zstd compresses even small messages of the
+    // types the dictionary was trained on.
+    bool const dictionary = algorithm == Algorithm::Zstd &&
+        zstdDictionary() != nullptr && [&] {
+            switch (type)
+            {
+                case protocol::mtTRANSACTION:
+                case protocol::mtPROPOSE_LEDGER:
+                case protocol::mtVALIDATION:
+                case protocol::mtLEDGER_DATA:
+                    return true;
+                default:
+                    return false;
+            }
+        }();
+
     bool const compressible = [&] {
+        if (dictionary)
+            return messageBytes > (headerBytesCompressed - headerBytes);
         if (messageBytes <= 70)
             return false;
         switch (type)
@@ -115,23 +133,25 @@ Message::compress()
             payload,
             messageBytes,
             [&](std::size_t inSize) {  // size of required compressed buffer
-                bufferCompressed_.resize(inSize + headerBytesCompressed);
-                return (bufferCompressed_.data() + headerBytesCompressed);
-            });
-
-        if (compressedSize <
-            (messageBytes - (headerBytesCompressed - headerBytes)))
+                compressed.resize(inSize + headerBytesCompressed);
+                return (compressed.data() + headerBytesCompressed);
+            },
+            algorithm);
+
+        if (compressedSize != 0 &&
+            compressedSize <
+                (messageBytes - (headerBytesCompressed - headerBytes)))
         {
-            bufferCompressed_.resize(headerBytesCompressed + compressedSize);
+            compressed.resize(headerBytesCompressed + compressedSize);
             setHeader(
-                bufferCompressed_.data(),
+                compressed.data(),
                 compressedSize,
                 type,
-                Algorithm::LZ4,
+                algorithm,
                 messageBytes);
         }
         else
-            bufferCompressed_.resize(0);
+            compressed.resize(0);
     }
 }
 
@@ -209,15 +229,32 @@ Message::getBufferSize()
 std::vector<uint8_t> const&
 Message::getBuffer(Compressed tryCompressed)
 {
-    if (tryCompressed == Compressed::Off)
-        return buffer_;
+    return getBuffer(
+        tryCompressed == Compressed::On ? Algorithm::LZ4 : Algorithm::None);
+}
 
-    std::call_once(once_flag_, &Message::compress, this);
+std::vector<uint8_t> const&
+Message::getBuffer(Algorithm algorithm)
+{
+    auto get = [&](std::once_flag& flag, std::vector<uint8_t>& compressed)
+        -> std::vector<uint8_t> const& {
+        std::call_once(flag, [&] { compress(algorithm, compressed); });
 
-    if (bufferCompressed_.size() > 0)
-        return bufferCompressed_;
-    else
+        if (compressed.size() > 0)
+            return compressed;
         return buffer_;
+    };
+
+    switch (algorithm)
+    {
+        case Algorithm::LZ4:
+            return get(once_flag_, bufferCompressed_);
+        case Algorithm::Zstd:
+            return get(zstdOnceFlag_, bufferZstd_);
+        case Algorithm::None:
+            break;
+    }
+    return buffer_;
 }
 
 int
@@ -40,6 +40,9 @@
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/utility/in_place_factory.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
 
 namespace ripple {
 
@@ -109,6 +112,13 @@ OverlayImpl::Timer::on_timer(error_code ec)
     if ((++overlay_.timer_count_ % Tuning::checkIdlePeers) == 0)
         overlay_.deleteIdlePeers();
 
+    if (overlay_.ledgerReplyCache_ &&
+        (overlay_.timer_count_ % Tuning::sweepLedgerReplyCache) == 0)
+        overlay_.ledgerReplyCache_->sweep();
+
+    if ((overlay_.timer_count_ % Tuning::sweepLastProposals) == 0)
+        overlay_.lastProposals_.sweep(Tuning::lastProposalAge);
+
     async_wait();
 }
 
@@ -140,7 +150,7 @@ OverlayImpl::OverlayImpl(
     , m_resolver(resolver)
     , next_id_(1)
     , timer_count_(0)
-    , slots_(app.logs(), *this)
+    , slots_(app.logs(), *this, app.config().VP_REDUCE_RELAY_SELECT_FASTEST)
     , m_stats(
           std::bind(&OverlayImpl::collect_metrics, this),
           collector,
@@ -157,6 +167,45 @@ OverlayImpl::OverlayImpl(
           }())
 {
     beast::PropertyStream::Source::add(m_peerFinder.get());
+
+    std::shared_ptr<compression::ZstdDictionary const> dictionary;
+    if (auto const& path = app_.config().COMPRESSION_DICTIONARY;
+        app_.config().COMPRESSION && !path.empty())
+    {
+        std::ifstream ifs(path, std::ios::binary);
+        if (!ifs)
+            Throw<std::runtime_error>(
+                "Unable to read compression dictionary " + path);
+        Blob const data{
+            std::istreambuf_iterator<char>(ifs),
+            std::istreambuf_iterator<char>()};
+        dictionary = std::make_shared<compression::ZstdDictionary>(data);
+        JLOG(journal_.info()) << "Loaded zstd compression dictionary " << path
+                              << " (id " << dictionary->id() << ", "
+                              << data.size() << " bytes)";
+    }
+    compression::setZstdDictionary(std::move(dictionary));
+
+    if (setup_.ioThreads > 0)
+    {
+        peerIO_ = std::make_unique<IOContextPool>(setup_.ioThreads);
+        serverHandler_.setPeerIO(
+            [this]() -> boost::asio::io_context& { return peerIO_->next(); });
+        JLOG(journal_.info())
+            << "Peer connections on " << setup_.ioThreads << " io threads";
+    }
+
+    if (setup_.ledgerReplyCacheMB > 0)
+        ledgerReplyCache_ = std::make_unique<LedgerReplyCache>(
+            megabytes(setup_.ledgerReplyCacheMB), journal_);
+
+    if (!setup_.captureFile.empty())
+    {
+        capture_ = std::make_unique<TrafficCapture>(
+            setup_.captureFile, megabytes(setup_.captureMaxMB));
+        JLOG(journal_.warn())
+            << "Recording peer messages into " << setup_.captureFile;
+    }
 }
 
 Handoff
@@ -407,7 +456,7 @@ OverlayImpl::connect(beast::IP::Endpoint const& remote_endpoint)
 
     auto const p = std::make_shared<ConnectAttempt>(
         app_,
-        io_service_,
+        peerIO_ ? peerIO_->next() : io_service_,
         beast::IPAddressConversion::to_asio_endpoint(remote_endpoint),
         usage,
         setup_.context,
@@ -565,6 +614,22 @@ OverlayImpl::stop()
 //
 //------------------------------------------------------------------------------
 
+static void
+writeHistogram(
+    beast::PropertyStream::Map& parent,
+    std::string const& key,
+    TrafficCount::Histogram const& h)
+{
+    if (h.count() == 0)
+        return;
+    beast::PropertyStream::Map item(key, parent);
+    item["count"] = std::to_string(h.count());
+    item["p50"] = std::to_string(h.percentile(50));
+    item["p90"] = std::to_string(h.percentile(90));
+    item["p99"] = std::to_string(h.percentile(99));
+    item["max"] = std::to_string(h.max());
+}
+
 void
 OverlayImpl::onWrite(beast::PropertyStream::Map& stream)
 {
@@ -580,6 +645,10 @@ OverlayImpl::onWrite(beast::PropertyStream::Map& stream)
             item["messages_in"] = std::to_string(i.messagesIn.load());
             item["bytes_out"] = std::to_string(i.bytesOut.load());
             item["messages_out"] = std::to_string(i.messagesOut.load());
+            writeHistogram(item, "size_in", i.sizeIn);
+            writeHistogram(item, "size_out", i.sizeOut);
+            writeHistogram(item, "queue_us", i.queueDelay);
+            writeHistogram(item, "handler_us", i.handlerTime);
         }
     }
 }
@@ -683,6 +752,49 @@ OverlayImpl::reportTraffic(
     m_traffic.addCount(cat, isInbound, number);
 }
 
+void
+OverlayImpl::reportQueueDelay(
+    TrafficCount::category cat,
+    std::chrono::microseconds delay)
+{
+    m_traffic.addQueueDelay(cat, delay);
+}
+
+void
+OverlayImpl::reportHandlerTime(
+    TrafficCount::category cat,
+    std::chrono::microseconds elapsed)
+{
+    m_traffic.addHandlerTime(cat, elapsed);
+}
+
+Json::Value
+OverlayImpl::trafficMetrics() const
+{
+    auto toJson = [](TrafficCount::Histogram const& h) {
+        Json::Value ret(Json::objectValue);
+        ret[jss::count] = std::to_string(h.count());
+        ret[jss::p50] = std::to_string(h.percentile(50));
+        ret[jss::p90] = std::to_string(h.percentile(90));
+        ret[jss::p99] = std::to_string(h.percentile(99));
+        ret[jss::max] = std::to_string(h.max());
+        return ret;
+    };
+
+    Json::Value ret(Json::objectValue);
+    for (auto const& i : m_traffic.getCounts())
+    {
+        if (!i)
+            continue;
+        auto& item = ret[i.name] = Json::objectValue;
+        item[jss::size_in] = toJson(i.sizeIn);
+        item[jss::size_out] = toJson(i.sizeOut);
+        item[jss::queue_us] = toJson(i.queueDelay);
+        item[jss::handler_us] = toJson(i.handlerTime);
+    }
+    return ret;
+}
+
 Json::Value
 OverlayImpl::crawlShards(bool includePublicKey, std::uint32_t relays)
 {
@@ -1153,14 +1265,14 @@ OverlayImpl::getActivePeers() const
     return ret;
 }
 
-Overlay::PeerSequence
+std::vector<std::shared_ptr<PeerImp>>
 OverlayImpl::getActivePeers(
     std::set<Peer::id_t> const& toSkip,
     std::size_t& active,
     std::size_t& disabled,
     std::size_t& enabledInSkip) const
 {
-    Overlay::PeerSequence ret;
+    std::vector<std::shared_ptr<PeerImp>> ret;
     std::lock_guard lock(mutex_);
 
     active = ids_.size();
@@ -1220,11 +1332,42 @@ OverlayImpl::findPeerByPublicKey(PublicKey const& pubKey)
     return {};
 }
 
+void
+OverlayImpl::prepareBuffers(
+    Message& m,
+    std::vector<std::shared_ptr<PeerImp>> const& peers)
+{
+    using compression::Algorithm;
+
+    bool lz4 = false;
+    bool zstd = false;
+    for (auto const& p : peers)
+    {
+        lz4 = lz4 || p->compressionAlgorithm() == Algorithm::LZ4;
+        zstd = zstd || p->compressionAlgorithm() == Algorithm::Zstd;
+    }
+
+    if (lz4)
+        m.getBuffer(Algorithm::LZ4);
+    if (zstd)
+        m.getBuffer(Algorithm::Zstd);
+}
+
+void
+OverlayImpl::sendTo(
+    std::shared_ptr<Message> const& m,
+    std::vector<std::shared_ptr<PeerImp>> const& peers)
+{
+    prepareBuffers(*m, peers);
+    for (auto const& p : peers)
+        p->send(m);
+}
+
 void
 OverlayImpl::broadcast(protocol::TMProposeSet& m)
 {
     auto const sm = std::make_shared<Message>(m, protocol::mtPROPOSE_LEDGER);
-    for_each([&](std::shared_ptr<PeerImp>&& p) { p->send(sm); });
+    relayTo(sm, [](PeerImp const&) { return true; });
 }
 
 std::set<Peer::id_t>
@@ -1237,9 +1380,8 @@ OverlayImpl::relay(
     {
         auto const sm =
             std::make_shared<Message>(m, protocol::mtPROPOSE_LEDGER, validator);
-        for_each([&](std::shared_ptr<PeerImp>&& p) {
-            if (toSkip->find(p->id()) == toSkip->end())
-                p->send(sm);
+        relayTo(sm, [&](PeerImp const& p) {
+            return toSkip->find(p.id()) == toSkip->end();
         });
         return *toSkip;
     }
@@ -1250,7 +1392,7 @@ void
 OverlayImpl::broadcast(protocol::TMValidation& m)
 {
     auto const sm = std::make_shared<Message>(m, protocol::mtVALIDATION);
-    for_each([sm](std::shared_ptr<PeerImp>&& p) { p->send(sm); });
+    relayTo(sm, [](PeerImp const&) { return true; });
 }
 
 std::set<Peer::id_t>
@@ -1263,9 +1405,8 @@ OverlayImpl::relay(
     {
         auto const sm =
             std::make_shared<Message>(m, protocol::mtVALIDATION, validator);
-        for_each([&](std::shared_ptr<PeerImp>&& p) {
-            if (toSkip->find(p->id()) == toSkip->end())
-                p->send(sm);
+        relayTo(sm, [&](PeerImp const& p) {
+            return toSkip->find(p.id()) == toSkip->end();
         });
         return *toSkip;
     }
@@ -1308,6 +1449,15 @@ OverlayImpl::relay(
     protocol::TMTransaction& m,
     std::set<Peer::id_t> const& toSkip)
 {
+    // Only cluster members act on the verified mark, so the other peers
+    // are sent the transaction without it
+    std::shared_ptr<Message> smVerified;
+    if (m.has_verified())
+    {
+        smVerified = std::make_shared<Message>(m, protocol::mtTRANSACTION);
+        m.clear_verified();
+    }
+
     auto const sm = std::make_shared<Message>(m, protocol::mtTRANSACTION);
     std::size_t total = 0;
     std::size_t disabled = 0;
@@ -1316,11 +1466,26 @@ OverlayImpl::relay(
     // total peers excluding peers in toSkip
     auto peers = getActivePeers(toSkip, total, disabled, enabledInSkip);
     auto minRelay = app_.config().TX_REDUCE_RELAY_MIN_PEERS + disabled;
+    prepareBuffers(*sm, peers);
+
+    if (smVerified)
+    {
+        if (std::none_of(peers.begin(), peers.end(), [](auto const& p) {
+                return p->cluster();
+            }))
+            smVerified.reset();
+        else
+            prepareBuffers(*smVerified, peers);
+    }
+
+    auto const send = [&](std::shared_ptr<PeerImp> const& p) {
+        p->send(smVerified && p->cluster() ? smVerified : sm);
+    };
 
     if (!app_.config().TX_REDUCE_RELAY_ENABLE || total <= minRelay)
     {
         for (auto const& p : peers)
-            p->send(sm);
+            send(p);
         if (app_.config().TX_REDUCE_RELAY_ENABLE ||
             app_.config().TX_REDUCE_RELAY_METRICS)
             txMetrics_.addMetrics(total, toSkip.size(), 0);
@@ -1349,12 +1514,12 @@ OverlayImpl::relay(
         // always relay to a peer with the disabled feature
         if (!p->txReduceRelayEnabled())
         {
-            p->send(sm);
+            send(p);
         }
         else if (enabledAndRelayed < enabledTarget)
         {
             enabledAndRelayed++;
-            p->send(sm);
+            send(p);
         }
         else
         {
@@ -1494,6 +1659,7 @@ OverlayImpl::updateSlotAndSquelch(
                 updateSlotAndSquelch(key, validator, std::move(peers), type);
             });
 
+    std::lock_guard lock(slotsMutex_);
     for (auto id : peers)
         slots_.updateSlotAndSquelch(key, validator, id, type);
 }
@@ -1510,6 +1676,7 @@ OverlayImpl::updateSlotAndSquelch(
             updateSlotAndSquelch(key, validator, peer, type);
         });
 
+    std::lock_guard lock(slotsMutex_);
     slots_.updateSlotAndSquelch(key, validator, peer, type);
 }
 
@@ -1519,6 +1686,7 @@ OverlayImpl::deletePeer(Peer::id_t id)
     if (!strand_.running_in_this_thread())
         return post(strand_, std::bind(&OverlayImpl::deletePeer, this, id));
 
+    std::lock_guard lock(slotsMutex_);
     slots_.deletePeer(id, true);
 }
 
@@ -1528,6 +1696,7 @@ OverlayImpl::deleteIdlePeers()
     if (!strand_.running_in_this_thread())
         return post(strand_, std::bind(&OverlayImpl::deleteIdlePeers, this));
 
+    std::lock_guard lock(slotsMutex_);
     slots_.deleteIdlePeers();
 }
 
@@ -1546,6 +1715,15 @@ setup_Overlay(BasicConfig const& config)
         if (setup.ipLimit < 0)
             Throw<std::runtime_error>("Configured IP limit is invalid");
 
+        set(setup.ioThreads, "io_threads", section);
+        if (setup.ioThreads > 64)
+            Throw<std::runtime_error>(
+                "Configured io_threads is invalid: must be at most 64");
+
+        set(setup.ledgerReplyCacheMB, "ledger_reply_cache", section);
+        set(setup.captureFile, "capture_file", section);
+        set(setup.captureMaxMB, "capture_max_mb", section);
+
         std::string ip;
         set(ip, "public_ip", section);
         if (!ip.empty())
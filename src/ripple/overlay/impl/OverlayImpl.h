@@ -29,7 +29,13 @@
 #include <ripple/overlay/Overlay.h>
 #include <ripple/overlay/Slot.h>
 #include <ripple/overlay/impl/Handshake.h>
+#include <ripple/overlay/impl/IOContextPool.h>
+#include <ripple/overlay/impl/LastProposals.h>
+#include <ripple/overlay/impl/LedgerReplyCache.h>
+#include <ripple/overlay/impl/TLSSessionCache.h>
+#include <ripple/overlay/impl/TrafficCapture.h>
 #include <ripple/overlay/impl/TrafficCount.h>
+#include <ripple/overlay/impl/Tuning.h>
 #include <ripple/overlay/impl/TxMetrics.h>
 #include <ripple/peerfinder/PeerfinderManager.h>
 #include <ripple/resource/ResourceManager.h>
@@ -118,6 +124,7 @@ private:
     std::atomic<uint64_t> jqTransOverflow_{0};
     std::atomic<uint64_t> peerDisconnects_{0};
     std::atomic<uint64_t> peerDisconnectsCharges_{0};
+    std::atomic<uint64_t> sendQueueBytes_{0};
 
     // 'cs' = crawl shards
     std::mutex csMutex_;
@@ -126,10 +133,21 @@ private:
     std::set<std::uint32_t> csIDs_;
 
     reduce_relay::Slots<UptimeClock> slots_;
+    // slots_ is updated on strand_; this guards it against vpMetrics()
+    std::mutex mutable slotsMutex_;
 
     // Transaction reduce-relay metrics
     metrics::TxMetrics txMetrics_;
 
+    // Ledger data served to peers, kept to serve again. Null if disabled.
+    std::unique_ptr<LedgerReplyCache> ledgerReplyCache_;
+
+    // Records the messages received from peers. Null unless configured.
+    std::unique_ptr<TrafficCapture> capture_;
+
+    // The TLS sessions of the peers we connected out to, to resume
+    TLSSessionCache tlsSessions_{Tuning::tlsSessions};
+
     // A message with the list of manifests we send to peers
     std::shared_ptr<Message> manifestMessage_;
     // Used to track whether we need to update the cached list of manifests
@@ -137,6 +155,8 @@ private:
     // Protects the message and the sequence list of manifests
     std::mutex manifestLock_;
 
+    LastProposals lastProposals_{stopwatch()};
+
     //--------------------------------------------------------------------------
 
 public:
@@ -208,7 +228,7 @@ public:
            feature enabled and in toSkip
        @return active peers less peers in toSkip
      */
-    PeerSequence
+    std::vector<std::shared_ptr<PeerImp>>
     getActivePeers(
         std::set<Peer::id_t> const& toSkip,
         std::size_t& active,
@@ -299,6 +319,24 @@ public:
         }
     }
 
+    /** Send a message to each active peer that satisfies a predicate.
+
+        The peers are picked and the buffers they will write are made
+        once, on the calling thread, before the message is posted to each
+        peer's strand. No strand then waits for another to compress it.
+    */
+    template <class Predicate>
+    void
+    relayTo(std::shared_ptr<Message> const& m, Predicate&& pred) const
+    {
+        std::vector<std::shared_ptr<PeerImp>> peers;
+        for_each([&](std::shared_ptr<PeerImp>&& p) {
+            if (pred(*p))
+                peers.push_back(std::move(p));
+        });
+        sendTo(m, peers);
+    }
+
     // Called when TMManifests is received from a peer
     void
     onManifests(
@@ -347,9 +385,59 @@ public:
     static std::string
     makePrefix(std::uint32_t id);
 
+    /** Make the compressed buffers of a message that peers will write. */
+    static void
+    prepareBuffers(
+        Message& m,
+        std::vector<std::shared_ptr<PeerImp>> const& peers);
+
+    /** Make the buffers of a message, then send it to peers. */
+    static void
+    sendTo(
+        std::shared_ptr<Message> const& m,
+        std::vector<std::shared_ptr<PeerImp>> const& peers);
+
     void
     reportTraffic(TrafficCount::category cat, bool isInbound, int bytes);
 
+    /** The recorder of received messages, or null if not capturing. */
+    TrafficCapture*
+    capture()
+    {
+        return capture_.get();
+    }
+
+    /** The cache of ledger data served to peers, or null if disabled. */
+    LedgerReplyCache*
+    ledgerReplyCache()
+    {
+        return ledgerReplyCache_.get();
+    }
+
+    /** The newest verified proposal of each trusted validator. */
+    LastProposals&
+    lastProposals()
+    {
+        return lastProposals_;
+    }
+
+    /** The TLS sessions to offer when connecting out to peers. */
+    TLSSessionCache&
+    tlsSessions()
+    {
+        return tlsSessions_;
+    }
+
+    void
+    reportQueueDelay(
+        TrafficCount::category cat,
+        std::chrono::microseconds delay);
+
+    void
+    reportHandlerTime(
+        TrafficCount::category cat,
+        std::chrono::microseconds elapsed);
+
     void
     incJqTransOverflow() override
     {
@@ -386,6 +474,25 @@ public:
         return peerDisconnectsCharges_;
     }
 
+    /** Called by peers as messages enter and leave their send queues. */
+    void
+    addSendQueueBytes(std::uint64_t bytes)
+    {
+        sendQueueBytes_ += bytes;
+    }
+
+    void
+    removeSendQueueBytes(std::uint64_t bytes)
+    {
+        sendQueueBytes_ -= bytes;
+    }
+
+    std::uint64_t
+    getSendQueueBytes() const override
+    {
+        return sendQueueBytes_;
+    }
+
     std::optional<std::uint32_t>
     networkID() const override
     {
@@ -441,6 +548,16 @@ public:
         return txMetrics_.json();
     }
 
+    Json::Value
+    vpMetrics() const override
+    {
+        std::lock_guard lock(slotsMutex_);
+        return slots_.getJson();
+    }
+
+    Json::Value
+    trafficMetrics() const override;
+
     /** Add tx reduce-relay metrics. */
     template <typename... Args>
     void
@@ -580,12 +697,24 @@ private:
             , bytesOut(collector->make_gauge(name, "Bytes_Out"))
             , messagesIn(collector->make_gauge(name, "Messages_In"))
             , messagesOut(collector->make_gauge(name, "Messages_Out"))
+            , sizeInP50(collector->make_gauge(name, "Size_In_P50"))
+            , sizeInP99(collector->make_gauge(name, "Size_In_P99"))
+            , queueDelayP50(collector->make_gauge(name, "Queue_Delay_P50"))
+            , queueDelayP99(collector->make_gauge(name, "Queue_Delay_P99"))
+            , handlerTimeP50(collector->make_gauge(name, "Handler_Time_P50"))
+            , handlerTimeP99(collector->make_gauge(name, "Handler_Time_P99"))
         {
         }
         beast::insight::Gauge bytesIn;
         beast::insight::Gauge bytesOut;
         beast::insight::Gauge messagesIn;
         beast::insight::Gauge messagesOut;
+        beast::insight::Gauge sizeInP50;
+        beast::insight::Gauge sizeInP99;
+        beast::insight::Gauge queueDelayP50;
+        beast::insight::Gauge queueDelayP99;
+        beast::insight::Gauge handlerTimeP50;
+        beast::insight::Gauge handlerTimeP99;
     };
 
     struct Stats
@@ -610,6 +739,10 @@ private:
     Stats m_stats;
     std::mutex m_statsMutex;
 
+    // Runs the peer connections when [overlay] io_threads is set. Declared
+    // last so its threads are joined before any other member is destroyed.
+    std::unique_ptr<IOContextPool> peerIO_;
+
 private:
     void
     collect_metrics()
@@ -624,6 +757,18 @@ private:
             m_stats.trafficGauges[i].bytesOut = counts[i].bytesOut;
             m_stats.trafficGauges[i].messagesIn = counts[i].messagesIn;
             m_stats.trafficGauges[i].messagesOut = counts[i].messagesOut;
+            m_stats.trafficGauges[i].sizeInP50 =
+                counts[i].sizeIn.percentile(50);
+            m_stats.trafficGauges[i].sizeInP99 =
+                counts[i].sizeIn.percentile(99);
+            m_stats.trafficGauges[i].queueDelayP50 =
+                counts[i].queueDelay.percentile(50);
+            m_stats.trafficGauges[i].queueDelayP99 =
+                counts[i].queueDelay.percentile(99);
+            m_stats.trafficGauges[i].handlerTimeP50 =
+                counts[i].handlerTime.percentile(50);
+            m_stats.trafficGauges[i].handlerTimeP99 =
+                counts[i].handlerTime.percentile(99);
         }
         m_stats.peerDisconnects = getPeerDisconnect();
     }
@@ -39,6 +39,7 @@
 #include <ripple/overlay/impl/PeerImp.h>
 #include <ripple/overlay/impl/Tuning.h>
 #include <ripple/overlay/predicates.h>
+#include <ripple/protocol/HashPrefix.h>
 #include <ripple/protocol/digest.h>
 
 #include <boost/algorithm/string.hpp>
@@ -100,14 +101,8 @@ PeerImp::PeerImp(
     , slot_(slot)
     , request_(std::move(request))
     , headers_(request_)
-    , compressionEnabled_(
-          peerFeatureEnabled(
-              headers_,
-              FEATURE_COMPR,
-              "lz4",
-              app_.config().COMPRESSION)
-              ? Compressed::On
-              : Compressed::Off)
+    , compressionAlgorithm_(
+          peerCompressionAlgorithm(headers_, app_.config().COMPRESSION))
     , txReduceRelayEnabled_(peerFeatureEnabled(
           headers_,
           FEATURE_TXRR,
@@ -123,7 +118,9 @@ PeerImp::PeerImp(
     , ledgerReplayMsgHandler_(app, app.getLedgerReplayer())
 {
     JLOG(journal_.info()) << "compression enabled "
-                          << (compressionEnabled_ == Compressed::On)
+                          << (compressionAlgorithm_ != Algorithm::None)
+                          << " zstd enabled "
+                          << (compressionAlgorithm_ == Algorithm::Zstd)
                           << " vp reduce-relay enabled "
                           << vpReduceRelayEnabled_
                           << " tx reduce-relay enabled "
@@ -135,6 +132,7 @@ PeerImp::~PeerImp()
 {
     const bool inCluster{cluster()};
 
+    overlay_.removeSendQueueBytes(sendQueueBytes_);
     overlay_.deletePeer(id_);
     overlay_.onPeerDeactivate(id_);
     overlay_.peerFinder().on_closed(slot_);
@@ -251,12 +249,13 @@ PeerImp::send(std::shared_ptr<Message> const& m)
     if (validator && !squelch_.expireSquelch(*validator))
         return;
 
+    auto const size = m->getBuffer(compressionAlgorithm_).size();
     overlay_.reportTraffic(
         safe_cast<TrafficCount::category>(m->getCategory()),
         false,
-        static_cast<int>(m->getBuffer(compressionEnabled_).size()));
+        static_cast<int>(size));
 
-    auto sendq_size = send_queue_.size();
+    auto sendq_size = send_queue_.size() + sending_.size();
 
     if (sendq_size < Tuning::targetSendQueue)
     {
@@ -273,15 +272,63 @@ PeerImp::send(std::shared_ptr<Message> const& m)
              << " sendq: " << sendq_size;
     }
 
-    send_queue_.push(m);
+    send_queue_.push(SendQueue::laneOf(m->getCategory()), m, size);
+    sendQueueBytes_ += size;
+    overlay_.addSendQueueBytes(size);
 
-    if (sendq_size != 0)
+    // A write is already outstanding
+    if (!sending_.empty())
         return;
 
+    writeSendQueue();
+}
+
+void
+PeerImp::writeSendQueue()
+{
+    assert(!send_queue_.empty() && sending_.empty());
+
+    // Take as many of the queued messages as fit in one write, in the
+    // order the lanes are scheduled. Nothing waits for more messages to
+    // arrive: those that queue up while a write is outstanding simply go
+    // out together in the next one.
+    auto entry = send_queue_.pop();
+    std::size_t bytes = entry.bytes;
+    sending_.push_back(std::move(entry.message));
+    while (!send_queue_.empty() &&
+           sending_.size() < Tuning::sendBatchMessages)
+    {
+        if (bytes + send_queue_.front().bytes > Tuning::sendBatchBytes)
+            break;
+        entry = send_queue_.pop();
+        bytes += entry.bytes;
+        sending_.push_back(std::move(entry.message));
+    }
+    sendingBytes_ = bytes;
+
+    // The TLS stream encrypts and writes one buffer at a time, so the
+    // messages are copied into a single buffer rather than gathered.
+    boost::asio::const_buffer buffer;
+    if (sending_.size() == 1)
+    {
+        buffer = boost::asio::buffer(
+            sending_.front()->getBuffer(compressionAlgorithm_));
+    }
+    else
+    {
+        write_buffer_.clear();
+        write_buffer_.reserve(bytes);
+        for (auto const& m : sending_)
+        {
+            auto const& b = m->getBuffer(compressionAlgorithm_);
+            write_buffer_.insert(write_buffer_.end(), b.begin(), b.end());
+        }
+        buffer = boost::asio::buffer(write_buffer_);
+    }
+
     boost::asio::async_write(
         stream_,
-        boost::asio::buffer(
-            send_queue_.front()->getBuffer(compressionEnabled_)),
+        buffer,
         bind_executor(
             strand_,
             std::bind(
@@ -418,6 +465,16 @@ PeerImp::json()
     ret[jss::uptime] = static_cast<Json::UInt>(
         std::chrono::duration_cast<std::chrono::seconds>(uptime()).count());
 
+    {
+        auto& sendq = ret[jss::send_queue] = Json::objectValue;
+        sendq[jss::consensus] = static_cast<Json::UInt>(
+            send_queue_.size(SendQueue::Lane::consensus));
+        sendq[jss::transactions] = static_cast<Json::UInt>(
+            send_queue_.size(SendQueue::Lane::transactions));
+        sendq[jss::bulk] = static_cast<Json::UInt>(
+            send_queue_.size(SendQueue::Lane::bulk));
+    }
+
     std::uint32_t minSeq, maxSeq;
     ledgerRange(minSeq, maxSeq);
 
@@ -642,7 +699,7 @@ PeerImp::gracefulClose()
     assert(socket_.is_open());
     assert(!gracefulClose_);
     gracefulClose_ = true;
-    if (send_queue_.size() > 0)
+    if (!send_queue_.empty() || !sending_.empty())
         return;
     setTimer();
     stream_.async_shutdown(bind_executor(
@@ -964,22 +1021,15 @@ PeerImp::onWriteMessage(error_code ec, std::size_t bytes_transferred)
 
     metrics_.sent.add_message(bytes_transferred);
 
-    assert(!send_queue_.empty());
-    send_queue_.pop();
+    assert(!sending_.empty());
+    sendQueueBytes_ -= sendingBytes_;
+    overlay_.removeSendQueueBytes(sendingBytes_);
+    sending_.clear();
+    sendingBytes_ = 0;
     if (!send_queue_.empty())
     {
         // Timeout on writes only
-        return boost::asio::async_write(
-            stream_,
-            boost::asio::buffer(
-                send_queue_.front()->getBuffer(compressionEnabled_)),
-            bind_executor(
-                strand_,
-                std::bind(
-                    &PeerImp::onWriteMessage,
-                    shared_from_this(),
-                    std::placeholders::_1,
-                    std::placeholders::_2)));
+        return writeSendQueue();
     }
 
     if (gracefulClose_)
@@ -1018,6 +1068,11 @@ PeerImp::onMessageBegin(
     fee_ = Resource::feeLightPeer;
     auto const category = TrafficCount::categorize(*m, type, true);
     overlay_.reportTraffic(category, true, static_cast<int>(size));
+    messageCategory_ = category;
+    messageReceived_ = clock_type::now();
+    messageDeferred_ = false;
+    if (auto const capture = overlay_.capture())
+        capture->record(id_, type, *m);
     using namespace protocol;
     if ((type == MessageType::mtTRANSACTION ||
          type == MessageType::mtHAVE_TRANSACTIONS ||
@@ -1046,6 +1101,13 @@ PeerImp::onMessageEnd(
 {
     load_event_.reset();
     charge(fee_);
+
+    // A message handed to a job is timed when the job runs
+    if (!messageDeferred_)
+        overlay_.reportHandlerTime(
+            messageCategory_,
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                clock_type::now() - messageReceived_));
 }
 
 void
@@ -1063,9 +1125,11 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMManifests> const& m)
         fee_ = Resource::feeMediumBurdenPeer;
 
     app_.getJobQueue().addJob(
-        jtMANIFEST, "receiveManifests", [this, that = shared_from_this(), m]() {
+        jtMANIFEST,
+        "receiveManifests",
+        measured([this, that = shared_from_this(), m]() {
             overlay_.onManifests(m, that);
-        });
+        }));
 }
 
 void
@@ -1535,12 +1599,27 @@ PeerImp::handleTransaction(
         return;
     }
 
-    SerialIter sit(makeSlice(m->rawtransaction()));
+    auto const raw = makeSlice(m->rawtransaction());
 
     try
     {
-        auto stx = std::make_shared<STTx const>(sit);
-        uint256 txID = stx->getTransactionID();
+        // A transaction's ID is the hash of its canonical serialization, so
+        // if hashing the bytes as received yields a known ID, these are the
+        // very bytes of a transaction we have already parsed. Relayed
+        // duplicates are common, so we avoid deserializing them again.
+        uint256 txID = sha512Half(HashPrefix::transactionID, raw);
+
+        std::shared_ptr<STTx const> stx;
+        auto const parse = [&]() {
+            SerialIter sit(raw);
+            stx = std::make_shared<STTx const>(sit);
+        };
+
+        if (!app_.getHashRouter().contains(txID))
+        {
+            parse();
+            txID = stx->getTransactionID();
+        }
 
         int flags;
         constexpr std::chrono::seconds tx_interval = 10s;
@@ -1562,6 +1641,12 @@ PeerImp::handleTransaction(
             return;
         }
 
+        if (!stx)
+        {
+            parse();
+            assert(stx->getTransactionID() == txID);
+        }
+
         JLOG(p_journal_.debug()) << "Got tx " << txID;
 
         bool checkSignature = true;
@@ -1580,6 +1665,14 @@ PeerImp::handleTransaction(
                 // check each transaction, regardless of source
                 checkSignature = false;
             }
+            else if (
+                app_.config().CLUSTER_VERIFY && m->has_verified() &&
+                m->verified())
+            {
+                // Unless the cluster agreed to share those checks, and
+                // the member checked this transaction before relaying it
+                checkSignature = false;
+            }
         }
 
         if (app_.getLedgerMaster().getValidatedLedgerAge() > 4min)
@@ -1599,13 +1692,13 @@ PeerImp::handleTransaction(
             app_.getJobQueue().addJob(
                 jtTRANSACTION,
                 "recvTransaction->checkTransaction",
-                [weak = std::weak_ptr<PeerImp>(shared_from_this()),
-                 flags,
-                 checkSignature,
-                 stx]() {
+                measured([weak = std::weak_ptr<PeerImp>(shared_from_this()),
+                          flags,
+                          checkSignature,
+                          stx]() {
                     if (auto peer = weak.lock())
                         peer->checkTransaction(flags, checkSignature, stx);
-                });
+                }));
         }
     }
     catch (std::exception const& ex)
@@ -1706,10 +1799,11 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMGetLedger> const& m)
 
     // Queue a job to process the request
     std::weak_ptr<PeerImp> weak = shared_from_this();
-    app_.getJobQueue().addJob(jtLEDGER_REQ, "recvGetLedger", [weak, m]() {
-        if (auto peer = weak.lock())
-            peer->processLedgerRequest(m);
-    });
+    app_.getJobQueue().addJob(
+        jtLEDGER_REQ, "recvGetLedger", measured([weak, m]() {
+            if (auto peer = weak.lock())
+                peer->processLedgerRequest(m);
+        }));
 }
 
 void
@@ -1725,7 +1819,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMProofPathRequest> const& m)
     fee_ = Resource::feeMediumBurdenPeer;
     std::weak_ptr<PeerImp> weak = shared_from_this();
     app_.getJobQueue().addJob(
-        jtREPLAY_REQ, "recvProofPathRequest", [weak, m]() {
+        jtREPLAY_REQ, "recvProofPathRequest", measured([weak, m]() {
             if (auto peer = weak.lock())
             {
                 auto reply =
@@ -1743,7 +1837,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMProofPathRequest> const& m)
                         reply, protocol::mtPROOF_PATH_RESPONSE));
                 }
             }
-        });
+        }));
 }
 
 void
@@ -1774,7 +1868,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMReplayDeltaRequest> const& m)
     fee_ = Resource::feeMediumBurdenPeer;
     std::weak_ptr<PeerImp> weak = shared_from_this();
     app_.getJobQueue().addJob(
-        jtREPLAY_REQ, "recvReplayDeltaRequest", [weak, m]() {
+        jtREPLAY_REQ, "recvReplayDeltaRequest", measured([weak, m]() {
             if (auto peer = weak.lock())
             {
                 auto reply =
@@ -1792,7 +1886,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMReplayDeltaRequest> const& m)
                         reply, protocol::mtREPLAY_DELTA_RESPONSE));
                 }
             }
-        });
+        }));
 }
 
 void
@@ -1895,13 +1989,13 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMLedgerData> const& m)
     {
         std::weak_ptr<PeerImp> weak{shared_from_this()};
         app_.getJobQueue().addJob(
-            jtTXN_DATA, "recvPeerData", [weak, ledgerHash, m]() {
+            jtTXN_DATA, "recvPeerData", measured([weak, ledgerHash, m]() {
                 if (auto peer = weak.lock())
                 {
                     peer->app_.getInboundTransactions().gotData(
                         ledgerHash, peer, m);
                 }
-            });
+            }));
         return;
     }
 
@@ -2008,10 +2102,10 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMProposeSet> const& m)
     app_.getJobQueue().addJob(
         isTrusted ? jtPROPOSAL_t : jtPROPOSAL_ut,
         "recvPropose->checkPropose",
-        [weak, isTrusted, m, proposal]() {
+        measured([weak, isTrusted, m, proposal]() {
             if (auto peer = weak.lock())
                 peer->checkPropose(isTrusted, m, proposal);
-        });
+        }));
 }
 
 void
@@ -2531,6 +2625,31 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
 
     try
     {
+        // Most validations reach us from several peers, so look for a
+        // duplicate before paying to deserialize the message.
+        auto const key = sha512Half(makeSlice(m->validation()));
+
+        if (auto [added, relayed] =
+                app_.getHashRouter().addSuppressionPeerWithStatus(key, id_);
+            !added)
+        {
+            // Count unique messages (Slots has it's own 'HashRouter'), which a
+            // peer receives within IDLED seconds since the message has been
+            // relayed. Wait WAIT_ON_BOOTUP time to let the server establish
+            // connections to peers. The message matches one already taken
+            // apart, so only the signing key is read from it.
+            if (reduceRelayReady() && relayed &&
+                (stopwatch().now() - *relayed) < reduce_relay::IDLED)
+            {
+                if (auto const signer = STValidation::peekSignerPublic(
+                        makeSlice(m->validation())))
+                    overlay_.updateSlotAndSquelch(
+                        key, *signer, id_, protocol::mtVALIDATION);
+            }
+            JLOG(p_journal_.trace()) << "Validation: duplicate";
+            return;
+        }
+
         auto const closeTime = app_.timeKeeper().closeTime();
 
         std::shared_ptr<STValidation> val;
@@ -2557,9 +2676,6 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
             return;
         }
 
-        // RH TODO: when isTrusted = false we should probably also cache a key
-        // suppression for 30 seconds to avoid doing a relatively expensive
-        // lookup every time a spam packet is received
         auto const isTrusted =
             app_.validators().trusted(val->getSignerPublic());
 
@@ -2569,24 +2685,6 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
         if (!isTrusted && app_.config().RELAY_UNTRUSTED_VALIDATIONS == -1)
             return;
 
-        auto key = sha512Half(makeSlice(m->validation()));
-
-        if (auto [added, relayed] =
-                app_.getHashRouter().addSuppressionPeerWithStatus(key, id_);
-            !added)
-        {
-            // Count unique messages (Slots has it's own 'HashRouter'), which a
-            // peer receives within IDLED seconds since the message has been
-            // relayed. Wait WAIT_ON_BOOTUP time to let the server establish
-            // connections to peers.
-            if (reduceRelayReady() && relayed &&
-                (stopwatch().now() - *relayed) < reduce_relay::IDLED)
-                overlay_.updateSlotAndSquelch(
-                    key, val->getSignerPublic(), id_, protocol::mtVALIDATION);
-            JLOG(p_journal_.trace()) << "Validation: duplicate";
-            return;
-        }
-
         if (!isTrusted && (tracking_.load() == Tracking::diverged))
         {
             JLOG(p_journal_.debug())
@@ -2600,7 +2698,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
 
 #ifdef DEBUG
                 ret += " " +
-                    std::to_string(val->getFieldU32(sfLedgerSequence)) + ": " +
+                    std::to_string(val->getLedgerSeq()) + ": " +
                     to_string(val->getNodeID());
 #endif
 
@@ -2611,10 +2709,10 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
             app_.getJobQueue().addJob(
                 isTrusted ? jtVALIDATION_t : jtVALIDATION_ut,
                 name,
-                [weak, val, m, key]() {
+                measured([weak, val, m, key]() {
                     if (auto peer = weak.lock())
                         peer->checkValidation(val, key, m);
-                });
+                }));
         }
         else
         {
@@ -2641,7 +2739,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMGetObjectByHash> const& m)
     if (packet.query())
     {
         // this is a query
-        if (send_queue_.size() >= Tuning::dropSendQueue)
+        if (send_queue_.size(SendQueue::Lane::bulk) >= Tuning::dropSendQueue)
         {
             JLOG(p_journal_.debug()) << "GetObject: Large send queue";
             return;
@@ -2665,10 +2763,10 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMGetObjectByHash> const& m)
 
             std::weak_ptr<PeerImp> weak = shared_from_this();
             app_.getJobQueue().addJob(
-                jtREQUESTED_TXN, "doTransactions", [weak, m]() {
+                jtREQUESTED_TXN, "doTransactions", measured([weak, m]() {
                     if (auto peer = weak.lock())
                         peer->doTransactions(m);
-                });
+                }));
             return;
         }
 
@@ -2805,10 +2903,10 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMHaveTransactions> const& m)
 
     std::weak_ptr<PeerImp> weak = shared_from_this();
     app_.getJobQueue().addJob(
-        jtMISSING_TXN, "handleHaveTransactions", [weak, m]() {
+        jtMISSING_TXN, "handleHaveTransactions", measured([weak, m]() {
             if (auto peer = weak.lock())
                 peer->handleHaveTransactions(m);
-        });
+        }));
 }
 
 void
@@ -2985,9 +3083,11 @@ PeerImp::doFetchPack(const std::shared_ptr<protocol::TMGetObjectByHash>& packet)
     auto elapsed = UptimeClock::now();
     auto const pap = &app_;
     app_.getJobQueue().addJob(
-        jtPACK, "MakeFetchPack", [pap, weak, packet, hash, elapsed]() {
+        jtPACK,
+        "MakeFetchPack",
+        measured([pap, weak, packet, hash, elapsed]() {
             pap->getLedgerMaster().makeFetchPack(weak, packet, hash, elapsed);
-        });
+        }));
 }
 
 void
@@ -3132,13 +3232,33 @@ PeerImp::checkPropose(
 
     assert(packet);
 
-    if (!cluster() && !peerPos.checkSign())
+    auto const& proposal = peerPos.proposal();
+    if (isTrusted &&
+        overlay_.lastProposals().superseded(
+            peerPos.publicKey(), proposal.prevLedger(), proposal.proposeSeq()))
     {
-        JLOG(p_journal_.warn()) << "Proposal fails sig check";
-        charge(Resource::feeInvalidSignature);
+        JLOG(p_journal_.trace()) << "Proposal: superseded";
         return;
     }
 
+    // Proposals from the cluster are taken without checking, so they are
+    // not recorded as verified
+    if (!cluster())
+    {
+        if (!peerPos.checkSign())
+        {
+            JLOG(p_journal_.warn()) << "Proposal fails sig check";
+            charge(Resource::feeInvalidSignature);
+            return;
+        }
+
+        if (isTrusted)
+            overlay_.lastProposals().verified(
+                peerPos.publicKey(),
+                proposal.prevLedger(),
+                proposal.proposeSeq());
+    }
+
     bool relay;
 
     if (isTrusted)
@@ -3476,7 +3596,7 @@ PeerImp::processLedgerRequest(std::shared_ptr<protocol::TMGetLedger> const& m)
     }
     else
     {
-        if (send_queue_.size() >= Tuning::dropSendQueue)
+        if (send_queue_.size(SendQueue::Lane::bulk) >= Tuning::dropSendQueue)
         {
             JLOG(p_journal_.debug())
                 << "processLedgerRequest: Large send queue";
@@ -3538,7 +3658,33 @@ PeerImp::processLedgerRequest(std::shared_ptr<protocol::TMGetLedger> const& m)
         auto const queryDepth{
             m->has_querydepth() ? m->querydepth() : (isHighLatency() ? 2 : 1)};
 
+        // Serve a request another peer made before from the cache. Requests
+        // with a cookie are relayed for one peer and are not kept whole.
+        auto const cache = overlay_.ledgerReplyCache();
+        auto const mapHash = map->getHash().as_uint256();
+        auto const seq = ledger ? ledger->info().seq
+                                : app_.getLedgerMaster().getValidLedgerIndex();
+        std::optional<uint256> replyKey;
+        if (cache && !m->has_requestcookie())
+        {
+            // The reply names its ledger, or the transaction set itself
+            replyKey = LedgerReplyCache::replyKey(
+                ledger ? ledger->info().hash : mapHash,
+                mapHash,
+                *m,
+                queryDepth);
+            if (auto const reply = cache->fetchReply(*replyKey, seq))
+            {
+                JLOG(p_journal_.trace())
+                    << "processLedgerRequest: Cached reply";
+                send(reply);
+                return;
+            }
+        }
+
         std::vector<std::pair<SHAMapNodeID, Blob>> data;
+        // Whether every node asked for was found, so the reply can be kept
+        bool complete = true;
 
         for (int i = 0; i < m->nodeids_size() &&
              ledgerData.nodes_size() < Tuning::softMaxReplyNodes;
@@ -3546,18 +3692,42 @@ PeerImp::processLedgerRequest(std::shared_ptr<protocol::TMGetLedger> const& m)
         {
             auto const shaMapNodeId{deserializeSHAMapNodeID(m->nodeids(i))};
 
-            data.clear();
-            data.reserve(Tuning::softMaxReplyNodes);
-
             try
             {
-                if (map->getNodeFat(*shaMapNodeId, data, fatLeaves, queryDepth))
+                std::shared_ptr<LedgerReplyCache::Nodes const> nodes;
+                std::optional<uint256> nodesKey;
+                if (cache)
                 {
-                    JLOG(p_journal_.trace())
-                        << "processLedgerRequest: getNodeFat got "
-                        << data.size() << " nodes";
+                    nodesKey = LedgerReplyCache::nodesKey(
+                        mapHash, *shaMapNodeId, queryDepth, fatLeaves);
+                    nodes = cache->fetchNodes(*nodesKey, seq);
+                }
+
+                if (!nodes)
+                {
+                    data.clear();
+                    data.reserve(Tuning::softMaxReplyNodes);
+
+                    if (map->getNodeFat(
+                            *shaMapNodeId, data, fatLeaves, queryDepth))
+                    {
+                        JLOG(p_journal_.trace())
+                            << "processLedgerRequest: getNodeFat got "
+                            << data.size() << " nodes";
+
+                        if (nodesKey)
+                            nodes = cache->insertNodes(
+                                *nodesKey, seq, std::move(data));
+                        else
+                            nodes = std::make_shared<
+                                LedgerReplyCache::Nodes const>(
+                                std::move(data));
+                    }
+                }
 
-                    for (auto const& d : data)
+                if (nodes)
+                {
+                    for (auto const& d : *nodes)
                     {
                         protocol::TMLedgerNode* node{ledgerData.add_nodes()};
                         node->set_nodeid(d.first.getRawString());
@@ -3566,12 +3736,14 @@ PeerImp::processLedgerRequest(std::shared_ptr<protocol::TMGetLedger> const& m)
                 }
                 else
                 {
+                    complete = false;
                     JLOG(p_journal_.warn())
                         << "processLedgerRequest: getNodeFat returns false";
                 }
             }
             catch (std::exception const& e)
             {
+                complete = false;
                 std::string info;
                 switch (itype)
                 {
@@ -3611,6 +3783,15 @@ PeerImp::processLedgerRequest(std::shared_ptr<protocol::TMGetLedger> const& m)
             << "processLedgerRequest: Got request for " << m->nodeids_size()
             << " nodes at depth " << queryDepth << ", return "
             << ledgerData.nodes_size() << " nodes";
+
+        if (replyKey && complete)
+        {
+            auto const reply =
+                std::make_shared<Message>(ledgerData, protocol::mtLEDGER_DATA);
+            cache->insertReply(*replyKey, seq, reply);
+            send(reply);
+            return;
+        }
     }
 
     send(std::make_shared<Message>(ledgerData, protocol::mtLEDGER_DATA));
@@ -31,6 +31,7 @@
 #include <ripple/overlay/impl/OverlayImpl.h>
 #include <ripple/overlay/impl/ProtocolMessage.h>
 #include <ripple/overlay/impl/ProtocolVersion.h>
+#include <ripple/overlay/impl/SendQueue.h>
 #include <ripple/peerfinder/PeerfinderManager.h>
 #include <ripple/protocol/Protocol.h>
 #include <ripple/protocol/STTx.h>
@@ -41,8 +42,9 @@
 #include <boost/endian/conversion.hpp>
 #include <boost/thread/shared_mutex.hpp>
 #include <cstdint>
+#include <deque>
 #include <optional>
-#include <queue>
+#include <vector>
 
 namespace ripple {
 
@@ -67,7 +69,7 @@ private:
     using endpoint_type = boost::asio::ip::tcp::endpoint;
     using waitable_timer =
         boost::asio::basic_waitable_timer<std::chrono::steady_clock>;
-    using Compressed = compression::Compressed;
+    using Algorithm = compression::Algorithm;
 
     Application& app_;
     id_t const id_;
@@ -155,10 +157,22 @@ private:
     http_request_type request_;
     http_response_type response_;
     boost::beast::http::fields const& headers_;
-    std::queue<std::shared_ptr<Message>> send_queue_;
+    SendQueue send_queue_;
+    // The messages taken from send_queue_ being written, and their bytes
+    std::vector<std::shared_ptr<Message>> sending_;
+    std::size_t sendingBytes_ = 0;
+    // The messages of a write that carries more than one of them
+    std::vector<std::uint8_t> write_buffer_;
+    // The bytes of the messages queued or being written
+    std::size_t sendQueueBytes_ = 0;
     bool gracefulClose_ = false;
     int large_sendq_ = 0;
     std::unique_ptr<LoadEvent> load_event_;
+    // The traffic category and arrival time of the message being handled,
+    // and whether its handling was handed off to a job
+    TrafficCount::category messageCategory_ = TrafficCount::category::unknown;
+    clock_type::time_point messageReceived_;
+    bool messageDeferred_ = false;
     // The highest sequence of each PublisherList that has
     // been sent to or received from this peer.
     hash_map<PublicKey, std::size_t> publisherListSequences_;
@@ -167,7 +181,7 @@ private:
     hash_map<PublicKey, NodeStore::ShardInfo> shardInfos_;
     std::mutex mutable shardInfoMutex_;
 
-    Compressed compressionEnabled_ = Compressed::Off;
+    Algorithm compressionAlgorithm_ = Algorithm::None;
 
     // Queue of transactions' hashes that have not been
     // relayed. The hashes are sent once a second to a peer
@@ -422,7 +436,14 @@ public:
     bool
     compressionEnabled() const override
     {
-        return compressionEnabled_ == Compressed::On;
+        return compressionAlgorithm_ != Algorithm::None;
+    }
+
+    /** The compression algorithm of the messages sent to this peer. */
+    Algorithm
+    compressionAlgorithm() const
+    {
+        return compressionAlgorithm_;
     }
 
     bool
@@ -479,6 +500,11 @@ private:
     void
     onReadMessage(error_code ec, std::size_t bytes_transferred);
 
+    // Write the messages at the front of the send queue, coalescing as many
+    // as the tuning limits allow into a single write
+    void
+    writeSendQueue();
+
     // Called when protocol messages bytes are sent
     void
     onWriteMessage(error_code ec, std::size_t bytes_transferred);
@@ -597,6 +623,31 @@ private:
     void
     doFetchPack(const std::shared_ptr<protocol::TMGetObjectByHash>& packet);
 
+    /** Wrap the job that handles the current message.
+
+        The job's wait in the queue and its run time are then counted
+        against the traffic category of the message.
+    */
+    template <class Handler>
+    auto
+    measured(Handler&& handler)
+    {
+        messageDeferred_ = true;
+        return [&overlay = overlay_,
+                category = messageCategory_,
+                received = messageReceived_,
+                handler = std::forward<Handler>(handler)]() {
+            using namespace std::chrono;
+            auto const start = clock_type::now();
+            overlay.reportQueueDelay(
+                category, duration_cast<microseconds>(start - received));
+            handler();
+            overlay.reportHandlerTime(
+                category,
+                duration_cast<microseconds>(clock_type::now() - start));
+        };
+    }
+
     void
     onValidatorListMessage(
         std::string const& messageType,
@@ -685,14 +736,8 @@ PeerImp::PeerImp(
     , slot_(std::move(slot))
     , response_(std::move(response))
     , headers_(response_)
-    , compressionEnabled_(
-          peerFeatureEnabled(
-              headers_,
-              FEATURE_COMPR,
-              "lz4",
-              app_.config().COMPRESSION)
-              ? Compressed::On
-              : Compressed::Off)
+    , compressionAlgorithm_(
+          peerCompressionAlgorithm(headers_, app_.config().COMPRESSION))
     , txReduceRelayEnabled_(peerFeatureEnabled(
           headers_,
           FEATURE_TXRR,
@@ -710,7 +755,9 @@ PeerImp::PeerImp(
     read_buffer_.commit(boost::asio::buffer_copy(
         read_buffer_.prepare(boost::asio::buffer_size(buffers)), buffers));
     JLOG(journal_.info()) << "compression enabled "
-                          << (compressionEnabled_ == Compressed::On)
+                          << (compressionAlgorithm_ != Algorithm::None)
+                          << " zstd enabled "
+                          << (compressionAlgorithm_ == Algorithm::Zstd)
                           << " vp reduce-relay enabled "
                           << vpReduceRelayEnabled_
                           << " tx reduce-relay enabled "
@@ -28,6 +28,8 @@
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/buffers_iterator.hpp>
 #include <boost/system/error_code.hpp>
+#include <google/protobuf/arena.h>
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <memory>
@@ -209,7 +211,8 @@ parseMessageHeader(
 
         hdr.algorithm = static_cast<compression::Algorithm>(*iter & 0xF0);
 
-        if (hdr.algorithm != compression::Algorithm::LZ4)
+        if (hdr.algorithm != compression::Algorithm::LZ4 &&
+            hdr.algorithm != compression::Algorithm::Zstd)
         {
             ec = make_error_code(boost::system::errc::protocol_error);
             return std::nullopt;
@@ -263,6 +266,10 @@ parseMessageHeader(
     return std::nullopt;
 }
 
+// The bounds on the first block of the arena a message is parsed into
+constexpr std::size_t minArenaBlockSize = 256;
+constexpr std::size_t maxArenaBlockSize = megabytes(1);
+
 template <
     class T,
     class Buffers,
@@ -271,7 +278,18 @@ template <
 std::shared_ptr<T>
 parseMessageContent(MessageHeader const& header, Buffers const& buffers)
 {
-    auto const m = std::make_shared<T>();
+    // The message, its strings and its repeated fields are all allocated
+    // from one arena, sized from the payload, instead of one allocation
+    // each. The returned pointer owns the arena, so everything is freed at
+    // once when the last handler holding the message is done with it.
+    google::protobuf::ArenaOptions options;
+    options.start_block_size = std::clamp<std::size_t>(
+        2 * header.uncompressed_size, minArenaBlockSize, maxArenaBlockSize);
+    options.max_block_size =
+        std::max<std::size_t>(options.start_block_size, options.max_block_size);
+    auto const arena = std::make_shared<google::protobuf::Arena>(options);
+    std::shared_ptr<T> const m{
+        arena, google::protobuf::Arena::CreateMessage<T>(arena.get())};
 
     ZeroCopyInputStream<Buffers> stream(buffers);
     stream.Skip(header.header_size);
@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/overlay/impl/SendQueue.h>
+#include <ripple/overlay/impl/TrafficCount.h>
+#include <ripple/overlay/impl/Tuning.h>
+#include <algorithm>
+#include <cassert>
+
+namespace ripple {
+
+namespace {
+
+// The quanta of each lane's turn, in bytes
+std::array<std::size_t, SendQueue::lanes> constexpr quanta{
+    16 * Tuning::sendLaneQuantum,
+    4 * Tuning::sendLaneQuantum,
+    Tuning::sendLaneQuantum};
+
+}  // namespace
+
+SendQueue::Lane
+SendQueue::laneOf(std::size_t category)
+{
+    switch (category)
+    {
+        case TrafficCount::category::base:
+        case TrafficCount::category::cluster:
+        case TrafficCount::category::overlay:
+        case TrafficCount::category::manifests:
+        case TrafficCount::category::proposal:
+        case TrafficCount::category::validation:
+        case TrafficCount::category::validatorlist:
+        case TrafficCount::category::get_set:
+        case TrafficCount::category::share_set:
+        case TrafficCount::category::ld_tsc_get:
+        case TrafficCount::category::ld_tsc_share:
+        case TrafficCount::category::gl_tsc_get:
+        case TrafficCount::category::gl_tsc_share:
+            return Lane::consensus;
+
+        case TrafficCount::category::transaction:
+        case TrafficCount::category::get_transactions:
+        case TrafficCount::category::have_transactions:
+        case TrafficCount::category::requested_transactions:
+            return Lane::transactions;
+
+        default:
+            return Lane::bulk;
+    }
+}
+
+void
+SendQueue::push(Lane lane, std::shared_ptr<Message> message, std::size_t bytes)
+{
+    auto& state = lanes_[static_cast<std::size_t>(lane)];
+    state.entries.push_back({std::move(message), bytes});
+    ++state.depth;
+    ++size_;
+}
+
+SendQueue::Entry const&
+SendQueue::front()
+{
+    return lanes_[select()].entries.front();
+}
+
+SendQueue::Entry
+SendQueue::pop()
+{
+    auto& state = lanes_[select()];
+    Entry entry = std::move(state.entries.front());
+    state.entries.pop_front();
+    --state.depth;
+    --size_;
+
+    state.deficit -= std::min(state.deficit, entry.bytes);
+    if (state.entries.empty())
+    {
+        state.deficit = 0;
+        current_ = (current_ + 1) % lanes;
+        granted_ = false;
+    }
+    return entry;
+}
+
+std::size_t
+SendQueue::select()
+{
+    assert(size_ != 0);
+    for (;;)
+    {
+        auto& state = lanes_[current_];
+        if (!state.entries.empty())
+        {
+            // A lane with nothing to share the connection with goes ahead
+            if (state.entries.size() == size_)
+                return current_;
+
+            if (!granted_)
+            {
+                state.deficit += quanta[current_];
+                granted_ = true;
+            }
+
+            if (state.entries.front().bytes <= state.deficit)
+                return current_;
+        }
+        else
+        {
+            state.deficit = 0;
+        }
+
+        current_ = (current_ + 1) % lanes;
+        granted_ = false;
+    }
+}
+
+}  // namespace ripple
@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_SENDQUEUE_H_INCLUDED
+#define RIPPLE_OVERLAY_SENDQUEUE_H_INCLUDED
+
+#include <ripple/overlay/Message.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+
+namespace ripple {
+
+/** The messages waiting to be written to a peer, in lanes.
+
+    Proposals, validations and the rest of consensus, relayed
+    transactions, and bulk ledger data each queue in their own lane. The
+    lanes are drained by deficit round robin: each turn, a lane may send
+    up to its weight times a quantum of bytes. The consensus lane has the
+    largest weight, so however much ledger data is being served a
+    consensus message waits for at most a few kilobytes of it.
+
+    This is used from the peer's strand only, except for the lane depths,
+    which may be read from any thread.
+*/
+class SendQueue
+{
+public:
+    enum class Lane : std::size_t { consensus, transactions, bulk };
+
+    static constexpr std::size_t lanes = 3;
+
+    struct Entry
+    {
+        std::shared_ptr<Message> message;
+        std::size_t bytes = 0;
+    };
+
+    /** The lane a message of a traffic category is sent in. */
+    static Lane
+    laneOf(std::size_t category);
+
+    /** Queue a message at the back of its lane. */
+    void
+    push(Lane lane, std::shared_ptr<Message> message, std::size_t bytes);
+
+    /** The message to be sent next. The queue must not be empty. */
+    Entry const&
+    front();
+
+    /** Remove the message to be sent next and return it. */
+    Entry
+    pop();
+
+    bool
+    empty() const
+    {
+        return size_ == 0;
+    }
+
+    /** The number of messages queued in all lanes. */
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /** The number of messages queued in a lane. */
+    std::size_t
+    size(Lane lane) const
+    {
+        return lanes_[static_cast<std::size_t>(lane)].depth;
+    }
+
+private:
+    struct State
+    {
+        std::deque<Entry> entries;
+        std::atomic<std::size_t> depth{0};
+        std::size_t deficit = 0;
+    };
+
+    // Choose the lane the next message comes from
+    std::size_t
+    select();
+
+    std::array<State, lanes> lanes_;
+    std::size_t size_ = 0;
+    // The lane whose turn it is, and whether its quantum was granted
+    std::size_t current_ = 0;
+    bool granted_ = false;
+};
+
+}  // namespace ripple
+
+#endif
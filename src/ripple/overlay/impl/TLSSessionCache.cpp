@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/overlay/impl/TLSSessionCache.h>
+
+namespace ripple {
+
+TLSSessionCache::TLSSessionCache(std::size_t capacity) : capacity_(capacity)
+{
+}
+
+void
+TLSSessionCache::insert(endpoint_type const& remote, SSL_SESSION* session)
+{
+    session_ptr ptr(session, SSL_SESSION_free);
+    if (!ptr)
+        return;
+
+    std::lock_guard lock(mutex_);
+    if (auto const it = index_.find(remote); it != index_.end())
+    {
+        sessions_.erase(it->second);
+        index_.erase(it);
+    }
+
+    sessions_.emplace_front(remote, std::move(ptr));
+    index_.emplace(remote, sessions_.begin());
+
+    while (sessions_.size() > capacity_)
+    {
+        index_.erase(sessions_.back().first);
+        sessions_.pop_back();
+    }
+}
+
+TLSSessionCache::session_ptr
+TLSSessionCache::fetch(endpoint_type const& remote) const
+{
+    std::lock_guard lock(mutex_);
+    if (auto const it = index_.find(remote); it != index_.end())
+        return it->second->second;
+    return {};
+}
+
+void
+TLSSessionCache::erase(endpoint_type const& remote)
+{
+    std::lock_guard lock(mutex_);
+    if (auto const it = index_.find(remote); it != index_.end())
+    {
+        sessions_.erase(it->second);
+        index_.erase(it);
+    }
+}
+
+std::size_t
+TLSSessionCache::size() const
+{
+    std::lock_guard lock(mutex_);
+    return sessions_.size();
+}
+
+}  // namespace ripple
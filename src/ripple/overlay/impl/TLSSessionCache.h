@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_TLSSESSIONCACHE_H_INCLUDED
+#define RIPPLE_OVERLAY_TLSSESSIONCACHE_H_INCLUDED
+
+#include <boost/asio/ip/tcp.hpp>
+#include <openssl/ssl.h>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace ripple {
+
+/** The TLS sessions of the servers we connected out to, by address.
+
+    When a connection to a peer drops and we connect to it again, offering
+    the session of the last connection lets the server resume it with an
+    abbreviated handshake, rather than a full key exchange. After a network
+    blip that saves the CPU of a reconnect storm on both sides.
+
+    Only the most recently stored sessions are kept, up to a capacity.
+*/
+class TLSSessionCache
+{
+public:
+    using endpoint_type = boost::asio::ip::tcp::endpoint;
+    using session_ptr = std::shared_ptr<SSL_SESSION>;
+
+    explicit TLSSessionCache(std::size_t capacity);
+
+    /** Store the session of a connection, taking ownership of it. */
+    void
+    insert(endpoint_type const& remote, SSL_SESSION* session);
+
+    /** Get the session stored for a server, if any. */
+    session_ptr
+    fetch(endpoint_type const& remote) const;
+
+    /** Forget the session stored for a server. */
+    void
+    erase(endpoint_type const& remote);
+
+    /** The number of sessions stored. */
+    std::size_t
+    size() const;
+
+private:
+    using List = std::list<std::pair<endpoint_type, session_ptr>>;
+
+    std::size_t const capacity_;
+
+    std::mutex mutable mutex_;
+    // Most recently stored first
+    List sessions_;
+    std::map<endpoint_type, List::iterator> index_;
+};
+
+}  // namespace ripple
+
+#endif
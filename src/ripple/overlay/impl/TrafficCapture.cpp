@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/contract.h>
+#include <ripple/overlay/impl/TrafficCapture.h>
+#include <boost/endian/conversion.hpp>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace ripple {
+
+namespace {
+
+constexpr std::size_t recordHeaderBytes = 8 + 4 + 2 + 4;
+
+template <class Int>
+void
+put(char*& p, Int value)
+{
+    boost::endian::native_to_little_inplace(value);
+    std::memcpy(p, &value, sizeof(value));
+    p += sizeof(value);
+}
+
+template <class Int>
+Int
+get(char const*& p)
+{
+    Int value;
+    std::memcpy(&value, p, sizeof(value));
+    p += sizeof(value);
+    return boost::endian::little_to_native(value);
+}
+
+}  // namespace
+
+TrafficCapture::TrafficCapture(std::string const& path, std::size_t maxBytes)
+    : start_(std::chrono::steady_clock::now())
+    , maxBytes_(maxBytes)
+    , out_(path, std::ios::binary | std::ios::trunc)
+{
+    if (!out_)
+        Throw<std::runtime_error>("Unable to open traffic capture " + path);
+    out_.write(magic, sizeof(magic));
+    bytes_ = sizeof(magic);
+}
+
+void
+TrafficCapture::record(
+    std::uint32_t peer,
+    std::uint16_t type,
+    ::google::protobuf::Message const& message)
+{
+    using namespace std::chrono;
+    auto const when =
+        duration_cast<microseconds>(steady_clock::now() - start_).count();
+
+    std::string data(recordHeaderBytes, '\0');
+    if (!message.AppendToString(&data))
+        return;
+
+    char* p = data.data();
+    put(p, static_cast<std::uint64_t>(when));
+    put(p, peer);
+    put(p, type);
+    put(p, static_cast<std::uint32_t>(data.size() - recordHeaderBytes));
+
+    std::lock_guard lock(mutex_);
+    if (bytes_ + data.size() > maxBytes_)
+        return;
+    out_.write(data.data(), data.size());
+    bytes_ += data.size();
+}
+
+std::size_t
+TrafficCapture::bytes() const
+{
+    std::lock_guard lock(mutex_);
+    return bytes_;
+}
+
+std::vector<TrafficCapture::Record>
+TrafficCapture::read(std::string const& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        Throw<std::runtime_error>("Unable to open traffic capture " + path);
+    std::string const data{
+        std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+
+    if (data.size() < sizeof(magic) ||
+        data.compare(0, sizeof(magic), magic, sizeof(magic)) != 0)
+        Throw<std::runtime_error>("Not a traffic capture: " + path);
+
+    std::vector<Record> records;
+    char const* p = data.data() + sizeof(magic);
+    char const* const end = data.data() + data.size();
+    while (p != end)
+    {
+        if (end - p < static_cast<std::ptrdiff_t>(recordHeaderBytes))
+            Throw<std::runtime_error>("Truncated traffic capture: " + path);
+
+        Record r;
+        r.when = std::chrono::microseconds(get<std::uint64_t>(p));
+        r.peer = get<std::uint32_t>(p);
+        r.type = get<std::uint16_t>(p);
+        auto const size = get<std::uint32_t>(p);
+        if (static_cast<std::size_t>(end - p) < size)
+            Throw<std::runtime_error>("Truncated traffic capture: " + path);
+        r.payload.assign(p, size);
+        p += size;
+        records.push_back(std::move(r));
+    }
+    return records;
+}
+
+}  // namespace ripple
@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_TRAFFICCAPTURE_H_INCLUDED
+#define RIPPLE_OVERLAY_TRAFFICCAPTURE_H_INCLUDED
+
+#include <google/protobuf/message.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+/** Records the messages received from peers, to be replayed later.
+
+    The file starts with an eight byte magic, then holds one record for
+    each message, in the order they were received:
+
+        8 bytes     Microseconds from the start of the capture
+        4 bytes     The ID of the peer the message came from
+        2 bytes     The message type
+        4 bytes     The size of the payload
+        payload     The message, serialized and uncompressed
+
+    Integers are little endian. Once the file reaches its size limit, no
+    more messages are recorded.
+*/
+class TrafficCapture
+{
+public:
+    struct Record
+    {
+        std::chrono::microseconds when;
+        std::uint32_t peer;
+        std::uint16_t type;
+        std::string payload;
+    };
+
+    static constexpr char magic[8] = {'R', 'P', 'L', 'C', 'A', 'P', '0', '1'};
+
+    /** Start a capture, truncating the file.
+
+        @param path The file to write.
+        @param maxBytes The size past which the file does not grow.
+    */
+    TrafficCapture(std::string const& path, std::size_t maxBytes);
+
+    /** Record a message received from a peer. */
+    void
+    record(
+        std::uint32_t peer,
+        std::uint16_t type,
+        ::google::protobuf::Message const& message);
+
+    /** The number of bytes written so far. */
+    std::size_t
+    bytes() const;
+
+    /** Read back every record of a capture.
+
+        @throws std::runtime_error if the file is not a capture, or a
+                record is cut short.
+    */
+    static std::vector<Record>
+    read(std::string const& path);
+
+private:
+    std::chrono::steady_clock::time_point const start_;
+    std::size_t const maxBytes_;
+
+    std::mutex mutable mutex_;
+    std::ofstream out_;
+    std::size_t bytes_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
@@ -20,11 +20,14 @@
 #ifndef RIPPLE_OVERLAY_TRAFFIC_H_INCLUDED
 #define RIPPLE_OVERLAY_TRAFFIC_H_INCLUDED
 
+#include <ripple/basics/Histogram.h>
 #include <ripple/basics/safe_cast.h>
 #include <ripple/protocol/messages.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 
 namespace ripple {
@@ -32,6 +35,8 @@ namespace ripple {
 class TrafficCount
 {
 public:
+    using Histogram = ripple::Histogram;
+
     class TrafficStats
     {
     public:
@@ -42,6 +47,16 @@ public:
         std::atomic<std::uint64_t> messagesIn{0};
         std::atomic<std::uint64_t> messagesOut{0};
 
+        // Message sizes in bytes
+        Histogram sizeIn;
+        Histogram sizeOut;
+
+        // Microseconds from receiving a message to the start of its job
+        Histogram queueDelay;
+
+        // Microseconds spent handling a message, in its job if it has one
+        Histogram handlerTime;
+
         TrafficStats(char const* n) : name(n)
         {
         }
@@ -52,6 +67,10 @@ public:
             , bytesOut(ts.bytesOut.load())
             , messagesIn(ts.messagesIn.load())
             , messagesOut(ts.messagesOut.load())
+            , sizeIn(ts.sizeIn)
+            , sizeOut(ts.sizeOut)
+            , queueDelay(ts.queueDelay)
+            , handlerTime(ts.handlerTime)
         {
         }
 
@@ -178,14 +197,33 @@ public:
         {
             counts_[cat].bytesIn += bytes;
             ++counts_[cat].messagesIn;
+            counts_[cat].sizeIn.add(bytes);
         }
         else
         {
             counts_[cat].bytesOut += bytes;
             ++counts_[cat].messagesOut;
+            counts_[cat].sizeOut.add(bytes);
         }
     }
 
+    /** Account for the time a received message waited for its job */
+    void
+    addQueueDelay(category cat, std::chrono::microseconds delay)
+    {
+        assert(cat <= category::unknown);
+        counts_[cat].queueDelay.add(std::max<std::int64_t>(0, delay.count()));
+    }
+
+    /** Account for the time spent handling a received message */
+    void
+    addHandlerTime(category cat, std::chrono::microseconds elapsed)
+    {
+        assert(cat <= category::unknown);
+        counts_[cat].handlerTime.add(
+            std::max<std::int64_t>(0, elapsed.count()));
+    }
+
     TrafficCount() = default;
 
     /** An up-to-date copy of all the counters
@@ -64,6 +64,28 @@ enum {
 /** Size of buffer used to read from the socket. */
 std::size_t constexpr readBufferBytes = 16384;
 
+/** The most messages, and bytes, coalesced into one write to the socket.
+    A larger message is written on its own. */
+std::size_t constexpr sendBatchMessages = 64;
+std::size_t constexpr sendBatchBytes = 16384;
+
+/** The bytes the bulk lane of a send queue may write in its turn. The
+    transaction and consensus lanes get four and sixteen times as much. */
+std::size_t constexpr sendLaneQuantum = 4096;
+
+/** The most TLS sessions kept to resume outbound peer connections with. */
+std::size_t constexpr tlsSessions = 1024;
+
+/** How long served ledger nodes and replies are kept, and how often
+    (in seconds) they are swept. */
+std::chrono::seconds constexpr ledgerReplyCacheAge{60};
+std::size_t constexpr sweepLedgerReplyCache = 5;
+
+/** How long the last proposal of a validator is remembered, and how often
+    (in seconds) they are swept. */
+std::chrono::seconds constexpr lastProposalAge{300};
+std::size_t constexpr sweepLastProposals = 60;
+
 }  // namespace Tuning
 
 }  // namespace ripple
@@ -204,6 +204,7 @@ private:
 
     beast::Journal m_journal;
     cache_type m_cache;
+    std::uint64_t m_generation = 0;
 
 public:
     using allocator_type = Allocator;
@@ -376,6 +377,16 @@ public:
         return m_cache.size();
     }
 
+    /** Returns a counter that changes whenever the hops lists change.
+        Refreshing an entry at the same hops does not change it, so callers
+        may reuse any result computed from the lists until it does.
+    */
+    std::uint64_t
+    generation() const
+    {
+        return m_generation;
+    }
+
     /** Erase entries whose time has expired. */
     void
     expire();
@@ -417,6 +428,7 @@ Livecache<Allocator>::expire()
     }
     if (n > 0)
     {
+        ++m_generation;
         JLOG(m_journal.debug()) << beast::leftw(18) << "Livecache expired " << n
                                 << ((n > 1) ? " entries" : " entry");
     }
@@ -438,6 +450,7 @@ Livecache<Allocator>::insert(Endpoint const& ep)
     if (result.second)
     {
         hops.insert(e);
+        ++m_generation;
         JLOG(m_journal.debug()) << beast::leftw(18) << "Livecache insert "
                                 << ep.address << " at hops " << ep.hops;
         return;
@@ -457,6 +470,7 @@ Livecache<Allocator>::insert(Endpoint const& ep)
     if (ep.hops < e.endpoint.hops)
     {
         hops.reinsert(e, ep.hops);
+        ++m_generation;
         JLOG(m_journal.debug()) << beast::leftw(18) << "Livecache update "
                                 << ep.address << " at hops " << ep.hops;
     }
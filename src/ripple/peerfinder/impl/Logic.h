@@ -41,6 +41,8 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 
 namespace ripple {
@@ -66,6 +68,10 @@ public:
 
     std::recursive_mutex lock_;
 
+    // Protects livecache_ and liveShuffled_. When both locks are needed,
+    // lock_ must be acquired first.
+    std::mutex livecacheLock_;
+
     // True if we are stopping.
     bool stopping_ = false;
 
@@ -85,6 +91,9 @@ public:
     // Live livecache from mtENDPOINTS messages
     Livecache<> livecache_;
 
+    // The livecache generation the hops lists were last shuffled at
+    std::optional<std::uint64_t> liveShuffled_;
+
     // LiveCache of addresses suitable for gaining initial connections
     Bootcache bootcache_;
 
@@ -453,9 +462,9 @@ public:
     std::vector<Endpoint>
     redirect(SlotImp::ptr const& slot)
     {
-        std::lock_guard _(lock_);
+        std::lock_guard lock(livecacheLock_);
         RedirectHandouts h(slot);
-        livecache_.hops.shuffle();
+        shuffleLivecache(lock);
         handout(&h, (&h) + 1, livecache_.hops.begin(), livecache_.hops.end());
         return std::move(h.list());
     }
@@ -526,9 +535,15 @@ public:
         //    Any outbound attempts are in progress
         //
         {
-            livecache_.hops.shuffle();
-            handout(
-                &h, (&h) + 1, livecache_.hops.rbegin(), livecache_.hops.rend());
+            {
+                std::lock_guard lock(livecacheLock_);
+                shuffleLivecache(lock);
+                handout(
+                    &h,
+                    (&h) + 1,
+                    livecache_.hops.rbegin(),
+                    livecache_.hops.rend());
+            }
             if (!h.list().empty())
             {
                 JLOG(m_journal.debug())
@@ -580,18 +595,27 @@ public:
         return none;
     }
 
+    /** Build the endpoints to send to each active peer.
+        Only the slot table is read under lock_; the handouts themselves are
+        computed under livecacheLock_. A slot that was already given every
+        eligible endpoint is skipped until the livecache or the slot's recent
+        table changes, since a handout would find nothing new for it.
+    */
     std::vector<std::pair<std::shared_ptr<Slot>, std::vector<Endpoint>>>
     buildEndpointsForPeers()
     {
         std::vector<std::pair<std::shared_ptr<Slot>, std::vector<Endpoint>>>
             result;
 
-        std::lock_guard _(lock_);
+        std::vector<SlotHandouts> targets;
 
-        clock_type::time_point const now = m_clock.now();
-        if (m_whenBroadcast <= now)
         {
-            std::vector<SlotHandouts> targets;
+            std::lock_guard _(lock_);
+
+            clock_type::time_point const now = m_clock.now();
+            if (m_whenBroadcast > now)
+                return result;
+            m_whenBroadcast = now + Tuning::secondsPerMessage;
 
             {
                 // build list of active slots
@@ -644,28 +668,45 @@ public:
                 for (auto& t : targets)
                     t.insert(ep);
             }
+        }
+
+        {
+            std::lock_guard lock(livecacheLock_);
+            auto const generation = livecache_.generation();
+
+            // Slots with nothing new to receive go to the back
+            auto const stale = std::partition(
+                targets.begin(), targets.end(), [generation](auto const& t) {
+                    return !t.slot()->recent.exhausted(generation);
+                });
 
             // build sequence of endpoints by hops
-            livecache_.hops.shuffle();
+            shuffleLivecache(lock);
             handout(
                 targets.begin(),
-                targets.end(),
+                stale,
                 livecache_.hops.begin(),
                 livecache_.hops.end());
 
-            // broadcast
-            for (auto const& t : targets)
+            for (auto iter = targets.begin(); iter != stale; ++iter)
             {
-                SlotImp::ptr const& slot = t.slot();
-                auto const& list = t.list();
-                JLOG(m_journal.trace())
-                    << beast::leftw(18) << "Logic sending "
-                    << slot->remote_endpoint() << " with " << list.size()
-                    << ((list.size() == 1) ? " endpoint" : " endpoints");
-                result.push_back(std::make_pair(slot, list));
+                if (!iter->full())
+                    iter->slot()->recent.setExhausted(generation);
             }
+        }
 
-            m_whenBroadcast = now + Tuning::secondsPerMessage;
+        // broadcast
+        for (auto const& t : targets)
+        {
+            SlotImp::ptr const& slot = t.slot();
+            auto const& list = t.list();
+            if (list.empty())
+                continue;
+            JLOG(m_journal.trace())
+                << beast::leftw(18) << "Logic sending "
+                << slot->remote_endpoint() << " with " << list.size()
+                << ((list.size() == 1) ? " endpoint" : " endpoints");
+            result.push_back(std::make_pair(slot, list));
         }
 
         return result;
@@ -674,10 +715,13 @@ public:
     void
     once_per_second()
     {
-        std::lock_guard _(lock_);
+        {
+            // Expire the Livecache
+            std::lock_guard lock(livecacheLock_);
+            livecache_.expire();
+        }
 
-        // Expire the Livecache
-        livecache_.expire();
+        std::lock_guard _(lock_);
 
         // Expire the recent cache in each slot
         for (auto const& entry : slots_)
@@ -691,6 +735,21 @@ public:
 
     //--------------------------------------------------------------------------
 
+    // Shuffle the livecache hops lists if entries were added or moved since
+    // the last shuffle. Handouts move what they give out to the back of each
+    // list, which spreads the remaining entries on their own.
+    void
+    shuffleLivecache(std::lock_guard<std::mutex> const&)
+    {
+        auto const generation = livecache_.generation();
+        if (liveShuffled_ == generation)
+            return;
+        livecache_.hops.shuffle();
+        liveShuffled_ = generation;
+    }
+
+    //--------------------------------------------------------------------------
+
     // Validate and clean up the list that we received from the slot.
     void
     preprocess(SlotImp::ptr const& slot, Endpoints& list)
@@ -777,7 +836,7 @@ public:
             << " contained " << list.size()
             << ((list.size() > 1) ? " entries" : " entry");
 
-        std::lock_guard _(lock_);
+        std::unique_lock lock(lock_);
 
         // The object must exist in our table
         assert(slots_.find(slot->remote_endpoint()) != slots_.end());
@@ -793,6 +852,10 @@ public:
 
         preprocess(slot, list);
 
+        // Inserted into the livecache once lock_ is released
+        Endpoints live;
+        live.reserve(list.size());
+
         for (auto const& ep : list)
         {
             assert(ep.hops != 0);
@@ -846,11 +909,20 @@ public:
             // listening test, else we silently drop neighbor endpoint
             // since their listening port is misconfigured.
             //
-            livecache_.insert(ep);
+            live.push_back(ep);
             bootcache_.insert(ep.address);
         }
 
         slot->whenAcceptEndpoints = now + Tuning::secondsPerMessage;
+
+        lock.unlock();
+
+        if (!live.empty())
+        {
+            std::lock_guard _(livecacheLock_);
+            for (auto const& ep : live)
+                livecache_.insert(ep);
+        }
     }
 
     //--------------------------------------------------------------------------
@@ -1181,6 +1253,7 @@ public:
 
         {
             beast::PropertyStream::Map child("livecache", map);
+            std::lock_guard lock(livecacheLock_);
             livecache_.onWrite(child);
         }
 
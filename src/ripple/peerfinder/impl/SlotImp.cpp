@@ -104,6 +104,7 @@ SlotImp::recent_t::recent_t(clock_type& clock) : cache(clock)
 void
 SlotImp::recent_t::insert(beast::IP::Endpoint const& ep, std::uint32_t hops)
 {
+    std::lock_guard lock(mutex_);
     auto const result(cache.emplace(ep, hops));
     if (!result.second)
     {
@@ -119,6 +120,7 @@ SlotImp::recent_t::insert(beast::IP::Endpoint const& ep, std::uint32_t hops)
 bool
 SlotImp::recent_t::filter(beast::IP::Endpoint const& ep, std::uint32_t hops)
 {
+    std::lock_guard lock(mutex_);
     auto const iter(cache.find(ep));
     if (iter == cache.end())
         return false;
@@ -128,10 +130,26 @@ SlotImp::recent_t::filter(beast::IP::Endpoint const& ep, std::uint32_t hops)
     return iter->second <= hops;
 }
 
+bool
+SlotImp::recent_t::exhausted(std::uint64_t generation)
+{
+    std::lock_guard lock(mutex_);
+    return exhausted_ == generation;
+}
+
+void
+SlotImp::recent_t::setExhausted(std::uint64_t generation)
+{
+    std::lock_guard lock(mutex_);
+    exhausted_ = generation;
+}
+
 void
 SlotImp::recent_t::expire()
 {
-    beast::expire(cache, Tuning::liveCacheSecondsToLive);
+    std::lock_guard lock(mutex_);
+    if (beast::expire(cache, Tuning::liveCacheSecondsToLive) > 0)
+        exhausted_.reset();
 }
 
 }  // namespace PeerFinder
@@ -25,6 +25,7 @@
 #include <ripple/peerfinder/PeerfinderManager.h>
 #include <ripple/peerfinder/Slot.h>
 #include <atomic>
+#include <mutex>
 #include <optional>
 
 namespace ripple {
@@ -158,12 +159,27 @@ public:
         bool
         filter(beast::IP::Endpoint const& ep, std::uint32_t hops);
 
+        /** Returns `true` if a handout from this livecache generation
+            would find nothing new for the slot.
+        */
+        bool
+        exhausted(std::uint64_t generation);
+
+        /** Called when a handout ran out of endpoints before filling up. */
+        void
+        setExhausted(std::uint64_t generation);
+
     private:
         void
         expire();
 
         friend class SlotImp;
+        std::mutex mutex_;
         beast::aged_unordered_map<beast::IP::Endpoint, std::uint32_t> cache;
+
+        // The livecache generation at which every endpoint the slot could
+        // be given was already in the cache. Cleared when entries expire.
+        std::optional<std::uint64_t> exhausted_;
     } recent;
 
     void
@@ -26,6 +26,7 @@
 #include <ripple/json/json_writer.h>
 #include <ripple/json/to_string.h>
 #include <ripple/nodestore/DatabaseShard.h>
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <cstdlib>
@@ -36,6 +37,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 
@@ -57,6 +59,7 @@ PerfLogImp::Counters::Counters(
                 // Ensure that no other function populates this entry.
                 assert(false);
             }
+            latency_.try_emplace(label);
         }
     }
     {
@@ -161,14 +164,56 @@ PerfLogImp::Counters::countersJson() const
         jqobj[jss::total] = totalJqJson;
     }
 
+    Json::Value invobj(Json::objectValue);
+    {
+        std::shared_lock lock(invMutex_);
+        for (auto const& [name, value] : inv_)
+        {
+            Json::Value i(Json::objectValue);
+            i[jss::checked] = std::to_string(value.checked.load());
+            i[jss::failed] = std::to_string(value.failed.load());
+            i[jss::duration_ns] = std::to_string(value.duration.load());
+            invobj[name] = i;
+        }
+    }
+
     Json::Value counters(Json::objectValue);
     // Be kind to reporting tools and let them expect rpc and jq objects
     // even if empty.
     counters[jss::rpc] = rpcobj;
     counters[jss::job_queue] = jqobj;
+    counters[jss::invariants] = invobj;
     return counters;
 }
 
+Json::Value
+PerfLogImp::Counters::latencyJson() const
+{
+    auto const percentiles = [](Histogram const& h) {
+        Json::Value ret(Json::objectValue);
+        ret[jss::p50] = std::to_string(h.percentile(50));
+        ret[jss::p99] = std::to_string(h.percentile(99));
+        ret[jss::p999] = std::to_string(h.percentile(99.9));
+        return ret;
+    };
+
+    Json::Value ret(Json::objectValue);
+    for (auto const& [method, latency] : latency_)
+    {
+        auto const count = latency.handler.count();
+        if (count == 0)
+            continue;
+
+        Json::Value& m = ret[method];
+        m[jss::count] = std::to_string(count);
+        m[jss::queue_us] = percentiles(latency.queue);
+        m[jss::ledger_us] = percentiles(latency.ledger);
+        m[jss::handler_us] = percentiles(latency.handler);
+        m[jss::serialize_us] = percentiles(latency.serialize);
+    }
+    return ret;
+}
+
 Json::Value
 PerfLogImp::Counters::currentJson() const
 {
@@ -378,6 +423,25 @@ PerfLogImp::rpcEnd(
         steady_clock::now() - startTime);
 }
 
+void
+PerfLogImp::rpcTimes(std::string const& method, RpcTimes const& times)
+{
+    // The servers report whatever method the client named, so unknown
+    // methods are expected and are not tracked.
+    auto const it = counters_.latency_.find(method);
+    if (it == counters_.latency_.end())
+        return;
+
+    auto const us = [](microseconds dur) {
+        return static_cast<std::uint64_t>(
+            std::max<std::int64_t>(0, dur.count()));
+    };
+    it->second.queue.add(us(times.queue));
+    it->second.ledger.add(us(times.ledger));
+    it->second.handler.add(us(times.handler));
+    it->second.serialize.add(us(times.serialize));
+}
+
 void
 PerfLogImp::jobQueue(JobType const type)
 {
@@ -433,6 +497,30 @@ PerfLogImp::jobFinish(JobType const type, microseconds dur, int instance)
         counters_.jobs_[instance] = {jtINVALID, steady_time_point()};
 }
 
+void
+PerfLogImp::invariantCheck(char const* name, nanoseconds dur, bool passed)
+{
+    auto& checks = counters_.inv_;
+    Counters::Inv* counter = nullptr;
+    {
+        std::shared_lock lock(counters_.invMutex_);
+        if (auto const it = checks.find(std::string_view{name});
+            it != checks.end())
+            counter = &it->second;
+    }
+    if (!counter)
+    {
+        std::unique_lock lock(counters_.invMutex_);
+        counter = &checks.try_emplace(name).first->second;
+    }
+
+    // Entries of the map are never removed, so the counter outlives the lock
+    counter->checked.fetch_add(1, std::memory_order_relaxed);
+    if (!passed)
+        counter->failed.fetch_add(1, std::memory_order_relaxed);
+    counter->duration.fetch_add(dur.count(), std::memory_order_relaxed);
+}
+
 void
 PerfLogImp::resizeJobs(int const resize)
 {
@@ -20,17 +20,21 @@
 #ifndef RIPPLE_BASICS_PERFLOGIMP_H
 #define RIPPLE_BASICS_PERFLOGIMP_H
 
+#include <ripple/basics/Histogram.h>
 #include <ripple/basics/PerfLog.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/impl/Handler.h>
 #include <boost/asio/ip/host_name.hpp>
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <fstream>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <thread>
 #include <type_traits>
@@ -104,10 +108,41 @@ class PerfLogImp : public PerfLog
             microseconds runningDuration{0};
         };
 
+        /**
+         * Latency of each phase of RPC calls, in microseconds.
+         */
+        struct Latency
+        {
+            Histogram queue;
+            Histogram ledger;
+            Histogram handler;
+            Histogram serialize;
+        };
+
+        /**
+         * Invariant checker performance counters.
+         */
+        struct Inv
+        {
+            // Counters for each transaction a checker ran over and for
+            // each one that failed the check.
+            std::atomic<std::uint64_t> checked{0};
+            std::atomic<std::uint64_t> failed{0};
+            // Cumulative duration of all runs.
+            std::atomic<nanoseconds::rep> duration{0};
+        };
+
         // rpc_ and jq_ do not need mutex protection because all
         // keys and values are created before more threads are started.
         std::unordered_map<std::string, Locked<Rpc>> rpc_;
+        // The histograms are atomic, so latency_ needs no mutex either.
+        std::unordered_map<std::string, Latency> latency_;
         std::unordered_map<JobType, Locked<Jq>> jq_;
+        // Checkers are added the first time they report, which takes the
+        // mutex exclusively. Later reports only share it, since the
+        // counters themselves are atomic.
+        std::map<std::string, Inv, std::less<>> inv_;
+        mutable std::shared_mutex invMutex_;
         std::vector<std::pair<JobType, steady_time_point>> jobs_;
         mutable std::mutex jobsMutex_;
         std::unordered_map<std::uint64_t, MethodStart> methods_;
@@ -118,6 +153,8 @@ class PerfLogImp : public PerfLog
         countersJson() const;
         Json::Value
         currentJson() const;
+        Json::Value
+        latencyJson() const;
     };
 
     Setup const setup_;
@@ -170,6 +207,9 @@ public:
         rpcEnd(method, requestId, false);
     }
 
+    void
+    rpcTimes(std::string const& method, RpcTimes const& times) override;
+
     void
     jobQueue(JobType const type) override;
     void
@@ -180,6 +220,8 @@ public:
         int instance) override;
     void
     jobFinish(JobType const type, microseconds dur, int instance) override;
+    void
+    invariantCheck(char const* name, nanoseconds dur, bool passed) override;
 
     Json::Value
     countersJson() const override
@@ -193,6 +235,12 @@ public:
         return counters_.currentJson();
     }
 
+    Json::Value
+    rpcLatencyJson() const override
+    {
+        return counters_.latencyJson();
+    }
+
     void
     resizeJobs(int const resize) override;
     void
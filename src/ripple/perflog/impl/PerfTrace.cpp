@@ -0,0 +1,298 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/PerfTrace.h>
+#include <ripple/beast/core/CurrentThreadName.h>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ripple {
+namespace perf {
+namespace trace {
+
+namespace detail {
+std::atomic<bool> enabled{false};
+}  // namespace detail
+
+namespace {
+
+// The number of rings of threads that have exited to keep for export
+constexpr std::size_t maxRetired = 64;
+
+struct Event
+{
+    // Odd while the event is written, then 2 * (index + 1). Readers copy
+    // an event only if this is the same, and even, before and after.
+    std::atomic<std::uint64_t> seq{0};
+    std::atomic<std::int64_t> begin{0};
+    // Negative for an instant event
+    std::atomic<std::int64_t> duration{0};
+    std::atomic<char const*> category{nullptr};
+    std::atomic<char const*> name{nullptr};
+    std::atomic<char const*> argName{nullptr};
+    std::atomic<std::int64_t> arg{0};
+};
+
+struct Ring
+{
+    Ring(std::uint32_t tid_, std::string threadName_)
+        : tid(tid_)
+        , threadName(std::move(threadName_))
+        , events(std::make_unique<Event[]>(eventsPerThread))
+    {
+    }
+
+    std::uint32_t const tid;
+    std::string const threadName;
+    // Only the owning thread writes
+    std::atomic<std::uint64_t> head{0};
+    std::unique_ptr<Event[]> const events;
+    bool retired = false;
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    // Oldest first
+    std::vector<std::shared_ptr<Ring>> rings;
+    std::uint32_t nextTid = 1;
+    std::atomic<std::int64_t> since{0};
+
+    std::shared_ptr<Ring>
+    add()
+    {
+        auto name = beast::getCurrentThreadName();
+        std::lock_guard lock(mutex);
+        auto ring = std::make_shared<Ring>(nextTid++, std::move(name));
+        rings.push_back(ring);
+        return ring;
+    }
+
+    void
+    retire(std::shared_ptr<Ring> const& ring)
+    {
+        std::lock_guard lock(mutex);
+        ring->retired = true;
+        auto const retired = std::count_if(
+            rings.begin(), rings.end(), [](auto const& r) {
+                return r->retired;
+            });
+        if (retired > maxRetired)
+        {
+            rings.erase(std::find_if(
+                rings.begin(), rings.end(), [](auto const& r) {
+                    return r->retired;
+                }));
+        }
+    }
+};
+
+// Never destroyed, as detached threads may record until the process ends
+Registry&
+registry()
+{
+    static Registry* const r = new Registry;
+    return *r;
+}
+
+struct Holder
+{
+    std::shared_ptr<Ring> ring;
+
+    ~Holder()
+    {
+        if (ring)
+            registry().retire(ring);
+    }
+};
+
+std::int64_t
+toNanoseconds(clock_type::time_point t)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               t.time_since_epoch())
+        .count();
+}
+
+void
+record(
+    char const* category,
+    char const* name,
+    std::int64_t begin,
+    std::int64_t duration,
+    char const* argName,
+    std::int64_t arg)
+{
+    thread_local Holder holder;
+    if (!holder.ring)
+        holder.ring = registry().add();
+
+    auto& ring = *holder.ring;
+    auto const i = ring.head.load(std::memory_order_relaxed);
+    auto& e = ring.events[i % eventsPerThread];
+
+    e.seq.store(2 * i + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    e.begin.store(begin, std::memory_order_relaxed);
+    e.duration.store(duration, std::memory_order_relaxed);
+    e.category.store(category, std::memory_order_relaxed);
+    e.name.store(name, std::memory_order_relaxed);
+    e.argName.store(argName, std::memory_order_relaxed);
+    e.arg.store(arg, std::memory_order_relaxed);
+    e.seq.store(2 * i + 2, std::memory_order_release);
+    ring.head.store(i + 1, std::memory_order_release);
+}
+
+}  // namespace
+
+void
+start()
+{
+    registry().since.store(
+        toNanoseconds(clock_type::now()), std::memory_order_relaxed);
+    detail::enabled.store(true, std::memory_order_relaxed);
+}
+
+void
+stop()
+{
+    detail::enabled.store(false, std::memory_order_relaxed);
+}
+
+void
+complete(
+    char const* category,
+    char const* name,
+    clock_type::time_point begin,
+    clock_type::time_point end,
+    char const* argName,
+    std::int64_t arg)
+{
+    if (!enabled())
+        return;
+    auto const b = toNanoseconds(begin);
+    record(
+        category,
+        name,
+        b,
+        std::max<std::int64_t>(toNanoseconds(end) - b, 0),
+        argName,
+        arg);
+}
+
+void
+instant(
+    char const* category,
+    char const* name,
+    char const* argName,
+    std::int64_t arg)
+{
+    if (!enabled())
+        return;
+    record(
+        category, name, toNanoseconds(clock_type::now()), -1, argName, arg);
+}
+
+Json::Value
+toJson()
+{
+    auto& reg = registry();
+    auto const since = reg.since.load(std::memory_order_relaxed);
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard lock(reg.mutex);
+        rings = reg.rings;
+    }
+
+    // Chrome takes timestamps in microseconds
+    auto const micros = [](std::int64_t ns) { return ns / 1000.0; };
+
+    Json::Value events(Json::arrayValue);
+    for (auto const& ring : rings)
+    {
+        {
+            Json::Value meta(Json::objectValue);
+            meta["name"] = "thread_name";
+            meta["ph"] = "M";
+            meta["pid"] = 1;
+            meta["tid"] = ring->tid;
+            meta["args"]["name"] = ring->threadName;
+            events.append(std::move(meta));
+        }
+
+        auto const head = ring->head.load(std::memory_order_acquire);
+        auto const first = head > eventsPerThread ? head - eventsPerThread : 0;
+        for (auto i = first; i != head; ++i)
+        {
+            auto const& e = ring->events[i % eventsPerThread];
+            auto const seq = e.seq.load(std::memory_order_acquire);
+            if (seq != 2 * i + 2)
+                continue;
+            auto const begin = e.begin.load(std::memory_order_relaxed);
+            auto const duration = e.duration.load(std::memory_order_relaxed);
+            auto const category = e.category.load(std::memory_order_relaxed);
+            auto const name = e.name.load(std::memory_order_relaxed);
+            auto const argName = e.argName.load(std::memory_order_relaxed);
+            auto const arg = e.arg.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (e.seq.load(std::memory_order_relaxed) != seq)
+                continue;
+            // Keep what was still running when tracing started
+            if (begin + std::max<std::int64_t>(duration, 0) < since)
+                continue;
+
+            Json::Value event(Json::objectValue);
+            event["name"] = name;
+            event["cat"] = category;
+            event["pid"] = 1;
+            event["tid"] = ring->tid;
+            event["ts"] = micros(begin);
+            if (duration < 0)
+            {
+                event["ph"] = "i";
+                event["s"] = "t";
+            }
+            else
+            {
+                event["ph"] = "X";
+                event["dur"] = micros(duration);
+            }
+            if (argName)
+                event["args"][argName] = static_cast<Json::Int>(
+                    std::clamp<std::int64_t>(
+                        arg,
+                        std::numeric_limits<Json::Int>::min(),
+                        std::numeric_limits<Json::Int>::max()));
+            events.append(std::move(event));
+        }
+    }
+
+    Json::Value ret(Json::objectValue);
+    ret["traceEvents"] = std::move(events);
+    ret["displayTimeUnit"] = "ms";
+    return ret;
+}
+
+}  // namespace trace
+}  // namespace perf
+}  // namespace ripple
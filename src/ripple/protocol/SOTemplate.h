@@ -130,9 +130,24 @@ public:
         return elements_.size();
     }
 
-    /** Retrieve the position of a named field. */
+    /** Retrieve the position of a named field.
+
+        This is a lookup in a table indexed by field number, and it is
+        defined here so the lookups STObject makes on every field access
+        can be inlined.
+
+        @return The position, or -1 if the template has no such field.
+    */
     int
-    getIndex(SField const&) const;
+    getIndex(SField const& sField) const
+    {
+        // The mapping table should be large enough for any possible field
+        //
+        if (sField.getNum() <= 0 || sField.getNum() >= indices_.size())
+            Throw<std::runtime_error>("Invalid field index for getIndex().");
+
+        return indices_[sField.getNum()];
+    }
 
     SOEStyle
     style(SField const& sf) const
@@ -58,6 +58,13 @@ class STValidation final : public STObject, public CountedObject<STValidation>
 
     NetClock::time_point seenTime_ = {};
 
+    // Copies of the fields that consensus reads over and over, taken once
+    // the validation is complete. A validation is not modified after it is
+    // constructed, so these never go stale.
+    uint256 ledgerHash_;
+    std::uint32_t ledgerSeq_ = 0;
+    NetClock::time_point signTime_ = {};
+
 public:
     /** Construct a STValidation from a peer from serialized data.
 
@@ -95,15 +102,19 @@ public:
         F&& f);
 
     // Hash of the validated ledger
-    uint256
-    getLedgerHash() const;
+    uint256 const&
+    getLedgerHash() const noexcept;
+
+    /** Validated ledger's sequence number */
+    std::uint32_t
+    getLedgerSeq() const noexcept;
 
     // Hash of consensus transaction set used to generate ledger
     uint256
     getConsensusHash() const;
 
     NetClock::time_point
-    getSignTime() const;
+    getSignTime() const noexcept;
 
     NetClock::time_point
     getSeenTime() const noexcept;
@@ -141,10 +152,24 @@ public:
     Blob
     getSignature() const;
 
+    /** Find the key that signed a serialized validation.
+
+        Only the fields ahead of the key are read and the signature is not
+        checked, so this is meant for data known to match a validation
+        that was already fully deserialized.
+
+        @return The key, or an unseated optional if it was not found
+    */
+    static std::optional<PublicKey>
+    peekSignerPublic(Slice data);
+
 private:
     static SOTemplate const&
     validationFormat();
 
+    void
+    cacheFields();
+
     STBase*
     copy(std::size_t n, void* buf) const override;
     STBase*
@@ -177,6 +202,7 @@ STValidation::STValidation(
     }
 
     assert(nodeID_.isNonZero());
+    cacheFields();
 }
 
 /** Construct, sign and trust a new STValidation issued by this node.
@@ -227,6 +253,25 @@ STValidation::STValidation(
 
     // We just signed this, so it should be valid.
     valid_ = true;
+    cacheFields();
+}
+
+inline uint256 const&
+STValidation::getLedgerHash() const noexcept
+{
+    return ledgerHash_;
+}
+
+inline std::uint32_t
+STValidation::getLedgerSeq() const noexcept
+{
+    return ledgerSeq_;
+}
+
+inline NetClock::time_point
+STValidation::getSignTime() const noexcept
+{
+    return signTime_;
 }
 
 inline PublicKey const&
@@ -33,6 +33,7 @@
 #include <cstdint>
 #include <cstring>
 #include <iomanip>
+#include <optional>
 #include <type_traits>
 
 namespace ripple {
@@ -306,6 +307,45 @@ Serializer::addVL(Iter begin, Iter end, int len)
 
 //------------------------------------------------------------------------------
 
+/** A Serializer for output that is used up before it goes away.
+
+    Serializing an object just to hash it, for instance, fills a buffer
+    that is thrown away at once. Each thread keeps one buffer that is
+    lent, emptied, to a single ScratchSerializer at a time, so once it
+    has grown to fit this does not allocate. A ScratchSerializer made
+    while the thread's buffer is lent out gets a buffer of its own.
+
+    The data must not be moved out of the buffer.
+*/
+class ScratchSerializer
+{
+private:
+    Serializer* s_;
+    std::optional<Serializer> own_;
+
+public:
+    ScratchSerializer();
+    ~ScratchSerializer();
+
+    ScratchSerializer(ScratchSerializer const&) = delete;
+    ScratchSerializer&
+    operator=(ScratchSerializer const&) = delete;
+
+    Serializer&
+    operator*() noexcept
+    {
+        return *s_;
+    }
+
+    Serializer*
+    operator->() noexcept
+    {
+        return s_;
+    }
+};
+
+//------------------------------------------------------------------------------
+
 // DEPRECATED
 // Transitional adapter to new serialization interfaces
 class SerialIter
@@ -86,11 +86,10 @@ public:
     boost::container::flat_set<AccountID>
     getAffectedAccounts() const;
 
+    /** Equivalent to getAsObject().getJson(), without copying the nodes */
     Json::Value
-    getJson(JsonOptions p) const
-    {
-        return getAsObject().getJson(p);
-    }
+    getJson(JsonOptions p) const;
+
     void
     addRaw(Serializer&, TER, std::uint32_t index);
 
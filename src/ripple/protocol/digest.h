@@ -25,6 +25,7 @@
 #include <boost/endian/conversion.hpp>
 #include <algorithm>
 #include <array>
+#include <span>
 
 namespace ripple {
 
@@ -237,6 +238,20 @@ sha512Half_s(Args const&... args)
     return static_cast<typename sha512_half_hasher_s::result_type>(h);
 }
 
+/** Computes the SHA512-Half of many independent messages.
+
+    For each `i`, `digests[i]` receives the same value as
+    `sha512Half(messages[i])`. Where the processor supports it, several
+    messages are hashed at once in separate vector lanes, which is much
+    faster than hashing them one by one when there are a lot of small
+    messages, such as the nodes of a SHAMap.
+
+    @param messages The messages to hash.
+    @param digests Receives one digest per message; must be the same size.
+*/
+void
+sha512HalfBatch(std::span<Slice const> messages, std::span<uint256> digests);
+
 }  // namespace ripple
 
 #endif
@@ -23,6 +23,7 @@
 #include <ripple/protocol/PublicKey.h>
 #include <ripple/protocol/digest.h>
 #include <ripple/protocol/tokens.h>
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <mutex>
@@ -31,7 +32,13 @@ namespace ripple {
 
 namespace detail {
 
-/** Caches the base58 representations of AccountIDs */
+/** Caches the base58 representations of AccountIDs
+
+    The cache is set associative: an AccountID can be held in any of the
+    slots of the set it hashes to, and a set evicts its least recently
+    used entry, so a few busy accounts that hash alike do not keep
+    evicting one another.
+*/
 class AccountIdCache
 {
 private:
@@ -41,8 +48,13 @@ private:
         char encoding[40] = {0};
     };
 
+    static constexpr std::size_t ways = 4;
+
+    // Most recently used first
+    using Set = std::array<CachedAccountID, ways>;
+
     // The actual cache
-    std::vector<CachedAccountID> cache_;
+    std::vector<Set> sets_;
 
     // We use a hash function designed to resist algorithmic complexity attacks
     hardened_hash<> hasher_;
@@ -51,17 +63,19 @@ private:
     std::atomic<std::uint64_t> locks_ = 0;
 
 public:
-    AccountIdCache(std::size_t count) : cache_(count)
+    AccountIdCache(std::size_t count)
+        : sets_(std::max<std::size_t>(count / ways, 1))
     {
         // This is non-binding, but we try to avoid wasting memory that
         // is caused by overallocation.
-        cache_.shrink_to_fit();
+        sets_.shrink_to_fit();
     }
 
     std::string
     toBase58(AccountID const& id)
     {
-        auto const index = hasher_(id) % cache_.size();
+        auto const index = hasher_(id) % sets_.size();
+        auto& set = sets_[index];
 
         packed_spinlock sl(locks_, index % 64);
 
@@ -70,8 +84,16 @@ public:
 
             // The check against the first character of the encoding ensures
             // that we don't mishandle the case of the all-zero account:
-            if (cache_[index].encoding[0] != 0 && cache_[index].id == id)
-                return cache_[index].encoding;
+            auto const it = std::find_if(
+                set.begin(), set.end(), [&id](CachedAccountID const& c) {
+                    return c.encoding[0] != 0 && c.id == id;
+                });
+
+            if (it != set.end())
+            {
+                std::rotate(set.begin(), it, it + 1);
+                return set.front().encoding;
+            }
         }
 
         auto ret =
@@ -81,8 +103,14 @@ public:
 
         {
             std::lock_guard lock(sl);
-            cache_[index].id = id;
-            std::strcpy(cache_[index].encoding, ret.c_str());
+
+            // Another thread may have added it meanwhile
+            if (set.front().encoding[0] == 0 || set.front().id != id)
+            {
+                std::rotate(set.begin(), set.end() - 1, set.end());
+                set.front().id = id;
+                std::strcpy(set.front().encoding, ret.c_str());
+            }
         }
 
         return ret;
@@ -18,12 +18,19 @@
 //==============================================================================
 
 #include <ripple/basics/contract.h>
+#include <ripple/basics/hardened_hash.h>
+#include <ripple/basics/spinlock.h>
 #include <ripple/basics/strHex.h>
 #include <ripple/protocol/PublicKey.h>
 #include <ripple/protocol/digest.h>
 #include <ripple/protocol/impl/secp256k1.h>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <ed25519.h>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <mutex>
 #include <type_traits>
 
 namespace ripple {
@@ -218,6 +225,77 @@ publicKeyType(Slice const& slice)
     return std::nullopt;
 }
 
+namespace {
+
+/** Caches secp256k1 public keys in their parsed form.
+
+    Parsing a compressed key decompresses it, at the cost of a square root
+    modulo the field prime. Most of what we verify is signed by a few keys,
+    those of validators above all, so keeping recently parsed keys saves
+    that work on nearly every verification.
+
+    The cache is direct mapped over a hash that resists algorithmic
+    complexity attacks, so made-up keys cannot target the slots of
+    particular keys.
+*/
+class ParsedKeyCache
+{
+private:
+    struct Entry
+    {
+        // All zero while the slot is empty; no valid key starts with 0
+        std::array<std::uint8_t, 33> key{};
+        secp256k1_pubkey parsed;
+    };
+
+    static constexpr std::size_t size = 1024;
+
+    std::array<Entry, size> entries_;
+
+    hardened_hash<> hasher_;
+
+    // 64 spinlocks, packed into a single 64-bit value
+    std::atomic<std::uint64_t> locks_ = 0;
+
+public:
+    bool
+    parse(PublicKey const& pk, secp256k1_pubkey& out)
+    {
+        assert(pk.size() == std::tuple_size_v<decltype(Entry::key)>);
+
+        auto const index = hasher_(pk) % size;
+        auto& entry = entries_[index];
+
+        packed_spinlock sl(locks_, index % 64);
+
+        {
+            std::lock_guard lock(sl);
+            if (std::memcmp(entry.key.data(), pk.data(), pk.size()) == 0)
+            {
+                out = entry.parsed;
+                return true;
+            }
+        }
+
+        if (secp256k1_ec_pubkey_parse(
+                secp256k1Context(),
+                &out,
+                reinterpret_cast<unsigned char const*>(pk.data()),
+                pk.size()) != 1)
+            return false;
+
+        {
+            std::lock_guard lock(sl);
+            std::memcpy(entry.key.data(), pk.data(), pk.size());
+            entry.parsed = out;
+        }
+
+        return true;
+    }
+};
+
+}  // namespace
+
 bool
 verifyDigest(
     PublicKey const& publicKey,
@@ -234,12 +312,10 @@ verifyDigest(
         (*canonicality != ECDSACanonicality::fullyCanonical))
         return false;
 
+    static ParsedKeyCache parsedKeys;
+
     secp256k1_pubkey pubkey_imp;
-    if (secp256k1_ec_pubkey_parse(
-            secp256k1Context(),
-            &pubkey_imp,
-            reinterpret_cast<unsigned char const*>(publicKey.data()),
-            publicKey.size()) != 1)
+    if (!parsedKeys.parse(publicKey, pubkey_imp))
         return false;
 
     secp256k1_ecdsa_signature sig_imp;
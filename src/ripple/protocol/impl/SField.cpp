@@ -18,9 +18,12 @@
 //==============================================================================
 
 #include <ripple/protocol/SField.h>
+#include <array>
 #include <cassert>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 
 namespace ripple {
@@ -30,6 +33,45 @@ SField::IsSigning const SField::notSigning;
 int SField::num = 0;
 std::map<int, SField const*> SField::knownCodeToField;
 
+namespace {
+
+// Every field is in knownCodeToField. Those whose type and value codes
+// are small, which is all of the ones that appear in serialized objects,
+// are also found by indexing this table, which is much cheaper than
+// searching the map. Being constant initialized, the table is ready
+// before any SField is constructed.
+constexpr int denseTypes = 32;
+constexpr int denseValues = 256;
+
+std::array<SField const*, denseTypes * denseValues> denseCodeToField{};
+
+std::optional<std::size_t>
+denseIndex(int code)
+{
+    int const type = code >> 16;
+    int const value = code & 0xffff;
+    if (code < 0 || type >= denseTypes || value >= denseValues)
+        return std::nullopt;
+    return type * denseValues + value;
+}
+
+// This is defined ahead of the SFields, so it is constructed before them
+std::unordered_map<std::string_view, SField const*> knownNameToField;
+
+void
+registerField(SField const& f)
+{
+    if (auto const index = denseIndex(f.fieldCode))
+        denseCodeToField[*index] = &f;
+
+    // Where names repeat, the field with the lowest code wins
+    auto const [it, inserted] = knownNameToField.emplace(f.fieldName, &f);
+    if (!inserted && f.fieldCode < it->second->fieldCode)
+        it->second = &f;
+}
+
+}  // namespace
+
 // Give only this translation unit permission to construct SFields
 struct SField::private_access_tag_t
 {
@@ -434,6 +476,7 @@ SField::SField(
     , jsonName(fieldName.c_str())
 {
     knownCodeToField[fieldCode] = this;
+    registerField(*this);
 }
 
 SField::SField(private_access_tag_t, int fc)
@@ -446,11 +489,19 @@ SField::SField(private_access_tag_t, int fc)
     , jsonName(fieldName.c_str())
 {
     knownCodeToField[fieldCode] = this;
+    registerField(*this);
 }
 
 SField const&
 SField::getField(int code)
 {
+    if (auto const index = denseIndex(code))
+    {
+        if (auto const f = denseCodeToField[*index])
+            return *f;
+        return sfInvalid;
+    }
+
     auto it = knownCodeToField.find(code);
 
     if (it != knownCodeToField.end())
@@ -479,12 +530,9 @@ SField::compare(SField const& f1, SField const& f2)
 SField const&
 SField::getField(std::string const& fieldName)
 {
-    for (auto const& [_, f] : knownCodeToField)
-    {
-        (void)_;
-        if (f->fieldName == fieldName)
-            return *f;
-    }
+    if (auto const it = knownNameToField.find(fieldName);
+        it != knownNameToField.end())
+        return *it->second;
     return sfInvalid;
 }
 
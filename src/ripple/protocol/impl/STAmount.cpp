@@ -1113,6 +1113,14 @@ operator-(STAmount const& value)
 //
 //------------------------------------------------------------------------------
 
+// The compiler's own 128 bit integers, where it has them, are much faster
+// than the multiprecision ones and give the same results
+#ifdef __SIZEOF_INT128__
+using muldiv_uint128_t = unsigned __int128;
+#else
+using muldiv_uint128_t = boost::multiprecision::uint128_t;
+#endif
+
 // Calculate (a * b) / c when all three values are 64-bit
 // without loss of precision:
 static std::uint64_t
@@ -1121,9 +1129,7 @@ muldiv(
     std::uint64_t multiplicand,
     std::uint64_t divisor)
 {
-    boost::multiprecision::uint128_t ret;
-
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    muldiv_uint128_t ret = muldiv_uint128_t(multiplier) * multiplicand;
     ret /= divisor;
 
     if (ret > std::numeric_limits<std::uint64_t>::max())
@@ -1143,9 +1149,7 @@ muldiv_round(
     std::uint64_t divisor,
     std::uint64_t rounding)
 {
-    boost::multiprecision::uint128_t ret;
-
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    muldiv_uint128_t ret = muldiv_uint128_t(multiplier) * multiplicand;
     ret += rounding;
     ret /= divisor;
 
@@ -25,6 +25,7 @@
 #include <ripple/protocol/STArray.h>
 #include <ripple/protocol/STBlob.h>
 #include <ripple/protocol/STObject.h>
+#include <utility>
 
 namespace ripple {
 
@@ -149,7 +150,7 @@ STObject::applyTemplate(const SOTemplate& type)
             });
         if (iter != v_.end())
         {
-            if ((e.style() == soeDEFAULT) && iter->get().isDefault())
+            if ((e.style() == soeDEFAULT) && std::as_const(*iter)->isDefault())
             {
                 throwFieldErr(
                     e.sField().fieldName,
@@ -231,12 +232,9 @@ STObject::set(SerialIter& sit, int depth)
             Throw<std::runtime_error>("Unknown field");
         }
 
-        // Unflatten the field
-        v_.emplace_back(sit, fn, depth + 1);
-
-        // If the object type has a known SOTemplate then set it.
-        if (auto const obj = dynamic_cast<STObject*>(&(v_.back().get())))
-            obj->applyTemplateFromSField(fn);  // May throw
+        // Unflatten the field. An object gets the template of its field,
+        // if it has a known one, as it is made.
+        v_.emplace_back(sit, fn, depth + 1);  // May throw
     }
 
     // We want to ensure that the deserialized object does not contain any
@@ -353,19 +351,19 @@ STObject::isEquivalent(const STBase& t) const
 uint256
 STObject::getHash(HashPrefix prefix) const
 {
-    Serializer s;
-    s.add32(prefix);
-    add(s, withAllFields);
-    return s.getSHA512Half();
+    ScratchSerializer s;
+    s->add32(prefix);
+    add(*s, withAllFields);
+    return s->getSHA512Half();
 }
 
 uint256
 STObject::getSigningHash(HashPrefix prefix) const
 {
-    Serializer s;
-    s.add32(prefix);
-    add(s, omitSigningFields);
-    return s.getSHA512Half();
+    ScratchSerializer s;
+    s->add32(prefix);
+    add(*s, omitSigningFields);
+    return s->getSHA512Half();
 }
 
 int
@@ -282,7 +282,8 @@ STTx::getMetaSQL(std::uint32_t inLedger, std::string const& escapedMetaData)
 {
     Serializer s;
     add(s);
-    return getMetaSQL(s, inLedger, txnSqlValidated, escapedMetaData);
+    return getMetaSQL(
+        std::move(s), inLedger, txnSqlValidated, escapedMetaData);
 }
 
 // VFALCO This could be a free function elsewhere
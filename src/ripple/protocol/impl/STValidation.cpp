@@ -72,16 +72,19 @@ STValidation::validationFormat()
     return format;
 };
 
-uint256
-STValidation::getSigningHash() const
+void
+STValidation::cacheFields()
 {
-    return STObject::getSigningHash(HashPrefix::validation);
+    ledgerHash_ = getFieldH256(sfLedgerHash);
+    ledgerSeq_ = getFieldU32(sfLedgerSequence);
+    signTime_ =
+        NetClock::time_point{NetClock::duration{getFieldU32(sfSigningTime)}};
 }
 
 uint256
-STValidation::getLedgerHash() const
+STValidation::getSigningHash() const
 {
-    return getFieldH256(sfLedgerHash);
+    return STObject::getSigningHash(HashPrefix::validation);
 }
 
 uint256
@@ -90,12 +93,6 @@ STValidation::getConsensusHash() const
     return getFieldH256(sfConsensusHash);
 }
 
-NetClock::time_point
-STValidation::getSignTime() const
-{
-    return NetClock::time_point{NetClock::duration{getFieldU32(sfSigningTime)}};
-}
-
 NetClock::time_point
 STValidation::getSeenTime() const noexcept
 {
@@ -136,7 +133,63 @@ STValidation::getSerialized() const
 {
     Serializer s;
     add(s);
-    return s.peekData();
+    return std::move(s.modData());
+}
+
+std::optional<PublicKey>
+STValidation::peekSignerPublic(Slice data)
+{
+    // Fields are serialized in order of type and then name, so the signing
+    // key can only be preceded by fields of the fixed size types, amounts
+    // and a few other variable length fields.
+    try
+    {
+        SerialIter sit(data);
+        while (!sit.empty())
+        {
+            int type;
+            int name;
+            sit.getFieldID(type, name);
+            switch (type)
+            {
+                case STI_UINT16:
+                    sit.skip(2);
+                    break;
+                case STI_UINT32:
+                    sit.skip(4);
+                    break;
+                case STI_UINT64:
+                    sit.skip(8);
+                    break;
+                case STI_UINT128:
+                    sit.skip(16);
+                    break;
+                case STI_UINT256:
+                    sit.skip(32);
+                    break;
+                case STI_AMOUNT:
+                    // Native amounts take 8 bytes, the others 48
+                    sit.skip((sit.get8() & 0x80) ? 47 : 7);
+                    break;
+                case STI_VL:
+                    if (name == sfSigningPubKey.fieldValue)
+                    {
+                        auto const key = sit.getVL();
+                        if (!publicKeyType(makeSlice(key)))
+                            return std::nullopt;
+                        return PublicKey(makeSlice(key));
+                    }
+                    sit.skip(sit.getVLDataLength());
+                    break;
+                default:
+                    return std::nullopt;
+            }
+        }
+    }
+    catch (std::exception const&)
+    {
+    }
+    return std::nullopt;
 }
 
 }  // namespace ripple
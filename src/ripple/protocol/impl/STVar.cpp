@@ -33,6 +33,7 @@
 #include <ripple/protocol/STVector256.h>
 #include <ripple/protocol/STXChainBridge.h>
 #include <ripple/protocol/XChainAttestations.h>
+#include <atomic>
 
 namespace ripple {
 namespace detail {
@@ -49,21 +50,12 @@ STVar::~STVar()
 
 STVar::STVar(STVar const& other)
 {
-    if (other.p_ != nullptr)
-        p_ = other.p_->copy(max_size, &d_);
+    assign(other);
 }
 
 STVar::STVar(STVar&& other)
 {
-    if (other.on_heap())
-    {
-        p_ = other.p_;
-        other.p_ = nullptr;
-    }
-    else
-    {
-        p_ = other.p_->move(max_size, &d_);
-    }
+    assign(std::move(other));
 }
 
 STVar&
@@ -72,10 +64,7 @@ STVar::operator=(STVar const& rhs)
     if (&rhs != this)
     {
         destroy();
-        if (rhs.p_)
-            p_ = rhs.p_->copy(max_size, &d_);
-        else
-            p_ = nullptr;
+        assign(rhs);
     }
 
     return *this;
@@ -87,20 +76,38 @@ STVar::operator=(STVar&& rhs)
     if (&rhs != this)
     {
         destroy();
-        if (rhs.on_heap())
-        {
-            p_ = rhs.p_;
-            rhs.p_ = nullptr;
-        }
-        else
-        {
-            p_ = rhs.p_->move(max_size, &d_);
-        }
+        assign(std::move(rhs));
     }
 
     return *this;
 }
 
+STVar::STVar(STBase&& t)
+{
+    if (is_shared_type(t))
+    {
+        adopt(std::unique_ptr<STBase>(t.move(0, nullptr)));
+        return;
+    }
+
+    p_ = t.move(max_size, &d_);
+    if (on_heap())
+        adopt(std::unique_ptr<STBase>(p_));
+}
+
+STVar::STVar(STBase const& t)
+{
+    if (is_shared_type(t))
+    {
+        adopt(std::unique_ptr<STBase>(t.copy(0, nullptr)));
+        return;
+    }
+
+    p_ = t.copy(max_size, &d_);
+    if (on_heap())
+        adopt(std::unique_ptr<STBase>(p_));
+}
+
 STVar::STVar(defaultObject_t, SField const& name) : STVar(name.fieldType, name)
 {
 }
@@ -157,6 +164,16 @@ STVar::STVar(SerialIter& sit, SField const& name, int depth)
             return;
         case STI_OBJECT:
             construct<STObject>(sit, name, depth);
+            try
+            {
+                // Before anything can share it
+                static_cast<STObject*>(p_)->applyTemplateFromSField(name);
+            }
+            catch (...)
+            {
+                destroy();
+                throw;
+            }
             return;
         case STI_ARRAY:
             construct<STArray>(sit, name, depth);
@@ -237,12 +254,88 @@ void
 STVar::destroy()
 {
     if (on_heap())
-        delete p_;
-    else
+        shared().~Shared();
+    else if (p_ != nullptr)
         p_->~STBase();
 
     p_ = nullptr;
 }
 
+void
+STVar::assign(STVar const& other)
+{
+    if (other.p_ == nullptr)
+        return;
+
+    if (!other.on_heap())
+        p_ = other.p_->copy(max_size, &d_);
+    else if (!other.shared().leaked)
+        adopt(other.shared().object);
+    else
+        adopt(std::unique_ptr<STBase>(other.p_->copy(0, nullptr)));
+}
+
+void
+STVar::assign(STVar&& other)
+{
+    if (other.p_ == nullptr)
+        return;
+
+    if (other.on_heap())
+    {
+        adopt(std::move(other.shared().object), other.shared().leaked);
+        other.destroy();
+    }
+    else
+    {
+        p_ = other.p_->move(max_size, &d_);
+    }
+}
+
+void
+STVar::adopt(std::shared_ptr<STBase> object, bool leaked)
+{
+    p_ = object.get();
+    new (&d_) Shared{std::move(object), leaked};
+}
+
+void
+STVar::unshare()
+{
+    auto& s = shared();
+
+    // Only a variant being changed can drop the count to one, and this
+    // one is being changed here, so no other thread can be racing it.
+    if (s.object.use_count() > 1)
+    {
+        s.object.reset(p_->copy(0, nullptr));
+        p_ = s.object.get();
+    }
+    else
+    {
+        // use_count() is a relaxed load. Pair it with the release of the
+        // last other copy, so that its reads of the object happen before
+        // this variant changes it.
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+
+    s.leaked = true;
+}
+
+bool
+STVar::is_shared_type(STBase const& t)
+{
+    switch (t.getSType())
+    {
+        case STI_OBJECT:
+        case STI_ARRAY:
+        case STI_VECTOR256:
+        case STI_PATHSET:
+            return true;
+        default:
+            return false;
+    }
+}
+
 }  // namespace detail
 }  // namespace ripple
@@ -25,10 +25,19 @@
 #include <ripple/protocol/Serializer.h>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
 #include <typeinfo>
 #include <utility>
 
 namespace ripple {
+
+class STArray;
+class STObject;
+class STPathSet;
+class STVector256;
+
 namespace detail {
 
 struct defaultObject_t
@@ -46,12 +55,29 @@ extern nonPresentObject_t nonPresentObject;
 
 // "variant" that can hold any type of serialized object
 // and includes a small-object allocation optimization.
+//
+// Objects too large for that, and the containers, which are costly to
+// copy, are kept on the heap and shared by copies of the variant. Asking
+// for one to change copies it first if it is shared, so a copy of an
+// object holding many fields only pays for those that are then changed.
+// Once a reference that can change an object has been handed out, later
+// copies of the variant no longer share it, since the change could come
+// at any time.
 class STVar
 {
 private:
     // The largest "small object" we can accomodate
     static std::size_t constexpr max_size = 72;
 
+    // What d_ holds for an object on the heap
+    struct Shared
+    {
+        std::shared_ptr<STBase> object;
+        bool leaked = false;
+    };
+
+    static_assert(sizeof(Shared) <= max_size);
+
     std::aligned_storage<max_size>::type d_;
     STBase* p_ = nullptr;
 
@@ -64,15 +90,8 @@ public:
     STVar&
     operator=(STVar&& rhs);
 
-    STVar(STBase&& t)
-    {
-        p_ = t.move(max_size, &d_);
-    }
-
-    STVar(STBase const& t)
-    {
-        p_ = t.copy(max_size, &d_);
-    }
+    STVar(STBase&& t);
+    STVar(STBase const& t);
 
     STVar(defaultObject_t, SField const& name);
     STVar(nonPresentObject_t, SField const& name);
@@ -81,6 +100,8 @@ public:
     STBase&
     get()
     {
+        if (on_heap())
+            unshare();
         return *p_;
     }
     STBase&
@@ -121,12 +142,34 @@ private:
     void
     destroy();
 
+    void
+    assign(STVar const& other);
+
+    void
+    assign(STVar&& other);
+
+    void
+    adopt(std::shared_ptr<STBase> object, bool leaked = false);
+
+    // Make the object ours alone, since it is about to change
+    void
+    unshare();
+
+    // Whether an object of a type is worth sharing between copies
+    template <class T>
+    static constexpr bool shared_type = std::is_same_v<T, STObject> ||
+        std::is_same_v<T, STArray> || std::is_same_v<T, STVector256> ||
+        std::is_same_v<T, STPathSet>;
+
+    static bool
+    is_shared_type(STBase const& t);
+
     template <class T, class... Args>
     void
     construct(Args&&... args)
     {
-        if constexpr (sizeof(T) > max_size)
-            p_ = new T(std::forward<Args>(args)...);
+        if constexpr (sizeof(T) > max_size || shared_type<T>)
+            adopt(std::make_shared<T>(std::forward<Args>(args)...));
         else
             p_ = new (&d_) T(std::forward<Args>(args)...);
     }
@@ -134,7 +177,20 @@ private:
     bool
     on_heap() const
     {
-        return static_cast<void const*>(p_) != static_cast<void const*>(&d_);
+        return p_ != nullptr &&
+            static_cast<void const*>(p_) != static_cast<void const*>(&d_);
+    }
+
+    Shared&
+    shared()
+    {
+        return *std::launder(reinterpret_cast<Shared*>(&d_));
+    }
+
+    Shared const&
+    shared() const
+    {
+        return *std::launder(reinterpret_cast<Shared const*>(&d_));
     }
 };
 
@@ -335,6 +335,46 @@ Serializer::decodeVLLength(int b1, int b2, int b3)
 
 //------------------------------------------------------------------------------
 
+namespace {
+
+struct Scratch
+{
+    Serializer s;
+    bool lent = false;
+};
+
+thread_local Scratch scratch;
+
+// A buffer that grew past this is released rather than kept around
+constexpr std::size_t maxScratchCapacity = 64 * 1024;
+
+}  // namespace
+
+ScratchSerializer::ScratchSerializer()
+{
+    if (scratch.lent)
+    {
+        s_ = &own_.emplace();
+        return;
+    }
+
+    scratch.lent = true;
+    scratch.s.erase();
+    s_ = &scratch.s;
+}
+
+ScratchSerializer::~ScratchSerializer()
+{
+    if (s_ != &scratch.s)
+        return;
+
+    if (scratch.s.capacity() > maxScratchCapacity)
+        scratch.s = Serializer{};
+    scratch.lent = false;
+}
+
+//------------------------------------------------------------------------------
+
 SerialIter::SerialIter(void const* data, std::size_t size) noexcept
     : p_(reinterpret_cast<std::uint8_t const*>(data)), remain_(size)
 {
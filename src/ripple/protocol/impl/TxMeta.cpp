@@ -21,6 +21,7 @@
 #include <ripple/basics/contract.h>
 #include <ripple/json/to_string.h>
 #include <ripple/protocol/STAccount.h>
+#include <ripple/protocol/STInteger.h>
 #include <ripple/protocol/TxMeta.h>
 #include <string>
 
@@ -39,7 +40,7 @@ TxMeta::TxMeta(
     STObject obj(sit, sfMetadata);
     mResult = obj.getFieldU8(sfTransactionResult);
     mIndex = obj.getFieldU32(sfTransactionIndex);
-    mNodes = *dynamic_cast<STArray*>(&obj.getField(sfAffectedNodes));
+    mNodes = std::move(dynamic_cast<STArray&>(obj.getField(sfAffectedNodes)));
 
     if (obj.isFieldPresent(sfDeliveredAmount))
         setDeliveredAmount(obj.getFieldAmount(sfDeliveredAmount));
@@ -53,12 +54,6 @@ TxMeta::TxMeta(uint256 const& txid, std::uint32_t ledger, STObject const& obj)
     mResult = obj.getFieldU8(sfTransactionResult);
     mIndex = obj.getFieldU32(sfTransactionIndex);
 
-    auto affectedNodes =
-        dynamic_cast<STArray const*>(obj.peekAtPField(sfAffectedNodes));
-    assert(affectedNodes);
-    if (affectedNodes)
-        mNodes = *affectedNodes;
-
     if (obj.isFieldPresent(sfDeliveredAmount))
         setDeliveredAmount(obj.getFieldAmount(sfDeliveredAmount));
 }
@@ -208,6 +203,21 @@ TxMeta::getAsObject() const
     return metaData;
 }
 
+Json::Value
+TxMeta::getJson(JsonOptions p) const
+{
+    assert(mResult != 255);
+    Json::Value ret(Json::objectValue);
+    ret[sfTransactionResult.getJsonName()] =
+        STUInt8(sfTransactionResult, mResult).getJson(p);
+    ret[sfTransactionIndex.getJsonName()] =
+        STUInt32(sfTransactionIndex, mIndex).getJson(p);
+    ret[sfAffectedNodes.getJsonName()] = mNodes.getJson(p);
+    if (hasDeliveredAmount())
+        ret[sfDeliveredAmount.getJsonName()] = mDelivered->getJson(p);
+    return ret;
+}
+
 void
 TxMeta::addRaw(Serializer& s, TER result, std::uint32_t index)
 {
@@ -219,7 +229,34 @@ TxMeta::addRaw(Serializer& s, TER result, std::uint32_t index)
         return o1.getFieldH256(sfLedgerIndex) < o2.getFieldH256(sfLedgerIndex);
     });
 
-    getAsObject().add(s);
+    STObject metaData(sfTransactionMetaData);
+    metaData.setFieldU8(sfTransactionResult, mResult);
+    metaData.setFieldU32(sfTransactionIndex, mIndex);
+    if (hasDeliveredAmount())
+        metaData.setFieldAmount(sfDeliveredAmount, getDeliveredAmount());
+
+    // Lend the nodes to the object being serialized rather than copy them.
+    // The output is built on the side and only then added to s, so if
+    // serializing throws, the nodes are taken back and s is untouched.
+    metaData.emplace_back(std::move(mNodes));
+    auto const takeBack = [&]() {
+        mNodes = std::move(
+            dynamic_cast<STArray&>(metaData.getField(sfAffectedNodes)));
+    };
+
+    Serializer out;
+    try
+    {
+        metaData.add(out);
+    }
+    catch (...)
+    {
+        takeBack();
+        throw;
+    }
+    takeBack();
+
+    s.addRaw(out);
 }
 
 }  // namespace ripple
@@ -0,0 +1,389 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/protocol/digest.h>
+#include <boost/endian/conversion.hpp>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define RIPPLE_SHA512_MULTI_X86 1
+#include <immintrin.h>
+#endif
+
+namespace ripple {
+
+namespace {
+
+// Hashes messages one at a time
+void
+sha512HalfScalar(Slice const* messages, std::size_t count, uint256* digests)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        digests[i] = sha512Half(messages[i]);
+}
+
+#if RIPPLE_SHA512_MULTI_X86
+
+constexpr std::array<std::uint64_t, 8> sha512Init = {
+    0x6a09e667f3bcc908ULL,
+    0xbb67ae8584caa73bULL,
+    0x3c6ef372fe94f82bULL,
+    0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL,
+    0x9b05688c2b3e6c1fULL,
+    0x1f83d9abfb41bd6bULL,
+    0x5be0cd19137e2179ULL};
+
+constexpr std::array<std::uint64_t, 80> sha512K = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
+    0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+    0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL,
+    0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
+    0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+    0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL, 0x2de92c6f592b0275ULL,
+    0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL,
+    0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+    0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL,
+    0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL,
+    0x92722c851482353bULL, 0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+    0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
+    0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL,
+    0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+    0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL,
+    0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL,
+    0xc67178f2e372532bULL, 0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+    0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL,
+    0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
+    0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+    0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL};
+
+/** The padded SHA-512 input of one message, one 128 byte block at a time.
+
+    Whole blocks are read in place; only the final one or two blocks,
+    which hold the padding and the length, are assembled in a buffer.
+*/
+class PaddedMessage
+{
+    std::uint8_t const* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t whole_ = 0;
+    std::size_t blocks_ = 0;
+    std::array<std::uint8_t, 256> tail_;
+
+public:
+    void
+    reset(Slice const& message)
+    {
+        data_ = message.data();
+        size_ = message.size();
+        whole_ = size_ / 128;
+        // One 0x80 byte and a 128 bit length follow the message
+        blocks_ = (size_ + 1 + 16 + 127) / 128;
+
+        auto const rest = size_ - whole_ * 128;
+        tail_.fill(0);
+        if (rest != 0)
+            std::memcpy(tail_.data(), data_ + whole_ * 128, rest);
+        tail_[rest] = 0x80;
+        auto const bits = boost::endian::native_to_big(
+            static_cast<std::uint64_t>(size_) * 8);
+        std::memcpy(
+            tail_.data() + (blocks_ - whole_) * 128 - 8, &bits, sizeof(bits));
+    }
+
+    std::size_t
+    blocks() const
+    {
+        return blocks_;
+    }
+
+    std::uint8_t const*
+    block(std::size_t n) const
+    {
+        if (n < whole_)
+            return data_ + n * 128;
+        return tail_.data() + (n - whole_) * 128;
+    }
+};
+
+inline std::uint64_t
+loadBig64(std::uint8_t const* p)
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return boost::endian::big_to_native(v);
+}
+
+// Round function shared by the vector kernels. V is the vector type and
+// the helpers below provide its arithmetic.
+#define RIPPLE_SHA512_ROUNDS(V, ADD, XOR, AND, ANDNOT, OR, ROTR, SHR, SET1) \
+    V w[80];                                                                \
+    for (int t = 0; t < 16; ++t)                                            \
+        w[t] = words[t];                                                    \
+    for (int t = 16; t < 80; ++t)                                           \
+    {                                                                       \
+        V const s0 = XOR(XOR(ROTR(w[t - 15], 1), ROTR(w[t - 15], 8)),       \
+                         SHR(w[t - 15], 7));                                \
+        V const s1 = XOR(XOR(ROTR(w[t - 2], 19), ROTR(w[t - 2], 61)),       \
+                         SHR(w[t - 2], 6));                                 \
+        w[t] = ADD(ADD(w[t - 16], s0), ADD(w[t - 7], s1));                  \
+    }                                                                       \
+    V a = state[0], b = state[1], c = state[2], d = state[3];               \
+    V e = state[4], f = state[5], g = state[6], h = state[7];               \
+    for (int t = 0; t < 80; ++t)                                            \
+    {                                                                       \
+        V const S1 = XOR(XOR(ROTR(e, 14), ROTR(e, 18)), ROTR(e, 41));       \
+        V const ch = XOR(AND(e, f), ANDNOT(e, g));                          \
+        V const t1 =                                                        \
+            ADD(ADD(ADD(h, S1), ADD(ch, SET1(sha512K[t]))), w[t]);          \
+        V const S0 = XOR(XOR(ROTR(a, 28), ROTR(a, 34)), ROTR(a, 39));       \
+        V const maj = OR(AND(a, b), AND(c, OR(a, b)));                      \
+        V const t2 = ADD(S0, maj);                                          \
+        h = g;                                                              \
+        g = f;                                                              \
+        f = e;                                                              \
+        e = ADD(d, t1);                                                     \
+        d = c;                                                              \
+        c = b;                                                              \
+        b = a;                                                              \
+        a = ADD(t1, t2);                                                    \
+    }
+
+//------------------------------------------------------------------------------
+
+#define RIPPLE_AVX2_ROTR(x, n) \
+    _mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - (n)))
+
+// Four messages at a time with AVX2
+__attribute__((target("avx2"))) void
+sha512HalfAvx2(Slice const* messages, std::size_t count, uint256* digests)
+{
+    constexpr std::size_t lanes = 4;
+    std::array<PaddedMessage, lanes> input;
+
+    for (std::size_t first = 0; first + lanes <= count; first += lanes)
+    {
+        std::size_t blocks = 0;
+        for (std::size_t j = 0; j < lanes; ++j)
+        {
+            input[j].reset(messages[first + j]);
+            blocks = std::max(blocks, input[j].blocks());
+        }
+
+        __m256i state[8];
+        for (int i = 0; i < 8; ++i)
+            state[i] = _mm256_set1_epi64x(sha512Init[i]);
+
+        for (std::size_t n = 0; n < blocks; ++n)
+        {
+            std::uint8_t const* block[lanes];
+            std::int64_t active[lanes];
+            for (std::size_t j = 0; j < lanes; ++j)
+            {
+                bool const live = n < input[j].blocks();
+                // Finished lanes recompute their last block and discard it
+                block[j] = input[j].block(live ? n : 0);
+                active[j] = live ? -1 : 0;
+            }
+
+            __m256i words[16];
+            for (int t = 0; t < 16; ++t)
+                words[t] = _mm256_set_epi64x(
+                    loadBig64(block[3] + 8 * t),
+                    loadBig64(block[2] + 8 * t),
+                    loadBig64(block[1] + 8 * t),
+                    loadBig64(block[0] + 8 * t));
+
+#define ADD _mm256_add_epi64
+#define XOR _mm256_xor_si256
+#define AND _mm256_and_si256
+#define ANDNOT _mm256_andnot_si256
+#define OR _mm256_or_si256
+#define SHR _mm256_srli_epi64
+#define SET1 _mm256_set1_epi64x
+            RIPPLE_SHA512_ROUNDS(
+                __m256i, ADD, XOR, AND, ANDNOT, OR, RIPPLE_AVX2_ROTR, SHR, SET1)
+#undef ADD
+#undef XOR
+#undef AND
+#undef ANDNOT
+#undef OR
+#undef SHR
+#undef SET1
+
+            __m256i const mask = _mm256_set_epi64x(
+                active[3], active[2], active[1], active[0]);
+            __m256i const out[8] = {a, b, c, d, e, f, g, h};
+            for (int i = 0; i < 8; ++i)
+                state[i] = _mm256_blendv_epi8(
+                    state[i], _mm256_add_epi64(state[i], out[i]), mask);
+        }
+
+        // The digest is the first four words of the state, big endian
+        for (int i = 0; i < 4; ++i)
+        {
+            alignas(32) std::uint64_t v[lanes];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(v), state[i]);
+            for (std::size_t j = 0; j < lanes; ++j)
+            {
+                auto const big = boost::endian::native_to_big(v[j]);
+                std::memcpy(digests[first + j].data() + 8 * i, &big, 8);
+            }
+        }
+    }
+
+    auto const done = count - count % lanes;
+    sha512HalfScalar(messages + done, count - done, digests + done);
+}
+
+#undef RIPPLE_AVX2_ROTR
+
+//------------------------------------------------------------------------------
+
+// Eight messages at a time with AVX-512
+__attribute__((target("avx512f"))) void
+sha512HalfAvx512(Slice const* messages, std::size_t count, uint256* digests)
+{
+    constexpr std::size_t lanes = 8;
+    std::array<PaddedMessage, lanes> input;
+
+    for (std::size_t first = 0; first + lanes <= count; first += lanes)
+    {
+        std::size_t blocks = 0;
+        for (std::size_t j = 0; j < lanes; ++j)
+        {
+            input[j].reset(messages[first + j]);
+            blocks = std::max(blocks, input[j].blocks());
+        }
+
+        __m512i state[8];
+        for (int i = 0; i < 8; ++i)
+            state[i] = _mm512_set1_epi64(sha512Init[i]);
+
+        for (std::size_t n = 0; n < blocks; ++n)
+        {
+            std::uint8_t const* block[lanes];
+            __mmask8 active = 0;
+            for (std::size_t j = 0; j < lanes; ++j)
+            {
+                bool const live = n < input[j].blocks();
+                block[j] = input[j].block(live ? n : 0);
+                if (live)
+                    active |= 1u << j;
+            }
+
+            __m512i words[16];
+            for (int t = 0; t < 16; ++t)
+                words[t] = _mm512_set_epi64(
+                    loadBig64(block[7] + 8 * t),
+                    loadBig64(block[6] + 8 * t),
+                    loadBig64(block[5] + 8 * t),
+                    loadBig64(block[4] + 8 * t),
+                    loadBig64(block[3] + 8 * t),
+                    loadBig64(block[2] + 8 * t),
+                    loadBig64(block[1] + 8 * t),
+                    loadBig64(block[0] + 8 * t));
+
+#define ADD _mm512_add_epi64
+#define XOR _mm512_xor_si512
+#define AND _mm512_and_si512
+#define ANDNOT _mm512_andnot_si512
+#define OR _mm512_or_si512
+#define ROTR _mm512_ror_epi64
+#define SHR _mm512_srli_epi64
+#define SET1 _mm512_set1_epi64
+            RIPPLE_SHA512_ROUNDS(
+                __m512i, ADD, XOR, AND, ANDNOT, OR, ROTR, SHR, SET1)
+#undef ADD
+#undef XOR
+#undef AND
+#undef ANDNOT
+#undef OR
+#undef ROTR
+#undef SHR
+#undef SET1
+
+            __m512i const out[8] = {a, b, c, d, e, f, g, h};
+            for (int i = 0; i < 8; ++i)
+                state[i] = _mm512_mask_add_epi64(
+                    state[i], active, state[i], out[i]);
+        }
+
+        for (int i = 0; i < 4; ++i)
+        {
+            alignas(64) std::uint64_t v[lanes];
+            _mm512_store_si512(v, state[i]);
+            for (std::size_t j = 0; j < lanes; ++j)
+            {
+                auto const big = boost::endian::native_to_big(v[j]);
+                std::memcpy(digests[first + j].data() + 8 * i, &big, 8);
+            }
+        }
+    }
+
+    auto const done = count - count % lanes;
+    if (count - done >= 4)
+        sha512HalfAvx2(messages + done, count - done, digests + done);
+    else
+        sha512HalfScalar(messages + done, count - done, digests + done);
+}
+
+#undef RIPPLE_SHA512_ROUNDS
+
+#endif
+
+using Kernel = void (*)(Slice const*, std::size_t, uint256*);
+
+Kernel
+selectKernel()
+{
+#if RIPPLE_SHA512_MULTI_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return sha512HalfAvx512;
+    if (__builtin_cpu_supports("avx2"))
+        return sha512HalfAvx2;
+#endif
+    return sha512HalfScalar;
+}
+
+}  // namespace
+
+void
+sha512HalfBatch(std::span<Slice const> messages, std::span<uint256> digests)
+{
+    assert(messages.size() == digests.size());
+
+    static Kernel const kernel = selectKernel();
+
+    // Lanes only pay for themselves once several messages are in hand
+    auto const run = messages.size() < 4 ? sha512HalfScalar : kernel;
+    run(messages.data(), messages.size(), digests.data());
+}
+
+}  // namespace ripple
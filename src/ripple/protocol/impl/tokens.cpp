@@ -88,19 +88,22 @@ checksum(void* out, void const* message, std::size_t size)
 
 namespace detail {
 
-/* The base58 encoding & decoding routines in this namespace are taken from
- * Bitcoin but have been modified from the original.
+/* The base58 encoding & decoding routines in this namespace are derived
+ * from those in Bitcoin but have been modified from the original: rather
+ * than one base58 digit or byte at a time, they work on 32-bit limbs and
+ * five base58 digits (58^5 < 2^32) at a time, which for the sizes of our
+ * tokens is many times faster.
  *
  * Copyright (c) 2014 The Bitcoin Core developers
  * Distributed under the MIT software license, see the accompanying
  * file COPYING or http://www.opensource.org/licenses/mit-license.php.
  */
+
+// 58^5, the largest power of 58 that fits in 32 bits
+static constexpr std::uint64_t b58Chunk = 656356768;
+
 static std::string
-encodeBase58(
-    void const* message,
-    std::size_t size,
-    void* temp,
-    std::size_t temp_size)
+encodeBase58(void const* message, std::size_t size)
 {
     auto pbegin = reinterpret_cast<unsigned char const*>(message);
     auto const pend = pbegin + size;
@@ -113,36 +116,46 @@ encodeBase58(
         zeroes++;
     }
 
-    auto const b58begin = reinterpret_cast<unsigned char*>(temp);
-    auto const b58end = b58begin + temp_size;
+    // Load the rest as a big-endian number of 32-bit limbs.
+    auto const bytes = static_cast<std::size_t>(pend - pbegin);
+    boost::container::small_vector<std::uint32_t, 16> limbs((bytes + 3) / 4);
+    for (std::size_t i = limbs.size() * 4 - bytes; pbegin != pend; ++i)
+        limbs[i / 4] = (limbs[i / 4] << 8) | *(pbegin++);
+
+    // Repeatedly divide by 58^5, which yields five base58 digits at a
+    // time, least significant first.
+    boost::container::small_vector<std::uint8_t, 64> b58;
+    std::size_t first = 0;
+    while (first != limbs.size())
+    {
+        std::uint64_t rem = 0;
+        for (auto i = first; i != limbs.size(); ++i)
+        {
+            auto const cur = (rem << 32) | limbs[i];
+            limbs[i] = static_cast<std::uint32_t>(cur / b58Chunk);
+            rem = cur % b58Chunk;
+        }
 
-    std::fill(b58begin, b58end, 0);
+        while (first != limbs.size() && limbs[first] == 0)
+            ++first;
 
-    while (pbegin != pend)
-    {
-        int carry = *pbegin;
-        // Apply "b58 = b58 * 256 + ch".
-        for (auto iter = b58end; iter != b58begin; --iter)
+        for (int i = 0; i != 5; ++i)
         {
-            carry += 256 * (iter[-1]);
-            iter[-1] = carry % 58;
-            carry /= 58;
+            b58.push_back(rem % 58);
+            rem /= 58;
         }
-        assert(carry == 0);
-        pbegin++;
     }
 
     // Skip leading zeroes in base58 result.
-    auto iter = b58begin;
-    while (iter != b58end && *iter == 0)
-        ++iter;
+    while (!b58.empty() && b58.back() == 0)
+        b58.pop_back();
 
     // Translate the result into a string.
     std::string str;
-    str.reserve(zeroes + (b58end - iter));
+    str.reserve(zeroes + b58.size());
     str.assign(zeroes, alphabetForward[0]);
-    while (iter != b58end)
-        str += alphabetForward[*(iter++)];
+    for (auto iter = b58.rbegin(); iter != b58.rend(); ++iter)
+        str += alphabetForward[*iter];
     return str;
 }
 
@@ -163,33 +176,51 @@ decodeBase58(std::string const& s)
     if (remain > 64)
         return {};
 
-    // Allocate enough space in big-endian base256 representation.
-    // log(58) / log(256), rounded up.
-    std::vector<unsigned char> b256(remain * 733 / 1000 + 1);
+    // The number as 32-bit limbs, least significant first. Apply
+    // "b256 = b256 * 58^n + carry" for up to five digits at a time.
+    boost::container::small_vector<std::uint32_t, 16> limbs;
     while (remain > 0)
     {
-        auto carry = alphabetReverse[*psz];
-        if (carry == -1)
-            return {};
-        // Apply "b256 = b256 * 58 + carry".
-        for (auto iter = b256.rbegin(); iter != b256.rend(); ++iter)
+        std::uint64_t carry = 0;
+        std::uint64_t scale = 1;
+        for (int i = 0; i != 5 && remain > 0; ++i)
         {
-            carry += 58 * *iter;
-            *iter = carry % 256;
-            carry /= 256;
+            auto const digit = alphabetReverse[*psz];
+            if (digit == -1)
+                return {};
+            carry = carry * 58 + digit;
+            scale *= 58;
+            ++psz;
+            --remain;
         }
-        assert(carry == 0);
-        ++psz;
-        --remain;
+
+        for (auto& limb : limbs)
+        {
+            carry += scale * limb;
+            limb = static_cast<std::uint32_t>(carry);
+            carry >>= 32;
+        }
+
+        if (carry != 0)
+            limbs.push_back(static_cast<std::uint32_t>(carry));
     }
+
     // Skip leading zeroes in b256.
-    auto iter = std::find_if(
-        b256.begin(), b256.end(), [](unsigned char c) { return c != 0; });
     std::string result;
-    result.reserve(zeroes + (b256.end() - iter));
+    result.reserve(zeroes + limbs.size() * 4);
     result.assign(zeroes, 0x00);
-    while (iter != b256.end())
-        result.push_back(*(iter++));
+    bool leading = true;
+    for (auto iter = limbs.rbegin(); iter != limbs.rend(); ++iter)
+    {
+        for (int shift = 24; shift >= 0; shift -= 8)
+        {
+            auto const c = static_cast<char>((*iter >> shift) & 0xff);
+            if (leading && c == 0)
+                continue;
+            leading = false;
+            result.push_back(c);
+        }
+    }
     return result;
 }
 
@@ -201,12 +232,7 @@ encodeBase58Token(TokenType type, void const* token, std::size_t size)
     // expanded token includes type + 4 byte checksum
     auto const expanded = 1 + size + 4;
 
-    // We need expanded + expanded * (log(256) / log(58)) which is
-    // bounded by expanded + expanded * (138 / 100 + 1) which works
-    // out to expanded * 3:
-    auto const bufsize = expanded * 3;
-
-    boost::container::small_vector<std::uint8_t, 1024> buf(bufsize);
+    boost::container::small_vector<std::uint8_t, 128> buf(expanded);
 
     // Lay the data out as
     //      <type><token><checksum>
@@ -215,8 +241,7 @@ encodeBase58Token(TokenType type, void const* token, std::size_t size)
         std::memcpy(buf.data() + 1, token, size);
     checksum(buf.data() + 1 + size, buf.data(), 1 + size);
 
-    return detail::encodeBase58(
-        buf.data(), expanded, buf.data() + expanded, bufsize - expanded);
+    return detail::encodeBase58(buf.data(), expanded);
 }
 
 std::string
@@ -116,6 +116,7 @@ JSS(PaymentChannelCreate);               // transaction type.
 JSS(PaymentChannelFund);                 // transaction type.
 JSS(RippleState);                        // ledger type.
 JSS(SLE_hit_rate);                       // out: GetCounts.
+JSS(SLE_hit_rates);                      // out: GetCounts.
 JSS(SetFee);                             // transaction type.
 JSS(UNLModify);                          // transaction type.
 JSS(SettleDelay);                        // in: TransactionSign
@@ -170,6 +171,7 @@ JSS(accounts);                  // in: LedgerEntry, Subscribe,
 JSS(accounts_proposed);         // in: Subscribe, Unsubscribe
 JSS(action);
 JSS(acquiring);                   // out: LedgerRequest
+JSS(acquisitions);                // out: GetCounts
 JSS(address);                     // out: PeerImp
 JSS(affected);                    // out: AcceptedLedgerTx
 JSS(age);                         // out: NetworkOPs, Peers
@@ -218,13 +220,18 @@ JSS(bridge);                      // in: LedgerEntry
 JSS(bridge_account);              // in: LedgerEntry
 JSS(build_path);                  // in: TransactionSign
 JSS(build_version);               // out: NetworkOPs
+JSS(built);                       // out: RCLTimelines
+JSS(bulk);                        // out: Peers
 JSS(cancel_after);                // out: AccountChannels
 JSS(can_delete);                  // out: CanDelete
+JSS(capacity);                    // out: GetCounts
 JSS(changes);                     // out: BookChanges
 JSS(channel_id);                  // out: AccountChannels
 JSS(channels);                    // out: AccountChannels
 JSS(check);                       // in: AccountObjects
 JSS(check_nodes);                 // in: LedgerCleaner
+JSS(checked);
+JSS(cleaned);                     // out: LedgerCleaner
 JSS(clear);                       // in/out: FetchInfo
 JSS(close);                       // out: BookChanges
 JSS(close_flags);                 // out: LedgerToJson
@@ -245,7 +252,14 @@ JSS(command);                     // in: RPCHandler
 JSS(complete);                    // out: NetworkOPs, InboundLedger
 JSS(complete_ledgers);            // out: NetworkOPs, PeerImp
 JSS(complete_shards);             // out: OverlayImpl, PeerImp
+JSS(completed);                   // out: ServerHandler
+JSS(compressed_cache_bytes);      // out: GetCounts
+JSS(compressed_cache_evictions);  // out: GetCounts
+JSS(compressed_cache_hits);       // out: GetCounts
+JSS(compressed_cache_misses);     // out: GetCounts
+JSS(compressed_cache_size);       // out: GetCounts
 JSS(consensus);                   // out: NetworkOPs, LedgerConsensus
+JSS(contentions);                 // out: GetCounts
 JSS(converge_time);               // out: NetworkOPs
 JSS(converge_time_s);             // out: NetworkOPs
 JSS(cookie);                      // out: NetworkOPs
@@ -269,6 +283,7 @@ JSS(dbKBLedger);              // out: getCounts
 JSS(dbKBTotal);               // out: getCounts
 JSS(dbKBTransaction);         // out: getCounts
 JSS(debug_signing);           // in: TransactionSign
+JSS(delay_us);                // out: Slot
 JSS(deletion_blockers_only);  // in: AccountObjects
 JSS(delivered_amount);        // out: insertDeliveredAmount
 JSS(deposit_authorized);      // out: deposit_authorized
@@ -292,6 +307,7 @@ JSS(directory);               // in: LedgerEntry
 JSS(discounted_fee);          // out: amm_info
 JSS(domain);                  // out: ValidatorInfo, Manifest
 JSS(drops);                   // out: TxQ
+JSS(duration_ns);
 JSS(duration_us);             // out: NetworkOPs
 JSS(effective);               // out: ValidatorList
                               // in: UNL
@@ -313,6 +329,7 @@ JSS(expected_date_UTC);     // out: any (warnings)
 JSS(expected_ledger_size);  // out: TxQ
 JSS(expiration);            // out: AccountOffers, AccountChannels,
                             //      ValidatorList, amm_info
+JSS(fail_counts);           // out: LedgerCleaner
 JSS(fail_hard);             // in: Sign, Submit
 JSS(failed);                // out: InboundLedger
 JSS(feature);               // in: Feature
@@ -329,6 +346,7 @@ JSS(FIELDS);                // out: RPC server_definitions
 JSS(first);                 // out: rpc/Version
 JSS(firstSequence);         // out: NodeToShardStatus
 JSS(firstShardIndex);       // out: NodeToShardStatus
+JSS(first_proposal);        // out: RCLTimelines
 JSS(finished);
 JSS(fix_txns);              // in: LedgerCleaner
 JSS(flags);                 // out: AccountOffers,
@@ -341,6 +359,7 @@ JSS(full);                  // in: LedgerClearer, handlers/Ledger
 JSS(full_reply);            // out: PathFind
 JSS(fullbelow_size);        // out: GetCounts
 JSS(good);                  // out: RPCVersion
+JSS(handler_us);            // out: Overlay, GetCounts
 JSS(hash);                  // out: NetworkOPs, InboundLedger,
                             //      LedgerToJson, STTx; field
 JSS(hashes);                // in: AccountObjects
@@ -351,6 +370,8 @@ JSS(high);                  // out: BookChanges
 JSS(highest_sequence);      // out: AccountInfo
 JSS(highest_ticket);        // out: AccountInfo
 JSS(historical_perminute);  // historical_perminute.
+JSS(hits);                  // out: JobQueue
+JSS(hold_us);               // out: GetCounts
 JSS(hostid);                // out: NetworkOPs
 JSS(hotwallet);             // in: GatewayBalances
 JSS(id);                    // websocket.
@@ -358,6 +379,7 @@ JSS(ident);                 // in: AccountCurrencies, AccountInfo,
                             //     OwnerInfo
 JSS(ignore_default);        // in: AccountLines
 JSS(inLedger);              // out: tx/Transaction
+JSS(in_use);                // out: JobQueue
 JSS(inbound);               // out: PeerImp
 JSS(index);                 // in: LedgerEntry, DownloadShard
                             // out: STLedgerEntry,
@@ -367,6 +389,7 @@ JSS(initial_sync_duration_us);
 JSS(internal_command);     // in: Internal
 JSS(invalid_API_version);  // out: Many, when a request has an invalid
                            //      version
+JSS(invariants);
 JSS(io_latency_ms);        // out: NetworkOPs
 JSS(ip);                   // in: Connect, out: OverlayImpl
 JSS(is_burned);            // out: nft_info (clio)
@@ -379,6 +402,7 @@ JSS(isVLEncoded);          // out: RPC server_definitions
 JSS(issuer);               // in: RipplePathFind, Subscribe,
                            //     Unsubscribe, BookOffers
                            // out: STPathSet, STAmount
+JSS(item_size);            // out: GetCounts
 JSS(job);
 JSS(job_queue);
 JSS(jobs);
@@ -387,7 +411,7 @@ JSS(jq_trans_overflow);           // JobQueue transaction limit overflow.
 JSS(kept);                        // out: SubmitTransaction
 JSS(key);                         // out
 JSS(key_type);                    // in/out: WalletPropose, TransactionSign
-JSS(latency);                     // out: PeerImp
+JSS(latency);                     // out: PeerImp, NetworkOPs
 JSS(last);                        // out: RPCVersion
 JSS(lastSequence);                // out: NodeToShardStatus
 JSS(lastShardIndex);              // out: NodeToShardStatus
@@ -398,6 +422,8 @@ JSS(last_refresh_message);        // out: ValidatorSite
 JSS(ledger);                      // in: NetworkOPs, LedgerCleaner,
                                   //     RPCHelpers
                                   // out: NetworkOPs, PeerImp
+JSS(ledger_cache);                // out: GetCounts
+JSS(ledger_cleaner);              // out: LedgerCleaner
 JSS(ledger_current_index);        // out: NetworkOPs, RPCHelpers,
                                   //      LedgerCurrent, LedgerAccept,
                                   //      AccountLines
@@ -408,6 +434,7 @@ JSS(ledger_hash);                 // in: RPCHelpers, LedgerRequest,
                                   // out: NetworkOPs, RPCHelpers,
                                   //      LedgerClosed, LedgerData,
                                   //      AccountLines
+JSS(ledger_header_hit_rate);      // out: GetCounts
 JSS(ledger_hit_rate);             // out: GetCounts
 JSS(ledger_index);                // in/out: many
 JSS(ledger_index_max);            // in, out: AccountTx*
@@ -415,6 +442,8 @@ JSS(ledger_index_min);            // in, out: AccountTx*
 JSS(ledger_max);                  // in, out: AccountTx*
 JSS(ledger_min);                  // in, out: AccountTx*
 JSS(ledger_time);                 // out: NetworkOPs
+JSS(ledger_us);                   // out: GetCounts
+JSS(ledgers_per_second);          // out: LedgerCleaner
 JSS(LEDGER_ENTRY_TYPES);          // out: RPC server_definitions
                                   // matches definitions.json format
 JSS(levels);                      // LogLevels
@@ -438,10 +467,12 @@ JSS(load_fee);                    // out: LoadFeeTrackImp, NetworkOPs
 JSS(local);                       // out: resource/Logic.h
 JSS(local_txs);                   // out: GetCounts
 JSS(local_static_keys);           // out: ValidatorList
+JSS(locks);                       // out: GetCounts
 JSS(low);                         // out: BookChanges
 JSS(lowest_sequence);             // out: AccountInfo
 JSS(lowest_ticket);               // out: AccountInfo
 JSS(lp_token);                    // out: amm_info
+JSS(magazine_hits);               // out: GetCounts
 JSS(majority);                    // out: RPC feature
 JSS(manifest);                    // out: ValidatorInfo, Manifest
 JSS(marker);                      // in/out: AccountTx, AccountOffers,
@@ -454,12 +485,16 @@ JSS(master_key);                  // out: WalletPropose, NetworkOPs,
 JSS(master_seed);                 // out: WalletPropose
 JSS(master_seed_hex);             // out: WalletPropose
 JSS(master_signature);            // out: pubManifest
+JSS(max);                         // out: Overlay
 JSS(max_ledger);                  // in/out: LedgerCleaner
 JSS(max_queue_size);              // out: TxQ
+JSS(max_rate);                    // in/out: LedgerCleaner
 JSS(max_spend_drops);             // out: AccountInfo
 JSS(max_spend_drops_total);       // out: AccountInfo
+JSS(max_wait_us);                 // out: GetCounts
 JSS(median_fee);                  // out: TxQ
 JSS(median_level);                // out: TxQ
+JSS(memory);                      // out: GetCounts
 JSS(message);                     // error.
 JSS(meta);                        // out: NetworkOPs, AccountTx*, Tx
 JSS(meta_blob);                   // out: NetworkOPs, AccountTx*, Tx
@@ -472,6 +507,7 @@ JSS(min_count);                  // in: GetCounts
 JSS(min_ledger);                 // in: LedgerCleaner
 JSS(minimum_fee);                // out: TxQ
 JSS(minimum_level);              // out: TxQ
+JSS(misses);                     // out: JobQueue
 JSS(missingCommand);             // error
 JSS(name);                       // out: AmendmentTableImpl, PeerImp
 JSS(needed_state_hashes);        // out: InboundLedger
@@ -491,10 +527,12 @@ JSS(no_ripple);                  // out: AccountLines
 JSS(no_ripple_peer);             // out: AccountLines
 JSS(node);                       // out: LedgerEntry
 JSS(node_binary);                // out: LedgerEntry
+JSS(node_cache);                 // out: GetCounts
 JSS(node_read_bytes);            // out: GetCounts
 JSS(node_read_errors);           // out: GetCounts
 JSS(node_read_retries);          // out: GetCounts
 JSS(node_reads_hit);             // out: GetCounts
+JSS(node_reads_shared);          // out: GetCounts
 JSS(node_reads_total);           // out: GetCounts
 JSS(node_reads_duration_us);     // out: GetCounts
 JSS(node_size);                  // out: server_info
@@ -511,12 +549,19 @@ JSS(offers);                     // out: NetworkOPs, AccountOffers, Subscribe
 JSS(offer_id);                   // out: insertNFTokenOfferID
 JSS(offline);                    // in: TransactionSign
 JSS(offset);                     // in/out: AccountTxOld
+JSS(online_delete);              // out: NetworkOPs
 JSS(open);                       // out: handlers/Ledger
 JSS(open_ledger_cost);           // out: SubmitTransaction
 JSS(open_ledger_fee);            // out: TxQ
 JSS(open_ledger_level);          // out: TxQ
+JSS(other);                      // out: GetCounts
+JSS(outstanding);                // out: GetCounts
 JSS(owner);                      // in: LedgerEntry, out: NetworkOPs
 JSS(owner_funds);                // in/out: Ledger, NetworkOPs, AcceptedLedgerTx
+JSS(p50);                        // out: Overlay, GetCounts
+JSS(p90);                        // out: Overlay
+JSS(p99);                        // out: Overlay, GetCounts
+JSS(p999);                       // out: GetCounts
 JSS(page_index);
 JSS(params);                      // RPC
 JSS(parent_close_time);           // out: LedgerToJson
@@ -524,6 +569,7 @@ JSS(parent_hash);                 // out: LedgerToJson
 JSS(partition);                   // in: LogLevel
 JSS(passphrase);                  // in: WalletPropose
 JSS(password);                    // in: Subscribe
+JSS(pathfinding);                 // out: GetCounts
 JSS(paths);                       // in: RipplePathFind
 JSS(paths_canonical);             // out: RipplePathFind
 JSS(paths_computed);              // out: PathRequest, RipplePathFind
@@ -535,8 +581,11 @@ JSS(peers);                       // out: InboundLedger, handlers/Peers, Overlay
 JSS(peer_disconnects);            // Severed peer connection counter.
 JSS(peer_disconnects_resources);  // Severed peer connections because of
                                   // excess resource consumption.
+JSS(policy);                      // out: Slots
+JSS(pooled);                      // out: JobQueue
 JSS(port);                        // in: Connect, out: NetworkOPs
 JSS(ports);                       // out: NetworkOPs
+JSS(position_changes);            // out: RCLTimelines
 JSS(previous);                    // out: Reservations
 JSS(previous_ledger);             // out: LedgerPropose
 JSS(price);                       // out: amm_info, AuctionSlot
@@ -559,15 +608,20 @@ JSS(quality_in);                  // out: AccountLines
 JSS(quality_out);                 // out: AccountLines
 JSS(queue);                       // in: AccountInfo
 JSS(queue_data);                  // out: AccountInfo
+JSS(queue_limit);                 // out: ServerHandler
+JSS(queue_us);                    // out: Overlay, GetCounts
 JSS(queued);                      // out: SubmitTransaction
 JSS(queued_duration_us);
+JSS(quorum);                      // out: RCLTimelines
 JSS(random);                // out: Random
 JSS(raw_meta);              // out: AcceptedLedgerTx
 JSS(receive_currencies);    // out: AccountCurrencies
+JSS(reduce_relay);          // out: handlers/Peers
 JSS(reference_level);       // out: TxQ
 JSS(refresh_interval);      // in: UNL
 JSS(refresh_interval_min);  // out: ValidatorSites
 JSS(regular_seed);          // in/out: LedgerEntry
+JSS(rejected);              // out: ServerHandler
 JSS(remaining);             // out: ValidatorList
 JSS(remote);                // out: Logic.h
 JSS(request);               // RPC
@@ -583,8 +637,14 @@ JSS(ripple_lines);          // out: NetworkOPs
 JSS(ripple_state);          // in: LedgerEntr
 JSS(ripplerpc);             // ripple RPC version
 JSS(role);                  // out: Ping.cpp
+JSS(rounds);                // out: RCLTimelines
 JSS(rpc);
+JSS(rpc_latency);            // out: GetCounts
+JSS(rpc_response_hit_rate);  // out: GetCounts
+JSS(rpc_response_size);      // out: GetCounts
+JSS(rpc_responses);          // out: GetCounts
 JSS(rt_accounts);  // in: Subscribe, Unsubscribe
+JSS(running);               // out: ServerHandler
 JSS(running_duration_us);
 JSS(search_depth);              // in: RipplePathFind
 JSS(searched_all);              // out: Tx
@@ -595,11 +655,14 @@ JSS(seed);                      //
 JSS(seed_hex);                  // in: WalletPropose, TransactionSign
 JSS(send_currencies);           // out: AccountCurrencies
 JSS(send_max);                  // in: PathRequest, RipplePathFind
+JSS(send_queue);                // out: Peers
+JSS(send_queues);               // out: GetCounts
 JSS(seq);                       // in: LedgerEntry;
                                 // out: NetworkOPs, RPCSub, AccountOffers,
                                 //      ValidatorList, ValidatorInfo, Manifest
 JSS(sequence);                  // in: UNL
 JSS(sequence_count);            // out: AccountInfo
+JSS(serialize_us);              // out: GetCounts
 JSS(server_domain);             // out: NetworkOPs
 JSS(server_state);              // out: NetworkOPs
 JSS(server_state_duration_us);  // out: NetworkOPs
@@ -607,6 +670,8 @@ JSS(server_status);             // out: NetworkOPs
 JSS(server_version);            // out: NetworkOPs
 JSS(settle_delay);              // out: AccountChannels
 JSS(severity);                  // in: LogLevel
+JSS(shamap_item_slabs);         // out: GetCounts
+JSS(shamap_items);              // out: GetCounts
 JSS(shards);                    // in/out: GetCounts, DownloadShard
 JSS(signature);                 // out: NetworkOPs, ChannelAuthorize
 JSS(signature_verified);        // out: ChannelVerify
@@ -615,6 +680,11 @@ JSS(signing_keys);              // out: ValidatorList
 JSS(signing_time);              // out: NetworkOPs
 JSS(signer_list);               // in: AccountObjects
 JSS(signer_lists);              // in/out: AccountInfo
+JSS(size);                      // out: JobQueue
+JSS(size_in);                   // out: Overlay
+JSS(size_out);                  // out: Overlay
+JSS(slabs);                     // out: GetCounts
+JSS(sle_cache);                 // out: GetCounts
 JSS(snapshot);                  // in: Subscribe
 JSS(source_account);            // in: PathRequest, RipplePathFind
 JSS(source_amount);             // in: PathRequest, RipplePathFind
@@ -637,12 +707,14 @@ JSS(subcommand);            // in: PathFind
 JSS(success);               // rpc
 JSS(supported);             // out: AmendmentTableImpl
 JSS(system_time_offset);    // out: NetworkOPs
+JSS(table);                 // out: NetworkOPs
 JSS(tag);                   // out: Peers
 JSS(taker);                 // in: Subscribe, BookOffers
 JSS(taker_gets);            // in: Subscribe, Unsubscribe, BookOffers
 JSS(taker_gets_funded);     // out: NetworkOPs
 JSS(taker_pays);            // in: Subscribe, Unsubscribe, BookOffers
 JSS(taker_pays_funded);     // out: NetworkOPs
+JSS(threads);               // out: ServerHandler
 JSS(threshold);             // in: Blacklist
 JSS(ticket);                // in: AccountObjects
 JSS(ticket_count);          // out: AccountInfo
@@ -671,6 +743,8 @@ JSS(TYPES);                   // out: RPC server_definitions
                               // matches definitions.json format
 JSS(transfer_rate);           // out: nft_info (clio)
 JSS(transitions);             // out: NetworkOPs
+JSS(treenode_cache);          // out: GetCounts
+JSS(treenode_cache_bytes);    // out: GetCounts
 JSS(treenode_cache_size);     // out: GetCounts
 JSS(treenode_track_size);     // out: GetCounts
 JSS(trusted);                 // out: UnlList
@@ -736,6 +810,7 @@ JSS(volume_b);                // out: BookChanges
 JSS(vote);                    // in: Feature
 JSS(vote_slots);              // out: amm_info
 JSS(vote_weight);             // out: amm_info
+JSS(wait_us);                 // out: GetCounts
 JSS(warning);                 // rpc:
 JSS(warnings);                // out: server_info, server_state
 JSS(workers);
@@ -20,6 +20,7 @@
 #ifndef RIPPLE_RESOURCE_FEES_H_INCLUDED
 #define RIPPLE_RESOURCE_FEES_H_INCLUDED
 
+#include <ripple/basics/PerfCost.h>
 #include <ripple/resource/Charge.h>
 
 namespace ripple {
@@ -63,6 +64,15 @@ extern Charge const feeWarning;  // The cost of receiving a warning
 extern Charge const feeDrop;     // The cost of being dropped for excess load
 /** @} */
 
+/** Return the charge for the resources an RPC request was measured using.
+
+    CPU time and time spent fetching from the nodestore are charged at
+    the same rate, plus a little for each fetch, so that a request
+    which does the work of a "heavy RPC" costs about as much as one.
+*/
+Charge
+measuredRPC(perf::Cost const& cost);
+
 }  // namespace Resource
 }  // namespace ripple
 
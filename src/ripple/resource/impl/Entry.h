@@ -26,6 +26,7 @@
 #include <ripple/resource/impl/Key.h>
 #include <ripple/resource/impl/Tuning.h>
 #include <cassert>
+#include <mutex>
 
 namespace ripple {
 namespace Resource {
@@ -99,6 +100,10 @@ struct Entry : public beast::List<Entry>::Node
 
     // For inactive entries, time after which this entry will be erased
     clock_type::time_point whenExpires;
+
+    // Protects the balances and lastWarningTime, which are updated
+    // without the lock on the table holding this entry
+    std::mutex mutex;
 };
 
 inline std::ostream&
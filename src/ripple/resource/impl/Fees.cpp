@@ -18,6 +18,8 @@
 //==============================================================================
 
 #include <ripple/resource/Fees.h>
+#include <algorithm>
+#include <limits>
 
 namespace ripple {
 namespace Resource {
@@ -41,5 +43,22 @@ Charge const feeHighBurdenPeer(2000, "heavy peer request");
 Charge const feeWarning(2000, "received warning");
 Charge const feeDrop(3000, "dropped");
 
+// The work charged one unit, as CPU or fetch time
+static constexpr std::chrono::microseconds measuredUnit{50};
+
+// The charge for each nodestore fetch, on top of its time
+static constexpr Charge::value_type measuredFetch = 1;
+
+Charge
+measuredRPC(perf::Cost const& cost)
+{
+    auto const units = (cost.cpu + cost.fetchTime) / measuredUnit +
+        cost.fetches * measuredFetch;
+    return Charge(
+        static_cast<Charge::value_type>(std::min<std::uint64_t>(
+            units, std::numeric_limits<Charge::value_type>::max())),
+        "measured RPC");
+}
+
 }  // namespace Resource
 }  // namespace ripple
@@ -21,6 +21,7 @@
 #define RIPPLE_RESOURCE_LOGIC_H_INCLUDED
 
 #include <ripple/basics/Log.h>
+#include <ripple/basics/ProfiledMutex.h>
 #include <ripple/basics/UnorderedContainers.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/clock/abstract_clock.h>
@@ -31,8 +32,10 @@
 #include <ripple/resource/Fees.h>
 #include <ripple/resource/Gossip.h>
 #include <ripple/resource/impl/Import.h>
+#include <array>
 #include <cassert>
 #include <mutex>
+#include <utility>
 
 namespace ripple {
 namespace Resource {
@@ -57,30 +60,43 @@ private:
         beast::insight::Meter drop;
     };
 
-    Stats m_stats;
-    Stopwatch& m_clock;
-    beast::Journal m_journal;
+    // A slice of the consumer table, chosen by the hash of the key.
+    // Entries are created, referenced and expired under the shard's
+    // lock, while charges only lock the entry being charged.
+    struct Shard
+    {
+        ProfiledMutex<std::mutex> mutex{"ResourceLogic"};
+
+        // Table of the entries in this shard
+        Table table;
 
-    std::recursive_mutex lock_;
+        // Because the following are intrusive lists, a given Entry may be
+        // in at most list at a given instant.  The Entry must be removed
+        // from one list before placing it in another.
 
-    // Table of all entries
-    Table table_;
+        // List of all active inbound entries
+        EntryIntrusiveList inbound;
 
-    // Because the following are intrusive lists, a given Entry may be in
-    // at most list at a given instant.  The Entry must be removed from
-    // one list before placing it in another.
+        // List of all active outbound entries
+        EntryIntrusiveList outbound;
 
-    // List of all active inbound entries
-    EntryIntrusiveList inbound_;
+        // List of all active admin entries
+        EntryIntrusiveList admin;
 
-    // List of all active outbound entries
-    EntryIntrusiveList outbound_;
+        // List of all inactve entries
+        EntryIntrusiveList inactive;
+    };
+
+    static constexpr std::size_t shardCount = 16;
+
+    Stats m_stats;
+    Stopwatch& m_clock;
+    beast::Journal m_journal;
 
-    // List of all active admin entries
-    EntryIntrusiveList admin_;
+    std::array<Shard, shardCount> shards_;
 
-    // List of all inactve entries
-    EntryIntrusiveList inactive_;
+    // Protects importTable_
+    std::mutex importLock_;
 
     // All imported gossip data
     Imports importTable_;
@@ -103,65 +119,24 @@ public:
         // destroyed before the consumer table.
         //
         importTable_.clear();
-        table_.clear();
+        for (auto& shard : shards_)
+            shard.table.clear();
     }
 
     Consumer
     newInboundEndpoint(beast::IP::Endpoint const& address)
     {
-        Entry* entry(nullptr);
-
-        {
-            std::lock_guard _(lock_);
-            auto [resultIt, resultInserted] = table_.emplace(
-                std::piecewise_construct,
-                std::make_tuple(kindInbound, address.at_port(0)),  // Key
-                std::make_tuple(m_clock.now()));                   // Entry
-
-            entry = &resultIt->second;
-            entry->key = &resultIt->first;
-            ++entry->refcount;
-            if (entry->refcount == 1)
-            {
-                if (!resultInserted)
-                {
-                    inactive_.erase(inactive_.iterator_to(*entry));
-                }
-                inbound_.push_back(*entry);
-            }
-        }
-
-        JLOG(m_journal.debug()) << "New inbound endpoint " << *entry;
-
-        return Consumer(*this, *entry);
+        Entry& entry = newEndpoint(kindInbound, address.at_port(0));
+        JLOG(m_journal.debug()) << "New inbound endpoint " << entry;
+        return Consumer(*this, entry);
     }
 
     Consumer
     newOutboundEndpoint(beast::IP::Endpoint const& address)
     {
-        Entry* entry(nullptr);
-
-        {
-            std::lock_guard _(lock_);
-            auto [resultIt, resultInserted] = table_.emplace(
-                std::piecewise_construct,
-                std::make_tuple(kindOutbound, address),  // Key
-                std::make_tuple(m_clock.now()));         // Entry
-
-            entry = &resultIt->second;
-            entry->key = &resultIt->first;
-            ++entry->refcount;
-            if (entry->refcount == 1)
-            {
-                if (!resultInserted)
-                    inactive_.erase(inactive_.iterator_to(*entry));
-                outbound_.push_back(*entry);
-            }
-        }
-
-        JLOG(m_journal.debug()) << "New outbound endpoint " << *entry;
-
-        return Consumer(*this, *entry);
+        Entry& entry = newEndpoint(kindOutbound, address);
+        JLOG(m_journal.debug()) << "New outbound endpoint " << entry;
+        return Consumer(*this, entry);
     }
 
     /**
@@ -172,29 +147,9 @@ public:
     Consumer
     newUnlimitedEndpoint(beast::IP::Endpoint const& address)
     {
-        Entry* entry(nullptr);
-
-        {
-            std::lock_guard _(lock_);
-            auto [resultIt, resultInserted] = table_.emplace(
-                std::piecewise_construct,
-                std::make_tuple(kindUnlimited, address.at_port(1)),  // Key
-                std::make_tuple(m_clock.now()));                     // Entry
-
-            entry = &resultIt->second;
-            entry->key = &resultIt->first;
-            ++entry->refcount;
-            if (entry->refcount == 1)
-            {
-                if (!resultInserted)
-                    inactive_.erase(inactive_.iterator_to(*entry));
-                admin_.push_back(*entry);
-            }
-        }
-
-        JLOG(m_journal.debug()) << "New unlimited endpoint " << *entry;
-
-        return Consumer(*this, *entry);
+        Entry& entry = newEndpoint(kindUnlimited, address.at_port(1));
+        JLOG(m_journal.debug()) << "New unlimited endpoint " << entry;
+        return Consumer(*this, entry);
     }
 
     Json::Value
@@ -210,43 +165,30 @@ public:
         clock_type::time_point const now(m_clock.now());
 
         Json::Value ret(Json::objectValue);
-        std::lock_guard _(lock_);
 
-        for (auto& inboundEntry : inbound_)
-        {
-            int localBalance = inboundEntry.local_balance.value(now);
-            if ((localBalance + inboundEntry.remote_balance) >= threshold)
+        auto const write = [&ret, now, threshold](
+                               EntryIntrusiveList& list, char const* type) {
+            for (auto& listEntry : list)
             {
-                Json::Value& entry =
-                    (ret[inboundEntry.to_string()] = Json::objectValue);
-                entry[jss::local] = localBalance;
-                entry[jss::remote] = inboundEntry.remote_balance;
-                entry[jss::type] = "inbound";
-            }
-        }
-        for (auto& outboundEntry : outbound_)
-        {
-            int localBalance = outboundEntry.local_balance.value(now);
-            if ((localBalance + outboundEntry.remote_balance) >= threshold)
-            {
-                Json::Value& entry =
-                    (ret[outboundEntry.to_string()] = Json::objectValue);
-                entry[jss::local] = localBalance;
-                entry[jss::remote] = outboundEntry.remote_balance;
-                entry[jss::type] = "outbound";
+                auto const [localBalance, remoteBalance] =
+                    balances(listEntry, now);
+                if ((localBalance + remoteBalance) >= threshold)
+                {
+                    Json::Value& entry =
+                        (ret[listEntry.to_string()] = Json::objectValue);
+                    entry[jss::local] = localBalance;
+                    entry[jss::remote] = remoteBalance;
+                    entry[jss::type] = type;
+                }
             }
-        }
-        for (auto& adminEntry : admin_)
+        };
+
+        for (auto& shard : shards_)
         {
-            int localBalance = adminEntry.local_balance.value(now);
-            if ((localBalance + adminEntry.remote_balance) >= threshold)
-            {
-                Json::Value& entry =
-                    (ret[adminEntry.to_string()] = Json::objectValue);
-                entry[jss::local] = localBalance;
-                entry[jss::remote] = adminEntry.remote_balance;
-                entry[jss::type] = "admin";
-            }
+            std::lock_guard _(shard.mutex);
+            write(shard.inbound, "inbound");
+            write(shard.outbound, "outbound");
+            write(shard.admin, "admin");
         }
 
         return ret;
@@ -258,18 +200,23 @@ public:
         clock_type::time_point const now(m_clock.now());
 
         Gossip gossip;
-        std::lock_guard _(lock_);
-
-        gossip.items.reserve(inbound_.size());
 
-        for (auto& inboundEntry : inbound_)
+        for (auto& shard : shards_)
         {
-            Gossip::Item item;
-            item.balance = inboundEntry.local_balance.value(now);
-            if (item.balance >= minimumGossipBalance)
+            std::lock_guard _(shard.mutex);
+
+            for (auto& inboundEntry : shard.inbound)
             {
-                item.address = inboundEntry.key->address;
-                gossip.items.push_back(item);
+                Gossip::Item item;
+                {
+                    std::lock_guard lock(inboundEntry.mutex);
+                    item.balance = inboundEntry.local_balance.value(now);
+                }
+                if (item.balance >= minimumGossipBalance)
+                {
+                    item.address = inboundEntry.key->address;
+                    gossip.items.push_back(item);
+                }
             }
         }
 
@@ -282,55 +229,37 @@ public:
     importConsumers(std::string const& origin, Gossip const& gossip)
     {
         auto const elapsed = m_clock.now();
+
+        // Build the new import before taking the lock
+        Import next;
+        next.whenExpires = elapsed + gossipExpirationSeconds;
+        next.items.reserve(gossip.items.size());
+        for (auto const& gossipItem : gossip.items)
+        {
+            Import::Item item;
+            item.balance = gossipItem.balance;
+            item.consumer = newInboundEndpoint(gossipItem.address);
+            addRemote(item.consumer.entry(), item.balance);
+            next.items.push_back(item);
+        }
+
         {
-            std::lock_guard _(lock_);
+            std::lock_guard _(importLock_);
             auto [resultIt, resultInserted] = importTable_.emplace(
                 std::piecewise_construct,
                 std::make_tuple(origin),  // Key
                 std::make_tuple(
                     m_clock.now().time_since_epoch().count()));  // Import
 
-            if (resultInserted)
+            // If a previous import exists, deduct its remote balances
+            Import& prev(resultIt->second);
+            if (!resultInserted)
             {
-                // This is a new import
-                Import& next(resultIt->second);
-                next.whenExpires = elapsed + gossipExpirationSeconds;
-                next.items.reserve(gossip.items.size());
-
-                for (auto const& gossipItem : gossip.items)
-                {
-                    Import::Item item;
-                    item.balance = gossipItem.balance;
-                    item.consumer = newInboundEndpoint(gossipItem.address);
-                    item.consumer.entry().remote_balance += item.balance;
-                    next.items.push_back(item);
-                }
-            }
-            else
-            {
-                // Previous import exists so add the new remote
-                // balances and then deduct the old remote balances.
-
-                Import next;
-                next.whenExpires = elapsed + gossipExpirationSeconds;
-                next.items.reserve(gossip.items.size());
-                for (auto const& gossipItem : gossip.items)
-                {
-                    Import::Item item;
-                    item.balance = gossipItem.balance;
-                    item.consumer = newInboundEndpoint(gossipItem.address);
-                    item.consumer.entry().remote_balance += item.balance;
-                    next.items.push_back(item);
-                }
-
-                Import& prev(resultIt->second);
                 for (auto& item : prev.items)
-                {
-                    item.consumer.entry().remote_balance -= item.balance;
-                }
-
-                std::swap(next, prev);
+                    addRemote(item.consumer.entry(), -item.balance);
             }
+
+            std::swap(next, prev);
         }
     }
 
@@ -341,25 +270,31 @@ public:
     void
     periodicActivity()
     {
-        std::lock_guard _(lock_);
-
         auto const elapsed = m_clock.now();
 
-        for (auto iter(inactive_.begin()); iter != inactive_.end();)
+        for (auto& shard : shards_)
         {
-            if (iter->whenExpires <= elapsed)
-            {
-                JLOG(m_journal.debug()) << "Expired " << *iter;
-                auto table_iter = table_.find(*iter->key);
-                ++iter;
-                erase(table_iter);
-            }
-            else
+            std::lock_guard _(shard.mutex);
+
+            for (auto iter(shard.inactive.begin());
+                 iter != shard.inactive.end();)
             {
-                break;
+                if (iter->whenExpires <= elapsed)
+                {
+                    JLOG(m_journal.debug()) << "Expired " << *iter;
+                    auto table_iter = shard.table.find(*iter->key);
+                    ++iter;
+                    erase(shard, table_iter);
+                }
+                else
+                {
+                    break;
+                }
             }
         }
 
+        std::lock_guard _(importLock_);
+
         auto iter = importTable_.begin();
         while (iter != importTable_.end())
         {
@@ -370,8 +305,7 @@ public:
                      item_iter != import.items.end();
                      ++item_iter)
                 {
-                    item_iter->consumer.entry().remote_balance -=
-                        item_iter->balance;
+                    addRemote(item_iter->consumer.entry(), -item_iter->balance);
                 }
 
                 iter = importTable_.erase(iter);
@@ -396,27 +330,18 @@ public:
         return Disposition::ok;
     }
 
-    void
-    erase(Table::iterator iter)
-    {
-        std::lock_guard _(lock_);
-        Entry& entry(iter->second);
-        assert(entry.refcount == 0);
-        inactive_.erase(inactive_.iterator_to(entry));
-        table_.erase(iter);
-    }
-
     void
     acquire(Entry& entry)
     {
-        std::lock_guard _(lock_);
+        std::lock_guard _(shardFor(*entry.key).mutex);
         ++entry.refcount;
     }
 
     void
     release(Entry& entry)
     {
-        std::lock_guard _(lock_);
+        Shard& shard = shardFor(*entry.key);
+        std::lock_guard _(shard.mutex);
         if (--entry.refcount == 0)
         {
             JLOG(m_journal.debug()) << "Inactive " << entry;
@@ -424,19 +349,19 @@ public:
             switch (entry.key->kind)
             {
                 case kindInbound:
-                    inbound_.erase(inbound_.iterator_to(entry));
+                    shard.inbound.erase(shard.inbound.iterator_to(entry));
                     break;
                 case kindOutbound:
-                    outbound_.erase(outbound_.iterator_to(entry));
+                    shard.outbound.erase(shard.outbound.iterator_to(entry));
                     break;
                 case kindUnlimited:
-                    admin_.erase(admin_.iterator_to(entry));
+                    shard.admin.erase(shard.admin.iterator_to(entry));
                     break;
                 default:
                     assert(false);
                     break;
             }
-            inactive_.push_back(entry);
+            shard.inactive.push_back(entry);
             entry.whenExpires = m_clock.now() + secondsUntilExpiration;
         }
     }
@@ -444,9 +369,11 @@ public:
     Disposition
     charge(Entry& entry, Charge const& fee)
     {
-        std::lock_guard _(lock_);
         clock_type::time_point const now(m_clock.now());
-        int const balance(entry.add(fee.cost(), now));
+        int const balance = [&] {
+            std::lock_guard _(entry.mutex);
+            return entry.add(fee.cost(), now);
+        }();
         JLOG(m_journal.trace()) << "Charging " << entry << " for " << fee;
         return disposition(balance);
     }
@@ -457,18 +384,22 @@ public:
         if (entry.isUnlimited())
             return false;
 
-        std::lock_guard _(lock_);
         bool notify(false);
         auto const elapsed = m_clock.now();
-        if (entry.balance(m_clock.now()) >= warningThreshold &&
-            elapsed != entry.lastWarningTime)
         {
-            charge(entry, feeWarning);
-            notify = true;
-            entry.lastWarningTime = elapsed;
+            std::lock_guard _(entry.mutex);
+            if (entry.balance(elapsed) >= warningThreshold &&
+                elapsed != entry.lastWarningTime)
+            {
+                entry.add(feeWarning.cost(), elapsed);
+                notify = true;
+                entry.lastWarningTime = elapsed;
+            }
         }
         if (notify)
         {
+            JLOG(m_journal.trace())
+                << "Charging " << entry << " for " << feeWarning;
             JLOG(m_journal.info()) << "Load warning: " << entry;
             ++m_stats.warn;
         }
@@ -481,30 +412,32 @@ public:
         if (entry.isUnlimited())
             return false;
 
-        std::lock_guard _(lock_);
-        bool drop(false);
         clock_type::time_point const now(m_clock.now());
-        int const balance(entry.balance(now));
-        if (balance >= dropThreshold)
-        {
-            JLOG(m_journal.warn())
-                << "Consumer entry " << entry << " dropped with balance "
-                << balance << " at or above drop threshold " << dropThreshold;
-
+        int const balance = [&] {
+            std::lock_guard _(entry.mutex);
+            int const balance(entry.balance(now));
             // Adding feeDrop at this point keeps the dropped connection
             // from re-connecting for at least a little while after it is
             // dropped.
-            charge(entry, feeDrop);
-            ++m_stats.drop;
-            drop = true;
-        }
-        return drop;
+            if (balance >= dropThreshold)
+                entry.add(feeDrop.cost(), now);
+            return balance;
+        }();
+        if (balance < dropThreshold)
+            return false;
+
+        JLOG(m_journal.warn())
+            << "Consumer entry " << entry << " dropped with balance "
+            << balance << " at or above drop threshold " << dropThreshold;
+        JLOG(m_journal.trace()) << "Charging " << entry << " for " << feeDrop;
+        ++m_stats.drop;
+        return true;
     }
 
     int
     balance(Entry& entry)
     {
-        std::lock_guard _(lock_);
+        std::lock_guard _(entry.mutex);
         return entry.balance(m_clock.now());
     }
 
@@ -519,12 +452,13 @@ public:
         for (auto& entry : list)
         {
             beast::PropertyStream::Map item(items);
+            auto const [localBalance, remoteBalance] = balances(entry, now);
             if (entry.refcount != 0)
                 item["count"] = entry.refcount;
             item["name"] = entry.to_string();
-            item["balance"] = entry.balance(now);
-            if (entry.remote_balance != 0)
-                item["remote_balance"] = entry.remote_balance;
+            item["balance"] = localBalance + remoteBalance;
+            if (remoteBalance != 0)
+                item["remote_balance"] = remoteBalance;
         }
     }
 
@@ -533,27 +467,98 @@ public:
     {
         clock_type::time_point const now(m_clock.now());
 
-        std::lock_guard _(lock_);
+        auto const write = [this, now, &map](
+                               char const* name,
+                               EntryIntrusiveList Shard::*list) {
+            beast::PropertyStream::Set s(name, map);
+            for (auto& shard : shards_)
+            {
+                std::lock_guard _(shard.mutex);
+                writeList(now, s, shard.*list);
+            }
+        };
 
-        {
-            beast::PropertyStream::Set s("inbound", map);
-            writeList(now, s, inbound_);
-        }
+        write("inbound", &Shard::inbound);
+        write("outbound", &Shard::outbound);
+        write("admin", &Shard::admin);
+        write("inactive", &Shard::inactive);
+    }
 
-        {
-            beast::PropertyStream::Set s("outbound", map);
-            writeList(now, s, outbound_);
-        }
+private:
+    Shard&
+    shardFor(Key const& key)
+    {
+        return shards_[Key::hasher{}(key) % shardCount];
+    }
 
+    // Find or create the entry for a key and add a reference to it
+    Entry&
+    newEndpoint(Kind kind, beast::IP::Endpoint const& address)
+    {
+        Key key(kind, address);
+        Shard& shard = shardFor(key);
+
+        std::lock_guard _(shard.mutex);
+        auto [resultIt, resultInserted] = shard.table.emplace(
+            std::piecewise_construct,
+            std::make_tuple(std::move(key)),  // Key
+            std::make_tuple(m_clock.now()));  // Entry
+
+        Entry& entry = resultIt->second;
+        // Holders of the entry read key without the lock, so set
+        // it only once.
+        if (resultInserted)
+            entry.key = &resultIt->first;
+        ++entry.refcount;
+        if (entry.refcount == 1)
         {
-            beast::PropertyStream::Set s("admin", map);
-            writeList(now, s, admin_);
-        }
+            if (!resultInserted)
+                shard.inactive.erase(shard.inactive.iterator_to(entry));
 
-        {
-            beast::PropertyStream::Set s("inactive", map);
-            writeList(now, s, inactive_);
+            switch (kind)
+            {
+                case kindInbound:
+                    shard.inbound.push_back(entry);
+                    break;
+                case kindOutbound:
+                    shard.outbound.push_back(entry);
+                    break;
+                case kindUnlimited:
+                    shard.admin.push_back(entry);
+                    break;
+                default:
+                    assert(false);
+                    break;
+            }
         }
+        return entry;
+    }
+
+    // Requires the shard's lock
+    void
+    erase(Shard& shard, Table::iterator iter)
+    {
+        Entry& entry(iter->second);
+        assert(entry.refcount == 0);
+        shard.inactive.erase(shard.inactive.iterator_to(entry));
+        shard.table.erase(iter);
+    }
+
+    static void
+    addRemote(Entry& entry, int balance)
+    {
+        std::lock_guard _(entry.mutex);
+        entry.remote_balance += balance;
+    }
+
+    // Return the local and remote balances of an entry
+    static std::pair<int, int>
+    balances(Entry& entry, clock_type::time_point const now)
+    {
+        std::lock_guard _(entry.mutex);
+        return {
+            static_cast<int>(entry.local_balance.value(now)),
+            entry.remote_balance};
     }
 };
 
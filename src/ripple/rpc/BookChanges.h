@@ -20,9 +20,17 @@
 #ifndef RIPPLE_RPC_BOOKCHANGES_H_INCLUDED
 #define RIPPLE_RPC_BOOKCHANGES_H_INCLUDED
 
-namespace Json {
-class Value;
-}
+#include <ripple/basics/TaggedCache.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/json/json_value.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/jss.h>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <tuple>
 
 namespace ripple {
 
@@ -33,11 +41,10 @@ class STTx;
 
 namespace RPC {
 
-template <class L>
-Json::Value
-computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
+/** The offers crossed in one ledger, tallied by book. */
+struct BookChanges
 {
-    std::map<
+    using Tally = std::map<
         std::string,
         std::tuple<
             STAmount,  // side A volume
@@ -46,8 +53,69 @@ computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
             STAmount,  // low rate
             STAmount,  // open rate
             STAmount   // close rate
-            >>
-        tally;
+            >>;
+
+    /// Keyed by the two sides of the book, as "A|B"
+    Tally tally;
+
+    /// The bookChanges message, as streamed and returned by book_changes
+    Json::Value json;
+};
+
+/** Recent ledgers' book changes, by ledger hash.
+
+    The book_changes stream and method both ask for the ledgers just
+    validated, and charting clients ask for the same ones again and again,
+    so each ledger's changes are tallied once and kept here.
+*/
+using BookChangesCache = TaggedCache<uint256, BookChanges const>;
+
+/** Build the bookChanges message of a ledger from its tally. */
+template <class L>
+Json::Value
+computeBookChangesJson(L const& ledger, BookChanges::Tally const& tally)
+{
+    Json::Value jvObj(Json::objectValue);
+    jvObj[jss::type] = "bookChanges";
+    jvObj[jss::ledger_index] = ledger.info().seq;
+    jvObj[jss::ledger_hash] = to_string(ledger.info().hash);
+    jvObj[jss::ledger_time] = Json::Value::UInt(
+        ledger.info().closeTime.time_since_epoch().count());
+
+    jvObj[jss::changes] = Json::arrayValue;
+
+    for (auto const& entry : tally)
+    {
+        Json::Value& inner = jvObj[jss::changes].append(Json::objectValue);
+
+        STAmount volA = std::get<0>(entry.second);
+        STAmount volB = std::get<1>(entry.second);
+
+        inner[jss::currency_a] =
+            (isXRP(volA) ? "XRP_drops" : to_string(volA.issue()));
+        inner[jss::currency_b] =
+            (isXRP(volB) ? "XRP_drops" : to_string(volB.issue()));
+
+        inner[jss::volume_a] =
+            (isXRP(volA) ? to_string(volA.xrp()) : to_string(volA.iou()));
+        inner[jss::volume_b] =
+            (isXRP(volB) ? to_string(volB.xrp()) : to_string(volB.iou()));
+
+        inner[jss::high] = to_string(std::get<2>(entry.second).iou());
+        inner[jss::low] = to_string(std::get<3>(entry.second).iou());
+        inner[jss::open] = to_string(std::get<4>(entry.second).iou());
+        inner[jss::close] = to_string(std::get<5>(entry.second).iou());
+    }
+
+    return jvObj;
+}
+
+/** Tally the offers crossed in a ledger. */
+template <class L>
+std::shared_ptr<BookChanges const>
+tallyBookChanges(std::shared_ptr<L const> const& lpAccepted)
+{
+    BookChanges::Tally tally;
 
     for (auto& tx : lpAccepted->txs)
     {
@@ -169,39 +237,40 @@ computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
         }
     }
 
-    Json::Value jvObj(Json::objectValue);
-    jvObj[jss::type] = "bookChanges";
-    jvObj[jss::ledger_index] = lpAccepted->info().seq;
-    jvObj[jss::ledger_hash] = to_string(lpAccepted->info().hash);
-    jvObj[jss::ledger_time] = Json::Value::UInt(
-        lpAccepted->info().closeTime.time_since_epoch().count());
-
-    jvObj[jss::changes] = Json::arrayValue;
-
-    for (auto const& entry : tally)
-    {
-        Json::Value& inner = jvObj[jss::changes].append(Json::objectValue);
+    auto changes = std::make_shared<BookChanges>();
+    changes->json = computeBookChangesJson(*lpAccepted, tally);
+    changes->tally = std::move(tally);
+    return changes;
+}
 
-        STAmount volA = std::get<0>(entry.second);
-        STAmount volB = std::get<1>(entry.second);
+/** Return the book changes of a ledger, tallying them only once.
 
-        inner[jss::currency_a] =
-            (isXRP(volA) ? "XRP_drops" : to_string(volA.issue()));
-        inner[jss::currency_b] =
-            (isXRP(volB) ? "XRP_drops" : to_string(volB.issue()));
+    The open ledger changes with every transaction, so its changes are
+    tallied each time and never kept.
+*/
+template <class L>
+std::shared_ptr<BookChanges const>
+getBookChanges(
+    BookChangesCache& cache,
+    std::shared_ptr<L const> const& lpAccepted)
+{
+    if (lpAccepted->open())
+        return tallyBookChanges(lpAccepted);
 
-        inner[jss::volume_a] =
-            (isXRP(volA) ? to_string(volA.xrp()) : to_string(volA.iou()));
-        inner[jss::volume_b] =
-            (isXRP(volB) ? to_string(volB.xrp()) : to_string(volB.iou()));
+    auto const& hash = lpAccepted->info().hash;
+    if (auto changes = cache.fetch(hash))
+        return changes;
 
-        inner[jss::high] = to_string(std::get<2>(entry.second).iou());
-        inner[jss::low] = to_string(std::get<3>(entry.second).iou());
-        inner[jss::open] = to_string(std::get<4>(entry.second).iou());
-        inner[jss::close] = to_string(std::get<5>(entry.second).iou());
-    }
+    auto changes = tallyBookChanges(lpAccepted);
+    cache.canonicalize_replace_client(hash, changes);
+    return changes;
+}
 
-    return jvObj;
+template <class L>
+Json::Value
+computeBookChanges(std::shared_ptr<L const> const& lpAccepted)
+{
+    return tallyBookChanges(lpAccepted)->json;
 }
 
 }  // namespace RPC
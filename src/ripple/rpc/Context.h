@@ -27,6 +27,8 @@
 
 #include <ripple/beast/utility/Journal.h>
 
+#include <chrono>
+
 namespace ripple {
 
 class Application;
@@ -48,6 +50,8 @@ struct Context
     std::shared_ptr<JobQueue::Coro> coro{};
     InfoSub::pointer infoSub{};
     unsigned int apiVersion;
+    // Time spent in getLedger, to tell ledger lookups from handler work
+    std::chrono::microseconds ledgerTime{0};
 };
 
 struct JsonContext : public Context
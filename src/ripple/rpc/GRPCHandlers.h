@@ -20,9 +20,12 @@
 #ifndef RIPPLE_RPC_GRPCHANDLER_H_INCLUDED
 #define RIPPLE_RPC_GRPCHANDLER_H_INCLUDED
 
+#include <ripple/ledger/ReadView.h>
 #include <ripple/proto/org/xrpl/rpc/v1/xrp_ledger.pb.h>
 #include <ripple/rpc/Context.h>
 #include <grpcpp/grpcpp.h>
+#include <cstdint>
+#include <memory>
 
 namespace ripple {
 
@@ -49,6 +52,41 @@ std::pair<org::xrpl::rpc::v1::GetLedgerDiffResponse, grpc::Status>
 doLedgerDiffGrpc(
     RPC::GRPCContext<org::xrpl::rpc::v1::GetLedgerDiffRequest>& context);
 
+/** Produces the messages of a StreamLedgerData call, one at a time.
+
+    The ledger is walked once for the whole stream, so each message picks
+    up where the last one stopped instead of searching down the tree for a
+    marker the way each page of GetLedgerData does.
+*/
+class LedgerDataStream
+{
+public:
+    using Request = org::xrpl::rpc::v1::StreamLedgerDataRequest;
+    using Response = org::xrpl::rpc::v1::StreamLedgerDataResponse;
+
+    /** Find the requested ledger and start the walk.
+
+        If the status is not Status::OK, there is nothing to stream.
+    */
+    grpc::Status
+    open(RPC::GRPCContext<Request>& context);
+
+    /** Fill in the next message of the stream.
+
+        @return false if this is the last message.
+    */
+    bool
+    next(Response& response);
+
+private:
+    std::shared_ptr<ReadView const> ledger_;
+    ReadView::txs_type::iterator tx_;
+    ReadView::txs_type::iterator txEnd_;
+    ReadView::sles_type::iterator sle_;
+    ReadView::sles_type::iterator sleEnd_;
+    std::uint32_t limit_ = 0;
+};
+
 }  // namespace ripple
 
 #endif
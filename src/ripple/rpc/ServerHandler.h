@@ -21,9 +21,11 @@
 #define RIPPLE_RPC_SERVERHANDLER_H_INCLUDED
 
 #include <ripple/app/main/CollectorManager.h>
+#include <ripple/basics/PerfLog.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/json/Output.h>
 #include <ripple/rpc/RPCHandler.h>
+#include <ripple/rpc/impl/PortWorkers.h>
 #include <ripple/rpc/impl/WSInfoSub.h>
 #include <ripple/server/Server.h>
 #include <ripple/server/Session.h>
@@ -31,9 +33,13 @@
 #include <boost/beast/core/tcp_stream.hpp>
 #include <boost/beast/ssl/ssl_stream.hpp>
 #include <boost/utility/string_view.hpp>
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 namespace ripple {
@@ -96,13 +102,20 @@ private:
     std::unique_ptr<Server> m_server;
     Setup setup_;
     JobQueue& m_jobQueue;
+    CollectorManager& collectorManager_;
     beast::insight::Counter rpc_requests_;
     beast::insight::Event rpc_size_;
     beast::insight::Event rpc_time_;
+    beast::insight::Event rpc_queue_time_;
+    beast::insight::Event rpc_ledger_time_;
+    beast::insight::Event rpc_handler_time_;
+    beast::insight::Event rpc_serialize_time_;
     std::mutex mutex_;
     std::condition_variable condition_;
     bool stopped_{false};
     std::map<std::reference_wrapper<Port const>, int> count_;
+    // The ports with threads of their own, by name
+    std::map<std::string, std::unique_ptr<PortWorkers>> workers_;
 
     // A private type used to restrict access to the ServerHandler constructor.
     struct ServerHandlerCreator
@@ -148,6 +161,19 @@ public:
     void
     stop();
 
+    /** The state of the threads serving a port alone.
+
+        @return `Json::nullValue` if the port shares the job queue.
+    */
+    Json::Value
+    getWorkersJson(Port const& port) const;
+
+    /** Set where connections accepted on peer protocol ports run.
+        Must be called before setup().
+    */
+    void
+    setPeerIO(std::function<boost::asio::io_context&()> peerIO);
+
     //
     // Handler
     //
@@ -190,16 +216,20 @@ public:
     onStopped(Server&);
 
 private:
+    using clock_type = std::chrono::steady_clock;
+
     Json::Value
     processSession(
         std::shared_ptr<WSSession> const& session,
         std::shared_ptr<JobQueue::Coro> const& coro,
-        Json::Value const& jv);
+        Json::Value const& jv,
+        perf::PerfLog::RpcTimes& times);
 
     void
     processSession(
         std::shared_ptr<Session> const&,
-        std::shared_ptr<JobQueue::Coro> coro);
+        std::shared_ptr<JobQueue::Coro> coro,
+        clock_type::time_point received);
 
     void
     processRequest(
@@ -209,10 +239,33 @@ private:
         Output&&,
         std::shared_ptr<JobQueue::Coro> coro,
         boost::string_view forwardedFor,
-        boost::string_view user);
+        boost::string_view user,
+        clock_type::time_point received);
+
+    // Publish where the time of an RPC call went
+    void
+    recordTimes(
+        std::string const& method,
+        perf::PerfLog::RpcTimes const& times);
 
     Handoff
     statusResponse(http_request_type const& request) const;
+
+    // Answer a Prometheus scrape, which only admin addresses may make
+    Handoff
+    metricsResponse(
+        Port const& port,
+        http_request_type const& request,
+        boost::asio::ip::tcp::endpoint const& remote_address) const;
+
+    // Run a request that does not suspend. It goes to the threads of its
+    // port if the port has them, and to the job queue otherwise.
+    bool
+    postRequest(
+        Port const& port,
+        JobType type,
+        std::string const& name,
+        std::function<void()> request);
 };
 
 ServerHandler::Setup
@@ -18,6 +18,8 @@
 //==============================================================================
 
 #include <ripple/app/main/Application.h>
+#include <ripple/app/paths/PathRequests.h>
+#include <ripple/app/paths/RippleLineCache.h>
 #include <ripple/app/paths/TrustLine.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/net/RPCErr.h>
@@ -59,14 +61,27 @@ doAccountCurrencies(RPC::JsonContext& context)
         return rpcError(rpcACT_NOT_FOUND);
 
     std::set<Currency> send, receive;
-    for (auto const& rspEntry : RPCTrustLine::getItems(accountID, *ledger))
+    if (auto const cache = context.app.getPathRequests().findLineCache(ledger))
     {
-        STAmount const& saBalance = rspEntry.getBalance();
-
-        if (saBalance < rspEntry.getLimit())
-            receive.insert(saBalance.getCurrency());
-        if ((-saBalance) < rspEntry.getLimitPeer())
-            send.insert(saBalance.getCurrency());
+        // Path finding has the lines of this ledger at hand already
+        if (auto const index =
+                cache->getLineIndex(accountID, LineDirection::outgoing))
+        {
+            send.insert(index->send.begin(), index->send.end());
+            receive.insert(index->receive.begin(), index->receive.end());
+        }
+    }
+    else
+    {
+        for (auto const& rspEntry : RPCTrustLine::getItems(accountID, *ledger))
+        {
+            STAmount const& saBalance = rspEntry.getBalance();
+
+            if (saBalance < rspEntry.getLimit())
+                receive.insert(saBalance.getCurrency());
+            if ((-saBalance) < rspEntry.getLimitPeer())
+                send.insert(saBalance.getCurrency());
+        }
     }
 
     send.erase(badCurrency());
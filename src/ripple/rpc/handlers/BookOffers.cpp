@@ -209,8 +209,10 @@ doBookChanges(RPC::JsonContext& context)
     if (std::holds_alternative<Json::Value>(res))
         return std::get<Json::Value>(res);
 
-    return RPC::computeBookChanges(
-        std::get<std::shared_ptr<Ledger const>>(res));
+    return RPC::getBookChanges(
+               context.app.getBookChangesCache(),
+               std::get<std::shared_ptr<Ledger const>>(res))
+        ->json;
 }
 
 }  // namespace ripple
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/app/main/Application.h>
+#include <ripple/app/misc/GatewayBalancesIndex.h>
 #include <ripple/app/paths/TrustLine.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/net/RPCErr.h>
@@ -50,6 +51,66 @@ namespace ripple {
 
 // gateway_balances [<ledger>] <account> [<howallet> [<hotwallet [...
 
+// Fill in the response from the index, taking out the hot wallets' lines
+static void
+fromIndex(
+    GatewayBalancesIndex::Balances indexed,
+    ReadView const& ledger,
+    AccountID const& accountID,
+    std::set<AccountID> const& hotWallets,
+    std::map<Currency, STAmount>& sums,
+    std::map<AccountID, std::vector<STAmount>>& hotBalances,
+    std::map<AccountID, std::vector<STAmount>>& assets,
+    std::map<AccountID, std::vector<STAmount>>& frozenBalances)
+{
+    std::set<Currency> changed;
+    for (auto const& hotWallet : hotWallets)
+    {
+        std::set<Currency> currencies;
+        for (auto const& [currency, _] : indexed.obligations)
+            currencies.insert(currency);
+        for (auto const& byPeer : {indexed.frozen, indexed.assets})
+        {
+            if (auto iter = byPeer.find(hotWallet); iter != byPeer.end())
+            {
+                for (auto const& [currency, _] : iter->second)
+                    currencies.insert(currency);
+            }
+        }
+
+        for (auto const& currency : currencies)
+        {
+            auto const sle =
+                ledger.read(keylet::line(accountID, hotWallet, currency));
+            if (!sle)
+                continue;
+
+            if (auto const obligation = GatewayBalancesIndex::apply(
+                    indexed, accountID, sle, false))
+                changed.insert(*obligation);
+            if (auto const rs = PathFindTrustLine::makeItem(accountID, sle);
+                rs && rs->getBalance().signum() != 0)
+                hotBalances[hotWallet].push_back(-rs->getBalance());
+        }
+    }
+
+    for (auto const& currency : changed)
+        GatewayBalancesIndex::total(indexed, currency);
+
+    for (auto const& [currency, sum] : indexed.obligations)
+        sums.emplace(currency, sum.amount);
+
+    auto toVectors = [](auto const& byPeer, auto& out) {
+        for (auto const& [peer, amounts] : byPeer)
+        {
+            for (auto const& [_, amount] : amounts)
+                out[peer].push_back(amount);
+        }
+    };
+    toVectors(indexed.frozen, frozenBalances);
+    toVectors(indexed.assets, assets);
+}
+
 Json::Value
 doGatewayBalances(RPC::JsonContext& context)
 {
@@ -143,8 +204,24 @@ doGatewayBalances(RPC::JsonContext& context)
     std::map<AccountID, std::vector<STAmount>> assets;
     std::map<AccountID, std::vector<STAmount>> frozenBalances;
 
-    // Traverse the cold wallet's trust lines
+    auto const index = context.app.getGatewayBalancesIndex();
+    if (auto const indexed = index && index->tracks(accountID)
+            ? index->balances(accountID, *ledger)
+            : nullptr)
+    {
+        fromIndex(
+            *indexed,
+            *ledger,
+            accountID,
+            hotWallets,
+            sums,
+            hotBalances,
+            assets,
+            frozenBalances);
+    }
+    else
     {
+        // Traverse the cold wallet's trust lines
         forEachItem(
             *ledger, accountID, [&](std::shared_ptr<SLE const> const& sle) {
                 auto rs = PathFindTrustLine::makeItem(accountID, sle);
@@ -21,8 +21,11 @@
 #include <ripple/app/ledger/InboundLedgers.h>
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
+#include <ripple/app/main/MemoryUsage.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/rdb/backend/SQLiteDatabase.h>
+#include <ripple/basics/PerfLog.h>
+#include <ripple/basics/ProfiledMutex.h>
 #include <ripple/basics/UptimeClock.h>
 #include <ripple/json/json_value.h>
 #include <ripple/ledger/CachedSLEs.h>
@@ -32,6 +35,8 @@
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/Context.h>
+#include <ripple/rpc/impl/ResponseCache.h>
+#include <ripple/shamap/SHAMapItem.h>
 #include <ripple/shamap/ShardFamily.h>
 
 namespace ripple {
@@ -108,9 +113,27 @@ getCountsJson(Application& app, int minObjectCount)
     ret[jss::historical_perminute] =
         static_cast<int>(app.getInboundLedgers().fetchRate());
     ret[jss::SLE_hit_rate] = app.cachedSLEs().rate();
+    {
+        using Caller = CachedSLEs::Caller;
+        auto const& sles = app.cachedSLEs();
+        Json::Value& rates = (ret[jss::SLE_hit_rates] = Json::objectValue);
+        rates[jss::rpc] = sles.rate(Caller::rpc);
+        rates[jss::pathfinding] = sles.rate(Caller::pathfinding);
+        rates[jss::transaction] = sles.rate(Caller::transaction);
+        rates[jss::other] = sles.rate(Caller::other);
+    }
     ret[jss::ledger_hit_rate] = app.getLedgerMaster().getCacheHitRate();
+    ret[jss::ledger_header_hit_rate] =
+        app.getLedgerMaster().getHeaderCacheHitRate();
     ret[jss::AL_size] = Json::UInt(app.getAcceptedLedgerCache().size());
     ret[jss::AL_hit_rate] = app.getAcceptedLedgerCache().getHitRate();
+    if (auto const cache = app.getRPCResponseCache())
+    {
+        ret[jss::rpc_response_size] = Json::UInt(cache->size());
+        ret[jss::rpc_response_hit_rate] = cache->getHitRate();
+    }
+    if (auto latency = app.getPerfLog().rpcLatencyJson(); latency.size() != 0)
+        ret[jss::rpc_latency] = std::move(latency);
 
     ret[jss::fullbelow_size] =
         static_cast<int>(app.getNodeFamily().getFullBelowCache(0)->size());
@@ -118,6 +141,44 @@ getCountsJson(Application& app, int minObjectCount)
         app.getNodeFamily().getTreeNodeCache(0)->getCacheSize();
     ret[jss::treenode_track_size] =
         app.getNodeFamily().getTreeNodeCache(0)->getTrackSize();
+    ret[jss::treenode_cache_bytes] = std::to_string(
+        app.getNodeFamily().getTreeNodeCache(0)->getCacheBytes());
+
+    {
+        Json::Value& slabs = (ret[jss::shamap_item_slabs] = Json::arrayValue);
+        for (auto const& c : detail::slabber.getCounts())
+        {
+            Json::Value& jv = slabs.append(Json::objectValue);
+            jv[jss::item_size] = static_cast<Json::UInt>(c.itemSize);
+            jv[jss::slabs] = static_cast<Json::UInt>(c.slabs);
+            jv[jss::capacity] = static_cast<Json::UInt>(c.capacity);
+            jv[jss::outstanding] = static_cast<Json::UInt>(c.outstanding);
+            jv[jss::magazine_hits] = std::to_string(c.magazineHits);
+        }
+    }
+
+    ret[jss::memory] = toJson(getMemoryUsage(app));
+
+    // Only builds with lock profiling have any
+    if (auto const locks = LockProfiles::getInstance().getCounts();
+        !locks.empty())
+    {
+        using namespace std::chrono;
+        auto us = [](nanoseconds ns) {
+            return std::to_string(duration_cast<microseconds>(ns).count());
+        };
+
+        Json::Value& jv = (ret[jss::locks] = Json::objectValue);
+        for (auto const& [name, counts] : locks)
+        {
+            Json::Value& lock = (jv[name] = Json::objectValue);
+            lock[jss::acquisitions] = std::to_string(counts.acquisitions);
+            lock[jss::contentions] = std::to_string(counts.contentions);
+            lock[jss::wait_us] = us(counts.wait);
+            lock[jss::max_wait_us] = us(counts.maxWait);
+            lock[jss::hold_us] = us(counts.hold);
+        }
+    }
 
     std::string uptime;
     auto s = UptimeClock::now();
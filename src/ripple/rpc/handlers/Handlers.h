@@ -59,6 +59,8 @@ doConnect(RPC::JsonContext&);
 Json::Value
 doConsensusInfo(RPC::JsonContext&);
 Json::Value
+doConsensusTimeline(RPC::JsonContext&);
+Json::Value
 doDepositAuthorized(RPC::JsonContext&);
 Json::Value
 doDownloadShard(RPC::JsonContext&);
@@ -111,6 +113,8 @@ doPause(RPC::JsonContext&);
 Json::Value
 doPeers(RPC::JsonContext&);
 Json::Value
+doPerfTrace(RPC::JsonContext&);
+Json::Value
 doPing(RPC::JsonContext&);
 Json::Value
 doPrint(RPC::JsonContext&);
@@ -20,6 +20,7 @@
 #include <ripple/app/ledger/LedgerCleaner.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/json/json_value.h>
+#include <ripple/protocol/jss.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/impl/Handler.h>
 
@@ -28,8 +29,21 @@ namespace ripple {
 Json::Value
 doLedgerCleaner(RPC::JsonContext& context)
 {
-    context.app.getLedgerCleaner().clean(context.params);
-    return RPC::makeObjectValue("Cleaner configured");
+    auto& cleaner = context.app.getLedgerCleaner();
+
+    // Report the progress without changing what is being cleaned
+    if (context.params.isMember(jss::status) &&
+        context.params[jss::status].asBool())
+    {
+        Json::Value ret(Json::objectValue);
+        ret[jss::ledger_cleaner] = cleaner.getJson();
+        return ret;
+    }
+
+    cleaner.clean(context.params);
+    auto ret = RPC::makeObjectValue("Cleaner configured");
+    ret[jss::ledger_cleaner] = cleaner.getJson();
+    return ret;
 }
 
 }  // namespace ripple
@@ -202,4 +202,65 @@ doLedgerDataGrpc(
     return {response, status};
 }
 
+grpc::Status
+LedgerDataStream::open(RPC::GRPCContext<Request>& context)
+{
+    if (auto status = RPC::ledgerFromRequest(ledger_, context))
+    {
+        if (status.toErrorCode() == rpcINVALID_PARAMS)
+            return {grpc::StatusCode::INVALID_ARGUMENT, status.message()};
+        return {grpc::StatusCode::NOT_FOUND, status.message()};
+    }
+
+    std::uint32_t const maxLimit = RPC::Tuning::pageLength(true);
+    auto const limit = context.params.limit();
+    limit_ = (limit == 0 || limit > maxLimit) ? maxLimit : limit;
+
+    // Without transactions, the walk starts at the end of them
+    txEnd_ = ledger_->txs.end();
+    tx_ = context.params.transactions() ? ledger_->txs.begin() : txEnd_;
+    sle_ = ledger_->sles.begin();
+    sleEnd_ = ledger_->sles.end();
+    return grpc::Status::OK;
+}
+
+bool
+LedgerDataStream::next(Response& response)
+{
+    auto const& info = ledger_->info();
+    response.set_ledger_index(info.seq);
+    response.set_ledger_hash(info.hash.data(), info.hash.size());
+
+    std::uint32_t count = 0;
+    for (; tx_ != txEnd_ && count < limit_; ++tx_, ++count)
+    {
+        auto const& [txn, meta] = *tx_;
+        auto txnAndMeta =
+            response.mutable_transactions_list()->add_transactions();
+        Serializer sTxn = txn->getSerializer();
+        txnAndMeta->set_transaction_blob(sTxn.data(), sTxn.getLength());
+        if (meta)
+        {
+            Serializer sMeta = meta->getSerializer();
+            txnAndMeta->set_metadata_blob(sMeta.data(), sMeta.getLength());
+        }
+    }
+
+    // Transactions and ledger objects are not mixed in one message
+    if (count != 0)
+        return true;
+
+    for (; sle_ != sleEnd_ && count < limit_; ++sle_, ++count)
+    {
+        auto const& sle = *sle_;
+        auto stateObject = response.mutable_ledger_objects()->add_objects();
+        Serializer s;
+        sle->add(s);
+        stateObject->set_data(s.peekData().data(), s.getLength());
+        stateObject->set_key(sle->key().data(), sle->key().size());
+    }
+
+    return sle_ != sleEnd_;
+}
+
 }  // namespace ripple
@@ -38,6 +38,9 @@ doPeers(RPC::JsonContext& context)
 
     jvResult[jss::peers] = context.app.overlay().json();
 
+    if (context.app.config().VP_REDUCE_RELAY_ENABLE)
+        jvResult[jss::reduce_relay] = context.app.overlay().vpMetrics();
+
     // Legacy support
     if (context.apiVersion == 1)
     {
@@ -0,0 +1,57 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/PerfTrace.h>
+#include <ripple/json/json_value.h>
+#include <ripple/net/RPCErr.h>
+#include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/Context.h>
+
+namespace ripple {
+
+// {
+//   action: "start" | "stop"  // optional
+// }
+//
+// With no action, returns the events recorded so far as a Chrome trace.
+Json::Value
+doPerfTrace(RPC::JsonContext& context)
+{
+    if (context.params.isMember(jss::action))
+    {
+        auto const action = context.params[jss::action].asString();
+        if (action == "start")
+            perf::trace::start();
+        else if (action == "stop")
+            perf::trace::stop();
+        else
+            return rpcError(rpcINVALID_PARAMS);
+
+        Json::Value ret(Json::objectValue);
+        ret[jss::enabled] = perf::trace::enabled();
+        return ret;
+    }
+
+    auto ret = perf::trace::toJson();
+    ret[jss::enabled] = perf::trace::enabled();
+    return ret;
+}
+
+}  // namespace ripple
@@ -54,6 +54,11 @@ doRipplePathFind(RPC::JsonContext& context)
             return rpcError(rpcNOT_SYNCED);
         }
 
+        // The server only runs this command inside a coroutine, which it
+        // needs in order to wait for the path finding engine.
+        if (!context.coro)
+            return rpcError(rpcINTERNAL);
+
         PathRequest::pointer request;
         lpLedger = context.ledgerMaster.getClosedLedger();
 
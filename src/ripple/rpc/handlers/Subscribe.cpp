@@ -112,6 +112,13 @@ doSubscribe(RPC::JsonContext& context)
     }
     ispSub->setApiVersion(context.apiVersion);
 
+    if (context.params.isMember(jss::binary))
+    {
+        if (!context.params[jss::binary].isBool())
+            return RPC::expected_field_error(jss::binary, "boolean");
+        ispSub->setBinary(context.params[jss::binary].asBool());
+    }
+
     if (context.params.isMember(jss::streams))
     {
         if (!context.params[jss::streams].isArray())
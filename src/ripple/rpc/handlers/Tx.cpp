@@ -289,7 +289,7 @@ doTxHelp(RPC::Context& context, TxArgs args)
 
         // compute outgoing CTID
         uint32_t lgrSeq = ledger->info().seq;
-        uint32_t txnIdx = meta->getAsObject().getFieldU32(sfTransactionIndex);
+        uint32_t txnIdx = meta->getIndex();
         uint32_t netID = context.app.config().NETWORK_ID;
 
         if (txnIdx <= 0xFFFFU && netID < 0xFFFFU && lgrSeq < 0x0FFF'FFFFUL)
@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/rpc/impl/PortWorkers.h>
+
+#include <ripple/protocol/jss.h>
+
+namespace ripple {
+
+PortWorkers::PortWorkers(
+    std::string const& name,
+    int threads,
+    std::size_t queueLimit)
+    : threads_(threads)
+    , queueLimit_(queueLimit)
+    , workers_(*this, nullptr, "Port " + name, threads)
+{
+}
+
+PortWorkers::~PortWorkers()
+{
+    stop();
+}
+
+bool
+PortWorkers::post(std::function<void()> request)
+{
+    {
+        std::lock_guard lock(mutex_);
+        if (stopped_ || (queueLimit_ != 0 && queue_.size() >= queueLimit_))
+        {
+            ++rejected_;
+            return false;
+        }
+        queue_.push_back(std::move(request));
+    }
+    workers_.addTask();
+    return true;
+}
+
+void
+PortWorkers::stop()
+{
+    {
+        std::unique_lock lock(mutex_);
+        stopped_ = true;
+        idle_.wait(lock, [this] { return queue_.empty() && running_ == 0; });
+    }
+    workers_.stop();
+}
+
+Json::Value
+PortWorkers::getJson() const
+{
+    Json::Value ret(Json::objectValue);
+    ret[jss::threads] = threads_;
+    if (queueLimit_ != 0)
+        ret[jss::queue_limit] = static_cast<Json::UInt>(queueLimit_);
+
+    std::lock_guard lock(mutex_);
+    ret[jss::queued] = static_cast<Json::UInt>(queue_.size());
+    ret[jss::running] = static_cast<Json::UInt>(running_);
+    ret[jss::completed] = std::to_string(completed_);
+    ret[jss::rejected] = std::to_string(rejected_);
+    return ret;
+}
+
+void
+PortWorkers::processTask(int)
+{
+    std::function<void()> request;
+    {
+        std::lock_guard lock(mutex_);
+        if (queue_.empty())
+            return;
+        request = std::move(queue_.front());
+        queue_.pop_front();
+        ++running_;
+    }
+
+    request();
+
+    std::lock_guard lock(mutex_);
+    --running_;
+    ++completed_;
+    if (queue_.empty() && running_ == 0)
+        idle_.notify_all();
+}
+
+}  // namespace ripple
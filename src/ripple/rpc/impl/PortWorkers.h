@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_PORTWORKERS_H_INCLUDED
+#define RIPPLE_RPC_PORTWORKERS_H_INCLUDED
+
+#include <ripple/core/impl/Workers.h>
+#include <ripple/json/json_value.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace ripple {
+
+/** Threads that serve the requests of one port alone.
+
+    By default the requests on every port share the job queue, so a burst
+    of heavy requests from public clients delays the admin and reporting
+    ports behind them. A port configured with its own workers runs its
+    requests here instead, with a concurrency bounded by the number of
+    threads and, optionally, a bound on the requests left waiting for
+    them.
+*/
+class PortWorkers : private Workers::Callback
+{
+public:
+    /** Create the threads.
+
+        @param name The name of the port, for the names of the threads.
+        @param threads The number of requests run at once.
+        @param queueLimit The number of requests that may wait for a
+                          thread, where 0 means unlimited.
+    */
+    PortWorkers(std::string const& name, int threads, std::size_t queueLimit);
+
+    ~PortWorkers() override;
+
+    /** Run a request on one of the threads.
+
+        @return `false` if the queue is full or the workers are stopped,
+                in which case the request is not run.
+    */
+    bool
+    post(std::function<void()> request);
+
+    /** Refuse new requests, then wait for the queued ones to finish. */
+    void
+    stop();
+
+    /** The number of threads, the requests queued and running on them,
+        and the requests completed and refused so far.
+    */
+    Json::Value
+    getJson() const;
+
+private:
+    void
+    processTask(int instance) override;
+
+    int const threads_;
+    std::size_t const queueLimit_;
+
+    std::mutex mutable mutex_;
+    std::condition_variable idle_;
+    std::deque<std::function<void()>> queue_;
+    std::size_t running_ = 0;
+    std::uint64_t completed_ = 0;
+    std::uint64_t rejected_ = 0;
+    bool stopped_ = false;
+
+    // Last, so the threads go before the state they use
+    Workers workers_;
+};
+
+}  // namespace ripple
+
+#endif
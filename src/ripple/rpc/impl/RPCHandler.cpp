@@ -24,12 +24,14 @@
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/reporting/P2pProxy.h>
 #include <ripple/basics/Log.h>
+#include <ripple/basics/PerfCost.h>
 #include <ripple/basics/PerfLog.h>
 #include <ripple/basics/contract.h>
 #include <ripple/core/Config.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/json/Object.h>
 #include <ripple/json/to_string.h>
+#include <ripple/ledger/CachedSLEs.h>
 #include <ripple/net/InfoSub.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/protocol/ErrorCodes.h>
@@ -39,6 +41,7 @@
 #include <ripple/rpc/RPCHandler.h>
 #include <ripple/rpc/Role.h>
 #include <ripple/rpc/impl/Handler.h>
+#include <ripple/rpc/impl/ResponseCache.h>
 #include <ripple/rpc/impl/Tuning.h>
 #include <atomic>
 #include <chrono>
@@ -190,16 +193,24 @@ callMethod(
     static std::atomic<std::uint64_t> requestId{0};
     auto& perfLog = context.app.getPerfLog();
     std::uint64_t const curId = ++requestId;
+    CachedSLEs::Scope const caller{CachedSLEs::Caller::rpc};
     try
     {
         perfLog.rpcStart(name, curId);
         auto v =
             context.app.getJobQueue().makeLoadEvent(jtGENERIC, "cmd:" + name);
 
+        perf::CostMeter const meter;
         auto start = std::chrono::system_clock::now();
         auto ret = method(context, result);
         auto end = std::chrono::system_clock::now();
 
+        // Charge for what the request used, if that's more than the
+        // handler asked for.
+        if (auto const measured = Resource::measuredRPC(meter.elapsed());
+            measured.cost() > context.loadType.cost())
+            context.loadType = measured;
+
         JLOG(context.j.debug())
             << "RPC call " << name << " completed in "
             << ((end - start).count() / 1000000000.0) << "seconds";
@@ -224,6 +235,33 @@ callMethod(
     }
 }
 
+// Call a method, unless the response cache holds its result
+template <class Method>
+Status
+callCachedMethod(
+    JsonContext& context,
+    Method method,
+    std::string const& name,
+    Json::Value& result)
+{
+    auto const cache = context.app.getRPCResponseCache();
+    auto const key = cache ? cache->key(context, name) : std::nullopt;
+    if (!key)
+        return callMethod(context, method, name, result);
+
+    auto const validated = context.ledgerMaster.getValidLedgerIndex();
+    if (auto const cached = cache->fetch(*key, validated))
+    {
+        result = *cached;
+        return rpcSUCCESS;
+    }
+
+    auto const ret = callMethod(context, method, name, result);
+    if (!ret && !result.isMember(jss::error))
+        cache->insert(*key, validated, result);
+    return ret;
+}
+
 }  // namespace
 
 void
@@ -273,7 +311,8 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
                 << ", user: " << context.headers.user
                 << ", forwarded for: " << context.headers.forwardedFor;
 
-            auto ret = callMethod(context, method, handler->name_, result);
+            auto ret =
+                callCachedMethod(context, method, handler->name_, result);
 
             JLOG(context.j.debug())
                 << "finish command: " << handler->name_
@@ -284,7 +323,8 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
         }
         else
         {
-            auto ret = callMethod(context, method, handler->name_, result);
+            auto ret =
+                callCachedMethod(context, method, handler->name_, result);
             injectReportingWarning(context, result);
             return ret;
         }
@@ -34,6 +34,7 @@
 #include <ripple/rpc/DeliveredAmount.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 #include <boost/algorithm/string/case_conv.hpp>
+#include <chrono>
 #include <regex>
 
 namespace ripple {
@@ -252,6 +253,7 @@ getAccountObjects(
         // directory entries
         return mlimit < limit;
     }
+    prefetchDirectory(ledger, root.key, *dir);
 
     std::uint32_t i = 0;
     for (;;)
@@ -310,6 +312,7 @@ getAccountObjects(
         dir = ledger.read({ltDIR_NODE, dirIndex});
         if (!dir)
             return true;
+        prefetchDirectory(ledger, root.key, *dir);
 
         if (i == mlimit)
         {
@@ -416,6 +419,12 @@ ledgerFromRequest<>(
     std::shared_ptr<ReadView const>&,
     GRPCContext<org::xrpl::rpc::v1::GetLedgerRequest>&);
 
+// explicit instantiation of above function
+template Status
+ledgerFromRequest<>(
+    std::shared_ptr<ReadView const>&,
+    GRPCContext<org::xrpl::rpc::v1::StreamLedgerDataRequest>&);
+
 template <class T>
 Status
 ledgerFromSpecifier(
@@ -475,10 +484,40 @@ ledgerFromSpecifier(
     return Status::OK;
 }
 
+namespace {
+
+// Adds the time until it goes out of scope to Context::ledgerTime
+class LedgerTimer
+{
+public:
+    explicit LedgerTimer(Context& context)
+        : context_(context), start_(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~LedgerTimer()
+    {
+        context_.ledgerTime +=
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start_);
+    }
+
+    LedgerTimer(LedgerTimer const&) = delete;
+    LedgerTimer&
+    operator=(LedgerTimer const&) = delete;
+
+private:
+    Context& context_;
+    std::chrono::steady_clock::time_point const start_;
+};
+
+}  // namespace
+
 template <class T>
 Status
 getLedger(T& ledger, uint256 const& ledgerHash, Context& context)
 {
+    LedgerTimer const timer{context};
     ledger = context.ledgerMaster.getLedgerByHash(ledgerHash);
     if (ledger == nullptr)
         return {rpcLGR_NOT_FOUND, "ledgerNotFound"};
@@ -489,6 +528,7 @@ template <class T>
 Status
 getLedger(T& ledger, uint32_t ledgerIndex, Context& context)
 {
+    LedgerTimer const timer{context};
     ledger = context.ledgerMaster.getLedgerBySeq(ledgerIndex);
     if (ledger == nullptr)
     {
@@ -520,6 +560,7 @@ template <class T>
 Status
 getLedger(T& ledger, LedgerShortcut shortcut, Context& context)
 {
+    LedgerTimer const timer{context};
     if (isValidatedOld(
             context.ledgerMaster,
             context.app.config().standalone() ||
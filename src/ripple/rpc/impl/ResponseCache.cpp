@@ -0,0 +1,222 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/main/Application.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/core/LexicalCast.h>
+#include <ripple/json/to_string.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/impl/ResponseCache.h>
+#include <ripple/rpc/impl/Tuning.h>
+#include <cstring>
+
+namespace ripple {
+namespace RPC {
+
+namespace {
+
+// Methods that take no ledger, whose results are kept until the next
+// validated ledger
+bool
+isLedgerless(std::string const& method)
+{
+    return method == "fee" || method == "server_info" ||
+        method == "server_state";
+}
+
+// An estimate of the bytes a value holds
+std::size_t
+bytesOf(Json::Value const& value)
+{
+    // Each member of an object or array costs a tree node besides its value
+    constexpr std::size_t nodeBytes = 48;
+
+    std::size_t bytes = sizeof(Json::Value);
+    switch (value.type())
+    {
+        case Json::stringValue:
+            bytes += std::strlen(value.asCString()) + 1;
+            break;
+        case Json::arrayValue:
+            for (auto const& v : value)
+                bytes += nodeBytes + bytesOf(v);
+            break;
+        case Json::objectValue:
+            for (auto it = value.begin(); it != value.end(); ++it)
+            {
+                bytes += nodeBytes + std::strlen(it.memberName()) + 1 +
+                    bytesOf(*it);
+            }
+            break;
+        default:
+            break;
+    }
+    return bytes;
+}
+
+}  // namespace
+
+ResponseCache::ResponseCache(
+    std::size_t bytes,
+    std::set<std::string> methods,
+    beast::Journal journal)
+    : methods_(std::move(methods))
+    , cache_(
+          "RPCResponses",
+          0,
+          Tuning::responseCacheAge,
+          stopwatch(),
+          journal)
+{
+    cache_.setTargetBytes(bytes);
+}
+
+std::optional<uint256>
+ResponseCache::key(JsonContext const& context, std::string const& method)
+    const
+{
+    if (methods_.count(method) == 0)
+        return std::nullopt;
+
+    auto& ledgerMaster = context.ledgerMaster;
+    auto const& params = context.params;
+    bool const reporting = context.app.config().reporting();
+
+    // The ledger the request resolves to, found the way ledgerFromRequest
+    // finds it. Numbered ledgers the server has validated can not change,
+    // so they are named by their sequence.
+    std::string ledger;
+    if (isLedgerless(method))
+    {
+        auto const validated = ledgerMaster.getValidatedLedger();
+        if (!validated)
+            return std::nullopt;
+        ledger = to_string(validated->info().hash);
+    }
+    else
+    {
+        if (params.isMember(jss::ledger))
+            return std::nullopt;
+
+        if (params.isMember(jss::ledger_hash))
+        {
+            auto const& hash = params[jss::ledger_hash];
+            if (!hash.isString())
+                return std::nullopt;
+            uint256 ledgerHash;
+            if (!ledgerHash.parseHex(hash.asString()))
+                return std::nullopt;
+            ledger = to_string(ledgerHash);
+        }
+        else
+        {
+            auto const index = params[jss::ledger_index].asString();
+            std::uint32_t seq = 0;
+            if (index == "validated" || (index.empty() && reporting))
+            {
+                auto const validated = ledgerMaster.getValidatedLedger();
+                if (!validated)
+                    return std::nullopt;
+                ledger = to_string(validated->info().hash);
+            }
+            else if (index == "closed" && !reporting)
+            {
+                auto const closed = ledgerMaster.getClosedLedger();
+                if (!closed)
+                    return std::nullopt;
+                ledger = to_string(closed->info().hash);
+            }
+            else if (
+                beast::lexicalCastChecked(seq, index) &&
+                seq <= ledgerMaster.getValidLedgerIndex())
+            {
+                ledger = std::to_string(seq);
+            }
+            else
+            {
+                // The current ledger, or one that may still change
+                return std::nullopt;
+            }
+        }
+    }
+
+    // The members of an object are ordered by name, so the same parameters
+    // always give the same text. Those naming the request are left out.
+    Json::Value request = params;
+    request.removeMember(jss::id);
+    request.removeMember(jss::command);
+    request.removeMember(jss::method);
+    request.removeMember(jss::api_version);
+
+    return sha512Half(
+        method,
+        context.apiVersion,
+        static_cast<int>(context.role),
+        ledger,
+        to_string(request));
+}
+
+std::shared_ptr<Json::Value const>
+ResponseCache::fetch(uint256 const& key, LedgerIndex validated)
+{
+    if (auto const entry = cache_.fetch(key, validated))
+        return {entry, &entry->result};
+    return {};
+}
+
+void
+ResponseCache::insert(
+    uint256 const& key,
+    LedgerIndex validated,
+    Json::Value result)
+{
+    auto entry = std::make_shared<Entry>();
+    entry->bytes = sizeof(Entry) + bytesOf(result);
+    entry->result = std::move(result);
+    cache_.canonicalize_replace_client(key, entry, validated);
+}
+
+void
+ResponseCache::sweep()
+{
+    cache_.sweep();
+}
+
+std::size_t
+ResponseCache::size() const
+{
+    return cache_.size();
+}
+
+std::size_t
+ResponseCache::bytes() const
+{
+    return cache_.getCacheBytes();
+}
+
+float
+ResponseCache::getHitRate()
+{
+    return cache_.getHitRate();
+}
+
+}  // namespace RPC
+}  // namespace ripple
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_RESPONSECACHE_H_INCLUDED
+#define RIPPLE_RPC_RESPONSECACHE_H_INCLUDED
+
+#include <ripple/basics/TaggedCache.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/json/json_value.h>
+#include <ripple/protocol/Protocol.h>
+#include <ripple/rpc/Context.h>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+
+namespace ripple {
+namespace RPC {
+
+/** Keeps the results of read-only RPC commands, to answer repeats.
+
+    Most read-only methods asked about a ledger that can not change give
+    the same result each time they are asked. Clients polling the same
+    accounts or books ask the same thing over and over, so the results of
+    the methods chosen in the configuration are kept, by the method, its
+    parameters, the API version, the role of the client and the ledger
+    the request resolves to.
+
+    Requests for the "current" ledger are never kept, since it changes
+    with every transaction applied to it. Requests for the "validated" or
+    "closed" ledger are keyed by the hash of that ledger, so once it
+    advances they miss and are answered again. Methods that take no ledger
+    at all, such as fee or server_info, are kept until the next validated
+    ledger.
+
+    Only successful results are kept. Once the cache is over its budget,
+    the results cached while the oldest validated ledgers were current are
+    the first to go.
+*/
+class ResponseCache
+{
+public:
+    /** Create the cache.
+
+        @param bytes The number of bytes the results may hold.
+        @param methods The methods whose results may be kept.
+        @param journal Where to log.
+    */
+    ResponseCache(
+        std::size_t bytes,
+        std::set<std::string> methods,
+        beast::Journal journal);
+
+    /** The key of a request, or nothing if its result must not be kept.
+
+        @param context The request.
+        @param method The name of the method the request calls.
+    */
+    std::optional<uint256>
+    key(JsonContext const& context, std::string const& method) const;
+
+    /** The kept result of a request, if any. */
+    std::shared_ptr<Json::Value const>
+    fetch(uint256 const& key, LedgerIndex validated);
+
+    /** Keep the result of a request. */
+    void
+    insert(uint256 const& key, LedgerIndex validated, Json::Value result);
+
+    /** Drop the results that are too old, or over the budget. */
+    void
+    sweep();
+
+    /** The number of results kept. */
+    std::size_t
+    size() const;
+
+    /** The number of bytes the kept results hold. */
+    std::size_t
+    bytes() const;
+
+    /** The fraction of fetches that found a result. */
+    float
+    getHitRate();
+
+private:
+    struct Entry
+    {
+        Json::Value result;
+        std::size_t bytes = 0;
+
+        std::size_t
+        memoryUsage() const
+        {
+            return bytes;
+        }
+    };
+
+    std::set<std::string> const methods_;
+    TaggedCache<uint256, Entry> cache_;
+};
+
+}  // namespace RPC
+}  // namespace ripple
+
+#endif
@@ -45,13 +45,61 @@
 #include <ripple/server/SimpleWriter.h>
 #include <ripple/server/impl/JSONRPCUtil.h>
 #include <boost/algorithm/string.hpp>
+#include <boost/asio/buffers_iterator.hpp>
 #include <boost/beast/http/fields.hpp>
 #include <boost/beast/http/string_body.hpp>
 #include <algorithm>
+#include <chrono>
 #include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace ripple {
 
+// Only ripple_path_find suspends its handler, while it waits for the path
+// finding engine, so only it needs the stack of a JobQueue::Coro. Every
+// other request runs as a plain job, which costs no stack of its own and
+// no switching between stacks.
+static std::string_view const suspendingMethod = "ripple_path_find";
+
+static bool
+needsCoro(Json::Value const& request)
+{
+    for (auto const& field : {jss::command, jss::method})
+    {
+        if (request.isMember(field) && request[field].isString() &&
+            request[field].asString() == suspendingMethod)
+            return true;
+    }
+    return false;
+}
+
+// The body has not been parsed yet, so look for the method anywhere in it.
+// A false match only costs the request a coroutine it does not need.
+static bool
+needsCoro(http_request_type const& request)
+{
+    auto const data = request.body().data();
+    auto const begin = boost::asio::buffers_begin(data);
+    auto const end = boost::asio::buffers_end(data);
+    return std::search(
+               begin, end, suspendingMethod.begin(), suspendingMethod.end()) !=
+        end;
+}
+
+// The method a request names, or an empty string if it names none
+static std::string
+requestMethod(Json::Value const& request)
+{
+    for (auto const& field : {jss::command, jss::method})
+    {
+        if (request.isMember(field) && request[field].isString())
+            return request[field].asString();
+    }
+    return {};
+}
+
 static bool
 isStatusRequest(http_request_type const& request)
 {
@@ -60,6 +108,13 @@ isStatusRequest(http_request_type const& request)
         request.method() == boost::beast::http::verb::get;
 }
 
+static bool
+isMetricsRequest(http_request_type const& request)
+{
+    return request.target() == "/metrics" &&
+        request.method() == boost::beast::http::verb::get;
+}
+
 static Handoff
 statusRequestResponse(
     http_request_type const& request,
@@ -114,11 +169,16 @@ ServerHandler::ServerHandler(
     , m_networkOPs(networkOPs)
     , m_server(make_Server(*this, io_service, app_.journal("Server")))
     , m_jobQueue(jobQueue)
+    , collectorManager_(cm)
 {
     auto const& group(cm.group("rpc"));
     rpc_requests_ = group->make_counter("requests");
     rpc_size_ = group->make_event("size");
     rpc_time_ = group->make_event("time");
+    rpc_queue_time_ = group->make_event("queue_time");
+    rpc_ledger_time_ = group->make_event("ledger_time");
+    rpc_handler_time_ = group->make_event("handler_time");
+    rpc_serialize_time_ = group->make_event("serialize_time");
 }
 
 ServerHandler::~ServerHandler()
@@ -130,9 +190,21 @@ void
 ServerHandler::setup(Setup const& setup, beast::Journal journal)
 {
     setup_ = setup;
+    for (auto const& port : setup_.ports)
+    {
+        if (port.workers != 0)
+            workers_[port.name] = std::make_unique<PortWorkers>(
+                port.name, port.workers, port.worker_queue_limit);
+    }
     m_server->ports(setup.ports);
 }
 
+void
+ServerHandler::setPeerIO(std::function<boost::asio::io_context&()> peerIO)
+{
+    m_server->setPeerIO(std::move(peerIO));
+}
+
 //------------------------------------------------------------------------------
 
 void
@@ -143,6 +215,41 @@ ServerHandler::stop()
         std::unique_lock lock(mutex_);
         condition_.wait(lock, [this] { return stopped_; });
     }
+    for (auto& [_, workers] : workers_)
+        workers->stop();
+}
+
+void
+ServerHandler::recordTimes(
+    std::string const& method,
+    perf::PerfLog::RpcTimes const& times)
+{
+    rpc_queue_time_.notify(times.queue);
+    rpc_ledger_time_.notify(times.ledger);
+    rpc_handler_time_.notify(times.handler);
+    rpc_serialize_time_.notify(times.serialize);
+    app_.getPerfLog().rpcTimes(method, times);
+}
+
+Json::Value
+ServerHandler::getWorkersJson(Port const& port) const
+{
+    auto const it = workers_.find(port.name);
+    if (it == workers_.end())
+        return Json::nullValue;
+    return it->second->getJson();
+}
+
+bool
+ServerHandler::postRequest(
+    Port const& port,
+    JobType type,
+    std::string const& name,
+    std::function<void()> request)
+{
+    if (auto const it = workers_.find(port.name); it != workers_.end())
+        return it->second->post(std::move(request));
+    return m_jobQueue.addJob(type, name, std::move(request));
 }
 
 //------------------------------------------------------------------------------
@@ -229,6 +336,10 @@ ServerHandler::onHandoff(
     if (is_ws && isStatusRequest(request))
         return statusResponse(request);
 
+    if ((p.count("http") > 0 || p.count("https") > 0) &&
+        isMetricsRequest(request))
+        return metricsResponse(session.port(), request, remote_address);
+
     // Otherwise pass to legacy onRequest or websocket
     return {};
 }
@@ -292,15 +403,32 @@ ServerHandler::onRequest(Session& session)
     }
 
     std::shared_ptr<Session> detachedSession = session.detach();
-    auto const postResult = m_jobQueue.postCoro(
-        jtCLIENT_RPC,
-        "RPC-Client",
-        [this, detachedSession](std::shared_ptr<JobQueue::Coro> coro) {
-            processSession(detachedSession, coro);
-        });
-    if (postResult == nullptr)
+    auto const received = clock_type::now();
+    bool posted;
+    if (needsCoro(detachedSession->request()))
     {
-        // The coroutine was rejected, probably because we're shutting down.
+        posted = m_jobQueue.postCoro(
+                     jtCLIENT_RPC,
+                     "RPC-Client",
+                     [this, detachedSession, received](
+                         std::shared_ptr<JobQueue::Coro> coro) {
+                         processSession(detachedSession, coro, received);
+                     }) != nullptr;
+    }
+    else
+    {
+        posted = postRequest(
+            detachedSession->port(),
+            jtCLIENT_RPC,
+            "RPC-Client",
+            [this, detachedSession, received]() {
+                processSession(detachedSession, nullptr, received);
+            });
+    }
+    if (!posted)
+    {
+        // The request was rejected, because we're shutting down or the
+        // threads of the port are backed up.
         HTTPReply(
             503,
             "Service Unavailable",
@@ -316,6 +444,7 @@ ServerHandler::onWSMessage(
     std::shared_ptr<WSSession> session,
     std::vector<boost::asio::const_buffer> const& buffers)
 {
+    auto const received = clock_type::now();
     Json::Value jv;
     auto const size = boost::asio::buffer_size(buffers);
     if (size > RPC::Tuning::maxRequestSize ||
@@ -339,25 +468,52 @@ ServerHandler::onWSMessage(
 
     JLOG(m_journal.trace()) << "Websocket received '" << jv << "'";
 
-    auto const postResult = m_jobQueue.postCoro(
-        jtCLIENT_WEBSOCKET,
-        "WS-Client",
-        [this, session, jv = std::move(jv)](
-            std::shared_ptr<JobQueue::Coro> const& coro) {
-            auto const jr = this->processSession(session, coro, jv);
-            auto const s = to_string(jr);
-            auto const n = s.length();
-            boost::beast::multi_buffer sb(n);
-            sb.commit(boost::asio::buffer_copy(
-                sb.prepare(n), boost::asio::buffer(s.c_str(), n)));
-            session->send(
-                std::make_shared<StreambufWSMsg<decltype(sb)>>(std::move(sb)));
-            session->complete();
-        });
-    if (postResult == nullptr)
+    bool const suspends = needsCoro(jv);
+    auto process = [this, session, received, jv = std::move(jv)](
+                       std::shared_ptr<JobQueue::Coro> const& coro) {
+        using namespace std::chrono;
+        perf::PerfLog::RpcTimes times;
+        times.queue = duration_cast<microseconds>(clock_type::now() - received);
+        auto const jr = this->processSession(session, coro, jv, times);
+        auto const serializing = clock_type::now();
+        auto const s = to_string(jr);
+        times.serialize =
+            duration_cast<microseconds>(clock_type::now() - serializing);
+        auto const n = s.length();
+        boost::beast::multi_buffer sb(n);
+        sb.commit(boost::asio::buffer_copy(
+            sb.prepare(n), boost::asio::buffer(s.c_str(), n)));
+        recordTimes(requestMethod(jv), times);
+        session->send(
+            std::make_shared<StreambufWSMsg<decltype(sb)>>(std::move(sb)));
+        session->complete();
+    };
+
+    bool posted;
+    if (suspends)
+    {
+        posted = m_jobQueue.postCoro(
+                     jtCLIENT_WEBSOCKET, "WS-Client", std::move(process)) !=
+            nullptr;
+    }
+    else
     {
-        // The coroutine was rejected, probably because we're shutting down.
-        session->close({boost::beast::websocket::going_away, "Shutting Down"});
+        posted = postRequest(
+            session->port(),
+            jtCLIENT_WEBSOCKET,
+            "WS-Client",
+            [process = std::move(process)]() { process(nullptr); });
+    }
+    if (!posted)
+    {
+        // The request was rejected, because we're shutting down or the
+        // threads of the port are backed up.
+        if (workers_.count(session->port().name) != 0)
+            session->close(
+                {boost::beast::websocket::try_again_later, "Server Busy"});
+        else
+            session->close(
+                {boost::beast::websocket::going_away, "Shutting Down"});
     }
 }
 
@@ -401,7 +557,8 @@ Json::Value
 ServerHandler::processSession(
     std::shared_ptr<WSSession> const& session,
     std::shared_ptr<JobQueue::Coro> const& coro,
-    Json::Value const& jv)
+    Json::Value const& jv,
+    perf::PerfLog::RpcTimes& times)
 {
     auto is = std::static_pointer_cast<WSInfoSub>(session->appDefined);
     if (is->getConsumer().disconnect(m_journal))
@@ -482,6 +639,11 @@ ServerHandler::processSession(
             RPC::doCommand(context, jr[jss::result]);
             auto end = std::chrono::system_clock::now();
             logDuration(jv, end - start, m_journal);
+            times.ledger = context.ledgerTime;
+            times.handler =
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    end - start) -
+                context.ledgerTime;
         }
     }
     catch (std::exception const& ex)
@@ -543,11 +705,12 @@ ServerHandler::processSession(
     return jr;
 }
 
-// Run as a coroutine.
+// Run as a job, or as a coroutine if the request may suspend.
 void
 ServerHandler::processSession(
     std::shared_ptr<Session> const& session,
-    std::shared_ptr<JobQueue::Coro> coro)
+    std::shared_ptr<JobQueue::Coro> coro,
+    clock_type::time_point received)
 {
     processRequest(
         session->port(),
@@ -561,7 +724,8 @@ ServerHandler::processSession(
             if (iter != session->request().end())
                 return iter->value();
             return boost::beast::string_view{};
-        }());
+        }(),
+        received);
 
     if (beast::rfc2616::is_keep_alive(session->request()))
         session->complete();
@@ -593,8 +757,12 @@ ServerHandler::processRequest(
     Output&& output,
     std::shared_ptr<JobQueue::Coro> coro,
     boost::string_view forwardedFor,
-    boost::string_view user)
+    boost::string_view user,
+    clock_type::time_point received)
 {
+    using namespace std::chrono;
+    auto const queued =
+        duration_cast<microseconds>(clock_type::now() - received);
     auto rpcJ = app_.journal("RPC");
 
     Json::Value jsonOrig;
@@ -627,6 +795,7 @@ ServerHandler::processRequest(
     }
 
     Json::Value reply(batch ? Json::arrayValue : Json::objectValue);
+    std::vector<std::pair<std::string, perf::PerfLog::RpcTimes>> calls;
     auto const start(std::chrono::high_resolution_clock::now());
     for (unsigned i = 0; i < size; ++i)
     {
@@ -892,6 +1061,12 @@ ServerHandler::processRequest(
         auto end = std::chrono::system_clock::now();
 
         logDuration(params, end - start, m_journal);
+        calls.emplace_back(
+            strMethod,
+            perf::PerfLog::RpcTimes{
+                queued,
+                context.ledgerTime,
+                duration_cast<microseconds>(end - start) - context.ledgerTime});
 
         usage.charge(loadType);
         if (usage.warn())
@@ -994,8 +1169,22 @@ ServerHandler::processRequest(
         return 200;
     }();
 
+    auto const serializing = clock_type::now();
     auto response = to_string(reply);
 
+    // The calls of a batch share the one response
+    if (!calls.empty())
+    {
+        auto const serialize =
+            duration_cast<microseconds>(clock_type::now() - serializing) /
+            static_cast<int>(calls.size());
+        for (auto& [method, times] : calls)
+        {
+            times.serialize = serialize;
+            recordTimes(method, times);
+        }
+    }
+
     rpc_time_.notify(std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::high_resolution_clock::now() - start));
     ++rpc_requests_;
@@ -1051,6 +1240,36 @@ ServerHandler::statusResponse(http_request_type const& request) const
     return handoff;
 }
 
+Handoff
+ServerHandler::metricsResponse(
+    Port const& port,
+    http_request_type const& request,
+    boost::asio::ip::tcp::endpoint const& remote_address) const
+{
+    using namespace boost::beast::http;
+    auto const remote =
+        beast::IPAddressConversion::from_asio(remote_address).address();
+    if (!ipAllowed(remote, port.admin_nets_v4, port.admin_nets_v6) ||
+        !authorized(port, build_map(request)))
+        return statusRequestResponse(request, status::forbidden);
+
+    auto body = collectorManager_.metrics();
+    if (!body)
+        return statusRequestResponse(request, status::not_found);
+
+    Handoff handoff;
+    response<string_body> msg;
+    msg.version(request.version());
+    msg.result(status::ok);
+    msg.insert("Server", BuildInfo::getFullVersionString());
+    msg.insert("Content-Type", "text/plain; version=0.0.4");
+    msg.insert("Connection", "close");
+    msg.body() = std::move(*body);
+    msg.prepare_payload();
+    handoff.response = std::make_shared<SimpleWriter>(msg);
+    return handoff;
+}
+
 //------------------------------------------------------------------------------
 
 void
@@ -1116,6 +1335,8 @@ to_Port(ParsedPort const& parsed, std::ostream& log)
     p.ssl_ciphers = parsed.ssl_ciphers;
     p.pmd_options = parsed.pmd_options;
     p.ws_queue_limit = parsed.ws_queue_limit;
+    p.workers = parsed.workers;
+    p.worker_queue_limit = parsed.worker_queue_limit;
     p.limit = parsed.limit;
     p.admin_nets_v4 = parsed.admin_nets_v4;
     p.admin_nets_v6 = parsed.admin_nets_v6;
@@ -65,6 +65,9 @@ static int constexpr maxJobQueueClients = 500;
 auto constexpr maxValidatedLedgerAge = std::chrono::minutes{2};
 static int constexpr maxRequestSize = 1000000;
 
+/** How long a result kept by the response cache may go unused. */
+auto constexpr responseCacheAge = std::chrono::minutes{1};
+
 /** Maximum number of pages in one response from a binary LedgerData request. */
 static int constexpr binaryPageLength = 2048;
 
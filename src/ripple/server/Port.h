@@ -75,6 +75,14 @@ struct Port
     // Websocket disconnects if send queue exceeds this limit
     std::uint16_t ws_queue_limit;
 
+    // Threads serving the requests on this port alone, where 0 means
+    // they share the job queue with every other port.
+    std::uint16_t workers = 0;
+
+    // Requests that may wait for those threads before more are refused,
+    // where 0 means unlimited.
+    std::uint16_t worker_queue_limit = 0;
+
     // Returns `true` if any websocket protocols are specified
     bool
     websockets() const;
@@ -110,6 +118,8 @@ struct ParsedPort
     boost::beast::websocket::permessage_deflate pmd_options;
     int limit = 0;
     std::uint16_t ws_queue_limit;
+    std::uint16_t workers = 0;
+    std::uint16_t worker_queue_limit = 0;
 
     std::optional<boost::asio::ip::address> ip;
     std::optional<std::uint16_t> port;
@@ -94,6 +94,7 @@ private:
     Port const& port_;
     Handler& handler_;
     boost::asio::io_context& ioc_;
+    std::function<boost::asio::io_context&()> const peerIO_;
     acceptor_type acceptor_;
     boost::asio::io_context::strand strand_;
     bool ssl_;
@@ -103,11 +104,18 @@ private:
     reOpen();
 
 public:
+    /** Create a Door.
+
+        @param peerIO If set, where connections accepted on a port serving
+                      the peer protocol run. Otherwise they run on
+                      `io_context`, like all other connections.
+    */
     Door(
         Handler& handler,
         boost::asio::io_context& io_context,
         Port const& port,
-        beast::Journal j);
+        beast::Journal j,
+        std::function<boost::asio::io_context&()> peerIO = {});
 
     // Work-around because we can't call shared_from_this in ctor
     void
@@ -134,6 +142,7 @@ private:
     create(
         bool ssl,
         ConstBufferSequence const& buffers,
+        boost::asio::io_context& ioc,
         stream_type&& stream,
         endpoint_type remote_address);
 
@@ -285,11 +294,13 @@ Door<Handler>::Door(
     Handler& handler,
     boost::asio::io_context& io_context,
     Port const& port,
-    beast::Journal j)
+    beast::Journal j,
+    std::function<boost::asio::io_context&()> peerIO)
     : j_(j)
     , port_(port)
     , handler_(handler)
     , ioc_(io_context)
+    , peerIO_(port_.protocol.count("peer") > 0 ? std::move(peerIO) : nullptr)
     , acceptor_(io_context)
     , strand_(io_context)
     , ssl_(
@@ -334,6 +345,7 @@ void
 Door<Handler>::create(
     bool ssl,
     ConstBufferSequence const& buffers,
+    boost::asio::io_context& ioc,
     stream_type&& stream,
     endpoint_type remote_address)
 {
@@ -342,7 +354,7 @@ Door<Handler>::create(
         if (auto sp = ios().template emplace<SSLHTTPPeer<Handler>>(
                 port_,
                 handler_,
-                ioc_,
+                ioc,
                 j_,
                 remote_address,
                 buffers,
@@ -353,7 +365,7 @@ Door<Handler>::create(
     if (auto sp = ios().template emplace<PlainHTTPPeer<Handler>>(
             port_,
             handler_,
-            ioc_,
+            ioc,
             j_,
             remote_address,
             buffers,
@@ -369,7 +381,9 @@ Door<Handler>::do_accept(boost::asio::yield_context do_yield)
     {
         error_code ec;
         endpoint_type remote_address;
-        stream_type stream(ioc_);
+        // The connection runs wherever its socket was opened
+        auto& ioc = peerIO_ ? peerIO_() : ioc_;
+        stream_type stream(ioc);
         socket_type& socket = stream.socket();
         acceptor_.async_accept(socket, remote_address, do_yield[ec]);
         if (ec)
@@ -390,7 +404,7 @@ Door<Handler>::do_accept(boost::asio::yield_context do_yield)
             if (auto sp = ios().template emplace<Detector>(
                     port_,
                     handler_,
-                    ioc_,
+                    ioc,
                     std::move(stream),
                     remote_address,
                     j_))
@@ -401,6 +415,7 @@ Door<Handler>::do_accept(boost::asio::yield_context do_yield)
             create(
                 ssl_,
                 boost::asio::null_buffers{},
+                ioc,
                 std::move(stream),
                 remote_address);
         }
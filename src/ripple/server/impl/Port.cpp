@@ -23,7 +23,9 @@
 #include <ripple/server/Port.h>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/trim.hpp>
+#include <boost/version.hpp>
 #include <sstream>
+#include <utility>
 
 namespace ripple {
 
@@ -292,6 +294,25 @@ parse_Port(ParsedPort& port, Section const& section, std::ostream& log)
         }
     }
 
+    for (auto [value, key] :
+         {std::make_pair(&port.workers, "workers"),
+          std::make_pair(&port.worker_queue_limit, "worker_queue_limit")})
+    {
+        if (auto const optResult = section.get(key))
+        {
+            try
+            {
+                *value = beast::lexicalCastThrow<std::uint16_t>(*optResult);
+            }
+            catch (std::exception const&)
+            {
+                log << "Invalid value '" << *optResult << "' for key '" << key
+                    << "' in [" << section.name() << "]";
+                Rethrow();
+            }
+        }
+    }
+
     populate(section, "admin", log, port.admin_nets_v4, port.admin_nets_v6);
     populate(
         section,
@@ -321,6 +342,12 @@ parse_Port(ParsedPort& port, Section const& section, std::ostream& log)
         section.value_or("server_no_context_takeover", false);
     port.pmd_options.compLevel = section.value_or("compress_level", 8);
     port.pmd_options.memLevel = section.value_or("memory_level", 4);
+#if BOOST_VERSION >= 108200
+    // Small messages, like most stream updates, gain little from deflate
+    // but cost as much CPU per frame to compress.
+    port.pmd_options.msg_size_threshold =
+        section.value_or<std::size_t>("compress_threshold", 256);
+#endif
 }
 
 }  // namespace ripple
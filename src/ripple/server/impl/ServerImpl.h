@@ -27,7 +27,9 @@
 #include <ripple/server/impl/io_list.h>
 #include <boost/asio.hpp>
 #include <array>
+#include <cassert>
 #include <chrono>
+#include <functional>
 #include <mutex>
 #include <optional>
 
@@ -60,6 +62,15 @@ public:
     virtual Endpoints
     ports(std::vector<Port> const& v) = 0;
 
+    /** Set where connections accepted on peer protocol ports run.
+        By default all connections run on the server's io_service. The
+        function is called once for each connection accepted on a port
+        serving the peer protocol, and must outlive the server's ports.
+        This may only be called before ports().
+    */
+    virtual void
+    setPeerIO(std::function<boost::asio::io_context&()> peerIO) = 0;
+
     /** Close the server.
         The close is performed asynchronously. The handler will be notified
         when the server has stopped. The server is considered stopped when
@@ -89,6 +100,7 @@ private:
     std::mutex m_;
     std::vector<Port> ports_;
     std::vector<std::weak_ptr<Door<Handler>>> list_;
+    std::function<boost::asio::io_context&()> peerIO_;
     int high_ = 0;
     std::array<std::size_t, 64> hist_;
 
@@ -111,6 +123,13 @@ public:
     Endpoints
     ports(std::vector<Port> const& ports) override;
 
+    void
+    setPeerIO(std::function<boost::asio::io_context&()> peerIO) override
+    {
+        assert(ports_.empty());
+        peerIO_ = std::move(peerIO);
+    }
+
     void
     close() override;
 
@@ -169,7 +188,7 @@ ServerImpl<Handler>::ports(std::vector<Port> const& ports)
     {
         ports_.push_back(port);
         if (auto sp = ios_.emplace<Door<Handler>>(
-                handler_, io_service_, ports_.back(), j_))
+                handler_, io_service_, ports_.back(), j_, peerIO_))
         {
             list_.push_back(sp);
             eps.push_back(sp->get_endpoint());
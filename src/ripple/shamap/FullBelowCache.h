@@ -20,31 +20,98 @@
 #ifndef RIPPLE_SHAMAP_FULLBELOWCACHE_H_INCLUDED
 #define RIPPLE_SHAMAP_FULLBELOWCACHE_H_INCLUDED
 
-#include <ripple/basics/KeyCache.h>
-#include <ripple/basics/TaggedCache.h>
 #include <ripple/basics/base_uint.h>
-#include <ripple/beast/insight/Collector.h>
+#include <ripple/basics/hardened_hash.h>
+#include <ripple/beast/clock/abstract_clock.h>
+#include <ripple/beast/insight/Insight.h>
 #include <ripple/beast/utility/Journal.h>
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace ripple {
 
 namespace detail {
 
+/** An open addressing set of node hashes.
+
+    Keys are stored inline with linear probing, so an entry costs its 32
+    bytes plus the table's slack. A zero hash marks an empty slot; no
+    node hashes to zero.
+
+    Thread safety:
+        Not thread safe; the owner provides the locking.
+*/
+class FullBelowSet
+{
+public:
+    using hasher = digest_hash;
+
+    explicit FullBelowSet(hasher const& hash) : hash_(hash)
+    {
+    }
+
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /** @return `true` If the key was in the set. */
+    bool
+    contains(uint256 const& key, std::size_t hash) const;
+
+    /** @return `true` If the key was not in the set already. */
+    bool
+    insert(uint256 const& key, std::size_t hash);
+
+    /** @return `true` If the key was in the set. */
+    bool
+    erase(uint256 const& key, std::size_t hash);
+
+    void
+    clear();
+
+    void
+    swap(FullBelowSet& other) noexcept;
+
+private:
+    std::size_t
+    find(uint256 const& key, std::size_t hash) const;
+
+    void
+    grow();
+
+    hasher hash_;
+    std::vector<uint256> slots_;
+    std::size_t size_ = 0;
+};
+
 /** Remembers which tree keys have all descendants resident.
     This optimizes the process of acquiring a complete tree.
+
+    Inner nodes carry a mark of their own (see
+    SHAMapInnerNode::isFullBelow), so this is only consulted for nodes
+    that are not in memory. The keys are spread over partitions with a
+    lock each, and every partition holds a recent and an older set. Every
+    half expiration period, a sweep drops the older set and the recent
+    one takes its place; a key found in the older set moves back to the
+    recent one. So a key that is not used for the expiration time is
+    forgotten, possibly after only half of it, without keeping a time
+    stamp per key.
 */
 class BasicFullBelowCache
 {
-private:
-    using CacheType = KeyCache;
-
 public:
     enum { defaultCacheTargetSize = 0 };
 
     using key_type = uint256;
-    using clock_type = typename CacheType::clock_type;
+    using clock_type = beast::abstract_clock<std::chrono::steady_clock>;
 
     /** Construct the cache.
 
@@ -60,16 +127,13 @@ public:
         beast::insight::Collector::ptr const& collector =
             beast::insight::NullCollector::New(),
         std::size_t target_size = defaultCacheTargetSize,
-        std::chrono::seconds expiration = std::chrono::minutes{2})
-        : m_cache(name, target_size, expiration, clock, j, collector), m_gen(1)
-    {
-    }
+        std::chrono::seconds expiration = std::chrono::minutes{2});
 
     /** Return the clock associated with the cache. */
     clock_type&
     clock()
     {
-        return m_cache.clock();
+        return clock_;
     }
 
     /** Return the number of elements in the cache.
@@ -77,20 +141,14 @@ public:
             Safe to call from any thread.
     */
     std::size_t
-    size() const
-    {
-        return m_cache.size();
-    }
+    size() const;
 
     /** Remove expired cache items.
         Thread safety:
             Safe to call from any thread.
     */
     void
-    sweep()
-    {
-        m_cache.sweep();
-    }
+    sweep();
 
     /** Refresh the last access time of an item, if it exists.
         Thread safety:
@@ -99,10 +157,7 @@ public:
         @return `true` If the key exists.
     */
     bool
-    touch_if_exists(key_type const& key)
-    {
-        return m_cache.touch_if_exists(key);
-    }
+    touch_if_exists(key_type const& key);
 
     /** Insert a key into the cache.
         If the key already exists, the last access time will still
@@ -112,10 +167,7 @@ public:
         @param key The key to insert.
     */
     void
-    insert(key_type const& key)
-    {
-        m_cache.insert(key);
-    }
+    insert(key_type const& key);
 
     /** generation determines whether cached entry is valid */
     std::uint32_t
@@ -125,21 +177,56 @@ public:
     }
 
     void
-    clear()
-    {
-        m_cache.clear();
-        ++m_gen;
-    }
+    clear();
 
     void
-    reset()
+    reset();
+
+private:
+    static constexpr std::size_t partitionCount = 16;
+
+    struct Partition
+    {
+        explicit Partition(FullBelowSet::hasher const& hash)
+            : recent(hash), older(hash)
+        {
+        }
+
+        std::mutex mutex;
+        FullBelowSet recent;
+        FullBelowSet older;
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+    };
+
+    Partition&
+    partition(std::size_t hash)
     {
-        m_cache.clear();
-        m_gen = 1;
+        return *partitions_[(hash >> 32) % partitionCount];
     }
 
-private:
-    CacheType m_cache;
+    void
+    clearPartitions();
+
+    void
+    collect_metrics();
+
+    beast::Journal const j_;
+    clock_type& clock_;
+    std::string const name_;
+    std::size_t const targetSize_;
+    clock_type::duration const sweepPeriod_;
+
+    FullBelowSet::hasher const hash_;
+    std::array<std::unique_ptr<Partition>, partitionCount> partitions_;
+
+    std::mutex sweepMutex_;
+    std::optional<clock_type::time_point> lastRotation_;
+
+    beast::insight::Hook hook_;
+    beast::insight::Gauge sizeGauge_;
+    beast::insight::Gauge hitRateGauge_;
+
     std::atomic<std::uint32_t> m_gen;
 };
 
@@ -33,8 +33,12 @@
 #include <ripple/shamap/SHAMapMissingNode.h>
 #include <ripple/shamap/SHAMapTreeNode.h>
 #include <ripple/shamap/TreeNodeCache.h>
+#include <atomic>
 #include <cassert>
+#include <span>
 #include <stack>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 namespace ripple {
@@ -104,12 +108,15 @@ private:
     /** The sequence of the ledger that this map references, if any. */
     std::uint32_t ledgerSeq_ = 0;
 
-    std::shared_ptr<SHAMapTreeNode> root_;
+    SharedIntrusive<SHAMapTreeNode> root_;
     mutable SHAMapState state_;
     SHAMapType const type_;
     bool backed_ = true;         // Map is backed by the database
     mutable bool full_ = false;  // Map is believed complete in database
 
+    /** Where this map's items come from, if not the usual allocator. */
+    boost::intrusive_ptr<SHAMapItemArena> arena_;
+
 public:
     /** Number of children each non-leaf node has (the 'radix tree' part of the
      * map) */
@@ -159,8 +166,16 @@ public:
     */
     class const_iterator;
 
+    /** Return an iterator to the first item.
+
+        @param readAhead How many following sibling subtrees to request
+                         from the node store, without waiting, each time
+                         the iterator descends into a subtree. Reads for
+                         nodes that aren't in memory then overlap with the
+                         scan instead of happening one at a time.
+    */
     const_iterator
-    begin() const;
+    begin(int readAhead = 0) const;
     const_iterator
     end() const;
 
@@ -221,11 +236,13 @@ public:
     /** Find the first item after the given item.
 
         @param id the identifier of the item.
+        @param readAhead How many sibling subtrees to prefetch as the
+                         iterator advances, as with begin().
 
         @note The item does not need to exist.
      */
     const_iterator
-    upper_bound(uint256 const& id) const;
+    upper_bound(uint256 const& id, int readAhead = 0) const;
 
     /** Find the object with the greatest object id smaller than the input id.
 
@@ -236,20 +253,63 @@ public:
     const_iterator
     lower_bound(uint256 const& id) const;
 
+    /** Start fetching the nodes that lead to some items.
+
+        Nodes that are neither in memory nor in the tree node cache are
+        read asynchronously from the node store and put in the cache, so
+        that later lookups of the items do not wait on the store.
+
+        @param keys the identifiers of the items. They need not exist.
+    */
+    void
+    prefetch(std::vector<uint256> const& keys) const;
+
     /**  Visit every node in this SHAMap
 
          @param function called with every node visited.
          If function returns false, visitNodes exits.
+
+         The template takes any callable, which it can inline into the walk.
     */
+    template <class Function>
+    void
+    visitNodes(Function&& function) const;
+
     void
     visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const;
 
+    /**  Visit every inner node of this SHAMap that is held in memory
+
+         Nothing is fetched: a branch whose child has not been read yet
+         is skipped, along with everything below it.
+
+         @param function called with every inner node visited.
+    */
+    void
+    visitResidentInnerNodes(
+        std::function<void(SHAMapInnerNode const&)> const& function) const;
+
+    /**  Get the inner nodes at the top of this SHAMap that are in memory
+
+         Nothing is fetched. Holding on to the nodes keeps them in the
+         tree node cache, so that a map with the same root hash can be
+         rebuilt without reading them from the node store again.
+
+         @param depth the number of levels below the root to include.
+    */
+    std::vector<SharedIntrusive<SHAMapInnerNode>>
+    getTopInnerNodes(int depth) const;
+
     /**  Visit every node in this SHAMap that
          is not present in the specified SHAMap
 
          @param function called with every node visited.
          If function returns false, visitDifferences exits.
     */
+    template <class Function>
+    void
+    visitDifferences(SHAMap const* have, Function&& function) const;
+
     void
     visitDifferences(
         SHAMap const* have,
@@ -259,6 +319,10 @@ public:
 
          @param function called with every non inner node visited.
     */
+    template <class Function>
+    void
+    visitLeaves(Function&& function) const;
+
     void
     visitLeaves(
         std::function<
@@ -308,6 +372,44 @@ public:
         uint256 const& key,
         std::vector<Blob> const& path);
 
+    /**
+     * Get the proof paths of several keys at once. Nodes that the paths
+     * share, like the root, are included once. The nodes are in depth
+     * first order from the root, visiting the branches of an inner node
+     * in increasing order.
+     * @param keys  keys of the leaves, strictly increasing
+     * @return the nodes of the proof paths, if all the keys are found
+     */
+    std::optional<std::vector<Blob>>
+    getProofPaths(std::vector<uint256> const& keys) const;
+
+    /**
+     * Verify proof paths obtained from getProofPaths
+     * @param rootHash  root hash of the map
+     * @param keys  keys of the leaves, strictly increasing
+     * @param nodes  the nodes of the proof paths
+     * @return true if verified successfully
+     */
+    static bool
+    verifyProofPaths(
+        uint256 const& rootHash,
+        std::vector<uint256> const& keys,
+        std::vector<Blob> const& nodes);
+
+    /**
+     * Pack the nodes of proof paths into one blob, each node preceded by
+     * its length, so that the whole bundle can be sent as one field.
+     */
+    static Blob
+    serializeProofPaths(std::vector<Blob> const& nodes);
+
+    /**
+     * Unpack a blob made by serializeProofPaths
+     * @return the nodes, if the blob is well formed
+     */
+    static std::optional<std::vector<Blob>>
+    deserializeProofPaths(Slice const& data);
+
     /** Serializes the root in a format appropriate for sending over the wire */
     void
     serializeRoot(Serializer& s) const;
@@ -323,6 +425,40 @@ public:
         Slice const& rawNode,
         SHAMapSyncFilter* filter);
 
+    /** Add several non-root nodes received together.
+
+        The nodes are parsed and hashed as a batch, then added in order as
+        if by addKnownNode, stopping after the first one that isn't good.
+
+        @return The combined result for the nodes that were added.
+    */
+    SHAMapAddNode
+    addKnownNodes(
+        std::span<std::pair<SHAMapNodeID, Slice> const> nodes,
+        SHAMapSyncFilter* filter);
+
+    /** Parse and hash nodes received from the network as a batch.
+
+        This only reads how the map allocates its items, so it may be called
+        concurrently with anything but the map's destruction. The results
+        can be handed to addKnownNodes later.
+    */
+    std::vector<SharedIntrusive<SHAMapTreeNode>>
+    parseNodes(std::span<Slice const> rawNodes) const;
+
+    /** Add several non-root nodes that were parsed by parseNodes.
+
+        The nodes are added in order as if by addKnownNode, stopping after
+        the first one that isn't good. Each node that is used is moved out.
+
+        @return The combined result for the nodes that were added.
+    */
+    SHAMapAddNode
+    addKnownNodes(
+        std::span<std::pair<SHAMapNodeID, SharedIntrusive<SHAMapTreeNode>>>
+            nodes,
+        SHAMapSyncFilter* filter);
+
     // status functions
     void
     setImmutable();
@@ -335,18 +471,41 @@ public:
     bool
     isValid() const;
 
-    // caution: otherMap must be accessed only by this function
-    // return value: true=successfully completed, false=too different
+    /** Find the items that differ between this map and another one.
+
+        @param threads The most threads to use. When greater than one, the
+                       differing branches below the root are compared
+                       concurrently, drawing on one budget of maxCount.
+                       All the differences found are the same either way.
+                       The threads are started for each call, so code
+                       serving clients should compare serially.
+
+        @return true if all the differences were found, false if there
+                were at least maxCount of them, in which case only
+                maxCount of them are reported. Which ones are reported
+                then may depend on the threads.
+
+        @note otherMap must be accessed only by this function
+    */
     bool
-    compare(SHAMap const& otherMap, Delta& differences, int maxCount) const;
+    compare(
+        SHAMap const& otherMap,
+        Delta& differences,
+        int maxCount,
+        std::size_t threads = 1) const;
 
     /** Convert any modified nodes to shared. */
     int
     unshare();
 
-    /** Flush modified nodes to the nodestore and convert them to shared. */
+    /** Flush modified nodes to the nodestore and convert them to shared.
+
+        @param threads The most threads to use. When greater than one, the
+                       modified subtrees below the root are hashed and
+                       written concurrently, then joined at the root.
+    */
     int
-    flushDirty(NodeObjectType t);
+    flushDirty(NodeObjectType t, std::size_t threads = 1);
 
     void
     walkMap(std::vector<SHAMapMissingNode>& missingNodes, int maxMissing) const;
@@ -360,6 +519,20 @@ public:
     void
     setUnbacked();
 
+    /** Allocate the items of this map from an arena.
+
+        Intended for short-lived maps, like transaction sets: the items
+        that the map builds from nodes it receives, and those created by
+        makeItem, are freed in bulk once the map, its snapshots, and the
+        items themselves are all gone. Already present items are unaffected.
+    */
+    void
+    setItemArena();
+
+    /** Make an item for this map, from its arena if it has one. */
+    boost::intrusive_ptr<SHAMapItem>
+    makeItem(uint256 const& key, Slice data) const;
+
     void
     dump(bool withHashes = false) const;
     void
@@ -367,28 +540,28 @@ public:
 
 private:
     using SharedPtrNodeStack =
-        std::stack<std::pair<std::shared_ptr<SHAMapTreeNode>, SHAMapNodeID>>;
+        std::stack<std::pair<SharedIntrusive<SHAMapTreeNode>, SHAMapNodeID>>;
     using DeltaRef = std::pair<
         boost::intrusive_ptr<SHAMapItem const>,
         boost::intrusive_ptr<SHAMapItem const>>;
 
     // tree node cache operations
-    std::shared_ptr<SHAMapTreeNode>
+    SharedIntrusive<SHAMapTreeNode>
     cacheLookup(SHAMapHash const& hash) const;
     void
-    canonicalize(SHAMapHash const& hash, std::shared_ptr<SHAMapTreeNode>&)
+    canonicalize(SHAMapHash const& hash, SharedIntrusive<SHAMapTreeNode>&)
         const;
 
     // database operations
-    std::shared_ptr<SHAMapTreeNode>
+    SharedIntrusive<SHAMapTreeNode>
     fetchNodeFromDB(SHAMapHash const& hash) const;
-    std::shared_ptr<SHAMapTreeNode>
+    SharedIntrusive<SHAMapTreeNode>
     fetchNodeNT(SHAMapHash const& hash) const;
-    std::shared_ptr<SHAMapTreeNode>
+    SharedIntrusive<SHAMapTreeNode>
     fetchNodeNT(SHAMapHash const& hash, SHAMapSyncFilter* filter) const;
-    std::shared_ptr<SHAMapTreeNode>
+    SharedIntrusive<SHAMapTreeNode>
     fetchNode(SHAMapHash const& hash) const;
-    std::shared_ptr<SHAMapTreeNode>
+    SharedIntrusive<SHAMapTreeNode>
     checkFilter(SHAMapHash const& hash, SHAMapSyncFilter* filter) const;
 
     /** Update hashes up to the root */
@@ -396,7 +569,7 @@ private:
     dirtyUp(
         SharedPtrNodeStack& stack,
         uint256 const& target,
-        std::shared_ptr<SHAMapTreeNode> terminal);
+        SharedIntrusive<SHAMapTreeNode> terminal);
 
     /** Walk towards the specified id, returning the node.  Caller must check
         if the return is nullptr, and if not, if the node->peekItem()->key() ==
@@ -410,42 +583,67 @@ private:
 
     /** Unshare the node, allowing it to be modified */
     template <class Node>
-    std::shared_ptr<Node>
-    unshareNode(std::shared_ptr<Node>, SHAMapNodeID const& nodeID);
+    SharedIntrusive<Node>
+    unshareNode(SharedIntrusive<Node>, SHAMapNodeID const& nodeID);
 
     /** prepare a node to be modified before flushing */
     template <class Node>
-    std::shared_ptr<Node>
-    preFlushNode(std::shared_ptr<Node> node) const;
+    SharedIntrusive<Node>
+    preFlushNode(SharedIntrusive<Node> node) const;
 
     /** write and canonicalize modified node */
-    std::shared_ptr<SHAMapTreeNode>
-    writeNode(NodeObjectType t, std::shared_ptr<SHAMapTreeNode> node) const;
+    SharedIntrusive<SHAMapTreeNode>
+    writeNode(NodeObjectType t, SharedIntrusive<SHAMapTreeNode> node) const;
+    SharedIntrusive<SHAMapTreeNode>
+    writeNode(
+        NodeObjectType t,
+        SharedIntrusive<SHAMapTreeNode> node,
+        Blob&& data) const;
+
+    /** Hook in a known node, calling makeNode only if it is needed */
+    template <class MakeNode>
+    SHAMapAddNode
+    addKnownNodeWith(
+        SHAMapNodeID const& node,
+        MakeNode&& makeNode,
+        SHAMapSyncFilter* filter);
 
     // returns the first item at or below this node
     SHAMapLeafNode*
     firstBelow(
-        std::shared_ptr<SHAMapTreeNode>,
+        SharedIntrusive<SHAMapTreeNode>,
         SharedPtrNodeStack& stack,
-        int branch = 0) const;
+        int branch = 0,
+        int readAhead = 0) const;
 
     // returns the last item at or below this node
     SHAMapLeafNode*
     lastBelow(
-        std::shared_ptr<SHAMapTreeNode> node,
+        SharedIntrusive<SHAMapTreeNode> node,
         SharedPtrNodeStack& stack,
         int branch = branchFactor) const;
 
     // helper function for firstBelow and lastBelow
     SHAMapLeafNode*
     belowHelper(
-        std::shared_ptr<SHAMapTreeNode> node,
+        SharedIntrusive<SHAMapTreeNode> node,
         SharedPtrNodeStack& stack,
         int branch,
         std::tuple<
             int,
             std::function<bool(int)>,
-            std::function<void(int&)>> const& loopParams) const;
+            std::function<void(int&)>> const& loopParams,
+        int readAhead) const;
+
+    /** Start reading the children of inner that follow branch.
+
+        At most count non-empty branches are considered. Children that are
+        already in memory are skipped, and the rest are fetched without
+        waiting and placed in the tree node cache, where a later descent
+        will find them.
+    */
+    void
+    prefetchAfter(SHAMapInnerNode* inner, int branch, int count) const;
 
     // Simple descent
     // Get a child of the specified node
@@ -453,15 +651,15 @@ private:
     descend(SHAMapInnerNode*, int branch) const;
     SHAMapTreeNode*
     descendThrow(SHAMapInnerNode*, int branch) const;
-    std::shared_ptr<SHAMapTreeNode>
-    descend(std::shared_ptr<SHAMapInnerNode> const&, int branch) const;
-    std::shared_ptr<SHAMapTreeNode>
-    descendThrow(std::shared_ptr<SHAMapInnerNode> const&, int branch) const;
+    SharedIntrusive<SHAMapTreeNode>
+    descend(SharedIntrusive<SHAMapInnerNode> const&, int branch) const;
+    SharedIntrusive<SHAMapTreeNode>
+    descendThrow(SharedIntrusive<SHAMapInnerNode> const&, int branch) const;
 
     // Descend with filter
     // If pending, callback is called as if it called fetchNodeNT
     using descendCallback =
-        std::function<void(std::shared_ptr<SHAMapTreeNode>, SHAMapHash const&)>;
+        std::function<void(SharedIntrusive<SHAMapTreeNode>, SHAMapHash const&)>;
     SHAMapTreeNode*
     descendAsync(
         SHAMapInnerNode* parent,
@@ -479,8 +677,8 @@ private:
 
     // Non-storing
     // Does not hook the returned node to its parent
-    std::shared_ptr<SHAMapTreeNode>
-    descendNoStore(std::shared_ptr<SHAMapInnerNode> const&, int branch) const;
+    SharedIntrusive<SHAMapTreeNode>
+    descendNoStore(SharedIntrusive<SHAMapInnerNode> const&, int branch) const;
 
     /** If there is only one leaf below this node, get its contents */
     boost::intrusive_ptr<SHAMapItem const> const&
@@ -492,18 +690,34 @@ private:
     hasLeafNode(uint256 const& tag, SHAMapHash const& hash) const;
 
     SHAMapLeafNode const*
-    peekFirstItem(SharedPtrNodeStack& stack) const;
+    peekFirstItem(SharedPtrNodeStack& stack, int readAhead = 0) const;
     SHAMapLeafNode const*
-    peekNextItem(uint256 const& id, SharedPtrNodeStack& stack) const;
+    peekNextItem(
+        uint256 const& id,
+        SharedPtrNodeStack& stack,
+        int readAhead = 0) const;
+    bool
+    compareSubTree(
+        SHAMapTreeNode* ourRoot,
+        SHAMapTreeNode* otherRoot,
+        SHAMap const& otherMap,
+        Delta& differences,
+        std::atomic<int>& maxCount) const;
     bool
     walkBranch(
         SHAMapTreeNode* node,
         boost::intrusive_ptr<SHAMapItem const> const& otherMapItem,
         bool isFirstMap,
         Delta& differences,
-        int& maxCount) const;
+        std::atomic<int>& maxCount) const;
     int
-    walkSubTree(bool doWrite, NodeObjectType t);
+    walkSubTree(bool doWrite, NodeObjectType t, std::size_t threads);
+    SharedIntrusive<SHAMapInnerNode>
+    flushSubTree(
+        SharedIntrusive<SHAMapInnerNode> node,
+        bool doWrite,
+        NodeObjectType t,
+        int& flushed) const;
 
     // Structure to track information about call to
     // getMissingNodes while it's in progress
@@ -544,7 +758,7 @@ private:
             SHAMapInnerNode*,                  // parent node
             SHAMapNodeID,                      // parent node ID
             int,                               // branch
-            std::shared_ptr<SHAMapTreeNode>>;  // node
+            SharedIntrusive<SHAMapTreeNode>>;  // node
 
         int deferred_;
         std::mutex deferLock_;
@@ -578,7 +792,7 @@ private:
     gmn_ProcessDeferredReads(MissingNodes&);
 
     // fetch from DB helper function
-    std::shared_ptr<SHAMapTreeNode>
+    SharedIntrusive<SHAMapTreeNode>
     finishFetch(
         SHAMapHash const& hash,
         std::shared_ptr<NodeObject> const& object) const;
@@ -633,6 +847,162 @@ SHAMap::setUnbacked()
     backed_ = false;
 }
 
+inline void
+SHAMap::setItemArena()
+{
+    if (!arena_)
+        arena_ = SHAMapItemArena::make();
+}
+
+inline boost::intrusive_ptr<SHAMapItem>
+SHAMap::makeItem(uint256 const& key, Slice data) const
+{
+    if (arena_)
+        return make_shamapitem(*arena_, key, data);
+
+    return make_shamapitem(key, data);
+}
+
+template <class Function>
+void
+SHAMap::visitLeaves(Function&& function) const
+{
+    visitNodes([&function](SHAMapTreeNode& node) {
+        if (!node.isInner())
+            function(static_cast<SHAMapLeafNode&>(node).peekItem());
+        return true;
+    });
+}
+
+template <class Function>
+void
+SHAMap::visitNodes(Function&& function) const
+{
+    if (!root_)
+        return;
+
+    function(*root_);
+
+    if (!root_->isInner())
+        return;
+
+    using StackEntry = std::pair<int, SharedIntrusive<SHAMapInnerNode>>;
+    std::stack<StackEntry, std::vector<StackEntry>> stack;
+
+    auto node = static_pointer_cast<SHAMapInnerNode>(root_);
+    int pos = 0;
+
+    while (true)
+    {
+        while (pos < 16)
+        {
+            if (!node->isEmptyBranch(pos))
+            {
+                SharedIntrusive<SHAMapTreeNode> child =
+                    descendNoStore(node, pos);
+                if (!function(*child))
+                    return;
+
+                if (child->isLeaf())
+                    ++pos;
+                else
+                {
+                    // If there are no more children, don't push this node
+                    while ((pos != 15) && (node->isEmptyBranch(pos + 1)))
+                        ++pos;
+
+                    if (pos != 15)
+                    {
+                        // save next position to resume at
+                        stack.push(std::make_pair(pos + 1, std::move(node)));
+                    }
+
+                    // descend to the child's first position
+                    node = static_pointer_cast<SHAMapInnerNode>(child);
+                    pos = 0;
+                }
+            }
+            else
+            {
+                ++pos;  // move to next position
+            }
+        }
+
+        if (stack.empty())
+            break;
+
+        std::tie(pos, node) = stack.top();
+        stack.pop();
+    }
+}
+
+template <class Function>
+void
+SHAMap::visitDifferences(SHAMap const* have, Function&& function) const
+{
+    // Visit every node in this SHAMap that is not present
+    // in the specified SHAMap
+    if (!root_)
+        return;
+
+    if (root_->getHash().isZero())
+        return;
+
+    if (have && (root_->getHash() == have->root_->getHash()))
+        return;
+
+    if (root_->isLeaf())
+    {
+        auto leaf = static_pointer_cast<SHAMapLeafNode>(root_);
+        if (!have ||
+            !have->hasLeafNode(leaf->peekItem()->key(), leaf->getHash()))
+            function(*root_);
+        return;
+    }
+    // contains unexplored non-matching inner node entries
+    using StackEntry = std::pair<SHAMapInnerNode*, SHAMapNodeID>;
+    std::stack<StackEntry, std::vector<StackEntry>> stack;
+
+    stack.push({static_cast<SHAMapInnerNode*>(root_.get()), SHAMapNodeID{}});
+
+    while (!stack.empty())
+    {
+        auto const [node, nodeID] = stack.top();
+        stack.pop();
+
+        // 1) Add this node to the pack
+        if (!function(*node))
+            return;
+
+        // 2) push non-matching child inner nodes
+        for (int i = 0; i < 16; ++i)
+        {
+            if (!node->isEmptyBranch(i))
+            {
+                auto const& childHash = node->getChildHash(i);
+                SHAMapNodeID childID = nodeID.getChildNodeID(i);
+                auto next = descendThrow(node, i);
+
+                if (next->isInner())
+                {
+                    if (!have || !have->hasInnerNode(childID, childHash))
+                        stack.push(
+                            {static_cast<SHAMapInnerNode*>(next), childID});
+                }
+                else if (
+                    !have ||
+                    !have->hasLeafNode(
+                        static_cast<SHAMapLeafNode*>(next)->peekItem()->key(),
+                        childHash))
+                {
+                    if (!function(*next))
+                        return;
+                }
+            }
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 
 class SHAMap::const_iterator
@@ -648,6 +1018,7 @@ private:
     SharedPtrNodeStack stack_;
     SHAMap const* map_ = nullptr;
     pointer item_ = nullptr;
+    int readAhead_ = 0;
 
 public:
     const_iterator() = delete;
@@ -669,20 +1040,25 @@ public:
     operator++(int);
 
 private:
-    explicit const_iterator(SHAMap const* map);
+    const_iterator(SHAMap const* map, int readAhead);
     const_iterator(SHAMap const* map, std::nullptr_t);
-    const_iterator(SHAMap const* map, pointer item, SharedPtrNodeStack&& stack);
+    const_iterator(
+        SHAMap const* map,
+        pointer item,
+        SharedPtrNodeStack&& stack,
+        int readAhead = 0);
 
     friend bool
     operator==(const_iterator const& x, const_iterator const& y);
     friend class SHAMap;
 };
 
-inline SHAMap::const_iterator::const_iterator(SHAMap const* map) : map_(map)
+inline SHAMap::const_iterator::const_iterator(SHAMap const* map, int readAhead)
+    : map_(map), readAhead_(readAhead)
 {
     assert(map_ != nullptr);
 
-    if (auto temp = map_->peekFirstItem(stack_))
+    if (auto temp = map_->peekFirstItem(stack_, readAhead_))
         item_ = temp->peekItem().get();
 }
 
@@ -694,8 +1070,9 @@ inline SHAMap::const_iterator::const_iterator(SHAMap const* map, std::nullptr_t)
 inline SHAMap::const_iterator::const_iterator(
     SHAMap const* map,
     pointer item,
-    SharedPtrNodeStack&& stack)
-    : stack_(std::move(stack)), map_(map), item_(item)
+    SharedPtrNodeStack&& stack,
+    int readAhead)
+    : stack_(std::move(stack)), map_(map), item_(item), readAhead_(readAhead)
 {
 }
 
@@ -714,7 +1091,7 @@ SHAMap::const_iterator::operator->() const
 inline SHAMap::const_iterator&
 SHAMap::const_iterator::operator++()
 {
-    if (auto temp = map_->peekNextItem(item_->key(), stack_))
+    if (auto temp = map_->peekNextItem(item_->key(), stack_, readAhead_))
         item_ = temp->peekItem().get();
     else
         item_ = nullptr;
@@ -743,9 +1120,9 @@ operator!=(SHAMap::const_iterator const& x, SHAMap::const_iterator const& y)
 }
 
 inline SHAMap::const_iterator
-SHAMap::begin() const
+SHAMap::begin(int readAhead) const
 {
-    return const_iterator(this);
+    return const_iterator(this, readAhead);
 }
 
 inline SHAMap::const_iterator
@@ -51,10 +51,10 @@ public:
     {
     }
 
-    std::shared_ptr<SHAMapTreeNode>
+    SharedIntrusive<SHAMapTreeNode>
     clone(std::uint32_t cowid) const final override
     {
-        return std::make_shared<SHAMapAccountStateLeafNode>(
+        return make_SharedIntrusive<SHAMapAccountStateLeafNode>(
             item_, cowid, hash_);
     }
 
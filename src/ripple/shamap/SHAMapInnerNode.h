@@ -49,7 +49,7 @@ public:
 private:
     /** Opaque type that contains the `hashes` array (array of type
        `SHAMapHash`) and the `children` array (array of type
-       `std::shared_ptr<SHAMapInnerNode>`).
+       `SharedIntrusive<SHAMapInnerNode>`).
      */
     TaggedPointer hashesAndChildren_;
 
@@ -114,7 +114,10 @@ public:
     operator=(SHAMapInnerNode const&) = delete;
     ~SHAMapInnerNode();
 
-    std::shared_ptr<SHAMapTreeNode>
+    void
+    partialDestructor() override;
+
+    SharedIntrusive<SHAMapTreeNode>
     clone(std::uint32_t cowid) const override;
 
     SHAMapNodeType
@@ -148,19 +151,19 @@ public:
     getChildHash(int m) const;
 
     void
-    setChild(int m, std::shared_ptr<SHAMapTreeNode> child);
+    setChild(int m, SharedIntrusive<SHAMapTreeNode> child);
 
     void
-    shareChild(int m, std::shared_ptr<SHAMapTreeNode> const& child);
+    shareChild(int m, SharedIntrusive<SHAMapTreeNode> const& child);
 
     SHAMapTreeNode*
     getChildPointer(int branch);
 
-    std::shared_ptr<SHAMapTreeNode>
+    SharedIntrusive<SHAMapTreeNode>
     getChild(int branch);
 
-    std::shared_ptr<SHAMapTreeNode>
-    canonicalizeChild(int branch, std::shared_ptr<SHAMapTreeNode> node);
+    SharedIntrusive<SHAMapTreeNode>
+    canonicalizeChild(int branch, SharedIntrusive<SHAMapTreeNode> node);
 
     // sync functions
     bool
@@ -176,6 +179,10 @@ public:
     void
     updateHashDeep();
 
+    /** Refresh the stored hashes of all children without rehashing. */
+    void
+    updateChildHashes();
+
     void
     serializeForWire(Serializer&) const override;
 
@@ -188,11 +195,14 @@ public:
     void
     invariants(bool is_root = false) const override;
 
-    static std::shared_ptr<SHAMapTreeNode>
+    std::size_t
+    memoryUsage() const override;
+
+    static SharedIntrusive<SHAMapTreeNode>
     makeFullInner(Slice data, SHAMapHash const& hash, bool hashValid);
 
-    static std::shared_ptr<SHAMapTreeNode>
-    makeCompressedInner(Slice data);
+    static SharedIntrusive<SHAMapTreeNode>
+    makeCompressedInner(Slice data, SHAMapHash const& hash, bool hashValid);
 };
 
 inline bool
@@ -26,10 +26,120 @@
 #include <ripple/basics/Slice.h>
 #include <ripple/basics/base_uint.h>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <atomic>
 #include <cassert>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace ripple {
 
+/** Bulk storage for the items of a short-lived map.
+
+    Items are carved out of large blocks and are never freed one at a time:
+    all the blocks go back to the heap together once the arena's owner and
+    every item allocated from it have released it. Each item holds a
+    reference, so items may safely outlive the map that created them.
+*/
+class SHAMapItemArena
+{
+    friend void
+    intrusive_ptr_add_ref(SHAMapItemArena const* x);
+
+    friend void
+    intrusive_ptr_release(SHAMapItemArena const* x);
+
+    // Allocations at least this large get a block of their own
+    static constexpr std::size_t blockSize = kilobytes(std::size_t(64));
+    static constexpr std::size_t largeSize = blockSize / 4;
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<std::uint8_t[]>> blocks_;
+    std::uint8_t* next_ = nullptr;
+    std::size_t left_ = 0;
+
+    // One reference for the owner and one for every live item
+    mutable std::atomic<std::size_t> refcount_ = 1;
+
+    SHAMapItemArena() = default;
+
+public:
+    SHAMapItemArena(SHAMapItemArena const&) = delete;
+
+    SHAMapItemArena&
+    operator=(SHAMapItemArena const&) = delete;
+
+    static boost::intrusive_ptr<SHAMapItemArena>
+    make()
+    {
+        return {new SHAMapItemArena, false};
+    }
+
+    /** Return suitably aligned memory for an object of the given size.
+
+        The memory is preceded by a pointer to this arena, and the arena
+        gains a reference that the object must give back when it dies.
+    */
+    std::uint8_t*
+    allocate(std::size_t size);
+
+    /** The arena that gave out the memory for an object. */
+    static SHAMapItemArena*
+    owner(void const* p)
+    {
+        return *(reinterpret_cast<SHAMapItemArena* const*>(p) - 1);
+    }
+};
+
+inline void
+intrusive_ptr_add_ref(SHAMapItemArena const* x)
+{
+    ++x->refcount_;
+}
+
+inline void
+intrusive_ptr_release(SHAMapItemArena const* x)
+{
+    if (--x->refcount_ == 0)
+        delete x;
+}
+
+inline std::uint8_t*
+SHAMapItemArena::allocate(std::size_t size)
+{
+    constexpr std::size_t header = sizeof(SHAMapItemArena*);
+
+    // Keep every allocation, and so the next header, pointer aligned
+    size = header + (size + header - 1) / header * header;
+
+    std::uint8_t* p;
+
+    {
+        std::lock_guard lock(mutex_);
+
+        if (size >= largeSize)
+        {
+            p = blocks_.emplace_back(new std::uint8_t[size]).get();
+        }
+        else
+        {
+            if (size > left_)
+            {
+                next_ = blocks_.emplace_back(new std::uint8_t[blockSize]).get();
+                left_ = blockSize;
+            }
+
+            p = next_;
+            next_ += size;
+            left_ -= size;
+        }
+    }
+
+    intrusive_ptr_add_ref(this);
+    *reinterpret_cast<SHAMapItemArena**>(p) = this;
+    return p + header;
+}
+
 // an item stored in a SHAMap
 class SHAMapItem : public CountedObject<SHAMapItem>
 {
@@ -46,12 +156,18 @@ class SHAMapItem : public CountedObject<SHAMapItem>
     friend boost::intrusive_ptr<SHAMapItem>
     make_shamapitem(uint256 const& tag, Slice data);
 
+    friend boost::intrusive_ptr<SHAMapItem>
+    make_shamapitem(SHAMapItemArena& arena, uint256 const& tag, Slice data);
+
 private:
+    // Set in size_ for items whose memory belongs to a SHAMapItemArena
+    static constexpr std::uint32_t arenaFlag = 0x80000000;
+
     uint256 const tag_;
 
     // We use std::uint32_t to minimize the size; there's no SHAMapItem whose
     // size exceeds 4GB and there won't ever be (famous last words?), so this
-    // is safe.
+    // is safe. The top bit is arenaFlag.
     std::uint32_t const size_;
 
     // This is the reference count used to support boost::intrusive_ptr
@@ -61,8 +177,11 @@ private:
     // the only way to properly create one is to first allocate enough memory
     // so we limit this constructor to codepaths that do this right and limit
     // arbitrary construction.
-    SHAMapItem(uint256 const& tag, Slice data)
-        : tag_(tag), size_(static_cast<std::uint32_t>(data.size()))
+    SHAMapItem(uint256 const& tag, Slice data, bool inArena = false)
+        : tag_(tag)
+        , size_(
+              static_cast<std::uint32_t>(data.size()) |
+              (inArena ? arenaFlag : 0))
     {
         std::memcpy(
             reinterpret_cast<std::uint8_t*>(this) + sizeof(*this),
@@ -92,7 +211,7 @@ public:
     std::size_t
     size() const
     {
-        return size_;
+        return size_ & ~arenaFlag;
     }
 
     void const*
@@ -146,9 +265,18 @@ intrusive_ptr_release(SHAMapItem const* x)
         // The SHAMapItem constuctor isn't trivial (because the destructor
         // for CountedObject isn't) so we can't avoid calling it here, but
         // plan for a future where we might not need to.
+        bool const inArena = (x->size_ & SHAMapItem::arenaFlag) != 0;
+
         if constexpr (!std::is_trivially_destructible_v<SHAMapItem>)
             std::destroy_at(x);
 
+        // The arena frees its memory in bulk; all we owe it is our reference
+        if (inArena)
+        {
+            intrusive_ptr_release(SHAMapItemArena::owner(p));
+            return;
+        }
+
         // If the slabber doens't claim this pointer, it was allocated
         // manually, so we free it manually.
         if (!detail::slabber.deallocate(const_cast<std::uint8_t*>(p)))
@@ -175,6 +303,17 @@ make_shamapitem(uint256 const& tag, Slice data)
     return {new (raw) SHAMapItem{tag, data}, false};
 }
 
+/** Make an item whose memory comes from the given arena. */
+inline boost::intrusive_ptr<SHAMapItem>
+make_shamapitem(SHAMapItemArena& arena, uint256 const& tag, Slice data)
+{
+    assert(data.size() <= megabytes<std::size_t>(16));
+
+    std::uint8_t* raw = arena.allocate(sizeof(SHAMapItem) + data.size());
+
+    return {new (raw) SHAMapItem{tag, data, true}, false};
+}
+
 static_assert(alignof(SHAMapItem) != 40);
 static_assert(alignof(SHAMapItem) == 8 || alignof(SHAMapItem) == 4);
 
@@ -48,6 +48,9 @@ public:
     SHAMapLeafNode&
     operator=(const SHAMapLeafNode&) = delete;
 
+    void
+    partialDestructor() final override;
+
     bool
     isLeaf() const final override
     {
@@ -63,6 +66,9 @@ public:
     void
     invariants(bool is_root = false) const final override;
 
+    std::size_t
+    memoryUsage() const final override;
+
 public:
     boost::intrusive_ptr<SHAMapItem const> const&
     peekItem() const;
@@ -0,0 +1,76 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_SHAMAP_SHAMAPSNAPSHOT_H_INCLUDED
+#define RIPPLE_SHAMAP_SHAMAPSNAPSHOT_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/shamap/SHAMap.h>
+#include <ripple/shamap/TreeNodeCache.h>
+#include <boost/filesystem.hpp>
+#include <cstdint>
+#include <optional>
+
+namespace ripple {
+
+/** The inner nodes of a state map, saved so that a restart has a warm cache.
+
+    A snapshot file starts with a header naming the ledger it was taken
+    from, followed by one record per inner node: the node's branch mask
+    and then the hashes of its non-empty branches. Node hashes are not
+    stored; they are recomputed when the file is loaded, so a damaged
+    record only yields a node that no map ever asks for.
+*/
+struct SHAMapSnapshot
+{
+    std::uint32_t ledgerSeq = 0;
+    uint256 rootHash;
+    std::uint64_t nodes = 0;
+};
+
+/** Write the inner nodes of a map that are held in memory to a file.
+
+    The file is written next to its destination and then renamed over it,
+    so an existing snapshot is never left half written.
+
+    @return The number of inner nodes written.
+*/
+std::uint64_t
+writeSHAMapSnapshot(
+    SHAMap const& map,
+    std::uint32_t ledgerSeq,
+    boost::filesystem::path const& path);
+
+/** Add the inner nodes of a snapshot file to a tree node cache.
+
+    The file is memory mapped and read in place.
+
+    @return A description of the snapshot, or nothing if the file is
+            missing or not a snapshot.
+*/
+std::optional<SHAMapSnapshot>
+loadSHAMapSnapshot(
+    boost::filesystem::path const& path,
+    TreeNodeCache& cache,
+    beast::Journal j);
+
+}  // namespace ripple
+
+#endif
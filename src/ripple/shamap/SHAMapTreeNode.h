@@ -21,6 +21,8 @@
 #define RIPPLE_SHAMAP_SHAMAPTREENODE_H_INCLUDED
 
 #include <ripple/basics/CountedObject.h>
+#include <ripple/basics/IntrusivePointer.h>
+#include <ripple/basics/IntrusiveRefCounts.h>
 #include <ripple/basics/SHAMapHash.h>
 #include <ripple/basics/TaggedCache.h>
 #include <ripple/beast/utility/Journal.h>
@@ -31,7 +33,9 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace ripple {
 
@@ -50,7 +54,7 @@ enum class SHAMapNodeType {
     tnACCOUNT_STATE = 4
 };
 
-class SHAMapTreeNode
+class SHAMapTreeNode : public IntrusiveRefCounts
 {
 protected:
     SHAMapHash hash_;
@@ -89,6 +93,17 @@ protected:
 public:
     virtual ~SHAMapTreeNode() noexcept = default;
 
+    /** Release what this node holds once no strong references remain.
+
+        A node whose last strong reference goes away while the cache still
+        has a weak reference to it is not freed until that weak reference
+        is released too. This lets the node drop its children and item
+        right away, rather than keep them alive for as long as the cache
+        tracks it.
+     */
+    virtual void
+    partialDestructor() = 0;
+
     /** \defgroup SHAMap Copy-on-Write Support
 
         By nature, a node may appear in multiple SHAMap instances. Rather than
@@ -130,7 +145,7 @@ public:
     }
 
     /** Make a copy of this node, setting the owner. */
-    virtual std::shared_ptr<SHAMapTreeNode>
+    virtual SharedIntrusive<SHAMapTreeNode>
     clone(std::uint32_t cowid) const = 0;
     /** @} */
 
@@ -138,6 +153,17 @@ public:
     virtual void
     updateHash() = 0;
 
+    /** Set the hash of this node to one computed elsewhere.
+
+        The hash must be the SHA512-Half of the node's
+        serializeWithPrefix output, which is what updateHash computes.
+    */
+    void
+    setHash(SHAMapHash const& hash)
+    {
+        hash_ = hash;
+    }
+
     /** Return the hash of this node. */
     SHAMapHash const&
     getHash() const
@@ -171,21 +197,59 @@ public:
     virtual void
     invariants(bool is_root = false) const = 0;
 
-    static std::shared_ptr<SHAMapTreeNode>
-    makeFromPrefix(Slice rawNode, SHAMapHash const& hash);
+    /** The number of bytes of memory that this node uses, including what
+        it owns but not its children.
+    */
+    virtual std::size_t
+    memoryUsage() const = 0;
 
-    static std::shared_ptr<SHAMapTreeNode>
-    makeFromWire(Slice rawNode);
+    /** Make a node from its prefixed serialization.
 
-private:
-    static std::shared_ptr<SHAMapTreeNode>
-    makeTransaction(Slice data, SHAMapHash const& hash, bool hashValid);
+        If an arena is given, the node's item, if any, is allocated from it.
+    */
+    static SharedIntrusive<SHAMapTreeNode>
+    makeFromPrefix(
+        Slice rawNode,
+        SHAMapHash const& hash,
+        SHAMapItemArena* arena = nullptr);
 
-    static std::shared_ptr<SHAMapTreeNode>
-    makeAccountState(Slice data, SHAMapHash const& hash, bool hashValid);
+    static SharedIntrusive<SHAMapTreeNode>
+    makeFromWire(Slice rawNode, SHAMapItemArena* arena = nullptr);
 
-    static std::shared_ptr<SHAMapTreeNode>
-    makeTransactionWithMeta(Slice data, SHAMapHash const& hash, bool hashValid);
+    /** Make a node from each of several wire serializations.
+
+        The result is the same as calling makeFromWire on each of them in
+        turn, but the node hashes are computed together, which is faster.
+    */
+    static std::vector<SharedIntrusive<SHAMapTreeNode>>
+    makeFromWire(
+        std::span<Slice const> rawNodes,
+        SHAMapItemArena* arena = nullptr);
+
+private:
+    static SharedIntrusive<SHAMapTreeNode>
+    makeFromWire(Slice rawNode, bool hashValid, SHAMapItemArena* arena);
+
+    static SharedIntrusive<SHAMapTreeNode>
+    makeTransaction(
+        Slice data,
+        SHAMapHash const& hash,
+        bool hashValid,
+        SHAMapItemArena* arena);
+
+    static SharedIntrusive<SHAMapTreeNode>
+    makeAccountState(
+        Slice data,
+        SHAMapHash const& hash,
+        bool hashValid,
+        SHAMapItemArena* arena);
+
+    static SharedIntrusive<SHAMapTreeNode>
+    makeTransactionWithMeta(
+        Slice data,
+        SHAMapHash const& hash,
+        bool hashValid,
+        SHAMapItemArena* arena);
 };
 
 }  // namespace ripple
@@ -82,6 +82,18 @@ public:
     std::pair<int, int>
     getTreeNodeCacheSize();
 
+    /** Return the number of fetches from the tree node caches that found
+        a node, and that did not, counting those of removed caches too
+    */
+    std::pair<std::uint64_t, std::uint64_t>
+    getTreeNodeCacheLookups();
+
+    /** Scale the targets of the tree node caches, including those made
+        later, by a factor of the configured targets
+    */
+    void
+    setTreeNodeCacheFactor(double factor);
+
     void
     sweep() override;
 
@@ -111,6 +123,8 @@ private:
     std::mutex tnCacheMutex_;
     int const tnTargetSize_;
     std::chrono::seconds const tnTargetAge_;
+    double tnFactor_{1.0};
+    std::pair<std::uint64_t, std::uint64_t> tnRemovedLookups_{0, 0};
 
     // Missing node handler
     LedgerIndex maxSeq_{0};
@@ -118,6 +132,14 @@ private:
 
     void
     acquire(uint256 const& hash, std::uint32_t seq);
+
+    // Must be called with tnCacheMutex_ held
+    void
+    scaleTreeNodeCache(TreeNodeCache& cache) const;
+
+    // Must be called with tnCacheMutex_ held
+    void
+    removeTreeNodeCache(TreeNodeCache const& cache);
 };
 
 }  // namespace ripple
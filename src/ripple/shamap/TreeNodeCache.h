@@ -20,11 +20,146 @@
 #ifndef RIPPLE_SHAMAP_TREENODECACHE_H_INCLUDED
 #define RIPPLE_SHAMAP_TREENODECACHE_H_INCLUDED
 
+#include <ripple/basics/IntrusivePointer.h>
+#include <ripple/basics/TaggedCache.h>
+#include <ripple/basics/base_uint.h>
 #include <ripple/shamap/SHAMapTreeNode.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace ripple {
 
-using TreeNodeCache = TaggedCache<uint256, SHAMapTreeNode>;
+/** The tree nodes of every map in a family, keyed by node hash.
+
+    A node stays tracked here for as long as any map holds it, even once
+    the cache has let go of its own reference. A map that loads a node
+    from the store, or writes one, is handed the tracked copy instead, so
+    ledgers which share a node share one copy of it and of its item.
+
+    Nearly every descent through a map looks a node up here, so the nodes
+    are spread by hash over independently locked shards, each with an
+    equal part of the targets. Threads looking up different nodes then
+    seldom wait on each other.
+*/
+class TreeNodeCache
+{
+    using cache_type = TaggedCache<
+        uint256,
+        SHAMapTreeNode,
+        /*IsKeyCache*/ false,
+        digest_hash,
+        std::equal_to<uint256>,
+        ProfiledMutex<std::recursive_mutex>,
+        SharedIntrusive<SHAMapTreeNode>,
+        WeakIntrusive<SHAMapTreeNode>>;
+
+public:
+    using key_type = uint256;
+    using clock_type = cache_type::clock_type;
+
+    static constexpr std::size_t shardCount = 16;
+
+    TreeNodeCache(
+        std::string const& name,
+        int size,
+        clock_type::duration expiration,
+        clock_type& clock,
+        beast::Journal journal);
+
+    /** Returns the node with a hash, if it is cached or tracked. */
+    SharedIntrusive<SHAMapTreeNode>
+    fetch(uint256 const& key, std::uint32_t generation = 0)
+    {
+        return shard(key).fetch(key, generation);
+    }
+
+    /** Refreshes a cached node, returning whether there was one. */
+    bool
+    touch_if_exists(uint256 const& key, std::uint32_t generation = 0)
+    {
+        return shard(key).touch_if_exists(key, generation);
+    }
+
+    /** Caches a node, or replaces it with the copy already tracked. */
+    bool
+    canonicalize_replace_client(
+        uint256 const& key,
+        SharedIntrusive<SHAMapTreeNode>& node,
+        std::uint32_t generation = 0)
+    {
+        return shard(key).canonicalize_replace_client(key, node, generation);
+    }
+
+    /** The number of nodes to keep, 0 for no limit. */
+    int
+    getTargetSize() const;
+
+    /** Sets the number of nodes to keep, 0 for no limit. */
+    void
+    setTargetSize(int size);
+
+    /** The number of bytes to keep, 0 for no limit. */
+    std::size_t
+    getTargetBytes() const;
+
+    /** Sets the number of bytes to keep, 0 for no limit. */
+    void
+    setTargetBytes(std::size_t bytes);
+
+    clock_type::duration
+    getTargetAge() const;
+
+    void
+    setTargetAge(clock_type::duration age);
+
+    /** Evict by a clock sweep rather than by age. */
+    void
+    setClockEviction(bool enable);
+
+    /** The number of nodes tracked, whether cached or not. */
+    std::size_t
+    size() const;
+
+    int
+    getCacheSize() const;
+
+    int
+    getTrackSize() const;
+
+    std::size_t
+    getCacheBytes() const;
+
+    float
+    getHitRate();
+
+    /** Returns the number of fetches that found a node, and that did not. */
+    std::pair<std::uint64_t, std::uint64_t>
+    getLookups() const;
+
+    std::vector<uint256>
+    getKeys() const;
+
+    void
+    sweep();
+
+    void
+    reset();
+
+private:
+    cache_type&
+    shard(uint256 const& key)
+    {
+        // Node hashes are uniformly distributed, so any byte will do.
+        return *shards_[*key.begin() % shardCount];
+    }
+
+    std::array<std::unique_ptr<cache_type>, shardCount> shards_;
+};
 
 }  // namespace ripple
 
@@ -0,0 +1,291 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Log.h>
+#include <ripple/shamap/FullBelowCache.h>
+#include <algorithm>
+#include <cassert>
+
+namespace ripple {
+namespace detail {
+
+std::size_t
+FullBelowSet::find(uint256 const& key, std::size_t hash) const
+{
+    assert(!slots_.empty());
+    auto const mask = slots_.size() - 1;
+    auto i = hash & mask;
+    while (slots_[i].isNonZero() && slots_[i] != key)
+        i = (i + 1) & mask;
+    return i;
+}
+
+bool
+FullBelowSet::contains(uint256 const& key, std::size_t hash) const
+{
+    if (size_ == 0)
+        return false;
+    return slots_[find(key, hash)].isNonZero();
+}
+
+bool
+FullBelowSet::insert(uint256 const& key, std::size_t hash)
+{
+    assert(key.isNonZero());
+
+    // Keep the table at most half full, so probe sequences stay short
+    if (2 * (size_ + 1) > slots_.size())
+        grow();
+
+    auto& slot = slots_[find(key, hash)];
+    if (slot.isNonZero())
+        return false;
+
+    slot = key;
+    ++size_;
+    return true;
+}
+
+bool
+FullBelowSet::erase(uint256 const& key, std::size_t hash)
+{
+    if (size_ == 0)
+        return false;
+
+    auto const mask = slots_.size() - 1;
+    auto i = find(key, hash);
+    if (slots_[i].isZero())
+        return false;
+
+    // Shift later entries of the probe sequence back into the hole, so
+    // that no tombstones are needed.
+    auto j = i;
+    while (true)
+    {
+        j = (j + 1) & mask;
+        if (slots_[j].isZero())
+            break;
+
+        auto const home = hash_(slots_[j]) & mask;
+
+        // The entry at j may move to i only if its home slot does not lie
+        // cyclically in (i, j].
+        bool const stays = (i <= j) ? (i < home && home <= j)
+                                    : (i < home || home <= j);
+        if (!stays)
+        {
+            slots_[i] = slots_[j];
+            i = j;
+        }
+    }
+
+    slots_[i] = beast::zero;
+    --size_;
+    return true;
+}
+
+void
+FullBelowSet::clear()
+{
+    std::vector<uint256>().swap(slots_);
+    size_ = 0;
+}
+
+void
+FullBelowSet::swap(FullBelowSet& other) noexcept
+{
+    std::swap(hash_, other.hash_);
+    slots_.swap(other.slots_);
+    std::swap(size_, other.size_);
+}
+
+void
+FullBelowSet::grow()
+{
+    std::vector<uint256> old(std::max<std::size_t>(64, 2 * slots_.size()));
+    old.swap(slots_);
+
+    for (auto const& key : old)
+    {
+        if (key.isNonZero())
+            slots_[find(key, hash_(key))] = key;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+BasicFullBelowCache::BasicFullBelowCache(
+    std::string const& name,
+    clock_type& clock,
+    beast::Journal j,
+    beast::insight::Collector::ptr const& collector,
+    std::size_t target_size,
+    std::chrono::seconds expiration)
+    : j_(j)
+    , clock_(clock)
+    , name_(name)
+    , targetSize_(target_size)
+    , sweepPeriod_(expiration / 2)
+    , hook_(collector->make_hook([this]() { collect_metrics(); }))
+    , sizeGauge_(collector->make_gauge(name, "size"))
+    , hitRateGauge_(collector->make_gauge(name, "hit_rate"))
+    , m_gen(1)
+{
+    for (auto& p : partitions_)
+        p = std::make_unique<Partition>(hash_);
+}
+
+std::size_t
+BasicFullBelowCache::size() const
+{
+    std::size_t total = 0;
+    for (auto const& p : partitions_)
+    {
+        std::lock_guard lock(p->mutex);
+        total += p->recent.size() + p->older.size();
+    }
+    return total;
+}
+
+bool
+BasicFullBelowCache::touch_if_exists(key_type const& key)
+{
+    auto const hash = hash_(key);
+    auto& p = partition(hash);
+    std::lock_guard lock(p.mutex);
+
+    if (p.recent.contains(key, hash))
+    {
+        ++p.hits;
+        return true;
+    }
+
+    if (p.older.erase(key, hash))
+    {
+        p.recent.insert(key, hash);
+        ++p.hits;
+        return true;
+    }
+
+    ++p.misses;
+    return false;
+}
+
+void
+BasicFullBelowCache::insert(key_type const& key)
+{
+    auto const hash = hash_(key);
+    auto& p = partition(hash);
+    std::lock_guard lock(p.mutex);
+
+    if (p.recent.insert(key, hash))
+        p.older.erase(key, hash);
+}
+
+void
+BasicFullBelowCache::sweep()
+{
+    std::lock_guard sweepLock(sweepMutex_);
+
+    std::size_t recent = 0;
+    for (auto& p : partitions_)
+    {
+        std::lock_guard lock(p->mutex);
+        recent += p->recent.size();
+    }
+
+    // The clock may not be running yet when the cache is constructed, so
+    // the first sweep starts the first period.
+    auto const now = clock_.now();
+    if (!lastRotation_)
+        lastRotation_ = now;
+
+    // Retire the older keys once per half expiration period, or sooner
+    // if the recent ones alone would fill more than half the target.
+    if (now - *lastRotation_ < sweepPeriod_ &&
+        (targetSize_ == 0 || 2 * recent <= targetSize_))
+        return;
+
+    std::size_t removed = 0;
+    for (auto& p : partitions_)
+    {
+        FullBelowSet retired(hash_);
+        {
+            std::lock_guard lock(p->mutex);
+            retired.swap(p->older);
+            p->older.swap(p->recent);
+        }
+
+        // Release the memory outside the lock
+        removed += retired.size();
+    }
+    lastRotation_ = now;
+
+    JLOG(j_.debug()) << name_ << ": " << removed << " removed, " << recent
+                     << " retained";
+}
+
+void
+BasicFullBelowCache::clearPartitions()
+{
+    for (auto& p : partitions_)
+    {
+        FullBelowSet recent(hash_);
+        FullBelowSet older(hash_);
+        std::lock_guard lock(p->mutex);
+        recent.swap(p->recent);
+        older.swap(p->older);
+    }
+}
+
+void
+BasicFullBelowCache::clear()
+{
+    clearPartitions();
+    ++m_gen;
+}
+
+void
+BasicFullBelowCache::reset()
+{
+    clearPartitions();
+    m_gen = 1;
+}
+
+void
+BasicFullBelowCache::collect_metrics()
+{
+    std::size_t total = 0;
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    for (auto const& p : partitions_)
+    {
+        std::lock_guard lock(p->mutex);
+        total += p->recent.size() + p->older.size();
+        hits += p->hits;
+        misses += p->misses;
+    }
+
+    sizeGauge_.set(total);
+    if (auto const lookups = hits + misses; lookups != 0)
+        hitRateGauge_.set((hits * 100) / lookups);
+}
+
+}  // namespace detail
+}  // namespace ripple
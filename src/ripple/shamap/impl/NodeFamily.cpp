@@ -20,6 +20,7 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/main/Tuning.h>
+#include <ripple/basics/ByteUtilities.h>
 #include <ripple/shamap/NodeFamily.h>
 #include <sstream>
 
@@ -44,6 +45,14 @@ NodeFamily::NodeFamily(Application& app, CollectorManager& cm)
           stopwatch(),
           j_))
 {
+    // A memory budget replaces the number of entries
+    if (auto const budget = app.config().TREE_CACHE_BUDGET)
+    {
+        tnCache_->setTargetSize(0);
+        tnCache_->setTargetBytes(megabytes(*budget));
+    }
+
+    tnCache_->setClockEviction(app.config().TREE_CACHE_CLOCK);
 }
 
 void
@@ -18,30 +18,38 @@
 //==============================================================================
 
 #include <ripple/basics/contract.h>
+#include <ripple/protocol/digest.h>
 #include <ripple/shamap/SHAMap.h>
 #include <ripple/shamap/SHAMapAccountStateLeafNode.h>
 #include <ripple/shamap/SHAMapNodeID.h>
 #include <ripple/shamap/SHAMapSyncFilter.h>
 #include <ripple/shamap/SHAMapTxLeafNode.h>
 #include <ripple/shamap/SHAMapTxPlusMetaLeafNode.h>
+#include <array>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <stack>
+#include <thread>
+#include <unordered_map>
 
 namespace ripple {
 
-[[nodiscard]] std::shared_ptr<SHAMapLeafNode>
+[[nodiscard]] SharedIntrusive<SHAMapLeafNode>
 makeTypedLeaf(
     SHAMapNodeType type,
     boost::intrusive_ptr<SHAMapItem const> item,
     std::uint32_t owner)
 {
     if (type == SHAMapNodeType::tnTRANSACTION_NM)
-        return std::make_shared<SHAMapTxLeafNode>(std::move(item), owner);
+        return make_SharedIntrusive<SHAMapTxLeafNode>(std::move(item), owner);
 
     if (type == SHAMapNodeType::tnTRANSACTION_MD)
-        return std::make_shared<SHAMapTxPlusMetaLeafNode>(
+        return make_SharedIntrusive<SHAMapTxPlusMetaLeafNode>(
             std::move(item), owner);
 
     if (type == SHAMapNodeType::tnACCOUNT_STATE)
-        return std::make_shared<SHAMapAccountStateLeafNode>(
+        return make_SharedIntrusive<SHAMapAccountStateLeafNode>(
             std::move(item), owner);
 
     LogicError(
@@ -53,7 +61,7 @@ makeTypedLeaf(
 SHAMap::SHAMap(SHAMapType t, Family& f)
     : f_(f), journal_(f.journal()), state_(SHAMapState::Modifying), type_(t)
 {
-    root_ = std::make_shared<SHAMapInnerNode>(cowid_);
+    root_ = make_SharedIntrusive<SHAMapInnerNode>(cowid_);
 }
 
 // The `hash` parameter is unused. It is part of the interface so it's clear
@@ -63,7 +71,7 @@ SHAMap::SHAMap(SHAMapType t, Family& f)
 SHAMap::SHAMap(SHAMapType t, uint256 const& hash, Family& f)
     : f_(f), journal_(f.journal()), state_(SHAMapState::Synching), type_(t)
 {
-    root_ = std::make_shared<SHAMapInnerNode>(cowid_);
+    root_ = make_SharedIntrusive<SHAMapInnerNode>(cowid_);
 }
 
 SHAMap::SHAMap(SHAMap const& other, bool isMutable)
@@ -75,6 +83,7 @@ SHAMap::SHAMap(SHAMap const& other, bool isMutable)
     , state_(isMutable ? SHAMapState::Modifying : SHAMapState::Immutable)
     , type_(other.type_)
     , backed_(other.backed_)
+    , arena_(other.arena_)
 {
     // If either map may change, they cannot share nodes
     if ((state_ != SHAMapState::Immutable) ||
@@ -94,7 +103,7 @@ void
 SHAMap::dirtyUp(
     SharedPtrNodeStack& stack,
     uint256 const& target,
-    std::shared_ptr<SHAMapTreeNode> child)
+    SharedIntrusive<SHAMapTreeNode> child)
 {
     // walk the tree up from through the inner nodes to the root_
     // update hashes and links
@@ -109,7 +118,7 @@ SHAMap::dirtyUp(
     while (!stack.empty())
     {
         auto node =
-            std::dynamic_pointer_cast<SHAMapInnerNode>(stack.top().first);
+            dynamic_pointer_cast<SHAMapInnerNode>(stack.top().first);
         SHAMapNodeID nodeID = stack.top().second;
         stack.pop();
         assert(node != nullptr);
@@ -136,7 +145,7 @@ SHAMap::walkTowardsKey(uint256 const& id, SharedPtrNodeStack* stack) const
         if (stack != nullptr)
             stack->push({inNode, nodeID});
 
-        auto const inner = std::static_pointer_cast<SHAMapInnerNode>(inNode);
+        auto const inner = static_pointer_cast<SHAMapInnerNode>(inNode);
         auto const branch = selectBranch(nodeID, id);
         if (inner->isEmptyBranch(branch))
             return nullptr;
@@ -159,7 +168,7 @@ SHAMap::findKey(uint256 const& id) const
     return leaf;
 }
 
-std::shared_ptr<SHAMapTreeNode>
+SharedIntrusive<SHAMapTreeNode>
 SHAMap::fetchNodeFromDB(SHAMapHash const& hash) const
 {
     assert(backed_);
@@ -167,7 +176,7 @@ SHAMap::fetchNodeFromDB(SHAMapHash const& hash) const
     return finishFetch(hash, obj);
 }
 
-std::shared_ptr<SHAMapTreeNode>
+SharedIntrusive<SHAMapTreeNode>
 SHAMap::finishFetch(
     SHAMapHash const& hash,
     std::shared_ptr<NodeObject> const& object) const
@@ -206,15 +215,15 @@ SHAMap::finishFetch(
 }
 
 // See if a sync filter has a node
-std::shared_ptr<SHAMapTreeNode>
+SharedIntrusive<SHAMapTreeNode>
 SHAMap::checkFilter(SHAMapHash const& hash, SHAMapSyncFilter* filter) const
 {
     if (auto nodeData = filter->getNode(hash))
     {
         try
         {
-            auto node =
-                SHAMapTreeNode::makeFromPrefix(makeSlice(*nodeData), hash);
+            auto node = SHAMapTreeNode::makeFromPrefix(
+                makeSlice(*nodeData), hash, arena_.get());
             if (node)
             {
                 filter->gotNode(
@@ -239,7 +248,7 @@ SHAMap::checkFilter(SHAMapHash const& hash, SHAMapSyncFilter* filter) const
 
 // Get a node without throwing
 // Used on maps where missing nodes are expected
-std::shared_ptr<SHAMapTreeNode>
+SharedIntrusive<SHAMapTreeNode>
 SHAMap::fetchNodeNT(SHAMapHash const& hash, SHAMapSyncFilter* filter) const
 {
     auto node = cacheLookup(hash);
@@ -262,7 +271,7 @@ SHAMap::fetchNodeNT(SHAMapHash const& hash, SHAMapSyncFilter* filter) const
     return node;
 }
 
-std::shared_ptr<SHAMapTreeNode>
+SharedIntrusive<SHAMapTreeNode>
 SHAMap::fetchNodeNT(SHAMapHash const& hash) const
 {
     auto node = cacheLookup(hash);
@@ -274,7 +283,7 @@ SHAMap::fetchNodeNT(SHAMapHash const& hash) const
 }
 
 // Throw if the node is missing
-std::shared_ptr<SHAMapTreeNode>
+SharedIntrusive<SHAMapTreeNode>
 SHAMap::fetchNode(SHAMapHash const& hash) const
 {
     auto node = fetchNodeNT(hash);
@@ -296,11 +305,11 @@ SHAMap::descendThrow(SHAMapInnerNode* parent, int branch) const
     return ret;
 }
 
-std::shared_ptr<SHAMapTreeNode>
-SHAMap::descendThrow(std::shared_ptr<SHAMapInnerNode> const& parent, int branch)
+SharedIntrusive<SHAMapTreeNode>
+SHAMap::descendThrow(SharedIntrusive<SHAMapInnerNode> const& parent, int branch)
     const
 {
-    std::shared_ptr<SHAMapTreeNode> ret = descend(parent, branch);
+    SharedIntrusive<SHAMapTreeNode> ret = descend(parent, branch);
 
     if (!ret && !parent->isEmptyBranch(branch))
         Throw<SHAMapMissingNode>(type_, parent->getChildHash(branch));
@@ -315,7 +324,7 @@ SHAMap::descend(SHAMapInnerNode* parent, int branch) const
     if (ret || !backed_)
         return ret;
 
-    std::shared_ptr<SHAMapTreeNode> node =
+    SharedIntrusive<SHAMapTreeNode> node =
         fetchNodeNT(parent->getChildHash(branch));
     if (!node)
         return nullptr;
@@ -324,11 +333,11 @@ SHAMap::descend(SHAMapInnerNode* parent, int branch) const
     return node.get();
 }
 
-std::shared_ptr<SHAMapTreeNode>
-SHAMap::descend(std::shared_ptr<SHAMapInnerNode> const& parent, int branch)
+SharedIntrusive<SHAMapTreeNode>
+SHAMap::descend(SharedIntrusive<SHAMapInnerNode> const& parent, int branch)
     const
 {
-    std::shared_ptr<SHAMapTreeNode> node = parent->getChild(branch);
+    SharedIntrusive<SHAMapTreeNode> node = parent->getChild(branch);
     if (node || !backed_)
         return node;
 
@@ -342,12 +351,12 @@ SHAMap::descend(std::shared_ptr<SHAMapInnerNode> const& parent, int branch)
 
 // Gets the node that would be hooked to this branch,
 // but doesn't hook it up.
-std::shared_ptr<SHAMapTreeNode>
+SharedIntrusive<SHAMapTreeNode>
 SHAMap::descendNoStore(
-    std::shared_ptr<SHAMapInnerNode> const& parent,
+    SharedIntrusive<SHAMapInnerNode> const& parent,
     int branch) const
 {
-    std::shared_ptr<SHAMapTreeNode> ret = parent->getChild(branch);
+    SharedIntrusive<SHAMapTreeNode> ret = parent->getChild(branch);
     if (!ret && backed_)
         ret = fetchNode(parent->getChildHash(branch));
     return ret;
@@ -369,7 +378,7 @@ SHAMap::descend(
     if (!child)
     {
         auto const& childHash = parent->getChildHash(branch);
-        std::shared_ptr<SHAMapTreeNode> childNode =
+        SharedIntrusive<SHAMapTreeNode> childNode =
             fetchNodeNT(childHash, filter);
 
         if (childNode)
@@ -426,8 +435,8 @@ SHAMap::descendAsync(
 }
 
 template <class Node>
-std::shared_ptr<Node>
-SHAMap::unshareNode(std::shared_ptr<Node> node, SHAMapNodeID const& nodeID)
+SharedIntrusive<Node>
+SHAMap::unshareNode(SharedIntrusive<Node> node, SHAMapNodeID const& nodeID)
 {
     // make sure the node is suitable for the intended operation (copy on write)
     assert(node->cowid() <= cowid_);
@@ -435,7 +444,7 @@ SHAMap::unshareNode(std::shared_ptr<Node> node, SHAMapNodeID const& nodeID)
     {
         // have a CoW
         assert(state_ != SHAMapState::Immutable);
-        node = std::static_pointer_cast<Node>(node->clone(cowid_));
+        node = static_pointer_cast<Node>(node->clone(cowid_));
         if (nodeID.isRoot())
             root_ = node;
     }
@@ -444,20 +453,21 @@ SHAMap::unshareNode(std::shared_ptr<Node> node, SHAMapNodeID const& nodeID)
 
 SHAMapLeafNode*
 SHAMap::belowHelper(
-    std::shared_ptr<SHAMapTreeNode> node,
+    SharedIntrusive<SHAMapTreeNode> node,
     SharedPtrNodeStack& stack,
     int branch,
     std::tuple<int, std::function<bool(int)>, std::function<void(int&)>> const&
-        loopParams) const
+        loopParams,
+    int readAhead) const
 {
     auto& [init, cmp, incr] = loopParams;
     if (node->isLeaf())
     {
-        auto n = std::static_pointer_cast<SHAMapLeafNode>(node);
+        auto n = static_pointer_cast<SHAMapLeafNode>(node);
         stack.push({node, {leafDepth, n->peekItem()->key()}});
         return n.get();
     }
-    auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
+    auto inner = static_pointer_cast<SHAMapInnerNode>(node);
     if (stack.empty())
         stack.push({inner, SHAMapNodeID{}});
     else
@@ -466,15 +476,18 @@ SHAMap::belowHelper(
     {
         if (!inner->isEmptyBranch(i))
         {
+            if (readAhead > 0)
+                prefetchAfter(inner.get(), i, readAhead);
+
             node = descendThrow(inner, i);
             assert(!stack.empty());
             if (node->isLeaf())
             {
-                auto n = std::static_pointer_cast<SHAMapLeafNode>(node);
+                auto n = static_pointer_cast<SHAMapLeafNode>(node);
                 stack.push({n, {leafDepth, n->peekItem()->key()}});
                 return n.get();
             }
-            inner = std::static_pointer_cast<SHAMapInnerNode>(node);
+            inner = static_pointer_cast<SHAMapInnerNode>(node);
             stack.push({inner, stack.top().second.getChildNodeID(branch)});
             i = init;  // descend and reset loop
         }
@@ -485,7 +498,7 @@ SHAMap::belowHelper(
 }
 SHAMapLeafNode*
 SHAMap::lastBelow(
-    std::shared_ptr<SHAMapTreeNode> node,
+    SharedIntrusive<SHAMapTreeNode> node,
     SharedPtrNodeStack& stack,
     int branch) const
 {
@@ -493,20 +506,172 @@ SHAMap::lastBelow(
     auto cmp = [](int i) { return i >= 0; };
     auto incr = [](int& i) { --i; };
 
-    return belowHelper(node, stack, branch, {init, cmp, incr});
+    return belowHelper(node, stack, branch, {init, cmp, incr}, 0);
 }
 SHAMapLeafNode*
 SHAMap::firstBelow(
-    std::shared_ptr<SHAMapTreeNode> node,
+    SharedIntrusive<SHAMapTreeNode> node,
     SharedPtrNodeStack& stack,
-    int branch) const
+    int branch,
+    int readAhead) const
 {
     auto init = 0;
     auto cmp = [](int i) { return i <= branchFactor; };
     auto incr = [](int& i) { ++i; };
 
-    return belowHelper(node, stack, branch, {init, cmp, incr});
+    return belowHelper(node, stack, branch, {init, cmp, incr}, readAhead);
+}
+
+void
+SHAMap::prefetchAfter(SHAMapInnerNode* inner, int branch, int count) const
+{
+    if (!backed_)
+        return;
+
+    for (int i = branch + 1; (i < branchFactor) && (count > 0); ++i)
+    {
+        if (inner->isEmptyBranch(i))
+            continue;
+
+        --count;
+
+        if (inner->getChildPointer(i))
+            continue;
+
+        auto const& hash = inner->getChildHash(i);
+
+        if (f_.getTreeNodeCache(ledgerSeq_)->touch_if_exists(
+                hash.as_uint256(), ledgerSeq_))
+            continue;
+
+        // The read may finish after this map is gone, so the callback
+        // only holds on to the family, which outlives every map.
+        f_.db().asyncFetch(
+            hash.as_uint256(),
+            ledgerSeq_,
+            [&family = f_, seq = ledgerSeq_, hash](
+                std::shared_ptr<NodeObject> const& object) {
+                // A missing node is reported by the descent that needs it
+                if (!object)
+                    return;
+
+                try
+                {
+                    auto node = SHAMapTreeNode::makeFromPrefix(
+                        makeSlice(object->getData()), hash);
+                    if (node)
+                        family.getTreeNodeCache(seq)
+                            ->canonicalize_replace_client(
+                                hash.as_uint256(), node, seq);
+                }
+                catch (std::exception const&)
+                {
+                }
+            });
+    }
+}
+
+// Fetch the node with the given hash into the cache, then carry on towards
+// the key until reaching a leaf, an empty branch or a missing node.
+static void
+prefetchPath(
+    Family& family,
+    std::uint32_t seq,
+    SHAMapHash const& hash,
+    SHAMapNodeID const& nodeID,
+    uint256 const& key)
+{
+    // The read may finish after the map is gone, so the callback only
+    // holds on to the family, which outlives every map.
+    family.db().asyncFetch(
+        hash.as_uint256(),
+        seq,
+        [&family, seq, hash, nodeID, key](
+            std::shared_ptr<NodeObject> const& object) {
+            // A missing node is reported by the lookup that needs it
+            if (!object)
+                return;
+
+            try
+            {
+                auto node = SHAMapTreeNode::makeFromPrefix(
+                    makeSlice(object->getData()), hash);
+                if (!node)
+                    return;
+
+                auto const cache = family.getTreeNodeCache(seq);
+                cache->canonicalize_replace_client(
+                    hash.as_uint256(), node, seq);
+
+                auto id = nodeID;
+                while (node->isInner())
+                {
+                    auto const inner =
+                        static_cast<SHAMapInnerNode*>(node.get());
+                    auto const branch = selectBranch(id, key);
+                    if (inner->isEmptyBranch(branch))
+                        return;
+
+                    auto const& childHash = inner->getChildHash(branch);
+                    auto const childID = id.getChildNodeID(branch);
+                    auto child = cache->fetch(childHash.as_uint256(), seq);
+                    if (!child)
+                    {
+                        prefetchPath(family, seq, childHash, childID, key);
+                        return;
+                    }
+
+                    node = std::move(child);
+                    id = childID;
+                }
+            }
+            catch (std::exception const&)
+            {
+            }
+        });
+}
+
+void
+SHAMap::prefetch(std::vector<uint256> const& keys) const
+{
+    if (!backed_ || !root_)
+        return;
+
+    for (auto const& key : keys)
+    {
+        // Hold on to cached nodes while passing through them
+        SharedIntrusive<SHAMapTreeNode> held;
+        SHAMapTreeNode* node = root_.get();
+        SHAMapNodeID nodeID;
+
+        while (node->isInner())
+        {
+            auto const inner = static_cast<SHAMapInnerNode*>(node);
+            auto const branch = selectBranch(nodeID, key);
+            if (inner->isEmptyBranch(branch))
+                break;
+
+            auto const childID = nodeID.getChildNodeID(branch);
+            if (auto const child = inner->getChildPointer(branch))
+            {
+                node = child;
+            }
+            else if (auto cached = cacheLookup(inner->getChildHash(branch)))
+            {
+                held = std::move(cached);
+                node = held.get();
+            }
+            else
+            {
+                prefetchPath(
+                    f_, ledgerSeq_, inner->getChildHash(branch), childID, key);
+                break;
+            }
+            nodeID = childID;
+        }
+    }
 }
+
 static const boost::intrusive_ptr<SHAMapItem const> no_item;
 
 boost::intrusive_ptr<SHAMapItem const> const&
@@ -546,10 +711,10 @@ SHAMap::onlyBelow(SHAMapTreeNode* node) const
 }
 
 SHAMapLeafNode const*
-SHAMap::peekFirstItem(SharedPtrNodeStack& stack) const
+SHAMap::peekFirstItem(SharedPtrNodeStack& stack, int readAhead) const
 {
     assert(stack.empty());
-    SHAMapLeafNode* node = firstBelow(root_, stack);
+    SHAMapLeafNode* node = firstBelow(root_, stack, 0, readAhead);
     if (!node)
     {
         while (!stack.empty())
@@ -560,7 +725,10 @@ SHAMap::peekFirstItem(SharedPtrNodeStack& stack) const
 }
 
 SHAMapLeafNode const*
-SHAMap::peekNextItem(uint256 const& id, SharedPtrNodeStack& stack) const
+SHAMap::peekNextItem(
+    uint256 const& id,
+    SharedPtrNodeStack& stack,
+    int readAhead) const
 {
     assert(!stack.empty());
     assert(stack.top().first->isLeaf());
@@ -569,13 +737,16 @@ SHAMap::peekNextItem(uint256 const& id, SharedPtrNodeStack& stack) const
     {
         auto [node, nodeID] = stack.top();
         assert(!node->isLeaf());
-        auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
+        auto inner = static_pointer_cast<SHAMapInnerNode>(node);
         for (auto i = selectBranch(nodeID, id) + 1; i < branchFactor; ++i)
         {
             if (!inner->isEmptyBranch(i))
             {
+                if (readAhead > 0)
+                    prefetchAfter(inner.get(), i, readAhead);
+
                 node = descendThrow(inner, i);
-                auto leaf = firstBelow(node, stack, i);
+                auto leaf = firstBelow(node, stack, i, readAhead);
                 if (!leaf)
                     Throw<SHAMapMissingNode>(type_, id);
                 assert(leaf->isLeaf());
@@ -612,7 +783,7 @@ SHAMap::peekItem(uint256 const& id, SHAMapHash& hash) const
 }
 
 SHAMap::const_iterator
-SHAMap::upper_bound(uint256 const& id) const
+SHAMap::upper_bound(uint256 const& id, int readAhead) const
 {
     SharedPtrNodeStack stack;
     walkTowardsKey(id, &stack);
@@ -624,23 +795,29 @@ SHAMap::upper_bound(uint256 const& id) const
             auto leaf = static_cast<SHAMapLeafNode*>(node.get());
             if (leaf->peekItem()->key() > id)
                 return const_iterator(
-                    this, leaf->peekItem().get(), std::move(stack));
+                    this, leaf->peekItem().get(), std::move(stack), readAhead);
         }
         else
         {
-            auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
+            auto inner = static_pointer_cast<SHAMapInnerNode>(node);
             for (auto branch = selectBranch(nodeID, id) + 1;
                  branch < branchFactor;
                  ++branch)
             {
                 if (!inner->isEmptyBranch(branch))
                 {
+                    if (readAhead > 0)
+                        prefetchAfter(inner.get(), branch, readAhead);
+
                     node = descendThrow(inner, branch);
-                    auto leaf = firstBelow(node, stack, branch);
+                    auto leaf = firstBelow(node, stack, branch, readAhead);
                     if (!leaf)
                         Throw<SHAMapMissingNode>(type_, id);
                     return const_iterator(
-                        this, leaf->peekItem().get(), std::move(stack));
+                        this,
+                        leaf->peekItem().get(),
+                        std::move(stack),
+                        readAhead);
                 }
             }
         }
@@ -665,7 +842,7 @@ SHAMap::lower_bound(uint256 const& id) const
         }
         else
         {
-            auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
+            auto inner = static_pointer_cast<SHAMapInnerNode>(node);
             for (int branch = selectBranch(nodeID, id) - 1; branch >= 0;
                  --branch)
             {
@@ -704,7 +881,7 @@ SHAMap::delItem(uint256 const& id)
     if (stack.empty())
         Throw<SHAMapMissingNode>(type_, id);
 
-    auto leaf = std::dynamic_pointer_cast<SHAMapLeafNode>(stack.top().first);
+    auto leaf = dynamic_pointer_cast<SHAMapLeafNode>(stack.top().first);
     stack.pop();
 
     if (!leaf || (leaf->peekItem()->key() != id))
@@ -714,12 +891,12 @@ SHAMap::delItem(uint256 const& id)
 
     // What gets attached to the end of the chain
     // (For now, nothing, since we deleted the leaf)
-    std::shared_ptr<SHAMapTreeNode> prevNode;
+    SharedIntrusive<SHAMapTreeNode> prevNode;
 
     while (!stack.empty())
     {
         auto node =
-            std::static_pointer_cast<SHAMapInnerNode>(stack.top().first);
+            static_pointer_cast<SHAMapInnerNode>(stack.top().first);
         SHAMapNodeID nodeID = stack.top().second;
         stack.pop();
 
@@ -792,7 +969,7 @@ SHAMap::addGiveItem(
 
     if (node->isLeaf())
     {
-        auto leaf = std::static_pointer_cast<SHAMapLeafNode>(node);
+        auto leaf = static_pointer_cast<SHAMapLeafNode>(node);
         if (leaf->peekItem()->key() == tag)
             return false;
     }
@@ -800,7 +977,7 @@ SHAMap::addGiveItem(
     if (node->isInner())
     {
         // easy case, we end on an inner node
-        auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
+        auto inner = static_pointer_cast<SHAMapInnerNode>(node);
         int branch = selectBranch(nodeID, tag);
         assert(inner->isEmptyBranch(branch));
         inner->setChild(branch, makeTypedLeaf(type, std::move(item), cowid_));
@@ -809,11 +986,11 @@ SHAMap::addGiveItem(
     {
         // this is a leaf node that has to be made an inner node holding two
         // items
-        auto leaf = std::static_pointer_cast<SHAMapLeafNode>(node);
+        auto leaf = static_pointer_cast<SHAMapLeafNode>(node);
         auto otherItem = leaf->peekItem();
         assert(otherItem && (tag != otherItem->key()));
 
-        node = std::make_shared<SHAMapInnerNode>(node->cowid());
+        node = make_SharedIntrusive<SHAMapInnerNode>(node->cowid());
 
         unsigned int b1, b2;
 
@@ -825,7 +1002,7 @@ SHAMap::addGiveItem(
             // we need a new inner node, since both go on same branch at this
             // level
             nodeID = nodeID.getChildNodeID(b1);
-            node = std::make_shared<SHAMapInnerNode>(cowid_);
+            node = make_SharedIntrusive<SHAMapInnerNode>(cowid_);
         }
 
         // we can add the two leaf nodes here
@@ -876,7 +1053,7 @@ SHAMap::updateGiveItem(
     if (stack.empty())
         Throw<SHAMapMissingNode>(type_, tag);
 
-    auto node = std::dynamic_pointer_cast<SHAMapLeafNode>(stack.top().first);
+    auto node = dynamic_pointer_cast<SHAMapLeafNode>(stack.top().first);
     auto nodeID = stack.top().second;
     stack.pop();
 
@@ -946,8 +1123,8 @@ SHAMap::fetchRoot(SHAMapHash const& hash, SHAMapSyncFilter* filter)
     @note The node must have already been unshared by having the caller
           first call SHAMapTreeNode::unshare().
  */
-std::shared_ptr<SHAMapTreeNode>
-SHAMap::writeNode(NodeObjectType t, std::shared_ptr<SHAMapTreeNode> node) const
+SharedIntrusive<SHAMapTreeNode>
+SHAMap::writeNode(NodeObjectType t, SharedIntrusive<SHAMapTreeNode> node) const
 {
     assert(node->cowid() == 0);
     assert(backed_);
@@ -961,12 +1138,27 @@ SHAMap::writeNode(NodeObjectType t, std::shared_ptr<SHAMapTreeNode> node) const
     return node;
 }
 
+SharedIntrusive<SHAMapTreeNode>
+SHAMap::writeNode(
+    NodeObjectType t,
+    SharedIntrusive<SHAMapTreeNode> node,
+    Blob&& data) const
+{
+    assert(node->cowid() == 0);
+    assert(backed_);
+
+    canonicalize(node->getHash(), node);
+
+    f_.db().store(t, std::move(data), node->getHash().as_uint256(), ledgerSeq_);
+    return node;
+}
+
 // We can't modify an inner node someone else might have a
 // pointer to because flushing modifies inner nodes -- it
 // makes them point to canonical/shared nodes.
 template <class Node>
-std::shared_ptr<Node>
-SHAMap::preFlushNode(std::shared_ptr<Node> node) const
+SharedIntrusive<Node>
+SHAMap::preFlushNode(SharedIntrusive<Node> node) const
 {
     // A shared node should never need to be flushed
     // because that would imply someone modified it
@@ -976,7 +1168,7 @@ SHAMap::preFlushNode(std::shared_ptr<Node> node) const
     {
         // Node is not uniquely ours, so unshare it before
         // possibly modifying it
-        node = std::static_pointer_cast<Node>(node->clone(cowid_));
+        node = static_pointer_cast<Node>(node->clone(cowid_));
     }
     return node;
 }
@@ -985,18 +1177,18 @@ int
 SHAMap::unshare()
 {
     // Don't share nodes with parent map
-    return walkSubTree(false, hotUNKNOWN);
+    return walkSubTree(false, hotUNKNOWN, 1);
 }
 
 int
-SHAMap::flushDirty(NodeObjectType t)
+SHAMap::flushDirty(NodeObjectType t, std::size_t threads)
 {
     // We only write back if this map is backed.
-    return walkSubTree(backed_, t);
+    return walkSubTree(backed_, t, threads);
 }
 
 int
-SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
+SHAMap::walkSubTree(bool doWrite, NodeObjectType t, std::size_t threads)
 {
     assert(!doWrite || backed_);
 
@@ -1017,107 +1209,291 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
         return 1;
     }
 
-    auto node = std::static_pointer_cast<SHAMapInnerNode>(root_);
+    auto node = static_pointer_cast<SHAMapInnerNode>(root_);
 
     if (node->isEmpty())
     {  // replace empty root with a new empty root
-        root_ = std::make_shared<SHAMapInnerNode>(0);
+        root_ = make_SharedIntrusive<SHAMapInnerNode>(0);
         return 1;
     }
 
-    // Stack of {parent,index,child} pointers representing
-    // inner nodes we are in the process of flushing
-    using StackEntry = std::pair<std::shared_ptr<SHAMapInnerNode>, int>;
-    std::stack<StackEntry, std::vector<StackEntry>> stack;
-
     node = preFlushNode(std::move(node));
 
-    int pos = 0;
+    if (threads <= 1)
+    {
+        root_ = flushSubTree(std::move(node), doWrite, t, flushed);
+        return flushed;
+    }
 
-    // We can't flush an inner node until we flush its children
-    while (1)
+    // The subtrees below the root share no nodes, so each dirty one can
+    // be hashed and written independently. Leaves hanging directly off
+    // the root are cheap and handled here.
+    std::array<SharedIntrusive<SHAMapInnerNode>, branchFactor> subtrees;
+    std::vector<int> dirty;
+    dirty.reserve(branchFactor);
+
+    for (int branch = 0; branch < branchFactor; ++branch)
     {
-        while (pos < branchFactor)
+        if (node->isEmptyBranch(branch))
+            continue;
+
+        auto child = node->getChild(branch);
+
+        if (!child || (child->cowid() == 0))
+            continue;
+
+        child = preFlushNode(std::move(child));
+
+        if (child->isInner())
+        {
+            subtrees[branch] =
+                static_pointer_cast<SHAMapInnerNode>(std::move(child));
+            dirty.push_back(branch);
+        }
+        else
+        {
+            ++flushed;
+            child->updateHash();
+            child->unshare();
+
+            if (doWrite)
+                child = writeNode(t, std::move(child));
+
+            node->shareChild(branch, child);
+        }
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<int> subtreeFlushed{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    auto const worker = [&]() {
+        try
         {
-            if (node->isEmptyBranch(pos))
+            for (auto i = next++; i < dirty.size(); i = next++)
             {
-                ++pos;
+                int n = 0;
+                auto& subtree = subtrees[dirty[i]];
+                subtree = flushSubTree(std::move(subtree), doWrite, t, n);
+                subtreeFlushed += n;
             }
-            else
+        }
+        catch (...)
+        {
+            std::lock_guard lock(errorMutex);
+            if (!error)
+                error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    auto const count = std::min(threads, dirty.size());
+    if (count > 1)
+        workers.reserve(count - 1);
+    for (std::size_t i = 1; i < count; ++i)
+        workers.emplace_back(worker);
+    worker();
+
+    for (auto& w : workers)
+        w.join();
+
+    if (error)
+        std::rethrow_exception(error);
+
+    flushed += subtreeFlushed;
+
+    for (auto const branch : dirty)
+        node->shareChild(branch, subtrees[branch]);
+
+    node->updateHashDeep();
+    node->unshare();
+
+    if (doWrite)
+        node = static_pointer_cast<SHAMapInnerNode>(
+            writeNode(t, std::move(node)));
+
+    root_ = std::move(node);
+
+    return flushed + 1;
+}
+
+SharedIntrusive<SHAMapInnerNode>
+SHAMap::flushSubTree(
+    SharedIntrusive<SHAMapInnerNode> node,
+    bool doWrite,
+    NodeObjectType t,
+    int& flushed) const
+{
+    // A node waiting to be flushed and where to hook it in once it is
+    struct Pending
+    {
+        SharedIntrusive<SHAMapTreeNode> node;
+        SHAMapInnerNode* parent;
+        int branch;
+    };
+
+    // We can't hash an inner node until we hash its children, so gather
+    // the dirty nodes one level at a time and hash the levels from the
+    // bottom up. Every node in a level is independent of the others,
+    // which lets them be hashed together.
+    std::vector<std::vector<Pending>> inners;
+    std::vector<Pending> leaves;
+
+    inners.push_back({{std::move(node), nullptr, 0}});
+
+    while (true)
+    {
+        std::vector<Pending> next;
+
+        for (auto const& p : inners.back())
+        {
+            auto const inner = static_cast<SHAMapInnerNode*>(p.node.get());
+            assert(inner->cowid() == cowid_);
+
+            for (int branch = 0; branch < branchFactor; ++branch)
             {
+                if (inner->isEmptyBranch(branch))
+                    continue;
+
                 // No need to do I/O. If the node isn't linked,
                 // it can't need to be flushed
-                int branch = pos;
-                auto child = node->getChild(pos++);
+                auto child = inner->getChild(branch);
 
-                if (child && (child->cowid() != 0))
-                {
-                    // This is a node that needs to be flushed
+                if (!child || (child->cowid() == 0))
+                    continue;
 
-                    child = preFlushNode(std::move(child));
+                child = preFlushNode(std::move(child));
 
-                    if (child->isInner())
-                    {
-                        // save our place and work on this node
-
-                        stack.emplace(std::move(node), branch);
-                        // The semantics of this changes when we move to c++-20
-                        // Right now no move will occur; With c++-20 child will
-                        // be moved from.
-                        node = std::static_pointer_cast<SHAMapInnerNode>(
-                            std::move(child));
-                        pos = 0;
-                    }
-                    else
-                    {
-                        // flush this leaf
-                        ++flushed;
+                if (child->isInner())
+                    next.push_back({std::move(child), inner, branch});
+                else
+                    leaves.push_back({std::move(child), inner, branch});
+            }
+        }
+
+        if (next.empty())
+            break;
 
-                        assert(node->cowid() == cowid_);
-                        child->updateHash();
-                        child->unshare();
+        inners.push_back(std::move(next));
+    }
 
-                        if (doWrite)
-                            child = writeNode(t, std::move(child));
+    // The nodes are hashed bottom up, but when the database asks for it they
+    // are held back and written parent first once the whole subtree is done
+    bool const ordered = doWrite && f_.db().treeOrderedWrites();
+    std::unordered_map<SHAMapTreeNode const*, Blob> held;
 
-                        node->shareChild(branch, child);
-                    }
+    constexpr std::size_t batchSize = 64;
+    std::vector<Serializer> data(batchSize);
+    std::array<Slice, batchSize> messages;
+    std::array<uint256, batchSize> digests;
+
+    auto const flush = [&](std::vector<Pending>& nodes) {
+        for (std::size_t first = 0; first < nodes.size(); first += batchSize)
+        {
+            auto const count = std::min(batchSize, nodes.size() - first);
+
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                data[i].erase();
+                nodes[first + i].node->serializeWithPrefix(data[i]);
+                messages[i] = data[i].slice();
+            }
+
+            // The prefixed serialization is exactly what a node's hash
+            // covers, so it is hashed once and then written as is
+            sha512HalfBatch(
+                {messages.data(), count}, {digests.data(), count});
+
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                auto& p = nodes[first + i];
+
+                p.node->setHash(SHAMapHash{digests[i]});
+
+                // This node can now be shared
+                p.node->unshare();
+
+                if (ordered)
+                {
+                    canonicalize(p.node->getHash(), p.node);
+                    held.emplace(p.node.get(), std::move(data[i].modData()));
                 }
+                else if (doWrite)
+                {
+                    p.node = writeNode(
+                        t, std::move(p.node), std::move(data[i].modData()));
+                }
+
+                // Hook this node to its parent
+                if (p.parent)
+                    p.parent->shareChild(p.branch, p.node);
+
+                ++flushed;
             }
         }
+    };
 
-        // update the hash of this inner node
-        node->updateHashDeep();
+    flush(leaves);
 
-        // This inner node can now be shared
-        node->unshare();
+    for (auto level = inners.rbegin(); level != inners.rend(); ++level)
+    {
+        // shareChild doesn't record the hashes of the children it links
+        for (auto const& p : *level)
+            static_cast<SHAMapInnerNode*>(p.node.get())->updateChildHashes();
 
-        if (doWrite)
-            node = std::static_pointer_cast<SHAMapInnerNode>(
-                writeNode(t, std::move(node)));
+        flush(*level);
+    }
 
-        ++flushed;
+    // The only node in the top level is the root of the flushed subtree
+    auto root = static_pointer_cast<SHAMapInnerNode>(
+        std::move(inners.front().front().node));
 
-        if (stack.empty())
-            break;
+    if (ordered)
+    {
+        auto const store = [&](SHAMapTreeNode const* node, Blob&& blob) {
+            f_.db().store(
+                t,
+                std::move(blob),
+                node->getHash().as_uint256(),
+                ledgerSeq_);
+        };
+
+        // Depth first, parent before children, in branch order. Only nodes
+        // that were just flushed can lead to others that were.
+        std::stack<SHAMapTreeNode*> stack;
+        stack.push(root.get());
+        while (!stack.empty())
+        {
+            auto const node = stack.top();
+            stack.pop();
 
-        auto parent = std::move(stack.top().first);
-        pos = stack.top().second;
-        stack.pop();
+            auto it = held.find(node);
+            if (it == held.end())
+                continue;
+            store(node, std::move(it->second));
+            held.erase(it);
 
-        // Hook this inner node to its parent
-        assert(parent->cowid() == cowid_);
-        parent->shareChild(pos, node);
+            if (!node->isInner())
+                continue;
 
-        // Continue with parent's next child, if any
-        node = std::move(parent);
-        ++pos;
-    }
+            auto const inner = static_cast<SHAMapInnerNode*>(node);
+            for (int branch = branchFactor; branch-- != 0;)
+            {
+                if (inner->isEmptyBranch(branch))
+                    continue;
+                if (auto const child = inner->getChildPointer(branch))
+                    stack.push(child);
+            }
+        }
 
-    // Last inner node is the new root_
-    root_ = std::move(node);
+        // A node that canonicalized to a copy already in the cache hides
+        // the nodes below it from the walk; they still have to be written
+        for (auto& [node, blob] : held)
+            store(node, std::move(blob));
+    }
 
-    return flushed;
+    return root;
 }
 
 void
@@ -1163,10 +1539,11 @@ SHAMap::dump(bool hash) const
     JLOG(journal_.info()) << leafCount << " resident leaves";
 }
 
-std::shared_ptr<SHAMapTreeNode>
+SharedIntrusive<SHAMapTreeNode>
 SHAMap::cacheLookup(SHAMapHash const& hash) const
 {
-    auto ret = f_.getTreeNodeCache(ledgerSeq_)->fetch(hash.as_uint256());
+    auto ret =
+        f_.getTreeNodeCache(ledgerSeq_)->fetch(hash.as_uint256(), ledgerSeq_);
     assert(!ret || !ret->cowid());
     return ret;
 }
@@ -1174,14 +1551,16 @@ SHAMap::cacheLookup(SHAMapHash const& hash) const
 void
 SHAMap::canonicalize(
     SHAMapHash const& hash,
-    std::shared_ptr<SHAMapTreeNode>& node) const
+    SharedIntrusive<SHAMapTreeNode>& node) const
 {
     assert(backed_);
     assert(node->cowid() == 0);
     assert(node->getHash() == hash);
 
+    // Tag the node with our ledger, so that under memory pressure the
+    // nodes that only older ledgers use go first
     f_.getTreeNodeCache(ledgerSeq_)
-        ->canonicalize_replace_client(hash.as_uint256(), node);
+        ->canonicalize_replace_client(hash.as_uint256(), node, ledgerSeq_);
 }
 
 void
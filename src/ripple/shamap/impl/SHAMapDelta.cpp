@@ -21,7 +21,11 @@
 #include <ripple/shamap/SHAMap.h>
 
 #include <array>
+#include <atomic>
+#include <exception>
+#include <mutex>
 #include <stack>
+#include <thread>
 #include <vector>
 
 namespace ripple {
@@ -40,7 +44,7 @@ SHAMap::walkBranch(
     boost::intrusive_ptr<SHAMapItem const> const& otherMapItem,
     bool isFirstMap,
     Delta& differences,
-    int& maxCount) const
+    std::atomic<int>& maxCount) const
 {
     // Walk a branch of a SHAMap that's matched by an empty branch or single
     // item in the other map
@@ -121,7 +125,11 @@ SHAMap::walkBranch(
 }
 
 bool
-SHAMap::compare(SHAMap const& otherMap, Delta& differences, int maxCount) const
+SHAMap::compare(
+    SHAMap const& otherMap,
+    Delta& differences,
+    int maxCount,
+    std::size_t threads) const
 {
     // compare two hash trees, add up to maxCount differences to the difference
     // table return value: true=complete table of differences given, false=too
@@ -133,11 +141,122 @@ SHAMap::compare(SHAMap const& otherMap, Delta& differences, int maxCount) const
     if (getHash() == otherMap.getHash())
         return true;
 
+    // All the workers draw on one budget, so a map that makes no sense
+    // costs no more to compare in parallel than serially
+    std::atomic<int> budget{maxCount};
+
+    if (threads <= 1 || !root_->isInner() || !otherMap.root_->isInner())
+        return compareSubTree(
+            root_.get(), otherMap.root_.get(), otherMap, differences, budget);
+
+    // Items in different branches of the root can't match each other, so
+    // each differing branch can be compared on its own. Every branch gets
+    // its own table, and the tables are merged in branch order once all
+    // are done, so a complete result doesn't depend on how the work was
+    // split.
+    auto const ours = static_cast<SHAMapInnerNode*>(root_.get());
+    auto const other = static_cast<SHAMapInnerNode*>(otherMap.root_.get());
+
+    std::vector<int> branches;
+    branches.reserve(branchFactor);
+    for (int i = 0; i < branchFactor; ++i)
+        if (ours->getChildHash(i) != other->getChildHash(i))
+            branches.push_back(i);
+
+    std::array<Delta, branchFactor> deltas;
+    std::array<bool, branchFactor> complete{};
+
+    std::atomic<std::size_t> next{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    auto const worker = [&]() {
+        try
+        {
+            for (auto i = next++; i < branches.size(); i = next++)
+            {
+                // Another worker used up the budget
+                if (budget.load() <= 0)
+                    break;
+
+                auto const b = branches[i];
+
+                if (other->isEmptyBranch(b))
+                    complete[b] = walkBranch(
+                        descendThrow(ours, b),
+                        nullptr,
+                        true,
+                        deltas[b],
+                        budget);
+                else if (ours->isEmptyBranch(b))
+                    complete[b] = otherMap.walkBranch(
+                        otherMap.descendThrow(other, b),
+                        nullptr,
+                        false,
+                        deltas[b],
+                        budget);
+                else
+                    complete[b] = compareSubTree(
+                        descendThrow(ours, b),
+                        otherMap.descendThrow(other, b),
+                        otherMap,
+                        deltas[b],
+                        budget);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard lock(errorMutex);
+            if (!error)
+                error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    auto const count = std::min(threads, branches.size());
+    if (count > 1)
+        workers.reserve(count - 1);
+    for (std::size_t i = 1; i < count; ++i)
+        workers.emplace_back(worker);
+    worker();
+
+    for (auto& w : workers)
+        w.join();
+
+    if (error)
+        std::rethrow_exception(error);
+
+    // Once the budget ran out, which differences were found depends on
+    // how the workers went, but there are never more than maxCount
+    bool done = true;
+    for (auto const b : branches)
+    {
+        for (auto& difference : deltas[b])
+        {
+            differences.insert(std::move(difference));
+            if (--maxCount <= 0)
+                return false;
+        }
+
+        done = done && complete[b];
+    }
+
+    return done;
+}
+
+bool
+SHAMap::compareSubTree(
+    SHAMapTreeNode* ourRoot,
+    SHAMapTreeNode* otherRoot,
+    SHAMap const& otherMap,
+    Delta& differences,
+    std::atomic<int>& maxCount) const
+{
     using StackEntry = std::pair<SHAMapTreeNode*, SHAMapTreeNode*>;
     std::stack<StackEntry, std::vector<StackEntry>>
         nodeStack;  // track nodes we've pushed
 
-    nodeStack.push({root_.get(), otherMap.root_.get()});
+    nodeStack.push({ourRoot, otherRoot});
     while (!nodeStack.empty())
     {
         auto [ourNode, otherNode] = nodeStack.top();
@@ -239,28 +358,28 @@ SHAMap::walkMap(std::vector<SHAMapMissingNode>& missingNodes, int maxMissing)
     if (!root_->isInner())  // root_ is only node, and we have it
         return;
 
-    using StackEntry = std::shared_ptr<SHAMapInnerNode>;
+    using StackEntry = SharedIntrusive<SHAMapInnerNode>;
     std::stack<StackEntry, std::vector<StackEntry>> nodeStack;
 
-    nodeStack.push(std::static_pointer_cast<SHAMapInnerNode>(root_));
+    nodeStack.push(static_pointer_cast<SHAMapInnerNode>(root_));
 
     while (!nodeStack.empty())
     {
-        std::shared_ptr<SHAMapInnerNode> node = std::move(nodeStack.top());
+        SharedIntrusive<SHAMapInnerNode> node = std::move(nodeStack.top());
         nodeStack.pop();
 
         for (int i = 0; i < 16; ++i)
         {
             if (!node->isEmptyBranch(i))
             {
-                std::shared_ptr<SHAMapTreeNode> nextNode =
+                SharedIntrusive<SHAMapTreeNode> nextNode =
                     descendNoStore(node, i);
 
                 if (nextNode)
                 {
                     if (nextNode->isInner())
                         nodeStack.push(
-                            std::static_pointer_cast<SHAMapInnerNode>(
+                            static_pointer_cast<SHAMapInnerNode>(
                                 nextNode));
                 }
                 else
@@ -282,11 +401,11 @@ SHAMap::walkMapParallel(
     if (!root_->isInner())  // root_ is only node, and we have it
         return false;
 
-    using StackEntry = std::shared_ptr<SHAMapInnerNode>;
-    std::array<std::shared_ptr<SHAMapTreeNode>, 16> topChildren;
+    using StackEntry = SharedIntrusive<SHAMapInnerNode>;
+    std::array<SharedIntrusive<SHAMapTreeNode>, 16> topChildren;
     {
         auto const& innerRoot =
-            std::static_pointer_cast<SHAMapInnerNode>(root_);
+            static_pointer_cast<SHAMapInnerNode>(root_);
         for (int i = 0; i < 16; ++i)
         {
             if (!innerRoot->isEmptyBranch(i))
@@ -311,7 +430,7 @@ SHAMap::walkMapParallel(
             continue;
 
         nodeStacks[rootChildIndex].push(
-            std::static_pointer_cast<SHAMapInnerNode>(child));
+            static_pointer_cast<SHAMapInnerNode>(child));
 
         JLOG(journal_.debug()) << "starting worker " << rootChildIndex;
         workers.push_back(std::thread(
@@ -321,7 +440,7 @@ SHAMap::walkMapParallel(
                 {
                     while (!nodeStack.empty())
                     {
-                        std::shared_ptr<SHAMapInnerNode> node =
+                        SharedIntrusive<SHAMapInnerNode> node =
                             std::move(nodeStack.top());
                         assert(node);
                         nodeStack.pop();
@@ -330,14 +449,15 @@ SHAMap::walkMapParallel(
                         {
                             if (node->isEmptyBranch(i))
                                 continue;
-                            std::shared_ptr<SHAMapTreeNode> nextNode =
+                            SharedIntrusive<SHAMapTreeNode> nextNode =
                                 descendNoStore(node, i);
 
                             if (nextNode)
                             {
                                 if (nextNode->isInner())
-                                    nodeStack.push(std::static_pointer_cast<
-                                                   SHAMapInnerNode>(nextNode));
+                                    nodeStack.push(
+                                        static_pointer_cast<SHAMapInnerNode>(
+                                            nextNode));
                             }
                             else
                             {
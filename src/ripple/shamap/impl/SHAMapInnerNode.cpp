@@ -58,6 +58,14 @@ SHAMapInnerNode::iterNonEmptyChildIndexes(F&& f) const
     hashesAndChildren_.iterNonEmptyChildIndexes(isBranch_, std::forward<F>(f));
 }
 
+void
+SHAMapInnerNode::partialDestructor()
+{
+    auto const children = hashesAndChildren_.getChildren();
+    iterNonEmptyChildIndexes(
+        [&](auto, auto indexNum) { children[indexNum].reset(); });
+}
+
 void
 SHAMapInnerNode::resizeChildArrays(std::uint8_t toAllocate)
 {
@@ -71,17 +79,17 @@ SHAMapInnerNode::getChildIndex(int i) const
     return hashesAndChildren_.getChildIndex(isBranch_, i);
 }
 
-std::shared_ptr<SHAMapTreeNode>
+SharedIntrusive<SHAMapTreeNode>
 SHAMapInnerNode::clone(std::uint32_t cowid) const
 {
     auto const branchCount = getBranchCount();
     auto const thisIsSparse = !hashesAndChildren_.isDense();
-    auto p = std::make_shared<SHAMapInnerNode>(cowid, branchCount);
+    auto p = make_SharedIntrusive<SHAMapInnerNode>(cowid, branchCount);
     p->hash_ = hash_;
     p->isBranch_ = isBranch_;
     p->fullBelowGen_ = fullBelowGen_;
     SHAMapHash *cloneHashes, *thisHashes;
-    std::shared_ptr<SHAMapTreeNode>*cloneChildren, *thisChildren;
+    SharedIntrusive<SHAMapTreeNode>*cloneChildren, *thisChildren;
     // structured bindings can't be captured in c++ 17; use tie instead
     std::tie(std::ignore, cloneHashes, cloneChildren) =
         p->hashesAndChildren_.getHashesAndChildren();
@@ -122,7 +130,7 @@ SHAMapInnerNode::clone(std::uint32_t cowid) const
     return p;
 }
 
-std::shared_ptr<SHAMapTreeNode>
+SharedIntrusive<SHAMapTreeNode>
 SHAMapInnerNode::makeFullInner(
     Slice data,
     SHAMapHash const& hash,
@@ -132,7 +140,7 @@ SHAMapInnerNode::makeFullInner(
     if (data.size() != branchFactor * uint256::bytes)
         Throw<std::runtime_error>("Invalid FI node");
 
-    auto ret = std::make_shared<SHAMapInnerNode>(0, branchFactor);
+    auto ret = make_SharedIntrusive<SHAMapInnerNode>(0, branchFactor);
 
     SerialIter si(data);
 
@@ -156,8 +164,11 @@ SHAMapInnerNode::makeFullInner(
     return ret;
 }
 
-std::shared_ptr<SHAMapTreeNode>
-SHAMapInnerNode::makeCompressedInner(Slice data)
+SharedIntrusive<SHAMapTreeNode>
+SHAMapInnerNode::makeCompressedInner(
+    Slice data,
+    SHAMapHash const& hash,
+    bool hashValid)
 {
     // A compressed inner node is serialized as a series of 33 byte chunks,
     // representing a one byte "position" and a 256-bit hash:
@@ -169,26 +180,31 @@ SHAMapInnerNode::makeCompressedInner(Slice data)
 
     SerialIter si(data);
 
-    auto ret = std::make_shared<SHAMapInnerNode>(0, branchFactor);
+    auto ret = make_SharedIntrusive<SHAMapInnerNode>(0, branchFactor);
 
     auto hashes = ret->hashesAndChildren_.getHashes();
 
     while (!si.empty())
     {
-        auto const hash = si.getBitString<256>();
+        auto const childHash = si.getBitString<256>();
         auto const pos = si.get8();
 
         if (pos >= branchFactor)
             Throw<std::runtime_error>("invalid CI node");
 
-        hashes[pos].as_uint256() = hash;
+        hashes[pos].as_uint256() = childHash;
 
         if (hashes[pos].isNonZero())
             ret->isBranch_ |= (1 << pos);
     }
 
     ret->resizeChildArrays(ret->getBranchCount());
-    ret->updateHash();
+
+    if (hashValid)
+        ret->hash_ = hash;
+    else
+        ret->updateHash();
+
     return ret;
 }
 
@@ -209,9 +225,16 @@ SHAMapInnerNode::updateHash()
 
 void
 SHAMapInnerNode::updateHashDeep()
+{
+    updateChildHashes();
+    updateHash();
+}
+
+void
+SHAMapInnerNode::updateChildHashes()
 {
     SHAMapHash* hashes;
-    std::shared_ptr<SHAMapTreeNode>* children;
+    SharedIntrusive<SHAMapTreeNode>* children;
     // structured bindings can't be captured in c++ 17; use tie instead
     std::tie(std::ignore, hashes, children) =
         hashesAndChildren_.getHashesAndChildren();
@@ -219,7 +242,6 @@ SHAMapInnerNode::updateHashDeep()
         if (children[indexNum] != nullptr)
             hashes[indexNum] = children[indexNum]->getHash();
     });
-    updateHash();
 }
 
 void
@@ -272,7 +294,7 @@ SHAMapInnerNode::getString(const SHAMapNodeID& id) const
 
 // We are modifying an inner node
 void
-SHAMapInnerNode::setChild(int m, std::shared_ptr<SHAMapTreeNode> child)
+SHAMapInnerNode::setChild(int m, SharedIntrusive<SHAMapTreeNode> child)
 {
     assert((m >= 0) && (m < branchFactor));
     assert(cowid_ != 0);
@@ -308,7 +330,7 @@ SHAMapInnerNode::setChild(int m, std::shared_ptr<SHAMapTreeNode> child)
 
 // finished modifying, now make shareable
 void
-SHAMapInnerNode::shareChild(int m, std::shared_ptr<SHAMapTreeNode> const& child)
+SHAMapInnerNode::shareChild(int m, SharedIntrusive<SHAMapTreeNode> const& child)
 {
     assert((m >= 0) && (m < branchFactor));
     assert(cowid_ != 0);
@@ -332,7 +354,7 @@ SHAMapInnerNode::getChildPointer(int branch)
     return hashesAndChildren_.getChildren()[index].get();
 }
 
-std::shared_ptr<SHAMapTreeNode>
+SharedIntrusive<SHAMapTreeNode>
 SHAMapInnerNode::getChild(int branch)
 {
     assert(branch >= 0 && branch < branchFactor);
@@ -355,10 +377,10 @@ SHAMapInnerNode::getChildHash(int m) const
     return zeroSHAMapHash;
 }
 
-std::shared_ptr<SHAMapTreeNode>
+SharedIntrusive<SHAMapTreeNode>
 SHAMapInnerNode::canonicalizeChild(
     int branch,
-    std::shared_ptr<SHAMapTreeNode> node)
+    SharedIntrusive<SHAMapTreeNode> node)
 {
     assert(branch >= 0 && branch < branchFactor);
     assert(node);
@@ -383,6 +405,15 @@ SHAMapInnerNode::canonicalizeChild(
     return node;
 }
 
+std::size_t
+SHAMapInnerNode::memoryUsage() const
+{
+    // Each allocated slot holds a child hash and a child pointer
+    return sizeof(SHAMapInnerNode) +
+        hashesAndChildren_.capacity() *
+        (sizeof(SHAMapHash) + sizeof(SharedIntrusive<SHAMapTreeNode>));
+}
+
 void
 SHAMapInnerNode::invariants(bool is_root) const
 {
@@ -40,6 +40,12 @@ SHAMapLeafNode::SHAMapLeafNode(
     assert(item_->size() >= 12);
 }
 
+void
+SHAMapLeafNode::partialDestructor()
+{
+    item_.reset();
+}
+
 boost::intrusive_ptr<SHAMapItem const> const&
 SHAMapLeafNode::peekItem() const
 {
@@ -91,4 +97,16 @@ SHAMapLeafNode::invariants(bool) const
     assert(item_ != nullptr);
 }
 
+std::size_t
+SHAMapLeafNode::memoryUsage() const
+{
+    // The derived leaf types add no members
+    std::size_t bytes = sizeof(SHAMapLeafNode);
+
+    if (item_)
+        bytes += sizeof(SHAMapItem) + item_->size();
+
+    return bytes;
+}
+
 }  // namespace ripple
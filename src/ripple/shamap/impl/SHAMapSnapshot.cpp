@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Log.h>
+#include <ripple/basics/contract.h>
+#include <ripple/protocol/Serializer.h>
+#include <ripple/shamap/SHAMapInnerNode.h>
+#include <ripple/shamap/SHAMapSnapshot.h>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <array>
+#include <cstring>
+#include <fstream>
+
+namespace ripple {
+
+namespace {
+
+// "RSMS", then the layout version.
+constexpr std::uint32_t snapshotMagic = 0x52534d53;
+constexpr std::uint32_t snapshotVersion = 1;
+
+// Where the node count sits in the header.
+constexpr std::streamoff countOffset = 3 * 4 + uint256::bytes;
+
+// How much to buffer before writing to the file.
+constexpr std::size_t chunkSize = 1024 * 1024;
+
+constexpr int branchFactor = SHAMapInnerNode::branchFactor;
+
+}  // namespace
+
+std::uint64_t
+writeSHAMapSnapshot(
+    SHAMap const& map,
+    std::uint32_t ledgerSeq,
+    boost::filesystem::path const& path)
+{
+    auto const temp = boost::filesystem::path(path) += ".tmp";
+
+    std::ofstream out(temp.string(), std::ios::binary | std::ios::trunc);
+    if (!out)
+        Throw<std::runtime_error>("unable to create " + temp.string());
+
+    Serializer s(chunkSize + 2 * branchFactor * uint256::bytes);
+    auto const flush = [&]() {
+        out.write(static_cast<char const*>(s.getDataPtr()), s.size());
+        s.erase();
+    };
+
+    s.add32(snapshotMagic);
+    s.add32(snapshotVersion);
+    s.add32(ledgerSeq);
+    s.addBitString(map.getHash().as_uint256());
+    s.add64(0);
+
+    std::uint64_t nodes = 0;
+    map.visitResidentInnerNodes([&](SHAMapInnerNode const& node) {
+        std::uint16_t mask = 0;
+        for (int i = 0; i < branchFactor; ++i)
+        {
+            if (!node.isEmptyBranch(i))
+                mask |= 1 << i;
+        }
+
+        s.add16(mask);
+        for (int i = 0; i < branchFactor; ++i)
+        {
+            if (mask & (1 << i))
+                s.addBitString(node.getChildHash(i).as_uint256());
+        }
+
+        ++nodes;
+        if (s.size() >= chunkSize)
+            flush();
+    });
+    flush();
+
+    // Now that the count is known, fill it in
+    out.seekp(countOffset);
+    s.add64(nodes);
+    flush();
+
+    out.close();
+    if (!out)
+        Throw<std::runtime_error>("unable to write " + temp.string());
+
+    boost::filesystem::rename(temp, path);
+    return nodes;
+}
+
+std::optional<SHAMapSnapshot>
+loadSHAMapSnapshot(
+    boost::filesystem::path const& path,
+    TreeNodeCache& cache,
+    beast::Journal j)
+{
+    namespace bip = boost::interprocess;
+
+    boost::system::error_code ec;
+    if (!boost::filesystem::is_regular_file(path, ec))
+        return std::nullopt;
+
+    SHAMapSnapshot snapshot;
+    try
+    {
+        bip::file_mapping const file(path.string().c_str(), bip::read_only);
+        bip::mapped_region const region(file, bip::read_only);
+        SerialIter sit(region.get_address(), region.get_size());
+
+        if (sit.get32() != snapshotMagic || sit.get32() != snapshotVersion)
+        {
+            JLOG(j.warn()) << path.string() << " is not a state snapshot";
+            return std::nullopt;
+        }
+
+        snapshot.ledgerSeq = sit.get32();
+        snapshot.rootHash = sit.get256();
+        auto const count = sit.get64();
+
+        std::array<std::uint8_t, branchFactor * uint256::bytes> full;
+        for (; snapshot.nodes < count; ++snapshot.nodes)
+        {
+            auto const mask = sit.get16();
+
+            full.fill(0);
+            for (int i = 0; i < branchFactor; ++i)
+            {
+                if (mask & (1 << i))
+                {
+                    auto const child = sit.get256();
+                    std::memcpy(
+                        full.data() + i * uint256::bytes,
+                        child.data(),
+                        uint256::bytes);
+                }
+            }
+
+            auto node = SHAMapInnerNode::makeFullInner(
+                Slice(full.data(), full.size()), SHAMapHash{}, false);
+            cache.canonicalize_replace_client(
+                node->getHash().as_uint256(), node, snapshot.ledgerSeq);
+        }
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j.warn()) << "Unable to load state snapshot " << path.string()
+                       << " after " << snapshot.nodes
+                       << " nodes: " << e.what();
+        return std::nullopt;
+    }
+
+    return snapshot;
+}
+
+}  // namespace ripple
@@ -20,6 +20,8 @@
 #include <ripple/basics/random.h>
 #include <ripple/shamap/SHAMap.h>
 #include <ripple/shamap/SHAMapSyncFilter.h>
+#include <algorithm>
+#include <functional>
 
 namespace ripple {
 
@@ -28,140 +30,83 @@ SHAMap::visitLeaves(
     std::function<void(boost::intrusive_ptr<SHAMapItem const> const&
                            item)> const& leafFunction) const
 {
-    visitNodes([&leafFunction](SHAMapTreeNode& node) {
-        if (!node.isInner())
-            leafFunction(static_cast<SHAMapLeafNode&>(node).peekItem());
-        return true;
-    });
+    visitLeaves<decltype(leafFunction)>(leafFunction);
 }
 
 void
 SHAMap::visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const
 {
-    if (!root_)
-        return;
-
-    function(*root_);
+    visitNodes<decltype(function)>(function);
+}
 
-    if (!root_->isInner())
+void
+SHAMap::visitResidentInnerNodes(
+    std::function<void(SHAMapInnerNode const&)> const& function) const
+{
+    if (!root_ || !root_->isInner())
         return;
 
-    using StackEntry = std::pair<int, std::shared_ptr<SHAMapInnerNode>>;
-    std::stack<StackEntry, std::vector<StackEntry>> stack;
-
-    auto node = std::static_pointer_cast<SHAMapInnerNode>(root_);
-    int pos = 0;
+    std::vector<SharedIntrusive<SHAMapInnerNode>> stack;
+    stack.push_back(static_pointer_cast<SHAMapInnerNode>(root_));
 
-    while (true)
+    while (!stack.empty())
     {
-        while (pos < 16)
-        {
-            if (!node->isEmptyBranch(pos))
-            {
-                std::shared_ptr<SHAMapTreeNode> child =
-                    descendNoStore(node, pos);
-                if (!function(*child))
-                    return;
+        auto node = std::move(stack.back());
+        stack.pop_back();
 
-                if (child->isLeaf())
-                    ++pos;
-                else
-                {
-                    // If there are no more children, don't push this node
-                    while ((pos != 15) && (node->isEmptyBranch(pos + 1)))
-                        ++pos;
+        function(*node);
 
-                    if (pos != 15)
-                    {
-                        // save next position to resume at
-                        stack.push(std::make_pair(pos + 1, std::move(node)));
-                    }
+        for (int i = 0; i < branchFactor; ++i)
+        {
+            if (node->isEmptyBranch(i))
+                continue;
 
-                    // descend to the child's first position
-                    node = std::static_pointer_cast<SHAMapInnerNode>(child);
-                    pos = 0;
-                }
-            }
-            else
-            {
-                ++pos;  // move to next position
-            }
+            if (auto child = node->getChild(i); child && child->isInner())
+                stack.push_back(
+                    static_pointer_cast<SHAMapInnerNode>(std::move(child)));
         }
-
-        if (stack.empty())
-            break;
-
-        std::tie(pos, node) = stack.top();
-        stack.pop();
     }
 }
 
-void
-SHAMap::visitDifferences(
-    SHAMap const* have,
-    std::function<bool(SHAMapTreeNode const&)> const& function) const
+std::vector<SharedIntrusive<SHAMapInnerNode>>
+SHAMap::getTopInnerNodes(int depth) const
 {
-    // Visit every node in this SHAMap that is not present
-    // in the specified SHAMap
-    if (!root_)
-        return;
+    std::vector<SharedIntrusive<SHAMapInnerNode>> nodes;
+    if (!root_ || !root_->isInner())
+        return nodes;
 
-    if (root_->getHash().isZero())
-        return;
+    nodes.push_back(static_pointer_cast<SHAMapInnerNode>(root_));
 
-    if (have && (root_->getHash() == have->root_->getHash()))
-        return;
-
-    if (root_->isLeaf())
+    // Each level is appended after the one above it
+    std::size_t begin = 0;
+    for (int level = 0; level < depth; ++level)
     {
-        auto leaf = std::static_pointer_cast<SHAMapLeafNode>(root_);
-        if (!have ||
-            !have->hasLeafNode(leaf->peekItem()->key(), leaf->getHash()))
-            function(*root_);
-        return;
-    }
-    // contains unexplored non-matching inner node entries
-    using StackEntry = std::pair<SHAMapInnerNode*, SHAMapNodeID>;
-    std::stack<StackEntry, std::vector<StackEntry>> stack;
-
-    stack.push({static_cast<SHAMapInnerNode*>(root_.get()), SHAMapNodeID{}});
-
-    while (!stack.empty())
-    {
-        auto const [node, nodeID] = stack.top();
-        stack.pop();
-
-        // 1) Add this node to the pack
-        if (!function(*node))
-            return;
-
-        // 2) push non-matching child inner nodes
-        for (int i = 0; i < 16; ++i)
+        std::size_t const end = nodes.size();
+        for (std::size_t i = begin; i != end; ++i)
         {
-            if (!node->isEmptyBranch(i))
+            for (int branch = 0; branch < branchFactor; ++branch)
             {
-                auto const& childHash = node->getChildHash(i);
-                SHAMapNodeID childID = nodeID.getChildNodeID(i);
-                auto next = descendThrow(node, i);
+                if (nodes[i]->isEmptyBranch(branch))
+                    continue;
 
-                if (next->isInner())
-                {
-                    if (!have || !have->hasInnerNode(childID, childHash))
-                        stack.push(
-                            {static_cast<SHAMapInnerNode*>(next), childID});
-                }
-                else if (
-                    !have ||
-                    !have->hasLeafNode(
-                        static_cast<SHAMapLeafNode*>(next)->peekItem()->key(),
-                        childHash))
-                {
-                    if (!function(*next))
-                        return;
-                }
+                if (auto child = nodes[i]->getChild(branch);
+                    child && child->isInner())
+                    nodes.push_back(
+                        static_pointer_cast<SHAMapInnerNode>(std::move(child)));
             }
         }
+        begin = end;
     }
+
+    return nodes;
+}
+
+void
+SHAMap::visitDifferences(
+    SHAMap const* have,
+    std::function<bool(SHAMapTreeNode const&)> const& function) const
+{
+    visitDifferences<decltype(function)>(have, function);
 }
 
 // Starting at the position referred to by the specfied
@@ -185,15 +130,34 @@ SHAMap::gmn_ProcessNodes(MissingNodes& mn, MissingNodes::StackEntry& se)
 
         auto const& childHash = node->getChildHash(branch);
 
+        // A child that is in memory says for itself whether anything is
+        // missing below it, so the full below cache is only consulted for
+        // children that are not.
+        auto const child = node->getChildPointer(branch);
+        if (child &&
+            (child->isLeaf() ||
+             static_cast<SHAMapInnerNode*>(child)->isFullBelow(
+                 mn.generation_)))
+        {
+            continue;
+        }
+
         if (mn.missingHashes_.count(childHash) != 0)
         {
             // we already know this child node is missing
             fullBelow = false;
         }
         else if (
-            !backed_ ||
-            !f_.getFullBelowCache(ledgerSeq_)
-                 ->touch_if_exists(childHash.as_uint256()))
+            backed_ &&
+            f_.getFullBelowCache(ledgerSeq_)
+                ->touch_if_exists(childHash.as_uint256()))
+        {
+            // Remember it in the node, if we have it, for the next visit
+            if (child)
+                static_cast<SHAMapInnerNode*>(child)->setFullBelowGen(
+                    mn.generation_);
+        }
+        else
         {
             bool pending = false;
             auto d = descendAsync(
@@ -202,7 +166,7 @@ SHAMap::gmn_ProcessNodes(MissingNodes& mn, MissingNodes::StackEntry& se)
                 mn.filter_,
                 pending,
                 [node, nodeID, branch, &mn](
-                    std::shared_ptr<SHAMapTreeNode> found, SHAMapHash const&) {
+                    SharedIntrusive<SHAMapTreeNode> found, SHAMapHash const&) {
                     // a read completed asynchronously
                     std::unique_lock<std::mutex> lock{mn.deferLock_};
                     mn.finishedReads_.emplace_back(
@@ -272,7 +236,7 @@ SHAMap::gmn_ProcessDeferredReads(MissingNodes& mn)
             SHAMapInnerNode*,
             SHAMapNodeID,
             int,
-            std::shared_ptr<SHAMapTreeNode>>
+            SharedIntrusive<SHAMapTreeNode>>
             deferredNode;
         {
             std::unique_lock<std::mutex> lock{mn.deferLock_};
@@ -326,7 +290,7 @@ SHAMap::getMissingNodes(int max, SHAMapSyncFilter* filter)
         f_.getFullBelowCache(ledgerSeq_)->getGeneration());
 
     if (!root_->isInner() ||
-        std::static_pointer_cast<SHAMapInnerNode>(root_)->isFullBelow(
+        static_pointer_cast<SHAMapInnerNode>(root_)->isFullBelow(
             mn.generation_))
     {
         clearSynching();
@@ -539,7 +503,7 @@ SHAMap::addRootNode(
     }
 
     assert(cowid_ >= 1);
-    auto node = SHAMapTreeNode::makeFromWire(rootNode);
+    auto node = SHAMapTreeNode::makeFromWire(rootNode, arena_.get());
     if (!node || node->getHash() != hash)
         return SHAMapAddNode::invalid();
 
@@ -571,6 +535,67 @@ SHAMap::addKnownNode(
     const SHAMapNodeID& node,
     Slice const& rawNode,
     SHAMapSyncFilter* filter)
+{
+    return addKnownNodeWith(
+        node,
+        [this, &rawNode]() {
+            return SHAMapTreeNode::makeFromWire(rawNode, arena_.get());
+        },
+        filter);
+}
+
+SHAMapAddNode
+SHAMap::addKnownNodes(
+    std::span<std::pair<SHAMapNodeID, Slice> const> nodes,
+    SHAMapSyncFilter* filter)
+{
+    std::vector<Slice> rawNodes;
+    rawNodes.reserve(nodes.size());
+    for (auto const& node : nodes)
+        rawNodes.push_back(node.second);
+
+    auto parsed = parseNodes(rawNodes);
+
+    std::vector<std::pair<SHAMapNodeID, SharedIntrusive<SHAMapTreeNode>>>
+        prepared;
+    prepared.reserve(nodes.size());
+    for (std::size_t i = 0; i != nodes.size(); ++i)
+        prepared.emplace_back(nodes[i].first, std::move(parsed[i]));
+
+    return addKnownNodes(prepared, filter);
+}
+
+std::vector<SharedIntrusive<SHAMapTreeNode>>
+SHAMap::parseNodes(std::span<Slice const> rawNodes) const
+{
+    return SHAMapTreeNode::makeFromWire(rawNodes, arena_.get());
+}
+
+SHAMapAddNode
+SHAMap::addKnownNodes(
+    std::span<std::pair<SHAMapNodeID, SharedIntrusive<SHAMapTreeNode>>> nodes,
+    SHAMapSyncFilter* filter)
+{
+    SHAMapAddNode san;
+
+    for (auto& [nodeID, node] : nodes)
+    {
+        san += addKnownNodeWith(
+            nodeID, [&node = node]() { return std::move(node); }, filter);
+
+        if (!san.isGood())
+            break;
+    }
+
+    return san;
+}
+
+template <class MakeNode>
+SHAMapAddNode
+SHAMap::addKnownNodeWith(
+    SHAMapNodeID const& node,
+    MakeNode&& makeNode,
+    SHAMapSyncFilter* filter)
 {
     assert(!node.isRoot());
 
@@ -597,8 +622,11 @@ SHAMap::addKnownNode(
             return SHAMapAddNode::invalid();
         }
 
+        // A child in memory is checked by the loop itself, through its
+        // full below mark, so only absent children need the cache.
         auto childHash = inner->getChildHash(branch);
-        if (f_.getFullBelowCache(ledgerSeq_)
+        if (!inner->getChildPointer(branch) &&
+            f_.getFullBelowCache(ledgerSeq_)
                 ->touch_if_exists(childHash.as_uint256()))
         {
             return SHAMapAddNode::duplicate();
@@ -609,7 +637,7 @@ SHAMap::addKnownNode(
 
         if (iNode == nullptr)
         {
-            auto newNode = SHAMapTreeNode::makeFromWire(rawNode);
+            SharedIntrusive<SHAMapTreeNode> newNode = makeNode();
 
             if (!newNode || childHash != newNode->getHash())
             {
@@ -800,7 +828,7 @@ SHAMap::getProofPath(uint256 const& key) const
     }
 
     if (auto const& node = stack.top().first; !node || node->isInner() ||
-        std::static_pointer_cast<SHAMapLeafNode>(node)->peekItem()->key() !=
+        static_pointer_cast<SHAMapLeafNode>(node)->peekItem()->key() !=
             key)
     {
         JLOG(journal_.debug()) << "no path to " << key;
@@ -867,4 +895,188 @@ SHAMap::verifyProofPath(
     return false;
 }
 
+std::optional<std::vector<Blob>>
+SHAMap::getProofPaths(std::vector<uint256> const& keys) const
+{
+    if (keys.empty() ||
+        std::adjacent_find(keys.begin(), keys.end(), std::greater_equal{}) !=
+            keys.end())
+    {
+        JLOG(journal_.debug()) << "getProofPaths: keys not strictly sorted";
+        return {};
+    }
+
+    // A node still to be written out, with the keys whose paths run
+    // through it: [first, last)
+    struct Pending
+    {
+        SHAMapTreeNode* node;
+        SHAMapNodeID nodeID;
+        std::size_t first;
+        std::size_t last;
+    };
+
+    std::vector<Blob> nodes;
+    std::vector<Pending> stack{{root_.get(), SHAMapNodeID{}, 0, keys.size()}};
+    while (!stack.empty())
+    {
+        auto const [node, nodeID, first, last] = stack.back();
+        stack.pop_back();
+
+        Serializer s;
+        node->serializeForWire(s);
+        nodes.emplace_back(std::move(s.modData()));
+
+        if (node->isLeaf())
+        {
+            auto const leaf = static_cast<SHAMapLeafNode*>(node);
+            if (last - first != 1 || leaf->peekItem()->key() != keys[first])
+            {
+                JLOG(journal_.debug()) << "no path to " << keys[first];
+                return {};
+            }
+            continue;
+        }
+
+        // The sorted keys that share this node fall into its branches in
+        // runs. Push the runs last to first, so the lowest branch comes
+        // out of the stack first.
+        auto const inner = static_cast<SHAMapInnerNode*>(node);
+        auto const mark = stack.size();
+        for (auto i = first; i != last;)
+        {
+            auto const branch = selectBranch(nodeID, keys[i]);
+            auto j = i + 1;
+            while (j != last && selectBranch(nodeID, keys[j]) == branch)
+                ++j;
+
+            if (inner->isEmptyBranch(branch))
+            {
+                JLOG(journal_.debug()) << "no path to " << keys[i];
+                return {};
+            }
+
+            stack.push_back(
+                {descendThrow(inner, branch),
+                 nodeID.getChildNodeID(branch),
+                 i,
+                 j});
+            i = j;
+        }
+        std::reverse(stack.begin() + mark, stack.end());
+    }
+
+    JLOG(journal_.debug()) << "getProofPaths for " << keys.size()
+                           << " keys, " << nodes.size() << " nodes";
+    return nodes;
+}
+
+bool
+SHAMap::verifyProofPaths(
+    uint256 const& rootHash,
+    std::vector<uint256> const& keys,
+    std::vector<Blob> const& nodes)
+{
+    if (keys.empty() || nodes.empty() ||
+        std::adjacent_find(keys.begin(), keys.end(), std::greater_equal{}) !=
+            keys.end())
+        return false;
+
+    // A node expected next, with the keys whose paths run through it
+    struct Pending
+    {
+        SHAMapHash hash;
+        unsigned int depth;
+        std::size_t first;
+        std::size_t last;
+    };
+
+    std::vector<Pending> stack{{SHAMapHash{rootHash}, 0, 0, keys.size()}};
+    auto next = nodes.begin();
+    try
+    {
+        while (!stack.empty())
+        {
+            if (next == nodes.end())
+                return false;
+
+            auto const [hash, depth, first, last] = stack.back();
+            stack.pop_back();
+
+            auto node = SHAMapTreeNode::makeFromWire(makeSlice(*next++));
+            if (!node)
+                return false;
+            node->updateHash();
+            if (node->getHash() != hash)
+                return false;
+
+            if (node->isLeaf())
+            {
+                auto const leaf = static_cast<SHAMapLeafNode*>(node.get());
+                if (last - first != 1 ||
+                    leaf->peekItem()->key() != keys[first])
+                    return false;
+                continue;
+            }
+
+            if (depth >= leafDepth)
+                return false;
+
+            auto const inner = static_cast<SHAMapInnerNode*>(node.get());
+            auto const nodeID = SHAMapNodeID::createID(depth, keys[first]);
+            auto const mark = stack.size();
+            for (auto i = first; i != last;)
+            {
+                auto const branch = selectBranch(nodeID, keys[i]);
+                auto j = i + 1;
+                while (j != last && selectBranch(nodeID, keys[j]) == branch)
+                    ++j;
+
+                if (inner->isEmptyBranch(branch))
+                    return false;
+
+                stack.push_back(
+                    {inner->getChildHash(branch), depth + 1, i, j});
+                i = j;
+            }
+            std::reverse(stack.begin() + mark, stack.end());
+        }
+    }
+    catch (std::exception const&)
+    {
+        // the nodes may come from the network,
+        // exception could be thrown when parsing the data
+        return false;
+    }
+
+    // should exhaust all the nodes now
+    return next == nodes.end();
+}
+
+Blob
+SHAMap::serializeProofPaths(std::vector<Blob> const& nodes)
+{
+    Serializer s;
+    for (auto const& node : nodes)
+        s.addVL(node);
+    return std::move(s.modData());
+}
+
+std::optional<std::vector<Blob>>
+SHAMap::deserializeProofPaths(Slice const& data)
+{
+    std::vector<Blob> nodes;
+    try
+    {
+        SerialIter sit(data);
+        while (!sit.empty())
+            nodes.push_back(sit.getVL());
+    }
+    catch (std::exception const&)
+    {
+        return {};
+    }
+    return nodes;
+}
+
 }  // namespace ripple
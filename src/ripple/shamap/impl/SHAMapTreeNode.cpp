@@ -36,26 +36,41 @@
 
 namespace ripple {
 
-std::shared_ptr<SHAMapTreeNode>
+namespace {
+
+boost::intrusive_ptr<SHAMapItem>
+makeItem(SHAMapItemArena* arena, uint256 const& tag, Slice data)
+{
+    if (arena)
+        return make_shamapitem(*arena, tag, data);
+
+    return make_shamapitem(tag, data);
+}
+
+}  // namespace
+
+SharedIntrusive<SHAMapTreeNode>
 SHAMapTreeNode::makeTransaction(
     Slice data,
     SHAMapHash const& hash,
-    bool hashValid)
+    bool hashValid,
+    SHAMapItemArena* arena)
 {
-    auto item =
-        make_shamapitem(sha512Half(HashPrefix::transactionID, data), data);
+    auto item = makeItem(
+        arena, sha512Half(HashPrefix::transactionID, data), data);
 
     if (hashValid)
-        return std::make_shared<SHAMapTxLeafNode>(std::move(item), 0, hash);
+        return make_SharedIntrusive<SHAMapTxLeafNode>(std::move(item), 0, hash);
 
-    return std::make_shared<SHAMapTxLeafNode>(std::move(item), 0);
+    return make_SharedIntrusive<SHAMapTxLeafNode>(std::move(item), 0);
 }
 
-std::shared_ptr<SHAMapTreeNode>
+SharedIntrusive<SHAMapTreeNode>
 SHAMapTreeNode::makeTransactionWithMeta(
     Slice data,
     SHAMapHash const& hash,
-    bool hashValid)
+    bool hashValid,
+    SHAMapItemArena* arena)
 {
     Serializer s(data.data(), data.size());
 
@@ -71,20 +86,21 @@ SHAMapTreeNode::makeTransactionWithMeta(
 
     s.chop(tag.bytes);
 
-    auto item = make_shamapitem(tag, s.slice());
+    auto item = makeItem(arena, tag, s.slice());
 
     if (hashValid)
-        return std::make_shared<SHAMapTxPlusMetaLeafNode>(
+        return make_SharedIntrusive<SHAMapTxPlusMetaLeafNode>(
             std::move(item), 0, hash);
 
-    return std::make_shared<SHAMapTxPlusMetaLeafNode>(std::move(item), 0);
+    return make_SharedIntrusive<SHAMapTxPlusMetaLeafNode>(std::move(item), 0);
 }
 
-std::shared_ptr<SHAMapTreeNode>
+SharedIntrusive<SHAMapTreeNode>
 SHAMapTreeNode::makeAccountState(
     Slice data,
     SHAMapHash const& hash,
-    bool hashValid)
+    bool hashValid,
+    SHAMapItemArena* arena)
 {
     Serializer s(data.data(), data.size());
 
@@ -103,17 +119,74 @@ SHAMapTreeNode::makeAccountState(
     if (tag.isZero())
         Throw<std::runtime_error>("Invalid AS node");
 
-    auto item = make_shamapitem(tag, s.slice());
+    auto item = makeItem(arena, tag, s.slice());
 
     if (hashValid)
-        return std::make_shared<SHAMapAccountStateLeafNode>(
+        return make_SharedIntrusive<SHAMapAccountStateLeafNode>(
             std::move(item), 0, hash);
 
-    return std::make_shared<SHAMapAccountStateLeafNode>(std::move(item), 0);
+    return make_SharedIntrusive<SHAMapAccountStateLeafNode>(std::move(item), 0);
 }
 
-std::shared_ptr<SHAMapTreeNode>
-SHAMapTreeNode::makeFromWire(Slice rawNode)
+SharedIntrusive<SHAMapTreeNode>
+SHAMapTreeNode::makeFromWire(Slice rawNode, SHAMapItemArena* arena)
+{
+    return makeFromWire(rawNode, false, arena);
+}
+
+std::vector<SharedIntrusive<SHAMapTreeNode>>
+SHAMapTreeNode::makeFromWire(
+    std::span<Slice const> rawNodes,
+    SHAMapItemArena* arena)
+{
+    std::vector<SharedIntrusive<SHAMapTreeNode>> nodes;
+    nodes.reserve(rawNodes.size());
+
+    // Which nodes still need their hash and what it covers
+    std::vector<std::size_t> pending;
+    std::vector<Serializer> data;
+    pending.reserve(rawNodes.size());
+    data.reserve(rawNodes.size());
+
+    for (auto const& rawNode : rawNodes)
+    {
+        // Build the node with a placeholder hash; the real one follows
+        auto node = makeFromWire(rawNode, true, arena);
+
+        if (node && node->isInner() &&
+            static_cast<SHAMapInnerNode*>(node.get())->isEmpty())
+        {
+            // An empty inner node has no prefixed serialization
+            node->updateHash();
+        }
+        else if (node)
+        {
+            pending.push_back(nodes.size());
+            node->serializeWithPrefix(data.emplace_back());
+        }
+
+        nodes.push_back(std::move(node));
+    }
+
+    std::vector<Slice> messages;
+    messages.reserve(data.size());
+    for (auto const& s : data)
+        messages.push_back(s.slice());
+
+    std::vector<uint256> digests(messages.size());
+    sha512HalfBatch(messages, digests);
+
+    for (std::size_t i = 0; i != pending.size(); ++i)
+        nodes[pending[i]]->setHash(SHAMapHash{digests[i]});
+
+    return nodes;
+}
+
+SharedIntrusive<SHAMapTreeNode>
+SHAMapTreeNode::makeFromWire(
+    Slice rawNode,
+    bool hashValid,
+    SHAMapItemArena* arena)
 {
     if (rawNode.empty())
         return {};
@@ -122,30 +195,33 @@ SHAMapTreeNode::makeFromWire(Slice rawNode)
 
     rawNode.remove_suffix(1);
 
-    bool const hashValid = false;
+    // If the hash is valid, the caller will set it
     SHAMapHash const hash;
 
     if (type == wireTypeTransaction)
-        return makeTransaction(rawNode, hash, hashValid);
+        return makeTransaction(rawNode, hash, hashValid, arena);
 
     if (type == wireTypeAccountState)
-        return makeAccountState(rawNode, hash, hashValid);
+        return makeAccountState(rawNode, hash, hashValid, arena);
 
     if (type == wireTypeInner)
         return SHAMapInnerNode::makeFullInner(rawNode, hash, hashValid);
 
     if (type == wireTypeCompressedInner)
-        return SHAMapInnerNode::makeCompressedInner(rawNode);
+        return SHAMapInnerNode::makeCompressedInner(rawNode, hash, hashValid);
 
     if (type == wireTypeTransactionWithMeta)
-        return makeTransactionWithMeta(rawNode, hash, hashValid);
+        return makeTransactionWithMeta(rawNode, hash, hashValid, arena);
 
     Throw<std::runtime_error>(
         "wire: Unknown type (" + std::to_string(type) + ")");
 }
 
-std::shared_ptr<SHAMapTreeNode>
-SHAMapTreeNode::makeFromPrefix(Slice rawNode, SHAMapHash const& hash)
+SharedIntrusive<SHAMapTreeNode>
+SHAMapTreeNode::makeFromPrefix(
+    Slice rawNode,
+    SHAMapHash const& hash,
+    SHAMapItemArena* arena)
 {
     if (rawNode.size() < 4)
         Throw<std::runtime_error>("prefix: short node");
@@ -163,16 +239,16 @@ SHAMapTreeNode::makeFromPrefix(Slice rawNode, SHAMapHash const& hash)
     bool const hashValid = true;
 
     if (type == HashPrefix::transactionID)
-        return makeTransaction(rawNode, hash, hashValid);
+        return makeTransaction(rawNode, hash, hashValid, arena);
 
     if (type == HashPrefix::leafNode)
-        return makeAccountState(rawNode, hash, hashValid);
+        return makeAccountState(rawNode, hash, hashValid, arena);
 
     if (type == HashPrefix::innerNode)
         return SHAMapInnerNode::makeFullInner(rawNode, hash, hashValid);
 
     if (type == HashPrefix::txNode)
-        return makeTransactionWithMeta(rawNode, hash, hashValid);
+        return makeTransactionWithMeta(rawNode, hash, hashValid, arena);
 
     Throw<std::runtime_error>(
         "prefix: unknown type (" +
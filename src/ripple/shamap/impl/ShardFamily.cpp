@@ -22,6 +22,7 @@
 #include <ripple/app/main/Tuning.h>
 #include <ripple/nodestore/DatabaseShard.h>
 #include <ripple/shamap/ShardFamily.h>
+#include <algorithm>
 #include <tuple>
 
 namespace ripple {
@@ -88,6 +89,7 @@ ShardFamily::getTreeNodeCache(std::uint32_t ledgerSeq)
         tnTargetAge_,
         stopwatch(),
         j_)};
+    scaleTreeNodeCache(*tnCache);
     return tnCache_.emplace(shardIndex, std::move(tnCache)).first->second;
 }
 
@@ -105,6 +107,49 @@ ShardFamily::getTreeNodeCacheSize()
     return {cacheSz, trackSz};
 }
 
+std::pair<std::uint64_t, std::uint64_t>
+ShardFamily::getTreeNodeCacheLookups()
+{
+    std::lock_guard lock(tnCacheMutex_);
+    auto lookups{tnRemovedLookups_};
+    for (auto const& e : tnCache_)
+    {
+        auto const [hits, misses] = e.second->getLookups();
+        lookups.first += hits;
+        lookups.second += misses;
+    }
+    return lookups;
+}
+
+void
+ShardFamily::setTreeNodeCacheFactor(double factor)
+{
+    std::lock_guard lock(tnCacheMutex_);
+    tnFactor_ = factor;
+    for (auto const& e : tnCache_)
+        scaleTreeNodeCache(*e.second);
+}
+
+void
+ShardFamily::scaleTreeNodeCache(TreeNodeCache& cache) const
+{
+    if (tnTargetSize_ > 0)
+        cache.setTargetSize(
+            std::max(1, static_cast<int>(tnTargetSize_ * tnFactor_)));
+    cache.setTargetAge(
+        std::chrono::duration_cast<TreeNodeCache::clock_type::duration>(
+            tnTargetAge_ * tnFactor_));
+}
+
+void
+ShardFamily::removeTreeNodeCache(TreeNodeCache const& cache)
+{
+    // Keep the lookups of the removed cache, so the totals never fall
+    auto const [hits, misses] = cache.getLookups();
+    tnRemovedLookups_.first += hits;
+    tnRemovedLookups_.second += misses;
+}
+
 void
 ShardFamily::sweep()
 {
@@ -129,7 +174,10 @@ ShardFamily::sweep()
 
         // Remove cache if empty
         if (it->second->getTrackSize() == 0)
+        {
+            removeTreeNodeCache(*it->second);
             it = tnCache_.erase(it);
+        }
         else
             ++it;
     }
@@ -149,6 +197,8 @@ ShardFamily::reset()
     }
 
     std::lock_guard lock(tnCacheMutex_);
+    for (auto const& e : tnCache_)
+        removeTreeNodeCache(*e.second);
     tnCache_.clear();
 }
 
@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/shamap/TreeNodeCache.h>
+
+namespace ripple {
+
+namespace {
+
+// Divide a target among the shards, keeping any nonzero target nonzero
+template <class Size>
+Size
+shareOf(Size target)
+{
+    return (target + TreeNodeCache::shardCount - 1) /
+        TreeNodeCache::shardCount;
+}
+
+}  // namespace
+
+TreeNodeCache::TreeNodeCache(
+    std::string const& name,
+    int size,
+    clock_type::duration expiration,
+    clock_type& clock,
+    beast::Journal journal)
+{
+    // The shards already split the nodes, so each is one partition that
+    // sweep() walks on its own thread rather than on threads of its own.
+    for (auto& shard : shards_)
+        shard = std::make_unique<cache_type>(
+            name,
+            shareOf(size),
+            expiration,
+            clock,
+            journal,
+            beast::insight::NullCollector::New(),
+            1);
+}
+
+int
+TreeNodeCache::getTargetSize() const
+{
+    int total = 0;
+    for (auto const& shard : shards_)
+        total += shard->getTargetSize();
+    return total;
+}
+
+void
+TreeNodeCache::setTargetSize(int size)
+{
+    for (auto& shard : shards_)
+        shard->setTargetSize(shareOf(size));
+}
+
+std::size_t
+TreeNodeCache::getTargetBytes() const
+{
+    std::size_t total = 0;
+    for (auto const& shard : shards_)
+        total += shard->getTargetBytes();
+    return total;
+}
+
+void
+TreeNodeCache::setTargetBytes(std::size_t bytes)
+{
+    for (auto& shard : shards_)
+        shard->setTargetBytes(shareOf(bytes));
+}
+
+TreeNodeCache::clock_type::duration
+TreeNodeCache::getTargetAge() const
+{
+    return shards_.front()->getTargetAge();
+}
+
+void
+TreeNodeCache::setTargetAge(clock_type::duration age)
+{
+    for (auto& shard : shards_)
+        shard->setTargetAge(age);
+}
+
+void
+TreeNodeCache::setClockEviction(bool enable)
+{
+    for (auto& shard : shards_)
+        shard->setClockEviction(enable);
+}
+
+std::size_t
+TreeNodeCache::size() const
+{
+    std::size_t total = 0;
+    for (auto const& shard : shards_)
+        total += shard->size();
+    return total;
+}
+
+int
+TreeNodeCache::getCacheSize() const
+{
+    int total = 0;
+    for (auto const& shard : shards_)
+        total += shard->getCacheSize();
+    return total;
+}
+
+int
+TreeNodeCache::getTrackSize() const
+{
+    int total = 0;
+    for (auto const& shard : shards_)
+        total += shard->getTrackSize();
+    return total;
+}
+
+std::size_t
+TreeNodeCache::getCacheBytes() const
+{
+    std::size_t total = 0;
+    for (auto const& shard : shards_)
+        total += shard->getCacheBytes();
+    return total;
+}
+
+float
+TreeNodeCache::getHitRate()
+{
+    // The shards see evenly spread keys, so their rates carry equal weight
+    float total = 0;
+    for (auto& shard : shards_)
+        total += shard->getHitRate();
+    return total / shardCount;
+}
+
+std::pair<std::uint64_t, std::uint64_t>
+TreeNodeCache::getLookups() const
+{
+    std::pair<std::uint64_t, std::uint64_t> total{0, 0};
+    for (auto const& shard : shards_)
+    {
+        auto const [hits, misses] = shard->getLookups();
+        total.first += hits;
+        total.second += misses;
+    }
+    return total;
+}
+
+std::vector<uint256>
+TreeNodeCache::getKeys() const
+{
+    std::vector<uint256> keys;
+    keys.reserve(size());
+    for (auto const& shard : shards_)
+    {
+        auto const k = shard->getKeys();
+        keys.insert(keys.end(), k.begin(), k.end());
+    }
+    return keys;
+}
+
+void
+TreeNodeCache::sweep()
+{
+    // Each shard is locked only while it is swept
+    for (auto& shard : shards_)
+        shard->sweep();
+}
+
+void
+TreeNodeCache::reset()
+{
+    for (auto& shard : shards_)
+        shard->reset();
+}
+
+}  // namespace ripple
@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/AcceptedLedger.h>
+#include <ripple/app/ledger/Ledger.h>
+#include <ripple/beast/unit_test.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class AcceptedLedger_test : public beast::unit_test::suite
+{
+    // A closed ledger holding `count` transactions, the metadata of
+    // the transaction at `bad`, if any, having no index
+    static std::shared_ptr<Ledger const>
+    makeLedger(
+        jtx::Env& env,
+        std::uint32_t count,
+        std::optional<std::uint32_t> bad = std::nullopt)
+    {
+        Config config;
+        std::shared_ptr<Ledger const> const genesis = std::make_shared<Ledger>(
+            create_genesis,
+            config,
+            std::vector<uint256>{},
+            env.app().getNodeFamily());
+        auto const ledger = std::make_shared<Ledger>(
+            *genesis, env.app().timeKeeper().closeTime());
+
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            STTx const stx(ttACCOUNT_SET, [i](STObject& obj) {
+                obj.setAccountID(sfAccount, AccountID(i + 1));
+                obj.setFieldU32(sfSequence, 1);
+                obj.setFieldAmount(sfFee, XRPAmount(10));
+                obj.setFieldVL(sfSigningPubKey, Slice{});
+            });
+            auto tx = std::make_shared<Serializer>();
+            stx.add(*tx);
+
+            // Index them in the reverse of their key order
+            STObject meta(sfMetadata);
+            meta.setFieldU8(sfTransactionResult, tesSUCCESS);
+            if (i != bad)
+                meta.setFieldU32(sfTransactionIndex, count - 1 - i);
+            meta.setFieldArray(sfAffectedNodes, STArray{sfAffectedNodes});
+            auto metaData = std::make_shared<Serializer>();
+            meta.add(*metaData);
+
+            ledger->rawTxInsert(stx.getTransactionID(), tx, metaData);
+        }
+        return ledger;
+    }
+
+    void
+    testOrder()
+    {
+        testcase("order");
+        using namespace jtx;
+
+        Env env(*this);
+
+        // Built on one thread, and on several
+        for (std::uint32_t const count : {0, 1, 10, 200})
+        {
+            auto const ledger = makeLedger(env, count);
+            AcceptedLedger const accepted(ledger, env.app());
+            BEAST_EXPECT(accepted.size() == count);
+
+            std::uint32_t index = 0;
+            bool ordered = true;
+            for (auto const& tx : accepted)
+            {
+                ordered = ordered && tx->getTxnSeq() == index++ &&
+                    tx->getMeta().getLgrSeq() == ledger->seq() &&
+                    ledger->txExists(tx->getTransactionID());
+            }
+            BEAST_EXPECT(ordered);
+        }
+    }
+
+    void
+    testThrow()
+    {
+        testcase("throw");
+        using namespace jtx;
+
+        Env env(*this);
+
+        // The error reaches the caller from any thread it happened on
+        for (std::uint32_t const count : {10, 200})
+        {
+            for (std::uint32_t const bad : {0u, count / 2, count - 1})
+            {
+                auto const ledger = makeLedger(env, count, bad);
+                try
+                {
+                    AcceptedLedger const accepted(ledger, env.app());
+                    fail();
+                }
+                catch (std::exception const&)
+                {
+                    pass();
+                }
+            }
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testOrder();
+        testThrow();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(AcceptedLedger, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
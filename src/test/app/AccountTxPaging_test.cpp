@@ -20,7 +20,9 @@
 #include <ripple/protocol/SField.h>
 #include <ripple/protocol/jss.h>
 #include <cstdlib>
+#include <string>
 #include <test/jtx.h>
+#include <vector>
 
 #include <ripple/rpc/GRPCHandlers.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
@@ -263,11 +265,74 @@ class AccountTxPaging_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testPageWalk()
+    {
+        testcase("Walk Every Page");
+        using namespace test::jtx;
+
+        Env env(*this);
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+
+        env.fund(XRP(10000), alice, bob);
+        env.close();
+
+        // Several transactions in most ledgers, none in some
+        for (auto i = 0; i < 12; ++i)
+        {
+            for (auto j = 0; j < i % 4; ++j)
+                env(pay(alice, bob, XRP(1 + j)));
+            env.close();
+        }
+
+        auto const maxLedger = env.closed()->info().seq;
+        auto const all = next(env, alice, 3, maxLedger, 400, true);
+        if (!BEAST_EXPECT(all[jss::transactions].isArray()))
+            return;
+        auto const& expected = all[jss::transactions];
+        BEAST_EXPECT(!all[jss::marker]);
+
+        auto const hashOf = [](Json::Value const& tx) {
+            return tx[jss::tx][jss::hash].asString();
+        };
+
+        for (bool const forward : {true, false})
+        {
+            for (unsigned const limit : {1, 2, 5})
+            {
+                std::vector<std::string> hashes;
+                Json::Value marker;
+                int pages = 0;
+                do
+                {
+                    auto const jrr =
+                        next(env, alice, 3, maxLedger, limit, forward, marker);
+                    auto const& txs = jrr[jss::transactions];
+                    if (!BEAST_EXPECT(txs.isArray() && txs.size() <= limit))
+                        return;
+                    for (auto const& tx : txs)
+                        hashes.push_back(hashOf(tx));
+                    marker = jrr[jss::marker];
+                } while (marker && ++pages < 100);
+
+                if (!BEAST_EXPECT(hashes.size() == expected.size()))
+                    continue;
+                for (std::size_t i = 0; i < hashes.size(); ++i)
+                {
+                    auto const j = forward ? i : hashes.size() - 1 - i;
+                    BEAST_EXPECT(hashes[i] == hashOf(expected[j]));
+                }
+            }
+        }
+    }
+
 public:
     void
     run() override
     {
         testAccountTxPaging();
+        testPageWalk();
     }
 };
 
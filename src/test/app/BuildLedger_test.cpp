@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class BuildLedger_test : public beast::unit_test::suite
+{
+    // Close the same ledgers using the given number of apply workers and
+    // return the hashes of the ledgers closed.
+    std::vector<uint256>
+    closeLedgers(int workers)
+    {
+        using namespace jtx;
+
+        Env env(*this, envconfig([workers](std::unique_ptr<Config> cfg) {
+            cfg->APPLY_WORKERS = workers;
+            return cfg;
+        }));
+
+        std::vector<uint256> hashes;
+        auto const close = [&]() {
+            env.close();
+            hashes.push_back(env.closed()->info().hash);
+        };
+
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+
+        std::vector<Account> accounts;
+        for (int i = 0; i < 40; ++i)
+            accounts.emplace_back("a" + std::to_string(i));
+
+        env.fund(XRP(100000), gw);
+        for (auto const& a : accounts)
+            env.fund(XRP(10000), a);
+        close();
+
+        for (auto const& a : accounts)
+            env(trust(a, USD(1000)));
+        close();
+
+        // Mostly disjoint payments, with some accounts sending more than
+        // one transaction and all of the offers sharing a book.
+        for (std::size_t i = 0; i < accounts.size(); ++i)
+        {
+            auto const& a = accounts[i];
+            auto const& b = accounts[(i + 1) % accounts.size()];
+            env(pay(a, b, XRP(10)));
+            env(pay(gw, a, USD(50)));
+            if (i % 3 == 0)
+                env(pay(a, b, XRP(5)));
+            env(offer(a, XRP(10), USD(10)));
+        }
+        close();
+
+        // Offers that cross the ones placed above
+        for (std::size_t i = 0; i < accounts.size(); i += 2)
+            env(offer(accounts[i], USD(10), XRP(10)));
+        close();
+
+        return hashes;
+    }
+
+    void
+    testSameLedgers()
+    {
+        testcase("same ledgers");
+
+        auto const serial = closeLedgers(0);
+        BEAST_EXPECT(serial.size() == 4);
+
+        for (int workers : {2, 4})
+            BEAST_EXPECT(closeLedgers(workers) == serial);
+    }
+
+public:
+    void
+    run() override
+    {
+        testSameLedgers();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(BuildLedger, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/main/CacheGovernor.h>
+#include <ripple/basics/TaggedCache.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/unit_test.h>
+#include <test/unit_test/SuiteJournal.h>
+
+namespace ripple {
+
+class CacheGovernor_test : public beast::unit_test::suite
+{
+    // A cache whose lookups the test sets
+    struct Fake
+    {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        double factor = 1.0;
+    };
+
+    static void
+    add(CacheGovernor& g, std::string name, Fake& f)
+    {
+        g.add(
+            std::move(name),
+            [&f]() { return std::make_pair(f.hits, f.misses); },
+            [&f](double factor) { f.factor = factor; });
+    }
+
+    void
+    testTrading()
+    {
+        testcase("trading");
+
+        test::SuiteJournal journal("CacheGovernor_test", *this);
+        CacheGovernor g(1000, journal);
+        Fake useful;
+        Fake useless;
+        add(g, "useful", useful);
+        add(g, "useless", useless);
+
+        useful.hits = 90;
+        useful.misses = 10;
+        useless.hits = 10;
+        useless.misses = 90;
+
+        // Under the high mark nothing changes
+        g.update(800);
+        BEAST_EXPECT(useful.factor == 1.0 && useless.factor == 1.0);
+
+        // Over it the cache that finds the least shrinks first, down to
+        // the least factor
+        g.update(950);
+        BEAST_EXPECT(useless.factor == CacheGovernor::shrinkStep);
+        BEAST_EXPECT(useful.factor == 1.0);
+        for (int i = 0; i < 10; ++i)
+            g.update(950);
+        BEAST_EXPECT(useless.factor == CacheGovernor::minFactor);
+        BEAST_EXPECT(useful.factor < 1.0);
+
+        // Over the limit every cache shrinks
+        auto const before = useful.factor;
+        g.update(1100);
+        BEAST_EXPECT(useful.factor < before);
+
+        // With room to spare the cache that finds the most grows back
+        // first, never past its own targets
+        useful.hits += 90;
+        useful.misses += 10;
+        useless.hits += 10;
+        useless.misses += 90;
+        g.update(500);
+        BEAST_EXPECT(useful.factor > before * CacheGovernor::shrinkStep);
+        BEAST_EXPECT(useless.factor == CacheGovernor::minFactor);
+        for (int i = 0; i < 100; ++i)
+            g.update(500);
+        BEAST_EXPECT(useful.factor == 1.0 && useless.factor == 1.0);
+        BEAST_EXPECT(g.factor("useful") == 1.0);
+        BEAST_EXPECT(g.factor("missing") == 0);
+    }
+
+    void
+    testTaggedCache()
+    {
+        testcase("tagged cache");
+
+        using namespace std::chrono_literals;
+        test::SuiteJournal journal("CacheGovernor_test", *this);
+        TestStopwatch clock;
+        TaggedCache<int, int> c("test", 1000, 60s, clock, journal);
+        c.setTargetBytes(4000);
+
+        // Without a limit the governor leaves the caches alone
+        {
+            CacheGovernor g(0, journal);
+            g.add("cache", c);
+            g.update(1 << 30);
+            BEAST_EXPECT(c.getTargetSize() == 1000);
+        }
+
+        CacheGovernor g(100, journal);
+        g.add("cache", c);
+        g.update(200);
+        BEAST_EXPECT(c.getTargetSize() == 750);
+        BEAST_EXPECT(c.getTargetBytes() == 3000);
+        BEAST_EXPECT(c.getTargetAge() == 45s);
+
+        for (int i = 0; i < 20; ++i)
+            g.update(0);
+        BEAST_EXPECT(c.getTargetSize() == 1000);
+        BEAST_EXPECT(c.getTargetBytes() == 4000);
+        BEAST_EXPECT(c.getTargetAge() == 60s);
+    }
+
+public:
+    void
+    run() override
+    {
+        testTrading();
+        testTaggedCache();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(CacheGovernor, app, ripple);
+
+}  // namespace ripple
@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/misc/CanonicalTXSet.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/TxFormats.h>
+#include <memory>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class CanonicalTXSet_test : public beast::unit_test::suite
+{
+    static std::shared_ptr<STTx const>
+    makeTx(AccountID const& account, std::uint32_t seq)
+    {
+        return std::make_shared<STTx const>(
+            ttACCOUNT_SET, [&](STObject& obj) {
+                obj.setAccountID(sfAccount, account);
+                obj.setFieldU32(sfSequence, seq);
+                obj.setFieldAmount(sfFee, STAmount{10});
+                obj.setFieldVL(sfSigningPubKey, Slice{});
+            });
+    }
+
+    using Seqs = std::vector<std::uint32_t>;
+
+    static Seqs
+    sequences(CanonicalTXSet const& set, AccountID const& account)
+    {
+        Seqs seqs;
+        for (auto const& item : set)
+        {
+            if (item.second->getAccountID(sfAccount) == account)
+                seqs.push_back(item.second->getFieldU32(sfSequence));
+        }
+        return seqs;
+    }
+
+public:
+    void
+    testOrder()
+    {
+        testcase("order");
+
+        AccountID const alice{1};
+        AccountID const bob{2};
+        CanonicalTXSet set{uint256{3}};
+        BEAST_EXPECT(set.empty());
+
+        set.insert(makeTx(alice, 3));
+        set.insert(makeTx(bob, 2));
+        set.insert(makeTx(alice, 1));
+        set.insert(makeTx(bob, 1));
+        set.insert(makeTx(alice, 2));
+        // Inserting a transaction already held changes nothing
+        set.insert(makeTx(alice, 2));
+        BEAST_EXPECT(set.size() == 5);
+
+        BEAST_EXPECT((sequences(set, alice) == Seqs{1, 2, 3}));
+        BEAST_EXPECT((sequences(set, bob) == Seqs{1, 2}));
+
+        // Each account's transactions are adjacent
+        std::vector<AccountID> accounts;
+        for (auto const& item : set)
+        {
+            auto const account = item.second->getAccountID(sfAccount);
+            if (accounts.empty() || accounts.back() != account)
+                accounts.push_back(account);
+        }
+        BEAST_EXPECT(accounts.size() == 2);
+    }
+
+    void
+    testEraseAndPop()
+    {
+        testcase("erase and pop");
+
+        AccountID const alice{1};
+        AccountID const bob{2};
+        CanonicalTXSet set{uint256{5}};
+        for (std::uint32_t seq = 1; seq <= 4; ++seq)
+        {
+            set.insert(makeTx(alice, seq));
+            set.insert(makeTx(bob, seq));
+        }
+
+        // Erase every other transaction while holding the others
+        std::vector<CanonicalTXSet::const_iterator> kept;
+        for (auto it = set.begin(); it != set.end();)
+        {
+            if (it->second->getFieldU32(sfSequence) % 2 == 0)
+                it = set.erase(it);
+            else
+                kept.push_back(it++);
+        }
+        BEAST_EXPECT(set.size() == 4);
+        for (auto const& it : kept)
+            BEAST_EXPECT(it->second->getFieldU32(sfSequence) % 2 == 1);
+        BEAST_EXPECT((sequences(set, alice) == Seqs{1, 3}));
+
+        // The next transaction of the account is popped, skipping the gaps
+        auto const next = set.popAcctTransaction(makeTx(alice, 2));
+        if (BEAST_EXPECT(next))
+            BEAST_EXPECT(next->getFieldU32(sfSequence) == 3);
+        BEAST_EXPECT(!set.popAcctTransaction(makeTx(alice, 4)));
+        BEAST_EXPECT(set.size() == 3);
+
+        // Inserting after reads merges into the sorted transactions
+        set.insert(makeTx(alice, 2));
+        set.insert(makeTx(bob, 1));
+        BEAST_EXPECT(set.size() == 4);
+        BEAST_EXPECT((sequences(set, alice) == Seqs{1, 2}));
+        BEAST_EXPECT((sequences(set, bob) == Seqs{1, 3}));
+
+        set.reset(uint256{6});
+        BEAST_EXPECT(set.empty());
+        BEAST_EXPECT(set.begin() == set.end());
+    }
+
+    void
+    run() override
+    {
+        testOrder();
+        testEraseAndPop();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(CanonicalTXSet, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
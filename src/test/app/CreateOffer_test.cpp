@@ -0,0 +1,222 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/paths/Flow.h>
+#include <ripple/app/tx/impl/CreateOffer.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/ledger/PaymentSandbox.h>
+#include <test/jtx.h>
+#include <test/jtx/AMM.h>
+#include <test/jtx/PathSet.h>
+#include <random>
+
+namespace ripple {
+namespace test {
+
+class CreateOffer_test : public beast::unit_test::suite
+{
+    // Check crossesNothing against what flow() does with the same offer.
+    // Returns whether crossing was skipped.
+    bool
+    checkCross(
+        jtx::Env& env,
+        jtx::Account const& taker,
+        Amounts const& takerAmount,
+        bool passive)
+    {
+        Quality threshold{takerAmount.out, takerAmount.in};
+        if (passive)
+            ++threshold;
+
+        bool const skipped = CreateOffer::crossesNothing(
+            *env.current(), takerAmount, threshold);
+
+        PaymentSandbox psb(env.current().get(), tapNONE);
+        auto const result = flow(
+            psb,
+            takerAmount.out,
+            taker,
+            taker,
+            STPathSet{},
+            true,
+            true,
+            true,
+            OfferCrossing::yes,
+            threshold,
+            takerAmount.in,
+            env.journal);
+
+        if (skipped)
+        {
+            // Nothing crossed and nothing to clean up
+            BEAST_EXPECT(
+                !isTesSuccess(result.result()) ||
+                result.actualAmountOut == beast::zero);
+            BEAST_EXPECT(result.removableOffers.empty());
+        }
+        return skipped;
+    }
+
+    void
+    testCrossesNothing(bool withAMM)
+    {
+        testcase(
+            std::string("crosses nothing") + (withAMM ? " with AMM" : ""));
+        using namespace jtx;
+
+        Env env{*this};
+        Account const gw{"gw"};
+        Account const taker{"taker"};
+        Account const ghost{"ghost"};
+        auto const USD = gw["USD"];
+
+        std::vector<Account> makers;
+        for (int i = 0; i < 4; ++i)
+            makers.emplace_back("maker" + std::to_string(i));
+
+        env.fund(XRP(100'000), gw, taker, ghost);
+        for (auto const& maker : makers)
+            env.fund(XRP(100'000), maker);
+        env.close();
+        env.trust(USD(100'000), taker, ghost);
+        for (auto const& maker : makers)
+            env.trust(USD(100'000), maker);
+        env.close();
+        env(pay(gw, taker, USD(10'000)));
+        env(pay(gw, ghost, USD(100)));
+        for (auto const& maker : makers)
+            env(pay(gw, maker, USD(10'000)));
+        env.close();
+
+        // Both books, between 8 and 12 XRP for 10 USD
+        beast::xor_shift_engine rng(42);
+        std::uniform_int_distribution<int> price(8'000, 12'000);
+        for (auto const& maker : makers)
+        {
+            for (int i = 0; i < 5; ++i)
+            {
+                env(offer(maker, drops(1'000 * price(rng)), USD(10)));
+                env(offer(maker, USD(10), drops(1'000 * price(rng))));
+            }
+        }
+
+        // The best offer of the book is unfunded, so flow() would find and
+        // remove it. It must never be skipped.
+        env(offer(ghost, XRP(7), USD(10)));
+        env(pay(ghost, gw, USD(100)));
+        env.close();
+
+        if (withAMM)
+        {
+            AMM amm(env, gw, XRP(10'000), USD(10'000));
+            env.close();
+        }
+
+        // Prices on either side of the books
+        std::uniform_int_distribution<int> bid(6'000, 14'000);
+        int skipped = 0;
+        int crossed = 0;
+        for (int i = 0; i < 200; ++i)
+        {
+            auto const xrp = drops(1'000 * bid(rng));
+            bool const passive = i % 3 == 0;
+            bool const buy = i % 2 == 0;
+            Amounts const takerAmount = buy
+                ? Amounts{STAmount(xrp), STAmount(USD(10))}
+                : Amounts{STAmount(USD(10)), STAmount(xrp)};
+            if (checkCross(env, taker, takerAmount, passive))
+                ++skipped;
+            else
+                ++crossed;
+        }
+
+        if (withAMM)
+        {
+            // The pool can always cross, so flow() is never skipped
+            BEAST_EXPECT(skipped == 0);
+        }
+        else
+        {
+            BEAST_EXPECT(skipped > 0);
+            BEAST_EXPECT(crossed > 0);
+        }
+
+        // Offers between two tokens may cross through XRP
+        auto const EUR = gw["EUR"];
+        BEAST_EXPECT(!CreateOffer::crossesNothing(
+            *env.current(),
+            Amounts{USD(10), EUR(10)},
+            Quality{STAmount(EUR(10)), STAmount(USD(10))}));
+    }
+
+    void
+    testPlaced()
+    {
+        testcase("placed");
+        using namespace jtx;
+
+        Env env{*this};
+        Account const gw{"gw"};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        auto const USD = gw["USD"];
+
+        env.fund(XRP(10'000), gw, alice, bob);
+        env.close();
+        env.trust(USD(1'000), alice, bob);
+        env(pay(gw, bob, USD(100)));
+        env.close();
+
+        env(offer(bob, XRP(110), USD(100)));
+        env.close();
+
+        // An offer that meets nothing rests in the book as it is
+        env(offer(alice, USD(100), XRP(100)));
+        env.close();
+        BEAST_EXPECT(isOffer(env, alice, USD(100), XRP(100)));
+        BEAST_EXPECT(isOffer(env, bob, XRP(110), USD(100)));
+
+        // A passive offer does not cross one of the same quality
+        env(offer(alice, USD(100), XRP(110)), txflags(tfPassive));
+        env.close();
+        BEAST_EXPECT(isOffer(env, alice, USD(100), XRP(110)));
+        BEAST_EXPECT(isOffer(env, bob, XRP(110), USD(100)));
+
+        // While one that does cross takes the offer
+        env(offer(alice, USD(100), XRP(110)));
+        env.close();
+        BEAST_EXPECT(!isOffer(env, bob, XRP(110), USD(100)));
+        env.require(balance(alice, USD(100)));
+    }
+
+public:
+    void
+    run() override
+    {
+        testCrossesNothing(false);
+        testCrossesNothing(true);
+        testPlaced();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(CreateOffer, tx, ripple);
+
+}  // namespace test
+}  // namespace ripple
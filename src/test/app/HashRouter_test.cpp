@@ -242,6 +242,67 @@ class HashRouter_test : public beast::unit_test::suite
         BEAST_EXPECT(router.shouldProcess(key, peer, flags, 1s));
     }
 
+    void
+    testPartitions()
+    {
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        HashRouter router(stopwatch, 2s);
+
+        // Keys whose first bytes differ land in different partitions
+        auto makeKey = [](std::uint8_t first, std::uint64_t rest) {
+            uint256 key{rest};
+            *key.begin() = first;
+            return key;
+        };
+        uint256 const key1 = makeKey(0, 1);
+        uint256 const key2 = makeKey(1, 2);
+        uint256 const key3 = makeKey(0, 3);
+
+        // t=0
+        router.setFlags(key1, 11111);
+
+        stopwatch.advance(3s);
+
+        // t=3
+        // An insertion only expires entries of its own partition
+        router.setFlags(key2, 22222);
+        BEAST_EXPECT(router.getFlags(key1) == 11111);
+
+        stopwatch.advance(3s);
+
+        // t=6
+        router.setFlags(key3, 33333);
+        BEAST_EXPECT(router.getFlags(key1) == 0);
+        BEAST_EXPECT(router.getFlags(key2) == 22222);
+        BEAST_EXPECT(router.getFlags(key3) == 33333);
+    }
+
+    void
+    testContains()
+    {
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        HashRouter router(stopwatch, 2s);
+        uint256 const key1(1);
+        uint256 const key2(2);
+
+        // Looking a hash up does not add it
+        BEAST_EXPECT(!router.contains(key1));
+        BEAST_EXPECT(!router.contains(key1));
+
+        router.addSuppression(key1);
+        BEAST_EXPECT(router.contains(key1));
+        BEAST_EXPECT(!router.contains(key2));
+
+        // Nor does it keep the entry from expiring
+        stopwatch.advance(3s);
+        BEAST_EXPECT(router.contains(key1));
+        router.addSuppression(key2);
+        BEAST_EXPECT(!router.contains(key1));
+        BEAST_EXPECT(router.contains(key2));
+    }
+
 public:
     void
     run() override
@@ -252,6 +313,8 @@ public:
         testSetFlags();
         testRelay();
         testProcess();
+        testPartitions();
+        testContains();
     }
 };
 
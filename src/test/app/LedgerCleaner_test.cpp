@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerCleaner.h>
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/protocol/jss.h>
+#include <test/jtx.h>
+
+#include <chrono>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+class LedgerCleaner_test : public beast::unit_test::suite
+{
+    // Wait for the cleaner to finish the range it was given
+    bool
+    waitForIdle(LedgerCleaner& cleaner)
+    {
+        using namespace std::chrono_literals;
+        auto const deadline = std::chrono::steady_clock::now() + 60s;
+        while (cleaner.getJson()[jss::state] != "idle")
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(10ms);
+        }
+        return true;
+    }
+
+    void
+    testWorkers()
+    {
+        testcase("workers");
+
+        using namespace jtx;
+        Env env{*this};
+        env.fund(XRP(10000), "alice", "bob");
+        for (int i = 0; i < 20; ++i)
+        {
+            env(pay("alice", "bob", XRP(1)));
+            env.close();
+        }
+
+        LedgerIndex minLedger = 0;
+        LedgerIndex maxLedger = 0;
+        BEAST_EXPECT(env.app().getLedgerMaster().getFullValidatedRange(
+            minLedger, maxLedger));
+        BEAST_EXPECT(maxLedger - minLedger >= 20);
+
+        auto& cleaner = env.app().getLedgerCleaner();
+
+        auto const clean = [&](unsigned workers, unsigned rate) {
+            Json::Value params(Json::objectValue);
+            params[jss::min_ledger] = minLedger;
+            params[jss::max_ledger] = maxLedger;
+            params[jss::check_nodes] = true;
+            params[jss::workers] = workers;
+            if (rate != 0)
+                params[jss::max_rate] = rate;
+            cleaner.clean(params);
+        };
+
+        // Several workers share the range, and run again for the next one
+        for (unsigned workers : {4, 2, 16})
+        {
+            clean(workers, 0);
+            BEAST_EXPECT(waitForIdle(cleaner));
+        }
+
+        // The rate bounds the workers together
+        clean(4, 10);
+        auto const json = cleaner.getJson();
+        if (BEAST_EXPECT(json[jss::state] == "running"))
+        {
+            BEAST_EXPECT(json[jss::workers] == 4);
+            BEAST_EXPECT(json[jss::max_rate] == 10);
+            BEAST_EXPECT(!json.isMember(jss::fail_counts));
+        }
+
+        // And the cleaner can be stopped partway
+        Json::Value stop(Json::objectValue);
+        stop[jss::stop] = true;
+        cleaner.clean(stop);
+        BEAST_EXPECT(waitForIdle(cleaner));
+    }
+
+public:
+    void
+    run() override
+    {
+        testWorkers();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerCleaner, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
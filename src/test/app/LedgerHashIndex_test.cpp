@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerHashIndex.h>
+#include <ripple/beast/unit_test.h>
+
+namespace ripple {
+namespace test {
+
+class LedgerHashIndex_test : public beast::unit_test::suite
+{
+    static LedgerHash
+    hashOf(LedgerIndex seq)
+    {
+        return LedgerHash{seq};
+    }
+
+    void
+    testInsert()
+    {
+        testcase("insert");
+
+        LedgerHashIndex index;
+        BEAST_EXPECT(!index.get(10));
+        BEAST_EXPECT(index.size() == 0);
+        BEAST_EXPECT(!index.insert(10, LedgerHash{}));
+
+        // The run grows in either direction
+        BEAST_EXPECT(index.insert(10, hashOf(10)));
+        BEAST_EXPECT(index.insert(11, hashOf(11)));
+        BEAST_EXPECT(index.insert(9, hashOf(9)));
+        BEAST_EXPECT(index.size() == 3);
+        for (LedgerIndex seq = 9; seq <= 11; ++seq)
+            BEAST_EXPECT(index.get(seq) == hashOf(seq));
+        BEAST_EXPECT(!index.get(8));
+        BEAST_EXPECT(!index.get(12));
+
+        // Sequences inside a gap are unknown until inserted
+        BEAST_EXPECT(index.insert(20, hashOf(20)));
+        BEAST_EXPECT(index.insert(5, hashOf(5)));
+        BEAST_EXPECT(index.size() == 5);
+        BEAST_EXPECT(!index.get(15));
+        BEAST_EXPECT(!index.get(6));
+        BEAST_EXPECT(index.get(20) == hashOf(20));
+        BEAST_EXPECT(index.get(5) == hashOf(5));
+
+        // A later hash replaces an earlier one
+        BEAST_EXPECT(index.insert(10, hashOf(100)));
+        BEAST_EXPECT(index.get(10) == hashOf(100));
+        BEAST_EXPECT(index.size() == 5);
+    }
+
+    void
+    testGap()
+    {
+        testcase("gap");
+
+        LedgerHashIndex index;
+        LedgerIndex const seq = 1000000;
+        BEAST_EXPECT(index.insert(seq, hashOf(seq)));
+
+        auto const far = seq + LedgerHashIndex::maxGap + 2;
+        BEAST_EXPECT(!index.insert(far, hashOf(far)));
+        BEAST_EXPECT(!index.get(far));
+
+        auto const near = seq + LedgerHashIndex::maxGap + 1;
+        BEAST_EXPECT(index.insert(near, hashOf(near)));
+        BEAST_EXPECT(index.get(near) == hashOf(near));
+
+        auto const low = seq - LedgerHashIndex::maxGap - 2;
+        BEAST_EXPECT(!index.insert(low, hashOf(low)));
+        BEAST_EXPECT(index.insert(low + 1, hashOf(low + 1)));
+        BEAST_EXPECT(index.size() == 3);
+    }
+
+    void
+    testErase()
+    {
+        testcase("erase");
+
+        LedgerHashIndex index;
+        for (LedgerIndex seq = 100; seq < 110; ++seq)
+            index.insert(seq, hashOf(seq));
+        BEAST_EXPECT(index.size() == 10);
+
+        index.erase(105);
+        index.erase(105);
+        index.erase(200);
+        BEAST_EXPECT(!index.get(105));
+        BEAST_EXPECT(index.size() == 9);
+
+        index.clearPrior(104);
+        BEAST_EXPECT(!index.get(103));
+        BEAST_EXPECT(index.get(104) == hashOf(104));
+        BEAST_EXPECT(index.size() == 5);
+
+        // Erasing the edges trims the run past any gap
+        index.erase(104);
+        BEAST_EXPECT(index.size() == 4);
+        BEAST_EXPECT(index.get(106) == hashOf(106));
+        index.clearPrior(110);
+        BEAST_EXPECT(index.size() == 0);
+        BEAST_EXPECT(!index.get(109));
+
+        // An emptied index starts a new run anywhere
+        BEAST_EXPECT(index.insert(5000000, hashOf(5000000)));
+        BEAST_EXPECT(index.get(5000000) == hashOf(5000000));
+        BEAST_EXPECT(index.size() == 1);
+    }
+
+public:
+    void
+    run() override
+    {
+        testInsert();
+        testGap();
+        testErase();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerHashIndex, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerHeaderCache.h>
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/beast/unit_test.h>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class LedgerHeaderCache_test : public beast::unit_test::suite
+{
+    static constexpr std::size_t unlimited =
+        std::numeric_limits<std::size_t>::max();
+
+    // Close a few ledgers with some activity and return them, oldest first
+    static std::vector<std::shared_ptr<Ledger const>>
+    makeLedgers(jtx::Env& env, int count)
+    {
+        using namespace jtx;
+        std::vector<std::shared_ptr<Ledger const>> ledgers;
+        for (int i = 0; i < count; ++i)
+        {
+            env.fund(XRP(10000), Account{"alice" + std::to_string(i)});
+            env.close();
+            ledgers.push_back(env.app().getLedgerMaster().getClosedLedger());
+        }
+        return ledgers;
+    }
+
+    static std::size_t
+    bytesOf(Ledger const& ledger, int depth = 1)
+    {
+        LedgerHeaderCache cache{unlimited, depth};
+        cache.insert(ledger);
+        return cache.bytes();
+    }
+
+    void
+    testFetch()
+    {
+        testcase("fetch");
+        using namespace jtx;
+
+        Env env{*this};
+        auto const ledgers = makeLedgers(env, 3);
+
+        LedgerHeaderCache cache{unlimited, 1};
+        for (auto const& ledger : ledgers)
+            cache.insert(*ledger);
+        BEAST_EXPECT(cache.size() == ledgers.size());
+
+        // Inserting a ledger again does not add to the cache
+        cache.insert(*ledgers.back());
+        BEAST_EXPECT(cache.size() == ledgers.size());
+
+        for (auto const& ledger : ledgers)
+        {
+            auto const info = cache.fetch(ledger->info().hash);
+            if (!BEAST_EXPECT(info))
+                continue;
+            BEAST_EXPECT(info->seq == ledger->info().seq);
+            BEAST_EXPECT(info->accountHash == ledger->info().accountHash);
+            BEAST_EXPECT(info->txHash == ledger->info().txHash);
+        }
+        BEAST_EXPECT(!cache.fetch(uint256{1}));
+        BEAST_EXPECT(cache.getHitRate() == 75.0f);
+
+        // The top of the state map is held along with the header
+        BEAST_EXPECT(
+            ledgers.back()->stateMap().getTopInnerNodes(1).size() > 1);
+        BEAST_EXPECT(bytesOf(*ledgers.back(), 1) > bytesOf(*ledgers.back(), 0));
+
+        cache.clearPrior(ledgers.back()->info().seq);
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(!cache.fetch(ledgers.front()->info().hash));
+        BEAST_EXPECT(cache.fetch(ledgers.back()->info().hash));
+        BEAST_EXPECT(cache.bytes() == bytesOf(*ledgers.back()));
+    }
+
+    void
+    testBudget()
+    {
+        testcase("budget");
+        using namespace jtx;
+
+        Env env{*this};
+        auto const ledgers = makeLedgers(env, 4);
+        auto const& a = ledgers[0];
+        auto const& b = ledgers[1];
+        auto const& c = ledgers[2];
+        auto const& d = ledgers[3];
+
+        // With no budget, only the newest header stays
+        {
+            LedgerHeaderCache cache{0, 1};
+            cache.insert(*a);
+            cache.insert(*b);
+            BEAST_EXPECT(cache.size() == 1);
+            BEAST_EXPECT(!cache.fetch(a->info().hash));
+            BEAST_EXPECT(cache.fetch(b->info().hash));
+        }
+
+        // The least recently used header is the first to go
+        {
+            std::size_t budget = 0;
+            for (auto const& ledger : ledgers)
+                budget += bytesOf(*ledger);
+
+            LedgerHeaderCache cache{budget - 1, 1};
+            cache.insert(*a);
+            cache.insert(*b);
+            cache.insert(*c);
+            BEAST_EXPECT(cache.size() == 3);
+            BEAST_EXPECT(cache.fetch(a->info().hash));
+
+            cache.insert(*d);
+            BEAST_EXPECT(cache.size() == 3);
+            BEAST_EXPECT(cache.bytes() <= budget - 1);
+            BEAST_EXPECT(!cache.fetch(b->info().hash));
+            BEAST_EXPECT(cache.fetch(a->info().hash));
+            BEAST_EXPECT(cache.fetch(c->info().hash));
+            BEAST_EXPECT(cache.fetch(d->info().hash));
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testFetch();
+        testBudget();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerHeaderCache, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
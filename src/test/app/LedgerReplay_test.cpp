@@ -28,9 +28,11 @@
 #include <ripple/basics/Slice.h>
 #include <ripple/overlay/PeerSet.h>
 #include <ripple/overlay/impl/PeerImp.h>
+#include <ripple/protocol/digest.h>
 #include <test/jtx.h>
 #include <test/jtx/envconfig.h>
 
+#include <atomic>
 #include <chrono>
 #include <thread>
 
@@ -95,6 +97,7 @@ public:
     acquire(uint256 const& hash, std::uint32_t seq, InboundLedger::Reason)
         override
     {
+        ++acquires;
         if (bhvr == InboundLedgersBehavior::DropAll)
             return {};
         if (auto l = ledgerSource.getLedgerByHash(hash); l)
@@ -182,6 +185,7 @@ public:
     LedgerMaster& ledgerSource;
     LedgerMaster& ledgerSink;
     InboundLedgersBehavior bhvr;
+    std::atomic<int> acquires = 0;
 };
 
 enum class PeerFeature {
@@ -316,6 +320,25 @@ public:
     bool ledgerReplayEnabled_;
 };
 
+/**
+ * A peer that keeps the messages sent to it
+ */
+class RecordingPeer : public TestPeer
+{
+public:
+    RecordingPeer() : TestPeer(false)
+    {
+    }
+
+    void
+    send(std::shared_ptr<Message> const& m) override
+    {
+        messages.push_back(m);
+    }
+
+    std::vector<std::shared_ptr<Message>> messages;
+};
+
 enum class PeerSetBehavior {
     Good,
     Drop50,
@@ -870,6 +893,7 @@ struct NetworkOfTwo
  * -- process a bad skip list
  * -- process a bad ledger delta
  * -- replay ledger ranges with different overlaps
+ * -- replay consecutive ranges that wait for each other's ledgers
  *
  * LedgerReplayerTimeout_test:
  * -- timeouts of SkipListAcquire
@@ -1443,6 +1467,136 @@ struct LedgerReplayer_test : public beast::unit_test::suite
         BEAST_EXPECT(net.client.countsAsExpected(0, 0, 0));
     }
 
+    void
+    testLedgerReplayPipeline()
+    {
+        testcase("Pipelined tasks");
+        int totalReplay = 5;
+        int rounds = 3;
+        NetworkOfTwo net(
+            *this,
+            {(totalReplay - 1) * rounds + 1},
+            PeerSetBehavior::Good,
+            InboundLedgersBehavior::DropAll,
+            PeerFeature::LedgerReplayEnabled);
+
+        // Each task finishes on the ledger the next one starts on
+        std::vector<uint256> finishHashes;
+        auto l = net.server.ledgerMaster.getClosedLedger();
+        for (int i = 0; i < rounds; ++i)
+        {
+            finishHashes.push_back(l->info().hash);
+            for (int j = 0; j < totalReplay - 1; ++j)
+            {
+                l = net.server.ledgerMaster.getLedgerByHash(
+                    l->info().parentHash);
+            }
+        }
+
+        // The client only has the first start ledger, and InboundLedgers
+        // can't provide the others
+        net.client.addLedger(l);
+
+        uint256 prior;
+        for (auto i = finishHashes.rbegin(); i != finishHashes.rend(); ++i)
+        {
+            net.client.replayer.replay(
+                InboundLedger::Reason::GENERIC, *i, totalReplay, prior);
+            prior = *i;
+        }
+
+        std::vector<TaskStatus> deltaStatuses(
+            totalReplay - 1, TaskStatus::Completed);
+        for (auto const& hash : finishHashes)
+        {
+            BEAST_EXPECT(net.client.waitAndCheckStatus(
+                hash,
+                totalReplay,
+                TaskStatus::Completed,
+                TaskStatus::Completed,
+                deltaStatuses));
+        }
+        BEAST_EXPECT(net.client.waitForLedgers(
+            finishHashes.front(), (totalReplay - 1) * rounds + 1));
+        BEAST_EXPECT(net.client.inboundLedgers.acquires == 0);
+
+        // sweep
+        net.client.replayer.sweep();
+        BEAST_EXPECT(net.client.countsAsExpected(0, 0, 0));
+    }
+
+    void
+    testFetchPack()
+    {
+        testcase("Fetch pack");
+        LedgerServer server(*this, {12});
+        auto const have = server.ledgerMaster.getClosedLedger();
+
+        auto const request = std::make_shared<protocol::TMGetObjectByHash>();
+        request->set_type(protocol::TMGetObjectByHash::otFETCH_PACK);
+        request->set_ledgerhash(have->info().hash.data(), uint256::size());
+
+        auto const pack = [&]() {
+            auto const peer = std::make_shared<RecordingPeer>();
+            server.ledgerMaster.makeFetchPack(
+                peer, request, have->info().hash, UptimeClock::now());
+
+            std::vector<protocol::TMIndexedObject> objects;
+            for (auto const& m : peer->messages)
+            {
+                auto const& buffer = m->getBuffer(compression::Compressed::Off);
+                protocol::TMGetObjectByHash reply;
+                BEAST_EXPECT(reply.ParseFromArray(
+                    buffer.data() + compression::headerBytes,
+                    buffer.size() - compression::headerBytes));
+                BEAST_EXPECT(
+                    reply.type() == protocol::TMGetObjectByHash::otFETCH_PACK);
+                objects.insert(
+                    objects.end(),
+                    reply.objects().begin(),
+                    reply.objects().end());
+            }
+            return objects;
+        };
+
+        // Segments are added newest first, each starting with its header
+        auto const built = pack();
+        BEAST_EXPECT(!built.empty());
+        auto seq = have->info().seq;
+        std::size_t ledgers = 0;
+        for (auto const& obj : built)
+        {
+            BEAST_EXPECT(
+                obj.hash().size() == uint256::size() &&
+                sha512Half(makeSlice(obj.data())) ==
+                    uint256::fromVoid(obj.hash().data()));
+            if (obj.ledgerseq() != seq)
+            {
+                BEAST_EXPECT(obj.ledgerseq() == seq - 1);
+                seq = obj.ledgerseq();
+                auto const ledger = server.ledgerMaster.getLedgerBySeq(seq);
+                BEAST_EXPECT(
+                    ledger &&
+                    uint256::fromVoid(obj.hash().data()) ==
+                        ledger->info().hash);
+                ++ledgers;
+            }
+        }
+        BEAST_EXPECT(ledgers > 4);
+
+        // A second pack is put together from the cached segments
+        auto const cached = pack();
+        BEAST_EXPECT(cached.size() == built.size());
+        BEAST_EXPECT(std::equal(
+            cached.begin(),
+            cached.end(),
+            built.begin(),
+            built.end(),
+            [](auto const& a, auto const& b) {
+                return a.SerializeAsString() == b.SerializeAsString();
+            }));
+    }
+
     void
     run() override
     {
@@ -1463,6 +1617,8 @@ struct LedgerReplayer_test : public beast::unit_test::suite
         testSkipListBadReply();
         testLedgerDeltaBadReply();
         testLedgerReplayOverlap();
+        testLedgerReplayPipeline();
+        testFetchPack();
     }
 };
 
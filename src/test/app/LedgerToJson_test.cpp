@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerToJson.h>
+#include <ripple/json/json_reader.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class LedgerToJson_test : public beast::unit_test::suite
+{
+    void
+    testStreamed()
+    {
+        testcase("streamed");
+
+        using namespace jtx;
+        Env env(*this);
+
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+        env.fund(XRP(10000), gw);
+        for (int i = 0; i < 20; ++i)
+        {
+            Account const a("a" + std::to_string(i));
+            env.fund(XRP(1000), a);
+            env(trust(a, USD(100)));
+        }
+        env.close();
+
+        // The streamed document must parse to what getJson builds.
+        auto const ledger = env.closed();
+        for (int const options :
+             {0,
+              int(LedgerFill::dumpTxrp),
+              LedgerFill::dumpState | LedgerFill::expand,
+              LedgerFill::dumpState | LedgerFill::binary})
+        {
+            LedgerFill const fill(*ledger, nullptr, options);
+
+            std::string s;
+            auto const bytes =
+                streamJson(fill, Json::stringOutput(s), env.journal);
+            BEAST_EXPECT(bytes == s.size());
+
+            Json::Value streamed;
+            BEAST_EXPECT(Json::Reader{}.parse(s, streamed));
+            BEAST_EXPECT(streamed == getJson(fill));
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testStreamed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerToJson, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
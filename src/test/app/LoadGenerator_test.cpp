@@ -0,0 +1,466 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/app/misc/Transaction.h>
+#include <ripple/app/misc/TxQ.h>
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/json/to_string.h>
+#include <test/jtx.h>
+#include <test/jtx/AMM.h>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+/*  Synthetic load generator.
+
+    Funds a set of accounts on a jtx Env, signs a mix of transactions
+    from them ahead of time, and then submits the transactions at a
+    target rate through NetworkOPs::processTransaction, the path taken by
+    transactions from peers. Ledgers are closed at a fixed interval while
+    the load runs, and afterwards until the queue drains. It reports the
+    sustained rate of transactions that made it into a ledger, how long
+    each ledger took to close, how the queue behaved and the latency of
+    each stage. This suite is manual:
+
+        rippled --unittest=LoadGenerator --unittest-arg="<config>"
+
+    The config is a comma separated list of key=value pairs:
+
+        accounts    Accounts submitting transactions. Default 200.
+        rate        Transactions submitted per second. Default 500.
+        seconds     How long to submit for. Default 10.
+        close       Milliseconds between ledger closes. Default 1000.
+        payment     Weight of XRP payments in the mix. Default 50.
+        offer       Weight of OfferCreates against an XRP/USD book.
+                    Default 20.
+        nft         Weight of NFTokenMints. Default 10.
+        amm         Weight of payments that swap XRP for USD through an
+                    AMM pool. Default 20.
+        ledger_size The minimum_txn_in_ledger_standalone of the queue.
+                    Default 1000.
+        json        A file to append one JSON object per run to.
+*/
+class LoadGenerator_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+    struct Params
+    {
+        std::size_t accounts;
+        std::size_t rate;
+        std::size_t seconds;
+        std::chrono::milliseconds close;
+        std::array<std::size_t, 4> weights;
+        std::size_t ledgerSize;
+    };
+
+    enum Kind { payment, offerCreate, nftMint, ammSwap };
+    static constexpr std::array<char const*, 4> kindNames{
+        "payment",
+        "offer",
+        "nft",
+        "amm"};
+
+    struct Submitted
+    {
+        std::shared_ptr<Transaction> tx;
+        Kind kind;
+        clock_type::time_point when;
+        std::optional<clock_type::duration> included;
+    };
+
+    // Percentiles in milliseconds of a set of durations
+    struct Latency
+    {
+        double p50 = 0;
+        double p90 = 0;
+        double p99 = 0;
+        double max = 0;
+    };
+
+    static Latency
+    latency(std::vector<clock_type::duration> samples)
+    {
+        Latency l;
+        if (samples.empty())
+            return l;
+        std::sort(samples.begin(), samples.end());
+        auto const at = [&](double q) {
+            auto const i = static_cast<std::size_t>(q * (samples.size() - 1));
+            return std::chrono::duration<double, std::milli>(samples[i])
+                .count();
+        };
+        l.p50 = at(0.5);
+        l.p90 = at(0.9);
+        l.p99 = at(0.99);
+        l.max = at(1.0);
+        return l;
+    }
+
+    void
+    report(std::string const& what, Latency const& l)
+    {
+        log << std::left << std::setw(12) << what << std::right << std::fixed
+            << std::setprecision(2) << " p50 " << std::setw(9) << l.p50
+            << " p90 " << std::setw(9) << l.p90 << " p99 " << std::setw(9)
+            << l.p99 << " max " << std::setw(9) << l.max << " ms"
+            << std::endl;
+    }
+
+    static Json::Value
+    toJson(Latency const& l)
+    {
+        Json::Value jv(Json::objectValue);
+        jv["p50_ms"] = l.p50;
+        jv["p90_ms"] = l.p90;
+        jv["p99_ms"] = l.p99;
+        jv["max_ms"] = l.max;
+        return jv;
+    }
+
+    void
+    runLoad(Params const& p, std::string const& json)
+    {
+        using namespace jtx;
+        using namespace std::chrono_literals;
+
+        Env env{*this, envconfig([&](std::unique_ptr<Config> cfg) {
+                    cfg->section("transaction_queue")
+                        .set(
+                            "minimum_txn_in_ledger_standalone",
+                            std::to_string(p.ledgerSize));
+                    return cfg;
+                })};
+
+        Account const gw{"gw"};
+        Account const lp{"lp"};
+        auto const USD = gw["USD"];
+
+        std::vector<Account> accounts;
+        accounts.reserve(p.accounts);
+        for (std::size_t i = 0; i < p.accounts; ++i)
+            accounts.emplace_back("load" + std::to_string(i));
+
+        // Set up in ledgers small enough that no fee escalates
+        std::size_t const perLedger =
+            std::max<std::size_t>(p.ledgerSize / 2, 1);
+        env.fund(XRP(100'000'000), gw, lp);
+        env.close();
+        env.trust(USD(1'000'000'000), lp);
+        env(pay(gw, lp, USD(100'000'000)));
+        env.close();
+        for (std::size_t i = 0; i < accounts.size(); ++i)
+        {
+            env.fund(XRP(1'000'000), accounts[i]);
+            if ((i + 1) % perLedger == 0)
+                env.close();
+        }
+        env.close();
+        for (std::size_t i = 0; i < accounts.size(); ++i)
+        {
+            env.trust(USD(1'000'000'000), accounts[i]);
+            if ((i + 1) % (perLedger / 2 + 1) == 0)
+                env.close();
+        }
+        env.close();
+        for (std::size_t i = 0; i < accounts.size(); ++i)
+        {
+            env(pay(gw, accounts[i], USD(1'000'000)));
+            if ((i + 1) % perLedger == 0)
+                env.close();
+        }
+        env.close();
+
+        AMM pool(env, lp, XRP(10'000'000), USD(10'000'000));
+        env.close();
+
+        // Sign every transaction before the clock starts
+        std::size_t const total = p.rate * p.seconds;
+        std::size_t const weightSum = std::max<std::size_t>(
+            1, p.weights[0] + p.weights[1] + p.weights[2] + p.weights[3]);
+
+        std::vector<std::uint32_t> seqs;
+        seqs.reserve(accounts.size());
+        for (auto const& a : accounts)
+            seqs.push_back(env.seq(a));
+
+        beast::xor_shift_engine rng(1);
+        auto const baseFee = env.current()->fees().base;
+
+        std::vector<Submitted> load;
+        load.reserve(total);
+        for (std::size_t i = 0; i < total; ++i)
+        {
+            auto const from = i % accounts.size();
+            auto const& account = accounts[from];
+            auto const& other = accounts[(from + 1) % accounts.size()];
+
+            Kind kind = payment;
+            for (auto pick = rand_int(rng, weightSum - 1); kind != ammSwap;
+                 kind = static_cast<Kind>(kind + 1))
+            {
+                if (pick < p.weights[kind])
+                    break;
+                pick -= p.weights[kind];
+            }
+
+            auto const jv = [&] {
+                switch (kind)
+                {
+                    case payment:
+                        return pay(account, other, drops(1'000'000));
+                    case offerCreate:
+                        // Alternate sides, so that some offers cross
+                        return rand_int(rng, 1)
+                            ? offer(account, XRP(1), USD(1))
+                            : offer(account, USD(1), XRP(1));
+                    case nftMint:
+                        return token::mint(account, 0);
+                    case ammSwap:
+                        break;
+                }
+                return pay(account, other, USD(1));
+            }();
+
+            auto const jt = kind == ammSwap
+                ? env.jt(
+                      jv,
+                      sendmax(XRP(2)),
+                      path(~USD),
+                      txflags(tfNoRippleDirect),
+                      seq(seqs[from]++),
+                      fee(baseFee))
+                : env.jt(jv, seq(seqs[from]++), fee(baseFee));
+
+            std::string reason;
+            load.push_back(Submitted{
+                std::make_shared<Transaction>(jt.stx, reason, env.app()),
+                kind,
+                {},
+                std::nullopt});
+        }
+
+        hash_map<uint256, std::size_t> byID;
+        for (std::size_t i = 0; i < load.size(); ++i)
+            byID.emplace(load[i].tx->getID(), i);
+
+        std::vector<clock_type::duration> submitTimes;
+        std::vector<clock_type::duration> closeTimes;
+        submitTimes.reserve(total);
+
+        std::size_t queuePeak = 0;
+        std::size_t included = 0;
+        std::size_t ledgers = 0;
+        auto lastInclusion = clock_type::now();
+
+        auto const closeLedger = [&] {
+            if (auto const metrics = env.app().getTxQ().getMetrics(
+                    *env.current());
+                metrics.txCount > queuePeak)
+                queuePeak = metrics.txCount;
+
+            auto const start = clock_type::now();
+            env.close();
+            auto const done = clock_type::now();
+            closeTimes.push_back(done - start);
+            ++ledgers;
+
+            std::size_t count = 0;
+            for (auto const& [stx, meta] : env.closed()->txs)
+            {
+                (void)meta;
+                if (auto const it = byID.find(stx->getTransactionID());
+                    it != byID.end() && !load[it->second].included)
+                {
+                    load[it->second].included = done - load[it->second].when;
+                    ++count;
+                }
+            }
+            if (count != 0)
+                lastInclusion = done;
+            included += count;
+            return count;
+        };
+
+        // Submit at the target rate, closing ledgers on schedule
+        auto const interval = std::chrono::duration_cast<clock_type::duration>(
+            std::chrono::duration<double>(1.0 / p.rate));
+        auto const start = clock_type::now();
+        auto nextClose = start + p.close;
+        for (std::size_t i = 0; i < load.size(); ++i)
+        {
+            auto const due = start + interval * static_cast<std::int64_t>(i);
+            while (true)
+            {
+                auto const now = clock_type::now();
+                if (now >= nextClose)
+                {
+                    closeLedger();
+                    nextClose += p.close;
+                    continue;
+                }
+                if (now >= due)
+                    break;
+                std::this_thread::sleep_until(std::min(due, nextClose));
+            }
+
+            auto& s = load[i];
+            s.when = clock_type::now();
+            env.app().getOPs().processTransaction(
+                s.tx, false, false, NetworkOPs::FailHard::no);
+            submitTimes.push_back(clock_type::now() - s.when);
+        }
+        auto const submitted = clock_type::now();
+
+        // Keep closing until the queue drains or stops making progress
+        for (int idle = 0; included != load.size() && idle < 3;)
+        {
+            std::this_thread::sleep_until(nextClose);
+            nextClose += p.close;
+            if (closeLedger() == 0)
+                ++idle;
+            else
+                idle = 0;
+        }
+
+        std::chrono::duration<double> const submitSpan = submitted - start;
+        std::chrono::duration<double> const includeSpan = lastInclusion - start;
+
+        std::array<std::vector<clock_type::duration>, 4> inclusion;
+        std::array<std::size_t, 4> kinds{};
+        std::map<std::string, std::size_t> lost;
+        for (auto const& s : load)
+        {
+            ++kinds[s.kind];
+            if (s.included)
+                inclusion[s.kind].push_back(*s.included);
+            else
+                ++lost[transToken(s.tx->getResult())];
+        }
+
+        auto const offered = submitSpan.count() > 0
+            ? load.size() / submitSpan.count()
+            : 0.0;
+        auto const sustained = includeSpan.count() > 0
+            ? included / includeSpan.count()
+            : 0.0;
+
+        log << std::fixed << std::setprecision(1) << "offered " << offered
+            << " tx/s, sustained " << sustained << " tx/s, " << included
+            << " of " << load.size() << " in " << ledgers
+            << " ledgers, queue peak " << queuePeak << std::endl;
+        for (auto const& [result, count] : lost)
+            log << "not included: " << count << " " << result << std::endl;
+
+        report("submit", latency(submitTimes));
+        report("close", latency(closeTimes));
+        std::vector<clock_type::duration> all;
+        for (std::size_t k = 0; k != inclusion.size(); ++k)
+        {
+            if (kinds[k] == 0)
+                continue;
+            report(std::string("in ") + kindNames[k], latency(inclusion[k]));
+            all.insert(all.end(), inclusion[k].begin(), inclusion[k].end());
+        }
+
+        BEAST_EXPECT(included != 0);
+
+        if (json.empty())
+            return;
+
+        Json::Value jv(Json::objectValue);
+        jv["accounts"] = static_cast<Json::UInt>(p.accounts);
+        jv["rate"] = static_cast<Json::UInt>(p.rate);
+        jv["seconds"] = static_cast<Json::UInt>(p.seconds);
+        jv["close_ms"] = static_cast<Json::UInt>(p.close.count());
+        jv["ledger_size"] = static_cast<Json::UInt>(p.ledgerSize);
+        jv["offered_tps"] = offered;
+        jv["sustained_tps"] = sustained;
+        jv["submitted"] = static_cast<Json::UInt>(load.size());
+        jv["included"] = static_cast<Json::UInt>(included);
+        jv["ledgers"] = static_cast<Json::UInt>(ledgers);
+        jv["queue_peak"] = static_cast<Json::UInt>(queuePeak);
+        jv["submit"] = toJson(latency(submitTimes));
+        jv["close"] = toJson(latency(closeTimes));
+        jv["inclusion"] = toJson(latency(all));
+        for (std::size_t k = 0; k != kinds.size(); ++k)
+        {
+            auto& entry = jv["mix"][kindNames[k]];
+            entry["weight"] = static_cast<Json::UInt>(p.weights[k]);
+            entry["submitted"] = static_cast<Json::UInt>(kinds[k]);
+            entry["included"] = static_cast<Json::UInt>(inclusion[k].size());
+            entry["inclusion"] = toJson(latency(inclusion[k]));
+        }
+        for (auto const& [result, count] : lost)
+            jv["not_included"][result] = static_cast<Json::UInt>(count);
+        std::ofstream out(json, std::ofstream::app);
+        out << to_string(jv) << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        std::vector<std::string> lines;
+        boost::split(lines, arg(), boost::is_any_of(","));
+        Section config;
+        config.append(lines);
+
+        Params p;
+        p.accounts = std::max<std::size_t>(
+            1, get<std::size_t>(config, "accounts", 200));
+        p.rate =
+            std::max<std::size_t>(1, get<std::size_t>(config, "rate", 500));
+        p.seconds =
+            std::max<std::size_t>(1, get<std::size_t>(config, "seconds", 10));
+        p.close = std::chrono::milliseconds(std::max<std::size_t>(
+            1, get<std::size_t>(config, "close", 1000)));
+        p.weights = {
+            get<std::size_t>(config, "payment", 50),
+            get<std::size_t>(config, "offer", 20),
+            get<std::size_t>(config, "nft", 10),
+            get<std::size_t>(config, "amm", 20)};
+        p.ledgerSize = std::max<std::size_t>(
+            1, get<std::size_t>(config, "ledger_size", 1000));
+
+        std::ostringstream name;
+        name << "accounts=" << p.accounts << " rate=" << p.rate
+             << " seconds=" << p.seconds << " close=" << p.close.count()
+             << "ms";
+        testcase(name.str());
+        runLoad(p, get(config, "json", ""));
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(LoadGenerator, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -19,6 +19,8 @@
 
 #include <ripple/app/tx/impl/OfferStream.h>
 #include <ripple/beast/unit_test.h>
+#include <ripple/ledger/Sandbox.h>
+#include <test/jtx.h>
 
 namespace ripple {
 
@@ -31,10 +33,66 @@ public:
         pass();
     }
 
+    void
+    testConsumed()
+    {
+        testcase("consumed");
+        using namespace test::jtx;
+
+        Env env{*this};
+        Account const gw{"gw"};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        auto const USD = gw["USD"];
+
+        env.fund(XRP(10000), gw, alice, bob);
+        env.close();
+        env.trust(USD(1000), alice, bob);
+        env.close();
+        env(pay(gw, alice, USD(100)));
+        env(pay(gw, bob, USD(100)));
+        env.close();
+
+        // More offers than one lookahead covers, from two owners
+        int const count = 12;
+        for (int i = 0; i < count; ++i)
+            env(offer(i % 2 ? alice : bob, XRP(10 + i), USD(10)));
+        env.close();
+
+        Sandbox view(&*env.current(), tapNONE);
+        Sandbox cancel(&*env.current(), tapNONE);
+        OfferStream::StepCounter counter(1000, env.journal);
+        OfferStream offers(
+            view,
+            cancel,
+            Book(xrpIssue(), USD.issue()),
+            env.current()->parentCloseTime(),
+            counter,
+            env.journal);
+
+        BEAST_EXPECT(offers.offersConsumed() == 0);
+
+        int presented = 0;
+        std::optional<Quality> last;
+        while (offers.step())
+        {
+            auto const quality = offers.tip().quality();
+            BEAST_EXPECT(!last || !(quality > *last));
+            last = quality;
+            ++presented;
+            BEAST_EXPECT(offers.offersConsumed() == presented);
+        }
+
+        BEAST_EXPECT(presented == count);
+        BEAST_EXPECT(offers.offersConsumed() == count);
+        BEAST_EXPECT(counter.count() == count);
+    }
+
     void
     run() override
     {
         test();
+        testConsumed();
     }
 };
 
@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/OpenLedger.h>
+#include <ripple/shamap/SHAMap.h>
+#include <test/jtx.h>
+#include <iterator>
+
+namespace ripple {
+namespace test {
+
+class OpenLedger_test : public beast::unit_test::suite
+{
+    // The hash of a tx set built from scratch, as a close once did
+    static uint256
+    buildHash(Application& app, OpenView const& view)
+    {
+        SHAMap set(SHAMapType::TRANSACTION, app.getNodeFamily());
+        set.setUnbacked();
+        for (auto const& tx : view.txs)
+        {
+            Serializer s;
+            tx.first->add(s);
+            set.addItem(
+                SHAMapNodeType::tnTRANSACTION_NM,
+                make_shamapitem(tx.first->getTransactionID(), s.slice()));
+        }
+        return set.getHash().as_uint256();
+    }
+
+    void
+    testTxSet()
+    {
+        testcase("tx set");
+
+        using namespace jtx;
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        env.fund(XRP(10000), alice, bob);
+        env.close();
+
+        auto const check = [&](std::size_t count) {
+            auto [view, set] = env.app().openLedger().currentWithTxSet();
+            BEAST_EXPECT(
+                std::distance(view->txs.begin(), view->txs.end()) ==
+                static_cast<std::ptrdiff_t>(count));
+            BEAST_EXPECT(
+                set->getHash().as_uint256() == buildHash(env.app(), *view));
+
+            // The set is the caller's to add pseudo-transactions to
+            set->addItem(
+                SHAMapNodeType::tnTRANSACTION_NM,
+                make_shamapitem(uint256(1), Slice{"pseudo", 6}));
+            auto const [again, live] =
+                env.app().openLedger().currentWithTxSet();
+            BEAST_EXPECT(!live->hasItem(uint256(1)));
+        };
+
+        check(0);
+        for (std::size_t i = 1; i <= 5; ++i)
+        {
+            env(pay(alice, bob, XRP(1)));
+            check(i);
+        }
+
+        env.close();
+        check(0);
+
+        env(pay(bob, alice, XRP(1)));
+        check(1);
+    }
+
+public:
+    void
+    run() override
+    {
+        testTxSet();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(OpenLedger, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/OrderBookDB.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/core/JobQueue.h>
+#include <test/jtx.h>
+#include <test/jtx/AMM.h>
+
+namespace ripple {
+namespace test {
+
+class OrderBookDB_test : public beast::unit_test::suite
+{
+    // Wait for the closed ledger to be published to the books
+    static std::size_t
+    booksOf(jtx::Env& env, Issue const& issue)
+    {
+        env.app().getJobQueue().rendezvous();
+        return env.app().getOrderBookDB().getBooksByTakerPays(issue).size();
+    }
+
+    void
+    testOffers()
+    {
+        testcase("offers");
+        using namespace jtx;
+
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const gw{"gateway"};
+        auto const USD = gw["USD"];
+        env.fund(XRP(10000), alice, gw);
+        env.close();
+        env.trust(USD(1000), alice);
+        env.close();
+        env(pay(gw, alice, USD(100)));
+        env.close();
+
+        auto& books = env.app().getOrderBookDB();
+        BEAST_EXPECT(booksOf(env, USD) == 0);
+        BEAST_EXPECT(!books.isBookToXRP(USD));
+
+        // Two qualities in the same book
+        auto const first = env.seq(alice);
+        env(offer(alice, USD(10), XRP(10)));
+        auto const second = env.seq(alice);
+        env(offer(alice, USD(10), XRP(20)));
+        env.close();
+        BEAST_EXPECT(booksOf(env, USD) == 1);
+        BEAST_EXPECT(books.isBookToXRP(USD));
+
+        // The book stays while any of its directories does
+        env(offer_cancel(alice, first));
+        env.close();
+        BEAST_EXPECT(booksOf(env, USD) == 1);
+        BEAST_EXPECT(books.isBookToXRP(USD));
+
+        env(offer_cancel(alice, second));
+        env.close();
+        BEAST_EXPECT(booksOf(env, USD) == 0);
+        BEAST_EXPECT(!books.isBookToXRP(USD));
+
+        // A book whose offers are crossed out goes away
+        env(offer(alice, XRP(10), USD(10)));
+        env.close();
+        BEAST_EXPECT(booksOf(env, xrpIssue()) == 1);
+        env(offer(gw, USD(10), XRP(10)));
+        env.close();
+        BEAST_EXPECT(booksOf(env, xrpIssue()) == 0);
+        BEAST_EXPECT(booksOf(env, USD) == 0);
+    }
+
+    void
+    testAMM()
+    {
+        testcase("AMM");
+        using namespace jtx;
+
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const gw{"gateway"};
+        auto const USD = gw["USD"];
+        env.fund(XRP(30000), alice, gw);
+        env.close();
+        env.trust(USD(30000), alice);
+        env.close();
+        env(pay(gw, alice, USD(20000)));
+        env.close();
+
+        // An AMM makes a book each way
+        AMM amm(env, alice, XRP(10000), USD(10000));
+        env.close();
+        BEAST_EXPECT(booksOf(env, USD) == 1);
+        BEAST_EXPECT(booksOf(env, xrpIssue()) == 1);
+        BEAST_EXPECT(env.app().getOrderBookDB().isBookToXRP(USD));
+
+        amm.withdrawAll(alice);
+        env.close();
+        BEAST_EXPECT(!amm.ammExists());
+        BEAST_EXPECT(booksOf(env, USD) == 0);
+        BEAST_EXPECT(booksOf(env, xrpIssue()) == 0);
+        BEAST_EXPECT(!env.app().getOrderBookDB().isBookToXRP(USD));
+    }
+
+public:
+    void
+    run() override
+    {
+        testOffers();
+        testAMM();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(OrderBookDB, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,238 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/paths/PathDependencies.h>
+#include <ripple/app/paths/Pathfinder.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/Indexes.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class PathDependencies_test : public beast::unit_test::suite
+{
+    static PathDependencies
+    onAccounts(std::initializer_list<AccountID> accounts)
+    {
+        PathDependencies deps;
+        deps.accounts.insert(accounts.begin(), accounts.end());
+        return deps;
+    }
+
+    void
+    testAccounts()
+    {
+        testcase("accounts");
+        using namespace jtx;
+
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        Account const carol{"carol"};
+        Account const gw{"gateway"};
+        auto const USD = gw["USD"];
+        env.fund(XRP(10000), alice, bob, carol, gw);
+        env.close();
+        env.trust(USD(100), alice, bob);
+        env.close();
+
+        env(pay(gw, alice, USD(10)));
+        env.close();
+        LedgerChanges const paid{*env.closed()};
+        BEAST_EXPECT(paid.affects(onAccounts({alice.id()})));
+        BEAST_EXPECT(paid.affects(onAccounts({gw.id()})));
+        BEAST_EXPECT(paid.affects(onAccounts({carol.id(), alice.id()})));
+        BEAST_EXPECT(!paid.affects(onAccounts({bob.id(), carol.id()})));
+        BEAST_EXPECT(paid.lineAccounts().count(alice.id()));
+        BEAST_EXPECT(paid.lineAccounts().count(gw.id()));
+        BEAST_EXPECT(!paid.lineAccounts().count(bob.id()));
+
+        // A payment in XRP changes the account roots but no trust lines
+        env(pay(carol, bob, XRP(10)));
+        env.close();
+        LedgerChanges const xrp{*env.closed()};
+        BEAST_EXPECT(xrp.affects(onAccounts({bob.id()})));
+        BEAST_EXPECT(xrp.affects(onAccounts({carol.id()})));
+        BEAST_EXPECT(!xrp.affects(onAccounts({alice.id(), gw.id()})));
+        BEAST_EXPECT(xrp.lineAccounts().empty());
+
+        // An empty ledger changes nothing
+        env.close();
+        LedgerChanges const empty{*env.closed()};
+        BEAST_EXPECT(!empty.affects(onAccounts({alice.id(), bob.id()})));
+    }
+
+    void
+    testBooksAndKeys()
+    {
+        testcase("books and keys");
+        using namespace jtx;
+
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const carol{"carol"};
+        Account const gw{"gateway"};
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+        env.fund(XRP(10000), alice, carol, gw);
+        env.close();
+
+        auto const offerSeq = env.seq(carol);
+        env(offer(carol, USD(10), XRP(10)));
+        env.close();
+        LedgerChanges const changes{*env.closed()};
+        auto const offerKey = keylet::offer(carol.id(), offerSeq).key;
+
+        PathDependencies deps;
+        deps.books.insert(USD.issue());
+        BEAST_EXPECT(changes.affects(deps));
+        deps.books = {EUR.issue()};
+        BEAST_EXPECT(!changes.affects(deps));
+
+        deps.keys.insert(keylet::account(alice.id()).key);
+        BEAST_EXPECT(!changes.affects(deps));
+        deps.keys.insert(offerKey);
+        BEAST_EXPECT(changes.affects(deps));
+
+        // A new entry is found by a search over a range that holds it
+        deps.keys.clear();
+        deps.ranges.emplace_back(offerKey, offerKey);
+        BEAST_EXPECT(!changes.affects(deps));
+        deps.ranges.emplace_back(uint256{}, std::nullopt);
+        BEAST_EXPECT(changes.affects(deps));
+    }
+
+    void
+    testRecordingView()
+    {
+        testcase("recording view");
+        using namespace jtx;
+
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const carol{"carol"};
+        Account const gw{"gateway"};
+        auto const USD = gw["USD"];
+        env.fund(XRP(10000), alice, carol, gw);
+        env.close();
+
+        auto const expires =
+            env.current()->info().parentCloseTime + std::chrono::hours(1);
+        auto const offerSeq = env.seq(carol);
+        env(offer(carol, USD(10), XRP(10)),
+            json(
+                sfExpiration.fieldName,
+                std::uint32_t(expires.time_since_epoch().count())));
+        env.close();
+
+        PathDependencies deps;
+        RecordingView const view{*env.closed(), deps};
+        BEAST_EXPECT(view.info().hash == env.closed()->info().hash);
+        BEAST_EXPECT(view.read(keylet::account(alice.id())));
+        BEAST_EXPECT(!view.exists(keylet::account(Account{"dan"}.id())));
+        BEAST_EXPECT(deps.keys.size() == 2);
+        BEAST_EXPECT(deps.keys.count(keylet::account(alice.id()).key));
+        BEAST_EXPECT(!deps.expires);
+
+        auto const offerKey = keylet::offer(carol.id(), offerSeq);
+        BEAST_EXPECT(view.read(offerKey));
+        BEAST_EXPECT(deps.expires == expires);
+
+        BEAST_EXPECT(view.succ(uint256{}));
+        BEAST_EXPECT(deps.ranges.size() == 1);
+        BEAST_EXPECT(deps.ranges.front().first == uint256{});
+        BEAST_EXPECT(!deps.ranges.front().second);
+
+        // The result no longer holds once the offer has expired
+        LedgerChanges const changes{*env.closed()};
+        PathDependencies expiring;
+        expiring.expires = expires;
+        BEAST_EXPECT(!changes.affects(expiring));
+        expiring.expires = env.closed()->info().parentCloseTime;
+        BEAST_EXPECT(changes.affects(expiring));
+
+        // Merging keeps everything and the earliest expiry
+        PathDependencies merged = onAccounts({alice.id()});
+        merged.merge(deps);
+        merged.merge(expiring);
+        BEAST_EXPECT(merged.accounts.size() == 1);
+        BEAST_EXPECT(merged.keys.size() == 3);
+        BEAST_EXPECT(merged.ranges.size() == 1);
+        BEAST_EXPECT(merged.expires == expiring.expires);
+    }
+
+    void
+    testRanking()
+    {
+        testcase("ranking");
+        using namespace jtx;
+
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        Account const carol{"carol"};
+        Account const gw{"gateway"};
+        auto const USD = gw["USD"];
+        env.fund(XRP(10000), alice, bob, carol, gw);
+        env.close();
+        env.trust(USD(1000), bob, carol);
+        env.close();
+        env(pay(gw, carol, USD(100)));
+        env(offer(carol, XRP(50), USD(50)));
+        env.close();
+
+        Pathfinder pf(
+            std::make_shared<RippleLineCache>(env.closed(), env.journal),
+            alice,
+            bob,
+            xrpCurrency(),
+            std::nullopt,
+            USD(10),
+            std::nullopt,
+            env.app());
+        BEAST_EXPECT(pf.findPaths(7));
+        pf.computePathRanks(4);
+
+        // Ranking the path through the book reads what funds the offer
+        auto const& deps = pf.dependencies();
+        auto const carolLine = keylet::line(carol.id(), USD.issue()).key;
+        BEAST_EXPECT(deps.keys.count(carolLine));
+
+        env(pay(gw, carol, USD(10)));
+        env.close();
+        LedgerChanges const changes{*env.closed()};
+        BEAST_EXPECT(changes.affects(deps));
+    }
+
+public:
+    void
+    run() override
+    {
+        testAccounts();
+        testBooksAndKeys();
+        testRecordingView();
+        testRanking();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PathDependencies, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -31,6 +31,7 @@
 #include <ripple/rpc/RPCHandler.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 #include <ripple/rpc/impl/Tuning.h>
+#include <array>
 #include <chrono>
 #include <condition_variable>
 #include <mutex>
@@ -449,6 +450,136 @@ public:
         }
     }
 
+    void
+    parallel_path_search()
+    {
+        testcase("parallel path search");
+        using namespace jtx;
+
+        // Alice can pay bob in several currencies, some through two
+        // gateways and some only through offers.
+        auto const search = [this](std::size_t threads) {
+            Env env(*this, envconfig([threads](std::unique_ptr<Config> cfg) {
+                cfg->PATH_SEARCH_OLD = 7;
+                cfg->PATH_SEARCH = 7;
+                cfg->PATH_SEARCH_MAX = 10;
+                cfg->PATH_SEARCH_THREADS = threads;
+                return cfg;
+            }));
+            auto const gw = Account("gateway");
+            auto const gw2 = Account("gateway2");
+            env.fund(XRP(10000), "alice", "bob", "carol", gw, gw2);
+            env.close();
+            for (auto const& c : {"USD", "EUR", "GBP", "JPY", "CNY"})
+            {
+                env.trust(gw[c](1000), "alice", "bob", "carol");
+                env.trust(gw2[c](1000), "alice", "bob", "carol");
+                env.close();
+                env(pay(gw, "alice", gw[c](100)));
+                env(pay(gw2, "alice", gw2[c](100)));
+                env(pay(gw, "carol", gw[c](500)));
+            }
+            env.close();
+            for (auto const& c : {"EUR", "GBP", "JPY"})
+                env(offer("carol", gw[c](60), gw["USD"](50)));
+            env(offer("carol", XRP(100), gw["USD"](40)));
+            env.close();
+
+            auto const result =
+                find_paths_request(env, "alice", "bob", gw["USD"](150));
+            return result[jss::alternatives];
+        };
+
+        auto const serial = search(1);
+        BEAST_EXPECT(serial.size() > 1);
+        BEAST_EXPECT(search(4) == serial);
+        BEAST_EXPECT(search(16) == serial);
+    }
+
+    void
+    shared_path_search()
+    {
+        testcase("shared path search");
+        using namespace jtx;
+
+        Env env(*this);
+        auto const gw = Account("gateway");
+        env.fund(XRP(10000), "alice", "bob", "carol", gw);
+        env.close();
+        env.trust(gw["USD"](1000), "alice", "bob", "carol");
+        env.close();
+        env(pay(gw, "alice", gw["USD"](100)));
+        env(pay(gw, "carol", gw["USD"](100)));
+        env(offer("carol", XRP(100), gw["USD"](50)));
+        env.close();
+
+        auto const alone =
+            find_paths_request(env, "alice", "bob", gw["USD"](10));
+        BEAST_EXPECT(alone[jss::alternatives].size() > 0);
+
+        // Requests made together are updated together, and those asking
+        // the same get the same answer whether or not they shared it
+        struct Request
+        {
+            Resource::Charge loadType = Resource::feeReferenceRPC;
+            Resource::Consumer c;
+            Json::Value result;
+            gate g;
+        };
+        std::array<Request, 4> requests;
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {
+            Json::Value params = Json::objectValue;
+            params[jss::command] = "ripple_path_find";
+            params[jss::source_account] = toBase58(Account("alice"));
+            params[jss::destination_account] =
+                toBase58(Account(i == 3 ? "carol" : "bob"));
+            params[jss::destination_amount] =
+                gw["USD"](10).value().getJson(JsonOptions::none);
+
+            env.app().getJobQueue().postCoro(
+                jtCLIENT,
+                "RPC-Client",
+                [&env, &r = requests[i], params](auto const& coro) {
+                    auto& app = env.app();
+                    RPC::JsonContext context{
+                        {env.journal,
+                         app,
+                         r.loadType,
+                         app.getOPs(),
+                         app.getLedgerMaster(),
+                         r.c,
+                         Role::USER,
+                         coro,
+                         {},
+                         RPC::apiVersionIfUnspecified},
+                        params,
+                        {}};
+                    RPC::doCommand(context, r.result);
+                    r.g.signal();
+                });
+        }
+
+        using namespace std::chrono_literals;
+        for (auto& r : requests)
+        {
+            BEAST_EXPECT(r.g.wait_for(5s));
+            BEAST_EXPECT(!r.result.isMember(jss::error));
+        }
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            BEAST_EXPECT(
+                requests[i].result[jss::alternatives] ==
+                alone[jss::alternatives]);
+            BEAST_EXPECT(
+                requests[i].result[jss::destination_account] ==
+                toBase58(Account("bob")));
+        }
+        BEAST_EXPECT(
+            requests[3].result[jss::destination_account] ==
+            toBase58(Account("carol")));
+    }
+
     void
     alternative_path_consume_both()
     {
@@ -1354,6 +1485,8 @@ public:
         payment_auto_path_find();
         path_find();
         path_find_consume_all();
+        parallel_path_search();
+        shared_path_search();
         alternative_path_consume_both();
         alternative_paths_consume_best_transfer();
         alternative_paths_consume_best_transfer_first();
@@ -0,0 +1,323 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/paths/Flow.h>
+#include <ripple/app/paths/Pathfinder.h>
+#include <ripple/app/paths/RippleLineCache.h>
+#include <ripple/app/tx/apply.h>
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/basics/CountedObject.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/json/to_string.h>
+#include <ripple/ledger/OpenView.h>
+#include <ripple/ledger/PaymentSandbox.h>
+#include <test/jtx.h>
+#include <test/jtx/AMM.h>
+#include <boost/algorithm/string.hpp>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace ripple {
+namespace test {
+
+/*  Payment engine benchmark.
+
+    Builds order books on a jtx Env and times the payment engine over
+    them: a payment through flow(), a path search with the Pathfinder,
+    and an OfferCreate that crosses the book. Each operation runs on a
+    fresh view over the same ledger, so every run sees the same books.
+    It reports operations per second and the counted objects (ledger
+    entries, STObjects and the like) that one operation holds when it
+    is done, the closest the tree gets to allocations per operation.
+    This suite is manual:
+
+        rippled --unittest=PaymentBenchmark --unittest-arg="<config>"
+
+    The config is a comma separated list of key=value pairs:
+
+        depth       Quality levels in the XRP/USD book. Default 10.
+        offers      Offers at each quality level, each from a different
+                    owner. Default 10.
+        fanout      Gateways issuing USD. The payer and the payee trust
+                    all of them and each has an XRP book, so the path
+                    search has that many ways to go. Default 4.
+        amm         Gateways whose USD also has an XRP AMM pool, the
+                    first one competing with the measured book.
+                    Default 0.
+        take        Offers a payment or a crossing consumes. Default 5.
+        level       Path search level. Default PATH_SEARCH.
+        iterations  Runs of each operation. Default 200 (20 in debug).
+        json        A file to append one JSON object per run to.
+*/
+class PaymentBenchmark_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+#ifndef NDEBUG
+    static constexpr std::size_t defaultIterations = 20;
+#else
+    static constexpr std::size_t defaultIterations = 200;
+#endif
+
+    struct Params
+    {
+        std::size_t depth;
+        std::size_t offers;
+        std::size_t fanout;
+        std::size_t amm;
+        std::size_t take;
+        int level;
+        std::size_t iterations;
+    };
+
+    struct Result
+    {
+        std::string what;
+        double opsPerSecond;
+        std::int64_t objects;
+    };
+
+    static std::int64_t
+    liveObjects()
+    {
+        std::int64_t n = 0;
+        for (auto const& [name, count] :
+             CountedObjects::getInstance().getCounts(0))
+            n += count;
+        return n;
+    }
+
+    // Run op once to count the objects it holds, then time it. op takes
+    // a pointer to set to that count before its views go away, or null.
+    template <class F>
+    Result
+    measure(std::string const& what, std::size_t iterations, F&& op)
+    {
+        Result result{what, 0, 0};
+        {
+            auto const before = liveObjects();
+            op(&result.objects);
+            result.objects -= before;
+        }
+
+        auto const start = clock_type::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+            op(nullptr);
+        std::chrono::duration<double> const elapsed =
+            clock_type::now() - start;
+        result.opsPerSecond = elapsed.count() > 0
+            ? static_cast<double>(iterations) / elapsed.count()
+            : 0;
+
+        log << std::left << std::setw(12) << what << std::right
+            << std::setw(14) << std::fixed << std::setprecision(1)
+            << result.opsPerSecond << " ops/s" << std::setw(10)
+            << result.objects << " objects/op" << std::endl;
+        return result;
+    }
+
+    static void
+    hold(std::int64_t* objects)
+    {
+        if (objects)
+            *objects = liveObjects();
+    }
+
+    void
+    runBenchmark(Params const& p, std::string const& json)
+    {
+        using namespace jtx;
+
+        Env env{*this};
+        auto const j = env.app().journal("PaymentBenchmark");
+
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        Account const mm{"mm"};
+        Account const lp{"lp"};
+
+        std::vector<Account> gateways;
+        for (std::size_t i = 0; i < p.fanout; ++i)
+            gateways.emplace_back("gw" + std::to_string(i));
+        std::vector<Account> makers;
+        for (std::size_t i = 0; i < p.offers; ++i)
+            makers.emplace_back("maker" + std::to_string(i));
+
+        auto const USD = gateways.front()["USD"];
+        auto const size = p.depth * p.offers;
+
+        env.fund(XRP(100'000'000), alice, bob, mm, lp);
+        for (auto const& gw : gateways)
+            env.fund(XRP(100'000), gw);
+        for (auto const& maker : makers)
+            env.fund(XRP(100'000), maker);
+        env.close();
+
+        for (auto const& gw : gateways)
+        {
+            auto const iou = gw["USD"];
+            env.trust(iou(100'000'000), alice, bob, mm, lp);
+            env(pay(gw, alice, iou(100'000)));
+            env(pay(gw, mm, iou(100'000)));
+            env(pay(gw, lp, iou(100'000)));
+        }
+        for (auto const& maker : makers)
+        {
+            env.trust(USD(100'000'000), maker);
+            env(pay(gateways.front(), maker, USD(100 * p.depth)));
+        }
+        env.close();
+
+        // Each level is one drop per USD worse than the one before
+        for (std::size_t level = 0; level < p.depth; ++level)
+        {
+            for (auto const& maker : makers)
+                env(offer(maker, drops(100'000'000 + 100 * level), USD(100)));
+            env.close();
+        }
+
+        // The other gateways' books, for the path search
+        for (std::size_t i = 1; i < p.fanout; ++i)
+        {
+            for (std::size_t k = 0; k < p.offers; ++k)
+                env(offer(mm, XRP(101 + k), gateways[i]["USD"](100)));
+        }
+        env.close();
+
+        std::vector<std::unique_ptr<AMM>> pools;
+        for (std::size_t i = 0; i < std::min(p.amm, p.fanout); ++i)
+            pools.push_back(std::make_unique<AMM>(
+                env, lp, XRP(10'000), gateways[i]["USD"](10'000)));
+        env.close();
+
+        STAmount const deliver = USD(100 * std::min(p.take, size));
+        STAmount const sendMax = XRP(1'000 * std::min(p.take, size));
+
+        std::vector<Result> results;
+
+        results.push_back(measure("flow", p.iterations, [&](auto objects) {
+            PaymentSandbox sb(env.current().get(), tapNONE);
+            auto const r = flow(
+                sb,
+                deliver,
+                alice,
+                bob,
+                STPathSet{},
+                true,
+                false,
+                true,
+                OfferCrossing::no,
+                std::nullopt,
+                sendMax,
+                j);
+            BEAST_EXPECT(r.result() == tesSUCCESS);
+            hold(objects);
+        }));
+
+        results.push_back(
+            measure("pathfind", p.iterations, [&](auto objects) {
+                auto const cache =
+                    std::make_shared<RippleLineCache>(env.current(), j);
+                Pathfinder pf(
+                    cache,
+                    alice,
+                    bob,
+                    xrpCurrency(),
+                    std::nullopt,
+                    deliver,
+                    std::nullopt,
+                    env.app());
+                if (BEAST_EXPECT(pf.findPaths(p.level)))
+                {
+                    pf.computePathRanks(4);
+                    STPath fullLiquidityPath;
+                    pf.getBestPaths(4, fullLiquidityPath, {}, xrpAccount());
+                }
+                hold(objects);
+            }));
+
+        auto const cross = env.jt(offer(alice, deliver, sendMax));
+        results.push_back(
+            measure("crossing", p.iterations, [&](auto objects) {
+                OpenView view(&*env.current());
+                auto const r =
+                    ripple::apply(env.app(), view, *cross.stx, tapNONE, j);
+                BEAST_EXPECT(r.first == tesSUCCESS);
+                hold(objects);
+            }));
+
+        if (json.empty())
+            return;
+
+        Json::Value jv(Json::objectValue);
+        jv["depth"] = static_cast<Json::UInt>(p.depth);
+        jv["offers"] = static_cast<Json::UInt>(p.offers);
+        jv["fanout"] = static_cast<Json::UInt>(p.fanout);
+        jv["amm"] = static_cast<Json::UInt>(pools.size());
+        jv["take"] = static_cast<Json::UInt>(p.take);
+        jv["level"] = p.level;
+        jv["iterations"] = static_cast<Json::UInt>(p.iterations);
+        for (auto const& r : results)
+        {
+            auto& entry = jv["results"][r.what];
+            entry["ops_per_second"] = r.opsPerSecond;
+            entry["objects_per_op"] = static_cast<Json::Int>(r.objects);
+        }
+        std::ofstream out(json, std::ofstream::app);
+        out << to_string(jv) << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        std::vector<std::string> lines;
+        boost::split(lines, arg(), boost::is_any_of(","));
+        Section config;
+        config.append(lines);
+
+        Params p;
+        p.depth =
+            std::max<std::size_t>(1, get<std::size_t>(config, "depth", 10));
+        p.offers =
+            std::max<std::size_t>(1, get<std::size_t>(config, "offers", 10));
+        p.fanout =
+            std::max<std::size_t>(1, get<std::size_t>(config, "fanout", 4));
+        p.amm = get<std::size_t>(config, "amm", 0);
+        p.take =
+            std::max<std::size_t>(1, get<std::size_t>(config, "take", 5));
+        p.level = get<int>(config, "level", Config{}.PATH_SEARCH);
+        p.iterations = std::max<std::size_t>(
+            1, get<std::size_t>(config, "iterations", defaultIterations));
+
+        std::ostringstream name;
+        name << "depth=" << p.depth << " offers=" << p.offers
+             << " fanout=" << p.fanout << " amm=" << p.amm
+             << " take=" << p.take;
+        testcase(name.str());
+        runBenchmark(p, get(config, "json", ""));
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(PaymentBenchmark, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
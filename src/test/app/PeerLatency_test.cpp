@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/PeerLatency.h>
+#include <ripple/beast/unit_test.h>
+
+namespace ripple {
+namespace test {
+
+class PeerLatency_test : public beast::unit_test::suite
+{
+    using ms = std::chrono::milliseconds;
+
+    void
+    testLatency()
+    {
+        testcase("latency");
+
+        PeerLatency latency{ms{100}, ms{500}, 16};
+        BEAST_EXPECT(latency.latency(1) == ms{100});
+        BEAST_EXPECT(latency.size() == 0);
+
+        // The first sample is taken as is, later ones are averaged in
+        latency.reply(1, ms{40});
+        BEAST_EXPECT(latency.latency(1) == ms{40});
+        latency.reply(1, ms{80});
+        BEAST_EXPECT(latency.latency(1) == ms{50});
+
+        // A timeout counts as a slow reply
+        latency.timeout(2);
+        BEAST_EXPECT(latency.latency(2) == ms{500});
+        latency.reply(2, ms{100});
+        BEAST_EXPECT(latency.latency(2) == ms{400});
+        BEAST_EXPECT(latency.size() == 2);
+    }
+
+    void
+    testRank()
+    {
+        testcase("rank");
+
+        PeerLatency latency{ms{100}, ms{500}, 16};
+        latency.reply(1, ms{200});
+        latency.reply(2, ms{20});
+        latency.timeout(3);
+
+        // Peers not yet measured sit between the fast and the slow ones
+        std::vector<Peer::id_t> ids{1, 2, 3, 4, 5};
+        latency.rank(ids);
+        BEAST_EXPECT((ids == std::vector<Peer::id_t>{2, 4, 5, 1, 3}));
+    }
+
+    void
+    testCapacity()
+    {
+        testcase("capacity");
+
+        PeerLatency latency{ms{100}, ms{500}, 2};
+        latency.reply(1, ms{10});
+        latency.reply(2, ms{20});
+        latency.reply(1, ms{10});
+
+        // The peer updated longest ago is forgotten first
+        latency.reply(3, ms{30});
+        BEAST_EXPECT(latency.size() == 2);
+        BEAST_EXPECT(latency.latency(1) == ms{10});
+        BEAST_EXPECT(latency.latency(2) == ms{100});
+        BEAST_EXPECT(latency.latency(3) == ms{30});
+    }
+
+public:
+    void
+    run() override
+    {
+        testLatency();
+        testRank();
+        testCapacity();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PeerLatency, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
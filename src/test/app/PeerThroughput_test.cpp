@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/PeerThroughput.h>
+#include <ripple/beast/clock/manual_clock.h>
+#include <ripple/beast/unit_test.h>
+
+namespace ripple {
+namespace test {
+
+class PeerThroughput_test : public beast::unit_test::suite
+{
+    using clock_type = beast::manual_clock<std::chrono::steady_clock>;
+
+    void
+    testRate()
+    {
+        testcase("rate");
+
+        clock_type clock;
+        PeerThroughput throughput{clock, 1, 16};
+        BEAST_EXPECT(throughput.rate(1) == 0);
+        BEAST_EXPECT(throughput.size() == 0);
+
+        // The nodes received count over the thirty second half life
+        throughput.received(1, 300);
+        BEAST_EXPECT(throughput.rate(1) == 10);
+        clock.advance(std::chrono::seconds{30});
+        BEAST_EXPECT(throughput.rate(1) == 5);
+        BEAST_EXPECT(throughput.size() == 1);
+    }
+
+    void
+    testAssign()
+    {
+        testcase("assign");
+
+        clock_type clock;
+        PeerThroughput throughput{clock, 1, 16};
+        throughput.assign(1);
+        throughput.assign(1);
+        BEAST_EXPECT(throughput.assigned(1) == 2);
+        throughput.release(1);
+        BEAST_EXPECT(throughput.assigned(1) == 1);
+        throughput.release(1);
+        throughput.release(1);
+        BEAST_EXPECT(throughput.assigned(1) == 0);
+
+        // Releasing a peer never seen is harmless
+        throughput.release(2);
+        BEAST_EXPECT(throughput.assigned(2) == 0);
+    }
+
+    void
+    testRank()
+    {
+        testcase("rank");
+
+        clock_type clock;
+        PeerThroughput throughput{clock, 1, 16};
+        throughput.received(1, 300);
+        throughput.received(2, 900);
+
+        std::vector<Peer::id_t> ids{3, 1, 2};
+        throughput.rank(ids);
+        BEAST_EXPECT((ids == std::vector<Peer::id_t>{2, 1, 3}));
+
+        // Work assigned to the fastest peer sends the next to the others
+        for (int i = 0; i < 3; ++i)
+            throughput.assign(2);
+        throughput.rank(ids);
+        BEAST_EXPECT((ids == std::vector<Peer::id_t>{1, 2, 3}));
+    }
+
+    void
+    testCapacity()
+    {
+        testcase("capacity");
+
+        clock_type clock;
+        PeerThroughput throughput{clock, 1, 2};
+        throughput.assign(1);
+        throughput.received(2, 30);
+        throughput.received(1, 30);
+
+        // The idle peer updated longest ago is forgotten first, and a peer
+        // still serving an acquisition is kept
+        throughput.received(3, 30);
+        BEAST_EXPECT(throughput.size() == 2);
+        BEAST_EXPECT(throughput.assigned(1) == 1);
+        BEAST_EXPECT(throughput.rate(2) == 0);
+        BEAST_EXPECT(throughput.rate(3) == 1);
+    }
+
+public:
+    void
+    run() override
+    {
+        testRate();
+        testAssign();
+        testRank();
+        testCapacity();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PeerThroughput, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/consensus/RCLSpeculation.h>
+#include <ripple/beast/unit_test.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+class RCLSpeculation_test : public beast::unit_test::suite
+{
+    struct Key
+    {
+        int prevLedger;
+        int txSet;
+        int closeTime;
+
+        bool
+        operator==(Key const&) const = default;
+    };
+
+    using Speculation = RCLSpeculation<Key, std::string>;
+
+    static constexpr std::chrono::milliseconds noWait{0};
+
+    void
+    testMatch()
+    {
+        testcase("Match");
+
+        Speculation s;
+        auto const h = s.start({1, 2, 3});
+        BEAST_EXPECT(h);
+        s.finish(h, "built");
+
+        auto const built = s.take({1, 2, 3}, noWait);
+        BEAST_EXPECT(built && *built == "built");
+
+        // Taken, so there is nothing left to take or discard
+        BEAST_EXPECT(!s.take({1, 2, 3}, noWait));
+        BEAST_EXPECT(!s.discard());
+    }
+
+    void
+    testMismatch()
+    {
+        testcase("Mismatch");
+
+        for (Key const key : {Key{9, 2, 3}, Key{1, 9, 3}, Key{1, 2, 9}})
+        {
+            Speculation s;
+            auto const h = s.start({1, 2, 3});
+            s.finish(h, "built");
+
+            BEAST_EXPECT(!s.take(key, noWait));
+
+            // The build is forgotten even though it did not match
+            BEAST_EXPECT(!s.take({1, 2, 3}, noWait));
+        }
+    }
+
+    void
+    testWait()
+    {
+        testcase("Wait");
+
+        using namespace std::chrono_literals;
+
+        Speculation s;
+        auto const h = s.start({1, 2, 3});
+        BEAST_EXPECT(h);
+
+        std::thread builder([&]() {
+            std::this_thread::sleep_for(50ms);
+            s.finish(h, "built");
+        });
+
+        auto const built = s.take({1, 2, 3}, 60s);
+        builder.join();
+        BEAST_EXPECT(built && *built == "built");
+    }
+
+    void
+    testTimeout()
+    {
+        testcase("Timeout");
+
+        using namespace std::chrono_literals;
+
+        Speculation s;
+        auto const h = s.start({1, 2, 3});
+
+        auto const start = std::chrono::steady_clock::now();
+        BEAST_EXPECT(!s.take({1, 2, 3}, 20ms));
+        BEAST_EXPECT(std::chrono::steady_clock::now() - start >= 20ms);
+
+        // A build finishing after it was given up on is dropped, and a new
+        // one can start meanwhile
+        auto const next = s.start({1, 2, 3});
+        BEAST_EXPECT(next);
+        s.finish(h, "late");
+        BEAST_EXPECT(!s.take({1, 2, 3}, noWait));
+        BEAST_EXPECT(!s.discard());
+        s.finish(next, "later");
+    }
+
+    void
+    testFailed()
+    {
+        testcase("Failed");
+
+        Speculation s;
+        auto const h = s.start({1, 2, 3});
+        s.finish(h, std::nullopt);
+        BEAST_EXPECT(!s.take({1, 2, 3}, noWait));
+    }
+
+    void
+    testStart()
+    {
+        testcase("Start");
+
+        Speculation s;
+        auto const h = s.start({1, 2, 3});
+        BEAST_EXPECT(h);
+
+        // Not while building, whatever the position
+        BEAST_EXPECT(!s.start({1, 2, 3}));
+        BEAST_EXPECT(!s.start({1, 2, 4}));
+
+        s.finish(h, "built");
+
+        // Not again for a position already built, but for another one
+        BEAST_EXPECT(!s.start({1, 2, 3}));
+        auto const other = s.start({1, 2, 4});
+        BEAST_EXPECT(other);
+        s.finish(other, "other");
+
+        BEAST_EXPECT(!s.take({1, 2, 3}, noWait));
+    }
+
+    void
+    testDiscard()
+    {
+        testcase("Discard");
+
+        Speculation s;
+        BEAST_EXPECT(!s.discard());
+
+        auto const h = s.start({1, 2, 3});
+        BEAST_EXPECT(s.discard());
+        BEAST_EXPECT(!s.discard());
+
+        // The build may still finish, to no effect
+        s.finish(h, "built");
+        BEAST_EXPECT(!s.take({1, 2, 3}, noWait));
+    }
+
+public:
+    void
+    run() override
+    {
+        testMatch();
+        testMismatch();
+        testWait();
+        testTimeout();
+        testFailed();
+        testStart();
+        testDiscard();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(RCLSpeculation, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
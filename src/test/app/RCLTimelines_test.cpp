@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/consensus/RCLTimelines.h>
+#include <ripple/beast/clock/manual_clock.h>
+#include <ripple/beast/insight/NullCollector.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/jss.h>
+
+namespace ripple {
+namespace test {
+
+class RCLTimelines_test : public beast::unit_test::suite
+{
+    using clock_type = beast::manual_clock<std::chrono::steady_clock>;
+
+    static ConsensusTimeline
+    makeTimeline(clock_type& clock)
+    {
+        using namespace std::chrono_literals;
+
+        ConsensusTimeline timeline;
+        timeline.opened = clock.now();
+        clock.advance(50ms);
+        timeline.firstProposal = clock.now();
+        clock.advance(950ms);
+        timeline.closed = clock.now();
+        clock.advance(500ms);
+        timeline.positionChanges.push_back(clock.now());
+        clock.advance(1000ms);
+        timeline.consensus = clock.now();
+        clock.advance(100ms);
+        timeline.built = clock.now();
+        clock.advance(10ms);
+        timeline.validated = clock.now();
+        return timeline;
+    }
+
+    void
+    testRecord()
+    {
+        testcase("record");
+        using namespace std::chrono_literals;
+
+        clock_type clock;
+        RCLTimelines timelines{2, clock, beast::insight::NullCollector::New()};
+
+        timelines.record(1, uint256{1}, makeTimeline(clock));
+        clock.advance(40ms);
+        timelines.quorum(uint256{1});
+        // Only the first quorum is stamped
+        clock.advance(1s);
+        timelines.quorum(uint256{1});
+        // A ledger no round built is ignored
+        timelines.quorum(uint256{9});
+
+        auto json = timelines.getJson(10);
+        if (!BEAST_EXPECT(json[jss::rounds].size() == 1))
+            return;
+
+        auto const& round = json[jss::rounds][0u];
+        BEAST_EXPECT(round[jss::ledger_index].asUInt() == 1);
+        BEAST_EXPECT(round[jss::ledger_hash] == to_string(uint256{1}));
+        BEAST_EXPECT(round[jss::first_proposal].asInt() == 50);
+        BEAST_EXPECT(round[jss::closed].asInt() == 1000);
+        BEAST_EXPECT(round[jss::position_changes].size() == 1);
+        BEAST_EXPECT(round[jss::position_changes][0u].asInt() == 1500);
+        BEAST_EXPECT(round[jss::consensus].asInt() == 2500);
+        BEAST_EXPECT(round[jss::built].asInt() == 2600);
+        BEAST_EXPECT(round[jss::validated].asInt() == 2610);
+        BEAST_EXPECT(round[jss::quorum].asInt() == 2650);
+    }
+
+    void
+    testCapacity()
+    {
+        testcase("capacity");
+
+        clock_type clock;
+        RCLTimelines timelines{2, clock, beast::insight::NullCollector::New()};
+
+        // A round that never closed only has its start
+        ConsensusTimeline open;
+        open.opened = clock.now();
+        timelines.record(1, uint256{1}, open);
+        {
+            auto json = timelines.getJson(10);
+            auto const& round = json[jss::rounds][0u];
+            BEAST_EXPECT(!round.isMember(jss::closed));
+            BEAST_EXPECT(!round.isMember(jss::quorum));
+            BEAST_EXPECT(round[jss::position_changes].size() == 0);
+        }
+
+        timelines.record(2, uint256{2}, makeTimeline(clock));
+        timelines.record(3, uint256{3}, makeTimeline(clock));
+        BEAST_EXPECT(timelines.size() == 2);
+
+        // The oldest round is gone, and the newest comes first
+        auto json = timelines.getJson(10);
+        if (!BEAST_EXPECT(json[jss::rounds].size() == 2))
+            return;
+        BEAST_EXPECT(json[jss::rounds][0u][jss::ledger_index].asUInt() == 3);
+        BEAST_EXPECT(json[jss::rounds][1u][jss::ledger_index].asUInt() == 2);
+
+        json = timelines.getJson(1);
+        if (!BEAST_EXPECT(json[jss::rounds].size() == 1))
+            return;
+        BEAST_EXPECT(json[jss::rounds][0u][jss::ledger_index].asUInt() == 3);
+
+        BEAST_EXPECT(timelines.getJson(0)[jss::rounds].size() == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testRecord();
+        testCapacity();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(RCLTimelines, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
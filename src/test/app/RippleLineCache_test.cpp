@@ -0,0 +1,184 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/paths/RippleLineCache.h>
+#include <ripple/beast/unit_test.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class RippleLineCache_test : public beast::unit_test::suite
+{
+    static std::size_t
+    countOf(std::shared_ptr<std::vector<PathFindTrustLine>> const& lines)
+    {
+        return lines ? lines->size() : 0;
+    }
+
+    void
+    testCarryOver()
+    {
+        testcase("carry over");
+        using namespace jtx;
+
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        Account const carol{"carol"};
+        Account const gw{"gateway"};
+        env.fund(XRP(10000), alice, bob, carol, gw);
+        env.close();
+        env.trust(gw["USD"](100), alice, bob);
+        env.close();
+
+        auto const out = LineDirection::outgoing;
+        RippleLineCache first{env.closed(), env.journal};
+        auto const bobLines = first.getRippleLines(bob, out);
+        BEAST_EXPECT(countOf(first.getRippleLines(alice, out)) == 1);
+        BEAST_EXPECT(countOf(bobLines) == 1);
+        BEAST_EXPECT(countOf(first.getRippleLines(gw, out)) == 2);
+        BEAST_EXPECT(!first.getRippleLines(carol, out));
+
+        // Only the accounts on either side of the new line are read again
+        env.trust(gw["EUR"](100), alice);
+        env.close();
+        RippleLineCache second{env.closed(), first, env.journal};
+        BEAST_EXPECT(second.getRippleLines(bob, out) == bobLines);
+        BEAST_EXPECT(countOf(second.getRippleLines(alice, out)) == 2);
+        BEAST_EXPECT(countOf(second.getRippleLines(gw, out)) == 3);
+        BEAST_EXPECT(!second.getRippleLines(carol, out));
+
+        // Payments change balances, so those lines are read again too
+        env(pay(gw, bob, gw["USD"](10)));
+        env.close();
+        RippleLineCache third{env.closed(), second, env.journal};
+        auto const paid = third.getRippleLines(bob, out);
+        BEAST_EXPECT(paid != bobLines);
+        BEAST_EXPECT(countOf(paid) == 1);
+        if (paid && !paid->empty())
+            BEAST_EXPECT(paid->front().getBalance().signum() > 0);
+    }
+
+    void
+    testUnrelatedLedger()
+    {
+        testcase("unrelated ledger");
+        using namespace jtx;
+
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const gw{"gateway"};
+        env.fund(XRP(10000), alice, gw);
+        env.close();
+        env.trust(gw["USD"](100), alice);
+        env.close();
+
+        auto const out = LineDirection::outgoing;
+        RippleLineCache first{env.closed(), env.journal};
+        auto const aliceLines = first.getRippleLines(alice, out);
+        BEAST_EXPECT(countOf(aliceLines) == 1);
+
+        // A ledger that does not build on the cached one carries nothing
+        env.close();
+        env.close();
+        RippleLineCache skipped{env.closed(), first, env.journal};
+        auto const lines = skipped.getRippleLines(alice, out);
+        BEAST_EXPECT(lines != aliceLines);
+        BEAST_EXPECT(countOf(lines) == 1);
+
+        // Neither does an open ledger
+        RippleLineCache open{env.current(), first, env.journal};
+        BEAST_EXPECT(open.getRippleLines(alice, out) != aliceLines);
+    }
+
+    void
+    testLineIndex()
+    {
+        testcase("line index");
+        using namespace jtx;
+
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        Account const gw{"gateway"};
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+        env.fund(XRP(10000), alice, bob, gw);
+        env.close();
+        env.trust(USD(100), alice, bob);
+        env.trust(EUR(100), alice);
+        env.close();
+        env(pay(gw, alice, USD(10)));
+        env.close();
+
+        auto const out = LineDirection::outgoing;
+        RippleLineCache first{env.closed(), env.journal};
+        BEAST_EXPECT(!first.getLineIndex(Account{"carol"}, out));
+
+        // alice holds USD to send and has room to take both currencies
+        auto const aliceIndex = first.getLineIndex(alice, out);
+        if (!BEAST_EXPECT(aliceIndex))
+            return;
+        BEAST_EXPECT(aliceIndex->lines == first.getRippleLines(alice, out));
+        BEAST_EXPECT(aliceIndex->send == hash_set<Currency>{USD.currency});
+        BEAST_EXPECT(
+            (aliceIndex->receive ==
+             hash_set<Currency>{USD.currency, EUR.currency}));
+        BEAST_EXPECT(aliceIndex->out.size() == 2);
+        BEAST_EXPECT(aliceIndex->out.at(USD.currency).rippling == 1);
+        BEAST_EXPECT(aliceIndex->out.at(EUR.currency).rippling == 0);
+        BEAST_EXPECT(first.getLineIndex(alice, out) == aliceIndex);
+
+        // The gateway extends no credit, but owes alice and bob both
+        auto const gwIndex = first.getLineIndex(gw, out);
+        if (!BEAST_EXPECT(gwIndex))
+            return;
+        BEAST_EXPECT(
+            (gwIndex->send == hash_set<Currency>{USD.currency, EUR.currency}));
+        BEAST_EXPECT(gwIndex->out.at(USD.currency).positions.size() == 2);
+        BEAST_EXPECT(gwIndex->out.at(USD.currency).rippling == 2);
+        BEAST_EXPECT(gwIndex->out.at(USD.currency).authorized == 0);
+
+        // The index stays with the lines into the next ledger
+        auto const bobIndex = first.getLineIndex(bob, out);
+        env(pay(gw, alice, EUR(5)));
+        env.close();
+        RippleLineCache second{env.closed(), first, env.journal};
+        BEAST_EXPECT(second.getLineIndex(gw, out) != gwIndex);
+        auto const paid = second.getLineIndex(alice, out);
+        if (BEAST_EXPECT(paid))
+            BEAST_EXPECT(paid->send.count(EUR.currency));
+        BEAST_EXPECT(bobIndex && second.getLineIndex(bob, out) == bobIndex);
+    }
+
+public:
+    void
+    run() override
+    {
+        testCarryOver();
+        testUnrelatedLedger();
+        testLineIndex();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(RippleLineCache, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
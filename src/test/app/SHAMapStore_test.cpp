@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/SHAMapStore.h>
 #include <ripple/app/rdb/backend/SQLiteDatabase.h>
@@ -166,6 +167,28 @@ class SHAMapStore_test : public beast::unit_test::suite
         return ledgerSeq;
     }
 
+    // Every node of the validated ledger's state and transaction maps must
+    // be in the node store
+    bool
+    validatedComplete(jtx::Env& env)
+    {
+        auto const validated =
+            env.app().getLedgerMaster().getValidatedLedger();
+        if (!BEAST_EXPECT(validated))
+            return false;
+
+        bool complete = true;
+        auto const check = [&](SHAMapTreeNode& node) {
+            if (!env.app().getNodeStore().fetchNodeObject(
+                    node.getHash().as_uint256(), validated->info().seq))
+                complete = false;
+            return complete;
+        };
+        validated->stateMap().visitNodes(check);
+        validated->txMap().visitNodes(check);
+        return complete;
+    }
+
 public:
     void
     testClear()
@@ -518,12 +541,93 @@ public:
         lastRotated = ledgerSeq - 1;
     }
 
+    void
+    testIncremental()
+    {
+        testcase("online_delete with incremental_rotation");
+        using namespace jtx;
+        using namespace std::chrono_literals;
+
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg = onlineDelete(std::move(cfg));
+            cfg->section(ConfigSection::nodeDatabase())
+                .set("incremental_rotation", "1");
+            return cfg;
+        }));
+        auto& store = env.app().getSHAMapStore();
+
+        auto ledgerSeq = waitForReady(env);
+        auto lastRotated = ledgerSeq - 1;
+
+        // State created before the rotations must survive all of them
+        Account const alice{"alice"};
+        env.fund(XRP(1000), alice);
+
+        // The first rotation copies everything, later ones only copy the
+        // differences from the state copied forward after the previous one
+        for (int rotation = 0; rotation < 3; ++rotation)
+        {
+            for (; ledgerSeq < lastRotated + deleteInterval + 1; ++ledgerSeq)
+            {
+                env.close();
+
+                auto ledger = env.rpc("ledger", "validated");
+                BEAST_EXPECT(
+                    goodLedger(env, ledger, std::to_string(ledgerSeq), true));
+            }
+
+            store.rendezvous();
+            BEAST_EXPECT(lastRotated != store.getLastRotated());
+            lastRotated = store.getLastRotated();
+        }
+
+        BEAST_EXPECT(env.le(alice));
+        BEAST_EXPECT(validatedComplete(env));
+    }
+
+    void
+    testRotateComplete()
+    {
+        testcase("rotation keeps the validated ledger");
+        using namespace jtx;
+        using namespace std::chrono_literals;
+
+        Env env(*this, envconfig(onlineDelete));
+        auto& store = env.app().getSHAMapStore();
+
+        auto ledgerSeq = waitForReady(env);
+        auto lastRotated = ledgerSeq - 1;
+
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        env.fund(XRP(1000), alice, bob);
+
+        for (int rotation = 0; rotation < 3; ++rotation)
+        {
+            for (; ledgerSeq < lastRotated + deleteInterval + 1; ++ledgerSeq)
+            {
+                env(pay(alice, bob, XRP(1)));
+                env.close();
+            }
+
+            store.rendezvous();
+            BEAST_EXPECT(lastRotated != store.getLastRotated());
+            lastRotated = store.getLastRotated();
+
+            // Nothing the validated ledger refers to may be lost, whether
+            // it was copied before the rotation or fetched after it.
+            BEAST_EXPECT(validatedComplete(env));
+        }
+    }
+
     void
     run() override
     {
         testClear();
         testAutomatic();
         testCanDelete();
+        testIncremental();
+        testRotateComplete();
     }
 };
 
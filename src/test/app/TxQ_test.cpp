@@ -2531,6 +2531,44 @@ public:
         }
     }
 
+    void
+    testAcceptBatches()
+    {
+        using namespace jtx;
+        testcase("accept batches");
+
+        Env env(
+            *this,
+            makeConfig(
+                {{"minimum_txn_in_ledger_standalone", "3"},
+                 {"accept_batch_size", "1"}}));
+
+        auto alice = Account("alice");
+        auto bob = Account("bob");
+        auto charlie = Account("charlie");
+        auto daria = Account("daria");
+
+        auto queued = ter(terQUEUED);
+
+        env.fund(XRP(50000), noripple(alice, bob, charlie, daria));
+        checkMetrics(__LINE__, env, 0, std::nullopt, 4, 3, 256);
+        auto const seq = env.seq(alice);
+
+        env(noop(alice), queued);
+        env(noop(charlie), fee(20), queued);
+        env(noop(daria), fee(15), queued);
+        checkMetrics(__LINE__, env, 3, std::nullopt, 4, 3, 256);
+
+        // Closing applies one queued transaction to the new open
+        // ledger, then jobs apply the others one at a time.
+        env.close();
+        env.app().getJobQueue().rendezvous();
+        checkMetrics(__LINE__, env, 0, 8, 3, 4, 256);
+        BEAST_EXPECT(env.seq(alice) == seq + 1);
+        BEAST_EXPECT(env.seq(charlie) == seq + 1);
+        BEAST_EXPECT(env.seq(daria) == seq + 1);
+    }
+
     void
     testAcctInQueueButEmpty()
     {
@@ -4949,6 +4987,7 @@ public:
         testBlockersTicket();
         testInFlightBalance();
         testConsequences();
+        testAcceptBatches();
     }
 
     void
@@ -17,10 +17,12 @@
 */
 //==============================================================================
 
+#include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/tx/apply.h>
 #include <ripple/basics/StringUtilities.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/protocol/Feature.h>
-#include <test/jtx/Env.h>
+#include <test/jtx.h>
 
 namespace ripple {
 
@@ -32,6 +34,8 @@ public:
     {
         testcase("Require Fully Canonicial Signature");
         testFullyCanonicalSigs();
+        testcase("Batch Signature Check");
+        testBatchValidity();
     }
 
     void
@@ -83,6 +87,51 @@ public:
 
         pass();
     }
+
+    void
+    testBatchValidity()
+    {
+        using namespace test::jtx;
+
+        Env env(*this);
+        Account const alice("alice");
+        env.fund(XRP(10000), alice);
+        env.close();
+
+        std::vector<std::shared_ptr<STTx const>> txs;
+        for (std::uint32_t i = 0; i < 20; ++i)
+            txs.push_back(env.jt(noop(alice), seq(env.seq(alice) + i)).stx);
+
+        // Damage the signature of the last one
+        STObject damaged(*txs.back());
+        auto sig = damaged.getFieldVL(sfTxnSignature);
+        sig[sig.size() / 2] ^= 0xff;
+        damaged.setFieldVL(sfTxnSignature, sig);
+        txs.back() = std::make_shared<STTx const>(std::move(damaged));
+
+        auto& router = env.app().getHashRouter();
+        auto const& rules = env.current()->rules();
+        checkValidity(
+            router,
+            txs,
+            rules,
+            env.app().config(),
+            env.app().getJobQueue(),
+            jtCLIENT,
+            4);
+
+        for (std::size_t i = 0; i < txs.size(); ++i)
+        {
+            // The batch left its results in the router
+            BEAST_EXPECT(router.getFlags(txs[i]->getTransactionID()) != 0);
+
+            auto const expected =
+                i + 1 < txs.size() ? Validity::Valid : Validity::SigBad;
+            BEAST_EXPECT(
+                checkValidity(router, *txs[i], rules, env.app().config())
+                    .first == expected);
+        }
+    }
 };
 
 BEAST_DEFINE_TESTSUITE(Apply, app, ripple);
@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+//==============================================================================
+
+#include <ripple/basics/Archive.h>
+#include <ripple/basics/FileUtilities.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/rngfill.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/beast/xor_shift_engine.h>
+
+#include <archive.h>
+#include <archive_entry.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+class Archive_test : public beast::unit_test::suite
+{
+    struct File
+    {
+        std::string name;
+        std::string contents;
+    };
+
+    // Write the files to a tar archive compressed with lz4
+    bool
+    createTarLz4(
+        boost::filesystem::path const& dst,
+        std::vector<std::string> const& dirs,
+        std::vector<File> const& files)
+    {
+        using archive_ptr =
+            std::unique_ptr<struct archive, void (*)(struct archive*)>;
+        archive_ptr aw{archive_write_new(), [](struct archive* a) {
+                           archive_write_free(a);
+                       }};
+        if (!BEAST_EXPECT(aw))
+            return false;
+
+        auto ok = [this](int result) {
+            return BEAST_EXPECT(result == ARCHIVE_OK);
+        };
+        if (!ok(archive_write_add_filter_lz4(aw.get())) ||
+            !ok(archive_write_set_format_pax_restricted(aw.get())) ||
+            !ok(archive_write_open_filename(aw.get(), dst.string().c_str())))
+        {
+            return false;
+        }
+
+        using entry_ptr = std::
+            unique_ptr<struct archive_entry, void (*)(struct archive_entry*)>;
+        auto write = [&](std::string const& name,
+                         std::string const* contents) {
+            entry_ptr entry{archive_entry_new(), archive_entry_free};
+            archive_entry_set_pathname(entry.get(), name.c_str());
+            archive_entry_set_filetype(
+                entry.get(), contents ? AE_IFREG : AE_IFDIR);
+            archive_entry_set_perm(entry.get(), contents ? 0644 : 0755);
+            archive_entry_set_size(
+                entry.get(), contents ? contents->size() : 0);
+            if (archive_write_header(aw.get(), entry.get()) != ARCHIVE_OK)
+                return false;
+            return !contents || contents->empty() ||
+                archive_write_data(
+                    aw.get(), contents->data(), contents->size()) ==
+                static_cast<la_ssize_t>(contents->size());
+        };
+
+        for (auto const& dir : dirs)
+        {
+            if (!BEAST_EXPECT(write(dir, nullptr)))
+                return false;
+        }
+        for (auto const& file : files)
+        {
+            if (!BEAST_EXPECT(write(file.name, &file.contents)))
+                return false;
+        }
+
+        return ok(archive_write_close(aw.get()));
+    }
+
+    void
+    testExtractTarLz4()
+    {
+        testcase("extractTarLz4");
+
+        using namespace boost::filesystem;
+
+        // Random data doesn't compress, so the archive runs to several of
+        // the blocks extractTarLz4 reads at a time. The sizes are not
+        // multiples of any block size.
+        beast::xor_shift_engine rng(97);
+        auto random = [&](std::size_t size) {
+            std::string s(size, '\0');
+            beast::rngfill(s.data(), s.size(), rng);
+            return s;
+        };
+
+        std::vector<std::string> const dirs{"shard", "shard/sub"};
+        std::vector<File> const files{
+            {"shard/nudb.dat", random(3 * 1024 * 1024 + 37)},
+            {"shard/nudb.key", random(1024 * 1024 - 5)},
+            {"shard/sub/small.txt", "A short file between large ones"},
+            {"shard/sub/empty", ""},
+            {"shard/last", random(2 * 1024 * 1024 + 1)}};
+
+        beast::temp_dir srcDir;
+        auto const archive = path(srcDir.path()) / "shard.tar.lz4";
+        if (!createTarLz4(archive, dirs, files))
+            return;
+        BEAST_EXPECT(file_size(archive) > 4 * 1024 * 1024);
+
+        beast::temp_dir dstDir;
+        try
+        {
+            extractTarLz4(archive, dstDir.path());
+        }
+        catch (std::exception const& e)
+        {
+            fail(e.what());
+            return;
+        }
+
+        for (auto const& dir : dirs)
+            BEAST_EXPECT(is_directory(path(dstDir.path()) / dir));
+
+        for (auto const& file : files)
+        {
+            auto const extracted = path(dstDir.path()) / file.name;
+            if (!BEAST_EXPECTS(is_regular_file(extracted), file.name))
+                continue;
+
+            boost::system::error_code ec;
+            auto const contents = getFileContents(ec, extracted);
+            BEAST_EXPECTS(!ec, file.name);
+            BEAST_EXPECTS(contents == file.contents, file.name);
+        }
+    }
+
+    void
+    testInvalidSource()
+    {
+        testcase("Invalid source");
+
+        beast::temp_dir dir;
+        auto const src = boost::filesystem::path(dir.path()) / "missing";
+        try
+        {
+            extractTarLz4(src, dir.path());
+            fail("extracting a missing archive must throw");
+        }
+        catch (std::runtime_error const&)
+        {
+            pass();
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testExtractTarLz4();
+        testInvalidSource();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(Archive, basics, ripple);
+
+}  // namespace ripple
@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/CountedObject.h>
+#include <ripple/beast/unit_test.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+
+namespace {
+
+struct Counted : public CountedObject<Counted>
+{
+};
+
+}  // namespace
+
+class CountedObject_test : public beast::unit_test::suite
+{
+    int
+    count(std::string const& name)
+    {
+        for (auto const& [n, c] : CountedObjects::getInstance().getCounts(0))
+            if (n == name)
+                return c;
+        return 0;
+    }
+
+public:
+    void
+    run() override
+    {
+        auto const name = beast::type_name<Counted>();
+
+        {
+            Counted a;
+            Counted b(a);
+            BEAST_EXPECT(count(name) == 2);
+        }
+        BEAST_EXPECT(count(name) == 0);
+
+        // Objects made on one thread and destroyed on another still sum
+        // to the right count.
+        std::vector<std::unique_ptr<Counted>> objects(8000);
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < 8; ++t)
+            threads.emplace_back([&, t] {
+                for (std::size_t i = t * 1000; i < (t + 1) * 1000; ++i)
+                    objects[i] = std::make_unique<Counted>();
+            });
+        for (auto& t : threads)
+            t.join();
+        BEAST_EXPECT(count(name) == 8000);
+
+        threads.clear();
+        for (std::size_t t = 0; t < 8; ++t)
+            threads.emplace_back([&, t] {
+                for (std::size_t i = t; i < objects.size(); i += 8)
+                    objects[i].reset();
+            });
+        for (auto& t : threads)
+            t.join();
+        BEAST_EXPECT(count(name) == 0);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(CountedObject, basics, ripple);
+
+}  // namespace ripple
@@ -0,0 +1,257 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/IntrusivePointer.h>
+#include <ripple/basics/IntrusiveRefCounts.h>
+#include <ripple/basics/TaggedCache.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/Protocol.h>
+#include <test/unit_test/SuiteJournal.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class IntrusiveShared_test : public beast::unit_test::suite
+{
+    // Counts how many objects are alive and how many were partially
+    // destroyed, so the tests can tell which path freed an object.
+    struct Counters
+    {
+        int live = 0;
+        int partial = 0;
+    };
+
+    struct Node : public IntrusiveRefCounts
+    {
+        Counters& counters;
+        bool released = false;
+
+        explicit Node(Counters& c) : counters(c)
+        {
+            ++counters.live;
+        }
+
+        virtual ~Node()
+        {
+            --counters.live;
+        }
+
+        void
+        partialDestructor()
+        {
+            released = true;
+            ++counters.partial;
+        }
+    };
+
+    struct Derived : public Node
+    {
+        using Node::Node;
+    };
+
+    void
+    testStrong()
+    {
+        testcase("strong references");
+
+        Counters c;
+        {
+            auto p = make_SharedIntrusive<Node>(c);
+            BEAST_EXPECT(c.live == 1);
+            BEAST_EXPECT(p.use_count() == 1);
+            {
+                auto q = p;
+                BEAST_EXPECT(p.use_count() == 2);
+                BEAST_EXPECT(q == p);
+            }
+            BEAST_EXPECT(p.use_count() == 1);
+
+            auto m = std::move(p);
+            BEAST_EXPECT(!p);
+            BEAST_EXPECT(p == nullptr);
+            BEAST_EXPECT(m.use_count() == 1);
+
+            m.reset();
+            BEAST_EXPECT(c.live == 0);
+        }
+        BEAST_EXPECT(c.live == 0);
+        BEAST_EXPECT(c.partial == 0);
+
+        {
+            SharedIntrusive<Node> base = make_SharedIntrusive<Derived>(c);
+            auto derived = static_pointer_cast<Derived>(base);
+            BEAST_EXPECT(derived.get() == base.get());
+            BEAST_EXPECT(base.use_count() == 2);
+            BEAST_EXPECT(dynamic_pointer_cast<Derived>(base) == base);
+
+            auto plain = make_SharedIntrusive<Node>(c);
+            BEAST_EXPECT(!dynamic_pointer_cast<Derived>(plain));
+        }
+        BEAST_EXPECT(c.live == 0);
+    }
+
+    void
+    testWeak()
+    {
+        testcase("weak references");
+
+        Counters c;
+        {
+            // The last strong reference goes first: the object is
+            // partially destroyed and freed with the weak reference.
+            auto p = make_SharedIntrusive<Node>(c);
+            WeakIntrusive<Node> w{p};
+            BEAST_EXPECT(!w.expired());
+            BEAST_EXPECT(w.lock() == p);
+
+            auto const raw = p.get();
+            p.reset();
+            BEAST_EXPECT(w.expired());
+            BEAST_EXPECT(!w.lock());
+            BEAST_EXPECT(c.live == 1);
+            BEAST_EXPECT(c.partial == 1);
+            BEAST_EXPECT(raw->released);
+
+            w.reset();
+            BEAST_EXPECT(c.live == 0);
+        }
+
+        {
+            // The weak reference goes first: no partial destruction.
+            auto p = make_SharedIntrusive<Node>(c);
+            {
+                WeakIntrusive<Node> w{p};
+                auto w2 = w;
+            }
+            BEAST_EXPECT(c.live == 1);
+            p.reset();
+            BEAST_EXPECT(c.live == 0);
+            BEAST_EXPECT(c.partial == 1);
+        }
+    }
+
+    void
+    testThreads()
+    {
+        testcase("threads");
+
+        // Race the release of the last strong reference against
+        // concurrent attempts to lock weak references.
+        Counters c;
+        std::atomic<int> failures{0};
+        constexpr int iterations = 2000;
+        for (int i = 0; i < iterations; ++i)
+        {
+            auto p = make_SharedIntrusive<Node>(c);
+            WeakIntrusive<Node> w{p};
+            std::atomic<bool> go{false};
+
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 2; ++t)
+            {
+                threads.emplace_back([&go, &failures, weak = w]() {
+                    while (!go.load())
+                        ;
+                    if (auto s = weak.lock(); s && s->released)
+                        ++failures;
+                });
+            }
+            go = true;
+            p.reset();
+            for (auto& t : threads)
+                t.join();
+            w.reset();
+        }
+
+        // Counters are only touched by the last owner of each object.
+        BEAST_EXPECT(failures == 0);
+        BEAST_EXPECT(c.live == 0);
+        BEAST_EXPECT(c.partial == iterations);
+    }
+
+    void
+    testCache()
+    {
+        testcase("tagged cache");
+
+        using namespace std::chrono_literals;
+        test::SuiteJournal journal("IntrusiveShared_test", *this);
+        TestStopwatch clock;
+        clock.set(0);
+
+        using Cache = TaggedCache<
+            LedgerIndex,
+            Node,
+            false,
+            hardened_hash<>,
+            std::equal_to<LedgerIndex>,
+            ProfiledMutex<std::recursive_mutex>,
+            SharedIntrusive<Node>,
+            WeakIntrusive<Node>>;
+
+        Counters c;
+        Cache cache("test", 1, 1s, clock, journal);
+        {
+            auto p1 = make_SharedIntrusive<Node>(c);
+            BEAST_EXPECT(!cache.canonicalize_replace_client(1, p1));
+
+            auto p2 = make_SharedIntrusive<Node>(c);
+            BEAST_EXPECT(cache.canonicalize_replace_client(1, p2));
+            BEAST_EXPECT(p1 == p2);
+            BEAST_EXPECT(c.live == 1);
+
+            // Age the entry out of the cache; it is still tracked while
+            // the strong references above are held.
+            ++clock;
+            cache.sweep();
+            BEAST_EXPECT(cache.getCacheSize() == 0);
+            BEAST_EXPECT(cache.getTrackSize() == 1);
+        }
+
+        // With the strong references gone only the cache's weak reference
+        // remains: the node has been partially destroyed but not freed.
+        BEAST_EXPECT(c.partial == 1);
+        BEAST_EXPECT(c.live == 1);
+
+        // Fetching the expired entry drops it and frees the node.
+        BEAST_EXPECT(!cache.fetch(1));
+        BEAST_EXPECT(cache.getTrackSize() == 0);
+        BEAST_EXPECT(c.live == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testStrong();
+        testWeak();
+        testThreads();
+        testCache();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(IntrusiveShared, ripple_basics, ripple);
+
+}  // namespace test
+}  // namespace ripple
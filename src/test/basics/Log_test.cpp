@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Log.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/json/json_reader.h>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class Log_test : public beast::unit_test::suite
+{
+    static std::vector<std::string>
+    readLines(std::string const& path)
+    {
+        std::vector<std::string> lines;
+        std::ifstream in(path);
+        for (std::string line; std::getline(in, line);)
+            lines.push_back(line);
+        return lines;
+    }
+
+    void
+    testJson()
+    {
+        testcase("json");
+
+        beast::temp_dir dir;
+        auto const path = dir.file("debug.log");
+        {
+            Logs logs{beast::severities::kInfo};
+            logs.silent(true);
+            BEAST_EXPECT(logs.open(path));
+            logs.json(true);
+
+            auto const j = logs.journal("LogTest");
+            JLOG(j.debug()) << "below the threshold";
+            JLOG(j.warn()) << "a \"quoted\"\tline\n";
+            JLOG(j.info()) << "{\"secret\": \"snoPBrXtMeMyMHUVTgbuqAfg1SUTb\"}";
+        }
+
+        auto const lines = readLines(path);
+        if (!BEAST_EXPECT(lines.size() == 2))
+            return;
+
+        Json::Value warn;
+        BEAST_EXPECT(Json::Reader().parse(lines[0], warn));
+        BEAST_EXPECT(warn["partition"] == "LogTest");
+        BEAST_EXPECT(warn["severity"] == "WRN");
+        BEAST_EXPECT(warn["message"] == "a \"quoted\"\tline\n");
+        BEAST_EXPECT(warn.isMember("time"));
+
+        // Secrets are masked before the message is quoted
+        Json::Value info;
+        BEAST_EXPECT(Json::Reader().parse(lines[1], info));
+        BEAST_EXPECT(info["severity"] == "NFO");
+        BEAST_EXPECT(
+            info["message"] ==
+            "{\"secret\": \"*****************************\"}");
+    }
+
+    void
+    testAsync()
+    {
+        testcase("async");
+
+        beast::temp_dir dir;
+        auto const path = dir.file("debug.log");
+        int constexpr threads = 4;
+        int constexpr count = 100;
+        std::uint64_t dropped;
+        {
+            Logs logs{beast::severities::kTrace};
+            logs.silent(true);
+            BEAST_EXPECT(logs.open(path));
+            logs.writeAsync(16);
+
+            auto const j = logs.journal("LogTest");
+            std::vector<std::thread> writers;
+            for (int i = 0; i < threads; ++i)
+            {
+                writers.emplace_back([&j] {
+                    for (int n = 0; n < count; ++n)
+                        JLOG(j.debug()) << "line " << n;
+                    JLOG(j.warn()) << "done";
+                });
+            }
+            for (auto& writer : writers)
+                writer.join();
+
+            // Destroying the logs writes whatever is still queued
+            dropped = logs.dropped();
+        }
+
+        // Warnings are never dropped, and each batch with lines missing is
+        // followed by a line saying how many.
+        auto const lines = readLines(path);
+        int done = 0;
+        int debug = 0;
+        std::uint64_t reported = 0;
+        for (auto const& line : lines)
+        {
+            if (line.find("LogTest:WRN done") != std::string::npos)
+                ++done;
+            else if (line.find("LogTest:DBG line ") != std::string::npos)
+                ++debug;
+            else if (auto const pos = line.find("Logs:WRN ");
+                     BEAST_EXPECT(pos != std::string::npos))
+                reported += std::stoull(line.substr(pos + 9));
+        }
+        BEAST_EXPECT(done == threads);
+        BEAST_EXPECT(debug + dropped == std::uint64_t{threads * count});
+        BEAST_EXPECT(reported == dropped);
+    }
+
+public:
+    void
+    run() override
+    {
+        testJson();
+        testAsync();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(Log, basics, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -21,6 +21,8 @@
 #include <ripple/basics/Number.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/protocol/STAmount.h>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <random>
 #include <sstream>
 #include <tuple>
 
@@ -340,6 +342,171 @@ public:
         BEAST_EXPECT(caught);
     }
 
+    // The range of a normalized Number
+    static constexpr std::int64_t minMantissa = 1'000'000'000'000'000;
+    static constexpr std::int64_t maxMantissa = 9'999'999'999'999'999;
+    static constexpr int minExponent = -32768;
+
+    // Cut a mantissa down to 16 digits one digit at a time, rounding on the
+    // exact value of the digits that were cut, the way the Number
+    // arithmetic was first written
+    template <class Int>
+    static Number
+    referenceRound(Int m, int e, bool negative)
+    {
+        Int dropped = 0;
+        Int scale = 1;
+        while (m > maxMantissa)
+        {
+            dropped += (m % 10) * scale;
+            scale *= 10;
+            m /= 10;
+            ++e;
+        }
+
+        int const r = [&] {
+            switch (Number::getround())
+            {
+                case Number::towards_zero:
+                    return -1;
+                case Number::downward:
+                    return negative && dropped != 0 ? 1 : -1;
+                case Number::upward:
+                    return !negative && dropped != 0 ? 1 : -1;
+                default:
+                    break;
+            }
+            if (2 * dropped > scale)
+                return 1;
+            if (2 * dropped < scale)
+                return -1;
+            return 0;
+        }();
+
+        auto mantissa = static_cast<std::int64_t>(m);
+        if (r == 1 || (r == 0 && (mantissa & 1) == 1))
+        {
+            ++mantissa;
+            if (mantissa > maxMantissa)
+            {
+                mantissa /= 10;
+                ++e;
+            }
+        }
+        if (e < minExponent)
+            return Number{};
+        return Number{negative ? -mantissa : mantissa, e};
+    }
+
+    void
+    test_mul_reference()
+    {
+        testcase("test_mul_reference");
+        using uint128 = boost::multiprecision::uint128_t;
+
+        std::int64_t const edges[]{
+            minMantissa,
+            minMantissa + 1,
+            minMantissa * 3 + 1,
+            3'162'277'660'168'379,
+            3'162'277'660'168'380,
+            4'999'999'999'999'999,
+            5'000'000'000'000'000,
+            5'000'000'000'000'001,
+            maxMantissa - 1,
+            maxMantissa};
+        std::mt19937_64 rng{0x4e756d626572};
+        auto mantissa = [&] {
+            if (rng() % 4 == 0)
+                return edges[rng() % std::size(edges)];
+            return minMantissa +
+                static_cast<std::int64_t>(
+                       rng() % (maxMantissa - minMantissa + 1));
+        };
+
+        for (auto const mode :
+             {Number::to_nearest,
+              Number::towards_zero,
+              Number::downward,
+              Number::upward})
+        {
+            saveNumberRoundMode const save{Number::setround(mode)};
+            for (int i = 0; i < 20'000; ++i)
+            {
+                auto const xm = mantissa();
+                auto const ym = mantissa();
+                bool const xn = rng() % 2;
+                bool const yn = rng() % 2;
+                // Some exponents are near the bottom of the range, so the
+                // products underflow
+                int const xe = rng() % 8 == 0
+                    ? minExponent + static_cast<int>(rng() % 20)
+                    : static_cast<int>(rng() % 60) - 30;
+                int const ye = static_cast<int>(rng() % 60) - 30;
+
+                Number const x{xn ? -xm : xm, xe};
+                Number const y{yn ? -ym : ym, ye};
+                auto const expected = referenceRound(
+                    uint128(xm) * uint128(ym), xe + ye, xn != yn);
+                auto const z = x * y;
+                if (!BEAST_EXPECT(z == expected))
+                {
+                    log << x << " * " << y << " gave " << z << " not "
+                        << expected << std::endl;
+                }
+            }
+        }
+    }
+
+    void
+    test_normalize_reference()
+    {
+        testcase("test_normalize_reference");
+        BEAST_EXPECT(Number::min().mantissa() == minMantissa);
+        BEAST_EXPECT(Number::min().exponent() == minExponent);
+        BEAST_EXPECT(Number::max().mantissa() == maxMantissa);
+
+        // Every size of mantissa, on both sides of each power of ten
+        for (auto const mode :
+             {Number::to_nearest,
+              Number::towards_zero,
+              Number::downward,
+              Number::upward})
+        {
+            saveNumberRoundMode const save{Number::setround(mode)};
+            std::uint64_t p = 1;
+            for (int digits = 1; digits <= 19; ++digits, p *= 10)
+            {
+                for (auto const u : {p - 1, p, p + 1, p * 5, p * 5 + 1})
+                {
+                    if (u == 0)
+                        continue;
+                    auto const m = static_cast<std::int64_t>(u);
+                    for (bool const negative : {false, true})
+                    {
+                        // Values that are too small are scaled up first
+                        auto scaled = u;
+                        int e = 0;
+                        while (scaled < minMantissa)
+                        {
+                            scaled *= 10;
+                            --e;
+                        }
+                        Number const n{negative ? -m : m, 0};
+                        BEAST_EXPECT(n == referenceRound(scaled, e, negative));
+                    }
+                }
+            }
+        }
+
+        // Scaling up stops at the smallest exponent
+        Number const tiny{5, minExponent + 3};
+        BEAST_EXPECT(tiny == Number{});
+        Number const small{5'000'000'000'000, minExponent + 3};
+        BEAST_EXPECT(small.mantissa() == 5'000'000'000'000'000);
+        BEAST_EXPECT(small.exponent() == minExponent);
+    }
+
     void
     test_root()
     {
@@ -728,6 +895,8 @@ public:
         test_sub();
         test_mul();
         test_div();
+        test_mul_reference();
+        test_normalize_reference();
         test_root();
         test_power1();
         test_power2();
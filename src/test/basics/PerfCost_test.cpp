@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/PerfCost.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/resource/Fees.h>
+#include <thread>
+#include <time.h>
+
+namespace ripple {
+namespace test {
+
+class PerfCost_test : public beast::unit_test::suite
+{
+    // Use CPU for a while on the calling thread
+    static void
+    spin(std::chrono::milliseconds duration)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        volatile std::uint64_t sink = 0;
+        while (std::chrono::steady_clock::now() - start < duration)
+            sink = sink + 1;
+    }
+
+    void
+    testMeter()
+    {
+        testcase("meter");
+        using namespace std::chrono_literals;
+
+        perf::CostMeter const meter;
+        perf::onFetch(100us, 0us);
+        perf::onFetch(300us, 0us);
+
+        // CPU time used in a fetch is only counted as CPU time
+        perf::onFetch(250us, 50us);
+        perf::onFetch(100us, 120us);
+
+        // Work done on other threads isn't counted
+        std::thread([] {
+            perf::onFetch(1000us, 0us);
+            spin(20ms);
+        }).join();
+
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+        spin(20ms);
+#endif
+
+        auto const cost = meter.elapsed();
+        BEAST_EXPECT(cost.fetches == 4);
+        BEAST_EXPECT(cost.fetchTime == 600us);
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+        BEAST_EXPECT(cost.cpu >= 10ms);
+        BEAST_EXPECT(cost.cpu < 1s);
+#endif
+
+        // Nothing is reported to another thread
+        std::thread([&meter, this] {
+            auto const cost = meter.elapsed();
+            BEAST_EXPECT(cost.fetches == 0);
+            BEAST_EXPECT(cost.cpu == 0us);
+        }).join();
+    }
+
+    void
+    testCharge()
+    {
+        testcase("charge");
+        using namespace std::chrono_literals;
+
+        perf::Cost cost;
+        BEAST_EXPECT(Resource::measuredRPC(cost).cost() == 0);
+
+        cost.fetches = 10;
+        BEAST_EXPECT(Resource::measuredRPC(cost).cost() == 10);
+
+        // A request using CPU and fetches like a heavy one costs as much
+        cost.cpu = 100ms;
+        cost.fetchTime = 50ms;
+        BEAST_EXPECT(
+            Resource::measuredRPC(cost).cost() ==
+            Resource::feeHighBurdenRPC.cost() + 10);
+    }
+
+public:
+    void
+    run() override
+    {
+        testMeter();
+        testCharge();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PerfCost, basics, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -989,6 +989,102 @@ public:
         }
     }
 
+    void
+    testInvariants(WithFile withFile)
+    {
+        // Exercise the invariant checker counters of PerfLog.
+        using namespace std::chrono_literals;
+
+        Fixture fixture{env_.app(), j_};
+        auto perfLog{fixture.perfLog(withFile)};
+        perfLog->start();
+
+        // Checkers should not appear until they report.
+        BEAST_EXPECT(perfLog->countersJson()[jss::invariants].size() == 0);
+
+        perfLog->invariantCheck("XRPNotCreated", 300ns, true);
+        perfLog->invariantCheck("XRPNotCreated", 200ns, false);
+        perfLog->invariantCheck("NoBadOffers", 50ns, true);
+        {
+            Json::Value const invariants{
+                perfLog->countersJson()[jss::invariants]};
+            BEAST_EXPECT(invariants.size() == 2);
+
+            Json::Value const& xrp{invariants["XRPNotCreated"]};
+            BEAST_EXPECT(xrp[jss::checked] == "2");
+            BEAST_EXPECT(xrp[jss::failed] == "1");
+            BEAST_EXPECT(xrp[jss::duration_ns] == "500");
+
+            Json::Value const& offers{invariants["NoBadOffers"]};
+            BEAST_EXPECT(offers[jss::checked] == "1");
+            BEAST_EXPECT(offers[jss::failed] == "0");
+            BEAST_EXPECT(offers[jss::duration_ns] == "50");
+        }
+
+        // Reports from several threads at once, including the first one
+        // of a checker, are all counted.
+        {
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t)
+            {
+                threads.emplace_back([&perfLog]() {
+                    for (int i = 0; i < 1000; ++i)
+                        perfLog->invariantCheck(
+                            "NoZeroEscrow", 2ns, i % 10 != 0);
+                });
+            }
+            for (auto& t : threads)
+                t.join();
+
+            Json::Value const escrow{
+                perfLog->countersJson()[jss::invariants]["NoZeroEscrow"]};
+            BEAST_EXPECT(escrow[jss::checked] == "4000");
+            BEAST_EXPECT(escrow[jss::failed] == "400");
+            BEAST_EXPECT(escrow[jss::duration_ns] == "8000");
+        }
+        perfLog->stop();
+    }
+
+    void
+    testRpcLatency()
+    {
+        // Exercise the RPC latency histograms of PerfLog.
+        using namespace std::chrono_literals;
+
+        Fixture fixture{env_.app(), j_};
+        auto perfLog{fixture.perfLog(WithFile::no)};
+        perfLog->start();
+
+        // Methods should not appear until they report.
+        BEAST_EXPECT(perfLog->rpcLatencyJson().size() == 0);
+
+        // Methods the server does not know are dropped.
+        perfLog->rpcTimes("not_a_method", {1us, 2us, 3us, 4us});
+        BEAST_EXPECT(perfLog->rpcLatencyJson().size() == 0);
+
+        for (int i = 0; i < 98; ++i)
+            perfLog->rpcTimes("account_tx", {10us, 0us, 100us, 10us});
+        for (int i = 0; i < 2; ++i)
+            perfLog->rpcTimes("account_tx", {10us, 5000us, 100us, 10us});
+        {
+            Json::Value const latency{perfLog->rpcLatencyJson()};
+            BEAST_EXPECT(latency.size() == 1);
+
+            // A percentile is the top of the bucket of powers of two it
+            // falls in, but no more than the largest sample.
+            Json::Value const& tx{latency["account_tx"]};
+            BEAST_EXPECT(tx[jss::count] == "100");
+            BEAST_EXPECT(tx[jss::queue_us][jss::p50] == "10");
+            BEAST_EXPECT(tx[jss::handler_us][jss::p50] == "100");
+            BEAST_EXPECT(tx[jss::handler_us][jss::p999] == "100");
+            BEAST_EXPECT(tx[jss::ledger_us][jss::p50] == "0");
+            BEAST_EXPECT(tx[jss::ledger_us][jss::p99] == "5000");
+            BEAST_EXPECT(tx[jss::ledger_us][jss::p999] == "5000");
+            BEAST_EXPECT(tx[jss::serialize_us][jss::p99] == "10");
+        }
+        perfLog->stop();
+    }
+
     void
     testRotate(WithFile withFile)
     {
@@ -1055,6 +1151,9 @@ public:
         testJobs(WithFile::yes);
         testInvalidID(WithFile::no);
         testInvalidID(WithFile::yes);
+        testInvariants(WithFile::no);
+        testInvariants(WithFile::yes);
+        testRpcLatency();
         testRotate(WithFile::no);
         testRotate(WithFile::yes);
     }
@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/PerfTrace.h>
+#include <ripple/beast/core/CurrentThreadName.h>
+#include <ripple/beast/unit_test.h>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class PerfTrace_test : public beast::unit_test::suite
+{
+    // The events of the trace with a name
+    static std::vector<Json::Value>
+    eventsNamed(Json::Value const& trace, char const* name)
+    {
+        std::vector<Json::Value> events;
+        for (auto const& event : trace["traceEvents"])
+        {
+            if (event["ph"] != "M" && event["name"] == name)
+                events.push_back(event);
+        }
+        return events;
+    }
+
+    void
+    testRecord()
+    {
+        testcase("record");
+        using namespace perf::trace;
+
+        // Nothing is recorded while tracing is off
+        BEAST_EXPECT(!enabled());
+        {
+            Scope scope("test", "untraced");
+        }
+        instant("test", "untraced");
+        BEAST_EXPECT(eventsNamed(toJson(), "untraced").empty());
+
+        start();
+        BEAST_EXPECT(enabled());
+        {
+            Scope scope("test", "scope");
+        }
+        auto const now = clock_type::now();
+        complete(
+            "test",
+            "complete",
+            now - std::chrono::milliseconds(5),
+            now,
+            "value",
+            42);
+        instant("test", "instant");
+
+        std::thread t([] {
+            beast::setCurrentThreadName("trace test");
+            instant("test", "other thread");
+        });
+        t.join();
+        stop();
+        instant("test", "after stop");
+
+        auto const trace = toJson();
+        BEAST_EXPECT(trace["displayTimeUnit"] == "ms");
+        BEAST_EXPECT(eventsNamed(trace, "after stop").empty());
+
+        auto const scope = eventsNamed(trace, "scope");
+        if (BEAST_EXPECT(scope.size() == 1))
+        {
+            BEAST_EXPECT(scope[0]["ph"] == "X");
+            BEAST_EXPECT(scope[0]["cat"] == "test");
+            BEAST_EXPECT(scope[0]["dur"].asDouble() >= 0);
+        }
+
+        auto const comp = eventsNamed(trace, "complete");
+        if (BEAST_EXPECT(comp.size() == 1))
+        {
+            BEAST_EXPECT(comp[0]["dur"].asDouble() == 5000);
+            BEAST_EXPECT(comp[0]["args"]["value"] == 42);
+        }
+
+        auto const inst = eventsNamed(trace, "instant");
+        if (BEAST_EXPECT(inst.size() == 1))
+            BEAST_EXPECT(inst[0]["ph"] == "i");
+
+        // Each thread has its own track, named after the thread
+        auto const other = eventsNamed(trace, "other thread");
+        if (BEAST_EXPECT(other.size() == 1) && BEAST_EXPECT(!inst.empty()))
+        {
+            BEAST_EXPECT(other[0]["tid"] != inst[0]["tid"]);
+            bool named = false;
+            for (auto const& event : trace["traceEvents"])
+            {
+                if (event["ph"] == "M" && event["tid"] == other[0]["tid"])
+                    named = event["args"]["name"] == "trace test";
+            }
+            BEAST_EXPECT(named);
+        }
+
+        // Starting again drops what came before
+        start();
+        BEAST_EXPECT(eventsNamed(toJson(), "scope").empty());
+        stop();
+    }
+
+    void
+    testWrap()
+    {
+        testcase("wrap");
+        using namespace perf::trace;
+
+        start();
+        std::thread t([] {
+            for (std::size_t i = 0; i < eventsPerThread + 100; ++i)
+                instant("test", "wrap", "index", i);
+        });
+        t.join();
+        stop();
+
+        // Only the newest events of the thread are kept
+        auto const events = eventsNamed(toJson(), "wrap");
+        if (BEAST_EXPECT(events.size() == eventsPerThread))
+        {
+            BEAST_EXPECT(events.front()["args"]["index"] == 100);
+            BEAST_EXPECT(
+                events.back()["args"]["index"] ==
+                static_cast<int>(eventsPerThread + 99));
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testRecord();
+        testWrap();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PerfTrace, basics, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/ProfiledMutex.h>
+#include <ripple/beast/unit_test.h>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class ProfiledMutex_test : public beast::unit_test::suite
+{
+    static std::optional<LockProfile::Counts>
+    find(std::string const& name)
+    {
+        for (auto const& [n, counts] : LockProfiles::getInstance().getCounts())
+        {
+            if (n == name)
+                return counts;
+        }
+        return std::nullopt;
+    }
+
+    void
+    testLocking()
+    {
+        testcase("locking");
+        using namespace std::chrono_literals;
+
+        ProfiledMutex<std::mutex> a("ProfiledMutex_test");
+        ProfiledMutex<std::mutex> b("ProfiledMutex_test");
+        int n = 0;
+        {
+            std::vector<std::thread> threads;
+            for (int i = 0; i != 4; ++i)
+            {
+                threads.emplace_back([&] {
+                    for (int j = 0; j != 1000; ++j)
+                    {
+                        std::lock_guard lock(j % 2 ? a : b);
+                        ++n;
+                    }
+                });
+            }
+            for (auto& t : threads)
+                t.join();
+        }
+        BEAST_EXPECT(n == 4000);
+
+        // A waiter on the condition variable gives up the lock
+        bool ready = false;
+        ProfiledConditionVariable cv;
+        {
+            ProfiledUniqueLock<std::mutex> lock(a);
+            std::thread t([&] {
+                std::this_thread::sleep_for(5ms);
+                std::lock_guard _(a);
+                ready = true;
+                cv.notify_all();
+            });
+            cv.wait(lock, [&] { return ready; });
+            lock.unlock();
+            t.join();
+        }
+
+        ProfiledMutex<std::recursive_mutex> r("ProfiledMutex_test.r");
+        r.lock();
+        BEAST_EXPECT(r.try_lock());
+        std::this_thread::sleep_for(2ms);
+        r.unlock();
+        r.unlock();
+
+#ifdef RIPPLE_PROFILE_LOCKS
+        auto const counts = find("ProfiledMutex_test");
+        if (!BEAST_EXPECT(counts))
+            return;
+        BEAST_EXPECT(counts->acquisitions >= 4002);
+        BEAST_EXPECT(counts->contentions <= counts->acquisitions);
+        BEAST_EXPECT(counts->maxWait <= counts->wait);
+        BEAST_EXPECT(counts->hold > 0ns);
+
+        // A recursive lock is counted once, and held from the first lock
+        // to the last unlock
+        auto const recursive = find("ProfiledMutex_test.r");
+        if (!BEAST_EXPECT(recursive))
+            return;
+        BEAST_EXPECT(recursive->acquisitions == 1);
+        BEAST_EXPECT(recursive->contentions == 0);
+        BEAST_EXPECT(recursive->hold >= 2ms);
+#else
+        // Built without profiling, the mutexes are plain
+        BEAST_EXPECT(!find("ProfiledMutex_test"));
+        BEAST_EXPECT(!find("ProfiledMutex_test.r"));
+#endif
+    }
+
+public:
+    void
+    run() override
+    {
+        testLocking();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ProfiledMutex, basics, ripple);
+
+}  // namespace test
+}  // namespace ripple
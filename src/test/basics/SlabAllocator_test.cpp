@@ -0,0 +1,181 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/SlabAllocator.h>
+#include <ripple/beast/unit_test.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+
+class SlabAllocator_test : public beast::unit_test::suite
+{
+    // Each test uses its own type, so that it gets its own magazines
+    template <int N>
+    struct Item
+    {
+        std::uint64_t a;
+        std::uint64_t b;
+    };
+
+    static constexpr std::size_t slabSize = 1024 * 1024;
+
+    void
+    testAllocate()
+    {
+        testcase("allocate");
+
+        SlabAllocator<Item<0>> alloc(0, slabSize);
+
+        std::set<std::uint8_t*> items;
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto const p = alloc.allocate();
+            BEAST_EXPECT(p != nullptr);
+            BEAST_EXPECT(items.insert(p).second);
+        }
+        BEAST_EXPECT(alloc.getCounts().outstanding >= items.size());
+
+        for (auto p : items)
+            BEAST_EXPECT(alloc.deallocate(p));
+
+        // A pointer from elsewhere is not taken
+        Item<0> foreign;
+        BEAST_EXPECT(
+            !alloc.deallocate(reinterpret_cast<std::uint8_t*>(&foreign)));
+
+        // Freed items are handed out again
+        auto const p = alloc.allocate();
+        BEAST_EXPECT(items.count(p) == 1);
+        BEAST_EXPECT(alloc.deallocate(p));
+    }
+
+    void
+    testThreads()
+    {
+        testcase("threads");
+
+        using Alloc = SlabAllocator<Item<1>>;
+        Alloc alloc(0, slabSize);
+
+        // Frees an item when the thread exits, after its magazines
+        struct AtExit
+        {
+            Alloc* alloc = nullptr;
+            std::uint8_t* item = nullptr;
+            std::atomic<int>* freed = nullptr;
+
+            ~AtExit()
+            {
+                if (item && alloc->deallocate(item))
+                    ++*freed;
+            }
+        };
+
+        // Items allocated by one thread and freed by another
+        std::mutex mutex;
+        std::vector<std::uint8_t*> shared;
+
+        std::atomic<int> freed{0};
+        std::atomic<bool> ok{true};
+        std::vector<std::thread> threads;
+        int const threadCount = 4;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&]() {
+                // Constructed before the magazines, so destroyed after them
+                thread_local AtExit atExit;
+
+                std::vector<std::uint8_t*> mine;
+                for (int round = 0; round < 100; ++round)
+                {
+                    for (int i = 0; i < 50; ++i)
+                    {
+                        auto const p = alloc.allocate();
+                        if (!p)
+                            ok = false;
+                        else
+                            mine.push_back(p);
+                    }
+
+                    std::lock_guard lock(mutex);
+                    for (auto i = 0; i < 10 && !mine.empty(); ++i)
+                    {
+                        shared.push_back(mine.back());
+                        mine.pop_back();
+                    }
+                    for (auto i = 0; i < 10 && !shared.empty(); ++i)
+                    {
+                        mine.push_back(shared.back());
+                        shared.pop_back();
+                    }
+                }
+
+                for (auto p : mine)
+                {
+                    if (!alloc.deallocate(p))
+                        ok = false;
+                }
+
+                atExit.alloc = &alloc;
+                atExit.item = alloc.allocate();
+                atExit.freed = &freed;
+            });
+        }
+
+        for (auto& t : threads)
+            t.join();
+
+        BEAST_EXPECT(ok);
+        BEAST_EXPECT(freed == threadCount);
+
+        // Free what is left on a thread of its own, so that its magazine
+        // goes back to the slabs as well
+        std::thread([&]() {
+            for (auto p : shared)
+            {
+                if (!alloc.deallocate(p))
+                    ok = false;
+            }
+        }).join();
+        BEAST_EXPECT(ok);
+
+        // Every item went back to the slabs, including those freed after
+        // the magazines of their threads were gone
+        auto const counts = alloc.getCounts();
+        BEAST_EXPECT(counts.outstanding == 0);
+        BEAST_EXPECT(counts.slabs != 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testAllocate();
+        testThreads();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SlabAllocator, basics, ripple);
+
+}  // namespace ripple
@@ -148,6 +148,187 @@ public:
             BEAST_EXPECT(c.getCacheSize() == 0);
             BEAST_EXPECT(c.getTrackSize() == 0);
         }
+
+        testBudget(journal);
+        testClock(journal);
+        testSweepHandler(journal);
+    }
+
+    struct Sized
+    {
+        std::size_t bytes;
+
+        std::size_t
+        memoryUsage() const
+        {
+            return bytes;
+        }
+    };
+
+    void
+    testBudget(beast::Journal const& journal)
+    {
+        using namespace std::chrono_literals;
+
+        testcase("byte budget");
+
+        TestStopwatch clock;
+        clock.set(0);
+
+        TaggedCache<LedgerIndex, Sized> c("budget", 0, 60s, clock, journal);
+        c.setTargetBytes(1000);
+        BEAST_EXPECT(c.getTargetBytes() == 1000);
+
+        auto add = [&c](LedgerIndex key, std::size_t bytes, std::uint32_t g) {
+            auto p = std::make_shared<Sized>(Sized{bytes});
+            return c.canonicalize_replace_client(key, p, g);
+        };
+
+        // One entry for each of three generations
+        BEAST_EXPECT(!add(1, 400, 1));
+        BEAST_EXPECT(!add(2, 400, 2));
+        BEAST_EXPECT(!add(3, 400, 3));
+        BEAST_EXPECT(c.getCacheBytes() == 1200);
+
+        // A newer generation using the first entry keeps it around; the
+        // oldest generation still in use then goes, however recent
+        BEAST_EXPECT(c.fetch(1, 4));
+        c.sweep();
+        BEAST_EXPECT(c.getCacheBytes() == 800);
+        BEAST_EXPECT(c.getCacheSize() == 2);
+        BEAST_EXPECT(!c.fetch(2));
+        BEAST_EXPECT(c.fetch(3));
+
+        // Under budget, nothing goes before its time
+        clock.advance(30s);
+        c.sweep();
+        BEAST_EXPECT(c.getCacheBytes() == 800);
+
+        // When the newest generation alone is over budget, it ages faster:
+        // what was last used 56 seconds ago goes though the age is 60
+        BEAST_EXPECT(!add(5, 700, 4));
+        BEAST_EXPECT(c.getCacheBytes() == 1500);
+        clock.advance(26s);
+        c.sweep();
+        BEAST_EXPECT(c.getCacheBytes() == 700);
+        BEAST_EXPECT(c.getCacheSize() == 1);
+        BEAST_EXPECT(c.fetch(5));
+
+        // Entries that are still referenced stay tracked but stop counting
+        {
+            auto const p = c.fetch(5);
+            clock.advance(61s);
+            c.sweep();
+            BEAST_EXPECT(c.getCacheBytes() == 0);
+            BEAST_EXPECT(c.getTrackSize() == 1);
+
+            // Fetching it caches it again
+            BEAST_EXPECT(c.fetch(5, 6) == p);
+            BEAST_EXPECT(c.getCacheBytes() == 700);
+        }
+
+        c.clear();
+        BEAST_EXPECT(c.getCacheBytes() == 0);
+    }
+
+    void
+    testClock(beast::Journal const& journal)
+    {
+        using namespace std::chrono_literals;
+
+        testcase("clock eviction");
+
+        TestStopwatch clock;
+        clock.set(0);
+
+        TaggedCache<LedgerIndex, std::string> c("clock", 4, 1s, clock, journal);
+        c.setClockEviction(true);
+
+        for (LedgerIndex i = 1; i <= 4; ++i)
+            BEAST_EXPECT(!c.insert(i, std::to_string(i)));
+        BEAST_EXPECT(c.getCacheSize() == 4);
+
+        // Keys are evicted as others are added, not by sweeps
+        BEAST_EXPECT(!c.insert(5, "5"));
+        BEAST_EXPECT(c.getCacheSize() == 4);
+        BEAST_EXPECT(c.getTrackSize() == 4);
+        ++clock;
+        c.sweep();
+        BEAST_EXPECT(c.getCacheSize() == 4);
+
+        // A key used since the hand passed gets a second chance
+        {
+            auto const keys = c.getKeys();
+            auto const used = std::find_if(
+                keys.begin(), keys.end(), [](auto k) { return k != 5; });
+            if (!BEAST_EXPECT(used != keys.end()))
+                return;
+            BEAST_EXPECT(c.fetch(*used));
+
+            BEAST_EXPECT(!c.insert(6, "6"));
+            BEAST_EXPECT(c.getCacheSize() == 4);
+            BEAST_EXPECT(c.fetch(*used));
+            BEAST_EXPECT(c.fetch(5));
+            BEAST_EXPECT(c.fetch(6));
+        }
+
+        // Entries still referenced stay tracked but leave the cache
+        {
+            std::vector<std::shared_ptr<std::string>> held;
+            for (LedgerIndex i = 10; i < 20; ++i)
+            {
+                held.push_back(std::make_shared<std::string>("x"));
+                c.canonicalize_replace_client(i, held.back());
+            }
+            BEAST_EXPECT(c.getCacheSize() == 4);
+            BEAST_EXPECT(c.getTrackSize() > 4);
+        }
+
+        // Once released, their entries go as the hand passes them
+        for (LedgerIndex i = 20; i < 40; ++i)
+            c.insert(i, "y");
+        BEAST_EXPECT(c.getCacheSize() == 4);
+        BEAST_EXPECT(c.getTrackSize() <= 8);
+
+        // Without a target, sweeps expire by age as usual
+        c.setTargetSize(0);
+        ++clock;
+        c.sweep();
+        BEAST_EXPECT(c.getCacheSize() == 0);
+        BEAST_EXPECT(c.getTrackSize() == 0);
+    }
+
+    void
+    testSweepHandler(beast::Journal const& journal)
+    {
+        using namespace std::chrono_literals;
+
+        testcase("sweep handler");
+
+        TestStopwatch clock;
+        clock.set(0);
+
+        TaggedCache<LedgerIndex, std::string> c("swept", 0, 1s, clock, journal);
+
+        std::vector<std::string> swept;
+        c.setSweepHandler([&](std::shared_ptr<std::string> const& s) {
+            swept.push_back(*s);
+        });
+
+        c.insert(1, "one");
+        c.insert(2, "two");
+        auto const held = c.fetch(2);
+
+        // Nothing has expired yet
+        c.sweep();
+        BEAST_EXPECT(swept.empty());
+
+        // Only objects that nothing else holds are passed on
+        clock.set(2);
+        c.sweep();
+        BEAST_EXPECT((swept == std::vector<std::string>{"one"}));
+        BEAST_EXPECT(c.getCacheSize() == 0);
+        BEAST_EXPECT(c.getTrackSize() == 1);
     }
 };
 
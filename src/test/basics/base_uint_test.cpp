@@ -23,6 +23,7 @@
 #include <ripple/beast/unit_test.h>
 #include <boost/endian/conversion.hpp>
 #include <complex>
+#include <random>
 
 #include <type_traits>
 
@@ -128,6 +129,59 @@ struct base_uint_test : beast::unit_test::suite
         }
     }
 
+    // Words are compared and hex converted in blocks, so try values that
+    // differ at every byte and strings long enough for several blocks
+    template <std::size_t Bits>
+    void
+    testBlocks(std::mt19937& gen)
+    {
+        using uint = base_uint<Bits>;
+        std::uniform_int_distribution<int> byte(0, 255);
+
+        for (int n = 0; n < 200; ++n)
+        {
+            uint a, b;
+            for (auto& x : a)
+                x = byte(gen);
+            b = a;
+            // Differ at one byte, often only a little
+            auto const at = n % uint::bytes;
+            b.begin()[at] ^= (n % 3 == 0) ? 1 : byte(gen) | 1;
+
+            auto const bytewise = std::lexicographical_compare(
+                a.begin(), a.end(), b.begin(), b.end());
+            BEAST_EXPECT((a < b) == bytewise);
+            BEAST_EXPECT((b < a) == !bytewise);
+            BEAST_EXPECT(a != b);
+            BEAST_EXPECT((a <=> a) == 0);
+
+            auto const hex = to_string(a);
+            std::string expected;
+            for (auto const x : a)
+            {
+                expected += "0123456789ABCDEF"[x >> 4];
+                expected += "0123456789ABCDEF"[x & 0xF];
+            }
+            BEAST_EXPECT(hex == expected);
+
+            uint parsed;
+            BEAST_EXPECT(parsed.parseHex(hex) && parsed == a);
+
+            std::string lower = hex;
+            for (auto& c : lower)
+                c = std::tolower(static_cast<unsigned char>(c));
+            BEAST_EXPECT(parsed.parseHex(lower) && parsed == a);
+
+            // A character that is not a hex digit anywhere fails
+            for (char const bad : {'g', 'G', '/', ':', '@', '`', '\0', '\xff'})
+            {
+                std::string broken = hex;
+                broken[n % broken.size()] = bad;
+                BEAST_EXPECT(!parsed.parseHex(broken));
+            }
+        }
+    }
+
     void
     run() override
     {
@@ -140,6 +194,13 @@ struct base_uint_test : beast::unit_test::suite
 
         testComparisons();
 
+        {
+            std::mt19937 gen(20231014);
+            testBlocks<96>(gen);
+            testBlocks<160>(gen);
+            testBlocks<256>(gen);
+        }
+
         // used to verify set insertion (hashing required)
         std::unordered_set<test96, hardened_hash<>> uset;
 
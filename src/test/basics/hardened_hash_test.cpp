@@ -17,11 +17,14 @@
 */
 //==============================================================================
 
+#include <ripple/basics/base_uint.h>
 #include <ripple/basics/hardened_hash.h>
 #include <ripple/beast/unit_test.h>
 #include <boost/functional/hash.hpp>
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iomanip>
 #include <unordered_map>
@@ -246,11 +249,48 @@ public:
         check_container<detail::test_hardened_unordered_multimap>();
     }
 
+    void
+    test_digest_hash()
+    {
+        testcase("digest hash");
+
+        digest_hash const hash;
+        uint256 const key{
+            "F1E2D3C4B5A69788796A5B4C3D2E1F00"
+            "E1D2C3B4A5968778695A4B3C2D1E0FFF"};
+
+        BEAST_EXPECT(hash(key) == hash(uint256{key}));
+        BEAST_EXPECT(hash(key) != hash(~key));
+
+        // Keys that differ in a single word still spread over a table
+        constexpr std::size_t buckets = 97;
+        for (std::size_t word = 0; word != 4; ++word)
+        {
+            std::array<int, buckets> counts{};
+            for (std::uint64_t i = 0; i != 100 * buckets; ++i)
+            {
+                uint256 k = key;
+                std::memcpy(k.data() + 8 * word, &i, sizeof(i));
+                ++counts[hash(k) % buckets];
+            }
+
+            auto const [lo, hi] =
+                std::minmax_element(counts.begin(), counts.end());
+            BEAST_EXPECT(*lo > 50 && *hi < 150);
+        }
+
+        std::unordered_set<uint256, digest_hash> set;
+        set.insert(key);
+        BEAST_EXPECT(set.count(key) == 1);
+        BEAST_EXPECT(set.count(~key) == 0);
+    }
+
     void
     run() override
     {
         test_user_types();
         test_containers();
+        test_digest_hash();
     }
 };
 
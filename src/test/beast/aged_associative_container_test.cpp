@@ -1449,6 +1449,22 @@ aged_associative_container_test_base::testChronological()
         v.cend(),
         equal_value<Traits>()));
 
+    // Expire the oldest items, a bounded number at a time
+    {
+        using namespace std::chrono_literals;
+        ++clock;
+        BEAST_EXPECT(expire(c, 1s, 1) == 1);
+        BEAST_EXPECT(c.size() == v.size() - 1);
+        BEAST_EXPECT(std::equal(
+            c.chronological.cbegin(),
+            c.chronological.cend(),
+            std::next(v.cbegin()),
+            v.cend(),
+            equal_value<Traits>()));
+        BEAST_EXPECT(expire(c, 1s) == v.size() - 1);
+        BEAST_EXPECT(c.empty());
+    }
+
     {
         // Because touch (reverse_iterator pos) is not allowed, the following
         // lines should not compile for any aged_container type.
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/insight/Histogram.h>
+#include <ripple/beast/insight/PrometheusCollector.h>
+#include <ripple/beast/unit_test.h>
+#include <chrono>
+#include <string>
+
+namespace beast {
+namespace insight {
+
+class PrometheusCollector_test : public unit_test::suite
+{
+    static bool
+    contains(std::string const& text, std::string const& line)
+    {
+        return text.find(line + "\n") != std::string::npos;
+    }
+
+public:
+    void
+    testHistogram()
+    {
+        testcase("histogram");
+
+        BEAST_EXPECT(Histogram::bucketFor(-5) == 0);
+        BEAST_EXPECT(Histogram::bucketFor(0) == 0);
+        BEAST_EXPECT(Histogram::bucketFor(1) == 0);
+        BEAST_EXPECT(Histogram::bucketFor(2) == 1);
+        BEAST_EXPECT(Histogram::bucketFor(3) == 2);
+        BEAST_EXPECT(Histogram::bucketFor(4) == 2);
+        BEAST_EXPECT(Histogram::bucketFor(5) == 3);
+        BEAST_EXPECT(
+            Histogram::bucketFor(
+                Histogram::upperBound(Histogram::bounded - 1)) ==
+            Histogram::bounded - 1);
+        BEAST_EXPECT(
+            Histogram::bucketFor(
+                Histogram::upperBound(Histogram::bounded - 1) + 1) ==
+            Histogram::bounded);
+
+        Histogram h;
+        for (int i = 1; i <= 100; ++i)
+            h.record(i);
+        auto const s = h.snapshot();
+        BEAST_EXPECT(s.count() == 100);
+        BEAST_EXPECT(s.sum == 5050);
+        BEAST_EXPECT(s.counts[0] == 1);
+        BEAST_EXPECT(s.counts[1] == 1);
+        BEAST_EXPECT(s.counts[2] == 2);
+        BEAST_EXPECT(s.counts[7] == 36);
+        BEAST_EXPECT(s.counts[Histogram::bounded] == 0);
+    }
+
+    void
+    testFormat()
+    {
+        testcase("format");
+        using namespace std::chrono_literals;
+
+        auto const collector = PrometheusCollector::New(
+            "node", Journal{Journal::getNullSink()});
+        BEAST_EXPECT(collector->format().empty());
+
+        auto counter = collector->make_counter("rpc", "requests");
+        auto gauge = collector->make_gauge("jobq.job-count");
+        auto meter = collector->make_meter("overlay.bytes");
+        auto event = collector->make_event("rpc", "time");
+        int hooked = 0;
+        auto hook = collector->make_hook([&] {
+            ++hooked;
+            gauge = 7;
+        });
+
+        counter.increment(3);
+        ++counter;
+        meter += 100;
+        event.notify(3ms);
+        event.notify(20ms);
+
+        auto const text = collector->format();
+        BEAST_EXPECT(hooked == 1);
+        BEAST_EXPECT(contains(text, "# TYPE node_rpc_requests counter"));
+        BEAST_EXPECT(contains(text, "node_rpc_requests 4"));
+        BEAST_EXPECT(contains(text, "# TYPE node_jobq_job_count gauge"));
+        BEAST_EXPECT(contains(text, "node_jobq_job_count 7"));
+        BEAST_EXPECT(contains(text, "# TYPE node_overlay_bytes counter"));
+        BEAST_EXPECT(contains(text, "node_overlay_bytes 100"));
+        BEAST_EXPECT(contains(text, "# TYPE node_rpc_time histogram"));
+        BEAST_EXPECT(contains(text, "node_rpc_time_bucket{le=\"2\"} 0"));
+        BEAST_EXPECT(contains(text, "node_rpc_time_bucket{le=\"4\"} 1"));
+        BEAST_EXPECT(contains(text, "node_rpc_time_bucket{le=\"32\"} 2"));
+        BEAST_EXPECT(contains(text, "node_rpc_time_bucket{le=\"+Inf\"} 2"));
+        BEAST_EXPECT(contains(text, "node_rpc_time_sum 23"));
+        BEAST_EXPECT(contains(text, "node_rpc_time_count 2"));
+
+        // Metrics sharing a name are reported as one
+        {
+            auto other = collector->make_counter("rpc.requests");
+            other.increment(10);
+            BEAST_EXPECT(contains(collector->format(), "node_rpc_requests 14"));
+        }
+
+        // A destroyed metric is no longer reported
+        event = Event{};
+        BEAST_EXPECT(
+            collector->format().find("node_rpc_time") == std::string::npos);
+        BEAST_EXPECT(contains(collector->format(), "node_rpc_requests 4"));
+    }
+
+    void
+    run() override
+    {
+        testHistogram();
+        testFormat();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PrometheusCollector, insight, beast);
+
+}  // namespace insight
+}  // namespace beast
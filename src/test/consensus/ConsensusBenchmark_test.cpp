@@ -0,0 +1,346 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/beast/unit_test.h>
+#include <test/csf.h>
+#include <test/csf/random.h>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+/*  Consensus benchmark.
+
+    Simulates consensus over a large network and reports how long each
+    simulated round costs to run, along with the distribution of close and
+    validation latencies the network sees. This suite is manual:
+
+        rippled --unittest=ConsensusBenchmark --unittest-arg="<config>"
+
+    The config is a comma separated list of key=value pairs. A value may
+    list several choices separated by ':', and the network is simulated
+    once for each combination of choices, so settings can be compared:
+
+        peers           Peers in the network. Default 200.
+        unl             Peers each peer trusts. Default all of them.
+        unls            Distinct UNLs the peers pick from. Default 10.
+        topology        How peers connect: trust, complete or random.
+                        Default trust.
+        degree          Connections per peer for a random topology.
+                        Default 10.
+        regions         Regions the peers are spread over. Default 1.
+        local           Link delay within a region, in ms. Default 20.
+        remote          Link delay to the far side of the world, in ms.
+                        Regions sit on a ring, and the delay between two
+                        of them grows with their distance. Default 150.
+        tps             Transactions submitted per second. Default 100.
+        duration        Simulated time, in seconds. Default 120.
+        seed            Seed for the random network. Default 42.
+        csv             A file to append one line per simulation to.
+
+    These override the ConsensusParms of every peer, in ms or percent:
+
+        min_consensus   ledgerMIN_CONSENSUS
+        max_consensus   ledgerMAX_CONSENSUS
+        min_close       ledgerMIN_CLOSE
+        granularity     ledgerGRANULARITY
+        av_min_time     avMIN_CONSENSUS_TIME
+        consensus_pct   minCONSENSUS_PCT
+
+    For example, to see how the UNL size affects close times:
+
+        peers=500,unl=35:100:250,regions=5,topology=trust
+*/
+class ConsensusBenchmark_test : public beast::unit_test::suite
+{
+    using Hist = csf::Histogram<csf::SimDuration>;
+
+    struct Result
+    {
+        std::chrono::milliseconds wall{};
+        std::size_t accepted = 0;
+        std::size_t fullyValidated = 0;
+        std::size_t branches = 0;
+        bool synchronized = false;
+        Hist acceptToAccept;
+        Hist acceptToFullyValid;
+    };
+
+    // Expand the settings that list several choices into one set of
+    // settings for each combination of choices
+    static std::vector<std::vector<std::string>>
+    expand(std::vector<std::string> const& lines)
+    {
+        std::vector<std::vector<std::string>> combos(1);
+        for (auto const& line : lines)
+        {
+            auto const eq = line.find('=');
+            if (eq == std::string::npos)
+            {
+                for (auto& combo : combos)
+                    combo.push_back(line);
+                continue;
+            }
+
+            std::vector<std::string> choices;
+            boost::split(choices, line.substr(eq + 1), boost::is_any_of(":"));
+
+            std::vector<std::vector<std::string>> next;
+            next.reserve(combos.size() * choices.size());
+            for (auto const& combo : combos)
+            {
+                for (auto const& choice : choices)
+                {
+                    next.push_back(combo);
+                    next.back().push_back(line.substr(0, eq + 1) + choice);
+                }
+            }
+            combos = std::move(next);
+        }
+        return combos;
+    }
+
+    static void
+    override(
+        Section const& config,
+        std::string const& name,
+        std::chrono::milliseconds& value)
+    {
+        value = std::chrono::milliseconds{
+            get<std::int64_t>(config, name, value.count())};
+    }
+
+    Result
+    simulate(Section const& config)
+    {
+        using namespace std::chrono;
+        using namespace csf;
+
+        auto const numPeers =
+            std::max<std::size_t>(1, get<std::size_t>(config, "peers", 200));
+        auto const unl = std::clamp<std::size_t>(
+            get<std::size_t>(config, "unl", numPeers), 1, numPeers);
+        auto const unls =
+            std::max<std::size_t>(1, get<std::size_t>(config, "unls", 10));
+        auto const topology = get(config, "topology", "trust");
+        auto const degree = get<std::size_t>(config, "degree", 10);
+        auto const regions =
+            std::max<std::size_t>(1, get<std::size_t>(config, "regions", 1));
+        milliseconds const local{get<std::int64_t>(config, "local", 20)};
+        milliseconds const remote{get<std::int64_t>(config, "remote", 150)};
+        auto const tps =
+            std::max<std::size_t>(1, get<std::size_t>(config, "tps", 100));
+        seconds const duration{get<std::int64_t>(config, "duration", 120)};
+
+        ConsensusParms parms;
+        override(config, "min_consensus", parms.ledgerMIN_CONSENSUS);
+        override(config, "max_consensus", parms.ledgerMAX_CONSENSUS);
+        override(config, "min_close", parms.ledgerMIN_CLOSE);
+        override(config, "granularity", parms.ledgerGRANULARITY);
+        override(config, "av_min_time", parms.avMIN_CONSENSUS_TIME);
+        parms.minCONSENSUS_PCT =
+            get<std::size_t>(config, "consensus_pct", parms.minCONSENSUS_PCT);
+
+        Sim sim;
+        sim.rng.seed(get<std::uint64_t>(config, "seed", 42));
+        PeerGroup network = sim.createGroup(numPeers);
+        for (Peer* peer : network)
+            peer->consensusParms = parms;
+
+        std::vector<double> const ranks(numPeers, 1.0);
+        if (unl == numPeers)
+            network.trust(network);
+        else
+            randomRankedTrust(
+                network,
+                ranks,
+                unls,
+                std::uniform_int_distribution<>(unl, unl),
+                sim.rng);
+
+        // Regions sit on a ring, so the farthest one is halfway round
+        auto const delay = [&](Peer const* a, Peer const* b) -> SimDuration {
+            auto const ra = static_cast<std::uint32_t>(a->id) % regions;
+            auto const rb = static_cast<std::uint32_t>(b->id) % regions;
+            if (ra == rb)
+                return local;
+            auto const apart = std::min(
+                (ra + regions - rb) % regions, (rb + regions - ra) % regions);
+            auto const farthest = std::max<std::size_t>(1, regions / 2);
+            return local + (remote - local) * apart / farthest;
+        };
+        auto const connect = [&](Peer* a, Peer* b) {
+            if (a != b)
+                a->connect(*b, delay(a, b));
+        };
+
+        if (topology == "complete")
+        {
+            for (Peer* a : network)
+                for (Peer* b : network)
+                    connect(a, b);
+        }
+        else if (topology == "random")
+        {
+            std::uniform_int_distribution<std::size_t> pick(0, numPeers - 1);
+            for (Peer* a : network)
+                for (std::size_t i = 0; i < degree; ++i)
+                    connect(a, network[pick(sim.rng)]);
+        }
+        else
+        {
+            for (Peer* a : network)
+                for (Peer* b : a->trustGraph.trustedPeers(a))
+                    connect(a, b);
+        }
+
+        TxCollector txCollector;
+        LedgerCollector ledgerCollector;
+        auto colls = makeCollectors(txCollector, ledgerCollector);
+        sim.collectors.add(colls);
+
+        // Initial round to set prior state
+        sim.run(1);
+
+        Rate const rate{tps, 1000ms};
+        auto selector =
+            makeSelector(network.begin(), network.end(), ranks, sim.rng);
+        auto submitter = makeSubmitter(
+            ConstantDistribution{rate.inv()},
+            sim.scheduler.now(),
+            sim.scheduler.now() + duration,
+            selector,
+            sim.scheduler,
+            sim.rng);
+
+        auto const start = steady_clock::now();
+        sim.run(duration);
+
+        Result result;
+        result.wall =
+            duration_cast<milliseconds>(steady_clock::now() - start);
+        result.accepted = ledgerCollector.accepted;
+        result.fullyValidated = ledgerCollector.fullyValidated;
+        result.branches = sim.branches();
+        result.synchronized = sim.synchronized();
+        result.acceptToAccept = ledgerCollector.acceptToAccept;
+        result.acceptToFullyValid = ledgerCollector.acceptToFullyValid;
+        return result;
+    }
+
+    template <class T>
+    static void
+    header(T& out)
+    {
+        out << std::left << std::setw(10) << "ledgers" << std::setw(10)
+            << "validated" << std::setw(10) << "wall(s)" << std::setw(12)
+            << "ms/round" << std::setw(24) << "close p10/p50/p90(s)"
+            << std::setw(24) << "valid p10/p50/p90(s)" << std::setw(10)
+            << "branches" << std::endl;
+    }
+
+    template <class T>
+    static void
+    row(T& out, Result const& r)
+    {
+        using namespace std::chrono;
+        auto const secs = [](csf::SimDuration d) {
+            return duration_cast<duration<double>>(d).count();
+        };
+        auto const pctls = [&secs](Hist const& h) {
+            std::ostringstream ss;
+            ss << std::fixed << std::setprecision(2)
+               << secs(h.percentile(0.1f)) << "/" << secs(h.percentile(0.5f))
+               << "/" << secs(h.percentile(0.9f));
+            return ss.str();
+        };
+        auto const perRound = r.accepted == 0
+            ? 0.0
+            : double(r.wall.count()) / double(r.accepted);
+
+        out << std::left << std::setw(10) << r.accepted << std::setw(10)
+            << r.fullyValidated << std::setw(10) << std::fixed
+            << std::setprecision(2) << r.wall.count() / 1000.0
+            << std::setw(12) << perRound << std::setw(24)
+            << pctls(r.acceptToAccept) << std::setw(24)
+            << pctls(r.acceptToFullyValid) << std::setw(10) << r.branches
+            << std::endl;
+    }
+
+    static void
+    csv(std::string const& path, std::string const& tag, Result const& r)
+    {
+        using namespace std::chrono;
+        auto const ms = [](csf::SimDuration d) {
+            return duration_cast<milliseconds>(d).count();
+        };
+
+        std::ofstream out(path, std::ofstream::app);
+        out << '"' << tag << '"' << "," << r.accepted << ","
+            << r.fullyValidated << "," << r.wall.count() << ","
+            << (r.accepted == 0 ? 0 : r.wall.count() / r.accepted);
+        for (auto const* h : {&r.acceptToAccept, &r.acceptToFullyValid})
+            for (float p : {0.1f, 0.5f, 0.9f})
+                out << "," << ms(h->percentile(p));
+        out << "," << r.branches << "," << r.synchronized << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        std::vector<std::string> lines;
+        if (!arg().empty())
+            boost::split(lines, arg(), boost::is_any_of(","));
+
+        for (auto const& combo : expand(lines))
+        {
+            Section config;
+            config.append(combo);
+
+            auto const tag = boost::algorithm::join(combo, ",");
+            testcase(tag.empty() ? "defaults" : tag);
+
+            auto const result = simulate(config);
+            header(log);
+            row(log, result);
+            if (auto const path = get(config, "csv", ""); !path.empty())
+                csv(path, tag, result);
+
+            BEAST_EXPECT(result.accepted != 0);
+            if (result.branches != 1 || !result.synchronized)
+                log << "network did not stay on one synchronized branch"
+                    << std::endl;
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(ConsensusBenchmark, consensus, ripple);
+
+}  // namespace test
+}  // namespace ripple
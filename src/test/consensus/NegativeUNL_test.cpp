@@ -1494,10 +1494,57 @@ class NegativeUNLVoteScoreTable_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testBuildScoreTableObserved()
+    {
+        testcase("Build Score Table Observed");
+
+        NetworkHistory history = {*this, {10, 0, false, false, 256 + 3}};
+        BEAST_EXPECT(history.goodHistory);
+        if (!history.goodHistory)
+            return;
+
+        NodeID myId = history.UNLNodeIDs[0];
+        history.walkHistoryAndAddValidations(
+            [&](std::shared_ptr<Ledger const> const& l,
+                std::size_t idx) -> bool {
+                return idx == 0 || (l->seq() + idx) % 3 != 0;
+            });
+
+        NegativeUNLVote walked(myId, history.env.journal);
+        auto const expected = walked.buildScoreTable(
+            history.lastLedger(), history.UNLNodeIDSet, history.validations);
+        BEAST_EXPECT(expected);
+
+        // Observing each ledger as it is built gives the same scores
+        auto const& ledgers = history.history;
+        NegativeUNLVote observed(myId, history.env.journal);
+        for (auto i = ledgers.size() - 256; i < ledgers.size(); ++i)
+            observed.observe(ledgers[i], history.validations);
+        BEAST_EXPECT(observed.window_.size() == 256);
+        BEAST_EXPECT(
+            observed.buildScoreTable(
+                history.lastLedger(),
+                history.UNLNodeIDSet,
+                history.validations) == expected);
+
+        // Observing a ledger again does nothing, but going back starts the
+        // window over, and the scores are then rebuilt from the validations
+        observed.observe(history.lastLedger(), history.validations);
+        observed.observe(ledgers[ledgers.size() - 3], history.validations);
+        BEAST_EXPECT(observed.window_.size() == 1);
+        BEAST_EXPECT(
+            observed.buildScoreTable(
+                history.lastLedger(),
+                history.UNLNodeIDSet,
+                history.validations) == expected);
+    }
+
     void
     run() override
     {
         testBuildScoreTableCombination();
+        testBuildScoreTableObserved();
     }
 };
 
@@ -21,9 +21,11 @@
 #include <ripple/beast/clock/manual_clock.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/consensus/Validations.h>
+#include <atomic>
 #include <memory>
 #include <test/csf/Validation.h>
 #include <test/unit_test/SuiteJournal.h>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <vector>
@@ -753,6 +755,19 @@ class Validations_test : public beast::unit_test::suite
         harness.clock().advance(harness.parms().validationSET_EXPIRES);
         harness.vals().expire(j);
         BEAST_EXPECT(harness.vals().numTrustedForLedger(ledgerC.id()) == 0);
+
+        // A set read since it was added is kept until it has not been read
+        // for validationSET_EXPIRES
+        Ledger const ledgerD = h["abcd"];
+        BEAST_EXPECT(ValStatus::current == harness.add(a.validate(ledgerD)));
+        harness.clock().advance(harness.parms().validationSET_EXPIRES / 2);
+        BEAST_EXPECT(harness.vals().numTrustedForLedger(ledgerD.id()) == 1);
+        harness.clock().advance(harness.parms().validationSET_EXPIRES / 2);
+        harness.vals().expire(j);
+        BEAST_EXPECT(harness.vals().sizeOfByLedgerCache() == 1);
+        harness.clock().advance(harness.parms().validationSET_EXPIRES);
+        harness.vals().expire(j);
+        BEAST_EXPECT(harness.vals().sizeOfByLedgerCache() == 0);
     }
 
     void
@@ -1005,6 +1020,51 @@ class Validations_test : public beast::unit_test::suite
         BEAST_EXPECT(harness.vals().numTrustedForLedger(ledgerA.id()) == 1);
     }
 
+    void
+    testConcurrentReads()
+    {
+        testcase("Concurrent reads");
+        LedgerHistoryHelper h;
+        TestHarness harness(h.oracle);
+        Ledger ledgerA = h["a"];
+
+        std::vector<Node> nodes;
+        for (int i = 0; i < 32; ++i)
+            nodes.push_back(harness.makeNode());
+
+        // Readers see the count grow as validations are added, without
+        // ever seeing it go back.
+        std::atomic<bool> done{false};
+        std::atomic<bool> ordered{true};
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; ++i)
+        {
+            readers.emplace_back([&] {
+                std::size_t last = 0;
+                while (!done.load())
+                {
+                    auto const n =
+                        harness.vals().numTrustedForLedger(ledgerA.id());
+                    if (n < last || n > nodes.size() ||
+                        harness.vals().fees(ledgerA.id(), 1).size() < n)
+                        ordered = false;
+                    last = n;
+                }
+            });
+        }
+
+        for (auto& node : nodes)
+            BEAST_EXPECT(
+                ValStatus::current == harness.add(node.validate(ledgerA)));
+        done = true;
+        for (auto& t : readers)
+            t.join();
+
+        BEAST_EXPECT(ordered);
+        BEAST_EXPECT(
+            harness.vals().numTrustedForLedger(ledgerA.id()) == nodes.size());
+    }
+
     void
     testSeqEnforcer()
     {
@@ -1140,6 +1200,7 @@ class Validations_test : public beast::unit_test::suite
         testGetPreferredLCL();
         testAcquireValidatedLedger();
         testNumTrustedForLedger();
+        testConcurrentReads();
         testSeqEnforcer();
         testTrustChanged();
     }
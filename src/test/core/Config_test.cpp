@@ -1279,6 +1279,53 @@ r.ripple.com:51235
         BEAST_EXPECT(!testDiverged("901"));
     }
 
+    void
+    testThreads()
+    {
+        testcase("threads");
+
+        {
+            Config c;
+            c.loadFromString("");
+            BEAST_EXPECT(c.JOB_QUEUE_CPUS.empty());
+            BEAST_EXPECT(c.IO_CPUS.empty());
+        }
+        {
+            Config c;
+            c.loadFromString(R"rippleConfig(
+[threads]
+job_queue = 4-6,0,2
+io = 1
+nodestore_read = 3
+)rippleConfig");
+            BEAST_EXPECT(
+                (c.JOB_QUEUE_CPUS == std::vector<unsigned>{0, 2, 4, 5, 6}));
+            BEAST_EXPECT((c.IO_CPUS == std::vector<unsigned>{1}));
+        }
+
+        auto const invalid = [](std::string const& key,
+                                std::string const& value) {
+            try
+            {
+                Config c;
+                c.loadFromString("[threads]\n" + key + "=" + value);
+                return false;
+            }
+            catch (std::runtime_error&)
+            {
+                return true;
+            }
+        };
+        for (auto const key : {"job_queue", "io", "nodestore_read"})
+        {
+            BEAST_EXPECT(invalid(key, "two"));
+            BEAST_EXPECT(invalid(key, "3-1"));
+            BEAST_EXPECT(invalid(key, "-1"));
+            BEAST_EXPECT(invalid(key, "node"));
+            BEAST_EXPECT(invalid(key, ","));
+        }
+    }
+
     void
     run() override
     {
@@ -1296,6 +1343,7 @@ r.ripple.com:51235
         testAmendment();
         testOverlay();
         testNetworkID();
+        testThreads();
     }
 };
 
@@ -17,8 +17,16 @@
 */
 //==============================================================================
 
+#include <ripple/beast/insight/NullCollector.h>
 #include <ripple/beast/unit_test.h>
+#include <ripple/core/JobLatencyProbe.h>
 #include <ripple/core/JobQueue.h>
+#include <ripple/core/JobTypes.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <test/jtx/Env.h>
 
 namespace ripple {
@@ -149,12 +157,377 @@ class JobQueue_test : public beast::unit_test::suite
         }
     }
 
+    // Blocks the jobs that wait on it until it is opened
+    struct Gate
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        int arrived = 0;
+        bool open = false;
+
+        void
+        wait()
+        {
+            std::unique_lock lock(mutex);
+            ++arrived;
+            cv.notify_all();
+            cv.wait(lock, [this] { return open; });
+        }
+
+        void
+        waitFor(int count)
+        {
+            std::unique_lock lock(mutex);
+            cv.wait(lock, [&] { return arrived >= count; });
+        }
+
+        void
+        release()
+        {
+            std::lock_guard lock(mutex);
+            open = true;
+            cv.notify_all();
+        }
+    };
+
+    void
+    testPriority()
+    {
+        testcase("priority");
+        jtx::Env env{*this};
+
+        JobQueue jQueue{
+            1,
+            beast::insight::NullCollector::New(),
+            env.journal,
+            env.app().logs(),
+            env.app().getPerfLog()};
+
+        // Hold the only thread while the other jobs queue up
+        Gate gate;
+        BEAST_EXPECT(jQueue.addJob(jtCLIENT, "Blocker", [&] { gate.wait(); }));
+        gate.waitFor(1);
+
+        std::mutex mutex;
+        std::vector<int> order;
+        auto const add = [&](JobType type, int id) {
+            return jQueue.addJob(type, "PriorityTest", [&, id] {
+                std::lock_guard lock(mutex);
+                order.push_back(id);
+            });
+        };
+        BEAST_EXPECT(add(jtCLIENT_RPC, 1));
+        BEAST_EXPECT(add(jtLEDGER_REQ, 2));
+        BEAST_EXPECT(add(jtCLIENT_RPC, 3));
+        BEAST_EXPECT(add(jtLEDGER_REQ, 4));
+        BEAST_EXPECT(jQueue.getJobCount(jtCLIENT_RPC) == 2);
+        BEAST_EXPECT(jQueue.getJobCountGE(jtCLIENT_RPC) == 4);
+
+        // Higher priority types first, and in order within a type
+        gate.release();
+        jQueue.rendezvous();
+        BEAST_EXPECT((order == std::vector<int>{2, 4, 1, 3}));
+        jQueue.stop();
+    }
+
+    void
+    testLimit()
+    {
+        testcase("limit");
+        jtx::Env env{*this};
+
+        JobQueue jQueue{
+            2,
+            beast::insight::NullCollector::New(),
+            env.journal,
+            env.app().logs(),
+            env.app().getPerfLog()};
+
+        // Only one fetch pack is made at a time
+        Gate gate;
+        BEAST_EXPECT(jQueue.addJob(jtPACK, "LimitTest", [&] { gate.wait(); }));
+        BEAST_EXPECT(jQueue.addJob(jtPACK, "LimitTest", [&] { gate.wait(); }));
+        gate.waitFor(1);
+        BEAST_EXPECT(jQueue.getJobCount(jtPACK) == 1);
+        BEAST_EXPECT(jQueue.getJobCountTotal(jtPACK) == 2);
+
+        // The waiting pack does not keep the other thread from other jobs
+        Gate other;
+        BEAST_EXPECT(
+            jQueue.addJob(jtLEDGER_REQ, "LimitTest", [&] { other.wait(); }));
+        other.waitFor(1);
+        BEAST_EXPECT(jQueue.getJobCount(jtPACK) == 1);
+        other.release();
+
+        gate.release();
+        jQueue.rendezvous();
+        BEAST_EXPECT(gate.arrived == 2);
+        BEAST_EXPECT(jQueue.getJobCountTotal(jtPACK) == 0);
+        jQueue.stop();
+    }
+
+    void
+    testParallelFor()
+    {
+        testcase("parallel for");
+        jtx::Env env{*this};
+
+        JobQueue jQueue{
+            4,
+            beast::insight::NullCollector::New(),
+            env.journal,
+            env.app().logs(),
+            env.app().getPerfLog()};
+
+        // Every index is visited exactly once
+        auto const check = [&](std::size_t count, std::size_t jobs) {
+            std::vector<std::atomic<int>> visits(count);
+            jQueue.parallelFor(
+                jtCLIENT, "ParallelForTest", count, jobs, [&](std::size_t i) {
+                    ++visits[i];
+                });
+            return std::all_of(visits.begin(), visits.end(), [](auto& v) {
+                return v.load() == 1;
+            });
+        };
+        BEAST_EXPECT(check(0, 4));
+        BEAST_EXPECT(check(1, 4));
+        BEAST_EXPECT(check(1000, 4));
+        BEAST_EXPECT(check(1000, 1));
+
+        // A job may use it while it holds every thread of the queue
+        Gate gate;
+        for (int i = 0; i < 3; ++i)
+            BEAST_EXPECT(
+                jQueue.addJob(jtCLIENT, "Blocker", [&] { gate.wait(); }));
+        gate.waitFor(3);
+        std::atomic<bool> inJob{false};
+        std::atomic<bool> finished{false};
+        BEAST_EXPECT(jQueue.addJob(jtCLIENT, "ParallelForTest", [&] {
+            inJob = check(100, 8);
+            finished = true;
+        }));
+        while (!finished)
+            std::this_thread::yield();
+        gate.release();
+        jQueue.rendezvous();
+        BEAST_EXPECT(inJob);
+
+        // Once the queue stops, this thread makes every call
+        jQueue.stop();
+        BEAST_EXPECT(check(100, 4));
+    }
+
+    void
+    testDeadline()
+    {
+        testcase("deadline");
+        using namespace std::chrono_literals;
+        jtx::Env env{*this};
+
+        JobQueue jQueue{
+            1,
+            beast::insight::NullCollector::New(),
+            env.journal,
+            env.app().logs(),
+            env.app().getPerfLog()};
+
+        Gate gate;
+        BEAST_EXPECT(jQueue.addJob(jtCLIENT, "Blocker", [&] { gate.wait(); }));
+        gate.waitFor(1);
+
+        std::mutex mutex;
+        std::vector<int> order;
+        auto const add = [&](JobType type, int id) {
+            return jQueue.addJob(type, "DeadlineTest", [&, id] {
+                std::lock_guard lock(mutex);
+                order.push_back(id);
+            });
+        };
+
+        // Let a client request wait past its deadline
+        auto const& info = JobTypes::instance().get(jtCLIENT_RPC);
+        BEAST_EXPECT(info.getDeadline() != 0ms);
+        BEAST_EXPECT(add(jtCLIENT_RPC, 1));
+        std::this_thread::sleep_for(info.getDeadline() + 100ms);
+        BEAST_EXPECT(add(jtLEDGER_REQ, 2));
+        BEAST_EXPECT(add(jtREPLAY_TASK, 3));
+        BEAST_EXPECT(add(jtTRANSACTION, 4));
+
+        // The late request passes the higher priority jobs that are not
+        // late, but not the transaction.
+        gate.release();
+        jQueue.rendezvous();
+        BEAST_EXPECT((order == std::vector<int>{4, 1, 3, 2}));
+
+        auto const jobTypes = jQueue.getJson()["job_types"];
+        int found = 0;
+        for (auto const& jobType : jobTypes)
+        {
+            if (jobType["job_type"] == "clientRPC")
+            {
+                ++found;
+                BEAST_EXPECT(jobType["deadline_missed"] == "1");
+            }
+            else
+            {
+                BEAST_EXPECT(!jobType.isMember("deadline_missed"));
+            }
+        }
+        BEAST_EXPECT(found == 1);
+        jQueue.stop();
+    }
+
+    void
+    testAgingLimit()
+    {
+        testcase("aging limit");
+        using namespace std::chrono_literals;
+        jtx::Env env{*this};
+
+        JobQueue jQueue{
+            1,
+            beast::insight::NullCollector::New(),
+            env.journal,
+            env.app().logs(),
+            env.app().getPerfLog()};
+
+        Gate gate;
+        BEAST_EXPECT(jQueue.addJob(jtCLIENT, "Blocker", [&] { gate.wait(); }));
+        gate.waitFor(1);
+
+        std::mutex mutex;
+        std::vector<int> order;
+        auto const add = [&](JobType type, int id) {
+            return jQueue.addJob(type, "AgingLimitTest", [&, id] {
+                std::lock_guard lock(mutex);
+                order.push_back(id);
+            });
+        };
+
+        // Overload the clients, so that they are all late
+        auto const& info = JobTypes::instance().get(jtCLIENT_RPC);
+        for (int i = 0; i < 20; ++i)
+            BEAST_EXPECT(add(jtCLIENT_RPC, i));
+        std::this_thread::sleep_for(info.getDeadline() + 100ms);
+
+        // Job types with no deadline of their own still get to run
+        BEAST_EXPECT(
+            JobTypes::instance().get(jtTRANSACTION_l).getDeadline() == 0ms);
+        BEAST_EXPECT(add(jtTRANSACTION_l, 100));
+        BEAST_EXPECT(
+            JobTypes::instance().get(jtVALIDATION_ut).getDeadline() == 0ms);
+        BEAST_EXPECT(add(jtVALIDATION_ut, 200));
+
+        gate.release();
+        jQueue.rendezvous();
+        BEAST_EXPECT(order.size() == 22);
+        auto const position = [&](int id) {
+            return std::find(order.begin(), order.end(), id) - order.begin();
+        };
+        BEAST_EXPECT(position(100) == 4);
+        BEAST_EXPECT(position(200) == 9);
+        BEAST_EXPECT(order.back() == 19);
+        jQueue.stop();
+    }
+
+    void
+    testCoroStacks()
+    {
+        testcase("coro stacks");
+        jtx::Env env{*this};
+
+        JobQueue jQueue{
+            1,
+            beast::insight::NullCollector::New(),
+            env.journal,
+            env.app().logs(),
+            env.app().getPerfLog(),
+            {},
+            CoroStackPool::Setup{kilobytes(256), true, 1}};
+
+        auto const run = [&] {
+            int ran = 0;
+            auto coro = jQueue.postCoro(
+                jtCLIENT,
+                "CoroStackTest",
+                [&ran](std::shared_ptr<JobQueue::Coro> const&) { ++ran; });
+            if (!BEAST_EXPECT(coro))
+                return;
+            coro->join();
+
+            // The stack goes back to the pool with the last reference
+            coro.reset();
+            jQueue.rendezvous();
+            BEAST_EXPECT(ran == 1);
+        };
+
+        // The second coroutine runs on the stack of the first
+        run();
+        run();
+        auto const stacks = jQueue.getJson()["coro_stacks"];
+        BEAST_EXPECT(stacks["size"].asUInt() == kilobytes(256));
+        BEAST_EXPECT(stacks["in_use"].asUInt() == 0);
+        BEAST_EXPECT(stacks["pooled"].asUInt() == 1);
+        BEAST_EXPECT(stacks["hits"] == "1");
+        BEAST_EXPECT(stacks["misses"] == "1");
+        jQueue.stop();
+    }
+
+    void
+    testLatencyProbe()
+    {
+        testcase("LatencyProbe");
+
+        using namespace std::chrono_literals;
+        jtx::Env env{*this};
+        JobQueue& jQueue = env.app().getJobQueue();
+        auto const collector = beast::insight::NullCollector::New();
+
+        // Every sample queues one probe at each probed type
+        {
+            JobLatencyProbe probe(jQueue, collector, 0ms);
+            probe.sample();
+            jQueue.rendezvous();
+            probe.sample();
+            jQueue.rendezvous();
+
+            auto const json = probe.getJson();
+            BEAST_EXPECT(json.size() == 5);
+            for (auto const type : {jtCLIENT, jtTRANSACTION, jtADMIN})
+            {
+                auto const& latencies = json[JobTypes::name(type)];
+                BEAST_EXPECT(latencies["count"] == "2");
+                BEAST_EXPECT(
+                    std::stoull(latencies["p50"].asString()) <=
+                    std::stoull(latencies["max"].asString()));
+            }
+        }
+
+        // Samples within the interval are skipped
+        {
+            JobLatencyProbe probe(jQueue, collector, 1h);
+            probe.sample();
+            probe.sample();
+            jQueue.rendezvous();
+            auto const json = probe.getJson();
+            BEAST_EXPECT(json[JobTypes::name(jtCLIENT)]["count"] == "1");
+        }
+    }
+
 public:
     void
     run() override
     {
         testAddJob();
         testPostCoro();
+        testPriority();
+        testLimit();
+        testParallelFor();
+        testDeadline();
+        testAgingLimit();
+        testCoroStacks();
+        testLatencyProbe();
     }
 };
 
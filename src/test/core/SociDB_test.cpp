@@ -20,9 +20,12 @@
 #include <ripple/basics/BasicConfig.h>
 #include <ripple/basics/contract.h>
 #include <ripple/core/ConfigSections.h>
+#include <ripple/core/DatabaseCon.h>
 #include <ripple/core/SociDB.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
+#include <chrono>
+#include <future>
 #include <test/jtx/TestSuite.h>
 
 namespace ripple {
@@ -359,12 +362,158 @@ public:
             bfs::remove(dbPath);
     }
     void
+    testCachedStatement()
+    {
+        testcase("cachedStatement");
+        BasicConfig c;
+        setupSQLiteConfig(c, getDatabasePath());
+        DBConfig sc(c, "SociTestDB");
+        {
+            soci::session s;
+            sc.open(s);
+            s << "CREATE TABLE IF NOT EXISTS CacheTest ("
+                 "  Key    INTEGER PRIMARY KEY,"
+                 "  Name   TEXT,"
+                 "  Data   BLOB"
+                 ");";
+            s << "INSERT INTO CacheTest (Key, Name, Data) VALUES "
+                 "(1, 'one', x'0102'), (2, NULL, NULL);";
+
+            std::string const sql =
+                "SELECT Name, Data FROM CacheTest WHERE Key = ?;";
+            for (std::int64_t key : {1, 2, 3, 1})
+            {
+                CachedStatement st(s, sql);
+                st.bind(1, key);
+                if (key == 3)
+                {
+                    BEAST_EXPECT(!st.step());
+                    continue;
+                }
+                if (!BEAST_EXPECT(st.step()))
+                    continue;
+
+                std::vector<std::uint8_t> data;
+                if (key == 1)
+                {
+                    BEAST_EXPECT(st.getText(0) == "one");
+                    BEAST_EXPECT(st.getBlob(1, data));
+                    BEAST_EXPECT(data == std::vector<std::uint8_t>({1, 2}));
+                    BEAST_EXPECT(
+                        st.sql() ==
+                        "SELECT Name, Data FROM CacheTest WHERE Key = 1;");
+                }
+                else
+                {
+                    BEAST_EXPECT(!st.getText(0));
+                    BEAST_EXPECT(!st.getBlob(1, data));
+                }
+                BEAST_EXPECT(!st.step());
+
+                // The same query may run nested in the first
+                CachedStatement nested(s, sql);
+                nested.bind(1, 1);
+                BEAST_EXPECT(nested.step());
+                BEAST_EXPECT(nested.getText(0) == "one");
+            }
+
+            try
+            {
+                CachedStatement bad(s, "SELECT FROM;");
+                fail("prepared bad SQL");
+            }
+            catch (std::runtime_error const&)
+            {
+                pass();
+            }
+
+            clearStatementCache(s);
+        }
+        namespace bfs = boost::filesystem;
+        bfs::path dbPath(sc.connectionString());
+        if (bfs::is_regular_file(dbPath))
+            bfs::remove(dbPath);
+    }
+    void
+    testReadConnections()
+    {
+        testcase("readConnections");
+        namespace bfs = boost::filesystem;
+        std::array<char const*, 1> const pragma{{"PRAGMA journal_mode=wal;"}};
+        std::array<char const*, 1> const init{
+            {"CREATE TABLE IF NOT EXISTS ReadTest ("
+             "  Key    INTEGER PRIMARY KEY,"
+             "  Value  INTEGER"
+             ");"}};
+
+        DatabaseCon::Setup setup;
+        setup.dataDir = getDatabasePath();
+        setup.readConnections = 2;
+        {
+            DatabaseCon con(setup, "ReadTestDB.db", pragma, init);
+            BEAST_EXPECT(con.readConnections() == 2);
+
+            *con.checkoutDb() << "INSERT INTO ReadTest (Value) VALUES (7);";
+            {
+                int value = 0;
+                auto db = con.checkoutReadDb();
+                *db << "SELECT Value FROM ReadTest;", soci::into(value);
+                BEAST_EXPECT(value == 7);
+
+                // The connections for reads refuse to write
+                try
+                {
+                    *db << "INSERT INTO ReadTest (Value) VALUES (8);";
+                    fail("wrote through a read-only connection");
+                }
+                catch (soci::soci_error const&)
+                {
+                    pass();
+                }
+            }
+
+            // A read does not wait on the connection that writes
+            auto const writer = con.checkoutDb();
+            auto count = std::async(std::launch::async, [&con] {
+                int n = 0;
+                *con.checkoutReadDb() << "SELECT COUNT(*) FROM ReadTest;",
+                    soci::into(n);
+                return n;
+            });
+            BEAST_EXPECT(
+                count.wait_for(std::chrono::seconds(10)) ==
+                std::future_status::ready);
+            BEAST_EXPECT(count.get() == 1);
+        }
+        for (auto const suffix : {"", "-wal", "-shm"})
+        {
+            auto const dbPath =
+                getDatabasePath() / (std::string("ReadTestDB.db") + suffix);
+            if (bfs::is_regular_file(dbPath))
+                bfs::remove(dbPath);
+        }
+
+        // A temporary database has no other connections to share
+        setup.standAlone = true;
+        {
+            DatabaseCon con(setup, "ReadTestDB.db", pragma, init);
+            BEAST_EXPECT(con.readConnections() == 0);
+            *con.checkoutDb() << "INSERT INTO ReadTest (Value) VALUES (7);";
+            int value = 0;
+            *con.checkoutReadDb() << "SELECT Value FROM ReadTest;",
+                soci::into(value);
+            BEAST_EXPECT(value == 7);
+        }
+    }
+    void
     run() override
     {
         testSQLiteFileNames();
         testSQLiteSession();
         testSQLiteSelect();
         testSQLiteDeleteWithSubselect();
+        testCachedStatement();
+        testReadConnections();
     }
 };
 
@@ -54,6 +54,11 @@ class PerfLogTest : public PerfLog
     {
     }
 
+    void
+    rpcTimes(std::string const& method, RpcTimes const& times) override
+    {
+    }
+
     void
     jobQueue(JobType const type) override
     {
@@ -74,12 +79,26 @@ class PerfLogTest : public PerfLog
     {
     }
 
+    void
+    invariantCheck(
+        char const* name,
+        std::chrono::nanoseconds dur,
+        bool passed) override
+    {
+    }
+
     Json::Value
     countersJson() const override
     {
         return Json::Value();
     }
 
+    Json::Value
+    rpcLatencyJson() const override
+    {
+        return Json::Value();
+    }
+
     Json::Value
     currentJson() const override
     {
@@ -511,6 +511,15 @@ struct Peer
                 id));
     }
 
+    void
+    onStablePosition(
+        Result const& result,
+        Ledger const& prevLedger,
+        NetClock::duration const& closeResolution,
+        ConsensusMode const& mode)
+    {
+    }
+
     void
     onForceAccept(
         Result const& result,
@@ -25,7 +25,11 @@
 #include <ripple/json/json_writer.h>
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
+#include <random>
 #include <regex>
+#include <string>
 
 namespace ripple {
 
@@ -716,6 +720,83 @@ struct json_value_test : beast::unit_test::suite
         }
     }
 
+    void
+    test_strings()
+    {
+        // Strings are scanned a word at a time, so try every length and
+        // position of the characters that end a run of plain ones
+        std::mt19937 gen(20230418);
+        std::string const alphabet = "abc \"\\/\n\t\x01\xc3\xa9";
+        std::uniform_int_distribution<std::size_t> pick(
+            0, alphabet.size() - 1);
+
+        for (std::size_t length = 0; length < 40; ++length)
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                std::string text;
+                for (std::size_t j = 0; j < length; ++j)
+                    text += alphabet[pick(gen)];
+
+                Json::Value expected(Json::objectValue);
+                expected["key" + text] = text;
+                expected["list"].append(text);
+
+                Json::Value parsed;
+                Json::Reader r;
+                if (!BEAST_EXPECT(
+                        r.parse(Json::FastWriter().write(expected), parsed)))
+                    continue;
+                BEAST_EXPECT(parsed == expected);
+            }
+
+            // An escape straddling the end of a word is still decoded
+            std::string const padding(length, 'x');
+            Json::Value parsed;
+            Json::Reader r;
+            if (BEAST_EXPECT(r.parse(
+                    "{\"a\":\"" + padding + "\\u00e9\\/\\\"" + padding +
+                        "\"}",
+                    parsed)))
+            {
+                BEAST_EXPECT(parsed["a"] == padding + "\xc3\xa9/\"" + padding);
+            }
+
+            // A string that never ends is an error
+            BEAST_EXPECT(!r.parse("{\"a\":\"" + padding, parsed));
+            BEAST_EXPECT(!r.parse("{\"a\":\"" + padding + "\\\"", parsed));
+        }
+    }
+
+    void
+    test_formatting()
+    {
+        BEAST_EXPECT(Json::valueToString(Json::Int(0)) == "0");
+        BEAST_EXPECT(
+            Json::valueToString(std::numeric_limits<Json::Int>::min()) ==
+            "-2147483648");
+        BEAST_EXPECT(
+            Json::valueToString(std::numeric_limits<Json::UInt>::max()) ==
+            "4294967295");
+        BEAST_EXPECT(Json::valueToString(2.5) == "2.5");
+        BEAST_EXPECT(Json::valueToString(1e21) == "1e+21");
+        BEAST_EXPECT(Json::valueToString(0.1) == "0.1");
+        BEAST_EXPECT(Json::valueToString(1.0 / 3) == "0.3333333333333333");
+
+        BEAST_EXPECT(Json::valueToQuotedString("") == "\"\"");
+        BEAST_EXPECT(
+            Json::valueToQuotedString("a plain string of some length") ==
+            "\"a plain string of some length\"");
+        BEAST_EXPECT(
+            Json::valueToQuotedString("\"\\/\b\f\n\r\t\x01\x1f\x7f\xc3\xa9") ==
+            "\"\\\"\\\\/\\b\\f\\n\\r\\t\\u0001\\u001F\x7f\xc3\xa9\"");
+
+        // Escapes on either side of a word of plain characters
+        BEAST_EXPECT(
+            Json::valueToQuotedString("\n0123456789abcdef\t") ==
+            "\"\\n0123456789abcdef\\t\"");
+    }
+
     void
     test_copy()
     {
@@ -762,6 +843,57 @@ struct json_value_test : beast::unit_test::suite
         pass();
     }
 
+    void
+    test_short_strings()
+    {
+        // Strings on either side of the inline capacity behave the same
+        for (std::size_t length = 0; length <= 2 * sizeof(char*); ++length)
+        {
+            std::string const str(length, static_cast<char>('a' + length));
+            Json::Value v1{str};
+            BEAST_EXPECT(v1.isString());
+            BEAST_EXPECT(v1.asString() == str);
+            BEAST_EXPECT(std::strlen(v1.asCString()) == length);
+            BEAST_EXPECT(v1.isConvertibleTo(Json::nullValue) == str.empty());
+            BEAST_EXPECT(bool(v1) == !str.empty());
+
+            Json::Value v2{v1};
+            BEAST_EXPECT(v2 == v1);
+            BEAST_EXPECT(v2.asString() == str);
+            BEAST_EXPECT(v2.asCString() != v1.asCString());
+
+            Json::Value v3{std::move(v2)};
+            BEAST_EXPECT(v3 == v1);
+            BEAST_EXPECT(v3.asString() == str);
+            BEAST_EXPECT(!v2);
+
+            Json::Value v4{str.c_str()};
+            BEAST_EXPECT(v4 == v1);
+            v4 = "z";
+            BEAST_EXPECT(v4.asString() == "z");
+            BEAST_EXPECT(v1 < v4);
+            v3.swap(v4);
+            BEAST_EXPECT(v3.asString() == "z");
+            BEAST_EXPECT(v4.asString() == str);
+        }
+
+        // Short and long strings compare by their contents
+        Json::Value const shorter{"abc"};
+        Json::Value const longer{std::string(32, 'b')};
+        BEAST_EXPECT(shorter < longer);
+        BEAST_EXPECT(!(longer < shorter));
+        BEAST_EXPECT(shorter != longer);
+        BEAST_EXPECT(Json::Value{"12"}.asInt() == 12);
+        BEAST_EXPECT(Json::Value{"12"}.asUInt() == 12);
+
+        // Inline strings survive being moved around inside containers
+        Json::Value array{Json::arrayValue};
+        for (int i = 0; i < 100; ++i)
+            array.append(std::to_string(i));
+        for (int i = 0; i < 100; ++i)
+            BEAST_EXPECT(array[i].asString() == std::to_string(i));
+    }
+
     void
     test_comparisons()
     {
@@ -1381,8 +1513,11 @@ struct json_value_test : beast::unit_test::suite
         test_bool();
         test_bad_json();
         test_edge_cases();
+        test_strings();
+        test_formatting();
         test_copy();
         test_move();
+        test_short_strings();
         test_comparisons();
         test_compact();
         test_conversions();
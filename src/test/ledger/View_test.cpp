@@ -20,9 +20,11 @@
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/core/ConfigSections.h>
 #include <ripple/ledger/ApplyViewImpl.h>
+#include <ripple/ledger/CachedView.h>
 #include <ripple/ledger/OpenView.h>
 #include <ripple/ledger/PaymentSandbox.h>
 #include <ripple/ledger/Sandbox.h>
+#include <ripple/ledger/detail/ApplyStateTable.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/Protocol.h>
 #include <test/jtx.h>
@@ -164,6 +166,110 @@ class View_test : public beast::unit_test::suite
         BEAST_EXPECT(v.exists(k(3)));
     }
 
+    void
+    testApplyStateTable()
+    {
+        testcase("ApplyStateTable");
+
+        using namespace jtx;
+        Env env(*this);
+        Config config;
+        std::shared_ptr<Ledger const> const genesis = std::make_shared<Ledger>(
+            create_genesis,
+            config,
+            std::vector<uint256>{},
+            env.app().getNodeFamily());
+        auto const ledger = std::make_shared<Ledger>(
+            *genesis, env.app().timeKeeper().closeTime());
+        wipe(*ledger);
+        ledger->rawInsert(sle(1, 1));
+        ReadView& v = *ledger;
+
+        using Table = ripple::detail::ApplyStateTable;
+
+        // A table that was only read through has nothing to apply
+        Table reader;
+        BEAST_EXPECT(seq(reader.read(v, k(1))) == 1);
+        BEAST_EXPECT(!reader.peek(v, k(2)));
+        BEAST_EXPECT(!reader.exists(v, k(2)));
+        BEAST_EXPECT(reader.succ(v, k(0).key, std::nullopt) == k(1).key);
+        BEAST_EXPECT(reader.size() == 0);
+
+        // Many more entries than fit the first buffer, which move with the
+        // table
+        Table writer;
+        for (std::uint64_t id = 2; id < 200; ++id)
+            writer.insert(v, sle(id, id));
+        auto s = writer.peek(v, k(1));
+        seq(s, 7);
+        writer.update(v, s);
+        for (std::uint64_t id = 2; id < 200; id += 2)
+            writer.erase(v, writer.peek(v, k(id)));
+
+        Table moved(std::move(writer));
+        BEAST_EXPECT(moved.size() == 100);
+        BEAST_EXPECT(seq(moved.read(v, k(1))) == 7);
+        BEAST_EXPECT(!moved.exists(v, k(2)));
+        BEAST_EXPECT(seq(moved.read(v, k(199))) == 199);
+        BEAST_EXPECT(moved.succ(v, k(1).key, std::nullopt) == k(3).key);
+
+        moved.apply(*ledger);
+        BEAST_EXPECT(seq(v.read(k(1))) == 7);
+        BEAST_EXPECT(!v.exists(k(2)));
+        BEAST_EXPECT(seq(v.read(k(3))) == 3);
+        BEAST_EXPECT(v.exists(k(199)));
+    }
+
+    // Searches of an owner's NFTokenPages through a CachedView
+    void
+    testCachedPages()
+    {
+        testcase("Cached pages");
+
+        using namespace jtx;
+        Env env(*this);
+        Config config;
+        std::shared_ptr<Ledger const> const genesis = std::make_shared<Ledger>(
+            create_genesis,
+            config,
+            std::vector<uint256>{},
+            env.app().getNodeFamily());
+        auto const ledger = std::make_shared<Ledger>(
+            *genesis, env.app().timeKeeper().closeTime());
+
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        auto const page = [](Account const& owner, std::uint64_t low) {
+            return keylet::nftpage(keylet::nftpage_min(owner), uint256(low));
+        };
+        for (auto const low : {10, 20, 30})
+            ledger->rawInsert(std::make_shared<SLE>(page(alice, low)));
+        ledger->rawInsert(std::make_shared<SLE>(page(bob, 5)));
+        ledger->setImmutable();
+
+        CachedLedger const cached(ledger, env.app().cachedSLEs());
+        for (auto const& owner : {alice, bob})
+        {
+            auto const last = keylet::nftpage_max(owner).key.next();
+            // Twice, so the second pass is answered from the gaps found
+            for (int pass = 0; pass != 2; ++pass)
+            {
+                for (auto const low : {0, 5, 9, 10, 15, 29, 30, 40})
+                {
+                    auto const key = page(owner, low).key;
+                    BEAST_EXPECT(
+                        cached.succ(key, last) == ledger->succ(key, last));
+                }
+            }
+        }
+
+        // Other ranges go to the ledger as they are
+        auto const key = page(alice, 10).key;
+        BEAST_EXPECT(cached.succ(key) == ledger->succ(key));
+        BEAST_EXPECT(
+            cached.succ(key, page(alice, 30).key) == page(alice, 20).key);
+    }
+
     void
     testMeta()
     {
@@ -329,6 +435,75 @@ class View_test : public beast::unit_test::suite
         BEAST_EXPECT(!v0.exists(k(4)));
     }
 
+    // Exercise chains of layered OpenViews
+    void
+    testLayered()
+    {
+        testcase("Layered");
+
+        using namespace jtx;
+        Env env(*this);
+        Config config;
+        std::shared_ptr<Ledger const> const genesis = std::make_shared<Ledger>(
+            create_genesis,
+            config,
+            std::vector<uint256>{},
+            env.app().getNodeFamily());
+        auto const ledger = std::make_shared<Ledger>(
+            *genesis, env.app().timeKeeper().closeTime());
+        wipe(*ledger);
+        ledger->rawInsert(sle(1));
+        ledger->rawInsert(sle(2));
+
+        auto const tx = [](std::uint32_t id) {
+            STTx const stx(ttACCOUNT_SET, [id](STObject& obj) {
+                obj.setAccountID(sfAccount, AccountID(id));
+                obj.setFieldU32(sfSequence, id);
+                obj.setFieldAmount(sfFee, XRPAmount(10));
+                obj.setFieldVL(sfSigningPubKey, Slice{});
+            });
+            auto s = std::make_shared<Serializer>();
+            stx.add(*s);
+            return std::make_pair(stx.getTransactionID(), std::move(s));
+        };
+
+        std::shared_ptr<OpenView const> view = std::make_shared<OpenView>(
+            open_ledger, ledger.get(), ledger->rules(), ledger);
+        std::vector<uint256> ids;
+        for (std::uint32_t i = 3; i < 40; ++i)
+        {
+            auto next = std::make_shared<OpenView>(layered, view);
+            BEAST_EXPECT(next->txCount() == view->txCount());
+            next->rawErase(sle(i - 1));
+            next->rawInsert(sle(i));
+            auto const [id, s] = tx(i);
+            next->rawTxInsert(id, s, nullptr);
+            ids.push_back(id);
+            BEAST_EXPECT(!view->txExists(id));
+            view = OpenView::collapse(std::move(next));
+
+            BEAST_EXPECT(sles(*view) == list(1, i));
+            BEAST_EXPECT(seq(view->read(k(i))) == 1);
+            BEAST_EXPECT(!view->exists(k(i - 1)));
+            BEAST_EXPECT(view->txCount() == ids.size());
+            BEAST_EXPECT(view->txExists(id));
+            BEAST_EXPECT(view->txRead(ids.front()).first);
+        }
+
+        // The tx of every layer are visited once, in key order
+        std::vector<uint256> visited;
+        for (auto const& item : view->txs)
+            visited.push_back(item.first->getTransactionID());
+        std::sort(ids.begin(), ids.end());
+        BEAST_EXPECT(visited == ids);
+
+        // Applying a layered view applies the changes beneath it
+        OpenView flat(open_ledger, ledger.get(), ledger->rules());
+        view->apply(flat);
+        BEAST_EXPECT(sles(flat) == list(1, 39));
+        BEAST_EXPECT(flat.txCount() == ids.size());
+    }
+
     // Verify contextual information
     void
     testContext()
@@ -1099,9 +1274,12 @@ class View_test : public beast::unit_test::suite
         BEAST_EXPECT(k(0).key < k(1).key);
 
         testLedger();
+        testApplyStateTable();
+        testCachedPages();
         testMeta();
         testMetaSucc();
         testStacked();
+        testLayered();
         testContext();
         testSles();
         testUpperAndLowerBound();
@@ -0,0 +1,149 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/json/json_writer.h>
+#include <ripple/net/MultiApiMessage.h>
+#include <ripple/server/WSSession.h>
+#include <boost/asio/buffer.hpp>
+#include <string>
+
+namespace ripple {
+namespace test {
+
+class MultiApiMessage_test : public beast::unit_test::suite
+{
+    static std::string
+    text(Json::Value const& jv)
+    {
+        std::string s;
+        Json::stream(jv, [&](void const* data, std::size_t n) {
+            s.append(static_cast<char const*>(data), n);
+        });
+        return s;
+    }
+
+    static Json::Value
+    makeJson(int version)
+    {
+        Json::Value jv(Json::objectValue);
+        jv["type"] = "transaction";
+        jv["version"] = version;
+        return jv;
+    }
+
+    void
+    testUniform()
+    {
+        testcase("uniform");
+
+        auto const jv = makeJson(0);
+        MultiApiMessage const message{jv};
+
+        // Every version shares one serialization
+        auto const& buffer = message.serialized(1);
+        if (!BEAST_EXPECT(buffer))
+            return;
+        BEAST_EXPECT(*buffer == text(jv));
+        BEAST_EXPECT(message.serialized(2) == buffer);
+        BEAST_EXPECT(message.serialized(3) == buffer);
+        BEAST_EXPECT(&message.json(1) == &jv);
+        BEAST_EXPECT(&message.json(3) == &jv);
+    }
+
+    void
+    testVersions()
+    {
+        testcase("versions");
+
+        MultiApiJson json;
+        for (std::size_t i = 0; i < MultiApiJson::size; ++i)
+            json.val[i] = makeJson(static_cast<int>(i));
+        MultiApiMessage const message{json};
+
+        for (unsigned int version = 1; version <= 3; ++version)
+        {
+            auto const index = apiVersionSelector(version)();
+            BEAST_EXPECT(&message.json(version) == &json.val[index]);
+            auto const& buffer = message.serialized(version);
+            if (!BEAST_EXPECT(buffer))
+                continue;
+            BEAST_EXPECT(*buffer == text(json.val[index]));
+            // Serialized once, then shared
+            BEAST_EXPECT(message.serialized(version) == buffer);
+        }
+        BEAST_EXPECT(message.serialized(1) != message.serialized(2));
+
+        // The buffers outlive the message
+        MultiApiMessage::Buffer kept;
+        {
+            MultiApiMessage const other{json};
+            kept = other.serialized(2);
+        }
+        BEAST_EXPECT(kept && *kept == text(json.val[1]));
+    }
+
+    void
+    testSharedWSMsg()
+    {
+        testcase("shared websocket message");
+
+        auto const data = std::make_shared<std::string const>(
+            text(makeJson(12345)));
+
+        // Two sessions send the same bytes, each at its own pace
+        SharedWSMsg a{data};
+        SharedWSMsg b{data};
+
+        std::string sent;
+        for (;;)
+        {
+            auto const [done, buffers] = a.prepare(4, {});
+            for (auto const& buffer : buffers)
+            {
+                BEAST_EXPECT(buffer.size() <= 4);
+                sent.append(
+                    static_cast<char const*>(buffer.data()), buffer.size());
+            }
+            if (done)
+                break;
+        }
+        BEAST_EXPECT(sent == *data);
+
+        auto const [done, buffers] = b.prepare(65536, {});
+        BEAST_EXPECT(done);
+        BEAST_EXPECT(
+            buffers.size() == 1 && buffers[0].data() == data->data() &&
+            buffers[0].size() == data->size());
+    }
+
+public:
+    void
+    run() override
+    {
+        testUniform();
+        testVersions();
+        testSharedWSMsg();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(MultiApiMessage, net, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -38,16 +38,20 @@ public:
     testBackend(
         std::string const& type,
         std::uint64_t const seedValue,
-        int numObjsToTest = 2000)
+        int numObjsToTest = 2000,
+        std::vector<std::string> const& options = {})
     {
         DummyScheduler scheduler;
 
-        testcase("Backend type=" + type);
+        testcase(
+            "Backend type=" + type +
+            (options.empty() ? "" : " " + options.front()));
 
         Section params;
         beast::temp_dir tempDir;
         params.set("type", type);
         params.set("path", tempDir.path());
+        params.append(options);
 
         beast::xor_shift_engine rng(seedValue);
 
@@ -80,6 +84,29 @@ public:
                 fetchCopyOfBatch(*backend, &copy, batch);
                 BEAST_EXPECT(areBatchesEqual(batch, copy));
             }
+
+            {
+                // Read it back with a single batched fetch, including a
+                // repeated key and a key that was never stored
+                std::vector<uint256 const*> hashes;
+                hashes.reserve(batch.size() + 2);
+                for (auto const& obj : batch)
+                    hashes.push_back(&obj->getHash());
+                hashes.push_back(&batch.front()->getHash());
+                uint256 const missing;
+                hashes.push_back(&missing);
+
+                auto const [objs, status] = backend->fetchBatch(hashes);
+                BEAST_EXPECT(status == ok);
+                BEAST_EXPECT(objs.size() == hashes.size());
+
+                Batch copy(objs.begin(), objs.begin() + batch.size());
+                BEAST_EXPECT(areBatchesEqual(batch, copy));
+                BEAST_EXPECT(
+                    objs[batch.size()] &&
+                    isSame(objs[batch.size()], batch.front()));
+                BEAST_EXPECT(!objs.back());
+            }
         }
 
         {
@@ -106,9 +133,15 @@ public:
         std::uint64_t const seedValue = 50;
 
         testBackend("nudb", seedValue);
+        testBackend("nudb", seedValue, 2000, {"batch_read_threads=4"});
 
 #if RIPPLE_ROCKSDB_AVAILABLE
         testBackend("rocksdb", seedValue);
+        testBackend(
+            "rocksdb",
+            seedValue,
+            2000,
+            {"column_families=1", "inner_node_cache_mb=4"});
 #endif
 
 #ifdef RIPPLE_ENABLE_SQLITE_BACKEND_TESTS
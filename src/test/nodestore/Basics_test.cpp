@@ -19,9 +19,16 @@
 
 #include <ripple/nodestore/DummyScheduler.h>
 #include <ripple/nodestore/Manager.h>
+#include <ripple/nodestore/impl/BatchWriter.h>
+#include <ripple/nodestore/impl/CompressedCache.h>
 #include <ripple/nodestore/impl/DecodedBlob.h>
 #include <ripple/nodestore/impl/EncodedBlob.h>
+#include <ripple/nodestore/impl/ExistenceFilter.h>
+#include <ripple/nodestore/impl/ZstdCodec.h>
+#include <ripple/nodestore/impl/codec.h>
+#include <ripple/protocol/jss.h>
 #include <test/nodestore/TestBase.h>
+#include <nudb/detail/buffer.hpp>
 
 namespace ripple {
 namespace NodeStore {
@@ -72,7 +79,311 @@ public:
 
                 BEAST_EXPECT(isSame(batch[i], object));
             }
+
+            // Decoding out of an owned buffer adopts that buffer
+            auto const p = static_cast<std::uint8_t const*>(encoded.getData());
+            Blob storage(p, p + encoded.getSize());
+            DecodedBlob adopted(
+                encoded.getKey(), storage.data(), storage.size());
+
+            BEAST_EXPECT(adopted.wasOk());
+
+            if (adopted.wasOk())
+            {
+                auto const buffer = storage.data();
+                std::shared_ptr<NodeObject> const object(
+                    adopted.createObject(std::move(storage)));
+
+                BEAST_EXPECT(isSame(batch[i], object));
+                BEAST_EXPECT(object->getData().data() == buffer);
+            }
+        }
+    }
+
+    // Checks the compressed object cache
+    void
+    testCompressedCache(std::uint64_t const seedValue)
+    {
+        testcase("compressed cache");
+
+        auto batch = createPredictableBatch(numObjectsToTest, seedValue);
+
+        {
+            // Everything fits
+            CompressedCache cache(megabytes(16));
+
+            for (auto const& object : batch)
+                cache.insert(*object);
+
+            for (auto const& object : batch)
+            {
+                auto const copy = cache.fetch(object->getHash());
+                BEAST_EXPECT(copy && isSame(object, copy));
+            }
+
+            BEAST_EXPECT(!cache.fetch(uint256{}));
+
+            Json::Value counts(Json::objectValue);
+            cache.getCountsJson(counts);
+            BEAST_EXPECT(
+                counts[jss::compressed_cache_hits] ==
+                std::to_string(batch.size()));
+            BEAST_EXPECT(counts[jss::compressed_cache_misses] == "1");
+            BEAST_EXPECT(counts[jss::compressed_cache_evictions] == "0");
+
+            // Cached objects are refreshed, not added again
+            auto const bytes = cache.bytes();
+            for (auto const& object : batch)
+                cache.insert(*object);
+            BEAST_EXPECT(cache.bytes() == bytes);
+        }
+
+        {
+            // The budget is respected by evicting older objects
+            CompressedCache cache(kilobytes(64));
+
+            for (auto const& object : batch)
+                cache.insert(*object);
+
+            Json::Value counts(Json::objectValue);
+            cache.getCountsJson(counts);
+            BEAST_EXPECT(
+                std::stoull(counts[jss::compressed_cache_bytes].asString()) <=
+                kilobytes(64));
+            BEAST_EXPECT(counts[jss::compressed_cache_evictions] != "0");
+
+            auto const& last = batch.back();
+            auto const copy = cache.fetch(last->getHash());
+            BEAST_EXPECT(copy && isSame(last, copy));
+        }
+    }
+
+    // Checks the backend existence filter
+    void
+    testExistenceFilter(std::uint64_t const seedValue)
+    {
+        testcase("existence filter");
+
+        auto batch = createPredictableBatch(numObjectsToTest, seedValue);
+        auto others = createPredictableBatch(numObjectsToTest, seedValue + 1);
+
+        ExistenceFilter filter(kilobytes(4));
+
+        for (auto const& object : batch)
+            BEAST_EXPECT(!filter.mayContain(object->getHash()));
+
+        for (auto const& object : batch)
+            filter.insert(object->getHash());
+
+        // No false negatives
+        for (auto const& object : batch)
+            BEAST_EXPECT(filter.mayContain(object->getHash()));
+
+        // About 16 bits per key should reject most absent keys
+        int falsePositives = 0;
+        for (auto const& object : others)
+        {
+            if (filter.mayContain(object->getHash()))
+                ++falsePositives;
         }
+        BEAST_EXPECT(falsePositives < numObjectsToTest / 20);
+    }
+
+#if RIPPLE_ZSTD_AVAILABLE
+    // Checks zstd compression with and without trained dictionaries
+    void
+    testZstdCodec(std::uint64_t const seedValue)
+    {
+        testcase("zstd codec");
+
+        // Account nodes which share most of their layout, as real ones do
+        beast::xor_shift_engine rng(seedValue);
+        Blob common(160);
+        beast::rngfill(common.data(), common.size(), rng);
+
+        Batch batch;
+        std::vector<Blob> samples;
+        for (int i = 0; i < numObjectsToTest; ++i)
+        {
+            Blob blob(common);
+            blob.resize(common.size() + 16);
+            beast::rngfill(blob.data() + common.size(), 16, rng);
+            uint256 hash;
+            beast::rngfill(hash.begin(), hash.size(), rng);
+            batch.push_back(NodeObject::createObject(
+                hotACCOUNT_NODE, std::move(blob), hash));
+
+            EncodedBlob e(batch.back());
+            auto const p = static_cast<std::uint8_t const*>(e.getData());
+            samples.emplace_back(p, p + e.getSize());
+        }
+
+        ZstdCodec::Dictionaries dictionaries;
+        dictionaries[hotACCOUNT_NODE] = ZstdCodec::train(samples, 4096);
+        BEAST_EXPECT(!dictionaries[hotACCOUNT_NODE].empty());
+
+        ZstdCodec const trained(3, dictionaries);
+        BEAST_EXPECT(trained.hasDictionary(hotACCOUNT_NODE));
+        BEAST_EXPECT(!trained.hasDictionary(hotLEDGER));
+
+        std::size_t lz4Bytes = 0;
+        std::size_t zstdBytes = 0;
+        for (auto const& object : batch)
+        {
+            EncodedBlob e(object);
+            nudb::detail::buffer bf1;
+            nudb::detail::buffer bf2;
+
+            auto const lz4 =
+                nodeobject_compress(e.getData(), e.getSize(), bf1);
+            lz4Bytes += lz4.second;
+
+            auto const zstd =
+                nodeobject_compress(e.getData(), e.getSize(), bf2, &trained);
+            zstdBytes += zstd.second;
+
+            // lz4 blobs stay readable with a zstd codec configured
+            nudb::detail::buffer out;
+            auto r =
+                nodeobject_decompress(lz4.first, lz4.second, out, &trained);
+            BEAST_EXPECT(
+                r.second == e.getSize() &&
+                std::memcmp(r.first, e.getData(), r.second) == 0);
+
+            r = nodeobject_decompress(zstd.first, zstd.second, out, &trained);
+            BEAST_EXPECT(
+                r.second == e.getSize() &&
+                std::memcmp(r.first, e.getData(), r.second) == 0);
+
+            // A blob naming a dictionary needs a codec that holds it
+            try
+            {
+                nodeobject_decompress(zstd.first, zstd.second, out);
+                fail("missing dictionary");
+            }
+            catch (std::runtime_error const&)
+            {
+                pass();
+            }
+        }
+
+        // The shared layout lives in the dictionary, not in each object
+        BEAST_EXPECT(zstdBytes * 2 < lz4Bytes);
+
+        // Objects without a dictionary are readable by any codec
+        auto const other = createPredictableBatch(100, seedValue);
+        for (auto const& object : other)
+        {
+            if (object->getType() == hotACCOUNT_NODE)
+                continue;
+            EncodedBlob e(object);
+            nudb::detail::buffer bf;
+            nudb::detail::buffer out;
+            auto const zstd =
+                nodeobject_compress(e.getData(), e.getSize(), bf, &trained);
+            auto const r = nodeobject_decompress(zstd.first, zstd.second, out);
+            BEAST_EXPECT(
+                r.second == e.getSize() &&
+                std::memcmp(r.first, e.getData(), r.second) == 0);
+        }
+    }
+#endif
+
+    // Checks that a zstd blob claiming too large a size is rejected
+    void
+    testZstdSizeLimit()
+    {
+        testcase("zstd size limit");
+
+        std::array<std::uint8_t, 64> blob{};
+        auto n = write_varint(blob.data(), 4);
+        n += write_varint(blob.data() + n, 0);
+        n += write_varint(
+            blob.data() + n, ZstdCodec::maxDecompressedSize + 1);
+
+        bool allocated = false;
+        try
+        {
+            nodeobject_decompress(
+                blob.data(), n + 8, [&](std::size_t) -> void* {
+                    allocated = true;
+                    return nullptr;
+                });
+            fail("oversized blob");
+        }
+        catch (std::runtime_error const&)
+        {
+            pass();
+        }
+        BEAST_EXPECT(!allocated);
+    }
+
+    // Checks that the batch writer groups queued writes and reports them
+    void
+    testBatchWriter(std::uint64_t const seedValue)
+    {
+        testcase("batch writer");
+
+        // Runs the write task only when asked to
+        struct ManualScheduler : Scheduler
+        {
+            Task* task = nullptr;
+            std::vector<BatchWriteReport> reports;
+
+            void
+            scheduleTask(Task& t) override
+            {
+                task = &t;
+            }
+            void
+            onFetch(FetchReport const&) override
+            {
+            }
+            void
+            onBatchWrite(BatchWriteReport const& report) override
+            {
+                reports.push_back(report);
+            }
+        };
+
+        struct Sink : BatchWriter::Callback
+        {
+            std::vector<std::size_t> batches;
+
+            void
+            writeBatch(Batch const& batch) override
+            {
+                batches.push_back(batch.size());
+            }
+        };
+
+        auto batch = createPredictableBatch(numObjectsToTest, seedValue);
+        std::size_t bytes = 0;
+        for (auto const& object : batch)
+            bytes += object->getData().size();
+
+        ManualScheduler scheduler;
+        Sink sink;
+        {
+            BatchWriter writer(sink, scheduler);
+
+            for (auto const& object : batch)
+                writer.store(object);
+            BEAST_EXPECT(writer.getWriteLoad() == numObjectsToTest);
+
+            // Everything queued before the task ran is one commit
+            BEAST_EXPECT(scheduler.task);
+            scheduler.task->performScheduledTask();
+        }
+
+        BEAST_EXPECT(sink.batches.size() == 1);
+        BEAST_EXPECT(sink.batches.front() == numObjectsToTest);
+        BEAST_EXPECT(scheduler.reports.size() == 1);
+        auto const& report = scheduler.reports.front();
+        BEAST_EXPECT(report.writeCount == numObjectsToTest);
+        BEAST_EXPECT(report.writeBytes == bytes);
+        BEAST_EXPECT(report.queueDepth == 0);
+        BEAST_EXPECT(report.stallTime.count() == 0);
     }
 
     void
@@ -83,6 +394,18 @@ public:
         testBatches(seedValue);
 
         testBlobs(seedValue);
+
+        testCompressedCache(seedValue);
+
+        testExistenceFilter(seedValue);
+
+#if RIPPLE_ZSTD_AVAILABLE
+        testZstdCodec(seedValue);
+#endif
+
+        testZstdSizeLimit();
+
+        testBatchWriter(seedValue);
     }
 };
 
@@ -0,0 +1,556 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/basics/ByteUtilities.h>
+#include <ripple/basics/StringUtilities.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/nodestore/Manager.h>
+#include <ripple/nodestore/impl/BatchWriter.h>
+#include <ripple/nodestore/impl/TaskQueue.h>
+#include <ripple/protocol/HashPrefix.h>
+#include <ripple/unity/rocksdb.h>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <test/unit_test/SuiteJournal.h>
+#include <thread>
+
+namespace ripple {
+namespace NodeStore {
+
+/*  Nodestore backend benchmark.
+
+    Preloads a backend, then runs a timed mix of reads and writes from a
+    number of client threads and reports throughput and latency
+    percentiles. This suite is manual:
+
+        rippled --unittest=Benchmark --unittest-arg="<config>[;<config>...]"
+
+    Each config is a comma separated list of key=value pairs:
+
+        type            Backend: nudb, rocksdb or memory. Default nudb.
+        path            Directory for the database. Default is a temporary
+                        directory that is removed afterwards.
+        items           Objects preloaded before the timed run.
+        ops             Operations in the timed run. Default equals items.
+        threads         Client threads. Default 4.
+        dist            Key distribution of the timed run:
+                          uniform  every preloaded key equally likely
+                          zipf     a few keys are hot, see 'skew'
+                          ledger   recently written keys are hot, which is
+                                   how ledger close and sync traffic looks
+                          trace    replay the file given by 'trace'
+                        Default ledger.
+        skew            Zipf exponent. Default 0.99.
+        write_percent   Percent of operations that write a new object.
+                        Default 10.
+        missing_percent Percent of reads for keys that do not exist.
+                        Default 0.
+        batch_writer    1 to send writes through a BatchWriter flushed by
+                        a background thread, as the RocksDB backend does,
+                        0 to call Backend::store directly. Default 1.
+        trace           A file of operations, one per line, either
+                        "r <hex key>" or "w <hex key> [<bytes>]". Keys read
+                        before they are written are preloaded.
+
+    Any other key is passed to the backend, for example cache_mb for
+    RocksDB or batch_read_threads for NuDB.
+*/
+class Benchmark_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+#ifndef NDEBUG
+    static constexpr std::size_t defaultItems = 10000;
+#else
+    static constexpr std::size_t defaultItems = 500000;
+#endif
+
+    // Runs scheduled tasks on a background thread. The DummyScheduler
+    // would run them on the caller, which hides the cost of batching.
+    class BackgroundScheduler : public Scheduler
+    {
+        TaskQueue queue_;
+
+    public:
+        ~BackgroundScheduler()
+        {
+            queue_.stop();
+        }
+
+        void
+        scheduleTask(Task& task) override
+        {
+            queue_.addTask([&task] { task.performScheduledTask(); });
+        }
+
+        void
+        onFetch(FetchReport const&) override
+        {
+        }
+
+        void
+        onBatchWrite(BatchWriteReport const&) override
+        {
+        }
+    };
+
+    // Writes through a BatchWriter into an unbatched backend
+    class BatchedWrites : public BatchWriter::Callback
+    {
+        Backend& backend_;
+        BatchWriter writer_;
+
+    public:
+        BatchedWrites(Backend& backend, Scheduler& scheduler)
+            : backend_(backend), writer_(*this, scheduler)
+        {
+        }
+
+        void
+        store(std::shared_ptr<NodeObject> const& object)
+        {
+            writer_.store(object);
+        }
+
+        void
+        writeBatch(Batch const& batch) override
+        {
+            backend_.storeBatch(batch);
+        }
+    };
+
+    struct Op
+    {
+        bool write;
+        uint256 key;
+        std::size_t size = 0;
+    };
+
+    struct Params
+    {
+        std::string type;
+        std::size_t items;
+        std::size_t ops;
+        std::size_t threads;
+        std::string dist;
+        double skew;
+        int writePercent;
+        int missingPercent;
+        bool batchWriter;
+        std::string trace;
+    };
+
+    // Object shapes roughly follow a live node store: account state inner
+    // nodes and leaves, transaction-with-metadata leaves and headers.
+    static std::shared_ptr<NodeObject>
+    makeObject(
+        uint256 const& key,
+        beast::xor_shift_engine& rng,
+        std::size_t size = 0)
+    {
+        auto const pick = rng() % 100;
+        NodeObjectType type;
+        Blob data;
+
+        if (pick < 5)
+        {
+            type = hotLEDGER;
+            data.resize(size ? size : 122);
+        }
+        else if (pick < 35 && !size)
+        {
+            // Inner node: prefix and sixteen child hashes, some empty, in
+            // the form the NuDB codec compresses specially
+            type = hotACCOUNT_NODE;
+            data.resize(4 + 16 * 32);
+            auto const prefix =
+                static_cast<std::uint32_t>(HashPrefix::innerNode);
+            data[0] = prefix >> 24;
+            data[1] = (prefix >> 16) & 0xff;
+            data[2] = (prefix >> 8) & 0xff;
+            data[3] = prefix & 0xff;
+            for (int branch = 0; branch < 16; ++branch)
+            {
+                if (rng() % 4 == 0)
+                    continue;
+                for (int i = 0; i < 32; ++i)
+                    data[4 + branch * 32 + i] = rng() & 0xff;
+            }
+            return NodeObject::createObject(type, std::move(data), key);
+        }
+        else if (pick < 75)
+        {
+            type = hotACCOUNT_NODE;
+            data.resize(size ? size : 100 + rng() % 300);
+        }
+        else
+        {
+            type = hotTRANSACTION_NODE;
+            data.resize(size ? size : 250 + rng() % 1250);
+        }
+
+        for (auto& b : data)
+            b = rng() & 0xff;
+        return NodeObject::createObject(type, std::move(data), key);
+    }
+
+    static uint256
+    makeKey(std::uint64_t n)
+    {
+        beast::xor_shift_engine rng(n + 1);
+        uint256 key;
+        for (auto& b : key)
+            b = rng() & 0xff;
+        return key;
+    }
+
+    // Draws ranks in [0, n) with probability proportional to 1/(rank+1)^s
+    class Zipf
+    {
+        std::vector<double> cdf_;
+
+    public:
+        Zipf(std::size_t n, double s) : cdf_(n)
+        {
+            double sum = 0;
+            for (std::size_t i = 0; i < n; ++i)
+                cdf_[i] = sum += 1.0 / std::pow(i + 1, s);
+            for (auto& c : cdf_)
+                c /= sum;
+        }
+
+        template <class Engine>
+        std::size_t
+        operator()(Engine& rng) const
+        {
+            auto const u = std::uniform_real_distribution<double>{}(rng);
+            return std::min<std::size_t>(
+                std::lower_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin(),
+                cdf_.size() - 1);
+        }
+    };
+
+    static std::string
+    fmt(double v, int precision = 1)
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(precision) << v;
+        return ss.str();
+    }
+
+    std::string
+    percentiles(std::vector<std::uint64_t>& ns)
+    {
+        if (ns.empty())
+            return "none";
+        std::sort(ns.begin(), ns.end());
+        auto at = [&](double q) {
+            return fmt(
+                ns[std::min<std::size_t>(ns.size() * q, ns.size() - 1)] /
+                1000.0);
+        };
+        return std::to_string(ns.size()) + " ops, p50=" + at(0.5) +
+            "us p99=" + at(0.99) + "us p999=" + at(0.999) + "us";
+    }
+
+    std::vector<Op>
+    loadTrace(std::string const& path, std::vector<Op>& preload)
+    {
+        std::vector<Op> ops;
+        std::ifstream in(path);
+        if (!in)
+        {
+            fail("Unable to open trace " + path);
+            return ops;
+        }
+
+        hash_set<uint256> written;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            std::vector<std::string> fields;
+            boost::split(
+                fields,
+                boost::trim_copy(line),
+                boost::is_any_of(" \t"),
+                boost::token_compress_on);
+            if (fields.size() < 2 || fields[0].empty() || fields[0][0] == '#')
+                continue;
+
+            Op op;
+            op.write = fields[0] == "w";
+            if (!op.key.parseHex(fields[1]))
+                continue;
+            if (op.write)
+            {
+                if (fields.size() > 2)
+                    op.size = std::stoul(fields[2]);
+                written.insert(op.key);
+            }
+            else if (written.insert(op.key).second)
+            {
+                preload.push_back({true, op.key});
+            }
+            ops.push_back(std::move(op));
+        }
+        return ops;
+    }
+
+    void
+    runBenchmark(Section config, Params const& p)
+    {
+        beast::temp_dir tempDir;
+        if (!config.exists("path"))
+            config.set("path", tempDir.path());
+
+        test::SuiteJournal journal("Benchmark_test", *this);
+        BackgroundScheduler scheduler;
+        auto backend = Manager::instance().make_Backend(
+            config, megabytes(4), scheduler, journal);
+        if (!BEAST_EXPECT(backend))
+            return;
+        backend->open();
+
+        // Build the operations up front so the timed loop only does I/O
+        std::vector<Op> preload;
+        std::vector<Op> ops;
+        if (p.dist == "trace")
+        {
+            ops = loadTrace(p.trace, preload);
+        }
+        else
+        {
+            preload.reserve(p.items);
+            for (std::size_t i = 0; i < p.items; ++i)
+                preload.push_back({true, makeKey(i)});
+
+            beast::xor_shift_engine rng(p.items);
+            std::optional<Zipf> zipf;
+            if (p.dist == "zipf")
+                zipf.emplace(p.items, p.skew);
+            std::size_t next = p.items;
+            std::uint64_t missing = 0;
+
+            ops.reserve(p.ops);
+            for (std::size_t i = 0; i < p.ops; ++i)
+            {
+                if (rng() % 100 < p.writePercent)
+                {
+                    ops.push_back({true, makeKey(next++)});
+                    continue;
+                }
+                if (rng() % 100 < p.missingPercent)
+                {
+                    // Stored keys are numbered from 0 up, these never are
+                    ops.push_back(
+                        {false, makeKey((std::uint64_t(1) << 63) | missing++)});
+                    continue;
+                }
+
+                std::size_t index;
+                if (zipf)
+                {
+                    // Scatter the hot ranks across the key space
+                    index = ((*zipf)(rng)*2654435761ull) % p.items;
+                }
+                else if (p.dist == "ledger")
+                {
+                    // Most reads are for objects written recently
+                    auto const age = std::exponential_distribution<double>{
+                        1.0 / std::max<std::size_t>(1, p.items / 100)}(rng);
+                    index = next - 1 - std::min<std::size_t>(age, next - 1);
+                }
+                else
+                {
+                    index = rng() % p.items;
+                }
+                ops.push_back({false, makeKey(index)});
+            }
+        }
+
+        {
+            beast::xor_shift_engine rng(1);
+            Batch batch;
+            batch.reserve(batchWritePreallocationSize);
+            for (auto const& op : preload)
+            {
+                batch.push_back(makeObject(op.key, rng));
+                if (batch.size() == batchWritePreallocationSize)
+                {
+                    backend->storeBatch(batch);
+                    batch.clear();
+                }
+            }
+            if (!batch.empty())
+                backend->storeBatch(batch);
+        }
+
+        std::optional<BatchedWrites> batched;
+        if (p.batchWriter)
+            batched.emplace(*backend, scheduler);
+
+        std::vector<std::vector<std::uint64_t>> reads(p.threads);
+        std::vector<std::vector<std::uint64_t>> writes(p.threads);
+        std::atomic<std::size_t> cursor{0};
+        std::atomic<std::size_t> notFound{0};
+
+        auto const start = clock_type::now();
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < p.threads; ++t)
+        {
+            threads.emplace_back([&, t] {
+                beast::xor_shift_engine rng(t + 1);
+                try
+                {
+                    for (auto i = cursor++; i < ops.size(); i = cursor++)
+                    {
+                        auto const& op = ops[i];
+                        std::shared_ptr<NodeObject> object;
+                        if (op.write)
+                            object = makeObject(op.key, rng, op.size);
+
+                        auto const before = clock_type::now();
+                        if (!op.write)
+                        {
+                            if (backend->fetch(op.key.data(), &object) != ok)
+                                ++notFound;
+                        }
+                        else if (batched)
+                        {
+                            batched->store(object);
+                        }
+                        else
+                        {
+                            backend->store(object);
+                        }
+                        auto const elapsed = std::chrono::duration_cast<
+                            std::chrono::nanoseconds>(
+                            clock_type::now() - before);
+                        (op.write ? writes : reads)[t].push_back(
+                            elapsed.count());
+                    }
+                }
+                catch (std::exception const& e)
+                {
+                    fail(e.what());
+                }
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+
+        // Include the time to drain pending batched writes
+        batched.reset();
+        auto const seconds =
+            std::chrono::duration<double>(clock_type::now() - start).count();
+
+        std::vector<std::uint64_t> allReads;
+        std::vector<std::uint64_t> allWrites;
+        for (std::size_t t = 0; t < p.threads; ++t)
+        {
+            allReads.insert(allReads.end(), reads[t].begin(), reads[t].end());
+            allWrites.insert(
+                allWrites.end(), writes[t].begin(), writes[t].end());
+        }
+
+        log << p.type << " dist=" << p.dist << " threads=" << p.threads
+            << " batch_writer=" << p.batchWriter << ": " << ops.size()
+            << " ops in " << fmt(seconds, 3) << "s, "
+            << fmt(ops.size() / seconds, 0) << " IOPS" << std::endl;
+        log << "  reads:  " << percentiles(allReads) << ", " << notFound
+            << " not found" << std::endl;
+        log << "  writes: " << percentiles(allWrites) << std::endl;
+
+        backend->close();
+    }
+
+public:
+    void
+    run() override
+    {
+        std::string args = arg();
+        if (args.empty())
+        {
+            args = "type=nudb;type=memory";
+#if RIPPLE_ROCKSDB_AVAILABLE
+            args += ";type=rocksdb";
+#endif
+        }
+
+        std::vector<std::string> configs;
+        boost::split(configs, args, boost::is_any_of(";"));
+        for (auto const& c : configs)
+        {
+            if (c.empty())
+                continue;
+
+            std::vector<std::string> lines;
+            boost::split(lines, c, boost::is_any_of(","));
+            Section config;
+            config.append(lines);
+
+            Params p;
+            p.type = get(config, "type", std::string("nudb"));
+            p.items = get<std::size_t>(config, "items", defaultItems);
+            p.ops = get<std::size_t>(config, "ops", p.items);
+            p.threads = std::max<std::size_t>(
+                1, get<std::size_t>(config, "threads", 4));
+            p.dist = get(config, "dist", std::string("ledger"));
+            p.skew = get<double>(config, "skew", 0.99);
+            p.writePercent = get<int>(config, "write_percent", 10);
+            p.missingPercent = get<int>(config, "missing_percent", 0);
+            p.batchWriter = get<int>(config, "batch_writer", 1) != 0;
+            p.trace = get(config, "trace");
+            config.set("type", p.type);
+
+            if (p.dist != "uniform" && p.dist != "zipf" &&
+                p.dist != "ledger" && p.dist != "trace")
+            {
+                fail("Unknown dist=" + p.dist);
+                continue;
+            }
+            if (p.dist == "trace" && p.trace.empty())
+            {
+                fail("dist=trace requires trace=<file>");
+                continue;
+            }
+
+            testcase(c);
+            runBenchmark(config, p);
+            pass();
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(Benchmark, NodeStore, ripple);
+
+}  // namespace NodeStore
+}  // namespace ripple
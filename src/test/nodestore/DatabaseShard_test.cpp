@@ -29,6 +29,7 @@
 #include <ripple/core/ConfigSections.h>
 #include <ripple/nodestore/DatabaseShard.h>
 #include <ripple/nodestore/DummyScheduler.h>
+#include <ripple/nodestore/Manager.h>
 #include <ripple/nodestore/impl/DecodedBlob.h>
 #include <ripple/nodestore/impl/Shard.h>
 #include <ripple/protocol/digest.h>
@@ -1855,6 +1856,78 @@ class DatabaseShard_test : public TestBase
             return;
     }
 
+    void
+    testStoreLedgerObjects(std::uint64_t const seedValue)
+    {
+        testcase("Store ledger objects");
+
+        using namespace test::jtx;
+
+        beast::temp_dir shardDir;
+        beast::temp_dir nodeDir;
+        Env env{*this, testConfig(shardDir.path(), nodeDir.path())};
+        DatabaseShard* db = env.app().getShardStore();
+        Database& ndb = env.app().getNodeStore();
+        if (!BEAST_EXPECT(db))
+            return;
+
+        TestData data(seedValue, 4, 1);
+        if (!BEAST_EXPECT(data.makeLedgers(env)))
+            return;
+
+        // The import copies each ledger with Shard::storeLedger, which
+        // serializes the nodes it walks, and then finalizes the shard
+        db->importDatabase(ndb);
+        if (!BEAST_EXPECT(waitShard(*db, 1)))
+            return;
+
+        // Reading each object from the source again and storing it in a
+        // NuDB backend, as the shard's is, gives the objects the shard
+        // would hold had it been built that way
+        beast::temp_dir refDir;
+        Section params;
+        params.set("type", "nudb");
+        params.set("path", refDir.path());
+        DummyScheduler scheduler;
+        auto ref = Manager::instance().make_Backend(
+            params, megabytes(4), scheduler, journal_);
+        ref->open();
+
+        hash_set<uint256> checked;
+        auto check = [&](uint256 const& hash, std::uint32_t ledgerSeq) {
+            if (!checked.insert(hash).second)
+                return true;
+
+            auto const src = ndb.fetchNodeObject(hash, ledgerSeq);
+            if (!BEAST_EXPECT(src))
+                return false;
+            ref->store(src);
+
+            std::shared_ptr<NodeObject> expected;
+            if (!BEAST_EXPECT(ref->fetch(hash.data(), &expected) == ok))
+                return false;
+
+            auto const stored = db->fetchNodeObject(hash, ledgerSeq);
+            return BEAST_EXPECT(stored && isSame(expected, stored));
+        };
+
+        for (auto const& ledger : data.ledgers_)
+        {
+            auto const seq = ledger->info().seq;
+            if (!check(ledger->info().hash, seq))
+                return;
+
+            auto visit = [&](SHAMapTreeNode& node) {
+                return check(node.getHash().as_uint256(), seq);
+            };
+            ledger->stateMap().snapShot(false)->visitNodes(visit);
+            if (ledger->info().txHash.isNonZero())
+                ledger->txMap().snapShot(false)->visitNodes(visit);
+        }
+
+        ref->close();
+    }
+
 public:
     DatabaseShard_test() : journal_("DatabaseShard_test", *this)
     {
@@ -1885,6 +1958,7 @@ public:
         testOpenShardManagement(seedValue());
         testShardInfo(seedValue());
         testSQLiteDatabase(seedValue());
+        testStoreLedgerObjects(seedValue());
     }
 };
 
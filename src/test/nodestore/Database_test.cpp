@@ -21,11 +21,14 @@
 #include <ripple/core/DatabaseCon.h>
 #include <ripple/nodestore/DummyScheduler.h>
 #include <ripple/nodestore/Manager.h>
+#include <ripple/protocol/digest.h>
 #include <test/jtx.h>
 #include <test/jtx/CheckMessageLogs.h>
 #include <test/jtx/envconfig.h>
 #include <test/nodestore/TestBase.h>
 #include <test/unit_test/SuiteJournal.h>
+#include <atomic>
+#include <thread>
 
 namespace ripple {
 
@@ -447,7 +450,9 @@ public:
     testImport(
         std::string const& destBackendType,
         std::string const& srcBackendType,
-        std::int64_t seedValue)
+        std::int64_t seedValue,
+        int importThreads = 1,
+        bool verify = false)
     {
         DummyScheduler scheduler;
 
@@ -459,10 +464,36 @@ public:
         // Create a batch
         auto batch = createPredictableBatch(numObjectsToTest, seedValue);
 
+        // Key the objects by the hash of their payload, except for one
+        // which the import is expected to skip
+        std::shared_ptr<NodeObject> corrupt;
+        if (verify)
+        {
+            for (auto& obj : batch)
+            {
+                Blob data(obj->getData());
+                auto const hash = sha512Half(makeSlice(data));
+                obj = NodeObject::createObject(
+                    obj->getType(), std::move(data), hash);
+            }
+            corrupt = batch.back();
+        }
+
         // Write to source db
         {
             std::unique_ptr<Database> src = Manager::instance().make_Database(
                 megabytes(4), scheduler, 2, srcParams, journal_);
+            if (corrupt)
+            {
+                batch.pop_back();
+                Blob data(corrupt->getData());
+                data.back() ^= 0xff;
+                src->store(
+                    corrupt->getType(),
+                    std::move(data),
+                    corrupt->getHash(),
+                    src->earliestLedgerSeq());
+            }
             storeBatch(*src, batch);
         }
 
@@ -478,19 +509,25 @@ public:
             Section destParams;
             destParams.set("type", destBackendType);
             destParams.set("path", dest_db.path());
+            destParams.set("import_threads", std::to_string(importThreads));
+            destParams.set("import_verify", verify ? "1" : "0");
 
             std::unique_ptr<Database> dest = Manager::instance().make_Database(
                 megabytes(4), scheduler, 2, destParams, journal_);
 
             testcase(
                 "import into '" + destBackendType + "' from '" +
-                srcBackendType + "'");
+                srcBackendType + "' with " + std::to_string(importThreads) +
+                (importThreads == 1 ? " thread" : " threads") +
+                (verify ? ", verified" : ""));
 
             // Do the import
             dest->importDatabase(*src);
 
             // Get the results of the import
             fetchCopyOfBatch(*dest, &copy, batch);
+            if (corrupt)
+                BEAST_EXPECT(!dest->fetchNodeObject(corrupt->getHash(), 0));
         }
 
         // Canonicalize the source and destination batches
@@ -501,6 +538,47 @@ public:
 
     //--------------------------------------------------------------------------
 
+    void
+    testConcurrentFetch(std::string const& type, std::int64_t seedValue)
+    {
+        testcase("concurrent fetch from '" + type + "'");
+
+        DummyScheduler scheduler;
+        beast::temp_dir node_db;
+        Section nodeParams;
+        nodeParams.set("type", type);
+        nodeParams.set("path", node_db.path());
+
+        auto batch = createPredictableBatch(64, seedValue);
+        std::unique_ptr<Database> db = Manager::instance().make_Database(
+            megabytes(4), scheduler, 2, nodeParams, journal_);
+        storeBatch(*db, batch);
+
+        // Every thread asks for the same objects in the same order, so
+        // that their reads overlap and are shared
+        std::atomic<int> mismatches{0};
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 8; ++i)
+        {
+            threads.emplace_back([&] {
+                for (auto const& obj : batch)
+                {
+                    auto const copy = db->fetchNodeObject(obj->getHash());
+                    if (!copy || !isSame(obj, copy))
+                        ++mismatches;
+                }
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+
+        BEAST_EXPECT(mismatches == 0);
+        BEAST_EXPECT(db->getFetchTotalCount() == 8 * batch.size());
+        BEAST_EXPECT(db->getFetchHitCount() == 8 * batch.size());
+    }
+
+    //--------------------------------------------------------------------------
+
     void
     testNodeStore(
         std::string const& type,
@@ -670,9 +748,13 @@ public:
 #endif
         }
 
+        testConcurrentFetch("nudb", seedValue);
+
         // Import tests
         {
             testImport("nudb", "nudb", seedValue);
+            testImport("nudb", "nudb", seedValue, 4);
+            testImport("nudb", "nudb", seedValue, 4, true);
 
 #if RIPPLE_ROCKSDB_AVAILABLE
             testImport("rocksdb", "rocksdb", seedValue);
@@ -0,0 +1,64 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/impl/IOContextPool.h>
+#include <boost/asio/post.hpp>
+#include <future>
+#include <set>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+class IOContextPool_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        testcase("round robin");
+
+        IOContextPool pool{3};
+        BEAST_EXPECT(pool.size() == 3);
+
+        std::set<boost::asio::io_context*> contexts;
+        for (int i = 0; i < 6; ++i)
+            contexts.insert(&pool.next());
+        BEAST_EXPECT(contexts.size() == 3);
+
+        // Each context runs on a thread of its own
+        std::set<std::thread::id> threads;
+        for (auto const context : contexts)
+        {
+            std::promise<std::thread::id> id;
+            boost::asio::post(*context, [&id] {
+                id.set_value(std::this_thread::get_id());
+            });
+            threads.insert(id.get_future().get());
+        }
+        BEAST_EXPECT(threads.size() == 3);
+        BEAST_EXPECT(threads.count(std::this_thread::get_id()) == 0);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(IOContextPool, overlay, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/impl/LastProposals.h>
+#include <ripple/protocol/SecretKey.h>
+
+namespace ripple {
+namespace test {
+
+class LastProposals_test : public beast::unit_test::suite
+{
+    void
+    testSuperseded()
+    {
+        testcase("superseded");
+
+        TestStopwatch clock;
+        LastProposals last{clock};
+        auto const validator = randomKeyPair(KeyType::secp256k1).first;
+        auto const other = randomKeyPair(KeyType::secp256k1).first;
+        uint256 const ledger{1};
+
+        BEAST_EXPECT(!last.superseded(validator, ledger, 0));
+
+        last.verified(validator, ledger, 3);
+        BEAST_EXPECT(last.superseded(validator, ledger, 2));
+        BEAST_EXPECT(!last.superseded(validator, ledger, 3));
+        BEAST_EXPECT(!last.superseded(validator, ledger, 4));
+        BEAST_EXPECT(!last.superseded(validator, uint256{2}, 2));
+        BEAST_EXPECT(!last.superseded(other, ledger, 2));
+
+        // An older proposal doesn't replace a newer one
+        last.verified(validator, ledger, 1);
+        BEAST_EXPECT(last.superseded(validator, ledger, 2));
+
+        // A proposal on another ledger replaces it whatever its sequence
+        last.verified(validator, uint256{2}, 0);
+        BEAST_EXPECT(!last.superseded(validator, ledger, 2));
+        BEAST_EXPECT(!last.superseded(validator, uint256{2}, 0));
+        BEAST_EXPECT(last.size() == 1);
+    }
+
+    void
+    testSweep()
+    {
+        testcase("sweep");
+
+        using namespace std::chrono_literals;
+        TestStopwatch clock;
+        LastProposals last{clock};
+        auto const stale = randomKeyPair(KeyType::secp256k1).first;
+        auto const active = randomKeyPair(KeyType::secp256k1).first;
+        uint256 const ledger{1};
+
+        last.verified(stale, ledger, 1);
+        last.verified(active, ledger, 1);
+        BEAST_EXPECT(last.size() == 2);
+
+        clock.advance(40s);
+        last.verified(active, ledger, 2);
+        last.sweep(60s);
+        BEAST_EXPECT(last.size() == 2);
+
+        // Only validators that kept proposing are remembered
+        clock.advance(40s);
+        last.sweep(60s);
+        BEAST_EXPECT(last.size() == 1);
+        BEAST_EXPECT(!last.superseded(stale, ledger, 0));
+        BEAST_EXPECT(last.superseded(active, ledger, 1));
+
+        clock.advance(40s);
+        last.sweep(60s);
+        BEAST_EXPECT(last.size() == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testSuperseded();
+        testSweep();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LastProposals, overlay, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/impl/LedgerReplyCache.h>
+#include <test/unit_test/SuiteJournal.h>
+
+namespace ripple {
+namespace test {
+
+class LedgerReplyCache_test : public beast::unit_test::suite
+{
+    void
+    testKeys()
+    {
+        testcase("keys");
+
+        uint256 const map{1};
+        SHAMapNodeID const root;
+        SHAMapNodeID const child = root.getChildNodeID(3);
+
+        auto const key = LedgerReplyCache::nodesKey(map, root, 1, true);
+        BEAST_EXPECT(key == LedgerReplyCache::nodesKey(map, root, 1, true));
+        BEAST_EXPECT(
+            key != LedgerReplyCache::nodesKey(uint256{2}, root, 1, true));
+        BEAST_EXPECT(key != LedgerReplyCache::nodesKey(map, child, 1, true));
+        BEAST_EXPECT(key != LedgerReplyCache::nodesKey(map, root, 2, true));
+        BEAST_EXPECT(key != LedgerReplyCache::nodesKey(map, root, 1, false));
+
+        protocol::TMGetLedger request;
+        request.set_itype(protocol::liAS_NODE);
+        request.add_nodeids(root.getRawString());
+        uint256 const ledger{3};
+        auto const reply = LedgerReplyCache::replyKey(ledger, map, request, 1);
+        BEAST_EXPECT(
+            reply == LedgerReplyCache::replyKey(ledger, map, request, 1));
+        BEAST_EXPECT(
+            reply != LedgerReplyCache::replyKey(ledger, map, request, 2));
+
+        // Ledgers that share a map have replies of their own
+        BEAST_EXPECT(
+            reply != LedgerReplyCache::replyKey(uint256{4}, map, request, 1));
+
+        request.add_nodeids(child.getRawString());
+        BEAST_EXPECT(
+            reply != LedgerReplyCache::replyKey(ledger, map, request, 1));
+    }
+
+    void
+    testFetch()
+    {
+        testcase("fetch");
+
+        test::SuiteJournal journal("LedgerReplyCache_test", *this);
+        LedgerReplyCache cache{megabytes(1), journal};
+        SHAMapNodeID const root;
+        auto const key = LedgerReplyCache::nodesKey(uint256{1}, root, 1, true);
+        BEAST_EXPECT(!cache.fetchNodes(key, 10));
+
+        LedgerReplyCache::Nodes nodes{{root, Blob(100, 0xAB)}};
+        auto const kept = cache.insertNodes(key, 10, std::move(nodes));
+        BEAST_EXPECT(kept && kept->size() == 1);
+
+        auto const found = cache.fetchNodes(key, 10);
+        if (BEAST_EXPECT(found))
+        {
+            BEAST_EXPECT(found == kept);
+            BEAST_EXPECT(found->front().second == Blob(100, 0xAB));
+        }
+
+        // Nodes found twice are shared with the copy kept first
+        LedgerReplyCache::Nodes again{{root, Blob(100, 0xAB)}};
+        BEAST_EXPECT(cache.insertNodes(key, 10, std::move(again)) == kept);
+
+        protocol::TMGetLedger request;
+        request.set_itype(protocol::liAS_NODE);
+        request.add_nodeids(root.getRawString());
+        auto const replyKey =
+            LedgerReplyCache::replyKey(uint256{1}, uint256{1}, request, 1);
+        BEAST_EXPECT(!cache.fetchReply(replyKey, 10));
+
+        uint256 const hash{1};
+        protocol::TMLedgerData data;
+        data.set_ledgerhash(hash.data(), hash.size());
+        data.set_ledgerseq(10);
+        data.set_type(protocol::liAS_NODE);
+        auto const message =
+            std::make_shared<Message>(data, protocol::mtLEDGER_DATA);
+        cache.insertReply(replyKey, 10, message);
+        BEAST_EXPECT(cache.fetchReply(replyKey, 10) == message);
+    }
+
+public:
+    void
+    run() override
+    {
+        testKeys();
+        testFetch();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerReplyCache, overlay, ripple);
+
+}  // namespace test
+}  // namespace ripple
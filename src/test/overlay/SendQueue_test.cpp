@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/impl/SendQueue.h>
+#include <ripple/overlay/impl/TrafficCount.h>
+#include <ripple/overlay/impl/Tuning.h>
+
+namespace ripple {
+namespace test {
+
+class SendQueue_test : public beast::unit_test::suite
+{
+    using Lane = SendQueue::Lane;
+
+    void
+    testLanes()
+    {
+        testcase("lanes");
+
+        using category = TrafficCount::category;
+        BEAST_EXPECT(SendQueue::laneOf(category::proposal) == Lane::consensus);
+        BEAST_EXPECT(
+            SendQueue::laneOf(category::validation) == Lane::consensus);
+        BEAST_EXPECT(
+            SendQueue::laneOf(category::ld_tsc_share) == Lane::consensus);
+        BEAST_EXPECT(
+            SendQueue::laneOf(category::transaction) == Lane::transactions);
+        BEAST_EXPECT(SendQueue::laneOf(category::ld_asn_share) == Lane::bulk);
+        BEAST_EXPECT(
+            SendQueue::laneOf(category::share_fetch_pack) == Lane::bulk);
+        BEAST_EXPECT(SendQueue::laneOf(category::unknown) == Lane::bulk);
+    }
+
+    void
+    testAlone()
+    {
+        testcase("alone");
+
+        // A lane with the connection to itself sends in order, whatever
+        // the size of its messages
+        SendQueue queue;
+        queue.push(Lane::bulk, nullptr, 1000000);
+        queue.push(Lane::bulk, nullptr, 2);
+        BEAST_EXPECT(queue.size() == 2);
+        BEAST_EXPECT(queue.size(Lane::bulk) == 2);
+        BEAST_EXPECT(queue.front().bytes == 1000000);
+        BEAST_EXPECT(queue.pop().bytes == 1000000);
+        BEAST_EXPECT(queue.pop().bytes == 2);
+        BEAST_EXPECT(queue.empty());
+        BEAST_EXPECT(queue.size(Lane::bulk) == 0);
+    }
+
+    void
+    testPriority()
+    {
+        testcase("priority");
+
+        // Consensus messages queued behind a backlog of ledger data wait
+        // for at most one bulk quantum of it
+        SendQueue queue;
+        auto const chunk = Tuning::sendLaneQuantum;
+        for (int i = 0; i < 100; ++i)
+            queue.push(Lane::bulk, nullptr, chunk);
+        BEAST_EXPECT(queue.pop().bytes == chunk);
+
+        for (int i = 0; i < 4; ++i)
+            queue.push(Lane::consensus, nullptr, 100 + i);
+        BEAST_EXPECT(queue.size(Lane::consensus) == 4);
+
+        std::size_t bulk = 0;
+        while (queue.size(Lane::consensus) != 0)
+        {
+            if (queue.pop().bytes == chunk)
+                ++bulk;
+        }
+        BEAST_EXPECT(bulk <= 1);
+        BEAST_EXPECT(queue.size() == 99 - bulk);
+    }
+
+    void
+    testWeights()
+    {
+        testcase("weights");
+
+        // Lanes that all have a backlog share the connection by weight
+        SendQueue queue;
+        auto const chunk = Tuning::sendLaneQuantum;
+        for (int i = 0; i < 1000; ++i)
+        {
+            queue.push(Lane::consensus, nullptr, chunk);
+            queue.push(Lane::transactions, nullptr, chunk);
+            queue.push(Lane::bulk, nullptr, chunk);
+        }
+
+        for (int i = 0; i < 210; ++i)
+            queue.pop();
+        BEAST_EXPECT(queue.size(Lane::consensus) == 1000 - 160);
+        BEAST_EXPECT(queue.size(Lane::transactions) == 1000 - 40);
+        BEAST_EXPECT(queue.size(Lane::bulk) == 1000 - 10);
+    }
+
+public:
+    void
+    run() override
+    {
+        testLanes();
+        testAlone();
+        testPriority();
+        testWeights();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SendQueue, overlay, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/impl/TLSSessionCache.h>
+
+namespace ripple {
+namespace test {
+
+class TLSSessionCache_test : public beast::unit_test::suite
+{
+    using endpoint_type = TLSSessionCache::endpoint_type;
+
+    static endpoint_type
+    endpoint(unsigned short port)
+    {
+        return {boost::asio::ip::make_address("10.0.0.1"), port};
+    }
+
+    void
+    testInsert()
+    {
+        testcase("insert");
+
+        TLSSessionCache cache{4};
+        BEAST_EXPECT(!cache.fetch(endpoint(1)));
+
+        auto const session = SSL_SESSION_new();
+        cache.insert(endpoint(1), session);
+        BEAST_EXPECT(cache.fetch(endpoint(1)).get() == session);
+        BEAST_EXPECT(!cache.fetch(endpoint(2)));
+        BEAST_EXPECT(cache.size() == 1);
+
+        // A new session for the same server replaces the old one
+        auto const replacement = SSL_SESSION_new();
+        cache.insert(endpoint(1), replacement);
+        BEAST_EXPECT(cache.fetch(endpoint(1)).get() == replacement);
+        BEAST_EXPECT(cache.size() == 1);
+
+        // A session fetched stays valid after it leaves the cache
+        auto const held = cache.fetch(endpoint(1));
+        cache.erase(endpoint(1));
+        BEAST_EXPECT(!cache.fetch(endpoint(1)));
+        BEAST_EXPECT(cache.size() == 0);
+        BEAST_EXPECT(SSL_SESSION_get_timeout(held.get()) >= 0);
+
+        cache.insert(endpoint(2), nullptr);
+        BEAST_EXPECT(cache.size() == 0);
+    }
+
+    void
+    testCapacity()
+    {
+        testcase("capacity");
+
+        TLSSessionCache cache{2};
+        cache.insert(endpoint(1), SSL_SESSION_new());
+        cache.insert(endpoint(2), SSL_SESSION_new());
+        cache.insert(endpoint(3), SSL_SESSION_new());
+        BEAST_EXPECT(cache.size() == 2);
+        BEAST_EXPECT(!cache.fetch(endpoint(1)));
+        BEAST_EXPECT(cache.fetch(endpoint(2)));
+        BEAST_EXPECT(cache.fetch(endpoint(3)));
+
+        // Storing a session again makes it the most recent
+        cache.insert(endpoint(2), SSL_SESSION_new());
+        cache.insert(endpoint(4), SSL_SESSION_new());
+        BEAST_EXPECT(cache.fetch(endpoint(2)));
+        BEAST_EXPECT(!cache.fetch(endpoint(3)));
+        BEAST_EXPECT(cache.fetch(endpoint(4)));
+    }
+
+public:
+    void
+    run() override
+    {
+        testInsert();
+        testCapacity();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(TLSSessionCache, overlay, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/overlay/impl/TrafficCapture.h>
+#include <ripple/protocol/messages.h>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace ripple {
+namespace test {
+
+class TrafficCapture_test : public beast::unit_test::suite
+{
+    static protocol::TMPing
+    makePing(std::uint32_t seq)
+    {
+        protocol::TMPing ping;
+        ping.set_type(protocol::TMPing::ptPING);
+        ping.set_seq(seq);
+        return ping;
+    }
+
+    template <class F>
+    void
+    expectThrow(F&& f)
+    {
+        try
+        {
+            f();
+            fail();
+        }
+        catch (std::runtime_error const&)
+        {
+            pass();
+        }
+    }
+
+    void
+    testRoundTrip()
+    {
+        testcase("round trip");
+
+        beast::temp_dir dir;
+        auto const path = dir.file("capture");
+        {
+            TrafficCapture capture{path, 1 << 20};
+            for (std::uint32_t i = 0; i < 10; ++i)
+                capture.record(i % 3, protocol::mtPING, makePing(i));
+        }
+
+        auto const records = TrafficCapture::read(path);
+        if (!BEAST_EXPECT(records.size() == 10))
+            return;
+        for (std::uint32_t i = 0; i < records.size(); ++i)
+        {
+            auto const& r = records[i];
+            BEAST_EXPECT(r.peer == i % 3);
+            BEAST_EXPECT(r.type == protocol::mtPING);
+            if (i > 0)
+                BEAST_EXPECT(r.when >= records[i - 1].when);
+
+            protocol::TMPing ping;
+            BEAST_EXPECT(ping.ParseFromString(r.payload));
+            BEAST_EXPECT(ping.seq() == i);
+        }
+    }
+
+    void
+    testLimit()
+    {
+        testcase("limit");
+
+        beast::temp_dir dir;
+        auto const path = dir.file("capture");
+        std::size_t bytes = 0;
+        {
+            // Room for the magic and a few records only
+            TrafficCapture capture{path, 64};
+            for (std::uint32_t i = 0; i < 10; ++i)
+                capture.record(0, protocol::mtPING, makePing(i));
+            bytes = capture.bytes();
+            BEAST_EXPECT(bytes <= 64);
+        }
+
+        auto const records = TrafficCapture::read(path);
+        BEAST_EXPECT(!records.empty() && records.size() < 10);
+        BEAST_EXPECT(
+            std::ifstream(path, std::ios::binary | std::ios::ate).tellg() ==
+            static_cast<std::streamoff>(bytes));
+    }
+
+    void
+    testCorrupt()
+    {
+        testcase("corrupt");
+
+        beast::temp_dir dir;
+        auto const path = dir.file("capture");
+
+        std::string data;
+        {
+            TrafficCapture capture{path, 1 << 20};
+            capture.record(1, protocol::mtPING, makePing(1));
+        }
+        {
+            std::ifstream in(path, std::ios::binary);
+            data.assign(
+                std::istreambuf_iterator<char>(in),
+                std::istreambuf_iterator<char>());
+        }
+
+        auto const write = [&](std::string const& contents) {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(contents.data(), contents.size());
+        };
+
+        // A record cut short inside its header, then inside its payload
+        write(data.substr(0, sizeof(TrafficCapture::magic) + 4));
+        expectThrow([&] { TrafficCapture::read(path); });
+        write(data.substr(0, data.size() - 1));
+        expectThrow([&] { TrafficCapture::read(path); });
+
+        // A file that is not a capture
+        write("not a capture at all");
+        expectThrow([&] { TrafficCapture::read(path); });
+
+        // A missing file
+        expectThrow([&] { TrafficCapture::read(dir.file("missing")); });
+    }
+
+public:
+    void
+    run() override
+    {
+        testRoundTrip();
+        testLimit();
+        testCorrupt();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(TrafficCapture, overlay, ripple);
+
+}  // namespace test
+}  // namespace ripple
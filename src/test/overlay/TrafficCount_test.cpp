@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/impl/TrafficCount.h>
+
+namespace ripple {
+namespace test {
+
+class TrafficCount_test : public beast::unit_test::suite
+{
+    void
+    testHistogram()
+    {
+        testcase("histogram");
+
+        TrafficCount::Histogram h;
+        BEAST_EXPECT(h.count() == 0);
+        BEAST_EXPECT(h.percentile(50) == 0);
+
+        for (std::uint64_t i = 1; i <= 100; ++i)
+            h.add(i);
+        BEAST_EXPECT(h.count() == 100);
+        BEAST_EXPECT(h.sum() == 5050);
+        BEAST_EXPECT(h.max() == 100);
+
+        // A percentile is the upper bound of its bucket, capped at the max
+        BEAST_EXPECT(h.percentile(1) == 1);
+        BEAST_EXPECT(h.percentile(50) == 63);
+        BEAST_EXPECT(h.percentile(99) == 100);
+        BEAST_EXPECT(h.percentile(100) == 100);
+
+        // Values beyond the last bound land in the last bucket
+        h.add(std::uint64_t{1} << 40);
+        BEAST_EXPECT(h.max() == std::uint64_t{1} << 40);
+        BEAST_EXPECT(h.percentile(100) == std::uint64_t{1} << 40);
+
+        TrafficCount::Histogram const copy{h};
+        BEAST_EXPECT(copy.count() == h.count());
+        BEAST_EXPECT(copy.percentile(50) == h.percentile(50));
+
+        TrafficCount::Histogram zeros;
+        zeros.add(0);
+        zeros.add(0);
+        BEAST_EXPECT(zeros.percentile(100) == 0);
+    }
+
+    void
+    testCategories()
+    {
+        testcase("categories");
+        using namespace std::chrono_literals;
+
+        TrafficCount traffic;
+        traffic.addCount(TrafficCount::proposal, true, 200);
+        traffic.addCount(TrafficCount::proposal, false, 300);
+        traffic.addQueueDelay(TrafficCount::proposal, 1500us);
+        traffic.addHandlerTime(TrafficCount::proposal, 40us);
+
+        // Steady clock readings should not go backwards, but if they do
+        // the sample counts as no time at all
+        traffic.addQueueDelay(TrafficCount::ld_get, -5us);
+
+        auto const& counts = traffic.getCounts();
+        auto const& proposal = counts[TrafficCount::proposal];
+        BEAST_EXPECT(proposal.sizeIn.count() == 1);
+        BEAST_EXPECT(proposal.sizeIn.max() == 200);
+        BEAST_EXPECT(proposal.sizeOut.max() == 300);
+        BEAST_EXPECT(proposal.queueDelay.max() == 1500);
+        BEAST_EXPECT(proposal.handlerTime.max() == 40);
+
+        auto const& ledgerData = counts[TrafficCount::ld_get];
+        BEAST_EXPECT(ledgerData.queueDelay.count() == 1);
+        BEAST_EXPECT(ledgerData.queueDelay.max() == 0);
+        BEAST_EXPECT(counts[TrafficCount::validation].queueDelay.count() == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testHistogram();
+        testCategories();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(TrafficCount, overlay, ripple);
+
+}  // namespace test
+}  // namespace ripple
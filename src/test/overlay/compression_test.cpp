@@ -23,6 +23,7 @@
 #include <ripple/basics/random.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/beast/utility/Journal.h>
+#include <ripple/nodestore/impl/ZstdCodec.h>
 #include <ripple/overlay/Compression.h>
 #include <ripple/overlay/Message.h>
 #include <ripple/overlay/impl/Handshake.h>
@@ -135,6 +136,17 @@ public:
 
         BEAST_EXPECT(
             proto1->ParseFromArray(decompressed.data(), decompressedSize));
+
+        // Received messages are parsed into an arena they keep alive
+        auto const parsed =
+            ripple::detail::parseMessageContent<T>(*header, buffers.data());
+        if (BEAST_EXPECT(parsed))
+        {
+            BEAST_EXPECT(parsed->GetArena() != nullptr);
+            BEAST_EXPECT(
+                parsed->SerializeAsString() == proto1->SerializeAsString());
+        }
+
         auto uncompressed = m.getBuffer(Compressed::Off);
         BEAST_EXPECT(std::equal(
             uncompressed.begin() + ripple::compression::headerBytes,
@@ -462,6 +474,119 @@ public:
             "TMValidatorListCollection");
     }
 
+    std::shared_ptr<protocol::TMProposeSet>
+    buildProposeSet(
+        PublicKey const& validator,
+        std::uint32_t ledgerSeq,
+        std::uint32_t proposeSeq)
+    {
+        auto proposal = std::make_shared<protocol::TMProposeSet>();
+        uint256 const prevLedger(ripple::sha512Half(ledgerSeq));
+        uint256 const txSet(ripple::sha512Half(rand_int<std::uint64_t>()));
+        proposal->set_proposeseq(proposeSeq);
+        proposal->set_currenttxhash(txSet.data(), txSet.size());
+        proposal->set_nodepubkey(validator.data(), validator.size());
+        proposal->set_closetime(ledgerSeq * 4);
+        std::string signature;
+        for (int i = 0; i < 2; ++i)
+        {
+            uint256 const half(ripple::sha512Half(rand_int<std::uint64_t>()));
+            signature.append(
+                reinterpret_cast<char const*>(half.data()), half.size());
+        }
+        proposal->set_signature(signature);
+        proposal->set_previousledger(prevLedger.data(), prevLedger.size());
+        return proposal;
+    }
+
+#if RIPPLE_ZSTD_AVAILABLE
+    void
+    testZstd()
+    {
+        testcase("Zstd dictionary");
+        using namespace compression;
+
+        std::vector<PublicKey> validators;
+        for (int i = 0; i < 20; ++i)
+            validators.push_back(
+                std::get<0>(randomKeyPair(KeyType::secp256k1)));
+
+        // Train a dictionary on proposals from a few ledgers
+        std::vector<Blob> samples;
+        for (std::uint32_t seq = 1; seq <= 50; ++seq)
+        {
+            for (auto const& validator : validators)
+            {
+                auto const proposal = buildProposeSet(validator, seq, 0);
+                std::string const serialized = proposal->SerializeAsString();
+                samples.emplace_back(serialized.begin(), serialized.end());
+            }
+        }
+        auto const dict = NodeStore::ZstdCodec::train(samples, 4096);
+        if (!BEAST_EXPECT(!dict.empty()))
+            return;
+        auto const dictionary = std::make_shared<ZstdDictionary>(dict);
+        BEAST_EXPECT(dictionary->id() != 0);
+
+        setZstdDictionary(dictionary);
+
+        auto const proposal = buildProposeSet(validators.front(), 50, 1);
+        Message m(*proposal, protocol::mtPROPOSE_LEDGER);
+
+        // Too small for lz4, but not with a dictionary
+        BEAST_EXPECT(
+            m.getBuffer(Algorithm::LZ4).size() ==
+            m.getBuffer(Algorithm::None).size());
+        auto const& buffer = m.getBuffer(Algorithm::Zstd);
+        BEAST_EXPECT(buffer.size() < m.getBuffer(Algorithm::None).size());
+
+        boost::system::error_code ec;
+        auto const header = ripple::detail::parseMessageHeader(
+            ec, boost::asio::buffer(buffer), buffer.size());
+        if (!BEAST_EXPECT(header && header->algorithm == Algorithm::Zstd))
+            return;
+
+        std::vector<std::uint8_t> decompressed(header->uncompressed_size);
+        ZeroCopyInputStream stream(boost::asio::buffer(buffer));
+        stream.Skip(header->header_size);
+        auto const decompressedSize = decompress(
+            stream,
+            header->payload_wire_size,
+            decompressed.data(),
+            header->uncompressed_size,
+            header->algorithm);
+        BEAST_EXPECT(decompressedSize == header->uncompressed_size);
+        auto const& uncompressed = m.getBuffer(Algorithm::None);
+        BEAST_EXPECT(std::equal(
+            uncompressed.begin() + headerBytes,
+            uncompressed.end(),
+            decompressed.begin(),
+            decompressed.end()));
+
+        // zstd is negotiated only between peers holding the same dictionary
+        http_request_type request;
+        request.insert(
+            "X-Protocol-Ctl",
+            makeFeaturesRequestHeader(true, false, false, false));
+        BEAST_EXPECT(
+            peerCompressionAlgorithm(request, true) == Algorithm::Zstd);
+        BEAST_EXPECT(
+            peerCompressionAlgorithm(request, false) == Algorithm::None);
+
+        http_response_type response;
+        response.insert(
+            "X-Protocol-Ctl",
+            makeFeaturesResponseHeader(request, true, false, false, false));
+        BEAST_EXPECT(
+            peerCompressionAlgorithm(response, true) == Algorithm::Zstd);
+
+        setZstdDictionary(nullptr);
+        BEAST_EXPECT(peerCompressionAlgorithm(request, true) == Algorithm::LZ4);
+        BEAST_EXPECT(
+            peerCompressionAlgorithm(response, true) == Algorithm::LZ4);
+    }
+#endif
+
     void
     testHandshake()
     {
@@ -533,6 +658,9 @@ public:
     run() override
     {
         testProtocol();
+#if RIPPLE_ZSTD_AVAILABLE
+        testZstd();
+#endif
         testHandshake();
     }
 };
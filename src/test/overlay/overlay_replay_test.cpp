@@ -0,0 +1,237 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/basics/make_SSLContext.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/overlay/impl/OverlayImpl.h>
+#include <ripple/overlay/impl/PeerImp.h>
+#include <ripple/overlay/impl/TrafficCapture.h>
+#include <ripple/peerfinder/impl/SlotImp.h>
+#include <ripple/protocol/jss.h>
+#include <boost/algorithm/string.hpp>
+#include <test/jtx/Env.h>
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <thread>
+
+namespace ripple {
+
+namespace test {
+
+/** Replays captured peer traffic through the overlay, and reports timing.
+
+    Start a server with [overlay] capture_file set to record the messages
+    its peers send, then stop it and run:
+
+        rippled --unittest=overlay_replay \
+            --unittest-arg="file=<path>,speed=<1-20>"
+
+    Every message in the capture is handed to a peer standing in for the
+    one that sent it, at the pace it arrived, sped up by the given factor.
+    Once all the work queued by the messages is done, the queueing delay
+    and handler time of each category of traffic is reported.
+*/
+class overlay_replay_test : public beast::unit_test::suite
+{
+    using socket_type = boost::asio::ip::tcp::socket;
+    using middle_type = boost::beast::tcp_stream;
+    using stream_type = boost::beast::ssl_stream<middle_type>;
+
+    // A peer with no connection, which drops what it is asked to send
+    class PeerTest : public PeerImp
+    {
+    public:
+        PeerTest(
+            Application& app,
+            id_t id,
+            std::shared_ptr<PeerFinder::Slot> const& slot,
+            http_request_type&& request,
+            PublicKey const& publicKey,
+            ProtocolVersion protocol,
+            Resource::Consumer consumer,
+            std::unique_ptr<stream_type>&& stream_ptr,
+            OverlayImpl& overlay)
+            : PeerImp(
+                  app,
+                  id,
+                  slot,
+                  std::move(request),
+                  publicKey,
+                  protocol,
+                  consumer,
+                  std::move(stream_ptr),
+                  overlay)
+        {
+        }
+
+        void
+        run() override
+        {
+        }
+
+        void
+        send(std::shared_ptr<Message> const&) override
+        {
+        }
+    };
+
+    std::shared_ptr<PeerTest>
+    addPeer(jtx::Env& env, Peer::id_t id, std::size_t index)
+    {
+        auto& overlay = dynamic_cast<OverlayImpl&>(env.app().overlay());
+        auto stream_ptr = std::make_unique<stream_type>(
+            socket_type(env.app().getIOService()), *context_);
+        auto const address = [](std::size_t n) {
+            return beast::IP::Address::from_string(
+                "10." + std::to_string((n >> 8) & 0xff) + "." +
+                std::to_string(n & 0xff) + ".1");
+        };
+        beast::IP::Endpoint const local(address(2 * index));
+        beast::IP::Endpoint const remote(address(2 * index + 1), 51235);
+        // Replayed traffic must not be cut off for the load it imposes
+        auto consumer = overlay.resourceManager().newUnlimitedEndpoint(remote);
+        auto slot = overlay.peerFinder().new_inbound_slot(local, remote);
+        auto const peer = std::make_shared<PeerTest>(
+            env.app(),
+            id,
+            slot,
+            http_request_type{},
+            PublicKey(std::get<0>(randomKeyPair(KeyType::ed25519))),
+            ProtocolVersion{2, 2},
+            consumer,
+            std::move(stream_ptr),
+            overlay);
+        overlay.add_active(peer);
+        return peer;
+    }
+
+    // The record as it would have arrived on the wire, uncompressed
+    static std::string
+    frame(TrafficCapture::Record const& r)
+    {
+        auto const size = static_cast<std::uint32_t>(r.payload.size());
+        std::string f;
+        f.reserve(compression::headerBytes + r.payload.size());
+        f.push_back(static_cast<char>((size >> 24) & 0x03));
+        f.push_back(static_cast<char>((size >> 16) & 0xff));
+        f.push_back(static_cast<char>((size >> 8) & 0xff));
+        f.push_back(static_cast<char>(size & 0xff));
+        f.push_back(static_cast<char>((r.type >> 8) & 0xff));
+        f.push_back(static_cast<char>(r.type & 0xff));
+        f += r.payload;
+        return f;
+    }
+
+    void
+    report(Json::Value const& metrics)
+    {
+        log << std::left << std::setw(34) << "category" << std::right
+            << std::setw(10) << "messages" << std::setw(10) << "queue p50"
+            << std::setw(10) << "queue p99" << std::setw(12) << "handler p50"
+            << std::setw(12) << "handler p99" << std::endl;
+        for (auto it = metrics.begin(); it != metrics.end(); ++it)
+        {
+            auto const& m = *it;
+            if (m[jss::size_in][jss::count].asString() == "0")
+                continue;
+            log << std::left << std::setw(34) << it.key().asString()
+                << std::right << std::setw(10)
+                << m[jss::size_in][jss::count].asString() << std::setw(10)
+                << m[jss::queue_us][jss::p50].asString() << std::setw(10)
+                << m[jss::queue_us][jss::p99].asString() << std::setw(12)
+                << m[jss::handler_us][jss::p50].asString() << std::setw(12)
+                << m[jss::handler_us][jss::p99].asString() << std::endl;
+        }
+        log << "Times are in microseconds." << std::endl;
+    }
+
+    std::shared_ptr<boost::asio::ssl::context> context_;
+
+public:
+    overlay_replay_test() : context_(make_SSLContext(""))
+    {
+    }
+
+    void
+    run() override
+    {
+        std::vector<std::string> lines;
+        boost::split(lines, arg(), boost::is_any_of(","));
+        Section args;
+        args.append(lines);
+
+        auto const file = get(args, "file", std::string{});
+        auto const speed = std::clamp(get<int>(args, "speed", 1), 1, 20);
+        if (file.empty())
+        {
+            log << "Usage: --unittest-arg=\"file=<path>,speed=<1-20>\""
+                << std::endl;
+            return;
+        }
+
+        testcase("replay " + file + " at " + std::to_string(speed) + "x");
+
+        auto const records = TrafficCapture::read(file);
+        log << records.size() << " messages" << std::endl;
+
+        jtx::Env env(*this);
+        std::map<std::uint32_t, std::shared_ptr<PeerTest>> peers;
+        for (auto const& r : records)
+        {
+            if (!peers.count(r.peer))
+                peers.emplace(r.peer, addPeer(env, r.peer, peers.size()));
+        }
+
+        using namespace std::chrono;
+        auto const start = steady_clock::now();
+        std::size_t failed = 0;
+        for (auto const& r : records)
+        {
+            std::this_thread::sleep_until(start + r.when / speed);
+
+            auto const f = frame(r);
+            std::size_t hint = 0;
+            auto const [used, ec] = invokeProtocolMessage(
+                boost::asio::buffer(f), *peers[r.peer], hint);
+            if (ec || used != f.size())
+                ++failed;
+        }
+        auto const sent = steady_clock::now() - start;
+
+        // Wait for the work the messages queued to finish
+        env.app().getJobQueue().rendezvous();
+        auto const done = steady_clock::now() - start;
+
+        log << "Replayed in " << duration_cast<milliseconds>(sent).count()
+            << "ms, drained in " << duration_cast<milliseconds>(done).count()
+            << "ms, " << failed << " messages not handled" << std::endl;
+        report(env.app().overlay().trafficMetrics());
+
+        BEAST_EXPECT(failed == 0);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(overlay_replay, overlay, ripple);
+
+}  // namespace test
+
+}  // namespace ripple
@@ -1317,6 +1317,18 @@ vp_squelch=1
             c.loadFromString(toLoad);
             BEAST_EXPECT(c.VP_REDUCE_RELAY_ENABLE == true);
             BEAST_EXPECT(c.VP_REDUCE_RELAY_SQUELCH == true);
+            BEAST_EXPECT(c.VP_REDUCE_RELAY_SELECT_FASTEST == false);
+
+            Config cf;
+
+            toLoad = (R"rippleConfig(
+[reduce_relay]
+vp_enable=1
+vp_select_fastest=1
+)rippleConfig");
+
+            cf.loadFromString(toLoad);
+            BEAST_EXPECT(cf.VP_REDUCE_RELAY_SELECT_FASTEST == true);
 
             Config c1;
 
@@ -1406,6 +1418,73 @@ vp_squelched=1
         mutable int maxDuration_;
     };
 
+    void
+    testSelectFastest(bool l)
+    {
+        doTest("Select Fastest", l, [&](bool l) {
+            PublicKey validator = std::get<0>(randomKeyPair(KeyType::ed25519));
+
+            struct Recorder : public reduce_relay::SquelchHandler
+            {
+                void
+                squelch(PublicKey const&, Peer::id_t id, std::uint32_t)
+                    const override
+                {
+                    squelched_.insert(id);
+                }
+                void
+                unsquelch(PublicKey const&, Peer::id_t id) const override
+                {
+                    squelched_.erase(id);
+                }
+                mutable std::set<Peer::id_t> squelched_;
+            };
+            Recorder handler;
+
+            int constexpr npeers = 10;
+            reduce_relay::Slots<ManualClock> slots(
+                env_.app().logs(), handler, true);
+            // Every message arrives from the peers in the same order,
+            // each peer a millisecond behind the previous one.
+            for (int m = 1; m <= reduce_relay::MAX_MESSAGE_THRESHOLD + 2; m++)
+            {
+                uint256 const message{std::uint64_t(2000000 + m)};
+                for (int peer = 0; peer < npeers; peer++)
+                {
+                    slots.updateSlotAndSquelch(
+                        message,
+                        validator,
+                        peer,
+                        protocol::MessageType::mtVALIDATION);
+                    ManualClock::advance(milliseconds(1));
+                }
+            }
+
+            auto const selected = slots.getSelected(validator);
+            BEAST_EXPECT(
+                selected.size() == reduce_relay::MAX_SELECTED_PEERS);
+            for (Peer::id_t id = 0; id < npeers; ++id)
+            {
+                bool const fast = id < reduce_relay::MAX_SELECTED_PEERS;
+                BEAST_EXPECT(selected.count(id) == (fast ? 1 : 0));
+                BEAST_EXPECT(handler.squelched_.count(id) == (fast ? 0 : 1));
+            }
+
+            auto const json = slots.getJson();
+            BEAST_EXPECT(json[jss::policy] == "fastest");
+            auto const& peers = json[jss::validators][toBase58(
+                TokenType::NodePublic, validator)][jss::peers];
+            BEAST_EXPECT(peers["0"][jss::state] == "selected");
+            BEAST_EXPECT(peers["9"][jss::state] == "squelched");
+            BEAST_EXPECT(
+                std::stoll(peers["0"][jss::delay_us].asString()) <
+                std::stoll(peers["9"][jss::delay_us].asString()));
+
+            // make Slot's internal hash router expire all messages
+            ManualClock::advance(hours(1));
+        });
+    }
+
     void
     testRandomSquelch(bool l)
     {
@@ -1572,6 +1651,7 @@ public:
         testSelectedPeerStopsRelaying(log);
         testInternalHashRouter(log);
         testRandomSquelch(log);
+        testSelectFastest(log);
         testHandshake(log);
     }
 };
@@ -274,11 +274,78 @@ public:
 )rippleConfig");
     }
 
+    void
+    test_handouts()
+    {
+        testcase("handouts");
+        TestStore store;
+        TestChecker checker;
+        TestStopwatch clock;
+        Logic<TestChecker> logic(clock, store, checker, journal_);
+        {
+            Config c;
+            c.autoConnect = false;
+            c.wantIncoming = false;
+            c.listeningPort = 1024;
+            logic.config(c);
+        }
+
+        for (auto const& addr : {"65.0.0.1:5", "65.0.0.2:5"})
+        {
+            auto const slot =
+                logic.new_outbound_slot(beast::IP::Endpoint::from_string(addr));
+            BEAST_EXPECT(logic.onConnected(
+                slot, beast::IP::Endpoint::from_string("65.0.0.9:5")));
+            PublicKey const pk(randomKeyPair(KeyType::secp256k1).first);
+            BEAST_EXPECT(
+                logic.activate(slot, pk, false) == PeerFinder::Result::success);
+        }
+
+        auto const addLive = [&logic](char const* addr) {
+            logic.livecache_.insert(
+                Endpoint{beast::IP::Endpoint::from_string(addr), 1});
+        };
+        auto const broadcast = [&]() {
+            clock.advance(Tuning::secondsPerMessage);
+            return logic.buildEndpointsForPeers();
+        };
+
+        addLive("66.0.0.1:5");
+        addLive("66.0.0.2:5");
+        addLive("66.0.0.3:5");
+
+        // Every peer gets the whole livecache
+        auto result = broadcast();
+        BEAST_EXPECT(result.size() == 2);
+        for (auto const& e : result)
+            BEAST_EXPECT(e.second.size() == 3);
+
+        // Nothing changed, so nobody is sent anything
+        BEAST_EXPECT(broadcast().empty());
+
+        // A refresh at the same hops is not a change
+        addLive("66.0.0.1:5");
+        BEAST_EXPECT(broadcast().empty());
+
+        // Only the new entry is handed out
+        addLive("66.0.0.4:5");
+        result = broadcast();
+        BEAST_EXPECT(result.size() == 2);
+        for (auto const& e : result)
+        {
+            BEAST_EXPECT(e.second.size() == 1);
+            BEAST_EXPECT(
+                e.second.front().address ==
+                beast::IP::Endpoint::from_string("66.0.0.4:5"));
+        }
+    }
+
     void
     run() override
     {
         test_backoff1();
         test_backoff2();
+        test_handouts();
         test_config();
         test_invalid_config();
     }
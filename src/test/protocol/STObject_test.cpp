@@ -704,6 +704,95 @@ testMalformed()
     }
 }
 
+void
+testHash()
+{
+    testcase("hash");
+
+    STObject obj(sfGeneric);
+    obj.setFieldU32(sfSequence, 7);
+    obj.setFieldVL(sfTxnSignature, Blob(100, 0xab));
+    obj.setFieldVL(sfMemoData, Blob(1000, 0xcd));
+
+    auto const expected = [&obj]() {
+        Serializer s;
+        s.add32(HashPrefix::transactionID);
+        obj.add(s);
+        return s.getSHA512Half();
+    }();
+    auto const signingHash = obj.getSigningHash(HashPrefix::txSign);
+    BEAST_EXPECT(signingHash != obj.getHash(HashPrefix::txSign));
+
+    // Hashing uses a scratch buffer; one made while it is in use gets
+    // a buffer of its own
+    {
+        ScratchSerializer outer;
+        outer->add32(1);
+        BEAST_EXPECT(obj.getHash(HashPrefix::transactionID) == expected);
+        BEAST_EXPECT(obj.getSigningHash(HashPrefix::txSign) == signingHash);
+        BEAST_EXPECT(outer->size() == 4);
+    }
+
+    // The scratch buffer starts out empty each time
+    BEAST_EXPECT(obj.getHash(HashPrefix::transactionID) == expected);
+    {
+        ScratchSerializer s;
+        BEAST_EXPECT(s->size() == 0);
+    }
+}
+
+void
+testCopyOnWrite()
+{
+    testcase("copy on write");
+
+    STObject source(sfGeneric);
+    source.setFieldU32(sfSequence, 7);
+    source.setFieldV256(
+        sfIndexes, STVector256(std::vector<uint256>{uint256{1}, uint256{2}}));
+    {
+        STArray memos(sfMemos);
+        STObject memo(sfMemo);
+        memo.setFieldVL(sfMemoData, Blob(100, 0xab));
+        memos.push_back(std::move(memo));
+        source.setFieldArray(sfMemos, std::move(memos));
+    }
+
+    Serializer s;
+    source.add(s);
+    SerialIter sit(s.slice());
+    STObject const base(sit, sfGeneric);
+
+    // A copy shares the containers of the object it was made from
+    STObject copy(base);
+    BEAST_EXPECT(
+        &copy.getFieldV256(sfIndexes) == &base.getFieldV256(sfIndexes));
+    BEAST_EXPECT(&copy.getFieldArray(sfMemos) == &base.getFieldArray(sfMemos));
+
+    // Changing a field copies only that one
+    copy.peekFieldArray(sfMemos).emplace_back(sfMemo);
+    BEAST_EXPECT(copy.getFieldArray(sfMemos).size() == 2);
+    BEAST_EXPECT(base.getFieldArray(sfMemos).size() == 1);
+    BEAST_EXPECT(
+        &copy.getFieldV256(sfIndexes) == &base.getFieldV256(sfIndexes));
+    copy.setFieldU32(sfSequence, 8);
+    BEAST_EXPECT(base.getFieldU32(sfSequence) == 7);
+    BEAST_EXPECT(copy != base);
+
+    // Nor is a field shared once it may be changed through a reference
+    auto& indexes = copy.getField(sfIndexes).downcast<STVector256>();
+    STObject const later(copy);
+    indexes.push_back(uint256{3});
+    BEAST_EXPECT(later.getFieldV256(sfIndexes).size() == 2);
+    BEAST_EXPECT(copy.getFieldV256(sfIndexes).size() == 3);
+    BEAST_EXPECT(base.getFieldV256(sfIndexes).size() == 2);
+
+    // Moving keeps the sharing
+    STObject moved(std::move(copy));
+    BEAST_EXPECT(moved.getFieldV256(sfIndexes).size() == 3);
+    BEAST_EXPECT(base == STObject(base));
+}
+
 void
 run() override
 {
@@ -716,6 +805,8 @@ run() override
     testParseJSONArrayWithInvalidChildrenObjects();
     testParseJSONEdgeCases();
     testMalformed();
+    testHash();
+    testCopyOnWrite();
 }
 }
 ;
@@ -199,6 +199,14 @@ public:
             BEAST_EXPECT(val->isFieldPresent(sfFlags));
             BEAST_EXPECT(val->isFieldPresent(sfLedgerHash));
             BEAST_EXPECT(val->isFieldPresent(sfSignature));
+
+            BEAST_EXPECT(
+                val->getLedgerHash() == val->getFieldH256(sfLedgerHash));
+            BEAST_EXPECT(
+                val->getLedgerSeq() == val->getFieldU32(sfLedgerSequence));
+            BEAST_EXPECT(
+                val->getSignTime().time_since_epoch().count() ==
+                val->getFieldU32(sfSigningTime));
         }
         catch (std::exception const& ex)
         {
@@ -346,10 +354,51 @@ public:
         }
     }
 
+    void
+    testPeekSignerPublic()
+    {
+        testcase("Peek Signer Public Key");
+
+        auto const peek = [](auto const& payload) {
+            return STValidation::peekSignerPublic(
+                Slice{payload, sizeof(payload)});
+        };
+
+        {
+            SerialIter sit{payload8};
+            STValidation val(
+                sit, [](PublicKey const& pk) { return calcNodeID(pk); }, false);
+            BEAST_EXPECT(peek(payload8) == val.getSignerPublic());
+        }
+
+        // A missing or invalid key is not found
+        BEAST_EXPECT(!peek(payload1));
+        BEAST_EXPECT(!peek(payload2));
+        BEAST_EXPECT(!STValidation::peekSignerPublic(Slice{}));
+
+        // Every kind of field that can precede the key is skipped
+        auto const [pk, sk] = randomKeyPair(KeyType::secp256k1);
+        STValidation val(
+            NetClock::time_point{}, pk, sk, calcNodeID(pk), [](auto& v) {
+                v.setFieldH256(sfLedgerHash, uint256{1});
+                v.setFieldU32(sfLedgerSequence, 10);
+                v.setFieldU32(sfLoadFee, 256);
+                v.setFieldU64(sfBaseFee, 10);
+                v.setFieldAmount(sfBaseFeeDrops, XRPAmount{10});
+                v.setFieldU64(sfCookie, 5);
+                v.setFieldV256(
+                    sfAmendments,
+                    STVector256(std::vector<uint256>{uint256{2}}));
+            });
+        auto const data = val.getSerialized();
+        BEAST_EXPECT(STValidation::peekSignerPublic(makeSlice(data)) == pk);
+    }
+
     void
     run() override
     {
         testDeserialization();
+        testPeekSignerPublic();
     }
 };
 
@@ -110,6 +110,8 @@ public:
     {
         testcase("secp256k1: digest signing & verification");
 
+        std::optional<PublicKey> otherPk;
+
         for (std::size_t i = 0; i < 32; i++)
         {
             auto const [pk, sk] = randomKeyPair(KeyType::secp256k1);
@@ -127,6 +129,10 @@ public:
                 BEAST_EXPECT(sig.size() != 0);
                 BEAST_EXPECT(verifyDigest(pk, digest, sig, true));
 
+                // Wrong key, though one that was used before:
+                if (otherPk)
+                    BEAST_EXPECT(!verifyDigest(*otherPk, digest, sig, true));
+
                 // Wrong digest:
                 BEAST_EXPECT(!verifyDigest(pk, ~digest, sig, true));
 
@@ -140,6 +146,8 @@ public:
                 // Wrong digest and signature:
                 BEAST_EXPECT(!verifyDigest(pk, ~digest, sig, true));
             }
+
+            otherPk = pk;
         }
     }
 
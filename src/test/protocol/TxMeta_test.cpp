@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/TxMeta.h>
+#include <ripple/protocol/st.h>
+
+namespace ripple {
+
+class TxMeta_test : public beast::unit_test::suite
+{
+    static TxMeta
+    makeMeta(uint256 const& txID)
+    {
+        TxMeta meta(txID, 5);
+        meta.setAffectedNode(uint256{2}, sfModifiedNode, ltACCOUNT_ROOT);
+        meta.setAffectedNode(uint256{1}, sfCreatedNode, ltOFFER);
+        meta.setDeliveredAmount(STAmount(1000));
+        return meta;
+    }
+
+    void
+    testAddRaw()
+    {
+        testcase("addRaw");
+
+        uint256 const txID{7};
+        auto meta = makeMeta(txID);
+
+        Serializer s;
+        meta.addRaw(s, tesSUCCESS, 3);
+
+        // The nodes are still there, sorted, after being serialized
+        BEAST_EXPECT(meta.getNodes().size() == 2);
+        BEAST_EXPECT(
+            meta.getNodes()[0].getFieldH256(sfLedgerIndex) == uint256{1});
+
+        TxMeta const parsed(txID, 5, s.peekData());
+        BEAST_EXPECT(parsed.getResultTER() == tesSUCCESS);
+        BEAST_EXPECT(parsed.getIndex() == 3);
+        BEAST_EXPECT(parsed.getNodes().size() == 2);
+        BEAST_EXPECT(
+            parsed.hasDeliveredAmount() &&
+            parsed.getDeliveredAmount() == STAmount(1000));
+        BEAST_EXPECT(
+            parsed.getJson(JsonOptions::none) ==
+            meta.getJson(JsonOptions::none));
+        BEAST_EXPECT(
+            parsed.getJson(JsonOptions::none) ==
+            parsed.getAsObject().getJson(JsonOptions::none));
+
+        // So serializing again gives the same bytes
+        Serializer again;
+        meta.addRaw(again, tesSUCCESS, 3);
+        BEAST_EXPECT(again.peekData() == s.peekData());
+    }
+
+    void
+    testAddRawThrows()
+    {
+        testcase("addRaw throws");
+
+        auto meta = makeMeta(uint256{7});
+
+        // A node without a ledger index can't be sorted
+        meta.getNodes().push_back(STObject(sfModifiedNode));
+
+        Serializer s;
+        s.add32(42);
+        try
+        {
+            meta.addRaw(s, tesSUCCESS, 3);
+            fail("no ledger index");
+        }
+        catch (std::exception const&)
+        {
+            pass();
+        }
+
+        // Nothing is written, and no node is lost
+        BEAST_EXPECT(s.size() == 4);
+        BEAST_EXPECT(meta.getNodes().size() == 3);
+    }
+
+public:
+    void
+    run() override
+    {
+        testAddRaw();
+        testAddRawThrows();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(TxMeta, protocol, ripple);
+
+}  // namespace ripple
@@ -0,0 +1,95 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Slice.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/protocol/digest.h>
+#include <vector>
+
+namespace ripple {
+
+class digest_test : public beast::unit_test::suite
+{
+    // Hashes count messages of random lengths below maxSize both ways
+    void
+    check(std::size_t count, std::size_t maxSize, std::uint64_t seed)
+    {
+        beast::xor_shift_engine eng(seed);
+
+        std::vector<std::vector<std::uint8_t>> buffers(count);
+        std::vector<Slice> messages;
+        messages.reserve(count);
+
+        for (auto& b : buffers)
+        {
+            b.resize(eng() % maxSize);
+            for (auto& c : b)
+                c = static_cast<std::uint8_t>(eng());
+            messages.emplace_back(b.data(), b.size());
+        }
+
+        std::vector<uint256> digests(count);
+        sha512HalfBatch(messages, digests);
+
+        bool match = true;
+        for (std::size_t i = 0; i != count; ++i)
+            match = match && (digests[i] == sha512Half(messages[i]));
+        BEAST_EXPECTS(match, std::to_string(count) + " messages");
+    }
+
+    void
+    testBatch()
+    {
+        testcase("sha512HalfBatch");
+
+        // Every lane count, including a partial final group
+        for (std::size_t count = 0; count <= 20; ++count)
+            check(count, 600, count);
+
+        // Message lengths around the 128 byte block boundaries, where the
+        // padding spills over into an extra block
+        for (std::size_t size = 0; size <= 300; ++size)
+        {
+            std::vector<std::uint8_t> b(size, 0xa5);
+            std::vector<Slice> messages(9, Slice(b.data(), b.size()));
+            std::vector<uint256> digests(messages.size());
+            sha512HalfBatch(messages, digests);
+
+            bool match = true;
+            for (auto const& d : digests)
+                match = match && (d == sha512Half(messages.front()));
+            BEAST_EXPECTS(match, std::to_string(size) + " bytes");
+        }
+
+        // A large batch of inner node sized messages
+        check(1000, 517, 42);
+    }
+
+public:
+    void
+    run() override
+    {
+        testBatch();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(digest, protocol, ripple);
+
+}  // namespace ripple
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/protocol/tokens.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+class tokens_test : public beast::unit_test::suite
+{
+    static constexpr char const* alphabet =
+        "rpshnaf39wBUDNEGHJKLM4PQRST7VWXYZ2bcdeCg65jkm8oFqi1tuvAxyz";
+
+    // The classic digit at a time encoding, to check the fast one against
+    static std::string
+    referenceEncode(TokenType type, std::string const& token)
+    {
+        std::vector<unsigned char> data;
+        data.push_back(static_cast<unsigned char>(type));
+        data.insert(data.end(), token.begin(), token.end());
+        auto const sha256 = [](void const* p, std::size_t n) {
+            sha256_hasher h;
+            h(p, n);
+            return static_cast<sha256_hasher::result_type>(h);
+        };
+        auto const h = sha256(data.data(), data.size());
+        auto const check = sha256(h.data(), h.size());
+        data.insert(data.end(), check.begin(), check.begin() + 4);
+
+        std::size_t zeroes = 0;
+        while (zeroes != data.size() && data[zeroes] == 0)
+            ++zeroes;
+
+        std::vector<unsigned char> b58(data.size() * 138 / 100 + 1);
+        for (auto i = zeroes; i != data.size(); ++i)
+        {
+            int carry = data[i];
+            for (auto it = b58.rbegin(); it != b58.rend(); ++it)
+            {
+                carry += 256 * *it;
+                *it = carry % 58;
+                carry /= 58;
+            }
+        }
+
+        auto it = b58.begin();
+        while (it != b58.end() && *it == 0)
+            ++it;
+
+        std::string result(zeroes, alphabet[0]);
+        while (it != b58.end())
+            result += alphabet[*it++];
+        return result;
+    }
+
+    void
+    check(TokenType type, std::string const& token)
+    {
+        auto const encoded =
+            encodeBase58Token(type, token.data(), token.size());
+        BEAST_EXPECT(encoded == referenceEncode(type, token));
+        BEAST_EXPECT(decodeBase58Token(encoded, type) == token);
+    }
+
+    void
+    testRoundTrip()
+    {
+        testcase("round trip");
+
+        for (std::size_t size : {0, 1, 3, 4, 5, 16, 20, 32, 33, 40})
+        {
+            check(TokenType::None, std::string(size, '\0'));
+            check(TokenType::AccountID, std::string(size, '\xff'));
+
+            for (int i = 0; i != 100; ++i)
+            {
+                std::string token(size, '\0');
+                for (auto& c : token)
+                    c = rand_int<int>(0, 255);
+
+                // Leading zeroes are encoded apart from the rest
+                if (size > 2 && i % 4 == 0)
+                    std::memset(token.data(), 0, rand_int<int>(1, 2));
+
+                check(TokenType::None, token);
+                check(TokenType::AccountID, token);
+                check(TokenType::NodePublic, token);
+            }
+        }
+    }
+
+    void
+    testDecodeErrors()
+    {
+        testcase("decode errors");
+
+        std::string const token(20, 'a');
+        auto const encoded =
+            encodeBase58Token(TokenType::AccountID, token.data(), 20);
+
+        // Wrong type
+        BEAST_EXPECT(decodeBase58Token(encoded, TokenType::NodePublic).empty());
+
+        // Characters outside the alphabet
+        for (auto const c : {'0', 'I', 'O', 'l', '\0'})
+        {
+            auto bad = encoded;
+            bad[bad.size() / 2] = c;
+            BEAST_EXPECT(decodeBase58Token(bad, TokenType::AccountID).empty());
+        }
+
+        // Bad checksum
+        {
+            auto bad = encoded;
+            bad.back() = bad.back() == 'r' ? 'p' : 'r';
+            BEAST_EXPECT(decodeBase58Token(bad, TokenType::AccountID).empty());
+        }
+
+        // Too long, and too short
+        BEAST_EXPECT(decodeBase58Token(
+                         std::string(65, alphabet[1]), TokenType::AccountID)
+                         .empty());
+        BEAST_EXPECT(decodeBase58Token("", TokenType::AccountID).empty());
+        BEAST_EXPECT(decodeBase58Token("rrrrrr", TokenType::None).empty());
+    }
+
+public:
+    void
+    run() override
+    {
+        testRoundTrip();
+        testDecodeErrors();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(tokens, protocol, ripple);
+
+}  // namespace ripple
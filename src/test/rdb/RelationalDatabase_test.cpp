@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/misc/LoadFeeTrack.h>
+#include <ripple/app/misc/Transaction.h>
+#include <ripple/app/rdb/backend/SQLiteDatabase.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/core/ConfigSections.h>
+#include <ripple/nodestore/DatabaseShard.h>
+#include <test/jtx.h>
+#include <chrono>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+class RelationalDatabase_test : public beast::unit_test::suite
+{
+    static constexpr std::uint32_t ledgersPerShard = 256;
+    static constexpr std::uint32_t shardCount = 2;
+
+    // The ledgers held by the shards
+    static constexpr std::uint32_t firstSeq = ledgersPerShard + 1;
+    static constexpr std::uint32_t lastSeq =
+        firstSeq + shardCount * ledgersPerShard - 1;
+
+    std::unique_ptr<Config>
+    makeConfig(std::string const& shardDir, std::string const& nodeDir)
+    {
+        return jtx::envconfig([&](std::unique_ptr<Config> cfg) {
+            for (auto const& [section, path] :
+                 {std::pair{ConfigSection::shardDatabase(), shardDir},
+                  std::pair{ConfigSection::nodeDatabase(), nodeDir}})
+            {
+                cfg->overwrite(section, "path", path);
+                cfg->overwrite(
+                    section,
+                    "ledgers_per_shard",
+                    std::to_string(ledgersPerShard));
+                cfg->overwrite(
+                    section, "earliest_seq", std::to_string(firstSeq));
+            }
+            return cfg;
+        });
+    }
+
+    bool
+    waitShard(NodeStore::DatabaseShard& shardStore, std::uint32_t shardIndex)
+    {
+        using namespace std::chrono_literals;
+
+        auto const end = std::chrono::steady_clock::now() + 60s;
+        while (shardStore.getNumTasks() ||
+               !boost::icl::contains(
+                   shardStore.getShardInfo()->finalized(), shardIndex))
+        {
+            if (std::chrono::steady_clock::now() > end)
+                return false;
+            std::this_thread::sleep_for(100ms);
+        }
+        return true;
+    }
+
+    void
+    testShardQueries()
+    {
+        testcase("Queries across shards");
+
+        using namespace jtx;
+
+        beast::temp_dir shardDir;
+        beast::temp_dir nodeDir;
+        Env env{*this, makeConfig(shardDir.path(), nodeDir.path())};
+
+        auto const shardStore = env.app().getShardStore();
+        auto const rdb =
+            dynamic_cast<SQLiteDatabase*>(&env.app().getRelationalDatabase());
+        if (!BEAST_EXPECT(shardStore && rdb))
+            return;
+
+        // One payment in every ledger, so that each shard holds some of
+        // alice's transactions
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        env.fund(XRP(100000), alice, bob);
+        env.close();
+
+        while (env.closed()->info().seq < lastSeq)
+        {
+            while (env.app().getFeeTrack().lowerLocalFee())
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            env(pay(alice, bob, XRP(1)));
+            env.close();
+        }
+        BEAST_EXPECT(env.closed()->info().seq == lastSeq);
+
+        shardStore->importDatabase(env.app().getNodeStore());
+        for (std::uint32_t shardIndex = 1; shardIndex <= shardCount;
+             ++shardIndex)
+        {
+            if (!BEAST_EXPECT(waitShard(*shardStore, shardIndex)))
+                return;
+        }
+
+        // Leave only the shards to answer
+        rdb->closeLedgerDB();
+        rdb->closeTransactionDB();
+
+        std::size_t const txCount = lastSeq - firstSeq + 1;
+
+        // These are read from each shard's transaction database, which
+        // holds the tables that the shard's ledger database lacks
+        BEAST_EXPECT(rdb->getTransactionCount() == txCount);
+        BEAST_EXPECT(rdb->getAccountTransactionCount() == 2 * txCount);
+        BEAST_EXPECT(rdb->getTransactionsMinLedgerSeq() == firstSeq);
+        BEAST_EXPECT(rdb->getAccountTransactionsMinLedgerSeq() == firstSeq);
+
+        // Oldest first pages over both shards end in the last one, at
+        // maxLedger
+        {
+            RelationalDatabase::AccountTxPageOptions const options{
+                alice.id(), firstSeq, lastSeq, std::nullopt, 10000, true};
+
+            auto const txs = rdb->oldestAccountTxPage(options).first;
+            if (BEAST_EXPECT(txs.size() == txCount))
+            {
+                BEAST_EXPECT(txs.front().first->getLedger() == firstSeq);
+                BEAST_EXPECT(txs.back().first->getLedger() == lastSeq);
+            }
+
+            auto const blobs = rdb->oldestAccountTxPageB(options).first;
+            if (BEAST_EXPECT(blobs.size() == txCount))
+            {
+                BEAST_EXPECT(std::get<2>(blobs.front()) == firstSeq);
+                BEAST_EXPECT(std::get<2>(blobs.back()) == lastSeq);
+            }
+        }
+
+        // They still stop at maxLedger within the first shard
+        {
+            RelationalDatabase::AccountTxPageOptions const options{
+                alice.id(), firstSeq, firstSeq + 9, std::nullopt, 10000, true};
+
+            BEAST_EXPECT(rdb->oldestAccountTxPage(options).first.size() == 10);
+            BEAST_EXPECT(rdb->oldestAccountTxPageB(options).first.size() == 10);
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testShardQueries();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(RelationalDatabase, rdb, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -27,6 +27,8 @@
 
 #include <boost/utility/base_from_member.hpp>
 #include <functional>
+#include <thread>
+#include <vector>
 
 namespace ripple {
 namespace Resource {
@@ -275,6 +277,50 @@ public:
         pass();
     }
 
+    void
+    testConcurrentCharges(beast::Journal j)
+    {
+        testcase("Concurrent charges");
+
+        TestLogic logic(j);
+
+        beast::IP::Endpoint const shared(
+            beast::IP::Endpoint::from_string("192.0.2.1"));
+
+        // Each charge adds one to the balance of its endpoint
+        Charge const fee(decayWindowSeconds);
+        int const threadCount = 4;
+        int const chargeCount = 500;
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&logic, &shared, &fee, t]() {
+                beast::IP::Endpoint const own(
+                    beast::IP::Endpoint::from_string(
+                        "198.51.100." + std::to_string(t + 1)));
+                for (int i = 0; i < chargeCount; ++i)
+                {
+                    logic.newInboundEndpoint(shared).charge(fee);
+                    logic.newInboundEndpoint(own).charge(fee);
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        BEAST_EXPECT(
+            logic.newInboundEndpoint(shared).balance() ==
+            threadCount * chargeCount);
+        for (int t = 0; t < threadCount; ++t)
+        {
+            beast::IP::Endpoint const own(beast::IP::Endpoint::from_string(
+                "198.51.100." + std::to_string(t + 1)));
+            BEAST_EXPECT(
+                logic.newInboundEndpoint(own).balance() == chargeCount);
+        }
+    }
+
     void
     run() override
     {
@@ -286,6 +332,7 @@ public:
         testCharges(journal);
         testImports(journal);
         testImport(journal);
+        testConcurrentCharges(journal);
     }
 };
 
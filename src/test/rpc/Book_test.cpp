@@ -1709,6 +1709,119 @@ public:
             (asAdmin ? RPC::Tuning::bookOffers.rdefault : 0u));
     }
 
+    void
+    testBookOfferSnapshots()
+    {
+        testcase("BookOffer Snapshots");
+        using namespace jtx;
+        Env env{*this};
+        Account const gw{"gw"};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        auto const USD = gw["USD"];
+        env.fund(XRP(100000), gw, alice, bob);
+        env(rate(gw, 1.25));
+        env.trust(USD(1000), alice, bob);
+        env.close();
+        env(pay(gw, alice, USD(30)));
+        env.close();
+
+        // Offers of alice are only partly funded, and more so for the
+        // issuer, who pays no transfer fee
+        for (auto i = 0; i < 10; i++)
+            env(offer(alice, XRP(100 + i), USD(10)));
+        env(offer(gw, XRP(200), USD(10)));
+        env.close();
+
+        auto bookOffers = [&](Account const& taker,
+                              Json::Value const& ledger,
+                              unsigned int limit) {
+            Json::Value jvParams;
+            jvParams[jss::limit] = limit;
+            jvParams[jss::ledger_index] = ledger;
+            jvParams[jss::taker] = taker.human();
+            jvParams[jss::taker_pays][jss::currency] = "XRP";
+            jvParams[jss::taker_gets][jss::currency] = "USD";
+            jvParams[jss::taker_gets][jss::issuer] = gw.human();
+            return env.rpc(
+                "json", "book_offers", to_string(jvParams))[jss::result]
+                                                        [jss::offers];
+        };
+
+        // The open ledger holds the same offers, and is never served from
+        // a snapshot
+        auto const closed = env.closed()->seq();
+        for (auto const& taker : {bob, gw})
+        {
+            auto const expected = bookOffers(taker, "current", 20);
+            BEAST_EXPECT(expected.size() == 11);
+            for (unsigned int const limit : {3, 20, 5, 11, 20})
+            {
+                auto const offers = bookOffers(taker, closed, limit);
+                if (!BEAST_EXPECT(
+                        offers.size() == std::min(limit, expected.size())))
+                    continue;
+                for (Json::UInt i = 0; i < offers.size(); ++i)
+                    BEAST_EXPECT(offers[i] == expected[i]);
+            }
+        }
+        BEAST_EXPECT(
+            bookOffers(bob, closed, 20) != bookOffers(gw, closed, 20));
+
+        // A newer ledger replaces the snapshots, without them hiding what
+        // an older ledger holds
+        env(offer(alice, XRP(90), USD(1)));
+        env.close();
+        BEAST_EXPECT(bookOffers(bob, env.closed()->seq(), 20).size() == 12);
+        BEAST_EXPECT(bookOffers(bob, closed, 20).size() == 11);
+        BEAST_EXPECT(bookOffers(bob, env.closed()->seq(), 20).size() == 12);
+    }
+
+    void
+    testBookChanges()
+    {
+        testcase("BookChanges");
+        using namespace jtx;
+        Env env{*this};
+        Account const gw{"gw"};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        auto const USD = gw["USD"];
+        env.fund(XRP(100000), gw, alice, bob);
+        env.trust(USD(1000), alice, bob);
+        env.close();
+        env(pay(gw, alice, USD(100)));
+        env(offer(alice, XRP(500), USD(50)));
+        env.close();
+        env(offer(bob, USD(20), XRP(200)));
+        env.close();
+
+        auto bookChanges = [&](Json::Value const& ledger) {
+            Json::Value jvParams;
+            jvParams[jss::ledger_index] = ledger;
+            return env.rpc(
+                "json", "book_changes", to_string(jvParams))[jss::result];
+        };
+
+        auto& cache = env.app().getBookChangesCache();
+        auto const crossed = env.closed()->seq();
+        auto const first = bookChanges(crossed);
+        BEAST_EXPECT(first[jss::ledger_index] == crossed);
+        BEAST_EXPECT(first[jss::changes].size() == 1);
+        BEAST_EXPECT(cache.size() == 1);
+
+        // A closed ledger's changes are tallied once
+        auto const second = bookChanges(crossed);
+        BEAST_EXPECT(second == first);
+        BEAST_EXPECT(cache.size() == 1);
+
+        // The open ledger's are not kept
+        BEAST_EXPECT(bookChanges("current")[jss::changes].size() == 0);
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(bookChanges(crossed - 1)[jss::changes].size() == 0);
+        BEAST_EXPECT(cache.size() == 2);
+    }
+
     void
     run() override
     {
@@ -1726,6 +1839,8 @@ public:
         testBookOfferErrors();
         testBookOfferLimits(true);
         testBookOfferLimits(false);
+        testBookOfferSnapshots();
+        testBookChanges();
     }
 };
 
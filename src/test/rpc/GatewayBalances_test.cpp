@@ -241,6 +241,201 @@ public:
         expect(jv[jss::result][jss::obligations]["USD"] == maxUSD.getText());
     }
 
+    void
+    testGWBIndex(FeatureBitset features)
+    {
+        testcase("Index");
+
+        using namespace jtx;
+        Account const alice{"alice"};
+        Env env(
+            *this, envconfig([&alice](std::unique_ptr<Config> cfg) {
+                cfg->GATEWAY_BALANCES_INDEX.push_back(alice.human());
+                return cfg;
+            }),
+            features);
+        BEAST_EXPECT(env.app().getGatewayBalancesIndex());
+
+        auto USD = alice["USD"];
+        auto CNY = alice["CNY"];
+        auto JPY = alice["JPY"];
+
+        Account const hw{"hw"};
+        Account const bob{"bob"};
+        Account const charley{"charley"};
+        Account const dave{"dave"};
+        env.fund(XRP(10000), alice, hw, bob, charley, dave);
+        env.close();
+
+        env(trust(hw, USD(10000)));
+        env(trust(hw, JPY(10000)));
+        env(pay(alice, hw, USD(5000)));
+        env(pay(alice, hw, JPY(5000)));
+        env(trust(bob, USD(100)));
+        env(trust(bob, CNY(100)));
+        env(pay(alice, bob, USD(50)));
+        env(trust(charley, CNY(500)));
+        env(pay(alice, charley, CNY(250)));
+        env(trust(dave, CNY(100)));
+        env(pay(alice, dave, CNY(30)));
+        env(trust(alice, charley["USD"](50)));
+        env(pay(charley, alice, USD(10)));
+        env(trust(alice, dave["CNY"](0), dave, tfSetFreeze));
+        env.close();
+
+        auto query = [&]() {
+            env.app().getJobQueue().rendezvous();
+            Json::Value params;
+            params[jss::account] = alice.human();
+            params[jss::hotwallet] = hw.human();
+            params[jss::ledger_index] = "validated";
+            return env.rpc(
+                "json", "gateway_balances", to_string(params))[jss::result];
+        };
+
+        {
+            auto const result = query();
+            BEAST_EXPECT(result[jss::status] == "success");
+
+            auto const& hwBalance = result[jss::balances][hw.human()];
+            BEAST_EXPECT(hwBalance.size() == 2);
+            for (auto const& balance : hwBalance)
+                BEAST_EXPECT(balance[jss::value] == "5000");
+
+            auto const& fBal = result[jss::frozen_balances][dave.human()];
+            BEAST_EXPECT(fBal.size() == 1);
+            BEAST_EXPECT(fBal[0u][jss::currency] == "CNY");
+            BEAST_EXPECT(fBal[0u][jss::value] == "30");
+
+            auto const& cAssets = result[jss::assets][charley.human()];
+            BEAST_EXPECT(cAssets.size() == 1);
+            BEAST_EXPECT(cAssets[0u][jss::currency] == "USD");
+            BEAST_EXPECT(cAssets[0u][jss::value] == "10");
+
+            auto const& obligations = result[jss::obligations];
+            BEAST_EXPECT(obligations.size() == 2);
+            BEAST_EXPECT(obligations["CNY"] == "250");
+            BEAST_EXPECT(obligations["USD"] == "50");
+        }
+
+        // Incremental updates: balances move, dave is unfrozen and
+        // charley's asset line is paid back
+        env(pay(alice, bob, USD(25)));
+        env(trust(alice, dave["CNY"](0), dave, tfClearFreeze));
+        env.close();
+        env(pay(alice, charley, charley["USD"](10)));
+        env(pay(hw, alice, JPY(5000)));
+        env.close();
+
+        {
+            auto const result = query();
+            BEAST_EXPECT(result[jss::status] == "success");
+
+            auto const& hwBalance = result[jss::balances][hw.human()];
+            BEAST_EXPECT(hwBalance.size() == 1);
+            BEAST_EXPECT(hwBalance[0u][jss::currency] == "USD");
+            BEAST_EXPECT(hwBalance[0u][jss::value] == "5000");
+
+            BEAST_EXPECT(!result.isMember(jss::frozen_balances));
+            BEAST_EXPECT(!result.isMember(jss::assets));
+
+            auto const& obligations = result[jss::obligations];
+            BEAST_EXPECT(obligations.size() == 2);
+            BEAST_EXPECT(obligations["CNY"] == "280");
+            BEAST_EXPECT(obligations["USD"] == "75");
+        }
+
+        // Hot wallets that are not passed are counted as obligations
+        {
+            env.app().getJobQueue().rendezvous();
+            Json::Value params;
+            params[jss::account] = alice.human();
+            params[jss::ledger_index] = "validated";
+            auto const result = env.rpc(
+                "json", "gateway_balances", to_string(params))[jss::result];
+            BEAST_EXPECT(!result.isMember(jss::balances));
+            BEAST_EXPECT(result[jss::obligations]["USD"] == "5075");
+        }
+    }
+
+    void
+    testGWBIndexMatchesScan()
+    {
+        testcase("Index matches scan");
+
+        using namespace jtx;
+        Account const alice{"alice"};
+        Account const hw{"hw"};
+        std::vector<Account> holders;
+        for (int i = 0; i < 8; ++i)
+            holders.emplace_back("holder" + std::to_string(i));
+
+        // Run the same trust line changes on a node that indexes alice and
+        // on one that scans her lines, and return the last answer of each
+        auto balancesAfter = [&](bool indexed) {
+            Env env(*this, envconfig([&](std::unique_ptr<Config> cfg) {
+                if (indexed)
+                    cfg->GATEWAY_BALANCES_INDEX.push_back(alice.human());
+                return cfg;
+            }));
+            BEAST_EXPECT(
+                static_cast<bool>(env.app().getGatewayBalancesIndex()) ==
+                indexed);
+
+            auto USD = alice["USD"];
+            auto EUR = alice["EUR"];
+            env.fund(XRP(10000), alice, hw);
+            for (auto const& holder : holders)
+                env.fund(XRP(10000), holder);
+            env.close();
+
+            env(trust(hw, USD(100000)));
+            env(pay(alice, hw, USD(50000)));
+            for (auto const& holder : holders)
+            {
+                env(trust(holder, USD(100000)));
+                env(trust(holder, EUR(100000)));
+            }
+            env.close();
+
+            // Many changes with fractional amounts, over many ledgers
+            for (int round = 0; round < 20; ++round)
+            {
+                for (std::size_t i = 0; i < holders.size(); ++i)
+                {
+                    auto const& holder = holders[i];
+                    env(pay(alice, holder, USD(1.25 + i * 0.5 + round)));
+                    env(pay(alice, holder, EUR(0.25 * (i + 1))));
+                    if ((round + i) % 3 == 0)
+                        env(pay(holder, alice, USD(0.75 + round)));
+                    if ((round + i) % 7 == 0)
+                        env(pay(holder, hw, USD(0.25)));
+                }
+                if (round % 5 == 4)
+                {
+                    auto const& holder = holders[round % holders.size()];
+                    env(pay(holder, alice, EUR(0.25 * (round + 1))));
+                }
+                env.close();
+            }
+
+            env.app().getJobQueue().rendezvous();
+            Json::Value params;
+            params[jss::account] = alice.human();
+            params[jss::hotwallet] = hw.human();
+            params[jss::ledger_index] = "validated";
+            return env.rpc(
+                "json", "gateway_balances", to_string(params))[jss::result];
+        };
+
+        auto const fromIndex = balancesAfter(true);
+        auto const fromScan = balancesAfter(false);
+        BEAST_EXPECT(fromIndex[jss::status] == "success");
+        BEAST_EXPECT(fromIndex[jss::obligations].size() == 2);
+        BEAST_EXPECT(fromIndex[jss::obligations] == fromScan[jss::obligations]);
+        BEAST_EXPECT(fromIndex[jss::balances] == fromScan[jss::balances]);
+    }
+
     void
     run() override
     {
@@ -250,9 +445,11 @@ public:
         {
             testGWB(feature);
             testGWBApiVersions(feature);
+            testGWBIndex(feature);
         }
 
         testGWBOverflow();
+        testGWBIndexMatchesScan();
     }
 };
 
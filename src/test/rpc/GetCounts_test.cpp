@@ -77,6 +77,15 @@ class GetCounts_test : public beast::unit_test::suite
                 BEAST_EXPECTS(result[it.first].asInt() == it.second, it.first);
             }
             BEAST_EXPECT(!result.isMember(jss::local_txs));
+
+            // Each subsystem reports the bytes it holds
+            auto const& memory = result[jss::memory];
+            BEAST_EXPECT(memory.isObject());
+            BEAST_EXPECT(std::stoull(memory[jss::shamap_items].asString()) > 0);
+            BEAST_EXPECT(
+                std::stoull(memory[jss::total].asString()) >=
+                std::stoull(memory[jss::treenode_cache].asString()) +
+                    std::stoull(memory[jss::shamap_items].asString()));
         }
 
         {
@@ -109,6 +118,17 @@ class GetCounts_test : public beast::unit_test::suite
                 result.isMember(jss::local_txs) &&
                 result[jss::local_txs].asInt() > 0);
         }
+
+        {
+            // Requests served over the network report their latency
+            BEAST_EXPECT(
+                !result.isMember(jss::rpc_latency) ||
+                !result[jss::rpc_latency].isMember("server_info"));
+            env.client().invoke("server_info");
+            result = env.rpc("get_counts")[jss::result];
+            BEAST_EXPECT(
+                result[jss::rpc_latency]["server_info"][jss::count] == "1");
+        }
     }
 
 public:
@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/impl/PortWorkers.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class PortWorkers_test : public beast::unit_test::suite
+{
+    void
+    testQueue()
+    {
+        testcase("queue");
+
+        PortWorkers workers{"test", 1, 2};
+        BEAST_EXPECT(workers.getJson()[jss::threads] == 1);
+        BEAST_EXPECT(workers.getJson()[jss::queue_limit] == 2);
+
+        // Hold the only thread, so the queue fills up behind it
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool started = false;
+        bool release = false;
+        BEAST_EXPECT(workers.post([&] {
+            std::unique_lock lock(mutex);
+            started = true;
+            cv.notify_all();
+            cv.wait(lock, [&] { return release; });
+        }));
+        {
+            std::unique_lock lock(mutex);
+            cv.wait(lock, [&] { return started; });
+        }
+
+        std::atomic<int> ran{0};
+        BEAST_EXPECT(workers.post([&] { ++ran; }));
+        BEAST_EXPECT(workers.post([&] { ++ran; }));
+        BEAST_EXPECT(!workers.post([&] { ++ran; }));
+        {
+            auto const jv = workers.getJson();
+            BEAST_EXPECT(jv[jss::queued] == 2);
+            BEAST_EXPECT(jv[jss::running] == 1);
+            BEAST_EXPECT(jv[jss::rejected] == "1");
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            release = true;
+            cv.notify_all();
+        }
+
+        // Stopping waits for the requests already queued
+        workers.stop();
+        BEAST_EXPECT(ran == 2);
+        BEAST_EXPECT(!workers.post([&] { ++ran; }));
+        {
+            auto const jv = workers.getJson();
+            BEAST_EXPECT(jv[jss::queued] == 0);
+            BEAST_EXPECT(jv[jss::running] == 0);
+            BEAST_EXPECT(jv[jss::completed] == "3");
+            BEAST_EXPECT(jv[jss::rejected] == "2");
+        }
+    }
+
+    void
+    testPort()
+    {
+        testcase("port");
+        using namespace jtx;
+
+        Env env{*this, envconfig([](std::unique_ptr<Config> cfg) {
+                    (*cfg)["port_rpc"].set("workers", "2");
+                    return cfg;
+                })};
+
+        // The requests sent over HTTP run on the threads of the port
+        auto const rpcPort =
+            env.app().config()["port_rpc"].get<std::string>("port");
+        env.client().invoke("server_info");
+        auto const result = env.client().invoke("server_info");
+        auto const& ports = result[jss::result][jss::info][jss::ports];
+        if (!BEAST_EXPECT(ports.isArray()))
+            return;
+
+        bool found = false;
+        for (auto const& port : ports)
+        {
+            if (port[jss::port].asString() != *rpcPort)
+            {
+                BEAST_EXPECT(!port.isMember(jss::workers));
+                continue;
+            }
+            found = true;
+            auto const& workers = port[jss::workers];
+            BEAST_EXPECT(workers[jss::threads] == 2);
+            BEAST_EXPECT(!workers.isMember(jss::queue_limit));
+            BEAST_EXPECT(workers[jss::running] == 1);
+            BEAST_EXPECT(workers[jss::completed] != "0");
+        }
+        BEAST_EXPECT(found);
+    }
+
+public:
+    void
+    run() override
+    {
+        testQueue();
+        testPort();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PortWorkers, rpc, ripple);
+
+}  // namespace test
+}  // namespace ripple
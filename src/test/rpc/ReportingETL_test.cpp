@@ -598,6 +598,128 @@ class ReportingETL_test : public beast::unit_test::suite
         }
     }
 
+    // gRPC stuff
+    class GrpcStreamLedgerDataClient : public GRPCTestClientBase
+    {
+    public:
+        org::xrpl::rpc::v1::StreamLedgerDataRequest request;
+        std::vector<org::xrpl::rpc::v1::StreamLedgerDataResponse> replies;
+
+        explicit GrpcStreamLedgerDataClient(std::string const& port)
+            : GRPCTestClientBase(port)
+        {
+        }
+
+        void
+        StreamLedgerData()
+        {
+            auto reader = stub_->StreamLedgerData(&context, request);
+            org::xrpl::rpc::v1::StreamLedgerDataResponse reply;
+            while (reader->Read(&reply))
+                replies.push_back(std::move(reply));
+            status = reader->Finish();
+        }
+    };
+
+    void
+    testStreamLedgerData()
+    {
+        testcase("StreamLedgerData");
+        using namespace test::jtx;
+        std::unique_ptr<Config> config = envconfig(addGrpcConfig);
+        std::string grpcPort =
+            *(*config)[SECTION_PORT_GRPC].get<std::string>("port");
+        Env env(*this, std::move(config));
+        auto grpcStream = [&grpcPort](
+                              auto sequence,
+                              std::uint32_t limit,
+                              bool transactions) {
+            GrpcStreamLedgerDataClient grpcClient{grpcPort};
+            grpcClient.request.mutable_ledger()->set_sequence(sequence);
+            grpcClient.request.set_limit(limit);
+            grpcClient.request.set_transactions(transactions);
+            grpcClient.StreamLedgerData();
+            return std::make_pair(grpcClient.status, grpcClient.replies);
+        };
+
+        Account const alice{"alice"};
+        env.fund(XRP(100000), alice);
+        int const numAccounts = 50;
+        for (auto i = 0; i < numAccounts; i++)
+        {
+            Account const bob{std::string("bob") + std::to_string(i)};
+            env.fund(XRP(1000), bob);
+        }
+        env.close();
+
+        auto const ledger = env.closed();
+        std::size_t const txCount =
+            std::distance(ledger->txs.begin(), ledger->txs.end());
+
+        for (std::uint32_t const limit : {0u, 1u, 7u})
+        {
+            auto const [status, replies] =
+                grpcStream(ledger->seq(), limit, true);
+            if (!BEAST_EXPECT(status.ok() && !replies.empty()))
+                continue;
+
+            std::vector<std::string> txns;
+            std::vector<std::string> objects;
+            for (auto const& reply : replies)
+            {
+                BEAST_EXPECT(reply.ledger_index() == ledger->seq());
+                BEAST_EXPECT(
+                    makeSlice(reply.ledger_hash()) ==
+                    Slice(ledger->info().hash.data(), uint256::size()));
+                auto const count = static_cast<std::uint32_t>(
+                    reply.transactions_list().transactions_size() +
+                    reply.ledger_objects().objects_size());
+                BEAST_EXPECT(limit == 0 || count <= limit);
+                // Transactions all come before the ledger objects
+                BEAST_EXPECT(
+                    objects.empty() ||
+                    reply.transactions_list().transactions_size() == 0);
+                for (auto const& txn : reply.transactions_list().transactions())
+                    txns.push_back(txn.transaction_blob());
+                for (auto const& obj : reply.ledger_objects().objects())
+                    objects.push_back(obj.data());
+            }
+
+            BEAST_EXPECT(txns.size() == txCount);
+            std::size_t idx = 0;
+            for (auto const& sle : ledger->sles)
+            {
+                if (!BEAST_EXPECT(idx < objects.size()))
+                    break;
+                BEAST_EXPECT(
+                    sle->getSerializer().slice() == makeSlice(objects[idx]));
+                ++idx;
+            }
+            BEAST_EXPECT(idx == objects.size());
+        }
+
+        {
+            // Without transactions, only the ledger objects are streamed
+            auto const [status, replies] = grpcStream(ledger->seq(), 0, false);
+            if (BEAST_EXPECT(status.ok() && replies.size() == 1))
+            {
+                BEAST_EXPECT(
+                    replies[0].transactions_list().transactions_size() == 0);
+                BEAST_EXPECT(
+                    replies[0].ledger_objects().objects_size() ==
+                    numAccounts + 4);
+            }
+        }
+
+        {
+            // A ledger that does not exist ends the stream with an error
+            auto const [status, replies] =
+                grpcStream(ledger->seq() + 100, 0, false);
+            BEAST_EXPECT(status.error_code() == grpc::StatusCode::NOT_FOUND);
+            BEAST_EXPECT(replies.empty());
+        }
+    }
+
     // gRPC stuff
     class GrpcLedgerDiffClient : public GRPCTestClientBase
     {
@@ -1128,6 +1250,8 @@ public:
 
         testGetLedgerData();
 
+        testStreamLedgerData();
+
         testGetLedgerDiff();
 
         testGetLedgerEntry();
@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/main/Application.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/impl/ResponseCache.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class ResponseCache_test : public beast::unit_test::suite
+{
+    static std::unique_ptr<Config>
+    withCache(std::unique_ptr<Config> cfg)
+    {
+        cfg->RPC_RESPONSE_CACHE_METHODS = {"account_info", "fee"};
+        return cfg;
+    }
+
+    static Json::Value
+    accountInfo(
+        jtx::Env& env,
+        jtx::Account const& account,
+        std::string const& ledger)
+    {
+        Json::Value params;
+        params[jss::account] = account.human();
+        if (!ledger.empty())
+            params[jss::ledger_index] = ledger;
+        return env.rpc("json", "account_info", to_string(params))
+            [jss::result];
+    }
+
+    void
+    testDisabled()
+    {
+        testcase("disabled");
+        using namespace jtx;
+
+        Env env{*this};
+        BEAST_EXPECT(!env.app().getRPCResponseCache());
+        auto const result = env.rpc("get_counts")[jss::result];
+        BEAST_EXPECT(!result.isMember(jss::rpc_response_size));
+    }
+
+    void
+    testValidated()
+    {
+        testcase("validated");
+        using namespace jtx;
+
+        Env env{*this, envconfig(withCache)};
+        auto const cache = env.app().getRPCResponseCache();
+        if (!BEAST_EXPECT(cache))
+            return;
+
+        Account const alice{"alice"};
+        env.fund(XRP(10000), alice);
+        env.close();
+
+        auto const first = accountInfo(env, alice, "validated");
+        BEAST_EXPECT(cache->size() == 1);
+        auto const second = accountInfo(env, alice, "validated");
+        BEAST_EXPECT(cache->size() == 1);
+        BEAST_EXPECT(first == second);
+        BEAST_EXPECT(cache->getHitRate() == 50.0f);
+
+        // A numbered ledger that has been validated is kept too
+        auto const seq = first[jss::ledger_index].asString();
+        accountInfo(env, alice, seq);
+        BEAST_EXPECT(cache->size() == 2);
+
+        // Once the validated ledger advances, it is asked again
+        env(pay(env.master, alice, XRP(1)));
+        env.close();
+        auto const third = accountInfo(env, alice, "validated");
+        BEAST_EXPECT(cache->size() == 3);
+        BEAST_EXPECT(
+            third[jss::account_data][jss::Balance] !=
+            first[jss::account_data][jss::Balance]);
+        BEAST_EXPECT(
+            accountInfo(env, alice, seq)[jss::account_data] ==
+            first[jss::account_data]);
+        BEAST_EXPECT(cache->size() == 3);
+    }
+
+    void
+    testNotKept()
+    {
+        testcase("not kept");
+        using namespace jtx;
+
+        Env env{*this, envconfig(withCache)};
+        auto const cache = env.app().getRPCResponseCache();
+        if (!BEAST_EXPECT(cache))
+            return;
+
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        env.fund(XRP(10000), alice);
+        env.close();
+
+        // The current ledger, whether named or by default
+        accountInfo(env, alice, "current");
+        accountInfo(env, alice, "");
+        accountInfo(env, alice, std::to_string(env.current()->seq()));
+        BEAST_EXPECT(cache->size() == 0);
+
+        // Errors
+        BEAST_EXPECT(
+            accountInfo(env, bob, "validated")[jss::error] == "actNotFound");
+        BEAST_EXPECT(cache->size() == 0);
+
+        // Methods that are not named
+        env.rpc("account_lines", alice.human(), "validated");
+        BEAST_EXPECT(cache->size() == 0);
+
+        // Methods that take no ledger are kept
+        auto const fee = env.rpc("fee")[jss::result];
+        BEAST_EXPECT(env.rpc("fee")[jss::result] == fee);
+        BEAST_EXPECT(cache->size() == 1);
+
+        auto const result = env.rpc("get_counts")[jss::result];
+        BEAST_EXPECT(result[jss::rpc_response_size].asUInt() == 1);
+    }
+
+public:
+    void
+    run() override
+    {
+        testDisabled();
+        testValidated();
+        testNotKept();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ResponseCache, rpc, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -151,6 +151,46 @@ admin = 127.0.0.1
         }
     }
 
+    void
+    testServerInfoSnapshot()
+    {
+        testcase("server_info snapshot");
+
+        using namespace test::jtx;
+
+        Env env(*this);
+        auto& ops = env.app().getOPs();
+        auto const seq = [&] {
+            auto const info = ops.getServerInfo(false, false, false);
+            return info[jss::validated_ledger][jss::seq].asUInt();
+        };
+
+        // Requests that are not admin share a snapshot, but a newly
+        // published ledger is reported at once
+        auto const first = seq();
+        BEAST_EXPECT(seq() == first);
+        env.close();
+        BEAST_EXPECT(seq() == first + 1);
+
+        // And so is a change of the operating mode
+        BEAST_EXPECT(
+            ops.getServerInfo(true, false, false)[jss::server_state] ==
+            "full");
+        ops.setMode(OperatingMode::TRACKING);
+        BEAST_EXPECT(
+            ops.getServerInfo(true, false, false)[jss::server_state] ==
+            "tracking");
+        BEAST_EXPECT(
+            ops.getServerInfo(false, false, false)[jss::server_state] ==
+            "tracking");
+
+        // Admin requests always build their own
+        auto const admin = ops.getServerInfo(true, true, false);
+        BEAST_EXPECT(admin.isMember(jss::pubkey_validator));
+        BEAST_EXPECT(!ops.getServerInfo(true, false, false)
+                          .isMember(jss::pubkey_validator));
+    }
+
     void
     testServerDefinitions()
     {
@@ -248,6 +288,7 @@ admin = 127.0.0.1
     run() override
     {
         testServerInfo();
+        testServerInfoSnapshot();
         testServerDefinitions();
     }
 };
@@ -20,6 +20,7 @@
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/core/ConfigSections.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/json/json_value.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/jss.h>
@@ -387,6 +388,72 @@ public:
         }
     }
 
+    void
+    testTransactionsOrder()
+    {
+        testcase("transactions order");
+
+        using namespace std::chrono_literals;
+        using namespace jtx;
+        Env env(*this);
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        env.fund(XRP(10000), alice, bob);
+        env.close();
+
+        // Let the funding ledger be published before subscribing
+        env.app().getJobQueue().rendezvous();
+
+        auto wsc = makeWSClient(env.app().config());
+        auto wscAccount = makeWSClient(env.app().config());
+        {
+            Json::Value stream;
+            stream[jss::streams] = Json::arrayValue;
+            stream[jss::streams].append("transactions");
+            BEAST_EXPECT(
+                wsc->invoke("subscribe", stream)[jss::status] == "success");
+        }
+        {
+            Json::Value stream;
+            stream[jss::accounts] = Json::arrayValue;
+            stream[jss::accounts].append(alice.human());
+            BEAST_EXPECT(
+                wscAccount->invoke("subscribe", stream)[jss::status] ==
+                "success");
+        }
+
+        // Each transaction is published once, in ledger order, to both
+        // the transaction and the account streams
+        std::uint32_t const count = 10;
+        auto const first = env.seq(alice);
+        for (std::uint32_t i = 0; i < count; ++i)
+            env(pay(alice, bob, XRP(1)));
+        env.close();
+
+        std::vector<std::string> hashes;
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            auto const jv = wsc->getMsg(5s);
+            if (!BEAST_EXPECT(jv))
+                return;
+            BEAST_EXPECT((*jv)[jss::meta][sfTransactionIndex.jsonName] == i);
+            BEAST_EXPECT((*jv)[jss::transaction][jss::Sequence] == first + i);
+            BEAST_EXPECT((*jv)[jss::validated] == true);
+            hashes.push_back((*jv)[jss::transaction][jss::hash].asString());
+        }
+        BEAST_EXPECT(!wsc->getMsg(10ms));
+
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            auto const jv = wscAccount->getMsg(5s);
+            if (!BEAST_EXPECT(jv))
+                return;
+            BEAST_EXPECT((*jv)[jss::transaction][jss::hash] == hashes[i]);
+            BEAST_EXPECT((*jv)[jss::meta][sfTransactionIndex.jsonName] == i);
+        }
+        BEAST_EXPECT(!wscAccount->getMsg(10ms));
+    }
+
     void
     testManifests()
     {
@@ -1304,6 +1371,7 @@ public:
         testLedger();
         testTransactions_APIv1();
         testTransactions_APIv2();
+        testTransactionsOrder();
         testManifests();
         testValidations(all - xrpFees);
         testValidations(all);
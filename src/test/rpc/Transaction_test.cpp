@@ -844,6 +844,52 @@ class Transaction_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testRecentIndex()
+    {
+        testcase("Recent transactions");
+
+        using namespace test::jtx;
+        using std::to_string;
+
+        Env env{*this};
+        auto const alice = Account("alice");
+        env.fund(XRP(1000), alice);
+        env.close();
+
+        env(noop(alice));
+        auto const txn = env.tx();
+        env.close();
+        auto const txnSeq = env.closed()->info().seq;
+
+        // Recent transactions are read from their ledger, not the database
+        dynamic_cast<SQLiteDatabase*>(&env.app().getRelationalDatabase())
+            ->deleteTransactionByLedgerSeq(txnSeq);
+        {
+            auto const result = env.rpc(
+                jss::tx.c_str(), to_string(txn->getTransactionID()));
+            BEAST_EXPECT(result[jss::result][jss::status] == jss::success);
+            BEAST_EXPECT(result[jss::result][jss::validated].asBool());
+            BEAST_EXPECT(
+                result[jss::result][jss::ledger_index].asUInt() == txnSeq);
+            BEAST_EXPECT(result[jss::result].isMember(jss::meta));
+        }
+
+        // Once it ages out of the index, the database is used again
+        for (int i = 0; i < 300; ++i)
+        {
+            env(noop(alice));
+            env.close();
+        }
+        {
+            auto const result = env.rpc(
+                jss::tx.c_str(), to_string(txn->getTransactionID()));
+            BEAST_EXPECT(
+                result[jss::result][jss::error] ==
+                RPC::get_error_info(rpcTXN_NOT_FOUND).token);
+        }
+    }
+
 public:
     void
     run() override
@@ -852,6 +898,8 @@ public:
         test::jtx::forAllApiVersions(
             std::bind_front(&Transaction_test::testBinaryRequest, this));
 
+        testRecentIndex();
+
         FeatureBitset const all{supported_amendments()};
         testWithFeats(all);
     }
@@ -0,0 +1,209 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/shamap/FullBelowCache.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <vector>
+
+namespace ripple {
+namespace tests {
+
+class FullBelowCache_test : public beast::unit_test::suite
+{
+    static uint256
+    randomKey(beast::xor_shift_engine& eng)
+    {
+        uint256 key;
+        for (auto& b : key)
+            b = static_cast<std::uint8_t>(eng());
+        return key;
+    }
+
+    void
+    testExpiration()
+    {
+        testcase("expiration");
+
+        using namespace std::chrono_literals;
+        test::SuiteJournal journal("FullBelowCache_test", *this);
+        TestStopwatch clock;
+        clock.set(0);
+
+        FullBelowCache cache(
+            "test",
+            clock,
+            journal,
+            beast::insight::NullCollector::New(),
+            0,
+            2s);
+        auto const one = uint256{1};
+        auto const two = uint256{2};
+
+        BEAST_EXPECT(cache.size() == 0);
+        BEAST_EXPECT(!cache.touch_if_exists(one));
+        cache.insert(one);
+        cache.insert(one);
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(cache.touch_if_exists(one));
+
+        // Nothing is retired before half the expiration time
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 1);
+
+        // One sweep period moves the key to the older set; using it
+        // brings it back, so it survives the next sweep.
+        ++clock;
+        cache.sweep();
+        cache.insert(two);
+        BEAST_EXPECT(cache.touch_if_exists(one));
+        ++clock;
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 2);
+
+        // Unused for two periods, both go.
+        ++clock;
+        cache.sweep();
+        ++clock;
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 0);
+        BEAST_EXPECT(!cache.touch_if_exists(one));
+        BEAST_EXPECT(!cache.touch_if_exists(two));
+    }
+
+    void
+    testTargetSize()
+    {
+        testcase("target size");
+
+        using namespace std::chrono_literals;
+        test::SuiteJournal journal("FullBelowCache_test", *this);
+        TestStopwatch clock;
+        clock.set(0);
+
+        FullBelowCache cache(
+            "test",
+            clock,
+            journal,
+            beast::insight::NullCollector::New(),
+            100,
+            1h);
+        beast::xor_shift_engine eng(7);
+        for (int i = 0; i < 200; ++i)
+            cache.insert(randomKey(eng));
+        BEAST_EXPECT(cache.size() == 200);
+
+        // Over the target, a sweep rotates without waiting for the
+        // expiration time, and the next one drops the old keys.
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 200);
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 200);
+
+        for (int i = 0; i < 60; ++i)
+            cache.insert(randomKey(eng));
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 60);
+    }
+
+    void
+    testMany()
+    {
+        testcase("many keys");
+
+        using namespace std::chrono_literals;
+        test::SuiteJournal journal("FullBelowCache_test", *this);
+        TestStopwatch clock;
+        clock.set(0);
+
+        FullBelowCache cache(
+            "test",
+            clock,
+            journal,
+            beast::insight::NullCollector::New(),
+            0,
+            2s);
+        beast::xor_shift_engine eng(42);
+
+        std::vector<uint256> keys;
+        for (int i = 0; i < 20000; ++i)
+            keys.push_back(randomKey(eng));
+
+        for (auto const& k : keys)
+            cache.insert(k);
+        BEAST_EXPECT(cache.size() == keys.size());
+
+        // Move every key to the older set, then touch every other one:
+        // removing keys from the older set must keep the rest findable.
+        ++clock;
+        cache.sweep();
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < keys.size(); i += 2)
+            found += cache.touch_if_exists(keys[i]);
+        BEAST_EXPECT(found == (keys.size() + 1) / 2);
+
+        found = 0;
+        for (auto const& k : keys)
+            found += cache.touch_if_exists(k);
+        BEAST_EXPECT(found == keys.size());
+        BEAST_EXPECT(cache.size() == keys.size());
+
+        int strays = 0;
+        for (int i = 0; i < 1000; ++i)
+            strays += cache.touch_if_exists(randomKey(eng));
+        BEAST_EXPECT(strays == 0);
+    }
+
+    void
+    testGeneration()
+    {
+        testcase("generation");
+
+        test::SuiteJournal journal("FullBelowCache_test", *this);
+        TestStopwatch clock;
+        FullBelowCache cache("test", clock, journal);
+
+        BEAST_EXPECT(cache.getGeneration() == 1);
+        cache.insert(uint256{1});
+        cache.clear();
+        BEAST_EXPECT(cache.size() == 0);
+        BEAST_EXPECT(cache.getGeneration() == 2);
+        cache.insert(uint256{1});
+        cache.reset();
+        BEAST_EXPECT(cache.size() == 0);
+        BEAST_EXPECT(cache.getGeneration() == 1);
+    }
+
+public:
+    void
+    run() override
+    {
+        testExpiration();
+        testTargetSize();
+        testMany();
+        testGeneration();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(FullBelowCache, ripple_app, ripple);
+
+}  // namespace tests
+}  // namespace ripple
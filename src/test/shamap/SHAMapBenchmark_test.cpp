@@ -0,0 +1,368 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/basics/Buffer.h>
+#include <ripple/basics/CountedObject.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/rngfill.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/shamap/SHAMap.h>
+#include <ripple/shamap/SHAMapItem.h>
+#include <test/shamap/common.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <boost/algorithm/string.hpp>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+namespace ripple {
+namespace tests {
+
+/*  SHAMap benchmark.
+
+    Builds a map shaped like a mainnet state tree, with random keys and
+    the mix of item sizes of the common ledger objects, and times the
+    basic operations on it. Each operation reports the nanoseconds it
+    takes and the change in live SHAMap objects (items, inner and leaf
+    nodes) that it causes. This suite is manual:
+
+        rippled --unittest=SHAMapBenchmark --unittest-arg="<config>"
+
+    The config is a comma separated list of key=value pairs:
+
+        items       Items in the map. Default 200000 (10000 in debug).
+        changes     Items updated or deleted in the runs that modify the
+                    map. Default items / 10.
+        threads     Threads for flushDirty and compare. Default 1.
+        read_ahead  Subtrees to read ahead in the cold iteration. Default 8.
+        seed        Seed for the synthetic keys and data. Default 42.
+*/
+class SHAMapBenchmark_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+#ifndef NDEBUG
+    static constexpr std::size_t defaultItems = 10000;
+#else
+    static constexpr std::size_t defaultItems = 200000;
+#endif
+
+    struct Params
+    {
+        std::size_t items;
+        std::size_t changes;
+        std::size_t threads;
+        int readAhead;
+        std::uint64_t seed;
+    };
+
+    // The live objects that make up SHAMaps
+    static std::int64_t
+    liveObjects()
+    {
+        std::int64_t n = 0;
+        for (auto const& [name, count] :
+             CountedObjects::getInstance().getCounts(0))
+        {
+            if (name.find("SHAMapItem") != std::string::npos ||
+                name.find("SHAMapInnerNode") != std::string::npos ||
+                name.find("LeafNode") != std::string::npos)
+                n += count;
+        }
+        return n;
+    }
+
+    static std::string
+    fmt(double value, int precision)
+    {
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(precision) << value;
+        return ss.str();
+    }
+
+    void
+    report(
+        std::string const& what,
+        std::size_t ops,
+        std::chrono::nanoseconds elapsed,
+        std::int64_t objects)
+    {
+        auto const n = static_cast<double>(std::max<std::size_t>(ops, 1));
+        log << std::left << std::setw(26) << what << std::right
+            << std::setw(12) << fmt(elapsed.count() / n, 1) << " ns/op"
+            << std::setw(10) << fmt(objects / n, 2) << " objects/op"
+            << std::setw(10) << ops << " ops" << std::endl;
+    }
+
+    // Time f, which returns the number of operations it did
+    template <class F>
+    void
+    measure(std::string const& what, F&& f)
+    {
+        auto const objects = liveObjects();
+        auto const start = clock_type::now();
+        std::size_t const ops = f();
+        auto const elapsed = clock_type::now() - start;
+        report(what, ops, elapsed, liveObjects() - objects);
+    }
+
+    // Item data sized like the serialized ledger objects of mainnet:
+    // mostly account roots and trust lines, some offers, and directories
+    // of all sizes.
+    static Buffer
+    makeData(beast::xor_shift_engine& rng)
+    {
+        std::uniform_int_distribution<int> kind(0, 99);
+        std::size_t size;
+
+        if (auto const k = kind(rng); k < 45)
+            size = std::uniform_int_distribution<std::size_t>(110, 140)(rng);
+        else if (k < 80)
+            size = std::uniform_int_distribution<std::size_t>(180, 230)(rng);
+        else if (k < 92)
+            size = std::uniform_int_distribution<std::size_t>(140, 180)(rng);
+        else
+            size = std::uniform_int_distribution<std::size_t>(100, 900)(rng);
+
+        Buffer data(size);
+        beast::rngfill(data.data(), data.size(), rng);
+        return data;
+    }
+
+    static uint256
+    makeKey(beast::xor_shift_engine& rng)
+    {
+        uint256 key;
+        beast::rngfill(key.begin(), key.size(), rng);
+        return key;
+    }
+
+    void
+    runBenchmark(Params const& p, beast::Journal const& journal)
+    {
+        using namespace std::chrono;
+
+        beast::xor_shift_engine rng(p.seed);
+
+        std::vector<boost::intrusive_ptr<SHAMapItem const>> items;
+        items.reserve(p.items);
+        for (std::size_t i = 0; i < p.items; ++i)
+            items.push_back(make_shamapitem(makeKey(rng), makeData(rng)));
+
+        // The items that the update and delete runs change
+        std::vector<boost::intrusive_ptr<SHAMapItem const>> updates;
+        updates.reserve(p.changes);
+        for (std::size_t i = 0; i < p.changes; ++i)
+        {
+            auto const& old = items[rng() % items.size()];
+            updates.push_back(make_shamapitem(old->key(), makeData(rng)));
+        }
+
+        TestNodeFamily f(journal);
+        SHAMap map(SHAMapType::STATE, f);
+
+        measure("insert", [&]() {
+            for (auto const& item : items)
+                map.addItem(SHAMapNodeType::tnACCOUNT_STATE, item);
+            return items.size();
+        });
+
+        measure("flushDirty (per node)", [&]() {
+            return map.flushDirty(hotACCOUNT_NODE, p.threads);
+        });
+
+        map.setImmutable();
+        auto const hash = map.getHash();
+
+        measure("snapShot immutable", [&]() {
+            for (int i = 0; i < 1000; ++i)
+                map.snapShot(false);
+            return 1000;
+        });
+
+        measure("snapShot mutable", [&]() {
+            for (int i = 0; i < 1000; ++i)
+                map.snapShot(true);
+            return 1000;
+        });
+
+        auto updated = map.snapShot(true);
+
+        measure("update", [&]() {
+            for (auto const& item : updates)
+                updated->updateGiveItem(SHAMapNodeType::tnACCOUNT_STATE, item);
+            return updates.size();
+        });
+
+        measure("flushDirty update (per node)", [&]() {
+            return updated->flushDirty(hotACCOUNT_NODE, p.threads);
+        });
+
+        {
+            auto deleted = map.snapShot(true);
+            measure("delete", [&]() {
+                for (auto const& item : updates)
+                    deleted->delItem(item->key());
+                return updates.size();
+            });
+        }
+
+        updated->setImmutable();
+
+        measure("compare (per difference)", [&]() {
+            SHAMap::Delta delta;
+            map.compare(
+                *updated,
+                delta,
+                static_cast<int>(2 * updates.size() + 1),
+                p.threads);
+            return delta.size();
+        });
+
+        measure("iterate warm", [&]() {
+            std::size_t n = 0;
+            for (auto const& item : map)
+                n += item.size() != 0;
+            return n;
+        });
+
+        for (auto const readAhead : {0, p.readAhead})
+        {
+            f.reset();
+            SHAMap cold(SHAMapType::STATE, hash.as_uint256(), f);
+            if (!BEAST_EXPECT(cold.fetchRoot(hash, nullptr)))
+                return;
+
+            measure(
+                "iterate cold, read ahead " + std::to_string(readAhead),
+                [&]() {
+                    std::size_t n = 0;
+                    for (auto it = cold.begin(readAhead); it != cold.end();
+                         ++it)
+                        n += it->size() != 0;
+                    return n;
+                });
+        }
+
+        runSync(map, p.seed, journal);
+    }
+
+    // Time what the acquiring side of a sync does; the work of the peers
+    // that serve the nodes is left out. Peers answer with the node and the
+    // level below it, as they do for ledger requests by default.
+    void
+    runSync(
+        SHAMap const& source,
+        std::uint64_t seed,
+        beast::Journal const& journal)
+    {
+        using namespace std::chrono;
+
+        // A store of its own, which starts without the source's nodes
+        TestNodeFamily f(journal, "SHAMapBenchmark_" + std::to_string(seed));
+        SHAMap destination(SHAMapType::STATE, source.getHash().as_uint256(), f);
+
+        std::vector<std::pair<SHAMapNodeID, Blob>> root;
+        if (!BEAST_EXPECT(source.getNodeFat(SHAMapNodeID(), root, false, 0)))
+            return;
+        destination.addRootNode(
+            source.getHash(), makeSlice(root[0].second), nullptr);
+
+        nanoseconds missingTime{0};
+        nanoseconds addTime{0};
+        std::size_t requested = 0;
+        std::size_t added = 0;
+        std::int64_t objects = 0;
+
+        while (true)
+        {
+            auto start = clock_type::now();
+            auto const missing = destination.getMissingNodes(2048, nullptr);
+            missingTime += clock_type::now() - start;
+
+            if (missing.empty())
+                break;
+            requested += missing.size();
+
+            std::vector<std::pair<SHAMapNodeID, Blob>> data;
+            for (auto const& [nodeID, hash] : missing)
+            {
+                if (!source.getNodeFat(nodeID, data, false, 1))
+                {
+                    fail("getNodeFat");
+                    return;
+                }
+            }
+
+            std::vector<std::pair<SHAMapNodeID, Slice>> nodes;
+            nodes.reserve(data.size());
+            for (auto const& [nodeID, blob] : data)
+                nodes.emplace_back(nodeID, makeSlice(blob));
+
+            auto const live = liveObjects();
+            start = clock_type::now();
+            destination.addKnownNodes(nodes, nullptr);
+            addTime += clock_type::now() - start;
+            objects += liveObjects() - live;
+            added += nodes.size();
+        }
+
+        destination.clearSynching();
+        BEAST_EXPECT(destination.getHash() == source.getHash());
+
+        report("sync getMissingNodes", requested, missingTime, 0);
+        report("sync addKnownNodes", added, addTime, objects);
+    }
+
+public:
+    void
+    run() override
+    {
+        test::SuiteJournal journal("SHAMapBenchmark_test", *this);
+
+        std::vector<std::string> lines;
+        boost::split(lines, arg(), boost::is_any_of(","));
+        Section config;
+        config.append(lines);
+
+        Params p;
+        p.items = std::max<std::size_t>(
+            1, get<std::size_t>(config, "items", defaultItems));
+        p.changes = std::max<std::size_t>(
+            1, get<std::size_t>(config, "changes", p.items / 10));
+        p.threads =
+            std::max<std::size_t>(1, get<std::size_t>(config, "threads", 1));
+        p.readAhead = get<int>(config, "read_ahead", 8);
+        p.seed = get<std::uint64_t>(config, "seed", 42);
+
+        testcase(
+            "items=" + std::to_string(p.items) +
+            " changes=" + std::to_string(p.changes) +
+            " threads=" + std::to_string(p.threads));
+        runBenchmark(p, journal);
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(SHAMapBenchmark, shamap, ripple);
+
+}  // namespace tests
+}  // namespace ripple
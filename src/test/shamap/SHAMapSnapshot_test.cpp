@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/shamap/SHAMap.h>
+#include <ripple/shamap/SHAMapSnapshot.h>
+#include <fstream>
+#include <test/shamap/common.h>
+#include <test/unit_test/SuiteJournal.h>
+
+namespace ripple {
+namespace tests {
+
+class SHAMapSnapshot_test : public beast::unit_test::suite
+{
+    void
+    testRoundTrip()
+    {
+        testcase("round trip");
+
+        test::SuiteJournal journal("SHAMapSnapshot_test", *this);
+        beast::temp_dir dir;
+        auto const path = dir.file("state.snapshot");
+
+        TestNodeFamily f(journal, "SHAMapSnapshot_test_source");
+        SHAMap map(SHAMapType::STATE, f);
+        for (std::uint32_t i = 0; i < 2000; ++i)
+        {
+            auto const key = sha512Half(i);
+            BEAST_EXPECT(map.addItem(
+                SHAMapNodeType::tnACCOUNT_STATE,
+                make_shamapitem(key, Slice(key.data(), key.size()))));
+        }
+        auto const rootHash = map.getHash();
+        map.setImmutable();
+
+        std::vector<SHAMapHash> inner;
+        map.visitResidentInnerNodes([&](SHAMapInnerNode const& node) {
+            inner.push_back(node.getHash());
+        });
+        BEAST_EXPECT(inner.size() > 1);
+        BEAST_EXPECT(inner.front() == rootHash);
+
+        BEAST_EXPECT(writeSHAMapSnapshot(map, 7, path) == inner.size());
+
+        // Every inner node is in the cache of a family that never saw
+        // the map, and with the same hash.
+        TestNodeFamily g(journal, "SHAMapSnapshot_test_destination");
+        auto const snapshot =
+            loadSHAMapSnapshot(path, *g.getTreeNodeCache(0), journal);
+        if (!BEAST_EXPECT(snapshot))
+            return;
+        BEAST_EXPECT(snapshot->ledgerSeq == 7);
+        BEAST_EXPECT(snapshot->rootHash == rootHash.as_uint256());
+        BEAST_EXPECT(snapshot->nodes == inner.size());
+
+        for (auto const& hash : inner)
+        {
+            auto const node = g.getTreeNodeCache(0)->fetch(hash.as_uint256());
+            BEAST_EXPECT(node && node->isInner() && node->getHash() == hash);
+        }
+    }
+
+    void
+    testBadFiles()
+    {
+        testcase("bad files");
+
+        test::SuiteJournal journal("SHAMapSnapshot_test", *this);
+        beast::temp_dir dir;
+        TestNodeFamily f(journal, "SHAMapSnapshot_test_bad");
+        auto& cache = *f.getTreeNodeCache(0);
+
+        BEAST_EXPECT(!loadSHAMapSnapshot(dir.file("missing"), cache, journal));
+
+        {
+            std::ofstream out(dir.file("garbage"), std::ios::binary);
+            out << "this is not a snapshot of anything";
+        }
+        BEAST_EXPECT(!loadSHAMapSnapshot(dir.file("garbage"), cache, journal));
+
+        // A snapshot cut short
+        SHAMap map(SHAMapType::STATE, f);
+        for (std::uint32_t i = 0; i < 100; ++i)
+        {
+            auto const key = sha512Half(i);
+            map.addItem(
+                SHAMapNodeType::tnACCOUNT_STATE,
+                make_shamapitem(key, Slice(key.data(), key.size())));
+        }
+        map.getHash();
+        map.setImmutable();
+
+        auto const path = dir.file("short");
+        BEAST_EXPECT(writeSHAMapSnapshot(map, 1, path) > 1);
+        boost::filesystem::resize_file(
+            path, boost::filesystem::file_size(path) - 1);
+        BEAST_EXPECT(!loadSHAMapSnapshot(path, cache, journal));
+    }
+
+public:
+    void
+    run() override
+    {
+        testRoundTrip();
+        testBadFiles();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SHAMapSnapshot, shamap, ripple);
+
+}  // namespace tests
+}  // namespace ripple
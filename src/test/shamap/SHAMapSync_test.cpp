@@ -120,6 +120,9 @@ public:
         std::vector<Blob> gotNodes;
         std::vector<uint256> hashes;
 
+        // Maps that are synched from peers, like transaction sets, may keep
+        // their items in an arena
+        destination.setItemArena();
         destination.setSynching();
 
         {
@@ -166,6 +169,42 @@ public:
             if (b.empty())
                 fail("", __FILE__, __LINE__);
 
+            // Alternate between adding the nodes one at a time, as a batch,
+            // which hashes them together, and as a batch that was parsed
+            // ahead of time
+            auto const how = rand_int(eng_, 2);
+            if (how == 1)
+            {
+                std::vector<std::pair<SHAMapNodeID, Slice>> nodes;
+                for (auto const& [nodeID, data] : b)
+                    nodes.emplace_back(nodeID, makeSlice(data));
+
+                if (!destination.addKnownNodes(nodes, nullptr).isUseful())
+                    fail("", __FILE__, __LINE__);
+                continue;
+            }
+
+            if (how == 2)
+            {
+                std::vector<Slice> raw;
+                for (auto const& [nodeID, data] : b)
+                    raw.push_back(makeSlice(data));
+
+                auto parsed = destination.parseNodes(raw);
+                if (parsed.size() != b.size())
+                    fail("", __FILE__, __LINE__);
+
+                std::vector<
+                    std::pair<SHAMapNodeID, SharedIntrusive<SHAMapTreeNode>>>
+                    nodes;
+                for (std::size_t i = 0; i < parsed.size(); ++i)
+                    nodes.emplace_back(b[i].first, std::move(parsed[i]));
+
+                if (!destination.addKnownNodes(nodes, nullptr).isUseful())
+                    fail("", __FILE__, __LINE__);
+                continue;
+            }
+
             for (std::size_t i = 0; i < b.size(); ++i)
             {
                 // Don't use BEAST_EXPECT here b/c it will be called a
@@ -21,9 +21,14 @@
 #include <ripple/basics/Buffer.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/beast/utility/Journal.h>
+#include <ripple/beast/utility/rngfill.h>
+#include <ripple/beast/xor_shift_engine.h>
 #include <ripple/shamap/SHAMap.h>
 #include <test/shamap/common.h>
 #include <test/unit_test/SuiteJournal.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
 namespace ripple {
 namespace tests {
@@ -122,6 +127,65 @@ public:
 
         run(true, journal);
         run(false, journal);
+        testItemArena(journal);
+    }
+
+    void
+    testItemArena(beast::Journal const& journal)
+    {
+        testcase("item arena");
+
+        tests::TestNodeFamily f(journal);
+
+        SHAMap heap(SHAMapType::TRANSACTION, f);
+        heap.setUnbacked();
+
+        boost::intrusive_ptr<SHAMapItem const> kept;
+
+        {
+            auto arena = std::make_shared<SHAMap>(SHAMapType::TRANSACTION, f);
+            arena->setUnbacked();
+            arena->setItemArena();
+
+            beast::xor_shift_engine rng(7);
+            for (int i = 0; i < 2000; ++i)
+            {
+                uint256 key;
+                beast::rngfill(key.begin(), key.size(), rng);
+
+                // Mix in items too large to share a block
+                Buffer data(i % 100 == 0 ? 20000 : 32 + i % 300);
+                std::fill_n(
+                    data.data(), data.size(), static_cast<std::uint8_t>(i));
+
+                auto item = arena->makeItem(key, data);
+                BEAST_EXPECT(item->key() == key);
+                BEAST_EXPECT(item->slice() == Slice(data));
+
+                BEAST_EXPECT(heap.addItem(
+                    SHAMapNodeType::tnTRANSACTION_NM,
+                    make_shamapitem(key, data)));
+                BEAST_EXPECT(arena->addItem(
+                    SHAMapNodeType::tnTRANSACTION_NM, std::move(item)));
+
+                if (i == 500)
+                    kept = arena->peekItem(key);
+            }
+
+            BEAST_EXPECT(arena->getHash() == heap.getHash());
+
+            // Snapshots share the arena and outlive the original
+            auto const copy = arena->snapShot(true);
+            arena.reset();
+
+            BEAST_EXPECT(copy->getHash() == heap.getHash());
+            BEAST_EXPECT(copy->deepCompare(heap));
+        }
+
+        // Items keep their memory after every map that held them is gone
+        BEAST_EXPECT(kept);
+        BEAST_EXPECT(heap.hasItem(kept->key()));
+        BEAST_EXPECT(heap.peekItem(kept->key())->slice() == kept->slice());
     }
 
     void
@@ -325,6 +389,316 @@ public:
                 --h;
             }
         }
+
+        if (backed)
+            testcase("parallel flush backed");
+        else
+            testcase("parallel flush unbacked");
+
+        {
+            tests::TestNodeFamily tf{journal};
+            SHAMap serial{SHAMapType::FREE, tf};
+            SHAMap parallel{SHAMapType::FREE, tf};
+            if (!backed)
+            {
+                serial.setUnbacked();
+                parallel.setUnbacked();
+            }
+
+            beast::xor_shift_engine rng(backed ? 1 : 2);
+            auto addItems = [&](int count) {
+                for (int i = 0; i < count; ++i)
+                {
+                    uint256 key;
+                    beast::rngfill(key.begin(), key.size(), rng);
+                    auto const data = IntToVUC(i);
+                    BEAST_EXPECT(serial.addItem(
+                        SHAMapNodeType::tnACCOUNT_STATE,
+                        make_shamapitem(key, data)));
+                    BEAST_EXPECT(parallel.addItem(
+                        SHAMapNodeType::tnACCOUNT_STATE,
+                        make_shamapitem(key, data)));
+                }
+            };
+
+            // A fresh tree, then a tree with only some subtrees dirty
+            for (int const count : {2000, 3})
+            {
+                addItems(count);
+
+                int const serialFlushed = serial.flushDirty(hotACCOUNT_NODE);
+                int const parallelFlushed =
+                    parallel.flushDirty(hotACCOUNT_NODE, 4);
+
+                BEAST_EXPECT(serialFlushed == parallelFlushed);
+                BEAST_EXPECT(serial.getHash() == parallel.getHash());
+                serial.invariants();
+                parallel.invariants();
+
+                if (backed)
+                    BEAST_EXPECT(tf.db().fetchNodeObject(
+                        parallel.getHash().as_uint256(), 0));
+            }
+        }
+
+        if (backed)
+        {
+            testcase("tree ordered flush");
+
+            Section config;
+            config.set("tree_ordered_writes", "1");
+            tests::TestNodeFamily plain{journal, "SHAMap_test_plain"};
+            tests::TestNodeFamily ordered{
+                journal, "SHAMap_test_ordered", config};
+            BEAST_EXPECT(!plain.db().treeOrderedWrites());
+            BEAST_EXPECT(ordered.db().treeOrderedWrites());
+
+            SHAMap expected{SHAMapType::FREE, plain};
+            SHAMap serial{SHAMapType::FREE, ordered};
+            SHAMap parallel{SHAMapType::FREE, ordered};
+
+            beast::xor_shift_engine rng(3);
+            for (int i = 0; i < 2000; ++i)
+            {
+                uint256 key;
+                beast::rngfill(key.begin(), key.size(), rng);
+                for (auto map : {&expected, &serial, &parallel})
+                    BEAST_EXPECT(map->addItem(
+                        SHAMapNodeType::tnACCOUNT_STATE,
+                        make_shamapitem(key, IntToVUC(i))));
+            }
+
+            int const flushed = expected.flushDirty(hotACCOUNT_NODE);
+            BEAST_EXPECT(serial.flushDirty(hotACCOUNT_NODE) == flushed);
+            BEAST_EXPECT(parallel.flushDirty(hotACCOUNT_NODE, 4) == flushed);
+            BEAST_EXPECT(serial.getHash() == expected.getHash());
+            BEAST_EXPECT(parallel.getHash() == expected.getHash());
+
+            // Every node was written, whatever the order
+            int stored = 0;
+            serial.visitNodes([&](SHAMapTreeNode& node) {
+                if (ordered.db().fetchNodeObject(
+                        node.getHash().as_uint256(), 0))
+                    ++stored;
+                return true;
+            });
+            BEAST_EXPECT(stored == flushed);
+        }
+
+        if (backed)
+            testcase("parallel compare backed");
+        else
+            testcase("parallel compare unbacked");
+
+        {
+            tests::TestNodeFamily tf{journal};
+            SHAMap base{SHAMapType::FREE, tf};
+            if (!backed)
+                base.setUnbacked();
+
+            beast::xor_shift_engine rng(backed ? 3 : 4);
+            std::vector<uint256> keys(1000);
+            for (int i = 0; i < 1000; ++i)
+            {
+                beast::rngfill(keys[i].begin(), keys[i].size(), rng);
+                BEAST_EXPECT(base.addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    make_shamapitem(keys[i], IntToVUC(i))));
+            }
+
+            // Delete, modify and add items across every branch
+            auto changed = base.snapShot(true);
+            for (int i = 0; i < 100; ++i)
+            {
+                BEAST_EXPECT(changed->delItem(keys[3 * i]));
+                BEAST_EXPECT(changed->updateGiveItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    make_shamapitem(keys[3 * i + 1], IntToVUC(3 * i + 2))));
+
+                uint256 key;
+                beast::rngfill(key.begin(), key.size(), rng);
+                BEAST_EXPECT(changed->addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    make_shamapitem(key, IntToVUC(i))));
+            }
+
+            auto same = [](SHAMap::Delta const& a, SHAMap::Delta const& b) {
+                auto const item = [](auto const& x, auto const& y) {
+                    return x ? (y && x->slice() == y->slice()) : !y;
+                };
+                return std::equal(
+                    a.begin(),
+                    a.end(),
+                    b.begin(),
+                    b.end(),
+                    [&](auto const& x, auto const& y) {
+                        return x.first == y.first &&
+                            item(x.second.first, y.second.first) &&
+                            item(x.second.second, y.second.second);
+                    });
+            };
+
+            SHAMap::Delta serial;
+            SHAMap::Delta parallel;
+            BEAST_EXPECT(base.compare(*changed, serial, 1000));
+            BEAST_EXPECT(base.compare(*changed, parallel, 1000, 4));
+            BEAST_EXPECT(serial.size() == 300);
+            BEAST_EXPECT(same(serial, parallel));
+
+            // Running out of room reports exactly maxCount of the
+            // differences, however many workers shared the budget
+            auto const within = [&](SHAMap::Delta const& part) {
+                SHAMap::Delta expected;
+                for (auto const& difference : part)
+                {
+                    auto const it = serial.find(difference.first);
+                    if (it == serial.end())
+                        return false;
+                    expected.insert(*it);
+                }
+                return same(part, expected);
+            };
+            for (std::size_t threads : {1, 3, 4, 16})
+            {
+                SHAMap::Delta part;
+                BEAST_EXPECT(!base.compare(*changed, part, 50, threads));
+                BEAST_EXPECT(part.size() == 50);
+                BEAST_EXPECT(within(part));
+            }
+        }
+
+        if (!backed)
+            return;
+
+        testcase("read ahead");
+
+        {
+            tests::TestNodeFamily tf{journal};
+            SHAMap warm{SHAMapType::FREE, tf};
+
+            beast::xor_shift_engine rng(5);
+            for (int i = 0; i < 3000; ++i)
+            {
+                uint256 key;
+                beast::rngfill(key.begin(), key.size(), rng);
+                BEAST_EXPECT(warm.addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    make_shamapitem(key, IntToVUC(i))));
+            }
+            warm.flushDirty(hotACCOUNT_NODE);
+            warm.setImmutable();
+
+            std::vector<uint256> expected;
+            for (auto const& item : warm)
+                expected.push_back(item.key());
+
+            // Scan a copy that has to load every node from the store,
+            // starting from the beginning and from the middle
+            for (auto const start : {0, 1234})
+            {
+                tf.reset();
+                SHAMap cold{SHAMapType::FREE, warm.getHash().as_uint256(), tf};
+                BEAST_EXPECT(cold.fetchRoot(warm.getHash(), nullptr));
+
+                auto it = start == 0
+                    ? cold.begin(8)
+                    : cold.upper_bound(expected[start - 1], 8);
+
+                std::vector<uint256> keys;
+                for (; it != cold.end(); ++it)
+                    keys.push_back(it->key());
+
+                BEAST_EXPECT(std::equal(
+                    keys.begin(),
+                    keys.end(),
+                    expected.begin() + start,
+                    expected.end()));
+            }
+        }
+
+        testcase("prefetch");
+
+        {
+            tests::TestNodeFamily tf{journal};
+            SHAMap warm{SHAMapType::FREE, tf};
+
+            beast::xor_shift_engine rng(7);
+            std::vector<uint256> keys;
+            for (int i = 0; i < 3000; ++i)
+            {
+                uint256 key;
+                beast::rngfill(key.begin(), key.size(), rng);
+                keys.push_back(key);
+                BEAST_EXPECT(warm.addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    make_shamapitem(key, IntToVUC(i))));
+            }
+            warm.flushDirty(hotACCOUNT_NODE);
+            warm.setImmutable();
+
+            tf.reset();
+            SHAMap cold{SHAMapType::FREE, warm.getHash().as_uint256(), tf};
+            BEAST_EXPECT(cold.fetchRoot(warm.getHash(), nullptr));
+
+            // Some of the items, and one that is not there
+            std::vector<uint256> wanted(keys.begin(), keys.begin() + 100);
+            wanted.emplace_back(1);
+            cold.prefetch(wanted);
+
+            // The leaves arrive in the cache in the background
+            auto const cache = tf.getTreeNodeCache(0);
+            auto const arrived = [&]() {
+                for (int i = 0; i < 100; ++i)
+                {
+                    SHAMapHash hash;
+                    warm.peekItem(keys[i], hash);
+                    if (!cache->touch_if_exists(hash.as_uint256()))
+                        return false;
+                }
+                return true;
+            };
+            for (int i = 0; i < 1000 && !arrived(); ++i)
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            BEAST_EXPECT(arrived());
+
+            for (int i = 0; i < 100; ++i)
+                BEAST_EXPECT(cold.peekItem(keys[i]));
+        }
+
+        testcase("shared leaves");
+
+        {
+            tests::TestNodeFamily tf{journal};
+            SHAMap warm{SHAMapType::FREE, tf};
+
+            beast::xor_shift_engine rng(9);
+            std::vector<uint256> keys;
+            for (int i = 0; i < 500; ++i)
+            {
+                uint256 key;
+                beast::rngfill(key.begin(), key.size(), rng);
+                keys.push_back(key);
+                BEAST_EXPECT(warm.addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    make_shamapitem(key, IntToVUC(i))));
+            }
+            warm.flushDirty(hotACCOUNT_NODE);
+            warm.setImmutable();
+
+            // Maps loaded from the store on their own share the leaves,
+            // and so the payloads, of any map that still holds them
+            auto const hash = warm.getHash();
+            SHAMap first{SHAMapType::FREE, hash.as_uint256(), tf};
+            SHAMap second{SHAMapType::FREE, hash.as_uint256(), tf};
+            BEAST_EXPECT(first.fetchRoot(hash, nullptr));
+            BEAST_EXPECT(second.fetchRoot(hash, nullptr));
+            for (auto const& key : keys)
+            {
+                auto const& item = warm.peekItem(key);
+                BEAST_EXPECT(item && first.peekItem(key) == item);
+                BEAST_EXPECT(second.peekItem(key) == item);
+            }
+        }
     }
 };
 
@@ -397,6 +771,116 @@ class SHAMapPathProof_test : public beast::unit_test::suite
         badPath = goodPath;
         badPath.erase(badPath.begin());
         BEAST_EXPECT(!map.verifyProofPath(rootHash, key, badPath));
+
+        testMultiple(map);
+    }
+
+    void
+    testMultiple(SHAMap& map)
+    {
+        testcase("multiple keys");
+
+        auto const rootHash = map.getHash().as_uint256();
+
+        // Add keys that differ early as well, so the paths both share
+        // nodes and part at the root.
+        for (unsigned char c = 1; c < 20; ++c)
+        {
+            uint256 k;
+            k.data()[0] = c * 13;
+            k.data()[1] = c;
+            map.addItem(
+                SHAMapNodeType::tnACCOUNT_STATE,
+                make_shamapitem(k, Slice{k.data(), k.size()}));
+        }
+        BEAST_EXPECT(map.getHash().as_uint256() != rootHash);
+        auto const root = map.getHash().as_uint256();
+
+        // Every third of the keys that share a long prefix, and all the
+        // others
+        std::vector<uint256> keys;
+        std::size_t n = 0;
+        map.visitLeaves([&](boost::intrusive_ptr<SHAMapItem const> const& i) {
+            if (n++ % 3 == 0 || i->key().data()[0] != 0)
+                keys.push_back(i->key());
+        });
+        std::sort(keys.begin(), keys.end());
+
+        auto const nodes = map.getProofPaths(keys);
+        if (!BEAST_EXPECT(nodes))
+            return;
+        BEAST_EXPECT(SHAMap::verifyProofPaths(root, keys, *nodes));
+        BEAST_EXPECT(!SHAMap::verifyProofPaths(rootHash, keys, *nodes));
+
+        // Shared nodes are only sent once
+        std::size_t single = 0;
+        for (auto const& k : keys)
+        {
+            auto const path = map.getProofPath(k);
+            BEAST_EXPECT(path);
+            if (path)
+                single += path->size();
+        }
+        BEAST_EXPECT(nodes->size() < single);
+
+        // A single key gives the same nodes as getProofPath, root first
+        {
+            auto const one = map.getProofPaths({keys.front()});
+            auto path = map.getProofPath(keys.front());
+            BEAST_EXPECT(one && path);
+            if (one && path)
+            {
+                std::reverse(path->begin(), path->end());
+                BEAST_EXPECT(*one == *path);
+            }
+        }
+
+        // The bundle survives packing
+        auto const packed = SHAMap::serializeProofPaths(*nodes);
+        auto const unpacked = SHAMap::deserializeProofPaths(makeSlice(packed));
+        BEAST_EXPECT(unpacked && *unpacked == *nodes);
+        BEAST_EXPECT(!SHAMap::deserializeProofPaths(
+            Slice{packed.data(), packed.size() - 1}));
+
+        // Keys out of order, repeated or missing
+        {
+            auto bad = keys;
+            std::swap(bad[0], bad[1]);
+            BEAST_EXPECT(!map.getProofPaths(bad));
+            BEAST_EXPECT(!SHAMap::verifyProofPaths(root, bad, *nodes));
+
+            bad = keys;
+            bad.insert(bad.begin(), bad.front());
+            BEAST_EXPECT(!map.getProofPaths(bad));
+
+            bad = keys;
+            bad.back().data()[0] = 0xff;
+            BEAST_EXPECT(!map.getProofPaths(bad));
+            BEAST_EXPECT(!map.getProofPaths({}));
+        }
+
+        // Proofs that do not match the keys
+        {
+            auto fewer = keys;
+            fewer.pop_back();
+            BEAST_EXPECT(!SHAMap::verifyProofPaths(root, fewer, *nodes));
+
+            auto bad = *nodes;
+            bad.pop_back();
+            BEAST_EXPECT(!SHAMap::verifyProofPaths(root, keys, bad));
+
+            bad = *nodes;
+            bad.push_back(bad.back());
+            BEAST_EXPECT(!SHAMap::verifyProofPaths(root, keys, bad));
+
+            bad = *nodes;
+            std::swap(bad[1], bad[2]);
+            BEAST_EXPECT(!SHAMap::verifyProofPaths(root, keys, bad));
+
+            bad = *nodes;
+            bad.back().front() ^= 1;
+            BEAST_EXPECT(!SHAMap::verifyProofPaths(root, keys, bad));
+        }
     }
 };
 
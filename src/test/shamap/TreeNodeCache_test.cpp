@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/shamap/SHAMapInnerNode.h>
+#include <ripple/shamap/TreeNodeCache.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <vector>
+
+namespace ripple {
+namespace tests {
+
+class TreeNodeCache_test : public beast::unit_test::suite
+{
+    // A key that falls in the given shard
+    static uint256
+    keyIn(std::size_t shard, std::uint8_t n)
+    {
+        uint256 key;
+        *key.begin() = static_cast<std::uint8_t>(shard);
+        *(key.end() - 1) = n;
+        return key;
+    }
+
+    static SharedIntrusive<SHAMapTreeNode>
+    makeNode()
+    {
+        return make_SharedIntrusive<SHAMapInnerNode>(0);
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono_literals;
+        test::SuiteJournal journal("TreeNodeCache_test", *this);
+        TestStopwatch clock;
+        clock.set(0);
+
+        auto const shards = TreeNodeCache::shardCount;
+        TreeNodeCache cache("test", 0, 1s, clock, journal);
+
+        // Nodes in every shard are cached and fetched back
+        std::vector<SharedIntrusive<SHAMapTreeNode>> nodes;
+        for (std::size_t s = 0; s < shards; ++s)
+        {
+            for (std::uint8_t n = 0; n < 2; ++n)
+            {
+                auto node = makeNode();
+                BEAST_EXPECT(
+                    !cache.canonicalize_replace_client(keyIn(s, n), node));
+                nodes.push_back(node);
+            }
+        }
+        BEAST_EXPECT(cache.getCacheSize() == 2 * shards);
+        BEAST_EXPECT(cache.getTrackSize() == 2 * shards);
+        BEAST_EXPECT(cache.getKeys().size() == 2 * shards);
+
+        for (std::size_t s = 0; s < shards; ++s)
+        {
+            BEAST_EXPECT(cache.fetch(keyIn(s, 0)) == nodes[2 * s]);
+            BEAST_EXPECT(cache.fetch(keyIn(s, 1)) == nodes[2 * s + 1]);
+        }
+        BEAST_EXPECT(!cache.fetch(keyIn(0, 2)));
+
+        // Another copy of a cached node is replaced by the cached one
+        for (std::size_t s = 0; s < shards; ++s)
+        {
+            auto node = makeNode();
+            BEAST_EXPECT(cache.canonicalize_replace_client(keyIn(s, 0), node));
+            BEAST_EXPECT(node == nodes[2 * s]);
+        }
+        BEAST_EXPECT(cache.getCacheSize() == 2 * shards);
+
+        // A sweep ages every shard. Nodes still held elsewhere stay
+        // tracked, the others go.
+        for (std::size_t s = 0; s < shards; ++s)
+            nodes[2 * s + 1].reset();
+        clock.advance(2s);
+        cache.sweep();
+        BEAST_EXPECT(cache.getCacheSize() == 0);
+        BEAST_EXPECT(cache.getTrackSize() == shards);
+        for (std::size_t s = 0; s < shards; ++s)
+        {
+            BEAST_EXPECT(cache.fetch(keyIn(s, 0)) == nodes[2 * s]);
+            BEAST_EXPECT(!cache.fetch(keyIn(s, 1)));
+        }
+
+        // Once no one holds them, the next sweeps drop them all
+        nodes.clear();
+        clock.advance(2s);
+        cache.sweep();
+        clock.advance(2s);
+        cache.sweep();
+        BEAST_EXPECT(cache.getTrackSize() == 0);
+        BEAST_EXPECT(cache.size() == 0);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(TreeNodeCache, shamap, ripple);
+
+}  // namespace tests
+}  // namespace ripple
@@ -32,8 +32,6 @@ namespace tests {
 class TestNodeFamily : public Family
 {
 private:
-    std::unique_ptr<NodeStore::Database> db_;
-
     std::shared_ptr<FullBelowCache> fbCache_;
     std::shared_ptr<TreeNodeCache> tnCache_;
 
@@ -42,8 +40,19 @@ private:
 
     beast::Journal const j_;
 
+    // Destroyed first, so that no read still running refers to the caches
+    std::unique_ptr<NodeStore::Database> db_;
+
 public:
-    TestNodeFamily(beast::Journal j)
+    /** @param path Names the memory database that holds the nodes. Memory
+                    databases last until the process exits, so families
+                    that must not see each other's nodes need their own.
+        @param config Further settings for the database.
+    */
+    TestNodeFamily(
+        beast::Journal j,
+        std::string const& path = "SHAMap_test",
+        Section testSection = Section{})
         : fbCache_(std::make_shared<FullBelowCache>(
               "App family full below cache",
               clock_,
@@ -56,9 +65,8 @@ public:
               j))
         , j_(j)
     {
-        Section testSection;
         testSection.set("type", "memory");
-        testSection.set("path", "SHAMap_test");
+        testSection.set("path", path);
         db_ = NodeStore::Manager::instance().make_Database(
             megabytes(4), scheduler_, 1, testSection, j);
     }